@@ -0,0 +1,52 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+#include "allocations.hpp"
+
+namespace {
+
+std::atomic<std::size_t> n_allocations{0};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+std::atomic<std::size_t> n_bytes{0};        // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+// Number of live CountAllocations, counting is on when positive
+std::atomic<int> n_counters{0};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+}  // namespace
+
+// Array and nothrow versions of the standard library forward to these replacements
+auto operator new(std::size_t size) -> void* {
+	if (n_counters.load(std::memory_order_relaxed) > 0) {
+		n_allocations.fetch_add(1, std::memory_order_relaxed);
+		n_bytes.fetch_add(size, std::memory_order_relaxed);
+	}
+	// NOLINTNEXTLINE(cppcoreguidelines-no-malloc) implementing operator new
+	if (auto* ptr = std::malloc(size > 0 ? size : 1); ptr != nullptr) {
+		return ptr;
+	}
+	throw std::bad_alloc{};
+}
+
+void operator delete(void* ptr) noexcept {
+	std::free(ptr);  // NOLINT(cppcoreguidelines-no-malloc) implementing operator delete
+}
+
+void operator delete(void* ptr, std::size_t /*size*/) noexcept {
+	std::free(ptr);  // NOLINT(cppcoreguidelines-no-malloc) implementing operator delete
+}
+
+namespace ecole::benchmark {
+
+auto allocations() noexcept -> Allocations {
+	return {n_allocations.load(std::memory_order_relaxed), n_bytes.load(std::memory_order_relaxed)};
+}
+
+CountAllocations::CountAllocations() noexcept {
+	n_counters.fetch_add(1, std::memory_order_relaxed);
+}
+
+CountAllocations::~CountAllocations() {
+	n_counters.fetch_sub(1, std::memory_order_relaxed);
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,38 @@
+#pragma once
+
+#include <cstddef>
+
+namespace ecole::benchmark {
+
+/** Number and size of the allocations made through the global operator new. */
+struct Allocations {
+	std::size_t n_allocations = 0;
+	std::size_t n_bytes = 0;
+
+	auto operator-(Allocations const& other) const noexcept -> Allocations {
+		return {n_allocations - other.n_allocations, n_bytes - other.n_bytes};
+	}
+};
+
+/**
+ * The allocations counted so far, made by all threads.
+ *
+ * Allocations are only counted while a CountAllocations is alive, so that the other benchmarks do not pay for the
+ * atomic increments.
+ * Only C++ allocations are counted, memory allocated by SCIP with ``malloc`` is not.
+ */
+auto allocations() noexcept -> Allocations;
+
+/** Count the allocations made through the global operator new during the lifetime of the object. */
+class CountAllocations {
+public:
+	CountAllocations() noexcept;
+	~CountAllocations();
+
+	CountAllocations(CountAllocations const&) = delete;
+	CountAllocations(CountAllocations&&) = delete;
+	auto operator=(CountAllocations const&) -> CountAllocations& = delete;
+	auto operator=(CountAllocations&&) -> CountAllocations& = delete;
+};
+
+}  // namespace ecole::benchmark
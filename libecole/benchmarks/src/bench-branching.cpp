@@ -1,4 +1,4 @@
-#include <chrono>
+#include <cstddef>
 #include <tuple>
 #include <utility>
 
@@ -7,7 +7,6 @@
 
 #include "ecole/dynamics/branching.hpp"
 #include "ecole/scip/model.hpp"
-#include "ecole/utility/chrono.hpp"
 
 #include "bench-branching.hpp"
 #include "branching/index-branchrule.hpp"
@@ -17,21 +16,6 @@ namespace ecole::benchmark {
 
 namespace {
 
-template <typename Func> auto measure_on_model(Func&& func_to_bench, scip::Model model) -> Metrics {
-	auto const cpu_time_before = utility::cpu_clock::now();
-	auto const wall_time_before = std::chrono::steady_clock::now();
-	func_to_bench(model);
-	auto const wall_time_after = std::chrono::steady_clock::now();
-	auto const cpu_time_after = utility::cpu_clock::now();
-
-	return {
-		std::chrono::duration<double>(wall_time_after - wall_time_before).count(),
-		std::chrono::duration<double>(cpu_time_after - cpu_time_before).count(),
-		static_cast<std::size_t>(SCIPgetNTotalNodes(model.get_scip_ptr())),
-		static_cast<std::size_t>(SCIPgetNLPIterations(model.get_scip_ptr())),
-	};
-}
-
 auto measure_branching_dynamics(scip::Model model) -> Metrics {
 	return measure_on_model(
 		[](scip::Model& m) {
@@ -66,11 +50,11 @@ auto BranchingResult::csv() -> std::string {
 	return merge_csv(instance.csv(), branching_dynamics_metrics.csv(), branching_rule_metrics.csv());
 }
 
-auto benchmark_branching(scip::Model const& model) -> BranchingResult {
+auto benchmark_branching(scip::Model const& model, std::size_t n_warmups, std::size_t n_trials) -> BranchingResult {
 	return {
 		InstanceFeatures::from_model(model.copy_orig()),
-		measure_branching_dynamics(model.copy_orig()),
-		measure_branching_rule(model.copy_orig()),
+		Metrics::repeat([&model] { return measure_branching_dynamics(model.copy_orig()); }, n_warmups, n_trials),
+		Metrics::repeat([&model] { return measure_branching_rule(model.copy_orig()); }, n_warmups, n_trials),
 	};
 }
 
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <string>
 
 #include "ecole/scip/model.hpp"
@@ -17,7 +18,12 @@ struct BranchingResult {
 	auto csv() -> std::string;
 };
 
-/** Benchmark the branching dynamics against a branch rule on a given model. */
-auto benchmark_branching(scip::Model const& model) -> BranchingResult;
+/**
+ * Benchmark the branching dynamics against a branch rule on a given model.
+ *
+ * Both are run ``n_trials`` times on copies of the model, after ``n_warmups`` untimed runs.
+ */
+auto benchmark_branching(scip::Model const& model, std::size_t n_warmups = 0, std::size_t n_trials = 1)
+	-> BranchingResult;
 
 }  // namespace ecole::benchmark
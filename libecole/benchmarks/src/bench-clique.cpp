@@ -0,0 +1,118 @@
+#include <algorithm>
+#include <chrono>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "utility/graph.hpp"
+
+#include "bench-clique.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+using utility::Graph;
+
+namespace {
+
+/** The previous implementation, testing every candidate against every clique member with binary searches. */
+auto reference_clique_partition(Graph const& graph) -> std::vector<std::vector<Graph::Node>> {
+	using Node = Graph::Node;
+	auto clique_partition = std::vector<std::vector<Node>>{};
+	clique_partition.reserve(graph.n_nodes());
+
+	auto order = std::vector<Node>(graph.n_nodes());
+	std::iota(order.begin(), order.end(), Node{0});
+	std::stable_sort(
+		order.begin(), order.end(), [&graph](auto n1, auto n2) { return graph.degree(n1) > graph.degree(n2); });
+	auto rank = std::vector<std::size_t>(graph.n_nodes());
+	for (std::size_t r = 0; r < order.size(); ++r) {
+		rank[order[r]] = r;
+	}
+
+	auto leftover = std::vector<bool>(graph.n_nodes(), true);
+	auto candidates = std::vector<Node>{};
+	for (auto const center : order) {
+		if (!leftover[center]) {
+			continue;
+		}
+		leftover[center] = false;
+		candidates.clear();
+		for (auto const node : graph.neighbors(center)) {
+			if (leftover[node]) {
+				candidates.push_back(node);
+			}
+		}
+		std::sort(candidates.begin(), candidates.end(), [&rank](auto n1, auto n2) { return rank[n1] < rank[n2]; });
+
+		auto clique = std::vector<Node>{center};
+		for (auto const node : candidates) {
+			auto const connected = [&](auto clique_node) { return graph.are_connected(node, clique_node); };
+			if (std::all_of(clique.begin(), clique.end(), connected)) {
+				clique.push_back(node);
+				leftover[node] = false;
+			}
+		}
+		clique_partition.push_back(std::move(clique));
+	}
+	return clique_partition;
+}
+
+auto measure_clique_partition(std::string name, std::vector<Graph> const& graphs) -> CliqueResult {
+	auto result = CliqueResult{std::move(name), graphs.front().n_nodes(), 0, graphs.size()};
+	auto reference_time = std::chrono::steady_clock::duration::zero();
+	auto wall_time = std::chrono::steady_clock::duration::zero();
+	result.identical = true;
+	for (auto const& graph : graphs) {
+		result.n_edges += graph.n_edges();
+		auto const reference_before = std::chrono::steady_clock::now();
+		auto const reference = reference_clique_partition(graph);
+		auto const wall_time_before = std::chrono::steady_clock::now();
+		auto const partition = graph.greedy_clique_partition();
+		wall_time += std::chrono::steady_clock::now() - wall_time_before;
+		reference_time += wall_time_before - reference_before;
+		result.identical = result.identical && (partition == reference);
+	}
+	result.n_edges /= graphs.size();
+	result.reference_time_s = std::chrono::duration<double>(reference_time).count();
+	result.wall_time_s = std::chrono::duration<double>(wall_time).count();
+	result.speedup = result.wall_time_s > 0 ? result.reference_time_s / result.wall_time_s : 0.;
+	return result;
+}
+
+}  // namespace
+
+auto CliqueResult::csv_title() -> std::string {
+	return make_csv(
+		"graph", "n_nodes", "n_edges", "n_graphs", "reference_time_s", "wall_time_s", "speedup", "identical");
+}
+
+auto CliqueResult::csv() -> std::string {
+	return make_csv(graph, n_nodes, n_edges, n_graphs, reference_time_s, wall_time_s, speedup, identical);
+}
+
+auto benchmark_clique_partition_barabasi_albert(
+	std::size_t n_nodes,
+	std::size_t affinity,
+	std::size_t n_graphs,
+	RandomGenerator& rng) -> CliqueResult {
+	auto graphs = std::vector<Graph>{};
+	for (std::size_t i = 0; i < n_graphs; ++i) {
+		graphs.push_back(Graph::barabasi_albert(n_nodes, affinity, rng));
+	}
+	return measure_clique_partition("barabasi_albert", graphs);
+}
+
+auto benchmark_clique_partition_erdos_renyi(
+	std::size_t n_nodes,
+	double edge_probability,
+	std::size_t n_graphs,
+	RandomGenerator& rng) -> CliqueResult {
+	auto graphs = std::vector<Graph>{};
+	for (std::size_t i = 0; i < n_graphs; ++i) {
+		graphs.push_back(Graph::erdos_renyi(n_nodes, edge_probability, rng));
+	}
+	return measure_clique_partition("erdos_renyi", graphs);
+}
+
+}  // namespace ecole::benchmark
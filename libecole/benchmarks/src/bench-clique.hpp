@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "ecole/random.hpp"
+
+namespace ecole::benchmark {
+
+struct CliqueResult {
+	std::string graph;
+	std::size_t n_nodes = 0;
+	std::size_t n_edges = 0;
+	std::size_t n_graphs = 0;
+	double reference_time_s = 0.;
+	double wall_time_s = 0.;
+	double speedup = 0.;
+	/** Whether the partitions were the same as those of the reference implementation on every graph. */
+	bool identical = false;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Compare Graph::greedy_clique_partition with the implementation testing every candidate against every clique member.
+ *
+ * Both are timed on the same ``n_graphs`` graphs, sampled from ``rng`` as in the IndependentSetGenerator.
+ */
+auto benchmark_clique_partition_barabasi_albert(
+	std::size_t n_nodes,
+	std::size_t affinity,
+	std::size_t n_graphs,
+	RandomGenerator& rng) -> CliqueResult;
+
+/** Same as benchmark_clique_partition_barabasi_albert on Erdos Renyi graphs. */
+auto benchmark_clique_partition_erdos_renyi(
+	std::size_t n_nodes,
+	double edge_probability,
+	std::size_t n_graphs,
+	RandomGenerator& rng) -> CliqueResult;
+
+}  // namespace ecole::benchmark
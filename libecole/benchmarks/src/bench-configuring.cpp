@@ -0,0 +1,73 @@
+#include <cstddef>
+#include <string>
+#include <utility>
+
+#include "ecole/dynamics/configuring.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "bench-configuring.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+/** A configuration of the kind chosen by configuration agents, changing the search and the separation. */
+auto configuration() -> dynamics::ParamDict {
+	return {
+		{"branching/scorefunc", 'p'},
+		{"nodeselection/childsel", 'h'},
+		{"separating/maxrounds", 1},
+		{"separating/maxroundsroot", 5},  // NOLINT(readability-magic-numbers)
+		{"presolving/maxrounds", 2},
+	};
+}
+
+auto measure_configuring_dynamics(scip::Model model, dynamics::ParamDict const& params) -> Metrics {
+	return measure_on_model(
+		[&params](scip::Model& m) {
+			auto dyn = dynamics::ConfiguringDynamics{};
+			dyn.reset_dynamics(m);
+			dyn.step_dynamics(m, params);
+		},
+		std::move(model));
+}
+
+auto measure_solve(scip::Model model, dynamics::ParamDict const& params) -> Metrics {
+	return measure_on_model(
+		[&params](scip::Model& m) {
+			m.set_params(params);
+			m.solve();
+		},
+		std::move(model));
+}
+
+}  // namespace
+
+auto ConfiguringResult::csv_title() -> std::string {
+	return merge_csv(
+		InstanceFeatures::csv_title(),
+		make_csv("episode_overhead_s"),
+		Metrics::csv_title("configuring_dynamics:"),
+		Metrics::csv_title("solve:"));
+}
+
+auto ConfiguringResult::csv() -> std::string {
+	return merge_csv(
+		instance.csv(),
+		make_csv(configuring_dynamics_metrics.wall_time_s - solve_metrics.wall_time_s),
+		configuring_dynamics_metrics.csv(),
+		solve_metrics.csv());
+}
+
+auto benchmark_configuring(scip::Model const& model, std::size_t n_warmups, std::size_t n_trials)
+	-> ConfiguringResult {
+	auto const params = configuration();
+	return {
+		InstanceFeatures::from_model(model.copy_orig()),
+		Metrics::repeat([&] { return measure_configuring_dynamics(model.copy_orig(), params); }, n_warmups, n_trials),
+		Metrics::repeat([&] { return measure_solve(model.copy_orig(), params); }, n_warmups, n_trials),
+	};
+}
+
+}  // namespace ecole::benchmark
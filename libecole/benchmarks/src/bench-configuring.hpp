@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "ecole/scip/model.hpp"
+
+#include "benchmark.hpp"
+
+namespace ecole::benchmark {
+
+struct ConfiguringResult {
+	InstanceFeatures instance;
+	Metrics configuring_dynamics_metrics;
+	Metrics solve_metrics;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark a configuration episode of the configuring dynamics against plain Model::solve with the same parameters.
+ *
+ * The difference of their wall times is the overhead of a configuration episode in Ecole.
+ * Both are run ``n_trials`` times on copies of the model, after ``n_warmups`` untimed runs.
+ */
+auto benchmark_configuring(scip::Model const& model, std::size_t n_warmups = 0, std::size_t n_trials = 1)
+	-> ConfiguringResult;
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,43 @@
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "ecole/scip/cons.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+#include "bench-constraints.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+auto ConstraintsResult::csv_title() -> std::string {
+	return make_csv("n_constraints", "n_nonzeros", "n_threads", "wall_time_s");
+}
+
+auto ConstraintsResult::csv() -> std::string {
+	return make_csv(n_constraints, n_nonzeros, n_threads, wall_time_s);
+}
+
+auto benchmark_constraints(scip::Model& model, std::size_t max_threads, std::size_t n_repeats)
+	-> std::vector<ConstraintsResult> {
+	auto* const scip = model.get_scip_ptr();
+	auto results = std::vector<ConstraintsResult>{};
+	for (std::size_t n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+		auto thread_pool = utility::ThreadPool{n_threads};
+		auto* const pool = (n_threads > 1) ? &thread_pool : nullptr;
+		for (std::size_t repeat = 0; repeat < n_repeats; ++repeat) {
+			auto const wall_time_before = std::chrono::steady_clock::now();
+			auto const [matrix, biases] = scip::get_all_constraints(scip, false, false, pool);
+			auto const wall_time_after = std::chrono::steady_clock::now();
+			results.push_back({
+				model.constraints().size(),
+				matrix.nnz(),
+				n_threads,
+				std::chrono::duration<double>(wall_time_after - wall_time_before).count(),
+			});
+		}
+	}
+	return results;
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ecole/scip/model.hpp"
+
+namespace ecole::benchmark {
+
+struct ConstraintsResult {
+	std::size_t n_constraints = 0;
+	std::size_t n_nonzeros = 0;
+	std::size_t n_threads = 0;
+	double wall_time_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the extraction time of the constraint matrix for an increasing number of threads.
+ *
+ * The matrix is extracted from the same problem ``n_repeats`` times for every number of threads.
+ */
+auto benchmark_constraints(scip::Model& model, std::size_t max_threads, std::size_t n_repeats)
+	-> std::vector<ConstraintsResult>;
+
+}  // namespace ecole::benchmark
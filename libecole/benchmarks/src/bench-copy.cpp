@@ -0,0 +1,75 @@
+#include <chrono>
+#include <future>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench-copy.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+/** Time every thread copying its source model the given number of times. */
+auto measure_copy(std::string source, std::vector<scip::Model const*> const& models, std::size_t n_copies_per_thread)
+	-> CopyResult {
+	auto const copy_many = [n_copies_per_thread](scip::Model const* model) {
+		for (std::size_t i = 0; i < n_copies_per_thread; ++i) {
+			[[maybe_unused]] auto const copy = model->copy_orig();
+		}
+	};
+
+	auto const wall_time_before = std::chrono::steady_clock::now();
+	auto futures = std::vector<std::future<void>>{};
+	futures.reserve(models.size());
+	for (auto const* model : models) {
+		futures.push_back(std::async(std::launch::async, copy_many, model));
+	}
+	for (auto& fut : futures) {
+		fut.get();
+	}
+	auto const wall_time_after = std::chrono::steady_clock::now();
+
+	return {
+		std::move(source),
+		models.size(),
+		models.size() * n_copies_per_thread,
+		std::chrono::duration<double>(wall_time_after - wall_time_before).count(),
+	};
+}
+
+}  // namespace
+
+auto CopyResult::csv_title() -> std::string {
+	return make_csv("source", "n_threads", "n_copies", "wall_time_s", "copies_per_s");
+}
+
+auto CopyResult::csv() -> std::string {
+	auto const copies_per_s = wall_time_s > 0 ? static_cast<double>(n_copies) / wall_time_s : 0.;
+	return make_csv(source, n_threads, n_copies, wall_time_s, copies_per_s);
+}
+
+auto benchmark_copy(scip::Model const& model, std::size_t max_threads, std::size_t n_copies_per_thread)
+	-> std::vector<CopyResult> {
+	// One independent source per thread
+	auto sources = std::vector<scip::Model>{};
+	sources.reserve(max_threads);
+	for (std::size_t i = 0; i < max_threads; ++i) {
+		sources.push_back(model.copy_orig());
+	}
+
+	auto results = std::vector<CopyResult>{};
+	for (std::size_t n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+		auto const shared = std::vector<scip::Model const*>(n_threads, &model);
+		results.push_back(measure_copy("shared", shared, n_copies_per_thread));
+		auto per_thread = std::vector<scip::Model const*>{};
+		for (std::size_t i = 0; i < n_threads; ++i) {
+			per_thread.push_back(&sources[i]);
+		}
+		results.push_back(measure_copy("per_thread", per_thread, n_copies_per_thread));
+	}
+	return results;
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,29 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ecole/scip/model.hpp"
+
+namespace ecole::benchmark {
+
+struct CopyResult {
+	std::string source;
+	std::size_t n_threads = 0;
+	std::size_t n_copies = 0;
+	double wall_time_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the throughput of Model::copy_orig for an increasing number of threads.
+ *
+ * Threads either all copy the same model, or each copy their own.
+ */
+auto benchmark_copy(scip::Model const& model, std::size_t max_threads, std::size_t n_copies_per_thread)
+	-> std::vector<CopyResult>;
+
+}  // namespace ecole::benchmark
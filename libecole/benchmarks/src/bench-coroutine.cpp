@@ -0,0 +1,62 @@
+#include <chrono>
+#include <string>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include "ecole/utility/coroutine.hpp"
+
+#include "bench-coroutine.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+/** Time round trips where the coroutine sends a value that the executor sends back. */
+template <typename WaitPolicy>
+auto measure_handoff(std::string wait_policy, std::size_t n_round_trips) -> HandoffResult {
+	using Coroutine = utility::Coroutine<std::size_t, std::size_t, WaitPolicy>;
+	using Executor = typename Coroutine::Executor;
+
+	auto co = Coroutine{[](Executor& executor) {
+		auto message = executor.yield(0);
+		while (!Executor::is_stop(message)) {
+			message = executor.yield(std::get<std::size_t>(message));
+		}
+	}};
+	co.wait();
+
+	auto const wall_time_before = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < n_round_trips; ++i) {
+		co.resume(i);
+		co.wait();
+	}
+	auto const wall_time_after = std::chrono::steady_clock::now();
+
+	return {
+		std::move(wait_policy),
+		n_round_trips,
+		std::chrono::duration<double>(wall_time_after - wall_time_before).count(),
+	};
+}
+
+}  // namespace
+
+auto HandoffResult::csv_title() -> std::string {
+	return make_csv("wait_policy", "n_round_trips", "wall_time_s", "round_trip_ns");
+}
+
+auto HandoffResult::csv() -> std::string {
+	auto const round_trip_ns = n_round_trips > 0 ? wall_time_s * 1e9 / static_cast<double>(n_round_trips) : 0.;
+	return make_csv(wait_policy, n_round_trips, wall_time_s, round_trip_ns);
+}
+
+auto benchmark_coroutine_handoff(std::size_t n_round_trips) -> std::vector<HandoffResult> {
+	return {
+		measure_handoff<utility::BlockingWait>("blocking", n_round_trips),
+		measure_handoff<utility::SpinThenBlockWait<>>("spin_then_block", n_round_trips),
+	};
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace ecole::benchmark {
+
+struct HandoffResult {
+	std::string wait_policy;
+	std::size_t n_round_trips = 0;
+	double wall_time_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/** Benchmark the latency of passing control back and forth in a Coroutine for every wait policy. */
+auto benchmark_coroutine_handoff(std::size_t n_round_trips) -> std::vector<HandoffResult>;
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,115 @@
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <sys/resource.h>
+
+#include "ecole/scip/cons.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "bench-generation.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+auto n_nonzeros(scip::Model const& model) -> std::size_t {
+	auto n_nonzeros = std::size_t{0};
+	for (auto* const cons : model.constraints()) {
+		n_nonzeros += scip::get_cons_n_vars(model.get_scip_ptr(), cons).value_or(0);
+	}
+	return n_nonzeros;
+}
+
+/** Peak resident set size of the process, in kibibytes on Linux. */
+auto peak_rss_kib() -> std::size_t {
+	auto usage = rusage{};
+	getrusage(RUSAGE_SELF, &usage);
+	return static_cast<std::size_t>(usage.ru_maxrss);
+}
+
+}  // namespace
+
+auto GenerationResult::csv_title() -> std::string {
+	return make_csv(
+		"generator",
+		"n_variables",
+		"n_constraints",
+		"n_nonzeros",
+		"n_instances",
+		"wall_time_s",
+		"instances_per_s",
+		"nonzeros_per_s",
+		"peak_rss_kib");
+}
+
+auto GenerationResult::csv() -> std::string {
+	return make_csv(
+		generator,
+		n_variables,
+		n_constraints,
+		n_nonzeros,
+		n_instances,
+		wall_time_s,
+		instances_per_s,
+		nonzeros_per_s,
+		peak_rss_kib);
+}
+
+auto benchmark_generation(instance::InstanceGenerator& generator, std::size_t n_instances) -> GenerationResult {
+	auto result = GenerationResult{};
+	auto wall_time = std::chrono::steady_clock::duration::zero();
+	auto total_nonzeros = std::size_t{0};
+	for (; result.n_instances < n_instances; ++result.n_instances) {
+		auto const wall_time_before = std::chrono::steady_clock::now();
+		auto const model = generator.next();
+		wall_time += std::chrono::steady_clock::now() - wall_time_before;
+		// Models are inspected and destroyed outside of the timed section
+		result.generator = model.name();
+		result.n_variables = model.variables().size();
+		result.n_constraints = model.constraints().size();
+		result.n_nonzeros = n_nonzeros(model);
+		total_nonzeros += result.n_nonzeros;
+	}
+	result.wall_time_s = std::chrono::duration<double>(wall_time).count();
+	result.instances_per_s = static_cast<double>(result.n_instances) / result.wall_time_s;
+	result.nonzeros_per_s = static_cast<double>(total_nonzeros) / result.wall_time_s;
+	result.peak_rss_kib = peak_rss_kib();
+	return result;
+}
+
+auto ParsingResult::csv_title() -> std::string {
+	return make_csv("generator", "format", "file_bytes", "n_reads", "wall_time_s", "reads_per_s", "megabytes_per_s");
+}
+
+auto ParsingResult::csv() -> std::string {
+	auto const reads_per_s = wall_time_s > 0 ? static_cast<double>(n_reads) / wall_time_s : 0.;
+	auto const megabytes_per_s = reads_per_s * static_cast<double>(file_bytes) / 1e6;  // NOLINT
+	return make_csv(generator, format, file_bytes, n_reads, wall_time_s, reads_per_s, megabytes_per_s);
+}
+
+auto benchmark_parsing(scip::Model const& model, std::size_t n_reads) -> std::vector<ParsingResult> {
+	auto results = std::vector<ParsingResult>{};
+	for (auto const* format : std::array{"lp", "mps"}) {
+		auto const path =
+			std::filesystem::temp_directory_path() / fmt::format("ecole-benchmark-{}.{}", model.name(), format);
+		model.write_problem(path);
+		auto result = ParsingResult{model.name(), format, std::filesystem::file_size(path), n_reads};
+		auto const wall_time_before = std::chrono::steady_clock::now();
+		for (std::size_t i = 0; i < n_reads; ++i) {
+			[[maybe_unused]] auto const read_model = scip::Model::from_file(path);
+		}
+		result.wall_time_s = std::chrono::duration<double>(std::chrono::steady_clock::now() - wall_time_before).count();
+		std::filesystem::remove(path);
+		results.push_back(std::move(result));
+	}
+	return results;
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ecole/instance/abstract.hpp"
+#include "ecole/scip/model.hpp"
+
+namespace ecole::benchmark {
+
+struct GenerationResult {
+	std::string generator;
+	std::size_t n_variables = 0;
+	std::size_t n_constraints = 0;
+	std::size_t n_nonzeros = 0;
+	std::size_t n_instances = 0;
+	double wall_time_s = 0.;
+	double instances_per_s = 0.;
+	double nonzeros_per_s = 0.;
+	/** Peak resident memory of the process after generating, which only grows across benchmarks. */
+	std::size_t peak_rss_kib = 0;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the throughput of an instance generator over ``n_instances`` instances.
+ *
+ * The generator is named after the models it generates.
+ */
+auto benchmark_generation(instance::InstanceGenerator& generator, std::size_t n_instances) -> GenerationResult;
+
+struct ParsingResult {
+	std::string generator;
+	std::string format;
+	std::size_t file_bytes = 0;
+	std::size_t n_reads = 0;
+	double wall_time_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark Model::from_file on the model written in every format, each read ``n_reads`` times.
+ *
+ * The time of a read includes creating and freeing the SCIP model and its plugins.
+ */
+auto benchmark_parsing(scip::Model const& model, std::size_t n_reads) -> std::vector<ParsingResult>;
+
+}  // namespace ecole::benchmark
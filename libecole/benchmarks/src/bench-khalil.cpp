@@ -0,0 +1,54 @@
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include <scip/scip.h>
+
+#include "ecole/observation/khalil-2016.hpp"
+#include "ecole/scip/callback.hpp"
+
+#include "bench-khalil.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+auto KhalilResult::csv_title() -> std::string {
+	return make_csv("node", "n_candidates", "n_threads", "wall_time_s");
+}
+
+auto KhalilResult::csv() -> std::string {
+	return make_csv(node, n_candidates, n_threads, wall_time_s);
+}
+
+auto benchmark_khalil(scip::Model model, std::size_t max_threads, std::size_t n_nodes) -> std::vector<KhalilResult> {
+	auto obs_funcs = std::vector<observation::Khalil2016>{};
+	auto thread_counts = std::vector<std::size_t>{};
+	for (std::size_t n_threads = 1; n_threads <= max_threads; n_threads *= 2) {
+		obs_funcs.emplace_back(false, n_threads);
+		thread_counts.push_back(n_threads);
+	}
+	for (auto& func : obs_funcs) {
+		func.before_reset(model);
+	}
+
+	auto results = std::vector<KhalilResult>{};
+	auto fcall = model.solve_iter(scip::callback::BranchruleConstructor{});
+	for (std::size_t node = 0; fcall.has_value() && node < n_nodes; ++node) {
+		auto const n_candidates = model.lp_branch_cands().size();
+		for (std::size_t i = 0; i < obs_funcs.size(); ++i) {
+			auto const wall_time_before = std::chrono::steady_clock::now();
+			[[maybe_unused]] auto const obs = obs_funcs[i].extract(model, false);
+			auto const wall_time_after = std::chrono::steady_clock::now();
+			results.push_back({
+				node,
+				n_candidates,
+				thread_counts[i],
+				std::chrono::duration<double>(wall_time_after - wall_time_before).count(),
+			});
+		}
+		fcall = model.solve_iter_continue(SCIP_DIDNOTRUN);
+	}
+	return results;
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ecole/scip/model.hpp"
+
+namespace ecole::benchmark {
+
+struct KhalilResult {
+	std::size_t node = 0;
+	std::size_t n_candidates = 0;
+	std::size_t n_threads = 0;
+	double wall_time_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the extraction time of the Khalil2016 observation on every node for an increasing number of threads.
+ *
+ * All numbers of threads extract the observation on the same node, before branching with SCIP default rule.
+ */
+auto benchmark_khalil(scip::Model model, std::size_t max_threads, std::size_t n_nodes) -> std::vector<KhalilResult>;
+
+}  // namespace ecole::benchmark
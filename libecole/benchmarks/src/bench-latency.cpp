@@ -0,0 +1,179 @@
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <scip/scip.h>
+
+#include "ecole/default.hpp"
+#include "ecole/dynamics/cut-selection.hpp"
+#include "ecole/dynamics/node-selection.hpp"
+#include "ecole/environment/branching.hpp"
+#include "ecole/environment/configuring.hpp"
+#include "ecole/environment/environment.hpp"
+#include "ecole/environment/primal-search.hpp"
+#include "ecole/information/nothing.hpp"
+#include "ecole/observation/nothing.hpp"
+#include "ecole/reward/is-done.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "bench-latency.hpp"
+#include "csv.hpp"
+#include "latency-histogram.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+using NodeSelection =
+	environment::Environment<dynamics::NodeSelectionDynamics, observation::Nothing, reward::IsDone, information::Nothing>;
+using CutSelection =
+	environment::Environment<dynamics::CutSelectionDynamics, observation::Nothing, reward::IsDone, information::Nothing>;
+
+/** The latencies of the calls to reset, or to step, as a whole and in parts. */
+struct OperationHistograms {
+	LatencyHistogram total;
+	LatencyHistogram solver;
+	LatencyHistogram ecole;
+
+	void record(std::chrono::nanoseconds total_time, std::chrono::nanoseconds solver_time) noexcept {
+		total.record(total_time);
+		solver.record(solver_time);
+		ecole.record(total_time - solver_time);
+	}
+};
+
+/**
+ * Time the solver spent solving since the start of the episode, excluding the handoffs of iterative solving.
+ *
+ * Dynamics that do not solve iteratively solve in a single call, whose time is measured by SCIP with the wall clock.
+ */
+auto solver_time(scip::Model& model, bool iterative) -> std::chrono::nanoseconds {
+	if (iterative) {
+		return model.callback_statistics().solving_time;
+	}
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::duration<double>{SCIPgetSolvingTime(model.get_scip_ptr())});
+}
+
+auto summarize(
+	scip::Model const& model,
+	std::string const& dynamics,
+	std::string const& operation,
+	std::string const& part,
+	LatencyHistogram const& histogram) -> LatencyResult {
+	auto const ns = [](std::chrono::nanoseconds duration) { return static_cast<double>(duration.count()); };
+	return {
+		model.variables().size(),
+		model.constraints().size(),
+		dynamics,
+		operation,
+		part,
+		histogram.count(),
+		histogram.mean(),
+		ns(histogram.percentile(0.5)),    // NOLINT(readability-magic-numbers)
+		ns(histogram.percentile(0.9)),    // NOLINT(readability-magic-numbers)
+		ns(histogram.percentile(0.99)),   // NOLINT(readability-magic-numbers)
+		ns(histogram.percentile(0.999)),  // NOLINT(readability-magic-numbers)
+		ns(histogram.max()),
+	};
+}
+
+/**
+ * Run episodes of an environment, choosing actions with the policy, and record the latency of every reset and step.
+ *
+ * Models are copied before being timed, since environments are usually given the models of instance generators.
+ */
+template <typename Env, typename Policy>
+void measure_latency(
+	std::vector<scip::Model> const& models,
+	std::size_t n_episodes,
+	std::string const& dynamics,
+	bool iterative,
+	Policy&& policy,
+	std::vector<LatencyResult>& results) {
+	auto env = Env{};
+	auto resets = OperationHistograms{};
+	auto steps = OperationHistograms{};
+	for (std::size_t i = 0; i < n_episodes; ++i) {
+		for (auto const& model : models) {
+			auto episode_model = model.copy_orig();
+			episode_model.set_param("timing/clocktype", 2);  // Wall clock
+			auto const reset_before = std::chrono::steady_clock::now();
+			auto [obs, action_set, reward, done, info] = env.reset(std::move(episode_model));
+			auto const reset_time = std::chrono::steady_clock::now() - reset_before;
+			auto solver_before = solver_time(env.model(), iterative);
+			resets.record(reset_time, solver_before);
+			while (!done) {
+				auto const action = policy(action_set);
+				auto const step_before = std::chrono::steady_clock::now();
+				std::tie(obs, action_set, reward, done, info) = env.step(action);
+				auto const step_time = std::chrono::steady_clock::now() - step_before;
+				auto const solver_after = solver_time(env.model(), iterative);
+				steps.record(step_time, solver_after - solver_before);
+				solver_before = solver_after;
+			}
+		}
+	}
+
+	auto const& model = models.front();
+	results.push_back(summarize(model, dynamics, "reset", "total", resets.total));
+	results.push_back(summarize(model, dynamics, "reset", "solver", resets.solver));
+	results.push_back(summarize(model, dynamics, "reset", "ecole", resets.ecole));
+	results.push_back(summarize(model, dynamics, "step", "total", steps.total));
+	results.push_back(summarize(model, dynamics, "step", "solver", steps.solver));
+	results.push_back(summarize(model, dynamics, "step", "ecole", steps.ecole));
+}
+
+}  // namespace
+
+auto LatencyResult::csv_title() -> std::string {
+	return merge_csv(
+		make_csv("n_vars", "n_cons", "dynamics", "operation", "part"),
+		make_csv("n_samples", "mean_ns", "p50_ns", "p90_ns", "p99_ns", "p999_ns", "max_ns"));
+}
+
+auto LatencyResult::csv() -> std::string {
+	return merge_csv(
+		make_csv(n_vars, n_cons, dynamics, operation, part),
+		make_csv(n_samples, mean_ns, p50_ns, p90_ns, p99_ns, p999_ns, max_ns));
+}
+
+auto benchmark_latency(std::vector<scip::Model> const& models, std::size_t n_episodes) -> std::vector<LatencyResult> {
+	auto results = std::vector<LatencyResult>{};
+	measure_latency<environment::Branching<>>(
+		models, n_episodes, "branching", true, [](auto const& action_set) { return action_set.value()[0]; }, results);
+	measure_latency<environment::Configuring<>>(
+		models,
+		n_episodes,
+		"configuring",
+		false,
+		[](auto const& /*action_set*/) { return dynamics::ParamDict{}; },
+		results);
+	measure_latency<environment::PrimalSearch<>>(
+		models,
+		n_episodes,
+		"primal_search",
+		true,
+		[](auto const& /*action_set*/) { return dynamics::PrimalSearchDynamics::Action{}; },
+		results);
+	measure_latency<NodeSelection>(
+		models,
+		n_episodes,
+		"node_selection",
+		true,
+		[](auto const& /*action_set*/) { return dynamics::NodeSelectionDynamics::Action{Default}; },
+		results);
+	measure_latency<CutSelection>(
+		models,
+		n_episodes,
+		"cut_selection",
+		true,
+		[](auto const& /*action_set*/) { return dynamics::CutSelectionDynamics::Action{Default}; },
+		results);
+	return results;
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ecole/scip/model.hpp"
+
+namespace ecole::benchmark {
+
+/** The distribution of the latency of one part of the resets or steps of an environment. */
+struct LatencyResult {
+	std::size_t n_vars = 0;
+	std::size_t n_cons = 0;
+	std::string dynamics;
+	/** Either ``reset`` or ``step``. */
+	std::string operation;
+	/** Either ``total``, ``solver`` for the time SCIP spent solving, or ``ecole`` for the rest. */
+	std::string part;
+	std::size_t n_samples = 0;
+	double mean_ns = 0.;
+	double p50_ns = 0.;
+	double p90_ns = 0.;
+	double p99_ns = 0.;
+	double p999_ns = 0.;
+	double max_ns = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the distribution of reset and step latencies of the environment of every dynamics.
+ *
+ * Every environment runs ``n_episodes`` episodes on every model with its default observation, reward, and information
+ * functions, taking the first or default action.
+ * Every reset and step is recorded in latency histograms, as a whole and split into the time the solver spent solving
+ * and the Ecole overhead, which includes the extraction of observations and the handoffs of iterative solving.
+ * Percentiles rather than means show regressions in tail latency, such as from contention on the allocator or locks.
+ */
+auto benchmark_latency(std::vector<scip::Model> const& models, std::size_t n_episodes) -> std::vector<LatencyResult>;
+
+}  // namespace ecole::benchmark
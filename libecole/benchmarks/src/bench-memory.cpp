@@ -0,0 +1,111 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <scip/scip.h>
+
+#include "ecole/observation/hutter-2011.hpp"
+#include "ecole/observation/khalil-2016.hpp"
+#include "ecole/observation/milp-bipartite.hpp"
+#include "ecole/observation/node-bipartite.hpp"
+#include "ecole/scip/callback.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "bench-memory.hpp"
+#include "csv.hpp"
+#include "memory.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+/** The observation functions whose size is measured, reset on the model being solved. */
+struct Observations {
+	observation::MilpBipartite milp_bipartite;
+	observation::Hutter2011 hutter_2011;
+	observation::NodeBipartite node_bipartite;
+	observation::Khalil2016 khalil_2016;
+
+	explicit Observations(scip::Model& model) {
+		milp_bipartite.before_reset(model);
+		hutter_2011.before_reset(model);
+		node_bipartite.before_reset(model);
+		khalil_2016.before_reset(model);
+	}
+};
+
+/** Measure the memory of the model, and extract the observations of the stage to measure their size. */
+auto measure_memory(scip::Model& model, std::string stage, std::int64_t resident_before, Observations* observations)
+	-> MemoryResult {
+	auto* const scip = model.get_scip_ptr();
+	auto result = MemoryResult{};
+	result.stage = std::move(stage);
+	result.resident_bytes = resident_bytes() - resident_before;
+	result.scip_used_bytes = static_cast<std::int64_t>(SCIPgetMemUsed(scip));
+	result.scip_total_bytes = static_cast<std::int64_t>(SCIPgetMemTotal(scip));
+	if (observations != nullptr) {
+		result.milp_bipartite_bytes = bytes_of(observations->milp_bipartite.extract(model, false));
+		result.hutter_2011_bytes = bytes_of(observations->hutter_2011.extract(model, false));
+		if (model.stage() == SCIP_STAGE_SOLVING) {
+			result.node_bipartite_bytes = bytes_of(observations->node_bipartite.extract(model, false));
+			result.khalil_2016_bytes = bytes_of(observations->khalil_2016.extract(model, false));
+		}
+	}
+	return result;
+}
+
+}  // namespace
+
+auto MemoryResult::csv_title() -> std::string {
+	return merge_csv(
+		make_csv("n_vars", "n_cons", "stage", "resident_bytes", "scip_used_bytes", "scip_total_bytes"),
+		make_csv("milp_bipartite_bytes", "hutter_2011_bytes", "node_bipartite_bytes", "khalil_2016_bytes"));
+}
+
+auto MemoryResult::csv() -> std::string {
+	return merge_csv(
+		make_csv(n_vars, n_cons, stage, resident_bytes, scip_used_bytes, scip_total_bytes),
+		make_csv(milp_bipartite_bytes, hutter_2011_bytes, node_bipartite_bytes, khalil_2016_bytes));
+}
+
+auto benchmark_memory(scip::Model const& model, std::size_t n_nodes) -> std::vector<MemoryResult> {
+	auto const filename = std::filesystem::temp_directory_path() / "ecole-bench-memory.mps";
+	model.write_problem(filename);
+	auto results = std::vector<MemoryResult>{};
+
+	auto const resident_before = resident_bytes();
+	auto file_model = scip::Model::from_file(filename);
+	std::filesystem::remove(filename);
+	file_model.set_params(model.get_changed_params());
+	results.push_back(measure_memory(file_model, "file", resident_before, nullptr));
+	{
+		auto const resident_before_copy = resident_bytes();
+		auto copy = file_model.copy_orig();
+		results.push_back(measure_memory(copy, "copy", resident_before_copy, nullptr));
+	}
+
+	auto observations = Observations{file_model};
+	file_model.presolve();
+	results.push_back(measure_memory(file_model, "presolved", resident_before, &observations));
+	auto fcall = file_model.solve_iter(scip::callback::BranchruleConstructor{});
+	if (fcall.has_value()) {
+		results.push_back(measure_memory(file_model, "root", resident_before, &observations));
+	}
+	for (std::size_t node = 0; fcall.has_value() && node < n_nodes; ++node) {
+		fcall = file_model.solve_iter_continue(SCIP_DIDNOTRUN);
+	}
+	if (fcall.has_value()) {
+		results.push_back(measure_memory(file_model, "branching", resident_before, &observations));
+	}
+	// The size of the original problem, since presolving changes the one of the model
+	for (auto& result : results) {
+		result.n_vars = model.variables().size();
+		result.n_cons = model.constraints().size();
+	}
+	return results;
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ecole/scip/model.hpp"
+
+namespace ecole::benchmark {
+
+/** The memory used by a model at one stage of its solving, and the size of the observations extracted there. */
+struct MemoryResult {
+	std::size_t n_vars = 0;
+	std::size_t n_cons = 0;
+	/** One of ``file``, ``copy``, ``presolved``, ``root``, or ``branching``. */
+	std::string stage;
+	/** Increase of the resident memory of the process since before the model was read, or zero if not available. */
+	std::int64_t resident_bytes = 0;
+	/** Memory used by the block memory of SCIP, and allocated by SCIP in total. */
+	std::int64_t scip_used_bytes = 0;
+	std::int64_t scip_total_bytes = 0;
+	/** Size of the tensors of the observations, zero for node observations outside of the solving stage. */
+	std::size_t milp_bipartite_bytes = 0;
+	std::size_t hutter_2011_bytes = 0;
+	std::size_t node_bipartite_bytes = 0;
+	std::size_t khalil_2016_bytes = 0;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark how the memory of a model and the size of its observations grow while it is solved.
+ *
+ * The model is written to a file and read back, then copied, presolved, solved up to the root branching, and solved
+ * for another ``n_nodes`` branching nodes with SCIP default rule.
+ * Memory freed by SCIP is not always given back to the system, so that the increase of the resident memory is an
+ * upper bound of the memory of the model.
+ */
+auto benchmark_memory(scip::Model const& model, std::size_t n_nodes) -> std::vector<MemoryResult>;
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,80 @@
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench-model.hpp"
+#include "csv.hpp"
+#include "memory.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+auto profile_name(scip::PluginProfile profile) -> std::string {
+	switch (profile) {
+	case scip::PluginProfile::full:
+		return "full";
+	case scip::PluginProfile::branching:
+		return "branching";
+	case scip::PluginProfile::modeling:
+		return "modeling";
+	}
+	return "";
+}
+
+template <typename Func> auto measure_model(std::string profile, std::string source, std::size_t n_models, Func make) {
+	auto models = std::vector<scip::Model>{};
+	models.reserve(n_models);
+	auto const resident_before = resident_bytes();
+	auto const wall_time_before = std::chrono::steady_clock::now();
+	for (std::size_t i = 0; i < n_models; ++i) {
+		models.push_back(make());
+	}
+	auto const wall_time_after = std::chrono::steady_clock::now();
+	auto const resident_after = resident_bytes();
+	return ModelResult{
+		std::move(profile),
+		std::move(source),
+		n_models,
+		std::chrono::duration<double>(wall_time_after - wall_time_before).count(),
+		static_cast<double>(resident_after - resident_before) / static_cast<double>(n_models),
+	};
+}
+
+}  // namespace
+
+auto ModelResult::csv_title() -> std::string {
+	return make_csv("profile", "source", "n_models", "wall_time_s", "models_per_s", "resident_bytes_per_model");
+}
+
+auto ModelResult::csv() -> std::string {
+	auto const models_per_s = wall_time_s > 0 ? static_cast<double>(n_models) / wall_time_s : 0.;
+	return make_csv(profile, source, n_models, wall_time_s, models_per_s, resident_bytes_per_model);
+}
+
+auto benchmark_model(scip::Model const& model, std::size_t n_models) -> std::vector<ModelResult> {
+	using scip::PluginProfile;
+	auto constexpr profiles = std::array{PluginProfile::full, PluginProfile::branching, PluginProfile::modeling};
+	// Models are read back with the plugins of every profile
+	auto const filename = std::filesystem::temp_directory_path() / "ecole-bench-model.mps";
+	model.write_problem(filename);
+	auto results = std::vector<ModelResult>{};
+	for (auto const profile : profiles) {
+		results.push_back(measure_model(profile_name(profile), "empty", n_models, [profile] {
+			return scip::Model::prob_basic("Model", profile);
+		}));
+		results.push_back(measure_model(profile_name(profile), "file", n_models, [&filename, profile] {
+			return scip::Model::from_file(filename, profile);
+		}));
+		// Copies keep the plugins of their source
+		auto const source = scip::Model::from_file(filename, profile);
+		results.push_back(measure_model(profile_name(profile), "copy", n_models, [&source] { return source.copy_orig(); }));
+	}
+	std::filesystem::remove(filename);
+	return results;
+}
+
+}  // namespace ecole::benchmark
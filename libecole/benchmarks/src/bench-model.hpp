@@ -0,0 +1,31 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ecole/scip/model.hpp"
+
+namespace ecole::benchmark {
+
+struct ModelResult {
+	std::string profile;
+	std::string source;
+	std::size_t n_models = 0;
+	double wall_time_s = 0.;
+	/** Increase of the resident memory while all models are alive, or zero where it cannot be measured. */
+	double resident_bytes_per_model = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the construction of models with every plugin profile.
+ *
+ * Models are created empty, by reading the given model from a file, and by copying it.
+ * All models of a measure are kept alive so that the memory they use adds up.
+ */
+auto benchmark_model(scip::Model const& model, std::size_t n_models) -> std::vector<ModelResult>;
+
+}  // namespace ecole::benchmark
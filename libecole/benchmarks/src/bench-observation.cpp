@@ -0,0 +1,148 @@
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <scip/scip.h>
+
+#include "ecole/observation/hutter-2011.hpp"
+#include "ecole/observation/khalil-2016.hpp"
+#include "ecole/observation/milp-bipartite.hpp"
+#include "ecole/observation/node-bipartite.hpp"
+#include "ecole/observation/pseudocosts.hpp"
+#include "ecole/observation/strong-branching-scores.hpp"
+#include "ecole/reward/abstract.hpp"
+#include "ecole/reward/bound-integral.hpp"
+#include "ecole/reward/is-done.hpp"
+#include "ecole/reward/lp-iterations.hpp"
+#include "ecole/reward/n-nodes.hpp"
+#include "ecole/reward/solving-time.hpp"
+#include "ecole/scip/callback.hpp"
+#include "ecole/utility/chrono.hpp"
+
+#include "allocations.hpp"
+#include "bench-observation.hpp"
+#include "csv.hpp"
+#include "memory.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+/***********************************
+ *  Measure of single extractions  *
+ ***********************************/
+
+template <typename DataFunc>
+auto measure_extraction(
+	std::string kind,
+	std::string name,
+	DataFunc& data_func,
+	scip::Model& model,
+	std::int64_t node) -> ObservationResult {
+	auto const counting = CountAllocations{};
+	auto const allocations_before = allocations();
+	auto const cpu_time_before = utility::cpu_clock::now();
+	auto const wall_time_before = std::chrono::steady_clock::now();
+	auto const data = data_func.extract(model, false);
+	auto const wall_time_after = std::chrono::steady_clock::now();
+	auto const cpu_time_after = utility::cpu_clock::now();
+	auto const allocated = allocations() - allocations_before;
+
+	return {
+		std::move(kind),
+		std::move(name),
+		model.variables().size(),
+		model.constraints().size(),
+		node,
+		std::chrono::duration<double>(wall_time_after - wall_time_before).count(),
+		std::chrono::duration<double>(cpu_time_after - cpu_time_before).count(),
+		allocated.n_allocations,
+		allocated.n_bytes,
+		bytes_of(data),
+	};
+}
+
+/** Apply func on each element of the tuple. */
+template <typename Tuple, typename Func> void for_each(Tuple& t, Func&& func) {
+	std::apply([&func](auto&... t_elem) { (func(t_elem), ...); }, t);
+}
+
+}  // namespace
+
+auto ObservationResult::csv_title() -> std::string {
+	return make_csv(
+		"kind",
+		"function",
+		"n_vars",
+		"n_cons",
+		"node",
+		"wall_time_s",
+		"cpu_time_s",
+		"n_allocations",
+		"allocated_bytes",
+		"observation_bytes");
+}
+
+auto ObservationResult::csv() -> std::string {
+	return make_csv(
+		kind,
+		function,
+		n_vars,
+		n_cons,
+		node,
+		wall_time_s,
+		cpu_time_s,
+		n_allocations,
+		allocated_bytes,
+		observation_bytes);
+}
+
+auto benchmark_observation(scip::Model model, std::size_t n_nodes) -> std::vector<ObservationResult> {
+	auto problem_funcs = std::tuple{
+		std::pair{"MilpBipartite", observation::MilpBipartite{}},
+		std::pair{"Hutter2011", observation::Hutter2011{}},
+	};
+	auto node_funcs = std::tuple{
+		std::pair{"NodeBipartite", observation::NodeBipartite{}},
+		std::pair{"Khalil2016", observation::Khalil2016{}},
+		std::pair{"Pseudocosts", observation::Pseudocosts{}},
+		std::pair{"StrongBranchingScores", observation::StrongBranchingScores{}},
+	};
+	auto reward_funcs = std::tuple{
+		std::pair{"IsDone", reward::IsDone{}},
+		std::pair{"LpIterations", reward::LpIterations{}},
+		std::pair{"NNodes", reward::NNodes{}},
+		std::pair{"SolvingTime", reward::SolvingTime{}},
+		std::pair{"DualIntegral", reward::DualIntegral{}},
+		std::pair{"PrimalIntegral", reward::PrimalIntegral{}},
+		std::pair{"PrimalDualIntegral", reward::PrimalDualIntegral{}},
+	};
+	auto before_reset = [&model](auto& name_func) { name_func.second.before_reset(model); };
+	for_each(problem_funcs, before_reset);
+	for_each(node_funcs, before_reset);
+	for_each(reward_funcs, before_reset);
+
+	auto results = std::vector<ObservationResult>{};
+	for_each(problem_funcs, [&](auto& name_func) {
+		results.push_back(measure_extraction("observation", name_func.first, name_func.second, model, -1));
+	});
+
+	auto fcall = model.solve_iter(scip::callback::BranchruleConstructor{});
+	for (std::size_t node = 0; fcall.has_value() && node < n_nodes; ++node) {
+		auto const node_number = static_cast<std::int64_t>(node);
+		for_each(node_funcs, [&](auto& name_func) {
+			results.push_back(measure_extraction("observation", name_func.first, name_func.second, model, node_number));
+		});
+		for_each(reward_funcs, [&](auto& name_func) {
+			results.push_back(measure_extraction("reward", name_func.first, name_func.second, model, node_number));
+		});
+		fcall = model.solve_iter_continue(SCIP_DIDNOTRUN);
+	}
+	return results;
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "ecole/scip/model.hpp"
+
+namespace ecole::benchmark {
+
+struct ObservationResult {
+	/** Either "observation" or "reward". */
+	std::string kind;
+	std::string function;
+	std::size_t n_vars = 0;
+	std::size_t n_cons = 0;
+	/** The node on which the data is extracted, or -1 for observations of the problem before solving. */
+	std::int64_t node = -1;
+	double wall_time_s = 0.;
+	double cpu_time_s = 0.;
+	/** Allocations made through the global operator new during the extraction. */
+	std::size_t n_allocations = 0;
+	std::size_t allocated_bytes = 0;
+	/** Size of the tensors in the observation, zero for rewards. */
+	std::size_t observation_bytes = 0;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the cost of a single extraction of every observation and reward function.
+ *
+ * MilpBipartite and Hutter2011 are extracted once on the problem, before solving.
+ * Node observation functions (NodeBipartite, Khalil2016, Pseudocosts, and StrongBranchingScores last since it solves
+ * LPs) and the reward functions are extracted on the same first ``n_nodes`` branching nodes, before branching with
+ * SCIP default rule.
+ * The allocations made while solving between nodes, such as the growth of the bound integrals history, are not
+ * attributed to the extractions.
+ */
+auto benchmark_observation(scip::Model model, std::size_t n_nodes) -> std::vector<ObservationResult>;
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,184 @@
+#include <chrono>
+#include <cstddef>
+#include <string>
+#include <tuple>
+#include <utility>
+
+#include <objscip/objbranchrule.h>
+#include <scip/scip.h>
+
+#include "ecole/dynamics/branching.hpp"
+#include "ecole/information/solver-statistics.hpp"
+#include "ecole/observation/node-bipartite.hpp"
+#include "ecole/reward/n-nodes.hpp"
+#include "ecole/scip/callback.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "bench-overhead.hpp"
+#include "branching/index-branchrule.hpp"
+#include "branching/lambda-branchrule.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+/** Accumulate the wall time of the calls to a function. */
+class Stopwatch {
+public:
+	template <typename Func> auto time(Func&& func) {
+		auto const before = std::chrono::steady_clock::now();
+		struct Accumulate {
+			Stopwatch& stopwatch;
+			std::chrono::steady_clock::time_point before;
+			~Accumulate() { stopwatch.total += std::chrono::steady_clock::now() - before; }
+		} accumulate{*this, before};
+		return func();
+	}
+
+	[[nodiscard]] auto seconds() const -> double { return std::chrono::duration<double>(total).count(); }
+
+private:
+	std::chrono::steady_clock::duration total{0};
+};
+
+/** Solve natively with a branch rule leaving every decision to SCIP, returning the number of calls and the time. */
+auto measure_native_callbacks(scip::Model model) -> std::tuple<std::size_t, double> {
+	auto n_callbacks = std::size_t{0};
+	auto count = [&n_callbacks](SCIP* /*scip*/) {
+		++n_callbacks;
+		return SCIP_DIDNOTRUN;
+	};
+	auto* branch_rule = new scip::LambdaBranchrule{model.get_scip_ptr(), "CountingBranching", std::move(count)};
+	SCIPincludeObjBranchrule(model.get_scip_ptr(), branch_rule, true);
+	// NOLINTNEXTLINE dynamically allocated object ownership is given to SCIP
+	auto stopwatch = Stopwatch{};
+	stopwatch.time([&model] { model.solve(); });
+	return {n_callbacks, stopwatch.seconds()};
+}
+
+/** Solve the same search iteratively, with a round trip to this thread on every LP branching. */
+auto measure_iterative_callbacks(scip::Model model) -> std::tuple<std::size_t, double> {
+	auto constructor = scip::callback::BranchruleConstructor{};
+	constructor.yield_external = false;
+	constructor.yield_pseudo = false;
+	auto n_callbacks = std::size_t{0};
+	auto stopwatch = Stopwatch{};
+	stopwatch.time([&] {
+		auto fcall = model.solve_iter(constructor);
+		while (fcall.has_value()) {
+			++n_callbacks;
+			fcall = model.solve_iter_continue(SCIP_DIDNOTRUN);
+		}
+	});
+	return {n_callbacks, stopwatch.seconds()};
+}
+
+auto measure_branching_rule(scip::Model model) -> double {
+	auto* branch_rule = new ecole::scip::IndexBranchrule{model.get_scip_ptr(), "FirstVarBranching", 0UL};
+	SCIPincludeObjBranchrule(model.get_scip_ptr(), branch_rule, true);
+	// NOLINTNEXTLINE dynamically allocated object ownership is given to SCIP
+	auto stopwatch = Stopwatch{};
+	stopwatch.time([&model] { model.solve(); });
+	return stopwatch.seconds();
+}
+
+/** Run a branching environment by hand, branching on the first candidate, to time every part of the steps. */
+void measure_environment(scip::Model model, OverheadResult& result) {
+	auto dynamics = dynamics::BranchingDynamics{};
+	auto observation_function = observation::NodeBipartite{};
+	auto reward_function = reward::NNodes{};
+	auto information_function = information::SolverStatistics{};
+	auto dynamics_watch = Stopwatch{};
+	auto observation_watch = Stopwatch{};
+	auto reward_watch = Stopwatch{};
+	auto information_watch = Stopwatch{};
+
+	observation_function.before_reset(model);
+	reward_function.before_reset(model);
+	information_function.before_reset(model);
+	// Not a structured binding, since those cannot be captured in lambdas
+	auto done = false;
+	auto action_set = dynamics::BranchingDynamics::ActionSet{};
+	std::tie(done, action_set) = dynamics_watch.time([&] { return dynamics.reset_dynamics(model); });
+	auto extract_all = [&](bool is_done) {
+		reward_watch.time([&] { return reward_function.extract(model, is_done); });
+		if (!is_done) {
+			observation_watch.time([&] { return observation_function.extract(model, is_done); });
+		}
+		information_watch.time([&] { return information_function.extract(model, is_done); });
+	};
+	extract_all(done);
+	while (!done) {
+		std::tie(done, action_set) =
+			dynamics_watch.time([&] { return dynamics.step_dynamics(model, action_set.value()[0]); });
+		extract_all(done);
+		++result.n_steps;
+	}
+
+	result.dynamics_wall_time_s = dynamics_watch.seconds();
+	result.observation_wall_time_s = observation_watch.seconds();
+	result.reward_wall_time_s = reward_watch.seconds();
+	result.information_wall_time_s = information_watch.seconds();
+}
+
+}  // namespace
+
+auto OverheadResult::csv_title() -> std::string {
+	return merge_csv(
+		make_csv(
+			"n_vars",
+			"n_cons",
+			"n_callbacks",
+			"native_callback_wall_time_s",
+			"iterative_callback_wall_time_s",
+			"callback_overhead_ns"),
+		make_csv(
+			"n_steps",
+			"branching_rule_wall_time_s",
+			"dynamics_wall_time_s",
+			"observation_wall_time_s",
+			"reward_wall_time_s",
+			"information_wall_time_s",
+			"handoff_wall_time_s",
+			"handoff_fraction_of_gap"));
+}
+
+auto OverheadResult::csv() -> std::string {
+	auto const per_call = [](double total_s, std::size_t n_calls) {
+		return n_calls > 0 ? total_s * 1e9 / static_cast<double>(n_calls) : 0.;  // NOLINT(readability-magic-numbers)
+	};
+	auto const handoff = dynamics_wall_time_s - branching_rule_wall_time_s;
+	auto const gap = dynamics_wall_time_s + observation_wall_time_s + reward_wall_time_s + information_wall_time_s -
+					 branching_rule_wall_time_s;
+	return merge_csv(
+		make_csv(
+			n_vars,
+			n_cons,
+			n_callbacks,
+			native_callback_wall_time_s,
+			iterative_callback_wall_time_s,
+			per_call(iterative_callback_wall_time_s - native_callback_wall_time_s, n_callbacks)),
+		make_csv(
+			n_steps,
+			branching_rule_wall_time_s,
+			dynamics_wall_time_s,
+			observation_wall_time_s,
+			reward_wall_time_s,
+			information_wall_time_s,
+			handoff,
+			gap > 0 ? handoff / gap : 0.));
+}
+
+auto benchmark_overhead(scip::Model const& model) -> OverheadResult {
+	auto result = OverheadResult{};
+	result.n_vars = model.variables().size();
+	result.n_cons = model.constraints().size();
+	std::tie(result.n_callbacks, result.native_callback_wall_time_s) = measure_native_callbacks(model.copy_orig());
+	std::tie(std::ignore, result.iterative_callback_wall_time_s) = measure_iterative_callbacks(model.copy_orig());
+	result.branching_rule_wall_time_s = measure_branching_rule(model.copy_orig());
+	measure_environment(model.copy_orig(), result);
+	return result;
+}
+
+}  // namespace ecole::benchmark
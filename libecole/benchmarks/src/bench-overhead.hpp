@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "ecole/scip/model.hpp"
+
+namespace ecole::benchmark {
+
+/** Where the time of an environment goes, compared with solving with an equivalent branching rule. */
+struct OverheadResult {
+	std::size_t n_vars = 0;
+	std::size_t n_cons = 0;
+
+	/** Solving with a branching rule that leaves every decision to SCIP, natively and iteratively. */
+	std::size_t n_callbacks = 0;
+	double native_callback_wall_time_s = 0.;
+	double iterative_callback_wall_time_s = 0.;
+
+	/** Branching on the first candidate with the branching rule, and with the environment broken down in parts. */
+	std::size_t n_steps = 0;
+	double branching_rule_wall_time_s = 0.;
+	double dynamics_wall_time_s = 0.;
+	double observation_wall_time_s = 0.;
+	double reward_wall_time_s = 0.;
+	double information_wall_time_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the overhead of solving iteratively, and of every part of a step of a branching environment.
+ *
+ * The overhead of a callback is the difference between solving iteratively and natively the same search, divided by
+ * the number of callbacks.
+ * The handoff is the part of the dynamics time not spent by the branching rule, which is reported along with the
+ * fraction of the gap between the environment and the branching rule that it accounts for.
+ */
+auto benchmark_overhead(scip::Model const& model) -> OverheadResult;
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,131 @@
+#include <cstddef>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <objscip/objheur.h>
+#include <scip/scip.h>
+
+#include "ecole/dynamics/primal-search.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+#include "bench-primal-search.hpp"
+#include "csv.hpp"
+#include "heuristic/lambda-heur.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+/** The pseudo branching candidates, and their values in the current LP solution rounded to integers. */
+struct RoundedSolution {
+	std::vector<std::size_t> indices;
+	std::vector<SCIP_Real> values;
+
+	void update(SCIP* scip) {
+		SCIP_VAR** cands = nullptr;
+		int n_cands = 0;
+		scip::call(SCIPgetPseudoBranchCands, scip, &cands, &n_cands, nullptr);
+		indices.resize(static_cast<std::size_t>(n_cands));
+		values.resize(static_cast<std::size_t>(n_cands));
+		for (std::size_t i = 0; i < indices.size(); ++i) {
+			indices[i] = static_cast<std::size_t>(SCIPvarGetProbindex(cands[i]));
+			values[i] = SCIPfeasRound(scip, SCIPgetSolVal(scip, nullptr, cands[i]));
+		}
+	}
+
+	[[nodiscard]] auto action() const -> dynamics::PrimalSearchDynamics::Action { return {indices, values}; }
+};
+
+/** Fix the variables in probing, solve the LP, and try its solution, as PrimalSearchDynamics does. */
+auto try_solution(SCIP* scip, SCIP_HEUR* heur, RoundedSolution const& solution) -> SCIP_RESULT {
+	SCIP_VAR** vars = SCIPgetVars(scip);
+	SCIP_Bool lperror = false;
+	SCIP_Bool cutoff = false;
+	SCIP_Bool solution_kept = false;
+	scip::call(SCIPstartProbing, scip);
+	scip::call(SCIPnewProbingNode, scip);
+	for (std::size_t i = 0; i < solution.indices.size(); ++i) {
+		scip::call(SCIPfixVarProbing, scip, vars[solution.indices[i]], solution.values[i]);
+	}
+	scip::call(SCIPpropagateProbing, scip, 0, &cutoff, nullptr);
+	if (!cutoff && !SCIPisLPConstructed(scip)) {
+		scip::call(SCIPconstructLP, scip, &cutoff);
+	}
+	if (!cutoff) {
+		scip::call(SCIPsolveProbingLP, scip, -1, &lperror, &cutoff);
+		if (!lperror && !cutoff) {
+			SCIP_SOL* sol = nullptr;
+			scip::call(SCIPcreateSol, scip, &sol, heur);
+			scip::call(SCIPlinkLPSol, scip, sol);
+			scip::call(SCIPtrySolFree, scip, &sol, false, true, true, true, true, &solution_kept);
+		}
+	}
+	scip::call(SCIPbacktrackProbing, scip, 0);
+	scip::call(SCIPendProbing, scip);
+	return solution_kept ? SCIP_FOUNDSOL : SCIP_DIDNOTFIND;
+}
+
+auto measure_primal_search_dynamics(scip::Model model, std::size_t& n_calls) -> Metrics {
+	return measure_on_model(
+		[&n_calls](scip::Model& m) {
+			auto dyn = dynamics::PrimalSearchDynamics{};
+			auto solution = RoundedSolution{};
+			n_calls = 0;
+			auto [done, action_set] = dyn.reset_dynamics(m);
+			while (!done) {
+				solution.update(m.get_scip_ptr());
+				std::tie(done, action_set) = dyn.step_dynamics(m, solution.action());
+				++n_calls;
+			}
+		},
+		std::move(model));
+}
+
+auto measure_heuristic(scip::Model model) -> Metrics {
+	return measure_on_model(
+		[](scip::Model& m) {
+			auto heuristic = [solution = RoundedSolution{}](SCIP* scip, SCIP_HEUR* heur) mutable {
+				solution.update(scip);
+				return try_solution(scip, heur, solution);
+			};
+			auto* heur = new scip::LambdaHeur{m.get_scip_ptr(), "RoundedLpHeuristic", std::move(heuristic)};
+			SCIPincludeObjHeur(m.get_scip_ptr(), heur, true);
+			// NOLINTNEXTLINE dynamically allocated object ownership is given to SCIP
+			m.solve();
+		},
+		std::move(model));
+}
+
+}  // namespace
+
+auto PrimalSearchResult::csv_title() -> std::string {
+	return merge_csv(
+		InstanceFeatures::csv_title(),
+		make_csv("n_calls", "call_overhead_us"),
+		Metrics::csv_title("primal_search_dynamics:"),
+		Metrics::csv_title("heuristic:"));
+}
+
+auto PrimalSearchResult::csv() -> std::string {
+	auto const overhead_s = primal_search_dynamics_metrics.wall_time_s - heuristic_metrics.wall_time_s;
+	auto const overhead_us = n_calls > 0 ? overhead_s * 1e6 / static_cast<double>(n_calls) : 0.;  // NOLINT
+	return merge_csv(
+		instance.csv(), make_csv(n_calls, overhead_us), primal_search_dynamics_metrics.csv(), heuristic_metrics.csv());
+}
+
+auto benchmark_primal_search(scip::Model const& model, std::size_t n_warmups, std::size_t n_trials)
+	-> PrimalSearchResult {
+	auto n_calls = std::size_t{0};
+	auto dynamics_metrics = Metrics::repeat(
+		[&] { return measure_primal_search_dynamics(model.copy_orig(), n_calls); }, n_warmups, n_trials);
+	return {
+		InstanceFeatures::from_model(model.copy_orig()),
+		n_calls,
+		dynamics_metrics,
+		Metrics::repeat([&model] { return measure_heuristic(model.copy_orig()); }, n_warmups, n_trials),
+	};
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+#include "ecole/scip/model.hpp"
+
+#include "benchmark.hpp"
+
+namespace ecole::benchmark {
+
+struct PrimalSearchResult {
+	InstanceFeatures instance;
+	/** Number of heuristic calls, that is steps of the dynamics, in the last trial. */
+	std::size_t n_calls = 0;
+	Metrics primal_search_dynamics_metrics;
+	Metrics heuristic_metrics;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark the primal search dynamics against a native heuristic doing the same search on a given model.
+ *
+ * At every node, both fix the pseudo branching candidates to their rounded LP values, solve the LP in probing, and
+ * submit its solution.
+ * The difference of their wall times, divided by the number of calls, is the overhead of a heuristic call in Ecole.
+ * Both are run ``n_trials`` times on copies of the model, after ``n_warmups`` untimed runs.
+ */
+auto benchmark_primal_search(scip::Model const& model, std::size_t n_warmups = 0, std::size_t n_trials = 1)
+	-> PrimalSearchResult;
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,116 @@
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include "ecole/environment/branching.hpp"
+
+#include "bench-scaling.hpp"
+#include "csv.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+struct ThreadMetrics {
+	std::size_t n_resets = 0;
+	std::size_t n_steps = 0;
+	std::chrono::steady_clock::duration reset_time{0};
+	std::chrono::steady_clock::duration step_time{0};
+};
+
+/** Run episodes of a Branching environment, starting from the given model index. */
+auto run_episodes(std::vector<scip::Model> const& models, std::size_t first_model, std::size_t n_episodes)
+	-> ThreadMetrics {
+	auto env = environment::Branching<>{};
+	auto metrics = ThreadMetrics{};
+	for (std::size_t i = 0; i < n_episodes; ++i) {
+		auto const reset_before = std::chrono::steady_clock::now();
+		auto [obs, action_set, reward, done, info] = env.reset(models[(first_model + i) % models.size()]);
+		metrics.reset_time += std::chrono::steady_clock::now() - reset_before;
+		++metrics.n_resets;
+		while (!done) {
+			auto const step_before = std::chrono::steady_clock::now();
+			std::tie(obs, action_set, reward, done, info) = env.step(action_set.value()[0]);
+			metrics.step_time += std::chrono::steady_clock::now() - step_before;
+			++metrics.n_steps;
+		}
+	}
+	return metrics;
+}
+
+auto measure_scaling(std::vector<scip::Model> const& models, std::size_t n_threads, std::size_t n_episodes_per_thread)
+	-> ScalingResult {
+	auto const wall_time_before = std::chrono::steady_clock::now();
+	auto futures = std::vector<std::future<ThreadMetrics>>{};
+	futures.reserve(n_threads);
+	for (std::size_t i = 0; i < n_threads; ++i) {
+		futures.push_back(std::async(std::launch::async, run_episodes, std::cref(models), i, n_episodes_per_thread));
+	}
+	auto result = ScalingResult{};
+	auto reset_time = std::chrono::steady_clock::duration{0};
+	auto step_time = std::chrono::steady_clock::duration{0};
+	for (auto& fut : futures) {
+		auto const metrics = fut.get();
+		result.n_resets += metrics.n_resets;
+		result.n_steps += metrics.n_steps;
+		reset_time += metrics.reset_time;
+		step_time += metrics.step_time;
+	}
+	auto const wall_time_after = std::chrono::steady_clock::now();
+
+	result.n_vars = models.front().variables().size();
+	result.n_cons = models.front().constraints().size();
+	result.n_threads = n_threads;
+	result.wall_time_s = std::chrono::duration<double>(wall_time_after - wall_time_before).count();
+	result.reset_wall_time_s = std::chrono::duration<double>(reset_time).count();
+	result.step_wall_time_s = std::chrono::duration<double>(step_time).count();
+	return result;
+}
+
+}  // namespace
+
+auto ScalingResult::csv_title() -> std::string {
+	return merge_csv(
+		make_csv("n_vars", "n_cons", "n_threads", "n_resets", "n_steps", "wall_time_s"),
+		make_csv(
+			"reset_wall_time_s",
+			"step_wall_time_s",
+			"resets_per_s",
+			"steps_per_s",
+			"resets_per_s_per_thread",
+			"steps_per_s_per_thread"));
+}
+
+auto ScalingResult::csv() -> std::string {
+	auto const rate = [](std::size_t count, double time_s) {
+		return time_s > 0 ? static_cast<double>(count) / time_s : 0.;
+	};
+	// Threads reset and step concurrently, so the aggregated throughput divides by the time of an average thread
+	auto const n_threads_d = static_cast<double>(n_threads);
+	return merge_csv(
+		make_csv(n_vars, n_cons, n_threads, n_resets, n_steps, wall_time_s),
+		make_csv(
+			reset_wall_time_s,
+			step_wall_time_s,
+			rate(n_resets, reset_wall_time_s / n_threads_d),
+			rate(n_steps, step_wall_time_s / n_threads_d),
+			rate(n_resets, reset_wall_time_s),
+			rate(n_steps, step_wall_time_s)));
+}
+
+auto benchmark_scaling(
+	std::vector<scip::Model> const& models,
+	std::size_t max_threads,
+	std::size_t n_episodes_per_thread) -> std::vector<ScalingResult> {
+	auto results = std::vector<ScalingResult>{};
+	for (std::size_t n_threads = 1; n_threads <= max_threads; ++n_threads) {
+		results.push_back(measure_scaling(models, n_threads, n_episodes_per_thread));
+	}
+	return results;
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "ecole/scip/model.hpp"
+
+namespace ecole::benchmark {
+
+struct ScalingResult {
+	std::size_t n_vars = 0;
+	std::size_t n_cons = 0;
+	std::size_t n_threads = 0;
+	std::size_t n_resets = 0;
+	std::size_t n_steps = 0;
+	double wall_time_s = 0.;
+	/** Time spent in reset, and in step, summed over all threads. */
+	double reset_wall_time_s = 0.;
+	double step_wall_time_s = 0.;
+
+	static auto csv_title() -> std::string;
+	auto csv() -> std::string;
+};
+
+/**
+ * Benchmark how the throughput of independent Branching environments scales with the number of threads.
+ *
+ * For every number of threads up to ``max_threads``, every thread runs its own environment for
+ * ``n_episodes_per_thread`` episodes on the given models, branching on the first candidate.
+ * Threads sharing a global resource, such as a mutex or the allocator, show as a drop in resets or steps per second
+ * per thread.
+ */
+auto benchmark_scaling(
+	std::vector<scip::Model> const& models,
+	std::size_t max_threads,
+	std::size_t n_episodes_per_thread) -> std::vector<ScalingResult>;
+
+}  // namespace ecole::benchmark
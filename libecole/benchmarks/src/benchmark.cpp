@@ -1,7 +1,10 @@
 #include <algorithm>
+#include <cmath>
+#include <cstddef>
 #include <functional>
 #include <iterator>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -41,16 +44,68 @@ auto InstanceFeatures::csv() -> std::string {
 	return make_csv(n_vars, n_cons, root_nnz, root_n_cols, root_n_rows, name);
 }
 
+namespace {
+
+constexpr auto median = 0.5;
+constexpr auto p10 = 0.1;
+constexpr auto p90 = 0.9;
+
+/** Nearest rank percentile of sorted values. */
+template <typename T> auto percentile(std::vector<T> const& sorted, double fraction) -> T {
+	auto const rank = static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(sorted.size())));
+	return sorted[std::clamp<std::size_t>(rank, 1, sorted.size()) - 1];
+}
+
+template <typename T> auto sorted_measures(std::vector<Metrics> const& trials, T Metrics::*measure) -> std::vector<T> {
+	auto values = std::vector<T>{};
+	values.reserve(trials.size());
+	std::transform(trials.begin(), trials.end(), std::back_inserter(values), std::mem_fn(measure));
+	std::sort(values.begin(), values.end());
+	return values;
+}
+
+}  // namespace
+
+auto Metrics::summarize(std::vector<Metrics> const& trials) -> Metrics {
+	auto const wall_times = sorted_measures(trials, &Metrics::wall_time_s);
+	auto const cpu_times = sorted_measures(trials, &Metrics::cpu_time_s);
+	auto summary = Metrics{};
+	summary.wall_time_s = percentile(wall_times, median);
+	summary.cpu_time_s = percentile(cpu_times, median);
+	summary.n_nodes = percentile(sorted_measures(trials, &Metrics::n_nodes), median);
+	summary.n_lp_iterations = percentile(sorted_measures(trials, &Metrics::n_lp_iterations), median);
+	summary.n_trials = trials.size();
+	summary.wall_time_s_p10 = percentile(wall_times, p10);
+	summary.wall_time_s_p90 = percentile(wall_times, p90);
+	summary.cpu_time_s_p10 = percentile(cpu_times, p10);
+	summary.cpu_time_s_p90 = percentile(cpu_times, p90);
+	return summary;
+}
+
 auto Metrics::csv_title(std::string_view prefix) -> std::string {
 	return make_csv(
 		fmt::format("{}{}", prefix, "wall_time_s"),
 		fmt::format("{}{}", prefix, "cpu_time_s"),
 		fmt::format("{}{}", prefix, "n_nodes"),
-		fmt::format("{}{}", prefix, "n_lp_iterations"));
+		fmt::format("{}{}", prefix, "n_lp_iterations"),
+		fmt::format("{}{}", prefix, "n_trials"),
+		fmt::format("{}{}", prefix, "wall_time_s_p10"),
+		fmt::format("{}{}", prefix, "wall_time_s_p90"),
+		fmt::format("{}{}", prefix, "cpu_time_s_p10"),
+		fmt::format("{}{}", prefix, "cpu_time_s_p90"));
 }
 
 auto Metrics::csv() -> std::string {
-	return make_csv(wall_time_s, cpu_time_s, n_nodes, n_lp_iterations);
+	return make_csv(
+		wall_time_s,
+		cpu_time_s,
+		n_nodes,
+		n_lp_iterations,
+		n_trials,
+		wall_time_s_p10,
+		wall_time_s_p90,
+		cpu_time_s_p10,
+		cpu_time_s_p90);
 }
 
 }  // namespace ecole::benchmark
@@ -1,9 +1,15 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <string>
 #include <string_view>
+#include <vector>
+
+#include <scip/scip.h>
 
 #include "ecole/scip/model.hpp"
+#include "ecole/utility/chrono.hpp"
 
 namespace ecole::benchmark {
 
@@ -21,14 +27,62 @@ struct InstanceFeatures {
 	auto csv() -> std::string;
 };
 
+/**
+ * Measures of a run, or the summary of repeated trials.
+ *
+ * Summaries report the median of every measure, along with the 10th and 90th percentiles of times.
+ */
 struct Metrics {
 	double wall_time_s = 0.;
 	double cpu_time_s = 0.;
 	std::size_t n_nodes = 0;
 	std::size_t n_lp_iterations = 0;
+	std::size_t n_trials = 1;
+	double wall_time_s_p10 = wall_time_s;
+	double wall_time_s_p90 = wall_time_s;
+	double cpu_time_s_p10 = cpu_time_s;
+	double cpu_time_s_p90 = cpu_time_s;
+
+	/** Summarize the measures of repeated trials, of which there must be at least one. */
+	static auto summarize(std::vector<Metrics> const& trials) -> Metrics;
+
+	/**
+	 * Run a measure the given number of times, after untimed warmup runs, and summarize it.
+	 *
+	 * @param measure A function returning the metrics of a single trial.
+	 */
+	template <typename Func> static auto repeat(Func&& measure, std::size_t n_warmups, std::size_t n_trials) -> Metrics;
 
 	static auto csv_title(std::string_view prefix = "") -> std::string;
 	auto csv() -> std::string;
 };
 
+/** Measure a single run of a function solving the model. */
+template <typename Func> auto measure_on_model(Func&& func_to_bench, scip::Model model) -> Metrics {
+	auto const cpu_time_before = utility::cpu_clock::now();
+	auto const wall_time_before = std::chrono::steady_clock::now();
+	func_to_bench(model);
+	auto const wall_time_after = std::chrono::steady_clock::now();
+	auto const cpu_time_after = utility::cpu_clock::now();
+
+	return {
+		std::chrono::duration<double>(wall_time_after - wall_time_before).count(),
+		std::chrono::duration<double>(cpu_time_after - cpu_time_before).count(),
+		static_cast<std::size_t>(SCIPgetNTotalNodes(model.get_scip_ptr())),
+		static_cast<std::size_t>(SCIPgetNLPIterations(model.get_scip_ptr())),
+	};
+}
+
+template <typename Func> auto Metrics::repeat(Func&& measure, std::size_t n_warmups, std::size_t n_trials) -> Metrics {
+	for (std::size_t i = 0; i < n_warmups; ++i) {
+		measure();
+	}
+	auto trials = std::vector<Metrics>{};
+	trials.reserve(n_trials);
+	for (std::size_t i = 0; i < n_trials; ++i) {
+		trials.push_back(measure());
+	}
+	return summarize(trials);
+}
+
 }  // namespace ecole::benchmark
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <utility>
+
+#include <objscip/objheur.h>
+#include <scip/scip.h>
+
+namespace ecole::scip {
+
+/** A primal heuristic called with the same settings as the reverse heuristic of PrimalSearchDynamics. */
+template <typename Func> class LambdaHeur : public ::scip::ObjHeur {
+public:
+	static constexpr int max_priority = 536870911;
+	static constexpr int every_node = 1;
+	static constexpr int no_offset = 0;
+	static constexpr int no_maxdepth = -1;
+
+	LambdaHeur(SCIP* scip, const char* name, Func heuristic);
+
+	auto scip_exec(SCIP* scip, SCIP_HEUR* heur, SCIP_HEURTIMING heurtiming, SCIP_Bool nodeinfeasible, SCIP_RESULT* result)
+		-> SCIP_RETCODE override;
+
+private:
+	Func heuristic;
+};
+
+template <typename Func>
+scip::LambdaHeur<Func>::LambdaHeur(SCIP* scip, const char* name, Func heuristic_) :
+	::scip::ObjHeur(
+		scip,
+		name,
+		"Heuristic running a function in the solver.",
+		'e',
+		max_priority,
+		every_node,
+		no_offset,
+		no_maxdepth,
+		SCIP_HEURTIMING_AFTERNODE,
+		false),
+	heuristic(std::move(heuristic_)) {}
+
+template <typename Func>
+auto LambdaHeur<Func>::scip_exec(
+	SCIP* scip,
+	SCIP_HEUR* heur,
+	SCIP_HEURTIMING /*heurtiming*/,
+	SCIP_Bool /*nodeinfeasible*/,
+	SCIP_RESULT* result) -> SCIP_RETCODE {
+	try {
+		*result = heuristic(scip, heur);
+		return SCIP_OKAY;
+	} catch (...) {
+		*result = SCIP_DIDNOTRUN;
+		return SCIP_ERROR;
+	}
+}
+
+}  // namespace ecole::scip
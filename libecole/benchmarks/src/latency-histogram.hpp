@@ -0,0 +1,112 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace ecole::benchmark {
+
+/**
+ * A histogram of latencies with a bounded relative error, in the manner of HDR histograms.
+ *
+ * Latencies are counted in nanoseconds, exactly below ``2^sub_bucket_bits`` and otherwise in buckets whose width is
+ * a ``2^(1 - sub_bucket_bits)`` fraction of their values, so that a percentile is reported within 0.8% at any scale.
+ * All buckets are allocated upon construction: recording is a constant time increment that does not allocate, so that
+ * it does not disturb the allocator of the code being measured.
+ */
+class LatencyHistogram {
+public:
+	using Duration = std::chrono::nanoseconds;
+
+	LatencyHistogram() : counts(n_buckets, 0) {}
+
+	void record(Duration latency) noexcept {
+		auto const value = static_cast<std::uint64_t>(std::max(latency.count(), Duration::rep{0}));
+		++counts[bucket_of(value)];
+		++n_values;
+		total += value;
+		min_value = std::min(min_value, value);
+		max_value = std::max(max_value, value);
+	}
+
+	[[nodiscard]] auto count() const noexcept -> std::size_t { return n_values; }
+	[[nodiscard]] auto max() const noexcept -> Duration { return to_duration(n_values > 0 ? max_value : 0); }
+	[[nodiscard]] auto mean() const noexcept -> double {
+		return n_values > 0 ? static_cast<double>(total) / static_cast<double>(n_values) : 0.;
+	}
+
+	/** Smallest recorded value, up to the bucket precision, that at least the given fraction of values do not exceed. */
+	[[nodiscard]] auto percentile(double fraction) const noexcept -> Duration {
+		if (n_values == 0) {
+			return Duration{0};
+		}
+		auto const rank = std::clamp<std::size_t>(
+			static_cast<std::size_t>(std::ceil(fraction * static_cast<double>(n_values))), 1, n_values);
+		auto n_below = std::size_t{0};
+		for (std::size_t bucket = 0; bucket < counts.size(); ++bucket) {
+			n_below += counts[bucket];
+			if (n_below >= rank) {
+				return to_duration(std::clamp(highest_of(bucket), min_value, max_value));
+			}
+		}
+		return max();
+	}
+
+private:
+	static constexpr auto sub_bucket_bits = std::size_t{8};
+	static constexpr auto n_exact = std::uint64_t{1} << sub_bucket_bits;
+	static constexpr auto n_sub_buckets = n_exact / 2;
+	static constexpr auto max_shift = std::size_t{64} - sub_bucket_bits;
+	static constexpr auto n_buckets = static_cast<std::size_t>(n_exact + max_shift * n_sub_buckets);
+
+	std::vector<std::size_t> counts;
+	std::size_t n_values = 0;
+	std::uint64_t total = 0;
+	std::uint64_t min_value = std::numeric_limits<std::uint64_t>::max();
+	std::uint64_t max_value = 0;
+
+	static auto to_duration(std::uint64_t value) noexcept -> Duration {
+		return Duration{static_cast<Duration::rep>(value)};
+	}
+
+	/** Position of the most significant bit of a non zero value. */
+	static auto log2(std::uint64_t value) noexcept -> std::size_t {
+		auto exponent = std::size_t{0};
+		for (auto half = std::size_t{32}; half > 0; half /= 2) {
+			if (value >= (std::uint64_t{1} << half)) {
+				value >>= half;
+				exponent += half;
+			}
+		}
+		return exponent;
+	}
+
+	/** Values below n_exact have their own bucket, others share it with values of the same leading bits. */
+	static auto bucket_of(std::uint64_t value) noexcept -> std::size_t {
+		if (value < n_exact) {
+			return static_cast<std::size_t>(value);
+		}
+		auto const shift = log2(value) - (sub_bucket_bits - 1);
+		auto const leading = value >> shift;
+		return static_cast<std::size_t>(n_exact + (shift - 1) * n_sub_buckets + (leading - n_sub_buckets));
+	}
+
+	static auto highest_of(std::size_t bucket) noexcept -> std::uint64_t {
+		if (bucket < n_exact) {
+			return bucket;
+		}
+		auto const shift = (bucket - n_exact) / n_sub_buckets + 1;
+		auto const leading = (bucket - n_exact) % n_sub_buckets + n_sub_buckets;
+		// The last bucket would overflow
+		if (shift == max_shift && leading + 1 == n_exact) {
+			return std::numeric_limits<std::uint64_t>::max();
+		}
+		return ((leading + 1) << shift) - 1;
+	}
+};
+
+}  // namespace ecole::benchmark
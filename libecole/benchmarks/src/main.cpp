@@ -1,7 +1,14 @@
+#include <algorithm>
+#include <array>
 #include <exception>
 #include <iostream>
+#include <map>
 #include <optional>
+#include <random>
+#include <thread>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include <CLI/CLI.hpp>
 
@@ -13,7 +20,23 @@
 #include "ecole/scip/seed.hpp"
 
 #include "bench-branching.hpp"
+#include "bench-clique.hpp"
+#include "bench-constraints.hpp"
+#include "bench-copy.hpp"
+#include "bench-configuring.hpp"
+#include "bench-coroutine.hpp"
+#include "bench-generation.hpp"
+#include "bench-khalil.hpp"
+#include "bench-latency.hpp"
+#include "bench-memory.hpp"
+#include "bench-model.hpp"
+#include "bench-observation.hpp"
+#include "bench-overhead.hpp"
+#include "bench-primal-search.hpp"
+#include "bench-scaling.hpp"
 #include "benchmark.hpp"
+#include "csv.hpp"
+#include "report.hpp"
 
 using namespace ecole::benchmark;
 using namespace ecole::instance;
@@ -32,10 +55,21 @@ void seed_model(ecole::scip::Model& model, ecole::RandomGenerator& rng) {
 	model.set_param("randomization/lpseed", seed_distrib(rng));
 }
 
-/** The generators used to benchmark branching dynamics. */
-auto benchmark_branching(std::size_t n_instances, std::size_t n_nodes) {
+/** How results are written, set once from the command line. */
+struct OutputOptions {
+	Format format = Format::csv;
+	std::optional<ecole::Seed> seed = {};
+};
+auto output_options = OutputOptions{};  // NOLINT(cppcoreguidelines-avoid-non-const-global-variables)
+
+auto make_report(std::string const& csv_title) -> Report {
+	return {std::cout, output_options.format, csv_title, output_options.seed};
+}
+
+/** The generators used to benchmark branching dynamics and observation functions. */
+auto branching_generators() {
 	using GraphType = typename ecole::instance::IndependentSetGenerator::Parameters::GraphType;
-	auto generators = std::tuple{
+	return std::tuple{
 		SetCoverGenerator{{500, 1000}},                           // NOLINT(readability-magic-numbers)
 		SetCoverGenerator{{1000, 1000}},                          // NOLINT(readability-magic-numbers)
 		SetCoverGenerator{{2000, 1000}},                          // NOLINT(readability-magic-numbers)
@@ -49,9 +83,14 @@ auto benchmark_branching(std::size_t n_instances, std::size_t n_nodes) {
 		IndependentSetGenerator{{1000, GraphType::erdos_renyi}},  // NOLINT(readability-magic-numbers)
 		IndependentSetGenerator{{1500, GraphType::erdos_renyi}},  // NOLINT(readability-magic-numbers)
 	};
+}
+
+/** Compare the branching dynamics with a branching rule on instances of the branching generators. */
+void benchmark_branching(std::size_t n_instances, std::size_t n_nodes, std::size_t n_warmups, std::size_t n_trials) {
+	auto generators = branching_generators();
 	auto rng = ecole::spawn_random_generator();
 
-	std::cout << BranchingResult::csv_title() << '\n';
+	auto report = make_report(BranchingResult::csv_title());
 	for (std::size_t i = 0; i < n_instances; ++i) {
 		auto benchmark_and_print = [&](auto& gen) noexcept {
 			try {
@@ -60,7 +99,7 @@ auto benchmark_branching(std::size_t n_instances, std::size_t n_nodes) {
 				model.disable_cuts();
 				model.set_param("limits/totalnodes", n_nodes);
 				seed_model(model, rng);
-				std::cout << benchmark_branching(model).csv() << '\n';
+				report.add(benchmark_branching(model, n_warmups, n_trials).csv());
 			} catch (std::exception const& e) {
 				std::cerr << "Error when benchmarking an instance: " << e.what() << '\n';
 			}
@@ -69,6 +108,299 @@ auto benchmark_branching(std::size_t n_instances, std::size_t n_nodes) {
 	}
 }
 
+/** Compare the primal search dynamics with a native heuristic on instances of the branching generators. */
+void benchmark_primal_search(
+	std::size_t n_instances,
+	std::size_t n_nodes,
+	std::size_t n_warmups,
+	std::size_t n_trials) {
+	auto generators = branching_generators();
+	auto rng = ecole::spawn_random_generator();
+
+	auto report = make_report(PrimalSearchResult::csv_title());
+	for (std::size_t i = 0; i < n_instances; ++i) {
+		for_each(generators, [&](auto& gen) noexcept {
+			try {
+				auto model = gen.next();
+				model.disable_presolve();
+				model.disable_cuts();
+				model.set_param("limits/totalnodes", n_nodes);
+				seed_model(model, rng);
+				report.add(ecole::benchmark::benchmark_primal_search(model, n_warmups, n_trials).csv());
+			} catch (std::exception const& e) {
+				std::cerr << "Error when benchmarking an instance: " << e.what() << '\n';
+			}
+		});
+	}
+}
+
+/** Compare the configuring dynamics with solving with the same parameters on the branching generators. */
+void benchmark_configuring(std::size_t n_instances, std::size_t n_nodes, std::size_t n_warmups, std::size_t n_trials) {
+	auto generators = branching_generators();
+	auto rng = ecole::spawn_random_generator();
+
+	auto report = make_report(ConfiguringResult::csv_title());
+	for (std::size_t i = 0; i < n_instances; ++i) {
+		for_each(generators, [&](auto& gen) noexcept {
+			try {
+				auto model = gen.next();
+				model.set_param("limits/totalnodes", n_nodes);
+				seed_model(model, rng);
+				report.add(ecole::benchmark::benchmark_configuring(model, n_warmups, n_trials).csv());
+			} catch (std::exception const& e) {
+				std::cerr << "Error when benchmarking an instance: " << e.what() << '\n';
+			}
+		});
+	}
+}
+
+/** Measure a single extraction of observation and reward functions on the first nodes of the branching generators. */
+void benchmark_observation(std::size_t n_instances, std::size_t n_nodes) {
+	auto generators = branching_generators();
+	auto rng = ecole::spawn_random_generator();
+
+	auto report = make_report(ObservationResult::csv_title());
+	for (std::size_t i = 0; i < n_instances; ++i) {
+		for_each(generators, [&](auto& gen) noexcept {
+			try {
+				auto model = gen.next();
+				model.disable_presolve();
+				model.disable_cuts();
+				seed_model(model, rng);
+				for (auto& result : ecole::benchmark::benchmark_observation(std::move(model), n_nodes)) {
+					report.add(result.csv());
+				}
+			} catch (std::exception const& e) {
+				std::cerr << "Error when benchmarking an instance: " << e.what() << '\n';
+			}
+		});
+	}
+}
+
+/** Measure the memory of models and the size of their observations on instances of the branching generators. */
+void benchmark_memory(std::size_t n_instances, std::size_t n_nodes) {
+	auto generators = branching_generators();
+	auto rng = ecole::spawn_random_generator();
+
+	auto report = make_report(MemoryResult::csv_title());
+	for (std::size_t i = 0; i < n_instances; ++i) {
+		for_each(generators, [&](auto& gen) noexcept {
+			try {
+				auto model = gen.next();
+				seed_model(model, rng);
+				for (auto& result : ecole::benchmark::benchmark_memory(model, n_nodes)) {
+					report.add(result.csv());
+				}
+			} catch (std::exception const& e) {
+				std::cerr << "Error when benchmarking an instance: " << e.what() << '\n';
+			}
+		});
+	}
+}
+
+/** Break down the overhead of the branching environment on instances of the branching generators. */
+void benchmark_overhead(std::size_t n_instances, std::size_t n_nodes) {
+	auto generators = branching_generators();
+	auto rng = ecole::spawn_random_generator();
+
+	auto report = make_report(OverheadResult::csv_title());
+	for (std::size_t i = 0; i < n_instances; ++i) {
+		for_each(generators, [&](auto& gen) noexcept {
+			try {
+				auto model = gen.next();
+				model.disable_presolve();
+				model.disable_cuts();
+				model.set_param("limits/totalnodes", n_nodes);
+				seed_model(model, rng);
+				report.add(ecole::benchmark::benchmark_overhead(model).csv());
+			} catch (std::exception const& e) {
+				std::cerr << "Error when benchmarking an instance: " << e.what() << '\n';
+			}
+		});
+	}
+}
+
+/** Measure how independent environments scale with the number of threads on the branching generators. */
+void benchmark_scaling(std::size_t n_instances, std::size_t n_nodes, std::size_t max_threads, std::size_t n_episodes) {
+	auto generators = branching_generators();
+	auto rng = ecole::spawn_random_generator();
+
+	auto report = make_report(ScalingResult::csv_title());
+	for_each(generators, [&](auto& gen) noexcept {
+		try {
+			auto models = std::vector<ecole::scip::Model>{};
+			for (std::size_t i = 0; i < n_instances; ++i) {
+				auto model = gen.next();
+				model.disable_presolve();
+				model.disable_cuts();
+				model.set_param("limits/totalnodes", n_nodes);
+				seed_model(model, rng);
+				models.push_back(std::move(model));
+			}
+			for (auto& result : ecole::benchmark::benchmark_scaling(models, max_threads, n_episodes)) {
+				report.add(result.csv());
+			}
+		} catch (std::exception const& e) {
+			std::cerr << "Error when benchmarking a generator: " << e.what() << '\n';
+		}
+	});
+}
+
+/** Record the distribution of reset and step latencies of every dynamics on the branching generators. */
+void benchmark_latency(std::size_t n_instances, std::size_t n_nodes, std::size_t n_episodes) {
+	auto generators = branching_generators();
+	auto rng = ecole::spawn_random_generator();
+
+	auto report = make_report(LatencyResult::csv_title());
+	for_each(generators, [&](auto& gen) noexcept {
+		try {
+			auto models = std::vector<ecole::scip::Model>{};
+			for (std::size_t i = 0; i < n_instances; ++i) {
+				auto model = gen.next();
+				model.set_param("limits/totalnodes", n_nodes);
+				seed_model(model, rng);
+				models.push_back(std::move(model));
+			}
+			for (auto& result : ecole::benchmark::benchmark_latency(models, n_episodes)) {
+				report.add(result.csv());
+			}
+		} catch (std::exception const& e) {
+			std::cerr << "Error when benchmarking a generator: " << e.what() << '\n';
+		}
+	});
+}
+
+/** Compare the wait policies of the coroutine used in iterative solving. */
+void benchmark_coroutine(std::size_t n_round_trips) {
+	auto report = make_report(HandoffResult::csv_title());
+	for (auto& result : benchmark_coroutine_handoff(n_round_trips)) {
+		report.add(result.csv());
+	}
+}
+
+/** Measure how model copies scale with the number of threads. */
+void benchmark_copy(std::size_t max_threads, std::size_t n_copies_per_thread) {
+	auto model = SetCoverGenerator{{500, 1000}}.next();  // NOLINT(readability-magic-numbers)
+	auto report = make_report(CopyResult::csv_title());
+	for (auto& result : benchmark_copy(model, max_threads, n_copies_per_thread)) {
+		report.add(result.csv());
+	}
+}
+
+/** Measure per-node Khalil2016 extraction time against the number of candidates and threads. */
+void benchmark_khalil(std::size_t max_threads, std::size_t n_nodes) {
+	auto generators = std::tuple{
+		SetCoverGenerator{{500, 1000}},  // NOLINT(readability-magic-numbers)
+		SetCoverGenerator{{500, 2000}},  // NOLINT(readability-magic-numbers)
+		SetCoverGenerator{{500, 4000}},  // NOLINT(readability-magic-numbers)
+	};
+	auto report = make_report(KhalilResult::csv_title());
+	for_each(generators, [&](auto& gen) {
+		auto model = gen.next();
+		model.disable_presolve();
+		model.disable_cuts();
+		for (auto& result : ecole::benchmark::benchmark_khalil(std::move(model), max_threads, n_nodes)) {
+			report.add(result.csv());
+		}
+	});
+}
+
+/** Measure constraint matrix extraction time on the largest benchmarked instances against the number of threads. */
+void benchmark_constraints(std::size_t max_threads, std::size_t n_repeats) {
+	using GraphType = typename ecole::instance::IndependentSetGenerator::Parameters::GraphType;
+	auto generators = std::tuple{
+		SetCoverGenerator{{2000, 1000}},                          // NOLINT(readability-magic-numbers)
+		SetCoverGenerator{{500, 4000}},                           // NOLINT(readability-magic-numbers)
+		CombinatorialAuctionGenerator{{300, 1500}},               // NOLINT(readability-magic-numbers)
+		CapacitatedFacilityLocationGenerator{{400, 100}},         // NOLINT(readability-magic-numbers)
+		IndependentSetGenerator{{1500, GraphType::erdos_renyi}},  // NOLINT(readability-magic-numbers)
+	};
+	auto report = make_report(ConstraintsResult::csv_title());
+	for_each(generators, [&](auto& gen) {
+		auto model = gen.next();
+		for (auto& result : ecole::benchmark::benchmark_constraints(model, max_threads, n_repeats)) {
+			report.add(result.csv());
+		}
+	});
+}
+
+/** Measure the throughput of instance generators of increasing sizes. */
+void benchmark_generation(std::size_t n_instances) {
+	using GraphType = typename ecole::instance::IndependentSetGenerator::Parameters::GraphType;
+	auto generators = std::tuple{
+		SetCoverGenerator{{1000, 1000}},                              // NOLINT(readability-magic-numbers)
+		SetCoverGenerator{{10000, 1000}},                             // NOLINT(readability-magic-numbers)
+		SetCoverGenerator{{20000, 1000}},                             // NOLINT(readability-magic-numbers)
+		CombinatorialAuctionGenerator{{100, 500}},                    // NOLINT(readability-magic-numbers)
+		CombinatorialAuctionGenerator{{300, 1500}},                   // NOLINT(readability-magic-numbers)
+		CapacitatedFacilityLocationGenerator{{400, 100}},             // NOLINT(readability-magic-numbers)
+		CapacitatedFacilityLocationGenerator{{2000, 500}},            // NOLINT(readability-magic-numbers)
+		IndependentSetGenerator{{500, GraphType::erdos_renyi}},       // NOLINT(readability-magic-numbers)
+		IndependentSetGenerator{{1500, GraphType::erdos_renyi}},      // NOLINT(readability-magic-numbers)
+		IndependentSetGenerator{{500, GraphType::barabasi_albert}},   // NOLINT(readability-magic-numbers)
+		IndependentSetGenerator{{1500, GraphType::barabasi_albert}},  // NOLINT(readability-magic-numbers)
+	};
+	auto report = make_report(GenerationResult::csv_title());
+	for_each(generators, [&](auto& gen) {
+		report.add(ecole::benchmark::benchmark_generation(gen, n_instances).csv());
+	});
+}
+
+/** Compare the greedy clique partition with the previous implementation on the graphs of IndependentSetGenerator. */
+void benchmark_clique(std::size_t n_graphs) {
+	auto rng = ecole::spawn_random_generator();
+	auto report = make_report(CliqueResult::csv_title());
+	for (auto const n_nodes : std::array<std::size_t, 3>{500, 1500, 5000}) {  // NOLINT(readability-magic-numbers)
+		report.add(benchmark_clique_partition_barabasi_albert(n_nodes, 4, n_graphs, rng).csv());  // NOLINT
+	}
+	for (auto const n_nodes : std::array<std::size_t, 2>{500, 1500}) {  // NOLINT(readability-magic-numbers)
+		report.add(benchmark_clique_partition_erdos_renyi(n_nodes, 0.25, n_graphs, rng).csv());  // NOLINT
+	}
+}
+
+/** Compare reading the instances of the branching generators from LP and MPS files. */
+void benchmark_parsing(std::size_t n_reads) {
+	auto generators = branching_generators();
+	auto report = make_report(ParsingResult::csv_title());
+	for_each(generators, [&](auto& gen) {
+		for (auto& result : ecole::benchmark::benchmark_parsing(gen.next(), n_reads)) {
+			report.add(result.csv());
+		}
+	});
+}
+
+/** Measure the combinatorial auction generation time over a grid of sizes and bundle parameters. */
+void benchmark_auction_generation(std::size_t n_instances) {
+	using Params = CombinatorialAuctionGenerator::Parameters;
+	using Size = std::pair<std::size_t, std::size_t>;
+	auto constexpr sizes = std::array{Size{100, 500}, Size{500, 2500}, Size{5000, 25000}};  // NOLINT
+	auto constexpr add_item_probs = std::array{0.5, 0.65, 0.8};                             // NOLINT
+	auto constexpr max_n_sub_bids = std::array<std::size_t, 2>{1, 5};                       // NOLINT
+	auto report = make_report(merge_csv(make_csv("add_item_prob", "max_n_sub_bids"), GenerationResult::csv_title()));
+	for (auto const [n_items, n_bids] : sizes) {
+		for (auto const add_item_prob : add_item_probs) {
+			for (auto const n_sub_bids : max_n_sub_bids) {
+				auto params = Params{n_items, n_bids};
+				params.add_item_prob = add_item_prob;
+				params.max_n_sub_bids = n_sub_bids;
+				auto generator = CombinatorialAuctionGenerator{params};
+				report.add(merge_csv(
+					make_csv(add_item_prob, n_sub_bids),
+					ecole::benchmark::benchmark_generation(generator, n_instances).csv()));
+			}
+		}
+	}
+}
+
+/** Compare the construction time and memory of models across plugin profiles. */
+void benchmark_model(std::size_t n_models) {
+	auto model = SetCoverGenerator{{500, 1000}}.next();  // NOLINT(readability-magic-numbers)
+	auto report = make_report(ModelResult::csv_title());
+	for (auto& result : ecole::benchmark::benchmark_model(model, n_models)) {
+		report.add(result.csv());
+	}
+}
+
 int main(int argc, char** argv) {
 	try {
 
@@ -80,13 +412,112 @@ int main(int argc, char** argv) {
 		auto n_nodes = std::size_t{100};  // NOLINT(readability-magic-numbers)
 		app.add_option("--node-limit,--nl", n_nodes, "Limit the number of nodes in each run");
 		auto seed = std::optional<ecole::Seed>{};
-		app.add_option("--seed,-s", seed, "Global Ecole random seed");
+		app.add_option("--seed,-s", seed, "Global Ecole random seed, drawn at random if not given");
+		auto output_format = Format::csv;
+		app.add_option("--format,-f", output_format, "Format of the results")
+			->transform(CLI::CheckedTransformer(std::map<std::string, Format>{{"csv", Format::csv}, {"json", Format::json}}));
+		auto n_warmups = std::size_t{0};
+		app.add_option("--warmups,-w", n_warmups, "Number of untimed runs before the trials of the solving benchmarks");
+		auto n_trials = std::size_t{1};
+		app.add_option("--trials,-r", n_trials, "Number of trials summarized in the solving benchmarks")
+			->check(CLI::PositiveNumber);
+
+		// Branching is run when no subcommand is given
+		app.require_subcommand(0, 1);
+		auto* coroutine_app = app.add_subcommand("coroutine", "Benchmark the coroutine handoff latency");
+		auto n_round_trips = std::size_t{100000};  // NOLINT(readability-magic-numbers)
+		coroutine_app->add_option("--round-trips,-n", n_round_trips, "Number of round trips between the two threads");
+		auto* copy_app = app.add_subcommand("copy", "Benchmark concurrent model copies");
+		auto max_threads = std::size_t{8};  // NOLINT(readability-magic-numbers)
+		copy_app->add_option("--max-threads,-t", max_threads, "Largest number of threads copying concurrently");
+		auto n_copies = std::size_t{20};  // NOLINT(readability-magic-numbers)
+		copy_app->add_option("--copies,-n", n_copies, "Number of copies made by each thread");
+		auto* khalil_app = app.add_subcommand("khalil", "Benchmark parallel Khalil2016 feature extraction");
+		khalil_app->add_option("--max-threads,-t", max_threads, "Largest number of threads extracting features");
+		auto* constraints_app = app.add_subcommand("constraints", "Benchmark parallel constraint matrix extraction");
+		constraints_app->add_option("--max-threads,-t", max_threads, "Largest number of threads reading constraints");
+		auto n_repeats = std::size_t{10};  // NOLINT(readability-magic-numbers)
+		constraints_app->add_option("--repeats,-n", n_repeats, "Number of extractions for every number of threads");
+		auto* generation_app = app.add_subcommand("generation", "Benchmark the throughput of instance generators");
+		generation_app->add_option("--instances,-n", n_instances, "Number of instances generated by each generator");
+		auto* clique_app = app.add_subcommand("clique", "Benchmark the greedy clique partition of independent sets");
+		auto n_graphs = std::size_t{10};  // NOLINT(readability-magic-numbers)
+		clique_app->add_option("--graphs,-n", n_graphs, "Number of graphs partitioned for every size")
+			->check(CLI::PositiveNumber);
+		auto* auction_app = app.add_subcommand("auction", "Benchmark combinatorial auction generation on a parameter grid");
+		auction_app->add_option("--instances,-n", n_instances, "Number of instances generated for each parameter");
+		auto* model_app = app.add_subcommand("model", "Benchmark model construction with every plugin profile");
+		auto n_models = std::size_t{100};  // NOLINT(readability-magic-numbers)
+		model_app->add_option("--models,-n", n_models, "Number of models created for every profile");
+		auto* observation_app =
+			app.add_subcommand("observation", "Benchmark the extraction of observation and reward functions");
+		observation_app->add_option("--node-limit,--nl", n_nodes, "Number of nodes on which observations are extracted");
+		auto* memory_app = app.add_subcommand("memory", "Benchmark the memory of models and the size of observations");
+		memory_app->add_option("--node-limit,--nl", n_nodes, "Number of branching nodes solved after the root");
+		auto* overhead_app = app.add_subcommand("overhead", "Break down the overhead of the branching environment");
+		overhead_app->add_option("--node-limit,--nl", n_nodes, "Maximum number of nodes to solve each instance");
+		auto* scaling_app = app.add_subcommand("scaling", "Benchmark environments on a growing number of threads");
+		auto max_env_threads = std::max(std::size_t{std::thread::hardware_concurrency()}, std::size_t{1});
+		scaling_app->add_option("--max-threads,-t", max_env_threads, "Largest number of threads running environments");
+		auto n_episodes = std::size_t{4};  // NOLINT(readability-magic-numbers)
+		scaling_app->add_option("--episodes,-e", n_episodes, "Number of episodes run by each thread");
+		scaling_app->add_option("--node-limit,--nl", n_nodes, "Maximum number of nodes to solve each instance");
+		auto* latency_app = app.add_subcommand("latency", "Benchmark the distribution of reset and step latencies");
+		latency_app->add_option("--episodes,-e", n_episodes, "Number of episodes run on every instance");
+		latency_app->add_option("--node-limit,--nl", n_nodes, "Maximum number of nodes to solve each instance");
+		auto* primal_search_app =
+			app.add_subcommand("primal-search", "Compare the primal search dynamics with a native heuristic");
+		primal_search_app->add_option("--node-limit,--nl", n_nodes, "Limit the number of nodes in each run");
+		auto* configuring_app =
+			app.add_subcommand("configuring", "Compare the configuring dynamics with solving with the same parameters");
+		configuring_app->add_option("--node-limit,--nl", n_nodes, "Limit the number of nodes in each run");
+		auto* parsing_app = app.add_subcommand("parsing", "Benchmark reading instances from LP and MPS files");
+		auto n_reads = std::size_t{10};  // NOLINT(readability-magic-numbers)
+		parsing_app->add_option("--reads,-n", n_reads, "Number of times every file is read");
 		CLI11_PARSE(app, argc, argv);
 
-		if (seed.has_value()) {
-			ecole::seed(seed.value());
+		// Always seed, so that every run can be reproduced on the same instances
+		if (!seed.has_value()) {
+			auto device = std::random_device{};
+			seed = std::uniform_int_distribution<ecole::Seed>{}(device);
+		}
+		ecole::seed(seed.value());
+		output_options = {output_format, seed};
+		if (coroutine_app->parsed()) {
+			benchmark_coroutine(n_round_trips);
+		} else if (copy_app->parsed()) {
+			benchmark_copy(max_threads, n_copies);
+		} else if (khalil_app->parsed()) {
+			benchmark_khalil(max_threads, n_nodes);
+		} else if (constraints_app->parsed()) {
+			benchmark_constraints(max_threads, n_repeats);
+		} else if (generation_app->parsed()) {
+			benchmark_generation(n_instances);
+		} else if (clique_app->parsed()) {
+			benchmark_clique(n_graphs);
+		} else if (parsing_app->parsed()) {
+			benchmark_parsing(n_reads);
+		} else if (auction_app->parsed()) {
+			benchmark_auction_generation(n_instances);
+		} else if (model_app->parsed()) {
+			benchmark_model(n_models);
+		} else if (observation_app->parsed()) {
+			benchmark_observation(n_instances, n_nodes);
+		} else if (memory_app->parsed()) {
+			benchmark_memory(n_instances, n_nodes);
+		} else if (overhead_app->parsed()) {
+			benchmark_overhead(n_instances, n_nodes);
+		} else if (primal_search_app->parsed()) {
+			benchmark_primal_search(n_instances, n_nodes, n_warmups, n_trials);
+		} else if (configuring_app->parsed()) {
+			benchmark_configuring(n_instances, n_nodes, n_warmups, n_trials);
+		} else if (latency_app->parsed()) {
+			benchmark_latency(n_instances, n_nodes, n_episodes);
+		} else if (scaling_app->parsed()) {
+			benchmark_scaling(n_instances, n_nodes, max_env_threads, n_episodes);
+		} else {
+			benchmark_branching(n_instances, n_nodes, n_warmups, n_trials);
 		}
-		benchmark_branching(n_instances, n_nodes);
 
 	} catch (std::exception const& e) {
 		std::cerr << "An error occured: " << e.what() << '\n';
@@ -0,0 +1,24 @@
+#include <cstdint>
+#include <fstream>
+
+#if defined(__linux__)
+#include <unistd.h>
+#endif
+
+#include "memory.hpp"
+
+namespace ecole::benchmark {
+
+auto resident_bytes() -> std::int64_t {
+#if defined(__linux__)
+	auto statm = std::ifstream{"/proc/self/statm"};
+	auto total_pages = std::int64_t{0};
+	auto resident_pages = std::int64_t{0};
+	if (statm >> total_pages >> resident_pages) {
+		return resident_pages * static_cast<std::int64_t>(sysconf(_SC_PAGESIZE));
+	}
+#endif
+	return 0;
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/observation/hutter-2011.hpp"
+#include "ecole/observation/khalil-2016.hpp"
+#include "ecole/observation/milp-bipartite.hpp"
+#include "ecole/observation/node-bipartite.hpp"
+#include "ecole/reward/abstract.hpp"
+#include "ecole/utility/sparse-matrix.hpp"
+
+namespace ecole::benchmark {
+
+/** The resident memory of the process in bytes, or zero if it is not available. */
+auto resident_bytes() -> std::int64_t;
+
+/*************************************
+ *  Size of the observation tensors  *
+ *************************************/
+
+template <typename T, std::size_t N> auto bytes_of(xt::xtensor<T, N> const& tensor) -> std::size_t {
+	return tensor.size() * sizeof(T);
+}
+
+template <typename T> auto bytes_of(utility::coo_matrix<T> const& matrix) -> std::size_t {
+	return bytes_of(matrix.values) + bytes_of(matrix.indices);
+}
+
+template <typename T, typename I> auto bytes_of(utility::csr_matrix<T, I> const& matrix) -> std::size_t {
+	return bytes_of(matrix.values) + bytes_of(matrix.column_indices) + bytes_of(matrix.row_pointers);
+}
+
+inline auto bytes_of(observation::NodeBipartiteObs const& obs) -> std::size_t {
+	return bytes_of(obs.variable_features) + bytes_of(obs.row_features) + bytes_of(obs.edge_features) +
+		   bytes_of(obs.edge_features_csr);
+}
+
+inline auto bytes_of(observation::MilpBipartiteObs const& obs) -> std::size_t {
+	return bytes_of(obs.variable_features) + bytes_of(obs.constraint_features) + bytes_of(obs.edge_features);
+}
+
+inline auto bytes_of(observation::Khalil2016Obs const& obs) -> std::size_t {
+	return bytes_of(obs.features) + bytes_of(obs.candidates) + bytes_of(obs.timed_out);
+}
+
+inline auto bytes_of(observation::Hutter2011Obs const& obs) -> std::size_t {
+	return bytes_of(obs.features);
+}
+
+template <typename T> auto bytes_of(std::optional<T> const& maybe_obs) -> std::size_t {
+	return maybe_obs.has_value() ? bytes_of(maybe_obs.value()) : 0;
+}
+
+/** Rewards are scalars, they hold no tensor. */
+inline auto bytes_of(reward::Reward /*reward*/) -> std::size_t {
+	return 0;
+}
+
+}  // namespace ecole::benchmark
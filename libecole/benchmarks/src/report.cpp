@@ -0,0 +1,95 @@
+#include <cmath>
+#include <cstdlib>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ecole/random.hpp"
+
+#include "report.hpp"
+
+namespace ecole::benchmark {
+
+namespace {
+
+/** Split a line written by make_csv and merge_csv, where every field is quoted. */
+auto split_csv(std::string_view line) -> std::vector<std::string> {
+	auto fields = std::vector<std::string>{};
+	if (line.size() >= 2 && line.front() == '"' && line.back() == '"') {
+		line = line.substr(1, line.size() - 2);
+	}
+	constexpr auto separator = std::string_view{R"(",")"};
+	for (auto pos = line.find(separator); pos != std::string_view::npos; pos = line.find(separator)) {
+		fields.emplace_back(line.substr(0, pos));
+		line = line.substr(pos + separator.size());
+	}
+	fields.emplace_back(line);
+	return fields;
+}
+
+auto json_string(std::string_view str) -> std::string {
+	auto escaped = std::string{"\""};
+	for (auto const c : str) {
+		if (c == '"' || c == '\\') {
+			escaped += '\\';
+		}
+		escaped += c;
+	}
+	return escaped + '"';
+}
+
+/** Numbers are written as is, non finite numbers as null, and anything else as a string. */
+auto json_value(std::string const& field) -> std::string {
+	if (field == "true" || field == "false") {
+		return field;
+	}
+	char* end = nullptr;
+	auto const number = std::strtod(field.c_str(), &end);
+	if (!field.empty() && end == field.c_str() + field.size()) {
+		return std::isfinite(number) ? field : "null";
+	}
+	return json_string(field);
+}
+
+}  // namespace
+
+Report::Report(std::ostream& out_, Format format_, std::string const& csv_title, std::optional<Seed> seed) :
+	out{out_}, format{format_}, columns{split_csv(csv_title)} {
+	if (format == Format::csv) {
+		out << csv_title << '\n';
+		return;
+	}
+	out << '{';
+	if (seed.has_value()) {
+		out << R"("seed": )" << seed.value() << ", ";
+	}
+	out << R"("results": [)";
+}
+
+Report::~Report() {
+	if (format == Format::json) {
+		out << (n_lines > 0 ? "\n]}" : "]}") << '\n';
+	}
+	out.flush();
+}
+
+void Report::add(std::string const& csv_line) {
+	if (format == Format::csv) {
+		out << csv_line << '\n';
+	} else {
+		auto const fields = split_csv(csv_line);
+		out << (n_lines > 0 ? ",\n\t{" : "\n\t{");
+		for (std::size_t i = 0; i < fields.size(); ++i) {
+			auto const key = i < columns.size() ? columns[i] : fmt::format("column_{}", i);
+			out << (i > 0 ? ", " : "") << json_string(key) << ": " << json_value(fields[i]);
+		}
+		out << '}';
+	}
+	++n_lines;
+}
+
+}  // namespace ecole::benchmark
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "ecole/random.hpp"
+
+namespace ecole::benchmark {
+
+enum struct Format { csv, json };
+
+/**
+ * Write the CSV lines of benchmark results, as is or as a JSON document.
+ *
+ * In JSON, every line is an object keyed by the columns of the title, and numbers are written unquoted.
+ * The document is completed when the report is destroyed.
+ */
+class Report {
+public:
+	Report(std::ostream& out, Format format, std::string const& csv_title, std::optional<Seed> seed = {});
+	Report(Report const&) = delete;
+	auto operator=(Report const&) -> Report& = delete;
+	~Report();
+
+	void add(std::string const& csv_line);
+
+private:
+	std::ostream& out;
+	Format format;
+	std::vector<std::string> columns;
+	std::size_t n_lines = 0;
+};
+
+}  // namespace ecole::benchmark
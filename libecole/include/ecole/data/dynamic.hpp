@@ -1,7 +1,10 @@
 #pragma once
 
-#include <memory>
+#include <cstddef>
+#include <new>
+#include <type_traits>
 #include <utility>
+#include <variant>
 
 #include "ecole/data/abstract.hpp"
 
@@ -15,70 +18,181 @@ namespace ecole::data {
  * For instance, using ``DynamicFunction<Reward>``, one can store any other reward function inside a
  * container (``std::vector``, ``std::map``...).
  *
+ * Functions no larger than ``buffer_size`` are stored inline, without allocation, and larger ones on the heap.
+ * Calls go through a table of function pointers rather than virtual methods.
+ *
  * @tparam Data Type of data returned by this function. All wrapped functions must be able to extracc
  *         data convertible to this type.
  *         This can be achieved for instance by choosing ``Data`` to be ``std::variant``.
  */
 template <typename Data> class DynamicFunction {
 public:
+	/** The size of the functions stored without allocation. */
+	static constexpr std::size_t buffer_size = 4 * sizeof(void*);
+
+	/** Whether a data function is stored inline, without allocation. */
+	template <typename DataFunction>
+	static constexpr bool is_stored_inline = sizeof(DataFunction) <= buffer_size &&
+											 alignof(std::max_align_t) % alignof(DataFunction) == 0 &&
+											 std::is_nothrow_move_constructible_v<DataFunction>;
+
 	/** Create a ``DynamicFunction`` from any compatible data function. */
 	template <typename DataFunction>
-	explicit DynamicFunction(DataFunction data_function) :
-		m_pimpl{std::make_unique<DataFunctionWrapper<DataFunction>>(std::move(data_function))} {}
+	explicit DynamicFunction(DataFunction data_function) : m_vtable{&vtable_for<DataFunction>} {
+		if constexpr (is_stored_inline<DataFunction>) {
+			new (&m_storage.buffer) DataFunction{std::move(data_function)};
+		} else {
+			m_storage.pointer = new DataFunction{std::move(data_function)};
+		}
+	}
 
-	/** Default move semantics. */
-	DynamicFunction(DynamicFunction&&) noexcept = default;
+	/** Move the wrapped data function, leaving the other one empty. */
+	DynamicFunction(DynamicFunction&& other) noexcept : m_vtable{other.m_vtable} {
+		if (m_vtable != nullptr) {
+			m_vtable->move(other.m_storage, m_storage);
+			other.m_vtable = nullptr;
+		}
+	}
 	/** Copy by copying the wrapped data function. */
-	DynamicFunction(DynamicFunction const& other) : DynamicFunction{other.m_pimpl->clone()} {}
+	DynamicFunction(DynamicFunction const& other) : m_vtable{other.m_vtable} {
+		if (m_vtable != nullptr) {
+			m_vtable->copy(other.m_storage, m_storage);
+		}
+	}
 
-	/** Default move assign semantics. */
-	DynamicFunction& operator=(DynamicFunction&&) noexcept = default;
+	/** Move assign the wrapped data function, leaving the other one empty. */
+	DynamicFunction& operator=(DynamicFunction&& other) noexcept {
+		if (this != &other) {
+			reset();
+			if (other.m_vtable != nullptr) {
+				other.m_vtable->move(other.m_storage, m_storage);
+				m_vtable = std::exchange(other.m_vtable, nullptr);
+			}
+		}
+		return *this;
+	}
 	/** Copy assign by copying the wrapped data function. */
 	DynamicFunction& operator=(DynamicFunction const& other) {
 		if (this != &other) {
-			m_pimpl = other.m_pimpl->clone();
+			// Copy first so that this is left unchanged if copying throws
+			*this = DynamicFunction{other};
 		}
 		return *this;
 	}
 
+	~DynamicFunction() { reset(); }
+
 	/** Call ``before_reset`` onto the wrapped item. */
-	auto before_reset(scip::Model& model) -> void { return m_pimpl->before_reset(model); }
+	auto before_reset(scip::Model& model) -> void { return m_vtable->before_reset(m_storage, model); }
 
 	/** Call ``extract`` onto the wrapped item. */
-	auto extract(scip::Model& model, bool done) -> Data { return m_pimpl->extract(model, done); }
+	auto extract(scip::Model& model, bool done) -> Data { return m_vtable->extract(m_storage, model, done); }
 
 private:
-	/**
-	 * Interface expected of a data function.
-	 *
-	 * This is used for dynamic polymorphism based on virtual inheritance.
-	 */
-	struct DataFunctionAbstract {
-		virtual ~DataFunctionAbstract() = default;
-		virtual auto clone() -> std::unique_ptr<DataFunctionAbstract> = 0;
-		virtual auto before_reset(scip::Model& model) -> void = 0;
-		virtual auto extract(scip::Model& model, bool done) -> Data = 0;
+	/** Inline buffer or pointer to a heap allocated data function. */
+	union Storage {
+		std::aligned_storage_t<buffer_size, alignof(std::max_align_t)> buffer;
+		void* pointer;
+	};
+
+	/** Operations of a wrapped data function, replacing a virtual table. */
+	struct VTable {
+		void (*destroy)(Storage& storage) noexcept;
+		void (*copy)(Storage const& from, Storage& to);
+		void (*move)(Storage& from, Storage& to) noexcept;
+		void (*before_reset)(Storage& storage, scip::Model& model);
+		auto (*extract)(Storage& storage, scip::Model& model, bool done) -> Data;
 	};
 
-	/**
-	 * Wrapper for any compatible data function.
-	 *
-	 * The wrapper implements the ``DataFunctionAbstract`` interface.
-	 */
-	template <typename DataFunction> struct DataFunctionWrapper final : DataFunctionAbstract {
-		explicit DataFunctionWrapper(DataFunction data_function) : m_data_function{std::move(data_function)} {}
-		auto clone() -> std::unique_ptr<DataFunctionAbstract> override {
-			return std::make_unique<DataFunctionWrapper>(*this);
+	template <typename DataFunction> static auto get(Storage& storage) noexcept -> DataFunction& {
+		if constexpr (is_stored_inline<DataFunction>) {
+			return *std::launder(reinterpret_cast<DataFunction*>(&storage.buffer));
+		} else {
+			return *static_cast<DataFunction*>(storage.pointer);
 		}
-		auto before_reset(scip::Model& model) -> void override { return m_data_function.before_reset(model); }
-		auto extract(scip::Model& model, bool done) -> Data override { return m_data_function.extract(model, done); }
+	}
 
-		DataFunction m_data_function;
+	template <typename DataFunction> static auto get(Storage const& storage) noexcept -> DataFunction const& {
+		return get<DataFunction>(const_cast<Storage&>(storage));  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+	}
+
+	template <typename DataFunction>
+	inline static constexpr VTable vtable_for = {
+		[](Storage& storage) noexcept {
+			if constexpr (is_stored_inline<DataFunction>) {
+				get<DataFunction>(storage).~DataFunction();
+			} else {
+				delete &get<DataFunction>(storage);
+			}
+		},
+		[](Storage const& from, Storage& to) {
+			if constexpr (is_stored_inline<DataFunction>) {
+				new (&to.buffer) DataFunction{get<DataFunction>(from)};
+			} else {
+				to.pointer = new DataFunction{get<DataFunction>(from)};
+			}
+		},
+		[](Storage& from, Storage& to) noexcept {
+			if constexpr (is_stored_inline<DataFunction>) {
+				new (&to.buffer) DataFunction{std::move(get<DataFunction>(from))};
+				get<DataFunction>(from).~DataFunction();
+			} else {
+				to.pointer = std::exchange(from.pointer, nullptr);
+			}
+		},
+		[](Storage& storage, scip::Model& model) { get<DataFunction>(storage).before_reset(model); },
+		[](Storage& storage, scip::Model& model, bool done) -> Data {
+			return get<DataFunction>(storage).extract(model, done);
+		},
 	};
 
-	explicit DynamicFunction(std::unique_ptr<DataFunctionAbstract> ptr) : m_pimpl{std::move(ptr)} {};
+	void reset() noexcept {
+		if (m_vtable != nullptr) {
+			m_vtable->destroy(m_storage);
+			m_vtable = nullptr;
+		}
+	}
+
+	Storage m_storage;
+	VTable const* m_vtable = nullptr;
+};
+
+/**
+ * Wrapper for one of a known set of data functions with similar data.
+ *
+ * This is an alternative to ``DynamicFunction`` when all the types of data functions that can be stored are known,
+ * which is stored inline and dispatches calls without indirection.
+ *
+ * @tparam Data Type of data returned by this function. All wrapped functions must be able to extract
+ *         data convertible to this type.
+ * @tparam DataFunctions The types of data functions that can be stored.
+ */
+template <typename Data, typename... DataFunctions> class VariantFunction {
+public:
+	/** Create a ``VariantFunction`` from one of the data functions. */
+	template <
+		typename DataFunction,
+		typename = std::enable_if_t<(std::is_same_v<std::decay_t<DataFunction>, DataFunctions> || ...)>>
+	explicit VariantFunction(DataFunction&& data_function) : m_data_function{std::forward<DataFunction>(data_function)} {}
+
+	/** Default construct the first type of data function. */
+	VariantFunction() = default;
+
+	/** Call ``before_reset`` onto the wrapped item. */
+	auto before_reset(scip::Model& model) -> void {
+		std::visit([&model](auto& func) { func.before_reset(model); }, m_data_function);
+	}
 
-	std::unique_ptr<DataFunctionAbstract> m_pimpl;
+	/** Call ``extract`` onto the wrapped item. */
+	auto extract(scip::Model& model, bool done) -> Data {
+		return std::visit([&model, done](auto& func) -> Data { return func.extract(model, done); }, m_data_function);
+	}
+
+	/** Index of the type of data function stored in ``DataFunctions``. */
+	[[nodiscard]] auto index() const noexcept -> std::size_t { return m_data_function.index(); }
+
+private:
+	std::variant<DataFunctions...> m_data_function;
 };
 
 }  // namespace ecole::data
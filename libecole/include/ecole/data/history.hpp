@@ -0,0 +1,140 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ecole/data/abstract.hpp"
+#include "ecole/traits.hpp"
+
+namespace ecole::data {
+
+/**
+ * The last data extracted by a HistoryFunction, from the oldest to the most recent.
+ *
+ * Data are shared, without copy, with the function and with the other histories holding them, so they cannot be
+ * modified.
+ */
+template <typename Data> class History {
+public:
+	using value_type = Data;
+	using Item = std::shared_ptr<Data const>;
+
+	History() = default;
+	explicit History(std::vector<Item> items_) : the_items{std::move(items_)} {}
+
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return the_items.size(); }
+	[[nodiscard]] auto empty() const noexcept -> bool { return the_items.empty(); }
+
+	/** The data extracted ``size() - 1 - i`` steps before the most recent one. */
+	[[nodiscard]] auto operator[](std::size_t i) const -> Data const& { return *the_items[i]; }
+	[[nodiscard]] auto front() const -> Data const& { return *the_items.front(); }
+	[[nodiscard]] auto back() const -> Data const& { return *the_items.back(); }
+
+	[[nodiscard]] auto items() const noexcept -> std::vector<Item> const& { return the_items; }
+
+	[[nodiscard]] auto operator==(History const& other) const -> bool {
+		auto const equal_data = [](Item const& a, Item const& b) { return *a == *b; };
+		return std::equal(the_items.begin(), the_items.end(), other.the_items.begin(), other.the_items.end(), equal_data);
+	}
+
+private:
+	std::vector<Item> the_items;
+};
+
+namespace internal {
+
+template <typename T> struct remove_optional { using type = T; };
+template <typename T> struct remove_optional<std::optional<T>> { using type = T; };
+
+}  // namespace internal
+
+/**
+ * Return the last data extracted by another function in the episode, such as the observations of the last nodes.
+ *
+ * Extracted data are moved into a preallocated ring buffer, where they replace the oldest ones, and histories
+ * only hold pointers to them.
+ * Stacking the history thus never copies data, and allocates a constant amount of memory per step whatever its length.
+ * The history is cleared on reset.
+ * When the wrapped function returns optional data, no history is returned and nothing is added to it when there is
+ * no data, as in terminal states.
+ *
+ * @tparam Function The data function whose data are kept.
+ */
+template <typename Function> class HistoryFunction {
+public:
+	using FunctionData = trait::data_of_t<Function>;
+	using Data = typename internal::remove_optional<FunctionData>::type;
+	static constexpr bool is_optional = !std::is_same_v<FunctionData, Data>;
+	using HistoryData = std::conditional_t<is_optional, std::optional<History<Data>>, History<Data>>;
+
+	static constexpr bool uses_lp_view = trait::uses_lp_view_v<Function>;
+
+	/**
+	 * Create the function.
+	 *
+	 * @param func The data function whose data are kept.
+	 * @param length The maximum number of data in the history.
+	 * @param pad Whether the first data of the episode is repeated so that histories always have the given length.
+	 * @throw std::invalid_argument If the length is zero.
+	 */
+	HistoryFunction(Function func_ = {}, std::size_t length_ = 1, bool pad_ = false) :
+		func{std::move(func_)}, ring(length_), pad{pad_} {
+		if (length_ == 0) {
+			throw std::invalid_argument{"History length must be positive."};
+		}
+	}
+
+	/** Clear the history and reset the wrapped function. */
+	auto before_reset(scip::Model& model) -> void {
+		std::fill(ring.begin(), ring.end(), nullptr);
+		n_extracted = 0;
+		func.before_reset(model);
+	}
+
+	/** Extract data with the wrapped function, and return the history ending with it. */
+	auto extract(scip::Model& model, bool done) -> HistoryData {
+		auto data = func.extract(model, done);
+		if constexpr (is_optional) {
+			if (!data.has_value()) {
+				return {};
+			}
+			push(std::move(data).value());
+		} else {
+			push(std::move(data));
+		}
+		return history();
+	}
+
+	/** The last data extracted in the episode, empty before the first call to extract. */
+	[[nodiscard]] auto history() const -> History<Data> {
+		auto const n_kept = std::min(n_extracted, ring.size());
+		auto items = std::vector<typename History<Data>::Item>{};
+		items.reserve(pad ? ring.size() : n_kept);
+		if (pad && n_extracted > 0) {
+			items.insert(items.end(), ring.size() - n_kept, ring.front());
+		}
+		for (auto i = n_extracted - n_kept; i < n_extracted; ++i) {
+			items.push_back(ring[i % ring.size()]);
+		}
+		return History<Data>{std::move(items)};
+	}
+
+	[[nodiscard]] auto length() const noexcept -> std::size_t { return ring.size(); }
+	[[nodiscard]] auto padded() const noexcept -> bool { return pad; }
+
+private:
+	Function func;
+	std::vector<typename History<Data>::Item> ring;
+	std::size_t n_extracted = 0;
+	bool pad = false;
+
+	void push(Data&& data) { ring[n_extracted++ % ring.size()] = std::make_shared<Data const>(std::move(data)); }
+};
+
+}  // namespace ecole::data
@@ -5,13 +5,17 @@
 
 #include "ecole/data/abstract.hpp"
 #include "ecole/traits.hpp"
+#include "ecole/utility/flat-map.hpp"
 
 namespace ecole::data {
 
 /** Combine multiple data into a map of data. */
 template <typename Key, typename Function> class MapFunction {
 public:
-	using DataMap = std::map<Key, trait::data_of_t<Function>>;
+	/** Flat, and filled in key order since the functions are sorted the same way. */
+	using DataMap = utility::FlatMap<Key, trait::data_of_t<Function>>;
+
+	static constexpr bool uses_lp_view = trait::uses_lp_view_v<Function>;
 
 	/** Default construct all functions. */
 	MapFunction() = default;
@@ -29,12 +33,16 @@ public:
 	/** Return data extracted from all functions as a map. */
 	DataMap extract(scip::Model& model, bool done) {
 		auto data = DataMap{};
+		data.reserve(data_functions.size());
 		for (auto& [key, func] : data_functions) {
 			data.emplace_hint(data.end(), key, func.extract(model, done));
 		}
 		return data;
 	}
 
+	/** The functions, by the key of their data. */
+	[[nodiscard]] auto functions() noexcept -> std::map<Key, Function>& { return data_functions; }
+
 private:
 	std::map<Key, Function> data_functions;
 };
@@ -7,6 +7,9 @@ namespace ecole::data {
 
 class NoneFunction {
 public:
+	static constexpr bool mutates_model = false;
+	static constexpr bool extracts_nothing = true;
+
 	auto before_reset(scip::Model const& /*model*/) -> void {}
 
 	auto extract(scip::Model const& /*model*/, bool /*done*/) -> NoneType { return ecole::None; }
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "ecole/data/abstract.hpp"
+#include "ecole/export.hpp"
+#include "ecole/traits.hpp"
+
+namespace ecole::data {
+
+/**
+ * Running mean and variance of every column of a feature matrix, with Welford's algorithm.
+ *
+ * NaN values, such as the rows of a Khalil2016Obs that are not branching candidates, are not counted.
+ * Statistics gathered independently, for instance by the environments of different threads, are combined with merge.
+ */
+class ECOLE_EXPORT FeatureStatistics {
+public:
+	FeatureStatistics() = default;
+	ECOLE_EXPORT explicit FeatureStatistics(std::size_t n_features);
+	/**
+	 * Restore statistics from their counts, means, and sums of squared differences from the means.
+	 *
+	 * @throw std::invalid_argument If the sizes differ.
+	 */
+	ECOLE_EXPORT FeatureStatistics(
+		std::vector<std::uint64_t> counts,
+		std::vector<double> means,
+		std::vector<double> squares);
+
+	[[nodiscard]] auto n_features() const noexcept -> std::size_t { return means.size(); }
+	[[nodiscard]] auto count(std::size_t feature) const noexcept -> std::uint64_t { return counts[feature]; }
+	[[nodiscard]] auto mean(std::size_t feature) const noexcept -> double { return means[feature]; }
+	/** The population variance of a feature, zero until two values are seen. */
+	[[nodiscard]] auto variance(std::size_t feature) const noexcept -> double {
+		return counts[feature] > 0 ? squares[feature] / static_cast<double>(counts[feature]) : 0.;
+	}
+
+	/** Add a value of a feature, unless it is NaN. */
+	void add(std::size_t feature, double value) noexcept {
+		if (std::isnan(value)) {
+			return;
+		}
+		auto const delta = value - means[feature];
+		means[feature] += delta / static_cast<double>(++counts[feature]);
+		squares[feature] += delta * (value - means[feature]);
+	}
+
+	/**
+	 * Add the statistics of the same features gathered elsewhere.
+	 *
+	 * The result is the same as if all values had been added here, up to rounding (Chan et al., 1979).
+	 *
+	 * @throw std::invalid_argument If the statistics have a different number of features.
+	 */
+	ECOLE_EXPORT void merge(FeatureStatistics const& other);
+
+	[[nodiscard]] auto operator==(FeatureStatistics const& other) const -> bool {
+		return counts == other.counts && means == other.means && squares == other.squares;
+	}
+
+	[[nodiscard]] auto get_counts() const noexcept -> std::vector<std::uint64_t> const& { return counts; }
+	[[nodiscard]] auto get_means() const noexcept -> std::vector<double> const& { return means; }
+	[[nodiscard]] auto get_squares() const noexcept -> std::vector<double> const& { return squares; }
+
+private:
+	std::vector<std::uint64_t> counts;
+	std::vector<double> means;
+	/** The sum of squared differences from the mean of every feature. */
+	std::vector<double> squares;
+};
+
+/** Convert statistics to bytes, the same on all platforms. */
+ECOLE_EXPORT auto serialize_statistics(std::vector<FeatureStatistics> const& statistics) -> std::string;
+
+/**
+ * Convert bytes written by serialize_statistics back to statistics.
+ *
+ * @throw std::invalid_argument If the bytes were not written by serialize_statistics.
+ */
+ECOLE_EXPORT auto deserialize_statistics(std::string_view data) -> std::vector<FeatureStatistics>;
+
+/**
+ * Normalize the features of observations with running statistics.
+ *
+ * The features normalized are the matrices returned as a tuple of references by ``normalized_features(observation)``,
+ * found by argument dependent lookup, such as the variable and row features of a NodeBipartiteObs, or the features
+ * of a Khalil2016Obs.
+ * Every column is normalized as ``(x - mean) / sqrt(variance + epsilon)`` with the statistics of the observations
+ * extracted before, which are updated with the new values in the same pass.
+ * Columns are left unchanged until a value is seen, and NaN values stay NaN.
+ *
+ * Statistics are frozen for inference, where they are typically loaded from those saved after training.
+ * Copies of the function have their own statistics, which can be merged, for instance after running environments in
+ * multiple threads.
+ *
+ * @tparam Function The observation function whose features are normalized.
+ */
+template <typename Function> class NormalizedFunction {
+public:
+	using Observation = typename trait::data_of_t<Function>::value_type;
+
+	static constexpr bool uses_lp_view = trait::uses_lp_view_v<Function>;
+
+	/** The default added to variances, which keeps constant features finite. */
+	static constexpr double default_epsilon = 1e-8;
+
+	/**
+	 * Create the function.
+	 *
+	 * @param func The observation function whose features are normalized.
+	 * @param epsilon Added to the variance before dividing by the standard deviation.
+	 * @param frozen Whether to normalize without updating the statistics.
+	 */
+	NormalizedFunction(Function func_ = {}, double epsilon_ = default_epsilon, bool frozen_ = false) :
+		func{std::move(func_)}, epsilon{epsilon_}, is_frozen{frozen_} {}
+
+	/** Reset the wrapped function, keeping the statistics. */
+	auto before_reset(scip::Model& model) -> void { func.before_reset(model); }
+
+	/**
+	 * Extract an observation with the wrapped function, and normalize its features.
+	 *
+	 * @throw std::invalid_argument If the number of features is not the same as in previous observations.
+	 */
+	auto extract(scip::Model& model, bool done) -> std::optional<Observation> {
+		auto obs = func.extract(model, done);
+		if (obs.has_value()) {
+			normalize(obs.value());
+		}
+		return obs;
+	}
+
+	/** Normalize the features of an observation, and update the statistics unless they are frozen. */
+	void normalize(Observation& obs) {
+		auto tensors = normalized_features(obs);
+		statistics.resize(std::tuple_size_v<decltype(tensors)>);
+		std::size_t index = 0;
+		std::apply([&](auto&... tensor) { (normalize_tensor(tensor, statistics[index++]), ...); }, tensors);
+	}
+
+	/** Stop or resume updating the statistics. */
+	void freeze(bool frozen_ = true) noexcept { is_frozen = frozen_; }
+	[[nodiscard]] auto frozen() const noexcept -> bool { return is_frozen; }
+
+	/** The statistics of every feature matrix, in the order of ``normalized_features``, empty before extracting. */
+	[[nodiscard]] auto get_statistics() const noexcept -> std::vector<FeatureStatistics> const& { return statistics; }
+	void set_statistics(std::vector<FeatureStatistics> statistics_) { statistics = std::move(statistics_); }
+
+	/**
+	 * Add the statistics of another function, such as a copy used in another thread.
+	 *
+	 * @throw std::invalid_argument If the statistics are of different features.
+	 */
+	void merge_statistics(std::vector<FeatureStatistics> const& other) {
+		if (statistics.empty()) {
+			statistics = other;
+			return;
+		}
+		if (other.size() != statistics.size()) {
+			throw std::invalid_argument{"Cannot merge statistics of a different number of feature matrices."};
+		}
+		for (std::size_t i = 0; i < other.size(); ++i) {
+			statistics[i].merge(other[i]);
+		}
+	}
+
+	[[nodiscard]] auto save_statistics() const -> std::string { return serialize_statistics(statistics); }
+	void load_statistics(std::string_view data) { statistics = deserialize_statistics(data); }
+
+private:
+	Function func;
+	std::vector<FeatureStatistics> statistics;
+	double epsilon = default_epsilon;
+	bool is_frozen = false;
+
+	template <typename Tensor> void normalize_tensor(Tensor& tensor, FeatureStatistics& stats) const {
+		static_assert(std::tuple_size_v<typename Tensor::shape_type> == 2, "Normalized features must be matrices.");
+		auto const n_rows = tensor.shape()[0];
+		auto const n_features = tensor.shape()[1];
+		if (stats.n_features() == 0) {
+			stats = FeatureStatistics{n_features};
+		} else if (stats.n_features() != n_features) {
+			throw std::invalid_argument{"Observations have a different number of features than the statistics."};
+		}
+
+		// Computed once, before the statistics are updated with the values of this observation
+		auto offsets = std::vector<double>(n_features, 0.);
+		auto scales = std::vector<double>(n_features, 1.);
+		for (std::size_t j = 0; j < n_features; ++j) {
+			if (stats.count(j) > 0) {
+				offsets[j] = stats.mean(j);
+				scales[j] = 1. / std::sqrt(stats.variance(j) + epsilon);
+			}
+		}
+
+		using Value = typename Tensor::value_type;
+		auto* row = tensor.data();
+		for (std::size_t i = 0; i < n_rows; ++i, row += n_features) {
+			for (std::size_t j = 0; j < n_features; ++j) {
+				auto const value = static_cast<double>(row[j]);
+				if (!is_frozen) {
+					stats.add(j, value);
+				}
+				row[j] = static_cast<Value>((value - offsets[j]) * scales[j]);
+			}
+		}
+	}
+};
+
+}  // namespace ecole::data
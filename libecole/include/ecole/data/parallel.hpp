@@ -0,0 +1,216 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ecole/data/abstract.hpp"
+#include "ecole/scip/lp-view.hpp"
+#include "ecole/traits.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::data {
+
+namespace internal {
+
+/** Wait for all tasks, since they may refer to the caller's variables, and rethrow the first error. */
+inline void wait_all(std::vector<std::future<void>>& futures, std::exception_ptr error) {
+	for (auto& future : futures) {
+		try {
+			future.get();
+		} catch (...) {
+			if (error == nullptr) {
+				error = std::current_exception();
+			}
+		}
+	}
+	if (error != nullptr) {
+		std::rethrow_exception(error);
+	}
+}
+
+}  // namespace internal
+
+/**
+ * Combine multiple data into a tuple, extracting them concurrently when possible.
+ *
+ * Functions that declare they only read the model (see trait::mutates_model) are extracted concurrently with one
+ * another on a thread pool, with the calling thread extracting the last one.
+ * Other functions are first extracted alone in the calling thread, in order.
+ * The data are the same as the ones of TupleFunction.
+ * Copies of the function share the same thread pool.
+ */
+template <typename... Functions> class ParallelTupleFunction {
+public:
+	using DataTuple = std::tuple<trait::data_of_t<Functions>...>;
+
+	/** The number of functions extracted concurrently. */
+	static constexpr std::size_t n_read_only = (std::size_t{0} + ... + std::size_t{!trait::mutates_model_v<Functions>});
+
+	static constexpr bool uses_lp_view = (trait::uses_lp_view_v<Functions> || ...);
+
+	/** Default construct all functions. */
+	ParallelTupleFunction() : ParallelTupleFunction{std::tuple<Functions...>{}} {}
+
+	/** Store a copy of the functions. */
+	ParallelTupleFunction(Functions... functions) : ParallelTupleFunction{std::tuple{std::move(functions)...}} {}
+	ParallelTupleFunction(std::tuple<Functions...> functions) : data_functions{std::move(functions)} {
+		if constexpr (n_read_only > 1) {
+			thread_pool = std::make_shared<utility::ThreadPool>(n_read_only - 1);
+		}
+	}
+
+	/** Call before_reset on all functions. */
+	auto before_reset(scip::Model& model) -> void {
+		std::apply([&model](auto&... functions) { ((functions.before_reset(model)), ...); }, data_functions);
+	}
+
+	/** Return data from all functions as a tuple. */
+	auto extract(scip::Model& model, bool done) -> DataTuple {
+		return extract_impl(model, done, std::index_sequence_for<Functions...>{});
+	}
+
+private:
+	std::tuple<Functions...> data_functions;
+	/** Shared so that the function remains copyable, null when at most one function is read only. */
+	std::shared_ptr<utility::ThreadPool> thread_pool;
+
+	template <std::size_t... I> auto extract_impl(scip::Model& model, bool done, std::index_sequence<I...>) -> DataTuple {
+		auto results = std::tuple<std::optional<trait::data_of_t<Functions>>...>{};
+		auto const extract_one = [&](auto index) {
+			constexpr auto i = decltype(index)::value;
+			std::get<i>(results).emplace(std::get<i>(data_functions).extract(model, done));
+		};
+
+		// Functions modifying the model must not run concurrently with any other
+		(
+			[&extract_one] {
+				if constexpr (trait::mutates_model_v<Functions>) {
+					extract_one(std::integral_constant<std::size_t, I>{});
+				}
+			}(),
+			...);
+		// Taken after the functions modifying the model, which may change the LP
+		if constexpr (uses_lp_view) {
+			scip::prepare_lp_view(model);
+		}
+
+		auto futures = std::vector<std::future<void>>{};
+		futures.reserve(n_read_only);
+		auto error = std::exception_ptr{};
+		(
+			[&] {
+				if constexpr (!trait::mutates_model_v<Functions>) {
+					auto const index = std::integral_constant<std::size_t, I>{};
+					if (futures.size() + 1 < n_read_only) {
+						futures.push_back(thread_pool->submit([&extract_one, index] { extract_one(index); }));
+					} else {
+						try {
+							extract_one(index);
+						} catch (...) {
+							error = std::current_exception();
+						}
+					}
+				}
+			}(),
+			...);
+		internal::wait_all(futures, error);
+
+		return DataTuple{std::move(std::get<I>(results).value())...};
+	}
+};
+
+/**
+ * Combine multiple data into a vector, extracting them concurrently when possible.
+ *
+ * If the function only reads the model (see trait::mutates_model), the functions are extracted concurrently on a
+ * thread pool, otherwise they are extracted in order as in VectorFunction.
+ * Copies of the function share the same thread pool.
+ */
+template <typename Function> class ParallelVectorFunction {
+public:
+	using DataVector = std::vector<trait::data_of_t<Function>>;
+
+	static constexpr bool uses_lp_view = trait::uses_lp_view_v<Function>;
+
+	/** Default construct with no functions. */
+	ParallelVectorFunction() = default;
+
+	/**
+	 * Store a copy of the functions.
+	 *
+	 * @param functions The functions to extract.
+	 * @param n_threads The number of threads of the pool, or zero to use get_n_threads().
+	 */
+	ParallelVectorFunction(std::vector<Function> functions, std::size_t n_threads = 0) :
+		data_functions{std::move(functions)} {
+		if constexpr (!trait::mutates_model_v<Function>) {
+			if (n_threads == 0) {
+				n_threads = utility::ThreadPool::default_n_threads();
+			}
+			if (data_functions.size() > 1 && n_threads > 1) {
+				thread_pool = std::make_shared<utility::ThreadPool>(n_threads - 1);
+			}
+		}
+	}
+
+	/** Call before_reset on all functions. */
+	auto before_reset(scip::Model& model) -> void {
+		for (auto& func : data_functions) {
+			func.before_reset(model);
+		}
+	}
+
+	/** Return data extracted from all functions as a vector. */
+	auto extract(scip::Model& model, bool done) -> DataVector {
+		auto results = std::vector<std::optional<trait::data_of_t<Function>>>(data_functions.size());
+		auto const extract_range = [&](std::size_t begin, std::size_t end) {
+			for (auto i = begin; i < end; ++i) {
+				results[i].emplace(data_functions[i].extract(model, done));
+			}
+		};
+
+		if constexpr (uses_lp_view) {
+			scip::prepare_lp_view(model);
+		}
+
+		// Functions are partitioned among the threads of the pool and the calling thread, unless already in a pool
+		auto const parallel = thread_pool != nullptr && !utility::ThreadPool::in_worker_thread();
+		auto const n_chunks = parallel ? thread_pool->size() + 1 : std::size_t{1};
+		auto const chunk_size = (data_functions.size() + n_chunks - 1) / n_chunks;
+		auto futures = std::vector<std::future<void>>{};
+		futures.reserve(n_chunks);
+		auto begin = std::size_t{0};
+		for (; begin + chunk_size < data_functions.size(); begin += chunk_size) {
+			futures.push_back(
+				thread_pool->submit([&extract_range, begin, chunk_size] { extract_range(begin, begin + chunk_size); }));
+		}
+		auto error = std::exception_ptr{};
+		try {
+			extract_range(begin, data_functions.size());
+		} catch (...) {
+			error = std::current_exception();
+		}
+		internal::wait_all(futures, error);
+
+		auto data = DataVector{};
+		data.reserve(results.size());
+		for (auto& result : results) {
+			data.push_back(std::move(result).value());
+		}
+		return data;
+	}
+
+private:
+	std::vector<Function> data_functions;
+	/** Shared so that the function remains copyable, null when extracting sequentially. */
+	std::shared_ptr<utility::ThreadPool> thread_pool;
+};
+
+}  // namespace ecole::data
@@ -1,8 +1,13 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
+#include <cstddef>
 #include <iterator>
 #include <map>
+#include <memory>
+#include <numeric>
+#include <string>
 #include <tuple>
 #include <type_traits>
 #include <utility>
@@ -14,6 +19,7 @@
 #include "ecole/data/tuple.hpp"
 #include "ecole/data/vector.hpp"
 #include "ecole/traits.hpp"
+#include "ecole/utility/chrono.hpp"
 
 namespace ecole::data {
 
@@ -45,7 +51,7 @@ template <typename Function, typename Allocator> auto parse(std::vector<Function
 			std::move_iterator{funcs.end()},
 			std::back_inserter(parsed_funcs),
 			[](Function&& func) { return parse(std::move(func)); });
-		return parsed_funcs;
+		return VectorFunction{std::move(parsed_funcs)};
 	}
 }
 
@@ -59,8 +65,160 @@ auto parse(std::map<Key, Function, Compare, Allocator> funcs) {
 		std::for_each(std::move_iterator{funcs.begin()}, std::move_iterator{funcs.end()}, [&parsed_funcs](auto&& key_func) {
 			parsed_funcs.emplace_hint(parsed_funcs.end(), std::move(key_func.first), parse(std::move(key_func.second)));
 		});
-		return parsed_funcs;
+		return MapFunction{std::move(parsed_funcs)};
 	}
 }
 
+/*****************************
+ *  Profiling of extraction  *
+ *****************************/
+
+/** Timings of every call to the extract method of a data function since it was last reset. */
+struct ExtractTimings {
+	std::vector<std::chrono::nanoseconds> wall_times;
+	std::vector<std::chrono::nanoseconds> thread_cpu_times;
+
+	[[nodiscard]] auto n_calls() const noexcept -> std::size_t { return wall_times.size(); }
+	[[nodiscard]] auto total_wall_time() const -> std::chrono::nanoseconds {
+		return std::accumulate(wall_times.begin(), wall_times.end(), std::chrono::nanoseconds{0});
+	}
+	[[nodiscard]] auto total_thread_cpu_time() const -> std::chrono::nanoseconds {
+		return std::accumulate(thread_cpu_times.begin(), thread_cpu_times.end(), std::chrono::nanoseconds{0});
+	}
+};
+
+/**
+ * Timings of all the functions of a composition, indexed by their path in the composition.
+ *
+ * The path of the outermost function is empty, and the path of a function in a tuple, vector, or map is the path of
+ * the container followed by a slash and the index or key of the function (for instance ``/0/node``).
+ */
+using ExtractProfile = std::map<std::string, ExtractTimings>;
+
+/**
+ * Record the time spent extracting data with a function, without changing the data.
+ *
+ * Timings are reset with the function, so that they cover one episode and can be queried once it is over.
+ * Copies of the function record their timings in the same place.
+ */
+template <typename Function> class ProfiledFunction {
+public:
+	ProfiledFunction(Function func_, std::shared_ptr<ExtractProfile> profile_, std::string const& path) :
+		func{std::move(func_)}, profile{std::move(profile_)}, timings{&(*profile)[path]} {}
+
+	/** Reset the wrapped function and its timings. */
+	auto before_reset(scip::Model& model) -> void {
+		timings->wall_times.clear();
+		timings->thread_cpu_times.clear();
+		func.before_reset(model);
+	}
+
+	/** Extract data with the wrapped function and record the time taken. */
+	auto extract(scip::Model& model, bool done) -> trait::data_of_t<Function> {
+		auto const wall_start = std::chrono::steady_clock::now();
+		auto const thread_cpu_start = utility::thread_cpu_clock::now();
+		auto data = func.extract(model, done);
+		timings->thread_cpu_times.push_back(utility::thread_cpu_clock::now() - thread_cpu_start);
+		timings->wall_times.push_back(std::chrono::steady_clock::now() - wall_start);
+		return data;
+	}
+
+private:
+	Function func;
+	std::shared_ptr<ExtractProfile> profile;
+	/** Points into the profile, where map elements are never moved. */
+	ExtractTimings* timings;
+};
+
+namespace internal {
+
+template <typename Key> auto child_path(std::string const& path, Key const& key) -> std::string {
+	if constexpr (std::is_convertible_v<Key const&, std::string>) {
+		return path + '/' + std::string{key};
+	} else {
+		return path + '/' + std::to_string(key);
+	}
+}
+
+template <typename Function>
+auto parse_profiled(Function func, std::shared_ptr<ExtractProfile> const& profile, std::string const& path);
+template <typename... Functions>
+auto parse_profiled(
+	std::tuple<Functions...> func_tuple,
+	std::shared_ptr<ExtractProfile> const& profile,
+	std::string const& path);
+template <typename Function, typename Allocator>
+auto parse_profiled(
+	std::vector<Function, Allocator> funcs,
+	std::shared_ptr<ExtractProfile> const& profile,
+	std::string const& path);
+template <typename Key, typename Function, typename Compare, typename Allocator>
+auto parse_profiled(
+	std::map<Key, Function, Compare, Allocator> funcs,
+	std::shared_ptr<ExtractProfile> const& profile,
+	std::string const& path);
+
+template <typename Function>
+auto parse_profiled(Function func, std::shared_ptr<ExtractProfile> const& profile, std::string const& path) {
+	return ProfiledFunction{parse(std::move(func)), profile, path};
+}
+
+template <typename... Functions, std::size_t... I>
+auto parse_profiled_tuple(
+	std::tuple<Functions...>&& func_tuple,
+	std::shared_ptr<ExtractProfile> const& profile,
+	std::string const& path,
+	std::index_sequence<I...> /*indices*/) {
+	return ProfiledFunction{
+		TupleFunction{parse_profiled(std::get<I>(std::move(func_tuple)), profile, child_path(path, I))...}, profile, path};
+}
+
+template <typename... Functions>
+auto parse_profiled(
+	std::tuple<Functions...> func_tuple,
+	std::shared_ptr<ExtractProfile> const& profile,
+	std::string const& path) {
+	return parse_profiled_tuple(std::move(func_tuple), profile, path, std::index_sequence_for<Functions...>{});
+}
+
+template <typename Function, typename Allocator>
+auto parse_profiled(
+	std::vector<Function, Allocator> funcs,
+	std::shared_ptr<ExtractProfile> const& profile,
+	std::string const& path) {
+	using ParsedFunction = decltype(parse_profiled(std::declval<Function>(), profile, path));
+	auto parsed_funcs = std::vector<ParsedFunction>{};
+	parsed_funcs.reserve(funcs.size());
+	for (std::size_t i = 0; i < funcs.size(); ++i) {
+		parsed_funcs.push_back(parse_profiled(std::move(funcs[i]), profile, child_path(path, i)));
+	}
+	return ProfiledFunction{VectorFunction{std::move(parsed_funcs)}, profile, path};
+}
+
+template <typename Key, typename Function, typename Compare, typename Allocator>
+auto parse_profiled(
+	std::map<Key, Function, Compare, Allocator> funcs,
+	std::shared_ptr<ExtractProfile> const& profile,
+	std::string const& path) {
+	using ParsedFunction = decltype(parse_profiled(std::declval<Function>(), profile, path));
+	auto parsed_funcs = std::map<Key, ParsedFunction>{};
+	for (auto& [key, func] : funcs) {
+		parsed_funcs.emplace_hint(parsed_funcs.end(), key, parse_profiled(std::move(func), profile, child_path(path, key)));
+	}
+	return ProfiledFunction{MapFunction{std::move(parsed_funcs)}, profile, path};
+}
+
+}  // namespace internal
+
+/**
+ * Parse data functions as parse does, timing every function of the composition.
+ *
+ * Every tuple, vector, map, and function they contain is wrapped in a ProfiledFunction, recording its timings in
+ * the profile under its path in the composition.
+ * The data extracted are the same as with parse.
+ */
+template <typename Function> auto parse_profiled(Function func, std::shared_ptr<ExtractProfile> const& profile) {
+	return internal::parse_profiled(std::move(func), profile, "");
+}
+
 }  // namespace ecole::data
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include "ecole/data/abstract.hpp"
+#include "ecole/traits.hpp"
+#include "ecole/utility/recycle-pool.hpp"
+
+namespace ecole::data {
+
+/**
+ * Extract data into objects recycled from a pool rather than allocated on every call.
+ *
+ * The wrapped function must provide an ``extract_into(model, done, data) -> bool`` method that overwrites existing
+ * data, reusing its memory.
+ * Data returned by extract should be given back with release once they are no longer needed.
+ * Data that are not given back are simply destroyed, and new ones are allocated when the pool is empty.
+ * Copies of the function share the same pool.
+ *
+ * @tparam Function The data function extracting into existing data.
+ */
+template <typename Function> class PooledFunction {
+public:
+	using Data = typename trait::data_of_t<Function>::value_type;
+	using Pool = utility::RecyclePool<Data>;
+
+	/**
+	 * Create the function.
+	 *
+	 * @param func The function extracting the data.
+	 * @param capacity The maximum number of released data kept for reuse.
+	 */
+	PooledFunction(Function func_ = {}, std::size_t capacity = 4) :
+		func{std::move(func_)}, the_pool{std::make_shared<Pool>(capacity)} {}
+
+	/** Reset the wrapped function. */
+	auto before_reset(scip::Model& model) -> void { func.before_reset(model); }
+
+	/** Extract data with the wrapped function, in an object taken from the pool. */
+	auto extract(scip::Model& model, bool done) -> std::optional<Data> {
+		auto data = the_pool->acquire();
+		if (func.extract_into(model, done, data)) {
+			return data;
+		}
+		the_pool->release(std::move(data));
+		return {};
+	}
+
+	/** Give back extracted data so that their memory is reused by later calls to extract. */
+	auto release(Data&& data) -> void { the_pool->release(std::move(data)); }
+
+	/** The pool of data, which can outlive the function to release data extracted earlier. */
+	[[nodiscard]] auto pool() const noexcept -> std::shared_ptr<Pool> const& { return the_pool; }
+
+private:
+	Function func;
+	std::shared_ptr<Pool> the_pool;
+};
+
+}  // namespace ecole::data
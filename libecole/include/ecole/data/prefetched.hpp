@@ -0,0 +1,106 @@
+#pragma once
+
+#include <chrono>
+#include <future>
+#include <utility>
+
+#include "ecole/data/abstract.hpp"
+#include "ecole/traits.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::data {
+
+/** Handle to data extracted in the background by a PrefetchedFunction. */
+template <typename Data> class PrefetchedData {
+public:
+	PrefetchedData() = default;
+	explicit PrefetchedData(std::shared_future<Data> future) : m_future{std::move(future)} {}
+
+	/**
+	 * Wait for the data to be extracted and return it.
+	 *
+	 * @throw std::exception Any exception thrown by the extraction.
+	 */
+	[[nodiscard]] auto get() const -> Data const& { return m_future.get(); }
+
+	/** Whether the data is extracted, in which case get does not wait. */
+	[[nodiscard]] auto is_ready() const -> bool {
+		return m_future.wait_for(std::chrono::seconds::zero()) == std::future_status::ready;
+	}
+
+private:
+	std::shared_future<Data> m_future;
+};
+
+/**
+ * Extract the data of a function in the background, while the agent thinks.
+ *
+ * The extraction of the wrapped function is started by extract, which returns at once with a handle to the data.
+ * An environment then returns the state to the agent, which can for instance compute its decision from the action set
+ * or from the other parts of the observation, and only waits for the data when it needs it.
+ * Environments wait for the extraction to finish before the model transitions again (see trait::prefetches).
+ *
+ * Since the extraction runs concurrently with other functions, it must only read the model.
+ * The model must not be used by the agent until the data is ready.
+ *
+ * @tparam Function A data function that does not modify the model (see trait::mutates_model).
+ */
+template <typename Function> class PrefetchedFunction {
+public:
+	using Data = trait::data_of_t<Function>;
+
+	static_assert(!trait::mutates_model_v<Function>, "Only functions reading the model can extract in the background.");
+
+	static constexpr bool mutates_model = false;
+	static constexpr bool uses_lp_view = trait::uses_lp_view_v<Function>;
+	static constexpr bool prefetches = true;
+
+	PrefetchedFunction() = default;
+	PrefetchedFunction(Function function) : m_function{std::move(function)} {}
+
+	/** Copies and moves wait for the extraction, as it refers to the function. */
+	PrefetchedFunction(PrefetchedFunction const& other) : m_function{(other.join(), other.m_function)} {}
+	PrefetchedFunction(PrefetchedFunction&& other) : m_function{(other.join(), std::move(other.m_function))} {}
+	auto operator=(PrefetchedFunction const& other) -> PrefetchedFunction& {
+		join();
+		other.join();
+		m_function = other.m_function;
+		return *this;
+	}
+	auto operator=(PrefetchedFunction&& other) -> PrefetchedFunction& {
+		join();
+		other.join();
+		m_function = std::move(other.m_function);
+		return *this;
+	}
+	~PrefetchedFunction() { join(); }
+
+	auto before_reset(scip::Model& model) -> void {
+		join();
+		m_function.before_reset(model);
+	}
+
+	/** Start extracting the data in the background, and return a handle to it. */
+	auto extract(scip::Model& model, bool done) -> PrefetchedData<Data> {
+		join();
+		m_extraction = utility::ThreadCache::global()
+						   .submit([this, &model, done] { return m_function.extract(model, done); })
+						   .share();
+		return PrefetchedData<Data>{m_extraction};
+	}
+
+	/** Wait for the extraction started by the last call to extract, after which the model can be modified. */
+	auto join() const -> void {
+		if (m_extraction.valid()) {
+			m_extraction.wait();
+		}
+	}
+
+	[[nodiscard]] auto function() noexcept -> Function& { return m_function; }
+
+private:
+	Function m_function;
+	std::shared_future<Data> m_extraction;
+};
+
+}  // namespace ecole::data
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <chrono>
+#include <stdexcept>
 #include <utility>
 
 #include "ecole/data/abstract.hpp"
@@ -24,10 +25,22 @@ template <typename Clock, typename Func> auto time(Func&& func) -> double {
 
 }  // namespace internal
 
+/**
+ * Time the extract method of a function.
+ *
+ * With ``thread_cpu``, only the CPU time of the calling thread is measured, so that functions timed in other threads,
+ * such as other environments, do not count.
+ */
 template <typename Function> class TimedFunction {
 public:
-	TimedFunction(Function func_, bool wall_ = false) : func{std::move(func_)}, wall{wall_} {}
-	TimedFunction(bool wall_ = false) : wall{wall_} {}
+	/** @throw std::invalid_argument If both the wall time and the thread CPU time are requested, as in SolvingTime. */
+	TimedFunction(Function func_, bool wall_ = false, bool thread_cpu_ = false) :
+		func{std::move(func_)}, wall{wall_}, thread_cpu{thread_cpu_} {
+		check_clocks();
+	}
+	TimedFunction(bool wall_ = false, bool thread_cpu_ = false) : wall{wall_}, thread_cpu{thread_cpu_} {
+		check_clocks();
+	}
 
 	/** Reset the function being timed. **/
 	auto before_reset(scip::Model& model) -> void { func.before_reset(model); }
@@ -37,12 +50,22 @@ public:
 		if (wall) {
 			return internal::time<std::chrono::steady_clock>([&]() { return func.extract(model, done); });
 		}
+		if (thread_cpu) {
+			return internal::time<utility::thread_cpu_clock>([&]() { return func.extract(model, done); });
+		}
 		return internal::time<utility::cpu_clock>([&]() { return func.extract(model, done); });
 	}
 
 private:
 	Function func{};
 	bool wall = false;
+	bool thread_cpu = false;
+
+	void check_clocks() const {
+		if (wall && thread_cpu) {
+			throw std::invalid_argument{"The thread CPU time cannot be used with the wall time."};
+		}
+	}
 };
 
 }  // namespace ecole::data
@@ -0,0 +1,292 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/export.hpp"
+#include "ecole/observation/node-bipartite.hpp"
+#include "ecole/random.hpp"
+#include "ecole/utility/tensor-view.hpp"
+
+namespace ecole::data {
+
+/**
+ * A transition of a trajectory, as collected for imitation learning.
+ *
+ * @tparam Value The floating point type of the observation features.
+ */
+template <typename Value> struct ECOLE_EXPORT BasicTrajectoryStep {
+	observation::BasicNodeBipartiteObs<Value> observation;
+	xt::xtensor<std::size_t, 1> action_set;
+	std::size_t action = 0;
+	double reward = 0.;
+};
+
+using TrajectoryStep = BasicTrajectoryStep<double>;
+using TrajectoryStepFloat32 = BasicTrajectoryStep<float>;
+
+/**
+ * A transition of a trajectory viewed in place in a trajectory file.
+ *
+ * Tensors stored uncompressed, with their full integer width, and not as differences point directly into the mapped
+ * file, other ones are decoded in buffers owned by the sample.
+ * The views remain valid as long as the sample (or a copy of ``memory``) is alive, even if the reader is destroyed.
+ *
+ * @tparam Value The floating point type of the observation features.
+ */
+template <typename Value> struct ECOLE_EXPORT BasicTrajectorySample {
+	observation::BasicNodeBipartiteObsView<Value> observation;
+	utility::tensor_view<std::size_t, 1> action_set;
+	std::size_t action = 0;
+	double reward = 0.;
+	/** Keep alive the memory viewed by the tensors. */
+	std::shared_ptr<void const> memory;
+};
+
+using TrajectorySample = BasicTrajectorySample<double>;
+using TrajectorySampleFloat32 = BasicTrajectorySample<float>;
+
+/** The compression of the shuffled bytes of tensors in trajectory files. */
+enum struct ECOLE_EXPORT TrajectoryCompression {
+	/** Runs of zeros are replaced by their length, which is fast and effective on zero and one hot features. */
+	zero_runs,
+	/** Bytes are compressed with zstd, which is slower but smaller, and requires Ecole to be built with zstd. */
+	zstd,
+};
+
+/**
+ * Stream trajectory steps to a compact binary file.
+ *
+ * Steps are serialized in memory and written to the file by chunks of ``chunk_size`` steps.
+ * Integer tensors are stored with the smallest integer width that can represent their values, and tensors can
+ * optionally be compressed by shuffling their bytes and compressing them, losslessly.
+ * Feature matrices are compressed column by column, so that the bytes of the values of a same feature are contiguous.
+ * Sorted integer tensors, such as edge indices, can be stored as the differences of consecutive values, which are
+ * narrower.
+ * An index of the steps is appended when the writer is closed, but files that were not closed can still be read.
+ *
+ * The file uses the native byte order and is not meant to be exchanged between machines of different endianness.
+ *
+ * @tparam Value The floating point type of the observation features.
+ */
+template <typename Value> class ECOLE_EXPORT BasicTrajectoryWriter {
+public:
+	/**
+	 * Create a new file, overwriting existing ones.
+	 *
+	 * @param filename The file to write.
+	 * @param compress Whether to compress tensors, which makes writing slower.
+	 * @param chunk_size The number of steps buffered in memory before being written to the file.
+	 * @param narrow_integers Whether to store integers with the smallest width possible.
+	 *  Files written without compression nor narrowing can be viewed without any copy.
+	 * @param compression How to compress the shuffled bytes of tensors when ``compress`` is set.
+	 * @param delta_integers Whether to store integer tensors as the differences of consecutive values along their last
+	 *  dimension, when the differences are smaller than the values.
+	 * @throw std::invalid_argument If the chunk size is zero.
+	 * @throw std::runtime_error If the file cannot be opened, or zstd is requested in a build without it.
+	 */
+	ECOLE_EXPORT BasicTrajectoryWriter(
+		std::filesystem::path const& filename,
+		bool compress = false,
+		std::size_t chunk_size = 64,
+		bool narrow_integers = true,
+		TrajectoryCompression compression = TrajectoryCompression::zero_runs,
+		bool delta_integers = false);
+	BasicTrajectoryWriter(BasicTrajectoryWriter const&) = delete;
+	BasicTrajectoryWriter(BasicTrajectoryWriter&&) = delete;
+	auto operator=(BasicTrajectoryWriter const&) -> BasicTrajectoryWriter& = delete;
+	auto operator=(BasicTrajectoryWriter&&) -> BasicTrajectoryWriter& = delete;
+
+	/** Close the file if it was not already, ignoring errors. */
+	ECOLE_EXPORT ~BasicTrajectoryWriter();
+
+	/** Append a step to the trajectory. */
+	ECOLE_EXPORT void write(BasicTrajectoryStep<Value> const& step);
+	/** Append a step to the trajectory, without having to copy its parts in a BasicTrajectoryStep. */
+	ECOLE_EXPORT void write(
+		observation::BasicNodeBipartiteObs<Value> const& observation,
+		xt::xtensor<std::size_t, 1> const& action_set,
+		std::size_t action,
+		double reward);
+
+	/** Write buffered steps and the index of steps, after which no step can be written. */
+	ECOLE_EXPORT void close();
+
+	/** The number of steps written so far. */
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return step_offsets.size(); }
+
+private:
+	std::ofstream file;
+	bool compress;
+	std::size_t chunk_size;
+	bool narrow_integers;
+	TrajectoryCompression compression;
+	bool delta_integers;
+	std::vector<char> chunk;
+	std::size_t n_chunk_steps = 0;
+	std::uint64_t file_offset = 0;
+	std::vector<std::uint64_t> step_offsets;
+
+	void flush_chunk();
+};
+
+/**
+ * Random access to the steps of a file written by BasicTrajectoryWriter.
+ *
+ * The file is memory mapped, so only the steps being read are loaded into memory, and reading steps concurrently
+ * from multiple threads is safe.
+ * The mapping is shared with the samples returned by view, so the reader can be moved or destroyed while they are used.
+ *
+ * @tparam Value The floating point type of the observation features, which must match the one used for writing.
+ */
+template <typename Value> class ECOLE_EXPORT BasicTrajectoryReader {
+public:
+	/**
+	 * Map the file in memory and read its index of steps.
+	 *
+	 * @throw std::runtime_error If the file cannot be opened or is not a valid trajectory file.
+	 */
+	ECOLE_EXPORT BasicTrajectoryReader(std::filesystem::path const& filename);
+	/** The number of steps in the file. */
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return step_offsets.size(); }
+
+	/**
+	 * Read the step at the given position in the trajectory.
+	 *
+	 * @throw std::out_of_range If the index is not smaller than the number of steps.
+	 * @throw std::runtime_error If the step is corrupted.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto read(std::size_t index) const -> BasicTrajectoryStep<Value>;
+
+	/**
+	 * View the step at the given position in the trajectory, without copying tensors when possible.
+	 *
+	 * @throw std::out_of_range If the index is not smaller than the number of steps.
+	 * @throw std::runtime_error If the step is corrupted.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto view(std::size_t index) const -> BasicTrajectorySample<Value>;
+
+private:
+	std::shared_ptr<std::byte const> data;
+	std::size_t data_size = 0;
+	std::vector<std::uint64_t> step_offsets;
+};
+
+/**
+ * The steps of multiple trajectory files, indexed contiguously.
+ *
+ * @tparam Value The floating point type of the observation features, which must match the one used for writing.
+ */
+template <typename Value> class ECOLE_EXPORT BasicTrajectoryDataset {
+public:
+	/**
+	 * Map all the files in memory.
+	 *
+	 * @throw std::runtime_error If a file cannot be opened or is not a valid trajectory file.
+	 */
+	ECOLE_EXPORT BasicTrajectoryDataset(std::vector<std::filesystem::path> const& filenames);
+
+	/** The total number of steps in the files. */
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return first_steps.back(); }
+
+	/**
+	 * Read the step at the given position in the dataset.
+	 *
+	 * @throw std::out_of_range If the index is not smaller than the number of steps.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto read(std::size_t index) const -> BasicTrajectoryStep<Value>;
+
+	/**
+	 * View the step at the given position in the dataset.
+	 *
+	 * @throw std::out_of_range If the index is not smaller than the number of steps.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto view(std::size_t index) const -> BasicTrajectorySample<Value>;
+
+private:
+	std::vector<BasicTrajectoryReader<Value>> readers;
+	/** The index of the first step of every file, followed by the total number of steps. */
+	std::vector<std::size_t> first_steps;
+
+	[[nodiscard]] auto locate(std::size_t index) const -> std::pair<BasicTrajectoryReader<Value> const&, std::size_t>;
+};
+
+/**
+ * Iterate once over the steps of a dataset in a random order.
+ *
+ * A background thread views the next steps and touches their memory so that the pages are loaded from disk before
+ * they are needed.
+ *
+ * @tparam Value The floating point type of the observation features.
+ */
+template <typename Value> class ECOLE_EXPORT BasicShuffledTrajectoryIterator {
+public:
+	/**
+	 * Shuffle the indices of the dataset and start prefetching.
+	 *
+	 * @param dataset The dataset to iterate over, which must outlive the iterator.
+	 * @param rng The random generator used to shuffle the steps.
+	 * @param n_prefetch The maximum number of steps prefetched ahead.
+	 * @throw std::invalid_argument If the number of steps prefetched is zero.
+	 */
+	ECOLE_EXPORT BasicShuffledTrajectoryIterator(
+		BasicTrajectoryDataset<Value> const& dataset,
+		RandomGenerator& rng,
+		std::size_t n_prefetch = 16);
+	BasicShuffledTrajectoryIterator(BasicShuffledTrajectoryIterator const&) = delete;
+	BasicShuffledTrajectoryIterator(BasicShuffledTrajectoryIterator&&) = delete;
+	auto operator=(BasicShuffledTrajectoryIterator const&) -> BasicShuffledTrajectoryIterator& = delete;
+	auto operator=(BasicShuffledTrajectoryIterator&&) -> BasicShuffledTrajectoryIterator& = delete;
+
+	/** Stop prefetching and wait for the background thread. */
+	ECOLE_EXPORT ~BasicShuffledTrajectoryIterator();
+
+	/**
+	 * The next step in the random order, or nothing once all steps have been returned.
+	 *
+	 * Errors raised while prefetching, such as corrupted steps, are rethrown here.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto next() -> std::optional<BasicTrajectorySample<Value>>;
+
+	/** The shuffled indices of the steps in the dataset. */
+	[[nodiscard]] auto order() const noexcept -> std::vector<std::size_t> const& { return indices; }
+
+private:
+	BasicTrajectoryDataset<Value> const& dataset;
+	std::vector<std::size_t> indices;
+	std::size_t n_prefetch;
+	std::size_t n_returned = 0;
+	std::mutex mutex;
+	std::condition_variable prefetched_cv;
+	std::condition_variable consumed_cv;
+	std::deque<BasicTrajectorySample<Value>> prefetched;
+	std::exception_ptr error;
+	bool stopping = false;
+	std::thread worker;
+
+	void prefetch();
+};
+
+using TrajectoryWriter = BasicTrajectoryWriter<double>;
+using TrajectoryWriterFloat32 = BasicTrajectoryWriter<float>;
+using TrajectoryReader = BasicTrajectoryReader<double>;
+using TrajectoryReaderFloat32 = BasicTrajectoryReader<float>;
+using TrajectoryDataset = BasicTrajectoryDataset<double>;
+using TrajectoryDatasetFloat32 = BasicTrajectoryDataset<float>;
+using ShuffledTrajectoryIterator = BasicShuffledTrajectoryIterator<double>;
+using ShuffledTrajectoryIteratorFloat32 = BasicShuffledTrajectoryIterator<float>;
+
+}  // namespace ecole::data
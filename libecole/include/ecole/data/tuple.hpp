@@ -1,8 +1,14 @@
 #pragma once
 
+#include <cstddef>
+#include <optional>
 #include <tuple>
+#include <type_traits>
+#include <utility>
 
 #include "ecole/data/abstract.hpp"
+#include "ecole/scip/lp-view.hpp"
+#include "ecole/scip/model.hpp"
 #include "ecole/traits.hpp"
 
 namespace ecole::data {
@@ -11,6 +17,10 @@ template <typename... Functions> class TupleFunction {
 public:
 	using DataTuple = std::tuple<trait::data_of_t<Functions>...>;
 
+	/** The fused traversal reads the LP view, even if the functions visiting the LP do not otherwise. */
+	static constexpr bool uses_lp_view = ((trait::uses_lp_view_v<Functions> || trait::visits_lp_v<Functions>) || ...);
+	static constexpr bool prefetches = (trait::prefetches_v<Functions> || ...);
+
 	/** Default construct all functions. */
 	TupleFunction() = default;
 
@@ -23,14 +33,106 @@ public:
 		std::apply([&model](auto&... functions) { ((functions.before_reset(model)), ...); }, data_functions);
 	}
 
-	/** Return data from all functions as a tuple. */
+	/**
+	 * Return data from all functions as a tuple.
+	 *
+	 * The functions visiting the LP (see trait::visits_lp) share a single traversal of the columns and rows of the LP
+	 * view, however many of them there are.
+	 * The functions extracting in the background (see trait::prefetches) are started last, so that they do not run
+	 * concurrently with the other functions.
+	 */
 	auto extract(scip::Model& model, bool done) -> DataTuple {
-		return std::apply(
-			[&model, done](auto&... functions) { return std::tuple{functions.extract(model, done)...}; }, data_functions);
+		if constexpr (fuses || prefetches) {
+			return extract_ordered(model, done, std::index_sequence_for<Functions...>{});
+		} else {
+			return std::apply(
+				[&model, done](auto&... functions) { return std::tuple{functions.extract(model, done)...}; },
+				data_functions);
+		}
+	}
+
+	/** Wait for the functions extracting in the background. */
+	auto join() const -> void {
+		std::apply(
+			[](auto const&... functions) {
+				(
+					[&functions] {
+						if constexpr (trait::prefetches_v<std::decay_t<decltype(functions)>>) {
+							functions.join();
+						}
+					}(),
+					...);
+			},
+			data_functions);
 	}
 
 private:
 	std::tuple<Functions...> data_functions;
+
+	static constexpr bool fuses = (trait::visits_lp_v<Functions> || ...);
+
+	/** Placeholder visitor of the functions not visiting the LP. */
+	struct NoVisitor {};
+
+	template <typename Function> static auto make_visitor(Function& function, scip::Model& model, bool done) {
+		if constexpr (trait::visits_lp_v<Function>) {
+			return function.lp_visitor(model, done);
+		} else {
+			return NoVisitor{};
+		}
+	}
+
+	template <std::size_t... I>
+	auto extract_ordered(scip::Model& model, bool done, std::index_sequence<I...> /*indices*/) -> DataTuple {
+		auto results = std::tuple<std::optional<trait::data_of_t<Functions>>...>{};
+		auto const extract_if = [&](auto index, bool selected) {
+			constexpr auto i = decltype(index)::value;
+			if (selected && !std::get<i>(results).has_value()) {
+				std::get<i>(results).emplace(std::get<i>(data_functions).extract(model, done));
+			}
+		};
+
+		if constexpr (fuses) {
+			if (model.stage() == SCIP_STAGE_SOLVING) {
+				visit_lp(model, done, results, std::index_sequence<I...>{});
+			}
+		}
+		(extract_if(std::integral_constant<std::size_t, I>{}, !trait::prefetches_v<Functions>), ...);
+		(extract_if(std::integral_constant<std::size_t, I>{}, trait::prefetches_v<Functions>), ...);
+
+		return DataTuple{std::move(std::get<I>(results).value())...};
+	}
+
+	/** Set the data of the functions visiting the LP, in a single traversal for all of them. */
+	template <typename Results, std::size_t... I>
+	auto visit_lp(scip::Model& model, bool done, Results& results, std::index_sequence<I...> /*indices*/) -> void {
+		auto const lp = model.lp_view();
+		auto visitors = std::tuple{make_visitor(std::get<I>(data_functions), model, done)...};
+		auto const visit = [&visitors](auto&& visit_one) {
+			std::apply([&visit_one](auto&... visitor) { (visit_one(visitor), ...); }, visitors);
+		};
+		for (std::size_t j = 0; j < lp->n_columns(); ++j) {
+			visit([&lp, j](auto& visitor) {
+				if constexpr (!std::is_same_v<std::decay_t<decltype(visitor)>, NoVisitor>) {
+					visitor.visit_column(*lp, j);
+				}
+			});
+		}
+		for (std::size_t i = 0; i < lp->n_rows(); ++i) {
+			visit([&lp, i](auto& visitor) {
+				if constexpr (!std::is_same_v<std::decay_t<decltype(visitor)>, NoVisitor>) {
+					visitor.visit_row(*lp, i);
+				}
+			});
+		}
+		(
+			[&] {
+				if constexpr (trait::visits_lp_v<Functions>) {
+					std::get<I>(results).emplace(std::get<I>(visitors).finish());
+				}
+			}(),
+			...);
+	}
 };
 
 }  // namespace ecole::data
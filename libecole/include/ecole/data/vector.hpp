@@ -15,6 +15,8 @@ template <typename Function> class VectorFunction {
 public:
 	using DataVector = std::vector<trait::data_of_t<Function>>;
 
+	static constexpr bool uses_lp_view = trait::uses_lp_view_v<Function>;
+
 	/** Default construct all functions. */
 	VectorFunction() = default;
 
@@ -38,6 +40,9 @@ public:
 		return data;
 	}
 
+	/** The functions, in the order of their data. */
+	[[nodiscard]] auto functions() noexcept -> std::vector<Function>& { return data_functions; }
+
 private:
 	std::vector<Function> data_functions;
 };
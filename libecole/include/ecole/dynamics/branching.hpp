@@ -1,12 +1,18 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
 #include <optional>
 
+#include <nonstd/span.hpp>
 #include <xtensor/xtensor.hpp>
 
 #include "ecole/default.hpp"
 #include "ecole/dynamics/parts.hpp"
+#include "ecole/dynamics/schedule.hpp"
 #include "ecole/export.hpp"
 
 namespace ecole::dynamics {
@@ -15,17 +21,150 @@ class ECOLE_EXPORT BranchingDynamics : public DefaultSetDynamicsRandomState {
 public:
 	using Action = Defaultable<std::size_t>;
 	using ActionSet = std::optional<xt::xtensor<std::size_t, 1>>;
+	/** Function making branching decisions directly in the solver thread. */
+	using Policy = std::function<Action(scip::Model&, ActionSet const&)>;
 
-	using DefaultSetDynamicsRandomState::set_dynamics_random_state;
+	/**
+	 * Create new dynamics.
+	 *
+	 * @param pseudo_candidates Whether the action set contains pseudo branching candidates rather than LP ones.
+	 * @param schedule The nodes on which control is given to the agent, other nodes being branched on by SCIP
+	 *        default rules in the solver thread.
+	 * @param presolve_cache_size The number of presolved problems kept to start later episodes on the same instances
+	 *        without presolving them again, zero disabling the cache.
+	 * @param cache_root_cuts Whether to also keep the cuts separated at the root node of the presolved problems, and
+	 *        add them to the problem of later episodes.
+	 * @param step_deadline How long the solver waits for the action once the state is extracted, before branching
+	 *        with SCIP default rules and solving until the next state, zero waiting forever (see start_step_deadline).
+	 * @param explore_policy The policy branching on the nodes not selected by the schedule, in the solver thread, or
+	 *        an empty function to use SCIP default rules.
+	 *        Exceptions thrown by the policy interrupt solving and are rethrown by reset_dynamics and step_dynamics.
+	 * @throw std::invalid_argument If root cuts are cached without a presolve cache.
+	 */
+	ECOLE_EXPORT BranchingDynamics(
+		bool pseudo_candidates = false,
+		ObservationSchedule schedule = {},
+		std::size_t presolve_cache_size = 0,
+		bool cache_root_cuts = false,
+		std::chrono::milliseconds step_deadline = std::chrono::milliseconds::zero(),
+		Policy explore_policy = nullptr);
 
-	ECOLE_EXPORT BranchingDynamics(bool pseudo_candidates = false) noexcept;
+	/**
+	 * Copy the dynamics, sharing only the presolve cache.
+	 *
+	 * The copy has its own schedule, state of branching decisions, and action set buffers, so that copies can be
+	 * used concurrently in different threads.
+	 */
+	ECOLE_EXPORT BranchingDynamics(BranchingDynamics const& other);
+	BranchingDynamics(BranchingDynamics&&) = default;
+	ECOLE_EXPORT auto operator=(BranchingDynamics const& other) -> BranchingDynamics&;
+	auto operator=(BranchingDynamics&&) -> BranchingDynamics& = default;
+	~BranchingDynamics() = default;
+
+	/**
+	 * Set seeds on the model and draw the random state of the schedule.
+	 *
+	 * When the presolve cache is enabled, the model is first replaced by a copy of its presolved problem, which is
+	 * presolved once for every instance and set of parameters, randomization parameters aside.
+	 * Problems without an exact fingerprint (see scip::Model::exact_fingerprint) are not cached.
+	 * The model then starts in the problem stage, with the transformed variables and constraints, and with presolving
+	 * disabled.
+	 * With root cuts cached, the root node of every new presolved problem is solved once on a copy to separate cuts,
+	 * which are then added as linear constraints to the problem of every episode.
+	 */
+	ECOLE_EXPORT auto set_dynamics_random_state(scip::Model& model, RandomGenerator& rng) const -> void;
 
 	ECOLE_EXPORT auto reset_dynamics(scip::Model& model) const -> std::tuple<bool, ActionSet>;
 
+	/**
+	 * Branch on the given variable and solve until the next state.
+	 *
+	 * If the step deadline has passed, the action is dropped, as SCIP already branched on the node, and the dynamics
+	 * wait for the next state.
+	 */
 	ECOLE_EXPORT auto step_dynamics(scip::Model& model, Action maybe_var_idx) const -> std::tuple<bool, ActionSet>;
 
+	/**
+	 * Branch on the given variable, then let the policy branch on the following nodes.
+	 *
+	 * The policy is called directly in the solver thread on the next ``n_nodes - 1`` nodes, so that control is given
+	 * back only once every ``n_nodes`` branching decisions.
+	 * Exceptions thrown by the policy interrupt solving and are rethrown by this function.
+	 */
+	ECOLE_EXPORT auto step_dynamics(scip::Model& model, Action maybe_var_idx, std::size_t n_nodes, Policy policy) const
+		-> std::tuple<bool, ActionSet>;
+
+	/**
+	 * Create a policy branching on the candidate with the highest score.
+	 *
+	 * @param scores The score of every variable, indexed by their problem index.
+	 */
+	ECOLE_EXPORT static auto score_policy(xt::xtensor<double, 1> scores) -> Policy;
+
+	/**
+	 * Create a policy branching on the candidate with the highest pseudocost score.
+	 *
+	 * Together with a probabilistic schedule and StrongBranchingScores, this is the explore-then-strong-branch scheme
+	 * used to collect imitation learning datasets, where only the nodes sampled for the expert reach the agent.
+	 */
+	ECOLE_EXPORT static auto pseudocost_policy() -> Policy;
+
+	/**
+	 * Return the action set of the current node in a buffer reused across calls, without allocating.
+	 *
+	 * The view is invalidated by the next call, or when the dynamics are destroyed.
+	 * Returns nothing when the model is not solving.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto action_set_view(scip::Model const& model) const
+		-> std::optional<nonstd::span<std::size_t const>>;
+
+	/** Same as action_set_view with 32 bits indices, for instance to feed models expecting them. */
+	[[nodiscard]] ECOLE_EXPORT auto action_set_view_32(scip::Model const& model) const
+		-> std::optional<nonstd::span<std::uint32_t const>>;
+
+	/**
+	 * Return the action set of the current node as a mask over all variables, in a buffer reused across calls.
+	 *
+	 * The mask holds a byte per variable, indexed as the variables of the model, set to one for the candidates, so
+	 * that it can be applied directly to the scores of all variables.
+	 * When packed, it holds a bit per variable, bit ``i % 8`` of byte ``i / 8`` being the one of variable ``i``.
+	 * The view is invalidated by the next call with the same packing, or when the dynamics are destroyed.
+	 * Returns nothing when the model is not solving.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto action_mask_view(scip::Model const& model, bool packed = false) const
+		-> std::optional<nonstd::span<std::uint8_t const>>;
+
+	/**
+	 * Start the step deadline of the current state, if any.
+	 *
+	 * Environments call it once they are done extracting data from the state, but not from reset_lazy and step_lazy
+	 * since the observation may still need the model.
+	 * From then on, the solver may branch by itself and keep solving, so the model must not be used until the next
+	 * call to step_dynamics.
+	 */
+	ECOLE_EXPORT auto start_step_deadline(scip::Model& model) const -> void;
+
+	[[nodiscard]] auto step_deadline() const noexcept -> std::chrono::milliseconds { return m_step_deadline; }
+
+	/** The number of presolved problems currently in the cache. */
+	[[nodiscard]] ECOLE_EXPORT auto n_presolved_cached() const -> std::size_t;
+
 private:
+	/** State shared with the branchrule to make decisions in the solver thread, not with copies. */
+	struct InlineBranching;
+
 	bool pseudo_candidates;
+	std::chrono::milliseconds m_step_deadline;
+	std::shared_ptr<InlineBranching> inline_branching;
+	Policy explore_policy;
+	/** Shared with the branchrule, which updates it in the solver thread. */
+	std::shared_ptr<ObservationSchedule> schedule;
+	/** Buffers of the action set views. */
+	struct ViewBuffers;
+	std::shared_ptr<ViewBuffers> view_buffers;
+	/** Presolved problems, shared by copies of the dynamics. */
+	struct PresolveCache;
+	std::shared_ptr<PresolveCache> presolve_cache;
 };
 
 }  // namespace ecole::dynamics
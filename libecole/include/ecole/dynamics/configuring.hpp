@@ -1,7 +1,10 @@
 #pragma once
 
+#include <cstddef>
 #include <map>
+#include <memory>
 #include <string>
+#include <string_view>
 
 #include "ecole/dynamics/parts.hpp"
 #include "ecole/export.hpp"
@@ -15,16 +18,70 @@ namespace ecole::dynamics {
  */
 using ParamDict = std::map<std::string, scip::Param>;
 
+/**
+ * The earliest phase of the solving process that a parameter affects.
+ */
+enum struct SolvePhase {
+	/** The parameter may change the presolved problem. */
+	presolving,
+	/** The parameter only affects the solving of the presolved problem, such as branching or node selection. */
+	solving,
+};
+
+/**
+ * Classify a SCIP parameter by the solve phase it affects.
+ *
+ * Parameters of branching rules, node selectors, separators, cut selectors, the LP, conflict analysis, limits,
+ * parallelism, and display are only read when solving the presolved problem, as are the frequencies of constraint
+ * handlers and propagators.
+ * Any other parameter, including those mentioning presolving in any plugin, is conservatively considered to affect
+ * presolving.
+ * This includes parameters of primal heuristics, since some run during presolving, and the solutions they find are
+ * used in presolving reductions.
+ */
+ECOLE_EXPORT auto param_phase(std::string_view name) noexcept -> SolvePhase;
+
 class ECOLE_EXPORT ConfiguringDynamics : public DefaultSetDynamicsRandomState {
 public:
 	using Action = ParamDict;
 	using ActionSet = NoneType;
 
+	/**
+	 * Create new dynamics.
+	 *
+	 * @param n_threads The number of threads solving every instance.
+	 *        With more than one thread, instances are solved with the SCIP concurrent solver, which races differently
+	 *        configured copies of the problem and keeps the result and statistics of the first to finish.
+	 *        This requires SCIP to be built with a task processing interface (``TPI``), otherwise instances are solved
+	 *        sequentially.
+	 * @param reuse_presolve Whether to presolve every instance once, for all the configurations only setting solving
+	 *        parameters (see param_phase).
+	 *        The presolved problem is cached, along with the fingerprint and the presolving parameters of the model,
+	 *        and loaded instead of presolving again when they match.
+	 *        Problems without an exact fingerprint (see Model::exact_fingerprint) are presolved as usual.
+	 *        The model then solves the presolved problem as its original problem, with presolving rounds disabled,
+	 *        so solutions and statistics are those of the presolved problem.
+	 *        Randomization parameters are not part of the key, so that episodes of different seeds share the presolved
+	 *        problem of the first one.
+	 * @throw std::invalid_argument If the number of threads is zero.
+	 */
+	ECOLE_EXPORT explicit ConfiguringDynamics(std::size_t n_threads = 1, bool reuse_presolve = false);
+
 	using DefaultSetDynamicsRandomState::set_dynamics_random_state;
 
 	ECOLE_EXPORT auto reset_dynamics(scip::Model& model) const -> std::tuple<bool, ActionSet>;
 
 	ECOLE_EXPORT auto step_dynamics(scip::Model& model, Action const& param_dict) const -> std::tuple<bool, ActionSet>;
+
+	[[nodiscard]] auto n_threads() const noexcept -> std::size_t { return m_n_threads; }
+	[[nodiscard]] auto reuse_presolve() const noexcept -> bool { return m_presolve_cache != nullptr; }
+
+private:
+	struct PresolveCache;
+
+	std::size_t m_n_threads;
+	/** Shared by copies of the dynamics, which solve the same instances. */
+	std::shared_ptr<PresolveCache> m_presolve_cache;
 };
 
 }  // namespace ecole::dynamics
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <vector>
+
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/default.hpp"
+#include "ecole/dynamics/parts.hpp"
+#include "ecole/export.hpp"
+
+namespace ecole::dynamics {
+
+/**
+ * Cut selection dynamics.
+ *
+ * Control is given back to the agent every time SCIP selects the cuts to add to the LP, in every separation round.
+ * The action set is a matrix of features of the candidate cuts, and the action is the indices of the cuts to add.
+ * Forced cuts are always added, and are not part of the candidates.
+ */
+class ECOLE_EXPORT CutSelectionDynamics : public DefaultSetDynamicsRandomState {
+public:
+	/** The columns of the action set. */
+	enum struct Column : std::size_t {
+		/** Distance of the cut to the LP solution, normalized by the cut norm (``SCIPgetCutEfficacy``). */
+		efficacy = 0,
+		/** Cosine between the cut and the objective (``SCIPgetRowObjParallelism``). */
+		objective_parallelism = 1,
+		/** Fraction of the LP columns in the cut. */
+		support = 2,
+		/** Fraction of the cut columns that are integral. */
+		integer_support = 3,
+	};
+	static constexpr std::size_t n_columns = 4;
+
+	/** Indices of the candidate cuts to add, or Default to let SCIP default cut selector choose. */
+	using Action = Defaultable<std::vector<std::size_t>>;
+	/** One row per candidate cut, with the columns of Column, or nothing when solving is finished. */
+	using ActionSet = std::optional<xt::xtensor<double, 2>>;
+
+	ECOLE_EXPORT CutSelectionDynamics();
+
+	ECOLE_EXPORT auto reset_dynamics(scip::Model& model) const -> std::tuple<bool, ActionSet>;
+
+	/**
+	 * Add the given cuts and resume solving until the next cut selection.
+	 *
+	 * @throw std::invalid_argument If an index is out of range or repeated, or more cuts are selected than SCIP
+	 *        allows in the current round.
+	 */
+	ECOLE_EXPORT auto step_dynamics(scip::Model& model, Action const& maybe_cut_indices) const
+		-> std::tuple<bool, ActionSet>;
+
+private:
+	/** The cut selector call waiting for the agent. */
+	struct PendingCall;
+
+	std::shared_ptr<PendingCall> pending;
+};
+
+}  // namespace ecole::dynamics
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/dynamics/parts.hpp"
+#include "ecole/export.hpp"
+#include "ecole/none.hpp"
+
+namespace ecole::dynamics {
+
+/**
+ * Branching with a policy called directly by SCIP.
+ *
+ * Contrary to BranchingDynamics, the solver is not paused on every branching decision.
+ * Instead, the policy is called from within a branchrule, in the solver thread, so that episodes are solved at the
+ * speed of a native branchrule.
+ * Episodes have length one: the instance is solved in a single step.
+ * Observation functions can still be used in the policy by extracting them from the model it is given, after having
+ * called their ``before_reset`` method.
+ */
+class ECOLE_EXPORT InlinePolicyBranching : public DefaultSetDynamicsRandomState {
+public:
+	using Action = NoneType;
+	using ActionSet = NoneType;
+	/** The branching candidates, as variable indices in the transformed problem. */
+	using Candidates = xt::xtensor<std::size_t, 1>;
+	/** Function returning the index of the variable to branch on. */
+	using Policy = std::function<std::size_t(scip::Model&, Candidates const&)>;
+
+	/**
+	 * Create the dynamics with the policy making all branching decisions.
+	 *
+	 * @param policy The branching policy, or an empty function to use SCIP default branching.
+	 * @param pseudo_candidates Whether to give the policy pseudo branching candidates rather than LP candidates.
+	 */
+	ECOLE_EXPORT InlinePolicyBranching(Policy policy = nullptr, bool pseudo_candidates = false);
+
+	using DefaultSetDynamicsRandomState::set_dynamics_random_state;
+
+	ECOLE_EXPORT auto reset_dynamics(scip::Model& model) const -> std::tuple<bool, ActionSet>;
+
+	/**
+	 * Solve the instance, branching with the policy.
+	 *
+	 * @throw std::exception The first exception raised by the policy, which interrupts solving.
+	 */
+	ECOLE_EXPORT auto step_dynamics(scip::Model& model, Action const& action) const -> std::tuple<bool, ActionSet>;
+
+private:
+	Policy policy;
+	bool pseudo_candidates;
+};
+
+}  // namespace ecole::dynamics
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <tuple>
+
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/default.hpp"
+#include "ecole/dynamics/parts.hpp"
+#include "ecole/export.hpp"
+
+namespace ecole::dynamics {
+
+/**
+ * Node selection dynamics.
+ *
+ * Control is given back to the agent every time SCIP selects the next node to process.
+ * The action set is the frontier of open nodes (leaves, children, and siblings), and the action is the number of the
+ * node to process next.
+ *
+ * The frontier is tracked incrementally in the solver thread: the children of the last node are added upon selection,
+ * and nodes are removed when they are selected or deleted (for instance when pruned).
+ */
+class ECOLE_EXPORT NodeSelectionDynamics : public DefaultSetDynamicsRandomState {
+public:
+	/** The columns of the action set. */
+	enum struct Column : std::size_t { number = 0, depth = 1, lower_bound = 2, estimate = 3 };
+	static constexpr std::size_t n_columns = 4;
+
+	/** The number of a node to select, as given by ``SCIPnodeGetNumber``, or Default to select the best bound. */
+	using Action = Defaultable<std::size_t>;
+	/** One row per open node, with the columns of Column, or nothing when solving is finished. */
+	using ActionSet = std::optional<xt::xtensor<double, 2>>;
+
+	ECOLE_EXPORT NodeSelectionDynamics();
+
+	ECOLE_EXPORT auto reset_dynamics(scip::Model& model) const -> std::tuple<bool, ActionSet>;
+
+	/**
+	 * Select the given node and solve it until the next node selection.
+	 *
+	 * @throw std::invalid_argument If the node is not in the frontier.
+	 */
+	ECOLE_EXPORT auto step_dynamics(scip::Model& model, Action maybe_node_number) const -> std::tuple<bool, ActionSet>;
+
+private:
+	/** Open nodes and pending selection, updated in the solver thread. */
+	class Frontier;
+
+	std::shared_ptr<Frontier> frontier;
+};
+
+}  // namespace ecole::dynamics
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <optional>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+#include "ecole/data/parallel.hpp"
+#include "ecole/dynamics/configuring.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/traits.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::dynamics {
+
+namespace internal {
+
+/**
+ * Call the function on every index of ``[0, n)``, on the pool and in the calling thread, with results in order.
+ *
+ * Called from the worker of a pool, the function is called sequentially.
+ */
+template <typename Function>
+auto parallel_map(utility::ThreadPool* thread_pool, std::size_t n, Function const& func)
+	-> std::vector<std::invoke_result_t<Function const&, std::size_t>> {
+	using Result = std::invoke_result_t<Function const&, std::size_t>;
+	auto results = std::vector<std::optional<Result>>(n);
+	auto const run_one = [&](std::size_t i) { results[i].emplace(func(i)); };
+
+	auto futures = std::vector<std::future<void>>{};
+	auto const parallel = thread_pool != nullptr && !utility::ThreadPool::in_worker_thread();
+	auto const n_submitted = (parallel && n > 0) ? n - 1 : 0;
+	futures.reserve(n_submitted);
+	for (std::size_t i = 0; i < n_submitted; ++i) {
+		futures.push_back(thread_pool->submit([&run_one, i] { run_one(i); }));
+	}
+	auto error = std::exception_ptr{};
+	try {
+		for (auto i = n_submitted; i < n; ++i) {
+			run_one(i);
+		}
+	} catch (...) {
+		error = std::current_exception();
+	}
+	data::internal::wait_all(futures, error);
+
+	auto data = std::vector<Result>{};
+	data.reserve(results.size());
+	for (auto& result : results) {
+		data.push_back(std::move(result).value());
+	}
+	return data;
+}
+
+/** Run a ConfiguringDynamics episode on the model, as an environment would, and return the final reward. */
+template <typename RewardFunction>
+auto configuring_episode(scip::Model& model, RewardFunction& reward_function, ParamDict const& param_dict)
+	-> trait::data_of_t<RewardFunction> {
+	auto dynamics = ConfiguringDynamics{};
+	reward_function.before_reset(model);
+	auto [done, action_set] = dynamics.reset_dynamics(model);
+	reward_function.extract(model, done);
+	std::tie(done, action_set) = dynamics.step_dynamics(model, param_dict);
+	return reward_function.extract(model, done);
+}
+
+/** A pool for the given number of threads including the calling one, or null when evaluating sequentially. */
+inline auto make_configurator_pool(std::size_t n_threads) -> std::shared_ptr<utility::ThreadPool> {
+	if (n_threads == 0) {
+		n_threads = utility::ThreadPool::default_n_threads();
+	}
+	if (n_threads > 1) {
+		return std::make_shared<utility::ThreadPool>(n_threads - 1);
+	}
+	return nullptr;
+}
+
+}  // namespace internal
+
+/**
+ * Evaluate many parameter configurations on the same instance concurrently.
+ *
+ * Every configuration is evaluated as an episode of ConfiguringDynamics on its own copy of the original problem
+ * (``copy_orig``), with its own copy of the reward function.
+ * Copies of the source model are serialized by the model, but the solving processes run concurrently on a thread
+ * pool, with the calling thread evaluating the last configuration.
+ * Copies of the configurator share the same thread pool.
+ *
+ * @tparam RewardFunction The function extracting the reward of a configuration, after the episode is done.
+ */
+template <typename RewardFunction> class ParallelConfigurator {
+public:
+	using Reward = trait::data_of_t<RewardFunction>;
+
+	/**
+	 * Create a configurator.
+	 *
+	 * @param reward_function The function copied to evaluate every configuration.
+	 * @param n_threads The number of configurations solved at once, or zero to use get_n_threads().
+	 */
+	ParallelConfigurator(RewardFunction reward_function = {}, std::size_t n_threads = 0) :
+		m_reward_function{std::move(reward_function)}, m_thread_pool{internal::make_configurator_pool(n_threads)} {}
+
+	/**
+	 * Solve a copy of the model with every configuration.
+	 *
+	 * The model itself is left unchanged.
+	 *
+	 * @return The reward of every configuration, in the same order.
+	 */
+	auto evaluate(scip::Model const& model, nonstd::span<ParamDict const> param_dicts) -> std::vector<Reward> {
+		return internal::parallel_map(m_thread_pool.get(), param_dicts.size(), [&](std::size_t i) {
+			auto copy = model.copy_orig();
+			auto reward_function = m_reward_function;
+			return internal::configuring_episode(copy, reward_function, param_dicts[i]);
+		});
+	}
+
+	[[nodiscard]] auto reward_function() const noexcept -> RewardFunction const& { return m_reward_function; }
+
+private:
+	RewardFunction m_reward_function;
+	/** Shared so that the configurator remains copyable, null when evaluating sequentially. */
+	std::shared_ptr<utility::ThreadPool> m_thread_pool;
+};
+
+}  // namespace ecole::dynamics
@@ -1,8 +1,11 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include <nonstd/span.hpp>
 #include <scip/def.h>
@@ -14,6 +17,8 @@
 
 namespace ecole::dynamics {
 
+class LinearScreen;
+
 class ECOLE_EXPORT PrimalSearchDynamics : public DefaultSetDynamicsRandomState {
 public:
 	/** An array of variable identifiers in the transformed problem. */
@@ -21,8 +26,27 @@ public:
 	/** A tuple of variable identifiers and variable values. */
 	using Action = std::pair<nonstd::span<std::size_t const>, nonstd::span<SCIP_Real const>>;
 
-	ECOLE_EXPORT
-	PrimalSearchDynamics(int trials_per_node = 1, int depth_freq = 1, int depth_start = 0, int depth_stop = -1);
+	/**
+	 * How solutions are screened against the linear rows of the LP before any probing.
+	 *
+	 * Screening bounds the activity of every global row of the LP with the solution, the other variables being free
+	 * within their global bounds, and only solutions that cannot violate a row are probed.
+	 */
+	enum struct Screening {
+		/** Probe all solutions. */
+		none,
+		/** Do not probe solutions with invalid values or violating a row. */
+		reject,
+		/** Round the values of integer variables and clip values to bounds, then reject solutions violating a row. */
+		repair,
+	};
+
+	ECOLE_EXPORT PrimalSearchDynamics(
+		int trials_per_node = 1,
+		int depth_freq = 1,
+		int depth_start = 0,
+		int depth_stop = -1,
+		Screening screening = Screening::none);
 
 	using DefaultSetDynamicsRandomState::set_dynamics_random_state;
 
@@ -30,14 +54,52 @@ public:
 
 	ECOLE_EXPORT auto step_dynamics(scip::Model& model, Action action) -> std::tuple<bool, ActionSet>;
 
+	/**
+	 * Try a batch of (partial) solutions as a single search trial.
+	 *
+	 * All solutions are tried in the same heuristic call and the same probing session, each at its own probing node,
+	 * which avoids giving back control and setting up probing for every solution.
+	 * Empty solutions are ignored.
+	 *
+	 * @return Whether the search finished, and the action set, as the single solution step_dynamics.
+	 * @throw std::invalid_argument If any solution is invalid, in which case no solution is tried.
+	 */
+	ECOLE_EXPORT auto step_dynamics_batch(scip::Model& model, nonstd::span<Action const> actions)
+		-> std::tuple<bool, ActionSet>;
+
+	/** For every solution of the last batch (or single solution) tried, whether it was kept by SCIP. */
+	[[nodiscard]] auto last_solutions_kept() const noexcept -> std::vector<bool> const& { return solutions_kept; }
+
+	/** For every solution of the last batch (or single solution), whether it was screened out without probing. */
+	[[nodiscard]] auto last_solutions_screened_out() const noexcept -> std::vector<bool> const& {
+		return solutions_screened_out;
+	}
+
+	/**
+	 * Return the action set as a mask over all variables, in a buffer reused across calls.
+	 *
+	 * The mask is laid out as in BranchingDynamics::action_mask_view.
+	 * The view is invalidated by the next call with the same packing, or when the dynamics are destroyed.
+	 * Returns nothing when the model is not solving.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto action_mask_view(scip::Model const& model, bool packed = false)
+		-> std::optional<nonstd::span<std::uint8_t const>>;
+
 private:
 	int trials_per_node;
 	int depth_freq;
 	int depth_start;
 	int depth_stop;
+	Screening screening;
+	/** The snapshot of the LP rows used for screening, of which copies of the dynamics take their own. */
+	std::shared_ptr<LinearScreen> screen;
 
 	unsigned int trials_spent = 0;        // to keep track of the number of trials during each search
 	SCIP_RESULT result = SCIP_DIDNOTRUN;  // the final result of each search (several trials)
+	std::vector<bool> solutions_kept;     // the result of every solution of the last trial
+	std::vector<bool> solutions_screened_out;  // which solutions of the last trial were not probed
+	std::vector<std::uint8_t> mask;       // the buffers of action_mask_view
+	std::vector<std::uint8_t> packed_mask;
 };
 
 }  // namespace ecole::dynamics
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+#include "ecole/dynamics/configuring.hpp"
+#include "ecole/dynamics/parallel-configurator.hpp"
+#include "ecole/export.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/traits.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::dynamics {
+
+/** The evaluation of a configuration in a race. */
+template <typename Reward> struct RaceResult {
+	/** The reward extracted at the end of the episode, even if interrupted. */
+	Reward reward;
+	/** Whether the configuration was interrupted because dominated by another one. */
+	bool interrupted = false;
+	/** Integral over wall time (in seconds) of the primal-dual gap, which lies in ``[0, 1]``. */
+	double gap_integral = 0.;
+};
+
+namespace internal {
+
+/**
+ * Bookkeeping of a race, shared by the threads solving the configurations.
+ *
+ * Since the primal-dual gap integral of a configuration never decreases while solving, a running configuration is
+ * dominated as soon as its integral exceeds the one of a configuration that solved the instance.
+ */
+class ECOLE_EXPORT Race {
+public:
+	explicit Race(double tolerance_) noexcept : tolerance{tolerance_} {}
+
+	/** Monitor the bounds of a model that is not solved yet, interrupting its solving when dominated. */
+	ECOLE_EXPORT void enter(scip::Model& model);
+	/** Stop monitoring a model, returning whether it was interrupted and its gap integral. */
+	ECOLE_EXPORT auto leave(scip::Model& model) -> std::pair<bool, double>;
+
+	/** Whether a configuration with the given gap integral is dominated by one that solved the instance. */
+	[[nodiscard]] auto is_dominated(double gap_integral) const noexcept -> bool {
+		auto const best = best_gap_integral.load(std::memory_order_relaxed);
+		return best < std::numeric_limits<double>::infinity() && gap_integral > tolerance * best;
+	}
+
+private:
+	double tolerance;
+	std::atomic<double> best_gap_integral = std::numeric_limits<double>::infinity();
+};
+
+}  // namespace internal
+
+/**
+ * Evaluate many parameter configurations on the same instance concurrently, interrupting the dominated ones.
+ *
+ * As in ParallelConfigurator, configurations are evaluated on their own copy of the original problem on a thread
+ * pool.
+ * The primal-dual gap integral of every configuration is monitored through the primal and dual bound events.
+ * A configuration is interrupted (``SCIPinterruptSolve``) when its integral exceeds the one of the best configuration
+ * that solved the instance, multiplied by a tolerance.
+ * Configurations are started in order, so that when there are more configurations than threads, the later ones can
+ * be interrupted earlier.
+ *
+ * @tparam RewardFunction The function extracting the reward of a configuration, after the episode is done.
+ */
+template <typename RewardFunction> class RacingConfigurator {
+public:
+	using Reward = trait::data_of_t<RewardFunction>;
+
+	/**
+	 * Create a configurator.
+	 *
+	 * @param reward_function The function copied to evaluate every configuration.
+	 * @param tolerance The factor of the best gap integral above which configurations are interrupted.
+	 * @param n_threads The number of configurations solved at once, or zero to use get_n_threads().
+	 */
+	RacingConfigurator(RewardFunction reward_function = {}, double tolerance = 1., std::size_t n_threads = 0) :
+		m_reward_function{std::move(reward_function)},
+		m_tolerance{tolerance},
+		m_thread_pool{internal::make_configurator_pool(n_threads)} {}
+
+	/**
+	 * Race a copy of the model with every configuration.
+	 *
+	 * The model itself is left unchanged.
+	 *
+	 * @return The result of every configuration, in the same order.
+	 */
+	auto evaluate(scip::Model const& model, nonstd::span<ParamDict const> param_dicts)
+		-> std::vector<RaceResult<Reward>> {
+		auto race = internal::Race{m_tolerance};
+		return internal::parallel_map(m_thread_pool.get(), param_dicts.size(), [&](std::size_t i) {
+			auto copy = model.copy_orig();
+			auto reward_function = m_reward_function;
+			race.enter(copy);
+			auto reward = internal::configuring_episode(copy, reward_function, param_dicts[i]);
+			auto const [interrupted, gap_integral] = race.leave(copy);
+			return RaceResult<Reward>{std::move(reward), interrupted, gap_integral};
+		});
+	}
+
+	[[nodiscard]] auto reward_function() const noexcept -> RewardFunction const& { return m_reward_function; }
+	[[nodiscard]] auto tolerance() const noexcept -> double { return m_tolerance; }
+
+private:
+	RewardFunction m_reward_function;
+	double m_tolerance;
+	/** Shared so that the configurator remains copyable, null when evaluating sequentially. */
+	std::shared_ptr<utility::ThreadPool> m_thread_pool;
+};
+
+}  // namespace ecole::dynamics
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/dynamics/parts.hpp"
+#include "ecole/export.hpp"
+#include "ecole/none.hpp"
+
+namespace ecole::dynamics {
+
+/**
+ * Raised when a replayed episode does not follow the recorded one.
+ */
+class ECOLE_EXPORT ReplayDivergence : public std::runtime_error {
+public:
+	ECOLE_EXPORT ReplayDivergence(std::size_t step, std::string const& reason);
+
+	/** The index of the first replayed branching decision that differs from the recording. */
+	[[nodiscard]] auto step() const noexcept -> std::size_t { return m_step; }
+
+private:
+	std::size_t m_step;
+};
+
+/**
+ * Branching by playing back the actions of a recorded BranchingDynamics episode.
+ *
+ * As with InlinePolicyBranching, the recorded actions are played back by a branchrule in the solver thread, so that
+ * episodes are replayed at the speed of a native branchrule, to compute new observations or rewards of recorded
+ * episodes.
+ * The observer is only called on the steps selected, and solving stops after the last recorded action.
+ * The model must be set as when recording, with the same parameters and seeds, for the replay to follow the
+ * recording.
+ */
+class ECOLE_EXPORT ReplayBranching : public DefaultSetDynamicsRandomState {
+public:
+	using Action = NoneType;
+	using ActionSet = NoneType;
+	/** The branching candidates, as variable indices in the transformed problem. */
+	using Candidates = xt::xtensor<std::size_t, 1>;
+	/** Function called on the selected steps, before their action is played back. */
+	using Observer = std::function<void(scip::Model&, std::size_t step, Candidates const&)>;
+
+	/**
+	 * Create the dynamics replaying the given branching decisions.
+	 *
+	 * @param actions The recorded variable indices branched on at every step.
+	 * @param action_sets The recorded action sets of every step, compared to the branching candidates up to their
+	 *        order, or empty to only check that the actions are candidates.
+	 * @param observer The function called on the selected steps, or an empty function.
+	 * @param observed_steps The increasing indices of the steps on which the observer is called, or empty for every
+	 *        step.
+	 * @param pseudo_candidates Whether the episode was recorded with pseudo branching candidates rather than LP
+	 *        candidates.
+	 * @throw std::invalid_argument If the action sets are not empty and not as many as the actions.
+	 */
+	ECOLE_EXPORT ReplayBranching(
+		std::vector<std::size_t> actions = {},
+		std::vector<Candidates> action_sets = {},
+		Observer observer = nullptr,
+		std::vector<std::size_t> observed_steps = {},
+		bool pseudo_candidates = false);
+
+	using DefaultSetDynamicsRandomState::set_dynamics_random_state;
+
+	ECOLE_EXPORT auto reset_dynamics(scip::Model& model) const -> std::tuple<bool, ActionSet>;
+
+	/**
+	 * Solve the instance, branching with the recorded actions, up to the last one.
+	 *
+	 * @throw ReplayDivergence If a recorded action is not a candidate, if the candidates differ from the recorded action
+	 *        set, or if the instance is solved before all the recorded actions are played back.
+	 * @throw std::exception The first exception raised by the observer, which interrupts solving.
+	 */
+	ECOLE_EXPORT auto step_dynamics(scip::Model& model, Action const& action) -> std::tuple<bool, ActionSet>;
+
+	/** The number of steps played back by the last call to step_dynamics. */
+	[[nodiscard]] auto n_replayed() const noexcept -> std::size_t { return m_n_replayed; }
+
+private:
+	std::vector<std::size_t> m_actions;
+	std::vector<Candidates> m_action_sets;
+	Observer m_observer;
+	std::vector<std::size_t> m_observed_steps;
+	bool m_pseudo_candidates;
+	std::size_t m_n_replayed = 0;
+};
+
+}  // namespace ecole::dynamics
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include "ecole/export.hpp"
+#include "ecole/random.hpp"
+
+namespace ecole::scip {
+class Model;
+}  // namespace ecole::scip
+
+namespace ecole::dynamics {
+
+/**
+ * Selection of the branching nodes on which control is given to the agent.
+ *
+ * Nodes that are not selected are branched on by SCIP in the solver thread, without extracting observations or
+ * rewards, and without switching threads.
+ * This is useful to collect datasets where only a fraction of nodes is kept.
+ */
+class ECOLE_EXPORT ObservationSchedule {
+public:
+	/**
+	 * Decide whether a node is selected.
+	 *
+	 * The predicate receives the model, the number of nodes considered so far in the episode (including the current
+	 * one), and a random generator seeded by the environment.
+	 */
+	using Predicate = std::function<bool(scip::Model& model, std::size_t n_nodes, RandomGenerator& rng)>;
+
+	/** Select every node. */
+	ObservationSchedule() = default;
+	/** Select nodes with a custom predicate. */
+	ECOLE_EXPORT explicit ObservationSchedule(Predicate predicate);
+
+	/**
+	 * Select one node every ``period`` nodes, starting with the first one.
+	 *
+	 * @throw std::invalid_argument If the period is zero.
+	 */
+	ECOLE_EXPORT static auto every(std::size_t period) -> ObservationSchedule;
+
+	/**
+	 * Select every node independently with the given probability.
+	 *
+	 * @throw std::invalid_argument If the probability is not in [0, 1].
+	 */
+	ECOLE_EXPORT static auto probability(double probability) -> ObservationSchedule;
+
+	/** Select nodes whose depth in the branch-and-bound tree is at most ``max_depth``. */
+	ECOLE_EXPORT static auto max_depth(std::size_t max_depth) -> ObservationSchedule;
+
+	/** Draw the random state of the schedule for the next episode. */
+	ECOLE_EXPORT auto seed(RandomGenerator& rng) -> void;
+
+	/** Start a new episode. */
+	auto reset() noexcept -> void { n_nodes = 0; }
+
+	/** Whether the current node is selected. */
+	ECOLE_EXPORT auto select(scip::Model& model) -> bool;
+
+	/** Whether all nodes are selected, in which case there is nothing to skip. */
+	[[nodiscard]] auto selects_all() const noexcept -> bool { return !predicate; }
+
+private:
+	Predicate predicate = nullptr;
+	std::size_t n_nodes = 0;
+	RandomGenerator rng;
+};
+
+}  // namespace ecole::dynamics
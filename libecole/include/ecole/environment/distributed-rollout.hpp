@@ -0,0 +1,409 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <future>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ecole/data/trajectory.hpp"
+#include "ecole/random.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::environment {
+
+/** An episode of a distributed rollout, as assigned to a worker. */
+struct EpisodeTask {
+	/** Index of the episode in the whole rollout. */
+	std::uint64_t episode;
+	/** Seed of the instance generator, the one instance::ShardedGenerator gives to the instance of the same index. */
+	Seed instance_seed;
+	/** Seed of the environment. */
+	Seed environment_seed;
+};
+
+/**
+ * Assign the episodes of a rollout to remote workers, and collect their trajectories, with backpressure.
+ *
+ * The coordinator does not communicate: workers on other machines reach it through any transport (MPI, sockets, an
+ * RPC server) whose handlers call assign and complete, concurrently since every method is thread safe.
+ *
+ * Episodes are assigned in order to the first worker asking, so that faster workers run more episodes.
+ * The seeds of an episode only depend on its index and on the seed of the coordinator, not on the worker running it,
+ * the number of workers, or their timing, so that a cluster run is reproducible.
+ * Instance seeds are the ones of instance::ShardedGenerator with the same random generator, so that the instances of
+ * a run are the union of the shards generated from that seed.
+ *
+ * A worker has at most ``max_in_flight`` episodes whose trajectory was not received, and asking for more blocks
+ * until one is.
+ * Trajectories are passed to the sink as they are received, and the worker only gets its credit back once the sink
+ * returns, so that a slow sink slows down the workers rather than letting trajectories pile up in memory.
+ */
+class RolloutCoordinator {
+public:
+	/** Receive the serialized trajectory of an episode, concurrently for different episodes. */
+	using Sink = std::function<void(EpisodeTask const&, std::string_view)>;
+
+	/**
+	 * Create the coordinator of a rollout.
+	 *
+	 * @param n_episodes The number of episodes of the rollout.
+	 * @param sink Called with every trajectory received.
+	 * @param max_in_flight The maximum number of episodes of a worker whose trajectory was not received, at least the
+	 *        number of environments of a worker so that none of them is idle.
+	 * @param rng The random generator from which the seeds of every episode are derived.
+	 * @throw std::invalid_argument If max_in_flight is zero.
+	 */
+	RolloutCoordinator(
+		std::uint64_t n_episodes,
+		Sink sink,
+		std::size_t max_in_flight = 2,
+		RandomGenerator rng = spawn_random_generator()) :
+		m_sink{std::move(sink)}, m_rng{rng}, m_n_episodes{n_episodes}, m_max_in_flight{max_in_flight} {
+		if (m_max_in_flight == 0) {
+			throw std::invalid_argument{"A RolloutCoordinator needs at least one episode in flight per worker."};
+		}
+	}
+
+	/** The seeds of an episode, independently of its assignment. */
+	[[nodiscard]] auto task(std::uint64_t episode) const -> EpisodeTask {
+		auto episode_rng = derive_random_generator(m_rng, episode);
+		auto const instance_seed = episode_rng();
+		return {episode, instance_seed, episode_rng()};
+	}
+
+	/**
+	 * Assign the next episode to a worker.
+	 *
+	 * Blocks while the worker has ``max_in_flight`` episodes in flight, and while every episode is assigned but some
+	 * are still in flight, since they are assigned again if their worker is released.
+	 *
+	 * @return The episode to run, or an empty optional once every trajectory is received.
+	 */
+	auto assign(std::size_t worker) -> std::optional<EpisodeTask> {
+		auto lk = std::unique_lock{m_mutex};
+		m_cv.wait(lk, [&] {
+			if (done()) {
+				return true;
+			}
+			auto const in_flight = m_in_flight.find(worker);
+			auto const has_credit = in_flight == m_in_flight.end() || in_flight->second.size() < m_max_in_flight;
+			return has_credit && (!m_released.empty() || m_n_assigned < m_n_episodes);
+		});
+		if (done()) {
+			return {};
+		}
+		auto episode = m_n_assigned;
+		if (!m_released.empty()) {
+			episode = m_released.front();
+			m_released.pop_front();
+		} else {
+			++m_n_assigned;
+		}
+		m_in_flight[worker].push_back(episode);
+		return task(episode);
+	}
+
+	/**
+	 * Receive the trajectory of an episode, and pass it to the sink.
+	 *
+	 * @throw std::invalid_argument If the episode is not in flight on this worker, for instance because the worker was
+	 *        released.
+	 * @throw std::exception Any exception thrown by the sink, in which case the episode is assigned again.
+	 */
+	void complete(std::size_t worker, std::uint64_t episode, std::string_view trajectory) {
+		{
+			auto const lk = std::lock_guard{m_mutex};
+			if (!is_in_flight(worker, episode)) {
+				throw std::invalid_argument{fmt::format("Episode {} is not in flight on worker {}.", episode, worker)};
+			}
+		}
+		// The sink is called without the lock so that trajectories of different workers are written concurrently
+		auto error = std::exception_ptr{};
+		try {
+			m_sink(task(episode), trajectory);
+		} catch (...) {
+			error = std::current_exception();
+		}
+		{
+			auto const lk = std::lock_guard{m_mutex};
+			// The worker may have been released while the trajectory was written
+			if (is_in_flight(worker, episode)) {
+				remove_in_flight(worker, episode);
+				if (error) {
+					m_released.push_back(episode);
+				} else {
+					++m_n_completed;
+				}
+			}
+		}
+		m_cv.notify_all();
+		if (error) {
+			std::rethrow_exception(error);
+		}
+	}
+
+	/** Assign again the episodes in flight on a worker, for instance after it lost its connection. */
+	void release(std::size_t worker) {
+		{
+			auto const lk = std::lock_guard{m_mutex};
+			if (auto const in_flight = m_in_flight.find(worker); in_flight != m_in_flight.end()) {
+				m_released.insert(m_released.end(), in_flight->second.begin(), in_flight->second.end());
+				m_in_flight.erase(in_flight);
+			}
+		}
+		m_cv.notify_all();
+	}
+
+	/** Block until every trajectory is received. */
+	void wait() {
+		auto lk = std::unique_lock{m_mutex};
+		m_cv.wait(lk, [&] { return done(); });
+	}
+
+	[[nodiscard]] auto n_episodes() const noexcept -> std::uint64_t { return m_n_episodes; }
+
+	[[nodiscard]] auto n_completed() const -> std::uint64_t {
+		auto const lk = std::lock_guard{m_mutex};
+		return m_n_completed;
+	}
+
+private:
+	Sink m_sink;
+	RandomGenerator m_rng;
+	std::uint64_t m_n_episodes;
+	std::size_t m_max_in_flight;
+
+	mutable std::mutex m_mutex;
+	std::condition_variable m_cv;
+	std::uint64_t m_n_assigned = 0;
+	std::uint64_t m_n_completed = 0;
+	std::deque<std::uint64_t> m_released;
+	std::map<std::size_t, std::vector<std::uint64_t>> m_in_flight;
+
+	[[nodiscard]] auto done() const noexcept -> bool { return m_n_completed == m_n_episodes; }
+
+	[[nodiscard]] auto is_in_flight(std::size_t worker, std::uint64_t episode) const -> bool {
+		auto const in_flight = m_in_flight.find(worker);
+		return in_flight != m_in_flight.end() &&
+			   std::find(in_flight->second.begin(), in_flight->second.end(), episode) != in_flight->second.end();
+	}
+
+	void remove_in_flight(std::size_t worker, std::uint64_t episode) {
+		auto& episodes = m_in_flight.at(worker);
+		episodes.erase(std::find(episodes.begin(), episodes.end(), episode));
+	}
+};
+
+/**
+ * Record the steps of branching episodes in trajectory files.
+ *
+ * Every environment of a worker spools its trajectory in its own file, which is read back once the episode is over
+ * to be sent to the coordinator, then overwritten by the next episode.
+ * Steps without observation, such as terminal states, are not recorded.
+ *
+ * @tparam Value The floating point type of the observation features.
+ */
+template <typename Value> class TrajectoryRecorder {
+public:
+	/**
+	 * Spool trajectories in a directory.
+	 *
+	 * @param directory An existing directory, private to the worker.
+	 * @param compress Whether to compress tensors, see data::BasicTrajectoryWriter.
+	 */
+	explicit TrajectoryRecorder(std::filesystem::path directory, bool compress = false) :
+		m_directory{std::move(directory)}, m_compress{compress} {}
+
+	/** Start the trajectory of an environment. */
+	void begin(std::size_t env) {
+		auto const lk = std::lock_guard{m_mutex};
+		m_writers[env] = std::make_unique<data::BasicTrajectoryWriter<Value>>(spool(env), m_compress);
+	}
+
+	/** Append a step to the trajectory of an environment. */
+	template <typename OptionalObservation, typename ActionSet>
+	void record(
+		std::size_t env,
+		OptionalObservation const& observation,
+		ActionSet const& action_set,
+		std::size_t action,
+		double reward) {
+		if (observation.has_value() && action_set.has_value()) {
+			writer(env).write(observation.value(), action_set.value(), action, reward);
+		}
+	}
+
+	/** Close the trajectory of an environment and read its bytes. */
+	auto end(std::size_t env) -> std::string {
+		writer(env).close();
+		auto file = std::ifstream{spool(env), std::ios::binary};
+		return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+	}
+
+private:
+	std::filesystem::path m_directory;
+	bool m_compress;
+	std::mutex m_mutex;
+	std::map<std::size_t, std::unique_ptr<data::BasicTrajectoryWriter<Value>>> m_writers;
+
+	[[nodiscard]] auto spool(std::size_t env) const -> std::filesystem::path {
+		return m_directory / fmt::format("spool-{}.trj", env);
+	}
+
+	auto writer(std::size_t env) -> data::BasicTrajectoryWriter<Value>& {
+		auto const lk = std::lock_guard{m_mutex};
+		return *m_writers.at(env);
+	}
+};
+
+/**
+ * Run the episodes assigned by a RolloutCoordinator on the environments of a worker.
+ *
+ * Every environment has its own thread, which asks for an episode, runs it from reset to terminal state, and sends its
+ * trajectory, so that at most one episode per environment is in flight.
+ * Asking for an episode and sending a trajectory go through callbacks, typically requests to the coordinator over the
+ * transport, which block when the coordinator applies backpressure.
+ *
+ * @tparam Env An Environment (or any class with the same reset, step, and seed interface).
+ */
+template <typename Env> class DistributedRolloutWorker {
+public:
+	using OptionalObservation = typename Env::OptionalObservation;
+	using ActionSet = typename Env::ActionSet;
+
+	/** Ask the coordinator for an episode, or an empty optional when there are none left. */
+	using Fetch = std::function<std::optional<EpisodeTask>()>;
+	/** Send the trajectory of an episode to the coordinator. */
+	using Send = std::function<void(EpisodeTask const&, std::string)>;
+
+	/**
+	 * Take ownership of the environments, each with its own thread.
+	 *
+	 * @throw std::invalid_argument If no environment is given.
+	 */
+	explicit DistributedRolloutWorker(std::vector<Env> envs) :
+		m_envs(std::move(envs)), m_pool(std::make_unique<utility::ThreadPool>(m_envs.size())) {
+		if (m_envs.empty()) {
+			throw std::invalid_argument{"A DistributedRolloutWorker needs at least one environment."};
+		}
+	}
+
+	/**
+	 * Run episodes until the coordinator has none left.
+	 *
+	 * @param fetch Called concurrently by the environment threads to get their next episode.
+	 * @param make_instance Called as ``make_instance(task)`` to get the instance (a filename or a model) of an episode,
+	 *        for instance by seeding an instance generator with its instance seed.
+	 * @param policy Called as ``policy(env, observation, action_set)`` to get the action of every transition.
+	 * @param recorder Recorder of the trajectories, with the interface of TrajectoryRecorder.
+	 * @param send Called concurrently by the environment threads with the trajectory of every episode.
+	 * @param args Passed to every Environment::reset.
+	 * @return The number of episodes run.
+	 * @throw std::exception The first exception raised by an episode or a callback, once running episodes have
+	 *        completed. No new episode is fetched after an exception.
+	 */
+	template <typename MakeInstance, typename Policy, typename Recorder, typename... Args>
+	auto run(
+		Fetch const& fetch,
+		MakeInstance&& make_instance,
+		Policy&& policy,
+		Recorder& recorder,
+		Send const& send,
+		Args const&... args) -> std::size_t {
+		auto mutex = std::mutex{};
+		auto n_run = std::size_t{0};
+		auto error = std::exception_ptr{};
+
+		auto run_env = [&](std::size_t env) {
+			while (true) {
+				try {
+					{
+						auto const lk = std::lock_guard{mutex};
+						if (error) {
+							return;
+						}
+					}
+					auto const task = fetch();
+					if (!task.has_value()) {
+						return;
+					}
+					recorder.begin(env);
+					run_episode(env, task.value(), make_instance(task.value()), policy, recorder, args...);
+					send(task.value(), recorder.end(env));
+					auto const lk = std::lock_guard{mutex};
+					++n_run;
+				} catch (...) {
+					auto const lk = std::lock_guard{mutex};
+					if (!error) {
+						error = std::current_exception();
+					}
+					return;
+				}
+			}
+		};
+
+		auto futures = std::vector<std::future<void>>{};
+		futures.reserve(size());
+		for (std::size_t env = 0; env < size(); ++env) {
+			futures.push_back(m_pool->submit([&run_env, env] { run_env(env); }));
+		}
+		// All threads are awaited before rethrowing since they reference local variables
+		for (auto& fut : futures) {
+			fut.wait();
+		}
+		if (error) {
+			std::rethrow_exception(error);
+		}
+		return n_run;
+	}
+
+	/** The number of environments, and of threads. */
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return m_envs.size(); }
+
+	auto& environment(std::size_t i) { return m_envs.at(i); }
+
+private:
+	std::vector<Env> m_envs;
+	// Destroyed first so that threads still running do not outlive the environments
+	std::unique_ptr<utility::ThreadPool> m_pool;
+
+	template <typename Instance, typename Policy, typename Recorder, typename... Args>
+	void run_episode(
+		std::size_t env_idx,
+		EpisodeTask const& task,
+		Instance&& instance,
+		Policy& policy,
+		Recorder& recorder,
+		Args const&... args) {
+		auto& env = m_envs[env_idx];
+		env.seed(task.environment_seed);
+		auto [obs, action_set, reward, done, info] = env.reset(std::forward<Instance>(instance), args...);
+		while (!done) {
+			auto const action = policy(env_idx, obs, action_set);
+			auto step = env.step(action);
+			recorder.record(env_idx, obs, action_set, action, std::get<2>(step));
+			std::tie(obs, action_set, reward, done, info) = std::move(step);
+		}
+	}
+};
+
+}  // namespace ecole::environment
@@ -1,18 +1,29 @@
 #pragma once
 
+#include <cstddef>
+#include <future>
 #include <map>
+#include <memory>
 #include <random>
+#include <string>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
+#include <typeinfo>
 
 #include "ecole/data/parser.hpp"
+#include "ecole/environment/stopping-criterion.hpp"
 #include "ecole/exception.hpp"
 #include "ecole/information/abstract.hpp"
 #include "ecole/random.hpp"
 #include "ecole/reward/abstract.hpp"
+#include "ecole/scip/lp-view.hpp"
+#include "ecole/scip/model-pool.hpp"
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/seed.hpp"
 #include "ecole/traits.hpp"
+#include "ecole/utility/metrics.hpp"
+#include "ecole/utility/tracing.hpp"
 
 #include <optional>
 
@@ -50,6 +61,55 @@ public:
 	using Information = trait::information_of_t<InformationFunction>;
 	using InformationMap = information::InformationMap<Information>;
 
+	/**
+	 * Handle to the observation of a state, extracted on first access.
+	 *
+	 * The observation can only be extracted while the environment is still in the state where the handle was
+	 * returned, that is until the next call to reset or step, and before the step deadline of the state, if any.
+	 * The step deadline runs from the time the handle is returned, and starts over once the observation is extracted.
+	 * Once extracted, the observation remains available for as long as the handle.
+	 */
+	class LazyObservation {
+	public:
+		/**
+		 * Extract the observation if it was not already, and return it.
+		 *
+		 * @throw MarkovError If the observation was not extracted before the environment transitioned, or before the
+		 *        step deadline passed.
+		 */
+		auto get() -> OptionalObservation& {
+			if (!extracted) {
+				if (env->state_id != state_id) {
+					throw MarkovError{"The environment transitioned before the observation was extracted."};
+				}
+				if (!done) {
+					// The solver must not run while extracting, and the agent gets a full deadline once it observes
+					if (!env->model().solve_iter_reclaim()) {
+						throw MarkovError{"The step deadline passed before the observation was extracted."};
+					}
+					observation = env->extract_observation(done);
+					env->start_step_deadline(done);
+				}
+				extracted = true;
+			}
+			return observation;
+		}
+
+		/** Whether the observation was extracted. */
+		[[nodiscard]] auto is_extracted() const noexcept -> bool { return extracted; }
+
+	private:
+		friend class Environment;
+
+		Environment* env;
+		std::size_t state_id;
+		bool done;
+		bool extracted = false;
+		OptionalObservation observation = {};
+
+		LazyObservation(Environment& env_, bool done_) : env{&env_}, state_id{env_.state_id}, done{done_} {}
+	};
+
 	/**
 	 * Default construct everything and seed environment with random value.
 	 */
@@ -85,6 +145,22 @@ public:
 	 */
 	void seed(Seed new_seed) { rng().seed(new_seed); }
 
+	/**
+	 * Save the state carried by the environment from one episode to the next.
+	 *
+	 * This is the random generator from which the randomness of every episode is drawn, so that an environment
+	 * restored with load_state, then reset on the same instances, runs the same episodes.
+	 * The state of the ongoing episode, held by the model, is not saved.
+	 */
+	[[nodiscard]] auto save_state() const -> std::string { return serialize_binary(the_rng); }
+
+	/**
+	 * Restore a state returned by save_state, taking effect from the next reset.
+	 *
+	 * @throw std::invalid_argument If the state was not returned by save_state.
+	 */
+	void load_state(std::string_view state) { the_rng = deserialize_binary(state); }
+
 	/**
 	 * Reset the environment to the initial state on the given problem instance.
 	 *
@@ -103,24 +179,13 @@ public:
 	template <typename... Args>
 	auto reset(scip::Model&& new_model, Args&&... args)
 		-> std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap> {
-		can_transition = true;
+		ECOLE_TRACE_SPAN("Environment::reset");
 		try {
-			// Create clean new Model
-			model() = std::move(new_model);
-			model().set_params(scip_params());
-			dynamics().set_dynamics_random_state(model(), rng());
-
-			// Reset data extraction function and bring model to initial state.
-			reward_function().before_reset(model());
-			observation_function().before_reset(model());
-			information_function().before_reset(model());
-
-			// Place the environment in its initial state
-			auto [done, action_set] = dynamics().reset_dynamics(model(), std::forward<Args>(args)...);
-			can_transition = !done;
+			auto [done, action_set] = reset_state(std::move(new_model), std::forward<Args>(args)...);
 
 			// Extract additional information to be returned by reset
 			auto [reward, observation, information] = extract_reward_observation_information(done);
+			start_step_deadline(done);
 
 			return {
 				std::move(observation),
@@ -144,7 +209,24 @@ public:
 	template <typename... Args>
 	auto reset(std::string const& filename, Args&&... args)
 		-> std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap> {
-		return reset(scip::Model::from_file(filename), std::forward<Args>(args)...);
+		return reset(model_from_file(filename), std::forward<Args>(args)...);
+	}
+
+	/**
+	 * Capture the current state to later branch differently from it.
+	 *
+	 * The snapshot is a new problem equivalent to the current node (see scip::Model::fork).
+	 * Passing it to reset starts a new episode from that node, and it can be reused for as many resets as desired.
+	 * The step deadline of the current state, if any, is stopped first, since the solver must not run while copying.
+	 *
+	 * @throw MarkovError If the step deadline has already passed, as the solver left the state.
+	 */
+	auto snapshot() -> scip::Model {
+		join_extraction();
+		if (!the_model.solve_iter_reclaim()) {
+			throw MarkovError{"The state cannot be captured after its step deadline has passed."};
+		}
+		return the_model.fork();
 	}
 
 	/**
@@ -166,16 +248,13 @@ public:
 	template <typename... Args>
 	auto step(Action const& action, Args&&... args)
 		-> std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap> {
-		if (!can_transition) {
-			throw MarkovError{"Environment need to be reset."};
-		}
+		ECOLE_TRACE_SPAN("Environment::step");
 		try {
-			// Transition the environment to the next state
-			auto [done, action_set] = dynamics().step_dynamics(model(), action, std::forward<Args>(args)...);
-			can_transition = !done;
+			auto [done, action_set] = step_state(action, std::forward<Args>(args)...);
 
 			// Extract additional information to be returned by step
 			auto [reward, observation, information] = extract_reward_observation_information(done);
+			start_step_deadline(done);
 
 			return {
 				std::move(observation),
@@ -190,6 +269,103 @@ public:
 		}
 	}
 
+	/**
+	 * Reset the environment as reset does, but only extract the observation if it is accessed.
+	 *
+	 * The reward and information are extracted immediately, and the observation is extracted on the first call to
+	 * LazyObservation::get, hence after the information.
+	 * Observations of states that are never looked at, such as states where the agent takes a default action, cost
+	 * nothing to extract.
+	 * The step deadline, if any, is started before returning, and started again once the observation is extracted.
+	 *
+	 * @return The same values as reset, with a handle to the observation in place of the observation.
+	 */
+	template <typename... Args>
+	auto reset_lazy(scip::Model&& new_model, Args&&... args)
+		-> std::tuple<LazyObservation, ActionSet, Reward, bool, InformationMap> {
+		ECOLE_TRACE_SPAN("Environment::reset_lazy");
+		try {
+			auto [done, action_set] = reset_state(std::move(new_model), std::forward<Args>(args)...);
+			auto [reward, information] = extract_reward_information(done);
+			start_step_deadline(done);
+			return {LazyObservation{*this, done}, std::move(action_set), std::move(reward), done, std::move(information)};
+		} catch (std::exception const&) {
+			can_transition = false;
+			throw;
+		}
+	}
+
+	template <typename... Args>
+	auto reset_lazy(scip::Model const& model, Args&&... args)
+		-> std::tuple<LazyObservation, ActionSet, Reward, bool, InformationMap> {
+		return reset_lazy(model.copy_orig(), std::forward<Args>(args)...);
+	}
+
+	template <typename... Args>
+	auto reset_lazy(std::string const& filename, Args&&... args)
+		-> std::tuple<LazyObservation, ActionSet, Reward, bool, InformationMap> {
+		return reset_lazy(model_from_file(filename), std::forward<Args>(args)...);
+	}
+
+	/**
+	 * Transition the environment as step does, but only extract the observation if it is accessed.
+	 *
+	 * @see reset_lazy
+	 * @return The same values as step, with a handle to the observation in place of the observation.
+	 */
+	template <typename... Args>
+	auto step_lazy(Action const& action, Args&&... args)
+		-> std::tuple<LazyObservation, ActionSet, Reward, bool, InformationMap> {
+		ECOLE_TRACE_SPAN("Environment::step_lazy");
+		try {
+			auto [done, action_set] = step_state(action, std::forward<Args>(args)...);
+			auto [reward, information] = extract_reward_information(done);
+			start_step_deadline(done);
+			return {LazyObservation{*this, done}, std::move(action_set), std::move(reward), done, std::move(information)};
+		} catch (std::exception const&) {
+			can_transition = false;
+			throw;
+		}
+	}
+
+	/**
+	 * Reset the environment asynchronously.
+	 *
+	 * The reset is executed in a new thread while the caller is free to do other work, such as resetting or
+	 * transitioning other environments.
+	 *
+	 * @param new_model Passed to reset, either a filename or a Model to take ownership of.
+	 * @param args Copied and passed to reset.
+	 * @return A future holding the return value of reset, or the exception it threw.
+	 * @pre The environment must not be used until the future is ready.
+	 */
+	template <typename Instance, typename... Args>
+	auto reset_async(Instance new_model, Args... args)
+		-> std::future<std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap>> {
+		return std::async(std::launch::async, [this, new_model = std::move(new_model), args...]() mutable {
+			return reset(std::move(new_model), std::move(args)...);
+		});
+	}
+
+	/**
+	 * Transition the environment asynchronously.
+	 *
+	 * The transition is executed in a new thread while the caller is free to do other work, such as transitioning other
+	 * environments.
+	 *
+	 * @param action Copied and passed to step.
+	 * @param args Copied and passed to step.
+	 * @return A future holding the return value of step, or the exception it threw.
+	 * @pre The environment must not be used until the future is ready.
+	 */
+	template <typename... Args>
+	auto step_async(Action action, Args... args)
+		-> std::future<std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap>> {
+		return std::async(std::launch::async, [this, action = std::move(action), args...]() mutable {
+			return step(action, std::move(args)...);
+		});
+	}
+
 	auto& dynamics() { return the_dynamics; }
 	auto& model() { return the_model; }
 	auto& observation_function() { return the_observation_function; }
@@ -198,6 +374,32 @@ public:
 	auto& scip_params() { return the_scip_params; }
 	auto& rng() { return the_rng; }
 
+	/**
+	 * The criterion ending episodes early, or an empty function to solve until the dynamics terminate.
+	 *
+	 * The criterion is copied in the Model of every new episode, and evaluated while solving (see
+	 * include_stopping_criterion), so an episode terminates as soon as it holds, without stepping through the states
+	 * in between.
+	 */
+	auto& stopping_criterion() { return the_stopping_criterion; }
+
+	/**
+	 * The memory, in bytes, that the model of an episode may use, or empty for no limit.
+	 *
+	 * The limit is set as the SCIP ``limits/memory`` parameter of every new episode, overriding scip_params, so that
+	 * SCIP stops solving when it is reached and the episode terminates as with any other limit, rather than the
+	 * process running out of memory (see scip::Model::memory_usage).
+	 */
+	auto& memory_limit() { return the_memory_limit; }
+
+	/**
+	 * The pool recycling the model of the previous episode on reset, or null to create a new model every episode.
+	 *
+	 * Only models read from a file by the environment are taken from the pool, but models of all episodes are given
+	 * back to it.
+	 */
+	auto& model_pool() { return the_model_pool; }
+
 private:
 	Dynamics the_dynamics;
 	scip::Model the_model;
@@ -205,15 +407,178 @@ private:
 	ObservationFunction the_observation_function;
 	InformationFunction the_information_function;
 	std::map<std::string, scip::Param> the_scip_params;
+	StoppingCriterion the_stopping_criterion;
+	std::optional<std::size_t> the_memory_limit;
+	std::shared_ptr<scip::ModelPool> the_model_pool;
 	RandomGenerator the_rng;
 	bool can_transition = false;
+	/** Incremented on every transition to invalidate LazyObservation of previous states. */
+	std::size_t state_id = 0;
+
+	/** Read the problem of a new episode, in the model of the previous one if possible. */
+	auto model_from_file(std::string const& filename) -> scip::Model {
+		if (the_model_pool == nullptr) {
+			return scip::Model::from_file(filename);
+		}
+		// Released first, so that the previous model is the one recycled
+		the_model_pool->release(std::move(model()));
+		try {
+			return the_model_pool->from_file(filename);
+		} catch (...) {
+			model() = the_model_pool->acquire();
+			throw;
+		}
+	}
+
+	/** Bring the model to the initial state, leaving data extraction to the caller. */
+	template <typename... Args> auto reset_state(scip::Model&& new_model, Args&&... args) -> std::tuple<bool, ActionSet> {
+		join_extraction();
+		can_transition = true;
+		++state_id;
+		// Create clean new Model
+		if (the_model_pool != nullptr) {
+			the_model_pool->release(std::move(model()));
+		}
+		model() = std::move(new_model);
+		model().set_params(scip_params());
+		if (the_memory_limit.has_value()) {
+			// SCIP memory limit is in megabytes
+			model().set_param("limits/memory", static_cast<SCIP_Real>(the_memory_limit.value()) / (1U << 20U));
+		}
+		dynamics().set_dynamics_random_state(model(), rng());
+		// Included once the dynamics installed the model of the episode, which may be a copy without the handler
+		if (the_stopping_criterion) {
+			include_stopping_criterion(model(), the_stopping_criterion);
+		}
+
+		// Reset data extraction function and bring model to initial state.
+		if constexpr (!trait::extracts_nothing_v<RewardFunction>) {
+			ECOLE_TRACE_SPAN("RewardFunction::before_reset");
+			reward_function().before_reset(model());
+		}
+		if constexpr (!trait::extracts_nothing_v<ObservationFunction>) {
+			ECOLE_TRACE_SPAN("ObservationFunction::before_reset");
+			observation_function().before_reset(model());
+		}
+		if constexpr (!trait::extracts_nothing_v<InformationFunction>) {
+			ECOLE_TRACE_SPAN("InformationFunction::before_reset");
+			information_function().before_reset(model());
+		}
+
+		// Place the environment in its initial state
+		ECOLE_TRACE_SPAN("Dynamics::reset_dynamics");
+		auto [done, action_set] = dynamics().reset_dynamics(model(), std::forward<Args>(args)...);
+		if (the_stopping_criterion) {
+			rethrow_stopping_criterion_error(model());
+		}
+		can_transition = !done;
+		static auto& n_resets = utility::metrics::counter("ecole_environment_resets_total", "Environment resets.");
+		n_resets.add();
+		return {done, std::move(action_set)};
+	}
+
+	/** Transition the model to the next state, leaving data extraction to the caller. */
+	template <typename... Args> auto step_state(Action const& action, Args&&... args) -> std::tuple<bool, ActionSet> {
+		if (!can_transition) {
+			throw MarkovError{"Environment need to be reset."};
+		}
+		join_extraction();
+		++state_id;
+		ECOLE_TRACE_SPAN("Dynamics::step_dynamics");
+		auto [done, action_set] = dynamics().step_dynamics(model(), action, std::forward<Args>(args)...);
+		if (the_stopping_criterion) {
+			rethrow_stopping_criterion_error(model());
+		}
+		can_transition = !done;
+		static auto& n_steps = utility::metrics::counter("ecole_environment_steps_total", "Environment transitions.");
+		n_steps.add();
+		return {done, std::move(action_set)};
+	}
+
+	/** Leave the model to the solver if the agent does not act in time, as the observation is already extracted. */
+	auto start_step_deadline(bool done) -> void {
+		if constexpr (trait::has_step_deadline_v<Dynamics>) {
+			if (!done) {
+				// The solver may resume at the deadline, so data cannot be extracted in the background past it
+				join_extraction();
+				dynamics().start_step_deadline(model());
+			}
+		}
+	}
+
+	auto extract_reward(bool done) {
+		if constexpr (trait::extracts_nothing_v<RewardFunction>) {
+			return trait::data_of_t<RewardFunction>{};
+		} else {
+			ECOLE_TRACE_SPAN("RewardFunction::extract");
+			return reward_function().extract(model(), done);
+		}
+	}
+
+	auto extract_observation(bool done) {
+		if constexpr (trait::extracts_nothing_v<ObservationFunction>) {
+			return Observation{};
+		} else {
+			ECOLE_TRACE_SPAN("ObservationFunction::extract");
+			static auto& duration = utility::metrics::histogram(
+				"ecole_observation_extract_seconds",
+				"Time spent extracting observations.",
+				{{"function", utility::metrics::type_label(typeid(ObservationFunction))}});
+			auto const timer = utility::metrics::ScopedTimer{duration};
+			return observation_function().extract(model(), done);
+		}
+	}
+
+	// An empty map does not allocate, so information functions extracting nothing cost nothing either
+	auto extract_information(bool done) {
+		if constexpr (trait::extracts_nothing_v<InformationFunction>) {
+			return InformationMap{};
+		} else {
+			ECOLE_TRACE_SPAN("InformationFunction::extract");
+			return information_function().extract(model(), done);
+		}
+	}
+
+	/** Wait for the data functions extracting in the background, before the model changes (see trait::prefetches). */
+	auto join_extraction() -> void {
+		if constexpr (trait::prefetches_v<RewardFunction>) {
+			reward_function().join();
+		}
+		if constexpr (trait::prefetches_v<ObservationFunction>) {
+			observation_function().join();
+		}
+		if constexpr (trait::prefetches_v<InformationFunction>) {
+			information_function().join();
+		}
+	}
+
+	/** Take the LP view once for all the data functions reading it (see trait::uses_lp_view). */
+	auto prepare_extraction() -> void {
+		if constexpr (
+			trait::uses_lp_view_v<ObservationFunction> || trait::uses_lp_view_v<RewardFunction> ||
+			trait::uses_lp_view_v<InformationFunction>) {
+			ECOLE_TRACE_SPAN("LpView");
+			scip::prepare_lp_view(model());
+		}
+	}
+
+	auto extract_reward_information(bool done) -> std::tuple<Reward, InformationMap> {
+		prepare_extraction();
+		auto reward = extract_reward(done);
+		auto information = extract_information(done);
+		return {std::move(reward), std::move(information)};
+	}
 
 	// extract reward, observation and information (in that order)
 	auto extract_reward_observation_information(bool done) -> std::tuple<Reward, OptionalObservation, InformationMap> {
-		auto reward = reward_function().extract(model(), done);
+		prepare_extraction();
+		auto reward = extract_reward(done);
 		// Don't extract observations in final states
-		auto observation = done ? OptionalObservation{} : observation_function().extract(model(), done);
-		auto information = information_function().extract(model(), done);
+		auto observation = done ? OptionalObservation{} : extract_observation(done);
+		if constexpr (trait::prefetches_v<ObservationFunction> && trait::mutates_model_v<InformationFunction>) {
+			observation_function().join();
+		}
+		auto information = extract_information(done);
 
 		return {std::move(reward), std::move(observation), std::move(information)};
 	}
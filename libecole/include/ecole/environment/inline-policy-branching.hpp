@@ -0,0 +1,18 @@
+#pragma once
+
+#include "ecole/dynamics/inline-policy-branching.hpp"
+#include "ecole/environment/environment.hpp"
+#include "ecole/information/nothing.hpp"
+#include "ecole/observation/nothing.hpp"
+#include "ecole/reward/is-done.hpp"
+
+namespace ecole::environment {
+
+template <
+	typename ObservationFunction = observation::Nothing,
+	typename RewardFunction = reward::IsDone,
+	typename InformationFunction = information::Nothing>
+using InlinePolicyBranching =
+	Environment<dynamics::InlinePolicyBranching, ObservationFunction, RewardFunction, InformationFunction>;
+
+}  // namespace ecole::environment
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <nonstd/span.hpp>
+
+namespace ecole::environment {
+
+/**
+ * Policy forwarding the decisions of many environments, in batches, to a single inference service.
+ *
+ * Meant as the policy of a RolloutRunner, whose workers call it concurrently, so that observations go from the
+ * environments to the inference service without going through Python.
+ * Requests of the workers are gathered until ``batch_size`` of them are pending, or until the oldest pending request
+ * has waited for ``max_delay``, then sent together in a single call to the transport (for instance a gRPC stub or a
+ * shared memory queue to a GPU inference server).
+ * The transport is called by one of the waiting workers, there is no dispatching thread.
+ *
+ * @tparam Env An Environment (or any class with the same observation, action set, and action types).
+ */
+template <typename Env> class RemoteAgent {
+public:
+	using Observation = typename Env::OptionalObservation;
+	using ActionSet = typename Env::ActionSet;
+	using Action = typename Env::Action;
+
+	/** The decision requested by a worker, valid for the duration of the call to the transport. */
+	struct Request {
+		std::size_t worker;
+		Observation const* observation;
+		ActionSet const* action_set;
+	};
+
+	/**
+	 * Compute the actions of a batch of requests, in order.
+	 *
+	 * The transport may throw, in which case the exception is rethrown in every worker of the batch.
+	 */
+	using Transport = std::function<std::vector<Action>(nonstd::span<Request const>)>;
+
+	/**
+	 * Create the agent.
+	 *
+	 * @param transport Called with every batch of requests.
+	 * @param batch_size The maximum number of requests in a batch, typically the number of workers.
+	 * @param max_delay The maximum time a request waits for the batch to fill up before it is sent anyway.
+	 * @throw std::invalid_argument If batch_size is zero.
+	 */
+	RemoteAgent(
+		Transport transport,
+		std::size_t batch_size,
+		std::chrono::microseconds max_delay = std::chrono::milliseconds{1}) :
+		m_transport{std::move(transport)}, m_batch_size{batch_size}, m_max_delay{max_delay} {
+		if (m_batch_size == 0) {
+			throw std::invalid_argument{"RemoteAgent batches need at least one request."};
+		}
+	}
+
+	/**
+	 * Get the action of a worker, waiting for its batch to be sent and answered.
+	 *
+	 * @throw std::invalid_argument If the transport does not return one action per request.
+	 * @throw std::exception Any exception thrown by the transport.
+	 */
+	auto operator()(std::size_t worker, Observation const& observation, ActionSet const& action_set) -> Action {
+		auto lk = std::unique_lock{m_mutex};
+		if (m_pending == nullptr) {
+			m_pending = std::make_shared<Batch>();
+			m_pending->deadline = std::chrono::steady_clock::now() + m_max_delay;
+		}
+		auto const batch = m_pending;
+		auto const position = batch->requests.size();
+		batch->requests.push_back({worker, &observation, &action_set});
+
+		if (batch->requests.size() < m_batch_size) {
+			m_signal.wait_until(lk, batch->deadline, [&batch] { return batch->sent; });
+		}
+		// The first worker to find its batch full or late sends it
+		if (!batch->sent) {
+			batch->sent = true;
+			m_pending.reset();
+			lk.unlock();
+			send(*batch);
+			lk.lock();
+			batch->answered = true;
+			++m_n_batches;
+			m_signal.notify_all();
+		}
+		m_signal.wait(lk, [&batch] { return batch->answered; });
+		if (batch->error) {
+			std::rethrow_exception(batch->error);
+		}
+		return batch->actions[position];
+	}
+
+	/** The number of batches sent. */
+	[[nodiscard]] auto n_batches() const -> std::size_t {
+		auto const lk = std::lock_guard{m_mutex};
+		return m_n_batches;
+	}
+
+private:
+	struct Batch {
+		std::vector<Request> requests;
+		std::vector<Action> actions;
+		std::exception_ptr error;
+		std::chrono::steady_clock::time_point deadline;
+		bool sent = false;
+		bool answered = false;
+	};
+
+	Transport m_transport;
+	std::size_t m_batch_size;
+	std::chrono::microseconds m_max_delay;
+	mutable std::mutex m_mutex;
+	std::condition_variable m_signal;
+	std::shared_ptr<Batch> m_pending;
+	std::size_t m_n_batches = 0;
+
+	/** Call the transport without holding the lock, since no other worker touches a sent batch. */
+	void send(Batch& batch) {
+		try {
+			batch.actions = m_transport(nonstd::span<Request const>{batch.requests.data(), batch.requests.size()});
+			if (batch.actions.size() != batch.requests.size()) {
+				throw std::invalid_argument{"RemoteAgent transport must return one action per request."};
+			}
+		} catch (...) {
+			batch.error = std::current_exception();
+		}
+	}
+};
+
+}  // namespace ecole::environment
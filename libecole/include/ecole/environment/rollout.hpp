@@ -0,0 +1,212 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ecole/random.hpp"
+#include "ecole/utility/affinity.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::environment {
+
+/** Summary of an episode run by a RolloutRunner. */
+template <typename Reward> struct EpisodeResult {
+	/** Index of the episode, in the order instances were taken from the queue. */
+	std::size_t episode;
+	/** Index of the environment, and of the worker thread it is pinned to, that ran the episode. */
+	std::size_t worker;
+	/** Number of transitions, not counting the reset. */
+	std::size_t n_steps;
+	/** Sum of the rewards of the episode, including the reward offset returned by the reset. */
+	Reward cumulative_reward;
+};
+
+/**
+ * Run complete episodes over many instances in parallel.
+ *
+ * Every environment is pinned to a worker thread, which runs its episode from reset to terminal state without
+ * interruption.
+ * As soon as a worker finishes an episode, it takes the next instance from a queue shared by all workers, so that
+ * episodes of very different lengths balance over the workers instead of leaving idle cores behind a static partition.
+ *
+ * Environments are seeded before every episode from the index of the episode, so that an episode does not depend on the
+ * worker running it, nor on the number of workers.
+ *
+ * Workers can be pinned to physical cores (see utility::physical_cores), in which case the solver of every
+ * environment runs on the same core as its worker (see utility::AffinityPolicy), and the memory of the environment
+ * stays on the NUMA node of that core.
+ *
+ * @tparam Env An Environment (or any class with the same reset, step, and seed interface).
+ */
+template <typename Env> class RolloutRunner {
+public:
+	using Seed = typename Env::Seed;
+	using OptionalObservation = typename Env::OptionalObservation;
+	using Action = typename Env::Action;
+	using ActionSet = typename Env::ActionSet;
+	using Reward = typename Env::Reward;
+	using Result = EpisodeResult<Reward>;
+
+	/**
+	 * Take ownership of the environments, each with its own worker thread.
+	 *
+	 * @param envs The environments, one per worker.
+	 * @param pin_workers Whether worker ``i`` runs on the ``i``-th physical core (modulo the number of cores), filling
+	 *        a socket before the next.
+	 * @throw std::invalid_argument If no environment is given.
+	 */
+	explicit RolloutRunner(std::vector<Env> envs, bool pin_workers = false) :
+		m_envs(std::move(envs)), m_pool(std::make_unique<utility::ThreadPool>(m_envs.size())) {
+		if (m_envs.empty()) {
+			throw std::invalid_argument{"A RolloutRunner needs at least one environment."};
+		}
+		if (pin_workers) {
+			m_cores = utility::physical_cores();
+		}
+	}
+
+	/** Seed the episodes of the following runs. */
+	void seed(Seed new_seed) { m_rng.seed(new_seed); }
+
+	/**
+	 * Run one episode per instance, taking instances in order.
+	 *
+	 * @see run_from
+	 */
+	template <typename Instance, typename Policy, typename... Args>
+	auto run(std::vector<Instance> instances, Policy&& policy, Args const&... args) -> std::vector<Result> {
+		auto next = instances.begin();
+		auto next_instance = [&instances, &next]() -> std::optional<Instance> {
+			if (next == instances.end()) {
+				return {};
+			}
+			return std::move(*(next++));
+		};
+		return run_from(next_instance, std::forward<Policy>(policy), args...);
+	}
+
+	/**
+	 * Run one episode per instance until the instance queue is exhausted.
+	 *
+	 * @param next_instance Called by idle workers, one at a time, to get the next instance (a filename or a model), or
+	 *        an empty optional when there are none left, for instance by wrapping an instance::InstanceGenerator.
+	 * @param policy Called as ``policy(worker, observation, action_set)`` in the worker threads to get the action of
+	 *        every transition, hence concurrently for different workers.
+	 * @param args Passed to every Environment::reset.
+	 * @return The results of every episode, ordered by episode index.
+	 * @throw std::exception The first exception raised by an episode, once running episodes have completed.
+	 *        No new episode is started after an exception.
+	 */
+	template <typename InstanceSource, typename Policy, typename... Args>
+	auto run_from(InstanceSource&& next_instance, Policy&& policy, Args const&... args) -> std::vector<Result> {
+		using Instance = typename std::invoke_result_t<InstanceSource&>::value_type;
+
+		auto const run_seed = m_rng();
+		auto queue_mutex = std::mutex{};
+		auto n_taken = std::size_t{0};
+		auto stopped = false;
+		auto error = std::exception_ptr{};
+		auto results = std::vector<Result>{};
+
+		auto take_instance = [&]() -> std::optional<std::pair<std::size_t, Instance>> {
+			auto const lk = std::lock_guard{queue_mutex};
+			if (stopped) {
+				return {};
+			}
+			auto instance = next_instance();
+			if (!instance.has_value()) {
+				stopped = true;
+				return {};
+			}
+			return std::pair{n_taken++, std::move(instance).value()};
+		};
+
+		auto run_worker = [&](std::size_t worker) {
+			auto const pinned = utility::ScopedAffinity{worker_cpus(worker)};
+			while (auto taken = take_instance()) {
+				auto& [episode, instance] = taken.value();
+				try {
+					auto const episode_seed = derive_random_generator(RandomGenerator{run_seed}, episode)();
+					auto result = run_episode(worker, episode, episode_seed, std::move(instance), policy, args...);
+					auto const lk = std::lock_guard{queue_mutex};
+					results.push_back(result);
+				} catch (...) {
+					auto const lk = std::lock_guard{queue_mutex};
+					if (!error) {
+						error = std::current_exception();
+					}
+					stopped = true;
+				}
+			}
+		};
+
+		auto futures = std::vector<std::future<void>>{};
+		futures.reserve(size());
+		for (std::size_t worker = 0; worker < size(); ++worker) {
+			futures.push_back(m_pool->submit([&run_worker, worker] { run_worker(worker); }));
+		}
+		// All workers are awaited before rethrowing since they reference local variables
+		for (auto& fut : futures) {
+			fut.wait();
+		}
+		if (error) {
+			std::rethrow_exception(error);
+		}
+		std::sort(results.begin(), results.end(), [](auto const& a, auto const& b) { return a.episode < b.episode; });
+		return results;
+	}
+
+	/** The number of environments, and of worker threads. */
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return m_envs.size(); }
+
+	auto& environment(std::size_t i) { return m_envs.at(i); }
+	auto& environments() { return m_envs; }
+
+	/** The CPUs of a worker, or an empty set if workers are not pinned. */
+	[[nodiscard]] auto worker_cpus(std::size_t worker) const -> utility::CpuSet {
+		if (m_cores.empty()) {
+			return {};
+		}
+		return m_cores[worker % m_cores.size()];
+	}
+
+private:
+	std::vector<Env> m_envs;
+	RandomGenerator m_rng = spawn_random_generator();
+	std::vector<utility::CpuSet> m_cores;
+	// Destroyed first so that workers still running do not outlive the environments
+	std::unique_ptr<utility::ThreadPool> m_pool;
+
+	template <typename Instance, typename Policy, typename... Args>
+	auto run_episode(
+		std::size_t worker,
+		std::size_t episode,
+		Seed episode_seed,
+		Instance&& instance,
+		Policy& policy,
+		Args const&... args) -> Result {
+		auto& env = m_envs[worker];
+		env.seed(episode_seed);
+		auto [obs, action_set, reward, done, info] = env.reset(std::forward<Instance>(instance), args...);
+		auto result = Result{episode, worker, 0, reward};
+		while (!done) {
+			auto const action = policy(worker, obs, action_set);
+			std::tie(obs, action_set, reward, done, info) = env.step(action);
+			++result.n_steps;
+			result.cumulative_reward += reward;
+		}
+		return result;
+	}
+};
+
+}  // namespace ecole::environment
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+#include "ecole/export.hpp"
+
+namespace ecole::scip {
+class Model;
+}
+
+namespace ecole::environment {
+
+/**
+ * Decide from the state of the solver whether to end the episode now.
+ *
+ * Criteria are evaluated by the solver itself, every time a node is solved or a new best solution is found, and hence
+ * run in the thread solving the model rather than the one calling Environment::step.
+ */
+using StoppingCriterion = std::function<bool(scip::Model&)>;
+
+/**
+ * Evaluate the criterion during the solving of the model, interrupting the solving as soon as it holds.
+ *
+ * The model ends its solving as if a limit was reached, so the episode terminates without yielding the states in
+ * between.
+ * Exceptions thrown by the criterion also interrupt the solving, and are rethrown by rethrow_stopping_criterion_error.
+ *
+ * @pre The model must not be transformed yet.
+ */
+ECOLE_EXPORT auto include_stopping_criterion(scip::Model& model, StoppingCriterion criterion) -> void;
+
+/** Rethrow the exception thrown by the stopping criterion of the model, if any. */
+ECOLE_EXPORT auto rethrow_stopping_criterion_error(scip::Model& model) -> void;
+
+/** Whether the solving of the model was interrupted by its stopping criterion. */
+ECOLE_EXPORT auto is_stopped_by_criterion(scip::Model& model) -> bool;
+
+/** Stop once the relative primal-dual gap is at most the given value. */
+ECOLE_EXPORT auto gap_below(double gap) -> StoppingCriterion;
+
+/** Stop once the primal bound did not improve over the last given number of nodes. */
+ECOLE_EXPORT auto primal_bound_stalled(std::size_t n_nodes) -> StoppingCriterion;
+
+}  // namespace ecole::environment
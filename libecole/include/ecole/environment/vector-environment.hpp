@@ -0,0 +1,487 @@
+#pragma once
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ecole/environment/environment.hpp"
+#include "ecole/exception.hpp"
+#include "ecole/instance/abstract.hpp"
+#include "ecole/random.hpp"
+#include "ecole/traits.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::environment {
+
+/**
+ * Collection of environments stepped concurrently.
+ *
+ * Each environment is reset and transitioned in a worker thread, so that solving of the different instances
+ * overlaps across cores and the caller pays a single round trip per batch.
+ * Environments that have reached a terminal state are not transitioned anymore until the next reset, and their entries
+ * in the batch returned by step are empty, with a zero reward and a ``true`` done flag.
+ *
+ * Environments can also be reset and transitioned individually with reset_async and step_async, in which case
+ * wait_any is used to collect the transitions in the order in which they complete.
+ *
+ * With set_auto_reset, environments rather start a new episode in the background as soon as they reach a terminal
+ * state, on an instance of the given generator, so that the next step does not wait on presolving and solving the
+ * root node of the new instance.
+ *
+ * @see Environment
+ */
+template <typename Dynamics, typename ObservationFunction, typename RewardFunction, typename InformationFunction>
+class VectorEnvironment {
+public:
+	using Env = Environment<Dynamics, ObservationFunction, RewardFunction, InformationFunction>;
+	using Seed = typename Env::Seed;
+	using OptionalObservation = typename Env::OptionalObservation;
+	using Action = typename Env::Action;
+	using ActionSet = typename Env::ActionSet;
+	using Reward = typename Env::Reward;
+	using InformationMap = typename Env::InformationMap;
+	/** Return of a single Environment::reset or Environment::step. */
+	using Transition = std::tuple<OptionalObservation, ActionSet, Reward, bool, InformationMap>;
+	/** Batched return of reset and step, each vector having one entry per environment. */
+	using Batch = std::tuple<
+		std::vector<OptionalObservation>,
+		std::vector<ActionSet>,
+		std::vector<Reward>,
+		std::vector<bool>,
+		std::vector<InformationMap>>;
+
+	/**
+	 * Take ownership of existing environments.
+	 *
+	 * @param envs The environments to step concurrently.
+	 * @param n_threads The number of worker threads, or zero to use one per environment (up to get_n_threads()).
+	 */
+	explicit VectorEnvironment(std::vector<Env> envs, std::size_t n_threads = 0) :
+		m_envs(std::move(envs)),
+		m_dones(m_envs.size(), true),
+		m_pending(m_envs.size()),
+		m_completion(std::make_unique<Completion>()),
+		m_auto_resets(m_envs.size()),
+		m_pool(std::make_unique<utility::ThreadPool>(
+			n_threads > 0 ? n_threads : std::min(m_envs.size(), utility::ThreadPool::default_n_threads()))) {}
+
+	/**
+	 * Create ``n_envs`` identical environments.
+	 *
+	 * The state functions, parameters, and dynamics arguments are copied in every environment.
+	 */
+	template <typename... Args>
+	VectorEnvironment(
+		std::size_t n_envs,
+		ObservationFunction const& observation_function = {},
+		RewardFunction const& reward_function = {},
+		InformationFunction const& information_function = {},
+		std::map<std::string, scip::Param> const& scip_params = {},
+		Args const&... args) :
+		VectorEnvironment(
+			make_envs(n_envs, observation_function, reward_function, information_function, scip_params, args...)) {}
+
+	/**
+	 * Seed every environment.
+	 *
+	 * Environment ``i`` is seeded from the stream ``i`` derived from ``new_seed`` so that environments follow
+	 * different trajectories, and do not overlap with the environments of vectors seeded with nearby seeds.
+	 * Automatic resets in progress are discarded, since they use the random generators of the environments.
+	 */
+	void seed(Seed new_seed) {
+		discard_auto_resets();
+		auto const rng = RandomGenerator{new_seed};
+		for (std::size_t i = 0; i < size(); ++i) {
+			m_envs[i].seed(derive_random_generator(rng, i)());
+		}
+	}
+
+	/**
+	 * Reset every environment concurrently.
+	 *
+	 * @param instances One problem instance (filename or model) per environment.
+	 * @param args Passed to every EnvironmentDynamics.
+	 * @return The batched return of every Environment::reset.
+	 * @throw std::exception The first exception raised by an environment, after all of them have completed.
+	 */
+	template <typename Instance, typename... Args>
+	auto reset(std::vector<Instance> instances, Args const&... args) -> Batch {
+		check_size(instances.size(), "instances");
+		discard_auto_resets();
+		auto reset_one = [this, &instances, &args...](std::size_t i) {
+			return m_envs[i].reset(std::move(instances[i]), args...);
+		};
+		auto batch = run_all(reset_one, false);
+		start_auto_resets();
+		return batch;
+	}
+
+	/**
+	 * Reset every environment concurrently on instances of the generator given to set_auto_reset.
+	 *
+	 * Automatic resets in progress are discarded, and their instances are not reused.
+	 *
+	 * @return The batched return of every Environment::reset.
+	 * @throw MarkovError If automatic resets are not enabled.
+	 * @throw std::exception The first exception raised by an environment, after all of them have completed.
+	 */
+	auto reset() -> Batch {
+		static_assert(trait::has_default_reset_v<Dynamics>, "Dynamics must be reset without arguments.");
+		if (m_generator == nullptr) {
+			throw MarkovError{"Resetting without instances needs an instance generator set with set_auto_reset."};
+		}
+		discard_auto_resets();
+		// Drawn in order of environments, so that seeded generators give the same instance to the same environment
+		auto instances = std::vector<scip::Model>{};
+		instances.reserve(size());
+		for (std::size_t i = 0; i < size(); ++i) {
+			instances.push_back(m_generator->next());
+		}
+		return reset(std::move(instances));
+	}
+
+	/**
+	 * Transition every environment that is not in a terminal state concurrently.
+	 *
+	 * With automatic resets, environments in terminal states rather return the first transition of their new episode,
+	 * that is the return of Environment::reset, waiting for it if needed.
+	 *
+	 * @param actions One action per environment, ignored for environments in terminal states.
+	 * @param args Passed to every EnvironmentDynamics.
+	 * @return The batched return of every Environment::step.
+	 * @throw std::exception The first exception raised by an environment, after all of them have completed.
+	 */
+	template <typename... Args> auto step(std::vector<Action> const& actions, Args const&... args) -> Batch {
+		check_size(actions.size(), "actions");
+		auto step_one = [this, &actions, &args...](std::size_t i) { return m_envs[i].step(actions[i], args...); };
+		auto batch = run_all(step_one, true);
+		start_auto_resets();
+		return batch;
+	}
+
+	/**
+	 * Transition every environment concurrently, resetting the ones in terminal states rather than skipping them.
+	 *
+	 * This is the automatic reset of vector environment APIs such as Gymnasium's, where environments that reached a
+	 * terminal state start a new episode on the next step, in the same round trip as the transitions of the others.
+	 *
+	 * Environments being reset automatically return their new episode and do not take an instance.
+	 *
+	 * @param actions One action per environment, ignored for environments in terminal states.
+	 * @param instances One problem instance (filename or model) per environment in a terminal state, in order.
+	 * @param reset_args Passed to the EnvironmentDynamics of every environment that is reset.
+	 * @return The batched return of every Environment::step or Environment::reset.
+	 * @throw std::exception The first exception raised by an environment, after all of them have completed.
+	 */
+	template <typename Instance, typename... Args>
+	auto step_or_reset(std::vector<Action> const& actions, std::vector<Instance> instances, Args const&... reset_args)
+		-> Batch {
+		check_size(actions.size(), "actions");
+		// Copied since m_dones is updated while tasks run
+		auto resets = m_dones;
+		for (std::size_t i = 0; i < size(); ++i) {
+			resets[i] = resets[i] && !m_auto_resets[i].valid();
+		}
+		auto instance_idx = std::vector<std::size_t>(size());
+		auto n_resets = std::size_t{0};
+		for (std::size_t i = 0; i < size(); ++i) {
+			if (resets[i]) {
+				instance_idx[i] = n_resets++;
+			}
+		}
+		if (instances.size() != n_resets) {
+			throw std::invalid_argument{fmt::format("Expected {} instances but got {}.", n_resets, instances.size())};
+		}
+		auto step_or_reset_one = [&](std::size_t i) -> Transition {
+			if (resets[i]) {
+				return m_envs[i].reset(std::move(instances[instance_idx[i]]), reset_args...);
+			}
+			return m_envs[i].step(actions[i]);
+		};
+		auto batch = run_all(step_or_reset_one, false);
+		start_auto_resets();
+		return batch;
+	}
+
+	/**
+	 * Reset environments in the background as soon as they reach a terminal state.
+	 *
+	 * The environments already in a terminal state start being reset immediately.
+	 * Instances are generated in the calling thread, in order of environments so that a seeded generator gives the
+	 * same instances to the same environments on every run, and then presolved and solved up to the first observation
+	 * concurrently in the worker threads.
+	 * Automatic resets use the default arguments of the EnvironmentDynamics.
+	 *
+	 * @param generator The source of new instances, which must not be used elsewhere while resets are in progress, or
+	 *        null to stop resetting automatically, discarding the resets in progress.
+	 * @throw MarkovError If asynchronous transitions have not been collected with wait_any.
+	 */
+	void set_auto_reset(std::shared_ptr<instance::InstanceGenerator> generator) {
+		static_assert(trait::has_default_reset_v<Dynamics>, "Dynamics must be reset without arguments.");
+		if (n_pending() > 0) {
+			throw MarkovError{"Asynchronous transitions must be collected with wait_any first."};
+		}
+		discard_auto_resets();
+		m_generator = std::move(generator);
+		start_auto_resets();
+	}
+
+	/** Whether environments are reset automatically. */
+	[[nodiscard]] auto auto_reset() const noexcept -> bool { return m_generator != nullptr; }
+
+	/**
+	 * Reset a single environment in the thread pool without waiting for it.
+	 *
+	 * @param i The index of the environment to reset.
+	 * @param instance The problem instance (filename or model) passed to Environment::reset.
+	 * @param args Copied and passed to the EnvironmentDynamics.
+	 * @see wait_any To collect the result.
+	 */
+	template <typename Instance, typename... Args> void reset_async(std::size_t i, Instance instance, Args... args) {
+		submit_one(i, [env = &environment(i), instance = std::move(instance), args...]() mutable {
+			return env->reset(std::move(instance), std::move(args)...);
+		});
+	}
+
+	/**
+	 * Transition a single environment in the thread pool without waiting for it.
+	 *
+	 * @param i The index of the environment to transition.
+	 * @param action Copied and passed to Environment::step.
+	 * @param args Copied and passed to the EnvironmentDynamics.
+	 * @see wait_any To collect the result.
+	 */
+	template <typename... Args> void step_async(std::size_t i, Action action, Args... args) {
+		submit_one(i, [env = &environment(i), action = std::move(action), args...]() mutable {
+			return env->step(action, std::move(args)...);
+		});
+	}
+
+	/**
+	 * Wait for the first pending asynchronous reset or transition to complete.
+	 *
+	 * @return The index of the environment and the return value of its reset or step.
+	 * @throw MarkovError If there are no pending asynchronous reset or transition.
+	 * @throw std::exception The exception raised by the environment, which is then left in a terminal state.
+	 */
+	auto wait_any() -> std::tuple<std::size_t, Transition> {
+		if (n_pending() == 0) {
+			throw MarkovError{"No pending asynchronous transition."};
+		}
+		auto const i = [this] {
+			auto lk = std::unique_lock{m_completion->mutex};
+			m_completion->signal.wait(lk, [this] { return !m_completion->ready.empty(); });
+			auto const idx = m_completion->ready.front();
+			m_completion->ready.pop_front();
+			return idx;
+		}();
+		try {
+			auto transition = m_pending[i].get();
+			m_dones[i] = std::get<3>(transition);
+			return {i, std::move(transition)};
+		} catch (...) {
+			m_dones[i] = true;
+			throw;
+		}
+	}
+
+	/** The number of asynchronous resets and transitions not yet collected by wait_any. */
+	[[nodiscard]] auto n_pending() const noexcept -> std::size_t {
+		return static_cast<std::size_t>(
+			std::count_if(m_pending.begin(), m_pending.end(), [](auto const& future) { return future.valid(); }));
+	}
+
+	/** The number of environments. */
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return m_envs.size(); }
+
+	/** Whether the environment is in a terminal state, or has not been reset yet. */
+	[[nodiscard]] auto done(std::size_t i) const -> bool { return m_dones.at(i); }
+
+	auto& environment(std::size_t i) { return m_envs.at(i); }
+	auto& environments() { return m_envs; }
+
+private:
+	std::vector<Env> m_envs;
+	std::vector<bool> m_dones;
+
+	/** Indices of the environments whose asynchronous task has completed, in order of completion. */
+	struct Completion {
+		std::mutex mutex;
+		std::condition_variable signal;
+		std::deque<std::size_t> ready;
+	};
+	std::vector<std::future<Transition>> m_pending;
+	std::unique_ptr<Completion> m_completion;
+
+	/** The generator of automatic resets, only used from the calling thread. */
+	std::shared_ptr<instance::InstanceGenerator> m_generator;
+	/** The resets started when environments reached a terminal state, returned by the next step. */
+	std::vector<std::future<Transition>> m_auto_resets;
+
+	// Destroyed first so that tasks still running do not outlive the environments
+	std::unique_ptr<utility::ThreadPool> m_pool;
+
+	template <typename... Args>
+	static auto make_envs(
+		std::size_t n_envs,
+		ObservationFunction const& observation_function,
+		RewardFunction const& reward_function,
+		InformationFunction const& information_function,
+		std::map<std::string, scip::Param> const& scip_params,
+		Args const&... args) -> std::vector<Env> {
+		auto envs = std::vector<Env>{};
+		envs.reserve(n_envs);
+		for (std::size_t i = 0; i < n_envs; ++i) {
+			envs.emplace_back(observation_function, reward_function, information_function, scip_params, args...);
+		}
+		return envs;
+	}
+
+	/** Append the entry of an environment in a terminal state. */
+	static void push_terminal(Batch& batch) {
+		auto& [observations, action_sets, rewards, dones, informations] = batch;
+		observations.emplace_back();
+		action_sets.emplace_back();
+		rewards.push_back(0.);
+		dones.push_back(true);
+		informations.emplace_back();
+	}
+
+	/** Start resetting the environments in terminal states that are not already being reset. */
+	void start_auto_resets() {
+		if constexpr (trait::has_default_reset_v<Dynamics>) {
+			if (m_generator == nullptr) {
+				return;
+			}
+			for (std::size_t i = 0; i < size(); ++i) {
+				if (m_dones[i] && !m_auto_resets[i].valid()) {
+					try {
+						m_auto_resets[i] = m_pool->submit([env = &m_envs[i], instance = m_generator->next()]() mutable {
+							return env->reset(std::move(instance));
+						});
+					} catch (...) {
+						// Rethrown by the next step, as the exceptions of the reset itself
+						auto failed = std::promise<Transition>{};
+						failed.set_exception(std::current_exception());
+						m_auto_resets[i] = failed.get_future();
+					}
+				}
+			}
+		}
+	}
+
+	/** Wait for the automatic resets in progress and drop them, leaving their environments in terminal states. */
+	void discard_auto_resets() noexcept {
+		for (std::size_t i = 0; i < size(); ++i) {
+			if (m_auto_resets[i].valid()) {
+				// The result and exceptions of the reset are not needed anymore
+				m_auto_resets[i].wait();
+				m_auto_resets[i] = {};
+				m_dones[i] = true;
+			}
+		}
+	}
+
+	/** Schedule an asynchronous task on environment ``i`` that signals its completion to wait_any. */
+	template <typename Func> void submit_one(std::size_t i, Func&& func) {
+		if (m_pending.at(i).valid()) {
+			throw MarkovError{fmt::format("Environment {} already has a pending asynchronous transition.", i)};
+		}
+		if (m_auto_resets[i].valid()) {
+			throw MarkovError{fmt::format("Environment {} is being reset automatically.", i)};
+		}
+		m_pending[i] = m_pool->submit([completion = m_completion.get(), i, func = std::forward<Func>(func)]() mutable {
+			// Signal in destructor to also notify when the task throws
+			struct Notifier {
+				Completion& completion;
+				std::size_t idx;
+				~Notifier() {
+					{
+						auto const lk = std::lock_guard{completion.mutex};
+						completion.ready.push_back(idx);
+					}
+					completion.signal.notify_one();
+				}
+			} notifier{*completion, i};
+			return func();
+		});
+	}
+
+	void check_size(std::size_t n_given, char const* what) const {
+		if (n_given != size()) {
+			throw std::invalid_argument{fmt::format("Expected {} {} but got {}.", size(), what, n_given)};
+		}
+	}
+
+	/**
+	 * Run the function on every environment in the thread pool and collect the results.
+	 *
+	 * When ``skip_done`` is set, environments in terminal states are not run and get a terminal entry in the batch.
+	 * Environments being reset automatically are not run either, and get the result of their reset.
+	 * All tasks are awaited before returning or throwing, so the function can safely capture by reference.
+	 */
+	template <typename Func> auto run_all(Func&& func, bool skip_done) -> Batch {
+		if (n_pending() > 0) {
+			throw MarkovError{"Asynchronous transitions must be collected with wait_any first."};
+		}
+
+		// Futures left invalid (default constructed) are environments that are skipped
+		auto futures = std::vector<std::future<Transition>>(size());
+		for (std::size_t i = 0; i < size(); ++i) {
+			if (m_auto_resets[i].valid()) {
+				futures[i] = std::move(m_auto_resets[i]);
+			} else if (!(skip_done && m_dones[i])) {
+				futures[i] = m_pool->submit([&func, i] { return func(i); });
+			}
+		}
+
+		auto batch = Batch{};
+		auto& [observations, action_sets, rewards, dones, informations] = batch;
+		observations.reserve(size());
+		action_sets.reserve(size());
+		rewards.reserve(size());
+		dones.reserve(size());
+		informations.reserve(size());
+
+		auto error = std::exception_ptr{};
+		for (std::size_t i = 0; i < size(); ++i) {
+			if (!futures[i].valid()) {
+				push_terminal(batch);
+				continue;
+			}
+			try {
+				auto [obs, action_set, reward, done, info] = futures[i].get();
+				observations.push_back(std::move(obs));
+				action_sets.push_back(std::move(action_set));
+				rewards.push_back(reward);
+				dones.push_back(done);
+				informations.push_back(std::move(info));
+			} catch (...) {
+				push_terminal(batch);
+				if (!error) {
+					error = std::current_exception();
+				}
+			}
+			m_dones[i] = dones.back();
+		}
+		if (error) {
+			std::rethrow_exception(error);
+		}
+		return batch;
+	}
+};
+
+}  // namespace ecole::environment
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstddef>
+
+#include "ecole/export.hpp"
+#include "ecole/scip/plugins.hpp"
+
+namespace ecole {
+
+/** The number of threads created by Ecole that are running, in all binaries using it. */
+[[nodiscard]] ECOLE_EXPORT auto n_running_threads() noexcept -> std::size_t;
+
+/**
+ * Check that the process can be forked for the children to use Ecole.
+ *
+ * A forked child only has the thread that called fork, but inherits the memory of the parent, including objects that
+ * refer to threads that do not exist in the child.
+ * Objects of Ecole that do not hold threads can be created in the parent and used in the children, where their memory
+ * is shared with the parent until modified.
+ * These are models, of any stage, instance generators, random generators, and data functions and environments
+ * created with a single thread.
+ *
+ * Threads are held by
+ *  - Models being solved by a coroutine, as between the reset and the end of the episode of most environments,
+ *  - Data functions created with more than one thread, or created with zero threads while ecole::get_n_threads is
+ *    more than one, after which the shared thread pool stays alive for as long as ecole::set_n_threads is not called
+ *    again,
+ *  - Vector environments, prefetching instance generators, and shuffled trajectory iterators,
+ *  - The threads kept by utility::ThreadCache, when coroutines are built to use them.
+ *
+ * @throw std::runtime_error If threads created by Ecole are running.
+ */
+ECOLE_EXPORT void check_fork_safe();
+
+/**
+ * Initialize the process wide state that Ecole and SCIP otherwise create on first use.
+ *
+ * A small problem is created with the plugins of the profile, and solved unless they cannot, so that the libraries
+ * are loaded and their lazily initialized state created, before forking worker processes that share them.
+ * No Ecole thread is left running, and no global random generator is used.
+ */
+ECOLE_EXPORT void prewarm(scip::PluginProfile profile = scip::PluginProfile::full);
+
+}  // namespace ecole
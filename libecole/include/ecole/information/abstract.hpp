@@ -1,12 +1,16 @@
 #pragma once
 
-#include <map>
 #include <string>
 
 #include "ecole/data/abstract.hpp"
+#include "ecole/utility/flat-map.hpp"
 
 namespace ecole::information {
 
-/** The type of information dictionnaries. */
-template <typename Information> using InformationMap = std::map<std::string, Information>;
+/**
+ * The type of information dictionnaries.
+ *
+ * A flat map, since information functions return a handful of entries on every transition.
+ */
+template <typename Information> using InformationMap = utility::FlatMap<std::string, Information>;
 }  // namespace ecole::information
@@ -13,6 +13,9 @@ namespace ecole::information {
  */
 class Nothing {
 public:
+	static constexpr bool mutates_model = false;
+	static constexpr bool extracts_nothing = true;
+
 	auto before_reset(scip::Model& /*model*/) -> void {}
 
 	auto extract(scip::Model& /* model */, bool /* done */) -> InformationMap<NoneType> { return {}; }
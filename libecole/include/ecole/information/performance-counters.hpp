@@ -0,0 +1,34 @@
+#pragma once
+
+#include "ecole/export.hpp"
+#include "ecole/information/abstract.hpp"
+
+namespace ecole::information {
+
+/**
+ * Information function returning where the time of the episode went.
+ *
+ * The counters are cumulated since the start of iterative solving, that is since the environment was reset, and
+ * are returned in an information map with the following keys.
+ * Times are in seconds of wall clock.
+ *
+ * - ``n_yields``: the number of times the solver gave back control to the environment.
+ * - ``n_skipped_calls``: the number of callbacks answered in the solver thread without giving back control, such as
+ *   branching calls that the dynamics does not handle.
+ * - ``n_missed_deadlines``: the number of callbacks answered by the solver itself because the agent did not act before
+ *   the deadline of the dynamics.
+ * - ``solving_time``: the time SCIP spent solving, between yields.
+ * - ``waiting_time``: the time the environment spent blocked waiting for the solver, which is the solving time plus
+ *   the cost of switching threads.
+ * - ``caller_time``: the time between SCIP yielding and solving being resumed, spent in the environment and agent.
+ * - ``time_since_yield``: the time since SCIP last yielded, that is, when extracted by an environment, the time spent
+ *   building the action set, extracting the reward and the observation in the current transition.
+ */
+class ECOLE_EXPORT PerformanceCounters {
+public:
+	auto before_reset(scip::Model& /*model*/) -> void {}
+
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done = false) -> InformationMap<double>;
+};
+
+}  // namespace ecole::information
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <vector>
+
+#include "ecole/export.hpp"
+#include "ecole/information/abstract.hpp"
+
+namespace ecole::information {
+
+/** What happened to a node once solved. */
+enum struct ECOLE_EXPORT NodeOutcome : std::uint8_t {
+	/** The node was branched on, creating children. */
+	branched = 0,
+	/** The LP solution of the node was feasible, or the node was cut off by the incumbent. */
+	feasible,
+	/** The node was infeasible. */
+	infeasible,
+};
+
+/**
+ * A node of the branch-and-bound tree, as recorded when solved.
+ *
+ * Records are written to files with a fixed size, in the byte order of the machine.
+ */
+struct ECOLE_EXPORT SearchTreeRecord {
+	/** The SCIP number of the node, starting at one for the root. */
+	std::int64_t number = 0;
+	/** The number of the parent node, or zero for the root. */
+	std::int64_t parent = 0;
+	/** The lower bound of the node, and the global primal bound, when solved, in the transformed problem. */
+	double lower_bound = 0.;
+	double primal_bound = 0.;
+	/** The new bound of the variable branched on to create the node. */
+	double branching_bound = 0.;
+	/** The LP iterations spent from focusing the node until it was solved. */
+	std::int64_t lp_iterations = 0;
+	std::int32_t depth = 0;
+	/** The problem index of the variable branched on to create the node, or -1 for the root. */
+	std::int32_t branching_var = -1;
+	NodeOutcome outcome = NodeOutcome::branched;
+	/** Whether the branching bound is an upper bound, rather than a lower bound. */
+	bool branching_upper = false;
+};
+
+/**
+ * Information function streaming the branch-and-bound tree while it is solved.
+ *
+ * An event handler writes a record for every node solved, when it is branched on or found feasible or infeasible, so
+ * that the memory used does not grow with the tree.
+ * Nodes pruned before being focused are not recorded.
+ * Records of successive episodes are appended, every tree starting with its root.
+ * Only one recorder can be used on a model.
+ */
+class ECOLE_EXPORT SearchTreeRecorder {
+public:
+	/** The function receiving every record, in the solver thread. */
+	using Sink = std::function<void(SearchTreeRecord const&)>;
+
+	/**
+	 * Write records in a file, which is created or truncated.
+	 *
+	 * @throw std::runtime_error If the file cannot be opened.
+	 */
+	ECOLE_EXPORT SearchTreeRecorder(std::filesystem::path const& filename);
+	/** Pass records to a function. */
+	ECOLE_EXPORT SearchTreeRecorder(Sink sink);
+
+	/** Include the event handler recording the tree of the model. */
+	ECOLE_EXPORT auto before_reset(scip::Model& model) -> void;
+
+	/**
+	 * Return the number of records of the current episode (``n_records``), flushing the file when done.
+	 *
+	 * The information is empty on a model without the event handler, which is only included by before_reset.
+	 *
+	 * @throw std::exception The exception raised by the sink, which interrupted solving.
+	 */
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done = false) -> InformationMap<double>;
+
+private:
+	Sink sink;
+	std::function<void()> flush;
+};
+
+/**
+ * Random access to the records of a file written by SearchTreeRecorder.
+ */
+class ECOLE_EXPORT SearchTreeReader {
+public:
+	/**
+	 * Open the file and check its header.
+	 *
+	 * @throw std::runtime_error If the file cannot be opened or was not written by SearchTreeRecorder.
+	 */
+	ECOLE_EXPORT SearchTreeReader(std::filesystem::path const& filename);
+
+	/** The number of records in the file. */
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return n_records; }
+
+	/**
+	 * Read the record at the given position.
+	 *
+	 * @throw std::out_of_range If the index is not smaller than the number of records.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto read(std::size_t index) const -> SearchTreeRecord;
+
+	/** Read consecutive records, by chunks, without holding more than a chunk in memory. */
+	ECOLE_EXPORT void for_each(std::function<void(SearchTreeRecord const&)> const& func) const;
+
+	/** Read all records. */
+	[[nodiscard]] ECOLE_EXPORT auto read_all() const -> std::vector<SearchTreeRecord>;
+
+private:
+	std::filesystem::path filename;
+	std::size_t n_records = 0;
+};
+
+}  // namespace ecole::information
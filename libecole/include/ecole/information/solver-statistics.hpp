@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "ecole/export.hpp"
+#include "ecole/information/abstract.hpp"
+
+namespace ecole::information {
+
+/**
+ * Solver statistics collected in a single pass.
+ *
+ * Counters are cumulated since the start of the solving process, and are zero in stages where SCIP does not
+ * provide them.
+ * Times are in seconds.
+ */
+struct ECOLE_EXPORT SolverStatisticsData {
+	std::uint64_t n_nodes = 0;
+	std::uint64_t n_total_nodes = 0;
+	std::uint64_t n_lp_iterations = 0;
+	std::uint64_t n_root_lp_iterations = 0;
+	std::uint64_t n_primal_lp_iterations = 0;
+	std::uint64_t n_dual_lp_iterations = 0;
+	std::uint64_t n_barrier_lp_iterations = 0;
+	std::uint64_t n_strong_branching_lp_iterations = 0;
+	std::uint64_t n_diving_lp_iterations = 0;
+	std::uint64_t n_cuts_found = 0;
+	std::uint64_t n_cuts_applied = 0;
+	std::uint64_t n_separation_rounds = 0;
+	double presolving_time = 0.;
+	double solving_time = 0.;
+	/** Time spent in every plugin, named as ``<type>/<name>`` (for instance ``heuristic/rounding``). */
+	std::vector<std::pair<std::string, double>> plugin_times;
+};
+
+/**
+ * Information function returning a configurable set of solver statistics.
+ *
+ * All statistics are queried in one pass over the model, which is cheaper than composing a function per statistic.
+ * The statistics are returned in an information map, with the names of the fields of SolverStatisticsData as keys,
+ * and plugin times prefixed by ``time/``.
+ */
+class ECOLE_EXPORT SolverStatistics {
+public:
+	/** The groups of statistics to collect. */
+	struct ECOLE_EXPORT Parameters {
+		/** Number of nodes in the current run and in all runs. */
+		bool nodes = true;
+		/** Number of LP iterations, in total and by type of LP. */
+		bool lp_iterations = true;
+		/** Number of cuts found and applied. */
+		bool cuts = true;
+		/** Number of separation rounds. */
+		bool separation_rounds = true;
+		/** Presolving and solving times. */
+		bool times = true;
+		/** Time spent in every heuristic, separator, propagator, presolver, and branching rule. */
+		bool plugin_times = false;
+	};
+
+	SolverStatistics(Parameters parameters_) noexcept : parameters{parameters_} {}
+	SolverStatistics() noexcept = default;
+
+	auto before_reset(scip::Model& /*model*/) -> void {}
+
+	/** Collect the statistics in the flat structure, leaving the groups not requested to zero. */
+	[[nodiscard]] ECOLE_EXPORT auto collect(scip::Model& model) const -> SolverStatisticsData;
+
+	/** Collect the statistics and return them as a map. */
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done = false) -> InformationMap<double>;
+
+	[[nodiscard]] auto get_parameters() const noexcept -> Parameters const& { return parameters; }
+
+private:
+	Parameters parameters;
+};
+
+}  // namespace ecole::information
@@ -1,5 +1,9 @@
 #pragma once
 
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
 #include "ecole/export.hpp"
 #include "ecole/random.hpp"
 #include "ecole/scip/model.hpp"
@@ -27,6 +31,25 @@ public:
 	 * Wether the generator is exhausted.
 	 */
 	[[nodiscard]] ECOLE_EXPORT virtual bool done() const = 0;
+
+	/**
+	 * Save the state of the generator, from which load_state resumes the same sequence of instances.
+	 *
+	 * @throw std::logic_error If the generator does not support saving its state.
+	 */
+	[[nodiscard]] ECOLE_EXPORT virtual auto save_state() const -> std::string {
+		throw std::logic_error{"Instance generator does not support saving its state."};
+	}
+
+	/**
+	 * Restore a state returned by save_state on a generator of the same type and parameters.
+	 *
+	 * @throw std::invalid_argument If the state was not saved by a generator of the same type and parameters.
+	 * @throw std::logic_error If the generator does not support saving its state.
+	 */
+	ECOLE_EXPORT virtual void load_state(std::string_view /*state*/) {
+		throw std::logic_error{"Instance generator does not support saving its state."};
+	}
 };
 
 }  // namespace ecole::instance
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "ecole/export.hpp"
+#include "ecole/scip/model.hpp"
+
+namespace ecole::instance {
+
+/**
+ * Cache of problem instances read once and copied on every request.
+ *
+ * Reading and parsing an instance file is done only once per template, after which every request is served with a
+ * copy of the original problem.
+ * Copies of the same model are serialized, so the cache keeps a pool of templates for every instance and creates a
+ * new one only when all existing templates are being copied by other threads.
+ * Hence, threads repeatedly resetting environments on the same instance do not wait on one another.
+ *
+ * Instances are identified by their file name and modification time, so modified files are read again.
+ * The size of the cache can be bounded by the total number of non zeros of its templates, that is the number of
+ * variables plus the number of coefficients in the constraints.
+ * When the bound is exceeded, the templates of the least recently used instances are dropped.
+ *
+ * The cache is thread safe.
+ */
+class ECOLE_EXPORT InstanceCache {
+public:
+	/**
+	 * Create an empty cache.
+	 *
+	 * @param max_nonzeros The maximum total number of non zeros of the templates kept in the cache.
+	 */
+	ECOLE_EXPORT explicit InstanceCache(std::size_t max_nonzeros = std::numeric_limits<std::size_t>::max()) noexcept;
+
+	/**
+	 * Return a fresh copy of the instance in the given file.
+	 *
+	 * The file is read only if no template of the instance is available.
+	 */
+	ECOLE_EXPORT auto get(std::string const& filename) -> scip::Model;
+
+	/** The number of distinct instances in the cache. */
+	[[nodiscard]] ECOLE_EXPORT auto size() const -> std::size_t;
+
+	/** The number of templates kept for the given instance. */
+	[[nodiscard]] ECOLE_EXPORT auto n_templates(std::string const& filename) const -> std::size_t;
+
+	/** The total number of non zeros of the templates kept. */
+	[[nodiscard]] ECOLE_EXPORT auto n_nonzeros() const -> std::size_t;
+
+	/** Remove all templates. */
+	ECOLE_EXPORT void clear();
+
+private:
+	using Time = std::filesystem::file_time_type;
+
+	struct Pool {
+		/** Templates not currently being copied. */
+		std::vector<scip::Model> available;
+		std::size_t n_templates = 0;
+		/** Identify the pool so that templates of a dropped pool are not returned to a newer one. */
+		std::uint64_t id = 0;
+		Time modification_time;
+		std::size_t n_nonzeros = 0;
+		std::uint64_t last_use = 0;
+	};
+
+	struct Template {
+		scip::Model model;
+		std::uint64_t pool_id;
+	};
+
+	std::map<std::string, Pool> m_pools;
+	std::size_t m_max_nonzeros;
+	std::size_t m_n_nonzeros = 0;
+	std::uint64_t m_clock = 0;
+	mutable std::mutex m_pools_mutex;
+
+	auto acquire(std::string const& filename) -> Template;
+	void release(std::string const& filename, Template&& model);
+	/** Unaccount the templates of a pool and return those available, to be destroyed outside of the lock. */
+	auto drop_pool(std::map<std::string, Pool>::iterator iter) -> std::vector<scip::Model>;
+	/** Remove least recently used templates until the cache fits its bound. */
+	auto evict() -> std::vector<scip::Model>;
+};
+
+}  // namespace ecole::instance
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
+#include <string_view>
 #include <utility>
 
 #include "ecole/export.hpp"
@@ -20,6 +22,8 @@ public:
 		std::pair<int, int> capacity_interval = {10, 160 + 1};           // NOLINT(readability-magic-numbers)
 		std::pair<int, int> fixed_cost_cste_interval = {0, 90 + 1};      // NOLINT(readability-magic-numbers)
 		std::pair<int, int> fixed_cost_scale_interval = {100, 110 + 1};  // NOLINT(readability-magic-numbers)
+		/** Whether to name variables and constraints, otherwise SCIP does not keep tables of names. */
+		bool named = true;
 	};
 
 	ECOLE_EXPORT static scip::Model generate_instance(Parameters parameters, RandomGenerator& rng);
@@ -30,6 +34,8 @@ public:
 
 	ECOLE_EXPORT scip::Model next() override;
 	ECOLE_EXPORT void seed(Seed seed) override;
+	[[nodiscard]] ECOLE_EXPORT auto save_state() const -> std::string override;
+	ECOLE_EXPORT void load_state(std::string_view state) override;
 	[[nodiscard]] ECOLE_EXPORT bool done() const override { return false; }
 
 	[[nodiscard]] ECOLE_EXPORT Parameters const& get_parameters() const noexcept { return parameters; }
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
+#include <string_view>
 
 #include "ecole/export.hpp"
 #include "ecole/instance/abstract.hpp"
@@ -23,6 +25,8 @@ public:
 		double resale_factor = 0.5;      // NOLINT(readability-magic-numbers)
 		bool integers = false;
 		bool warnings = false;
+		/** Whether to name variables and constraints, otherwise SCIP does not keep tables of names. */
+		bool named = true;
 	};
 
 	ECOLE_EXPORT static scip::Model generate_instance(Parameters parameters, RandomGenerator& rng);
@@ -33,6 +37,8 @@ public:
 
 	ECOLE_EXPORT scip::Model next() override;
 	ECOLE_EXPORT void seed(Seed seed) override;
+	[[nodiscard]] ECOLE_EXPORT auto save_state() const -> std::string override;
+	ECOLE_EXPORT void load_state(std::string_view state) override;
 	[[nodiscard]] ECOLE_EXPORT bool done() const override { return false; }
 
 	[[nodiscard]] ECOLE_EXPORT Parameters const& get_parameters() const noexcept { return parameters; }
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+#include "ecole/export.hpp"
+#include "ecole/instance/prefetching.hpp"
+#include "ecole/random.hpp"
+
+namespace ecole::instance {
+
+/**
+ * Generate instances and write them to files on multiple threads.
+ *
+ * Every thread creates its own generator with the factory.
+ * Instance ``i`` is generated right after seeding the generator with a seed derived from ``seed`` and ``i`` only, so the
+ * content of every file does not depend on the number of threads nor on their scheduling.
+ * Files are named ``instance-<i>.<extension>`` and the format is deduced by SCIP from the extension, for instance
+ * ``"mps.gz"`` writes compressed MPS files when SCIP is built with zlib.
+ *
+ * @param make_generator Called once per thread to create the generator it runs.
+ * @param n_instances The number of instances to write.
+ * @param seed The seed from which the seed of every instance is derived.
+ * @param directory The directory in which to write the files, created if it does not exist.
+ * @param extension The extension of the files.
+ * @param n_threads The number of threads, or zero to use the number set by ecole::set_n_threads.
+ * @return The paths of the files written, in the order of the instances.
+ * @throw std::invalid_argument If a generator is exhausted before all instances are written.
+ *  Other errors raised by the generators or when writing the files are rethrown after all threads have stopped.
+ */
+ECOLE_EXPORT auto write_dataset(
+	PrefetchingGenerator::Factory const& make_generator,
+	std::size_t n_instances,
+	Seed seed,
+	std::filesystem::path const& directory,
+	std::string const& extension = "mps",
+	std::size_t n_threads = 0) -> std::vector<std::filesystem::path>;
+
+}  // namespace ecole::instance
@@ -1,16 +1,45 @@
 #pragma once
 
 #include <cstddef>
+#include <cstdint>
+#include <deque>
 #include <filesystem>
+#include <future>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "ecole/export.hpp"
 #include "ecole/instance/abstract.hpp"
+#include "ecole/instance/manifest.hpp"
 #include "ecole/random.hpp"
 
+namespace ecole::utility {
+class ThreadPool;
+}  // namespace ecole::utility
+
 namespace ecole::instance {
 
+class InstanceCache;
+
+/**
+ * Iterate over the problem files of a directory.
+ *
+ * The files are listed once upon construction, either by scanning the directory or by reading a manifest (see
+ * write_manifest), which avoids scanning large directories on slow file systems.
+ *
+ * Files can be loaded ahead on background threads, so that parsing the next files overlaps with using the current
+ * model.
+ * Files are sampled in the same order with and without prefetching.
+ * Parsed files can also be kept in an InstanceCache, which is useful when files are sampled repeatedly.
+ *
+ * Files can be grouped in buckets of similar cost, with consecutive files sampled from the same bucket.
+ * The environments of a VectorEnvironment stepped together then get problems of similar cost, which balances their
+ * episodes and reduces the padding of their observations when they are batched.
+ *
+ * Distributed processes can each sample a disjoint shard of the files, given by their rank.
+ */
 class ECOLE_EXPORT FileGenerator : public InstanceGenerator {
 public:
 	struct ECOLE_EXPORT Parameters {
@@ -21,25 +50,116 @@ public:
 		std::string directory = "instances";
 		bool recursive = true;
 		SamplingMode sampling_mode = SamplingMode::remove_and_repeat;
+		/** The maximum number of files loaded ahead on background threads, or zero to load files on demand. */
+		std::size_t n_prefetch = 0;
+		/** Stop loading files ahead once their total size in bytes reaches this limit. */
+		std::uintmax_t prefetch_size_limit = std::uintmax_t{1} << 30;  // NOLINT(readability-magic-numbers)
+		/** Cache parsed files up to this total number of non zeros (see InstanceCache), or zero to disable caching. */
+		std::size_t cache_max_nonzeros = 0;
+		/**
+		 * Directory of binary snapshots of the files (see scip::Model::save_binary), or empty to parse files directly.
+		 *
+		 * The first time a file is sampled, its snapshot is written in this directory, and the snapshot is read
+		 * instead of the file afterward.
+		 * Only problems that snapshots reproduce exactly have one (see scip::Model::is_binary_exact), that is with
+		 * only linear constraints and default flags, other files being parsed every time.
+		 * The directory can be shared by many processes, which then parse every file once, every process still
+		 * building its own copy of the problems.
+		 * It must not be inside the directory of the files.
+		 */
+		std::string snapshot_directory = "";
+		/** A manifest listing the files (see read_manifest), read instead of scanning the directory if not empty. */
+		std::string manifest = "";
+		/**
+		 * Group the files in this many buckets of similar cost, or one to sample among all files.
+		 *
+		 * Buckets have the same number of files.
+		 * The cost of a file is given by the manifest (see ManifestEntry::cost) if it is known for all files,
+		 * otherwise its number of non zeros if it is known for all files, otherwise its size.
+		 */
+		std::size_t n_buckets = 1;
+		/**
+		 * The number of consecutive files sampled from the same bucket.
+		 *
+		 * The first file of every batch is sampled among all files, and the others in its bucket, so that every file
+		 * is still sampled with the same probability.
+		 * A batch continues in another bucket in the unlikely case where its bucket has no files left.
+		 */
+		std::size_t bucket_batch_size = 1;
+		/**
+		 * Only sample the files of this shard, out of world_size shards, such as the rank of a distributed process.
+		 *
+		 * Files are sorted by path and dealt to shards in turn, so shards are disjoint, have the same number of files
+		 * up to one, and only depend on the list of files.
+		 */
+		std::size_t rank = 0;
+		/** The number of shards in which files are split, or one to sample all files. */
+		std::size_t world_size = 1;
 	};
 
+	/** @throw std::invalid_argument If the world size is zero or the rank is not smaller than the world size. */
 	ECOLE_EXPORT FileGenerator(Parameters parameters, RandomGenerator rng);
 	ECOLE_EXPORT FileGenerator(Parameters parameters);
 	ECOLE_EXPORT FileGenerator();
+	/** Copy the sampling state, loading the files prefetched by the other generator again. */
+	ECOLE_EXPORT FileGenerator(FileGenerator const& other);
+	ECOLE_EXPORT FileGenerator(FileGenerator&& other) noexcept;
+	ECOLE_EXPORT auto operator=(FileGenerator const& other) -> FileGenerator&;
+	ECOLE_EXPORT auto operator=(FileGenerator&& other) noexcept -> FileGenerator&;
+	ECOLE_EXPORT ~FileGenerator() override;
 
 	ECOLE_EXPORT auto next() -> scip::Model override;
 	ECOLE_EXPORT void seed(Seed seed) override;
 	[[nodiscard]] ECOLE_EXPORT auto done() const -> bool override;
 
+	/** Save the random generator and the files not sampled yet, including files being loaded ahead. */
+	[[nodiscard]] ECOLE_EXPORT auto save_state() const -> std::string override;
+	/**
+	 * Restore the sampling state, loading the files that were prefetched again.
+	 *
+	 * @throw std::invalid_argument If the state was saved with a different number of files, or with prefetched files
+	 *  while this generator does not prefetch.
+	 */
+	ECOLE_EXPORT void load_state(std::string_view state) override;
+
 	[[nodiscard]] ECOLE_EXPORT auto get_parameters() const noexcept -> Parameters const& { return parameters; }
 
 private:
+	struct Prefetched {
+		std::filesystem::path path;
+		std::uintmax_t size;
+		std::future<scip::Model> model;
+	};
+
 	RandomGenerator rng;
 	Parameters parameters;
-	std::vector<std::filesystem::path> files;
+	std::vector<ManifestEntry> files;
 	std::size_t files_remaining;
+	/** Files are sorted by bucket, the end of each bucket in files, and its number of files not sampled yet. */
+	std::vector<std::size_t> bucket_ends;
+	std::vector<std::size_t> bucket_remaining;
+	std::size_t current_bucket = 0;
+	std::size_t batch_position = 0;
+	std::unique_ptr<utility::ThreadPool> thread_pool;
+	std::deque<Prefetched> prefetched;
+	std::uintmax_t prefetched_size = 0;
+	/** Shared with copies of the generator since the cache is thread safe. */
+	std::shared_ptr<InstanceCache> cache;
 
 	void reset_file_list();
+	/** Whether all files have been sampled, including those prefetched. */
+	[[nodiscard]] auto sampling_done() const -> bool;
+	/** Choose the next file according to the sampling mode. */
+	auto sample_file() -> ManifestEntry const&;
+	auto sample_bucketed_file() -> ManifestEntry const&;
+	[[nodiscard]] auto bucketed() const noexcept -> bool { return bucket_ends.size() > 1; }
+	[[nodiscard]] auto bucket_begin(std::size_t bucket) const noexcept -> std::size_t;
+	/** Sample files and start loading them until the prefetching limits are reached. */
+	void prefetch();
+	void load_ahead(ManifestEntry const& entry);
+	/** Read the file, or copy it from the cache, or read its snapshot. */
+	static auto load(InstanceCache* cache, std::filesystem::path const& snapshots, std::filesystem::path const& path)
+		-> scip::Model;
 };
 
 }  // namespace ecole::instance
@@ -0,0 +1,135 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "ecole/export.hpp"
+#include "ecole/instance/abstract.hpp"
+#include "ecole/instance/prefetching.hpp"
+#include "ecole/random.hpp"
+#include "ecole/scip/model.hpp"
+
+namespace ecole::instance {
+
+/** The outcome of presolving an instance and solving its root node, used to estimate its difficulty. */
+struct ECOLE_EXPORT ProbeStatistics {
+	/** Whether the instance was solved, to optimality or infeasibility, at the root node. */
+	bool solved = false;
+	/** The relative gap after the root node, infinite without primal solution. */
+	double gap = std::numeric_limits<double>::infinity();
+	std::size_t n_lp_iterations = 0;
+	/** The size of the presolved problem. */
+	std::size_t n_vars = 0;
+	std::size_t n_cons = 0;
+	/** The wall time of the probe, in seconds. */
+	double solving_time = 0.;
+
+	/** Presolve a copy of the model and solve its root node. */
+	ECOLE_EXPORT static auto probe(scip::Model const& model, double time_limit) -> ProbeStatistics;
+};
+
+/**
+ * The range of probe statistics of the instances kept by a FilteredGenerator.
+ *
+ * The default range only rejects instances solved at the root.
+ */
+struct ECOLE_EXPORT ProbeRange {
+	bool keep_solved = false;
+	double min_gap = 0.;
+	double max_gap = std::numeric_limits<double>::infinity();
+	std::size_t min_lp_iterations = 0;
+	std::size_t max_lp_iterations = std::numeric_limits<std::size_t>::max();
+	/**
+	 * The time limit of every probe, in seconds, after which the instance is judged from the statistics reached.
+	 *
+	 * Instances interrupted by the limit depend on the speed of the machine, so the limit is infinite by default.
+	 */
+	double time_limit = std::numeric_limits<double>::infinity();
+
+	[[nodiscard]] ECOLE_EXPORT auto contains(ProbeStatistics const& stats) const noexcept -> bool;
+};
+
+/**
+ * Generate instances of a given difficulty, by probing them on background threads.
+ *
+ * Every background thread runs its own generator, and probes every instance it generates, by presolving it and
+ * solving its root node, to only keep those whose statistics fall in the range.
+ * Instances that are solved at the root, or that are too hard, are discarded before reaching an environment, and
+ * their generation and probing overlap with the episodes on the kept instances.
+ * Instances are prefetched as in PrefetchingGenerator, so the sequence of instances only depends on the seed (as long
+ * as probes are not interrupted by their time limit).
+ */
+class ECOLE_EXPORT FilteredGenerator : public InstanceGenerator {
+public:
+	using Factory = PrefetchingGenerator::Factory;
+
+	/**
+	 * Create the generators and start generating and probing instances.
+	 *
+	 * @param make_generator Called once per thread to create the generator it runs.
+	 * @param range The range of statistics of the instances kept.
+	 * @param n_threads The number of background threads.
+	 * @param queue_size The maximum number of kept models prefetched by every thread.
+	 * @param max_rejections The number of consecutive instances a thread rejects before failing, as the range is
+	 *  likely out of reach of the generator.
+	 * @param rng The random generator used to seed the generators of every thread.
+	 * @throw std::invalid_argument If the number of threads, the size of the queues, or the maximum number of
+	 *  rejections is zero.
+	 */
+	ECOLE_EXPORT FilteredGenerator(
+		Factory const& make_generator,
+		ProbeRange range,
+		std::size_t n_threads,
+		std::size_t queue_size,
+		std::size_t max_rejections,
+		RandomGenerator rng);
+	ECOLE_EXPORT FilteredGenerator(
+		Factory const& make_generator,
+		ProbeRange range = {},
+		std::size_t n_threads = 2,
+		std::size_t queue_size = 2,
+		std::size_t max_rejections = 1000);
+
+	/**
+	 * Return the next kept model, waiting for it if it is not ready.
+	 *
+	 * @throw std::runtime_error If a thread rejected ``max_rejections`` consecutive instances.
+	 * @throw IteratorExhausted If all the generators are exhausted.
+	 */
+	ECOLE_EXPORT auto next() -> scip::Model override;
+
+	/** Discard prefetched models and restart all generators with seeds derived from the given one. */
+	ECOLE_EXPORT void seed(Seed seed) override;
+
+	[[nodiscard]] ECOLE_EXPORT auto done() const -> bool override;
+
+	/** @see PrefetchingGenerator::save_state */
+	[[nodiscard]] ECOLE_EXPORT auto save_state() const -> std::string override;
+	/** @see PrefetchingGenerator::load_state */
+	ECOLE_EXPORT void load_state(std::string_view state) override;
+
+	[[nodiscard]] auto range() const noexcept -> ProbeRange const& { return m_range; }
+	[[nodiscard]] auto n_threads() const noexcept -> std::size_t { return prefetcher.n_threads(); }
+
+	/** The number of instances probed since the creation of the generator, including prefetched ones. */
+	[[nodiscard]] auto n_probed() const noexcept -> std::size_t { return counters->n_probed; }
+	/** The number of instances rejected since the creation of the generator. */
+	[[nodiscard]] auto n_rejected() const noexcept -> std::size_t { return counters->n_rejected; }
+
+	/** Counters shared by the probing threads. */
+	struct Counters {
+		std::atomic<std::size_t> n_probed = 0;
+		std::atomic<std::size_t> n_rejected = 0;
+	};
+
+private:
+	ProbeRange m_range;
+	std::shared_ptr<Counters> counters;
+	PrefetchingGenerator prefetcher;
+};
+
+}  // namespace ecole::instance
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
+#include <string_view>
 
 #include "ecole/export.hpp"
 #include "ecole/instance/abstract.hpp"
@@ -17,6 +19,12 @@ public:
 		GraphType graph_type = GraphType::barabasi_albert;
 		double edge_probability = 0.25;  // NOLINT(readability-magic-numbers)
 		std::size_t affinity = 4;        // NOLINT(readability-magic-numbers)
+		/** Whether to sample Erdos Renyi graphs in linear time, otherwise reproduce graphs of previous versions. */
+		bool geometric_skip = true;
+		/** Whether to sample Barabasi Albert graphs in linear time, otherwise reproduce graphs of previous versions. */
+		bool repeated_nodes = true;
+		/** Whether to name variables and constraints, otherwise SCIP does not keep tables of names. */
+		bool named = true;
 	};
 
 	ECOLE_EXPORT static scip::Model generate_instance(Parameters parameters, RandomGenerator& rng);
@@ -27,6 +35,8 @@ public:
 
 	ECOLE_EXPORT scip::Model next() override;
 	ECOLE_EXPORT void seed(Seed seed) override;
+	[[nodiscard]] ECOLE_EXPORT auto save_state() const -> std::string override;
+	ECOLE_EXPORT void load_state(std::string_view state) override;
 	[[nodiscard]] ECOLE_EXPORT bool done() const override { return false; }
 
 	[[nodiscard]] ECOLE_EXPORT Parameters const& get_parameters() const noexcept { return parameters; }
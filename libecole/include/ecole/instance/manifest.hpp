@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <vector>
+
+#include "ecole/export.hpp"
+
+namespace ecole::instance {
+
+/** A problem file listed in a manifest, with what is known about it without reading it. */
+struct ECOLE_EXPORT ManifestEntry {
+	std::filesystem::path path;
+	/** The size of the file in bytes. */
+	std::uintmax_t size = 0;
+	/** The number of non zeros of the problem (see scip::Model::nnz), if known. */
+	std::optional<std::size_t> n_nonzeros = {};
+	/** The fingerprint of the problem (see scip::Model::fingerprint), if known. */
+	std::optional<std::uint64_t> fingerprint = {};
+	/** The expected cost of an episode on the problem, such as a solving time measured before, if known. */
+	std::optional<double> cost = {};
+};
+
+/**
+ * List the problem files of a directory, as FileGenerator does.
+ *
+ * A file is a regular file or a symlink to an existing file.
+ * Entries are sorted by path.
+ *
+ * @param directory The directory in which to look for files.
+ * @param recursive Whether sub-directories are searched as well.
+ * @param read_problems Whether to read the problems to also know their number of non zeros and fingerprint, which
+ *        is much slower than only listing the files.
+ * @param n_threads The number of threads reading problems, or zero to share Ecole's threads.
+ * @throw std::exception Any error raised when reading a problem, once all threads have stopped.
+ */
+ECOLE_EXPORT auto scan_manifest(
+	std::filesystem::path const& directory,
+	bool recursive = true,
+	bool read_problems = false,
+	std::size_t n_threads = 0) -> std::vector<ManifestEntry>;
+
+/**
+ * Write a manifest file, to be read instead of listing a directory.
+ *
+ * The manifest is a tab separated text file, with one line per problem file holding its path, size, number of non
+ * zeros, hexadecimal fingerprint, and cost, the last three being empty when unknown.
+ * Costs are typically added to a manifest by other tools, for instance from the solving times of a first run.
+ * Paths are written relative to the directory of the manifest, so that the manifest can be moved along with the files.
+ * Empty lines and lines starting with ``#`` are ignored when reading.
+ */
+ECOLE_EXPORT void write_manifest(std::filesystem::path const& manifest, std::vector<ManifestEntry> const& entries);
+
+/**
+ * Read a manifest file written by write_manifest.
+ *
+ * Relative paths are resolved from the directory of the manifest.
+ *
+ * @throw std::invalid_argument If the manifest cannot be opened or a line is not well formed.
+ */
+ECOLE_EXPORT auto read_manifest(std::filesystem::path const& manifest) -> std::vector<ManifestEntry>;
+
+}  // namespace ecole::instance
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "ecole/export.hpp"
+#include "ecole/instance/abstract.hpp"
+#include "ecole/random.hpp"
+#include "ecole/scip/model.hpp"
+
+namespace ecole::instance {
+
+/**
+ * Generate instances ahead of time on background threads.
+ *
+ * Every thread runs its own generator, created with the given factory and seeded from the random generator of the
+ * prefetching generator, and keeps a bounded queue of ready models.
+ * Models are returned by taking them from the threads in turn, so the sequence of instances only depends on the seed,
+ * not on the scheduling of the threads.
+ * Generators with finite instances, such as a FileGenerator, are iterated independently in every thread.
+ */
+class ECOLE_EXPORT PrefetchingGenerator : public InstanceGenerator {
+public:
+	using Factory = std::function<std::unique_ptr<InstanceGenerator>()>;
+
+	/**
+	 * Create the generators and start generating instances.
+	 *
+	 * @param make_generator Called once per thread to create the generator it runs.
+	 * @param n_threads The number of background threads.
+	 * @param queue_size The maximum number of models prefetched by every thread.
+	 * @param rng The random generator used to seed the generators of every thread.
+	 * @throw std::invalid_argument If the number of threads or the size of the queues is zero.
+	 */
+	ECOLE_EXPORT PrefetchingGenerator(
+		Factory const& make_generator,
+		std::size_t n_threads,
+		std::size_t queue_size,
+		RandomGenerator rng);
+	ECOLE_EXPORT
+	PrefetchingGenerator(Factory const& make_generator, std::size_t n_threads = 2, std::size_t queue_size = 2);
+	PrefetchingGenerator(PrefetchingGenerator const&) = delete;
+	PrefetchingGenerator(PrefetchingGenerator&&) = delete;
+	auto operator=(PrefetchingGenerator const&) -> PrefetchingGenerator& = delete;
+	auto operator=(PrefetchingGenerator&&) -> PrefetchingGenerator& = delete;
+
+	/** Stop generating and wait for the background threads. */
+	ECOLE_EXPORT ~PrefetchingGenerator() override;
+
+	/**
+	 * Return the next prefetched model, waiting for it if it is not ready.
+	 *
+	 * Errors raised by the generators are rethrown here.
+	 *
+	 * @throw IteratorExhausted If all the generators are exhausted.
+	 */
+	ECOLE_EXPORT auto next() -> scip::Model override;
+
+	/** Discard prefetched models and restart all generators with seeds derived from the given one. */
+	ECOLE_EXPORT void seed(Seed seed) override;
+
+	/** Whether all the generators are exhausted, waiting for them to know it. */
+	[[nodiscard]] ECOLE_EXPORT auto done() const -> bool override;
+
+	/**
+	 * Save the state of the generators from which the models not returned yet are generated.
+	 *
+	 * Waits for every thread to have prefetched a model, or to be exhausted.
+	 *
+	 * @throw std::logic_error If the generators do not support saving their state.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto save_state() const -> std::string override;
+
+	/**
+	 * Discard prefetched models and restart all generators from the saved state.
+	 *
+	 * @throw std::invalid_argument If the state was saved with a different number of threads.
+	 */
+	ECOLE_EXPORT void load_state(std::string_view state) override;
+
+	[[nodiscard]] auto n_threads() const noexcept -> std::size_t { return slots.size(); }
+
+private:
+	/** A generator running on a background thread, with the models it prefetched. */
+	struct Slot {
+		std::unique_ptr<InstanceGenerator> generator;
+		std::deque<scip::Model> ready;
+		/** The state of the generator before generating every ready model, or nothing if it cannot be saved. */
+		std::deque<std::optional<std::string>> ready_states;
+		/** The state of the generator before it got exhausted or failed. */
+		std::optional<std::string> last_state;
+		std::exception_ptr error;
+		bool exhausted = false;
+		std::thread worker;
+	};
+
+	RandomGenerator rng;
+	std::size_t queue_size;
+	std::vector<std::unique_ptr<Slot>> slots;
+	std::size_t next_slot = 0;
+	bool stopping = false;
+	mutable std::mutex mutex;
+	mutable std::condition_variable produced_cv;
+	std::condition_variable consumed_cv;
+
+	/** Seed the generators of every thread, and start the threads. */
+	void start();
+	void launch();
+	void stop();
+	void clear();
+	void produce(Slot& slot);
+};
+
+}  // namespace ecole::instance
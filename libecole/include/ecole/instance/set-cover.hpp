@@ -1,6 +1,8 @@
 #pragma once
 
 #include <cstddef>
+#include <string>
+#include <string_view>
 
 #include "ecole/export.hpp"
 #include "ecole/instance/abstract.hpp"
@@ -15,6 +17,8 @@ public:
 		std::size_t n_cols = 1000;  // NOLINT(readability-magic-numbers)
 		double density = 0.05;      // NOLINT(readability-magic-numbers)
 		int max_coef = 100;         // NOLINT(readability-magic-numbers)
+		/** Whether to name variables and constraints, otherwise SCIP does not keep tables of names. */
+		bool named = true;
 	};
 
 	ECOLE_EXPORT static scip::Model generate_instance(Parameters parameters, RandomGenerator& rng);
@@ -25,6 +29,8 @@ public:
 
 	ECOLE_EXPORT scip::Model next() override;
 	ECOLE_EXPORT void seed(Seed seed) override;
+	[[nodiscard]] ECOLE_EXPORT auto save_state() const -> std::string override;
+	ECOLE_EXPORT void load_state(std::string_view state) override;
 	[[nodiscard]] ECOLE_EXPORT bool done() const override { return false; }
 
 	[[nodiscard]] ECOLE_EXPORT Parameters const& get_parameters() const noexcept { return parameters; }
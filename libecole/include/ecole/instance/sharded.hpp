@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "ecole/export.hpp"
+#include "ecole/instance/abstract.hpp"
+#include "ecole/random.hpp"
+#include "ecole/scip/model.hpp"
+
+namespace ecole::instance {
+
+/**
+ * Generate the shard of a sequence of instances that belongs to one of many distributed processes.
+ *
+ * The wrapped generator is seeded before every instance, like in write_dataset: instance ``i`` of the whole sequence
+ * is generated from a seed derived from the random generator and ``i`` only.
+ * The process of a given rank generates instances ``rank``, ``rank + world_size``, and so on, without generating the
+ * others, so shards are disjoint and their union is the sequence generated with a world size of one.
+ * This is meant for random generators, such as a SetCoverGenerator, while files are sharded with the parameters of a
+ * FileGenerator.
+ */
+class ECOLE_EXPORT ShardedGenerator : public InstanceGenerator {
+public:
+	/**
+	 * Wrap a generator.
+	 *
+	 * @param generator The generator seeded before every instance.
+	 * @param rank The shard generated, such as the rank of a distributed process.
+	 * @param world_size The number of shards, such as the number of distributed processes.
+	 * @param rng The random generator from which the seeds of all instances are derived, which must be the same in all
+	 *  processes.
+	 * @throw std::invalid_argument If the generator is null, the world size is zero, or the rank is not smaller than
+	 *  the world size.
+	 */
+	ECOLE_EXPORT ShardedGenerator(
+		std::unique_ptr<InstanceGenerator> generator,
+		std::size_t rank,
+		std::size_t world_size,
+		RandomGenerator rng);
+	ECOLE_EXPORT ShardedGenerator(std::unique_ptr<InstanceGenerator> generator, std::size_t rank, std::size_t world_size);
+
+	ECOLE_EXPORT auto next() -> scip::Model override;
+
+	/** Restart the sequence of instances from a random generator seeded with the given seed. */
+	ECOLE_EXPORT void seed(Seed seed) override;
+
+	[[nodiscard]] ECOLE_EXPORT auto done() const -> bool override;
+
+	/** Save the random generator and the number of instances generated, but not the state of the wrapped generator. */
+	[[nodiscard]] ECOLE_EXPORT auto save_state() const -> std::string override;
+
+	/** @throw std::invalid_argument If the state was not saved by a ShardedGenerator. */
+	ECOLE_EXPORT void load_state(std::string_view state) override;
+
+	[[nodiscard]] auto rank() const noexcept -> std::size_t { return m_rank; }
+	[[nodiscard]] auto world_size() const noexcept -> std::size_t { return m_world_size; }
+
+private:
+	std::unique_ptr<InstanceGenerator> generator;
+	std::size_t m_rank;
+	std::size_t m_world_size;
+	RandomGenerator rng;
+	/** The number of instances of the shard generated since the last seeding. */
+	std::uint64_t n_generated = 0;
+};
+
+}  // namespace ecole::instance
@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+#include <scip/def.h>
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/export.hpp"
+#include "ecole/observation/abstract.hpp"
+
+namespace ecole::observation {
+
+/**
+ * Strong branching scores computed under a budget.
+ *
+ * Contrary to StrongBranchingScores, only a subset of the candidates, preselected by their pseudocost score, is
+ * evaluated and every strong branching LP can be limited in number of iterations.
+ * The result has the same layout as StrongBranchingScores, with NaN for variables that were not scored.
+ */
+class ECOLE_EXPORT BudgetedStrongBranchingScores {
+public:
+	/**
+	 * Create the observation function.
+	 *
+	 * @param pseudo_candidates Whether to score pseudo candidates rather than LP candidates.
+	 * @param max_candidates The number of candidates with highest pseudocost score to evaluate, or all if empty.
+	 * @param max_lp_iterations The iteration limit of each strong branching LP, or no limit if empty.
+	 * @param reuse_cache Whether to return the previous scores when the node and its LP have not changed.
+	 */
+	ECOLE_EXPORT BudgetedStrongBranchingScores(
+		bool pseudo_candidates = false,
+		std::optional<std::size_t> max_candidates = {},
+		std::optional<std::size_t> max_lp_iterations = {},
+		bool reuse_cache = false);
+
+	ECOLE_EXPORT auto before_reset(scip::Model& model) -> void;
+
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<xt::xtensor<double, 1>>;
+
+private:
+	bool pseudo_candidates;
+	std::optional<std::size_t> max_candidates;
+	std::optional<std::size_t> max_lp_iterations;
+	bool reuse_cache;
+
+	/** Scores of the last extraction, with the node and LP count they were computed for. */
+	struct Cache {
+		SCIP_Longint node_number = -1;
+		SCIP_Longint n_lps = -1;
+		xt::xtensor<double, 1> scores;
+	} cache;
+};
+
+/** Strong branching scores, some of which are replaced by a cheaper estimate. */
+struct ECOLE_EXPORT ReliabilityBranchingScoresObs {
+	/** The score of every variable, NaN for variables that are not candidates. */
+	xt::xtensor<double, 1> scores;
+	/** Whether the score was computed by strong branching, rather than estimated from pseudocosts. */
+	xt::xtensor<bool, 1> exact;
+};
+
+/**
+ * Strong branching scores, skipping the LPs of candidates with reliable pseudocosts.
+ *
+ * In the spirit of SCIP reliability pseudocost branching (relpscost), strong branching is only run on candidates
+ * whose pseudocosts have been updated less than ``reliability_threshold`` times in either direction.
+ * Other candidates use their pseudocost score.
+ * Entries scored by strong branching are marked as exact.
+ */
+class ECOLE_EXPORT ReliabilityBranchingScores {
+public:
+	/**
+	 * Create the observation function.
+	 *
+	 * @param pseudo_candidates Whether to score pseudo candidates rather than LP candidates.
+	 * @param reliability_threshold The number of pseudocost updates after which a candidate is not strong branched.
+	 * @param max_lp_iterations The iteration limit of each strong branching LP, or no limit if empty.
+	 */
+	ECOLE_EXPORT ReliabilityBranchingScores(
+		bool pseudo_candidates = false,
+		SCIP_Real reliability_threshold = 5.,
+		std::optional<std::size_t> max_lp_iterations = {});
+
+	auto before_reset(scip::Model& /*model*/) -> void {}
+
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<ReliabilityBranchingScoresObs>;
+
+private:
+	bool pseudo_candidates;
+	SCIP_Real reliability_threshold;
+	std::optional<std::size_t> max_lp_iterations;
+};
+
+}  // namespace ecole::observation
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/export.hpp"
+#include "ecole/observation/abstract.hpp"
+
+namespace ecole::observation {
+
+/** Strong branching scores, along with the children LPs that they are computed from. */
+struct ECOLE_EXPORT DetailedStrongBranchingScoresObs {
+	/** The score of every variable, NaN for variables that were not evaluated. */
+	xt::xtensor<double, 1> scores;
+	/** The dual bound improvement of the down child of every variable, NaN for variables that were not evaluated. */
+	xt::xtensor<double, 1> down_gains;
+	/** The dual bound improvement of the up child of every variable, NaN for variables that were not evaluated. */
+	xt::xtensor<double, 1> up_gains;
+	/** The number of simplex iterations of both children of every variable, zero for variables not evaluated. */
+	xt::xtensor<std::size_t, 1> n_lp_iterations;
+};
+
+/**
+ * Strong branching scores computed by Ecole with the SCIP strong branching API.
+ *
+ * Contrary to StrongBranchingScores, the vanillafullstrong branching rule is not called.
+ * Instead the children LPs of every candidate are solved directly, each warm started from the node LP basis that SCIP
+ * stores once for all candidates, and the gains and number of iterations of every candidate are reported.
+ * Strong branching results are stored in the columns as if done by a branching rule, which SCIP can then reuse on the
+ * same node.
+ */
+class ECOLE_EXPORT DetailedStrongBranchingScores {
+public:
+	/**
+	 * Create the observation function.
+	 *
+	 * @param pseudo_candidates Whether to score pseudo candidates rather than LP candidates.
+	 * @param max_lp_iterations The iteration limit of each children LP, or no limit if empty.
+	 */
+	ECOLE_EXPORT DetailedStrongBranchingScores(
+		bool pseudo_candidates = false,
+		std::optional<std::size_t> max_lp_iterations = {});
+
+	auto before_reset(scip::Model& /*model*/) -> void {}
+
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<DetailedStrongBranchingScoresObs>;
+
+private:
+	bool pseudo_candidates;
+	std::optional<std::size_t> max_lp_iterations;
+};
+
+}  // namespace ecole::observation
@@ -1,16 +1,22 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
 #include <optional>
+#include <unordered_map>
 
 #include <xtensor/xtensor.hpp>
 
 #include "ecole/export.hpp"
 #include "ecole/observation/abstract.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 namespace ecole::observation {
 
 struct ECOLE_EXPORT Hutter2011Obs {
-	static inline std::size_t constexpr n_features = 33;
+	static inline std::size_t constexpr n_features = 35;
 
 	enum struct ECOLE_EXPORT Features : std::size_t {
 		/* Problem size features */
@@ -33,9 +39,8 @@ struct ECOLE_EXPORT Hutter2011Obs {
 		node_degree_std,
 		node_degree_25q,
 		node_degree_75q,
-		// Not computed because too expensive
-		// clustering_coef_mean,
-		// clustering_coef_std,
+		clustering_coef_mean,
+		clustering_coef_std,
 		edge_density,
 		/* LP features */
 		lp_slack_mean,
@@ -69,8 +74,59 @@ struct ECOLE_EXPORT Hutter2011Obs {
 
 class ECOLE_EXPORT Hutter2011 {
 public:
+	/** Reading the constraints uses the buffer memory of SCIP, as in MilpBipartite. */
+	static constexpr bool mutates_model = true;
+
+	/**
+	 * Create the observation function.
+	 *
+	 * @param cache_features Whether to remember the features of instances, so that they are returned without being
+	 *        recomputed, nor the constraints read, when the same instance (according to Model::exact_fingerprint) is
+	 *        seen again.
+	 * @param n_clustering_samples The number of pairs of neighbors sampled per variable to estimate clustering
+	 *        coefficients, all pairs being used when there are fewer.
+	 * @param n_threads The number of threads reading the constraints, or zero to share Ecole's threads.
+	 *        The observation does not depend on the number of threads.
+	 * @param reuse_root_lp Whether to read the LP based features from the root LP of models whose root LP is solved,
+	 *        rather than solving the LP relaxation of a copy, and thereby to also extract during solving.
+	 *        The root LP is that of the presolved problem with cuts, so the features differ from those of the copy.
+	 * @param max_cached_instances The number of instances whose features are cached, the least recently used being
+	 *        dropped first.
+	 */
+	ECOLE_EXPORT Hutter2011(
+		bool cache_features = false,
+		std::size_t n_clustering_samples = 64,
+		std::size_t n_threads = 1,
+		bool reuse_root_lp = false,
+		std::size_t max_cached_instances = 1024);
+
 	auto before_reset(scip::Model& /*model*/) -> void {}
 	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<Hutter2011Obs>;
+
+	/**
+	 * Compute the features of an MPS file without loading it in SCIP.
+	 *
+	 * The file is read once line by line, which is much faster than creating a Model for triaging large collections
+	 * of instances.
+	 * The LP based features, which require solving the LP relaxation, are NaN.
+	 * Only the free MPS format, without quadratic, SOS, or indicator sections, is supported.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto extract_from_file(std::filesystem::path const& filename) const -> Hutter2011Obs;
+
+private:
+	bool cache_features;
+	std::size_t n_clustering_samples;
+	bool reuse_root_lp;
+	std::size_t max_cached_instances;
+	std::shared_ptr<utility::ThreadPool> thread_pool;
+
+	struct CacheEntry {
+		xt::xtensor<double, 1> features;
+		std::uint64_t last_use = 0;
+	};
+	/** Features by instance fingerprint, with the clock of their last use to evict the least recently used. */
+	std::unordered_map<std::uint64_t, CacheEntry> cache;
+	std::uint64_t cache_clock = 0;
 };
 
 }  // namespace ecole::observation
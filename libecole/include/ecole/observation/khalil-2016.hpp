@@ -1,12 +1,18 @@
 #pragma once
 
+#include <chrono>
 #include <cstddef>
+#include <memory>
 #include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
 
 #include <xtensor/xtensor.hpp>
 
 #include "ecole/export.hpp"
 #include "ecole/observation/abstract.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 namespace ecole::observation {
 
@@ -104,12 +110,64 @@ struct ECOLE_EXPORT Khalil2016Obs {
 		active_coef_weight4_max,
 	};
 
+	/**
+	 * Features of every variable, or only of the candidates when extracted with ``candidates_only``.
+	 *
+	 * Columns are all the Features, or only the selected ones in the order they were given to Khalil2016.
+	 */
 	xt::xtensor<double, 2> features;
+	/** The problem index (``SCIPvarGetProbindex``) of the branching candidates, in the order they are extracted. */
+	xt::xtensor<std::size_t, 1> candidates;
+	/**
+	 * Whether every column was left NaN because the time budget of the extraction ran out before its group of features
+	 * was computed for all candidates.
+	 */
+	xt::xtensor<bool, 1> timed_out;
 };
 
+/** The features normalized by data::NormalizedFunction. */
+inline auto normalized_features(Khalil2016Obs& obs) {
+	return std::tie(obs.features);
+}
+
 class ECOLE_EXPORT Khalil2016 {
 public:
-	ECOLE_EXPORT Khalil2016(bool pseudo_candidates = false) noexcept;
+	/**
+	 * Extraction catches row events, and SCIP caches row activities and LP values when they are read, so it must not
+	 * run concurrently with other functions (see trait::mutates_model).
+	 */
+	static constexpr bool mutates_model = true;
+	/** Active rows are read from the LP view shared with other functions (see trait::uses_lp_view). */
+	static constexpr bool uses_lp_view = true;
+
+	/**
+	 * Create the observation function.
+	 *
+	 * @param pseudo_candidates Extract features for pseudo branching candidates rather than LP branching candidates.
+	 * @param n_threads The number of threads computing the features of candidates, or zero to share Ecole's threads.
+	 *        Candidates are partitioned among threads, and every candidate writes its own row, so the observation does
+	 *        not depend on the number of threads.
+	 * @param candidates_only Only allocate a row per branching candidate, in the order of Khalil2016Obs::candidates,
+	 *        rather than a row per variable.
+	 * @param features The features to extract, as columns in the given order, or all of them when empty.
+	 *        Groups of dynamic features where no feature is selected are not computed, such as the statistics of
+	 *        active constraint coefficients, which need a pass over the whole LP.
+	 * @param incremental Track changes of the LP rows with SCIP events, so that the constraint degree and coefficient
+	 *        to right hand side ratio statistics are only recomputed for the columns of rows that changed since the
+	 *        previous extraction.
+	 * @param time_budget The wall time allowed per extraction, from its start, or zero for no limit.
+	 *        Groups of dynamic features are then computed one after the other, from the cheapest (slack, ceil
+	 *        distances, and pseudocosts) to the most expensive (active constraint coefficients), and the groups that
+	 *        are not complete by the deadline are left NaN, and marked in Khalil2016Obs::timed_out.
+	 *        Static features are always extracted, and the time to compute them at the root node counts in the budget.
+	 */
+	ECOLE_EXPORT Khalil2016(
+		bool pseudo_candidates = false,
+		std::size_t n_threads = 1,
+		bool candidates_only = false,
+		std::vector<Khalil2016Obs::Features> features = {},
+		bool incremental = false,
+		std::chrono::microseconds time_budget = std::chrono::microseconds::zero());
 
 	ECOLE_EXPORT auto before_reset(scip::Model& model) -> void;
 
@@ -117,7 +175,15 @@ public:
 
 private:
 	bool pseudo_candidates;
+	bool candidates_only;
+	bool incremental;
+	std::chrono::microseconds time_budget;
+	std::string eventhdlr_name;
+	/** The index of the selected features. */
+	std::vector<std::size_t> feature_indices;
 	xt::xtensor<double, 2> static_features;
+	/** Shared so that the function remains copyable, null when extracting sequentially. */
+	std::shared_ptr<utility::ThreadPool> thread_pool;
 };
 
 }  // namespace ecole::observation
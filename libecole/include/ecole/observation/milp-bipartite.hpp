@@ -1,19 +1,23 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
 #include <optional>
+#include <vector>
 
 #include <xtensor/xtensor.hpp>
 
 #include "ecole/export.hpp"
 #include "ecole/observation/abstract.hpp"
 #include "ecole/utility/sparse-matrix.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 namespace ecole::observation {
 
-class ECOLE_EXPORT MilpBipartiteObs {
-public:
-	using value_type = double;
-
+/** Features of the MilpBipartite observations, independent of their value type. */
+struct ECOLE_EXPORT MilpBipartiteFeatures {
 	static inline std::size_t constexpr n_variable_features = 9;
 	enum struct ECOLE_EXPORT VariableFeatures : std::size_t {
 		objective = 0,
@@ -30,22 +34,113 @@ public:
 	enum struct ECOLE_EXPORT ConstraintFeatures : std::size_t {
 		bias = 0,
 	};
+};
+
+/**
+ * Bipartite graph observation of the MILP.
+ *
+ * @tparam Value The floating point type of the features.
+ */
+template <typename Value> struct ECOLE_EXPORT BasicMilpBipartiteObs : MilpBipartiteFeatures {
+	using value_type = Value;
 
 	xt::xtensor<value_type, 2> variable_features;
 	xt::xtensor<value_type, 2> constraint_features;
+	/** The edges, left empty when extracted in the CSR format. */
 	utility::coo_matrix<value_type> edge_features;
+	/** The edges sorted by constraint, in the CSR format, left empty unless requested. */
+	utility::csr_matrix<value_type, std::int32_t> edge_features_csr;
+	/** The edges sorted by variable, in the CSC format as returned by coo_matrix::to_csc, left empty unless requested. */
+	utility::csr_matrix<value_type, std::int32_t> edge_features_csc;
 };
 
-class ECOLE_EXPORT MilpBipartite {
+using MilpBipartiteObs = BasicMilpBipartiteObs<double>;
+using MilpBipartiteObsFloat32 = BasicMilpBipartiteObs<float>;
+
+/**
+ * Observation function extracting the bipartite graph of the MILP during presolving.
+ *
+ * @tparam Value The floating point type of the features extracted.
+ */
+template <typename Value> class ECOLE_EXPORT BasicMilpBipartite {
 public:
-	MilpBipartite(bool normalize_ = false) : normalize{normalize_} {}
+	/**
+	 * Re-expressing constraints on active variables uses the buffer memory of SCIP, and SCIPgetObjNorm caches its
+	 * value in the LP, so extraction must not run concurrently with other functions.
+	 */
+	static constexpr bool mutates_model = true;
+
+	using Observation = BasicMilpBipartiteObs<Value>;
+
+	/**
+	 * Create the observation function.
+	 *
+	 * @param normalize Whether to normalize the features of constraints and variables.
+	 * @param n_threads The number of threads reading the constraints, or zero to share Ecole's threads.
+	 *        The observation does not depend on the number of threads.
+	 * @param csr_edges Extract edges in ``edge_features_csr`` instead of the coordinate format.
+	 * @param csc_edges Also extract edges sorted by variable in ``edge_features_csc``.
+	 *        Compressed edges have 32 bits indices and are sorted by counting sort, on the threads reading the
+	 *        constraints.
+	 * @throw std::invalid_argument When extracting, if there are too many edges for 32 bits indices.
+	 */
+	ECOLE_EXPORT BasicMilpBipartite(
+		bool normalize = false,
+		std::size_t n_threads = 1,
+		bool csr_edges = false,
+		bool csc_edges = false);
 
 	auto before_reset(scip::Model& /*model*/) -> void {}
 
-	ECOLE_EXPORT auto extract(scip::Model& model, bool done) const -> std::optional<MilpBipartiteObs>;
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) const -> std::optional<Observation>;
 
 private:
 	bool normalize = false;
+	bool use_csr_edges = false;
+	bool use_csc_edges = false;
+	std::shared_ptr<utility::ThreadPool> thread_pool;
 };
 
+using MilpBipartite = BasicMilpBipartite<double>;
+using MilpBipartiteFloat32 = BasicMilpBipartite<float>;
+
+/**
+ * Extract the bipartite graph of a problem, outside of any environment.
+ *
+ * Meant for instance level features, for instance for algorithm selection.
+ * When presolving, a copy of the original problem is presolved, leaving the model unchanged.
+ *
+ * @param model The problem, in the problem or presolving stages.
+ * @param presolve Whether to extract the graph of the presolved problem rather than the original one.
+ * @param normalize Whether to normalize the features of constraints and variables.
+ * @return The observation, or nothing if the problem is solved by presolving.
+ */
+template <typename Value>
+ECOLE_EXPORT auto extract_milp_bipartite(scip::Model& model, bool presolve = false, bool normalize = false)
+	-> std::optional<BasicMilpBipartiteObs<Value>>;
+
+/**
+ * Read a problem file and extract its bipartite graph.
+ *
+ * The problem is read with the minimal plugins needed (see scip::PluginProfile), presolved with the presolving of the
+ * constraint handlers only if requested, and freed after extraction.
+ */
+template <typename Value>
+ECOLE_EXPORT auto
+extract_milp_bipartite(std::filesystem::path const& filename, bool presolve = false, bool normalize = false)
+	-> std::optional<BasicMilpBipartiteObs<Value>>;
+
+/**
+ * Extract the bipartite graph of many problem files in parallel, in the same order.
+ *
+ * @param n_threads The number of threads reading files, or zero to share Ecole's threads.
+ * @throw std::exception The first error raised while reading or extracting a file, after all files are processed.
+ */
+template <typename Value>
+ECOLE_EXPORT auto extract_milp_bipartite(
+	std::vector<std::filesystem::path> const& filenames,
+	bool presolve = false,
+	bool normalize = false,
+	std::size_t n_threads = 0) -> std::vector<std::optional<BasicMilpBipartiteObs<Value>>>;
+
 }  // namespace ecole::observation
@@ -1,18 +1,25 @@
 #pragma once
 
+#include <cstddef>
+#include <cstdint>
+#include <memory>
 #include <optional>
+#include <string>
+#include <tuple>
+#include <vector>
 
+#include <nonstd/span.hpp>
 #include <xtensor/xtensor.hpp>
 
 #include "ecole/export.hpp"
 #include "ecole/observation/abstract.hpp"
 #include "ecole/utility/sparse-matrix.hpp"
+#include "ecole/utility/tensor-view.hpp"
 
 namespace ecole::observation {
 
-struct ECOLE_EXPORT NodeBipartiteObs {
-	using value_type = double;
-
+/** Features of the NodeBipartite observations, independent of their value type. */
+struct ECOLE_EXPORT NodeBipartiteFeatures {
 	static inline std::size_t constexpr n_static_variable_features = 5;
 	static inline std::size_t constexpr n_dynamic_variable_features = 15;
 	static inline std::size_t constexpr n_variable_features = n_static_variable_features + n_dynamic_variable_features;
@@ -55,24 +62,342 @@ struct ECOLE_EXPORT NodeBipartiteObs {
 		dual_solution_value,
 		scaled_age,
 	};
+};
+
+/**
+ * Bipartite graph observation for branch-and-bound nodes.
+ *
+ * @tparam Value The floating point type of the features.
+ */
+template <typename Value> struct ECOLE_EXPORT BasicNodeBipartiteObs : NodeBipartiteFeatures {
+	using value_type = Value;
 
 	xt::xtensor<value_type, 2> variable_features;
 	xt::xtensor<value_type, 2> row_features;
+	/** The edges, left empty when extracted in the CSR format. */
 	utility::coo_matrix<value_type> edge_features;
+	/** The edges in the CSR format, left empty unless requested. */
+	utility::csr_matrix<value_type, std::int32_t> edge_features_csr;
+	/**
+	 * The edges sorted by variable, in the CSC format, left empty unless requested.
+	 *
+	 * As with coo_matrix::to_csc, this is the CSR format of the transposed matrix: the edges of variable ``j`` are in
+	 * ``[row_pointers[j], row_pointers[j + 1])``, and ``column_indices`` hold their row.
+	 */
+	utility::csr_matrix<value_type, std::int32_t> edge_features_csc;
+	/** The original index of every variable of a subgraph around branching candidates, left empty otherwise. */
+	xt::xtensor<std::size_t, 1> variable_ids;
+	/** The original index of every row of a subgraph around branching candidates, left empty otherwise. */
+	xt::xtensor<std::size_t, 1> row_ids;
+};
+
+using NodeBipartiteObs = BasicNodeBipartiteObs<double>;
+using NodeBipartiteObsFloat32 = BasicNodeBipartiteObs<float>;
+
+/** The features normalized by data::NormalizedFunction, leaving edges as they are. */
+template <typename Value> auto normalized_features(BasicNodeBipartiteObs<Value>& obs) {
+	return std::tie(obs.variable_features, obs.row_features);
+}
+
+/**
+ * Read only view of a bipartite graph observation stored elsewhere, such as in a memory mapped file.
+ *
+ * Members have the same names, shapes, and layout as in BasicNodeBipartiteObs.
+ *
+ * @tparam Value The floating point type of the features.
+ */
+template <typename Value> struct ECOLE_EXPORT BasicNodeBipartiteObsView : NodeBipartiteFeatures {
+	using value_type = Value;
+
+	utility::tensor_view<value_type, 2> variable_features;
+	utility::tensor_view<value_type, 2> row_features;
+	utility::coo_matrix_view<value_type> edge_features;
+	utility::csr_matrix_view<value_type, std::int32_t> edge_features_csr;
 };
 
-class ECOLE_EXPORT NodeBipartite {
+using NodeBipartiteObsView = BasicNodeBipartiteObsView<double>;
+using NodeBipartiteObsViewFloat32 = BasicNodeBipartiteObsView<float>;
+
+/**
+ * Observation function extracting bipartite graphs on branch-and-bound nodes.
+ *
+ * Features are computed by SCIP in double precision and converted upon being written in the observation, so that a
+ * single precision observation can be extracted without an intermediate double precision one.
+ *
+ * @tparam Value The floating point type of the features extracted.
+ */
+template <typename Value> class ECOLE_EXPORT BasicNodeBipartite {
 public:
-	NodeBipartite(bool cache = false) : use_cache{cache} {}
+	/**
+	 * Extraction catches LP events, and calls SCIP getters that cache their value in the LP, such as SCIPgetObjNorm
+	 * and SCIPgetVarRedcost, so it must not run concurrently with other functions.
+	 */
+	static constexpr bool mutates_model = true;
+	/** Dynamic column and row features are read from the LP view. */
+	static constexpr bool uses_lp_view = true;
+
+	using Observation = BasicNodeBipartiteObs<Value>;
+
+	/**
+	 * Create the observation function.
+	 *
+	 * @param cache Reuse static variable features within an episode, and static row features across nodes for every LP
+	 *        row, identified by its SCIP index, so that only new cuts or modified rows get them recomputed.
+	 *        This is valid with cutting planes.
+	 *        Static variable features are not reused across episodes, since reading the objective and type of every
+	 *        variable costs less than recognizing the instance and its variable ordering.
+	 * @param incremental Track changes of the LP rows with SCIP events, so that static row features and edges are only
+	 *        recomputed for the rows that changed since the previous extraction.
+	 *        This is valid with cutting planes and takes precedence over ``cache``.
+	 * @param csr_edges Extract edges in the CSR format, with 32 bits indices, instead of the coordinate format.
+	 * @param candidate_hops Restrict the graph to the subgraph induced by the LP branching candidates and the rows
+	 *        they appear in (1), and further to the other variables of these rows (2).
+	 *        The default (0) extracts the whole graph.
+	 * @param csc_edges Also extract edges sorted by variable in ``edge_features_csc``, with 32 bits indices, so that
+	 *        messages from rows to variables can be aggregated per segment without sorting the edges.
+	 *        They are sorted from the other format in linear time.
+	 * @throw std::invalid_argument If candidate_hops is more than 2.
+	 */
+	ECOLE_EXPORT BasicNodeBipartite(
+		bool cache = false,
+		bool incremental = false,
+		bool csr_edges = false,
+		std::size_t candidate_hops = 0,
+		bool csc_edges = false);
 
 	ECOLE_EXPORT auto before_reset(scip::Model& model) -> void;
 
-	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<NodeBipartiteObs>;
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<Observation>;
+
+	/**
+	 * Extract the observation into an existing one, reusing its memory.
+	 *
+	 * Tensors are only reallocated when their number of elements changes, so repeatedly extracting into the same
+	 * observation avoids allocations across steps.
+	 *
+	 * @return Whether an observation was extracted, which is not the case in terminal states.
+	 */
+	ECOLE_EXPORT auto extract_into(scip::Model& model, bool done, Observation& obs) -> bool;
 
 private:
-	NodeBipartiteObs the_cache;
+	/** Static features and edges of LP rows by row index. */
+	struct RowCache;
+
+	Observation the_cache;
+	std::shared_ptr<RowCache> row_cache;
+	std::string eventhdlr_name;
 	bool use_cache = false;
+	bool use_incremental = false;
+	bool use_csr_edges = false;
+	bool use_csc_edges = false;
 	bool cache_computed = false;
+	std::size_t n_candidate_hops = 0;
+};
+
+using NodeBipartite = BasicNodeBipartite<double>;
+using NodeBipartiteFloat32 = BasicNodeBipartite<float>;
+
+/**
+ * Changes of a bipartite graph observation from the previous one, as extracted by BasicDeltaNodeBipartite.
+ *
+ * Variables and rows are identified by their position in the observation, so rows beyond ``n_rows`` are removed and
+ * rows beyond the previous number of rows are added, with their features and edges in the delta.
+ *
+ * @tparam Value The floating point type of the features.
+ */
+template <typename Value> struct ECOLE_EXPORT BasicNodeBipartiteDelta {
+	using value_type = Value;
+
+	/** The number of variables of the observation once the delta is applied. */
+	std::size_t n_variables = 0;
+	/** The number of rows of the observation once the delta is applied. */
+	std::size_t n_rows = 0;
+	/** The variables whose features changed, in increasing order. */
+	xt::xtensor<std::size_t, 1> variable_indices;
+	/** The new features of every variable of ``variable_indices``. */
+	xt::xtensor<value_type, 2> variable_features;
+	/** The rows whose features changed, in increasing order. */
+	xt::xtensor<std::size_t, 1> row_indices;
+	/** The new features of every row of ``row_indices``. */
+	xt::xtensor<value_type, 2> row_features;
+	/** The rows whose edges changed, in increasing order. */
+	xt::xtensor<std::size_t, 1> edge_row_indices;
+	/** The new edges of the rows of ``edge_row_indices``, with one row of the matrix per changed row. */
+	utility::csr_matrix<value_type, std::int32_t> edge_features;
 };
 
+using NodeBipartiteDelta = BasicNodeBipartiteDelta<double>;
+using NodeBipartiteDeltaFloat32 = BasicNodeBipartiteDelta<float>;
+
+/**
+ * Observation function extracting the changes of the bipartite graph since the previous extraction.
+ *
+ * Consecutive nodes of a dive share most of their LP, so deltas are much smaller than observations, which matters
+ * when storing them or sending them over the network.
+ * The first delta of an episode is relative to an empty observation.
+ * Observations are recovered by applying the deltas in order with apply_delta.
+ *
+ * @tparam Value The floating point type of the features extracted.
+ */
+template <typename Value> class ECOLE_EXPORT BasicDeltaNodeBipartite {
+public:
+	static constexpr bool mutates_model = BasicNodeBipartite<Value>::mutates_model;
+	static constexpr bool uses_lp_view = BasicNodeBipartite<Value>::uses_lp_view;
+
+	using Observation = BasicNodeBipartiteDelta<Value>;
+
+	/**
+	 * Create the observation function.
+	 *
+	 * @see BasicNodeBipartite::BasicNodeBipartite
+	 */
+	ECOLE_EXPORT BasicDeltaNodeBipartite(bool cache = false, bool incremental = false);
+
+	ECOLE_EXPORT auto before_reset(scip::Model& model) -> void;
+
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<Observation>;
+
+private:
+	BasicNodeBipartite<Value> node_bipartite;
+	BasicNodeBipartiteObs<Value> previous_obs;
+	BasicNodeBipartiteObs<Value> current_obs;
+};
+
+using DeltaNodeBipartite = BasicDeltaNodeBipartite<double>;
+using DeltaNodeBipartiteFloat32 = BasicDeltaNodeBipartite<float>;
+
+/**
+ * Apply a delta to the observation it was extracted after.
+ *
+ * Edges are written in the CSR format only, in ``edge_features_csr``, as with ``NodeBipartite(csr_edges=true)``.
+ *
+ * @throw std::invalid_argument If the shapes of the delta do not match the observation.
+ */
+template <typename Value>
+ECOLE_EXPORT void apply_delta(BasicNodeBipartiteObs<Value>& obs, BasicNodeBipartiteDelta<Value> const& delta);
+
+/**
+ * Bipartite graph observation with the categorical variable features stored as small integer codes.
+ *
+ * The four one hot encoded variable types and basis statuses are each stored as a single code, namely the position of
+ * the one in their encoding, and the boolean features as zero or one, in a separate tensor from the continuous
+ * features.
+ * Row features and edges are those of BasicNodeBipartiteObs.
+ *
+ * @tparam Value The floating point type of the continuous features.
+ */
+template <typename Value> struct ECOLE_EXPORT BasicNodeBipartiteCompactObs {
+	using value_type = Value;
+	using RowFeatures = NodeBipartiteFeatures::RowFeatures;
+
+	static inline std::size_t constexpr n_continuous_variable_features = 8;
+	enum struct ECOLE_EXPORT ContinuousVariableFeatures : std::size_t {
+		objective = 0,
+		normed_reduced_cost,
+		solution_value,
+		solution_frac,
+		scaled_age,
+		incumbent_value,
+		average_incumbent_value,
+		index,
+	};
+
+	static inline std::size_t constexpr n_categorical_variable_features = 6;
+	enum struct ECOLE_EXPORT CategoricalVariableFeatures : std::size_t {
+		type = 0,  // Binary, integer, implicit integer, or continuous
+		has_lower_bound,
+		has_upper_bound,
+		is_solution_at_lower_bound,
+		is_solution_at_upper_bound,
+		basis_status,  // Lower, basic, upper, or zero
+	};
+
+	xt::xtensor<value_type, 2> variable_features;
+	xt::xtensor<std::uint8_t, 2> variable_categories;
+	xt::xtensor<value_type, 2> row_features;
+	/** The edges, left empty when extracted in the CSR format. */
+	utility::coo_matrix<value_type> edge_features;
+	/** The edges in the CSR format, left empty unless requested. */
+	utility::csr_matrix<value_type, std::int32_t> edge_features_csr;
+};
+
+using NodeBipartiteCompactObs = BasicNodeBipartiteCompactObs<double>;
+using NodeBipartiteCompactObsFloat32 = BasicNodeBipartiteCompactObs<float>;
+
+/**
+ * Observation function extracting bipartite graphs with categorical variable features stored as codes.
+ *
+ * A single precision observation takes about a quarter of the memory per variable of a NodeBipartiteObs, which
+ * matters when storing millions of nodes, such as in replay buffers.
+ *
+ * @tparam Value The floating point type of the continuous features extracted.
+ */
+template <typename Value> class ECOLE_EXPORT BasicCompactNodeBipartite {
+public:
+	static constexpr bool mutates_model = BasicNodeBipartite<Value>::mutates_model;
+	static constexpr bool uses_lp_view = BasicNodeBipartite<Value>::uses_lp_view;
+
+	using Observation = BasicNodeBipartiteCompactObs<Value>;
+
+	/**
+	 * Create the observation function.
+	 *
+	 * @see BasicNodeBipartite::BasicNodeBipartite
+	 */
+	ECOLE_EXPORT BasicCompactNodeBipartite(bool cache = false, bool incremental = false, bool csr_edges = false);
+
+	ECOLE_EXPORT auto before_reset(scip::Model& model) -> void;
+
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<Observation>;
+
+private:
+	BasicNodeBipartite<Value> node_bipartite;
+	BasicNodeBipartiteObs<Value> full_obs;
+};
+
+using CompactNodeBipartite = BasicCompactNodeBipartite<double>;
+using CompactNodeBipartiteFloat32 = BasicCompactNodeBipartite<float>;
+
+/**
+ * Many bipartite graph observations concatenated into a single graph, as batched inputs of graph neural networks.
+ *
+ * @tparam Value The floating point type of the features.
+ */
+template <typename Value> struct ECOLE_EXPORT BasicNodeBipartiteBatch {
+	using value_type = Value;
+
+	xt::xtensor<value_type, 2> variable_features;
+	xt::xtensor<value_type, 2> row_features;
+	/** The edges of all graphs, with indices shifted to the concatenated rows and variables. */
+	utility::coo_matrix<value_type> edge_features;
+	/** The index of the observation of every variable. */
+	xt::xtensor<std::size_t, 1> variable_batch;
+	/** The index of the observation of every row. */
+	xt::xtensor<std::size_t, 1> row_batch;
+	/** The variables of observation ``i`` are in ``[variable_offsets[i], variable_offsets[i+1])``. */
+	xt::xtensor<std::size_t, 1> variable_offsets;
+	xt::xtensor<std::size_t, 1> row_offsets;
+	xt::xtensor<std::size_t, 1> edge_offsets;
+};
+
+using NodeBipartiteBatch = BasicNodeBipartiteBatch<double>;
+using NodeBipartiteBatchFloat32 = BasicNodeBipartiteBatch<float>;
+
+/**
+ * Concatenate bipartite graph observations into a single graph.
+ *
+ * Every tensor of the batch is allocated once with its final size, and edges in either format are written in the
+ * coordinate format.
+ *
+ * @param observations The observations to concatenate, where null pointers (such as terminal states) have empty
+ *        ranges in the batch.
+ */
+template <typename Value>
+ECOLE_EXPORT auto collate(nonstd::span<BasicNodeBipartiteObs<Value> const* const> observations)
+	-> BasicNodeBipartiteBatch<Value>;
+
+template <typename Value>
+ECOLE_EXPORT auto collate(std::vector<BasicNodeBipartiteObs<Value>> const& observations)
+	-> BasicNodeBipartiteBatch<Value>;
+
 }  // namespace ecole::observation
@@ -1,19 +1,74 @@
 #pragma once
 
+#include <cstddef>
 #include <optional>
+#include <vector>
 
+#include <scip/scip.h>
 #include <xtensor/xtensor.hpp>
 
 #include "ecole/export.hpp"
 #include "ecole/observation/abstract.hpp"
 
+namespace ecole::scip {
+struct LpView;
+}
+
 namespace ecole::observation {
 
 class ECOLE_EXPORT Pseudocosts {
 public:
+	/** Candidates can be found among the LP columns visited by a composite function (see trait::visits_lp). */
+	static constexpr bool visits_lp = true;
+
+	/** Visitor computing the pseudocosts of the branching candidates among the columns of the LP view. */
+	class ECOLE_EXPORT LpVisitor {
+	public:
+		ECOLE_EXPORT LpVisitor(scip::Model& model, bool candidates_only);
+
+		ECOLE_EXPORT auto visit_column(scip::LpView const& lp, std::size_t col_idx) -> void;
+		auto visit_row(scip::LpView const& /*lp*/, std::size_t /*row_idx*/) const noexcept -> void {}
+
+		[[nodiscard]] ECOLE_EXPORT auto finish() -> std::optional<xt::xtensor<double, 1>>;
+
+	private:
+		SCIP* scip;
+		/** The position in the observation of every variable by problem index, or -1 for non candidates. */
+		std::vector<std::ptrdiff_t> positions;
+		xt::xtensor<double, 1> pseudocosts;
+	};
+
+	/**
+	 * Create the observation function.
+	 *
+	 * @param candidates_only Only extract the pseudocosts of the LP branching candidates, in the order of
+	 *        Model::lp_branch_cands, rather than one value per variable.
+	 */
+	ECOLE_EXPORT Pseudocosts(bool candidates_only = false) noexcept;
+
 	auto before_reset(scip::Model& /*model*/) -> void {}
 
 	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<xt::xtensor<double, 1>>;
+
+	/**
+	 * Extract the pseudocosts in a given tensor.
+	 *
+	 * The tensor is only reallocated when its size differs from the observation size, so the same buffer can be
+	 * reused across nodes.
+	 *
+	 * @return Whether the pseudocosts could be extracted, in which case the tensor is overwritten.
+	 */
+	ECOLE_EXPORT auto extract_into(scip::Model& model, bool done, xt::xtensor<double, 1>& pseudocosts) const -> bool;
+
+	/**
+	 * Create a visitor of the LP columns of a solving model.
+	 *
+	 * The data it finishes with is the same as the one of extract.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto lp_visitor(scip::Model& model, bool done) const -> LpVisitor;
+
+private:
+	bool candidates_only;
 };
 
 }  // namespace ecole::observation
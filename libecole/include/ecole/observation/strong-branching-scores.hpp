@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 
@@ -8,19 +9,56 @@
 
 #include "ecole/export.hpp"
 #include "ecole/observation/abstract.hpp"
+#include "ecole/scip/param.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 namespace ecole::observation {
 
 class ECOLE_EXPORT StrongBranchingScores {
 public:
-	ECOLE_EXPORT StrongBranchingScores(bool pseudo_candidates = false);
+	/** Extracting changes parameters and runs strong branching LPs on the model. */
+	static constexpr bool mutates_model = true;
 
-	auto before_reset(scip::Model& /*model*/) -> void {}
+	/**
+	 * Create the observation function.
+	 *
+	 * @param pseudo_candidates Whether to score pseudo candidates rather than LP candidates.
+	 * @param n_threads The number of threads scoring candidates, or zero to share Ecole's threads.
+	 *        With more than one thread, the node LP is copied in a new LP interface per thread, where the children of
+	 *        a share of the candidates are solved, warm started from the node basis as in SCIP strong branching.
+	 *        Scores are then the same as with one thread, up to the tolerances of the LP solver.
+	 *        The vanillafullstrong rule is used instead when the node LP cannot be copied with its basis, or when
+	 *        a pseudo candidate is not in the LP.
+	 */
+	ECOLE_EXPORT StrongBranchingScores(bool pseudo_candidates = false, std::size_t n_threads = 1);
 
-	ECOLE_EXPORT auto extract(scip::Model& model, bool done) const -> std::optional<xt::xtensor<double, 1>>;
+	/** Resolve the vanillafullstrong parameters of the model. */
+	ECOLE_EXPORT auto before_reset(scip::Model& model) -> void;
+
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<xt::xtensor<double, 1>>;
+
+	/** Whether the last extraction solved the children on copies of the node LP, rather than with vanillafullstrong. */
+	[[nodiscard]] auto scored_on_lp_copies() const noexcept -> bool { return last_scored_on_lp_copies; }
 
 private:
+	/** The vanillafullstrong rule and handles on its parameters, changed and restored on every extraction. */
+	struct VanillafullstrongParams {
+		SCIP* scip;
+		SCIP_BRANCHRULE* branchrule;
+		scip::ParamHandle<scip::ParamType::Bool> integralcands;
+		scip::ParamHandle<scip::ParamType::Bool> scoreall;
+		scip::ParamHandle<scip::ParamType::Bool> collectscores;
+		scip::ParamHandle<scip::ParamType::Bool> donotbranch;
+		scip::ParamHandle<scip::ParamType::Bool> idempotent;
+	};
+
 	bool pseudo_candidates;
+	std::optional<VanillafullstrongParams> params;
+	/** Shared so that the function remains copyable, null when extracting sequentially. */
+	std::shared_ptr<utility::ThreadPool> thread_pool;
+	bool last_scored_on_lp_copies = false;
+
+	auto vanillafullstrong_params(scip::Model& model) -> VanillafullstrongParams const&;
 };
 
 }  // namespace ecole::observation
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/export.hpp"
+#include "ecole/observation/abstract.hpp"
+
+namespace ecole::observation {
+
+struct ECOLE_EXPORT TreeStatisticsObs {
+	static inline std::size_t constexpr n_features = 15;
+
+	enum struct ECOLE_EXPORT Features : std::size_t {
+		/* Size of the tree */
+		n_nodes = 0,
+		n_open_nodes,
+		/* Depth of the nodes */
+		focus_depth,
+		max_depth,
+		focus_depth_mean,
+		focus_depth_stddev,
+		leaf_depth_mean,
+		/* Outcome of the nodes */
+		n_feasible_leaves,
+		n_infeasible_leaves,
+		n_branched_nodes,
+		n_backtracks,
+		/* Primal progress */
+		n_incumbents,
+		nodes_since_incumbent,
+		gap,
+		gap_at_last_incumbent,
+	};
+
+	xt::xtensor<double, 1> features;
+};
+
+/**
+ * Statistics of the branch-and-bound tree and of the search in it.
+ *
+ * The statistics are aggregated by an event handler, in constant time at every node solved and incumbent found, so
+ * that extracting them is a constant time copy, rather than a walk over the queues of open nodes.
+ * The handler is shared by all functions on the same model, and included by before_reset, as SCIP does not allow
+ * including it once solving.
+ * On a model where it is missing, the aggregated statistics are NaN.
+ */
+class ECOLE_EXPORT TreeStatistics {
+public:
+	/** Extraction only reads the aggregates and the model. */
+	static constexpr bool mutates_model = false;
+
+	ECOLE_EXPORT auto before_reset(scip::Model& model) -> void;
+
+	ECOLE_EXPORT auto extract(scip::Model& model, bool done) -> std::optional<TreeStatisticsObs>;
+};
+
+}  // namespace ecole::observation
@@ -1,13 +1,145 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
 #include <random>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
 
 #include "ecole/export.hpp"
 
 namespace ecole {
 
-using RandomGenerator = std::mt19937;
+/**
+ * Mersenne twister engine generating the same values as ``std::mt19937``, with access to its state.
+ *
+ * The standard engine only exposes its state through text streams, which are slow to format and parse.
+ * This one has the same seeding, values, text representation (as ``libstdc++``), and comparison, and additionally
+ * lets its state words be read and written, so that it is serialized as raw binary (see serialize_binary).
+ */
+class RandomGenerator {
+public:
+	using result_type = std::uint_fast32_t;
+
+	static constexpr std::size_t state_size = 624;
+
+	/** Whether a type is taken as a seed sequence, rather than as a seed value or a generator to copy. */
+	template <typename SeedSeq>
+	static constexpr bool is_seed_sequence =
+		!std::is_convertible_v<SeedSeq, result_type> && !std::is_same_v<std::remove_cv_t<SeedSeq>, RandomGenerator>;
+	static constexpr result_type default_seed = 5489U;
+
+	/** The state words of the engine, in the order they are used, and the position of the next one. */
+	struct State {
+		std::array<std::uint32_t, state_size> words;
+		std::size_t position;
+	};
+
+	[[nodiscard]] static constexpr auto min() noexcept -> result_type { return 0; }
+	[[nodiscard]] static constexpr auto max() noexcept -> result_type { return word_mask; }
+
+	explicit RandomGenerator(result_type value = default_seed) noexcept { seed(value); }
+
+	/** Seed with a seed sequence, such as ``std::seed_seq``. */
+	template <typename SeedSeq, typename = std::enable_if_t<is_seed_sequence<SeedSeq>>>
+	explicit RandomGenerator(SeedSeq& seeds) {
+		seed(seeds);
+	}
+
+	void seed(result_type value = default_seed) noexcept {
+		m_words[0] = value & word_mask;
+		for (std::size_t i = 1; i < state_size; ++i) {
+			auto const prev = m_words[i - 1];
+			m_words[i] = (init_multiplier * (prev ^ (prev >> 30U)) + i) & word_mask;
+		}
+		m_position = state_size;
+	}
+
+	template <typename SeedSeq>
+	auto seed(SeedSeq& seeds) -> std::enable_if_t<is_seed_sequence<SeedSeq>> {
+		auto values = std::array<std::uint_least32_t, state_size>{};
+		seeds.generate(values.begin(), values.end());
+		auto all_zero = true;
+		for (std::size_t i = 0; i < state_size; ++i) {
+			m_words[i] = values[i] & word_mask;
+			all_zero = all_zero && ((i == 0 ? (m_words[i] & upper_mask) : m_words[i]) == 0);
+		}
+		// A null state would only generate zeros
+		if (all_zero) {
+			m_words[0] = result_type{1} << 31U;
+		}
+		m_position = state_size;
+	}
+
+	auto operator()() noexcept -> result_type {
+		if (m_position >= state_size) {
+			twist();
+		}
+		auto value = m_words[m_position++];
+		value ^= (value >> 11U);
+		value ^= (value << 7U) & 0x9d2c5680U;
+		value ^= (value << 15U) & 0xefc60000U;
+		value ^= (value >> 18U);
+		return value;
+	}
+
+	void discard(unsigned long long n) noexcept {  // NOLINT(google-runtime-int) same as std::mt19937
+		for (; n > 0; --n) {
+			(*this)();
+		}
+	}
+
+	[[nodiscard]] ECOLE_EXPORT auto state() const noexcept -> State;
+
+	/** @throw std::invalid_argument If the position is past the state words. */
+	ECOLE_EXPORT void set_state(State const& state);
+
+	[[nodiscard]] friend auto operator==(RandomGenerator const& a, RandomGenerator const& b) noexcept -> bool {
+		return (a.m_position == b.m_position) && (a.m_words == b.m_words);
+	}
+	[[nodiscard]] friend auto operator!=(RandomGenerator const& a, RandomGenerator const& b) noexcept -> bool {
+		return !(a == b);
+	}
+
+	/** Write the state words and the position, separated by spaces. */
+	ECOLE_EXPORT friend auto operator<<(std::ostream& os, RandomGenerator const& rng) -> std::ostream&;
+
+	/** Read the state as written by operator<<, or without position as other standard libraries write it. */
+	ECOLE_EXPORT friend auto operator>>(std::istream& is, RandomGenerator& rng) -> std::istream&;
+
+private:
+	static constexpr std::size_t shift_size = 397;
+	static constexpr result_type word_mask = 0xffffffffU;
+	static constexpr result_type upper_mask = 0x80000000U;
+	static constexpr result_type lower_mask = 0x7fffffffU;
+	static constexpr result_type twist_matrix = 0x9908b0dfU;
+	static constexpr result_type init_multiplier = 1812433253U;
+
+	std::array<result_type, state_size> m_words;
+	std::size_t m_position;
+
+	/** Generate the next state_size words at once. */
+	void twist() noexcept {
+		auto const mix = [](result_type upper, result_type lower, result_type shifted) {
+			auto const y = (upper & upper_mask) | (lower & lower_mask);
+			return shifted ^ (y >> 1U) ^ (((y & 1U) != 0) ? twist_matrix : 0U);
+		};
+		for (std::size_t k = 0; k < state_size - shift_size; ++k) {
+			m_words[k] = mix(m_words[k], m_words[k + 1], m_words[k + shift_size]);
+		}
+		for (std::size_t k = state_size - shift_size; k < state_size - 1; ++k) {
+			m_words[k] = mix(m_words[k], m_words[k + 1], m_words[k + shift_size - state_size]);
+		}
+		m_words[state_size - 1] = mix(m_words[state_size - 1], m_words[0], m_words[shift_size - 1]);
+		m_position = 0;
+	}
+};
+
 using Seed = RandomGenerator::result_type;
 
 /**
@@ -28,6 +160,30 @@ ECOLE_EXPORT auto seed(Seed val) -> void;
  */
 ECOLE_EXPORT auto spawn_random_generator() -> RandomGenerator;
 
+/**
+ * Get the random generator of the given stream of Ecole's main source of randomness.
+ *
+ * Unlike the overload without argument, the result only depends on the seed and the stream, not on the order of calls
+ * in different threads.
+ */
+ECOLE_EXPORT auto spawn_random_generator(std::uint64_t stream) -> RandomGenerator;
+
+/**
+ * Derive an independent random generator from the state of a random generator and a stream index.
+ *
+ * The parent random generator is not modified, and the result only depends on its state and the stream, so it can
+ * be computed concurrently and in any order.
+ */
+ECOLE_EXPORT auto derive_random_generator(RandomGenerator const& rng, std::uint64_t stream) -> RandomGenerator;
+
+/**
+ * Split a random generator into independent random generators, one per parallel worker.
+ *
+ * The random generators are derived from the state of the parent, which is then advanced so that successive splits
+ * give different random generators.
+ */
+ECOLE_EXPORT auto split_random_generator(RandomGenerator& rng, std::size_t n) -> std::vector<RandomGenerator>;
+
 /**
  * Convert the state of the random generator to a string.
  */
@@ -38,4 +194,19 @@ ECOLE_EXPORT auto serialize(RandomGenerator const& rng) -> std::string;
  */
 ECOLE_EXPORT auto deserialize(std::string const& data) -> RandomGenerator;
 
+/**
+ * Convert the state of the random generator to compact bytes.
+ *
+ * The bytes are a header followed by the state words and the position, as little endian 32 bits integers, so they are
+ * the same on all platforms, and written and read without formatting.
+ */
+ECOLE_EXPORT auto serialize_binary(RandomGenerator const& rng) -> std::string;
+
+/**
+ * Convert bytes written by serialize_binary to a random generator.
+ *
+ * @throw std::invalid_argument If the bytes do not represent the state of a random generator.
+ */
+ECOLE_EXPORT auto deserialize_binary(std::string_view data) -> RandomGenerator;
+
 }  // namespace ecole
@@ -1,7 +1,10 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
 #include <functional>
 #include <string>
+#include <vector>
 
 #include "ecole/export.hpp"
 #include "ecole/reward/abstract.hpp"
@@ -10,15 +13,63 @@ namespace ecole::reward {
 
 enum struct ECOLE_EXPORT Bound { primal, dual, primal_dual };
 
+/** The solver events after which the dual bound of an integral is read. */
+enum struct ECOLE_EXPORT DualBoundEvent {
+	/** Every solved LP, the most precise but most expensive. */
+	lp,
+	/** Every solved node, ignoring the intermediate LPs of the node. */
+	node,
+};
+
+/** The bounds recorded at every event since the reset, for debugging integrals. */
+struct ECOLE_EXPORT BoundHistory {
+	std::vector<std::chrono::nanoseconds> times;
+	std::vector<Reward> primal_bounds;
+	std::vector<Reward> dual_bounds;
+};
+
+/**
+ * The integral of a bound with respect to time.
+ *
+ * The integral is accumulated at every event, so its memory does not grow with the length of the solve.
+ * Integrals on the same model with the same clock and events share a single event handler.
+ */
 template <Bound bound> class ECOLE_EXPORT BoundIntegral {
 public:
 	using BoundFunction = std::function<std::tuple<Reward, Reward>(scip::Model& model)>;
 
-	ECOLE_EXPORT BoundIntegral(bool wall_ = false, const BoundFunction& bound_function_ = {});
+	/**
+	 * Create the reward function.
+	 *
+	 * @param wall_ Whether to use the wall time rather than the process time.
+	 * @param bound_function_ The function returning the offset and initial bounds of the integral.
+	 * @param keep_history_ Whether to also record the bounds at every event, which uses memory proportional to the
+	 *  number of events.
+	 * @param dual_bound_event_ The events after which the dual bound is read.
+	 * @param coarse_clock_ Whether to read the wall time from utility::coarse_steady_clock, which is cheaper.
+	 * @param thread_cpu_clock_ Whether to only count the CPU time of the threads of the environment and of its solver
+	 *  (see utility::ThreadsCpuTimer), rather than of the whole process.
+	 * @throw std::invalid_argument If a coarse clock is requested without using the wall time, or a thread CPU clock
+	 *  with the wall time.
+	 */
+	ECOLE_EXPORT BoundIntegral(
+		bool wall_ = false,
+		const BoundFunction& bound_function_ = {},
+		bool keep_history_ = false,
+		DualBoundEvent dual_bound_event_ = DualBoundEvent::lp,
+		bool coarse_clock_ = false,
+		bool thread_cpu_clock_ = false);
 
 	ECOLE_EXPORT auto before_reset(scip::Model& model) -> void;
 	ECOLE_EXPORT auto extract(scip::Model& model, bool done = false) -> Reward;
 
+	/**
+	 * The bounds recorded since the model was reset, empty unless the history is kept.
+	 *
+	 * The history is shared by the integrals using the same event handler, and bounds that none of them use are NaN.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto history(scip::Model& model) const -> BoundHistory const&;
+
 private:
 	BoundFunction bound_function;
 	std::string name;
@@ -26,6 +77,12 @@ private:
 	Reward initial_dual_bound = 0.0;
 	Reward offset = 0.0;
 	bool wall = false;
+	bool keep_history = false;
+	DualBoundEvent dual_bound_event = DualBoundEvent::lp;
+	bool coarse_clock = false;
+	bool thread_cpu_clock = false;
+	/** The index of the integral in the event handler of the current model. */
+	std::size_t accumulator = 0;
 };
 
 using PrimalIntegral = BoundIntegral<Bound::primal>;
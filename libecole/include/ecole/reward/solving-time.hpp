@@ -1,22 +1,41 @@
 #pragma once
 
 #include <chrono>
+#include <memory>
 
 #include "ecole/export.hpp"
 #include "ecole/reward/abstract.hpp"
 
+namespace ecole::utility {
+class ThreadsCpuTimer;
+}  // namespace ecole::utility
+
 namespace ecole::reward {
 
 class ECOLE_EXPORT SolvingTime {
 public:
-	SolvingTime(bool wall_ = false) noexcept : wall{wall_} {}
+	/**
+	 * Create the reward function.
+	 *
+	 * @param wall_ Whether to use the wall time rather than the process time.
+	 * @param thread_cpu_ Whether to only count the CPU time of the threads of the environment and of its solver,
+	 *  rather than of the whole process, which stays correct with environments in multiple threads.
+	 *  Threads of the SCIP concurrent solver are not counted.
+	 * @throw std::invalid_argument If both the wall time and the thread CPU time are requested.
+	 */
+	ECOLE_EXPORT SolvingTime(bool wall_ = false, bool thread_cpu_ = false);
 
 	ECOLE_EXPORT auto before_reset(scip::Model& model) -> void;
 	ECOLE_EXPORT auto extract(scip::Model& model, bool done = false) -> Reward;
 
 private:
 	bool wall = false;
+	bool thread_cpu = false;
 	std::chrono::nanoseconds solving_time_offset;
+	/** Shared with the event handler reading it from the solver thread, created anew on every reset. */
+	std::shared_ptr<utility::ThreadsCpuTimer> timer;
+
+	[[nodiscard]] auto time_now() const -> std::chrono::nanoseconds;
 };
 
 }  // namespace ecole::reward
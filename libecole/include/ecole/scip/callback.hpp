@@ -1,9 +1,19 @@
 #pragma once
 
+#include <chrono>
+#include <cstddef>
+#include <functional>
+#include <optional>
+#include <string>
 #include <tuple>
 #include <variant>
 
+#include <scip/type_event.h>
+#include <scip/type_lp.h>
+#include <scip/type_result.h>
+#include <scip/type_scip.h>
 #include <scip/type_timing.h>
+#include <scip/type_tree.h>
 
 #include "ecole/utility/unreachable.hpp"
 
@@ -15,7 +25,7 @@
 namespace ecole::scip::callback {
 
 /** Type of rverse callback available. */
-enum struct Type { Branchrule, Heuristic };
+enum struct Type { Branchrule, Heuristic, Nodesel, Cutsel, Separator, Presolver, EventHandler };
 
 /** Return the name used for the reverse callback. */
 constexpr auto name(Type type) {
@@ -24,25 +34,65 @@ constexpr auto name(Type type) {
 		return "ecole::scip::StopLocation::Branchrule";
 	case Type::Heuristic:
 		return "ecole::scip::StopLocation::Heuristic";
+	case Type::Nodesel:
+		return "ecole::scip::StopLocation::Nodesel";
+	case Type::Cutsel:
+		return "ecole::scip::StopLocation::Cutsel";
+	case Type::Separator:
+		return "ecole::scip::StopLocation::Separator";
+	case Type::Presolver:
+		return "ecole::scip::StopLocation::Presolver";
+	case Type::EventHandler:
+		return "ecole::scip::StopLocation::EventHandler";
 	default:
 		utility::unreachable();
 	}
 }
 
+/**
+ * Return the name used for the reverse callback at the given position among those of the same type.
+ *
+ * The first callback of every type keeps the name of its type, so that it can be found by other plugins.
+ */
+inline auto name(Type type, std::size_t index) -> std::string {
+	if (index == 0) {
+		return name(type);
+	}
+	return std::string{name(type)} + "/" + std::to_string(index);
+}
+
 constexpr inline int priority_max = 536870911;
+constexpr inline int priority_min = -536870912;
 constexpr inline int max_depth_none = -1;
 constexpr inline double max_bound_distance_none = 1.0;
 constexpr inline int frequency_always = 1;
 constexpr inline int frequency_offset_none = 0;
+constexpr inline int max_rounds_none = -1;
 
 /** Parameter passed to create a reverse callback. */
 template <Type type> struct Constructor;
 
+/** Parameter given by SCIP to the callback function. */
+template <Type type> struct Call;
+
+/**
+ * Function called in the solver thread before pausing iterative solving.
+ *
+ * It can handle the callback directly by returning a ``SCIP_RESULT``, in which case iterative solving does not pause,
+ * or return nothing to pause as usual.
+ */
+template <Type type> using Handler = std::function<std::optional<SCIP_RESULT>(SCIP*, Call<type> const&)>;
+
 /** Parameter passed to a reverse branchrule. */
 template <> struct Constructor<Type::Branchrule> {
 	int priority = priority_max;
 	int max_depth = max_depth_none;
 	double max_bound_distance = max_bound_distance_none;
+	Handler<Type::Branchrule> handler = nullptr;
+	/** Whether calls on LP, external, and pseudo solutions are given; others return ``SCIP_DIDNOTRUN`` directly. */
+	bool yield_lp = true;
+	bool yield_external = true;
+	bool yield_pseudo = true;
 };
 using BranchruleConstructor = Constructor<Type::Branchrule>;
 
@@ -56,10 +106,58 @@ template <> struct Constructor<Type::Heuristic> {
 };
 using HeuristicConstructor = Constructor<Type::Heuristic>;
 
-using DynamicConstructor = std::variant<Constructor<Type::Branchrule>, Constructor<Type::Heuristic>>;
+/** Parameter passed to create a reverse node selector. */
+template <> struct Constructor<Type::Nodesel> {
+	int priority = priority_max;
+	int memsave_priority = priority_max;
+	Handler<Type::Nodesel> handler = nullptr;
+};
+using NodeselConstructor = Constructor<Type::Nodesel>;
+
+/** Parameter passed to create a reverse cut selector. */
+template <> struct Constructor<Type::Cutsel> {
+	int priority = priority_max;
+	Handler<Type::Cutsel> handler = nullptr;
+};
+using CutselConstructor = Constructor<Type::Cutsel>;
 
-/** Parameter given by SCIP to the callback function. */
-template <Type type> struct Call;
+/** Parameter passed to create a reverse separator, called on every separation round at the given frequency. */
+template <> struct Constructor<Type::Separator> {
+	int priority = priority_max;
+	int frequency = frequency_always;
+	double max_bound_distance = max_bound_distance_none;
+	Handler<Type::Separator> handler = nullptr;
+};
+using SeparatorConstructor = Constructor<Type::Separator>;
+
+/** Parameter passed to create a reverse presolver, called on every presolving round of the given timings. */
+template <> struct Constructor<Type::Presolver> {
+	int priority = priority_max;
+	int max_rounds = max_rounds_none;
+	SCIP_PRESOLTIMING timing_mask = SCIP_PRESOLTIMING_ALWAYS;
+	Handler<Type::Presolver> handler = nullptr;
+};
+using PresolverConstructor = Constructor<Type::Presolver>;
+
+/**
+ * Parameter passed to create a reverse event handler, called on the given global events while solving.
+ *
+ * Events are caught from the start of the solving stage, after presolving.
+ */
+template <> struct Constructor<Type::EventHandler> {
+	SCIP_EVENTTYPE event_mask = SCIP_EVENTTYPE_NODESOLVED;
+	Handler<Type::EventHandler> handler = nullptr;
+};
+using EventHandlerConstructor = Constructor<Type::EventHandler>;
+
+using DynamicConstructor = std::variant<
+	Constructor<Type::Branchrule>,
+	Constructor<Type::Heuristic>,
+	Constructor<Type::Nodesel>,
+	Constructor<Type::Cutsel>,
+	Constructor<Type::Separator>,
+	Constructor<Type::Presolver>,
+	Constructor<Type::EventHandler>>;
 
 /** Parameter given by SCIP to the branchrule function. */
 template <> struct Call<Type::Branchrule> {
@@ -68,6 +166,8 @@ template <> struct Call<Type::Branchrule> {
 
 	bool allow_add_constraints;
 	Where where;
+	/** Position of the callback in the constructors given to solve_iter. */
+	std::size_t constructor_index = 0;
 };
 using BranchruleCall = Call<Type::Branchrule>;
 
@@ -75,9 +175,113 @@ using BranchruleCall = Call<Type::Branchrule>;
 template <> struct Call<Type::Heuristic> {
 	SCIP_HEURTIMING heuristic_timing;
 	bool node_infeasible;
+	/** Position of the callback in the constructors given to solve_iter. */
+	std::size_t constructor_index = 0;
 };
 using HeuristicCall = Call<Type::Heuristic>;
 
-using DynamicCall = std::variant<Call<Type::Branchrule>, Call<Type::Heuristic>>;
+/**
+ * Parameter given by SCIP to the node selector function.
+ *
+ * The selected node must be written before resuming with ``SCIP_SUCCESS``.
+ * Resuming with another result lets the node selector select the node with the best lower bound.
+ */
+template <> struct Call<Type::Nodesel> {
+	SCIP_NODE** selected_node;
+	/** Position of the callback in the constructors given to solve_iter. */
+	std::size_t constructor_index = 0;
+};
+using NodeselCall = Call<Type::Nodesel>;
+
+/**
+ * Parameter given by SCIP to the cut selector function.
+ *
+ * To select cuts, they must be moved to the front of ``cuts``, their number written to ``n_selected_cuts``, and
+ * solving resumed with ``SCIP_SUCCESS``.
+ * Resuming with another result leaves the selection to the next cut selector.
+ * The pointers are valid until solving is resumed.
+ */
+template <> struct Call<Type::Cutsel> {
+	SCIP_ROW** cuts;
+	int n_cuts;
+	SCIP_ROW** forced_cuts;
+	int n_forced_cuts;
+	bool root;
+	int max_n_selected_cuts;
+	int* n_selected_cuts;
+	/** Position of the callback in the constructors given to solve_iter. */
+	std::size_t constructor_index = 0;
+};
+using CutselCall = Call<Type::Cutsel>;
+
+/**
+ * Parameter given by SCIP to the separator function on the LP solution.
+ *
+ * Cuts added before resuming must be reported with ``SCIP_SEPARATED`` (or another separation result), and resuming
+ * with ``SCIP_DIDNOTRUN`` leaves the separation round to the other separators.
+ */
+template <> struct Call<Type::Separator> {
+	bool allow_local;
+	int depth;
+	/** Position of the callback in the constructors given to solve_iter. */
+	std::size_t constructor_index = 0;
+};
+using SeparatorCall = Call<Type::Separator>;
+
+/**
+ * Parameter given by SCIP to the presolver function.
+ *
+ * The problem must not be changed, since the presolving counters of SCIP are not given, so resuming is limited to
+ * ``SCIP_DIDNOTRUN``, ``SCIP_DIDNOTFIND``, and ``SCIP_DELAYED``.
+ * This leaves the agent to act on the presolving of other plugins, such as their priorities and number of rounds.
+ */
+template <> struct Call<Type::Presolver> {
+	int n_rounds;
+	SCIP_PRESOLTIMING timing;
+	/** Position of the callback in the constructors given to solve_iter. */
+	std::size_t constructor_index = 0;
+};
+using PresolverCall = Call<Type::Presolver>;
+
+/**
+ * Parameter given by SCIP to the event handler function.
+ *
+ * The result given to resume is ignored.
+ * The event is valid until solving is resumed.
+ */
+template <> struct Call<Type::EventHandler> {
+	SCIP_EVENTTYPE event_type;
+	SCIP_EVENT* event;
+	/** Position of the callback in the constructors given to solve_iter. */
+	std::size_t constructor_index = 0;
+};
+using EventHandlerCall = Call<Type::EventHandler>;
+
+/** Statistics of the reverse callbacks, since the start of the last iterative solving. */
+struct Statistics {
+	/** Number of calls given back to the caller of solve_iter and solve_iter_continue. */
+	std::size_t n_yields = 0;
+	/** Number of calls answered in the solver thread, by a handler or because they are not yielded. */
+	std::size_t n_skipped_calls = 0;
+	/** Number of calls answered with a fallback result because the caller missed the deadline to continue. */
+	std::size_t n_missed_deadlines = 0;
+	/** Time the solver thread spent solving, that is outside of yields. */
+	std::chrono::nanoseconds solving_time{0};
+	/** Time the caller spent blocked waiting for the solver thread. */
+	std::chrono::nanoseconds waiting_time{0};
+	/** Time between calls being given back to the caller and solving being resumed. */
+	std::chrono::nanoseconds caller_time{0};
+	/** When the last call was given back to the caller. */
+	std::chrono::steady_clock::time_point last_yield_time = {};
+};
+
+using DynamicCall = std::variant<
+	Call<Type::Branchrule>,
+	Call<Type::Heuristic>,
+	Call<Type::Nodesel>,
+	Call<Type::Cutsel>,
+	Call<Type::Separator>,
+	Call<Type::Presolver>,
+	Call<Type::EventHandler>>;
 
 }  // namespace ecole::scip::callback
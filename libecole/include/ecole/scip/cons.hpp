@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <vector>
@@ -14,8 +15,14 @@
 #include "ecole/scip/utils.hpp"
 #include "ecole/utility/sparse-matrix.hpp"
 
+namespace ecole::utility {
+class ThreadPool;
+}  // namespace ecole::utility
+
 namespace ecole::scip {
 
+class Model;
+
 /** Scip deleter for Cons pointers. */
 class ECOLE_EXPORT ConsReleaser {
 public:
@@ -47,6 +54,80 @@ ECOLE_EXPORT auto create_cons_basic_linear(
 	SCIP_Real lhs,
 	SCIP_Real rhs) -> std::unique_ptr<SCIP_CONS, ConsReleaser>;
 
+/**
+ * Linear constraints stored as compressed sparse rows, to be added to a problem at once.
+ *
+ * Constraints refer to variables by their index, so that they can be built without a SCIP problem, for instance from
+ * data prepared by the user.
+ * Adding them to a problem reuses the same buffers for all constraints.
+ */
+class ECOLE_EXPORT LinearConstraintBatch {
+public:
+	/** An empty batch. */
+	ECOLE_EXPORT LinearConstraintBatch();
+
+	/**
+	 * Build a batch from compressed sparse rows.
+	 *
+	 * @param indptr The offsets in indices and values of every constraint, followed by the number of non zeros.
+	 * @param indices The index of the variable of every coefficient.
+	 * @param values The coefficients.
+	 * @param lhs The left hand side of every constraint, possibly infinite.
+	 * @param rhs The right hand side of every constraint, possibly infinite.
+	 * @throw std::invalid_argument If the sizes of the arrays are inconsistent or the offsets are decreasing.
+	 */
+	ECOLE_EXPORT LinearConstraintBatch(
+		std::vector<std::size_t> indptr,
+		std::vector<std::size_t> indices,
+		std::vector<SCIP_Real> values,
+		std::vector<SCIP_Real> lhs,
+		std::vector<SCIP_Real> rhs);
+
+	/** Reserve memory for the given number of constraints and non zero coefficients. */
+	ECOLE_EXPORT void reserve(std::size_t n_constraints, std::size_t n_nonzeros);
+
+	/**
+	 * Append a constraint ``lhs <= sum(coefs * vars[var_indices]) <= rhs``.
+	 *
+	 * @throw std::invalid_argument If there are not as many coefficients as variables.
+	 */
+	ECOLE_EXPORT void add(
+		nonstd::span<std::size_t const> var_indices,
+		nonstd::span<SCIP_Real const> coefs,
+		SCIP_Real lhs,
+		SCIP_Real rhs);
+	/** Append a constraint where all variables have the same coefficient. */
+	ECOLE_EXPORT void add(nonstd::span<std::size_t const> var_indices, SCIP_Real coef, SCIP_Real lhs, SCIP_Real rhs);
+
+	/** The number of constraints in the batch. */
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return lhs.size(); }
+	/** The number of coefficients in the batch. */
+	[[nodiscard]] auto n_nonzeros() const noexcept -> std::size_t { return indices.size(); }
+
+	/**
+	 * Create and add all constraints to a problem.
+	 *
+	 * Infinite sides are replaced by the SCIP infinity.
+	 *
+	 * @param scip The problem to add the constraints to.
+	 * @param vars The variables indexed by the constraints.
+	 * @param name_prefix Constraints are named with this prefix followed by their index in the batch, or left
+	 *  anonymous if null.
+	 * @throw std::out_of_range If a variable index is not smaller than the number of variables.
+	 *  No constraint is added in that case.
+	 */
+	ECOLE_EXPORT void add_to(SCIP* scip, nonstd::span<SCIP_VAR* const> vars, char const* name_prefix = "c_") const;
+	/** Add all constraints to a model, indexing the variables in the order of Model::variables. */
+	ECOLE_EXPORT void add_to(Model& model, char const* name_prefix = "c_") const;
+
+private:
+	std::vector<std::size_t> indptr;
+	std::vector<std::size_t> indices;
+	std::vector<SCIP_Real> values;
+	std::vector<SCIP_Real> lhs;
+	std::vector<SCIP_Real> rhs;
+};
+
 ECOLE_EXPORT auto cons_get_rhs(SCIP const* scip, SCIP_CONS const* cons) noexcept -> std::optional<SCIP_Real>;
 ECOLE_EXPORT auto cons_get_finite_rhs(SCIP const* scip, SCIP_CONS const* cons) noexcept -> std::optional<SCIP_Real>;
 ECOLE_EXPORT auto cons_get_lhs(SCIP const* scip, SCIP_CONS const* cons) noexcept -> std::optional<SCIP_Real>;
@@ -68,7 +149,17 @@ ECOLE_EXPORT auto get_constraint_linear_coefs(SCIP* scip, SCIP_CONS* constraint)
 	std::tuple<std::vector<SCIP_VAR*>, std::vector<SCIP_Real>, std::optional<SCIP_Real>, std::optional<SCIP_Real>>>;
 ECOLE_EXPORT auto get_constraint_coefs(SCIP* scip, SCIP_CONS* constraint)
 	-> std::tuple<std::vector<SCIP_VAR*>, std::vector<SCIP_Real>, std::optional<SCIP_Real>, std::optional<SCIP_Real>>;
-ECOLE_EXPORT auto get_all_constraints(SCIP* scip, bool normalize = false, bool include_variable_bounds = false)
-	-> std::tuple<utility::coo_matrix<SCIP_Real>, xt::xtensor<SCIP_Real, 1>>;
+
+/**
+ * Extract all constraints as a matrix of inequalities ``a x <= b``.
+ *
+ * Every finite side of a constraint is a row, in the order of the constraints, with the left hand side negated.
+ * When a thread pool is given, constraints are read concurrently, with the same output as without.
+ */
+ECOLE_EXPORT auto get_all_constraints(
+	SCIP* scip,
+	bool normalize = false,
+	bool include_variable_bounds = false,
+	utility::ThreadPool* thread_pool = nullptr) -> std::tuple<utility::coo_matrix<SCIP_Real>, xt::xtensor<SCIP_Real, 1>>;
 
 }  // namespace ecole::scip
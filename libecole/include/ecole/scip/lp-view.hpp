@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#include <nonstd/span.hpp>
+#include <scip/scip.h>
+
+#include "ecole/export.hpp"
+
+namespace ecole::scip {
+
+class Model;
+
+/**
+ * Snapshot of the LP relaxation of the current node, stored in contiguous arrays.
+ *
+ * All the data is read from SCIP once, so that observation functions iterate over plain arrays rather than calling
+ * into SCIP for every column and row.
+ * Since it only holds copies, a view can also be read concurrently.
+ * It is obtained through Model::lp_view, which shares it among all the functions extracting data on the same LP.
+ */
+struct ECOLE_EXPORT LpView {
+	/**
+	 * Read the LP of the current node.
+	 *
+	 * @throw ScipError If the model is not solving.
+	 */
+	ECOLE_EXPORT explicit LpView(Model& model);
+
+	/** Whether the view still describes the LP of the model, or was taken at another node or LP solve. */
+	[[nodiscard]] ECOLE_EXPORT auto is_current(Model const& model) const noexcept -> bool;
+
+	[[nodiscard]] auto n_columns() const noexcept -> std::size_t { return columns.size(); }
+	[[nodiscard]] auto n_rows() const noexcept -> std::size_t { return rows.size(); }
+	[[nodiscard]] auto n_nonzeros() const noexcept -> std::size_t { return values.size(); }
+	/** The memory allocated for the arrays of the view, in bytes. */
+	[[nodiscard]] ECOLE_EXPORT auto n_bytes() const noexcept -> std::size_t;
+
+	/** The LP column indices of the non zero coefficients of a row, as in Model::lp_columns. */
+	[[nodiscard]] auto row_columns(std::size_t row) const noexcept -> nonstd::span<std::size_t const> {
+		return {column_indices.data() + row_pointers[row], row_pointers[row + 1] - row_pointers[row]};
+	}
+	/** The non zero coefficients of a row, in the same order as row_columns. */
+	[[nodiscard]] auto row_values(std::size_t row) const noexcept -> nonstd::span<SCIP_Real const> {
+		return {values.data() + row_pointers[row], row_pointers[row + 1] - row_pointers[row]};
+	}
+
+	/** Columns in the order of Model::lp_columns. */
+	std::vector<SCIP_COL*> columns;
+	/** The problem index of the variable of every column. */
+	std::vector<std::size_t> column_var_indices;
+	std::vector<SCIP_Real> column_objectives;
+	std::vector<SCIP_Real> column_lower_bounds;
+	std::vector<SCIP_Real> column_upper_bounds;
+	std::vector<SCIP_Real> column_primal_values;
+	std::vector<SCIP_Real> column_reduced_costs;
+	std::vector<SCIP_BASESTAT> column_basis_statuses;
+
+	/** Rows in the order of Model::lp_rows. */
+	std::vector<SCIP_ROW*> rows;
+	/** Sides and activities as in SCIP, that is including the row constant. */
+	std::vector<SCIP_Real> row_lhs;
+	std::vector<SCIP_Real> row_rhs;
+	std::vector<SCIP_Real> row_constants;
+	std::vector<SCIP_Real> row_activities;
+	std::vector<SCIP_Real> row_dual_values;
+	std::vector<SCIP_BASESTAT> row_basis_statuses;
+
+	/** The coefficients of the rows on LP columns, in compressed sparse rows. */
+	std::vector<std::size_t> row_pointers;
+	std::vector<std::size_t> column_indices;
+	std::vector<SCIP_Real> values;
+
+private:
+	/** Identifies the LP that the view was taken on: node number, number of LPs and LP iterations. */
+	std::tuple<SCIP_Longint, SCIP_Longint, SCIP_Longint> lp_key;
+};
+
+/**
+ * Take the LP view of a solving model before data functions read it, possibly concurrently.
+ *
+ * Model::lp_view updates the view kept in the model, so it must not be called concurrently on a new LP.
+ * Once the view is taken, later calls on the same LP only read it.
+ * Does nothing when the model is not solving.
+ */
+ECOLE_EXPORT void prepare_lp_view(Model& model);
+
+}  // namespace ecole::scip
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <vector>
+
+#include "ecole/export.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/plugins.hpp"
+
+namespace ecole::scip {
+
+/**
+ * Models kept after use to hold new problems, saving the creation of SCIP and of its plugins.
+ *
+ * Creating a Model includes every plugin of its profile and their parameters, and freeing it frees them all, which is
+ * a large part of the time to reset an environment on small problems.
+ * Released models are instead recycled (see Model::recycle): only their problem is freed, and their parameters are
+ * reset, so that they are equivalent to a new Model once they are acquired again.
+ *
+ * Pools are thread safe, and can be shared by environments running in different threads.
+ */
+class ECOLE_EXPORT ModelPool {
+public:
+	/**
+	 * Create an empty pool.
+	 *
+	 * @param profile The plugins of the models created by the pool.
+	 * @param max_size The number of models kept at most, others are freed when released.
+	 */
+	ECOLE_EXPORT explicit ModelPool(PluginProfile profile = PluginProfile::full, std::size_t max_size = 1);
+
+	/** A model without problem, recycled if available or newly created otherwise. */
+	[[nodiscard]] ECOLE_EXPORT auto acquire() -> Model;
+
+	/** A model holding the problem of the given file, as Model::from_file. */
+	[[nodiscard]] ECOLE_EXPORT auto from_file(std::filesystem::path const& filename) -> Model;
+
+	/**
+	 * Give a model back to the pool.
+	 *
+	 * The model is freed instead if the pool is full or if it cannot be recycled, for instance because data functions
+	 * included plugins in it.
+	 */
+	ECOLE_EXPORT void release(Model&& model);
+
+	/**
+	 * Create models until the given number of them are available, at most the maximum size.
+	 *
+	 * Models reserved before forking are shared by the forked processes until modified.
+	 */
+	ECOLE_EXPORT void reserve(std::size_t n_models);
+
+	/** The number of models available. */
+	[[nodiscard]] ECOLE_EXPORT auto size() const -> std::size_t;
+
+	[[nodiscard]] auto profile() const noexcept -> PluginProfile { return m_profile; }
+	[[nodiscard]] auto max_size() const noexcept -> std::size_t { return m_max_size; }
+
+private:
+	PluginProfile m_profile;
+	std::size_t m_max_size;
+	mutable std::mutex m_mutex;
+	std::vector<Model> m_models;
+};
+
+}  // namespace ecole::scip
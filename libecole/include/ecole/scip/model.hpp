@@ -1,7 +1,9 @@
 #pragma once
 
 #include <cassert>
+#include <chrono>
 #include <cstddef>
+#include <cstdint>
 #include <cstring>
 #include <filesystem>
 #include <functional>
@@ -19,15 +21,35 @@
 #include "ecole/export.hpp"
 #include "ecole/scip/callback.hpp"
 #include "ecole/scip/exception.hpp"
+#include "ecole/scip/param.hpp"
+#include "ecole/scip/plugins.hpp"
 #include "ecole/scip/type.hpp"
 #include "ecole/utility/numeric.hpp"
 #include "ecole/utility/type-traits.hpp"
 #include "ecole/utility/unreachable.hpp"
 
+namespace ecole::utility {
+enum class CoroutineBackend;
+enum class AffinityPolicy;
+}
+
 namespace ecole::scip {
 
 /* Forward declare scip holder type */
 class Scimpl;
+struct LpView;
+
+/** Memory held by a Model, in bytes. */
+struct MemoryUsage {
+	/** Block memory in use by SCIP (``SCIPgetMemUsed``). */
+	std::size_t scip_used;
+	/** Block memory allocated by SCIP, including freed blocks kept for reuse (``SCIPgetMemTotal``). */
+	std::size_t scip_total;
+	/** SCIP estimate of the memory allocated outside of block memory, such as by the LP solver. */
+	std::size_t scip_external;
+	/** The LP view kept by the model for observation functions (see Model::lp_view). */
+	std::size_t lp_view;
+};
 
 /**
  * A stateful SCIP solver object.
@@ -39,10 +61,17 @@ class Scimpl;
  */
 class ECOLE_EXPORT Model {
 public:
+	/** Default number of bytes of the log kept by capture_log. */
+	static constexpr std::size_t default_log_capacity = 1U << 16U;
+
 	/**
 	 * Construct an *initialized* model with default SCIP plugins.
 	 */
 	ECOLE_EXPORT Model();
+	/**
+	 * Construct an *initialized* model with only the SCIP plugins of the given profile.
+	 */
+	ECOLE_EXPORT explicit Model(PluginProfile profile);
 	ECOLE_EXPORT Model(Model&& /*other*/) noexcept;
 	Model(Model const& model) = delete;
 	ECOLE_EXPORT Model(std::unique_ptr<Scimpl>&& /*other_scimpl*/);
@@ -64,6 +93,54 @@ public:
 	[[nodiscard]] ECOLE_EXPORT Model copy() const;
 	[[nodiscard]] ECOLE_EXPORT Model copy_orig() const;
 
+	/**
+	 * Free the problem and reset the parameters, keeping the solver and its plugins to read a new problem.
+	 *
+	 * This is much faster than creating a new Model, but only possible for models created with the given plugin
+	 * profile, and in which no plugin was included since, other than by iterative solving.
+	 *
+	 * @return Whether the model was recycled, otherwise it is left untouched.
+	 * @see ModelPool
+	 */
+	[[nodiscard]] ECOLE_EXPORT bool recycle(PluginProfile profile);
+
+	/**
+	 * Create a new problem from the subtree of the current node.
+	 *
+	 * During solving, the new model holds the transformed problem with the local bounds of the current node as its
+	 * original problem.
+	 * Solving it explores a subtree equivalent to the current node, so it can be used to try different decisions from
+	 * the same node without replaying the whole episode.
+	 * The branching tree, cuts, and primal solutions found so far are not kept, hence this is only an approximation of
+	 * the solver state.
+	 * Before the problem is transformed, this is the same as copy_orig.
+	 */
+	[[nodiscard]] ECOLE_EXPORT Model fork() const;
+
+	/**
+	 * Copy the problem, without the plugins and parameters, into a new model with the plugins of the given profile.
+	 *
+	 * This is lighter than copy, both to create the copy and to solve it, when the plugins of the model are not needed.
+	 * The problem is the transformed one once transformed, as with copy.
+	 *
+	 * @return The new model, or nothing if the profile lacks the handler of a constraint of the problem.
+	 */
+	[[nodiscard]] ECOLE_EXPORT std::optional<Model> copy_problem(PluginProfile profile) const;
+
+	/**
+	 * Replace the problem by a copy of the problem of another model, keeping the plugins and parameters of this one.
+	 *
+	 * As with copy_problem, the problem copied is the transformed one once transformed, so that loading a presolved
+	 * model gives the presolved problem as the original problem of this model.
+	 *
+	 * @return Whether the problem was loaded, which fails when this model lacks the handler of a constraint of the
+	 *         problem, or one that can copy constraints, or when the other model has no problem.
+	 *         The model is then left untouched.
+	 * @throw ScipError If a handler fails to copy one of the constraints, in which case the model is left without
+	 *        problem.
+	 */
+	[[nodiscard]] ECOLE_EXPORT bool load_problem(Model const& other);
+
 	/**
 	 * Compare if two model share the same SCIP pointer, _i.e._ the same memory.
 	 */
@@ -72,29 +149,122 @@ public:
 
 	/**
 	 * Construct a model by reading a problem file supported by SCIP (LP, MPS,...).
+	 *
+	 * Files compressed with gzip (``.gz``) or zstd (``.zst``) are decompressed in memory before being parsed, when
+	 * Ecole is built with zlib and libzstd respectively.
 	 */
-	ECOLE_EXPORT static Model from_file(std::filesystem::path const& filename);
+	ECOLE_EXPORT static Model
+	from_file(std::filesystem::path const& filename, PluginProfile profile = PluginProfile::full);
+
+	/**
+	 * Construct a model by parsing a problem held in memory.
+	 *
+	 * SCIP readers only read from files, so on Linux the data is exposed through an anonymous in-memory file,
+	 * without touching the file system.
+	 * Other platforms fall back to a temporary file.
+	 *
+	 * @param data The content of the problem file.
+	 * @param format The extension of the file format, such as "lp", "mps", or "cip", which selects the SCIP reader.
+	 */
+	ECOLE_EXPORT static Model
+	from_buffer(std::string_view data, std::string const& format, PluginProfile profile = PluginProfile::full);
 
 	/**
 	 * Constuct an empty problem with empty data structures.
 	 */
-	ECOLE_EXPORT static Model prob_basic(std::string const& name = "Model");
+	ECOLE_EXPORT static Model prob_basic(std::string const& name = "Model", PluginProfile profile = PluginProfile::full);
 
 	/**
 	 * Writes the Model into a file.
 	 */
 	ECOLE_EXPORT void write_problem(std::filesystem::path const& filename) const;
 
+	/**
+	 * Write the original problem in a compact binary format, to be read back with load_binary.
+	 *
+	 * Variables (with their bounds, objective and type) and constraints are dumped as flat arrays, constraints being
+	 * stored as compressed sparse rows.
+	 * Every constraint must have a linear representation (such as linear, set partitioning, or knapsack constraints),
+	 * and is read back as a linear constraint.
+	 * Parameters and solutions are not saved.
+	 * The format uses the byte order of the machine.
+	 *
+	 * Other data of constraints and variables, such as their type of constraint or flags, is not saved, so the
+	 * problem read back may differ (see is_binary_exact).
+	 *
+	 * @throw ScipError If a constraint is not linear or the file cannot be written.
+	 */
+	ECOLE_EXPORT void save_binary(std::filesystem::path const& filename) const;
+
+	/**
+	 * Whether load_binary reads back the same problem as the one written by save_binary.
+	 *
+	 * That is the case when all constraints are linear constraints, and constraints and variables have the flags
+	 * that SCIP gives them by default, as the readers of LP and MPS files do.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto is_binary_exact() const -> bool;
+
+	/**
+	 * Construct a model from a problem written with save_binary.
+	 *
+	 * Loading reads arrays in bulk instead of parsing text, then creates all variables and constraints.
+	 *
+	 * @throw ScipError If the file cannot be read or is not a valid binary problem.
+	 */
+	ECOLE_EXPORT static Model
+	load_binary(std::filesystem::path const& filename, PluginProfile profile = PluginProfile::full);
+
+	/**
+	 * Write the original problem in the format of save_binary, in memory.
+	 *
+	 * @throw ScipError If a constraint is not linear.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto to_binary() const -> std::string;
+
+	/**
+	 * Construct a model from a problem written with to_binary or save_binary, held in memory.
+	 *
+	 * @throw ScipError If the data is not a valid binary problem.
+	 */
+	ECOLE_EXPORT static Model from_binary(std::string_view data, PluginProfile profile = PluginProfile::full);
+
 	/**
 	 * Read a problem file into the Model.
 	 */
 	ECOLE_EXPORT void read_problem(std::string const& filename);
 
+	/**
+	 * Read a problem held in memory into the Model, as in from_buffer.
+	 */
+	ECOLE_EXPORT void read_problem_from_buffer(std::string_view data, std::string const& format);
+
 	/**
 	 * Change whether or not to write logging messages in the logger.
 	 */
 	ECOLE_EXPORT void set_messagehdlr_quiet(bool quiet) noexcept;
 
+	/**
+	 * Capture the log of SCIP in a ring buffer of the given number of bytes, rather than writing it.
+	 *
+	 * Messages are copied as is, without locking nor allocating, so that capture can be left on in production and the
+	 * log retrieved with captured_log, after an episode or an exception.
+	 * The model is no longer quiet, and how much is logged is set by the ``display/verblevel`` parameter.
+	 * A capacity of zero stops capturing and makes the model quiet.
+	 * Copies of the model do not capture its log.
+	 */
+	ECOLE_EXPORT void capture_log(std::size_t capacity = default_log_capacity);
+
+	/**
+	 * The last captured log, since the start of the capture or the last clear.
+	 *
+	 * Once the buffer is full, older messages are overwritten, and the log starts at the first full line.
+	 * The log is only consistent when SCIP is not writing, such as between two steps of iterative solving.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto captured_log() const -> std::string;
+
+	/** Forget the log captured so far. */
+	ECOLE_EXPORT void clear_captured_log() noexcept;
+
 	[[nodiscard]] ECOLE_EXPORT std::string name() const noexcept;
 	ECOLE_EXPORT void set_name(std::string const& name);
 
@@ -122,8 +292,24 @@ public:
 	template <typename T> void set_param(std::string const& name, T value);
 	template <typename T> [[nodiscard]] T get_param(std::string const& name) const;
 
-	ECOLE_EXPORT void set_params(std::map<std::string, Param> name_values);
+	/**
+	 * Resolve a parameter once for repeated fast access.
+	 *
+	 * The method will throw an exception if the parameter does not exist or if its type is not *exactly* the one
+	 * used by SCIP.
+	 */
+	template <ParamType T> [[nodiscard]] ECOLE_EXPORT ParamHandle<T> param_handle(std::string const& name);
+
+	/**
+	 * Set many parameters at once.
+	 *
+	 * Parameters already holding the given value are left untouched, so that reapplying the same parameters, as
+	 * environments do on every reset, only changes the ones that differ.
+	 */
+	ECOLE_EXPORT void set_params(std::map<std::string, Param> const& name_values);
 	[[nodiscard]] ECOLE_EXPORT std::map<std::string, Param> get_params() const;
+	/** Get the parameters whose value differs from their SCIP default. */
+	[[nodiscard]] ECOLE_EXPORT std::map<std::string, Param> get_changed_params() const;
 
 	ECOLE_EXPORT void disable_presolve();
 	ECOLE_EXPORT void disable_cuts();
@@ -134,11 +320,60 @@ public:
 	[[nodiscard]] ECOLE_EXPORT nonstd::span<SCIP_COL*> lp_columns() const;
 	[[nodiscard]] ECOLE_EXPORT nonstd::span<SCIP_CONS*> constraints() const noexcept;
 	[[nodiscard]] ECOLE_EXPORT nonstd::span<SCIP_ROW*> lp_rows() const;
+	/**
+	 * A snapshot of the LP of the current node.
+	 *
+	 * The view is kept until the node or the LP changes, so that all functions extracting data on the same LP share
+	 * it rather than each reading the LP from SCIP.
+	 * Taking a view on a new LP is not thread safe (see prepare_lp_view).
+	 *
+	 * @throw ScipError If the model is not solving.
+	 */
+	[[nodiscard]] ECOLE_EXPORT std::shared_ptr<LpView const> lp_view();
 	[[nodiscard]] ECOLE_EXPORT std::size_t nnz() const noexcept;
 
+	/**
+	 * The memory currently held by the solver and by Ecole data cached in the model.
+	 *
+	 * The SCIP ``limits/memory`` parameter applies to the sum of scip_used and scip_external.
+	 */
+	[[nodiscard]] ECOLE_EXPORT auto memory_usage() const noexcept -> MemoryUsage;
+
+	/**
+	 * A hash of the problem, to recognize an instance seen previously.
+	 *
+	 * Hashes the objective sense and offset, the type, objective, and bounds of the variables, and the handler,
+	 * variables, coefficients, and sides of the constraints, in a single pass without allocating more than a buffer
+	 * for the largest constraint.
+	 * Names are ignored, and the value is the same across reads of a file, copy_orig, and processes.
+	 * Data of constraints that SCIP cannot report, such as nonlinear expressions, are not hashed (see
+	 * exact_fingerprint).
+	 */
+	[[nodiscard]] ECOLE_EXPORT std::uint64_t fingerprint() const;
+
+	/**
+	 * The fingerprint, if it covers all the data of the problem.
+	 *
+	 * This is the case when the variables, coefficients, and sides of every constraint can be read, as for linear
+	 * constraints.
+	 * Caches keyed by problem use it so that different problems never share an entry.
+	 *
+	 * @return The fingerprint, or nothing if the problem has constraints only partially hashed.
+	 */
+	[[nodiscard]] ECOLE_EXPORT std::optional<std::uint64_t> exact_fingerprint() const;
+
 	ECOLE_EXPORT void transform_prob();
 	ECOLE_EXPORT void presolve();
 	ECOLE_EXPORT void solve();
+	/**
+	 * Solve with the SCIP concurrent solver, using up to ``parallel/maxnthreads`` threads.
+	 *
+	 * The statistics of the model, such as the number of nodes, are those of the concurrent solver that finished
+	 * first.
+	 * Event handlers and other plugins of the model are not called by the concurrent solvers.
+	 * Falls back to solve when SCIP is built without a task processing interface.
+	 */
+	ECOLE_EXPORT void solve_concurrent();
 
 	[[nodiscard]] ECOLE_EXPORT bool is_solved() const noexcept;
 	[[nodiscard]] ECOLE_EXPORT SCIP_Real primal_bound() const noexcept;
@@ -211,6 +446,53 @@ public:
 	 */
 	ECOLE_EXPORT auto solve_iter_continue(SCIP_RESULT result) -> std::optional<callback::DynamicCall>;
 
+	/**
+	 * Let the solver continue by itself if iterative solving is not continued before the deadline.
+	 *
+	 * The solver thread answers the current callback with the fallback result once the timeout has elapsed, and keeps
+	 * solving.
+	 * Until solve_iter_reclaim is called, the solver may be running, so the model must not be used in the meantime.
+	 *
+	 * @pre Iterative solving is paused on a callback.
+	 */
+	ECOLE_EXPORT void solve_iter_set_deadline(std::chrono::nanoseconds timeout, SCIP_RESULT fallback = SCIP_DIDNOTRUN);
+
+	/**
+	 * Take back the model after solve_iter_set_deadline.
+	 *
+	 * @return Whether the solver is still paused on the callback, in which case the model can be used and continued
+	 *         as usual.
+	 *         Otherwise the deadline was missed, and the next call to solve_iter_continue ignores its result and waits
+	 *         for the next callback.
+	 *         True when no deadline was set.
+	 */
+	ECOLE_EXPORT auto solve_iter_reclaim() -> bool;
+
+	/** Statistics of the reverse callbacks since the last call to solve_iter. */
+	[[nodiscard]] ECOLE_EXPORT auto callback_statistics() const noexcept -> callback::Statistics;
+
+	/**
+	 * Get and set where the solver runs during iterative solving.
+	 *
+	 * The backend is taken into account on the next call to ``solve_iter``.
+	 * Copies of the model use the default backend.
+	 *
+	 * @see utility::CoroutineBackend
+	 */
+	[[nodiscard]] ECOLE_EXPORT utility::CoroutineBackend coroutine_backend() const noexcept;
+	ECOLE_EXPORT void set_coroutine_backend(utility::CoroutineBackend backend) noexcept;
+
+	/**
+	 * Get and set on which CPUs the solver runs during iterative solving.
+	 *
+	 * As for the backend, the policy is taken into account on the next call to ``solve_iter``, and copies of the model
+	 * use the default policy.
+	 *
+	 * @see utility::AffinityPolicy
+	 */
+	[[nodiscard]] ECOLE_EXPORT utility::AffinityPolicy coroutine_affinity() const noexcept;
+	ECOLE_EXPORT void set_coroutine_affinity(utility::AffinityPolicy affinity) noexcept;
+
 private:
 	std::unique_ptr<Scimpl> scimpl;
 };
@@ -264,19 +546,22 @@ template <typename To, typename From> auto cast([[maybe_unused]] From val) -> To
 
 template <typename T> void Model::set_param(std::string const& name, T value) {
 	using internal::cast;
-	switch (get_param_type(name)) {
+	// Resolve the parameter once to dispatch on its type and change its value
+	auto* const scip = get_scip_ptr();
+	auto* const param = find_param(scip, name);
+	switch (param_type(param)) {
 	case ParamType::Bool:
-		return set_param<ParamType::Bool>(name, cast<bool>(value));
+		return ParamHandle<ParamType::Bool>{scip, param}.set(cast<bool>(value));
 	case ParamType::Int:
-		return set_param<ParamType::Int>(name, cast<int>(value));
+		return ParamHandle<ParamType::Int>{scip, param}.set(cast<int>(value));
 	case ParamType::LongInt:
-		return set_param<ParamType::LongInt>(name, cast<SCIP_Longint>(value));
+		return ParamHandle<ParamType::LongInt>{scip, param}.set(cast<SCIP_Longint>(value));
 	case ParamType::Real:
-		return set_param<ParamType::Real>(name, cast<SCIP_Real>(value));
+		return ParamHandle<ParamType::Real>{scip, param}.set(cast<SCIP_Real>(value));
 	case ParamType::Char:
-		return set_param<ParamType::Char>(name, cast<char>(value));
+		return ParamHandle<ParamType::Char>{scip, param}.set(cast<char>(value));
 	case ParamType::String:
-		return set_param<ParamType::String>(name, cast<std::string>(value));
+		return ParamHandle<ParamType::String>{scip, param}.set(cast<std::string>(value));
 	default:
 		utility::unreachable();
 	}
@@ -284,19 +569,21 @@ template <typename T> void Model::set_param(std::string const& name, T value) {
 
 template <typename T> T Model::get_param(std::string const& name) const {
 	using namespace internal;
-	switch (get_param_type(name)) {
+	auto* const scip = const_cast<SCIP*>(get_scip_ptr());
+	auto* const param = find_param(scip, name);
+	switch (param_type(param)) {
 	case ParamType::Bool:
-		return cast<T>(get_param<ParamType::Bool>(name));
+		return cast<T>(ParamHandle<ParamType::Bool>{scip, param}.get());
 	case ParamType::Int:
-		return cast<T>(get_param<ParamType::Int>(name));
+		return cast<T>(ParamHandle<ParamType::Int>{scip, param}.get());
 	case ParamType::LongInt:
-		return cast<T>(get_param<ParamType::LongInt>(name));
+		return cast<T>(ParamHandle<ParamType::LongInt>{scip, param}.get());
 	case ParamType::Real:
-		return cast<T>(get_param<ParamType::Real>(name));
+		return cast<T>(ParamHandle<ParamType::Real>{scip, param}.get());
 	case ParamType::Char:
-		return cast<T>(get_param<ParamType::Char>(name));
+		return cast<T>(ParamHandle<ParamType::Char>{scip, param}.get());
 	case ParamType::String:
-		return cast<T>(get_param<ParamType::String>(name));
+		return cast<T>(ParamHandle<ParamType::String>{scip, param}.get());
 	default:
 		utility::unreachable();
 	}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+
+#include <scip/scip.h>
+
+#include "ecole/export.hpp"
+#include "ecole/scip/type.hpp"
+#include "ecole/utility/type-traits.hpp"
+
+namespace ecole::scip {
+
+/**
+ * Find a parameter by name.
+ *
+ * @throw ScipError If no parameter of the given name exists.
+ */
+[[nodiscard]] ECOLE_EXPORT auto find_param(SCIP* scip, std::string const& name) -> SCIP_PARAM*;
+
+/** The type of a SCIP parameter. */
+[[nodiscard]] ECOLE_EXPORT auto param_type(SCIP_PARAM* param) noexcept -> ParamType;
+
+/**
+ * Typed access to a SCIP parameter resolved once.
+ *
+ * Contrary to Model::get_param and Model::set_param, the parameter is not looked up by name on every access.
+ * The handle is only valid as long as the Model that created it is alive.
+ *
+ * @see Model::param_handle to create a handle.
+ */
+template <ParamType T> class ECOLE_EXPORT ParamHandle {
+public:
+	ECOLE_EXPORT ParamHandle(SCIP* scip, SCIP_PARAM* param) noexcept;
+
+	[[nodiscard]] ECOLE_EXPORT auto get() const -> param_t<T>;
+	ECOLE_EXPORT void set(utility::value_or_const_ref_t<param_t<T>> value) const;
+
+	[[nodiscard]] ECOLE_EXPORT auto name() const -> char const*;
+
+private:
+	SCIP* scip;
+	SCIP_PARAM* param;
+};
+
+}  // namespace ecole::scip
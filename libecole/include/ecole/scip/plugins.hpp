@@ -0,0 +1,32 @@
+#pragma once
+
+#include <scip/scip.h>
+
+#include "ecole/export.hpp"
+
+namespace ecole::scip {
+
+/**
+ * The set of SCIP plugins included in a new Model.
+ *
+ * Including all default plugins takes a significant part of the time and memory needed to create small models.
+ * Parameters of plugins that are not included do not exist, and copies of a model have the same plugins.
+ */
+enum struct PluginProfile {
+	/** All default SCIP plugins. */
+	full,
+	/**
+	 * What is needed to solve linear problems with branch-and-bound.
+	 *
+	 * That is the readers, linear constraint handlers, node selectors, and branching rules, but no heuristics,
+	 * separators, propagators, or presolvers other than those of the constraint handlers.
+	 */
+	branching,
+	/** Only readers and linear constraint handlers, to create, read, copy, and write problems but not solve them. */
+	modeling,
+};
+
+/** Include the plugins of the given profile in a newly created SCIP. */
+ECOLE_EXPORT void include_plugins(SCIP* scip, PluginProfile profile);
+
+}  // namespace ecole::scip
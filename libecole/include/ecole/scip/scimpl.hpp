@@ -1,17 +1,25 @@
 #pragma once
 
+#include <chrono>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <utility>
+#include <vector>
 
 #include <nonstd/span.hpp>
 #include <scip/scip.h>
 
 #include "ecole/export.hpp"
 #include "ecole/scip/callback.hpp"
+#include "ecole/scip/plugins.hpp"
+#include "ecole/utility/metrics.hpp"
 
 namespace ecole::utility {
-template <typename Return, typename Message> class Coroutine;
+struct BlockingWait;
+template <typename Return, typename Message, typename WaitPolicy> class Coroutine;
+enum class CoroutineBackend;
+enum class AffinityPolicy;
 }
 
 namespace ecole::scip {
@@ -20,6 +28,12 @@ struct ECOLE_EXPORT ScipDeleter {
 	ECOLE_EXPORT void operator()(SCIP* ptr);
 };
 
+/** Counters updated in the solver thread, defined with the reverse callbacks. */
+struct SolverCounters;
+struct LpView;
+/** The ring buffer of Model::capture_log. */
+class LogBuffer;
+
 class ECOLE_EXPORT Scimpl {
 public:
 	ECOLE_EXPORT Scimpl();
@@ -31,16 +45,63 @@ public:
 
 	[[nodiscard]] ECOLE_EXPORT auto copy() const -> Scimpl;
 	[[nodiscard]] ECOLE_EXPORT auto copy_orig() const -> Scimpl;
+	[[nodiscard]] ECOLE_EXPORT auto fork() const -> Scimpl;
+	/** A copy of the problem in a SCIP with the plugins of a profile, if they have all its constraint handlers. */
+	[[nodiscard]] ECOLE_EXPORT auto copy_problem(PluginProfile profile) const -> std::optional<Scimpl>;
+	/** Replace the problem by a copy of the problem of the source, if this SCIP has all its constraint handlers. */
+	ECOLE_EXPORT auto load_problem(Scimpl const& source) -> bool;
 
 	ECOLE_EXPORT auto solve_iter(nonstd::span<callback::DynamicConstructor const> arg_packs)
 		-> std::optional<callback::DynamicCall>;
 	ECOLE_EXPORT auto solve_iter_continue(SCIP_RESULT result) -> std::optional<callback::DynamicCall>;
+	ECOLE_EXPORT void solve_iter_set_deadline(std::chrono::nanoseconds timeout, SCIP_RESULT fallback);
+	ECOLE_EXPORT auto solve_iter_reclaim() -> bool;
+	[[nodiscard]] ECOLE_EXPORT auto callback_statistics() const noexcept -> callback::Statistics;
+
+	[[nodiscard]] ECOLE_EXPORT auto coroutine_backend() const noexcept -> utility::CoroutineBackend;
+	ECOLE_EXPORT void set_coroutine_backend(utility::CoroutineBackend backend) noexcept;
+	[[nodiscard]] ECOLE_EXPORT auto coroutine_affinity() const noexcept -> utility::AffinityPolicy;
+	ECOLE_EXPORT void set_coroutine_affinity(utility::AffinityPolicy affinity) noexcept;
+
+	/** Record the plugins of a SCIP just created with the given profile, so that it can later be recycled. */
+	ECOLE_EXPORT void set_plugin_profile(PluginProfile profile);
+	/**
+	 * Free the problem and reset the parameters, keeping the SCIP and its plugins for a new problem.
+	 *
+	 * @return Whether the SCIP was recycled, which requires it to have exactly the plugins of the given profile (and
+	 *         the reverse callbacks of iterative solving). Otherwise it is left untouched.
+	 */
+	ECOLE_EXPORT auto recycle(PluginProfile profile) -> bool;
+
+	/** The LP view last returned by Model::lp_view. */
+	[[nodiscard]] auto lp_view_cache() noexcept -> std::shared_ptr<LpView const>& { return m_lp_view; }
+
+	/** The buffer in which the log is captured, if any. */
+	[[nodiscard]] auto log_buffer() noexcept -> std::shared_ptr<LogBuffer>& { return m_log_buffer; }
 
 private:
-	using Controller = utility::Coroutine<callback::DynamicCall, SCIP_RESULT>;
+	using Controller = utility::Coroutine<callback::DynamicCall, SCIP_RESULT, utility::BlockingWait>;
 
+	// Declared first to be destroyed after the SCIP, which may write in it until freed
+	std::shared_ptr<LogBuffer> m_log_buffer;
 	std::unique_ptr<SCIP, ScipDeleter> m_scip;
 	std::unique_ptr<Controller> m_controller;
+	std::shared_ptr<SolverCounters> m_solver_counters;
+	callback::Statistics m_statistics;
+	// Held by pointer to keep Scimpl movable
+	std::unique_ptr<std::mutex> m_copy_mutex;
+	utility::CoroutineBackend m_coroutine_backend;
+	utility::AffinityPolicy m_coroutine_affinity;
+	std::shared_ptr<LpView const> m_lp_view;
+	std::optional<PluginProfile> m_plugin_profile;
+	std::vector<int> m_plugin_counts;
+	/** The block memory used by the SCIP, as last sampled, in the memory of all models. */
+	utility::metrics::GaugeShare m_memory;
+	/** Whether the solver resumed by itself after a deadline, since the last reclaim. */
+	bool m_deadline_missed = false;
+
+	[[nodiscard]] auto lock_for_copy() const -> std::unique_lock<std::mutex>;
+	auto wait_for_solver() -> std::optional<callback::DynamicCall>;
 };
 
 }  // namespace ecole::scip
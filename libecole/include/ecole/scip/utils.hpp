@@ -1,5 +1,7 @@
 #pragma once
 
+#include <utility>
+
 #include <scip/scip.h>
 
 #include "ecole/scip/exception.hpp"
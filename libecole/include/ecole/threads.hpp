@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+
+#include "ecole/export.hpp"
+
+namespace ecole {
+
+namespace utility {
+class ThreadPool;
+}
+
+/**
+ * Set the number of threads used by the parallel features of Ecole that are not given one explicitly.
+ *
+ * This includes the extraction of observations, the vector environments, and the batch tools.
+ * Zero, the default, uses one thread per core, and one disables parallelism.
+ * Only features created afterwards are affected.
+ */
+ECOLE_EXPORT auto set_n_threads(std::size_t n_threads) -> void;
+
+/** The number of threads used by the parallel features of Ecole that are not given one explicitly. */
+[[nodiscard]] ECOLE_EXPORT auto get_n_threads() noexcept -> std::size_t;
+
+/**
+ * The pool of get_n_threads() workers shared by the parallel features of Ecole, created on first use.
+ *
+ * Null when there is a single thread.
+ */
+[[nodiscard]] ECOLE_EXPORT auto shared_thread_pool() -> std::shared_ptr<utility::ThreadPool>;
+
+/**
+ * The thread pool of a parallel feature given its number of threads.
+ *
+ * Zero gives the shared pool (see shared_thread_pool), one gives null to run sequentially, and other values give a
+ * new pool of that size.
+ */
+[[nodiscard]] ECOLE_EXPORT auto make_thread_pool(std::size_t n_threads) -> std::shared_ptr<utility::ThreadPool>;
+
+}  // namespace ecole
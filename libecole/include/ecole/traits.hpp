@@ -107,12 +107,97 @@ template <typename T> inline constexpr bool has_step_dynamics_v = has_step_dynam
 
 template <typename T> inline constexpr bool is_dynamics_v = internal::has_step_dynamics_v<T>;
 
+/**
+ * Check whether dynamics have a deadline to act on states.
+ *
+ * Such dynamics have a ``start_step_deadline(scip::Model&)`` member function, called by environments once they are
+ * done extracting data from a state, from which point the model is left to the solver.
+ */
+template <typename, typename = void> struct has_step_deadline : std::false_type {};
+template <typename T>
+struct has_step_deadline<
+	T,
+	std::void_t<decltype(std::declval<T&>().start_step_deadline(std::declval<scip::Model&>()))>> : std::true_type {};
+template <typename T> inline constexpr bool has_step_deadline_v = has_step_deadline<T>::value;
+
+/**
+ * Check whether dynamics can be reset without arguments, as automatic resets of vector environments do.
+ */
+template <typename, typename = void> struct has_default_reset : std::false_type {};
+template <typename T>
+struct has_default_reset<T, std::void_t<decltype(std::declval<T&>().reset_dynamics(std::declval<scip::Model&>()))>> :
+	std::true_type {};
+template <typename T> inline constexpr bool has_default_reset_v = has_default_reset<T>::value;
+
 /*********************************
  *  Detection of extracted data  *
  *********************************/
 
 template <typename T> using data_of_t = utility::return_t<decltype(&T::extract)>;
 
+/*************************************
+ *  Detection of model modification  *
+ *************************************/
+
+/**
+ * Check whether a data function may modify the model when extracting data.
+ *
+ * Functions declare that their ``extract`` method only reads the model with a ``static constexpr bool mutates_model``
+ * member set to false.
+ * Functions without such member are assumed to modify the model, for instance by changing parameters.
+ * Many SCIP getters are not pure reads, as they compute values lazily and cache them in the SCIP data (row activities,
+ * reduced costs, the objective norm), or allocate buffer memory, so only functions not calling them are read only.
+ * Passing LP data through scip::LpView, taken before concurrent extraction, avoids these calls.
+ */
+template <typename, typename = void> struct mutates_model : std::true_type {};
+template <typename T>
+struct mutates_model<T, std::void_t<decltype(T::mutates_model)>> : std::bool_constant<T::mutates_model> {};
+template <typename T> inline constexpr bool mutates_model_v = mutates_model<T>::value;
+
+/**
+ * Check whether a data function reads the LP through Model::lp_view.
+ *
+ * Functions opt in with a ``static constexpr bool uses_lp_view`` member set to true, so that environments and
+ * parallel functions take the view once, before extracting data, for all the functions sharing it.
+ */
+template <typename, typename = void> struct uses_lp_view : std::false_type {};
+template <typename T>
+struct uses_lp_view<T, std::void_t<decltype(T::uses_lp_view)>> : std::bool_constant<T::uses_lp_view> {};
+template <typename T> inline constexpr bool uses_lp_view_v = uses_lp_view<T>::value;
+
+/**
+ * Check whether a data function can compute its data in a traversal of the LP view shared with other functions.
+ *
+ * Functions opt in with a ``static constexpr bool visits_lp`` member set to true, and a ``lp_visitor(model, done)``
+ * method returning a visitor.
+ * Composite functions, such as TupleFunction, then call ``visit_column(lp, j)`` and ``visit_row(lp, i)`` of all their
+ * visitors in a single pass over the LP view, before getting the data of every visitor with ``finish()``.
+ */
+template <typename, typename = void> struct visits_lp : std::false_type {};
+template <typename T> struct visits_lp<T, std::void_t<decltype(T::visits_lp)>> : std::bool_constant<T::visits_lp> {};
+template <typename T> inline constexpr bool visits_lp_v = visits_lp<T>::value;
+
+/**
+ * Check whether a data function keeps extracting data in the background after extract has returned.
+ *
+ * Functions opt in with a ``static constexpr bool prefetches`` member set to true, and a ``join()`` method waiting for
+ * the extraction, which environments call before the model transitions again (see data::PrefetchedFunction).
+ */
+template <typename, typename = void> struct prefetches : std::false_type {};
+template <typename T> struct prefetches<T, std::void_t<decltype(T::prefetches)>> : std::bool_constant<T::prefetches> {};
+template <typename T> inline constexpr bool prefetches_v = prefetches<T>::value;
+
+/**
+ * Check whether a data function extracts no data, and keeps no state.
+ *
+ * Functions opt in with a ``static constexpr bool extracts_nothing`` member set to true, so that environments never
+ * call them and default construct their data instead.
+ */
+template <typename, typename = void> struct extracts_nothing : std::false_type {};
+template <typename T>
+struct extracts_nothing<T, std::void_t<decltype(T::extracts_nothing)>> : std::bool_constant<T::extracts_nothing> {};
+template <typename T> inline constexpr bool extracts_nothing_v = extracts_nothing<T>::value;
+
 /***********************************
  *  Detection of observation type  *
  ***********************************/
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <vector>
+
+#include "ecole/export.hpp"
+
+namespace ecole::utility {
+
+/** A set of logical CPUs, as sorted CPU indices. */
+using CpuSet = std::vector<unsigned int>;
+
+/**
+ * The CPUs on which the calling thread is allowed to run.
+ *
+ * Empty on systems where thread affinity is not supported.
+ */
+ECOLE_EXPORT auto thread_affinity() -> CpuSet;
+
+/**
+ * Restrict the calling thread to the given CPUs.
+ *
+ * Memory is allocated by Linux on the NUMA node of the CPU first touching it, so a thread pinned to a core also keeps
+ * the memory it allocates, such as the block memory of SCIP, on its node.
+ *
+ * @return Whether the affinity was set, which is never the case on systems where it is not supported or if the set is
+ *         empty.
+ */
+ECOLE_EXPORT auto set_thread_affinity(CpuSet const& cpus) -> bool;
+
+/**
+ * The CPUs allowed to the calling thread, grouped by physical core.
+ *
+ * Every set holds the SMT siblings (hyperthreads) of a core.
+ * Cores are ordered by socket, then by CPU index, so that consecutive cores share their socket for as long as possible.
+ * Every CPU is its own core on systems where the topology is unknown.
+ */
+ECOLE_EXPORT auto physical_cores() -> std::vector<CpuSet>;
+
+/**
+ * Restrict the calling thread to some CPUs for the lifetime of the object.
+ *
+ * The previous affinity of the thread is restored upon destruction, which matters for threads reused by other tasks,
+ * such as those of a ThreadCache.
+ * Nothing is done when the thread already has the given affinity.
+ */
+class ECOLE_EXPORT ScopedAffinity {
+public:
+	ECOLE_EXPORT explicit ScopedAffinity(CpuSet const& cpus);
+	ScopedAffinity(ScopedAffinity const&) = delete;
+	ScopedAffinity(ScopedAffinity&&) = delete;
+	auto operator=(ScopedAffinity const&) -> ScopedAffinity& = delete;
+	auto operator=(ScopedAffinity&&) -> ScopedAffinity& = delete;
+	ECOLE_EXPORT ~ScopedAffinity();
+
+private:
+	CpuSet previous;
+	bool changed = false;
+};
+
+}  // namespace ecole::utility
@@ -1,6 +1,10 @@
 #pragma once
 
 #include <chrono>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
 
 #include "ecole/export.hpp"
 
@@ -26,4 +30,63 @@ public:
 	ECOLE_EXPORT static auto now() -> time_point;
 };
 
+/**
+ * A steady clock that is cheaper to read but less precise.
+ *
+ * On Linux, this reads ``CLOCK_MONOTONIC_COARSE``, whose resolution is one scheduler tick (a few milliseconds).
+ * On other systems, this is the same as ``std::chrono::steady_clock``.
+ */
+class ECOLE_EXPORT coarse_steady_clock {
+public:
+	using duration = std::chrono::nanoseconds;
+	using rep = duration::rep;
+	using period = duration::period;
+	using time_point = std::chrono::time_point<coarse_steady_clock>;
+	static bool constexpr is_steady = true;
+
+	ECOLE_EXPORT static auto now() -> time_point;
+};
+
+/**
+ * A CPU usage clock of the calling thread.
+ *
+ * Contrary to cpu_clock, the work of other threads of the process, such as other environments, is not counted.
+ */
+class ECOLE_EXPORT thread_cpu_clock {
+public:
+	using duration = std::chrono::nanoseconds;
+	using rep = duration::rep;
+	using period = duration::period;
+	using time_point = std::chrono::time_point<thread_cpu_clock>;
+	static bool constexpr is_steady = true;
+
+	ECOLE_EXPORT static auto now() -> time_point;
+};
+
+/**
+ * The CPU time used by the threads reading the timer since it was reset.
+ *
+ * Every read adds the CPU time that the calling thread used since its previous read.
+ * This measures work handed over between threads, such as an environment and the coroutine solving its model, without
+ * counting the other threads of the process.
+ * The CPU time that a thread uses after its last read is not counted, so all threads doing the work must read the
+ * timer regularly.
+ */
+class ECOLE_EXPORT ThreadsCpuTimer {
+public:
+	ThreadsCpuTimer() = default;
+	ECOLE_EXPORT ThreadsCpuTimer(ThreadsCpuTimer const& other);
+	ECOLE_EXPORT auto operator=(ThreadsCpuTimer const& other) -> ThreadsCpuTimer&;
+
+	/** Start counting from zero, forgetting the threads that read the timer. */
+	ECOLE_EXPORT void reset();
+	/** Add the time used by the calling thread since its previous read, and return the total. */
+	ECOLE_EXPORT auto elapsed() -> std::chrono::nanoseconds;
+
+private:
+	mutable std::mutex mutex;
+	std::vector<std::pair<std::thread::id, thread_cpu_clock::time_point>> last_reads;
+	std::chrono::nanoseconds total{0};
+};
+
 }  // namespace ecole::utility
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <cstddef>
 #include <exception>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <optional>
@@ -9,8 +13,73 @@
 #include <utility>
 #include <variant>
 
+#include "ecole/utility/affinity.hpp"
+
 namespace ecole::utility {
 
+/**
+ * Where the executor of a Coroutine runs.
+ *
+ * - ``Thread`` creates a new thread for every coroutine.
+ * - ``ThreadCache`` reuses idle threads from ThreadCache::global, which avoids the cost of thread creation when many
+ *   short lived coroutines are created.
+ */
+enum class CoroutineBackend { Thread, ThreadCache };
+
+/** The backend used when none is specified, selected at build time with ``ECOLE_COROUTINE_THREAD_CACHE``. */
+#ifdef ECOLE_COROUTINE_THREAD_CACHE
+inline constexpr auto default_coroutine_backend = CoroutineBackend::ThreadCache;
+#else
+inline constexpr auto default_coroutine_backend = CoroutineBackend::Thread;
+#endif
+
+/**
+ * On which CPUs the executor of a Coroutine runs.
+ *
+ * - ``Any`` leaves the affinity of the executor thread as is.
+ *   On Linux, a new thread starts with the affinity of the thread creating it, while a cached thread keeps its own.
+ * - ``FollowCaller`` restricts the executor to the CPUs of the thread creating the coroutine.
+ *   When that thread is pinned, for instance to the SMT siblings of a core, both sides of the coroutine hand over to
+ *   one another without crossing sockets, and the memory allocated by the executor stays on the same NUMA node.
+ */
+enum class AffinityPolicy { Any, FollowCaller };
+
+/** The affinity policy used when none is specified. */
+inline constexpr auto default_affinity_policy = AffinityPolicy::FollowCaller;
+
+/**
+ * Wait policy blocking on the condition variable until the condition is met.
+ */
+struct BlockingWait {
+	template <typename Predicate>
+	static void wait(std::unique_lock<std::mutex>& lk, std::condition_variable& signal, Predicate&& pred) {
+		signal.wait(lk, std::forward<Predicate>(pred));
+	}
+};
+
+/**
+ * Wait policy spinning on the condition for a while before blocking on the condition variable.
+ *
+ * This avoids the wake up latency of the condition variable when the other side answers quickly, at the cost of
+ * keeping a CPU core busy while waiting.
+ * Spinning is skipped on single core machines, where it could only delay the other side.
+ *
+ * @tparam n_spins The number of times the condition is checked before blocking.
+ */
+template <std::size_t n_spins = 10000> struct SpinThenBlockWait {  // NOLINT(readability-magic-numbers)
+	template <typename Predicate>
+	static void wait(std::unique_lock<std::mutex>& lk, std::condition_variable& signal, Predicate&& pred) {
+		static bool const can_spin = std::thread::hardware_concurrency() > 1;
+		if (can_spin) {
+			lk.unlock();
+			for (std::size_t i = 0; (i < n_spins) && !pred(); ++i) {
+			}
+			lk.lock();
+		}
+		signal.wait(lk, std::forward<Predicate>(pred));
+	}
+};
+
 /**
  * Asynchronous cooperative interruptable code execution.
  *
@@ -26,8 +95,10 @@ namespace ecole::utility {
  *
  * @tparam Return The type of return values created by the executor.
  * @tparam Message The type of the messages that can be sent to the executor.
+ * @tparam WaitPolicy How both sides wait for one another, either BlockingWait or SpinThenBlockWait.
+ *         The predicate given to the policy can be evaluated without holding the lock.
  */
-template <typename Return, typename Message> class Coroutine {
+template <typename Return, typename Message, typename WaitPolicy = BlockingWait> class Coroutine {
 public:
 	/** Return or nothing if the corutine has finished. */
 	using MaybeReturn = std::optional<Return>;
@@ -43,6 +114,21 @@ public:
 	 */
 	template <class Function, class... Args> Coroutine(Function&& func, Args&&... args);
 
+	/**
+	 * Start the execution on the given backend.
+	 *
+	 * @see Coroutine(Function&&, Args&&...)
+	 */
+	template <class Function, class... Args> Coroutine(CoroutineBackend backend, Function&& func, Args&&... args);
+
+	/**
+	 * Start the execution on the given backend, with the given CPU affinity.
+	 *
+	 * @see Coroutine(Function&&, Args&&...)
+	 */
+	template <class Function, class... Args>
+	Coroutine(CoroutineBackend backend, AffinityPolicy affinity, Function&& func, Args&&... args);
+
 	/**
 	 * Terminate the coroutine
 	 *
@@ -70,6 +156,29 @@ public:
 	 */
 	auto resume(Message instruction) -> void;
 
+	/**
+	 * Let the executor resume by itself with a fallback message if not resumed before the deadline.
+	 *
+	 * The coroutine gives up exclusive access to the shared state until ``reclaim`` is called, which must be done
+	 * before calling ``resume``.
+	 * This function should only be called after ``wait`` has returned a value.
+	 *
+	 * @param timeout How long the executor waits from now before resuming with the fallback message.
+	 * @param fallback The message received by the executor when the deadline passes.
+	 */
+	auto set_deadline(std::chrono::steady_clock::duration timeout, Message fallback) -> void;
+
+	/**
+	 * Cancel the deadline set by ``set_deadline``.
+	 *
+	 * @return Whether the executor was still waiting, in which case the coroutine has exclusive access again and
+	 *         ``resume`` can be called.
+	 *         Otherwise the executor already resumed with the fallback message and ``wait`` must be called for its
+	 *         next value.
+	 *         Always true when no deadline was set.
+	 */
+	auto reclaim() -> bool;
+
 private:
 	/** Type indicating that the executor must terminate. */
 	struct StopToken {};
@@ -92,6 +201,8 @@ private:
 		auto coroutine_resume_executor(Lock&& lk, MessageOrStop instruction) -> void;
 		auto coroutine_stop_executor(Lock&& lk) -> void;
 		[[nodiscard]] auto coroutine_executor_is_done(Lock const& lk) const noexcept -> bool;
+		auto coroutine_set_deadline(Lock&& lk, std::chrono::steady_clock::time_point deadline, Message fallback) -> void;
+		auto coroutine_reclaim() -> std::pair<Lock, bool>;
 
 		auto executor_start() -> Lock;
 		auto executor_yield(Lock&& lk, Return value) -> std::pair<Lock, MessageOrStop>;
@@ -102,8 +213,14 @@ private:
 		std::exception_ptr m_executor_exception = nullptr;  // NOLINT(bugprone-throw-keyword-missing)
 		std::mutex m_exclusion_mutex;
 		std::condition_variable m_resume_signal;
-		bool m_executor_running = true;
+		// Atomic as it is read without holding the lock by spinning wait policies
+		std::atomic<bool> m_executor_running = true;
 		bool m_executor_finished = false;
+		// Atomic as it is read without holding the lock by spinning wait policies
+		std::atomic<bool> m_has_deadline = false;
+		bool m_deadline_passed = false;
+		std::chrono::steady_clock::time_point m_deadline;
+		std::optional<Message> m_fallback;
 		Return m_value;
 		MessageOrStop m_instruction;
 
@@ -150,7 +267,10 @@ public:
 
 private:
 	std::shared_ptr<Synchronizer> m_synchronizer;
+	/** Executor running on a dedicated thread (CoroutineBackend::Thread). */
 	std::thread executor_thread;
+	/** Executor running on a cached thread (CoroutineBackend::ThreadCache). */
+	std::future<void> executor_task;
 	Lock m_exclusion_lock;
 
 	auto stop_executor() -> void;
@@ -158,10 +278,12 @@ private:
 }  // namespace ecole::utility
 
 #include <cassert>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
 #include "ecole/utility/function-traits.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 namespace ecole::utility {
 
@@ -169,41 +291,69 @@ namespace ecole::utility {
  *  Implementation of Coroutine::Synchronizer  *
  ***********************************************/
 
-template <typename Return, typename Message>
-auto Coroutine<Return, Message>::Synchronizer::coroutine_wait_executor() -> Lock {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Synchronizer::coroutine_wait_executor() -> Lock {
 	Lock lk{m_exclusion_mutex};
-	m_resume_signal.wait(lk, [this] { return !m_executor_running; });
+	WaitPolicy::wait(lk, m_resume_signal, [this] { return !m_executor_running; });
 	return maybe_throw(std::move(lk));
 }
 
-template <typename Return, typename Message>
-auto Coroutine<Return, Message>::Synchronizer::coroutine_pop_return() -> Return {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Synchronizer::coroutine_pop_return() -> Return {
 	return std::move(m_value);
 }
 
-template <typename Return, typename Message>
-auto Coroutine<Return, Message>::Synchronizer::coroutine_resume_executor(Lock&& lk, MessageOrStop new_instruction)
-	-> void {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Synchronizer::coroutine_resume_executor(
+	Lock&& lk,
+	MessageOrStop new_instruction) -> void {
 	assert(is_valid_lock(lk));
 	m_instruction = std::move(new_instruction);
+	m_has_deadline = false;
 	m_executor_running = true;
 	lk.unlock();
 	m_resume_signal.notify_one();
 }
 
-template <typename Return, typename Message>
-auto Coroutine<Return, Message>::Synchronizer::coroutine_executor_is_done(
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Synchronizer::coroutine_executor_is_done(
 	[[maybe_unused]] Lock const& lk) const noexcept -> bool {
 	assert(is_valid_lock(lk));
 	return m_executor_finished;
 }
 
-template <typename Return, typename Message> auto Coroutine<Return, Message>::Synchronizer::executor_start() -> Lock {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Synchronizer::coroutine_set_deadline(
+	Lock&& lk,
+	std::chrono::steady_clock::time_point deadline,
+	Message fallback) -> void {
+	assert(is_valid_lock(lk));
+	m_deadline = deadline;
+	m_fallback = std::move(fallback);
+	m_deadline_passed = false;
+	m_has_deadline = true;
+	lk.unlock();
+	m_resume_signal.notify_one();
+}
+
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Synchronizer::coroutine_reclaim() -> std::pair<Lock, bool> {
+	Lock lk{m_exclusion_mutex};
+	m_has_deadline = false;
+	auto const passed = std::exchange(m_deadline_passed, false);
+	if (passed) {
+		lk.unlock();
+	}
+	return {std::move(lk), !passed};
+}
+
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Synchronizer::executor_start() -> Lock {
 	return Lock{m_exclusion_mutex};
 }
 
-template <typename Return, typename Message>
-auto Coroutine<Return, Message>::Synchronizer::executor_yield(Lock&& lk, Return value)
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Synchronizer::executor_yield(Lock&& lk, Return value)
 	-> std::pair<Lock, MessageOrStop> {
 	assert(is_valid_lock(lk));
 	m_executor_running = false;
@@ -211,12 +361,26 @@ auto Coroutine<Return, Message>::Synchronizer::executor_yield(Lock&& lk, Return
 	lk.unlock();
 	m_resume_signal.notify_one();
 	lk.lock();
-	m_resume_signal.wait(lk, [this] { return m_executor_running; });
+	while (!m_executor_running) {
+		if (m_has_deadline) {
+			// The coroutine may also reclaim the deadline, after which waiting continues without it
+			auto const woken = m_resume_signal.wait_until(
+				lk, m_deadline, [this] { return m_executor_running || !m_has_deadline; });
+			if (!woken) {
+				m_instruction = std::move(m_fallback).value();
+				m_has_deadline = false;
+				m_deadline_passed = true;
+				m_executor_running = true;
+			}
+		} else {
+			WaitPolicy::wait(lk, m_resume_signal, [this] { return m_executor_running || m_has_deadline; });
+		}
+	}
 	return {std::move(lk), std::move(m_instruction)};
 }
 
-template <typename Return, typename Message>
-auto Coroutine<Return, Message>::Synchronizer::executor_terminate(Lock&& lk) -> void {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Synchronizer::executor_terminate(Lock&& lk) -> void {
 	assert(is_valid_lock(lk));
 	m_executor_running = false;
 	m_executor_finished = true;
@@ -224,20 +388,22 @@ auto Coroutine<Return, Message>::Synchronizer::executor_terminate(Lock&& lk) ->
 	m_resume_signal.notify_one();
 }
 
-template <typename Return, typename Message>
-auto Coroutine<Return, Message>::Synchronizer::executor_terminate(Lock&& lk, std::exception_ptr const& e) -> void {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Synchronizer::executor_terminate(
+	Lock&& lk,
+	std::exception_ptr const& e) -> void {
 	assert(is_valid_lock(lk));
 	m_executor_exception = e;
 	executor_terminate(std::move(lk));
 }
 
-template <typename Return, typename Message>
-auto Coroutine<Return, Message>::Synchronizer::is_valid_lock(Lock const& lk) const noexcept -> bool {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Synchronizer::is_valid_lock(Lock const& lk) const noexcept -> bool {
 	return lk && (lk.mutex() == &m_exclusion_mutex);
 }
 
-template <typename Return, typename Message>
-auto Coroutine<Return, Message>::Synchronizer::maybe_throw(Lock&& lk) -> Lock {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Synchronizer::maybe_throw(Lock&& lk) -> Lock {
 	assert(is_valid_lock(lk));
 	auto e_ptr = m_executor_exception;
 	m_executor_exception = nullptr;
@@ -252,32 +418,34 @@ auto Coroutine<Return, Message>::Synchronizer::maybe_throw(Lock&& lk) -> Lock {
  *  Implementation of Coroutine::Executor  *
  *******************************************/
 
-template <typename Return, typename Message>
-auto Coroutine<Return, Message>::Executor::is_stop(MessageOrStop const& message) -> bool {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Executor::is_stop(MessageOrStop const& message) -> bool {
 	return std::holds_alternative<StopToken>(message);
 }
 
-template <typename Return, typename Message>
-Coroutine<Return, Message>::Executor::Executor(std::shared_ptr<Synchronizer> synchronizer) noexcept :
+template <typename Return, typename Message, typename WaitPolicy>
+Coroutine<Return, Message, WaitPolicy>::Executor::Executor(std::shared_ptr<Synchronizer> synchronizer) noexcept :
 	m_synchronizer(std::move(synchronizer)) {}
 
-template <typename Return, typename Message> auto Coroutine<Return, Message>::Executor::start() -> void {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Executor::start() -> void {
 	m_exclusion_lock = m_synchronizer->executor_start();
 }
 
-template <typename Return, typename Message>
-auto Coroutine<Return, Message>::Executor::yield(Return value) -> MessageOrStop {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Executor::yield(Return value) -> MessageOrStop {
 	auto [lock, instruction] = m_synchronizer->executor_yield(std::move(m_exclusion_lock), std::move(value));
 	m_exclusion_lock = std::move(lock);
 	return instruction;
 }
 
-template <typename Return, typename Message> auto Coroutine<Return, Message>::Executor::terminate() -> void {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Executor::terminate() -> void {
 	m_synchronizer->executor_terminate(std::move(m_exclusion_lock));
 }
 
-template <typename Return, typename Message>
-auto Coroutine<Return, Message>::Executor::terminate(std::exception_ptr&& except) -> void {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Executor::terminate(std::exception_ptr&& except) -> void {
 	m_synchronizer->executor_terminate(std::move(m_exclusion_lock), except);
 }
 
@@ -285,22 +453,42 @@ auto Coroutine<Return, Message>::Executor::terminate(std::exception_ptr&& except
  *  Implementation of Coroutine  *
  *********************************/
 
-template <typename Return, typename Message>
+template <typename Return, typename Message, typename WaitPolicy>
+template <typename Function, typename... Args>
+Coroutine<Return, Message, WaitPolicy>::Coroutine(Function&& func_, Args&&... args_) :
+	Coroutine(default_coroutine_backend, std::forward<Function>(func_), std::forward<Args>(args_)...) {}
+
+template <typename Return, typename Message, typename WaitPolicy>
 template <typename Function, typename... Args>
-Coroutine<Return, Message>::Coroutine(Function&& func_, Args&&... args_) :
+Coroutine<Return, Message, WaitPolicy>::Coroutine(CoroutineBackend backend, Function&& func_, Args&&... args_) :
+	Coroutine(backend, default_affinity_policy, std::forward<Function>(func_), std::forward<Args>(args_)...) {}
+
+template <typename Return, typename Message, typename WaitPolicy>
+template <typename Function, typename... Args>
+Coroutine<Return, Message, WaitPolicy>::Coroutine(
+	CoroutineBackend backend,
+	AffinityPolicy affinity,
+	Function&& func_,
+	Args&&... args_) :
 	m_synchronizer(std::make_shared<Synchronizer>()) {
 	auto executor = std::make_shared<Executor>(m_synchronizer);
+	// Read in the creating thread, an empty set leaves the executor affinity untouched
+	auto cpus = (affinity == AffinityPolicy::FollowCaller) ? thread_affinity() : CpuSet{};
 
-	auto executor_func = [executor](Function&& func, Args&&... args) {
+	// Threads of the cache are already counted, and the function is copyable for the cache
+	auto running = backend == CoroutineBackend::Thread ? std::make_shared<RunningThread>() : nullptr;
+
+	auto executor_func = [executor, cpus = std::move(cpus), running = std::move(running)](auto&& func, auto&&... args) {
+		auto const pinned = ScopedAffinity{cpus};
 		executor->start();
 		try {
 			using ExecutorArg = std::remove_const_t<std::remove_reference_t<utility::arg_t<0, Function>>>;
 			if constexpr (std::is_same_v<ExecutorArg, std::shared_ptr<Executor>>) {
-				func(executor, std::forward<Args>(args)...);
+				func(executor, std::forward<decltype(args)>(args)...);
 			} else if constexpr (std::is_same_v<ExecutorArg, std::weak_ptr<Executor>>) {
-				func(std::weak_ptr<Executor>(executor), std::forward<Args>(args)...);
+				func(std::weak_ptr<Executor>(executor), std::forward<decltype(args)>(args)...);
 			} else {
-				func(*executor, std::forward<Args>(args)...);
+				func(*executor, std::forward<decltype(args)>(args)...);
 			}
 			executor->terminate();
 		} catch (...) {
@@ -308,23 +496,41 @@ Coroutine<Return, Message>::Coroutine(Function&& func_, Args&&... args_) :
 		}
 	};
 
-	executor_thread = std::thread(executor_func, std::forward<Function>(func_), std::forward<Args>(args_)...);
+	switch (backend) {
+	case CoroutineBackend::Thread:
+		executor_thread = std::thread(executor_func, std::forward<Function>(func_), std::forward<Args>(args_)...);
+		break;
+	case CoroutineBackend::ThreadCache:
+		// Arguments are decay copied, as with std::thread
+		executor_task = ThreadCache::global().submit([executor_func,
+		                                              func = std::decay_t<Function>(std::forward<Function>(func_)),
+		                                              args = std::make_tuple(std::forward<Args>(args_)...)]() mutable {
+			std::apply([&](auto&... a) { executor_func(std::move(func), std::move(a)...); }, args);
+		});
+		break;
+	}
 }
 
-template <typename Return, typename Message> Coroutine<Return, Message>::~Coroutine() noexcept {
+template <typename Return, typename Message, typename WaitPolicy>
+Coroutine<Return, Message, WaitPolicy>::~Coroutine() noexcept {
 	assert(std::this_thread::get_id() != executor_thread.get_id());
-	if (executor_thread.joinable()) {
+	if (executor_thread.joinable() || executor_task.valid()) {
 		try {
 			stop_executor();
 		} catch (...) {
-			// if the Coroutine<Return, Message> is deleted but not waited on, then we ignore potential
+			// if the Coroutine is deleted but not waited on, then we ignore potential
 			// exceptions
 		}
-		executor_thread.join();
+		if (executor_thread.joinable()) {
+			executor_thread.join();
+		} else {
+			executor_task.wait();
+		}
 	}
 }
 
-template <typename Return, typename Message> auto Coroutine<Return, Message>::wait() -> MaybeReturn {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::wait() -> MaybeReturn {
 	m_exclusion_lock = m_synchronizer->coroutine_wait_executor();
 	if (m_synchronizer->coroutine_executor_is_done(m_exclusion_lock)) {
 		return std::nullopt;
@@ -332,16 +538,35 @@ template <typename Return, typename Message> auto Coroutine<Return, Message>::wa
 	return m_synchronizer->coroutine_pop_return();
 }
 
-template <typename Return, typename Message> auto Coroutine<Return, Message>::resume(Message instruction) -> void {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::resume(Message instruction) -> void {
 	m_synchronizer->coroutine_resume_executor(std::move(m_exclusion_lock), std::move(instruction));
 }
 
-template <typename Return, typename Message>
-auto Coroutine<Return, Message>::Synchronizer::coroutine_stop_executor(Lock&& lk) -> void {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::set_deadline(std::chrono::steady_clock::duration timeout, Message fallback)
+	-> void {
+	m_synchronizer->coroutine_set_deadline(
+		std::move(m_exclusion_lock), std::chrono::steady_clock::now() + timeout, std::move(fallback));
+}
+
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::reclaim() -> bool {
+	if (m_exclusion_lock.owns_lock()) {
+		return true;
+	}
+	auto [lock, waiting] = m_synchronizer->coroutine_reclaim();
+	m_exclusion_lock = std::move(lock);
+	return waiting;
+}
+
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::Synchronizer::coroutine_stop_executor(Lock&& lk) -> void {
 	coroutine_resume_executor(std::move(lk), Coroutine::StopToken{});
 }
 
-template <typename Return, typename Message> auto Coroutine<Return, Message>::stop_executor() -> void {
+template <typename Return, typename Message, typename WaitPolicy>
+auto Coroutine<Return, Message, WaitPolicy>::stop_executor() -> void {
 	if (!m_exclusion_lock.owns_lock()) {
 		m_exclusion_lock = m_synchronizer->coroutine_wait_executor();
 	}
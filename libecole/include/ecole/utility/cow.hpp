@@ -0,0 +1,44 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+namespace ecole::utility {
+
+/**
+ * A value shared by its copies until one of them modifies it.
+ *
+ * Copying is a reference count increment, and the value is only copied by mut, when other copies still share it.
+ * This is meant for replay buffers and data augmentation, which duplicate observations and modify few of their
+ * tensors: holding every tensor in its own Cow means that only the modified tensors are copied.
+ * Copies can be used from different threads, but a single copy must not be modified concurrently.
+ */
+template <typename T> class Cow {
+public:
+	Cow() : m_value{std::make_shared<T>()} {}
+	/** Take ownership of a value, without copying it. */
+	explicit Cow(T value) : m_value{std::make_shared<T>(std::move(value))} {}
+
+	[[nodiscard]] auto get() const noexcept -> T const& { return *m_value; }
+	auto operator*() const noexcept -> T const& { return *m_value; }
+	auto operator->() const noexcept -> T const* { return m_value.get(); }
+
+	/** The value, for modification, copied first if other copies share it. */
+	auto mut() -> T& {
+		if (m_value.use_count() > 1) {
+			m_value = std::make_shared<T>(std::as_const(*m_value));
+		}
+		return *m_value;
+	}
+
+	/** Whether other copies share the value, hence whether mut would copy it. */
+	[[nodiscard]] auto shared() const noexcept -> bool { return m_value.use_count() > 1; }
+
+	/** Move the value out, copied if other copies share it. */
+	auto release() && -> T { return std::move(mut()); }
+
+private:
+	std::shared_ptr<T> m_value;
+};
+
+}  // namespace ecole::utility
@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace ecole::utility {
+
+/**
+ * Associative container storing its entries contiguously, sorted by key.
+ *
+ * A drop-in replacement for ``std::map`` when few entries are built at once and read by iteration, as for
+ * information dictionaries.
+ * All entries share a single allocation, and inserting entries in key order only appends to the vector.
+ * Lookups are transparent, so that they can be made with a ``char const*`` on a map of ``std::string``.
+ * Contrary to ``std::map``, inserting an entry invalidates iterators and references.
+ */
+template <typename Key, typename Value, typename Compare = std::less<>> class FlatMap {
+public:
+	using key_type = Key;
+	using mapped_type = Value;
+	using value_type = std::pair<Key, Value>;
+	using size_type = std::size_t;
+	using key_compare = Compare;
+	using container_type = std::vector<value_type>;
+	using iterator = typename container_type::iterator;
+	using const_iterator = typename container_type::const_iterator;
+
+	FlatMap() = default;
+
+	/** Insert the entries, keeping the first of duplicated keys as ``std::map`` does. */
+	FlatMap(std::initializer_list<value_type> entries) {
+		m_entries.reserve(entries.size());
+		for (auto const& [key, value] : entries) {
+			emplace(key, value);
+		}
+	}
+
+	[[nodiscard]] auto begin() noexcept -> iterator { return m_entries.begin(); }
+	[[nodiscard]] auto begin() const noexcept -> const_iterator { return m_entries.begin(); }
+	[[nodiscard]] auto cbegin() const noexcept -> const_iterator { return m_entries.cbegin(); }
+	[[nodiscard]] auto end() noexcept -> iterator { return m_entries.end(); }
+	[[nodiscard]] auto end() const noexcept -> const_iterator { return m_entries.end(); }
+	[[nodiscard]] auto cend() const noexcept -> const_iterator { return m_entries.cend(); }
+
+	[[nodiscard]] auto size() const noexcept -> size_type { return m_entries.size(); }
+	[[nodiscard]] auto empty() const noexcept -> bool { return m_entries.empty(); }
+	[[nodiscard]] auto capacity() const noexcept -> size_type { return m_entries.capacity(); }
+	void reserve(size_type n) { m_entries.reserve(n); }
+	void clear() noexcept { m_entries.clear(); }
+
+	template <typename K> [[nodiscard]] auto find(K const& key) -> iterator {
+		auto const iter = lower_bound(key);
+		return (iter != end() && !m_compare(key, iter->first)) ? iter : end();
+	}
+	template <typename K> [[nodiscard]] auto find(K const& key) const -> const_iterator {
+		auto const iter = lower_bound(key);
+		return (iter != end() && !m_compare(key, iter->first)) ? iter : end();
+	}
+
+	template <typename K> [[nodiscard]] auto contains(K const& key) const -> bool { return find(key) != end(); }
+	template <typename K> [[nodiscard]] auto count(K const& key) const -> size_type { return contains(key) ? 1 : 0; }
+
+	/** @throw std::out_of_range If the key is not in the map. */
+	template <typename K> [[nodiscard]] auto at(K const& key) -> Value& {
+		return const_cast<Value&>(std::as_const(*this).at(key));  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+	}
+	template <typename K> [[nodiscard]] auto at(K const& key) const -> Value const& {
+		auto const iter = find(key);
+		if (iter == end()) {
+			throw std::out_of_range{"Key not found in FlatMap."};
+		}
+		return iter->second;
+	}
+
+	template <typename K> auto operator[](K&& key) -> Value& { return emplace(std::forward<K>(key)).first->second; }
+
+	/** Insert an entry if the key is not already present, constructing the value from the arguments. */
+	template <typename K, typename... Args> auto emplace(K&& key, Args&&... args) -> std::pair<iterator, bool> {
+		return emplace_at(lower_bound(key), std::forward<K>(key), std::forward<Args>(args)...);
+	}
+
+	/** Same as emplace, skipping the binary search when the key belongs right before the hint. */
+	template <typename K, typename... Args> auto emplace_hint(const_iterator hint, K&& key, Args&&... args) -> iterator {
+		auto const fits_before = hint == cend() || m_compare(key, hint->first);
+		auto const fits_after = hint == cbegin() || m_compare(std::prev(hint)->first, key);
+		auto const pos = (fits_before && fits_after) ? begin() + (hint - cbegin()) : lower_bound(key);
+		return emplace_at(pos, std::forward<K>(key), std::forward<Args>(args)...).first;
+	}
+
+	/** Insert an entry, or overwrite the value of an existing key. */
+	template <typename K, typename V> auto insert_or_assign(K&& key, V&& value) -> std::pair<iterator, bool> {
+		auto const pos = lower_bound(key);
+		if (pos != end() && !m_compare(key, pos->first)) {
+			pos->second = std::forward<V>(value);
+			return {pos, false};
+		}
+		return emplace_at(pos, std::forward<K>(key), std::forward<V>(value));
+	}
+
+	/** Remove the entry with given key, returning the number of entries removed. */
+	template <typename K> auto erase(K const& key) -> size_type {
+		auto const iter = find(key);
+		if (iter == end()) {
+			return 0;
+		}
+		m_entries.erase(iter);
+		return 1;
+	}
+
+	[[nodiscard]] friend auto operator==(FlatMap const& a, FlatMap const& b) -> bool {
+		return a.m_entries == b.m_entries;
+	}
+	[[nodiscard]] friend auto operator!=(FlatMap const& a, FlatMap const& b) -> bool { return !(a == b); }
+
+private:
+	container_type m_entries;
+	Compare m_compare{};
+
+	template <typename K> auto lower_bound(K const& key) -> iterator {
+		return std::lower_bound(begin(), end(), key, [this](auto const& entry, auto const& k) {
+			return m_compare(entry.first, k);
+		});
+	}
+	template <typename K> auto lower_bound(K const& key) const -> const_iterator {
+		return std::lower_bound(begin(), end(), key, [this](auto const& entry, auto const& k) {
+			return m_compare(entry.first, k);
+		});
+	}
+
+	/** Emplace at the lower bound position of the key, unless the key is already there. */
+	template <typename K, typename... Args>
+	auto emplace_at(iterator pos, K&& key, Args&&... args) -> std::pair<iterator, bool> {
+		if (pos != end() && !m_compare(key, pos->first)) {
+			return {pos, false};
+		}
+		auto const iter = m_entries.emplace(
+			pos,
+			std::piecewise_construct,
+			std::forward_as_tuple(std::forward<K>(key)),
+			std::forward_as_tuple(std::forward<Args>(args)...));
+		return {iter, true};
+	}
+};
+
+}  // namespace ecole::utility
@@ -0,0 +1,165 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+#include "ecole/export.hpp"
+
+/**
+ * Operational metrics of the process, such as the number of transitions and the time spent extracting observations.
+ *
+ * Metrics live for the whole process in a global registry, from which they are collected, or exported in the text
+ * format of Prometheus.
+ * Registering a metric takes a lock, so hot paths register once and keep the reference, after which updating a metric
+ * is one or two relaxed atomic operations.
+ */
+namespace ecole::utility::metrics {
+
+/** The names and values of the labels of a metric, in the order they are exported. */
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+/** A monotonic count of events. */
+class ECOLE_EXPORT Counter {
+public:
+	void add(std::uint64_t n = 1) noexcept { m_value.fetch_add(n, std::memory_order_relaxed); }
+	[[nodiscard]] auto value() const noexcept -> std::uint64_t { return m_value.load(std::memory_order_relaxed); }
+
+private:
+	std::atomic<std::uint64_t> m_value{0};
+};
+
+/** A value that goes up and down, such as memory in bytes. */
+class ECOLE_EXPORT Gauge {
+public:
+	void add(std::int64_t delta) noexcept { m_value.fetch_add(delta, std::memory_order_relaxed); }
+	void set(std::int64_t value) noexcept { m_value.store(value, std::memory_order_relaxed); }
+	[[nodiscard]] auto value() const noexcept -> std::int64_t { return m_value.load(std::memory_order_relaxed); }
+
+private:
+	std::atomic<std::int64_t> m_value{0};
+};
+
+/**
+ * The part of a gauge owned by one object, removed from the gauge when the object is destroyed.
+ *
+ * Used to sum a quantity over live objects, such as the memory of all models, without keeping a list of them.
+ */
+class ECOLE_EXPORT GaugeShare {
+public:
+	explicit GaugeShare(Gauge& gauge) noexcept : m_gauge{&gauge} {}
+	GaugeShare(GaugeShare&& other) noexcept :
+		m_gauge{other.m_gauge}, m_value{std::exchange(other.m_value, std::int64_t{0})} {}
+	GaugeShare(GaugeShare const&) = delete;
+	auto operator=(GaugeShare&&) -> GaugeShare& = delete;
+	auto operator=(GaugeShare const&) -> GaugeShare& = delete;
+	~GaugeShare() { m_gauge->add(-m_value); }
+
+	/** Replace the contribution of the owner to the gauge. */
+	void set(std::int64_t value) noexcept { m_gauge->add(value - std::exchange(m_value, value)); }
+
+private:
+	Gauge* m_gauge;
+	std::int64_t m_value = 0;
+};
+
+/**
+ * Distribution of durations, in buckets growing by powers of four from one microsecond to about eighteen minutes.
+ *
+ * The counts of the buckets are not cumulative, they are made so when exported.
+ */
+class ECOLE_EXPORT Histogram {
+public:
+	static inline std::size_t constexpr n_bounds = 16;
+
+	/** The inclusive upper bounds of the buckets, in nanoseconds, the last bucket counting longer durations. */
+	static inline constexpr auto bounds_ns = [] {
+		auto bounds = std::array<std::int64_t, n_bounds>{};
+		auto bound = std::int64_t{1000};
+		for (auto& b : bounds) {
+			b = bound;
+			bound *= 4;
+		}
+		return bounds;
+	}();
+
+	void observe(std::chrono::nanoseconds duration) noexcept {
+		auto bucket = std::size_t{0};
+		while (bucket < n_bounds && duration.count() > bounds_ns[bucket]) {
+			++bucket;
+		}
+		m_counts[bucket].fetch_add(1, std::memory_order_relaxed);
+		m_sum_ns.fetch_add(static_cast<std::uint64_t>(duration.count()), std::memory_order_relaxed);
+	}
+
+	/** The number of durations in every bucket, from the shortest. */
+	[[nodiscard]] auto counts() const noexcept -> std::array<std::uint64_t, n_bounds + 1>;
+	/** The number of durations observed. */
+	[[nodiscard]] auto count() const noexcept -> std::uint64_t;
+	/** The sum of the durations observed. */
+	[[nodiscard]] auto sum() const noexcept -> std::chrono::nanoseconds {
+		return std::chrono::nanoseconds{m_sum_ns.load(std::memory_order_relaxed)};
+	}
+
+private:
+	std::array<std::atomic<std::uint64_t>, n_bounds + 1> m_counts{};
+	std::atomic<std::uint64_t> m_sum_ns{0};
+};
+
+/** Observe the time between its construction and destruction in a histogram. */
+class ECOLE_EXPORT ScopedTimer {
+public:
+	explicit ScopedTimer(Histogram& histogram) noexcept :
+		m_histogram{histogram}, m_begin{std::chrono::steady_clock::now()} {}
+	ScopedTimer(ScopedTimer const&) = delete;
+	ScopedTimer(ScopedTimer&&) = delete;
+	auto operator=(ScopedTimer const&) -> ScopedTimer& = delete;
+	auto operator=(ScopedTimer&&) -> ScopedTimer& = delete;
+	~ScopedTimer() { m_histogram.observe(std::chrono::steady_clock::now() - m_begin); }
+
+private:
+	Histogram& m_histogram;
+	std::chrono::steady_clock::time_point m_begin;
+};
+
+/**
+ * Find or register the metric of the given name and labels.
+ *
+ * The reference remains valid for the whole process.
+ * The help is only used when the name is first registered.
+ *
+ * @throw std::invalid_argument If the name is already registered with another type of metric.
+ */
+[[nodiscard]] ECOLE_EXPORT auto counter(std::string_view name, std::string_view help, Labels const& labels = {})
+	-> Counter&;
+[[nodiscard]] ECOLE_EXPORT auto gauge(std::string_view name, std::string_view help, Labels const& labels = {})
+	-> Gauge&;
+[[nodiscard]] ECOLE_EXPORT auto histogram(std::string_view name, std::string_view help, Labels const& labels = {})
+	-> Histogram&;
+
+/** A value of a metric, as exported to Prometheus. */
+struct ECOLE_EXPORT Sample {
+	/** The name of the metric, with the ``_bucket``, ``_sum``, and ``_count`` suffixes for histograms. */
+	std::string name;
+	/** The labels of the metric, with the ``le`` upper bound for histogram buckets. */
+	Labels labels;
+	double value;
+};
+
+/** Read all the metrics, in the order they were registered, histograms in seconds. */
+[[nodiscard]] ECOLE_EXPORT auto collect() -> std::vector<Sample>;
+
+/** Write all the metrics in the text exposition format of Prometheus. */
+[[nodiscard]] ECOLE_EXPORT auto to_prometheus() -> std::string;
+
+/** A readable name of a type, without the namespaces of Ecole, used as a label value. */
+[[nodiscard]] ECOLE_EXPORT auto type_label(std::type_info const& type) -> std::string;
+
+}  // namespace ecole::utility::metrics
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <cstddef>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace ecole::utility {
+
+/**
+ * Bounded pool of objects given back after use so that their memory can be reused.
+ *
+ * Objects are not cleared when released, so containers keep their memory and can be overwritten in place, for
+ * instance by the ``extract_into`` method of observation functions.
+ * The most recently released object is acquired first, as it is the most likely to have the right size.
+ * Objects released to a full pool are destroyed.
+ * The pool can be used concurrently from multiple threads.
+ */
+template <typename T> class RecyclePool {
+public:
+	explicit RecyclePool(std::size_t capacity = 4) : m_capacity{capacity} {}
+
+	/** Take an object from the pool, or a default constructed one if the pool is empty. */
+	auto acquire() -> T {
+		auto const lock = std::lock_guard{m_mutex};
+		if (m_objects.empty()) {
+			return T{};
+		}
+		auto object = std::move(m_objects.back());
+		m_objects.pop_back();
+		return object;
+	}
+
+	/** Give an object back for later reuse. */
+	auto release(T&& object) -> void {
+		auto const lock = std::lock_guard{m_mutex};
+		if (m_objects.size() < m_capacity) {
+			m_objects.push_back(std::move(object));
+		}
+	}
+
+	/** The number of objects currently held in the pool. */
+	[[nodiscard]] auto size() const -> std::size_t {
+		auto const lock = std::lock_guard{m_mutex};
+		return m_objects.size();
+	}
+
+	/** The maximum number of objects held in the pool. */
+	[[nodiscard]] auto capacity() const noexcept -> std::size_t { return m_capacity; }
+
+private:
+	std::vector<T> m_objects;
+	std::size_t m_capacity;
+	mutable std::mutex m_mutex;
+};
+
+}  // namespace ecole::utility
@@ -1,13 +1,26 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cassert>
 #include <cstddef>
+#include <future>
+#include <limits>
+#include <stdexcept>
 #include <tuple>
+#include <vector>
 
+#include <nonstd/span.hpp>
+#include <xtensor/xbuilder.hpp>
 #include <xtensor/xtensor.hpp>
 
+#include "ecole/utility/tensor-view.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
 namespace ecole::utility {
 
+template <typename T, typename Index = std::size_t> struct csr_matrix;
+
 /**
  * Simple coordinate sparse matrix.
  *
@@ -32,9 +45,338 @@ template <typename T> struct coo_matrix {
 
 	[[nodiscard]] auto nnz() const noexcept -> std::size_t { return values.size(); }
 
+	/**
+	 * Convert to the compressed sparse row format, in linear time.
+	 *
+	 * Elements of a row keep their order, so column indices are sorted if elements are sorted by row and column, as
+	 * after sum_duplicates.
+	 *
+	 * @param thread_pool If given, large matrices are converted in parallel on the pool and the calling thread.
+	 * @throw std::invalid_argument If the index type cannot represent the number of non zero elements.
+	 */
+	template <typename Index = std::size_t>
+	[[nodiscard]] auto to_csr(ThreadPool* thread_pool = nullptr) const -> csr_matrix<T, Index>;
+
+	/**
+	 * Convert to the compressed sparse column format, in linear time.
+	 *
+	 * The compressed sparse column layout of a matrix is the compressed sparse row layout of its transpose, which is
+	 * what is returned: ``row_pointers`` index columns, and ``column_indices`` hold row indices.
+	 *
+	 * @see to_csr
+	 */
+	template <typename Index = std::size_t>
+	[[nodiscard]] auto to_csc(ThreadPool* thread_pool = nullptr) const -> csr_matrix<T, Index>;
+
+	[[nodiscard]] auto transpose() const -> coo_matrix;
+
+	/** Sort elements by row then column, and sum the values of elements with the same indices. */
+	[[nodiscard]] auto sum_duplicates(ThreadPool* thread_pool = nullptr) const -> coo_matrix;
+
+	/**
+	 * Keep the elements of the given rows, renumbered by their position in ``rows``.
+	 *
+	 * Elements keep their relative order.
+	 *
+	 * @throw std::invalid_argument If a row is out of bounds or repeated.
+	 */
+	[[nodiscard]] auto select_rows(nonstd::span<std::size_t const> rows) const -> coo_matrix;
+
+	/**
+	 * Keep the elements of the given columns, renumbered by their position in ``cols``.
+	 *
+	 * @see select_rows
+	 */
+	[[nodiscard]] auto select_cols(nonstd::span<std::size_t const> cols) const -> coo_matrix;
+
 	auto operator==(coo_matrix const& other) const -> bool;
 };
 
+/**
+ * Simple compressed sparse row matrix.
+ *
+ * The column indices and values of row ``i`` are stored in the range ``[row_pointers[i], row_pointers[i + 1])``,
+ * hence ``row_pointers`` has one more element than there are rows.
+ * Compared to coo_matrix, row indices are not repeated for every non zero element, and a smaller index type can be
+ * used to further reduce memory usage.
+ *
+ * @tparam T The type of the values.
+ * @tparam Index The integer type of the indices, which must be able to represent the number of non zero elements.
+ */
+template <typename T, typename Index> struct csr_matrix {
+	using value_type = T;
+	using index_type = Index;
+
+	xt::xtensor<value_type, 1> values;
+	xt::xtensor<index_type, 1> column_indices;
+	xt::xtensor<index_type, 1> row_pointers = {0};
+	std::array<std::size_t, 2> shape = {0, 0};
+
+	using Tuple = std::tuple<decltype(values), decltype(column_indices), decltype(row_pointers), decltype(shape)>;
+
+	[[nodiscard]] static auto from_tuple(Tuple t) -> csr_matrix;
+
+	/** Convert a coordinate matrix whose elements are sorted by row index. */
+	[[nodiscard]] static auto from_coo(coo_matrix<T> const& coo) -> csr_matrix;
+
+	[[nodiscard]] auto to_tuple() const& -> Tuple;
+	[[nodiscard]] auto to_tuple() && -> Tuple;
+
+	[[nodiscard]] auto to_coo() const -> coo_matrix<T>;
+
+	[[nodiscard]] auto nnz() const noexcept -> std::size_t { return values.size(); }
+
+	/**
+	 * Transpose the matrix, in linear time.
+	 *
+	 * This is also the conversion to the compressed sparse column format (see coo_matrix::to_csc).
+	 * The column indices of every row of the result are sorted.
+	 *
+	 * @param thread_pool If given, large matrices are transposed in parallel on the pool and the calling thread.
+	 */
+	[[nodiscard]] auto transpose(ThreadPool* thread_pool = nullptr) const -> csr_matrix;
+
+	/** Sort the column indices of every row, and sum the values of elements with the same indices. */
+	[[nodiscard]] auto sum_duplicates(ThreadPool* thread_pool = nullptr) const -> csr_matrix;
+
+	/**
+	 * Keep the given rows, renumbered by their position in ``rows``.
+	 *
+	 * @throw std::invalid_argument If a row is out of bounds or repeated.
+	 */
+	[[nodiscard]] auto select_rows(nonstd::span<std::size_t const> rows) const -> csr_matrix;
+
+	/**
+	 * Keep the elements of the given columns, renumbered by their position in ``cols``.
+	 *
+	 * Elements of a row keep their relative order.
+	 *
+	 * @throw std::invalid_argument If a column is out of bounds or repeated.
+	 */
+	[[nodiscard]] auto select_cols(nonstd::span<std::size_t const> cols) const -> csr_matrix;
+
+	auto operator==(csr_matrix const& other) const -> bool;
+};
+
+/** Read only view of a coo_matrix stored elsewhere. */
+template <typename T> struct coo_matrix_view {
+	using value_type = T;
+
+	tensor_view<value_type, 1> values;
+	tensor_view<std::size_t, 2> indices;
+	std::array<std::size_t, 2> shape = {0, 0};
+
+	[[nodiscard]] auto nnz() const noexcept -> std::size_t { return values.size(); }
+};
+
+/** Read only view of a csr_matrix stored elsewhere. */
+template <typename T, typename Index = std::size_t> struct csr_matrix_view {
+	using value_type = T;
+	using index_type = Index;
+
+	tensor_view<value_type, 1> values;
+	tensor_view<index_type, 1> column_indices;
+	tensor_view<index_type, 1> row_pointers;
+	std::array<std::size_t, 2> shape = {0, 0};
+
+	[[nodiscard]] auto nnz() const noexcept -> std::size_t { return values.size(); }
+};
+
+/******************************************
+ *  Implementation of the sparse kernels  *
+ ******************************************/
+
+namespace internal {
+
+/** Number of elements below which sparse operations are not worth splitting between threads. */
+inline constexpr std::size_t min_parallel_chunk_size = std::size_t{1} << 16U;
+
+/** Number of chunks to split the elements into, one per thread of the pool and the calling thread at most. */
+inline auto n_chunks_for(std::size_t n_elements, ThreadPool const* thread_pool) noexcept -> std::size_t {
+	if (thread_pool == nullptr) {
+		return 1;
+	}
+	return std::clamp<std::size_t>(n_elements / min_parallel_chunk_size, 1, thread_pool->size() + 1);
+}
+
+/**
+ * Call ``func(chunk, begin, end)`` on contiguous chunks of ``[0, n_elements)``.
+ *
+ * Chunks are run in parallel on the pool, and the first one in the calling thread.
+ * The function must not throw.
+ */
+template <typename Function>
+void for_each_chunk(std::size_t n_elements, std::size_t n_chunks, ThreadPool* thread_pool, Function const& func) {
+	auto const run = [&](std::size_t chunk) {
+		func(chunk, n_elements * chunk / n_chunks, n_elements * (chunk + 1) / n_chunks);
+	};
+	auto futures = std::vector<std::future<void>>{};
+	futures.reserve(n_chunks - 1);
+	for (std::size_t chunk = 1; chunk < n_chunks; ++chunk) {
+		futures.push_back(thread_pool->submit([&run, chunk] { run(chunk); }));
+	}
+	run(0);
+	for (auto& fut : futures) {
+		fut.wait();
+	}
+}
+
+/**
+ * Stable counting sort of elements by key, the core of conversions to compressed formats.
+ *
+ * Every chunk of elements counts its keys, from which every chunk knows where to place its elements of every key.
+ *
+ * @param key_of Give the key of an element, smaller than ``n_keys``.
+ * @param place Called as ``place(element, position)`` to move every element to its sorted position, concurrently for
+ *        different elements when run in parallel.
+ * @return The pointers of the compressed format, elements of key ``i`` being placed in
+ *         ``[pointers[i], pointers[i + 1])``.
+ * @throw std::invalid_argument If the index type cannot represent the number of elements.
+ */
+template <typename Index, typename KeyOf, typename Place>
+auto counting_sort(
+	std::size_t n_elements,
+	std::size_t n_keys,
+	KeyOf const& key_of,
+	Place const& place,
+	ThreadPool* thread_pool) -> xt::xtensor<Index, 1> {
+	if (n_elements > static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+		throw std::invalid_argument{"The index type cannot represent the number of non zero elements."};
+	}
+	auto const n_chunks = n_chunks_for(n_elements, thread_pool);
+	// The number of elements of every key in every chunk, then the next position of these elements
+	auto offsets = std::vector<std::size_t>(n_chunks * n_keys, 0);
+	for_each_chunk(n_elements, n_chunks, thread_pool, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+		auto* const counts = offsets.data() + chunk * n_keys;
+		for (auto k = begin; k < end; ++k) {
+			assert(key_of(k) < n_keys);
+			++counts[key_of(k)];
+		}
+	});
+	auto pointers = xt::xtensor<Index, 1>::from_shape({n_keys + 1});
+	auto position = std::size_t{0};
+	for (std::size_t key = 0; key < n_keys; ++key) {
+		pointers(key) = static_cast<Index>(position);
+		for (std::size_t chunk = 0; chunk < n_chunks; ++chunk) {
+			auto& offset = offsets[chunk * n_keys + key];
+			auto const count = offset;
+			offset = position;
+			position += count;
+		}
+	}
+	pointers(n_keys) = static_cast<Index>(position);
+	for_each_chunk(n_elements, n_chunks, thread_pool, [&](std::size_t chunk, std::size_t begin, std::size_t end) {
+		auto* const next = offsets.data() + chunk * n_keys;
+		for (auto k = begin; k < end; ++k) {
+			place(k, next[key_of(k)]++);
+		}
+	});
+	return pointers;
+}
+
+/** Compress the elements of a coordinate matrix along the rows (axis 0) or the columns (axis 1). */
+template <typename Index, typename T>
+auto compress(coo_matrix<T> const& coo, std::size_t axis, ThreadPool* thread_pool) -> csr_matrix<T, Index> {
+	auto const nnz = coo.nnz();
+	auto const other_axis = 1 - axis;
+	auto csr = csr_matrix<T, Index>{
+		decltype(csr_matrix<T, Index>::values)::from_shape({nnz}),
+		decltype(csr_matrix<T, Index>::column_indices)::from_shape({nnz}),
+		{},
+		{coo.shape[axis], coo.shape[other_axis]},
+	};
+	csr.row_pointers = counting_sort<Index>(
+		nnz,
+		coo.shape[axis],
+		[&](std::size_t k) { return coo.indices(axis, k); },
+		[&](std::size_t k, std::size_t pos) {
+			csr.values(pos) = coo.values(k);
+			csr.column_indices(pos) = static_cast<Index>(coo.indices(other_axis, k));
+		},
+		thread_pool);
+	return csr;
+}
+
+/** Sum the values of consecutive elements of a row with the same column, in place. */
+template <typename T, typename Index> void merge_sorted_duplicates(csr_matrix<T, Index>& csr) {
+	auto n_kept = std::size_t{0};
+	auto begin = std::size_t{0};
+	for (std::size_t i = 0; i < csr.shape[0]; ++i) {
+		auto const row_start = n_kept;
+		auto const end = static_cast<std::size_t>(csr.row_pointers(i + 1));
+		for (auto k = begin; k < end; ++k) {
+			if (n_kept > row_start && csr.column_indices(n_kept - 1) == csr.column_indices(k)) {
+				csr.values(n_kept - 1) += csr.values(k);
+			} else {
+				csr.column_indices(n_kept) = csr.column_indices(k);
+				csr.values(n_kept) = csr.values(k);
+				++n_kept;
+			}
+		}
+		csr.row_pointers(i + 1) = static_cast<Index>(n_kept);
+		begin = end;
+	}
+	auto values = decltype(csr.values)::from_shape({n_kept});
+	auto column_indices = decltype(csr.column_indices)::from_shape({n_kept});
+	std::copy_n(csr.values.begin(), n_kept, values.begin());
+	std::copy_n(csr.column_indices.begin(), n_kept, column_indices.begin());
+	csr.values = std::move(values);
+	csr.column_indices = std::move(column_indices);
+}
+
+inline constexpr auto not_selected = std::numeric_limits<std::size_t>::max();
+
+/**
+ * Map indices of a dimension to their position among the selected ones, or not_selected.
+ *
+ * @throw std::invalid_argument If a selected index is out of bounds or repeated.
+ */
+inline auto selection_positions(nonstd::span<std::size_t const> selected, std::size_t size)
+	-> std::vector<std::size_t> {
+	auto positions = std::vector<std::size_t>(size, not_selected);
+	for (std::size_t i = 0; i < selected.size(); ++i) {
+		if (selected[i] >= size) {
+			throw std::invalid_argument{"Selected index is out of the bounds of the matrix."};
+		}
+		if (positions[selected[i]] != not_selected) {
+			throw std::invalid_argument{"Selected index is repeated."};
+		}
+		positions[selected[i]] = i;
+	}
+	return positions;
+}
+
+/** Keep the elements of a coordinate matrix selected in the given axis. */
+template <typename T>
+auto select(coo_matrix<T> const& coo, std::size_t axis, nonstd::span<std::size_t const> selected) -> coo_matrix<T> {
+	auto const positions = selection_positions(selected, coo.shape[axis]);
+	auto n_kept = std::size_t{0};
+	for (std::size_t k = 0; k < coo.nnz(); ++k) {
+		if (positions[coo.indices(axis, k)] != not_selected) {
+			++n_kept;
+		}
+	}
+	auto result = coo_matrix<T>{
+		decltype(coo.values)::from_shape({n_kept}),
+		decltype(coo.indices)::from_shape({2, n_kept}),
+		coo.shape,
+	};
+	result.shape[axis] = selected.size();
+	auto const other_axis = 1 - axis;
+	auto pos = std::size_t{0};
+	for (std::size_t k = 0; k < coo.nnz(); ++k) {
+		if (auto const new_idx = positions[coo.indices(axis, k)]; new_idx != not_selected) {
+			result.values(pos) = coo.values(k);
+			result.indices(axis, pos) = new_idx;
+			result.indices(other_axis, pos) = coo.indices(other_axis, k);
+			++pos;
+		}
+	}
+	return result;
+}
+
+}  // namespace internal
+
 /**********************************
  *  Implementation of coo_matrix  *
  **********************************/
@@ -50,8 +392,180 @@ template <typename T> auto coo_matrix<T>::to_tuple() && -> Tuple {
 	return {std::move(values), std::move(indices), shape};
 }
 
+template <typename T>
+template <typename Index>
+auto coo_matrix<T>::to_csr(ThreadPool* thread_pool) const -> csr_matrix<T, Index> {
+	return internal::compress<Index>(*this, 0, thread_pool);
+}
+
+template <typename T>
+template <typename Index>
+auto coo_matrix<T>::to_csc(ThreadPool* thread_pool) const -> csr_matrix<T, Index> {
+	return internal::compress<Index>(*this, 1, thread_pool);
+}
+
+template <typename T> auto coo_matrix<T>::transpose() const -> coo_matrix {
+	auto transposed = coo_matrix{values, decltype(indices)::from_shape({2, nnz()}), {shape[1], shape[0]}};
+	for (std::size_t k = 0; k < nnz(); ++k) {
+		transposed.indices(0, k) = indices(1, k);
+		transposed.indices(1, k) = indices(0, k);
+	}
+	return transposed;
+}
+
+template <typename T> auto coo_matrix<T>::sum_duplicates(ThreadPool* thread_pool) const -> coo_matrix {
+	// Transposing the compressed columns sorts the column indices of every row
+	auto csr = to_csc(thread_pool).transpose(thread_pool);
+	internal::merge_sorted_duplicates(csr);
+	return csr.to_coo();
+}
+
+template <typename T> auto coo_matrix<T>::select_rows(nonstd::span<std::size_t const> rows) const -> coo_matrix {
+	return internal::select(*this, 0, rows);
+}
+
+template <typename T> auto coo_matrix<T>::select_cols(nonstd::span<std::size_t const> cols) const -> coo_matrix {
+	return internal::select(*this, 1, cols);
+}
+
 template <typename T> auto coo_matrix<T>::operator==(coo_matrix const& other) const -> bool {
 	return std::tie(values, indices, shape) == std::tie(other.values, other.indices, other.shape);
 }
 
+/**********************************
+ *  Implementation of csr_matrix  *
+ **********************************/
+
+template <typename T, typename I> auto csr_matrix<T, I>::from_tuple(Tuple t) -> csr_matrix {
+	return std::apply([](auto&&... vals) { return csr_matrix{std::forward<decltype(vals)>(vals)...}; }, std::move(t));
+}
+
+template <typename T, typename I> auto csr_matrix<T, I>::from_coo(coo_matrix<T> const& coo) -> csr_matrix {
+	auto const nnz = coo.nnz();
+	auto csr = csr_matrix{
+		coo.values,
+		decltype(column_indices)::from_shape({nnz}),
+		xt::zeros<index_type>({coo.shape[0] + 1}),
+		coo.shape,
+	};
+	for (std::size_t k = 0; k < nnz; ++k) {
+		assert((k == 0) || (coo.indices(0, k - 1) <= coo.indices(0, k)));
+		csr.column_indices(k) = static_cast<index_type>(coo.indices(1, k));
+		++csr.row_pointers(coo.indices(0, k) + 1);
+	}
+	for (std::size_t i = 0; i < coo.shape[0]; ++i) {
+		csr.row_pointers(i + 1) += csr.row_pointers(i);
+	}
+	return csr;
+}
+
+template <typename T, typename I> auto csr_matrix<T, I>::to_tuple() const& -> Tuple {
+	return {values, column_indices, row_pointers, shape};
+}
+template <typename T, typename I> auto csr_matrix<T, I>::to_tuple() && -> Tuple {
+	return {std::move(values), std::move(column_indices), std::move(row_pointers), shape};
+}
+
+template <typename T, typename I> auto csr_matrix<T, I>::to_coo() const -> coo_matrix<T> {
+	auto coo = coo_matrix<T>{values, decltype(coo_matrix<T>::indices)::from_shape({2, nnz()}), shape};
+	for (std::size_t i = 0; i + 1 < row_pointers.size(); ++i) {
+		for (auto k = static_cast<std::size_t>(row_pointers(i)); k < static_cast<std::size_t>(row_pointers(i + 1)); ++k) {
+			coo.indices(0, k) = i;
+			coo.indices(1, k) = static_cast<std::size_t>(column_indices(k));
+		}
+	}
+	return coo;
+}
+
+template <typename T, typename I> auto csr_matrix<T, I>::transpose(ThreadPool* thread_pool) const -> csr_matrix {
+	// The row of every element, which the counting sort needs independently of the others
+	auto rows = std::vector<I>(nnz());
+	for (std::size_t i = 0; i < shape[0]; ++i) {
+		std::fill(
+			rows.begin() + static_cast<std::ptrdiff_t>(row_pointers(i)),
+			rows.begin() + static_cast<std::ptrdiff_t>(row_pointers(i + 1)),
+			static_cast<I>(i));
+	}
+	auto transposed = csr_matrix{
+		decltype(values)::from_shape({nnz()}),
+		decltype(column_indices)::from_shape({nnz()}),
+		{},
+		{shape[1], shape[0]},
+	};
+	transposed.row_pointers = internal::counting_sort<I>(
+		nnz(),
+		shape[1],
+		[&](std::size_t k) { return static_cast<std::size_t>(column_indices(k)); },
+		[&](std::size_t k, std::size_t pos) {
+			transposed.values(pos) = values(k);
+			transposed.column_indices(pos) = rows[k];
+		},
+		thread_pool);
+	return transposed;
+}
+
+template <typename T, typename I> auto csr_matrix<T, I>::sum_duplicates(ThreadPool* thread_pool) const -> csr_matrix {
+	auto sorted = transpose(thread_pool).transpose(thread_pool);
+	internal::merge_sorted_duplicates(sorted);
+	return sorted;
+}
+
+template <typename T, typename I>
+auto csr_matrix<T, I>::select_rows(nonstd::span<std::size_t const> rows) const -> csr_matrix {
+	internal::selection_positions(rows, shape[0]);
+	auto selected = csr_matrix{{}, {}, decltype(row_pointers)::from_shape({rows.size() + 1}), {rows.size(), shape[1]}};
+	selected.row_pointers(0) = 0;
+	for (std::size_t i = 0; i < rows.size(); ++i) {
+		selected.row_pointers(i + 1) =
+			static_cast<I>(selected.row_pointers(i) + row_pointers(rows[i] + 1) - row_pointers(rows[i]));
+	}
+	auto const n_kept = static_cast<std::size_t>(selected.row_pointers(rows.size()));
+	selected.values = decltype(values)::from_shape({n_kept});
+	selected.column_indices = decltype(column_indices)::from_shape({n_kept});
+	for (std::size_t i = 0; i < rows.size(); ++i) {
+		auto const begin = static_cast<std::ptrdiff_t>(row_pointers(rows[i]));
+		auto const end = static_cast<std::ptrdiff_t>(row_pointers(rows[i] + 1));
+		auto const dest = static_cast<std::ptrdiff_t>(selected.row_pointers(i));
+		std::copy(values.begin() + begin, values.begin() + end, selected.values.begin() + dest);
+		std::copy(column_indices.begin() + begin, column_indices.begin() + end, selected.column_indices.begin() + dest);
+	}
+	return selected;
+}
+
+template <typename T, typename I>
+auto csr_matrix<T, I>::select_cols(nonstd::span<std::size_t const> cols) const -> csr_matrix {
+	auto const positions = internal::selection_positions(cols, shape[1]);
+	auto const is_kept = [&](std::size_t k) {
+		return positions[static_cast<std::size_t>(column_indices(k))] != internal::not_selected;
+	};
+	auto selected = csr_matrix{{}, {}, decltype(row_pointers)::from_shape({shape[0] + 1}), {shape[0], cols.size()}};
+	selected.row_pointers(0) = 0;
+	for (std::size_t i = 0; i < shape[0]; ++i) {
+		auto n_kept = selected.row_pointers(i);
+		for (auto k = static_cast<std::size_t>(row_pointers(i)); k < static_cast<std::size_t>(row_pointers(i + 1)); ++k) {
+			if (is_kept(k)) {
+				++n_kept;
+			}
+		}
+		selected.row_pointers(i + 1) = n_kept;
+	}
+	auto const n_kept = static_cast<std::size_t>(selected.row_pointers(shape[0]));
+	selected.values = decltype(values)::from_shape({n_kept});
+	selected.column_indices = decltype(column_indices)::from_shape({n_kept});
+	auto pos = std::size_t{0};
+	for (std::size_t k = 0; k < nnz(); ++k) {
+		if (is_kept(k)) {
+			selected.values(pos) = values(k);
+			selected.column_indices(pos) = static_cast<I>(positions[static_cast<std::size_t>(column_indices(k))]);
+			++pos;
+		}
+	}
+	return selected;
+}
+
+template <typename T, typename I> auto csr_matrix<T, I>::operator==(csr_matrix const& other) const -> bool {
+	return std::tie(values, column_indices, row_pointers, shape) ==
+				 std::tie(other.values, other.column_indices, other.row_pointers, other.shape);
+}
+
 }  // namespace ecole::utility
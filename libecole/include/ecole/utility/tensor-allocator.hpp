@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <memory_resource>
+#include <type_traits>
+
+#include "ecole/export.hpp"
+
+/**
+ * Allocation of the memory of tensors through a user supplied memory resource.
+ *
+ * When Ecole is built with ``ECOLE_TENSOR_ALLOCATOR``, this header is included in every translation unit and
+ * TensorAllocator becomes the default allocator of xtensor, so that the tensors of observations, action sets, and all
+ * other xtensor containers get their memory from tensor_memory_resource.
+ * This is the place to plug an arena, a NUMA local allocator, or pinned host memory for direct upload to a GPU.
+ * This header must hence not include xtensor.
+ */
+namespace ecole::utility {
+
+/**
+ * The memory resource used by tensors created now by the current thread.
+ *
+ * Defaults to ``std::pmr::new_delete_resource``.
+ */
+ECOLE_EXPORT auto tensor_memory_resource() noexcept -> std::pmr::memory_resource*;
+
+/**
+ * Set the memory resource used by tensors created from now on, by all threads.
+ *
+ * Existing tensors keep the resource they were created with, which must outlive them.
+ *
+ * @param resource The new resource, or null to restore the default one.
+ * @return The previous resource.
+ */
+ECOLE_EXPORT auto set_tensor_memory_resource(std::pmr::memory_resource* resource) noexcept
+	-> std::pmr::memory_resource*;
+
+/**
+ * Use a memory resource for the tensors created by the current thread during the lifetime of the object.
+ *
+ * This takes precedence over set_tensor_memory_resource, and is meant for writing a single extraction straight into
+ * a user provided buffer, for instance with a ``std::pmr::monotonic_buffer_resource`` over device mappable memory.
+ */
+class ECOLE_EXPORT ScopedTensorMemoryResource {
+public:
+	ECOLE_EXPORT explicit ScopedTensorMemoryResource(std::pmr::memory_resource* resource) noexcept;
+	ECOLE_EXPORT ~ScopedTensorMemoryResource();
+
+	ScopedTensorMemoryResource(ScopedTensorMemoryResource const&) = delete;
+	ScopedTensorMemoryResource(ScopedTensorMemoryResource&&) = delete;
+	auto operator=(ScopedTensorMemoryResource const&) -> ScopedTensorMemoryResource& = delete;
+	auto operator=(ScopedTensorMemoryResource&&) -> ScopedTensorMemoryResource& = delete;
+
+private:
+	std::pmr::memory_resource* previous;
+};
+
+/**
+ * Standard allocator getting memory from the tensor memory resource.
+ *
+ * The resource is read when the allocator is created and kept in copies, so memory is given back to the resource it
+ * came from, even if the tensor memory resource changed in the meantime.
+ */
+template <typename T> class TensorAllocator {
+public:
+	using value_type = T;
+	/** Memory moved between tensors stays with the allocator able to give it back. */
+	using propagate_on_container_move_assignment = std::true_type;
+	using propagate_on_container_swap = std::true_type;
+
+	TensorAllocator() noexcept : m_resource{tensor_memory_resource()} {}
+	template <typename U> TensorAllocator(TensorAllocator<U> const& other) noexcept : m_resource{other.resource()} {}
+
+	[[nodiscard]] auto allocate(std::size_t n) -> T* {
+		return static_cast<T*>(m_resource->allocate(n * sizeof(T), alignof(T)));
+	}
+
+	void deallocate(T* ptr, std::size_t n) noexcept { m_resource->deallocate(ptr, n * sizeof(T), alignof(T)); }
+
+	/** Copies of tensors use the current resource rather than the resource of the original. */
+	[[nodiscard]] auto select_on_container_copy_construction() const noexcept -> TensorAllocator { return {}; }
+
+	[[nodiscard]] auto resource() const noexcept -> std::pmr::memory_resource* { return m_resource; }
+
+	template <typename U> auto operator==(TensorAllocator<U> const& other) const noexcept -> bool {
+		return m_resource == other.resource() || m_resource->is_equal(*other.resource());
+	}
+	template <typename U> auto operator!=(TensorAllocator<U> const& other) const noexcept -> bool {
+		return !(*this == other);
+	}
+
+private:
+	std::pmr::memory_resource* m_resource;
+};
+
+}  // namespace ecole::utility
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <functional>
+#include <numeric>
+
+#include <xtensor/xadapt.hpp>
+
+namespace ecole::utility {
+
+/**
+ * Read only view of a row major tensor stored elsewhere.
+ *
+ * Unlike xtensor adaptors, the view is a regular type that can be copied and assigned, rebinding the view.
+ * The memory viewed must outlive the view.
+ */
+template <typename T, std::size_t N> struct tensor_view {
+	using value_type = T;
+
+	T const* data = nullptr;
+	std::array<std::size_t, N> shape = {};
+
+	[[nodiscard]] auto size() const noexcept -> std::size_t {
+		return std::accumulate(shape.begin(), shape.end(), std::size_t{1}, std::multiplies<>{});
+	}
+
+	/** An xtensor expression on the viewed data, without copy. */
+	[[nodiscard]] auto adapt() const { return xt::adapt(data, size(), xt::no_ownership(), shape); }
+};
+
+}  // namespace ecole::utility
@@ -0,0 +1,285 @@
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ecole/export.hpp"
+#include "ecole/threads.hpp"
+
+namespace ecole::utility {
+
+/**
+ * Counts a thread created by Ecole, in all binaries (see ecole::n_running_threads).
+ *
+ * It is created before the thread, and moved in the function the thread runs, so that the thread is counted from its
+ * creation until the end of that function.
+ */
+class ECOLE_EXPORT RunningThread {
+public:
+	ECOLE_EXPORT RunningThread() noexcept;
+	ECOLE_EXPORT RunningThread(RunningThread&& other) noexcept;
+	RunningThread(RunningThread const&) = delete;
+	auto operator=(RunningThread const&) -> RunningThread& = delete;
+	auto operator=(RunningThread&&) -> RunningThread& = delete;
+	ECOLE_EXPORT ~RunningThread() noexcept;
+
+	/** The number of threads counted. */
+	[[nodiscard]] ECOLE_EXPORT static auto count() noexcept -> std::size_t;
+
+private:
+	bool m_counted = true;
+};
+
+/**
+ * Fixed size pool of worker threads executing tasks in submission order.
+ *
+ * Threads are created once upon construction and reused for every task, hence avoiding the cost of spawning a new
+ * thread for each piece of work.
+ * Tasks left in the queue when the pool is destroyed are still executed before the workers are joined.
+ */
+class ThreadPool {
+public:
+	/** Number of threads used when none is specified, as set by ecole::set_n_threads. */
+	static auto default_n_threads() noexcept -> std::size_t;
+
+	/**
+	 * Whether the calling thread is a worker of a ThreadPool.
+	 *
+	 * Parallel features called from a worker, such as observation functions of the environments of a
+	 * VectorEnvironment, run sequentially so as not to oversubscribe the cores, nor to wait on tasks queued behind
+	 * their own.
+	 */
+	[[nodiscard]] ECOLE_EXPORT static auto in_worker_thread() noexcept -> bool;
+
+	/** Create the pool and start the worker threads. */
+	explicit ThreadPool(std::size_t n_threads = default_n_threads());
+	ThreadPool(ThreadPool const&) = delete;
+	ThreadPool(ThreadPool&&) = delete;
+	auto operator=(ThreadPool const&) -> ThreadPool& = delete;
+	auto operator=(ThreadPool&&) -> ThreadPool& = delete;
+
+	/** Execute remaining tasks and join worker threads. */
+	~ThreadPool() noexcept;
+
+	/**
+	 * Schedule a task for asynchronous execution.
+	 *
+	 * @return A future holding the result of the task, or the exception it threw.
+	 */
+	template <typename Function> auto submit(Function&& func) -> std::future<std::invoke_result_t<Function>>;
+
+	/** The number of worker threads. */
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return m_workers.size(); }
+
+private:
+	std::vector<std::thread> m_workers;
+	std::deque<std::function<void()>> m_tasks;
+	std::mutex m_tasks_mutex;
+	std::condition_variable m_tasks_signal;
+	bool m_stopping = false;
+
+	ECOLE_EXPORT static auto mark_worker_thread() noexcept -> void;
+	auto worker_loop() -> void;
+};
+
+/**
+ * Pool of threads created on demand and kept alive to be reused by later tasks.
+ *
+ * Contrary to ThreadPool, a task never waits for a thread to become available: a new thread is created when no idle
+ * one exists.
+ * This makes it suitable for long running tasks that block on one another, such as Coroutine executors, while still
+ * amortizing the cost of thread creation.
+ */
+class ThreadCache {
+public:
+	/** A process wide instance. */
+	static auto global() -> ThreadCache&;
+
+	ThreadCache() = default;
+	ThreadCache(ThreadCache const&) = delete;
+	ThreadCache(ThreadCache&&) = delete;
+	auto operator=(ThreadCache const&) -> ThreadCache& = delete;
+	auto operator=(ThreadCache&&) -> ThreadCache& = delete;
+
+	/** Execute remaining tasks and join threads. */
+	~ThreadCache() noexcept;
+
+	/**
+	 * Schedule a task for immediate asynchronous execution.
+	 *
+	 * @return A future holding the result of the task, or the exception it threw.
+	 */
+	template <typename Function> auto submit(Function&& func) -> std::future<std::invoke_result_t<Function>>;
+
+	/** The number of threads created so far. */
+	[[nodiscard]] auto size() -> std::size_t;
+
+private:
+	std::vector<std::thread> m_workers;
+	std::deque<std::function<void()>> m_tasks;
+	std::mutex m_tasks_mutex;
+	std::condition_variable m_tasks_signal;
+	std::size_t m_n_idle = 0;
+	bool m_stopping = false;
+
+	auto mark_idle() -> void;
+	auto worker_loop() -> void;
+};
+
+/**********************************
+ *  Implementation of ThreadPool  *
+ **********************************/
+
+inline auto ThreadPool::default_n_threads() noexcept -> std::size_t {
+	return get_n_threads();
+}
+
+inline ThreadPool::ThreadPool(std::size_t n_threads) {
+	n_threads = n_threads > 0 ? n_threads : 1;
+	m_workers.reserve(n_threads);
+	for (std::size_t i = 0; i < n_threads; ++i) {
+		m_workers.emplace_back([this, running = RunningThread{}] { worker_loop(); });
+	}
+}
+
+inline ThreadPool::~ThreadPool() noexcept {
+	{
+		auto const lk = std::lock_guard{m_tasks_mutex};
+		m_stopping = true;
+	}
+	m_tasks_signal.notify_all();
+	for (auto& worker : m_workers) {
+		worker.join();
+	}
+}
+
+template <typename Function>
+auto ThreadPool::submit(Function&& func) -> std::future<std::invoke_result_t<Function>> {
+	using Result = std::invoke_result_t<Function>;
+	// std::function requires copyable callables, hence the shared_ptr around the move only packaged_task
+	auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Function>(func));
+	auto future = task->get_future();
+	{
+		auto const lk = std::lock_guard{m_tasks_mutex};
+		m_tasks.emplace_back([task = std::move(task)] { (*task)(); });
+	}
+	m_tasks_signal.notify_one();
+	return future;
+}
+
+inline auto ThreadPool::worker_loop() -> void {
+	mark_worker_thread();
+	while (true) {
+		auto task = std::function<void()>{};
+		{
+			auto lk = std::unique_lock{m_tasks_mutex};
+			m_tasks_signal.wait(lk, [this] { return m_stopping || !m_tasks.empty(); });
+			if (m_tasks.empty()) {
+				return;
+			}
+			task = std::move(m_tasks.front());
+			m_tasks.pop_front();
+		}
+		task();
+	}
+}
+
+/***********************************
+ *  Implementation of ThreadCache  *
+ ***********************************/
+
+inline auto ThreadCache::global() -> ThreadCache& {
+	static auto cache = ThreadCache{};
+	return cache;
+}
+
+inline ThreadCache::~ThreadCache() noexcept {
+	{
+		auto const lk = std::lock_guard{m_tasks_mutex};
+		m_stopping = true;
+	}
+	m_tasks_signal.notify_all();
+	for (auto& worker : m_workers) {
+		worker.join();
+	}
+}
+
+template <typename Function>
+auto ThreadCache::submit(Function&& func) -> std::future<std::invoke_result_t<Function>> {
+	using Result = std::invoke_result_t<Function>;
+	struct State {
+		std::decay_t<Function> func;
+		std::promise<Result> promise;
+	};
+	auto state = std::make_shared<State>(State{std::forward<Function>(func), {}});
+	auto future = state->promise.get_future();
+
+	// The thread is marked idle before the result is made available, so that a task submitted as soon as the future
+	// is ready reuses this thread rather than creating a new one.
+	auto task = [this, state = std::move(state)] {
+		try {
+			if constexpr (std::is_void_v<Result>) {
+				state->func();
+				mark_idle();
+				state->promise.set_value();
+			} else {
+				auto result = state->func();
+				mark_idle();
+				state->promise.set_value(std::move(result));
+			}
+		} catch (...) {
+			mark_idle();
+			state->promise.set_exception(std::current_exception());
+		}
+	};
+
+	{
+		auto const lk = std::lock_guard{m_tasks_mutex};
+		m_tasks.emplace_back(std::move(task));
+		// Every queued task must be matched with an idle thread, otherwise it could wait indefinitely
+		if (m_tasks.size() > m_n_idle) {
+			++m_n_idle;
+			m_workers.emplace_back([this, running = RunningThread{}] { worker_loop(); });
+		}
+	}
+	m_tasks_signal.notify_one();
+	return future;
+}
+
+inline auto ThreadCache::size() -> std::size_t {
+	auto const lk = std::lock_guard{m_tasks_mutex};
+	return m_workers.size();
+}
+
+inline auto ThreadCache::mark_idle() -> void {
+	auto const lk = std::lock_guard{m_tasks_mutex};
+	++m_n_idle;
+}
+
+inline auto ThreadCache::worker_loop() -> void {
+	// The thread is counted as idle upon creation, and tasks mark it idle again upon completion
+	auto lk = std::unique_lock{m_tasks_mutex};
+	while (true) {
+		m_tasks_signal.wait(lk, [this] { return m_stopping || !m_tasks.empty(); });
+		if (m_tasks.empty()) {
+			return;
+		}
+		--m_n_idle;
+		auto task = std::move(m_tasks.front());
+		m_tasks.pop_front();
+		lk.unlock();
+		task();
+		lk.lock();
+	}
+}
+
+}  // namespace ecole::utility
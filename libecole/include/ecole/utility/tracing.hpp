@@ -0,0 +1,68 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+
+#include "ecole/export.hpp"
+
+/**
+ * Tracing of the time spent in the main parts of Ecole.
+ *
+ * Spans are only compiled when Ecole is built with ``ECOLE_TRACING``, otherwise ECOLE_TRACE_SPAN expands to nothing.
+ * When compiled, spans are recorded while tracing is started, and written as a Chrome trace (JSON format read by
+ * Perfetto and ``chrome://tracing``) when it is stopped.
+ * Tracing is started when the library is loaded if the ``ECOLE_TRACE_FILE`` environment variable is set, and the
+ * trace is written to that file when the program exits.
+ */
+namespace ecole::utility::tracing {
+
+/** Whether spans are recorded. */
+ECOLE_EXPORT auto is_started() noexcept -> bool;
+
+/** Start recording spans, to be written to the given file, discarding spans that were not written. */
+ECOLE_EXPORT void start(std::string filename);
+
+/** Stop recording spans and write the trace, if it was started. */
+ECOLE_EXPORT void stop();
+
+/** Record the time between its construction and destruction in the current thread. */
+class ECOLE_EXPORT Span {
+public:
+	/** The name must outlive the trace, such as a string literal. */
+	explicit Span(char const* name_) noexcept : name{name_} {
+		if (is_started()) {
+			begin = std::chrono::steady_clock::now();
+		} else {
+			name = nullptr;
+		}
+	}
+	Span(Span const&) = delete;
+	Span(Span&&) = delete;
+	auto operator=(Span const&) -> Span& = delete;
+	auto operator=(Span&&) -> Span& = delete;
+	~Span() {
+		if (name != nullptr) {
+			record(name, begin, std::chrono::steady_clock::now());
+		}
+	}
+
+private:
+	char const* name;
+	std::chrono::steady_clock::time_point begin;
+
+	ECOLE_EXPORT static void
+	record(char const* name, std::chrono::steady_clock::time_point begin, std::chrono::steady_clock::time_point end);
+};
+
+}  // namespace ecole::utility::tracing
+
+#define ECOLE_TRACE_CONCAT_IMPL(a, b) a##b
+#define ECOLE_TRACE_CONCAT(a, b) ECOLE_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef ECOLE_TRACING
+/** Record a span named after the string literal until the end of the enclosing scope. */
+#define ECOLE_TRACE_SPAN(name) \
+	::ecole::utility::tracing::Span const ECOLE_TRACE_CONCAT(ecole_trace_span_, __LINE__) { name }
+#else
+#define ECOLE_TRACE_SPAN(name) static_cast<void>(0)
+#endif
@@ -0,0 +1,107 @@
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#include "ecole/data/normalized.hpp"
+#include "utility/state.hpp"
+
+namespace ecole::data {
+
+namespace {
+
+auto double_bits(double value) noexcept -> std::uint64_t {
+	auto bits = std::uint64_t{0};
+	static_assert(sizeof(bits) == sizeof(value));
+	std::memcpy(&bits, &value, sizeof(value));
+	return bits;
+}
+
+auto bits_double(std::uint64_t bits) noexcept -> double {
+	auto value = 0.;
+	std::memcpy(&value, &bits, sizeof(value));
+	return value;
+}
+
+}  // namespace
+
+FeatureStatistics::FeatureStatistics(std::size_t n_features) :
+	counts(n_features, 0), means(n_features, 0.), squares(n_features, 0.) {}
+
+FeatureStatistics::FeatureStatistics(
+	std::vector<std::uint64_t> counts_,
+	std::vector<double> means_,
+	std::vector<double> squares_) :
+	counts{std::move(counts_)}, means{std::move(means_)}, squares{std::move(squares_)} {
+	if (counts.size() != means.size() || counts.size() != squares.size()) {
+		throw std::invalid_argument{"Feature statistics must have as many counts, means, and squares."};
+	}
+}
+
+void FeatureStatistics::merge(FeatureStatistics const& other) {
+	if (other.n_features() == 0) {
+		return;
+	}
+	if (n_features() == 0) {
+		*this = other;
+		return;
+	}
+	if (other.n_features() != n_features()) {
+		throw std::invalid_argument{"Cannot merge statistics of a different number of features."};
+	}
+	for (std::size_t j = 0; j < n_features(); ++j) {
+		if (other.counts[j] == 0) {
+			continue;
+		}
+		auto const count = static_cast<double>(counts[j]);
+		auto const other_count = static_cast<double>(other.counts[j]);
+		auto const total = count + other_count;
+		auto const delta = other.means[j] - means[j];
+		means[j] += delta * other_count / total;
+		squares[j] += other.squares[j] + delta * delta * count * other_count / total;
+		counts[j] += other.counts[j];
+	}
+}
+
+auto serialize_statistics(std::vector<FeatureStatistics> const& statistics) -> std::string {
+	auto writer = utility::StateWriter{};
+	writer.write(statistics.size());
+	for (auto const& stats : statistics) {
+		writer.write(stats.n_features());
+		for (std::size_t j = 0; j < stats.n_features(); ++j) {
+			writer.write(stats.count(j));
+			writer.write(double_bits(stats.get_means()[j]));
+			writer.write(double_bits(stats.get_squares()[j]));
+		}
+	}
+	return std::move(writer).str();
+}
+
+auto deserialize_statistics(std::string_view data) -> std::vector<FeatureStatistics> {
+	auto reader = utility::StateReader{data};
+	auto const n_matrices = reader.read_integer();
+	// Every matrix takes at least a word, which bounds the sizes read before reserving memory
+	if (n_matrices > data.size()) {
+		throw std::invalid_argument{"Saved statistics are truncated."};
+	}
+	auto statistics = std::vector<FeatureStatistics>{};
+	statistics.reserve(static_cast<std::size_t>(n_matrices));
+	for (std::uint64_t i = 0; i < n_matrices; ++i) {
+		auto const n_features = static_cast<std::size_t>(reader.read_integer());
+		if (n_features > data.size()) {
+			throw std::invalid_argument{"Saved statistics are truncated."};
+		}
+		auto counts = std::vector<std::uint64_t>(n_features);
+		auto means = std::vector<double>(n_features);
+		auto squares = std::vector<double>(n_features);
+		for (std::size_t j = 0; j < n_features; ++j) {
+			counts[j] = reader.read_integer();
+			means[j] = bits_double(reader.read_integer());
+			squares[j] = bits_double(reader.read_integer());
+		}
+		statistics.emplace_back(std::move(counts), std::move(means), std::move(squares));
+	}
+	reader.finish();
+	return statistics;
+}
+
+}  // namespace ecole::data
@@ -0,0 +1,995 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+#include <xtensor/xtensor.hpp>
+#ifdef ECOLE_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+#include "ecole/data/trajectory.hpp"
+#include "ecole/utility/thread-pool.hpp"
+#include "ecole/utility/unreachable.hpp"
+
+namespace ecole::data {
+
+/*
+ * The file starts with a header made of a magic string, the format version, and the size of floating point values.
+ * It is followed by steps, each made of its size in bytes and its serialized content.
+ * Steps start on 8 bytes boundaries, and so do tensor data within steps, so that they can be viewed in place.
+ * When the writer is closed, the offsets of all steps are written, followed by the offset of this index and a second
+ * magic string, so that the reader can find the index from the end of the file.
+ */
+
+namespace {
+
+constexpr auto file_magic = std::array<char, 8>{'E', 'C', 'O', 'L', 'E', 'T', 'R', 'J'};
+constexpr auto index_magic = std::array<char, 8>{'E', 'C', 'O', 'L', 'E', 'I', 'D', 'X'};
+constexpr std::uint32_t format_version = 3;
+/** Files of older versions are still read, since versions only added codecs. */
+constexpr std::uint32_t min_format_version = 2;
+constexpr std::size_t header_size = file_magic.size() + 2 * sizeof(std::uint32_t);
+constexpr std::size_t footer_size = sizeof(std::uint64_t) + index_magic.size();
+constexpr std::size_t alignment = sizeof(std::uint64_t);
+
+auto align(std::size_t offset) noexcept -> std::size_t {
+	return (offset + alignment - 1) / alignment * alignment;
+}
+
+/** How the bytes of a tensor are stored, in the low bits of the codec byte. */
+enum struct Codec : std::uint8_t {
+	raw = 0,
+	/** Bytes are grouped by position in their element, then runs of zeros are replaced by their length. */
+	shuffled_zero_runs = 1,
+	/** Bytes are grouped by position in their element, then compressed with zstd. */
+	shuffled_zstd = 2,
+};
+
+/** Transformations of the elements before their bytes are stored, as flags in the high bits of the codec byte. */
+namespace filter {
+/** Elements of matrices are stored column by column, so that the values of a feature are contiguous. */
+constexpr std::uint8_t columns = 0x10;
+/** Integers are stored as the zigzag encoded differences with the previous element of their row. */
+constexpr std::uint8_t delta = 0x20;
+constexpr std::uint8_t codec_mask = 0x0F;
+}  // namespace filter
+
+/** Zero runs shorter than this are stored as literal bytes. */
+constexpr std::size_t min_zero_run = 4;
+
+[[noreturn]] void throw_corrupted() {
+	throw std::runtime_error{"Trajectory step is corrupted."};
+}
+
+/** Group the bytes of ``n`` elements of size ``width`` by their position in the element. */
+void shuffle(std::byte const* in, std::byte* out, std::size_t n, std::size_t width) noexcept {
+	for (std::size_t i = 0; i < n; ++i) {
+		for (std::size_t b = 0; b < width; ++b) {
+			out[b * n + i] = in[i * width + b];
+		}
+	}
+}
+
+void unshuffle(std::byte const* in, std::byte* out, std::size_t n, std::size_t width) noexcept {
+	for (std::size_t i = 0; i < n; ++i) {
+		for (std::size_t b = 0; b < width; ++b) {
+			out[i * width + b] = in[b * n + i];
+		}
+	}
+}
+
+/** Transpose a row major matrix of ``n_rows`` rows of elements of size ``width``. */
+void transpose(
+	std::byte const* in,
+	std::byte* out,
+	std::size_t n_rows,
+	std::size_t n_cols,
+	std::size_t width) noexcept {
+	for (std::size_t i = 0; i < n_rows; ++i) {
+		for (std::size_t j = 0; j < n_cols; ++j) {
+			std::memcpy(out + (j * n_rows + i) * width, in + (i * n_cols + j) * width, width);
+		}
+	}
+}
+
+/** Map differences to unsigned integers so that small ones are small, as 0, -1, 1, -2, 2, and so on. */
+template <typename U> auto zigzag(U diff) noexcept -> U {
+	constexpr auto sign_shift = static_cast<unsigned>(std::numeric_limits<U>::digits - 1);
+	return static_cast<U>(static_cast<U>(diff << 1U) ^ static_cast<U>(U{0} - (diff >> sign_shift)));
+}
+
+template <typename U> auto unzigzag(U code) noexcept -> U {
+	return static_cast<U>((code >> 1U) ^ static_cast<U>(U{0} - (code & 1U)));
+}
+
+/** Position of the least significant bytes of a 64 bits integer when only ``width`` of them are kept. */
+auto kept_bytes_offset(std::size_t width) noexcept -> std::size_t {
+	auto const one = std::uint64_t{1};
+	auto const little_endian = *reinterpret_cast<std::byte const*>(&one) == std::byte{1};
+	return little_endian ? 0 : sizeof(std::uint64_t) - width;
+}
+
+/** The number of bytes needed to represent an unsigned integer. */
+auto integer_width(std::uint64_t max) noexcept -> std::size_t {
+	if (max <= std::numeric_limits<std::uint8_t>::max()) {
+		return sizeof(std::uint8_t);
+	}
+	if (max <= std::numeric_limits<std::uint16_t>::max()) {
+		return sizeof(std::uint16_t);
+	}
+	if (max <= std::numeric_limits<std::uint32_t>::max()) {
+		return sizeof(std::uint32_t);
+	}
+	return sizeof(std::uint64_t);
+}
+
+/** Append an integer using seven bits per byte, the last bit indicating whether more bytes follow. */
+void append_varint(std::vector<char>& out, std::uint64_t value) {
+	constexpr auto continuation = std::uint64_t{0x80};
+	while (value >= continuation) {
+		out.push_back(static_cast<char>((value & (continuation - 1)) | continuation));
+		value >>= 7U;
+	}
+	out.push_back(static_cast<char>(value));
+}
+
+/** How tensors are encoded by the writer. */
+struct EncoderOptions {
+	bool compress;
+	TrajectoryCompression compression;
+	bool narrow_integers;
+	bool delta_integers;
+};
+
+/** Serialize values at the end of a byte buffer. */
+class Encoder {
+public:
+	Encoder(std::vector<char>& buffer_, EncoderOptions const& options_) noexcept :
+		buffer{buffer_}, begin{buffer_.size()}, options{options_} {}
+
+	template <typename T> void scalar(T value) {
+		static_assert(std::is_trivially_copyable_v<T>);
+		append(&value, sizeof(T));
+	}
+
+	template <std::size_t N> void shape(std::array<std::size_t, N> const& dims) {
+		for (auto const dim : dims) {
+			scalar<std::uint64_t>(dim);
+		}
+	}
+
+	template <typename T, std::size_t N> void tensor(xt::xtensor<T, N> const& values) {
+		for (auto const dim : values.shape()) {
+			scalar<std::uint64_t>(dim);
+		}
+		auto const n_cols = values.shape(N - 1);
+		if constexpr (std::is_integral_v<T>) {
+			integers(values.data(), values.size(), n_cols);
+		} else if (options.compress && N == 2 && n_cols > 1) {
+			transposed.resize(values.size() * sizeof(T));
+			transpose(
+				reinterpret_cast<std::byte const*>(values.data()), transposed.data(), values.shape(0), n_cols, sizeof(T));
+			block(transposed.data(), values.size(), sizeof(T), filter::columns);
+		} else {
+			block(reinterpret_cast<std::byte const*>(values.data()), values.size(), sizeof(T), 0);
+		}
+	}
+
+private:
+	std::vector<char>& buffer;
+	/** Where the step starts in the buffer, from which data are aligned. */
+	std::size_t begin;
+	EncoderOptions options;
+	std::vector<std::uint64_t> deltas;
+	std::vector<std::byte> narrowed;
+	std::vector<std::byte> transposed;
+	std::vector<std::byte> shuffled;
+	std::vector<char> encoded;
+
+	void append(void const* bytes, std::size_t n) {
+		auto const* const begin = static_cast<char const*>(bytes);
+		buffer.insert(buffer.end(), begin, begin + n);
+	}
+
+	/** Store integers, or their differences in rows of ``n_cols``, with the smallest width that represents them. */
+	template <typename T> void integers(T const* values, std::size_t n, std::size_t n_cols) {
+		using Unsigned = std::make_unsigned_t<T>;
+		if (options.delta_integers && n > 0) {
+			// Differences are taken modulo the integer type, so they never need more bytes than the values
+			deltas.resize(n);
+			auto max_value = Unsigned{0};
+			auto max_delta = Unsigned{0};
+			for (std::size_t i = 0; i < n; ++i) {
+				auto const value = static_cast<Unsigned>(values[i]);
+				auto const previous = (i % n_cols == 0) ? Unsigned{0} : static_cast<Unsigned>(values[i - 1]);
+				auto const delta = zigzag(static_cast<Unsigned>(value - previous));
+				deltas[i] = delta;
+				max_value = std::max(max_value, value);
+				max_delta = std::max(max_delta, delta);
+			}
+			if (max_delta < max_value) {
+				auto const width = options.narrow_integers ? integer_width(max_delta) : sizeof(T);
+				return narrow(deltas.data(), n, width, filter::delta);
+			}
+		}
+		auto width = sizeof(T);
+		auto non_negative = options.narrow_integers;
+		if constexpr (std::is_signed_v<T>) {
+			non_negative = non_negative && std::all_of(values, values + n, [](auto val) { return val >= 0; });
+		}
+		if (non_negative) {
+			auto const max = static_cast<std::uint64_t>(n > 0 ? *std::max_element(values, values + n) : 0);
+			width = std::min(integer_width(max), sizeof(T));
+		}
+		narrow(values, n, width, 0);
+	}
+
+	/** Store the ``width`` least significant bytes of integers that fit in them. */
+	template <typename Int> void narrow(Int const* values, std::size_t n, std::size_t width, std::uint8_t filters) {
+		if (width == sizeof(Int)) {
+			return block(reinterpret_cast<std::byte const*>(values), n, width, filters);
+		}
+		narrowed.resize(n * width);
+		auto const shift = kept_bytes_offset(width);
+		for (std::size_t i = 0; i < n; ++i) {
+			auto const val = static_cast<std::uint64_t>(values[i]);
+			std::memcpy(narrowed.data() + i * width, reinterpret_cast<std::byte const*>(&val) + shift, width);
+		}
+		block(narrowed.data(), n, width, filters);
+	}
+
+	void block(std::byte const* bytes, std::size_t n, std::size_t width, std::uint8_t filters) {
+		auto const n_bytes = n * width;
+		scalar(static_cast<std::uint8_t>(width));
+		if (options.compress && n_bytes > 0) {
+			shuffled.resize(n_bytes);
+			shuffle(bytes, shuffled.data(), n, width);
+			auto const codec = compress(shuffled.data(), n_bytes);
+			if (encoded.size() < n_bytes) {
+				scalar(static_cast<std::uint8_t>(static_cast<std::uint8_t>(codec) | filters));
+				scalar<std::uint64_t>(encoded.size());
+				pad();
+				append(encoded.data(), encoded.size());
+				return;
+			}
+		}
+		scalar(static_cast<std::uint8_t>(static_cast<std::uint8_t>(Codec::raw) | filters));
+		scalar<std::uint64_t>(n_bytes);
+		pad();
+		append(bytes, n_bytes);
+	}
+
+	void pad() { buffer.resize(begin + align(buffer.size() - begin), 0); }
+
+	/** Compress shuffled bytes in ``encoded``. */
+	auto compress(std::byte const* bytes, std::size_t n) -> Codec {
+		if (options.compression == TrajectoryCompression::zstd) {
+			encode_zstd(bytes, n);
+			return Codec::shuffled_zstd;
+		}
+		encode_zero_runs(bytes, n);
+		return Codec::shuffled_zero_runs;
+	}
+
+	/** Tokens are a varint ``2k`` followed by ``k`` literal bytes, or a varint ``2k + 1`` for ``k`` zeros. */
+	void encode_zero_runs(std::byte const* bytes, std::size_t n) {
+		encoded.clear();
+		auto flush_literal = [&](std::size_t begin, std::size_t end) {
+			if (end > begin) {
+				append_varint(encoded, 2 * (end - begin));
+				auto const* const chars = reinterpret_cast<char const*>(bytes);
+				encoded.insert(encoded.end(), chars + begin, chars + end);
+			}
+		};
+		std::size_t literal_begin = 0;
+		std::size_t i = 0;
+		while (i < n) {
+			if (bytes[i] != std::byte{0}) {
+				++i;
+				continue;
+			}
+			auto run_end = i;
+			while (run_end < n && bytes[run_end] == std::byte{0}) {
+				++run_end;
+			}
+			if (run_end - i >= min_zero_run || run_end == n) {
+				flush_literal(literal_begin, i);
+				append_varint(encoded, 2 * (run_end - i) + 1);
+				literal_begin = run_end;
+			}
+			i = run_end;
+		}
+		flush_literal(literal_begin, n);
+	}
+
+	void encode_zstd([[maybe_unused]] std::byte const* bytes, [[maybe_unused]] std::size_t n) {
+#ifdef ECOLE_HAS_ZSTD
+		encoded.resize(ZSTD_compressBound(n));
+		auto const size = ZSTD_compress(encoded.data(), encoded.size(), bytes, n, ZSTD_CLEVEL_DEFAULT);
+		if (ZSTD_isError(size) != 0) {
+			throw std::runtime_error{fmt::format("Could not compress trajectory step: {}.", ZSTD_getErrorName(size))};
+		}
+		encoded.resize(size);
+#else
+		utility::unreachable();
+#endif
+	}
+};
+
+/** Deserialize values from a byte range, checking that the range is not overrun. */
+class Decoder {
+public:
+	Decoder(std::byte const* begin_, std::byte const* end_) noexcept : begin{begin_}, pos{begin_}, end{end_} {}
+
+	template <typename T> auto scalar() -> T {
+		static_assert(std::is_trivially_copyable_v<T>);
+		auto value = T{};
+		std::memcpy(&value, take(sizeof(T)), sizeof(T));
+		return value;
+	}
+
+	template <std::size_t N> auto shape() -> std::array<std::size_t, N> {
+		auto dims = std::array<std::size_t, N>{};
+		for (auto& dim : dims) {
+			dim = static_cast<std::size_t>(scalar<std::uint64_t>());
+		}
+		return dims;
+	}
+
+	template <typename T, std::size_t N> auto tensor() -> xt::xtensor<T, N> {
+		auto const dims = shape<N>();
+		auto const n = checked_size<T>(dims);
+		auto values = xt::xtensor<T, N>::from_shape(dims);
+		decode(block<T>(n, dims), values.data(), n);
+		return values;
+	}
+
+	/** View the tensor in place if possible, otherwise decode it in a buffer allocated with ``allocate``. */
+	template <typename T, std::size_t N, typename Allocate>
+	auto tensor_view(Allocate&& allocate) -> utility::tensor_view<T, N> {
+		auto const dims = shape<N>();
+		auto const n = checked_size<T>(dims);
+		auto const data = block<T>(n, dims);
+		auto const aligned = reinterpret_cast<std::uintptr_t>(data.bytes) % alignof(T) == 0;
+		if (data.codec == Codec::raw && data.filters == 0 && data.width == sizeof(T) && aligned) {
+			return {reinterpret_cast<T const*>(data.bytes), dims};
+		}
+		auto* const values = static_cast<T*>(allocate(n * sizeof(T)));
+		decode(data, values, n);
+		return {values, dims};
+	}
+
+	[[nodiscard]] auto done() const noexcept -> bool { return pos == end; }
+
+private:
+	/** The location and encoding of the data of a tensor. */
+	struct Block {
+		std::size_t width;
+		Codec codec;
+		std::uint8_t filters;
+		std::byte const* bytes;
+		std::size_t size;
+		/** The number of elements in the last dimension of the tensor. */
+		std::size_t n_cols;
+	};
+
+	std::byte const* begin;
+	std::byte const* pos;
+	std::byte const* end;
+	std::vector<std::byte> decoded;
+	std::vector<std::byte> unshuffled;
+	std::vector<std::byte> transposed;
+
+	auto take(std::size_t n) -> std::byte const* {
+		if (static_cast<std::size_t>(end - pos) < n) {
+			throw_corrupted();
+		}
+		auto const* const begin = pos;
+		pos += n;
+		return begin;
+	}
+
+	template <typename T, std::size_t N> static auto checked_size(std::array<std::size_t, N> const& dims) -> std::size_t {
+		std::size_t n = 1;
+		for (auto const dim : dims) {
+			if (dim != 0 && n > std::numeric_limits<std::size_t>::max() / sizeof(T) / dim) {
+				throw_corrupted();
+			}
+			n *= dim;
+		}
+		return n;
+	}
+
+	/** Read the header of the data of the ``n`` elements of a tensor and skip over the data. */
+	template <typename T, std::size_t N> auto block(std::size_t n, std::array<std::size_t, N> const& dims) -> Block {
+		auto const width = static_cast<std::size_t>(scalar<std::uint8_t>());
+		auto const codec_byte = scalar<std::uint8_t>();
+		auto const codec = static_cast<Codec>(codec_byte & filter::codec_mask);
+		auto const filters = static_cast<std::uint8_t>(codec_byte & ~filter::codec_mask);
+		auto const size = static_cast<std::size_t>(scalar<std::uint64_t>());
+		take(align(static_cast<std::size_t>(pos - begin)) - static_cast<std::size_t>(pos - begin));
+		auto const* const bytes = take(size);
+		if ((width > sizeof(T)) || (width < sizeof(T) && !std::is_integral_v<T>) || (width == 0 && n > 0)) {
+			throw_corrupted();
+		}
+		if ((codec != Codec::raw && codec != Codec::shuffled_zero_runs && codec != Codec::shuffled_zstd) ||
+			(codec == Codec::raw && size != n * width)) {
+			throw_corrupted();
+		}
+		auto const valid_filters = static_cast<std::uint8_t>(
+			((N == 2 && width == sizeof(T)) ? filter::columns : 0) | (std::is_integral_v<T> ? filter::delta : 0));
+		if ((filters & ~valid_filters) != 0) {
+			throw_corrupted();
+		}
+		return {width, codec, filters, bytes, size, dims[N - 1]};
+	}
+
+	template <typename T> void decode(Block const& data, T* out, std::size_t n) {
+		auto const width = data.width;
+		auto const n_bytes = n * width;
+		auto const* bytes = data.bytes;
+		if (data.codec != Codec::raw) {
+			if (data.codec == Codec::shuffled_zstd) {
+				decode_zstd(bytes, data.size, n_bytes);
+			} else {
+				decode_zero_runs(bytes, data.size, n_bytes);
+			}
+			unshuffled.resize(n_bytes);
+			unshuffle(decoded.data(), unshuffled.data(), n, width);
+			bytes = unshuffled.data();
+		}
+		if ((data.filters & filter::columns) != 0 && n > 0) {
+			transposed.resize(n_bytes);
+			transpose(bytes, transposed.data(), data.n_cols, n / data.n_cols, width);
+			bytes = transposed.data();
+		}
+
+		if (width == sizeof(T)) {
+			std::memcpy(out, bytes, n_bytes);
+		} else {
+			auto const shift = kept_bytes_offset(width);
+			for (std::size_t i = 0; i < n; ++i) {
+				auto val = std::uint64_t{0};
+				std::memcpy(reinterpret_cast<std::byte*>(&val) + shift, bytes + i * width, width);
+				out[i] = static_cast<T>(val);
+			}
+		}
+		if constexpr (std::is_integral_v<T>) {
+			if ((data.filters & filter::delta) != 0) {
+				using Unsigned = std::make_unsigned_t<T>;
+				auto previous = Unsigned{0};
+				for (std::size_t i = 0; i < n; ++i) {
+					previous = (i % data.n_cols == 0) ? Unsigned{0} : previous;
+					previous = static_cast<Unsigned>(previous + unzigzag(static_cast<Unsigned>(out[i])));
+					out[i] = static_cast<T>(previous);
+				}
+			}
+		}
+	}
+
+	void decode_zero_runs(std::byte const* bytes, std::size_t size, std::size_t n_bytes) {
+		decoded.clear();
+		decoded.reserve(n_bytes);
+		auto sub = Decoder{bytes, bytes + size};
+		while (!sub.done()) {
+			auto const token = sub.varint();
+			auto const length = static_cast<std::size_t>(token / 2);
+			if (length > n_bytes - decoded.size()) {
+				throw_corrupted();
+			}
+			if (token % 2 == 1) {
+				decoded.resize(decoded.size() + length, std::byte{0});
+			} else {
+				auto const* const literal = sub.take(length);
+				decoded.insert(decoded.end(), literal, literal + length);
+			}
+		}
+		if (decoded.size() != n_bytes) {
+			throw_corrupted();
+		}
+	}
+
+	void decode_zstd(
+		[[maybe_unused]] std::byte const* bytes,
+		[[maybe_unused]] std::size_t size,
+		[[maybe_unused]] std::size_t n_bytes) {
+#ifdef ECOLE_HAS_ZSTD
+		decoded.resize(n_bytes);
+		auto const decoded_size = ZSTD_decompress(decoded.data(), n_bytes, bytes, size);
+		if (ZSTD_isError(decoded_size) != 0 || decoded_size != n_bytes) {
+			throw_corrupted();
+		}
+#else
+		throw std::runtime_error{"Cannot read a trajectory compressed with zstd, Ecole was built without zstd."};
+#endif
+	}
+
+	auto varint() -> std::uint64_t {
+		auto value = std::uint64_t{0};
+		for (unsigned shift = 0; shift < 64; shift += 7) {
+			auto const byte = std::to_integer<std::uint64_t>(*take(1));
+			value |= (byte & 0x7FU) << shift;
+			if ((byte & 0x80U) == 0) {
+				return value;
+			}
+		}
+		throw_corrupted();
+	}
+};
+
+template <typename Value>
+void encode_step(
+	Encoder& encoder,
+	observation::BasicNodeBipartiteObs<Value> const& obs,
+	xt::xtensor<std::size_t, 1> const& action_set,
+	std::size_t action,
+	double reward) {
+	encoder.tensor(obs.variable_features);
+	encoder.tensor(obs.row_features);
+	encoder.tensor(obs.edge_features.values);
+	encoder.tensor(obs.edge_features.indices);
+	encoder.shape(obs.edge_features.shape);
+	encoder.tensor(obs.edge_features_csr.values);
+	encoder.tensor(obs.edge_features_csr.column_indices);
+	encoder.tensor(obs.edge_features_csr.row_pointers);
+	encoder.shape(obs.edge_features_csr.shape);
+	encoder.tensor(action_set);
+	encoder.scalar<std::uint64_t>(action);
+	encoder.scalar(reward);
+}
+
+template <typename Value> auto decode_step(Decoder& decoder) -> BasicTrajectoryStep<Value> {
+	using Step = BasicTrajectoryStep<Value>;
+	using Obs = decltype(Step::observation);
+	auto step = Step{};
+	auto& obs = step.observation;
+	obs.variable_features = decoder.tensor<Value, 2>();
+	obs.row_features = decoder.tensor<Value, 2>();
+	obs.edge_features.values = decoder.tensor<Value, 1>();
+	obs.edge_features.indices = decoder.tensor<std::size_t, 2>();
+	obs.edge_features.shape = decoder.shape<2>();
+	using Csr = decltype(Obs::edge_features_csr);
+	obs.edge_features_csr.values = decoder.tensor<Value, 1>();
+	obs.edge_features_csr.column_indices = decoder.tensor<typename Csr::index_type, 1>();
+	obs.edge_features_csr.row_pointers = decoder.tensor<typename Csr::index_type, 1>();
+	obs.edge_features_csr.shape = decoder.shape<2>();
+	step.action_set = decoder.tensor<std::size_t, 1>();
+	step.action = static_cast<std::size_t>(decoder.scalar<std::uint64_t>());
+	step.reward = decoder.scalar<double>();
+	if (!decoder.done()) {
+		throw_corrupted();
+	}
+	return step;
+}
+
+/** Buffers holding the tensors of a sample that could not be viewed in place, and the mapping of the file. */
+struct SampleMemory {
+	std::shared_ptr<std::byte const> mapping;
+	std::vector<std::unique_ptr<std::byte[]>> buffers;  // NOLINT(cppcoreguidelines-avoid-c-arrays)
+
+	auto allocate(std::size_t n_bytes) -> void* {
+		// Arrays of bytes are allocated with an alignment suitable for any scalar
+		return buffers.emplace_back(std::make_unique<std::byte[]>(n_bytes)).get();  // NOLINT
+	}
+};
+
+template <typename Value>
+auto view_step(Decoder& decoder, std::shared_ptr<std::byte const> mapping) -> BasicTrajectorySample<Value> {
+	using Sample = BasicTrajectorySample<Value>;
+	using Csr = decltype(observation::BasicNodeBipartiteObsView<Value>::edge_features_csr);
+	using Index = typename Csr::index_type;
+	auto memory = std::make_shared<SampleMemory>();
+	memory->mapping = std::move(mapping);
+	auto const allocate = [&memory](std::size_t n_bytes) { return memory->allocate(n_bytes); };
+
+	auto sample = Sample{};
+	auto& obs = sample.observation;
+	obs.variable_features = decoder.tensor_view<Value, 2>(allocate);
+	obs.row_features = decoder.tensor_view<Value, 2>(allocate);
+	obs.edge_features.values = decoder.tensor_view<Value, 1>(allocate);
+	obs.edge_features.indices = decoder.tensor_view<std::size_t, 2>(allocate);
+	obs.edge_features.shape = decoder.shape<2>();
+	obs.edge_features_csr.values = decoder.tensor_view<Value, 1>(allocate);
+	obs.edge_features_csr.column_indices = decoder.tensor_view<Index, 1>(allocate);
+	obs.edge_features_csr.row_pointers = decoder.tensor_view<Index, 1>(allocate);
+	obs.edge_features_csr.shape = decoder.shape<2>();
+	sample.action_set = decoder.tensor_view<std::size_t, 1>(allocate);
+	sample.action = static_cast<std::size_t>(decoder.scalar<std::uint64_t>());
+	sample.reward = decoder.scalar<double>();
+	if (!decoder.done()) {
+		throw_corrupted();
+	}
+	sample.memory = std::move(memory);
+	return sample;
+}
+
+/** Read one byte per page of the tensor so that the pages are loaded in memory. */
+template <typename T, std::size_t N> auto touch(utility::tensor_view<T, N> const& view) noexcept -> std::byte {
+	constexpr std::size_t page_size = 4096;
+	auto const* const bytes = reinterpret_cast<std::byte const*>(view.data);
+	auto const n_bytes = view.size() * sizeof(T);
+	auto sum = std::byte{0};
+	for (std::size_t i = 0; i < n_bytes; i += page_size) {
+		sum ^= bytes[i];
+	}
+	return sum;
+}
+
+template <typename Value> void touch(BasicTrajectorySample<Value> const& sample) noexcept {
+	auto const& obs = sample.observation;
+	auto sum = touch(obs.variable_features);
+	sum ^= touch(obs.row_features);
+	sum ^= touch(obs.edge_features.values);
+	sum ^= touch(obs.edge_features.indices);
+	sum ^= touch(obs.edge_features_csr.values);
+	sum ^= touch(obs.edge_features_csr.column_indices);
+	sum ^= touch(obs.edge_features_csr.row_pointers);
+	sum ^= touch(sample.action_set);
+	// Prevent the reads from being optimized away
+	[[maybe_unused]] auto volatile const result = sum;
+}
+
+template <typename T> void write_scalar(std::ofstream& file, T value) {
+	file.write(reinterpret_cast<char const*>(&value), sizeof(T));
+}
+
+template <typename T> auto read_scalar(std::byte const* data) noexcept -> T {
+	auto value = T{};
+	std::memcpy(&value, data, sizeof(T));
+	return value;
+}
+
+/** Read the index of steps, or recover the steps of a file whose writer was not closed. */
+template <typename Value>
+auto read_step_offsets(std::byte const* data, std::size_t data_size, std::filesystem::path const& filename)
+	-> std::vector<std::uint64_t> {
+	auto offsets = std::vector<std::uint64_t>{};
+	auto const not_trajectory = [&filename] {
+		throw std::runtime_error{fmt::format("File {} is not a trajectory file.", filename.string())};
+	};
+	if (std::memcmp(data, file_magic.data(), file_magic.size()) != 0) {
+		not_trajectory();
+	}
+	if (auto const version = read_scalar<std::uint32_t>(data + file_magic.size());
+		version < min_format_version || version > format_version) {
+		throw std::runtime_error{fmt::format("Unsupported version of trajectory file {}.", filename.string())};
+	}
+	if (read_scalar<std::uint32_t>(data + file_magic.size() + sizeof(std::uint32_t)) != sizeof(Value)) {
+		throw std::runtime_error{
+			fmt::format("Trajectory file {} was written with a different floating point type.", filename.string())};
+	}
+
+	auto const has_index =
+		(data_size >= header_size + sizeof(std::uint64_t) + footer_size) &&
+		(std::memcmp(data + data_size - index_magic.size(), index_magic.data(), index_magic.size()) == 0);
+	if (has_index) {
+		auto const index_offset = static_cast<std::size_t>(read_scalar<std::uint64_t>(data + data_size - footer_size));
+		auto const index_end = data_size - footer_size;
+		if (index_offset < header_size || index_offset + sizeof(std::uint64_t) > index_end) {
+			not_trajectory();
+		}
+		auto const n_steps = static_cast<std::size_t>(read_scalar<std::uint64_t>(data + index_offset));
+		auto const* const index = data + index_offset + sizeof(std::uint64_t);
+		if (n_steps != static_cast<std::size_t>(data + index_end - index) / sizeof(std::uint64_t)) {
+			not_trajectory();
+		}
+		offsets.resize(n_steps);
+		std::memcpy(offsets.data(), index, n_steps * sizeof(std::uint64_t));
+		for (auto const offset : offsets) {
+			if (offset < header_size || offset + sizeof(std::uint64_t) > index_offset) {
+				not_trajectory();
+			}
+		}
+	} else {
+		// The writer was not closed, recover the steps written entirely
+		auto offset = header_size;
+		while (offset + sizeof(std::uint64_t) <= data_size) {
+			auto const step_size = read_scalar<std::uint64_t>(data + offset);
+			if (step_size > data_size - offset - sizeof(std::uint64_t)) {
+				break;
+			}
+			offsets.push_back(offset);
+			offset = align(offset + sizeof(std::uint64_t) + static_cast<std::size_t>(step_size));
+		}
+	}
+	return offsets;
+}
+
+/** A decoder over the content of the step starting at the given offset. */
+auto step_decoder(std::byte const* data, std::size_t data_size, std::size_t offset) -> Decoder {
+	auto const step_size = static_cast<std::size_t>(read_scalar<std::uint64_t>(data + offset));
+	auto const* const begin = data + offset + sizeof(std::uint64_t);
+	if (step_size > static_cast<std::size_t>(data + data_size - begin)) {
+		throw_corrupted();
+	}
+	return Decoder{begin, begin + step_size};
+}
+
+}  // namespace
+
+/**********************************************
+ *  Implementation of BasicTrajectoryWriter  *
+ **********************************************/
+
+template <typename Value>
+BasicTrajectoryWriter<Value>::BasicTrajectoryWriter(
+	std::filesystem::path const& filename,
+	bool compress_,
+	std::size_t chunk_size_,
+	bool narrow_integers_,
+	TrajectoryCompression compression_,
+	bool delta_integers_) :
+	file{filename, std::ios::binary | std::ios::trunc},
+	compress{compress_},
+	chunk_size{chunk_size_},
+	narrow_integers{narrow_integers_},
+	compression{compression_},
+	delta_integers{delta_integers_} {
+	if (chunk_size == 0) {
+		throw std::invalid_argument{"The chunk size must be positive."};
+	}
+#ifndef ECOLE_HAS_ZSTD
+	if (compress && compression == TrajectoryCompression::zstd) {
+		throw std::runtime_error{"Cannot compress trajectories with zstd, Ecole was built without zstd."};
+	}
+#endif
+	if (!file) {
+		throw std::runtime_error{fmt::format("Could not open file {}.", filename.string())};
+	}
+	file.write(file_magic.data(), file_magic.size());
+	write_scalar(file, format_version);
+	write_scalar(file, static_cast<std::uint32_t>(sizeof(Value)));
+	file_offset = header_size;
+}
+
+template <typename Value> BasicTrajectoryWriter<Value>::~BasicTrajectoryWriter() {
+	try {
+		close();
+	} catch (...) {
+	}
+}
+
+template <typename Value> void BasicTrajectoryWriter<Value>::write(BasicTrajectoryStep<Value> const& step) {
+	write(step.observation, step.action_set, step.action, step.reward);
+}
+
+template <typename Value>
+void BasicTrajectoryWriter<Value>::write(
+	observation::BasicNodeBipartiteObs<Value> const& observation,
+	xt::xtensor<std::size_t, 1> const& action_set,
+	std::size_t action,
+	double reward) {
+	if (!file.is_open()) {
+		throw std::runtime_error{"Cannot write a step to a closed trajectory."};
+	}
+	auto const chunk_end = chunk.size();
+	// Steps start aligned in the file, chunks start wherever the previous one ended
+	auto const step_begin = align(file_offset + chunk_end) - file_offset;
+	// Padding and placeholder for the size of the step
+	chunk.resize(step_begin + sizeof(std::uint64_t), 0);
+	try {
+		auto encoder = Encoder{chunk, {compress, compression, narrow_integers, delta_integers}};
+		encode_step(encoder, observation, action_set, action, reward);
+	} catch (...) {
+		chunk.resize(chunk_end);
+		throw;
+	}
+	auto const step_size = static_cast<std::uint64_t>(chunk.size() - step_begin - sizeof(std::uint64_t));
+	std::memcpy(chunk.data() + step_begin, &step_size, sizeof(step_size));
+	step_offsets.push_back(file_offset + step_begin);
+
+	if (++n_chunk_steps >= chunk_size) {
+		flush_chunk();
+	}
+}
+
+template <typename Value> void BasicTrajectoryWriter<Value>::close() {
+	if (!file.is_open()) {
+		return;
+	}
+	flush_chunk();
+	auto const index_offset = file_offset;
+	write_scalar(file, static_cast<std::uint64_t>(step_offsets.size()));
+	auto const index_size = step_offsets.size() * sizeof(std::uint64_t);
+	file.write(reinterpret_cast<char const*>(step_offsets.data()), static_cast<std::streamsize>(index_size));
+	write_scalar(file, index_offset);
+	file.write(index_magic.data(), index_magic.size());
+	file.close();
+	if (!file) {
+		throw std::runtime_error{"Could not write the trajectory index."};
+	}
+}
+
+template <typename Value> void BasicTrajectoryWriter<Value>::flush_chunk() {
+	file.write(chunk.data(), static_cast<std::streamsize>(chunk.size()));
+	if (!file) {
+		throw std::runtime_error{"Could not write trajectory steps."};
+	}
+	file_offset += chunk.size();
+	chunk.clear();
+	n_chunk_steps = 0;
+}
+
+/**********************************************
+ *  Implementation of BasicTrajectoryReader  *
+ **********************************************/
+
+template <typename Value> BasicTrajectoryReader<Value>::BasicTrajectoryReader(std::filesystem::path const& filename) {
+	auto const fd = ::open(filename.c_str(), O_RDONLY);  // NOLINT(cppcoreguidelines-pro-type-vararg)
+	if (fd < 0) {
+		throw std::runtime_error{fmt::format("Could not open file {}.", filename.string())};
+	}
+	struct stat file_stat = {};
+	if (::fstat(fd, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(header_size)) {
+		::close(fd);
+		throw std::runtime_error{fmt::format("File {} is not a trajectory file.", filename.string())};
+	}
+	data_size = static_cast<std::size_t>(file_stat.st_size);
+	auto* const mapped = ::mmap(nullptr, data_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	::close(fd);
+	if (mapped == MAP_FAILED) {
+		throw std::runtime_error{fmt::format("Could not map file {} in memory.", filename.string())};
+	}
+	// Unmapped when the reader and all the samples viewing the file are destroyed
+	data = std::shared_ptr<std::byte const>{
+		static_cast<std::byte const*>(mapped), [size = data_size](std::byte const* ptr) {
+			::munmap(const_cast<std::byte*>(ptr), size);  // NOLINT(cppcoreguidelines-pro-type-const-cast)
+		}};
+
+	step_offsets = read_step_offsets<Value>(data.get(), data_size, filename);
+}
+
+template <typename Value>
+auto BasicTrajectoryReader<Value>::read(std::size_t index) const -> BasicTrajectoryStep<Value> {
+	if (index >= step_offsets.size()) {
+		throw std::out_of_range{fmt::format("Step {} is out of a trajectory of {} steps.", index, step_offsets.size())};
+	}
+	auto decoder = step_decoder(data.get(), data_size, static_cast<std::size_t>(step_offsets[index]));
+	return decode_step<Value>(decoder);
+}
+
+template <typename Value>
+auto BasicTrajectoryReader<Value>::view(std::size_t index) const -> BasicTrajectorySample<Value> {
+	if (index >= step_offsets.size()) {
+		throw std::out_of_range{fmt::format("Step {} is out of a trajectory of {} steps.", index, step_offsets.size())};
+	}
+	auto decoder = step_decoder(data.get(), data_size, static_cast<std::size_t>(step_offsets[index]));
+	return view_step<Value>(decoder, data);
+}
+
+/***********************************************
+ *  Implementation of BasicTrajectoryDataset  *
+ ***********************************************/
+
+template <typename Value>
+BasicTrajectoryDataset<Value>::BasicTrajectoryDataset(std::vector<std::filesystem::path> const& filenames) {
+	readers.reserve(filenames.size());
+	first_steps.reserve(filenames.size() + 1);
+	first_steps.push_back(0);
+	for (auto const& filename : filenames) {
+		auto const& reader = readers.emplace_back(filename);
+		first_steps.push_back(first_steps.back() + reader.size());
+	}
+}
+
+template <typename Value>
+auto BasicTrajectoryDataset<Value>::read(std::size_t index) const -> BasicTrajectoryStep<Value> {
+	auto const [reader, step] = locate(index);
+	return reader.read(step);
+}
+
+template <typename Value>
+auto BasicTrajectoryDataset<Value>::view(std::size_t index) const -> BasicTrajectorySample<Value> {
+	auto const [reader, step] = locate(index);
+	return reader.view(step);
+}
+
+template <typename Value>
+auto BasicTrajectoryDataset<Value>::locate(std::size_t index) const
+	-> std::pair<BasicTrajectoryReader<Value> const&, std::size_t> {
+	if (index >= size()) {
+		throw std::out_of_range{fmt::format("Step {} is out of a dataset of {} steps.", index, size())};
+	}
+	// The last file whose first step is not after the index, skipping empty files
+	auto const file = static_cast<std::size_t>(
+		std::upper_bound(first_steps.begin(), first_steps.end(), index) - first_steps.begin() - 1);
+	return {readers[file], index - first_steps[file]};
+}
+
+/********************************************************
+ *  Implementation of BasicShuffledTrajectoryIterator  *
+ ********************************************************/
+
+template <typename Value>
+BasicShuffledTrajectoryIterator<Value>::BasicShuffledTrajectoryIterator(
+	BasicTrajectoryDataset<Value> const& dataset_,
+	RandomGenerator& rng,
+	std::size_t n_prefetch_) :
+	dataset{dataset_}, indices(dataset_.size()), n_prefetch{n_prefetch_} {
+	if (n_prefetch == 0) {
+		throw std::invalid_argument{"The number of steps prefetched must be positive."};
+	}
+	std::iota(indices.begin(), indices.end(), std::size_t{0});
+	std::shuffle(indices.begin(), indices.end(), rng);
+	worker = std::thread{[this, running = utility::RunningThread{}] { prefetch(); }};
+}
+
+template <typename Value> BasicShuffledTrajectoryIterator<Value>::~BasicShuffledTrajectoryIterator() {
+	{
+		auto const lock = std::lock_guard{mutex};
+		stopping = true;
+	}
+	consumed_cv.notify_all();
+	worker.join();
+}
+
+template <typename Value>
+auto BasicShuffledTrajectoryIterator<Value>::next() -> std::optional<BasicTrajectorySample<Value>> {
+	if (n_returned == indices.size()) {
+		return {};
+	}
+	auto lock = std::unique_lock{mutex};
+	prefetched_cv.wait(lock, [this] { return !prefetched.empty() || error; });
+	if (prefetched.empty()) {
+		std::rethrow_exception(error);
+	}
+	auto sample = std::move(prefetched.front());
+	prefetched.pop_front();
+	lock.unlock();
+	consumed_cv.notify_one();
+	++n_returned;
+	return sample;
+}
+
+template <typename Value> void BasicShuffledTrajectoryIterator<Value>::prefetch() {
+	for (auto const index : indices) {
+		{
+			auto lock = std::unique_lock{mutex};
+			consumed_cv.wait(lock, [this] { return stopping || prefetched.size() < n_prefetch; });
+			if (stopping) {
+				return;
+			}
+		}
+		try {
+			// Viewing and touching pages happens outside the lock, concurrently with the consumer
+			auto sample = dataset.view(index);
+			touch(sample);
+			auto const lock = std::lock_guard{mutex};
+			prefetched.push_back(std::move(sample));
+		} catch (...) {
+			auto const lock = std::lock_guard{mutex};
+			error = std::current_exception();
+		}
+		prefetched_cv.notify_one();
+		if (error) {
+			return;
+		}
+	}
+}
+
+template class BasicTrajectoryWriter<double>;
+template class BasicTrajectoryWriter<float>;
+template class BasicTrajectoryReader<double>;
+template class BasicTrajectoryReader<float>;
+template class BasicTrajectoryDataset<double>;
+template class BasicTrajectoryDataset<float>;
+template class BasicShuffledTrajectoryIterator<double>;
+template class BasicShuffledTrajectoryIterator<float>;
+
+}  // namespace ecole::data
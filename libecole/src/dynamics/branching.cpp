@@ -1,16 +1,246 @@
 #include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
 #include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 #include <xtensor/xtensor.hpp>
 
 #include "ecole/dynamics/branching.hpp"
+#include "ecole/scip/cons.hpp"
 #include "ecole/scip/model.hpp"
+#include "ecole/scip/row.hpp"
 #include "ecole/scip/utils.hpp"
 
+#include "utility/mask.hpp"
+
 namespace ecole::dynamics {
 
-BranchingDynamics::BranchingDynamics(bool pseudo_candidates_) noexcept : pseudo_candidates(pseudo_candidates_) {}
+struct BranchingDynamics::InlineBranching {
+	Policy policy = nullptr;
+	/** Number of decisions left to the policy before giving back control. */
+	std::size_t n_remaining = 0;
+	std::exception_ptr policy_error = nullptr;  // NOLINT(bugprone-throw-keyword-missing)
+};
+
+struct BranchingDynamics::ViewBuffers {
+	std::vector<std::size_t> indices;
+	std::vector<std::uint32_t> indices_32;
+	std::vector<std::uint8_t> mask;
+	std::vector<std::uint8_t> packed_mask;
+};
+
+namespace {
+
+/**
+ * The original problem and the parameters that the presolved problem depends upon.
+ *
+ * Parameters are compared in full, so that configurations never share a presolved problem by a hash collision.
+ */
+struct PresolveKey {
+	std::uint64_t fingerprint;
+	std::map<std::string, scip::Param> params;
+
+	[[nodiscard]] auto operator==(PresolveKey const& other) const -> bool {
+		return fingerprint == other.fingerprint && params == other.params;
+	}
+};
+
+}  // namespace
+
+struct BranchingDynamics::PresolveCache {
+	/** A presolved problem, with the cuts separated at its root node when root cuts are cached. */
+	struct Entry {
+		scip::Model presolved;
+		scip::LinearConstraintBatch root_cuts;
+	};
+
+	std::size_t capacity;
+	bool cache_root_cuts;
+	std::mutex mutex;
+	/** Entries with their key, the oldest first. */
+	std::deque<std::pair<PresolveKey, std::shared_ptr<Entry const>>> entries;
+};
+
+BranchingDynamics::BranchingDynamics(
+	bool pseudo_candidates_,
+	ObservationSchedule schedule_,
+	std::size_t presolve_cache_size,
+	bool cache_root_cuts,
+	std::chrono::milliseconds step_deadline,
+	Policy explore_policy_) :
+	pseudo_candidates(pseudo_candidates_),
+	m_step_deadline(step_deadline),
+	inline_branching(std::make_shared<InlineBranching>()),
+	explore_policy(std::move(explore_policy_)),
+	schedule(std::make_shared<ObservationSchedule>(std::move(schedule_))),
+	view_buffers(std::make_shared<ViewBuffers>()) {
+	if (presolve_cache_size > 0) {
+		presolve_cache = std::make_shared<PresolveCache>();
+		presolve_cache->capacity = presolve_cache_size;
+		presolve_cache->cache_root_cuts = cache_root_cuts;
+	} else if (cache_root_cuts) {
+		throw std::invalid_argument{"Caching root cuts requires a presolve cache."};
+	}
+	if (step_deadline < std::chrono::milliseconds::zero()) {
+		throw std::invalid_argument{"The step deadline cannot be negative."};
+	}
+}
+
+BranchingDynamics::BranchingDynamics(BranchingDynamics const& other) :
+	DefaultSetDynamicsRandomState(other),
+	pseudo_candidates(other.pseudo_candidates),
+	m_step_deadline(other.m_step_deadline),
+	inline_branching(std::make_shared<InlineBranching>()),
+	explore_policy(other.explore_policy),
+	schedule(std::make_shared<ObservationSchedule>(*other.schedule)),
+	view_buffers(std::make_shared<ViewBuffers>()),
+	presolve_cache(other.presolve_cache) {}
+
+auto BranchingDynamics::operator=(BranchingDynamics const& other) -> BranchingDynamics& {
+	if (this != &other) {
+		*this = BranchingDynamics{other};
+	}
+	return *this;
+}
+
+namespace {
+
+/**
+ * Key of the original problem and of the parameters that the presolved problem depends upon.
+ *
+ * Randomization parameters are left out since they are the only ones changing between episodes.
+ * Parameters at their default value are left out too, since they are the same for all models.
+ * Problems without exact fingerprint have no key, and are not cached.
+ */
+auto presolve_key(scip::Model const& model) -> std::optional<PresolveKey> {
+	auto const fingerprint = model.exact_fingerprint();
+	if (!fingerprint.has_value()) {
+		return {};
+	}
+	auto params = model.get_changed_params();
+	for (auto iter = params.begin(); iter != params.end();) {
+		if (iter->first.rfind("randomization/", 0) == 0) {
+			iter = params.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+	return PresolveKey{fingerprint.value(), std::move(params)};
+}
+
+/**
+ * Solve the root node of a fork of the presolved problem and return the cuts in its last LP.
+ *
+ * Cuts are rows added by separators or by constraint handlers without belonging to a constraint.
+ * They index the variables in the order of Model::variables, which is the same for all forks of the problem.
+ */
+auto separate_root_cuts(scip::Model const& presolved) -> scip::LinearConstraintBatch {
+	auto model = presolved.fork();
+	model.disable_presolve();
+	auto constructor = scip::callback::BranchruleConstructor{};
+	constructor.yield_external = false;
+	constructor.yield_pseudo = false;
+	auto cuts = scip::LinearConstraintBatch{};
+	// The first branching call happens once the root node is done separating
+	if (!model.solve_iter(constructor).has_value()) {
+		return cuts;
+	}
+	auto const inf = std::numeric_limits<SCIP_Real>::infinity();
+	auto* const scip = model.get_scip_ptr();
+	auto indices = std::vector<std::size_t>{};
+	for (auto* const row : model.lp_rows()) {
+		auto const origin = SCIProwGetOrigintype(row);
+		if (origin != SCIP_ROWORIGINTYPE_SEPA && origin != SCIP_ROWORIGINTYPE_CONSHDLR) {
+			continue;
+		}
+		indices.clear();
+		auto mapped = true;
+		for (auto* const col : scip::get_cols(row)) {
+			// Without presolving, transformed variables are the original ones of the fork, up to SCIP bookkeeping
+			auto* var = SCIPcolGetVar(col);
+			auto scalar = SCIP_Real{1.};
+			auto constant = SCIP_Real{0.};
+			scip::call(SCIPvarGetOrigvarSum, &var, &scalar, &constant);
+			if (var == nullptr || scalar != 1. || constant != 0.) {
+				mapped = false;
+				break;
+			}
+			indices.push_back(static_cast<std::size_t>(SCIPvarGetProbindex(var)));
+		}
+		if (mapped) {
+			auto const vals = scip::get_vals(row);
+			cuts.add(
+				indices,
+				{vals.data(), vals.size()},
+				scip::get_unshifted_lhs(scip, row).value_or(-inf),
+				scip::get_unshifted_rhs(scip, row).value_or(inf));
+		}
+	}
+	return cuts;
+}
+
+}  // namespace
+
+auto BranchingDynamics::set_dynamics_random_state(scip::Model& model, RandomGenerator& rng) const -> void {
+	auto key = presolve_cache != nullptr ? presolve_key(model) : std::optional<PresolveKey>{};
+	if (key.has_value()) {
+		auto entry = std::shared_ptr<PresolveCache::Entry const>{};
+		{
+			auto const lk = std::lock_guard{presolve_cache->mutex};
+			auto const& entries = presolve_cache->entries;
+			auto const iter = std::find_if(entries.begin(), entries.end(), [&key](auto const& e) { return e.first == *key; });
+			if (iter != entries.end()) {
+				entry = iter->second;
+			}
+		}
+		// Presolving happens outside of the lock so that other threads can start their episodes meanwhile
+		if (entry == nullptr) {
+			auto presolved = model.copy_orig();
+			presolved.presolve();
+			// Problems solved or found infeasible by presolving are left to be solved normally
+			if (presolved.stage() == SCIP_STAGE_PRESOLVED) {
+				auto root_cuts =
+					presolve_cache->cache_root_cuts ? separate_root_cuts(presolved) : scip::LinearConstraintBatch{};
+				entry = std::make_shared<PresolveCache::Entry const>(
+					PresolveCache::Entry{std::move(presolved), std::move(root_cuts)});
+				auto const lk = std::lock_guard{presolve_cache->mutex};
+				auto& entries = presolve_cache->entries;
+				if (entries.size() >= presolve_cache->capacity) {
+					entries.pop_front();
+				}
+				entries.emplace_back(std::move(key).value(), entry);
+			}
+		}
+		if (entry != nullptr) {
+			model = entry->presolved.fork();
+			model.disable_presolve();
+			// Cuts are valid inequalities, added as constraints so that the root LP starts with them
+			entry->root_cuts.add_to(model, "root_cut_");
+		}
+	}
+	DefaultSetDynamicsRandomState::set_dynamics_random_state(model, rng);
+	// The default schedule is not random, and drawing its state would change the seeds of the next episodes
+	if (!schedule->selects_all()) {
+		schedule->seed(rng);
+	}
+}
+
+auto BranchingDynamics::n_presolved_cached() const -> std::size_t {
+	if (presolve_cache == nullptr) {
+		return 0;
+	}
+	auto const lk = std::lock_guard{presolve_cache->mutex};
+	return presolve_cache->entries.size();
+}
 
 namespace {
 
@@ -27,6 +257,20 @@ auto action_set(scip::Model const& model, bool pseudo) -> std::optional<xt::xten
 	return branch_cols;
 }
 
+/** Fill the buffer with the action set, only allocating when it grows larger than ever before. */
+template <typename Index>
+auto action_set_into(scip::Model const& model, bool pseudo, std::vector<Index>& buffer)
+	-> std::optional<nonstd::span<Index const>> {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		return {};
+	}
+	auto const branch_cands = pseudo ? model.pseudo_branch_cands() : model.lp_branch_cands();
+	buffer.resize(branch_cands.size());
+	auto const var_to_idx = [](auto const var) { return static_cast<Index>(SCIPvarGetProbindex(var)); };
+	std::transform(branch_cands.begin(), branch_cands.end(), buffer.begin(), var_to_idx);
+	return nonstd::span<Index const>{buffer.data(), buffer.size()};
+}
+
 /** Iterative solving until next LP branchrule call and return the action_set. */
 template <typename FCall>
 auto keep_solving_until_next_LP_callback(scip::Model& model, FCall& fcall, bool pseudo_candidates)
@@ -46,34 +290,197 @@ auto keep_solving_until_next_LP_callback(scip::Model& model, FCall& fcall, bool
 	return {true, {}};
 }
 
+/** Branch on the given variable, or let SCIP branch by default. */
+auto branch(scip::Model& model, Defaultable<std::size_t> maybe_var_idx) -> SCIP_RESULT {
+	// Default fallback to SCIP default branching
+	if (!std::holds_alternative<std::size_t>(maybe_var_idx)) {
+		return SCIP_DIDNOTRUN;
+	}
+	auto const var_idx = std::get<std::size_t>(maybe_var_idx);
+	auto const vars = model.variables();
+	// Error handling
+	if (var_idx >= vars.size()) {
+		throw std::invalid_argument{
+			fmt::format("Branching candidate index {} larger than the number of variables ({}).", var_idx, vars.size())};
+	}
+	// Branching
+	scip::call(SCIPbranchVar, model.get_scip_ptr(), vars[var_idx], nullptr, nullptr, nullptr);
+	return SCIP_BRANCHED;
+}
+
+/** Rethrow the error of a policy called in the solver thread, if any. */
+template <typename InlineBranching> void rethrow_policy_error(InlineBranching& state) {
+	if (auto const policy_error = std::exchange(state.policy_error, nullptr)) {
+		std::rethrow_exception(policy_error);
+	}
+}
+
 }  // namespace
 
 auto BranchingDynamics::reset_dynamics(scip::Model& model) const -> std::tuple<bool, ActionSet> {
-	auto fcall = model.solve_iter(scip::callback::BranchruleConstructor{});
-	return keep_solving_until_next_LP_callback(model, fcall, pseudo_candidates);
+	*inline_branching = {};
+	schedule->reset();
+	auto constructor = scip::callback::BranchruleConstructor{};
+	// Only LP branching is given to the agent, other calls are left to SCIP without waking this thread
+	constructor.yield_external = false;
+	constructor.yield_pseudo = false;
+	auto const pseudo = pseudo_candidates;
+	// Called in the solver thread while the calling thread waits on the coroutine, hence without data race.
+	constructor.handler = [state = inline_branching, schedule = schedule, explore = explore_policy, &model, pseudo](
+		SCIP* scip, scip::callback::BranchruleCall const& call) -> std::optional<SCIP_RESULT> {
+		auto const call_policy = [&](Policy const& policy) -> SCIP_RESULT {
+			try {
+				return branch(model, policy(model, action_set(model, pseudo)));
+			} catch (...) {
+				state->policy_error = std::current_exception();
+				state->n_remaining = 0;
+				SCIPinterruptSolve(scip);
+				return SCIP_DIDNOTRUN;
+			}
+		};
+		if (state->n_remaining == 0) {
+			// Nodes not selected are branched on without giving back control
+			auto const is_lp = call.where == scip::callback::BranchruleCall::Where::LP;
+			if (is_lp && !schedule->selects_all() && !schedule->select(model)) {
+				return explore ? call_policy(explore) : SCIP_DIDNOTRUN;
+			}
+			return {};
+		}
+		if (call.where != scip::callback::BranchruleCall::Where::LP) {
+			return SCIP_DIDNOTRUN;
+		}
+		--(state->n_remaining);
+		return call_policy(state->policy);
+	};
+	auto fcall = model.solve_iter(constructor);
+	auto result = keep_solving_until_next_LP_callback(model, fcall, pseudo_candidates);
+	rethrow_policy_error(*inline_branching);
+	return result;
+}
+
+auto BranchingDynamics::start_step_deadline(scip::Model& model) const -> void {
+	if (m_step_deadline > std::chrono::milliseconds::zero() && model.stage() == SCIP_STAGE_SOLVING) {
+		model.solve_iter_set_deadline(m_step_deadline, SCIP_DIDNOTRUN);
+	}
 }
 
+namespace {
+
+/** Branch on the variable if the solver still waits for the action, otherwise drop it. */
+auto branch_in_time(scip::Model& model, Defaultable<std::size_t> maybe_var_idx) -> SCIP_RESULT {
+	if (!model.solve_iter_reclaim()) {
+		return SCIP_DIDNOTRUN;
+	}
+	return branch(model, maybe_var_idx);
+}
+
+}  // namespace
+
 auto BranchingDynamics::step_dynamics(scip::Model& model, Defaultable<std::size_t> maybe_var_idx) const
 	-> std::tuple<bool, ActionSet> {
-	// Default fallback to SCIP default branching
-	auto scip_result = SCIP_DIDNOTRUN;
-
-	if (std::holds_alternative<std::size_t>(maybe_var_idx)) {
-		auto const var_idx = std::get<std::size_t>(maybe_var_idx);
-		auto const vars = model.variables();
-		// Error handling
-		if (var_idx >= vars.size()) {
-			throw std::invalid_argument{
-				fmt::format("Branching candidate index {} larger than the number of variables ({}).", var_idx, vars.size())};
+	auto const scip_result = branch_in_time(model, maybe_var_idx);
+	// Looping until the next LP branchrule rule callback, if it exists.
+	auto fcall = model.solve_iter_continue(scip_result);
+	auto result = keep_solving_until_next_LP_callback(model, fcall, pseudo_candidates);
+	rethrow_policy_error(*inline_branching);
+	return result;
+}
+
+auto BranchingDynamics::step_dynamics(
+	scip::Model& model,
+	Defaultable<std::size_t> maybe_var_idx,
+	std::size_t n_nodes,
+	Policy policy) const -> std::tuple<bool, ActionSet> {
+	if (n_nodes > 1 && !policy) {
+		throw std::invalid_argument{"A policy is required to branch on more than one node."};
+	}
+	auto const scip_result = branch_in_time(model, maybe_var_idx);
+	inline_branching->policy = std::move(policy);
+	inline_branching->n_remaining = n_nodes > 0 ? n_nodes - 1 : 0;
+	auto result = std::tuple<bool, ActionSet>{};
+	try {
+		auto fcall = model.solve_iter_continue(scip_result);
+		result = keep_solving_until_next_LP_callback(model, fcall, pseudo_candidates);
+	} catch (...) {
+		*inline_branching = {};
+		throw;
+	}
+	auto const policy_error = inline_branching->policy_error;
+	*inline_branching = {};
+	if (policy_error) {
+		std::rethrow_exception(policy_error);
+	}
+	return result;
+}
+
+auto BranchingDynamics::action_set_view(scip::Model const& model) const
+	-> std::optional<nonstd::span<std::size_t const>> {
+	return action_set_into(model, pseudo_candidates, view_buffers->indices);
+}
+
+auto BranchingDynamics::action_set_view_32(scip::Model const& model) const
+	-> std::optional<nonstd::span<std::uint32_t const>> {
+	return action_set_into(model, pseudo_candidates, view_buffers->indices_32);
+}
+
+auto BranchingDynamics::action_mask_view(scip::Model const& model, bool packed) const
+	-> std::optional<nonstd::span<std::uint8_t const>> {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		return {};
+	}
+	auto const branch_cands = pseudo_candidates ? model.pseudo_branch_cands() : model.lp_branch_cands();
+	auto& buffer = packed ? view_buffers->packed_mask : view_buffers->mask;
+	return utility::fill_variable_mask(branch_cands, model.variables().size(), packed, buffer);
+}
+
+auto BranchingDynamics::score_policy(xt::xtensor<double, 1> scores) -> Policy {
+	return [scores = std::move(scores)](scip::Model& /*model*/, ActionSet const& action_set) -> Action {
+		if (!action_set.has_value() || action_set->size() == 0) {
+			return Default;
+		}
+		auto best = action_set.value()(0);
+		auto best_score = -std::numeric_limits<double>::infinity();
+		for (auto const var_idx : action_set.value()) {
+			if (var_idx >= scores.size()) {
+				throw std::invalid_argument{
+					fmt::format("Branching candidate index {} larger than the number of scores ({}).", var_idx, scores.size())};
+			}
+			if (scores(var_idx) > best_score) {
+				best = var_idx;
+				best_score = scores(var_idx);
+			}
+		}
+		return best;
+	};
+}
+
+namespace {
+
+auto pseudocost_branching(scip::Model& model, BranchingDynamics::ActionSet const& action_set)
+	-> BranchingDynamics::Action {
+	if (!action_set.has_value() || action_set->size() == 0) {
+		return Default;
+	}
+	auto* const scip = model.get_scip_ptr();
+	auto const vars = model.variables();
+	auto best = action_set.value()(0);
+	auto best_score = -std::numeric_limits<double>::infinity();
+	for (auto const var_idx : action_set.value()) {
+		auto* const var = vars[var_idx];
+		auto const score = SCIPgetVarPseudocostScore(scip, var, SCIPvarGetLPSol(var));
+		if (score > best_score) {
+			best = var_idx;
+			best_score = score;
 		}
-		// Branching
-		scip::call(SCIPbranchVar, model.get_scip_ptr(), vars[var_idx], nullptr, nullptr, nullptr);
-		scip_result = SCIP_BRANCHED;
 	}
+	return best;
+}
 
-	// Looping until the next LP branchrule rule callback, if it exists.
-	auto fcall = model.solve_iter_continue(scip_result);
-	return keep_solving_until_next_LP_callback(model, fcall, pseudo_candidates);
+}  // namespace
+
+auto BranchingDynamics::pseudocost_policy() -> Policy {
+	// A plain function, rather than a lambda, is given back to C++ as is by the Python bindings, without the GIL
+	return Policy{&pseudocost_branching};
 }
 
 }  // namespace ecole::dynamics
@@ -1,18 +1,147 @@
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+
+#include <scip/scip.h>
+
 #include "ecole/dynamics/configuring.hpp"
 #include "ecole/scip/model.hpp"
 
 namespace ecole::dynamics {
 
+namespace {
+
+auto constexpr solving_prefixes = std::array<std::string_view, 10>{
+	"branching/",
+	"nodeselection/",
+	"separating/",
+	"cutselection/",
+	"lp/",
+	"conflict/",
+	"limits/",
+	"parallel/",
+	"concurrent/",
+	"display/",
+};
+
+/** Frequencies of constraint handlers and propagators, which presolving does not read. */
+auto constexpr solving_suffixes = std::array<std::string_view, 4>{"/sepafreq", "/propfreq", "/eagerfreq", "/freq"};
+
+auto starts_with(std::string_view str, std::string_view prefix) noexcept -> bool {
+	return str.substr(0, prefix.size()) == prefix;
+}
+
+auto ends_with(std::string_view str, std::string_view suffix) noexcept -> bool {
+	return str.size() >= suffix.size() && str.substr(str.size() - suffix.size()) == suffix;
+}
+
+/** The changed parameters of the model that may change its presolved problem, other than the seeds. */
+auto presolve_params(scip::Model const& model) -> ParamDict {
+	auto params = model.get_changed_params();
+	for (auto iter = params.begin(); iter != params.end();) {
+		auto const& name = iter->first;
+		if (param_phase(name) == SolvePhase::solving || starts_with(name, "randomization/")) {
+			iter = params.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+	return params;
+}
+
+}  // namespace
+
+auto param_phase(std::string_view name) noexcept -> SolvePhase {
+	if (name.find("presol") != std::string_view::npos || name.find("maxprerounds") != std::string_view::npos) {
+		return SolvePhase::presolving;
+	}
+	auto const has_prefix = [name](auto prefix) { return starts_with(name, prefix); };
+	if (std::any_of(solving_prefixes.begin(), solving_prefixes.end(), has_prefix)) {
+		return SolvePhase::solving;
+	}
+	auto const has_suffix = [name](auto suffix) { return ends_with(name, suffix); };
+	if ((starts_with(name, "constraints/") || starts_with(name, "propagating/")) &&
+		std::any_of(solving_suffixes.begin(), solving_suffixes.end(), has_suffix)) {
+		return SolvePhase::solving;
+	}
+	return SolvePhase::presolving;
+}
+
+/** The presolved problem of the last instance presolved, and what it was presolved from. */
+struct ConfiguringDynamics::PresolveCache {
+	std::mutex mutex;
+	std::uint64_t fingerprint = 0;
+	ParamDict params;
+	std::optional<scip::Model> presolved;
+
+	/** Load the cached presolved problem in the model if it matches, or presolve the model and cache its problem. */
+	void start(scip::Model& model);
+};
+
+void ConfiguringDynamics::PresolveCache::start(scip::Model& model) {
+	// Problems only partially fingerprinted could be mistaken for one another
+	auto const exact_fingerprint = model.exact_fingerprint();
+	if (!exact_fingerprint.has_value()) {
+		return;
+	}
+	auto const model_fingerprint = exact_fingerprint.value();
+	auto model_params = presolve_params(model);
+	{
+		auto const lk = std::lock_guard{mutex};
+		if (presolved.has_value() && fingerprint == model_fingerprint && params == model_params &&
+			model.load_problem(presolved.value())) {
+			model.set_param("presolving/maxrounds", 0);
+			return;
+		}
+	}
+	// Presolve outside of the lock, copies of the dynamics solving other instances need not wait
+	model.presolve();
+	if (model.stage() != SCIP_STAGE_PRESOLVED) {
+		return;
+	}
+	auto copy = model.copy();
+	auto const lk = std::lock_guard{mutex};
+	fingerprint = model_fingerprint;
+	params = std::move(model_params);
+	presolved = std::move(copy);
+}
+
+ConfiguringDynamics::ConfiguringDynamics(std::size_t n_threads, bool reuse_presolve) :
+	m_n_threads{n_threads}, m_presolve_cache{reuse_presolve ? std::make_shared<PresolveCache>() : nullptr} {
+	if (n_threads == 0) {
+		throw std::invalid_argument{"ConfiguringDynamics need at least one thread."};
+	}
+}
+
 auto ConfiguringDynamics::reset_dynamics(scip::Model& /* model */) const -> std::tuple<bool, NoneType> {
 	return {false, None};
 }
 
 auto ConfiguringDynamics::step_dynamics(scip::Model& model, ParamDict const& param_dict) const
 	-> std::tuple<bool, NoneType> {
+	if (m_n_threads > 1) {
+		model.set_param("parallel/maxnthreads", static_cast<int>(m_n_threads));
+	}
+	// Set after the number of threads so that the action can still override it
 	for (auto const& [name, value] : param_dict) {
 		model.set_param(name, value);
 	}
-	model.solve();
+	auto const is_solving_param = [](auto const& name_value) {
+		return param_phase(name_value.first) == SolvePhase::solving;
+	};
+	auto const only_solving = std::all_of(param_dict.begin(), param_dict.end(), is_solving_param);
+	if (m_presolve_cache != nullptr && only_solving && model.stage() == SCIP_STAGE_PROBLEM) {
+		m_presolve_cache->start(model);
+	}
+	if (m_n_threads > 1) {
+		model.solve_concurrent();
+	} else {
+		model.solve();
+	}
 	return {true, None};
 }
 
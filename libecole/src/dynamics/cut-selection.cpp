@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <variant>
+#include <vector>
+
+#include <fmt/format.h>
+#include <scip/scip.h>
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/dynamics/cut-selection.hpp"
+#include "ecole/scip/callback.hpp"
+#include "ecole/scip/model.hpp"
+
+namespace ecole::dynamics {
+
+struct CutSelectionDynamics::PendingCall {
+	std::optional<scip::callback::CutselCall> call;
+};
+
+namespace {
+
+using Column = CutSelectionDynamics::Column;
+
+/** Compute the features of all cuts in one pass, writing every row of the matrix once. */
+auto cut_features(SCIP* scip, scip::callback::CutselCall const& call) -> xt::xtensor<double, 2> {
+	auto const n_cuts = static_cast<std::size_t>(call.n_cuts);
+	auto features = xt::xtensor<double, 2>::from_shape({n_cuts, CutSelectionDynamics::n_columns});
+	auto const n_lp_cols = static_cast<double>(SCIPgetNLPCols(scip));
+	auto* out = features.data();
+	for (std::size_t i = 0; i < n_cuts; ++i, out += CutSelectionDynamics::n_columns) {
+		auto* const cut = call.cuts[i];
+		auto const n_nonzeros = static_cast<double>(SCIProwGetNNonz(cut));
+		out[static_cast<std::size_t>(Column::efficacy)] = SCIPgetCutEfficacy(scip, nullptr, cut);
+		out[static_cast<std::size_t>(Column::objective_parallelism)] = SCIPgetRowObjParallelism(scip, cut);
+		out[static_cast<std::size_t>(Column::support)] = n_lp_cols > 0 ? n_nonzeros / n_lp_cols : 0.;
+		out[static_cast<std::size_t>(Column::integer_support)] =
+			n_nonzeros > 0 ? static_cast<double>(SCIPgetRowNumIntCols(scip, cut)) / n_nonzeros : 0.;
+	}
+	return features;
+}
+
+/** Move the selected cuts to the front, in the given order, as SCIP expects. */
+void select_cuts(scip::callback::CutselCall const& call, std::vector<std::size_t> const& cut_indices) {
+	auto const n_cuts = static_cast<std::size_t>(call.n_cuts);
+	if (cut_indices.size() > static_cast<std::size_t>(call.max_n_selected_cuts)) {
+		throw std::invalid_argument{fmt::format(
+			"Selected {} cuts, but at most {} can be selected in this round.",
+			cut_indices.size(),
+			call.max_n_selected_cuts)};
+	}
+	auto is_selected = std::vector<bool>(n_cuts, false);
+	for (auto const idx : cut_indices) {
+		if (idx >= n_cuts) {
+			throw std::invalid_argument{fmt::format("Cut index {} larger than the number of cuts ({}).", idx, n_cuts)};
+		}
+		if (is_selected[idx]) {
+			throw std::invalid_argument{fmt::format("Cut index {} selected more than once.", idx)};
+		}
+		is_selected[idx] = true;
+	}
+	auto reordered = std::vector<SCIP_ROW*>{};
+	reordered.reserve(n_cuts);
+	for (auto const idx : cut_indices) {
+		reordered.push_back(call.cuts[idx]);
+	}
+	for (std::size_t i = 0; i < n_cuts; ++i) {
+		if (!is_selected[i]) {
+			reordered.push_back(call.cuts[i]);
+		}
+	}
+	std::copy(reordered.begin(), reordered.end(), call.cuts);
+	*call.n_selected_cuts = static_cast<int>(cut_indices.size());
+}
+
+/** Store the pending call and return the cut features. */
+auto wait_for_selection(
+	SCIP* scip,
+	std::optional<scip::callback::CutselCall>& pending_call,
+	std::optional<scip::callback::DynamicCall> const& fcall) -> std::tuple<bool, CutSelectionDynamics::ActionSet> {
+	// Assuming the cut selector is the only reverse callback
+	if (!fcall.has_value()) {
+		pending_call.reset();
+		return {true, {}};
+	}
+	pending_call = std::get<scip::callback::CutselCall>(fcall.value());
+	return {false, cut_features(scip, pending_call.value())};
+}
+
+}  // namespace
+
+CutSelectionDynamics::CutSelectionDynamics() : pending{std::make_shared<PendingCall>()} {}
+
+auto CutSelectionDynamics::reset_dynamics(scip::Model& model) const -> std::tuple<bool, ActionSet> {
+	pending->call.reset();
+	auto constructor = scip::callback::CutselConstructor{};
+	// Rounds without candidates are not worth giving back control
+	constructor.handler = [](SCIP* /*scip*/, scip::callback::CutselCall const& call) -> std::optional<SCIP_RESULT> {
+		if (call.n_cuts == 0) {
+			return SCIP_DIDNOTFIND;
+		}
+		return {};
+	};
+	auto const fcall = model.solve_iter(constructor);
+	return wait_for_selection(model.get_scip_ptr(), pending->call, fcall);
+}
+
+auto CutSelectionDynamics::step_dynamics(scip::Model& model, Action const& maybe_cut_indices) const
+	-> std::tuple<bool, ActionSet> {
+	auto result = SCIP_DIDNOTFIND;
+	if (std::holds_alternative<std::vector<std::size_t>>(maybe_cut_indices)) {
+		if (!pending->call.has_value()) {
+			throw std::invalid_argument{"No cut selection is pending."};
+		}
+		select_cuts(pending->call.value(), std::get<std::vector<std::size_t>>(maybe_cut_indices));
+		result = SCIP_SUCCESS;
+	}
+	pending->call.reset();
+	auto const fcall = model.solve_iter_continue(result);
+	return wait_for_selection(model.get_scip_ptr(), pending->call, fcall);
+}
+
+}  // namespace ecole::dynamics
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+#include <objscip/objbranchrule.h>
+#include <scip/scip.h>
+
+#include "ecole/dynamics/inline-policy-branching.hpp"
+#include "ecole/scip/callback.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+namespace ecole::dynamics {
+
+namespace {
+
+using Policy = InlinePolicyBranching::Policy;
+using Candidates = InlinePolicyBranching::Candidates;
+
+auto branch_candidates(scip::Model const& model, bool pseudo) -> Candidates {
+	auto const branch_cands = pseudo ? model.pseudo_branch_cands() : model.lp_branch_cands();
+	auto branch_cols = Candidates::from_shape({branch_cands.size()});
+	auto const var_to_idx = [](auto const var) { return SCIPvarGetProbindex(var); };
+	std::transform(branch_cands.begin(), branch_cands.end(), branch_cols.begin(), var_to_idx);
+	return branch_cols;
+}
+
+/** Branchrule calling the policy on every LP branching decision. */
+class PolicyBranchrule : public ::scip::ObjBranchrule {
+public:
+	PolicyBranchrule(scip::Model& model, Policy policy, bool pseudo_candidates) :
+		ObjBranchrule{
+			model.get_scip_ptr(),
+			"ecole::dynamics::InlinePolicyBranching",
+			"Branchrule that calls a policy in the solver thread.",
+			scip::callback::priority_max,
+			scip::callback::max_depth_none,
+			scip::callback::max_bound_distance_none},
+		m_model{model},
+		m_policy{std::move(policy)},
+		m_pseudo_candidates{pseudo_candidates} {}
+
+	auto scip_execlp(SCIP* scip, SCIP_BRANCHRULE* /*branchrule*/, SCIP_Bool /*allow_add_cons*/, SCIP_RESULT* result)
+		-> SCIP_RETCODE override {
+		*result = SCIP_DIDNOTRUN;
+		// Exceptions must not go through SCIP C code
+		try {
+			auto const var_idx = m_policy(m_model, branch_candidates(m_model, m_pseudo_candidates));
+			auto const vars = m_model.variables();
+			if (var_idx >= vars.size()) {
+				throw std::invalid_argument{
+					fmt::format("Branching candidate index {} larger than the number of variables ({}).", var_idx, vars.size())};
+			}
+			scip::call(SCIPbranchVar, scip, vars[var_idx], nullptr, nullptr, nullptr);
+			*result = SCIP_BRANCHED;
+		} catch (...) {
+			m_error = std::current_exception();
+			return SCIPinterruptSolve(scip);
+		}
+		return SCIP_OKAY;
+	}
+
+	/** The exception raised by the policy, if any. */
+	[[nodiscard]] auto error() const noexcept -> std::exception_ptr const& { return m_error; }
+
+private:
+	scip::Model& m_model;
+	Policy m_policy;
+	bool m_pseudo_candidates;
+	std::exception_ptr m_error = nullptr;  // NOLINT(bugprone-throw-keyword-missing)
+};
+
+}  // namespace
+
+InlinePolicyBranching::InlinePolicyBranching(Policy policy_, bool pseudo_candidates_) :
+	policy(std::move(policy_)), pseudo_candidates(pseudo_candidates_) {}
+
+auto InlinePolicyBranching::reset_dynamics(scip::Model& /* model */) const -> std::tuple<bool, NoneType> {
+	return {false, None};
+}
+
+auto InlinePolicyBranching::step_dynamics(scip::Model& model, NoneType const& /* action */) const
+	-> std::tuple<bool, NoneType> {
+	// Without a policy, we let SCIP branch by default
+	if (!policy) {
+		model.solve();
+		return {true, None};
+	}
+	// Owned by SCIP, but it lives as long as the model
+	auto* const branchrule = new PolicyBranchrule{model, policy, pseudo_candidates};  // NOLINT
+	scip::call(SCIPincludeObjBranchrule, model.get_scip_ptr(), branchrule, true);
+	model.solve();
+	if (branchrule->error()) {
+		std::rethrow_exception(branchrule->error());
+	}
+	return {true, None};
+}
+
+}  // namespace ecole::dynamics
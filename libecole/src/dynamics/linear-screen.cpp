@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+#include <scip/scip.h>
+#include <xtensor/xadapt.hpp>
+#include <xtensor/xindex_view.hpp>
+#include <xtensor/xoperation.hpp>
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/scip/model.hpp"
+
+#include "dynamics/linear-screen.hpp"
+
+namespace ecole::dynamics {
+
+namespace {
+
+auto constexpr inf = std::numeric_limits<SCIP_Real>::infinity();
+
+/** SCIP infinite values as IEEE infinity, so that they propagate through sums without overflow. */
+auto ieee(SCIP* scip, SCIP_Real value) noexcept -> SCIP_Real {
+	if (SCIPisInfinity(scip, value)) {
+		return inf;
+	}
+	if (SCIPisInfinity(scip, -value)) {
+		return -inf;
+	}
+	return value;
+}
+
+/** Same as SCIPisFeasGT, with the relative tolerance of SCIP. */
+auto feas_gt(SCIP_Real x, SCIP_Real y, SCIP_Real feastol) noexcept -> bool {
+	return x - y > feastol * std::max({1., std::abs(x), std::abs(y)});
+}
+
+}  // namespace
+
+void LinearScreen::update(scip::Model& model) {
+	auto* const scip = model.get_scip_ptr();
+	auto* const node = SCIPgetFocusNode(scip);
+	auto const new_key = std::tuple{node != nullptr ? SCIPnodeGetNumber(node) : SCIP_Longint{-1}, SCIPgetNLPRows(scip)};
+	if (new_key == key) {
+		return;
+	}
+	key = new_key;
+	feastol = SCIPfeastol(scip);
+
+	auto const vars = model.variables();
+	var_lbs.resize(vars.size());
+	var_ubs.resize(vars.size());
+	var_integral.resize(vars.size());
+	for (std::size_t j = 0; j < vars.size(); ++j) {
+		var_lbs[j] = ieee(scip, SCIPvarGetLbGlobal(vars[j]));
+		var_ubs[j] = ieee(scip, SCIPvarGetUbGlobal(vars[j]));
+		var_integral[j] = SCIPvarIsIntegral(vars[j]) != 0;
+	}
+
+	row_lhs.clear();
+	row_rhs.clear();
+	row_pointers.assign(1, 0);
+	auto all_coefs = std::vector<SCIP_Real>{};
+	auto all_vars = std::vector<std::size_t>{};
+	for (auto* const row : model.lp_rows()) {
+		// Local rows may cut off solutions outside of the node, and the LP does not hold coefficients on other columns
+		if (SCIProwIsLocal(row) || SCIProwGetNNonz(row) != SCIProwGetNLPNonz(row)) {
+			continue;
+		}
+		auto const n_nonzeros = static_cast<std::size_t>(SCIProwGetNNonz(row));
+		auto* const* const cols = SCIProwGetCols(row);
+		auto const* const vals = SCIProwGetVals(row);
+		for (std::size_t k = 0; k < n_nonzeros; ++k) {
+			all_coefs.push_back(vals[k]);
+			all_vars.push_back(static_cast<std::size_t>(SCIPvarGetProbindex(SCIPcolGetVar(cols[k]))));
+		}
+		row_lhs.push_back(ieee(scip, SCIProwGetLhs(row)) - SCIProwGetConstant(row));
+		row_rhs.push_back(ieee(scip, SCIProwGetRhs(row)) - SCIProwGetConstant(row));
+		row_pointers.push_back(all_coefs.size());
+	}
+	coefs = xt::adapt(all_coefs, {all_coefs.size()});
+	coef_vars = xt::adapt(all_vars, {all_vars.size()});
+}
+
+auto LinearScreen::screen(
+	nonstd::span<std::size_t const> var_indices,
+	nonstd::span<SCIP_Real const> vals,
+	bool repair,
+	std::vector<SCIP_Real>& repaired) -> bool {
+	repaired.assign(vals.begin(), vals.end());
+	lower = xt::adapt(var_lbs, {var_lbs.size()});
+	upper = xt::adapt(var_ubs, {var_ubs.size()});
+	for (std::size_t i = 0; i < var_indices.size(); ++i) {
+		auto const var = var_indices[i];
+		auto& val = repaired[i];
+		if (var_integral[var] && std::abs(val - std::round(val)) > feastol) {
+			if (!repair) {
+				return false;
+			}
+			val = std::round(val);
+		}
+		if (feas_gt(var_lbs[var], val, feastol) || feas_gt(val, var_ubs[var], feastol)) {
+			if (!repair) {
+				return false;
+			}
+			val = std::clamp(val, var_lbs[var], var_ubs[var]);
+		}
+		lower[var] = val;
+		upper[var] = val;
+	}
+
+	// Bounds of the contribution of every non zero to its row activity, as vectorized expressions
+	auto const lower_nz = xt::index_view(lower, coef_vars);
+	auto const upper_nz = xt::index_view(upper, coef_vars);
+	xt::xtensor<SCIP_Real, 1> const min_terms = xt::where(coefs > 0., coefs * lower_nz, coefs * upper_nz);
+	xt::xtensor<SCIP_Real, 1> const max_terms = xt::where(coefs > 0., coefs * upper_nz, coefs * lower_nz);
+
+	for (std::size_t r = 0; r < row_lhs.size(); ++r) {
+		auto const first = static_cast<std::ptrdiff_t>(row_pointers[r]);
+		auto const last = static_cast<std::ptrdiff_t>(row_pointers[r + 1]);
+		auto const min_activity = std::accumulate(min_terms.data() + first, min_terms.data() + last, 0.);
+		auto const max_activity = std::accumulate(max_terms.data() + first, max_terms.data() + last, 0.);
+		if (feas_gt(min_activity, row_rhs[r], feastol) || feas_gt(row_lhs[r], max_activity, feastol)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+}  // namespace ecole::dynamics
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <tuple>
+#include <vector>
+
+#include <nonstd/span.hpp>
+#include <scip/def.h>
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/scip/model.hpp"
+
+namespace ecole::dynamics {
+
+/**
+ * Snapshot of the global linear rows of the LP and of the global bounds, to screen candidate solutions.
+ *
+ * A (partial) assignment is screened by bounding the activity of every row, with assigned variables at their value
+ * and the others free within their global bounds.
+ * Only rows valid in the whole tree are kept, and rows with non zeros on columns outside the LP are dropped, so a
+ * screened out assignment cannot be completed into a feasible solution, while the converse need not hold.
+ * The snapshot is taken again when the node or the number of LP rows changes.
+ */
+class LinearScreen {
+public:
+	/** Take the snapshot of the LP of the current node, if not already taken. */
+	void update(scip::Model& model);
+
+	/**
+	 * Whether the assignment may be completed into a feasible solution.
+	 *
+	 * @param var_indices The problem indices of the assigned variables.
+	 * @param vals The values of the variables.
+	 * @param repair Whether to round the values of integer variables and to clip values to the global bounds, rather
+	 *        than screening them out.
+	 * @param repaired The values given to the variables, with the repairs.
+	 */
+	auto screen(
+		nonstd::span<std::size_t const> var_indices,
+		nonstd::span<SCIP_Real const> vals,
+		bool repair,
+		std::vector<SCIP_Real>& repaired) -> bool;
+
+private:
+	std::tuple<SCIP_Longint, int> key = {-1, -1};
+	SCIP_Real feastol = 0.;
+
+	std::vector<SCIP_Real> var_lbs;
+	std::vector<SCIP_Real> var_ubs;
+	std::vector<bool> var_integral;
+
+	/** Sides minus the row constant, infinite sides as IEEE infinity. */
+	std::vector<SCIP_Real> row_lhs;
+	std::vector<SCIP_Real> row_rhs;
+	std::vector<std::size_t> row_pointers;
+	/** The coefficients of the rows, and the problem index of their variable. */
+	xt::xtensor<SCIP_Real, 1> coefs;
+	xt::xtensor<std::size_t, 1> coef_vars;
+
+	/** Buffers of the bounds of an assignment. */
+	xt::xtensor<SCIP_Real, 1> lower;
+	xt::xtensor<SCIP_Real, 1> upper;
+};
+
+}  // namespace ecole::dynamics
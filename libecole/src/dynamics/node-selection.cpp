@@ -0,0 +1,209 @@
+#include <cassert>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <fmt/format.h>
+#include <objscip/objeventhdlr.h>
+#include <scip/scip.h>
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/dynamics/node-selection.hpp"
+#include "ecole/scip/callback.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+namespace ecole::dynamics {
+
+class NodeSelectionDynamics::Frontier {
+public:
+	/** Where to write the node selected by the agent, valid while the solver waits for the agent. */
+	SCIP_NODE** selected_node = nullptr;
+
+	void clear() {
+		nodes.clear();
+		index_of.clear();
+		selected_node = nullptr;
+	}
+
+	/** Bring the frontier up to date when SCIP selects the next node. */
+	void update(SCIP* scip) {
+		// The previous selection is now being processed, or processed
+		if (auto* const focus = SCIPgetFocusNode(scip); focus != nullptr) {
+			erase(SCIPnodeGetNumber(focus));
+		}
+		SCIP_NODE** children = nullptr;
+		int n_children = 0;
+		scip::call(SCIPgetChildren, scip, &children, &n_children);
+		for (int i = 0; i < n_children; ++i) {
+			insert(children[i]);
+		}
+		// Nodes can also leave the tree without a deletion event, for instance on restarts
+		if (nodes.size() != static_cast<std::size_t>(SCIPgetNNodesLeft(scip))) {
+			rebuild(scip);
+		}
+	}
+
+	void insert(SCIP_NODE* node) {
+		if (index_of.try_emplace(SCIPnodeGetNumber(node), nodes.size()).second) {
+			nodes.push_back(node);
+		}
+	}
+
+	void erase(SCIP_Longint number) {
+		auto const iter = index_of.find(number);
+		if (iter == index_of.end()) {
+			return;
+		}
+		// Swap with the last node to erase in constant time
+		auto const index = iter->second;
+		index_of.erase(iter);
+		if (index + 1 < nodes.size()) {
+			nodes[index] = nodes.back();
+			index_of[SCIPnodeGetNumber(nodes[index])] = index;
+		}
+		nodes.pop_back();
+	}
+
+	[[nodiscard]] auto find(SCIP_Longint number) const -> SCIP_NODE* {
+		auto const iter = index_of.find(number);
+		return iter != index_of.end() ? nodes[iter->second] : nullptr;
+	}
+
+	[[nodiscard]] auto empty() const noexcept -> bool { return nodes.empty(); }
+
+	/** Bounds and estimates are read now, since SCIP can update them while nodes are open. */
+	[[nodiscard]] auto action_set() const -> xt::xtensor<double, 2> {
+		auto data = xt::xtensor<double, 2>::from_shape({nodes.size(), n_columns});
+		for (std::size_t i = 0; i < nodes.size(); ++i) {
+			data(i, static_cast<std::size_t>(Column::number)) = static_cast<double>(SCIPnodeGetNumber(nodes[i]));
+			data(i, static_cast<std::size_t>(Column::depth)) = static_cast<double>(SCIPnodeGetDepth(nodes[i]));
+			data(i, static_cast<std::size_t>(Column::lower_bound)) = SCIPnodeGetLowerbound(nodes[i]);
+			data(i, static_cast<std::size_t>(Column::estimate)) = SCIPnodeGetEstimate(nodes[i]);
+		}
+		return data;
+	}
+
+private:
+	std::vector<SCIP_NODE*> nodes;
+	std::unordered_map<SCIP_Longint, std::size_t> index_of;
+
+	void rebuild(SCIP* scip) {
+		nodes.clear();
+		index_of.clear();
+		SCIP_NODE** leaves = nullptr;
+		SCIP_NODE** children = nullptr;
+		SCIP_NODE** siblings = nullptr;
+		int n_leaves = 0;
+		int n_children = 0;
+		int n_siblings = 0;
+		scip::call(
+			SCIPgetOpenNodesData, scip, &leaves, &children, &siblings, &n_leaves, &n_children, &n_siblings);
+		auto const insert_all = [this](SCIP_NODE** open_nodes, int n_open) {
+			for (int i = 0; i < n_open; ++i) {
+				insert(open_nodes[i]);
+			}
+		};
+		insert_all(leaves, n_leaves);
+		insert_all(children, n_children);
+		insert_all(siblings, n_siblings);
+	}
+};
+
+namespace {
+
+/** Remove pruned nodes from the frontier as they are deleted. */
+class FrontierEventHandler : public ::scip::ObjEventhdlr {
+public:
+	static constexpr auto name = "ecole::dynamics::NodeSelectionDynamics";
+
+	template <typename Frontier>
+	FrontierEventHandler(SCIP* scip, std::shared_ptr<Frontier> frontier_) :
+		ObjEventhdlr(scip, name, "Event handler tracking the open nodes"), erase{[frontier_](SCIP_Longint number) {
+			frontier_->erase(number);
+		}} {}
+
+	SCIP_RETCODE scip_init(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) override {
+		return SCIPcatchEvent(scip, SCIP_EVENTTYPE_NODEDELETE, eventhdlr, nullptr, nullptr);
+	}
+
+	SCIP_RETCODE scip_exit(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) override {
+		return SCIPdropEvent(scip, SCIP_EVENTTYPE_NODEDELETE, eventhdlr, nullptr, -1);
+	}
+
+	SCIP_RETCODE
+	scip_exec(SCIP* /*scip*/, SCIP_EVENTHDLR* /*eventhdlr*/, SCIP_EVENT* event, SCIP_EVENTDATA* /*eventdata*/)
+		override {
+		erase(SCIPnodeGetNumber(SCIPeventGetNode(event)));
+		return SCIP_OKAY;
+	}
+
+private:
+	std::function<void(SCIP_Longint)> erase;
+};
+
+/** Iterative solving until the next node selection and return the frontier. */
+template <typename Frontier>
+auto keep_solving_until_next_selection(Frontier& frontier, std::optional<scip::callback::DynamicCall> const& fcall)
+	-> std::tuple<bool, NodeSelectionDynamics::ActionSet> {
+	// Assuming the node selector is the only reverse callback
+	if (!fcall.has_value()) {
+		frontier.clear();
+		return {true, {}};
+	}
+	frontier.selected_node = std::get<scip::callback::NodeselCall>(fcall.value()).selected_node;
+	return {false, frontier.action_set()};
+}
+
+}  // namespace
+
+NodeSelectionDynamics::NodeSelectionDynamics() : frontier{std::make_shared<Frontier>()} {}
+
+auto NodeSelectionDynamics::reset_dynamics(scip::Model& model) const -> std::tuple<bool, ActionSet> {
+	frontier->clear();
+	auto* const scip = model.get_scip_ptr();
+	if (SCIPfindObjEventhdlr(scip, FrontierEventHandler::name) == nullptr) {
+		auto handler = std::make_unique<FrontierEventHandler>(scip, frontier);
+		scip::call(SCIPincludeObjEventhdlr, scip, handler.get(), true);
+		// NOLINTNEXTLINE memory ownership is passed to SCIP
+		handler.release();
+	}
+	auto constructor = scip::callback::NodeselConstructor{};
+	// Called in the solver thread while the calling thread waits on the coroutine, hence without data race.
+	constructor.handler = [frontier = frontier](
+		SCIP* scip_ptr, scip::callback::NodeselCall const& /*call*/) -> std::optional<SCIP_RESULT> {
+		frontier->update(scip_ptr);
+		if (frontier->empty()) {
+			return SCIP_DIDNOTRUN;
+		}
+		return {};
+	};
+	auto const fcall = model.solve_iter(constructor);
+	return keep_solving_until_next_selection(*frontier, fcall);
+}
+
+auto NodeSelectionDynamics::step_dynamics(scip::Model& model, Action maybe_node_number) const
+	-> std::tuple<bool, ActionSet> {
+	auto result = SCIP_DIDNOTRUN;
+	if (std::holds_alternative<std::size_t>(maybe_node_number)) {
+		auto const number = std::get<std::size_t>(maybe_node_number);
+		auto* const node = frontier->find(static_cast<SCIP_Longint>(number));
+		if (node == nullptr) {
+			throw std::invalid_argument{fmt::format("Node {} is not an open node.", number)};
+		}
+		assert(frontier->selected_node != nullptr);
+		*(frontier->selected_node) = node;
+		result = SCIP_SUCCESS;
+	}
+	frontier->selected_node = nullptr;
+	auto const fcall = model.solve_iter_continue(result);
+	return keep_solving_until_next_selection(*frontier, fcall);
+}
+
+}  // namespace ecole::dynamics
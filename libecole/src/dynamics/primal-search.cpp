@@ -1,6 +1,8 @@
 #include <algorithm>
 #include <exception>
+#include <memory>
 #include <stdexcept>
+#include <vector>
 
 #include <fmt/format.h>
 #include <xtensor/xtensor.hpp>
@@ -11,10 +13,22 @@
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/utils.hpp"
 
+#include "dynamics/linear-screen.hpp"
+#include "utility/mask.hpp"
+
 namespace ecole::dynamics {
 
-PrimalSearchDynamics::PrimalSearchDynamics(int trials_per_node_, int depth_freq_, int depth_start_, int depth_stop_) :
-	trials_per_node(trials_per_node_), depth_freq(depth_freq_), depth_start(depth_start_), depth_stop(depth_stop_) {
+PrimalSearchDynamics::PrimalSearchDynamics(
+	int trials_per_node_,
+	int depth_freq_,
+	int depth_start_,
+	int depth_stop_,
+	Screening screening_) :
+	trials_per_node(trials_per_node_),
+	depth_freq(depth_freq_),
+	depth_start(depth_start_),
+	depth_stop(depth_stop_),
+	screening(screening_) {
 	if (trials_per_node < -1) {
 		throw std::invalid_argument{fmt::format("Illegal value for number of trials per node: {}.", trials_per_node)};
 	}
@@ -49,6 +63,60 @@ auto add_solution_from_lp(SCIP* scip) -> bool {
 	return solution_kept;
 }
 
+void check_action(PrimalSearchDynamics::Action const& action, std::size_t n_vars) {
+	auto const& [var_indices, vals] = action;
+
+	// check that both spans have same size
+	if (var_indices.size() != vals.size()) {
+		throw std::invalid_argument{
+			fmt::format("Invalid action: {} variable indices for {} values.", var_indices.size(), vals.size())};
+	}
+
+	// check that variable indices are within range
+	for (auto const var_id : var_indices) {
+		if (var_id >= n_vars) {
+			throw std::invalid_argument{fmt::format("Invalid action: variable index {} is out of range.", var_id)};
+		}
+	}
+}
+
+/** Fix variables at a new probing node, solve the LP, try its solution, and backtrack. */
+template <typename Vars>
+auto try_solution(SCIP* scip_ptr, Vars const& problem_vars, PrimalSearchDynamics::Action const& action) -> bool {
+	auto const& [var_indices, vals] = action;
+	SCIP_Bool lperror = false;
+	SCIP_Bool cutoff = false;
+	auto solution_kept = false;
+
+	scip::call(SCIPnewProbingNode, scip_ptr);
+
+	// fix variables in the (partial) solution to their given values
+	for (std::size_t i = 0; i < var_indices.size(); i++) {
+		scip::call(SCIPfixVarProbing, scip_ptr, problem_vars[var_indices[i]], vals[i]);
+	}
+
+	// propagate
+	scip::call(SCIPpropagateProbing, scip_ptr, 0, &cutoff, nullptr);
+	if (!cutoff) {
+		// build the LP if needed
+		if (!SCIPisLPConstructed(scip_ptr)) {
+			scip::call(SCIPconstructLP, scip_ptr, &cutoff);
+		}
+		if (!cutoff) {
+			// solve the LP
+			scip::call(SCIPsolveProbingLP, scip_ptr, -1, &lperror, &cutoff);
+			if (!lperror && !cutoff) {
+				// try the LP solution in the original problem
+				solution_kept = add_solution_from_lp(scip_ptr);
+			}
+		}
+	}
+
+	// undo the fixings for the next solution
+	scip::call(SCIPbacktrackProbing, scip_ptr, 0);
+	return solution_kept;
+}
+
 }  // namespace
 
 auto PrimalSearchDynamics::reset_dynamics(scip::Model& model) const -> std::tuple<bool, ActionSet> {
@@ -69,65 +137,64 @@ auto PrimalSearchDynamics::reset_dynamics(scip::Model& model) const -> std::tupl
 }
 
 auto PrimalSearchDynamics::step_dynamics(scip::Model& model, Action action) -> std::tuple<bool, ActionSet> {
-	auto const [var_indices, vals] = action;
-	auto problem_vars = model.variables();
+	return step_dynamics_batch(model, nonstd::span<Action const>{&action, 1});
+}
 
-	// check that both spans have same size
-	if (var_indices.size() != vals.size()) {
-		throw std::invalid_argument{
-			fmt::format("Invalid action: {} variable indices for {} values.", var_indices.size(), vals.size())};
+auto PrimalSearchDynamics::step_dynamics_batch(scip::Model& model, nonstd::span<Action const> actions)
+	-> std::tuple<bool, ActionSet> {
+	auto problem_vars = model.variables();
+	for (auto const& action : actions) {
+		check_action(action, problem_vars.size());
 	}
 
-	// check that variable indices are within range
-	for (auto const var_id : var_indices) {
-		if (var_id >= problem_vars.size()) {
-			throw std::invalid_argument{fmt::format("Invalid action: variable index {} is out of range.", var_id)};
+	auto* scip_ptr = model.get_scip_ptr();
+	solutions_kept.assign(actions.size(), false);
+	solutions_screened_out.assign(actions.size(), false);
+
+	// Screen solutions before probing, replacing their values by the repaired ones
+	auto repaired_values = std::vector<std::vector<SCIP_Real>>(screening != Screening::none ? actions.size() : 0);
+	auto screened_actions = std::vector<Action>(actions.begin(), actions.end());
+	if (screening != Screening::none) {
+		if (screen == nullptr || screen.use_count() > 1) {
+			screen = std::make_shared<LinearScreen>();
+		}
+		screen->update(model);
+		for (std::size_t i = 0; i < actions.size(); ++i) {
+			auto const& [var_indices, vals] = actions[i];
+			if (var_indices.empty()) {
+				continue;
+			}
+			if (screen->screen(var_indices, vals, screening == Screening::repair, repaired_values[i])) {
+				screened_actions[i].second = repaired_values[i];
+			} else {
+				solutions_screened_out[i] = true;
+				screened_actions[i].first = {};
+			}
 		}
 	}
 
-	auto* scip_ptr = model.get_scip_ptr();
-	auto solution_kept = false;  // result of the current action (solution found or not)
-
-	// if the action is not empty, run a search iteration
-	// try to improve the (partial) solution by fixing variables and then re-solving the LP
-	if (not var_indices.empty()) {
-		SCIP_Bool lperror = false;
-		SCIP_Bool cutoff = false;
-
-		// enter probing mode
+	// if some action is not empty, run a search iteration
+	// try to improve the (partial) solutions by fixing variables and then re-solving the LP
+	auto const is_empty = [](auto const& action) { return action.first.empty(); };
+	if (!std::all_of(screened_actions.begin(), screened_actions.end(), is_empty)) {
+		// enter probing mode once for all actions
 		scip::call(SCIPstartProbing, scip_ptr);
-
-		// fix variables in the (partial) solution to their given values
-		for (std::size_t i = 0; i < var_indices.size(); i++) {
-			auto id = var_indices[i];
-			auto* var = problem_vars[id];
-			auto val = vals[i];
-			scip::call(SCIPfixVarProbing, scip_ptr, var, val);
-		}
-
-		// propagate
-		scip::call(SCIPpropagateProbing, scip_ptr, 0, &cutoff, nullptr);
-		if (!cutoff) {
-			// build the LP if needed
-			if (!SCIPisLPConstructed(scip_ptr)) {
-				scip::call(SCIPconstructLP, scip_ptr, &cutoff);
-			}
-			if (!cutoff) {
-				// solve the LP
-				scip::call(SCIPsolveProbingLP, scip_ptr, -1, &lperror, &cutoff);
-				if (!lperror && !cutoff) {
-					// try the LP solution in the original problem
-					solution_kept = add_solution_from_lp(scip_ptr);
+		try {
+			for (std::size_t i = 0; i < actions.size(); ++i) {
+				if (!is_empty(screened_actions[i])) {
+					solutions_kept[i] = try_solution(scip_ptr, problem_vars, screened_actions[i]);
 				}
 			}
+		} catch (...) {
+			SCIPendProbing(scip_ptr);
+			throw;
 		}
-
 		// exit probing mode
 		scip::call(SCIPendProbing, scip_ptr);
 	}
 
 	// update the final search result depending on the action result
-	if (solution_kept) {
+	if (std::find(solutions_kept.begin(), solutions_kept.end(), true) != solutions_kept.end()) {
 		result = SCIP_FOUNDSOL;
 	} else if (result == SCIP_DIDNOTRUN) {
 		result = SCIP_DIDNOTFIND;
@@ -150,4 +217,13 @@ auto PrimalSearchDynamics::step_dynamics(scip::Model& model, Action action) -> s
 	return {false, action_set(model)};
 }
 
+auto PrimalSearchDynamics::action_mask_view(scip::Model const& model, bool packed)
+	-> std::optional<nonstd::span<std::uint8_t const>> {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		return {};
+	}
+	auto& buffer = packed ? packed_mask : mask;
+	return utility::fill_variable_mask(model.pseudo_branch_cands(), model.variables().size(), packed, buffer);
+}
+
 }  // namespace ecole::dynamics
@@ -0,0 +1,114 @@
+#include <algorithm>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <utility>
+
+#include <objscip/objeventhdlr.h>
+#include <scip/scip.h>
+
+#include "ecole/dynamics/racing-configurator.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+namespace ecole::dynamics::internal {
+
+namespace {
+
+/** The primal-dual gap, between zero when solved and one when a bound is missing or the bounds have opposite signs. */
+auto primal_dual_gap(SCIP* scip) -> double {
+	if (SCIPgetStage(scip) < SCIP_STAGE_TRANSFORMED) {
+		return 1.;
+	}
+	if (SCIPgetStage(scip) == SCIP_STAGE_SOLVED) {
+		return 0.;
+	}
+	auto const primal = SCIPgetPrimalbound(scip);
+	auto const dual = SCIPgetDualbound(scip);
+	if (SCIPisInfinity(scip, std::abs(primal)) || SCIPisInfinity(scip, std::abs(dual))) {
+		return 1.;
+	}
+	if (SCIPisEQ(scip, primal, dual)) {
+		return 0.;
+	}
+	if (primal * dual < 0) {
+		return 1.;
+	}
+	return std::min(1., std::abs(primal - dual) / std::max(std::abs(primal), std::abs(dual)));
+}
+
+/** Integrate the primal-dual gap of a model at bound events, and interrupt the solving when dominated. */
+class RaceEventHandler : public ::scip::ObjEventhdlr {
+public:
+	static constexpr auto name = "ecole::race";
+	static constexpr SCIP_EVENTTYPE events = SCIP_EVENTTYPE_BESTSOLFOUND | SCIP_EVENTTYPE_NODESOLVED;
+
+	RaceEventHandler(SCIP* scip, Race const& race_) :
+		ObjEventhdlr(scip, name, "Event handler for configuration racing"), race{race_} {}
+
+	/** Find the handler of the model. */
+	static auto get(scip::Model& model) -> RaceEventHandler& {
+		auto* const handler = dynamic_cast<RaceEventHandler*>(SCIPfindObjEventhdlr(model.get_scip_ptr(), name));
+		assert(handler != nullptr);
+		return *handler;
+	}
+
+	SCIP_RETCODE scip_init(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) override {
+		return SCIPcatchEvent(scip, events, eventhdlr, nullptr, nullptr);
+	}
+
+	SCIP_RETCODE scip_exit(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) override {
+		return SCIPdropEvent(scip, events, eventhdlr, nullptr, -1);
+	}
+
+	SCIP_RETCODE
+	scip_exec(SCIP* scip, SCIP_EVENTHDLR* /*eventhdlr*/, SCIP_EVENT* /*event*/, SCIP_EVENTDATA* /*eventdata*/) override {
+		update(scip);
+		if (!interrupted && race.is_dominated(gap_integral)) {
+			SCIP_CALL(SCIPinterruptSolve(scip));
+			interrupted = true;
+		}
+		return SCIP_OKAY;
+	}
+
+	/** Integrate the previous gap until now and read the current gap. */
+	void update(SCIP* scip) {
+		auto const now = std::chrono::steady_clock::now();
+		// The gap is constant since the previous event, so the integral is exact
+		gap_integral += gap * std::chrono::duration<double>(now - last_time).count();
+		last_time = now;
+		gap = primal_dual_gap(scip);
+	}
+
+	bool interrupted = false;
+	double gap_integral = 0.;
+
+private:
+	Race const& race;
+	std::chrono::steady_clock::time_point last_time = std::chrono::steady_clock::now();
+	double gap = 1.;
+};
+
+}  // namespace
+
+void Race::enter(scip::Model& model) {
+	auto handler = std::make_unique<RaceEventHandler>(model.get_scip_ptr(), *this);
+	scip::call(SCIPincludeObjEventhdlr, model.get_scip_ptr(), handler.get(), true);
+	// NOLINTNEXTLINE memory ownership is passed to SCIP
+	handler.release();
+}
+
+auto Race::leave(scip::Model& model) -> std::pair<bool, double> {
+	auto& handler = RaceEventHandler::get(model);
+	handler.update(model.get_scip_ptr());
+	if (!handler.interrupted && model.is_solved()) {
+		// Keep the smallest integral of the configurations that solved the instance
+		auto best = best_gap_integral.load();
+		while (handler.gap_integral < best && !best_gap_integral.compare_exchange_weak(best, handler.gap_integral)) {
+		}
+	}
+	return {handler.interrupted, handler.gap_integral};
+}
+
+}  // namespace ecole::dynamics::internal
@@ -0,0 +1,95 @@
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+#include <xtensor/xsort.hpp>
+
+#include "ecole/dynamics/inline-policy-branching.hpp"
+#include "ecole/dynamics/replay-branching.hpp"
+#include "ecole/scip/model.hpp"
+
+namespace ecole::dynamics {
+
+namespace {
+
+using Candidates = ReplayBranching::Candidates;
+
+/** Raised by the policy to interrupt solving after the last recorded action. */
+struct ReplayFinished : std::exception {};
+
+auto same_candidates(Candidates const& candidates, Candidates const& recorded) -> bool {
+	if (candidates.size() != recorded.size()) {
+		return false;
+	}
+	Candidates const sorted = xt::sort(candidates);
+	Candidates const sorted_recorded = xt::sort(recorded);
+	return std::equal(sorted.begin(), sorted.end(), sorted_recorded.begin());
+}
+
+}  // namespace
+
+ReplayDivergence::ReplayDivergence(std::size_t step, std::string const& reason) :
+	std::runtime_error{fmt::format("Replay diverged from the recording at step {}: {}", step, reason)}, m_step{step} {}
+
+ReplayBranching::ReplayBranching(
+	std::vector<std::size_t> actions,
+	std::vector<Candidates> action_sets,
+	Observer observer,
+	std::vector<std::size_t> observed_steps,
+	bool pseudo_candidates) :
+	m_actions{std::move(actions)},
+	m_action_sets{std::move(action_sets)},
+	m_observer{std::move(observer)},
+	m_observed_steps{std::move(observed_steps)},
+	m_pseudo_candidates{pseudo_candidates} {
+	if (!m_action_sets.empty() && m_action_sets.size() != m_actions.size()) {
+		throw std::invalid_argument{fmt::format(
+			"Got {} recorded action sets for {} recorded actions.", m_action_sets.size(), m_actions.size())};
+	}
+}
+
+auto ReplayBranching::reset_dynamics(scip::Model& /* model */) const -> std::tuple<bool, NoneType> {
+	return {false, None};
+}
+
+auto ReplayBranching::step_dynamics(scip::Model& model, NoneType const& /* action */) -> std::tuple<bool, NoneType> {
+	m_n_replayed = 0;
+	auto next_observed = m_observed_steps.begin();
+	auto const policy = [this, &next_observed](scip::Model& m, Candidates const& candidates) -> std::size_t {
+		auto const step = m_n_replayed;
+		if (step == m_actions.size()) {
+			throw ReplayFinished{};
+		}
+		auto const action = m_actions[step];
+		if (!m_action_sets.empty() && !same_candidates(candidates, m_action_sets[step])) {
+			throw ReplayDivergence{step, "the branching candidates differ from the recorded action set."};
+		}
+		if (std::find(candidates.begin(), candidates.end(), action) == candidates.end()) {
+			throw ReplayDivergence{step, fmt::format("the recorded action {} is not a branching candidate.", action)};
+		}
+		auto const last_observed = m_observed_steps.end();
+		while (next_observed != last_observed && *next_observed < step) {
+			++next_observed;
+		}
+		auto const observed = m_observed_steps.empty() || (next_observed != last_observed && *next_observed == step);
+		if (observed && m_observer) {
+			m_observer(m, step, candidates);
+		}
+		++m_n_replayed;
+		return action;
+	};
+
+	try {
+		InlinePolicyBranching{policy, m_pseudo_candidates}.step_dynamics(model, None);
+	} catch (ReplayFinished const&) {
+		return {true, None};
+	}
+	if (model.is_solved() && m_n_replayed < m_actions.size()) {
+		throw ReplayDivergence{m_n_replayed, "the instance was solved before the last recorded action."};
+	}
+	return {true, None};
+}
+
+}  // namespace ecole::dynamics
@@ -0,0 +1,49 @@
+#include <random>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+#include <scip/scip.h>
+
+#include "ecole/dynamics/schedule.hpp"
+#include "ecole/scip/model.hpp"
+
+namespace ecole::dynamics {
+
+ObservationSchedule::ObservationSchedule(Predicate predicate_) : predicate{std::move(predicate_)} {}
+
+auto ObservationSchedule::every(std::size_t period) -> ObservationSchedule {
+	if (period == 0) {
+		throw std::invalid_argument{"The period of an observation schedule must be positive."};
+	}
+	return ObservationSchedule{[period](scip::Model& /*model*/, std::size_t n_nodes, RandomGenerator& /*rng*/) {
+		return (n_nodes - 1) % period == 0;
+	}};
+}
+
+auto ObservationSchedule::probability(double probability) -> ObservationSchedule {
+	if (!(probability >= 0. && probability <= 1.)) {
+		throw std::invalid_argument{
+			fmt::format("The probability of an observation schedule must be in [0, 1], got {}.", probability)};
+	}
+	return ObservationSchedule{[probability](scip::Model& /*model*/, std::size_t /*n_nodes*/, RandomGenerator& rng) {
+		return std::uniform_real_distribution<double>{0., 1.}(rng) < probability;
+	}};
+}
+
+auto ObservationSchedule::max_depth(std::size_t max_depth) -> ObservationSchedule {
+	return ObservationSchedule{[max_depth](scip::Model& model, std::size_t /*n_nodes*/, RandomGenerator& /*rng*/) {
+		return static_cast<std::size_t>(SCIPgetDepth(model.get_scip_ptr())) <= max_depth;
+	}};
+}
+
+auto ObservationSchedule::seed(RandomGenerator& random_engine) -> void {
+	rng.seed(std::uniform_int_distribution<Seed>{}(random_engine));
+}
+
+auto ObservationSchedule::select(scip::Model& model) -> bool {
+	++n_nodes;
+	return !predicate || predicate(model, n_nodes, rng);
+}
+
+}  // namespace ecole::dynamics
@@ -0,0 +1,118 @@
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <objscip/objeventhdlr.h>
+#include <scip/scip.h>
+
+#include "ecole/environment/stopping-criterion.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+namespace ecole::environment {
+
+namespace {
+
+/** Evaluate a stopping criterion at node and solution events, and interrupt the solving when it holds. */
+class StoppingEventHandler : public ::scip::ObjEventhdlr {
+public:
+	static constexpr auto name = "ecole::stopping";
+	static constexpr SCIP_EVENTTYPE events = SCIP_EVENTTYPE_BESTSOLFOUND | SCIP_EVENTTYPE_NODESOLVED;
+
+	StoppingEventHandler(SCIP* scip, scip::Model& model_, StoppingCriterion criterion_) :
+		ObjEventhdlr(scip, name, "Event handler for episode stopping criteria"),
+		model{&model_},
+		criterion{std::move(criterion_)} {}
+
+	/** Find the handler of the model, if any. */
+	static auto find(scip::Model& model) -> StoppingEventHandler* {
+		return dynamic_cast<StoppingEventHandler*>(SCIPfindObjEventhdlr(model.get_scip_ptr(), name));
+	}
+
+	SCIP_RETCODE scip_init(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) override {
+		return SCIPcatchEvent(scip, events, eventhdlr, nullptr, nullptr);
+	}
+
+	SCIP_RETCODE scip_exit(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) override {
+		return SCIPdropEvent(scip, events, eventhdlr, nullptr, -1);
+	}
+
+	SCIP_RETCODE
+	scip_exec(SCIP* scip, SCIP_EVENTHDLR* /*eventhdlr*/, SCIP_EVENT* /*event*/, SCIP_EVENTDATA* /*eventdata*/) override {
+		if (interrupted) {
+			return SCIP_OKAY;
+		}
+		// Exceptions must not go through SCIP, they are kept for the environment to rethrow
+		try {
+			interrupted = criterion(*model);
+		} catch (...) {
+			error = std::current_exception();
+			interrupted = true;
+		}
+		if (interrupted) {
+			SCIP_CALL(SCIPinterruptSolve(scip));
+		}
+		return SCIP_OKAY;
+	}
+
+	scip::Model* model;
+	StoppingCriterion criterion;
+	bool interrupted = false;
+	std::exception_ptr error;
+};
+
+}  // namespace
+
+auto include_stopping_criterion(scip::Model& model, StoppingCriterion criterion) -> void {
+	if (auto* const handler = StoppingEventHandler::find(model); handler != nullptr) {
+		// The handler of a previous episode is reused
+		handler->model = &model;
+		handler->criterion = std::move(criterion);
+		handler->interrupted = false;
+		handler->error = nullptr;
+		return;
+	}
+	auto handler = std::make_unique<StoppingEventHandler>(model.get_scip_ptr(), model, std::move(criterion));
+	scip::call(SCIPincludeObjEventhdlr, model.get_scip_ptr(), handler.get(), true);
+	// NOLINTNEXTLINE memory ownership is passed to SCIP
+	handler.release();
+}
+
+auto rethrow_stopping_criterion_error(scip::Model& model) -> void {
+	if (auto* const handler = StoppingEventHandler::find(model); handler != nullptr && handler->error) {
+		std::rethrow_exception(std::exchange(handler->error, nullptr));
+	}
+}
+
+auto is_stopped_by_criterion(scip::Model& model) -> bool {
+	auto const* const handler = StoppingEventHandler::find(model);
+	return handler != nullptr && handler->interrupted;
+}
+
+auto gap_below(double gap) -> StoppingCriterion {
+	return [gap](scip::Model& model) { return SCIPgetGap(model.get_scip_ptr()) <= gap; };
+}
+
+auto primal_bound_stalled(std::size_t n_nodes) -> StoppingCriterion {
+	// Copied with the criterion, so that every episode starts from a fresh state
+	struct Stall {
+		std::size_t n_nodes;
+		std::optional<SCIP_Real> primal_bound = {};
+		SCIP_Longint last_improvement = 0;
+	};
+	return [stall = Stall{n_nodes}](scip::Model& model) mutable {
+		auto* const scip = model.get_scip_ptr();
+		auto const primal_bound = SCIPgetPrimalbound(scip);
+		auto const n_solved = SCIPgetNNodes(scip);
+		if (!stall.primal_bound.has_value() || primal_bound != stall.primal_bound.value()) {
+			stall.primal_bound = primal_bound;
+			stall.last_improvement = n_solved;
+			return false;
+		}
+		return n_solved - stall.last_improvement >= static_cast<SCIP_Longint>(stall.n_nodes);
+	};
+}
+
+}  // namespace ecole::environment
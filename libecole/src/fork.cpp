@@ -0,0 +1,53 @@
+#include <cstddef>
+#include <stdexcept>
+#include <string_view>
+
+#include <fmt/format.h>
+
+#include "ecole/fork.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole {
+
+namespace {
+
+/** A problem exercising presolving, the LP, and branching, while solved in a few milliseconds. */
+constexpr std::string_view prewarm_problem = R"(Maximize
+ obj: 5 x + 4 y + 3 z
+Subject To
+ c1: 2 x + 3 y + z <= 5
+ c2: 4 x + y + 2 z <= 11
+ c3: 3 x + 4 y + 2 z <= 8
+Bounds
+ x <= 10
+ y <= 10
+ z <= 10
+Generals
+ x y z
+End
+)";
+
+}  // namespace
+
+auto n_running_threads() noexcept -> std::size_t {
+	return utility::RunningThread::count();
+}
+
+void check_fork_safe() {
+	if (auto const n_threads = n_running_threads(); n_threads > 0) {
+		throw std::runtime_error{fmt::format(
+			"{} threads created by Ecole are running, which would not exist in a forked process. They are held by models "
+			"being solved, environments in the middle of an episode, or functions created with many threads.",
+			n_threads)};
+	}
+}
+
+void prewarm(scip::PluginProfile profile) {
+	auto model = scip::Model::from_buffer(prewarm_problem, "lp", profile);
+	if (profile != scip::PluginProfile::modeling) {
+		model.solve();
+	}
+}
+
+}  // namespace ecole
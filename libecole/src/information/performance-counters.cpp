@@ -0,0 +1,25 @@
+#include <chrono>
+
+#include "ecole/information/performance-counters.hpp"
+#include "ecole/scip/model.hpp"
+
+namespace ecole::information {
+
+auto PerformanceCounters::extract(scip::Model& model, bool /*done*/) -> InformationMap<double> {
+	auto const now = std::chrono::steady_clock::now();
+	auto const statistics = model.callback_statistics();
+	auto const seconds = [](auto duration) { return std::chrono::duration<double>(duration).count(); };
+	// Before any iterative solving, there was no yield
+	auto const has_yielded = statistics.last_yield_time != std::chrono::steady_clock::time_point{};
+	return {
+		{"n_yields", static_cast<double>(statistics.n_yields)},
+		{"n_skipped_calls", static_cast<double>(statistics.n_skipped_calls)},
+		{"n_missed_deadlines", static_cast<double>(statistics.n_missed_deadlines)},
+		{"solving_time", seconds(statistics.solving_time)},
+		{"waiting_time", seconds(statistics.waiting_time)},
+		{"caller_time", seconds(statistics.caller_time)},
+		{"time_since_yield", has_yielded ? seconds(now - statistics.last_yield_time) : 0.},
+	};
+}
+
+}  // namespace ecole::information
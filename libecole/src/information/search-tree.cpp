@@ -0,0 +1,304 @@
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <objscip/objeventhdlr.h>
+#include <scip/scip.h>
+
+#include "ecole/information/search-tree.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+namespace ecole::information {
+
+namespace {
+
+/**
+ * The file is made of a header, with a magic string, the format version, and the size of records, followed by the
+ * records.
+ * Records are packed field by field, so that their size does not depend on the padding of SearchTreeRecord.
+ */
+constexpr auto file_magic = std::array<char, 8>{'E', 'C', 'O', 'L', 'E', 'T', 'R', 'E'};
+constexpr std::uint32_t file_version = 1;
+constexpr std::size_t header_size = file_magic.size() + 2 * sizeof(std::uint32_t);
+constexpr std::size_t record_size = 6 * sizeof(std::int64_t) + 2 * sizeof(std::int32_t) + 2 * sizeof(std::uint8_t);
+constexpr std::size_t records_per_chunk = 4096;
+
+using RecordBytes = std::array<char, record_size>;
+
+template <typename T> auto pack(char* out, T value) noexcept -> char* {
+	std::memcpy(out, &value, sizeof(T));
+	return out + sizeof(T);
+}
+
+template <typename T> auto unpack(char const* in, T& value) noexcept -> char const* {
+	std::memcpy(&value, in, sizeof(T));
+	return in + sizeof(T);
+}
+
+auto encode(SearchTreeRecord const& record) noexcept -> RecordBytes {
+	auto bytes = RecordBytes{};
+	auto* out = bytes.data();
+	out = pack(out, record.number);
+	out = pack(out, record.parent);
+	out = pack(out, record.lower_bound);
+	out = pack(out, record.primal_bound);
+	out = pack(out, record.branching_bound);
+	out = pack(out, record.lp_iterations);
+	out = pack(out, record.depth);
+	out = pack(out, record.branching_var);
+	out = pack(out, static_cast<std::uint8_t>(record.outcome));
+	pack(out, static_cast<std::uint8_t>(record.branching_upper));
+	return bytes;
+}
+
+auto decode(char const* in) noexcept -> SearchTreeRecord {
+	auto record = SearchTreeRecord{};
+	auto outcome = std::uint8_t{0};
+	auto upper = std::uint8_t{0};
+	in = unpack(in, record.number);
+	in = unpack(in, record.parent);
+	in = unpack(in, record.lower_bound);
+	in = unpack(in, record.primal_bound);
+	in = unpack(in, record.branching_bound);
+	in = unpack(in, record.lp_iterations);
+	in = unpack(in, record.depth);
+	in = unpack(in, record.branching_var);
+	in = unpack(in, outcome);
+	unpack(in, upper);
+	record.outcome = static_cast<NodeOutcome>(outcome);
+	record.branching_upper = upper != 0;
+	return record;
+}
+
+/** SCIP infinite values as IEEE infinity, so that records can be read without SCIP. */
+auto ieee(SCIP* scip, SCIP_Real value) noexcept -> double {
+	if (SCIPisInfinity(scip, value)) {
+		return std::numeric_limits<double>::infinity();
+	}
+	if (SCIPisInfinity(scip, -value)) {
+		return -std::numeric_limits<double>::infinity();
+	}
+	return value;
+}
+
+auto outcome_of(SCIP_EVENTTYPE type) noexcept -> NodeOutcome {
+	switch (type) {
+	case SCIP_EVENTTYPE_NODEBRANCHED:
+		return NodeOutcome::branched;
+	case SCIP_EVENTTYPE_NODEFEASIBLE:
+		return NodeOutcome::feasible;
+	default:
+		return NodeOutcome::infeasible;
+	}
+}
+
+/** Write a record of every node solved to the sink. */
+class TreeEventHandler : public ::scip::ObjEventhdlr {
+public:
+	inline static auto constexpr name = "ecole::information::SearchTreeRecorder::TreeEventHandler";
+
+	TreeEventHandler(SCIP* scip) : ObjEventhdlr(scip, name, "Event handler recording the search tree") {}
+
+	/** Find the handler of the model, creating it if needed. */
+	static auto get(scip::Model& model) -> TreeEventHandler& {
+		auto* const scip = model.get_scip_ptr();
+		if (find(model) == nullptr) {
+			auto handler = std::make_unique<TreeEventHandler>(scip);
+			scip::call(SCIPincludeObjEventhdlr, scip, handler.get(), true);
+			// NOLINTNEXTLINE memory ownership is passed to SCIP
+			handler.release();
+		}
+		auto* const handler = find(model);
+		assert(handler != nullptr);
+		return *handler;
+	}
+
+	/** Find the handler of the model, or null if it was not included. */
+	static auto find(scip::Model& model) -> TreeEventHandler* {
+		return dynamic_cast<TreeEventHandler*>(SCIPfindObjEventhdlr(model.get_scip_ptr(), name));
+	}
+
+	void set_sink(SearchTreeRecorder::Sink new_sink) { sink = std::move(new_sink); }
+
+	[[nodiscard]] auto n_records() const noexcept -> std::size_t { return n_written; }
+
+	auto scip_initsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE override {
+		n_written = 0;
+		focus_lp_iterations = 0;
+		return SCIPcatchEvent(scip, events, eventhdlr, nullptr, nullptr);
+	}
+
+	auto scip_exitsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE override {
+		return SCIPdropEvent(scip, events, eventhdlr, nullptr, -1);
+	}
+
+	auto scip_exec(SCIP* scip, SCIP_EVENTHDLR* /*eventhdlr*/, SCIP_EVENT* event, SCIP_EVENTDATA* /*eventdata*/)
+		-> SCIP_RETCODE override {
+		auto const type = SCIPeventGetType(event);
+		if (type == SCIP_EVENTTYPE_NODEFOCUSED) {
+			focus_lp_iterations = SCIPgetNLPIterations(scip);
+			return SCIP_OKAY;
+		}
+		if (!sink) {
+			return SCIP_OKAY;
+		}
+		auto* const node = SCIPeventGetNode(event);
+		auto record = SearchTreeRecord{};
+		record.number = SCIPnodeGetNumber(node);
+		record.depth = SCIPnodeGetDepth(node);
+		record.lower_bound = ieee(scip, SCIPnodeGetLowerbound(node));
+		record.primal_bound = ieee(scip, SCIPgetUpperbound(scip));
+		record.lp_iterations = SCIPgetNLPIterations(scip) - focus_lp_iterations;
+		record.outcome = outcome_of(type);
+		if (auto* const parent = SCIPnodeGetParent(node); parent != nullptr) {
+			record.parent = SCIPnodeGetNumber(parent);
+			SCIP_VAR* var = nullptr;
+			SCIP_Real bound = 0.;
+			auto bound_type = SCIP_BOUNDTYPE_LOWER;
+			int n_branchings = 0;
+			SCIPnodeGetParentBranchings(node, &var, &bound, &bound_type, &n_branchings, 1);
+			if (n_branchings > 0 && var != nullptr) {
+				record.branching_var = SCIPvarGetProbindex(var);
+				record.branching_bound = bound;
+				record.branching_upper = bound_type == SCIP_BOUNDTYPE_UPPER;
+			}
+		}
+		// Exceptions must not go through SCIP C code
+		try {
+			sink(record);
+		} catch (...) {
+			m_error = std::current_exception();
+			sink = nullptr;
+			return SCIPinterruptSolve(scip);
+		}
+		++n_written;
+		return SCIP_OKAY;
+	}
+
+	/** Rethrow the exception raised by the sink, if any. */
+	void rethrow() {
+		if (m_error) {
+			std::rethrow_exception(std::exchange(m_error, nullptr));
+		}
+	}
+
+private:
+	static inline auto constexpr events = SCIP_EVENTTYPE_NODEFOCUSED | SCIP_EVENTTYPE_NODESOLVED;
+
+	SearchTreeRecorder::Sink sink;
+	std::size_t n_written = 0;
+	SCIP_Longint focus_lp_iterations = 0;
+	std::exception_ptr m_error = nullptr;  // NOLINT(bugprone-throw-keyword-missing)
+};
+
+}  // namespace
+
+SearchTreeRecorder::SearchTreeRecorder(std::filesystem::path const& filename) {
+	auto file = std::make_shared<std::ofstream>(filename, std::ios::binary | std::ios::trunc);
+	if (!*file) {
+		throw std::runtime_error{fmt::format("Cannot open {} for writing.", filename.string())};
+	}
+	file->write(file_magic.data(), file_magic.size());
+	auto header = std::array<char, 2 * sizeof(std::uint32_t)>{};
+	pack(pack(header.data(), file_version), static_cast<std::uint32_t>(record_size));
+	file->write(header.data(), header.size());
+	// The stream buffer bounds the memory used, however large the tree
+	sink = [file](SearchTreeRecord const& record) {
+		auto const bytes = encode(record);
+		if (!file->write(bytes.data(), bytes.size())) {
+			throw std::runtime_error{"Cannot write search tree record."};
+		}
+	};
+	flush = [file] { file->flush(); };
+}
+
+SearchTreeRecorder::SearchTreeRecorder(Sink sink_) : sink{std::move(sink_)} {}
+
+auto SearchTreeRecorder::before_reset(scip::Model& model) -> void {
+	TreeEventHandler::get(model).set_sink(sink);
+}
+
+auto SearchTreeRecorder::extract(scip::Model& model, bool done) -> InformationMap<double> {
+	// Handlers cannot be included while solving, so nothing is recorded on a model not reset by the function
+	auto* const handler = TreeEventHandler::find(model);
+	if (handler == nullptr) {
+		return {};
+	}
+	handler->rethrow();
+	if (done && flush) {
+		flush();
+	}
+	return {{"n_records", static_cast<double>(handler->n_records())}};
+}
+
+SearchTreeReader::SearchTreeReader(std::filesystem::path const& filename_) : filename{filename_} {
+	auto file = std::ifstream{filename, std::ios::binary | std::ios::ate};
+	if (!file) {
+		throw std::runtime_error{fmt::format("Cannot open {} for reading.", filename.string())};
+	}
+	auto const file_size = static_cast<std::size_t>(file.tellg());
+	auto header = std::array<char, header_size>{};
+	file.seekg(0);
+	if (file_size < header_size || !file.read(header.data(), header.size())) {
+		throw std::runtime_error{fmt::format("{} is not a search tree file.", filename.string())};
+	}
+	auto version = std::uint32_t{0};
+	auto size = std::uint32_t{0};
+	unpack(unpack(header.data() + file_magic.size(), version), size);
+	if (std::memcmp(header.data(), file_magic.data(), file_magic.size()) != 0 || version != file_version ||
+		size != record_size) {
+		auto const message = fmt::format("{} is not a search tree file of version {}.", filename.string(), file_version);
+		throw std::runtime_error{message};
+	}
+	n_records = (file_size - header_size) / record_size;
+}
+
+auto SearchTreeReader::read(std::size_t index) const -> SearchTreeRecord {
+	if (index >= n_records) {
+		throw std::out_of_range{fmt::format("Record {} out of {} records.", index, n_records)};
+	}
+	auto file = std::ifstream{filename, std::ios::binary};
+	file.seekg(static_cast<std::streamoff>(header_size + index * record_size));
+	auto bytes = RecordBytes{};
+	if (!file.read(bytes.data(), bytes.size())) {
+		throw std::runtime_error{fmt::format("Cannot read record {} of {}.", index, filename.string())};
+	}
+	return decode(bytes.data());
+}
+
+void SearchTreeReader::for_each(std::function<void(SearchTreeRecord const&)> const& func) const {
+	auto file = std::ifstream{filename, std::ios::binary};
+	file.seekg(static_cast<std::streamoff>(header_size));
+	auto buffer = std::vector<char>(records_per_chunk * record_size);
+	for (std::size_t first = 0; first < n_records; first += records_per_chunk) {
+		auto const n_chunk = std::min(records_per_chunk, n_records - first);
+		if (!file.read(buffer.data(), static_cast<std::streamsize>(n_chunk * record_size))) {
+			throw std::runtime_error{fmt::format("Cannot read records of {}.", filename.string())};
+		}
+		for (std::size_t i = 0; i < n_chunk; ++i) {
+			func(decode(buffer.data() + i * record_size));
+		}
+	}
+}
+
+auto SearchTreeReader::read_all() const -> std::vector<SearchTreeRecord> {
+	auto records = std::vector<SearchTreeRecord>{};
+	records.reserve(n_records);
+	for_each([&records](auto const& record) { records.push_back(record); });
+	return records;
+}
+
+}  // namespace ecole::information
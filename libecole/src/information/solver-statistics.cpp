@@ -0,0 +1,136 @@
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#include <fmt/format.h>
+#include <scip/scip.h>
+
+#include "ecole/information/solver-statistics.hpp"
+#include "ecole/scip/model.hpp"
+
+namespace ecole::information {
+
+namespace {
+
+/** Stages in which SCIP provides the solving statistics. */
+auto has_statistics(SCIP_STAGE stage) noexcept -> bool {
+	switch (stage) {
+	case SCIP_STAGE_PRESOLVING:
+	case SCIP_STAGE_PRESOLVED:
+	case SCIP_STAGE_SOLVING:
+	case SCIP_STAGE_SOLVED:
+		return true;
+	default:
+		return false;
+	}
+}
+
+template <typename Plugin, typename GetName, typename GetTime>
+void add_plugin_times(
+	SolverStatisticsData& data,
+	char const* type,
+	Plugin** plugins,
+	int n_plugins,
+	GetName get_name,
+	GetTime get_time) {
+	for (int i = 0; i < n_plugins; ++i) {
+		data.plugin_times.emplace_back(
+			fmt::format("{}/{}", type, get_name(plugins[i])), static_cast<double>(get_time(plugins[i])));
+	}
+}
+
+void collect_plugin_times(SCIP* scip, SolverStatisticsData& data) {
+	data.plugin_times.reserve(static_cast<std::size_t>(
+		SCIPgetNHeurs(scip) + SCIPgetNSepas(scip) + SCIPgetNProps(scip) + SCIPgetNPresols(scip) +
+		SCIPgetNBranchrules(scip)));
+	add_plugin_times(data, "heuristic", SCIPgetHeurs(scip), SCIPgetNHeurs(scip), SCIPheurGetName, SCIPheurGetTime);
+	add_plugin_times(data, "separator", SCIPgetSepas(scip), SCIPgetNSepas(scip), SCIPsepaGetName, SCIPsepaGetTime);
+	add_plugin_times(data, "propagator", SCIPgetProps(scip), SCIPgetNProps(scip), SCIPpropGetName, SCIPpropGetTime);
+	add_plugin_times(
+		data, "presolver", SCIPgetPresols(scip), SCIPgetNPresols(scip), SCIPpresolGetName, SCIPpresolGetTime);
+	add_plugin_times(
+		data,
+		"branching_rule",
+		SCIPgetBranchrules(scip),
+		SCIPgetNBranchrules(scip),
+		SCIPbranchruleGetName,
+		SCIPbranchruleGetTime);
+}
+
+}  // namespace
+
+auto SolverStatistics::collect(scip::Model& model) const -> SolverStatisticsData {
+	auto data = SolverStatisticsData{};
+	auto* const scip = model.get_scip_ptr();
+	// Plugins are always listed so that the information keys do not depend on the stage
+	if (parameters.plugin_times) {
+		collect_plugin_times(scip, data);
+	}
+	if (!has_statistics(model.stage())) {
+		return data;
+	}
+
+	if (parameters.nodes) {
+		data.n_nodes = static_cast<std::uint64_t>(SCIPgetNNodes(scip));
+		data.n_total_nodes = static_cast<std::uint64_t>(SCIPgetNTotalNodes(scip));
+	}
+	if (parameters.lp_iterations) {
+		data.n_lp_iterations = static_cast<std::uint64_t>(SCIPgetNLPIterations(scip));
+		data.n_root_lp_iterations = static_cast<std::uint64_t>(SCIPgetNRootLPIterations(scip));
+		data.n_primal_lp_iterations = static_cast<std::uint64_t>(SCIPgetNPrimalLPIterations(scip));
+		data.n_dual_lp_iterations = static_cast<std::uint64_t>(SCIPgetNDualLPIterations(scip));
+		data.n_barrier_lp_iterations = static_cast<std::uint64_t>(SCIPgetNBarrierLPIterations(scip));
+		data.n_strong_branching_lp_iterations = static_cast<std::uint64_t>(SCIPgetNStrongbranchLPIterations(scip));
+		data.n_diving_lp_iterations = static_cast<std::uint64_t>(SCIPgetNDivingLPIterations(scip));
+	}
+	if (parameters.cuts) {
+		data.n_cuts_found = static_cast<std::uint64_t>(SCIPgetNCutsFound(scip));
+		data.n_cuts_applied = static_cast<std::uint64_t>(SCIPgetNCutsApplied(scip));
+	}
+	if (parameters.separation_rounds) {
+		data.n_separation_rounds = static_cast<std::uint64_t>(SCIPgetNSepaRounds(scip));
+	}
+	if (parameters.times) {
+		data.presolving_time = SCIPgetPresolvingTime(scip);
+		data.solving_time = SCIPgetSolvingTime(scip);
+	}
+	return data;
+}
+
+auto SolverStatistics::extract(scip::Model& model, bool /*done*/) -> InformationMap<double> {
+	auto data = collect(model);
+	auto info = InformationMap<double>{};
+	// Upper bound on the number of statistics, so that all entries fit in a single allocation
+	info.reserve(14 + data.plugin_times.size());
+	auto const add = [&info](char const* name, auto value) { info.emplace(name, static_cast<double>(value)); };
+	if (parameters.nodes) {
+		add("n_nodes", data.n_nodes);
+		add("n_total_nodes", data.n_total_nodes);
+	}
+	if (parameters.lp_iterations) {
+		add("n_lp_iterations", data.n_lp_iterations);
+		add("n_root_lp_iterations", data.n_root_lp_iterations);
+		add("n_primal_lp_iterations", data.n_primal_lp_iterations);
+		add("n_dual_lp_iterations", data.n_dual_lp_iterations);
+		add("n_barrier_lp_iterations", data.n_barrier_lp_iterations);
+		add("n_strong_branching_lp_iterations", data.n_strong_branching_lp_iterations);
+		add("n_diving_lp_iterations", data.n_diving_lp_iterations);
+	}
+	if (parameters.cuts) {
+		add("n_cuts_found", data.n_cuts_found);
+		add("n_cuts_applied", data.n_cuts_applied);
+	}
+	if (parameters.separation_rounds) {
+		add("n_separation_rounds", data.n_separation_rounds);
+	}
+	if (parameters.times) {
+		add("presolving_time", data.presolving_time);
+		add("solving_time", data.solving_time);
+	}
+	for (auto& [name, time] : data.plugin_times) {
+		info.emplace("time/" + name, time);
+	}
+	return info;
+}
+
+}  // namespace ecole::information
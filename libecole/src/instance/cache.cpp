@@ -0,0 +1,160 @@
+#include <algorithm>
+#include <system_error>
+#include <utility>
+
+#include "ecole/instance/cache.hpp"
+#include "ecole/scip/cons.hpp"
+#include "ecole/utility/metrics.hpp"
+
+namespace ecole::instance {
+
+namespace {
+
+auto modification_time(std::string const& filename) -> std::filesystem::file_time_type {
+	auto error = std::error_code{};
+	auto const time = std::filesystem::last_write_time(filename, error);
+	// Missing files fail when read, so the time does not matter
+	return error ? std::filesystem::file_time_type{} : time;
+}
+
+auto count_nonzeros(scip::Model const& model) -> std::size_t {
+	auto const* const scip = model.get_scip_ptr();
+	auto n_nonzeros = model.variables().size();
+	for (auto const* const cons : model.constraints()) {
+		n_nonzeros += scip::get_cons_n_vars(scip, cons).value_or(0);
+	}
+	return n_nonzeros;
+}
+
+}  // namespace
+
+InstanceCache::InstanceCache(std::size_t max_nonzeros) noexcept : m_max_nonzeros{max_nonzeros} {}
+
+auto InstanceCache::get(std::string const& filename) -> scip::Model {
+	// Templates are copied outside of the lock, and only one thread at a time copies a given template
+	auto model = acquire(filename);
+	try {
+		auto copy = model.model.copy_orig();
+		release(filename, std::move(model));
+		return copy;
+	} catch (...) {
+		release(filename, std::move(model));
+		throw;
+	}
+}
+
+auto InstanceCache::size() const -> std::size_t {
+	auto const lk = std::lock_guard{m_pools_mutex};
+	return m_pools.size();
+}
+
+auto InstanceCache::n_templates(std::string const& filename) const -> std::size_t {
+	auto const lk = std::lock_guard{m_pools_mutex};
+	if (auto const iter = m_pools.find(filename); iter != m_pools.end()) {
+		return iter->second.n_templates;
+	}
+	return 0;
+}
+
+auto InstanceCache::n_nonzeros() const -> std::size_t {
+	auto const lk = std::lock_guard{m_pools_mutex};
+	return m_n_nonzeros;
+}
+
+void InstanceCache::clear() {
+	auto dropped = std::vector<scip::Model>{};
+	auto const lk = std::lock_guard{m_pools_mutex};
+	while (!m_pools.empty()) {
+		auto models = drop_pool(m_pools.begin());
+		std::move(models.begin(), models.end(), std::back_inserter(dropped));
+	}
+}
+
+auto InstanceCache::acquire(std::string const& filename) -> Template {
+	static auto constexpr help = "Instances requested from caches, found as a template or read from file.";
+	static auto& n_hits = utility::metrics::counter("ecole_instance_cache_requests_total", help, {{"result", "hit"}});
+	static auto& n_misses = utility::metrics::counter("ecole_instance_cache_requests_total", help, {{"result", "miss"}});
+	auto const time = modification_time(filename);
+	{
+		auto dropped = std::vector<scip::Model>{};
+		auto const lk = std::lock_guard{m_pools_mutex};
+		if (auto const iter = m_pools.find(filename); iter != m_pools.end()) {
+			auto& pool = iter->second;
+			if (pool.modification_time != time) {
+				// The file was modified since it was read
+				dropped = drop_pool(iter);
+			} else if (!pool.available.empty()) {
+				auto model = std::move(pool.available.back());
+				pool.available.pop_back();
+				pool.last_use = ++m_clock;
+				n_hits.add();
+				return {std::move(model), pool.id};
+			}
+		}
+	}
+	n_misses.add();
+	// Reading is slow so it is also done outside of the lock
+	auto model = scip::Model::from_file(filename);
+	auto const n_nonzeros = count_nonzeros(model);
+	auto const lk = std::lock_guard{m_pools_mutex};
+	auto [iter, inserted] = m_pools.try_emplace(filename);
+	auto& pool = iter->second;
+	if (inserted) {
+		pool.id = ++m_clock;
+		pool.modification_time = time;
+		pool.n_nonzeros = n_nonzeros;
+	} else if (pool.modification_time != time) {
+		// Another thread read a different version of the file, so this template is not cached
+		return {std::move(model), 0};
+	}
+	++pool.n_templates;
+	m_n_nonzeros += pool.n_nonzeros;
+	pool.last_use = ++m_clock;
+	return {std::move(model), pool.id};
+}
+
+void InstanceCache::release(std::string const& filename, Template&& model) {
+	auto dropped = std::vector<scip::Model>{};
+	auto const lk = std::lock_guard{m_pools_mutex};
+	// Templates acquired before the cache was cleared or the file modified are dropped
+	if (auto const iter = m_pools.find(filename); iter != m_pools.end() && iter->second.id == model.pool_id) {
+		iter->second.available.push_back(std::move(model.model));
+		dropped = evict();
+	}
+}
+
+auto InstanceCache::drop_pool(std::map<std::string, Pool>::iterator iter) -> std::vector<scip::Model> {
+	auto& pool = iter->second;
+	m_n_nonzeros -= pool.n_templates * pool.n_nonzeros;
+	auto models = std::move(pool.available);
+	m_pools.erase(iter);
+	return models;
+}
+
+auto InstanceCache::evict() -> std::vector<scip::Model> {
+	auto dropped = std::vector<scip::Model>{};
+	while (m_n_nonzeros > m_max_nonzeros) {
+		// Linear search of the least recently used pool, which is small compared to reading a file
+		auto lru = m_pools.end();
+		for (auto iter = m_pools.begin(); iter != m_pools.end(); ++iter) {
+			if (!iter->second.available.empty() && (lru == m_pools.end() || iter->second.last_use < lru->second.last_use)) {
+				lru = iter;
+			}
+		}
+		if (lru == m_pools.end()) {
+			// All remaining templates are being copied
+			break;
+		}
+		auto& pool = lru->second;
+		dropped.push_back(std::move(pool.available.back()));
+		pool.available.pop_back();
+		--pool.n_templates;
+		m_n_nonzeros -= pool.n_nonzeros;
+		if (pool.n_templates == 0) {
+			m_pools.erase(lru);
+		}
+	}
+	return dropped;
+}
+
+}  // namespace ecole::instance
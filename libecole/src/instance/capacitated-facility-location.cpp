@@ -1,13 +1,14 @@
 #include <array>
+#include <cmath>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 #include <range/v3/view/enumerate.hpp>
 #include <xtensor/xmath.hpp>
 #include <xtensor/xrandom.hpp>
 #include <xtensor/xtensor.hpp>
-#include <xtensor/xview.hpp>
 
 #include "ecole/instance/capacitated-facility-location.hpp"
 #include "ecole/scip/cons.hpp"
@@ -15,6 +16,8 @@
 #include "ecole/scip/utils.hpp"
 #include "ecole/scip/var.hpp"
 
+#include "instance/names.hpp"
+
 namespace views = ranges::views;
 
 namespace ecole::instance {
@@ -41,6 +44,14 @@ void CapacitatedFacilityLocationGenerator::seed(Seed seed) {
 	rng.seed(seed);
 }
 
+auto CapacitatedFacilityLocationGenerator::save_state() const -> std::string {
+	return serialize_binary(rng);
+}
+
+void CapacitatedFacilityLocationGenerator::load_state(std::string_view state) {
+	rng = deserialize_binary(state);
+}
+
 /*************************************************************
  *  CapacitatedFacilityLocationGenerator::generate_instance  *
  *************************************************************/
@@ -51,21 +62,30 @@ using value_type = SCIP_Real;
 using xvector = xt::xtensor<value_type, 1>;
 using xmatrix = xt::xtensor<value_type, 2>;
 
-/** Function to sample the unit transporation costs matrix between customers and facilities.
+/** Function to sample the transporation costs matrix between customers and facilities.
  *
- * The costs are sampled per unit of demand, as described in Cornuejols et al. (1991).
+ * The costs are sampled per unit of demand, as described in Cornuejols et al. (1991), and multiplied by the customer
+ * demands.
+ * Only the locations are sampled, and the costs are written in a single pass over the output matrix.
  */
-auto unit_transportation_costs(std::size_t n_customers, std::size_t n_facilities, RandomGenerator& rng) -> xmatrix {
-	// To sample a random matrix. Explicit casting in return type to avoid xtensor lazy numer generation.
-	auto rand = [&rng](auto n, auto m) -> xmatrix { return xt::random::rand<value_type>({n, m}, 0., 1., rng); };
+auto transportation_costs(xvector const& demands, std::size_t n_facilities, RandomGenerator& rng) -> xmatrix {
+	auto const n_customers = demands.size();
+	// Sampled in sequence so that the order of draws is well defined.
+	auto const customers_x = static_cast<xvector>(xt::random::rand<value_type>({n_customers}, 0., 1., rng));
+	auto const facilities_x = static_cast<xvector>(xt::random::rand<value_type>({n_facilities}, 0., 1., rng));
+	auto const customers_y = static_cast<xvector>(xt::random::rand<value_type>({n_customers}, 0., 1., rng));
+	auto const facilities_y = static_cast<xvector>(xt::random::rand<value_type>({n_facilities}, 0., 1., rng));
 
 	auto constexpr scaling = value_type{10.};
-	auto costs = scaling * xt::sqrt(
-													 xt::square(rand(n_customers, std::size_t{1}) - rand(std::size_t{1}, n_facilities)) +
-													 xt::square(rand(n_customers, std::size_t{1}) - rand(std::size_t{1}, n_facilities)));
-
-	assert(costs.shape()[0] == n_customers);
-	assert(costs.shape()[1] == n_facilities);
+	auto costs = xmatrix::from_shape({n_customers, n_facilities});
+	for (std::size_t customer_idx = 0; customer_idx < n_customers; ++customer_idx) {
+		auto const scaled_demand = scaling * demands[customer_idx];
+		for (std::size_t facility_idx = 0; facility_idx < n_facilities; ++facility_idx) {
+			auto const dx = customers_x[customer_idx] - facilities_x[facility_idx];
+			auto const dy = customers_y[customer_idx] - facilities_y[facility_idx];
+			costs(customer_idx, facility_idx) = scaled_demand * std::sqrt(dx * dx + dy * dy);
+		}
+	}
 	return costs;
 }
 
@@ -75,9 +95,8 @@ auto unit_transportation_costs(std::size_t n_customers, std::size_t n_facilities
  * by the scip*. Their lifetime should not exceed that of the scip* (although that was already implied when creating
  * them).
  */
-auto add_facility_var(SCIP* scip, std::size_t idx, SCIP_Real cost) -> SCIP_VAR* {
-	auto const name = fmt::format("f_{}", idx);
-	auto unique_var = scip::create_var_basic(scip, name.c_str(), 0., 1., cost, SCIP_VARTYPE_BINARY);
+auto add_facility_var(SCIP* scip, std::size_t idx, SCIP_Real cost, NameFormatter& name) -> SCIP_VAR* {
+	auto unique_var = scip::create_var_basic(scip, name("f_{}", idx), 0., 1., cost, SCIP_VARTYPE_BINARY);
 	auto* var_ptr = unique_var.get();
 	scip::call(SCIPaddVar, scip, var_ptr);
 	return var_ptr;
@@ -87,11 +106,11 @@ auto add_facility_var(SCIP* scip, std::size_t idx, SCIP_Real cost) -> SCIP_VAR*
  *
  * Variable pointers are returned in a array with as many entries as there are facilities.
  */
-auto add_facility_vars(SCIP* scip, xvector const& fixed_costs) {
+auto add_facility_vars(SCIP* scip, xvector const& fixed_costs, NameFormatter& name) {
 	auto vars = xt::xtensor<SCIP_VAR*, 1>{fixed_costs.shape(), nullptr};
 	auto* out_iter = vars.begin();
 	for (auto [idx, cost] : views::enumerate(fixed_costs)) {
-		*(out_iter++) = add_facility_var(scip, idx, cost);
+		*(out_iter++) = add_facility_var(scip, idx, cost, name);
 	}
 	return vars;
 }
@@ -102,11 +121,20 @@ auto add_facility_vars(SCIP* scip, xvector const& fixed_costs) {
  * by the scip*. Their lifetime should not exceed that of the scip* (although that was already implied when creating
  * them).
  */
-auto add_serving_var(SCIP* scip, std::size_t customer_idx, std::size_t facility_idx, SCIP_Real cost, bool continuous)
-	-> SCIP_VAR* {
-	auto const name = fmt::format("s_{}_{}", customer_idx, facility_idx);
+auto add_serving_var(
+	SCIP* scip,
+	std::size_t customer_idx,
+	std::size_t facility_idx,
+	SCIP_Real cost,
+	bool continuous,
+	NameFormatter& name) -> SCIP_VAR* {
 	auto unique_var = scip::create_var_basic(
-		scip, name.c_str(), 0., 1., cost, continuous ? SCIP_VARTYPE_CONTINUOUS : SCIP_VARTYPE_BINARY);
+		scip,
+		name("s_{}_{}", customer_idx, facility_idx),
+		0.,
+		1.,
+		cost,
+		continuous ? SCIP_VARTYPE_CONTINUOUS : SCIP_VARTYPE_BINARY);
 	auto* var_ptr = unique_var.get();
 	scip::call(SCIPaddVar, scip, var_ptr);
 	return var_ptr;
@@ -116,13 +144,13 @@ auto add_serving_var(SCIP* scip, std::size_t customer_idx, std::size_t facility_
  *
  * Variables pointers are returned in a matrix where rows reprensent customers and columns reprensent facilities.
  */
-auto add_serving_vars(SCIP* scip, xmatrix const& transportation_costs, bool continuous) {
+auto add_serving_vars(SCIP* scip, xmatrix const& transportation_costs, bool continuous, NameFormatter& name) {
 	auto const [n_customers, n_facilities] = transportation_costs.shape();
 	auto vars = xt::xtensor<SCIP_VAR*, 2>{{n_customers, n_facilities}, nullptr};
 	for (std::size_t customer_idx = 0; customer_idx < n_customers; ++customer_idx) {
 		for (std::size_t facility_idx = 0; facility_idx < n_facilities; ++facility_idx) {
 			auto cost = transportation_costs(customer_idx, facility_idx);
-			vars(customer_idx, facility_idx) = add_serving_var(scip, customer_idx, facility_idx, cost, continuous);
+			vars(customer_idx, facility_idx) = add_serving_var(scip, customer_idx, facility_idx, cost, continuous, name);
 		}
 	}
 	return vars;
@@ -134,7 +162,7 @@ auto add_serving_vars(SCIP* scip, xmatrix const& transportation_costs, bool cont
  * That is, fractions served through each facilities sum to one.
  * Constraints are relased automatically (through unique_ptr in scip::create_cons_basic_linear).
  */
-auto add_demand_cons(SCIP* scip, xt::xtensor<SCIP_VAR*, 2> const& serving_vars) -> void {
+auto add_demand_cons(SCIP* scip, xt::xtensor<SCIP_VAR*, 2> const& serving_vars, NameFormatter& name) -> void {
 	auto const inf = SCIPinfinity(scip);
 	auto const [n_customers, n_facilities] = serving_vars.shape();
 	// Asserting row major as we pass the pointer as an array to SCIP when creating constraints
@@ -144,9 +172,8 @@ auto add_demand_cons(SCIP* scip, xt::xtensor<SCIP_VAR*, 2> const& serving_vars)
 	// Gasse et al. Exact combinatorial optimization with graph convolutional neural networks 2019.
 	auto const coefs = xvector({n_facilities}, 1.);
 	for (std::size_t customer_idx = 0; customer_idx < n_customers; ++customer_idx) {
-		auto const name = fmt::format("d_{}", customer_idx);
 		auto cons = scip::create_cons_basic_linear(
-			scip, name.c_str(), n_facilities, &serving_vars(customer_idx, 0), coefs.data(), 1.0, inf);
+			scip, name("d_{}", customer_idx), n_facilities, &serving_vars(customer_idx, 0), coefs.data(), 1.0, inf);
 		scip::call(SCIPaddCons, scip, cons.get());
 	}
 }
@@ -155,29 +182,34 @@ auto add_demand_cons(SCIP* scip, xt::xtensor<SCIP_VAR*, 2> const& serving_vars)
  *
  * For each facility the sum of all fraction of demand served, multiplied by the demand, must be smaller than the
  * facility capacity.
+ * The variables of a facility are gathered in a buffer, along with the facility variable, rather than transposing the
+ * whole matrix of serving variables.
  * Constraints are relased automatically (through unique_ptr in scip::create_cons_basic_linear).
  */
 auto add_capacity_cons(
 	SCIP* scip,
-	xt::xtensor<SCIP_VAR*, 2> serving_vars,
+	xt::xtensor<SCIP_VAR*, 2> const& serving_vars,
 	xt::xtensor<SCIP_VAR*, 1> const& facility_vars,
 	xvector const& demands,
-	xvector const& capacities) -> void {
+	xvector const& capacities,
+	NameFormatter& name) -> void {
 	auto const inf = SCIPinfinity(scip);
-	// Transposing and asserting row major as we pass the pointer as an array to SCIP when creating constraints.
-	serving_vars = xt::transpose(std::move(serving_vars));
-	assert(serving_vars.layout() == xt::layout_type::row_major);
-
-	auto const [n_facilities, n_customers] = serving_vars.shape();
+	auto const [n_customers, n_facilities] = serving_vars.shape();
 	assert(facility_vars.size() == n_facilities);
 	assert(demands.size() == n_customers);
 	assert(capacities.size() == n_facilities);
 
+	auto cons_vars = std::vector<SCIP_VAR*>(n_customers + 1);
+	auto cons_coefs = std::vector<SCIP_Real>(demands.begin(), demands.end());
+	cons_coefs.push_back(0.);
 	for (std::size_t facility_idx = 0; facility_idx < n_facilities; ++facility_idx) {
-		auto const name = fmt::format("c_{}", facility_idx);
+		for (std::size_t customer_idx = 0; customer_idx < n_customers; ++customer_idx) {
+			cons_vars[customer_idx] = serving_vars(customer_idx, facility_idx);
+		}
+		cons_vars[n_customers] = facility_vars[facility_idx];
+		cons_coefs[n_customers] = -capacities[facility_idx];
 		auto cons = scip::create_cons_basic_linear(
-			scip, name.c_str(), n_customers, &serving_vars(facility_idx, 0), demands.data(), -inf, 0.);
-		scip::call(SCIPaddCoefLinear, scip, cons.get(), facility_vars[facility_idx], -capacities[facility_idx]);
+			scip, name("c_{}", facility_idx), cons_vars.size(), cons_vars.data(), cons_coefs.data(), -inf, 0.);
 		scip::call(SCIPaddCons, scip, cons.get());
 	}
 }
@@ -191,7 +223,8 @@ auto add_tightening_cons(
 	xt::xtensor<SCIP_VAR*, 2> const& serving_vars,
 	xt::xtensor<SCIP_VAR*, 1> const& facility_vars,
 	xvector const& demands,
-	xvector const& capacities) -> void {
+	xvector const& capacities,
+	NameFormatter& name) -> void {
 	auto const inf = SCIPinfinity(scip);
 	auto const [n_customers, n_facilities] = serving_vars.shape();
 	assert(facility_vars.size() == n_facilities);
@@ -199,16 +232,16 @@ auto add_tightening_cons(
 	// Open facilities must satisfy the total demand.
 	auto total_demand = xt::sum(demands)();
 	auto global_cons = scip::create_cons_basic_linear(
-		scip, "t_total_demand", n_facilities, facility_vars.data(), capacities.data(), total_demand, inf);
+		scip, name("t_total_demand"), n_facilities, facility_vars.data(), capacities.data(), total_demand, inf);
 	scip::call(SCIPaddCons, scip, global_cons.get());
 
 	// A closed facility cannot serve any customer.
 	for (std::size_t customer_idx = 0; customer_idx < n_customers; ++customer_idx) {
 		for (std::size_t facility_idx = 0; facility_idx < n_facilities; ++facility_idx) {
-			auto const name = fmt::format("t_{}_{}", customer_idx, facility_idx);
 			auto const vars = std::array{serving_vars(customer_idx, facility_idx), facility_vars[facility_idx]};
 			auto constexpr coefs = std::array<SCIP_Real, 2>{1., -1};
-			auto cons = scip::create_cons_basic_linear(scip, name.c_str(), vars.size(), vars.data(), coefs.data(), -inf, 0.);
+			auto cons = scip::create_cons_basic_linear(
+				scip, name("t_{}_{}", customer_idx, facility_idx), vars.size(), vars.data(), coefs.data(), -inf, 0.);
 			scip::call(SCIPaddCons, scip, cons.get());
 		}
 	}
@@ -236,24 +269,24 @@ scip::Model CapacitatedFacilityLocationGenerator::generate_instance(
 		randint(parameters.n_facilities, parameters.fixed_cost_scale_interval) * xt::sqrt(capacities) +
 		randint(parameters.n_facilities, parameters.fixed_cost_cste_interval));
 	// transport costs from facility to customers
-	auto const transportation_costs = static_cast<xmatrix>(
-		unit_transportation_costs(parameters.n_customers, parameters.n_facilities, rng) *
-		xt::view(demands, xt::all(), xt::newaxis()));
+	auto const costs = transportation_costs(demands, parameters.n_facilities, rng);
 
 	// Scale capacities according to ratio after sampling as stated in Cornuejols et al. (1991).
 	capacities = capacities * parameters.ratio * xt::sum(demands)() / xt::sum(capacities)();
 	capacities = xt::nearbyint(capacities);
 
-	auto model = scip::Model::prob_basic();
-	model.set_name(fmt::format("CapacitatedFacilityLocation-{}-{}", parameters.n_customers, parameters.n_facilities));
+	auto model = make_problem(
+		fmt::format("CapacitatedFacilityLocation-{}-{}", parameters.n_customers, parameters.n_facilities),
+		parameters.named);
 	auto* const scip = model.get_scip_ptr();
+	auto name = NameFormatter{parameters.named};
 
-	auto const facility_vars = add_facility_vars(scip, fixed_costs);
-	auto const serving_vars = add_serving_vars(scip, transportation_costs, parameters.continuous_assignment);
+	auto const facility_vars = add_facility_vars(scip, fixed_costs, name);
+	auto const serving_vars = add_serving_vars(scip, costs, parameters.continuous_assignment, name);
 
-	add_demand_cons(scip, serving_vars);
-	add_capacity_cons(scip, serving_vars, facility_vars, demands, capacities);
-	add_tightening_cons(scip, serving_vars, facility_vars, demands, capacities);
+	add_demand_cons(scip, serving_vars, name);
+	add_capacity_cons(scip, serving_vars, facility_vars, demands, capacities, name);
+	add_tightening_cons(scip, serving_vars, facility_vars, demands, capacities, name);
 
 	return model;
 }
@@ -1,8 +1,10 @@
 #include <algorithm>
 #include <map>
+#include <random>
 #include <stdexcept>
 #include <tuple>
 #include <utility>
+#include <vector>
 
 #include <fmt/format.h>
 
@@ -19,6 +21,8 @@
 #include "ecole/scip/utils.hpp"
 #include "ecole/scip/var.hpp"
 
+#include "instance/names.hpp"
+
 namespace ecole::instance {
 
 /*******************************************
@@ -39,6 +43,14 @@ void CombinatorialAuctionGenerator::seed(Seed seed) {
 	rng.seed(seed);
 }
 
+auto CombinatorialAuctionGenerator::save_state() const -> std::string {
+	return serialize_binary(rng);
+}
+
+void CombinatorialAuctionGenerator::load_state(std::string_view state) {
+	rng = deserialize_binary(state);
+}
+
 namespace {
 
 template <typename T> using xvector = xt::xtensor<T, 1>;
@@ -86,18 +98,76 @@ auto arg_choice_without_replacement(std::size_t n_samples, xvector<double> weigh
 	return indices;
 }
 
-/** Choose the next item to be added to the bundle/sub-bundle. */
-auto choose_next_item(
-	xvector<std::size_t> const& bundle_mask,
-	xvector<double> const& interests,
-	xmatrix<double> const& compats,
-	RandomGenerator& rng) {
+/**
+ * Grow a bundle with items sampled according to the bidder interests and their compatibilities with the bundle.
+ *
+ * The mean compatibility of every item with the bundle is updated when an item is added, rather than recomputed from
+ * the full compatibility matrix for every item sampled.
+ * Buffers are reused when starting a new bundle.
+ */
+class BundleBuilder {
+public:
+	BundleBuilder(xmatrix<double> const& compats_, xvector<double> const& interests_) :
+		compats{compats_},
+		interests{interests_},
+		in_bundle(interests_.size(), false),
+		compat_sums(interests_.size(), 0.),
+		cumulative_weights(interests_.size(), 0.) {}
+
+	/** Start a new bundle with the given item. */
+	void reset(std::size_t item) {
+		std::fill(in_bundle.begin(), in_bundle.end(), false);
+		std::fill(compat_sums.begin(), compat_sums.end(), 0.);
+		n_bundle_items = 0;
+		add(item);
+	}
 
-	auto const compats_masked = compats * bundle_mask;
-	auto const compats_masked_mean = xt::mean(compats_masked, 1);
-	auto const probs = xt::eval((1 - bundle_mask) * interests * compats_masked_mean);
-	return arg_choice_without_replacement(1, probs, rng)(0);
-}
+	void add(std::size_t item) {
+		in_bundle[item] = true;
+		++n_bundle_items;
+		for (std::size_t i = 0; i < compat_sums.size(); ++i) {
+			compat_sums[i] += compats(i, item);
+		}
+	}
+
+	/** Choose the next item to be added to the bundle/sub-bundle. */
+	auto sample_next(RandomGenerator& rng) -> std::size_t {
+		auto const n_items = static_cast<double>(compat_sums.size());
+		auto total = 0.;
+		for (std::size_t i = 0; i < compat_sums.size(); ++i) {
+			if (!in_bundle[i]) {
+				total += interests[i] * (compat_sums[i] / n_items);
+			}
+			cumulative_weights[i] = total;
+		}
+		auto weight_dist = std::uniform_real_distribution<double>{0, total};
+		auto const u = weight_dist(rng);
+		auto const iter = std::upper_bound(cumulative_weights.cbegin(), cumulative_weights.cend(), u);
+		return static_cast<std::size_t>(iter - cumulative_weights.cbegin());
+	}
+
+	[[nodiscard]] auto size() const noexcept { return n_bundle_items; }
+
+	/** The items in the bundle, sorted. */
+	[[nodiscard]] auto bundle() const {
+		auto items = Bundle{};
+		items.reserve(n_bundle_items);
+		for (std::size_t i = 0; i < in_bundle.size(); ++i) {
+			if (in_bundle[i]) {
+				items.push_back(i);
+			}
+		}
+		return items;
+	}
+
+private:
+	xmatrix<double> const& compats;
+	xvector<double> const& interests;
+	std::vector<bool> in_bundle;
+	std::vector<double> compat_sums;
+	std::vector<double> cumulative_weights;
+	std::size_t n_bundle_items = 0;
+};
 
 /** Gets price of the bundle */
 auto get_bundle_price(const Bundle& bundle, const xvector<double>& private_values, bool integers, double additivity) {
@@ -115,7 +185,7 @@ auto get_bundle_price(const Bundle& bundle, const xvector<double>& private_value
 
 /** Generate initial bundle, choose first item according to bidder interests */
 auto get_bundle(
-	const xmatrix<double>& compats,
+	BundleBuilder& builder,
 	const xvector<double>& private_interests,
 	const xvector<double>& private_values,
 	std::size_t n_items,
@@ -124,10 +194,7 @@ auto get_bundle(
 	double add_item_prob,
 	RandomGenerator& rng) {
 
-	auto item = arg_choice_without_replacement(1, private_interests, rng)(0);
-
-	auto bundle_mask = xvector<std::size_t>({n_items}, 0);
-	bundle_mask[item] = 1;
+	builder.reset(arg_choice_without_replacement(1, private_interests, rng)(0));
 
 	// add additional items, according to bidder interests and item compatibilities
 	while (true) {
@@ -136,15 +203,14 @@ auto get_bundle(
 			break;
 		}
 
-		if (xt::sum(bundle_mask)() == n_items) {
+		if (builder.size() == n_items) {
 			break;
 		}
 
-		item = choose_next_item(bundle_mask, private_interests, compats, rng);
-		bundle_mask[item] = 1;
+		builder.add(builder.sample_next(rng));
 	}
 
-	Bundle bundle = xt::nonzero(bundle_mask)[0];
+	auto bundle = builder.bundle();
 
 	auto price = get_bundle_price(bundle, private_values, integers, additivity);
 
@@ -154,37 +220,31 @@ auto get_bundle(
 /** Generate the set of subsitue bundles */
 auto get_substitute_bundles(
 	const Bundle& bundle,
-	const xmatrix<double>& compats,
-	const xvector<double>& private_interests,
+	BundleBuilder& builder,
 	const xvector<double>& private_values,
-	std::size_t n_items,
 	bool integers,
 	double additivity,
 	RandomGenerator& rng) {
 
 	// get substitute bundles
 	std::vector<std::tuple<Bundle, Price>> sub_bundles{};
+	sub_bundles.reserve(bundle.size());
 
 	for (auto item : bundle) {
 
 		// at least one item must be shared with initial bundle
-		auto sub_bundle_mask = xvector<std::size_t>({n_items}, 0);
-		sub_bundle_mask[item] = 1;
+		builder.reset(item);
 
 		// add additional items, according to bidder interests and item compatibilities
-		while (true) {
-			if (xt::sum(sub_bundle_mask)() >= bundle.size()) {
-				break;
-			}
-			item = choose_next_item(sub_bundle_mask, private_interests, compats, rng);
-			sub_bundle_mask[item] = 1;
+		while (builder.size() < bundle.size()) {
+			builder.add(builder.sample_next(rng));
 		}
 
-		Bundle sub_bundle = xt::nonzero(sub_bundle_mask)[0];
+		auto sub_bundle = builder.bundle();
 
 		auto sub_price = get_bundle_price(sub_bundle, private_values, integers, additivity);
 
-		sub_bundles.emplace_back(sub_bundle, sub_price);
+		sub_bundles.emplace_back(std::move(sub_bundle), sub_price);
 	}
 
 	return sub_bundles;
@@ -221,7 +281,7 @@ auto add_bundles(
 	});
 
 	// add valid substitute bundles to bidder_bids
-	for (auto [sub_bundle, sub_price] : sub_bundles) {
+	for (auto const& [sub_bundle, sub_price] : sub_bundles) {
 
 		if (bidder_bids.size() >= max_n_sub_bids + 1 || bid_index + bidder_bids.size() >= n_bids) {
 			break;
@@ -310,8 +370,9 @@ auto get_bids(
 		// substitutable bids of this bidder
 		std::map<Bundle, Price> bidder_bids = {};
 
+		auto builder = BundleBuilder{compats, private_interests};
 		auto [bundle, price] =
-			get_bundle(compats, private_interests, private_values, n_items, integers, additivity, add_item_prob, rng);
+			get_bundle(builder, private_interests, private_values, n_items, integers, additivity, add_item_prob, rng);
 
 		// restart bid if price < 0
 		if (price < 0) {
@@ -324,7 +385,7 @@ auto get_bids(
 
 		// get substitute bundles
 		auto substitute_bundles =
-			get_substitute_bundles(bundle, compats, private_interests, private_values, n_items, integers, additivity, rng);
+			get_substitute_bundles(bundle, builder, private_values, integers, additivity, rng);
 
 		// add bundles to bidder_bids
 		add_bundles(
@@ -352,27 +413,30 @@ auto get_bids(
 }
 
 /** Adds a single variable with the coefficient price. */
-auto add_var(SCIP* scip, std::size_t i, Price price) {
-	auto const name = fmt::format("x_{}", i);
-	auto unique_var = scip::create_var_basic(scip, name.c_str(), 0., 1., price, SCIP_VARTYPE_BINARY);
+auto add_var(SCIP* scip, std::size_t i, Price price, NameFormatter& name) {
+	auto unique_var = scip::create_var_basic(scip, name("x_{}", i), 0., 1., price, SCIP_VARTYPE_BINARY);
 	auto* var_ptr = unique_var.get();
 	scip::call(SCIPaddVar, scip, var_ptr);
 	return var_ptr;
 }
 
 /** Add all variables associated with the bundles. */
-auto add_vars(SCIP* scip, std::vector<std::tuple<Bundle, Price>> const& bids) {
+auto add_vars(SCIP* scip, std::vector<std::tuple<Bundle, Price>> const& bids, NameFormatter& name) {
 	auto vars = xvector<SCIP_VAR*>{{bids.size()}};
 	std::size_t i = 0;
 	for (auto [_, price] : bids) {
-		vars[i] = add_var(scip, i, price);
+		vars[i] = add_var(scip, i, price, name);
 		++i;
 	}
 	return vars;
 }
 
 /** Adds all constraints to the SCIP model.  */
-auto add_constraints(SCIP* scip, xvector<SCIP_VAR*> vars, std::vector<Bundle> const& bids_per_item) {
+auto add_constraints(
+	SCIP* scip,
+	xvector<SCIP_VAR*> const& vars,
+	std::vector<Bundle> const& bids_per_item,
+	NameFormatter& name) {
 	std::size_t index = 0;
 	for (auto item_bids : bids_per_item) {
 		if (!item_bids.empty()) {
@@ -381,10 +445,9 @@ auto add_constraints(SCIP* scip, xvector<SCIP_VAR*> vars, std::vector<Bundle> co
 			for (std::size_t j = 0; j < item_bids.size(); ++j) {
 				cons_vars(j) = vars(item_bids[j]);
 			}
-			auto name = fmt::format("c_{}", index);
 			auto const inf = SCIPinfinity(scip);
-			auto cons =
-				scip::create_cons_basic_linear(scip, name.c_str(), cons_vars.size(), &cons_vars(0), coefs.data(), -inf, 1.0);
+			auto cons = scip::create_cons_basic_linear(
+				scip, name("c_{}", index), cons_vars.size(), &cons_vars(0), coefs.data(), -inf, 1.0);
 			scip::call(SCIPaddCons, scip, cons.get());
 		}
 		++index;
@@ -417,10 +480,15 @@ scip::Model CombinatorialAuctionGenerator::generate_instance(Parameters paramete
 	auto const values = xt::eval(parameters.min_value + (parameters.max_value - parameters.min_value) * rand_val);
 
 	// get compatibilities
-	auto const compats_rand = xt::eval(xt::random::rand({parameters.n_items, parameters.n_items}, 0.0, 1.0, rng));
-	auto compats = xt::eval(xt::triu(compats_rand, 1));
-	compats += xt::transpose(compats);
-	compats /= xt::sum(compats, 1);
+	// Symmetrize the upper triangle in place rather than with full size temporaries
+	auto compats = xt::eval(xt::random::rand({parameters.n_items, parameters.n_items}, 0.0, 1.0, rng));
+	for (std::size_t i = 0; i < parameters.n_items; ++i) {
+		for (std::size_t j = 0; j < i; ++j) {
+			compats(i, j) = compats(j, i);
+		}
+		compats(i, i) = 0.;
+	}
+	compats /= xt::eval(xt::sum(compats, 1));
 
 	// get all bids
 	auto [bids, n_dummy_items] = get_bids(
@@ -440,8 +508,8 @@ scip::Model CombinatorialAuctionGenerator::generate_instance(Parameters paramete
 		rng);
 
 	// create scip model
-	auto model = scip::Model::prob_basic();
-	model.set_name(fmt::format("CombinatorialAuction-{}-{}", parameters.n_items, parameters.n_bids));
+	auto model = make_problem(
+		fmt::format("CombinatorialAuction-{}-{}", parameters.n_items, parameters.n_bids), parameters.named);
 	auto* const scip = model.get_scip_ptr();
 	scip::call(SCIPsetObjsense, scip, SCIP_OBJSENSE_MAXIMIZE);
 
@@ -455,8 +523,9 @@ scip::Model CombinatorialAuctionGenerator::generate_instance(Parameters paramete
 		++i;
 	}
 
-	auto const vars = add_vars(scip, bids);
-	add_constraints(scip, vars, bids_per_item);
+	auto name = NameFormatter{parameters.named};
+	auto const vars = add_vars(scip, bids, name);
+	add_constraints(scip, vars, bids_per_item, name);
 
 	return model;
 }
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+#include <fmt/format.h>
+
+#include "ecole/instance/dataset.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/threads.hpp"
+
+namespace ecole::instance {
+
+auto write_dataset(
+	PrefetchingGenerator::Factory const& make_generator,
+	std::size_t n_instances,
+	Seed seed,
+	std::filesystem::path const& directory,
+	std::string const& extension,
+	std::size_t n_threads) -> std::vector<std::filesystem::path> {
+	if (n_threads == 0) {
+		n_threads = get_n_threads();
+	}
+	n_threads = std::min(n_threads, std::max(n_instances, std::size_t{1}));
+	std::filesystem::create_directories(directory);
+
+	auto paths = std::vector<std::filesystem::path>(n_instances);
+	for (std::size_t i = 0; i < n_instances; ++i) {
+		paths[i] = directory / fmt::format("instance-{}.{}", i, extension);
+	}
+
+	// The seeds of all instances derive from the same root, whatever thread generates them
+	auto const root_rng = RandomGenerator{seed};
+	auto next_instance = std::atomic<std::size_t>{0};
+	auto error = std::exception_ptr{};
+	auto error_mutex = std::mutex{};
+
+	auto work = [&] {
+		try {
+			auto generator = make_generator();
+			for (auto i = next_instance++; i < n_instances; i = next_instance++) {
+				auto instance_rng = derive_random_generator(root_rng, i);
+				generator->seed(instance_rng());
+				if (generator->done()) {
+					throw std::invalid_argument{"The generator is exhausted before all instances are written."};
+				}
+				generator->next().write_problem(paths[i]);
+			}
+		} catch (...) {
+			// Stop the other threads on their next instance
+			next_instance = n_instances;
+			auto const lock = std::lock_guard{error_mutex};
+			if (!error) {
+				error = std::current_exception();
+			}
+		}
+	};
+
+	auto threads = std::vector<std::thread>{};
+	threads.reserve(n_threads);
+	for (std::size_t t = 0; t < n_threads; ++t) {
+		threads.emplace_back(work);
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+	return paths;
+}
+
+}  // namespace ecole::instance
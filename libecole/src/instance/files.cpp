@@ -1,9 +1,25 @@
 #include <algorithm>
+#include <cstdint>
+#include <functional>
 #include <iterator>
 #include <random>
+#include <stdexcept>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+#include <unistd.h>
+
+#include <fmt/format.h>
 
 #include "ecole/exception.hpp"
+#include "ecole/instance/cache.hpp"
 #include "ecole/instance/files.hpp"
+#include "ecole/scip/exception.hpp"
+#include "ecole/utility/thread-pool.hpp"
+#include "utility/hash.hpp"
+#include "utility/state.hpp"
 
 namespace ecole::instance {
 
@@ -11,30 +27,75 @@ namespace fs = std::filesystem;
 
 namespace {
 
-/** List files and symlinks to files in the given directory iterator. */
-template <typename FileIter> auto list_files(FileIter&& dir_iter) {
-	auto files = std::vector<fs::path>{};
-	for (auto iter = begin(dir_iter), last = end(dir_iter); iter != last; ++iter) {
-		auto file = iter->path();
-		if (fs::is_regular_file(file) || (fs::is_symlink(file) && fs::exists(fs::read_symlink(file)))) {
-			files.push_back(std::move(file));
-		}
+/** The snapshot of a file, named after its path and modification time, so that edited files get a new snapshot. */
+auto snapshot_path(fs::path const& snapshots, fs::path const& path) -> fs::path {
+	auto hasher = utility::Hasher{};
+	auto const name = fs::absolute(path).lexically_normal().string();
+	hasher.add(std::string_view{name});
+	hasher.add(static_cast<std::uint64_t>(fs::last_write_time(path).time_since_epoch().count()));
+	hasher.add(static_cast<std::uint64_t>(fs::file_size(path)));
+	return snapshots / fmt::format("{:016x}.bin", hasher.digest());
+}
+
+auto by_path(ManifestEntry const& a, ManifestEntry const& b) -> bool {
+	return a.path < b.path;
+}
+
+/** Sort files by cost, from the most precise information known for all of them, keeping the order of ties. */
+void sort_by_cost(std::vector<ManifestEntry>& files) {
+	auto const known_for_all = [&files](auto member) {
+		return std::all_of(begin(files), end(files), [member](auto const& entry) { return (entry.*member).has_value(); });
+	};
+	auto const sort_by = [&files](auto cost) {
+		std::stable_sort(begin(files), end(files), [&cost](auto const& a, auto const& b) { return cost(a) < cost(b); });
+	};
+	if (known_for_all(&ManifestEntry::cost)) {
+		sort_by([](auto const& entry) { return entry.cost.value(); });
+	} else if (known_for_all(&ManifestEntry::n_nonzeros)) {
+		sort_by([](auto const& entry) { return entry.n_nonzeros.value(); });
+	} else {
+		sort_by([](auto const& entry) { return entry.size; });
+	}
+}
+
+/** Keep every world_size-th file starting from rank, in path order. */
+void keep_shard(std::vector<ManifestEntry>& files, std::size_t rank, std::size_t world_size) {
+	std::sort(begin(files), end(files), by_path);
+	auto shard = std::vector<ManifestEntry>{};
+	shard.reserve(files.size() / world_size + 1);
+	for (auto i = rank; i < files.size(); i += world_size) {
+		shard.push_back(std::move(files[i]));
 	}
-	return files;
+	files = std::move(shard);
 }
 
 }  // namespace
 
 FileGenerator::FileGenerator(Parameters parameters_, RandomGenerator rng_) :
 	rng{rng_}, parameters{std::move(parameters_)} {
-	using opts = fs::directory_options;
-	if (parameters.recursive) {
-		files = list_files(fs::recursive_directory_iterator{parameters.directory, opts::follow_directory_symlink});
+	if (parameters.world_size == 0) {
+		throw std::invalid_argument{"The world size must be positive."};
+	}
+	if (parameters.rank >= parameters.world_size) {
+		throw std::invalid_argument{
+			fmt::format("The rank {} must be smaller than the world size {}.", parameters.rank, parameters.world_size)};
+	}
+	if (parameters.manifest.empty()) {
+		files = scan_manifest(parameters.directory, parameters.recursive);
 	} else {
-		files = list_files(fs::directory_iterator{parameters.directory, opts::follow_directory_symlink});
+		files = read_manifest(parameters.manifest);
+	}
+	if (parameters.world_size > 1) {
+		keep_shard(files, parameters.rank, parameters.world_size);
 	}
-	// The order in which the files are iterated over is unspecified.
 	reset_file_list();
+	if (parameters.n_prefetch > 0) {
+		thread_pool = std::make_unique<utility::ThreadPool>(
+			std::min(parameters.n_prefetch, utility::ThreadPool::default_n_threads()));
+	}
+	if (parameters.cache_max_nonzeros > 0) {
+		cache = std::make_shared<InstanceCache>(parameters.cache_max_nonzeros);
+	}
 }
 
 FileGenerator::FileGenerator(Parameters parameters_) :
@@ -42,10 +103,178 @@ FileGenerator::FileGenerator(Parameters parameters_) :
 
 FileGenerator::FileGenerator() : FileGenerator{Parameters{}} {}
 
+FileGenerator::FileGenerator(FileGenerator const& other) :
+	rng{other.rng},
+	parameters{other.parameters},
+	files{other.files},
+	files_remaining{other.files_remaining},
+	bucket_ends{other.bucket_ends},
+	bucket_remaining{other.bucket_remaining},
+	current_bucket{other.current_bucket},
+	batch_position{other.batch_position},
+	cache{other.cache} {
+	if (other.thread_pool) {
+		thread_pool = std::make_unique<utility::ThreadPool>(other.thread_pool->size());
+	}
+	for (auto const& item : other.prefetched) {
+		load_ahead({item.path, item.size});
+	}
+}
+
+FileGenerator::FileGenerator(FileGenerator&& other) noexcept = default;
+
+auto FileGenerator::operator=(FileGenerator const& other) -> FileGenerator& {
+	if (this != &other) {
+		*this = FileGenerator{other};
+	}
+	return *this;
+}
+
+auto FileGenerator::operator=(FileGenerator&& other) noexcept -> FileGenerator& = default;
+
+// Defined where ThreadPool is complete
+FileGenerator::~FileGenerator() = default;
+
 auto FileGenerator::next() -> scip::Model {
-	if (done()) {
+	if (!thread_pool) {
+		if (done()) {
+			throw IteratorExhausted{};
+		}
+		return load(cache.get(), parameters.snapshot_directory, sample_file().path);
+	}
+
+	prefetch();
+	if (prefetched.empty()) {
 		throw IteratorExhausted{};
 	}
+	auto model = std::move(prefetched.front().model);
+	prefetched_size -= prefetched.front().size;
+	prefetched.pop_front();
+	// Start loading a replacement while this model is being used
+	prefetch();
+	return model.get();
+}
+
+void FileGenerator::seed(Seed seed) {
+	// Models being loaded are discarded when their loading finishes
+	prefetched.clear();
+	prefetched_size = 0;
+	reset_file_list();
+	rng.seed(seed);
+}
+
+auto FileGenerator::save_state() const -> std::string {
+	// Files are identified by their rank in sorted order, which does not depend on the directory iteration
+	auto sorted = files;
+	std::sort(begin(sorted), end(sorted), by_path);
+	auto const rank = [&sorted](fs::path const& path) {
+		auto const iter = std::lower_bound(
+			begin(sorted), end(sorted), path, [](auto const& entry, auto const& p) { return entry.path < p; });
+		return static_cast<std::uint64_t>(iter - begin(sorted));
+	};
+
+	auto writer = utility::StateWriter{};
+	writer.write(serialize_binary(rng));
+	writer.write(files.size());
+	writer.write(files_remaining);
+	for (auto const& file : files) {
+		writer.write(rank(file.path));
+	}
+	writer.write(prefetched.size());
+	for (auto const& item : prefetched) {
+		writer.write(rank(item.path));
+	}
+	if (bucketed()) {
+		for (auto const remaining : bucket_remaining) {
+			writer.write(remaining);
+		}
+		writer.write(current_bucket);
+		writer.write(batch_position);
+	}
+	return std::move(writer).str();
+}
+
+void FileGenerator::load_state(std::string_view state) {
+	auto reader = utility::StateReader{state};
+	auto new_rng = deserialize_binary(reader.read_bytes());
+	if (reader.read_integer() != files.size()) {
+		throw std::invalid_argument{"FileGenerator state was saved with a different number of files."};
+	}
+	auto sorted = files;
+	std::sort(begin(sorted), end(sorted), by_path);
+	auto const file_at = [&reader, &sorted] {
+		auto const index = reader.read_integer();
+		if (index >= sorted.size()) {
+			throw std::invalid_argument{"FileGenerator state refers to a file that does not exist."};
+		}
+		return sorted[static_cast<std::size_t>(index)];
+	};
+
+	auto const new_files_remaining = static_cast<std::size_t>(reader.read_integer());
+	auto new_files = std::vector<ManifestEntry>{};
+	new_files.reserve(files.size());
+	for (std::size_t i = 0; i < files.size(); ++i) {
+		new_files.push_back(file_at());
+	}
+	auto const n_prefetched = static_cast<std::size_t>(reader.read_integer());
+	auto new_prefetched = std::vector<ManifestEntry>{};
+	for (std::size_t i = 0; i < n_prefetched; ++i) {
+		new_prefetched.push_back(file_at());
+	}
+	auto new_bucket_remaining = std::vector<std::size_t>{};
+	auto new_current_bucket = std::size_t{0};
+	auto new_batch_position = std::size_t{0};
+	if (bucketed()) {
+		for (std::size_t b = 0; b < bucket_ends.size(); ++b) {
+			new_bucket_remaining.push_back(static_cast<std::size_t>(reader.read_integer()));
+			if (new_bucket_remaining.back() > bucket_ends[b] - bucket_begin(b)) {
+				throw std::invalid_argument{"FileGenerator state has more files remaining than files in a bucket."};
+			}
+		}
+		new_current_bucket = static_cast<std::size_t>(reader.read_integer());
+		new_batch_position = static_cast<std::size_t>(reader.read_integer());
+		if (new_current_bucket >= bucket_ends.size()) {
+			throw std::invalid_argument{"FileGenerator state refers to a bucket that does not exist."};
+		}
+	}
+	reader.finish();
+	if (new_files_remaining > files.size()) {
+		throw std::invalid_argument{"FileGenerator state has more files remaining than files."};
+	}
+	if (!new_prefetched.empty() && !thread_pool) {
+		throw std::invalid_argument{"FileGenerator state has prefetched files but the generator does not prefetch."};
+	}
+
+	// Models being loaded are discarded when their loading finishes
+	prefetched.clear();
+	prefetched_size = 0;
+	rng = new_rng;
+	files = std::move(new_files);
+	files_remaining = new_files_remaining;
+	if (bucketed()) {
+		bucket_remaining = std::move(new_bucket_remaining);
+		current_bucket = new_current_bucket;
+		batch_position = new_batch_position;
+	}
+	for (auto const& entry : new_prefetched) {
+		load_ahead(entry);
+	}
+}
+
+auto FileGenerator::done() const -> bool {
+	return prefetched.empty() && sampling_done();
+}
+
+auto FileGenerator::sampling_done() const -> bool {
+	auto const no_files_at_all = files.empty();
+	auto const seen_all_files = (files_remaining == 0 && parameters.sampling_mode == Parameters::SamplingMode::remove);
+	return no_files_at_all || seen_all_files;
+}
+
+auto FileGenerator::sample_file() -> ManifestEntry const& {
+	if (bucketed()) {
+		return sample_bucketed_file();
+	}
 	if (files_remaining == 0) {
 		files_remaining = files.size();
 	}
@@ -55,30 +284,116 @@ auto FileGenerator::next() -> scip::Model {
 
 	// files_remaining is not used in this case, it is only an alias for files.size().
 	if (parameters.sampling_mode == Parameters::SamplingMode::replace) {
-		return scip::Model::from_file(files[idx]);
+		return files[idx];
 	}
 
 	// files[0: files_reamining] are unseen files, while files[files_reamining: -1] are seen.
 	// We mark files[idx] as seen by exchanging it with files[files_remaining]
 	files_remaining--;
-	swap(files[idx], files[files_remaining]);
-	return scip::Model::from_file(files[files_remaining]);
+	std::swap(files[idx], files[files_remaining]);
+	return files[files_remaining];
 }
 
-void FileGenerator::seed(Seed seed) {
-	reset_file_list();
-	rng.seed(seed);
+auto FileGenerator::sample_bucketed_file() -> ManifestEntry const& {
+	if (files_remaining == 0) {
+		files_remaining = files.size();
+		for (std::size_t b = 0; b < bucket_ends.size(); ++b) {
+			bucket_remaining[b] = bucket_ends[b] - bucket_begin(b);
+		}
+	}
+
+	// Sampling the bucket of a file among all the files left gives every file the same probability
+	if (batch_position == 0 || bucket_remaining[current_bucket] == 0) {
+		auto const idx = std::uniform_int_distribution<std::size_t>{0, files_remaining - 1}(rng);
+		current_bucket = 0;
+		for (auto seen = bucket_remaining[0]; seen <= idx; seen += bucket_remaining[current_bucket]) {
+			++current_bucket;
+		}
+	}
+	batch_position = (batch_position + 1) % std::max(parameters.bucket_batch_size, std::size_t{1});
+
+	// Same as sample_file, within the files of the bucket
+	auto const first = bucket_begin(current_bucket);
+	auto choice = std::uniform_int_distribution<std::size_t>{0, bucket_remaining[current_bucket] - 1};
+	auto const idx = first + choice(rng);
+	if (parameters.sampling_mode == Parameters::SamplingMode::replace) {
+		return files[idx];
+	}
+	files_remaining--;
+	auto const last = first + --bucket_remaining[current_bucket];
+	std::swap(files[idx], files[last]);
+	return files[last];
 }
 
-auto FileGenerator::done() const -> bool {
-	auto const no_files_at_all = files.empty();
-	auto const seen_all_files = (files_remaining == 0 && parameters.sampling_mode == Parameters::SamplingMode::remove);
-	return no_files_at_all || seen_all_files;
+void FileGenerator::prefetch() {
+	// The size limit is checked before sampling, so the last file prefetched can exceed it
+	while (prefetched.size() < parameters.n_prefetch &&
+				 (prefetched.empty() || prefetched_size < parameters.prefetch_size_limit) && !sampling_done()) {
+		load_ahead(sample_file());
+	}
+}
+
+void FileGenerator::load_ahead(ManifestEntry const& entry) {
+	auto model =
+		thread_pool->submit([path = entry.path, cache = cache, snapshots = fs::path{parameters.snapshot_directory}] {
+			return load(cache.get(), snapshots, path);
+		});
+	prefetched.push_back({entry.path, entry.size, std::move(model)});
+	prefetched_size += entry.size;
+}
+
+auto FileGenerator::load(InstanceCache* cache, fs::path const& snapshots, fs::path const& path) -> scip::Model {
+	if (cache != nullptr) {
+		return cache->get(path.string());
+	}
+	if (snapshots.empty()) {
+		return scip::Model::from_file(path);
+	}
+
+	auto const snapshot = snapshot_path(snapshots, path);
+	if (fs::exists(snapshot)) {
+		return scip::Model::load_binary(snapshot);
+	}
+	auto model = scip::Model::from_file(path);
+	// Other problems would not be read back the same, so they have no snapshot and are parsed every time
+	if (!model.is_binary_exact()) {
+		return model;
+	}
+	// Written under a unique name then renamed, so that other processes never read a partial snapshot
+	auto const tmp = fs::path{snapshot}.concat(
+		fmt::format(".{}.{}.tmp", ::getpid(), std::hash<std::thread::id>{}(std::this_thread::get_id())));
+	fs::create_directories(snapshots);
+	try {
+		model.save_binary(tmp);
+		fs::rename(tmp, snapshot);
+	} catch (scip::ScipError const&) {
+		// Snapshots that cannot be written are skipped, the file being parsed next time
+		auto error = std::error_code{};
+		fs::remove(tmp, error);
+	}
+	return model;
 }
 
 void FileGenerator::reset_file_list() {
-	std::sort(begin(files), end(files));
+	std::sort(begin(files), end(files), by_path);
 	files_remaining = files.size();
+
+	auto const n_buckets = std::min(parameters.n_buckets, files.size());
+	bucket_ends.clear();
+	bucket_remaining.clear();
+	current_bucket = 0;
+	batch_position = 0;
+	if (n_buckets > 1) {
+		sort_by_cost(files);
+		for (std::size_t b = 0; b < n_buckets; ++b) {
+			bucket_ends.push_back((b + 1) * files.size() / n_buckets);
+			bucket_remaining.push_back(bucket_ends[b] - bucket_begin(b));
+		}
+	}
+}
+
+auto FileGenerator::bucket_begin(std::size_t bucket) const noexcept -> std::size_t {
+	return bucket == 0 ? 0 : bucket_ends[bucket - 1];
 }
 
 }  // namespace ecole::instance
@@ -0,0 +1,170 @@
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include <fmt/format.h>
+#include <scip/scip.h>
+
+#include "ecole/exception.hpp"
+#include "ecole/instance/filtered.hpp"
+
+namespace ecole::instance {
+
+namespace {
+
+/** Wrap a generator to only return the instances whose probe falls in the range. */
+class ProbingGenerator : public InstanceGenerator {
+public:
+	ProbingGenerator(
+		std::unique_ptr<InstanceGenerator> generator_,
+		ProbeRange const& range_,
+		std::size_t max_rejections_,
+		std::shared_ptr<FilteredGenerator::Counters> counters_) :
+		generator{std::move(generator_)},
+		range{range_},
+		max_rejections{max_rejections_},
+		counters{std::move(counters_)} {}
+
+	auto next() -> scip::Model override {
+		if (!find_kept()) {
+			throw IteratorExhausted{};
+		}
+		return std::exchange(kept, {}).value();
+	}
+
+	void seed(Seed seed) override {
+		kept.reset();
+		generator->seed(seed);
+	}
+
+	/** Whether no other instance is kept, probing instances until one is. */
+	[[nodiscard]] auto done() const -> bool override { return !find_kept(); }
+
+	/** The state before the kept instance is generated, as the prefetching threads save it before calling done. */
+	[[nodiscard]] auto save_state() const -> std::string override { return generator->save_state(); }
+
+	void load_state(std::string_view state) override {
+		kept.reset();
+		generator->load_state(state);
+	}
+
+private:
+	std::unique_ptr<InstanceGenerator> generator;
+	ProbeRange range;
+	std::size_t max_rejections;
+	std::shared_ptr<FilteredGenerator::Counters> counters;
+	/** The next instance kept, probed ahead so that finite generators know whether they are done. */
+	mutable std::optional<scip::Model> kept;
+
+	auto find_kept() const -> bool {
+		for (std::size_t n_rejected = 0; !kept.has_value(); ++n_rejected) {
+			if (generator->done()) {
+				return false;
+			}
+			if (n_rejected == max_rejections) {
+				throw std::runtime_error{fmt::format(
+					"FilteredGenerator rejected {} consecutive instances, out of its range.", max_rejections)};
+			}
+			auto model = generator->next();
+			auto const stats = ProbeStatistics::probe(model, range.time_limit);
+			++counters->n_probed;
+			if (range.contains(stats)) {
+				kept = std::move(model);
+			} else {
+				++counters->n_rejected;
+			}
+		}
+		return true;
+	}
+};
+
+/** The factory of the prefetcher, wrapping every generator to probe its instances. */
+auto probing_factory(
+	FilteredGenerator::Factory const& make_generator,
+	ProbeRange const& range,
+	std::size_t max_rejections,
+	std::shared_ptr<FilteredGenerator::Counters> const& counters) -> FilteredGenerator::Factory {
+	if (max_rejections == 0) {
+		throw std::invalid_argument{"The maximum number of rejections must be positive."};
+	}
+	return [make_generator, range, max_rejections, counters]() -> std::unique_ptr<InstanceGenerator> {
+		return std::make_unique<ProbingGenerator>(make_generator(), range, max_rejections, counters);
+	};
+}
+
+}  // namespace
+
+auto ProbeStatistics::probe(scip::Model const& model, double time_limit) -> ProbeStatistics {
+	auto probed = model.copy_orig();
+	probed.set_param("limits/nodes", 1);
+	if (time_limit < std::numeric_limits<double>::infinity()) {
+		probed.set_param("limits/time", time_limit);
+	}
+	probed.solve();
+
+	auto* const scip = probed.get_scip_ptr();
+	auto const status = SCIPgetStatus(scip);
+	auto const gap = SCIPgetGap(scip);
+	auto stats = ProbeStatistics{};
+	stats.solved = status == SCIP_STATUS_OPTIMAL || status == SCIP_STATUS_INFEASIBLE;
+	stats.gap = SCIPisInfinity(scip, gap) ? std::numeric_limits<double>::infinity() : gap;
+	stats.n_lp_iterations = static_cast<std::size_t>(SCIPgetNLPIterations(scip));
+	stats.n_vars = static_cast<std::size_t>(SCIPgetNVars(scip));
+	stats.n_cons = static_cast<std::size_t>(SCIPgetNConss(scip));
+	stats.solving_time = SCIPgetSolvingTime(scip);
+	return stats;
+}
+
+auto ProbeRange::contains(ProbeStatistics const& stats) const noexcept -> bool {
+	if (stats.solved) {
+		return keep_solved;
+	}
+	return min_gap <= stats.gap && stats.gap <= max_gap && min_lp_iterations <= stats.n_lp_iterations &&
+		   stats.n_lp_iterations <= max_lp_iterations;
+}
+
+FilteredGenerator::FilteredGenerator(
+	Factory const& make_generator,
+	ProbeRange range_,
+	std::size_t n_threads,
+	std::size_t queue_size,
+	std::size_t max_rejections,
+	RandomGenerator rng) :
+	m_range{range_},
+	counters{std::make_shared<Counters>()},
+	prefetcher{probing_factory(make_generator, m_range, max_rejections, counters), n_threads, queue_size, rng} {}
+
+FilteredGenerator::FilteredGenerator(
+	Factory const& make_generator,
+	ProbeRange range_,
+	std::size_t n_threads,
+	std::size_t queue_size,
+	std::size_t max_rejections) :
+	FilteredGenerator{make_generator, range_, n_threads, queue_size, max_rejections, ecole::spawn_random_generator()} {}
+
+auto FilteredGenerator::next() -> scip::Model {
+	return prefetcher.next();
+}
+
+void FilteredGenerator::seed(Seed seed) {
+	prefetcher.seed(seed);
+}
+
+auto FilteredGenerator::done() const -> bool {
+	return prefetcher.done();
+}
+
+auto FilteredGenerator::save_state() const -> std::string {
+	return prefetcher.save_state();
+}
+
+void FilteredGenerator::load_state(std::string_view state) {
+	prefetcher.load_state(state);
+}
+
+}  // namespace ecole::instance
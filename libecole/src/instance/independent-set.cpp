@@ -14,6 +14,7 @@
 #include "ecole/scip/var.hpp"
 #include "ecole/utility/unreachable.hpp"
 
+#include "instance/names.hpp"
 #include "utility/graph.hpp"
 
 namespace views = ranges::views;
@@ -40,6 +41,14 @@ void IndependentSetGenerator::seed(Seed seed) {
 	rng.seed(seed);
 }
 
+auto IndependentSetGenerator::save_state() const -> std::string {
+	return serialize_binary(rng);
+}
+
+void IndependentSetGenerator::load_state(std::string_view state) {
+	rng = deserialize_binary(state);
+}
+
 /************************************************
  *  IndependentSetGenerator::generate_instance  *
  ************************************************/
@@ -50,9 +59,9 @@ namespace {
 auto make_graph(IndependentSetGenerator::Parameters parameters, RandomGenerator& rng) -> Graph {
 	switch (parameters.graph_type) {
 	case IndependentSetGenerator::Parameters::GraphType::erdos_renyi:
-		return Graph::erdos_renyi(parameters.n_nodes, parameters.edge_probability, rng);
+		return Graph::erdos_renyi(parameters.n_nodes, parameters.edge_probability, rng, parameters.geometric_skip);
 	case IndependentSetGenerator::Parameters::GraphType::barabasi_albert:
-		return Graph::barabasi_albert(parameters.n_nodes, parameters.affinity, rng);
+		return Graph::barabasi_albert(parameters.n_nodes, parameters.affinity, rng, parameters.repeated_nodes);
 	default:
 		utility::unreachable();
 	}
@@ -64,55 +73,20 @@ auto make_graph(IndependentSetGenerator::Parameters parameters, RandomGenerator&
  * the scip*.
  * Their lifetime should not exceed that of the scip* (although that was already implied when creating them).
  */
-auto add_node_var(SCIP* scip, Graph::Node n) -> SCIP_VAR* {
-	auto const name = fmt::format("n_{}", n);
-	auto unique_var = scip::create_var_basic(scip, name.c_str(), 0., 1., 1.0, SCIP_VARTYPE_BINARY);
+auto add_node_var(SCIP* scip, Graph::Node n, NameFormatter& name) -> SCIP_VAR* {
+	auto unique_var = scip::create_var_basic(scip, name("n_{}", n), 0., 1., 1.0, SCIP_VARTYPE_BINARY);
 	auto* var_ptr = unique_var.get();
 	scip::call(SCIPaddVar, scip, var_ptr);
 	return var_ptr;
 }
 
 /** Create and add all variables for the nodes. */
-auto add_node_vars(SCIP* scip, std::size_t n_nodes) -> std::vector<SCIP_VAR*> {
+auto add_node_vars(SCIP* scip, std::size_t n_nodes, NameFormatter& name) -> std::vector<SCIP_VAR*> {
 	using Node = Graph::Node;
-	return views::ints(Node{0}, Node{n_nodes}) | views::transform([scip](auto n) { return add_node_var(scip, n); }) |
-				 ranges::to<std::vector>();
+	return views::ints(Node{0}, Node{n_nodes}) |
+				 views::transform([scip, &name](auto n) { return add_node_var(scip, n, name); }) | ranges::to<std::vector>();
 }
 
-/** A class to reuse ressources between calls to `add_cons`. */
-class ConstraintCreator {
-public:
-	using Node = Graph::Node;
-
-	/** Allocate a buffer of variables used in create_cons_basic_linear. */
-	ConstraintCreator(std::size_t buffer_size) : ones(buffer_size, 1.) { var_buffer.reserve(buffer_size); }
-
-	/** Add constraint that at most one of the given variable can be in the independent set. */
-	template <typename ConsContainer> void add_cons(SCIP* scip, ConsContainer const& vars) {
-		auto const inf = SCIPinfinity(scip);
-		auto const name = fmt::format("c_{}", idx++);
-		auto cons = scip::create_cons_basic_linear(scip, name.c_str(), vars.size(), vars.data(), ones.data(), -inf, 1.0);
-		scip::call(SCIPaddCons, scip, cons.get());
-	}
-
-	/** Variation of the where the internal buffer is used to store a temporary contiguous array of variables.
-	 *
-	 * This buffer is needed by the call to SCIPcreateConsBasicLinear.
-	 */
-	void add_cons(SCIP* scip, std::vector<SCIP_VAR*> const& node_vars, std::vector<Node> const& clique) {
-		var_buffer.clear();
-		for (auto node : clique) {
-			var_buffer.push_back(node_vars[node]);
-		}
-		add_cons(scip, var_buffer);
-	}
-
-private:
-	std::vector<SCIP_VAR*> var_buffer;
-	std::vector<SCIP_Real> ones;
-	std::size_t idx = 0;
-};
-
 /** A class to lookup fast if two nodes are in the same clique. */
 class CliqueIndex {
 public:
@@ -140,18 +114,20 @@ private:
 
 scip::Model IndependentSetGenerator::generate_instance(Parameters parameters, RandomGenerator& rng) {
 	auto const graph = make_graph(parameters, rng);
-	auto model = scip::Model::prob_basic();
-	model.set_name(fmt::format("IndependentSet-{}", parameters.n_nodes));
+	auto model = make_problem(fmt::format("IndependentSet-{}", parameters.n_nodes), parameters.named);
 	auto* const scip = model.get_scip_ptr();
 	scip::call(SCIPsetObjsense, scip, SCIP_OBJSENSE_MAXIMIZE);
 
-	auto vars = add_node_vars(scip, graph.n_nodes());
-	auto cons_creator = ConstraintCreator{graph.n_nodes()};
+	auto var_name = NameFormatter{parameters.named};
+	auto vars = add_node_vars(scip, graph.n_nodes(), var_name);
 	auto const clique_partition = graph.greedy_clique_partition();
+	// At most one node of every constraint can be in the independent set
+	auto constraints = scip::LinearConstraintBatch{};
+	auto const inf = SCIPinfinity(scip);
 
 	// Constraints for edges in clique are strenghen
 	for (auto const& clique : clique_partition) {
-		cons_creator.add_cons(scip, vars, clique);
+		constraints.add(clique, 1., -inf, 1.);
 	}
 
 	// Constraints for other edges not in cliques
@@ -159,17 +135,19 @@ scip::Model IndependentSetGenerator::generate_instance(Parameters parameters, Ra
 	graph.edges_visit([&](auto edge) {
 		auto [n1, n2] = edge;
 		if (!clique_index.are_in_same_clique(n1, n2)) {
-			cons_creator.add_cons(scip, std::array{vars[n1], vars[n2]});
+			constraints.add(std::array{n1, n2}, 1., -inf, 1.);
 		}
 	});
 
 	// Constraints for unconnected nodes otherwise SCIP complains
 	for (auto node = Graph::Node{0}; node < graph.n_nodes(); ++node) {
 		if (graph.degree(node) == 0) {
-			cons_creator.add_cons(scip, std::array{vars[node]});
+			constraints.add(std::array{node}, 1., -inf, 1.);
 		}
 	}
 
+	constraints.add_to(scip, vars, parameters.named ? "c_" : nullptr);
+
 	return model;
 }
 
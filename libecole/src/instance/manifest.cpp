@@ -0,0 +1,192 @@
+#include <algorithm>
+#include <cctype>
+#include <exception>
+#include <fstream>
+#include <future>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "ecole/instance/manifest.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/threads.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::instance {
+
+namespace fs = std::filesystem;
+
+namespace {
+
+/** List files and symlinks to files in the given directory iterator. */
+template <typename FileIter> auto list_files(FileIter&& dir_iter) {
+	auto entries = std::vector<ManifestEntry>{};
+	for (auto iter = begin(dir_iter), last = end(dir_iter); iter != last; ++iter) {
+		auto file = iter->path();
+		if (fs::is_regular_file(file) || (fs::is_symlink(file) && fs::exists(fs::read_symlink(file)))) {
+			auto const size = fs::file_size(file);
+			entries.push_back({std::move(file), size});
+		}
+	}
+	return entries;
+}
+
+/** Set the number of non zeros and fingerprint of every entry on a pool of threads. */
+void read_statistics(std::vector<ManifestEntry>& entries, std::size_t n_threads) {
+	auto const read_entry = [](ManifestEntry& entry) {
+		auto const model = scip::Model::from_file(entry.path);
+		entry.n_nonzeros = model.nnz();
+		entry.fingerprint = model.fingerprint();
+	};
+	// Problems are read sequentially with a single thread, or when already running in a pool
+	auto const pool = (n_threads > 0 || !utility::ThreadPool::in_worker_thread()) ? make_thread_pool(n_threads) : nullptr;
+	if (pool == nullptr) {
+		std::for_each(entries.begin(), entries.end(), read_entry);
+		return;
+	}
+	auto futures = std::vector<std::future<void>>{};
+	futures.reserve(entries.size());
+	for (auto& entry : entries) {
+		futures.push_back(pool->submit([&read_entry, &entry] { read_entry(entry); }));
+	}
+	// All problems are awaited before rethrowing since they reference the entries
+	auto error = std::exception_ptr{};
+	for (auto& future : futures) {
+		try {
+			future.get();
+		} catch (...) {
+			if (!error) {
+				error = std::current_exception();
+			}
+		}
+	}
+	if (error) {
+		std::rethrow_exception(error);
+	}
+}
+
+template <typename Integer> auto parse_integer(std::string const& field, int base, std::size_t line) -> Integer {
+	// Signs and spaces are accepted by stoull but not written in manifests
+	if (!field.empty() && (std::isxdigit(static_cast<unsigned char>(field.front())) != 0)) {
+		try {
+			auto n_parsed = std::size_t{0};
+			auto const value = std::stoull(field, &n_parsed, base);
+			if (n_parsed == field.size()) {
+				return static_cast<Integer>(value);
+			}
+		} catch (std::exception const&) {
+		}
+	}
+	throw std::invalid_argument{fmt::format("Manifest line {} has an invalid number '{}'.", line, field)};
+}
+
+template <typename Integer>
+auto parse_optional(std::string const& field, int base, std::size_t line) -> std::optional<Integer> {
+	if (field.empty()) {
+		return {};
+	}
+	return parse_integer<Integer>(field, base, line);
+}
+
+auto parse_cost(std::string const& field, std::size_t line) -> std::optional<double> {
+	if (field.empty()) {
+		return {};
+	}
+	try {
+		auto n_parsed = std::size_t{0};
+		auto const value = std::stod(field, &n_parsed);
+		if (n_parsed == field.size() && value >= 0) {
+			return value;
+		}
+	} catch (std::exception const&) {
+	}
+	throw std::invalid_argument{fmt::format("Manifest line {} has an invalid cost '{}'.", line, field)};
+}
+
+}  // namespace
+
+auto scan_manifest(fs::path const& directory, bool recursive, bool read_problems, std::size_t n_threads)
+	-> std::vector<ManifestEntry> {
+	using opts = fs::directory_options;
+	auto entries = std::vector<ManifestEntry>{};
+	if (recursive) {
+		entries = list_files(fs::recursive_directory_iterator{directory, opts::follow_directory_symlink});
+	} else {
+		entries = list_files(fs::directory_iterator{directory, opts::follow_directory_symlink});
+	}
+	std::sort(begin(entries), end(entries), [](auto const& a, auto const& b) { return a.path < b.path; });
+	if (read_problems) {
+		read_statistics(entries, n_threads);
+	}
+	return entries;
+}
+
+void write_manifest(fs::path const& manifest, std::vector<ManifestEntry> const& entries) {
+	auto const base = fs::absolute(manifest).parent_path();
+	auto file = std::ofstream{manifest};
+	if (!file) {
+		throw std::invalid_argument{fmt::format("Cannot write manifest {}.", manifest.string())};
+	}
+	file << "# path\tsize\tn_nonzeros\tfingerprint\tcost\n";
+	for (auto const& entry : entries) {
+		auto const path = fs::absolute(entry.path).lexically_normal().lexically_proximate(base);
+		file << path.generic_string() << '\t' << entry.size << '\t';
+		if (entry.n_nonzeros.has_value()) {
+			file << entry.n_nonzeros.value();
+		}
+		file << '\t';
+		if (entry.fingerprint.has_value()) {
+			file << fmt::format("{:016x}", entry.fingerprint.value());
+		}
+		file << '\t';
+		if (entry.cost.has_value()) {
+			file << fmt::format("{}", entry.cost.value());
+		}
+		file << '\n';
+	}
+	if (!file.flush()) {
+		throw std::invalid_argument{fmt::format("Cannot write manifest {}.", manifest.string())};
+	}
+}
+
+auto read_manifest(fs::path const& manifest) -> std::vector<ManifestEntry> {
+	auto file = std::ifstream{manifest};
+	if (!file) {
+		throw std::invalid_argument{fmt::format("Cannot open manifest {}.", manifest.string())};
+	}
+	auto const base = manifest.parent_path();
+	auto entries = std::vector<ManifestEntry>{};
+	auto line = std::string{};
+	for (std::size_t line_number = 1; std::getline(file, line); ++line_number) {
+		if (line.empty() || line.front() == '#') {
+			continue;
+		}
+		auto fields = std::vector<std::string>{};
+		auto stream = std::istringstream{line};
+		for (auto field = std::string{}; std::getline(stream, field, '\t');) {
+			fields.push_back(std::move(field));
+		}
+		// A trailing empty field is not seen by getline
+		if (line.back() == '\t') {
+			fields.emplace_back();
+		}
+		if (fields.size() < 2 || fields.size() > 5 || fields[0].empty()) {
+			throw std::invalid_argument{fmt::format("Manifest line {} is not well formed.", line_number)};
+		}
+		fields.resize(5);
+		auto path = fs::path{fields[0]};
+		entries.push_back({
+			path.is_relative() ? (base / path).lexically_normal() : std::move(path),
+			parse_integer<std::uintmax_t>(fields[1], 10, line_number),  // NOLINT(readability-magic-numbers)
+			parse_optional<std::size_t>(fields[2], 10, line_number),    // NOLINT(readability-magic-numbers)
+			parse_optional<std::uint64_t>(fields[3], 16, line_number),  // NOLINT(readability-magic-numbers)
+			parse_cost(fields[4], line_number),
+		});
+	}
+	return entries;
+}
+
+}  // namespace ecole::instance
@@ -0,0 +1,23 @@
+#include <string>
+
+#include <scip/scip.h>
+
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+#include "instance/names.hpp"
+
+namespace ecole::instance {
+
+auto make_problem(std::string const& name, bool named) -> scip::Model {
+	auto model = scip::Model{};
+	if (!named) {
+		// Must be set before creating the problem
+		model.set_param("misc/usevartable", false);
+		model.set_param("misc/useconstable", false);
+	}
+	scip::call(SCIPcreateProbBasic, model.get_scip_ptr(), name.c_str());
+	return model;
+}
+
+}  // namespace ecole::instance
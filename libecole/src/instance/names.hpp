@@ -0,0 +1,41 @@
+#pragma once
+
+#include <iterator>
+#include <string>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "ecole/scip/model.hpp"
+
+namespace ecole::instance {
+
+/**
+ * Create an empty problem to be filled by an instance generator.
+ *
+ * When entities are not named, SCIP does not keep hash tables of variable and constraint names.
+ */
+auto make_problem(std::string const& name, bool named) -> scip::Model;
+
+/** Format the names of variables and constraints in a reused buffer, or give empty names to anonymous entities. */
+class NameFormatter {
+public:
+	explicit NameFormatter(bool named_) noexcept : named{named_} {}
+
+	/** The formatted name, valid until the next call. */
+	template <typename... Args> auto operator()(fmt::format_string<Args...> format, Args&&... args) -> char const* {
+		if (!named) {
+			return "";
+		}
+		buffer.clear();
+		fmt::format_to(std::back_inserter(buffer), format, std::forward<Args>(args)...);
+		buffer.push_back('\0');
+		return buffer.data();
+	}
+
+private:
+	bool named;
+	fmt::memory_buffer buffer;
+};
+
+}  // namespace ecole::instance
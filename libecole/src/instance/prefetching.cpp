@@ -0,0 +1,224 @@
+#include <algorithm>
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+#include "ecole/exception.hpp"
+#include "ecole/instance/prefetching.hpp"
+#include "ecole/utility/thread-pool.hpp"
+#include "utility/state.hpp"
+
+namespace ecole::instance {
+
+namespace {
+
+/** The state of a generator, or nothing for generators that do not support saving it. */
+auto saved_state(InstanceGenerator const& generator) -> std::optional<std::string> {
+	try {
+		return generator.save_state();
+	} catch (std::logic_error const&) {
+		return {};
+	}
+}
+
+}  // namespace
+
+PrefetchingGenerator::PrefetchingGenerator(
+	Factory const& make_generator,
+	std::size_t n_threads,
+	std::size_t queue_size_,
+	RandomGenerator rng_) :
+	rng{rng_}, queue_size{queue_size_} {
+	if (n_threads == 0) {
+		throw std::invalid_argument{"The number of threads must be positive."};
+	}
+	if (queue_size == 0) {
+		throw std::invalid_argument{"The size of the queues must be positive."};
+	}
+	slots.reserve(n_threads);
+	for (std::size_t i = 0; i < n_threads; ++i) {
+		slots.push_back(std::make_unique<Slot>());
+		slots.back()->generator = make_generator();
+	}
+	start();
+}
+
+PrefetchingGenerator::PrefetchingGenerator(
+	Factory const& make_generator,
+	std::size_t n_threads,
+	std::size_t queue_size_) :
+	PrefetchingGenerator{make_generator, n_threads, queue_size_, ecole::spawn_random_generator()} {}
+
+PrefetchingGenerator::~PrefetchingGenerator() {
+	stop();
+}
+
+auto PrefetchingGenerator::next() -> scip::Model {
+	auto lock = std::unique_lock{mutex};
+	// Take from the threads in turn, skipping the exhausted ones
+	for (std::size_t n_exhausted = 0; n_exhausted < slots.size();) {
+		auto& slot = *slots[next_slot];
+		produced_cv.wait(lock, [&slot] { return !slot.ready.empty() || slot.error || slot.exhausted; });
+		if (!slot.ready.empty()) {
+			auto model = std::move(slot.ready.front());
+			slot.ready.pop_front();
+			slot.ready_states.pop_front();
+			next_slot = (next_slot + 1) % slots.size();
+			lock.unlock();
+			consumed_cv.notify_all();
+			return model;
+		}
+		if (slot.error) {
+			// The thread stopped on the error, so the generator is considered exhausted afterward
+			slot.exhausted = true;
+			next_slot = (next_slot + 1) % slots.size();
+			std::rethrow_exception(std::exchange(slot.error, nullptr));
+		}
+		next_slot = (next_slot + 1) % slots.size();
+		++n_exhausted;
+	}
+	throw IteratorExhausted{};
+}
+
+void PrefetchingGenerator::seed(Seed seed) {
+	stop();
+	clear();
+	next_slot = 0;
+	rng.seed(seed);
+	start();
+}
+
+auto PrefetchingGenerator::save_state() const -> std::string {
+	auto lock = std::unique_lock{mutex};
+	auto const settled = [](auto const& slot) { return !slot->ready.empty() || slot->error || slot->exhausted; };
+	produced_cv.wait(lock, [&] { return std::all_of(slots.begin(), slots.end(), settled); });
+	auto writer = utility::StateWriter{};
+	writer.write(slots.size());
+	writer.write(next_slot);
+	for (auto const& slot : slots) {
+		auto const& state = slot->ready_states.empty() ? slot->last_state : slot->ready_states.front();
+		if (!state.has_value()) {
+			throw std::logic_error{"PrefetchingGenerator runs generators that do not support saving their state."};
+		}
+		writer.write(state.value());
+	}
+	return std::move(writer).str();
+}
+
+void PrefetchingGenerator::load_state(std::string_view state) {
+	auto reader = utility::StateReader{state};
+	if (reader.read_integer() != slots.size()) {
+		throw std::invalid_argument{"PrefetchingGenerator state was saved with a different number of threads."};
+	}
+	auto const new_next_slot = static_cast<std::size_t>(reader.read_integer());
+	if (new_next_slot >= slots.size()) {
+		throw std::invalid_argument{"PrefetchingGenerator state has an invalid next thread."};
+	}
+	auto generator_states = std::vector<std::string_view>{};
+	for (std::size_t i = 0; i < slots.size(); ++i) {
+		generator_states.push_back(reader.read_bytes());
+	}
+	reader.finish();
+
+	stop();
+	clear();
+	// The threads are restarted even if a generator rejects its state, so that the generator stays usable
+	try {
+		for (std::size_t i = 0; i < slots.size(); ++i) {
+			slots[i]->generator->load_state(generator_states[i]);
+		}
+	} catch (...) {
+		launch();
+		throw;
+	}
+	next_slot = new_next_slot;
+	launch();
+}
+
+auto PrefetchingGenerator::done() const -> bool {
+	auto lock = std::unique_lock{mutex};
+	auto const settled = [](auto const& slot) { return !slot->ready.empty() || slot->error || slot->exhausted; };
+	produced_cv.wait(lock, [&] { return std::all_of(slots.begin(), slots.end(), settled); });
+	auto const exhausted = [](auto const& slot) { return slot->ready.empty() && !slot->error && slot->exhausted; };
+	return std::all_of(slots.begin(), slots.end(), exhausted);
+}
+
+void PrefetchingGenerator::start() {
+	// Every thread gets its own stream, derived before any of them start, to be reproducible
+	auto streams = split_random_generator(rng, slots.size());
+	for (std::size_t i = 0; i < slots.size(); ++i) {
+		slots[i]->generator->seed(streams[i]());
+	}
+	launch();
+}
+
+void PrefetchingGenerator::launch() {
+	stopping = false;
+	for (auto& slot : slots) {
+		slot->worker = std::thread{[this, &slot = *slot, running = utility::RunningThread{}] { produce(slot); }};
+	}
+}
+
+void PrefetchingGenerator::stop() {
+	{
+		auto const lock = std::lock_guard{mutex};
+		stopping = true;
+	}
+	consumed_cv.notify_all();
+	for (auto& slot : slots) {
+		if (slot->worker.joinable()) {
+			slot->worker.join();
+		}
+	}
+}
+
+void PrefetchingGenerator::clear() {
+	for (auto& slot : slots) {
+		slot->ready.clear();
+		slot->ready_states.clear();
+		slot->last_state.reset();
+		slot->error = nullptr;
+		slot->exhausted = false;
+	}
+}
+
+void PrefetchingGenerator::produce(Slot& slot) {
+	while (true) {
+		{
+			auto lock = std::unique_lock{mutex};
+			consumed_cv.wait(lock, [&] { return stopping || slot.ready.size() < queue_size; });
+			if (stopping) {
+				return;
+			}
+		}
+		// Only this thread uses the generator while it is running, so it is used outside of the lock
+		auto state = std::optional<std::string>{};
+		try {
+			state = saved_state(*slot.generator);
+			if (slot.generator->done()) {
+				auto const lock = std::lock_guard{mutex};
+				slot.last_state = std::move(state);
+				slot.exhausted = true;
+			} else {
+				auto model = slot.generator->next();
+				auto const lock = std::lock_guard{mutex};
+				slot.ready.push_back(std::move(model));
+				slot.ready_states.push_back(std::move(state));
+			}
+		} catch (...) {
+			auto const lock = std::lock_guard{mutex};
+			slot.last_state = std::move(state);
+			slot.error = std::current_exception();
+		}
+		produced_cv.notify_all();
+		auto const lock = std::lock_guard{mutex};
+		if (slot.exhausted || slot.error) {
+			return;
+		}
+	}
+}
+
+}  // namespace ecole::instance
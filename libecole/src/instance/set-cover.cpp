@@ -1,6 +1,9 @@
-#include <fmt/format.h>
+#include <algorithm>
 #include <map>
+#include <random>
+#include <vector>
 
+#include <fmt/format.h>
 #include <xtensor/xrandom.hpp>
 #include <xtensor/xsort.hpp>
 #include <xtensor/xtensor.hpp>
@@ -12,6 +15,8 @@
 #include "ecole/scip/utils.hpp"
 #include "ecole/scip/var.hpp"
 
+#include "instance/names.hpp"
+
 namespace ecole::instance {
 
 /*************************************
@@ -32,6 +37,14 @@ void SetCoverGenerator::seed(Seed seed) {
 	rng.seed(seed);
 }
 
+auto SetCoverGenerator::save_state() const -> std::string {
+	return serialize_binary(rng);
+}
+
+void SetCoverGenerator::load_state(std::string_view state) {
+	rng = deserialize_binary(state);
+}
+
 namespace {
 
 using std::size_t;
@@ -73,34 +86,31 @@ auto get_counts(xvector& indices, size_t n_cols) -> xvector {
  *
  * Samples num_samples values in the range from start_index to
  * end_index.
+ * This is the reservoir sampling of xt::random::choice without replacement, with the same random draws, but without
+ * materializing the range, which is as large as the constraint matrix.
  */
 auto get_choice_in_range(size_t start_index, size_t end_index, size_t num_samples, RandomGenerator& rng) -> xvector {
-	xvector choices = xt::arange<size_t>(start_index, end_index, 1);
-	xvector samples = xt::random::choice(choices, num_samples, false, rng);
+	xvector samples = xt::arange<size_t>(start_index, start_index + num_samples, 1);
+	for (size_t i = num_samples; i < end_index - start_index; ++i) {
+		auto const idx = std::uniform_int_distribution<size_t>(0, i)(rng);
+		if (idx < num_samples) {
+			samples(idx) = start_index + i;
+		}
+	}
 	return samples;
 }
 
-/** Adds a variable to the SCIP Model.
- *
- * Adds a single binary variable with a specified cost.
- */
-auto add_var(SCIP* scip, size_t idx, SCIP_Real cost) -> SCIP_VAR* {
-	auto const name = fmt::format("x_{}", idx);
-	auto unique_var = scip::create_var_basic(scip, name.c_str(), 0., 1., cost, SCIP_VARTYPE_BINARY);
-	auto* var_ptr = unique_var.get();
-	scip::call(SCIPaddVar, scip, var_ptr);
-	return var_ptr;
-}
-
 /** Adds all variables to the SCIP Model.
  *
- * A variable is added for each element (or column) in the
+ * A binary variable is added for each element (or column) in the
  * set cover problem.
  */
-auto add_vars(SCIP* scip, xt::xtensor<SCIP_Real, 1> const& c) -> xt::xtensor<SCIP_VAR*, 1> {
-	auto vars = xt::xtensor<SCIP_VAR*, 1>{{c.shape()}};
+auto add_vars(SCIP* scip, xt::xtensor<SCIP_Real, 1> const& c, NameFormatter& name) -> std::vector<SCIP_VAR*> {
+	auto vars = std::vector<SCIP_VAR*>(c.size());
 	for (size_t i = 0; i < c.size(); ++i) {
-		vars(i) = add_var(scip, i, c(i));
+		auto unique_var = scip::create_var_basic(scip, name("x_{}", i), 0., 1., c(i), SCIP_VARTYPE_BINARY);
+		vars[i] = unique_var.get();
+		scip::call(SCIPaddVar, scip, vars[i]);
 	}
 	return vars;
 }
@@ -108,23 +118,30 @@ auto add_vars(SCIP* scip, xt::xtensor<SCIP_Real, 1> const& c) -> xt::xtensor<SCI
 /** Adds set covering constaints.
  *
  * For each set, at least one element is required to the solution.
+ * Constraints are read directly from the CSR arrays, reusing the same buffers for all of them.
  */
-auto add_constaints(SCIP* scip, xt::xtensor<SCIP_VAR*, 1> vars, xvector& indices, xvector& indptr, size_t n_rows) {
-
+auto add_constaints(
+	SCIP* scip,
+	std::vector<SCIP_VAR*> const& vars,
+	xvector const& indices,
+	xvector const& indptr,
+	size_t n_rows,
+	NameFormatter& name) {
+	auto const inf = SCIPinfinity(scip);
+	size_t max_row_size = 0;
 	for (size_t i = 0; i < n_rows; ++i) {
+		max_row_size = std::max(max_row_size, indptr(i + 1) - indptr(i));
+	}
+	auto cons_vars = std::vector<SCIP_VAR*>(max_row_size);
+	auto const coefs = std::vector<SCIP_Real>(max_row_size, 1.);
 
-		// get the set of variables to be added in the constraint.
-		auto cons_vars = xt::xtensor<SCIP_VAR*, 1>{{indptr(i + 1) - indptr(i)}};
-		for (size_t j = indptr(i); j < indptr(i + 1); ++j) {
-			cons_vars(j - indptr(i)) = vars(indices(j));
+	for (size_t i = 0; i < n_rows; ++i) {
+		auto const row_size = indptr(i + 1) - indptr(i);
+		for (size_t j = 0; j < row_size; ++j) {
+			cons_vars[j] = vars[indices(indptr(i) + j)];
 		}
-
-		// add constraint to SCIP Model.
-		auto name = fmt::format("c_{}", i);
-		auto const inf = SCIPinfinity(scip);
-		auto coefs = xt::xtensor<SCIP_Real, 1>(cons_vars.shape(), 1.);
-		auto cons =
-			scip::create_cons_basic_linear(scip, name.c_str(), cons_vars.size(), &cons_vars(0), coefs.data(), 1.0, inf);
+		auto cons = scip::create_cons_basic_linear(
+			scip, name("c_{}", i), row_size, cons_vars.data(), coefs.data(), 1.0, inf);
 		scip::call(SCIPaddCons, scip, cons.get());
 	}
 }
@@ -224,14 +241,14 @@ scip::Model SetCoverGenerator::generate_instance(Parameters parameters, RandomGe
 	xt::xtensor<SCIP_Real, 1> c = xt::random::randint<size_t>({n_cols}, 0, max_coef, rng) + 1;
 
 	// create scip model
-	auto model = scip::Model::prob_basic();
-	model.set_name(fmt::format("SetCover-{}-{}", parameters.n_rows, parameters.n_cols));
+	auto model = make_problem(fmt::format("SetCover-{}-{}", parameters.n_rows, parameters.n_cols), parameters.named);
 	auto* const scip = model.get_scip_ptr();
 	scip::call(SCIPsetObjsense, scip, SCIP_OBJSENSE_MINIMIZE);
 
 	// add variables and constraints
-	auto const vars = add_vars(scip, c);
-	add_constaints(scip, vars, indices_csr, indptr_csr, n_rows);
+	auto name = NameFormatter{parameters.named};
+	auto const vars = add_vars(scip, c, name);
+	add_constaints(scip, vars, indices_csr, indptr_csr, n_rows, name);
 
 	return model;
 
@@ -0,0 +1,73 @@
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+
+#include "ecole/exception.hpp"
+#include "ecole/instance/sharded.hpp"
+#include "utility/state.hpp"
+
+namespace ecole::instance {
+
+ShardedGenerator::ShardedGenerator(
+	std::unique_ptr<InstanceGenerator> generator_,
+	std::size_t rank_,
+	std::size_t world_size_,
+	RandomGenerator rng_) :
+	generator{std::move(generator_)}, m_rank{rank_}, m_world_size{world_size_}, rng{rng_} {
+	if (generator == nullptr) {
+		throw std::invalid_argument{"The sharded generator must not be null."};
+	}
+	if (m_world_size == 0) {
+		throw std::invalid_argument{"The world size must be positive."};
+	}
+	if (m_rank >= m_world_size) {
+		throw std::invalid_argument{
+			fmt::format("The rank {} must be smaller than the world size {}.", m_rank, m_world_size)};
+	}
+}
+
+ShardedGenerator::ShardedGenerator(
+	std::unique_ptr<InstanceGenerator> generator_,
+	std::size_t rank_,
+	std::size_t world_size_) :
+	ShardedGenerator{std::move(generator_), rank_, world_size_, ecole::spawn_random_generator()} {}
+
+auto ShardedGenerator::next() -> scip::Model {
+	if (done()) {
+		throw IteratorExhausted{};
+	}
+	// Same derivation as write_dataset, from the index of the instance in the whole sequence
+	auto instance_rng = derive_random_generator(rng, m_rank + n_generated * m_world_size);
+	generator->seed(instance_rng());
+	auto model = generator->next();
+	++n_generated;
+	return model;
+}
+
+void ShardedGenerator::seed(Seed seed) {
+	rng.seed(seed);
+	n_generated = 0;
+}
+
+auto ShardedGenerator::done() const -> bool {
+	return generator->done();
+}
+
+auto ShardedGenerator::save_state() const -> std::string {
+	auto writer = utility::StateWriter{};
+	writer.write(serialize_binary(rng));
+	writer.write(n_generated);
+	return std::move(writer).str();
+}
+
+void ShardedGenerator::load_state(std::string_view state) {
+	auto reader = utility::StateReader{state};
+	auto new_rng = deserialize_binary(reader.read_bytes());
+	auto const new_n_generated = reader.read_integer();
+	reader.finish();
+	rng = new_rng;
+	n_generated = new_n_generated;
+}
+
+}  // namespace ecole::instance
@@ -0,0 +1,144 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <scip/scip.h>
+#include <xtensor/xbuilder.hpp>
+
+#include "ecole/observation/budgeted-strong-branching-scores.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+#include "observation/strong-branching.hpp"
+
+namespace ecole::observation {
+
+namespace {
+
+/** Candidates to score, ordered by decreasing pseudocost score and truncated to the budget. */
+auto preselect_candidates(scip::Model& model, bool pseudo_candidates, std::optional<std::size_t> max_candidates) {
+	auto* const scip = model.get_scip_ptr();
+	auto const all_cands = pseudo_candidates ? model.pseudo_branch_cands() : model.lp_branch_cands();
+	auto cands = std::vector<SCIP_VAR*>(all_cands.begin(), all_cands.end());
+
+	if (max_candidates.has_value() && max_candidates.value() < cands.size()) {
+		auto pseudocost_score = [scip](SCIP_VAR* var) {
+			return SCIPgetVarPseudocostScore(scip, var, SCIPvarGetLPSol(var));
+		};
+		auto const n_kept = static_cast<std::ptrdiff_t>(max_candidates.value());
+		std::partial_sort(cands.begin(), cands.begin() + n_kept, cands.end(), [&](auto* var1, auto* var2) {
+			return pseudocost_score(var1) > pseudocost_score(var2);
+		});
+		cands.resize(max_candidates.value());
+	}
+	return cands;
+}
+
+/** Score the candidates in the same way as the vanillafullstrong branching rule, leaving NaN when the LP fails. */
+auto strong_branching_scores(
+	SCIP* scip,
+	std::vector<SCIP_VAR*> const& cands,
+	int iteration_limit,
+	xt::xtensor<double, 1>& scores) -> void {
+	if (cands.empty()) {
+		return;
+	}
+	auto const lp_objval = SCIPgetLPObjval(scip);
+
+	scip::call(SCIPstartStrongbranch, scip, false);
+	for (auto* const var : cands) {
+		auto const children = strong_branch(scip, var, lp_objval, iteration_limit, true);
+		if (!children.has_value()) {
+			break;
+		}
+		auto const var_index = static_cast<std::size_t>(SCIPvarGetProbindex(var));
+		scores[var_index] = static_cast<double>(SCIPgetBranchScore(scip, var, children->down_gain, children->up_gain));
+	}
+	scip::call(SCIPendStrongbranch, scip);
+}
+
+/** Whether the candidate has pseudocosts updated at least the given number of times in both directions. */
+auto has_reliable_pseudocosts(SCIP* scip, SCIP_VAR* var, SCIP_Real threshold) -> bool {
+	return std::min(
+			   SCIPgetVarPseudocostCountCurrentRun(scip, var, SCIP_BRANCHDIR_DOWNWARDS),
+			   SCIPgetVarPseudocostCountCurrentRun(scip, var, SCIP_BRANCHDIR_UPWARDS)) >= threshold;
+}
+
+}  // namespace
+
+BudgetedStrongBranchingScores::BudgetedStrongBranchingScores(
+	bool pseudo_candidates_,
+	std::optional<std::size_t> max_candidates_,
+	std::optional<std::size_t> max_lp_iterations_,
+	bool reuse_cache_) :
+	pseudo_candidates(pseudo_candidates_),
+	max_candidates(max_candidates_),
+	max_lp_iterations(max_lp_iterations_),
+	reuse_cache(reuse_cache_) {}
+
+auto BudgetedStrongBranchingScores::before_reset(scip::Model& /*model*/) -> void {
+	cache = {};
+}
+
+auto BudgetedStrongBranchingScores::extract(scip::Model& model, bool /* done */)
+	-> std::optional<xt::xtensor<double, 1>> {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		return {};
+	}
+
+	auto* const scip = model.get_scip_ptr();
+	auto const node_number = SCIPnodeGetNumber(SCIPgetCurrentNode(scip));
+	auto const n_lps = SCIPgetNLPs(scip);
+	if (reuse_cache && (node_number == cache.node_number) && (n_lps == cache.n_lps)) {
+		return cache.scores;
+	}
+
+	auto const cands = preselect_candidates(model, pseudo_candidates, max_candidates);
+	auto scores = nan_scores(scip);
+	strong_branching_scores(scip, cands, to_iteration_limit(max_lp_iterations), scores);
+
+	if (reuse_cache) {
+		cache = {node_number, n_lps, scores};
+	}
+	return scores;
+}
+
+ReliabilityBranchingScores::ReliabilityBranchingScores(
+	bool pseudo_candidates_,
+	SCIP_Real reliability_threshold_,
+	std::optional<std::size_t> max_lp_iterations_) :
+	pseudo_candidates(pseudo_candidates_),
+	reliability_threshold(reliability_threshold_),
+	max_lp_iterations(max_lp_iterations_) {}
+
+auto ReliabilityBranchingScores::extract(scip::Model& model, bool /* done */)
+	-> std::optional<ReliabilityBranchingScoresObs> {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		return {};
+	}
+
+	auto* const scip = model.get_scip_ptr();
+	auto obs = ReliabilityBranchingScoresObs{nan_scores(scip), {}};
+	obs.exact = xt::zeros<bool>(obs.scores.shape());
+
+	auto unreliable_cands = std::vector<SCIP_VAR*>{};
+	for (auto* const var : pseudo_candidates ? model.pseudo_branch_cands() : model.lp_branch_cands()) {
+		auto const var_index = static_cast<std::size_t>(SCIPvarGetProbindex(var));
+		if (has_reliable_pseudocosts(scip, var, reliability_threshold)) {
+			obs.scores[var_index] = SCIPgetVarPseudocostScore(scip, var, SCIPvarGetLPSol(var));
+		} else {
+			unreliable_cands.push_back(var);
+		}
+	}
+
+	strong_branching_scores(scip, unreliable_cands, to_iteration_limit(max_lp_iterations), obs.scores);
+	for (auto* const var : unreliable_cands) {
+		auto const var_index = static_cast<std::size_t>(SCIPvarGetProbindex(var));
+		obs.exact[var_index] = !std::isnan(obs.scores[var_index]);
+	}
+	return obs;
+}
+
+}  // namespace ecole::observation
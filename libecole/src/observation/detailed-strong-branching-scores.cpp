@@ -0,0 +1,60 @@
+#include <cmath>
+#include <cstddef>
+
+#include <scip/scip.h>
+#include <xtensor/xbuilder.hpp>
+
+#include "ecole/observation/detailed-strong-branching-scores.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+#include "observation/strong-branching.hpp"
+
+namespace ecole::observation {
+
+DetailedStrongBranchingScores::DetailedStrongBranchingScores(
+	bool pseudo_candidates_,
+	std::optional<std::size_t> max_lp_iterations_) :
+	pseudo_candidates(pseudo_candidates_), max_lp_iterations(max_lp_iterations_) {}
+
+auto DetailedStrongBranchingScores::extract(scip::Model& model, bool /* done */)
+	-> std::optional<DetailedStrongBranchingScoresObs> {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		return {};
+	}
+
+	auto* const scip = model.get_scip_ptr();
+	auto const nb_vars = static_cast<std::size_t>(SCIPgetNVars(scip));
+	auto obs = DetailedStrongBranchingScoresObs{
+		xt::xtensor<double, 1>({nb_vars}, std::nan("")),
+		xt::xtensor<double, 1>({nb_vars}, std::nan("")),
+		xt::xtensor<double, 1>({nb_vars}, std::nan("")),
+		xt::zeros<std::size_t>({nb_vars}),
+	};
+	auto const cands = pseudo_candidates ? model.pseudo_branch_cands() : model.lp_branch_cands();
+	if (cands.empty()) {
+		return obs;
+	}
+
+	auto const lp_objval = SCIPgetLPObjval(scip);
+	auto const iteration_limit = to_iteration_limit(max_lp_iterations);
+	scip::call(SCIPstartStrongbranch, scip, false);
+	for (auto* const var : cands) {
+		// Not idempotent so that SCIP counts the iterations and stores the result in the column
+		auto const children = strong_branch(scip, var, lp_objval, iteration_limit, false);
+		if (!children.has_value()) {
+			break;
+		}
+		auto const var_index = static_cast<std::size_t>(SCIPvarGetProbindex(var));
+		obs.scores[var_index] =
+			static_cast<double>(SCIPgetBranchScore(scip, var, children->down_gain, children->up_gain));
+		obs.down_gains[var_index] = children->down_gain;
+		obs.up_gains[var_index] = children->up_gain;
+		obs.n_lp_iterations[var_index] = static_cast<std::size_t>(children->n_lp_iterations);
+	}
+	scip::call(SCIPendStrongbranch, scip);
+
+	return obs;
+}
+
+}  // namespace ecole::observation
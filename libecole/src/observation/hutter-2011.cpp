@@ -1,28 +1,38 @@
 #include <algorithm>
+#include <array>
+#include <cassert>
 #include <cmath>
+#include <cstddef>
+#include <filesystem>
+#include <limits>
+#include <numeric>
 #include <optional>
+#include <random>
+#include <stdexcept>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
 
+#include <nonstd/span.hpp>
 #include <range/v3/numeric/accumulate.hpp>
 #include <range/v3/range/conversion.hpp>
 #include <range/v3/view/iota.hpp>
 #include <range/v3/view/transform.hpp>
 #include <scip/scip.h>
-#include <xtensor/xadapt.hpp>
 #include <xtensor/xindex_view.hpp>
-#include <xtensor/xsort.hpp>
 #include <xtensor/xtensor.hpp>
 #include <xtensor/xview.hpp>
 
 #include "ecole/observation/hutter-2011.hpp"
 #include "ecole/scip/cons.hpp"
 #include "ecole/scip/model.hpp"
+#include "ecole/threads.hpp"
+#include "ecole/utility/metrics.hpp"
 #include "ecole/utility/sparse-matrix.hpp"
 
-#include "utility/graph.hpp"
 #include "utility/math.hpp"
+#include "utility/mps.hpp"
 
 namespace ecole::observation {
 
@@ -41,6 +51,54 @@ template <typename E> constexpr auto idx(E e) {
 	return static_cast<std::underlying_type_t<E>>(e);
 }
 
+/** Variable data that the features depend upon, with infinite bounds as IEEE infinities. */
+struct VariableData {
+	std::vector<SCIP_Real> objective;
+	std::vector<SCIP_Real> lower_bounds;
+	std::vector<SCIP_Real> upper_bounds;
+	std::vector<SCIP_VARTYPE> types;
+
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return types.size(); }
+};
+
+auto get_variable_data(scip::Model const& model) -> VariableData {
+	auto* const scip = const_cast<SCIP*>(model.get_scip_ptr());
+	auto const variables = model.variables();
+	auto to_ieee = [scip](SCIP_Real bound) {
+		if (SCIPisInfinity(scip, std::abs(bound))) {
+			return std::copysign(std::numeric_limits<SCIP_Real>::infinity(), bound);
+		}
+		return bound;
+	};
+	auto data = VariableData{};
+	for (auto* const var : variables) {
+		data.objective.push_back(SCIPvarGetObj(var));
+		data.lower_bounds.push_back(to_ieee(SCIPvarGetLbGlobal(var)));
+		data.upper_bounds.push_back(to_ieee(SCIPvarGetUbGlobal(var)));
+		data.types.push_back(SCIPvarGetType(var));
+	}
+	return data;
+}
+
+/** Variable types as SCIP reader would create them, that is binary for integer variables within zero and one. */
+auto get_variable_data(utility::MpsProblem problem) -> VariableData {
+	auto data = VariableData{
+		std::move(problem.objective), std::move(problem.lower_bounds), std::move(problem.upper_bounds), {}};
+	data.types.reserve(problem.integral.size());
+	for (std::size_t var_idx = 0; var_idx < problem.integral.size(); ++var_idx) {
+		auto const lb = data.lower_bounds[var_idx];
+		auto const ub = data.upper_bounds[var_idx];
+		if (!problem.integral[var_idx]) {
+			data.types.push_back(SCIP_VARTYPE_CONTINUOUS);
+		} else if ((lb >= 0.) && (ub <= 1.)) {
+			data.types.push_back(SCIP_VARTYPE_BINARY);
+		} else {
+			data.types.push_back(SCIP_VARTYPE_INTEGER);
+		}
+	}
+	return data;
+}
+
 /** [1-3] Problem size features. */
 template <typename Tensor> void set_problem_size(Tensor&& out, ConstraintMatrix const& cons_matrix) {
 	out[idx(Features::nb_variables)] = static_cast<value_type>(cons_matrix.shape[var_axis]);
@@ -81,71 +139,154 @@ template <typename Tensor> void set_var_cons_degrees(Tensor&& out, ConstraintMat
 }
 
 /**
- * Compute the quantile of an xtensor expression.
+ * Compute quantiles of some data, reordering it in place.
  *
  * The quantiles are computed by linear interpolation of the two data points in which it falls.
+ * The data points are selected with ``std::nth_element``, in linear time and without copy, every selection only
+ * partitioning the elements above the previous one.
  *
  * @param data The (unsorted) data from which to extract the quantiles.
- * @param percentages Quantiles to compute, between 0 and 1.
+ * @param percentages Quantiles to compute, between 0 and 1, in increasing order.
  */
-template <typename E, typename QT, std::size_t QN> auto quantiles(E&& data, std::array<QT, QN> const& percentages) {
+template <typename T, typename QT, std::size_t QN>
+auto quantiles(nonstd::span<T> data, std::array<QT, QN> const& percentages) -> std::array<QT, QN> {
 	static_assert(std::is_floating_point_v<QT>);
 	assert(std::all_of(percentages.begin(), percentages.end(), [](auto p) { return (0 <= p) && (p <= 1); }));
+	assert(std::is_sorted(percentages.begin(), percentages.end()));
 
-	auto const data_size = static_cast<QT>(data.size());
-
-	// IILF Fill an array with upper and lower index of each quantile
-	auto const quantile_idx = [&]() {
-		auto pos = std::array<std::size_t, 2 * QN>{};
-		auto pos_iter = pos.begin();
-		for (auto p : percentages) {
-			auto const continuous_idx = p * data_size;
-			*(pos_iter++) = static_cast<std::size_t>(std::floor(continuous_idx));
-			*(pos_iter++) = static_cast<std::size_t>(std::ceil(continuous_idx));
+	auto quants = std::array<QT, QN>{};
+	if (data.empty()) {
+		return quants;
+	}
+	auto const last_idx = data.size() - 1;
+	// Elements before it are either selected already, or below the last selected one
+	auto unselected = data.begin();
+	auto const select = [&](std::size_t idx) {
+		auto const nth = data.begin() + static_cast<std::ptrdiff_t>(idx);
+		if (nth >= unselected) {
+			std::nth_element(unselected, nth, data.end());
+			unselected = nth + 1;
 		}
-		return pos;
-	}();
-
-	// Partially sort data so that the element whose index are given by quantile_idx are in the correct postiion.
-	auto const partially_sorted_data = xt::partition(std::forward<E>(data), quantile_idx);
+		return static_cast<QT>(*nth);
+	};
 
-	//
-	auto quants = std::array<QT, QN>{};
-	auto* quants_iter = quants.begin();
-	for (auto p : percentages) {
-		auto const continuous_idx = p * data_size;
-		auto const down_idx = static_cast<std::size_t>(std::floor(continuous_idx));
-		auto const down_val = static_cast<QT>(partially_sorted_data[down_idx]);
-		auto const up_idx = static_cast<std::size_t>(std::floor(continuous_idx));
-		auto const up_val = static_cast<QT>(partially_sorted_data[up_idx]);
+	for (std::size_t i = 0; i < QN; ++i) {
+		auto const continuous_idx = percentages[i] * static_cast<QT>(data.size());
+		auto const down_val = select(std::min(static_cast<std::size_t>(std::floor(continuous_idx)), last_idx));
+		auto const up_val = select(std::min(static_cast<std::size_t>(std::ceil(continuous_idx)), last_idx));
 		auto const frac = continuous_idx - std::floor(continuous_idx);
-		*(quants_iter++) = (1 - frac) * down_val + frac * up_val;
+		quants[i] = (1 - frac) * down_val + frac * up_val;
 	}
 	return quants;
 }
 
-/** [12-17,20] Variable graph features. */
-template <typename Tensor> void set_var_degrees(Tensor&& out, ConstraintMatrix const& matrix) {
-	auto const n_var = matrix.shape[var_axis];
-	auto const n_cons = matrix.shape[cons_axis];
-	// Build variable graph.
-	// TODO could be optimized if we know matrix.indices[cons_axis] is sorted (or sort it).
-	auto graph = utility::Graph{n_var};
-	for (std::size_t cons = 0; cons < n_cons; ++cons) {
-		auto const vars =
-			xt::eval(xt::filter(xt::row(matrix.indices, var_axis), xt::equal(xt::row(matrix.indices, cons_axis), cons)));
-		auto const* const var_end = vars.end();
-		for (auto const* var1_iter = vars.begin(); var1_iter < var_end; ++var1_iter) {
-			for (auto const* var2_iter = var1_iter + 1; var2_iter < var_end; ++var2_iter) {
-				if (!graph.are_connected(*var1_iter, *var2_iter)) {
-					graph.add_edge({*var1_iter, *var2_iter});
+/** Compressed incidence lists, such as the variables of every constraint. */
+struct Incidence {
+	std::vector<std::size_t> offsets;
+	std::vector<std::size_t> indices;
+
+	[[nodiscard]] auto size() const noexcept -> std::size_t { return offsets.size() - 1; }
+	[[nodiscard]] auto of(std::size_t i) const -> nonstd::span<std::size_t const> {
+		return {indices.data() + offsets[i], offsets[i + 1] - offsets[i]};
+	}
+};
+
+/** Group the non zero coefficients of the matrix by their index along the given axis (counting sort). */
+auto make_incidence(ConstraintMatrix const& matrix, std::size_t from_axis) -> Incidence {
+	auto const to_axis = 1 - from_axis;
+	auto incidence = Incidence{
+		std::vector<std::size_t>(matrix.shape[from_axis] + 1, 0),
+		std::vector<std::size_t>(matrix.nnz()),
+	};
+	for (auto const from : xt::row(matrix.indices, from_axis)) {
+		incidence.offsets[from + 1]++;
+	}
+	std::partial_sum(incidence.offsets.begin(), incidence.offsets.end(), incidence.offsets.begin());
+	auto cursors = std::vector<std::size_t>(incidence.offsets.begin(), incidence.offsets.end() - 1);
+	for (std::size_t k = 0; k < matrix.nnz(); ++k) {
+		incidence.indices[cursors[matrix.indices(from_axis, k)]++] = matrix.indices(to_axis, k);
+	}
+	return incidence;
+}
+
+/**
+ * Build the variable graph, where two variables are adjacent if they appear in a common constraint.
+ *
+ * This is the sparsity pattern of the product of the transposed constraint matrix with itself (without its diagonal),
+ * computed one variable at a time by marking the variables of all the constraints it appears in.
+ * Neighbors of every variables are sorted.
+ */
+auto make_var_graph(Incidence const& vars_of_cons, Incidence const& cons_of_var) -> Incidence {
+	auto const n_var = cons_of_var.size();
+	auto const no_var = n_var;
+	auto last_marked_by = std::vector<std::size_t>(n_var, no_var);
+	auto graph = Incidence{{0}, {}};
+	graph.offsets.reserve(n_var + 1);
+	for (std::size_t var = 0; var < n_var; ++var) {
+		last_marked_by[var] = var;
+		for (auto const cons : cons_of_var.of(var)) {
+			for (auto const neighbor : vars_of_cons.of(cons)) {
+				if (last_marked_by[neighbor] != var) {
+					last_marked_by[neighbor] = var;
+					graph.indices.push_back(neighbor);
 				}
 			}
 		}
+		std::sort(graph.indices.begin() + static_cast<std::ptrdiff_t>(graph.offsets.back()), graph.indices.end());
+		graph.offsets.push_back(graph.indices.size());
+	}
+	return graph;
+}
+
+/**
+ * Estimate the clustering coefficient of a node of the graph.
+ *
+ * The coefficient is the fraction of pairs of neighbors that are themselves adjacent.
+ * Pairs are all enumerated if there are at most ``n_samples`` of them, otherwise ``n_samples`` pairs are drawn at
+ * random.
+ */
+template <typename RandomEngine>
+auto clustering_coef(Incidence const& graph, std::size_t node, std::size_t n_samples, RandomEngine& rng) -> double {
+	auto const neighbors = graph.of(node);
+	auto const degree = neighbors.size();
+	if (degree < 2) {
+		return 0.;
+	}
+	auto are_connected = [&graph](std::size_t node1, std::size_t node2) {
+		auto const node1_neighbors = graph.of(node1);
+		return std::binary_search(node1_neighbors.begin(), node1_neighbors.end(), node2);
+	};
+
+	auto const n_pairs = degree * (degree - 1) / 2;
+	std::size_t n_connected = 0;
+	if (n_pairs <= n_samples) {
+		for (std::size_t i = 0; i < degree; ++i) {
+			for (std::size_t j = i + 1; j < degree; ++j) {
+				n_connected += are_connected(neighbors[i], neighbors[j]) ? 1 : 0;
+			}
+		}
+		return static_cast<double>(n_connected) / static_cast<double>(n_pairs);
 	}
+	auto choice = std::uniform_int_distribution<std::size_t>{0, degree - 1};
+	for (std::size_t sample = 0; sample < n_samples; ++sample) {
+		auto const i = choice(rng);
+		auto j = choice(rng);
+		while (j == i) {
+			j = choice(rng);
+		}
+		n_connected += are_connected(neighbors[i], neighbors[j]) ? 1 : 0;
+	}
+	return static_cast<double>(n_connected) / static_cast<double>(n_samples);
+}
+
+/** [12-20] Variable graph features. */
+template <typename Tensor>
+void set_var_degrees(Tensor&& out, ConstraintMatrix const& matrix, std::size_t n_clustering_samples) {
+	auto const n_var = matrix.shape[var_axis];
+	auto const graph = make_var_graph(make_incidence(matrix, cons_axis), make_incidence(matrix, var_axis));
 
 	// Compute stats
-	auto get_var_degree = [&graph](auto var) { return graph.neighbors(var).size(); };
+	auto get_var_degree = [&graph](auto var) { return graph.of(var).size(); };
 	auto var_degrees = views::ints(0UL, n_var) | views::transform(get_var_degree) | ranges::to<std::vector>();
 
 	auto const stats = utility::compute_stats(var_degrees);
@@ -153,16 +294,38 @@ template <typename Tensor> void set_var_degrees(Tensor&& out, ConstraintMatrix c
 	out[idx(Features::node_degree_max)] = stats.max;
 	out[idx(Features::node_degree_min)] = stats.min;
 	out[idx(Features::node_degree_std)] = stats.stddev;
-	auto const quants = quantiles(xt::adapt(var_degrees), std::array<double, 2>{0.25, 0.75});
+	// The degrees are not needed anymore, so they are reordered in place
+	auto const quants = quantiles(nonstd::span<std::size_t>{var_degrees}, std::array<double, 2>{0.25, 0.75});
 	out[idx(Features::node_degree_25q)] = quants[0];
 	out[idx(Features::node_degree_75q)] = quants[1];
+
+	// Fixed seed so that the observation is deterministic
+	auto rng = std::mt19937{};
+	auto clustering = utility::StatsAccumulator<value_type>{};
+	for (std::size_t var = 0; var < n_var; ++var) {
+		clustering.add(clustering_coef(graph, var, n_clustering_samples, rng));
+	}
+	auto const clustering_stats = clustering.stats();
+	out[idx(Features::clustering_coef_mean)] = clustering_stats.mean;
+	out[idx(Features::clustering_coef_std)] = clustering_stats.stddev;
+
+	auto const n_edges = graph.indices.size() / 2;
 	auto const n_edges_complete_graph = static_cast<value_type>(n_var * (n_var - 1)) / 2.;
-	out[idx(Features::edge_density)] = static_cast<value_type>(graph.n_edges()) / n_edges_complete_graph;
+	out[idx(Features::edge_density)] = static_cast<value_type>(n_edges) / n_edges_complete_graph;
 }
 
-/** Solves the LP relaxation of a model by making a copy, and setting all its variables continuous. */
-auto solve_lp_relaxation(scip::Model const& model) {
-	auto relax_model = model.copy();
+/** The solution of the LP relaxation, in the order of the variables of the model, and its objective value. */
+using LpSolution = std::tuple<std::vector<SCIP_Real>, SCIP_Real>;
+
+/**
+ * Solves the LP relaxation of a model by making a copy, and setting all its variables continuous.
+ *
+ * Only the problem is copied when possible, since the heuristics, separators, and propagators of the model would be
+ * copied, and run, for nothing.
+ */
+auto solve_lp_relaxation(scip::Model const& model) -> LpSolution {
+	auto problem_copy = model.copy_problem(scip::PluginProfile::branching);
+	auto relax_model = problem_copy.has_value() ? std::move(problem_copy).value() : model.copy();
 	auto* const relax_scip = relax_model.get_scip_ptr();
 	auto const variables = relax_model.variables();
 
@@ -201,12 +364,36 @@ auto solve_lp_relaxation(scip::Model const& model) {
 		variables.data(),
 		optimal_sol_coefs.data());
 
-	return std::tuple{std::move(optimal_sol_coefs), optimal_value};
+	return {std::move(optimal_sol_coefs), optimal_value};
+}
+
+auto is_root_lp_solved(scip::Model const& model) -> bool {
+	auto const stage = model.stage();
+	if (stage != SCIP_STAGE_SOLVING && stage != SCIP_STAGE_SOLVED) {
+		return false;
+	}
+	return SCIPgetLPRootObjval(const_cast<SCIP*>(model.get_scip_ptr())) != SCIP_INVALID;
+}
+
+/** Reads the solution of the root LP of a model being solved, if the root LP is solved. */
+auto get_root_lp(scip::Model const& model) -> std::optional<LpSolution> {
+	if (!is_root_lp_solved(model)) {
+		return {};
+	}
+	auto* const scip = const_cast<SCIP*>(model.get_scip_ptr());
+	auto const variables = model.variables();
+	auto root_sol_coefs = std::vector<SCIP_Real>(variables.size());
+	std::transform(variables.begin(), variables.end(), root_sol_coefs.begin(), [](auto* var) {
+		return SCIPvarGetRootSol(var);
+	});
+	return {{std::move(root_sol_coefs), SCIPretransformObj(scip, SCIPgetLPRootObjval(scip))}};
 }
 
 /** [21-24] LP based features. */
-template <typename Tensor> void set_lp_based_features(Tensor&& out, scip::Model const& model) {
-	auto const [lp_solution, lp_objective] = solve_lp_relaxation(model);
+template <typename Tensor> void set_lp_based_features(Tensor&& out, scip::Model const& model, bool reuse_root_lp) {
+	auto root_lp = reuse_root_lp ? get_root_lp(model) : std::nullopt;
+	auto const [lp_solution, lp_objective] =
+		root_lp.has_value() ? std::move(root_lp).value() : solve_lp_relaxation(model);
 
 	// Compute the integer slack vector
 	auto* const scip = const_cast<SCIP*>(model.get_scip_ptr());
@@ -242,8 +429,7 @@ template <typename Tensor> void set_lp_based_features(Tensor&& out, scip::Model
 
 /** [25-27] Objective function features. */
 template <typename Tensor>
-void set_obj_features(Tensor&& out, scip::Model const& model, ConstraintMatrix const& cons_matrix) {
-	auto const variables = model.variables();
+void set_obj_features(Tensor&& out, VariableData const& variables, ConstraintMatrix const& cons_matrix) {
 	auto coefficients_m = std::vector<value_type>{};
 	auto coefficients_n = std::vector<value_type>{};
 	auto coefficients_sqrtn = std::vector<value_type>{};
@@ -258,7 +444,7 @@ void set_obj_features(Tensor&& out, scip::Model const& model, ConstraintMatrix c
 	coefficients_sqrtn.resize(variables.size());
 	auto const nb_constraints = static_cast<value_type>(cons_matrix.shape[cons_axis]);
 	for (std::size_t var_idx = 0; var_idx < variables.size(); ++var_idx) {
-		auto c = SCIPvarGetObj(variables[var_idx]);
+		auto c = variables.objective[var_idx];
 		coefficients_m.push_back(c / nb_constraints);
 		if (nb_cons_of_vars[var_idx] != 0) {
 			coefficients_n.push_back(c / nb_cons_of_vars[var_idx]);
@@ -329,28 +515,32 @@ void set_cons_matrix_features(
 }
 
 /** [32-35] Variable type features. */
-template <typename Tensor> void set_variable_type_features(Tensor&& out, scip::Model const& model) {
-	auto* const scip = const_cast<SCIP*>(model.get_scip_ptr());
+template <typename Tensor> void set_variable_type_features(Tensor&& out, VariableData const& variables) {
 	double nb_unbounded_int_vars = 0.;
+	double nb_int_vars = 0.;
+	double nb_cont_vars = 0.;
 
 	auto support_sizes = std::vector<std::size_t>{};
-	for (auto* const variable : model.variables()) {
-		if (SCIPvarGetType(variable) == SCIP_VARTYPE_BINARY) {
+	for (std::size_t var_idx = 0; var_idx < variables.size(); ++var_idx) {
+		auto const type = variables.types[var_idx];
+		if (type == SCIP_VARTYPE_BINARY) {
 			support_sizes.push_back(2);
-		} else if (SCIPvarGetType(variable) == SCIP_VARTYPE_INTEGER) {
-			auto ub = SCIPvarGetUbGlobal(variable);
-			auto lb = SCIPvarGetLbGlobal(variable);
-			if (SCIPisInfinity(scip, std::abs(ub)) || SCIPisInfinity(scip, std::abs(lb))) {
+			nb_int_vars++;
+		} else if (type == SCIP_VARTYPE_INTEGER) {
+			auto ub = variables.upper_bounds[var_idx];
+			auto lb = variables.lower_bounds[var_idx];
+			if (std::isinf(ub) || std::isinf(lb)) {
 				nb_unbounded_int_vars++;
 			} else {
 				support_sizes.push_back(static_cast<std::size_t>(ub - lb));
 			}
+			nb_int_vars++;
+		} else if (type == SCIP_VARTYPE_CONTINUOUS) {
+			nb_cont_vars++;
 		}
 	}
 
 	auto const support_sizes_stats = utility::compute_stats(support_sizes);
-	auto const nb_int_vars = static_cast<double>(SCIPgetNBinVars(scip) + SCIPgetNIntVars(scip));
-	auto const nb_cont_vars = static_cast<double>(SCIPgetNContVars(scip));
 
 	out[idx(Features::discrete_vars_support_size_mean)] = support_sizes_stats.mean;
 	out[idx(Features::discrete_vars_support_size_std)] = support_sizes_stats.stddev;
@@ -362,18 +552,33 @@ template <typename Tensor> void set_variable_type_features(Tensor&& out, scip::M
 	out[idx(Features::ratio_continuous_vars)] = nb_cont_vars / (nb_int_vars + nb_cont_vars);
 }
 
-auto extract_features(scip::Model& model) {
-	auto observation = xt::xtensor<value_type, 1>::from_shape({Hutter2011Obs::n_features});
-	auto const [cons_matrix, cons_biases] = scip::get_all_constraints(model.get_scip_ptr());
+/** Features that do not need to solve the LP relaxation, the LP based ones being left to NaN. */
+auto extract_static_features(
+	VariableData const& variables,
+	ConstraintMatrix const& cons_matrix,
+	xt::xtensor<SCIP_Real, 1> const& cons_biases,
+	std::size_t n_clustering_samples) {
+	auto observation = xt::xtensor<value_type, 1>({Hutter2011Obs::n_features}, std::nan(""));
 
 	set_problem_size(observation, cons_matrix);
 	set_var_cons_degrees(observation, cons_matrix);
-	set_var_degrees(observation, cons_matrix);
-	set_lp_based_features(observation, model);
-	set_obj_features(observation, model, cons_matrix);
+	set_var_degrees(observation, cons_matrix, n_clustering_samples);
+	set_obj_features(observation, variables, cons_matrix);
 	set_cons_matrix_features(observation, cons_matrix, cons_biases);
-	set_variable_type_features(observation, model);
+	set_variable_type_features(observation, variables);
+
+	return observation;
+}
 
+auto extract_features(
+	scip::Model& model,
+	ConstraintMatrix const& cons_matrix,
+	xt::xtensor<SCIP_Real, 1> const& cons_biases,
+	std::size_t n_clustering_samples,
+	bool reuse_root_lp) {
+	auto observation =
+		extract_static_features(get_variable_data(model), cons_matrix, cons_biases, n_clustering_samples);
+	set_lp_based_features(observation, model, reuse_root_lp);
 	return observation;
 }
 
@@ -383,11 +588,73 @@ auto extract_features(scip::Model& model) {
  *  Observation extracting function  *
  *************************************/
 
+Hutter2011::Hutter2011(
+	bool cache_features_,
+	std::size_t n_clustering_samples_,
+	std::size_t n_threads,
+	bool reuse_root_lp_,
+	std::size_t max_cached_instances_) :
+	cache_features(cache_features_),
+	n_clustering_samples(n_clustering_samples_),
+	reuse_root_lp(reuse_root_lp_),
+	max_cached_instances(max_cached_instances_) {
+	if (n_clustering_samples == 0) {
+		throw std::invalid_argument{"The number of clustering samples must be positive."};
+	}
+	if (cache_features && max_cached_instances == 0) {
+		throw std::invalid_argument{"The number of cached instances must be positive."};
+	}
+	thread_pool = make_thread_pool(n_threads);
+}
+
 auto Hutter2011::extract(scip::Model& model, bool /* done */) -> std::optional<Hutter2011Obs> {
-	if (model.stage() >= SCIP_STAGE_SOLVING) {
+	if (model.stage() >= SCIP_STAGE_SOLVING && !(reuse_root_lp && is_root_lp_solved(model))) {
 		return {};
 	}
-	return {{extract_features(model)}};
+
+	auto const compute_features = [&] {
+		auto const [cons_matrix, cons_biases] =
+			scip::get_all_constraints(model.get_scip_ptr(), false, false, thread_pool.get());
+		return extract_features(model, cons_matrix, cons_biases, n_clustering_samples, reuse_root_lp);
+	};
+	if (!cache_features) {
+		return {{compute_features()}};
+	}
+
+	static auto constexpr help = "Extractions of Hutter2011 caching features, found in the cache or computed.";
+	static auto& n_hits = utility::metrics::counter("ecole_hutter2011_cache_requests_total", help, {{"result", "hit"}});
+	static auto& n_misses =
+		utility::metrics::counter("ecole_hutter2011_cache_requests_total", help, {{"result", "miss"}});
+	// Looked up before reading the constraints, which is most of the cost of the features
+	auto const exact_fingerprint = model.exact_fingerprint();
+	if (!exact_fingerprint.has_value()) {
+		return {{compute_features()}};
+	}
+	auto const fingerprint = exact_fingerprint.value();
+	if (auto const iter = cache.find(fingerprint); iter != cache.end()) {
+		n_hits.add();
+		iter->second.last_use = ++cache_clock;
+		return {{iter->second.features}};
+	}
+	n_misses.add();
+	auto features = compute_features();
+	if (cache.size() >= max_cached_instances) {
+		// Linear search of the least recently used entry, which is small compared to computing the features
+		auto const lru = std::min_element(cache.begin(), cache.end(), [](auto const& a, auto const& b) {
+			return a.second.last_use < b.second.last_use;
+		});
+		cache.erase(lru);
+	}
+	cache.emplace(fingerprint, CacheEntry{features, ++cache_clock});
+	return {{std::move(features)}};
+}
+
+auto Hutter2011::extract_from_file(std::filesystem::path const& filename) const -> Hutter2011Obs {
+	auto problem = utility::read_mps(filename);
+	auto const cons_matrix = std::move(problem.constraint_matrix);
+	auto const cons_biases = std::move(problem.constraint_biases);
+	auto const variables = get_variable_data(std::move(problem));
+	return {extract_static_features(variables, cons_matrix, cons_biases, n_clustering_samples)};
 }
 
 }  // namespace ecole::observation
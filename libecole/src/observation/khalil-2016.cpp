@@ -1,12 +1,21 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <cmath>
-#include <set>
+#include <cstddef>
+#include <future>
+#include <iterator>
+#include <memory>
+#include <numeric>
+#include <optional>
+#include <string>
 #include <type_traits>
 #include <utility>
+#include <vector>
 
 #include <nonstd/span.hpp>
-#include <range/v3/numeric/accumulate.hpp>
-#include <range/v3/range/conversion.hpp>
-#include <range/v3/view/filter.hpp>
+#include <objscip/objeventhdlr.h>
 #include <range/v3/view/transform.hpp>
 #include <range/v3/view/zip.hpp>
 #include <xtensor/xfixed.hpp>
@@ -14,8 +23,11 @@
 
 #include "ecole/observation/khalil-2016.hpp"
 #include "ecole/scip/col.hpp"
+#include "ecole/scip/lp-view.hpp"
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/row.hpp"
+#include "ecole/scip/utils.hpp"
+#include "ecole/threads.hpp"
 
 #include "utility/math.hpp"
 
@@ -27,6 +39,7 @@ namespace views = ranges::views;
 
 using Features = Khalil2016Obs::Features;
 using value_type = decltype(Khalil2016Obs::features)::value_type;
+using Clock = std::chrono::steady_clock;
 
 using ecole::utility::safe_div;
 using ecole::utility::square;
@@ -88,67 +101,65 @@ template <typename Tensor> void set_number_constraints(Tensor&& out, SCIP_COL* c
 }
 
 /**
- * Stats. for constraint degrees.
+ * Stats. for constraint degrees and constraint coeffs.
  *
  * The degree of a constraint is the number of variables that participate in it.
  * A variable may participate in multiple constraints, and statistics over those constraints'
  * degrees are used.
  * The constraint degree is computed on the root LP (mean, stdev., min, max)
- */
-template <typename Tensor>
-void set_static_stats_for_constraint_degree(Tensor&& out, nonstd::span<SCIP_ROW*> const rows) noexcept {
-	auto row_get_nnz = [](auto const row) { return static_cast<std::size_t>(SCIProwGetNNonz(row)); };
-	auto const stats = utility::compute_stats(rows | ranges::views::transform(row_get_nnz));
-	out[idx(Features::rows_deg_mean)] = stats.mean;
-	out[idx(Features::rows_deg_stddev)] = stats.stddev;
-	out[idx(Features::rows_deg_min)] = stats.min;
-	out[idx(Features::rows_deg_max)] = stats.max;
-}
-
-/**
- * Stats. for constraint coeffs.
  *
- * A variable's positive coefficients in the constraints it participates in
+ * A variable's positive and negative coefficients in the constraints it participates in
  * (count, mean, stdev., min, max).
- */
-template <typename Tensor>
-void set_stats_for_constraint_positive_coefficients(Tensor&& out, nonstd::span<SCIP_Real> const coefficients) noexcept {
-	auto const stats = utility::compute_stats(coefficients | views::filter([](auto x) { return x > 0.; }));
-	out[idx(Features::rows_pos_coefs_count)] = stats.count;
-	out[idx(Features::rows_pos_coefs_mean)] = stats.mean;
-	out[idx(Features::rows_pos_coefs_stddev)] = stats.stddev;
-	out[idx(Features::rows_pos_coefs_min)] = stats.min;
-	out[idx(Features::rows_pos_coefs_max)] = stats.max;
-}
-
-/**
- * Stats. for constraint coeffs.
  *
- * A variable's negative coefficients in the constraints it participates in
- * (count, mean, stdev., min, max).
+ * All statistics are accumulated in a single sweep over the column, as this is recomputed on every reset.
  */
 template <typename Tensor>
-void set_stats_for_constraint_negative_coefficients(Tensor&& out, nonstd::span<SCIP_Real> const coefficients) noexcept {
-	auto const stats = utility::compute_stats(coefficients | views::filter([](auto x) { return x < 0.; }));
-	out[idx(Features::rows_neg_coefs_count)] = stats.count;
-	out[idx(Features::rows_neg_coefs_mean)] = stats.mean;
-	out[idx(Features::rows_neg_coefs_stddev)] = stats.stddev;
-	out[idx(Features::rows_neg_coefs_min)] = stats.min;
-	out[idx(Features::rows_neg_coefs_max)] = stats.max;
+void set_static_stats_for_constraints(
+	Tensor&& out,
+	nonstd::span<SCIP_ROW*> const rows,
+	nonstd::span<SCIP_Real> const coefficients) noexcept {
+	auto degree_stats = utility::StatsAccumulator<value_type>{};
+	auto positive_stats = utility::StatsAccumulator<value_type>{};
+	auto negative_stats = utility::StatsAccumulator<value_type>{};
+	auto const n_rows = rows.size();
+	for (std::size_t i = 0; i < n_rows; ++i) {
+		degree_stats.add(static_cast<value_type>(SCIProwGetNNonz(rows[i])));
+		auto const coef = coefficients[i];
+		if (coef > 0.) {
+			positive_stats.add(coef);
+		} else if (coef < 0.) {
+			negative_stats.add(coef);
+		}
+	}
+
+	auto const degree = degree_stats.stats();
+	out[idx(Features::rows_deg_mean)] = degree.mean;
+	out[idx(Features::rows_deg_stddev)] = degree.stddev;
+	out[idx(Features::rows_deg_min)] = degree.min;
+	out[idx(Features::rows_deg_max)] = degree.max;
+
+	auto const positive = positive_stats.stats();
+	out[idx(Features::rows_pos_coefs_count)] = positive.count;
+	out[idx(Features::rows_pos_coefs_mean)] = positive.mean;
+	out[idx(Features::rows_pos_coefs_stddev)] = positive.stddev;
+	out[idx(Features::rows_pos_coefs_min)] = positive.min;
+	out[idx(Features::rows_pos_coefs_max)] = positive.max;
+
+	auto const negative = negative_stats.stats();
+	out[idx(Features::rows_neg_coefs_count)] = negative.count;
+	out[idx(Features::rows_neg_coefs_mean)] = negative.mean;
+	out[idx(Features::rows_neg_coefs_stddev)] = negative.stddev;
+	out[idx(Features::rows_neg_coefs_min)] = negative.min;
+	out[idx(Features::rows_neg_coefs_max)] = negative.max;
 }
 
 /**
  * Extract the static features for a single LP columns.
  */
 template <typename Tensor> void set_static_features(Tensor&& out, SCIP_COL* const col) {
-	auto const rows = scip::get_rows(col);
-	auto const coefficients = scip::get_vals(col);
-
 	set_objective_function_coefficient(out, col);
 	set_number_constraints(out, col);
-	set_static_stats_for_constraint_degree(out, rows);
-	set_stats_for_constraint_positive_coefficients(out, coefficients);
-	set_stats_for_constraint_negative_coefficients(out, coefficients);
+	set_static_stats_for_constraints(out, scip::get_rows(col), scip::get_vals(col));
 }
 
 /**
@@ -239,9 +250,9 @@ template <typename Tensor> void set_infeasibility_statistics(Tensor&& out, SCIP_
  * avoid passing the wrong ones.
  */
 template <typename Tensor>
-void set_dynamic_stats_for_constraint_degree(Tensor&& out, nonstd::span<SCIP_ROW*> const rows) noexcept {
-	auto row_get_lp_nnz = [](auto const row) { return static_cast<std::size_t>(SCIProwGetNLPNonz(row)); };
-	auto const stats = utility::compute_stats(rows | views::transform(row_get_lp_nnz));
+void set_dynamic_stats_for_constraint_degree(
+	Tensor&& out,
+	utility::StatsFeatures<value_type> const& stats) noexcept {
 	auto const root_deg_mean = out[idx(Features::rows_deg_mean)];
 	auto const root_deg_min = out[idx(Features::rows_deg_min)];
 	auto const root_deg_max = out[idx(Features::rows_deg_max)];
@@ -254,31 +265,37 @@ void set_dynamic_stats_for_constraint_degree(Tensor&& out, nonstd::span<SCIP_ROW
 	out[idx(Features::rows_dynamic_deg_max_ratio)] = safe_div(stats.max, root_deg_max + stats.max);
 }
 
+auto constraint_degree_stats(nonstd::span<SCIP_ROW*> const rows) noexcept -> utility::StatsFeatures<value_type> {
+	auto row_get_lp_nnz = [](auto const row) { return static_cast<std::size_t>(SCIProwGetNLPNonz(row)); };
+	return utility::compute_stats(rows | views::transform(row_get_lp_nnz));
+}
+
 /**
  * Min/max for ratios of constraint coeffs. to RHS.
  *
  * Minimum and maximum ratios across positive and negative right-hand-sides (RHS).
  */
-template <typename Tensor>
-void set_min_max_for_ratios_constraint_coeffs_rhs(
-	Tensor&& out,
+struct RhsRatios {
+	value_type positive_min = 1.;
+	value_type positive_max = -1.;
+	value_type negative_min = 1.;
+	value_type negative_max = -1.;
+};
+
+auto ratios_constraint_coeffs_rhs(
 	SCIP* const scip,
 	nonstd::span<SCIP_ROW*> const rows,
-	nonstd::span<SCIP_Real> const coefficients) noexcept {
+	nonstd::span<SCIP_Real> const coefficients) noexcept -> RhsRatios {
+	auto ratios = RhsRatios{};
 
-	value_type positive_rhs_ratio_max = -1.;
-	value_type positive_rhs_ratio_min = 1.;
-	value_type negative_rhs_ratio_max = -1.;
-	value_type negative_rhs_ratio_min = 1.;
-
-	auto rhs_ratio_updates = [&](auto const coef, auto const rhs) {
+	auto rhs_ratio_updates = [&ratios](auto const coef, auto const rhs) {
 		auto const ratio_val = safe_div(coef, std::abs(coef) + std::abs(rhs));
 		if (rhs >= 0) {
-			positive_rhs_ratio_max = std::max(positive_rhs_ratio_max, ratio_val);
-			positive_rhs_ratio_min = std::min(positive_rhs_ratio_min, ratio_val);
+			ratios.positive_max = std::max(ratios.positive_max, ratio_val);
+			ratios.positive_min = std::min(ratios.positive_min, ratio_val);
 		} else {
-			negative_rhs_ratio_max = std::max(negative_rhs_ratio_max, ratio_val);
-			negative_rhs_ratio_min = std::min(negative_rhs_ratio_min, ratio_val);
+			ratios.negative_max = std::max(ratios.negative_max, ratio_val);
+			ratios.negative_min = std::min(ratios.negative_min, ratio_val);
 		}
 	};
 
@@ -291,11 +308,15 @@ void set_min_max_for_ratios_constraint_coeffs_rhs(
 			rhs_ratio_updates(-coef, -lhs);
 		}
 	}
+	return ratios;
+}
 
-	out[idx(Features::coef_pos_rhs_ratio_min)] = positive_rhs_ratio_min;
-	out[idx(Features::coef_pos_rhs_ratio_max)] = positive_rhs_ratio_max;
-	out[idx(Features::coef_neg_rhs_ratio_min)] = negative_rhs_ratio_min;
-	out[idx(Features::coef_neg_rhs_ratio_max)] = negative_rhs_ratio_max;
+template <typename Tensor>
+void set_min_max_for_ratios_constraint_coeffs_rhs(Tensor&& out, RhsRatios const& ratios) noexcept {
+	out[idx(Features::coef_pos_rhs_ratio_min)] = ratios.positive_min;
+	out[idx(Features::coef_pos_rhs_ratio_max)] = ratios.positive_max;
+	out[idx(Features::coef_neg_rhs_ratio_min)] = ratios.negative_min;
+	out[idx(Features::coef_neg_rhs_ratio_max)] = ratios.negative_max;
 }
 
 /**
@@ -351,13 +372,14 @@ void set_min_max_for_one_to_all_coefficient_ratios(
 }
 
 /**
- * Return if a row in the constraints is active in the LP.
+ * Return if a row is active, as precomputed in the weights of the active constraints coefficients.
+ *
+ * Contrary to the SCIP version, this does not lazily update the row activity, so it can be called concurrently.
+ * Rows that are not in the LP are never active.
  */
-auto row_is_active(SCIP* const scip, SCIP_ROW* const row) noexcept -> bool {
-	auto const activity = SCIPgetRowActivity(scip, row);
-	auto const lhs = SCIProwGetLhs(row);
-	auto const rhs = SCIProwGetRhs(row);
-	return SCIPisEQ(scip, activity, rhs) || SCIPisEQ(scip, activity, lhs);
+auto row_is_active(xt::xtensor<value_type, 2> const& active_rows_weights, SCIP_ROW* const row) noexcept -> bool {
+	auto const row_lp_idx = SCIProwGetLPPos(row);
+	return (row_lp_idx >= 0) && !std::isnan(active_rows_weights(row_lp_idx, 0));
 }
 
 /**
@@ -368,47 +390,42 @@ auto row_is_active(SCIP* const scip, SCIP_ROW* const row) noexcept -> bool {
  *   - inverse of the sum of the coefficients of all variables in constraint,
  *   - inverse of the sum of the coefficients of only candidate variables in constraint
  *   - dual cost of the constraint.
- * They are computed for every row that is active, as defined by @ref row_is_active.
+ * They are computed for every row that is active, that is binding at the LP optimum.
  * Weights for non activate rows are left as NaN and ununsed.
  * This is equivalent to an unsafe/unchecked masked tensor.
  */
 auto stats_for_active_constraint_coefficients_weights(scip::Model& model) {
 	auto* const scip = model.get_scip_ptr();
-	auto const lp_rows = model.lp_rows();
-	auto const branch_candidates = model.pseudo_branch_cands() | ranges::to<std::set>();
+	auto const lp = model.lp_view();
 
-	/** Check if a column is a branching candidate. */
-	auto is_candidate = [&branch_candidates](auto* col) { return branch_candidates.count(SCIPcolGetVar(col)) > 0; };
-
-	/** Compute the sum of absolute values in a range. */
-	auto sum_abs = [](auto range) {
-		return ranges::accumulate(range | views::transform([](auto x) { return std::abs(x); }), 0.);
-	};
-
-	/** Compute the sum of absolute value of column coefficient if the column is a branching candidate. */
-	auto sum_abs_if_candidate = [&is_candidate](auto const& row_cols, auto const& row_cols_vals) {
-		auto sum = value_type{0.};
-		for (auto const [col, val] : views::zip(row_cols, row_cols_vals)) {
-			if (is_candidate(col)) {
-				sum += std::abs(val);
-			}
-		}
-		return sum;
-	};
+	// Candidates are flagged by problem index rather than searched for every coefficient
+	auto is_candidate = std::vector<bool>(model.variables().size(), false);
+	for (auto* const var : model.pseudo_branch_cands()) {
+		is_candidate[static_cast<std::size_t>(SCIPvarGetProbindex(var))] = true;
+	}
 
 	/** Compute the inverse of a number or 1 if the number is zero. */
 	auto safe_inv = [](auto const x) { return x != 0. ? 1. / x : 1.; };
 
-	xt::xtensor<value_type, 2> weights{{lp_rows.size(), 4}, std::nan("")};
+	xt::xtensor<value_type, 2> weights{{lp->n_rows(), 4}, std::nan("")};
 	auto* weights_iter = weights.begin();
 
-	for (auto* const row : lp_rows) {
-		if (row_is_active(scip, row)) {
-			auto const row_cols_vals = scip::get_vals(row);
+	for (std::size_t i = 0; i < lp->n_rows(); ++i) {
+		// A row is active if it is binding at the LP optimum
+		auto const activity = lp->row_activities[i];
+		if (SCIPisEQ(scip, activity, lp->row_rhs[i]) || SCIPisEQ(scip, activity, lp->row_lhs[i])) {
+			auto sum_abs = value_type{0.};
+			auto sum_abs_candidates = value_type{0.};
+			for (auto const [col_idx, val] : views::zip(lp->row_columns(i), lp->row_values(i))) {
+				sum_abs += std::abs(val);
+				if (is_candidate[lp->column_var_indices[col_idx]]) {
+					sum_abs_candidates += std::abs(val);
+				}
+			}
 			*(weights_iter++) = 1.;
-			*(weights_iter++) = safe_inv(sum_abs(row_cols_vals));
-			*(weights_iter++) = safe_inv(sum_abs_if_candidate(scip::get_cols(row), row_cols_vals));
-			*(weights_iter++) = std::abs(SCIProwGetDualsol(row));
+			*(weights_iter++) = safe_inv(sum_abs);
+			*(weights_iter++) = safe_inv(sum_abs_candidates);
+			*(weights_iter++) = std::abs(lp->row_dual_values[i]);
 		} else {
 			weights_iter += 4;
 		}
@@ -434,7 +451,6 @@ auto stats_for_active_constraint_coefficients_weights(scip::Model& model) {
 template <typename Tensor>
 void set_stats_for_active_constraint_coefficients(
 	Tensor&& out,
-	SCIP* const scip,
 	nonstd::span<SCIP_ROW*> const rows,
 	nonstd::span<SCIP_Real> const coefficients,
 	xt::xtensor<value_type, 2> const& active_rows_weights) noexcept {
@@ -449,7 +465,7 @@ void set_stats_for_active_constraint_coefficients(
 	for (auto const [row, coef] : views::zip(rows, coefficients)) {
 		auto const row_lp_idx = SCIProwGetLPPos(row);
 
-		if (row_is_active(scip, row)) {
+		if (row_is_active(active_rows_weights, row)) {
 			n_active_rows++;
 
 			for (std::size_t weight_idx = 0; weight_idx < weights_stats.size(); ++weight_idx) {
@@ -473,7 +489,7 @@ void set_stats_for_active_constraint_coefficients(
 
 		for (auto const [row, coef] : views::zip(rows, coefficients)) {
 			auto const row_lp_idx = SCIProwGetLPPos(row);
-			if (row_is_active(scip, row)) {
+			if (row_is_active(active_rows_weights, row)) {
 				for (std::size_t weight_idx = 0; weight_idx < weights_stats.size(); ++weight_idx) {
 					auto const weight = active_rows_weights(row_lp_idx, weight_idx);
 					assert(!std::isnan(weight));  // If NaN likely hit a maked value
@@ -521,6 +537,170 @@ void set_stats_for_active_constraint_coefficients(
 	out[idx(Features::active_coef_weight4_max)] = weights_stats[3].max;
 }
 
+/**
+ * Groups of dynamic features computed together.
+ *
+ * A group is only computed when at least one of its features is selected.
+ */
+struct DynamicGroups {
+	bool slack_ceil_and_pseudocosts = false;
+	bool infeasibility_statistics = false;
+	bool constraint_degree = false;
+	bool ratios_constraint_coeffs_rhs = false;
+	bool one_to_all_coefficient_ratios = false;
+	bool active_constraint_coefficients = false;
+};
+
+/** A group of dynamic features, as the range of its features and its flag in DynamicGroups. */
+struct DynamicGroup {
+	Features first;
+	Features last;
+	bool DynamicGroups::*selected;
+};
+
+/** The groups by increasing cost, which is the order they are computed in when extraction has a time budget. */
+constexpr auto dynamic_groups_by_priority = std::array<DynamicGroup, 6>{{
+	{Features::slack, Features::pseudocost_product, &DynamicGroups::slack_ceil_and_pseudocosts},
+	{Features::n_cutoff_up, Features::n_cutoff_down_ratio, &DynamicGroups::infeasibility_statistics},
+	{Features::rows_dynamic_deg_mean, Features::rows_dynamic_deg_max_ratio, &DynamicGroups::constraint_degree},
+	{Features::coef_pos_rhs_ratio_min, Features::coef_neg_rhs_ratio_max, &DynamicGroups::ratios_constraint_coeffs_rhs},
+	{Features::pos_coef_pos_coef_ratio_min,
+	 Features::neg_coef_neg_coef_ratio_max,
+	 &DynamicGroups::one_to_all_coefficient_ratios},
+	{Features::active_coef_weight1_count,
+	 Features::active_coef_weight4_max,
+	 &DynamicGroups::active_constraint_coefficients},
+}};
+
+/** The positions of the selected features that lie in the range. */
+auto columns_of(nonstd::span<std::size_t const> const feature_indices, std::size_t first, std::size_t last)
+	-> std::vector<std::size_t> {
+	auto columns = std::vector<std::size_t>{};
+	for (std::size_t k = 0; k < feature_indices.size(); ++k) {
+		if ((first <= feature_indices[k]) && (feature_indices[k] <= last)) {
+			columns.push_back(k);
+		}
+	}
+	return columns;
+}
+
+auto dynamic_groups_of(nonstd::span<std::size_t const> const feature_indices) noexcept -> DynamicGroups {
+	auto groups = DynamicGroups{};
+	for (auto const& group : dynamic_groups_by_priority) {
+		groups.*group.selected = std::any_of(feature_indices.begin(), feature_indices.end(), [&group](auto i) {
+			return (idx(group.first) <= i) && (i <= idx(group.last));
+		});
+	}
+	return groups;
+}
+
+/** The dynamic features of a column that only depend on its rows. */
+struct RowDependentStats {
+	utility::StatsFeatures<value_type> constraint_degree;
+	RhsRatios ratios_constraint_coeffs_rhs;
+};
+
+auto row_dependent_stats(SCIP* const scip, SCIP_COL* const col) noexcept -> RowDependentStats {
+	auto const rows = scip::get_rows(col);
+	return {constraint_degree_stats(rows), ratios_constraint_coeffs_rhs(scip, rows, scip::get_vals(col))};
+}
+
+/**
+ * Event handler caching the row dependent statistics of columns across nodes.
+ *
+ * The statistics of a column are dropped whenever one of its rows enters or leaves the LP, or has its sides or
+ * coefficients changed while in the LP, so that the cost of a node scales with the changes of the LP rather than with
+ * its size.
+ * Rows freed out of the LP leave their columns without event, which is caught by comparing the number of rows of
+ * columns, and changes of the LP columns change the LP degree of rows, which drops all statistics.
+ */
+class LpRowsEventHandler : public ::scip::ObjEventhdlr {
+public:
+	inline static auto constexpr base_name = "ecole::observation::Khalil2016::LpRowsEventHandler";
+	inline static auto counter = std::atomic<unsigned long>{0};
+
+	LpRowsEventHandler(SCIP* scip, char const* name) :
+		ObjEventhdlr(scip, name, "Event handler tracking the columns of changed LP rows") {}
+
+	/** Catch LP row additions and deletions. */
+	auto scip_initsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE override {
+		return SCIPcatchEvent(scip, lp_events, eventhdlr, nullptr, nullptr);
+	}
+
+	/** Drop LP row additions and deletions. */
+	auto scip_exitsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE override {
+		return SCIPdropEvent(scip, lp_events, eventhdlr, nullptr, -1);
+	}
+
+	/** Drop the statistics of the columns of the row, and track modifications of rows while they are in the LP. */
+	auto scip_exec(SCIP* scip, SCIP_EVENTHDLR* eventhdlr, SCIP_EVENT* event, SCIP_EVENTDATA* /*eventdata*/)
+		-> SCIP_RETCODE override {
+		auto* const row = SCIPeventGetRow(event);
+		auto* const* const cols = SCIProwGetCols(row);
+		for (int k = 0; k < SCIProwGetNNonz(row); ++k) {
+			auto const var_idx = static_cast<std::size_t>(SCIPcolGetVarProbindex(cols[k]));
+			if (var_idx < m_columns.size()) {
+				m_columns[var_idx].n_rows = -1;
+			}
+		}
+		switch (SCIPeventGetType(event)) {
+		case SCIP_EVENTTYPE_ROWADDEDLP:
+			return SCIPcatchRowEvent(scip, row, SCIP_EVENTTYPE_ROWCHANGED, eventhdlr, nullptr, nullptr);
+		case SCIP_EVENTTYPE_ROWDELETEDLP:
+			return SCIPdropRowEvent(scip, row, SCIP_EVENTTYPE_ROWCHANGED, eventhdlr, nullptr, -1);
+		default:
+			return SCIP_OKAY;
+		}
+	}
+
+	/** Make room for every variable, and drop all statistics if the LP columns changed, before reading them. */
+	void prepare(SCIP* const scip) {
+		auto const n_lp_cols = SCIPgetNLPCols(scip);
+		if (n_lp_cols != m_n_lp_cols) {
+			m_columns.clear();
+			m_n_lp_cols = n_lp_cols;
+		}
+		m_columns.resize(static_cast<std::size_t>(SCIPgetNVars(scip)));
+	}
+
+	/**
+	 * The statistics of a column, only recomputed if its rows changed since they were last computed.
+	 *
+	 * Columns of different variables can be read concurrently, since each only writes its own entry.
+	 */
+	auto stats_of(SCIP* const scip, SCIP_COL* const col) noexcept -> RowDependentStats const& {
+		auto& column = m_columns[static_cast<std::size_t>(SCIPcolGetVarProbindex(col))];
+		if (auto const n_rows = SCIPcolGetNNonz(col); column.n_rows != n_rows) {
+			column.stats = row_dependent_stats(scip, col);
+			column.n_rows = n_rows;
+		}
+		return column.stats;
+	}
+
+private:
+	static inline auto constexpr lp_events = SCIP_EVENTTYPE_ROWADDEDLP | SCIP_EVENTTYPE_ROWDELETEDLP;
+
+	struct Column {
+		RowDependentStats stats;
+		/** The number of rows of the column when the statistics were computed, or -1 if they are not valid. */
+		int n_rows = -1;
+	};
+
+	std::vector<Column> m_columns;
+	int m_n_lp_cols = -1;
+};
+
+auto find_eventhdlr(scip::Model& model, std::string const& name) -> LpRowsEventHandler* {
+	return dynamic_cast<LpRowsEventHandler*>(SCIPfindObjEventhdlr(model.get_scip_ptr(), name.c_str()));
+}
+
+void add_eventhdlr(scip::Model& model, std::string const& name) {
+	auto handler = std::make_unique<LpRowsEventHandler>(model.get_scip_ptr(), name.c_str());
+	scip::call(SCIPincludeObjEventhdlr, model.get_scip_ptr(), handler.get(), true);
+	// NOLINTNEXTLINE memory ownership is passed to SCIP
+	handler.release();
+}
+
 /**
  * Extract the dynamic features for a single branching candidate variable.
  *
@@ -532,17 +712,41 @@ void set_dynamic_features(
 	Tensor&& out,
 	SCIP* const scip,
 	SCIP_VAR* const var,
-	xt::xtensor<value_type, 2> const& active_rows_weights) {
+	xt::xtensor<value_type, 2> const& active_rows_weights,
+	DynamicGroups const& groups,
+	LpRowsEventHandler* const handler) {
 	auto* const col = SCIPvarGetCol(var);
 	auto const rows = scip::get_rows(col);
 	auto const coefficients = scip::get_vals(col);
 
-	set_slack_ceil_and_pseudocosts(out, scip, var, col);
-	set_infeasibility_statistics(out, var);
-	set_dynamic_stats_for_constraint_degree(out, rows);
-	set_min_max_for_ratios_constraint_coeffs_rhs(out, scip, rows, coefficients);
-	set_min_max_for_one_to_all_coefficient_ratios(out, rows, coefficients);
-	set_stats_for_active_constraint_coefficients(out, scip, rows, coefficients, active_rows_weights);
+	if (groups.slack_ceil_and_pseudocosts) {
+		set_slack_ceil_and_pseudocosts(out, scip, var, col);
+	}
+	if (groups.infeasibility_statistics) {
+		set_infeasibility_statistics(out, var);
+	}
+	if (handler != nullptr && (groups.constraint_degree || groups.ratios_constraint_coeffs_rhs)) {
+		auto const& stats = handler->stats_of(scip, col);
+		if (groups.constraint_degree) {
+			set_dynamic_stats_for_constraint_degree(out, stats.constraint_degree);
+		}
+		if (groups.ratios_constraint_coeffs_rhs) {
+			set_min_max_for_ratios_constraint_coeffs_rhs(out, stats.ratios_constraint_coeffs_rhs);
+		}
+	} else {
+		if (groups.constraint_degree) {
+			set_dynamic_stats_for_constraint_degree(out, constraint_degree_stats(rows));
+		}
+		if (groups.ratios_constraint_coeffs_rhs) {
+			set_min_max_for_ratios_constraint_coeffs_rhs(out, ratios_constraint_coeffs_rhs(scip, rows, coefficients));
+		}
+	}
+	if (groups.one_to_all_coefficient_ratios) {
+		set_min_max_for_one_to_all_coefficient_ratios(out, rows, coefficients);
+	}
+	if (groups.active_constraint_coefficients) {
+		set_stats_for_active_constraint_coefficients(out, rows, coefficients, active_rows_weights);
+	}
 }
 
 /**
@@ -561,21 +765,144 @@ void set_precomputed_static_features(TensorOut&& var_features, TensorIn const& v
  *  Main extraction function  *
  ******************************/
 
-auto extract_all_features(scip::Model& model, bool pseudo, xt::xtensor<value_type, 2> const& static_features) {
+/**
+ * Extract the features of all branching candidates.
+ *
+ * Every candidate only writes its own row, and only reads from SCIP without updating its lazily computed values, so
+ * candidates can be partitioned among the threads of the pool when one is given.
+ * With ``candidates_only``, rows are candidates rather than variables.
+ * Features are computed in a full row on the stack, from which only the selected columns are copied.
+ *
+ * With a deadline, the static features are copied first, then the dynamic groups are computed one after the other, in
+ * priority order, for all candidates.
+ * Threads stop at the first candidate past the deadline, and the columns of the group being computed and of the
+ * following ones are left NaN and marked as timed out.
+ */
+auto extract_all_features(
+	scip::Model& model,
+	bool pseudo,
+	bool candidates_only,
+	nonstd::span<std::size_t const> const feature_indices,
+	xt::xtensor<value_type, 2> const& static_features,
+	utility::ThreadPool* thread_pool,
+	LpRowsEventHandler* handler,
+	std::optional<Clock::time_point> const deadline) -> Khalil2016Obs {
 	auto const branch_cands = pseudo ? model.pseudo_branch_cands() : model.lp_branch_cands();
-	auto observation = xt::xtensor<value_type, 2>{{model.variables().size(), Khalil2016Obs::n_features}, std::nan("")};
+	auto const n_cands = branch_cands.size();
+	auto const n_obs_rows = candidates_only ? n_cands : model.variables().size();
+	auto observation = Khalil2016Obs{
+		xt::xtensor<value_type, 2>{{n_obs_rows, feature_indices.size()}, std::nan("")},
+		decltype(Khalil2016Obs::candidates)::from_shape({n_cands}),
+		xt::xtensor<bool, 1>{{feature_indices.size()}, false},
+	};
 
 	auto* const scip = model.get_scip_ptr();
-	auto const active_rows_weights = stats_for_active_constraint_coefficients_weights(model);
-
-	for (auto* var : branch_cands) {
-		auto const var_idx = SCIPvarGetProbindex(var);
-		auto var_features = xt::row(observation, var_idx);
-		auto var_static_features = xt::row(static_features, var_idx);
-		set_precomputed_static_features(var_features, var_static_features);
-		set_dynamic_features(var_features, scip, var, active_rows_weights);
+	auto const groups = dynamic_groups_of(feature_indices);
+	if (handler != nullptr) {
+		handler->prepare(scip);
+	}
+
+	auto active_rows_weights = xt::xtensor<value_type, 2>{};
+	// Set by the first thread past the deadline, so that the others stop as well
+	auto timed_out = std::atomic<bool>{false};
+	auto const out_of_time = [&deadline, &timed_out] {
+		if (!deadline.has_value()) {
+			return false;
+		}
+		if (!timed_out.load(std::memory_order_relaxed) && Clock::now() >= deadline.value()) {
+			timed_out.store(true, std::memory_order_relaxed);
+		}
+		return timed_out.load(std::memory_order_relaxed);
+	};
+
+	auto const extract_candidates =
+		[&](std::size_t begin, std::size_t end, DynamicGroups const& to_compute, nonstd::span<std::size_t const> columns) {
+			for (auto i = begin; i < end && !out_of_time(); ++i) {
+				auto* const var = branch_cands[i];
+				auto const var_idx = SCIPvarGetProbindex(var);
+				observation.candidates(i) = static_cast<std::size_t>(var_idx);
+				auto all_features = xt::xtensor_fixed<value_type, xt::xshape<Khalil2016Obs::n_features>>{};
+				all_features.fill(std::nan(""));
+				set_precomputed_static_features(all_features, xt::row(static_features, var_idx));
+				set_dynamic_features(all_features, scip, var, active_rows_weights, to_compute, handler);
+				auto var_features =
+					xt::row(observation.features, candidates_only ? static_cast<std::ptrdiff_t>(i) : var_idx);
+				for (auto const k : columns) {
+					var_features(k) = all_features(feature_indices[k]);
+				}
+			}
+		};
+
+	auto const parallel = thread_pool != nullptr && !utility::ThreadPool::in_worker_thread();
+	auto const n_chunks = parallel ? std::min(thread_pool->size(), n_cands) : std::size_t{1};
+	auto const for_all_candidates = [&](DynamicGroups const& to_compute, nonstd::span<std::size_t const> columns) {
+		if (n_chunks <= 1) {
+			extract_candidates(0, n_cands, to_compute, columns);
+			return;
+		}
+		auto futures = std::vector<std::future<void>>{};
+		futures.reserve(n_chunks);
+		for (std::size_t chunk = 0; chunk < n_chunks; ++chunk) {
+			auto const begin = chunk * n_cands / n_chunks;
+			auto const end = (chunk + 1) * n_cands / n_chunks;
+			futures.push_back(thread_pool->submit([&extract_candidates, &to_compute, columns, begin, end] {
+				extract_candidates(begin, end, to_compute, columns);
+			}));
+		}
+		// All tasks are awaited before rethrowing since they reference local variables
+		for (auto& fut : futures) {
+			fut.wait();
+		}
+		for (auto& fut : futures) {
+			fut.get();
+		}
+	};
+
+	if (!deadline.has_value()) {
+		// Computed upfront as reading the LP view lazily updates row activities, which is not thread safe
+		if (groups.active_constraint_coefficients) {
+			active_rows_weights = stats_for_active_constraint_coefficients_weights(model);
+		}
+		auto all_columns = std::vector<std::size_t>(feature_indices.size());
+		std::iota(all_columns.begin(), all_columns.end(), std::size_t{0});
+		for_all_candidates(groups, all_columns);
+		return observation;
 	}
 
+	// Candidates and static features are copied from what is already computed, whatever the deadline
+	auto const static_columns = columns_of(feature_indices, 0, Khalil2016Obs::n_static_features - 1);
+	for (std::size_t i = 0; i < n_cands; ++i) {
+		auto const var_idx = SCIPvarGetProbindex(branch_cands[i]);
+		observation.candidates(i) = static_cast<std::size_t>(var_idx);
+		auto var_features = xt::row(observation.features, candidates_only ? static_cast<std::ptrdiff_t>(i) : var_idx);
+		for (auto const k : static_columns) {
+			var_features(k) = static_features(var_idx, feature_indices[k]);
+		}
+	}
+	// Candidates computed before the deadline are dropped too, so that a column is either complete or NaN
+	auto const drop_if_timed_out = [&observation, &timed_out](nonstd::span<std::size_t const> columns) {
+		if (timed_out.load()) {
+			for (auto const k : columns) {
+				xt::col(observation.features, static_cast<std::ptrdiff_t>(k)) = std::nan("");
+				observation.timed_out(k) = true;
+			}
+		}
+	};
+	for (auto const& group : dynamic_groups_by_priority) {
+		if (!(groups.*group.selected)) {
+			continue;
+		}
+		auto const columns = columns_of(feature_indices, idx(group.first), idx(group.last));
+		auto to_compute = DynamicGroups{};
+		to_compute.*group.selected = true;
+		if (to_compute.active_constraint_coefficients && !out_of_time()) {
+			active_rows_weights = stats_for_active_constraint_coefficients_weights(model);
+		}
+		if (!out_of_time()) {
+			for_all_candidates(to_compute, columns);
+		}
+		drop_if_timed_out(columns);
+	}
 	return observation;
 }
 
@@ -590,18 +917,58 @@ auto is_on_root_node(scip::Model& model) -> bool {
  *  Observation extracting function  *
  *************************************/
 
-Khalil2016::Khalil2016(bool pseudo_candidates_) noexcept : pseudo_candidates(pseudo_candidates_) {}
+Khalil2016::Khalil2016(
+	bool pseudo_candidates_,
+	std::size_t n_threads,
+	bool candidates_only_,
+	std::vector<Khalil2016Obs::Features> features,
+	bool incremental_,
+	std::chrono::microseconds time_budget_) :
+	pseudo_candidates(pseudo_candidates_),
+	candidates_only(candidates_only_),
+	incremental(incremental_),
+	time_budget(time_budget_) {
+	if (features.empty()) {
+		feature_indices.resize(Khalil2016Obs::n_features);
+		std::iota(feature_indices.begin(), feature_indices.end(), std::size_t{0});
+	} else {
+		std::transform(features.begin(), features.end(), std::back_inserter(feature_indices), [](auto feature) {
+			return idx(feature);
+		});
+	}
+	thread_pool = make_thread_pool(n_threads);
+	if (incremental) {
+		eventhdlr_name = LpRowsEventHandler::base_name + std::to_string(LpRowsEventHandler::counter++);
+	}
+}
 
-void Khalil2016::before_reset(scip::Model& /* model */) {
+void Khalil2016::before_reset(scip::Model& model) {
 	static_features = decltype(static_features){};
+	if (incremental) {
+		add_eventhdlr(model, eventhdlr_name);
+	}
 }
 
 auto Khalil2016::extract(scip::Model& model, bool /* done */) -> std::optional<Khalil2016Obs> {
 	if (model.stage() == SCIP_STAGE_SOLVING) {
+		auto deadline = std::optional<Clock::time_point>{};
+		if (time_budget > std::chrono::microseconds::zero()) {
+			deadline = Clock::now() + time_budget;
+		}
 		if (is_on_root_node(model)) {
 			static_features = extract_static_features(model);
 		}
-		return {{extract_all_features(model, pseudo_candidates, static_features)}};
+		// Without the handler, as when before_reset was not called on the model, features are computed from scratch
+		auto* const handler = incremental ? find_eventhdlr(model, eventhdlr_name) : nullptr;
+		return extract_all_features(
+			model,
+			pseudo_candidates,
+			candidates_only,
+			feature_indices,
+			static_features,
+			thread_pool.get(),
+			handler,
+			deadline);
 	}
 	return {};
 }
@@ -1,10 +1,18 @@
 #include <type_traits>
 
+#include <algorithm>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <future>
+#include <memory>
+#include <optional>
+#include <vector>
 #include <scip/scip.h>
 #include <scip/struct_lp.h>
 #include <xtensor/xadapt.hpp>
+#include <xtensor/xoperation.hpp>
 #include <xtensor/xnorm.hpp>
 #include <xtensor/xview.hpp>
 
@@ -12,6 +20,7 @@
 #include "ecole/observation/milp-bipartite.hpp"
 #include "ecole/scip/cons.hpp"
 #include "ecole/scip/model.hpp"
+#include "ecole/threads.hpp"
 #include "ecole/utility/unreachable.hpp"
 
 namespace ecole::observation {
@@ -22,12 +31,8 @@ namespace {
  *  Common helpers   *
  *********************/
 
-using xmatrix = decltype(MilpBipartiteObs::variable_features);
-using value_type = xmatrix::value_type;
-using coo_xmatrix = utility::coo_matrix<value_type>;
-
-using VariableFeatures = MilpBipartiteObs::VariableFeatures;
-using ConstraintFeatures = MilpBipartiteObs::ConstraintFeatures;
+using VariableFeatures = MilpBipartiteFeatures::VariableFeatures;
+using ConstraintFeatures = MilpBipartiteFeatures::ConstraintFeatures;
 
 /******************************************
  *  Variable extraction functions         *
@@ -56,35 +61,37 @@ template <typename E> constexpr auto idx(E e) {
 	return static_cast<std::underlying_type_t<E>>(e);
 }
 
+/** Write a feature computed by SCIP, converting it to the value type of the observation. */
+template <typename Features, typename E> void set_feature(Features& out, E feature, SCIP_Real value) {
+	out[idx(feature)] = static_cast<typename std::decay_t<Features>::value_type>(value);
+}
+
 template <typename Features>
 void set_static_features_for_var(
 	Features&& out,
 	SCIP* const scip,
 	SCIP_VAR* const var,
-	std::optional<value_type> obj_norm = {}) {
+	std::optional<SCIP_Real> obj_norm = {}) {
 	double const objsense = (SCIPgetObjsense(scip) == SCIP_OBJSENSE_MINIMIZE) ? 1. : -1.;
 
-	out[idx(VariableFeatures::objective)] = objsense * SCIPvarGetObj(var);
-	if (obj_norm.has_value()) {
-		out[idx(VariableFeatures::objective)] /= obj_norm.value();
-	}
+	set_feature(out, VariableFeatures::objective, objsense * SCIPvarGetObj(var) / obj_norm.value_or(1.));
 	// One-hot enconding of variable type
-	out[idx(VariableFeatures::is_type_binary)] = 0.;
-	out[idx(VariableFeatures::is_type_integer)] = 0.;
-	out[idx(VariableFeatures::is_type_implicit_integer)] = 0.;
-	out[idx(VariableFeatures::is_type_continuous)] = 0.;
+	set_feature(out, VariableFeatures::is_type_binary, 0.);
+	set_feature(out, VariableFeatures::is_type_integer, 0.);
+	set_feature(out, VariableFeatures::is_type_implicit_integer, 0.);
+	set_feature(out, VariableFeatures::is_type_continuous, 0.);
 	switch (SCIPvarGetType(var)) {
 	case SCIP_VARTYPE_BINARY:
-		out[idx(VariableFeatures::is_type_binary)] = 1.;
+		set_feature(out, VariableFeatures::is_type_binary, 1.);
 		break;
 	case SCIP_VARTYPE_INTEGER:
-		out[idx(VariableFeatures::is_type_integer)] = 1.;
+		set_feature(out, VariableFeatures::is_type_integer, 1.);
 		break;
 	case SCIP_VARTYPE_IMPLINT:
-		out[idx(VariableFeatures::is_type_implicit_integer)] = 1.;
+		set_feature(out, VariableFeatures::is_type_implicit_integer, 1.);
 		break;
 	case SCIP_VARTYPE_CONTINUOUS:
-		out[idx(VariableFeatures::is_type_continuous)] = 1.;
+		set_feature(out, VariableFeatures::is_type_continuous, 1.);
 		break;
 	default:
 		utility::unreachable();
@@ -92,24 +99,24 @@ void set_static_features_for_var(
 
 	auto const lower_bound = SCIPvarGetLbLocal(var);
 	if (SCIPisInfinity(scip, std::abs(lower_bound))) {
-		out[idx(VariableFeatures::has_lower_bound)] = 0.;
-		out[idx(VariableFeatures::lower_bound)] = 0.;
+		set_feature(out, VariableFeatures::has_lower_bound, 0.);
+		set_feature(out, VariableFeatures::lower_bound, 0.);
 	} else {
-		out[idx(VariableFeatures::has_lower_bound)] = 1.;
-		out[idx(VariableFeatures::lower_bound)] = lower_bound;
+		set_feature(out, VariableFeatures::has_lower_bound, 1.);
+		set_feature(out, VariableFeatures::lower_bound, lower_bound);
 	}
 
 	auto const upper_bound = SCIPvarGetUbLocal(var);
 	if (SCIPisInfinity(scip, std::abs(upper_bound))) {
-		out[idx(VariableFeatures::has_upper_bound)] = 0.;
-		out[idx(VariableFeatures::upper_bound)] = 0.;
+		set_feature(out, VariableFeatures::has_upper_bound, 0.);
+		set_feature(out, VariableFeatures::upper_bound, 0.);
 	} else {
-		out[idx(VariableFeatures::has_upper_bound)] = 1.;
-		out[idx(VariableFeatures::upper_bound)] = upper_bound;
+		set_feature(out, VariableFeatures::has_upper_bound, 1.);
+		set_feature(out, VariableFeatures::upper_bound, upper_bound);
 	}
 }
 
-void set_features_for_all_vars(xmatrix& out, scip::Model& model, bool normalize) {
+template <typename Matrix> void set_features_for_all_vars(Matrix& out, scip::Model& model, bool normalize) {
 	auto* const scip = model.get_scip_ptr();
 
 	// Contant reused in every iterations
@@ -128,26 +135,144 @@ template <typename T> auto vec_to_col(xt::xtensor<T, 1>&& t) -> xt::xtensor<T, 2
 	return xt::xtensor<T, 2>{std::move(t.storage()), {t.size(), 1}, {1, 0}};
 }
 
+/** Convert a tensor computed by SCIP to the value type of the observation, without copy for double precision. */
+template <typename Value, typename Tensor> auto as_value_type(Tensor&& t) {
+	if constexpr (std::is_same_v<typename std::decay_t<Tensor>::value_type, Value>) {
+		return std::forward<Tensor>(t);
+	} else {
+		return xt::xtensor<Value, std::decay_t<Tensor>::rank>{xt::cast<Value>(t)};
+	}
+}
+
+template <typename Value> auto as_value_type(utility::coo_matrix<SCIP_Real>&& coo) -> utility::coo_matrix<Value> {
+	return {as_value_type<Value>(std::move(coo.values)), std::move(coo.indices), coo.shape};
+}
+
 }  // namespace
 
 /*************************************
  *  Observation extracting function  *
  *************************************/
 
-auto MilpBipartite::extract(scip::Model& model, bool /* done */) const -> std::optional<MilpBipartiteObs> {
+template <typename Value>
+BasicMilpBipartite<Value>::BasicMilpBipartite(bool normalize_, std::size_t n_threads, bool csr_edges, bool csc_edges) :
+	normalize{normalize_}, use_csr_edges{csr_edges}, use_csc_edges{csc_edges} {
+	thread_pool = make_thread_pool(n_threads);
+}
+
+template <typename Value>
+auto BasicMilpBipartite<Value>::extract(scip::Model& model, bool /* done */) const -> std::optional<Observation> {
+	using xmatrix = decltype(Observation::variable_features);
+
 	if (model.stage() < SCIP_STAGE_SOLVING) {
-		auto [edge_features, constraint_features] = scip::get_all_constraints(model.get_scip_ptr(), normalize);
+		auto [edge_features, constraint_features] =
+			scip::get_all_constraints(model.get_scip_ptr(), normalize, false, thread_pool.get());
 
-		auto variable_features = xmatrix::from_shape({model.variables().size(), MilpBipartiteObs::n_variable_features});
+		auto variable_features = xmatrix::from_shape({model.variables().size(), Observation::n_variable_features});
 		set_features_for_all_vars(variable_features, model, normalize);
 
-		return MilpBipartiteObs{
-			std::move(variable_features),
-			vec_to_col(std::move(constraint_features)),
-			std::move(edge_features),
-		};
+		auto obs = Observation{};
+		obs.variable_features = std::move(variable_features);
+		obs.constraint_features = vec_to_col(as_value_type<Value>(std::move(constraint_features)));
+		auto edges = as_value_type<Value>(std::move(edge_features));
+		if (use_csc_edges) {
+			obs.edge_features_csc = edges.template to_csc<std::int32_t>(thread_pool.get());
+		}
+		if (use_csr_edges) {
+			obs.edge_features_csr = edges.template to_csr<std::int32_t>(thread_pool.get());
+		} else {
+			obs.edge_features = std::move(edges);
+		}
+		return obs;
 	}
 	return {};
 }
 
+template class BasicMilpBipartite<double>;
+template class BasicMilpBipartite<float>;
+
+template <typename Value>
+auto extract_milp_bipartite(scip::Model& model, bool presolve, bool normalize)
+	-> std::optional<BasicMilpBipartiteObs<Value>> {
+	auto const extract = [normalize](scip::Model& mdl) {
+		return BasicMilpBipartite<Value>{normalize}.extract(mdl, false);
+	};
+	if (!presolve) {
+		return extract(model);
+	}
+	auto copy = model.copy_orig();
+	copy.presolve();
+	return (copy.stage() == SCIP_STAGE_PRESOLVED) ? extract(copy) : std::nullopt;
+}
+
+template <typename Value>
+auto extract_milp_bipartite(std::filesystem::path const& filename, bool presolve, bool normalize)
+	-> std::optional<BasicMilpBipartiteObs<Value>> {
+	// Presolving needs the plugins to transform the problem, reading only the readers and constraint handlers
+	auto const profile = presolve ? scip::PluginProfile::branching : scip::PluginProfile::modeling;
+	auto model = scip::Model::from_file(filename, profile);
+	if (presolve) {
+		model.presolve();
+		if (model.stage() != SCIP_STAGE_PRESOLVED) {
+			return {};
+		}
+	}
+	return BasicMilpBipartite<Value>{normalize}.extract(model, false);
+}
+
+template <typename Value>
+auto extract_milp_bipartite(
+	std::vector<std::filesystem::path> const& filenames,
+	bool presolve,
+	bool normalize,
+	std::size_t n_threads) -> std::vector<std::optional<BasicMilpBipartiteObs<Value>>> {
+	auto const extract = [presolve, normalize](std::filesystem::path const& filename) {
+		return extract_milp_bipartite<Value>(filename, presolve, normalize);
+	};
+	auto observations = std::vector<std::optional<BasicMilpBipartiteObs<Value>>>{};
+	observations.reserve(filenames.size());
+
+	auto own_pool = std::optional<utility::ThreadPool>{};
+	auto shared_pool = std::shared_ptr<utility::ThreadPool>{};
+	utility::ThreadPool* pool = nullptr;
+	if (n_threads > 0) {
+		pool = &own_pool.emplace(std::min(n_threads, std::max(filenames.size(), std::size_t{1})));
+	} else if (!utility::ThreadPool::in_worker_thread()) {
+		shared_pool = shared_thread_pool();
+		pool = shared_pool.get();
+	}
+	// Files are read sequentially with a single thread, or when already running in a pool
+	if (pool == nullptr) {
+		for (auto const& filename : filenames) {
+			observations.push_back(extract(filename));
+		}
+		return observations;
+	}
+
+	auto futures = std::vector<std::future<std::optional<BasicMilpBipartiteObs<Value>>>>{};
+	futures.reserve(filenames.size());
+	for (auto const& filename : filenames) {
+		futures.push_back(pool->submit([&extract, &filename] { return extract(filename); }));
+	}
+	// All tasks are awaited before rethrowing since they reference the file names
+	for (auto& future : futures) {
+		future.wait();
+	}
+	for (auto& future : futures) {
+		observations.push_back(future.get());
+	}
+	return observations;
+}
+
+template auto extract_milp_bipartite<double>(scip::Model&, bool, bool) -> std::optional<MilpBipartiteObs>;
+template auto extract_milp_bipartite<float>(scip::Model&, bool, bool) -> std::optional<MilpBipartiteObsFloat32>;
+template auto extract_milp_bipartite<double>(std::filesystem::path const&, bool, bool)
+	-> std::optional<MilpBipartiteObs>;
+template auto extract_milp_bipartite<float>(std::filesystem::path const&, bool, bool)
+	-> std::optional<MilpBipartiteObsFloat32>;
+template auto extract_milp_bipartite<double>(std::vector<std::filesystem::path> const&, bool, bool, std::size_t)
+	-> std::vector<std::optional<MilpBipartiteObs>>;
+template auto extract_milp_bipartite<float>(std::vector<std::filesystem::path> const&, bool, bool, std::size_t)
+	-> std::vector<std::optional<MilpBipartiteObsFloat32>>;
+
 }  // namespace ecole::observation
@@ -1,16 +1,37 @@
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <cassert>
 #include <cmath>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <limits>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <tuple>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
+#include <objscip/objeventhdlr.h>
 #include <scip/scip.h>
 #include <scip/struct_lp.h>
+#include <scip/type_event.h>
+#include <xtensor/xadapt.hpp>
+#include <xtensor/xbuilder.hpp>
+#include <xtensor/xmath.hpp>
+#include <xtensor/xoperation.hpp>
+#include <xtensor/xtensor.hpp>
 #include <xtensor/xview.hpp>
 
 #include "ecole/observation/node-bipartite.hpp"
+#include "ecole/scip/lp-view.hpp"
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/row.hpp"
+#include "ecole/scip/utils.hpp"
 #include "ecole/utility/unreachable.hpp"
 
 namespace ecole::observation {
@@ -21,11 +42,11 @@ namespace {
  *  Common helpers   *
  *********************/
 
-using xmatrix = decltype(NodeBipartiteObs::variable_features);
-using value_type = xmatrix::value_type;
+/** Features are computed in the precision of SCIP, and converted when written in the observation. */
+using value_type = SCIP_Real;
 
-using VariableFeatures = NodeBipartiteObs::VariableFeatures;
-using RowFeatures = NodeBipartiteObs::RowFeatures;
+using VariableFeatures = NodeBipartiteFeatures::VariableFeatures;
+using RowFeatures = NodeBipartiteFeatures::RowFeatures;
 
 value_type constexpr cste = 5.;
 value_type constexpr nan = std::numeric_limits<value_type>::quiet_NaN();
@@ -39,36 +60,33 @@ SCIP_Real obj_l2_norm(SCIP* const scip) noexcept {
  *  Variable features extraction functions *
  *******************************************/
 
-std::optional<SCIP_Real> upper_bound(SCIP* const scip, SCIP_COL* const col) noexcept {
-	auto const ub_val = SCIPcolGetUb(col);
-	if (SCIPisInfinity(scip, std::abs(ub_val))) {
-		return {};
-	}
-	return ub_val;
-}
-
-std::optional<SCIP_Real> lower_bound(SCIP* const scip, SCIP_COL* const col) noexcept {
-	auto const lb_val = SCIPcolGetLb(col);
-	if (SCIPisInfinity(scip, std::abs(lb_val))) {
-		return {};
-	}
-	return lb_val;
-}
-
-bool is_prim_sol_at_lb(SCIP* const scip, SCIP_COL* const col) noexcept {
-	auto const lb_val = lower_bound(scip, col);
-	if (lb_val) {
-		return SCIPisEQ(scip, SCIPcolGetPrimsol(col), lb_val.value());
-	}
-	return false;
-}
+/** The LP data of a column, read from the LP view when the column is in the LP, and from SCIP otherwise. */
+struct ColumnLpData {
+	SCIP_Real lower_bound;
+	SCIP_Real upper_bound;
+	SCIP_Real primal_value;
+	SCIP_Real reduced_cost;
+	SCIP_BASESTAT basis_status;
+};
 
-bool is_prim_sol_at_ub(SCIP* const scip, SCIP_COL* const col) noexcept {
-	auto const ub_val = upper_bound(scip, col);
-	if (ub_val) {
-		return SCIPisEQ(scip, SCIPcolGetPrimsol(col), ub_val.value());
+ColumnLpData column_lp_data(SCIP* const scip, scip::LpView const& lp, SCIP_VAR* const var, SCIP_COL* const col) {
+	if (auto const pos = SCIPcolGetLPPos(col); pos >= 0) {
+		auto const j = static_cast<std::size_t>(pos);
+		return {
+			lp.column_lower_bounds[j],
+			lp.column_upper_bounds[j],
+			lp.column_primal_values[j],
+			lp.column_reduced_costs[j],
+			lp.column_basis_statuses[j],
+		};
 	}
-	return false;
+	return {
+		SCIPcolGetLb(col),
+		SCIPcolGetUb(col),
+		SCIPvarGetLPSol(var),
+		SCIPgetVarRedcost(scip, var),
+		SCIPcolGetBasisStatus(col),
+	};
 }
 
 std::optional<SCIP_Real> best_sol_val(SCIP* const scip, SCIP_VAR* const var) noexcept {
@@ -79,115 +97,151 @@ std::optional<SCIP_Real> best_sol_val(SCIP* const scip, SCIP_VAR* const var) noe
 	return {};
 }
 
-std::optional<SCIP_Real> avg_sol(SCIP* const scip, SCIP_VAR* const var) noexcept {
-	if (SCIPgetBestSol(scip) != nullptr) {
-		return SCIPvarGetAvgSol(var);
-	}
-	return {};
+/*
+ * Kernels computing a feature for all columns or rows at once, as branchless xtensor expressions on contiguous arrays,
+ * which xtensor vectorizes with xsimd.
+ */
+namespace kernel {
+
+/** Whether values are finite, with SCIP infinity. */
+template <typename E> auto is_finite(E const& x, SCIP_Real inf) {
+	return xt::abs(x) < inf;
 }
 
-std::optional<SCIP_Real> feas_frac(SCIP* const scip, SCIP_VAR* const var) noexcept {
-	if (SCIPvarGetType(var) == SCIP_VARTYPE_CONTINUOUS) {
-		return {};
-	}
-	return SCIPfeasFrac(scip, SCIPvarGetLPSol(var));
+/** Same as SCIPisEQ, which compares with an absolute tolerance. */
+template <typename E1, typename E2> auto is_eq(E1 const& x, E2 const& y, SCIP_Real eps) {
+	return xt::abs(x - y) <= eps;
+}
+
+/** Same as SCIPfeasFrac. */
+template <typename E> auto feas_frac(E const& x, SCIP_Real feastol) {
+	return x - xt::floor(x + feastol);
 }
 
+/** Ratio of the numerator by the denominator when positive (as in SCIPisPositive), and zero otherwise. */
+template <typename E1, typename E2> auto safe_ratio(E1 const& numerator, E2 const& denominator, SCIP_Real eps) {
+	return xt::where(denominator > eps, numerator / denominator, 0.);
+}
+
+}  // namespace kernel
+
 /** Convert an enum to its underlying index. */
 template <typename E> constexpr auto idx(E e) {
 	return static_cast<std::underlying_type_t<E>>(e);
 }
 
+/** Write a feature computed by SCIP, converting it to the value type of the observation. */
+template <typename Features, typename E> void set_feature(Features& out, E feature, value_type value) {
+	out[idx(feature)] = static_cast<typename std::decay_t<Features>::value_type>(value);
+}
+
 template <typename Features>
 void set_static_features_for_var(Features&& out, SCIP_VAR* const var, value_type obj_norm) {
-	out[idx(VariableFeatures::objective)] = SCIPvarGetObj(var) / obj_norm;
+	set_feature(out, VariableFeatures::objective, SCIPvarGetObj(var) / obj_norm);
 	// On-hot enconding of variable type
-	out[idx(VariableFeatures::is_type_binary)] = 0.;
-	out[idx(VariableFeatures::is_type_integer)] = 0.;
-	out[idx(VariableFeatures::is_type_implicit_integer)] = 0.;
-	out[idx(VariableFeatures::is_type_continuous)] = 0.;
+	set_feature(out, VariableFeatures::is_type_binary, 0.);
+	set_feature(out, VariableFeatures::is_type_integer, 0.);
+	set_feature(out, VariableFeatures::is_type_implicit_integer, 0.);
+	set_feature(out, VariableFeatures::is_type_continuous, 0.);
 
 	switch (SCIPvarGetType(var)) {
 	case SCIP_VARTYPE_BINARY:
-		out[idx(VariableFeatures::is_type_binary)] = 1.;
+		set_feature(out, VariableFeatures::is_type_binary, 1.);
 		break;
 	case SCIP_VARTYPE_INTEGER:
-		out[idx(VariableFeatures::is_type_integer)] = 1.;
+		set_feature(out, VariableFeatures::is_type_integer, 1.);
 		break;
 	case SCIP_VARTYPE_IMPLINT:
-		out[idx(VariableFeatures::is_type_implicit_integer)] = 1.;
+		set_feature(out, VariableFeatures::is_type_implicit_integer, 1.);
 		break;
 	case SCIP_VARTYPE_CONTINUOUS:
-		out[idx(VariableFeatures::is_type_continuous)] = 1.;
+		set_feature(out, VariableFeatures::is_type_continuous, 1.);
 		break;
 	default:
 		utility::unreachable();
 	}
 }
 
-template <typename Features>
-void set_dynamic_features_for_var(
-	Features&& out,
-	SCIP* const scip,
-	SCIP_VAR* const var,
-	SCIP_COL* const col,
-	value_type obj_norm,
-	value_type n_lps) {
-	out[idx(VariableFeatures::has_lower_bound)] = static_cast<value_type>(lower_bound(scip, col).has_value());
-	out[idx(VariableFeatures::has_upper_bound)] = static_cast<value_type>(upper_bound(scip, col).has_value());
-	out[idx(VariableFeatures::normed_reduced_cost)] = SCIPgetVarRedcost(scip, var) / obj_norm;
-	out[idx(VariableFeatures::solution_value)] = SCIPvarGetLPSol(var);
-	out[idx(VariableFeatures::solution_frac)] = feas_frac(scip, var).value_or(0.);
-	out[idx(VariableFeatures::is_solution_at_lower_bound)] = static_cast<value_type>(is_prim_sol_at_lb(scip, col));
-	out[idx(VariableFeatures::is_solution_at_upper_bound)] = static_cast<value_type>(is_prim_sol_at_ub(scip, col));
-	out[idx(VariableFeatures::scaled_age)] = static_cast<value_type>(SCIPcolGetAge(col)) / (n_lps + cste);
-	out[idx(VariableFeatures::incumbent_value)] = best_sol_val(scip, var).value_or(nan);
-	out[idx(VariableFeatures::average_incumbent_value)] = avg_sol(scip, var).value_or(nan);
-	// On-hot encoding
-	out[idx(VariableFeatures::is_basis_lower)] = 0.;
-	out[idx(VariableFeatures::is_basis_basic)] = 0.;
-	out[idx(VariableFeatures::is_basis_upper)] = 0.;
-	out[idx(VariableFeatures::is_basis_zero)] = 0.;
-	
-	switch (SCIPcolGetBasisStatus(col)) {
-	case SCIP_BASESTAT_LOWER:
-		out[idx(VariableFeatures::is_basis_lower)] = 1.;
-		break;
-	case SCIP_BASESTAT_BASIC:
-		out[idx(VariableFeatures::is_basis_basic)] = 1.;
-		break;
-	case SCIP_BASESTAT_UPPER:
-		out[idx(VariableFeatures::is_basis_upper)] = 1.;
-		break;
-	case SCIP_BASESTAT_ZERO:
-		out[idx(VariableFeatures::is_basis_zero)] = 1.;
-		break;
-	default:
-		utility::unreachable();
-	}
-
-	int i = SCIPvarGetProbindex(var);
-	SCIP_VAR* aux = SCIPgetOrigVars(scip)[i];
-	out[idx(VariableFeatures::index)] = SCIPvarGetProbindex(SCIPvarGetTransVar(aux));
+/** One hot encoding of the basis status. */
+template <typename Features> void set_basis_features_for_var(Features&& out, SCIP_BASESTAT status) noexcept {
+	set_feature(out, VariableFeatures::is_basis_lower, static_cast<value_type>(status == SCIP_BASESTAT_LOWER));
+	set_feature(out, VariableFeatures::is_basis_basic, static_cast<value_type>(status == SCIP_BASESTAT_BASIC));
+	set_feature(out, VariableFeatures::is_basis_upper, static_cast<value_type>(status == SCIP_BASESTAT_UPPER));
+	set_feature(out, VariableFeatures::is_basis_zero, static_cast<value_type>(status == SCIP_BASESTAT_ZERO));
 }
 
-void set_features_for_all_vars(xmatrix& out, scip::Model& model, bool const update_static) {
+/**
+ * Set the features of all variables.
+ *
+ * The LP data of the columns is first gathered in problem order, then the dynamic features are computed one at a time
+ * for all variables with the vectorized kernels, and finally written in the observation.
+ */
+template <typename Matrix> void set_features_for_all_vars(Matrix& out, scip::Model& model, bool const update_static) {
 	auto* const scip = model.get_scip_ptr();
 
 	// Contant reused in every iterations
 	auto const n_lps = static_cast<value_type>(SCIPgetNLPs(scip));
 	auto const obj_norm = obj_l2_norm(scip);
+	auto const inf = SCIPinfinity(scip);
+	auto const eps = SCIPepsilon(scip);
+	auto const lp = model.lp_view();
 
 	auto const variables = model.variables();
 	auto const n_vars = variables.size();
+	auto const shape = std::array<std::size_t, 1>{n_vars};
+	auto lower_bounds = xt::xtensor<SCIP_Real, 1>::from_shape(shape);
+	auto upper_bounds = xt::xtensor<SCIP_Real, 1>::from_shape(shape);
+	auto primal_values = xt::xtensor<SCIP_Real, 1>::from_shape(shape);
+	auto reduced_costs = xt::xtensor<SCIP_Real, 1>::from_shape(shape);
+	auto ages = xt::xtensor<SCIP_Real, 1>::from_shape(shape);
+	auto is_continuous = xt::xtensor<bool, 1>::from_shape(shape);
+	auto basis_statuses = std::vector<SCIP_BASESTAT>(n_vars);
 	for (std::size_t var_idx = 0; var_idx < n_vars; ++var_idx) {
 		auto* const var = variables[var_idx];
 		auto* const col = SCIPvarGetCol(var);
+		auto const col_data = column_lp_data(scip, *lp, var, col);
+		lower_bounds(var_idx) = col_data.lower_bound;
+		upper_bounds(var_idx) = col_data.upper_bound;
+		primal_values(var_idx) = col_data.primal_value;
+		reduced_costs(var_idx) = col_data.reduced_cost;
+		basis_statuses[var_idx] = col_data.basis_status;
+		ages(var_idx) = static_cast<SCIP_Real>(SCIPcolGetAge(col));
+		is_continuous(var_idx) = SCIPvarGetType(var) == SCIP_VARTYPE_CONTINUOUS;
+	}
+
+	xt::xtensor<bool, 1> const has_lower_bound = kernel::is_finite(lower_bounds, inf);
+	xt::xtensor<bool, 1> const has_upper_bound = kernel::is_finite(upper_bounds, inf);
+	xt::xtensor<SCIP_Real, 1> const normed_reduced_costs = reduced_costs / obj_norm;
+	xt::xtensor<SCIP_Real, 1> const solution_fracs =
+		xt::where(is_continuous, 0., kernel::feas_frac(primal_values, SCIPfeastol(scip)));
+	xt::xtensor<bool, 1> const is_at_lower_bound = has_lower_bound && kernel::is_eq(primal_values, lower_bounds, eps);
+	xt::xtensor<bool, 1> const is_at_upper_bound = has_upper_bound && kernel::is_eq(primal_values, upper_bounds, eps);
+	xt::xtensor<SCIP_Real, 1> const scaled_ages = ages / (n_lps + cste);
+
+	auto* const orig_vars = SCIPgetOrigVars(scip);
+	auto const has_incumbent = SCIPgetBestSol(scip) != nullptr;
+	for (std::size_t var_idx = 0; var_idx < n_vars; ++var_idx) {
+		auto* const var = variables[var_idx];
 		auto features = xt::row(out, static_cast<std::ptrdiff_t>(var_idx));
 		if (update_static) {
 			set_static_features_for_var(features, var, obj_norm);
 		}
-		set_dynamic_features_for_var(features, scip, var, col, obj_norm, n_lps);
+		set_feature(features, VariableFeatures::has_lower_bound, static_cast<value_type>(has_lower_bound(var_idx)));
+		set_feature(features, VariableFeatures::has_upper_bound, static_cast<value_type>(has_upper_bound(var_idx)));
+		set_feature(features, VariableFeatures::normed_reduced_cost, normed_reduced_costs(var_idx));
+		set_feature(features, VariableFeatures::solution_value, primal_values(var_idx));
+		set_feature(features, VariableFeatures::solution_frac, solution_fracs(var_idx));
+		set_feature(
+			features, VariableFeatures::is_solution_at_lower_bound, static_cast<value_type>(is_at_lower_bound(var_idx)));
+		set_feature(
+			features, VariableFeatures::is_solution_at_upper_bound, static_cast<value_type>(is_at_upper_bound(var_idx)));
+		set_feature(features, VariableFeatures::scaled_age, scaled_ages(var_idx));
+		set_feature(features, VariableFeatures::incumbent_value, best_sol_val(scip, var).value_or(nan));
+		set_feature(
+			features, VariableFeatures::average_incumbent_value, has_incumbent ? SCIPvarGetAvgSol(var) : nan);
+		set_basis_features_for_var(features, basis_statuses[var_idx]);
+		auto* const orig_var = orig_vars[SCIPvarGetProbindex(var)];
+		set_feature(features, VariableFeatures::index, SCIPvarGetProbindex(SCIPvarGetTransVar(orig_var)));
 	}
 }
 
@@ -224,68 +278,94 @@ std::size_t n_ineq_rows(scip::Model& model) {
 }
 
 template <typename Features>
-void set_static_features_for_lhs_row(Features&& out, SCIP* const scip, SCIP_ROW* const row, value_type row_norm) {
-	out[idx(RowFeatures::bias)] = -1. * scip::get_unshifted_lhs(scip, row).value() / row_norm;
-	out[idx(RowFeatures::objective_cosine_similarity)] = -1 * obj_cos_sim(scip, row);
-}
-
-template <typename Features>
-void set_static_features_for_rhs_row(Features&& out, SCIP* const scip, SCIP_ROW* const row, value_type row_norm) {
-	out[idx(RowFeatures::bias)] = scip::get_unshifted_rhs(scip, row).value() / row_norm;
-	out[idx(RowFeatures::objective_cosine_similarity)] = obj_cos_sim(scip, row);
-}
-
-template <typename Features>
-void set_dynamic_features_for_lhs_row(
+void set_static_features_for_lhs_row(
 	Features&& out,
 	SCIP* const scip,
 	SCIP_ROW* const row,
 	value_type row_norm,
-	value_type obj_norm,
-	value_type n_lps) {
-	out[idx(RowFeatures::is_tight)] = static_cast<value_type>(scip::is_at_lhs(scip, row));
-	out[idx(RowFeatures::dual_solution_value)] = -1. * SCIProwGetDualsol(row) / (row_norm * obj_norm);
-	out[idx(RowFeatures::scaled_age)] = static_cast<value_type>(SCIProwGetAge(row)) / (n_lps + cste);
+	value_type cos_sim) {
+	set_feature(out, RowFeatures::bias, -1. * scip::get_unshifted_lhs(scip, row).value() / row_norm);
+	set_feature(out, RowFeatures::objective_cosine_similarity, -1 * cos_sim);
 }
 
 template <typename Features>
-void set_dynamic_features_for_rhs_row(
+void set_static_features_for_rhs_row(
 	Features&& out,
 	SCIP* const scip,
 	SCIP_ROW* const row,
 	value_type row_norm,
-	value_type obj_norm,
-	value_type n_lps) {
-	out[idx(RowFeatures::is_tight)] = static_cast<value_type>(scip::is_at_rhs(scip, row));
-	out[idx(RowFeatures::dual_solution_value)] = SCIProwGetDualsol(row) / (row_norm * obj_norm);
-	out[idx(RowFeatures::scaled_age)] = static_cast<value_type>(SCIProwGetAge(row)) / (n_lps + cste);
+	value_type cos_sim) {
+	set_feature(out, RowFeatures::bias, scip::get_unshifted_rhs(scip, row).value() / row_norm);
+	set_feature(out, RowFeatures::objective_cosine_similarity, cos_sim);
+}
+
+template <typename Features>
+void set_dynamic_features_for_row(Features&& out, bool is_tight, value_type dual_value, value_type scaled_age) {
+	set_feature(out, RowFeatures::is_tight, static_cast<value_type>(is_tight));
+	set_feature(out, RowFeatures::dual_solution_value, dual_value);
+	set_feature(out, RowFeatures::scaled_age, scaled_age);
 }
 
-auto set_features_for_all_rows(xmatrix& out, scip::Model& model, bool const update_static) {
+/**
+ * Set the features of all rows.
+ *
+ * As for variables, the features of every LP row are computed at once by the vectorized kernels, reading the LP view
+ * without copy, before being written on the one or two observation rows of each LP row.
+ */
+template <typename Matrix> void set_features_for_all_rows(Matrix& out, scip::Model& model, bool const update_static) {
 	auto* const scip = model.get_scip_ptr();
 
 	auto const n_lps = static_cast<value_type>(SCIPgetNLPs(scip));
 	value_type const obj_norm = obj_l2_norm(scip);
+	auto const eps = SCIPepsilon(scip);
+	auto const lp = model.lp_view();
+
+	auto const n_rows = lp->n_rows();
+	auto const shape = std::array<std::size_t, 1>{n_rows};
+	auto const adapt = [n_rows, &shape](std::vector<SCIP_Real> const& vec) {
+		return xt::adapt(vec.data(), n_rows, xt::no_ownership(), shape);
+	};
+	auto norms = xt::xtensor<SCIP_Real, 1>::from_shape(shape);
+	auto ages = xt::xtensor<SCIP_Real, 1>::from_shape(shape);
+	auto obj_prods = xt::xtensor<SCIP_Real, 1>::from_shape(shape);
+	for (std::size_t row_idx = 0; row_idx < n_rows; ++row_idx) {
+		auto* const row = lp->rows[row_idx];
+		norms(row_idx) = SCIProwGetNorm(row);
+		ages(row_idx) = static_cast<SCIP_Real>(SCIProwGetAge(row));
+		obj_prods(row_idx) = row->objprod;
+	}
+
+	auto const activities = adapt(lp->row_activities);
+	xt::xtensor<bool, 1> const is_tight_lhs = kernel::is_eq(activities, adapt(lp->row_lhs), eps);
+	xt::xtensor<bool, 1> const is_tight_rhs = kernel::is_eq(activities, adapt(lp->row_rhs), eps);
+	xt::xtensor<SCIP_Real, 1> const row_norms = xt::where(norms > 0., norms, 1.);
+	xt::xtensor<SCIP_Real, 1> const normed_duals = adapt(lp->row_dual_values) / (row_norms * obj_norm);
+	xt::xtensor<SCIP_Real, 1> const scaled_ages = ages / (n_lps + cste);
+	auto cos_sims = xt::xtensor<SCIP_Real, 1>{};
+	if (update_static) {
+		cos_sims = kernel::safe_ratio(obj_prods, norms * SCIPgetObjNorm(scip), eps);
+	}
 
 	auto feat_row_idx = std::size_t{0};
-	for (auto* const row : model.lp_rows()) {
-		auto const row_norm = static_cast<value_type>(row_l2_norm(row));
+	for (std::size_t row_idx = 0; row_idx < n_rows; ++row_idx) {
+		auto* const row = lp->rows[row_idx];
 
 		// Rows are counted once per rhs and once per lhs
 		if (scip::get_unshifted_lhs(scip, row).has_value()) {
 			auto features = xt::row(out, static_cast<std::ptrdiff_t>(feat_row_idx));
 			if (update_static) {
-				set_static_features_for_lhs_row(features, scip, row, row_norm);
+				set_static_features_for_lhs_row(features, scip, row, row_norms(row_idx), cos_sims(row_idx));
 			}
-			set_dynamic_features_for_lhs_row(features, scip, row, row_norm, obj_norm, n_lps);
+			set_dynamic_features_for_row(
+				features, is_tight_lhs(row_idx), -1. * normed_duals(row_idx), scaled_ages(row_idx));
 			feat_row_idx++;
 		}
 		if (scip::get_unshifted_rhs(scip, row).has_value()) {
 			auto features = xt::row(out, static_cast<std::ptrdiff_t>(feat_row_idx));
 			if (update_static) {
-				set_static_features_for_rhs_row(features, scip, row, row_norm);
+				set_static_features_for_rhs_row(features, scip, row, row_norms(row_idx), cos_sims(row_idx));
 			}
-			set_dynamic_features_for_rhs_row(features, scip, row, row_norm, obj_norm, n_lps);
+			set_dynamic_features_for_row(features, is_tight_rhs(row_idx), normed_duals(row_idx), scaled_ages(row_idx));
 			feat_row_idx++;
 		}
 	}
@@ -316,13 +396,28 @@ auto matrix_nnz(scip::Model& model) {
 	return nnz;
 }
 
-utility::coo_matrix<value_type> extract_edge_features(scip::Model& model) {
+/** Resize a tensor, which only reallocates its memory when its number of elements changes. */
+template <typename Tensor, typename... Dims> void resize(Tensor& tensor, Dims... dims) {
+	tensor.resize(typename Tensor::shape_type{static_cast<std::size_t>(dims)...});
+}
+
+/** Check that the CSR index type can represent the number of non zero elements. */
+template <typename Index> void check_csr_index_size(std::size_t nnz) {
+	if (nnz > static_cast<std::size_t>(std::numeric_limits<Index>::max())) {
+		throw std::overflow_error{"Too many edges to be indexed in the CSR format."};
+	}
+}
+
+/** Fill the edges in the coordinate format, reusing the memory of the given matrix. */
+template <typename Coo> void fill_coo_edge_features(scip::Model& model, Coo& out) {
+	using out_value_type = typename Coo::value_type;
 	auto* const scip = model.get_scip_ptr();
 
-	using coo_matrix = utility::coo_matrix<value_type>;
 	auto const nnz = matrix_nnz(model);
-	auto values = decltype(coo_matrix::values)::from_shape({nnz});
-	auto indices = decltype(coo_matrix::indices)::from_shape({2, nnz});
+	resize(out.values, nnz);
+	resize(out.indices, 2, nnz);
+	auto& values = out.values;
+	auto& indices = out.indices;
 
 	std::size_t i = 0;
 	std::size_t j = 0;
@@ -335,7 +430,7 @@ utility::coo_matrix<value_type> extract_edge_features(scip::Model& model) {
 			for (std::size_t k = 0; k < row_nnz; ++k) {
 				indices(0, j + k) = i;
 				indices(1, j + k) = static_cast<std::size_t>(SCIPcolGetVarProbindex(row_cols[k]));
-				values[j + k] = -row_vals[k] / row_norm;
+				values[j + k] = static_cast<out_value_type>(-row_vals[k] / row_norm);
 			}
 			j += row_nnz;
 			i++;
@@ -344,7 +439,7 @@ utility::coo_matrix<value_type> extract_edge_features(scip::Model& model) {
 			for (std::size_t k = 0; k < row_nnz; ++k) {
 				indices(0, j + k) = i;
 				indices(1, j + k) = static_cast<std::size_t>(SCIPcolGetVarProbindex(row_cols[k]));
-				values[j + k] = row_vals[k] / row_norm;
+				values[j + k] = static_cast<out_value_type>(row_vals[k] / row_norm);
 			}
 			j += row_nnz;
 			i++;
@@ -354,30 +449,384 @@ utility::coo_matrix<value_type> extract_edge_features(scip::Model& model) {
 	auto const n_rows = n_ineq_rows(model);
 	// Change this here for variables
 	auto const n_vars = static_cast<std::size_t>(SCIPgetNVars(scip));
-	return {values, indices, {n_rows, n_vars}};
+	out.shape = {n_rows, n_vars};
 }
 
-auto is_on_root_node(scip::Model& model) -> bool {
+/** Fill the edges in the CSR format, reusing the memory of the given matrix. */
+template <typename Csr> void fill_csr_edge_features(scip::Model& model, Csr& out) {
+	using out_value_type = typename Csr::value_type;
+	using index_type = typename Csr::index_type;
 	auto* const scip = model.get_scip_ptr();
-	return SCIPgetCurrentNode(scip) == SCIPgetRootNode(scip);
+
+	auto const n_rows = n_ineq_rows(model);
+	auto const nnz = matrix_nnz(model);
+	check_csr_index_size<index_type>(nnz);
+	resize(out.values, nnz);
+	resize(out.column_indices, nnz);
+	resize(out.row_pointers, n_rows + 1);
+
+	std::size_t i = 0;
+	std::size_t j = 0;
+	out.row_pointers(0) = 0;
+	auto const add_side = [&](SCIP_ROW* const row, value_type sign, value_type row_norm) {
+		auto* const row_cols = SCIProwGetCols(row);
+		auto const* const row_vals = SCIProwGetVals(row);
+		auto const row_nnz = static_cast<std::size_t>(SCIProwGetNLPNonz(row));
+		for (std::size_t k = 0; k < row_nnz; ++k) {
+			out.column_indices(j + k) = static_cast<index_type>(SCIPcolGetVarProbindex(row_cols[k]));
+			out.values(j + k) = static_cast<out_value_type>(sign * row_vals[k] / row_norm);
+		}
+		j += row_nnz;
+		i++;
+		out.row_pointers(i) = static_cast<index_type>(j);
+	};
+	for (auto* const row : model.lp_rows()) {
+		auto const row_norm = static_cast<value_type>(row_l2_norm(row));
+		// Rows are counted once per rhs and once per lhs
+		if (scip::get_unshifted_lhs(scip, row).has_value()) {
+			add_side(row, -1., row_norm);
+		}
+		if (scip::get_unshifted_rhs(scip, row).has_value()) {
+			add_side(row, 1., row_norm);
+		}
+	}
+	assert(i == n_rows);
+	out.shape = {n_rows, static_cast<std::size_t>(SCIPgetNVars(scip))};
+}
+
+/************************************************
+ *  Incremental extraction using LP row events  *
+ ***********************************************/
+
+using StaticRowFeatures = std::array<value_type, NodeBipartiteFeatures::n_static_row_features>;
+
+/** Static features and edges of a single LP row, before duplication for left and right hand sides. */
+struct RowBlock {
+	std::optional<StaticRowFeatures> lhs_features;
+	std::optional<StaticRowFeatures> rhs_features;
+	std::vector<std::size_t> cols;
+	/** Coefficients divided by the row norm, as used for the right hand side. */
+	std::vector<value_type> vals;
+
+	[[nodiscard]] auto n_sides() const noexcept -> std::size_t {
+		return static_cast<std::size_t>(lhs_features.has_value()) + static_cast<std::size_t>(rhs_features.has_value());
+	}
+};
+
+auto make_row_block(SCIP* const scip, SCIP_ROW* const row) -> RowBlock {
+	auto block = RowBlock{};
+	auto const row_norm = static_cast<value_type>(row_l2_norm(row));
+	auto const cos_sim = obj_cos_sim(scip, row);
+	if (scip::get_unshifted_lhs(scip, row).has_value()) {
+		set_static_features_for_lhs_row(block.lhs_features.emplace(), scip, row, row_norm, cos_sim);
+	}
+	if (scip::get_unshifted_rhs(scip, row).has_value()) {
+		set_static_features_for_rhs_row(block.rhs_features.emplace(), scip, row, row_norm, cos_sim);
+	}
+	auto* const row_cols = SCIProwGetCols(row);
+	auto const* const row_vals = SCIProwGetVals(row);
+	auto const row_nnz = static_cast<std::size_t>(SCIProwGetNLPNonz(row));
+	block.cols.resize(row_nnz);
+	block.vals.resize(row_nnz);
+	for (std::size_t k = 0; k < row_nnz; ++k) {
+		block.cols[k] = static_cast<std::size_t>(SCIPcolGetVarProbindex(row_cols[k]));
+		block.vals[k] = row_vals[k] / row_norm;
+	}
+	return block;
+}
+
+/**
+ * Event handler keeping the static features of LP rows up to date.
+ *
+ * Rows are added and removed from the LP during solving (cuts, aging), and their sides or coefficients may change.
+ * The handler drops the cached features of any row involved in such events, so that they are recomputed on the next
+ * extraction, while the features of other rows are reused.
+ */
+class LpRowsEventHandler : public ::scip::ObjEventhdlr {
+public:
+	inline static auto constexpr base_name = "ecole::observation::NodeBipartite::LpRowsEventHandler";
+	inline static auto counter = std::atomic<unsigned long>{0};
+
+	LpRowsEventHandler(SCIP* scip, char const* name) :
+		ObjEventhdlr(scip, name, "Event handler tracking changes in the LP rows") {}
+
+	/** Catch LP row additions and deletions. */
+	auto scip_initsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE override {
+		return SCIPcatchEvent(scip, lp_events, eventhdlr, nullptr, nullptr);
+	}
+
+	/** Drop LP row additions and deletions. */
+	auto scip_exitsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE override {
+		return SCIPdropEvent(scip, lp_events, eventhdlr, nullptr, -1);
+	}
+
+	/** Invalidate the row features, and track modifications of rows while they are in the LP. */
+	auto scip_exec(SCIP* scip, SCIP_EVENTHDLR* eventhdlr, SCIP_EVENT* event, SCIP_EVENTDATA* /*eventdata*/)
+		-> SCIP_RETCODE override {
+		auto* const row = SCIPeventGetRow(event);
+		m_blocks.erase(row);
+		m_lp_changed = true;
+		switch (SCIPeventGetType(event)) {
+		case SCIP_EVENTTYPE_ROWADDEDLP:
+			return SCIPcatchRowEvent(scip, row, SCIP_EVENTTYPE_ROWCHANGED, eventhdlr, nullptr, nullptr);
+		case SCIP_EVENTTYPE_ROWDELETEDLP:
+			return SCIPdropRowEvent(scip, row, SCIP_EVENTTYPE_ROWCHANGED, eventhdlr, nullptr, -1);
+		default:
+			return SCIP_OKAY;
+		}
+	}
+
+	/** Whether any LP row changed since the last call to update. */
+	[[nodiscard]] auto lp_changed() const noexcept -> bool { return m_lp_changed; }
+
+	/** Return the features of every LP row in order, only recomputing those of rows that changed. */
+	auto update(scip::Model& model) -> std::vector<RowBlock const*> {
+		auto* const scip = model.get_scip_ptr();
+		auto const rows = model.lp_rows();
+		auto blocks = std::vector<RowBlock const*>{};
+		blocks.reserve(rows.size());
+		for (auto* const row : rows) {
+			auto [iter, inserted] = m_blocks.try_emplace(row);
+			if (inserted) {
+				iter->second = make_row_block(scip, row);
+			}
+			// References to unordered_map elements are stable upon insertion
+			blocks.push_back(&iter->second);
+		}
+		m_lp_changed = false;
+		return blocks;
+	}
+
+private:
+	static inline auto constexpr lp_events = SCIP_EVENTTYPE_ROWADDEDLP | SCIP_EVENTTYPE_ROWDELETEDLP;
+
+	std::unordered_map<SCIP_ROW*, RowBlock> m_blocks;
+	bool m_lp_changed = true;
+};
+
+auto get_eventhdlr(scip::Model& model, std::string const& name) -> LpRowsEventHandler& {
+	auto* const base_handler = SCIPfindObjEventhdlr(model.get_scip_ptr(), name.c_str());
+	assert(base_handler != nullptr);
+	auto* const handler = dynamic_cast<LpRowsEventHandler*>(base_handler);
+	assert(handler != nullptr);
+	return *handler;
+}
+
+void add_eventhdlr(scip::Model& model, std::string const& name) {
+	auto handler = std::make_unique<LpRowsEventHandler>(model.get_scip_ptr(), name.c_str());
+	scip::call(SCIPincludeObjEventhdlr, model.get_scip_ptr(), handler.get(), true);
+	// NOLINTNEXTLINE memory ownership is passed to SCIP
+	handler.release();
 }
 
-auto extract_observation_fully(scip::Model& model) -> NodeBipartiteObs {
-	auto obs = NodeBipartiteObs{
-		// Change this here for variables
-		xmatrix::from_shape({model.variables().size(), NodeBipartiteObs::n_variable_features}),
-		xmatrix::from_shape({n_ineq_rows(model), NodeBipartiteObs::n_row_features}),
-		extract_edge_features(model),
+/** Features of a row cached by row index, with the data used to detect rows modified in place. */
+struct CachedRow {
+	RowBlock block;
+	SCIP_Real lhs;
+	SCIP_Real rhs;
+	SCIP_Real constant;
+	int n_lp_nonzeros;
+	std::uint64_t last_seen;
+};
+
+auto make_cached_row(SCIP* const scip, SCIP_ROW* const row) -> CachedRow {
+	return {
+		make_row_block(scip, row),
+		SCIProwGetLhs(row),
+		SCIProwGetRhs(row),
+		SCIProwGetConstant(row),
+		SCIProwGetNLPNonz(row),
+		0,
 	};
+}
+
+auto is_up_to_date(CachedRow const& cached, SCIP_ROW* const row) noexcept -> bool {
+	return (cached.lhs == SCIProwGetLhs(row)) && (cached.rhs == SCIProwGetRhs(row)) &&
+		   (cached.constant == SCIProwGetConstant(row)) && (cached.n_lp_nonzeros == SCIProwGetNLPNonz(row));
+}
+
+/** Fill the static row features and the edges from the features of every LP row. */
+template <typename Obs>
+void assemble_rows_and_edges(
+	std::vector<RowBlock const*> const& blocks,
+	std::size_t n_vars,
+	Obs& obs,
+	bool const csr_edges) {
+	using out_value_type = typename Obs::value_type;
+	using index_type = typename decltype(Obs::edge_features_csr)::index_type;
+
+	auto n_rows = std::size_t{0};
+	auto nnz = std::size_t{0};
+	for (auto const* const block : blocks) {
+		n_rows += block->n_sides();
+		nnz += block->n_sides() * block->cols.size();
+	}
+
+	resize(obs.row_features, n_rows, NodeBipartiteFeatures::n_row_features);
+	auto& coo = obs.edge_features;
+	auto& csr = obs.edge_features_csr;
+	if (csr_edges) {
+		check_csr_index_size<index_type>(nnz);
+		resize(csr.values, nnz);
+		resize(csr.column_indices, nnz);
+		resize(csr.row_pointers, n_rows + 1);
+		csr.row_pointers(0) = 0;
+		csr.shape = {n_rows, n_vars};
+	} else {
+		resize(coo.values, nnz);
+		resize(coo.indices, 2, nnz);
+		coo.shape = {n_rows, n_vars};
+	}
+
+	std::size_t i = 0;
+	std::size_t j = 0;
+	auto const add_side = [&](StaticRowFeatures const& features, RowBlock const& block, value_type sign) {
+		std::copy(features.begin(), features.end(), xt::row(obs.row_features, static_cast<std::ptrdiff_t>(i)).begin());
+		for (std::size_t k = 0; k < block.cols.size(); ++k) {
+			if (csr_edges) {
+				csr.column_indices(j + k) = static_cast<index_type>(block.cols[k]);
+				csr.values(j + k) = static_cast<out_value_type>(sign * block.vals[k]);
+			} else {
+				coo.indices(0, j + k) = i;
+				coo.indices(1, j + k) = block.cols[k];
+				coo.values(j + k) = static_cast<out_value_type>(sign * block.vals[k]);
+			}
+		}
+		j += block.cols.size();
+		i++;
+		if (csr_edges) {
+			csr.row_pointers(i) = static_cast<index_type>(j);
+		}
+	};
+	for (auto const* const block : blocks) {
+		// Rows are counted once per rhs and once per lhs
+		if (block->lhs_features.has_value()) {
+			add_side(block->lhs_features.value(), *block, -1.);
+		}
+		if (block->rhs_features.has_value()) {
+			add_side(block->rhs_features.value(), *block, 1.);
+		}
+	}
+	assert(i == n_rows);
+	assert(j == nnz);
+}
+
+/** Update the observation in place, recomputing static features only for what changed since the last call. */
+template <typename Obs>
+void extract_observation_incrementally(
+	scip::Model& model,
+	LpRowsEventHandler& handler,
+	Obs& obs,
+	bool const cache_computed,
+	bool const csr_edges) {
+	if (!cache_computed) {
+		resize(obs.variable_features, model.variables().size(), NodeBipartiteFeatures::n_variable_features);
+	}
+	// Static variable features do not change during solving
+	set_features_for_all_vars(obs.variable_features, model, !cache_computed);
+
+	if (!cache_computed || handler.lp_changed()) {
+		auto const n_vars = static_cast<std::size_t>(SCIPgetNVars(model.get_scip_ptr()));
+		assemble_rows_and_edges(handler.update(model), n_vars, obs, csr_edges);
+	}
+	set_features_for_all_rows(obs.row_features, model, false);
+}
+
+/** Update the observation in place, with static row features cached by row index. */
+template <typename RowCache, typename Obs>
+void extract_observation_with_row_cache(
+	scip::Model& model,
+	RowCache& row_cache,
+	Obs& obs,
+	bool const cache_computed,
+	bool const csr_edges) {
+	if (!cache_computed) {
+		resize(obs.variable_features, model.variables().size(), NodeBipartiteFeatures::n_variable_features);
+	}
+	// Static variable features do not change during solving
+	set_features_for_all_vars(obs.variable_features, model, !cache_computed);
+
+	auto const n_vars = static_cast<std::size_t>(SCIPgetNVars(model.get_scip_ptr()));
+	assemble_rows_and_edges(row_cache.update(model), n_vars, obs, csr_edges);
+	set_features_for_all_rows(obs.row_features, model, false);
+}
+
+template <typename Obs> void fill_observation_fully(scip::Model& model, Obs& obs, bool const csr_edges) {
+	// Change this here for variables
+	resize(obs.variable_features, model.variables().size(), NodeBipartiteFeatures::n_variable_features);
+	resize(obs.row_features, n_ineq_rows(model), NodeBipartiteFeatures::n_row_features);
+	if (csr_edges) {
+		fill_csr_edge_features(model, obs.edge_features_csr);
+	} else {
+		fill_coo_edge_features(model, obs.edge_features);
+	}
 	set_features_for_all_vars(obs.variable_features, model, true);
 	set_features_for_all_rows(obs.row_features, model, true);
-	return obs;
 }
 
-auto extract_observation_from_cache(scip::Model& model, NodeBipartiteObs obs) -> NodeBipartiteObs {
-	set_features_for_all_vars(obs.variable_features, model, false);
-	set_features_for_all_rows(obs.row_features, model, false);
-	return obs;
+/** The indices of the elements set in a mask. */
+auto mask_indices(std::vector<bool> const& mask) -> std::vector<std::size_t> {
+	auto indices = std::vector<std::size_t>{};
+	for (std::size_t i = 0; i < mask.size(); ++i) {
+		if (mask[i]) {
+			indices.push_back(i);
+		}
+	}
+	return indices;
+}
+
+/** Restrict the observation to the subgraph induced by the LP branching candidates and their neighbours. */
+template <typename Obs>
+void restrict_to_candidates(scip::Model& model, Obs& obs, std::size_t const n_hops, bool const csr_edges) {
+	auto const for_each_edge = [&obs, csr_edges](auto&& func) {
+		if (csr_edges) {
+			auto const& csr = obs.edge_features_csr;
+			for (std::size_t i = 0; i < csr.shape[0]; ++i) {
+				auto const end = static_cast<std::size_t>(csr.row_pointers(i + 1));
+				for (auto k = static_cast<std::size_t>(csr.row_pointers(i)); k < end; ++k) {
+					func(i, static_cast<std::size_t>(csr.column_indices(k)));
+				}
+			}
+		} else {
+			auto const& coo = obs.edge_features;
+			for (std::size_t k = 0; k < coo.nnz(); ++k) {
+				func(coo.indices(0, k), coo.indices(1, k));
+			}
+		}
+	};
+
+	auto is_var_kept = std::vector<bool>(obs.variable_features.shape(0), false);
+	for (auto* const var : model.lp_branch_cands()) {
+		is_var_kept[static_cast<std::size_t>(SCIPvarGetProbindex(var))] = true;
+	}
+	auto is_row_kept = std::vector<bool>(obs.row_features.shape(0), false);
+	for_each_edge([&](std::size_t row, std::size_t var) {
+		if (is_var_kept[var]) {
+			is_row_kept[row] = true;
+		}
+	});
+	if (n_hops > 1) {
+		for_each_edge([&](std::size_t row, std::size_t var) {
+			if (is_row_kept[row]) {
+				is_var_kept[var] = true;
+			}
+		});
+	}
+
+	auto const var_ids = mask_indices(is_var_kept);
+	auto const row_ids = mask_indices(is_row_kept);
+	// Views are evaluated in new tensors since they alias the features they are assigned to
+	auto variable_features = decltype(obs.variable_features)(xt::view(obs.variable_features, xt::keep(var_ids)));
+	auto row_features = decltype(obs.row_features)(xt::view(obs.row_features, xt::keep(row_ids)));
+	obs.variable_features = std::move(variable_features);
+	obs.row_features = std::move(row_features);
+	if (csr_edges) {
+		obs.edge_features_csr = obs.edge_features_csr.select_rows(row_ids).select_cols(var_ids);
+	} else {
+		obs.edge_features = obs.edge_features.select_rows(row_ids).select_cols(var_ids);
+	}
+	obs.variable_ids = xt::adapt(var_ids, {var_ids.size()});
+	obs.row_ids = xt::adapt(row_ids, {row_ids.size()});
 }
 
 }  // namespace
@@ -386,25 +835,522 @@ auto extract_observation_from_cache(scip::Model& model, NodeBipartiteObs obs) ->
  *  Observation extracting function  *
  *************************************/
 
-auto NodeBipartite::before_reset(scip::Model& /* model */) -> void {
+/**
+ * Static features and edges of LP rows, by SCIP row index.
+ *
+ * Row indices are unique within a run and never reused, so that rows leaving the LP and entering it back, such as cuts
+ * from the pool, keep their features.
+ */
+template <typename Value> struct BasicNodeBipartite<Value>::RowCache {
+	std::unordered_map<int, CachedRow> rows;
+	std::uint64_t n_updates = 0;
+
+	/** Return the features of every LP row in order, only computing those of new or modified rows. */
+	auto update(scip::Model& model) -> std::vector<RowBlock const*> {
+		auto* const scip = model.get_scip_ptr();
+		auto const lp_rows = model.lp_rows();
+		++n_updates;
+		auto blocks = std::vector<RowBlock const*>{};
+		blocks.reserve(lp_rows.size());
+		for (auto* const row : lp_rows) {
+			auto [iter, inserted] = rows.try_emplace(SCIProwGetIndex(row));
+			if (inserted || !is_up_to_date(iter->second, row)) {
+				iter->second = make_cached_row(scip, row);
+			}
+			iter->second.last_seen = n_updates;
+			// References to unordered_map elements are stable upon insertion and erasure of other elements
+			blocks.push_back(&iter->second.block);
+		}
+		// Rows out of the LP are only forgotten once they outnumber the LP rows, to keep those likely to come back
+		if (rows.size() > 2 * lp_rows.size()) {
+			for (auto iter = rows.begin(); iter != rows.end();) {
+				iter = (iter->second.last_seen == n_updates) ? std::next(iter) : rows.erase(iter);
+			}
+		}
+		return blocks;
+	}
+};
+
+template <typename Value>
+BasicNodeBipartite<Value>::BasicNodeBipartite(
+	bool cache,
+	bool incremental,
+	bool csr_edges,
+	std::size_t candidate_hops,
+	bool csc_edges) :
+	use_cache{cache},
+	use_incremental{incremental},
+	use_csr_edges{csr_edges},
+	use_csc_edges{csc_edges},
+	n_candidate_hops{candidate_hops} {
+	if (n_candidate_hops > 2) {
+		throw std::invalid_argument{"NodeBipartite subgraphs span at most two hops around the candidates."};
+	}
+	if (use_cache) {
+		row_cache = std::make_shared<RowCache>();
+	}
+	if (use_incremental) {
+		eventhdlr_name = LpRowsEventHandler::base_name + std::to_string(LpRowsEventHandler::counter++);
+	}
+}
+
+template <typename Value> auto BasicNodeBipartite<Value>::before_reset(scip::Model& model) -> void {
 	cache_computed = false;
+	if (use_cache) {
+		row_cache = std::make_shared<RowCache>();
+	}
+	if (use_incremental) {
+		add_eventhdlr(model, eventhdlr_name);
+	}
+}
+
+template <typename Value>
+auto BasicNodeBipartite<Value>::extract(scip::Model& model, bool done) -> std::optional<Observation> {
+	auto obs = Observation{};
+	if (extract_into(model, done, obs)) {
+		return obs;
+	}
+	return {};
+}
+
+template <typename Value>
+auto BasicNodeBipartite<Value>::extract_into(scip::Model& model, bool /* done */, Observation& obs) -> bool {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		return false;
+	}
+	if (use_incremental) {
+		auto& handler = get_eventhdlr(model, eventhdlr_name);
+		extract_observation_incrementally(model, handler, the_cache, cache_computed, use_csr_edges);
+		cache_computed = true;
+		obs = the_cache;
+	} else if (use_cache) {
+		extract_observation_with_row_cache(model, *row_cache, the_cache, cache_computed, use_csr_edges);
+		cache_computed = true;
+		obs = the_cache;
+	} else {
+		fill_observation_fully(model, obs, use_csr_edges);
+	}
+	if (n_candidate_hops > 0) {
+		restrict_to_candidates(model, obs, n_candidate_hops, use_csr_edges);
+	}
+	if (use_csc_edges) {
+		// Both conversions are a counting sort of the edges by variable
+		if (use_csr_edges) {
+			obs.edge_features_csc = obs.edge_features_csr.transpose();
+		} else {
+			obs.edge_features_csc = obs.edge_features.template to_csc<std::int32_t>();
+		}
+	}
+	return true;
+}
+
+template class BasicNodeBipartite<double>;
+template class BasicNodeBipartite<float>;
+
+/****************************
+ *  Deltas of observations  *
+ ****************************/
+
+namespace {
+
+/** Whether two features are the same, where NaN features are the same as one another. */
+template <typename T> auto same_feature(T const a, T const b) noexcept -> bool {
+	return (a == b) || (std::isnan(a) && std::isnan(b));
+}
+
+/** The rows of the new features that differ from the old ones, where new rows always differ. */
+template <typename Features>
+auto changed_feature_rows(Features const& old_features, Features const& new_features) -> std::vector<std::size_t> {
+	using T = typename Features::value_type;
+	auto const n_features = new_features.shape(1);
+	auto changed = std::vector<std::size_t>{};
+	for (std::size_t i = 0; i < new_features.shape(0); ++i) {
+		auto const* const new_row = new_features.data() + i * n_features;
+		if (i >= old_features.shape(0) ||
+			!std::equal(new_row, new_row + n_features, old_features.data() + i * n_features, same_feature<T>)) {
+			changed.push_back(i);
+		}
+	}
+	return changed;
+}
+
+/** The rows of the new edges that differ from the old ones, where new rows always differ. */
+template <typename Csr> auto changed_edge_rows(Csr const& old_edges, Csr const& new_edges) -> std::vector<std::size_t> {
+	using T = typename Csr::value_type;
+	auto changed = std::vector<std::size_t>{};
+	for (std::size_t i = 0; i < new_edges.shape[0]; ++i) {
+		auto const begin = static_cast<std::size_t>(new_edges.row_pointers(i));
+		auto const end = static_cast<std::size_t>(new_edges.row_pointers(i + 1));
+		if (i >= old_edges.shape[0]) {
+			changed.push_back(i);
+			continue;
+		}
+		auto const old_begin = static_cast<std::size_t>(old_edges.row_pointers(i));
+		auto const old_end = static_cast<std::size_t>(old_edges.row_pointers(i + 1));
+		auto const same_row =
+			(end - begin == old_end - old_begin) &&
+			std::equal(
+				new_edges.column_indices.begin() + begin,
+				new_edges.column_indices.begin() + end,
+				old_edges.column_indices.begin() + old_begin) &&
+			std::equal(
+				new_edges.values.begin() + begin,
+				new_edges.values.begin() + end,
+				old_edges.values.begin() + old_begin,
+				same_feature<T>);
+		if (!same_row) {
+			changed.push_back(i);
+		}
+	}
+	return changed;
+}
+
+template <typename Features>
+auto gather_feature_rows(Features const& features, std::vector<std::size_t> const& rows) -> Features {
+	auto const n_features = features.shape(1);
+	auto gathered = Features::from_shape({rows.size(), n_features});
+	for (std::size_t k = 0; k < rows.size(); ++k) {
+		std::copy_n(features.data() + rows[k] * n_features, n_features, gathered.data() + k * n_features);
+	}
+	return gathered;
+}
+
+auto to_tensor(std::vector<std::size_t> const& indices) -> xt::xtensor<std::size_t, 1> {
+	return xt::adapt(indices, {indices.size()});
 }
 
-auto NodeBipartite::extract(scip::Model& model, bool /* done */) -> std::optional<NodeBipartiteObs> {
-	if (model.stage() == SCIP_STAGE_SOLVING) {
-		if (use_cache) {
-			if (is_on_root_node(model)) {
-				the_cache = extract_observation_fully(model);
-				cache_computed = true;
-				return the_cache;
+template <typename Value>
+auto make_delta(BasicNodeBipartiteObs<Value> const& previous, BasicNodeBipartiteObs<Value> const& current)
+	-> BasicNodeBipartiteDelta<Value> {
+	auto delta = BasicNodeBipartiteDelta<Value>{};
+	delta.n_variables = current.variable_features.shape(0);
+	delta.n_rows = current.row_features.shape(0);
+	auto const variables = changed_feature_rows(previous.variable_features, current.variable_features);
+	delta.variable_indices = to_tensor(variables);
+	delta.variable_features = gather_feature_rows(current.variable_features, variables);
+	auto const rows = changed_feature_rows(previous.row_features, current.row_features);
+	delta.row_indices = to_tensor(rows);
+	delta.row_features = gather_feature_rows(current.row_features, rows);
+	auto const edge_rows = changed_edge_rows(previous.edge_features_csr, current.edge_features_csr);
+	delta.edge_row_indices = to_tensor(edge_rows);
+	auto const edges = nonstd::span<std::size_t const>{edge_rows.data(), edge_rows.size()};
+	delta.edge_features = current.edge_features_csr.select_rows(edges);
+	return delta;
+}
+
+/**
+ * Resize the features to the given number of rows, keeping the existing ones, and overwrite the given rows.
+ *
+ * @throw std::invalid_argument If the rows are out of bounds, or do not cover the added rows.
+ */
+template <typename Features, typename Indices>
+void update_feature_rows(
+	Features& features,
+	std::size_t const n_rows,
+	std::size_t const n_features,
+	Indices const& indices,
+	Features const& new_features) {
+	if (new_features.shape(0) != indices.size() || (indices.size() > 0 && new_features.shape(1) != n_features)) {
+		throw std::invalid_argument{"The features of the delta do not match its indices."};
+	}
+	auto const n_kept = std::min(n_rows, features.shape(0));
+	if (std::count_if(indices.begin(), indices.end(), [n_kept](auto i) { return i >= n_kept; }) !=
+		static_cast<std::ptrdiff_t>(n_rows - n_kept)) {
+		throw std::invalid_argument{"The delta does not match the observation it is applied to."};
+	}
+	if (features.shape(0) != n_rows || features.shape(1) != n_features) {
+		auto resized = Features::from_shape({n_rows, n_features});
+		std::copy_n(features.data(), n_kept * n_features, resized.data());
+		features = std::move(resized);
+	}
+	for (std::size_t k = 0; k < indices.size(); ++k) {
+		assert(indices(k) < n_rows);
+		std::copy_n(new_features.data() + k * n_features, n_features, features.data() + indices(k) * n_features);
+	}
+}
+
+}  // namespace
+
+template <typename Value>
+BasicDeltaNodeBipartite<Value>::BasicDeltaNodeBipartite(bool cache, bool incremental) :
+	node_bipartite{cache, incremental, true} {}
+
+template <typename Value> auto BasicDeltaNodeBipartite<Value>::before_reset(scip::Model& model) -> void {
+	node_bipartite.before_reset(model);
+	previous_obs = {};
+}
+
+template <typename Value>
+auto BasicDeltaNodeBipartite<Value>::extract(scip::Model& model, bool done) -> std::optional<Observation> {
+	if (!node_bipartite.extract_into(model, done, current_obs)) {
+		return {};
+	}
+	auto delta = make_delta(previous_obs, current_obs);
+	// The previous observation is extracted into next time, reusing its memory
+	std::swap(previous_obs, current_obs);
+	return delta;
+}
+
+template class BasicDeltaNodeBipartite<double>;
+template class BasicDeltaNodeBipartite<float>;
+
+template <typename Value>
+void apply_delta(BasicNodeBipartiteObs<Value>& obs, BasicNodeBipartiteDelta<Value> const& delta) {
+	using Obs = BasicNodeBipartiteObs<Value>;
+	using Csr = decltype(Obs::edge_features_csr);
+	using index_type = typename Csr::index_type;
+
+	update_feature_rows(
+		obs.variable_features,
+		delta.n_variables,
+		Obs::n_variable_features,
+		delta.variable_indices,
+		delta.variable_features);
+	update_feature_rows(obs.row_features, delta.n_rows, Obs::n_row_features, delta.row_indices, delta.row_features);
+
+	auto const& old_edges = obs.edge_features_csr;
+	auto const& new_edges = delta.edge_features;
+	if (new_edges.shape[0] != delta.edge_row_indices.size()) {
+		throw std::invalid_argument{"The edges of the delta do not match its indices."};
+	}
+	// The row of the delta holding the edges of every row, if they changed
+	auto constexpr unchanged = std::numeric_limits<std::size_t>::max();
+	auto delta_rows = std::vector<std::size_t>(delta.n_rows, unchanged);
+	for (std::size_t k = 0; k < delta.edge_row_indices.size(); ++k) {
+		if (delta.edge_row_indices(k) >= delta.n_rows) {
+			throw std::invalid_argument{"The delta has edges for rows out of the observation."};
+		}
+		delta_rows[delta.edge_row_indices(k)] = k;
+	}
+	auto const row_edges = [&](std::size_t i) {
+		auto const& edges = (delta_rows[i] != unchanged) ? new_edges : old_edges;
+		auto const row = (delta_rows[i] != unchanged) ? delta_rows[i] : i;
+		return std::tuple{
+			&edges,
+			static_cast<std::size_t>(edges.row_pointers(row)),
+			static_cast<std::size_t>(edges.row_pointers(row + 1))};
+	};
+
+	auto edges = Csr{};
+	edges.row_pointers = decltype(edges.row_pointers)::from_shape({delta.n_rows + 1});
+	edges.shape = {delta.n_rows, delta.n_variables};
+	edges.row_pointers(0) = 0;
+	for (std::size_t i = 0; i < delta.n_rows; ++i) {
+		if (delta_rows[i] == unchanged && i >= old_edges.shape[0]) {
+			throw std::invalid_argument{"The delta does not match the observation it is applied to."};
+		}
+		auto const range = row_edges(i);
+		auto const n_row_edges = std::get<2>(range) - std::get<1>(range);
+		edges.row_pointers(i + 1) = static_cast<index_type>(static_cast<std::size_t>(edges.row_pointers(i)) + n_row_edges);
+	}
+	auto const nnz = static_cast<std::size_t>(edges.row_pointers(delta.n_rows));
+	edges.values = decltype(edges.values)::from_shape({nnz});
+	edges.column_indices = decltype(edges.column_indices)::from_shape({nnz});
+	for (std::size_t i = 0; i < delta.n_rows; ++i) {
+		auto const [source, begin, end] = row_edges(i);
+		auto const dest = static_cast<std::ptrdiff_t>(edges.row_pointers(i));
+		auto const first = static_cast<std::ptrdiff_t>(begin);
+		auto const last = static_cast<std::ptrdiff_t>(end);
+		std::copy(source->values.begin() + first, source->values.begin() + last, edges.values.begin() + dest);
+		std::copy(
+			source->column_indices.begin() + first,
+			source->column_indices.begin() + last,
+			edges.column_indices.begin() + dest);
+	}
+	obs.edge_features_csr = std::move(edges);
+	obs.edge_features = {};
+}
+
+template void apply_delta<double>(NodeBipartiteObs&, NodeBipartiteDelta const&);
+template void apply_delta<float>(NodeBipartiteObsFloat32&, NodeBipartiteDeltaFloat32 const&);
+
+/**************************
+ *  Compact observations  *
+ **************************/
+
+namespace {
+
+using ContinuousVariableFeatures = NodeBipartiteCompactObs::ContinuousVariableFeatures;
+using CategoricalVariableFeatures = NodeBipartiteCompactObs::CategoricalVariableFeatures;
+
+/** The feature of the full observation of every continuous feature, in order. */
+constexpr auto continuous_variable_features = std::array{
+	VariableFeatures::objective,
+	VariableFeatures::normed_reduced_cost,
+	VariableFeatures::solution_value,
+	VariableFeatures::solution_frac,
+	VariableFeatures::scaled_age,
+	VariableFeatures::incumbent_value,
+	VariableFeatures::average_incumbent_value,
+	VariableFeatures::index,
+};
+static_assert(continuous_variable_features.size() == NodeBipartiteCompactObs::n_continuous_variable_features);
+static_assert(idx(ContinuousVariableFeatures::index) + 1 == continuous_variable_features.size());
+
+/** The features of the full observation encoding a categorical feature, one for booleans. */
+struct Encoding {
+	VariableFeatures first;
+	std::uint8_t size;
+};
+
+/** The encoding of every categorical feature, in order. */
+constexpr auto categorical_variable_features = std::array{
+	Encoding{VariableFeatures::is_type_binary, 4},
+	Encoding{VariableFeatures::has_lower_bound, 1},
+	Encoding{VariableFeatures::has_upper_bound, 1},
+	Encoding{VariableFeatures::is_solution_at_lower_bound, 1},
+	Encoding{VariableFeatures::is_solution_at_upper_bound, 1},
+	Encoding{VariableFeatures::is_basis_lower, 4},
+};
+static_assert(categorical_variable_features.size() == NodeBipartiteCompactObs::n_categorical_variable_features);
+static_assert(idx(CategoricalVariableFeatures::basis_status) + 1 == categorical_variable_features.size());
+
+/** The code of a categorical feature, which is the position of the one in a one hot encoding, or the boolean. */
+template <typename T> auto encode(T const* const features, Encoding const encoding) noexcept -> std::uint8_t {
+	auto const* const first = features + idx(encoding.first);
+	if (encoding.size == 1) {
+		return static_cast<std::uint8_t>(*first != 0);
+	}
+	auto const* const one = std::find_if(first, first + encoding.size, [](T x) { return x != 0; });
+	return static_cast<std::uint8_t>(one - first);
+}
+
+/** Split the variable features of a full observation into continuous features and categorical codes. */
+template <typename Value>
+void compact_variable_features(xt::xtensor<Value, 2> const& features, BasicNodeBipartiteCompactObs<Value>& obs) {
+	auto const n_vars = features.shape(0);
+	auto const n_features = features.shape(1);
+	obs.variable_features = xt::xtensor<Value, 2>::from_shape({n_vars, continuous_variable_features.size()});
+	obs.variable_categories = xt::xtensor<std::uint8_t, 2>::from_shape({n_vars, categorical_variable_features.size()});
+	auto* continuous = obs.variable_features.data();
+	auto* categories = obs.variable_categories.data();
+	for (std::size_t var_idx = 0; var_idx < n_vars; ++var_idx) {
+		auto const* const var_features = features.data() + var_idx * n_features;
+		for (auto const feature : continuous_variable_features) {
+			*continuous++ = var_features[idx(feature)];
+		}
+		for (auto const encoding : categorical_variable_features) {
+			*categories++ = encode(var_features, encoding);
+		}
+	}
+}
+
+}  // namespace
+
+template <typename Value>
+BasicCompactNodeBipartite<Value>::BasicCompactNodeBipartite(bool cache, bool incremental, bool csr_edges) :
+	node_bipartite{cache, incremental, csr_edges} {}
+
+template <typename Value> auto BasicCompactNodeBipartite<Value>::before_reset(scip::Model& model) -> void {
+	node_bipartite.before_reset(model);
+}
+
+template <typename Value>
+auto BasicCompactNodeBipartite<Value>::extract(scip::Model& model, bool done) -> std::optional<Observation> {
+	if (!node_bipartite.extract_into(model, done, full_obs)) {
+		return {};
+	}
+	auto obs = Observation{};
+	compact_variable_features(full_obs.variable_features, obs);
+	// Only the full variable features are extracted into next time, reusing their memory
+	obs.row_features = std::exchange(full_obs.row_features, {});
+	obs.edge_features = std::exchange(full_obs.edge_features, {});
+	obs.edge_features_csr = std::exchange(full_obs.edge_features_csr, {});
+	return obs;
+}
+
+template class BasicCompactNodeBipartite<double>;
+template class BasicCompactNodeBipartite<float>;
+
+/*******************************
+ *  Collation of observations  *
+ *******************************/
+
+template <typename Value>
+auto collate(nonstd::span<BasicNodeBipartiteObs<Value> const* const> observations) -> BasicNodeBipartiteBatch<Value> {
+	using Obs = BasicNodeBipartiteObs<Value>;
+	auto const n_obs = observations.size();
+	auto const n_edges_of = [](Obs const& obs) {
+		return obs.edge_features.nnz() > 0 ? obs.edge_features.nnz() : obs.edge_features_csr.nnz();
+	};
+
+	auto batch = BasicNodeBipartiteBatch<Value>{};
+	batch.variable_offsets = xt::zeros<std::size_t>({n_obs + 1});
+	batch.row_offsets = xt::zeros<std::size_t>({n_obs + 1});
+	batch.edge_offsets = xt::zeros<std::size_t>({n_obs + 1});
+	for (std::size_t i = 0; i < n_obs; ++i) {
+		auto const* const obs = observations[i];
+		batch.variable_offsets[i + 1] = batch.variable_offsets[i] + (obs != nullptr ? obs->variable_features.shape(0) : 0);
+		batch.row_offsets[i + 1] = batch.row_offsets[i] + (obs != nullptr ? obs->row_features.shape(0) : 0);
+		batch.edge_offsets[i + 1] = batch.edge_offsets[i] + (obs != nullptr ? n_edges_of(*obs) : 0);
+	}
+
+	auto const n_vars = batch.variable_offsets[n_obs];
+	auto const n_rows = batch.row_offsets[n_obs];
+	auto const n_edges = batch.edge_offsets[n_obs];
+	batch.variable_features = decltype(batch.variable_features)::from_shape({n_vars, Obs::n_variable_features});
+	batch.row_features = decltype(batch.row_features)::from_shape({n_rows, Obs::n_row_features});
+	batch.variable_batch = decltype(batch.variable_batch)::from_shape({n_vars});
+	batch.row_batch = decltype(batch.row_batch)::from_shape({n_rows});
+	batch.edge_features.values = decltype(batch.edge_features.values)::from_shape({n_edges});
+	batch.edge_features.indices = decltype(batch.edge_features.indices)::from_shape({2, n_edges});
+	batch.edge_features.shape = {n_rows, n_vars};
+
+	auto* const row_indices = batch.edge_features.indices.data();
+	auto* const var_indices = batch.edge_features.indices.data() + n_edges;
+	for (std::size_t i = 0; i < n_obs; ++i) {
+		auto const* const obs = observations[i];
+		if (obs == nullptr) {
+			continue;
+		}
+		auto const var_start = batch.variable_offsets[i];
+		auto const row_start = batch.row_offsets[i];
+		auto const edge_start = batch.edge_offsets[i];
+		// Tensors are row major, so the features of every observation are contiguous
+		std::copy(
+			obs->variable_features.begin(),
+			obs->variable_features.end(),
+			batch.variable_features.data() + var_start * Obs::n_variable_features);
+		std::copy(
+			obs->row_features.begin(),
+			obs->row_features.end(),
+			batch.row_features.data() + row_start * Obs::n_row_features);
+		std::fill_n(batch.variable_batch.data() + var_start, obs->variable_features.shape(0), i);
+		std::fill_n(batch.row_batch.data() + row_start, obs->row_features.shape(0), i);
+
+		if (auto const& coo = obs->edge_features; coo.nnz() > 0) {
+			std::copy(coo.values.begin(), coo.values.end(), batch.edge_features.values.data() + edge_start);
+			for (std::size_t e = 0; e < coo.nnz(); ++e) {
+				row_indices[edge_start + e] = coo.indices(0, e) + row_start;
+				var_indices[edge_start + e] = coo.indices(1, e) + var_start;
 			}
-			if (cache_computed) {
-				return extract_observation_from_cache(model, the_cache);
+		} else {
+			auto const& csr = obs->edge_features_csr;
+			std::copy(csr.values.begin(), csr.values.end(), batch.edge_features.values.data() + edge_start);
+			auto const n_csr_rows = csr.row_pointers.size() > 0 ? csr.row_pointers.size() - 1 : 0;
+			for (std::size_t r = 0; r < n_csr_rows; ++r) {
+				auto const begin = static_cast<std::size_t>(csr.row_pointers[r]);
+				auto const end = static_cast<std::size_t>(csr.row_pointers[r + 1]);
+				for (auto e = begin; e < end; ++e) {
+					row_indices[edge_start + e] = r + row_start;
+					var_indices[edge_start + e] = static_cast<std::size_t>(csr.column_indices[e]) + var_start;
+				}
 			}
 		}
-		return extract_observation_fully(model);
 	}
-	return {};
+	return batch;
+}
+
+template <typename Value>
+auto collate(std::vector<BasicNodeBipartiteObs<Value>> const& observations) -> BasicNodeBipartiteBatch<Value> {
+	auto pointers = std::vector<BasicNodeBipartiteObs<Value> const*>(observations.size());
+	std::transform(observations.begin(), observations.end(), pointers.begin(), [](auto const& obs) { return &obs; });
+	return collate<Value>(nonstd::span<BasicNodeBipartiteObs<Value> const* const>{pointers.data(), pointers.size()});
 }
 
+template auto collate<double>(nonstd::span<NodeBipartiteObs const* const>) -> NodeBipartiteBatch;
+template auto collate<float>(nonstd::span<NodeBipartiteObsFloat32 const* const>) -> NodeBipartiteBatchFloat32;
+template auto collate<double>(std::vector<NodeBipartiteObs> const&) -> NodeBipartiteBatch;
+template auto collate<float>(std::vector<NodeBipartiteObsFloat32> const&) -> NodeBipartiteBatchFloat32;
+
 }  // namespace ecole::observation
@@ -1,6 +1,7 @@
 #include <cmath>
 #include <cstddef>
 #include <optional>
+#include <utility>
 
 #include <nonstd/span.hpp>
 #include <range/v3/view/zip.hpp>
@@ -8,6 +9,7 @@
 #include <xtensor/xview.hpp>
 
 #include "ecole/observation/pseudocosts.hpp"
+#include "ecole/scip/lp-view.hpp"
 #include "ecole/scip/model.hpp"
 
 namespace ecole::observation {
@@ -30,25 +32,71 @@ auto scip_get_lp_branch_cands(SCIP* const scip) noexcept {
 
 }  // namespace
 
-std::optional<xt::xtensor<double, 1>> Pseudocosts::extract(scip::Model& model, bool /* done */) {
+Pseudocosts::Pseudocosts(bool candidates_only_) noexcept : candidates_only{candidates_only_} {}
+
+std::optional<xt::xtensor<double, 1>> Pseudocosts::extract(scip::Model& model, bool done) {
+	auto pseudocosts = xt::xtensor<double, 1>{};
+	if (extract_into(model, done, pseudocosts)) {
+		return pseudocosts;
+	}
+	return {};
+}
+
+auto Pseudocosts::extract_into(scip::Model& model, bool /* done */, xt::xtensor<double, 1>& pseudocosts) const
+	-> bool {
 	if (model.stage() != SCIP_STAGE_SOLVING) {
-		return {};
+		return false;
 	}
 
 	auto* const scip = model.get_scip_ptr();
 	auto const [cands, lp_values] = scip_get_lp_branch_cands(scip);
 
-	/* Store pseudocosts in tensor */
-	auto const nb_vars = static_cast<std::size_t>(SCIPgetNVars(scip));
-	xt::xtensor<double, 1> pseudocosts({nb_vars}, std::nan(""));
+	/* Store pseudocosts in tensor, reusing its memory when possible */
+	auto const size = candidates_only ? cands.size() : static_cast<std::size_t>(SCIPgetNVars(scip));
+	if (pseudocosts.size() != size) {
+		pseudocosts.resize({size});
+	}
+	if (!candidates_only) {
+		pseudocosts.fill(std::nan(""));
+	}
 
+	std::size_t cand_idx = 0;
 	for (auto const [var, lp_val] : views::zip(cands, lp_values)) {
-		auto const var_index = static_cast<std::size_t>(SCIPvarGetProbindex(var));
-		auto const score = SCIPgetVarPseudocostScore(scip, var, lp_val);
-		pseudocosts[var_index] = static_cast<double>(score);
+		auto const idx = candidates_only ? cand_idx++ : static_cast<std::size_t>(SCIPvarGetProbindex(var));
+		pseudocosts[idx] = static_cast<double>(SCIPgetVarPseudocostScore(scip, var, lp_val));
 	}
 
-	return pseudocosts;
+	return true;
+}
+
+auto Pseudocosts::lp_visitor(scip::Model& model, bool /* done */) const -> LpVisitor {
+	return {model, candidates_only};
+}
+
+Pseudocosts::LpVisitor::LpVisitor(scip::Model& model, bool candidates_only) : scip{model.get_scip_ptr()} {
+	auto const [cands, lp_values] = scip_get_lp_branch_cands(scip);
+	auto const n_vars = static_cast<std::size_t>(SCIPgetNVars(scip));
+	positions.assign(n_vars, -1);
+	for (std::size_t cand_idx = 0; cand_idx < cands.size(); ++cand_idx) {
+		auto const var_idx = SCIPvarGetProbindex(cands[cand_idx]);
+		positions[static_cast<std::size_t>(var_idx)] = candidates_only ? static_cast<std::ptrdiff_t>(cand_idx) : var_idx;
+	}
+	pseudocosts = xt::xtensor<double, 1>::from_shape({candidates_only ? cands.size() : n_vars});
+	pseudocosts.fill(std::nan(""));
+}
+
+auto Pseudocosts::LpVisitor::visit_column(scip::LpView const& lp, std::size_t col_idx) -> void {
+	auto const position = positions[lp.column_var_indices[col_idx]];
+	if (position >= 0) {
+		// Branching candidates are LP columns, whose primal value is the LP solution value of the candidate
+		auto* const var = SCIPcolGetVar(lp.columns[col_idx]);
+		pseudocosts[static_cast<std::size_t>(position)] =
+			static_cast<double>(SCIPgetVarPseudocostScore(scip, var, lp.column_primal_values[col_idx]));
+	}
+}
+
+auto Pseudocosts::LpVisitor::finish() -> std::optional<xt::xtensor<double, 1>> {
+	return std::move(pseudocosts);
 }
 
 }  // namespace ecole::observation
@@ -1,5 +1,11 @@
+#include <algorithm>
+#include <climits>
 #include <cmath>
 #include <cstddef>
+#include <future>
+#include <optional>
+#include <utility>
+#include <vector>
 
 #include <nonstd/span.hpp>
 #include <range/v3/view/zip.hpp>
@@ -9,6 +15,10 @@
 #include "ecole/observation/strong-branching-scores.hpp"
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/utils.hpp"
+#include "ecole/threads.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+#include "observation/strong-branching.hpp"
 
 namespace ecole::observation {
 
@@ -28,44 +38,160 @@ auto scip_get_vanillafullstrong_data(SCIP* const scip) noexcept {
 	};
 }
 
+/** The bounds of the down and up children of a candidate, as in SCIP strong branching. */
+auto children_bounds(SCIP* const scip, SCIP_VAR* const var) noexcept {
+	auto const value = SCIPvarGetLPSol(var);
+	if (SCIPisFeasIntegral(scip, value)) {
+		auto const rounded = SCIPfeasRound(scip, value);
+		return std::pair{rounded - 1., rounded + 1.};
+	}
+	return std::pair{SCIPfeasFloor(scip, value), SCIPfeasCeil(scip, value)};
+}
+
+/**
+ * Score the candidates on copies of the node LP, one per chunk of candidates, solved in the threads of the pool.
+ *
+ * Gains are computed as with the vanillafullstrong rule, where children objective values are capped by the cutoff
+ * bound, which infeasible children reach.
+ * Return empty when the node LP cannot be copied, or when a candidate is not in the LP.
+ */
+auto parallel_scores(scip::Model& model, bool pseudo_candidates, utility::ThreadPool& thread_pool)
+	-> std::optional<xt::xtensor<double, 1>> {
+	auto* const scip = model.get_scip_ptr();
+	auto const cands = pseudo_candidates ? model.pseudo_branch_cands() : model.lp_branch_cands();
+	auto const n_cands = cands.size();
+	auto cols = std::vector<int>(n_cands);
+	auto bounds = std::vector<std::pair<SCIP_Real, SCIP_Real>>(n_cands);
+	for (std::size_t i = 0; i < n_cands; ++i) {
+		auto* const col = SCIPvarGetStatus(cands[i]) == SCIP_VARSTATUS_COLUMN ? SCIPvarGetCol(cands[i]) : nullptr;
+		if (col == nullptr || SCIPcolGetLPPos(col) < 0) {
+			return {};
+		}
+		cols[i] = SCIPcolGetLPPos(col);
+		bounds[i] = children_bounds(scip, cands[i]);
+	}
+	auto const node_lp = read_node_lp(scip);
+	if (!node_lp.has_value()) {
+		return {};
+	}
+
+	auto objvals = std::vector<std::optional<std::pair<SCIP_Real, SCIP_Real>>>(n_cands);
+	auto const solve_children = [&](std::size_t begin, std::size_t end) {
+		auto lp = NodeLpCopy{node_lp.value()};
+		for (auto i = begin; i < end; ++i) {
+			auto const [down_ub, up_lb] = bounds[i];
+			auto const idx = static_cast<std::size_t>(cols[i]);
+			auto const down = lp.solve_child(cols[i], node_lp->lb[idx], down_ub, INT_MAX);
+			auto const up = lp.solve_child(cols[i], up_lb, node_lp->ub[idx], INT_MAX);
+			if (down.has_value() && up.has_value()) {
+				objvals[i] = std::pair{down.value(), up.value()};
+			}
+		}
+	};
+	auto const n_chunks = std::min(thread_pool.size(), n_cands);
+	auto futures = std::vector<std::future<void>>{};
+	futures.reserve(n_chunks);
+	for (std::size_t chunk = 0; chunk < n_chunks; ++chunk) {
+		auto const begin = chunk * n_cands / n_chunks;
+		auto const end = (chunk + 1) * n_cands / n_chunks;
+		futures.push_back(thread_pool.submit([&solve_children, begin, end] { solve_children(begin, end); }));
+	}
+	// All tasks are awaited before rethrowing since they reference local variables
+	for (auto& fut : futures) {
+		fut.wait();
+	}
+	for (auto& fut : futures) {
+		fut.get();
+	}
+
+	// Objective values of the LP interface do not include loose variables
+	auto const lp_objval = SCIPgetLPObjval(scip);
+	auto const offset = lp_objval - node_lp->objval;
+	auto const cutoff = SCIPgetCutoffbound(scip);
+	auto const to_gain = [&](SCIP_Real objval) {
+		auto const capped = SCIPisInfinity(scip, objval) ? cutoff : std::min(objval + offset, cutoff);
+		return std::max(capped, lp_objval) - lp_objval;
+	};
+	auto scores = xt::xtensor<double, 1>({static_cast<std::size_t>(SCIPgetNVars(scip))}, std::nan(""));
+	for (std::size_t i = 0; i < n_cands; ++i) {
+		if (objvals[i].has_value()) {
+			auto const [down, up] = objvals[i].value();
+			auto const var_index = static_cast<std::size_t>(SCIPvarGetProbindex(cands[i]));
+			scores[var_index] = static_cast<double>(SCIPgetBranchScore(scip, cands[i], to_gain(down), to_gain(up)));
+		}
+	}
+	return scores;
+}
+
 }  // namespace
 
-StrongBranchingScores::StrongBranchingScores(bool pseudo_candidates_) : pseudo_candidates(pseudo_candidates_) {}
+StrongBranchingScores::StrongBranchingScores(bool pseudo_candidates_, std::size_t n_threads) :
+	pseudo_candidates(pseudo_candidates_), thread_pool(make_thread_pool(n_threads)) {}
+
+auto StrongBranchingScores::before_reset(scip::Model& model) -> void {
+	params.reset();
+	vanillafullstrong_params(model);
+}
+
+auto StrongBranchingScores::vanillafullstrong_params(scip::Model& model) -> VanillafullstrongParams const& {
+	// Resolve again if extract is called on a different model than the one given to before_reset
+	if (!params.has_value() || (params->scip != model.get_scip_ptr())) {
+		params = VanillafullstrongParams{
+			model.get_scip_ptr(),
+			SCIPfindBranchrule(model.get_scip_ptr(), "vanillafullstrong"),
+			model.param_handle<scip::ParamType::Bool>("branching/vanillafullstrong/integralcands"),
+			model.param_handle<scip::ParamType::Bool>("branching/vanillafullstrong/scoreall"),
+			model.param_handle<scip::ParamType::Bool>("branching/vanillafullstrong/collectscores"),
+			model.param_handle<scip::ParamType::Bool>("branching/vanillafullstrong/donotbranch"),
+			model.param_handle<scip::ParamType::Bool>("branching/vanillafullstrong/idempotent"),
+		};
+	}
+	return params.value();
+}
 
-std::optional<xt::xtensor<double, 1>> StrongBranchingScores::extract(scip::Model& model, bool /* done */) const {
+std::optional<xt::xtensor<double, 1>> StrongBranchingScores::extract(scip::Model& model, bool /* done */) {
+	last_scored_on_lp_copies = false;
 	if (model.stage() != SCIP_STAGE_SOLVING) {
 		return {};
 	}
 
+	if (thread_pool != nullptr && !utility::ThreadPool::in_worker_thread()) {
+		if (auto scores = parallel_scores(model, pseudo_candidates, *thread_pool); scores.has_value()) {
+			last_scored_on_lp_copies = true;
+			return scores;
+		}
+	}
+
 	auto* const scip = model.get_scip_ptr();
+	auto const& vanilla = vanillafullstrong_params(model);
 
 	/* store original SCIP parameters */
-	auto const integralcands = model.get_param<bool>("branching/vanillafullstrong/integralcands");
-	auto const scoreall = model.get_param<bool>("branching/vanillafullstrong/scoreall");
-	auto const collectscores = model.get_param<bool>("branching/vanillafullstrong/collectscores");
-	auto const donotbranch = model.get_param<bool>("branching/vanillafullstrong/donotbranch");
-	auto const idempotent = model.get_param<bool>("branching/vanillafullstrong/idempotent");
+	auto const integralcands = vanilla.integralcands.get();
+	auto const scoreall = vanilla.scoreall.get();
+	auto const collectscores = vanilla.collectscores.get();
+	auto const donotbranch = vanilla.donotbranch.get();
+	auto const idempotent = vanilla.idempotent.get();
 
 	/* set parameters for vanilla full strong branching  */
-	model.set_param("branching/vanillafullstrong/integralcands", pseudo_candidates);
-	model.set_param("branching/vanillafullstrong/scoreall", true);
-	model.set_param("branching/vanillafullstrong/collectscores", true);
-	model.set_param("branching/vanillafullstrong/donotbranch", true);
-	model.set_param("branching/vanillafullstrong/idempotent", true);
+	vanilla.integralcands.set(pseudo_candidates);
+	vanilla.scoreall.set(true);
+	vanilla.collectscores.set(true);
+	vanilla.donotbranch.set(true);
+	vanilla.idempotent.set(true);
 
 	/* execute vanilla full strong branching */
-	auto* branchrule = SCIPfindBranchrule(scip, "vanillafullstrong");
+	auto* const branchrule = vanilla.branchrule;
 	SCIP_RESULT result;
 	scip::call(branchrule->branchexeclp, scip, branchrule, false, &result);
 	assert(result == SCIP_DIDNOTRUN);
 	auto const [cands, cands_scores] = scip_get_vanillafullstrong_data(scip);
 
 	/* restore model parameters */
-	model.set_param("branching/vanillafullstrong/integralcands", integralcands);
-	model.set_param("branching/vanillafullstrong/scoreall", scoreall);
-	model.set_param("branching/vanillafullstrong/collectscores", collectscores);
-	model.set_param("branching/vanillafullstrong/donotbranch", donotbranch);
-	model.set_param("branching/vanillafullstrong/idempotent", idempotent);
+	vanilla.integralcands.set(integralcands);
+	vanilla.scoreall.set(scoreall);
+	vanilla.collectscores.set(collectscores);
+	vanilla.donotbranch.set(donotbranch);
+	vanilla.idempotent.set(idempotent);
 
 	/* Store strong branching scores in tensor */
 	auto const nb_vars = static_cast<std::size_t>(SCIPgetNVars(scip));
@@ -0,0 +1,187 @@
+#include <algorithm>
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <optional>
+#include <vector>
+
+#include <lpi/lpi.h>
+
+#include "ecole/scip/utils.hpp"
+
+#include "observation/strong-branching.hpp"
+
+namespace ecole::observation {
+
+auto to_iteration_limit(std::optional<std::size_t> max_lp_iterations) noexcept -> int {
+	if (!max_lp_iterations.has_value()) {
+		return INT_MAX;
+	}
+	return static_cast<int>(std::min(max_lp_iterations.value(), static_cast<std::size_t>(INT_MAX)));
+}
+
+auto strong_branch(SCIP* scip, SCIP_VAR* var, SCIP_Real lp_objval, int iteration_limit, bool idempotent)
+	-> std::optional<StrongBranchingResult> {
+	SCIP_Real down = 0.;
+	SCIP_Real up = 0.;
+	SCIP_Bool lperror = false;
+	auto* const strong_branch =
+		SCIPisFeasIntegral(scip, SCIPvarGetLPSol(var)) ? SCIPgetVarStrongbranchInt : SCIPgetVarStrongbranchFrac;
+	auto const n_lp_iterations_before = SCIPgetNStrongbranchLPIterations(scip);
+	scip::call(
+		strong_branch,
+		scip,
+		var,
+		iteration_limit,
+		idempotent,
+		&down,
+		&up,
+		nullptr,
+		nullptr,
+		nullptr,
+		nullptr,
+		nullptr,
+		nullptr,
+		&lperror);
+	if (lperror) {
+		return {};
+	}
+	return StrongBranchingResult{
+		std::max(down, lp_objval) - lp_objval,
+		std::max(up, lp_objval) - lp_objval,
+		SCIPgetNStrongbranchLPIterations(scip) - n_lp_iterations_before,
+	};
+}
+
+namespace {
+
+/** Parameters copied to the solvers of children, other than the iteration limit set by every child. */
+constexpr auto copied_int_params = std::array{SCIP_LPPAR_SCALING, SCIP_LPPAR_PRESOLVING, SCIP_LPPAR_PRICING};
+constexpr auto copied_real_params = std::array{SCIP_LPPAR_FEASTOL, SCIP_LPPAR_DUALFEASTOL};
+
+}  // namespace
+
+auto read_node_lp(SCIP* scip) -> std::optional<NodeLpData> {
+	if (!SCIPisLPSolBasic(scip) || SCIPgetLPSolstat(scip) != SCIP_LPSOLSTAT_OPTIMAL) {
+		return {};
+	}
+	SCIP_LPI* lpi = nullptr;
+	scip::call(SCIPgetLPI, scip, &lpi);
+	int n_cols = 0;
+	int n_rows = 0;
+	int n_nonz = 0;
+	scip::call(SCIPlpiGetNCols, lpi, &n_cols);
+	scip::call(SCIPlpiGetNRows, lpi, &n_rows);
+	scip::call(SCIPlpiGetNNonz, lpi, &n_nonz);
+	if (n_cols == 0 || n_rows == 0) {
+		return {};
+	}
+
+	auto data = NodeLpData{};
+	data.messagehdlr = SCIPgetMessagehdlr(scip);
+	auto const cols = static_cast<std::size_t>(n_cols);
+	auto const rows = static_cast<std::size_t>(n_rows);
+	data.obj.resize(cols);
+	data.lb.resize(cols);
+	data.ub.resize(cols);
+	data.lhs.resize(rows);
+	data.rhs.resize(rows);
+	data.beg.resize(cols);
+	data.ind.resize(static_cast<std::size_t>(n_nonz));
+	data.val.resize(static_cast<std::size_t>(n_nonz));
+	data.cstat.resize(cols);
+	data.rstat.resize(rows);
+	scip::call(SCIPlpiGetObjsen, lpi, &data.objsen);
+	scip::call(SCIPlpiGetObjval, lpi, &data.objval);
+	scip::call(SCIPlpiGetObj, lpi, 0, n_cols - 1, data.obj.data());
+	scip::call(
+		SCIPlpiGetCols,
+		lpi,
+		0,
+		n_cols - 1,
+		data.lb.data(),
+		data.ub.data(),
+		&n_nonz,
+		data.beg.data(),
+		data.ind.data(),
+		data.val.data());
+	scip::call(
+		SCIPlpiGetRows, lpi, 0, n_rows - 1, data.lhs.data(), data.rhs.data(), nullptr, nullptr, nullptr, nullptr);
+	scip::call(SCIPlpiGetBase, lpi, data.cstat.data(), data.rstat.data());
+	// Parameters not supported by the LP solver are left to their default
+	for (auto const param : copied_int_params) {
+		if (int value = 0; SCIPlpiGetIntpar(lpi, param, &value) == SCIP_OKAY) {
+			data.int_params.emplace_back(param, value);
+		}
+	}
+	for (auto const param : copied_real_params) {
+		if (SCIP_Real value = 0.; SCIPlpiGetRealpar(lpi, param, &value) == SCIP_OKAY) {
+			data.real_params.emplace_back(param, value);
+		}
+	}
+	return data;
+}
+
+NodeLpCopy::NodeLpCopy(NodeLpData const& data_) : data{data_} {
+	scip::call(SCIPlpiCreate, &lpi, data.messagehdlr, "ecole-strong-branching", data.objsen);
+	try {
+		scip::call(
+			SCIPlpiLoadColLP,
+			lpi,
+			data.objsen,
+			static_cast<int>(data.obj.size()),
+			data.obj.data(),
+			data.lb.data(),
+			data.ub.data(),
+			nullptr,
+			static_cast<int>(data.lhs.size()),
+			data.lhs.data(),
+			data.rhs.data(),
+			nullptr,
+			static_cast<int>(data.val.size()),
+			data.beg.data(),
+			data.ind.data(),
+			data.val.data());
+		for (auto const [param, value] : data.int_params) {
+			scip::call(SCIPlpiSetIntpar, lpi, param, value);
+		}
+		for (auto const [param, value] : data.real_params) {
+			scip::call(SCIPlpiSetRealpar, lpi, param, value);
+		}
+		scip::call(SCIPlpiSetIntpar, lpi, SCIP_LPPAR_FROMSCRATCH, 0);
+		// Every copy runs in its own thread already
+		SCIPlpiSetIntpar(lpi, SCIP_LPPAR_THREADS, 1);
+	} catch (...) {
+		SCIPlpiFree(&lpi);
+		throw;
+	}
+}
+
+NodeLpCopy::~NodeLpCopy() {
+	SCIPlpiFree(&lpi);
+}
+
+auto NodeLpCopy::solve_child(int col, SCIP_Real new_lb, SCIP_Real new_ub, int iteration_limit)
+	-> std::optional<SCIP_Real> {
+	if (new_lb > new_ub) {
+		return SCIPlpiInfinity(lpi);
+	}
+	auto const idx = static_cast<std::size_t>(col);
+	scip::call(SCIPlpiChgBounds, lpi, 1, &col, &new_lb, &new_ub);
+	scip::call(SCIPlpiSetBase, lpi, data.cstat.data(), data.rstat.data());
+	scip::call(SCIPlpiSetIntpar, lpi, SCIP_LPPAR_LPITLIM, iteration_limit);
+	auto const retcode = SCIPlpiSolveDual(lpi);
+	auto objval = std::optional<SCIP_Real>{};
+	if (retcode == SCIP_OKAY) {
+		if (SCIPlpiIsPrimalInfeasible(lpi) || SCIPlpiIsObjlimExc(lpi)) {
+			objval = SCIPlpiInfinity(lpi);
+		} else if (SCIPlpiIsOptimal(lpi) || SCIPlpiIsIterlimExc(lpi)) {
+			objval.emplace();
+			scip::call(SCIPlpiGetObjval, lpi, &objval.value());
+		}
+	}
+	scip::call(SCIPlpiChgBounds, lpi, 1, &col, &data.lb[idx], &data.ub[idx]);
+	return objval;
+}
+
+}  // namespace ecole::observation
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstddef>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <lpi/type_lpi.h>
+#include <scip/scip.h>
+
+namespace ecole::observation {
+
+/** SCIP simplex iteration limit, where an empty limit is no limit. */
+auto to_iteration_limit(std::optional<std::size_t> max_lp_iterations) noexcept -> int;
+
+/** Dual bound improvements of the two children of a candidate, as computed by strong branching. */
+struct StrongBranchingResult {
+	SCIP_Real down_gain;
+	SCIP_Real up_gain;
+	/** The number of simplex iterations of both children, available only when not idempotent. */
+	SCIP_Longint n_lp_iterations;
+};
+
+/**
+ * Solve the children LPs of a candidate, in the same way as the vanillafullstrong branching rule.
+ *
+ * Must be called between SCIPstartStrongbranch and SCIPendStrongbranch, in which case every LP is warm started
+ * from the basis of the node LP stored by SCIP.
+ * When not idempotent, SCIP statistics are updated and the result is stored in the candidate column.
+ *
+ * @param lp_objval The objective value of the node LP, read before starting strong branching.
+ * @return The gains of the children, or empty if an LP failed.
+ */
+auto strong_branch(SCIP* scip, SCIP_VAR* var, SCIP_Real lp_objval, int iteration_limit, bool idempotent)
+	-> std::optional<StrongBranchingResult>;
+
+/**
+ * The node LP, as loaded in the LP interface of SCIP, with its optimal basis and the parameters of the LP solver.
+ *
+ * The LP interface of SCIP is only read when creating the data, in the solver thread, so that copies of the LP can
+ * then be created concurrently.
+ */
+struct NodeLpData {
+	SCIP_MESSAGEHDLR* messagehdlr = nullptr;
+	SCIP_OBJSEN objsen = SCIP_OBJSEN_MINIMIZE;
+	/** The objective value of the node LP in the LP interface, which does not include loose variables. */
+	SCIP_Real objval = 0.;
+	std::vector<SCIP_Real> obj;
+	std::vector<SCIP_Real> lb;
+	std::vector<SCIP_Real> ub;
+	std::vector<SCIP_Real> lhs;
+	std::vector<SCIP_Real> rhs;
+	/** The columns, in compressed sparse format. */
+	std::vector<int> beg;
+	std::vector<int> ind;
+	std::vector<SCIP_Real> val;
+	std::vector<int> cstat;
+	std::vector<int> rstat;
+	/** The parameters of the solver of SCIP that it supports. */
+	std::vector<std::pair<SCIP_LPPARAM, int>> int_params;
+	std::vector<std::pair<SCIP_LPPARAM, SCIP_Real>> real_params;
+};
+
+/** Read the node LP, or return empty if it is not solved to optimality with a basis. */
+auto read_node_lp(SCIP* scip) -> std::optional<NodeLpData>;
+
+/**
+ * A copy of the node LP in a new LP interface, solving the children of candidates independently of SCIP.
+ *
+ * As in SCIP strong branching, children are solved by the dual simplex, warm started from the basis of the node LP.
+ * Different copies can be used in different threads, with a thread safe LP solver such as SoPlex.
+ */
+class NodeLpCopy {
+public:
+	explicit NodeLpCopy(NodeLpData const& data);
+	NodeLpCopy(NodeLpCopy const&) = delete;
+	auto operator=(NodeLpCopy const&) -> NodeLpCopy& = delete;
+	~NodeLpCopy();
+
+	/**
+	 * Solve the child where the bounds of the column are changed, and restore them.
+	 *
+	 * @return The objective value in the LP interface, the infinity of the LP solver if the child is infeasible, or
+	 *         empty if the LP failed.
+	 */
+	auto solve_child(int col, SCIP_Real new_lb, SCIP_Real new_ub, int iteration_limit) -> std::optional<SCIP_Real>;
+
+private:
+	NodeLpData const& data;
+	SCIP_LPI* lpi = nullptr;
+};
+
+}  // namespace ecole::observation
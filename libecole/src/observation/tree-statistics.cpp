@@ -0,0 +1,186 @@
+#include <array>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <utility>
+
+#include <objscip/objeventhdlr.h>
+#include <scip/scip.h>
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/observation/tree-statistics.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+#include "utility/math.hpp"
+
+namespace ecole::observation {
+
+namespace {
+
+using Features = TreeStatisticsObs::Features;
+
+template <typename E> constexpr auto idx(E e) {
+	return static_cast<std::size_t>(e);
+}
+
+/** The gap, infinite without primal solution. */
+auto get_gap(SCIP* const scip) -> double {
+	auto const gap = SCIPgetGap(scip);
+	return SCIPisInfinity(scip, gap) ? std::numeric_limits<double>::infinity() : gap;
+}
+
+/**
+ * Aggregate the statistics of the search that SCIP does not keep.
+ *
+ * Statistics are reset when solving starts, and updated in constant time at every event.
+ */
+class TreeEventHandler : public ::scip::ObjEventhdlr {
+public:
+	inline static auto constexpr name = "ecole::observation::TreeStatistics::TreeEventHandler";
+
+	TreeEventHandler(SCIP* scip) : ObjEventhdlr(scip, name, "Event handler for the statistics of the search tree") {}
+
+	/** Include the handler in the model, unless already there. */
+	static void include(scip::Model& model) {
+		auto* const scip = model.get_scip_ptr();
+		if (SCIPfindObjEventhdlr(scip, name) == nullptr) {
+			auto handler = std::make_unique<TreeEventHandler>(scip);
+			scip::call(SCIPincludeObjEventhdlr, scip, handler.get(), true);
+			// NOLINTNEXTLINE memory ownership is passed to SCIP
+			handler.release();
+		}
+	}
+
+	/** Find the handler of the model, or null if it was not included. */
+	static auto find(scip::Model& model) -> TreeEventHandler const* {
+		return dynamic_cast<TreeEventHandler const*>(SCIPfindObjEventhdlr(model.get_scip_ptr(), name));
+	}
+
+	/** Reset the statistics and catch node and solution events. */
+	auto scip_initsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE override {
+		focus_depths = {};
+		leaf_depths = {};
+		n_branched = 0;
+		n_backtracks = 0;
+		last_focus = -1;
+		// Solutions may have been found during presolving
+		gap_at_last_incumbent = SCIPgetNSols(scip) > 0 ? get_gap(scip) : std::numeric_limits<double>::infinity();
+		return SCIPcatchEvent(scip, events, eventhdlr, nullptr, nullptr);
+	}
+
+	/** Drop node and solution events. */
+	auto scip_exitsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE override {
+		return SCIPdropEvent(scip, events, eventhdlr, nullptr, -1);
+	}
+
+	auto scip_exec(SCIP* scip, SCIP_EVENTHDLR* /*eventhdlr*/, SCIP_EVENT* event, SCIP_EVENTDATA* /*eventdata*/)
+		-> SCIP_RETCODE override {
+		auto const type = SCIPeventGetType(event);
+		if ((type & SCIP_EVENTTYPE_BESTSOLFOUND) != 0) {
+			gap_at_last_incumbent = get_gap(scip);
+			return SCIP_OKAY;
+		}
+		auto* const node = SCIPeventGetNode(event);
+		auto const depth = static_cast<double>(SCIPnodeGetDepth(node));
+		switch (type) {
+		case SCIP_EVENTTYPE_NODEFOCUSED: {
+			focus_depths.add(depth);
+			// Nodes are compared by number, since the previous focus node may have been freed
+			auto* const parent = SCIPnodeGetParent(node);
+			if (last_focus >= 0 && (parent == nullptr || SCIPnodeGetNumber(parent) != last_focus)) {
+				++n_backtracks;
+			}
+			last_focus = SCIPnodeGetNumber(node);
+			break;
+		}
+		case SCIP_EVENTTYPE_NODEFEASIBLE:
+		case SCIP_EVENTTYPE_NODEINFEASIBLE:
+			leaf_depths.add(depth);
+			break;
+		case SCIP_EVENTTYPE_NODEBRANCHED:
+			++n_branched;
+			break;
+		default:
+			break;
+		}
+		return SCIP_OKAY;
+	}
+
+	/** Write the aggregated statistics in the features. */
+	template <typename Tensor> void set_features(Tensor&& out) const noexcept {
+		auto const focus_stats = focus_depths.stats();
+		out[idx(Features::focus_depth_mean)] = focus_stats.mean;
+		out[idx(Features::focus_depth_stddev)] = focus_stats.stddev;
+		out[idx(Features::leaf_depth_mean)] = leaf_depths.stats().mean;
+		out[idx(Features::n_branched_nodes)] = static_cast<double>(n_branched);
+		out[idx(Features::n_backtracks)] = static_cast<double>(n_backtracks);
+		out[idx(Features::gap_at_last_incumbent)] = gap_at_last_incumbent;
+	}
+
+private:
+	static inline auto constexpr events = SCIP_EVENTTYPE_NODEFOCUSED | SCIP_EVENTTYPE_NODEFEASIBLE |
+										  SCIP_EVENTTYPE_NODEINFEASIBLE | SCIP_EVENTTYPE_NODEBRANCHED |
+										  SCIP_EVENTTYPE_BESTSOLFOUND;
+
+	utility::StatsAccumulator<double> focus_depths;
+	utility::StatsAccumulator<double> leaf_depths;
+	std::size_t n_branched = 0;
+	std::size_t n_backtracks = 0;
+	SCIP_Longint last_focus = -1;
+	double gap_at_last_incumbent = std::numeric_limits<double>::infinity();
+};
+
+/** Write the aggregated statistics in the features, or NaN if the model has no handler. */
+template <typename Tensor> void set_aggregated_features(TreeEventHandler const* handler, Tensor&& out) noexcept {
+	if (handler != nullptr) {
+		handler->set_features(out);
+		return;
+	}
+	auto constexpr aggregated = std::array{
+		Features::focus_depth_mean,
+		Features::focus_depth_stddev,
+		Features::leaf_depth_mean,
+		Features::n_branched_nodes,
+		Features::n_backtracks,
+		Features::gap_at_last_incumbent,
+	};
+	for (auto const feature : aggregated) {
+		out[idx(feature)] = std::numeric_limits<double>::quiet_NaN();
+	}
+}
+
+}  // namespace
+
+auto TreeStatistics::before_reset(scip::Model& model) -> void {
+	TreeEventHandler::include(model);
+}
+
+auto TreeStatistics::extract(scip::Model& model, bool /* done */) -> std::optional<TreeStatisticsObs> {
+	if (model.stage() != SCIP_STAGE_SOLVING) {
+		return {};
+	}
+	auto* const scip = model.get_scip_ptr();
+	auto features = xt::xtensor<double, 1>::from_shape({TreeStatisticsObs::n_features});
+
+	// Statistics that SCIP keeps are read in constant time
+	auto const n_nodes = SCIPgetNNodes(scip);
+	auto* const incumbent = SCIPgetBestSol(scip);
+	features[idx(Features::n_nodes)] = static_cast<double>(n_nodes);
+	features[idx(Features::n_open_nodes)] = static_cast<double>(SCIPgetNNodesLeft(scip));
+	features[idx(Features::focus_depth)] = static_cast<double>(SCIPgetDepth(scip));
+	features[idx(Features::max_depth)] = static_cast<double>(SCIPgetMaxDepth(scip));
+	features[idx(Features::n_feasible_leaves)] = static_cast<double>(SCIPgetNFeasibleLeaves(scip));
+	features[idx(Features::n_infeasible_leaves)] = static_cast<double>(SCIPgetNInfeasibleLeaves(scip));
+	features[idx(Features::n_incumbents)] = static_cast<double>(SCIPgetNBestSolsFound(scip));
+	features[idx(Features::nodes_since_incumbent)] =
+		static_cast<double>(incumbent != nullptr ? n_nodes - SCIPsolGetNodenum(incumbent) : n_nodes);
+	features[idx(Features::gap)] = get_gap(scip);
+
+	// Handlers cannot be included while solving, so the model of an episode not reset by the function has none
+	set_aggregated_features(TreeEventHandler::find(model), features);
+	return {{std::move(features)}};
+}
+
+}  // namespace ecole::observation
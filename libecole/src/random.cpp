@@ -1,6 +1,15 @@
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <ios>
 #include <locale>
-#include <mutex>
+#include <random>
 #include <sstream>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
 
 #include "ecole/random.hpp"
 
@@ -13,17 +22,49 @@ public:
 
 	auto seed(Seed val) -> void;
 	auto spawn() -> RandomGenerator;
+	auto spawn(std::uint64_t stream) -> RandomGenerator;
 
 private:
-	std::mutex m;
-	Seed user_seed = 0;
-	Seed spawn_seed = 0;
+	// Atomics rather than a mutex, so that threads spawning random generators do not contend
+	std::atomic<Seed> user_seed = 0;
+	std::atomic<Seed> spawn_seed = 0;
 
 	RandomGeneratorManager();
-
-	auto new_seed_seq() -> std::seed_seq;
 };
 
+/** The number of values drawn from a random generator to derive others from it. */
+constexpr std::size_t n_derive_words = 4;
+
+/** Distinguish streams from successive spawns, which use seed sequences of a different length. */
+constexpr Seed stream_tag = 0x5EED5;
+
+auto low_word(std::uint64_t value) noexcept -> Seed {
+	return static_cast<Seed>(value & 0xFFFFFFFFU);
+}
+
+auto high_word(std::uint64_t value) noexcept -> Seed {
+	return static_cast<Seed>(value >> 32U);
+}
+
+/** Identify the binary format, in case it changes. */
+constexpr std::array<char, 4> binary_header = {'E', 'M', 'T', '1'};
+constexpr std::size_t binary_size = binary_header.size() + 4 * (RandomGenerator::state_size + 1);
+
+auto write_word(char* out, std::uint32_t word) noexcept -> char* {
+	for (unsigned int shift = 0; shift < 32; shift += 8) {
+		*(out++) = static_cast<char>((word >> shift) & 0xFFU);
+	}
+	return out;
+}
+
+auto read_word(char const* in) noexcept -> std::uint32_t {
+	auto word = std::uint32_t{0};
+	for (unsigned int shift = 0; shift < 32; shift += 8) {
+		word |= static_cast<std::uint32_t>(static_cast<unsigned char>(*(in++))) << shift;
+	}
+	return word;
+}
+
 }  // namespace
 
 auto seed(Seed val) -> void {
@@ -34,7 +75,84 @@ auto spawn_random_generator() -> RandomGenerator {
 	return RandomGeneratorManager::get().spawn();
 }
 
-// Not efficient, but operator<< is the only thing we have
+auto spawn_random_generator(std::uint64_t stream) -> RandomGenerator {
+	return RandomGeneratorManager::get().spawn(stream);
+}
+
+auto derive_random_generator(RandomGenerator const& rng, std::uint64_t stream) -> RandomGenerator {
+	// Draw from a copy to leave the parent unchanged
+	auto parent = rng;
+	auto words = std::array<Seed, n_derive_words>{};
+	for (auto& word : words) {
+		word = parent();
+	}
+	auto seeds = std::seed_seq{words[0], words[1], words[2], words[3], low_word(stream), high_word(stream)};
+	return RandomGenerator{seeds};
+}
+
+auto split_random_generator(RandomGenerator& rng, std::size_t n) -> std::vector<RandomGenerator> {
+	auto rngs = std::vector<RandomGenerator>{};
+	rngs.reserve(n);
+	for (std::size_t i = 0; i < n; ++i) {
+		rngs.push_back(derive_random_generator(rng, i));
+	}
+	rng.discard(n_derive_words);
+	return rngs;
+}
+
+auto RandomGenerator::state() const noexcept -> State {
+	auto state = State{};
+	for (std::size_t i = 0; i < state_size; ++i) {
+		state.words[i] = static_cast<std::uint32_t>(m_words[i]);
+	}
+	state.position = m_position;
+	return state;
+}
+
+void RandomGenerator::set_state(State const& state) {
+	if (state.position > state_size) {
+		throw std::invalid_argument{"RandomGenerator state position is past its words."};
+	}
+	for (std::size_t i = 0; i < state_size; ++i) {
+		m_words[i] = state.words[i];
+	}
+	m_position = state.position;
+}
+
+auto operator<<(std::ostream& os, RandomGenerator const& rng) -> std::ostream& {
+	auto const flags = os.flags(std::ios_base::dec | std::ios_base::left);
+	auto const fill = os.fill(os.widen(' '));
+	for (auto const word : rng.m_words) {
+		os << word << os.widen(' ');
+	}
+	os << rng.m_position;
+	os.flags(flags);
+	os.fill(fill);
+	return os;
+}
+
+auto operator>>(std::istream& is, RandomGenerator& rng) -> std::istream& {
+	auto const flags = is.flags(std::ios_base::dec | std::ios_base::skipws);
+	auto state = RandomGenerator::State{};
+	for (auto& word : state.words) {
+		is >> word;
+	}
+	if (is) {
+		// Other standard libraries do not write the position, meaning the words are to be twisted
+		if (!(is >> state.position)) {
+			state.position = RandomGenerator::state_size;
+			is.clear(is.rdstate() & ~std::ios_base::failbit);
+		}
+		if (state.position > RandomGenerator::state_size) {
+			is.setstate(std::ios_base::failbit);
+		} else {
+			rng.set_state(state);
+		}
+	}
+	is.flags(flags);
+	return is;
+}
+
 auto serialize(RandomGenerator const& rng) -> std::string {
 	auto osstream = std::ostringstream{};
 	osstream.imbue(std::locale("C"));
@@ -42,7 +160,6 @@ auto serialize(RandomGenerator const& rng) -> std::string {
 	return std::move(osstream).str();
 }
 
-// Not efficient, but operator>> is the only thing we have
 auto deserialize(std::string const& data) -> RandomGenerator {
 	auto rng = RandomGenerator{};  // NOLINT need not be seeded since we set its state
 	auto isstream = std::istringstream{data};
@@ -51,6 +168,33 @@ auto deserialize(std::string const& data) -> RandomGenerator {
 	return rng;
 }
 
+auto serialize_binary(RandomGenerator const& rng) -> std::string {
+	auto const state = rng.state();
+	auto data = std::string(binary_size, '\0');
+	auto* out = std::copy(binary_header.begin(), binary_header.end(), data.data());
+	for (auto const word : state.words) {
+		out = write_word(out, word);
+	}
+	write_word(out, static_cast<std::uint32_t>(state.position));
+	return data;
+}
+
+auto deserialize_binary(std::string_view data) -> RandomGenerator {
+	if (data.size() != binary_size || !std::equal(binary_header.begin(), binary_header.end(), data.begin())) {
+		throw std::invalid_argument{"Data does not represent a RandomGenerator."};
+	}
+	auto state = RandomGenerator::State{};
+	auto const* in = data.data() + binary_header.size();
+	for (auto& word : state.words) {
+		word = read_word(in);
+		in += 4;
+	}
+	state.position = read_word(in);
+	auto rng = RandomGenerator{};
+	rng.set_state(state);
+	return rng;
+}
+
 /*******************************************
  *  Implementation of RandomGeneratorManager  *
  *******************************************/
@@ -63,22 +207,22 @@ auto RandomGeneratorManager::get() -> RandomGeneratorManager& {
 }
 
 auto RandomGeneratorManager::seed(Seed val) -> void {
-	auto const lk = std::unique_lock{m};
+	// Seeding while other threads spawn random generators is not deterministic anyway
 	user_seed = val;
 	spawn_seed = 0;
 }
 
 auto RandomGeneratorManager::spawn() -> RandomGenerator {
-	auto seeds = new_seed_seq();
+	auto seeds = std::seed_seq{user_seed.load(), spawn_seed.fetch_add(1) + 1};
 	return RandomGenerator{seeds};
 }
 
-RandomGeneratorManager::RandomGeneratorManager() : user_seed{std::random_device{}()} {}
-
-auto RandomGeneratorManager::new_seed_seq() -> std::seed_seq {
-	auto const lk = std::unique_lock{m};
-	return {user_seed, ++spawn_seed};
+auto RandomGeneratorManager::spawn(std::uint64_t stream) -> RandomGenerator {
+	auto seeds = std::seed_seq{user_seed.load(), stream_tag, low_word(stream), high_word(stream)};
+	return RandomGenerator{seeds};
 }
 
+RandomGeneratorManager::RandomGeneratorManager() : user_seed{std::random_device{}()} {}
+
 }  // namespace
 }  // namespace ecole
@@ -1,8 +1,17 @@
+#include <algorithm>
+#include <cassert>
 #include <chrono>
+#include <cstddef>
+#include <limits>
 #include <memory>
-#include <mutex>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
 #include <vector>
 
+#include <fmt/format.h>
+
 #include "scip/scip.h"
 #include "scip/type_event.h"
 #include <objscip/objeventhdlr.h>
@@ -11,31 +20,71 @@
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/utils.hpp"
 #include "ecole/utility/chrono.hpp"
+#include "ecole/utility/tracing.hpp"
+#include "ecole/utility/unreachable.hpp"
 
 namespace ecole::reward {
 
 namespace {
 
-/*****************************************
- *  Declaration of IntegralEventHanlder  *
- *****************************************/
+/** The value integrated over time, given the current bounds. */
+struct Integrand {
+	Bound bound;
+	SCIP_OBJSENSE obj_sense;
+	SCIP_Real offset;
+	SCIP_Real initial_primal_bound;
+	SCIP_Real initial_dual_bound;
+
+	[[nodiscard]] auto operator()(SCIP_Real primal_bound, SCIP_Real dual_bound) const noexcept -> SCIP_Real {
+		auto const minimize = obj_sense == SCIP_OBJSENSE_MINIMIZE;
+		switch (bound) {
+		case Bound::dual:
+			if (minimize) {
+				return offset - std::max(dual_bound, initial_dual_bound);
+			}
+			return -(offset - std::min(dual_bound, initial_dual_bound));
+		case Bound::primal:
+			if (minimize) {
+				return -(offset - std::min(primal_bound, initial_primal_bound));
+			}
+			return offset - std::max(primal_bound, initial_primal_bound);
+		case Bound::primal_dual:
+			if (minimize) {
+				return -(std::max(dual_bound, initial_dual_bound) - std::min(primal_bound, initial_primal_bound));
+			}
+			return std::min(dual_bound, initial_dual_bound) - std::max(primal_bound, initial_primal_bound);
+		}
+		utility::unreachable();
+	}
+};
 
-class IntegralEventHandler : public ::scip::ObjEventhdlr {
+enum struct Clock { cpu, wall, coarse_wall, thread_cpu };
+
+/**************************************
+ *  Declaration of BoundEventHandler  *
+ **************************************/
+
+/**
+ * Collect the bounds and times of a model once for all bound integrals.
+ *
+ * There is one handler per model for every clock and dual bound event, so that integrals used together, such as in a
+ * TupleFunction, catch each event and read the clock and bounds only once.
+ * Every integral subscribes an accumulator, which receives the integral of its integrand at every event.
+ */
+class BoundEventHandler : public ::scip::ObjEventhdlr {
 public:
-	inline static auto constexpr base_name = "ecole::reward::IntegralEventHandler";
-	inline static auto integral_reward_function_counter = 0;
+	BoundEventHandler(SCIP* scip, Clock clock_, SCIP_EVENTTYPE dual_event_, const char* name_) :
+		ObjEventhdlr(scip, name_, "Event handler for primal and dual integrals"), clock{clock_}, dual_event{dual_event_} {}
 
-	IntegralEventHandler(SCIP* scip, bool wall_, bool extract_primal_, bool extract_dual_, const char* name_) :
-		ObjEventhdlr(scip, name_, "Event handler for primal and dual integrals"),
-		wall{wall_},
-		extract_primal{extract_primal_},
-		extract_dual{extract_dual_} {}
+	~BoundEventHandler() override = default;
 
-	~IntegralEventHandler() override = default;
+	/** Find the handler of the model with the given name, creating it if needed. */
+	static auto get(scip::Model& model, Clock clock, SCIP_EVENTTYPE dual_event, std::string const& name)
+		-> BoundEventHandler&;
+	/** Find the handler of the model with the given name. */
+	static auto get(scip::Model& model, std::string const& name) -> BoundEventHandler&;
 
-	[[nodiscard]] std::vector<std::chrono::nanoseconds> const& get_times() const noexcept { return times; }
-	[[nodiscard]] std::vector<SCIP_Real> const& get_primal_bounds() const noexcept { return primal_bounds; }
-	[[nodiscard]] std::vector<SCIP_Real> const& get_dual_bounds() const noexcept { return dual_bounds; }
+	[[nodiscard]] auto get_history() const noexcept -> BoundHistory const& { return history; }
 
 	/** Catch primal and dual related events. */
 	SCIP_RETCODE scip_init(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) override;
@@ -44,48 +93,74 @@ public:
 	/* Call extract_metrics() to obtain bounds/times at events. */
 	SCIP_RETCODE scip_exec(SCIP* scip, SCIP_EVENTHDLR* eventhdlr, SCIP_EVENT* event, SCIP_EVENTDATA* eventdata) override;
 
-	/** Get and adds primal/dual bounds and times to vectors. */
+	/**
+	 * Start accumulating the integral of the integrand from now on, returning the index of the accumulator.
+	 *
+	 * Integrals must subscribe before solving starts, so that the events they need are caught.
+	 */
+	auto subscribe(SCIP* scip, Integrand integrand, bool keep_history_) -> std::size_t;
+	/** Integrate the previous bounds until now, and update the bounds changed by the event. */
 	void extract_metrics(SCIP* scip, SCIP_EVENTTYPE event_type = 0);
-	void clear_bounds();
+	/** Return the integral accumulated since the last call. */
+	auto take_integral(std::size_t accumulator) noexcept -> SCIP_Real;
 
 private:
-	bool wall;
-	bool extract_primal;
-	bool extract_dual;
-	std::vector<std::chrono::nanoseconds> times;
-	std::vector<SCIP_Real> primal_bounds;
-	std::vector<SCIP_Real> dual_bounds;
+	struct Accumulator {
+		Integrand integrand;
+		SCIP_Real integral = 0.;
+	};
+
+	Clock clock;
+	/** Read from the solver and environment threads with Clock::thread_cpu. */
+	utility::ThreadsCpuTimer timer;
+	SCIP_EVENTTYPE dual_event;
+	bool keep_history = false;
+	bool extract_primal = false;
+	bool extract_dual = false;
+	bool primal_known = false;
+	bool dual_known = false;
+	std::optional<std::chrono::nanoseconds> last_time;
+	SCIP_Real primal_bound = 0.;
+	SCIP_Real dual_bound = 0.;
+	std::vector<Accumulator> accumulators;
+	BoundHistory history;
+
+	auto time_now() -> std::chrono::nanoseconds;
+	void integrate_until(std::chrono::nanoseconds now);
+	void update_bounds(SCIP* scip, SCIP_EVENTTYPE event_type);
+	void record_history(std::chrono::nanoseconds now);
 };
 
-/********************************************
- *  Implementation of IntegralEventHanlder  *
- ********************************************/
+/*****************************************
+ *  Implementation of BoundEventHandler  *
+ *****************************************/
 
-auto IntegralEventHandler::scip_init(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE {
+auto BoundEventHandler::scip_init(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE {
 	if (extract_primal) {
 		SCIP_CALL(SCIPcatchEvent(scip, SCIP_EVENTTYPE_BESTSOLFOUND, eventhdlr, nullptr, nullptr));
 	}
 	if (extract_dual) {
-		SCIP_CALL(SCIPcatchEvent(scip, SCIP_EVENTTYPE_LPEVENT, eventhdlr, nullptr, nullptr));
+		SCIP_CALL(SCIPcatchEvent(scip, dual_event, eventhdlr, nullptr, nullptr));
 	}
 	return SCIP_OKAY;
 }
 
-auto IntegralEventHandler::scip_exit(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE {
+auto BoundEventHandler::scip_exit(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE {
 	if (extract_primal) {
 		SCIP_CALL(SCIPdropEvent(scip, SCIP_EVENTTYPE_BESTSOLFOUND, eventhdlr, nullptr, -1));
 	}
 	if (extract_dual) {
-		SCIP_CALL(SCIPdropEvent(scip, SCIP_EVENTTYPE_LPEVENT, eventhdlr, nullptr, -1));
+		SCIP_CALL(SCIPdropEvent(scip, dual_event, eventhdlr, nullptr, -1));
 	}
 	return SCIP_OKAY;
 }
 
-auto IntegralEventHandler::scip_exec(
+auto BoundEventHandler::scip_exec(
 	SCIP* scip,
 	SCIP_EVENTHDLR* /*eventhdlr*/,
 	SCIP_EVENT* event,
 	SCIP_EVENTDATA* /*eventdata*/) -> SCIP_RETCODE {
+	ECOLE_TRACE_SPAN("BoundEventHandler::scip_exec");
 	extract_metrics(scip, SCIPeventGetType(event));
 	return SCIP_OKAY;
 }
@@ -127,137 +202,108 @@ auto get_dual_bound(SCIP* scip) {
 	}
 }
 
-auto time_now(bool wall) -> std::chrono::nanoseconds {
-	if (wall) {
+auto BoundEventHandler::time_now() -> std::chrono::nanoseconds {
+	switch (clock) {
+	case Clock::wall:
 		return std::chrono::steady_clock::now().time_since_epoch();
+	case Clock::coarse_wall:
+		return utility::coarse_steady_clock::now().time_since_epoch();
+	case Clock::cpu:
+		return utility::cpu_clock::now().time_since_epoch();
+	case Clock::thread_cpu:
+		return timer.elapsed();
 	}
-	return utility::cpu_clock::now().time_since_epoch();
-}
-
-auto is_lp_event(SCIP_EVENTTYPE event) {
-	return event & SCIP_EVENTTYPE_LPEVENT;
+	utility::unreachable();
 }
 
 auto is_bestsol_event(SCIP_EVENTTYPE event) {
 	return event & SCIP_EVENTTYPE_BESTSOLFOUND;
 }
 
-void IntegralEventHandler::extract_metrics(SCIP* scip, SCIP_EVENTTYPE event_type) {
-	if (extract_primal) {
-		if ((is_bestsol_event(event_type)) || (primal_bounds.empty())) {
-			primal_bounds.push_back(get_primal_bound(scip));
-		} else {
-			primal_bounds.push_back(primal_bounds.back());
-		}
+void BoundEventHandler::update_bounds(SCIP* scip, SCIP_EVENTTYPE event_type) {
+	if (extract_primal && (is_bestsol_event(event_type) || !primal_known)) {
+		primal_bound = get_primal_bound(scip);
+		primal_known = true;
 	}
-	if (extract_dual) {
-		if ((is_lp_event(event_type)) || (dual_bounds.empty())) {
-			dual_bounds.push_back(get_dual_bound(scip));
-		} else {
-			dual_bounds.push_back(dual_bounds.back());
-		}
+	if (extract_dual && ((event_type & dual_event) != 0 || !dual_known)) {
+		dual_bound = get_dual_bound(scip);
+		dual_known = true;
 	}
-	times.push_back(time_now(wall));
 }
 
-void IntegralEventHandler::clear_bounds() {
-	if (extract_dual) {
-		auto last_dual = dual_bounds.back();
-		dual_bounds.clear();
-		dual_bounds.push_back(last_dual);
-	}
-	if (extract_primal) {
-		auto last_primal = primal_bounds.back();
-		primal_bounds.clear();
-		primal_bounds.push_back(last_primal);
+void BoundEventHandler::integrate_until(std::chrono::nanoseconds now) {
+	// The bounds are constant since the previous event, so the integrals are exact
+	if (last_time.has_value()) {
+		auto const time_diff = std::chrono::duration<double>(now - last_time.value()).count();
+		for (auto& accumulator : accumulators) {
+			accumulator.integral += accumulator.integrand(primal_bound, dual_bound) * time_diff;
+		}
 	}
-	auto last_time = times.back();
-	times.clear();
-	times.push_back(last_time);
+	last_time = now;
 }
 
-/*************************************
- *  Implementation of BoundIntegral  *
- *************************************/
-
-auto compute_dual_integral(
-	std::vector<SCIP_Real> const& dual_bounds,
-	std::vector<std::chrono::nanoseconds> const& times,
-	SCIP_Real const offset,
-	SCIP_Real const initial_dual_bound,
-	SCIP_Objsense obj_sense) {
-	SCIP_Real dual_integral = 0.0;
-	for (std::size_t i = 0; i < dual_bounds.size() - 1; ++i) {
-		auto const time_diff = std::chrono::duration<double>(times[i + 1] - times[i]).count();
-		auto const dual_bound = dual_bounds[i];
-		if (obj_sense == SCIP_OBJSENSE_MINIMIZE) {
-			dual_integral += (offset - std::max(dual_bound, initial_dual_bound)) * time_diff;
-		} else {
-			dual_integral += -(offset - std::min(dual_bound, initial_dual_bound)) * time_diff;
-		}
+void BoundEventHandler::record_history(std::chrono::nanoseconds now) {
+	if (keep_history) {
+		// Bounds that no integral uses are not read
+		auto constexpr nan = std::numeric_limits<Reward>::quiet_NaN();
+		history.times.push_back(now);
+		history.primal_bounds.push_back(extract_primal ? primal_bound : nan);
+		history.dual_bounds.push_back(extract_dual ? dual_bound : nan);
 	}
-	return dual_integral;
 }
 
-auto compute_primal_integral(
-	std::vector<SCIP_Real> const& primal_bounds,
-	std::vector<std::chrono::nanoseconds> const& times,
-	SCIP_Real const offset,
-	SCIP_Real const initial_primal_bound,
-	SCIP_Objsense obj_sense) {
-	SCIP_Real primal_integral = 0.0;
-	for (std::size_t i = 0; i < primal_bounds.size() - 1; ++i) {
-		auto const time_diff = std::chrono::duration<double>(times[i + 1] - times[i]).count();
-		auto const primal_bound = primal_bounds[i];
-		if (obj_sense == SCIP_OBJSENSE_MINIMIZE) {
-			primal_integral += -(offset - std::min(primal_bound, initial_primal_bound)) * time_diff;
-		} else {
-			primal_integral += (offset - std::max(primal_bound, initial_primal_bound)) * time_diff;
-		}
-	}
-	return primal_integral;
+void BoundEventHandler::extract_metrics(SCIP* scip, SCIP_EVENTTYPE event_type) {
+	auto const now = time_now();
+	integrate_until(now);
+	update_bounds(scip, event_type);
+	record_history(now);
 }
 
-auto compute_primal_dual_integral(
-	std::vector<SCIP_Real> const& primal_bounds,
-	std::vector<SCIP_Real> const& dual_bounds,
-	std::vector<std::chrono::nanoseconds> const& times,
-	SCIP_Real const initial_primal_bound,
-	SCIP_Real const initial_dual_bound,
-	SCIP_Objsense obj_sense) {
-	SCIP_Real primal_dual_integral = 0.0;
-
-	for (std::size_t i = 0; i < primal_bounds.size() - 1; ++i) {
-		auto const time_diff = std::chrono::duration<double>(times[i + 1] - times[i]).count();
-		auto const dual_bound = dual_bounds[i];
-		auto const primal_bound = primal_bounds[i];
-		if (obj_sense == SCIP_OBJSENSE_MINIMIZE) {
-			primal_dual_integral +=
-				-(std::max(dual_bound, initial_dual_bound) - std::min(primal_bound, initial_primal_bound)) * time_diff;
-		} else {
-			primal_dual_integral +=
-				(std::min(dual_bound, initial_dual_bound) - std::max(primal_bound, initial_primal_bound)) * time_diff;
-		}
-	}
-	return primal_dual_integral;
+auto BoundEventHandler::subscribe(SCIP* scip, Integrand integrand, bool keep_history_) -> std::size_t {
+	// Bring other integrals up to date so that the new one starts now
+	auto const now = time_now();
+	integrate_until(now);
+	extract_primal = extract_primal || integrand.bound != Bound::dual;
+	extract_dual = extract_dual || integrand.bound != Bound::primal;
+	keep_history = keep_history || keep_history_;
+	update_bounds(scip, 0);
+	record_history(now);
+	accumulators.push_back({integrand});
+	return accumulators.size() - 1;
 }
 
-/** Return the integral event handler */
-auto get_eventhdlr(scip::Model& model, const char* name) -> auto& {
-	auto* const base_handler = SCIPfindObjEventhdlr(model.get_scip_ptr(), name);
+auto BoundEventHandler::take_integral(std::size_t accumulator) noexcept -> SCIP_Real {
+	return std::exchange(accumulators[accumulator].integral, 0.);
+}
+
+auto BoundEventHandler::get(scip::Model& model, std::string const& name) -> BoundEventHandler& {
+	auto* const base_handler = SCIPfindObjEventhdlr(model.get_scip_ptr(), name.c_str());
 	assert(base_handler != nullptr);
-	auto* const handler = dynamic_cast<IntegralEventHandler*>(base_handler);
+	auto* const handler = dynamic_cast<BoundEventHandler*>(base_handler);
 	assert(handler != nullptr);
 	return *handler;
 }
 
-/** Add the integral event handler to the model. */
-void add_eventhdlr(scip::Model& model, bool wall, bool extract_primal, bool extract_dual, const char* name) {
-	auto handler = std::make_unique<IntegralEventHandler>(model.get_scip_ptr(), wall, extract_primal, extract_dual, name);
-	scip::call(SCIPincludeObjEventhdlr, model.get_scip_ptr(), handler.get(), true);
-	// NOLINTNEXTLINE memory ownership is passed to SCIP
-	handler.release();
-	// NOLINTNEXTLINE memory ownership is passed to SCIP
+auto BoundEventHandler::get(scip::Model& model, Clock clock, SCIP_EVENTTYPE dual_event, std::string const& name)
+	-> BoundEventHandler& {
+	if (SCIPfindObjEventhdlr(model.get_scip_ptr(), name.c_str()) == nullptr) {
+		auto handler = std::make_unique<BoundEventHandler>(model.get_scip_ptr(), clock, dual_event, name.c_str());
+		scip::call(SCIPincludeObjEventhdlr, model.get_scip_ptr(), handler.get(), true);
+		// NOLINTNEXTLINE memory ownership is passed to SCIP
+		handler.release();
+	}
+	return get(model, name);
+}
+
+auto clock_of(bool wall, bool coarse_clock, bool thread_cpu_clock) noexcept -> Clock {
+	if (wall) {
+		return coarse_clock ? Clock::coarse_wall : Clock::wall;
+	}
+	return thread_cpu_clock ? Clock::thread_cpu : Clock::cpu;
+}
+
+auto event_of(DualBoundEvent dual_bound_event) noexcept -> SCIP_EVENTTYPE {
+	return dual_bound_event == DualBoundEvent::node ? SCIP_EVENTTYPE_NODESOLVED : SCIP_EVENTTYPE_LPEVENT;
 }
 
 /** Default function for returning +/-infinity for the bounds in computing primal-dual integral. */
@@ -287,7 +333,24 @@ auto default_primal_dual_bound_function(scip::Model& model) -> std::tuple<Reward
 }  // namespace
 
 template <Bound bound>
-ecole::reward::BoundIntegral<bound>::BoundIntegral(bool wall_, const BoundFunction& bound_function_) : wall{wall_} {
+ecole::reward::BoundIntegral<bound>::BoundIntegral(
+	bool wall_,
+	const BoundFunction& bound_function_,
+	bool keep_history_,
+	DualBoundEvent dual_bound_event_,
+	bool coarse_clock_,
+	bool thread_cpu_clock_) :
+	wall{wall_},
+	keep_history{keep_history_},
+	dual_bound_event{dual_bound_event_},
+	coarse_clock{coarse_clock_},
+	thread_cpu_clock{thread_cpu_clock_} {
+	if (coarse_clock && !wall) {
+		throw std::invalid_argument{"The coarse clock only measures wall time."};
+	}
+	if (thread_cpu_clock && wall) {
+		throw std::invalid_argument{"The thread CPU clock cannot measure wall time."};
+	}
 	if constexpr (bound == Bound::dual) {
 		bound_function = bound_function_ ? bound_function_ : default_dual_bound_function;
 	} else if constexpr (bound == Bound::primal) {
@@ -296,53 +359,39 @@ ecole::reward::BoundIntegral<bound>::BoundIntegral(bool wall_, const BoundFuncti
 		bound_function = bound_function_ ? bound_function_ : default_primal_dual_bound_function;
 	}
 
-	static auto m = std::mutex{};
-	auto g = std::lock_guard{m};
-	name = IntegralEventHandler::base_name + std::to_string(IntegralEventHandler::integral_reward_function_counter);
-	IntegralEventHandler::integral_reward_function_counter++;
+	// Integrals with the same clock and events share their event handler
+	name = fmt::format(
+		"ecole::reward::BoundEventHandler/{}/{}",
+		static_cast<int>(clock_of(wall, coarse_clock, thread_cpu_clock)),
+		event_of(dual_bound_event));
 }
 
 template <Bound bound> void BoundIntegral<bound>::before_reset(scip::Model& model) {
 	// Initalize bounds and event handler
 	if constexpr (bound == Bound::dual) {
 		std::tie(offset, initial_dual_bound) = bound_function(model);
-		add_eventhdlr(model, wall, false, true, name.c_str());
 	} else if constexpr (bound == Bound::primal) {
 		std::tie(offset, initial_primal_bound) = bound_function(model);
-		add_eventhdlr(model, wall, true, false, name.c_str());
 	} else if constexpr (bound == Bound::primal_dual) {
 		std::tie(initial_primal_bound, initial_dual_bound) = bound_function(model);
-		add_eventhdlr(model, wall, true, true, name.c_str());
 	}
-
-	// Extract metrics before resetting to get initial reference point
-	get_eventhdlr(model, name.c_str()).extract_metrics(model.get_scip_ptr());
+	auto const integrand = Integrand{
+		bound, SCIPgetObjsense(model.get_scip_ptr()), offset, initial_primal_bound, initial_dual_bound};
+	auto const clock = clock_of(wall, coarse_clock, thread_cpu_clock);
+	auto& handler = BoundEventHandler::get(model, clock, event_of(dual_bound_event), name);
+	// Subscribing takes the initial reference point
+	accumulator = handler.subscribe(model.get_scip_ptr(), integrand, keep_history);
 }
 
 template <Bound bound> Reward BoundIntegral<bound>::extract(scip::Model& model, bool /*done*/) {
-	// Get info from event handler
-	auto& handler = get_eventhdlr(model, name.c_str());
+	// Integrate until now, the rest of the integral was accumulated at every event
+	auto& handler = BoundEventHandler::get(model, name);
 	handler.extract_metrics(model.get_scip_ptr());
+	return static_cast<Reward>(handler.take_integral(accumulator));
+}
 
-	auto const& dual_bounds = handler.get_dual_bounds();
-	auto const& primal_bounds = handler.get_primal_bounds();
-	auto const& times = handler.get_times();
-	auto const obj_sense = SCIPgetObjsense(model.get_scip_ptr());
-
-	// Compute primal integral and difference
-	SCIP_Real integral = 0.;
-	if constexpr (bound == Bound::dual) {
-		integral = compute_dual_integral(dual_bounds, times, offset, initial_dual_bound, obj_sense);
-	} else if constexpr (bound == Bound::primal) {
-		integral = compute_primal_integral(primal_bounds, times, offset, initial_primal_bound, obj_sense);
-	} else if constexpr (bound == Bound::primal_dual) {
-		integral = compute_primal_dual_integral(
-			primal_bounds, dual_bounds, times, initial_primal_bound, initial_dual_bound, obj_sense);
-	}
-
-	// Reset arrays for storing bounds
-	handler.clear_bounds();
-	return static_cast<Reward>(integral);
+template <Bound bound> auto BoundIntegral<bound>::history(scip::Model& model) const -> BoundHistory const& {
+	return BoundEventHandler::get(model, name).get_history();
 }
 
 template class BoundIntegral<Bound::primal>;
@@ -1,27 +1,85 @@
 #include <chrono>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+#include <fmt/format.h>
+#include <objscip/objeventhdlr.h>
+#include <scip/scip.h>
 
 #include "ecole/reward/solving-time.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
 #include "ecole/utility/chrono.hpp"
 
 namespace ecole::reward {
 
 namespace {
 
-auto time_now(bool wall) -> std::chrono::nanoseconds {
+/** Read the timer from the solver thread, so that the time spent solving is counted. */
+class SolvingTimeEventHandler : public ::scip::ObjEventhdlr {
+public:
+	inline static auto constexpr events = SCIP_EVENTTYPE_LPEVENT | SCIP_EVENTTYPE_NODESOLVED;
+
+	SolvingTimeEventHandler(SCIP* scip, std::shared_ptr<utility::ThreadsCpuTimer> timer_, char const* name) :
+		ObjEventhdlr(scip, name, "Event handler reading the thread CPU time of the solver"), timer{std::move(timer_)} {}
+
+	auto scip_init(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE override {
+		return SCIPcatchEvent(scip, events, eventhdlr, nullptr, nullptr);
+	}
+
+	auto scip_exit(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE override {
+		return SCIPdropEvent(scip, events, eventhdlr, nullptr, -1);
+	}
+
+	auto scip_exec(SCIP* /*scip*/, SCIP_EVENTHDLR* /*eventhdlr*/, SCIP_EVENT* /*event*/, SCIP_EVENTDATA* /*eventdata*/)
+		-> SCIP_RETCODE override {
+		try {
+			timer->elapsed();
+		} catch (...) {
+			return SCIP_ERROR;
+		}
+		return SCIP_OKAY;
+	}
+
+private:
+	std::shared_ptr<utility::ThreadsCpuTimer> timer;
+};
+
+}  // namespace
+
+SolvingTime::SolvingTime(bool wall_, bool thread_cpu_) : wall{wall_}, thread_cpu{thread_cpu_} {
+	if (wall && thread_cpu) {
+		throw std::invalid_argument{"The thread CPU time cannot be used with the wall time."};
+	}
+}
+
+auto SolvingTime::time_now() const -> std::chrono::nanoseconds {
+	if (thread_cpu) {
+		return timer->elapsed();
+	}
 	if (wall) {
 		return std::chrono::steady_clock::now().time_since_epoch();
 	}
 	return utility::cpu_clock::now().time_since_epoch();
 }
 
-}  // namespace
-
-void SolvingTime::before_reset(scip::Model& /* model */) {
-	solving_time_offset = time_now(wall);
+void SolvingTime::before_reset(scip::Model& model) {
+	if (thread_cpu) {
+		// A new timer per episode so that copies of the reward function do not share it
+		timer = std::make_shared<utility::ThreadsCpuTimer>();
+		auto const name = fmt::format("ecole::reward::SolvingTime/{}", static_cast<void const*>(timer.get()));
+		auto handler = std::make_unique<SolvingTimeEventHandler>(model.get_scip_ptr(), timer, name.c_str());
+		scip::call(SCIPincludeObjEventhdlr, model.get_scip_ptr(), handler.get(), true);
+		// NOLINTNEXTLINE memory ownership is passed to SCIP
+		handler.release();
+	}
+	solving_time_offset = time_now();
 }
 
 Reward SolvingTime::extract(scip::Model& /* model */, bool /* done */) {
-	auto const now = time_now(wall);
+	auto const now = time_now();
 	// Casting to seconds represented as a Reward (no ratio).
 	auto const solving_time_diff = std::chrono::duration<Reward>{now - solving_time_offset}.count();
 	solving_time_offset = now;
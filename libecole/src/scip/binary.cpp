@@ -0,0 +1,368 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <fmt/format.h>
+#include <nonstd/span.hpp>
+#include <robin_hood.h>
+#include <scip/scip.h>
+
+#include "ecole/scip/cons.hpp"
+#include "ecole/scip/exception.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+#include "ecole/scip/var.hpp"
+
+namespace ecole::scip {
+
+namespace {
+
+/*
+ * The data starts with a header, followed by flat arrays, every array being preceded by its number of elements.
+ * Names are stored as a single array of characters, every name being terminated by a null character.
+ */
+constexpr auto magic = std::array<char, 8>{'E', 'C', 'O', 'L', 'E', 'B', 'I', 'N'};
+constexpr std::uint32_t format_version = 1;
+/** Written in the byte order of the machine, to detect files written on another architecture. */
+constexpr std::uint32_t byte_order_mark = 0x01020304;
+
+constexpr auto infinity = std::numeric_limits<SCIP_Real>::infinity();
+
+/** Append values and arrays to a buffer in memory. */
+class Writer {
+public:
+	template <typename T> void value(T const& val) {
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast) writing trivial types
+		data.append(reinterpret_cast<char const*>(&val), sizeof(T));
+	}
+
+	template <typename T> void array(std::vector<T> const& values) {
+		value(static_cast<std::uint64_t>(values.size()));
+		// NOLINTNEXTLINE(cppcoreguidelines-pro-type-reinterpret-cast) writing trivial types
+		data.append(reinterpret_cast<char const*>(values.data()), values.size() * sizeof(T));
+	}
+
+	[[nodiscard]] auto str() && -> std::string { return std::move(data); }
+
+private:
+	std::string data;
+};
+
+/** Read values and arrays from a buffer in memory, checking that they are within the buffer. */
+class Reader {
+public:
+	Reader(std::string_view data_, std::string source_) : data{data_}, source{std::move(source_)} {}
+
+	template <typename T> auto value() -> T {
+		auto val = T{};
+		std::memcpy(&val, take(sizeof(T)), sizeof(T));
+		return val;
+	}
+
+	template <typename T> auto array() -> std::vector<T> {
+		auto const size = value<std::uint64_t>();
+		// Do not allocate more than the buffer can hold on corrupted sizes
+		if (size > data.size() / sizeof(T)) {
+			fail("array size larger than the data");
+		}
+		auto values = std::vector<T>(size);
+		auto const n_bytes = values.size() * sizeof(T);
+		if (n_bytes > 0) {
+			std::memcpy(values.data(), take(n_bytes), n_bytes);
+		}
+		return values;
+	}
+
+	[[noreturn]] void fail(char const* reason) const {
+		throw ScipError{fmt::format("Invalid binary problem {}: {}.", source, reason)};
+	}
+
+private:
+	std::string_view data;
+	std::string source;
+
+	auto take(std::size_t n_bytes) -> char const* {
+		if (n_bytes > data.size()) {
+			fail("data is truncated");
+		}
+		auto const* const start = data.data();
+		data.remove_prefix(n_bytes);
+		return start;
+	}
+};
+
+void append_name(std::vector<char>& names, char const* name) {
+	names.insert(names.end(), name, name + std::char_traits<char>::length(name) + 1);
+}
+
+/** Pointers to the null terminated names stored one after the other. */
+auto split_names(std::vector<char> const& names, std::size_t n_names, Reader const& reader)
+	-> std::vector<char const*> {
+	if (!names.empty() && names.back() != '\0') {
+		reader.fail("names are not null terminated");
+	}
+	auto pointers = std::vector<char const*>{};
+	pointers.reserve(n_names);
+	for (auto iter = names.begin(); iter != names.end(); iter = std::find(iter, names.end(), '\0') + 1) {
+		pointers.push_back(&*iter);
+	}
+	if (pointers.size() != n_names) {
+		reader.fail("wrong number of names");
+	}
+	return pointers;
+}
+
+/** The given value, with SCIP infinity replaced by the floating point one. */
+auto to_ieee_infinity(SCIP* scip, SCIP_Real val) noexcept -> SCIP_Real {
+	if (SCIPisInfinity(scip, val)) {
+		return infinity;
+	}
+	if (SCIPisInfinity(scip, -val)) {
+		return -infinity;
+	}
+	return val;
+}
+
+/** Create a model from binary data, naming the source of the data in errors. */
+auto read_binary(std::string_view data, std::string source, PluginProfile profile) -> Model;
+
+}  // namespace
+
+void Model::save_binary(std::filesystem::path const& filename) const {
+	auto const data = to_binary();
+	auto file = std::ofstream{filename, std::ios::binary};
+	file.write(data.data(), static_cast<std::streamsize>(data.size()));
+	if (!file) {
+		throw ScipError{fmt::format("Could not write binary problem {}.", filename.string())};
+	}
+}
+
+auto Model::to_binary() const -> std::string {
+	auto* const scip = const_cast<SCIP*>(get_scip_ptr());
+
+	auto const vars = nonstd::span<SCIP_VAR*>{SCIPgetOrigVars(scip), static_cast<std::size_t>(SCIPgetNOrigVars(scip))};
+	auto var_lbs = std::vector<SCIP_Real>{};
+	auto var_ubs = std::vector<SCIP_Real>{};
+	auto var_objs = std::vector<SCIP_Real>{};
+	auto var_types = std::vector<std::uint8_t>{};
+	auto var_names = std::vector<char>{};
+	auto var_index = robin_hood::unordered_flat_map<SCIP_VAR const*, std::int32_t>{};
+	var_index.reserve(vars.size());
+	for (auto* const var : vars) {
+		var_index.emplace(var, static_cast<std::int32_t>(var_index.size()));
+		var_lbs.push_back(to_ieee_infinity(scip, SCIPvarGetLbOriginal(var)));
+		var_ubs.push_back(to_ieee_infinity(scip, SCIPvarGetUbOriginal(var)));
+		var_objs.push_back(SCIPvarGetObj(var));
+		var_types.push_back(static_cast<std::uint8_t>(SCIPvarGetType(var)));
+		append_name(var_names, SCIPvarGetName(var));
+	}
+
+	auto const conss =
+		nonstd::span<SCIP_CONS*>{SCIPgetOrigConss(scip), static_cast<std::size_t>(SCIPgetNOrigConss(scip))};
+	auto cons_lhs = std::vector<SCIP_Real>{};
+	auto cons_rhs = std::vector<SCIP_Real>{};
+	auto cons_indptr = std::vector<std::uint64_t>{0};
+	auto cons_indices = std::vector<std::int32_t>{};
+	auto cons_values = std::vector<SCIP_Real>{};
+	auto cons_names = std::vector<char>{};
+	auto row_vars = std::vector<SCIP_VAR const*>{};
+	auto row_vals = std::vector<SCIP_Real>{};
+	for (auto* const cons : conss) {
+		auto const n_vars = get_cons_n_vars(scip, cons);
+		auto const lhs = cons_get_lhs(scip, cons);
+		auto const rhs = cons_get_rhs(scip, cons);
+		row_vars.resize(n_vars.value_or(0));
+		row_vals.resize(n_vars.value_or(0));
+		if (!n_vars.has_value() || !lhs.has_value() || !rhs.has_value() || !get_cons_vars(scip, cons, row_vars) ||
+			!get_cons_vals(scip, cons, row_vals)) {
+			throw ScipError{fmt::format(
+				"Constraint {} of type {} is not linear and cannot be saved.",
+				SCIPconsGetName(cons),
+				SCIPconshdlrGetName(SCIPconsGetHdlr(cons)))};
+		}
+		for (auto const* const var : row_vars) {
+			cons_indices.push_back(var_index.at(var));
+		}
+		cons_values.insert(cons_values.end(), row_vals.begin(), row_vals.end());
+		cons_indptr.push_back(cons_indices.size());
+		cons_lhs.push_back(to_ieee_infinity(scip, lhs.value()));
+		cons_rhs.push_back(to_ieee_infinity(scip, rhs.value()));
+		append_name(cons_names, SCIPconsGetName(cons));
+	}
+
+	auto name = std::vector<char>{};
+	append_name(name, SCIPgetProbName(scip));
+
+	auto writer = Writer{};
+	writer.value(magic);
+	writer.value(format_version);
+	writer.value(byte_order_mark);
+	writer.array(name);
+	writer.value(static_cast<std::int32_t>(SCIPgetObjsense(scip)));
+	writer.value(SCIPgetOrigObjoffset(scip));
+	writer.array(var_lbs);
+	writer.array(var_ubs);
+	writer.array(var_objs);
+	writer.array(var_types);
+	writer.array(var_names);
+	writer.array(cons_lhs);
+	writer.array(cons_rhs);
+	writer.array(cons_indptr);
+	writer.array(cons_indices);
+	writer.array(cons_values);
+	writer.array(cons_names);
+	return std::move(writer).str();
+}
+
+auto Model::is_binary_exact() const -> bool {
+	auto* const scip = const_cast<SCIP*>(get_scip_ptr());
+	auto const vars = nonstd::span<SCIP_VAR*>{SCIPgetOrigVars(scip), static_cast<std::size_t>(SCIPgetNOrigVars(scip))};
+	// The flags of SCIPcreateVarBasic and SCIPcreateConsBasicLinear, used by load_binary
+	auto const is_default_var = [](SCIP_VAR* var) { return SCIPvarIsInitial(var) && !SCIPvarIsRemovable(var); };
+	auto const is_default_linear = [](SCIP_CONS* cons) {
+		return std::string_view{SCIPconshdlrGetName(SCIPconsGetHdlr(cons))} == "linear" && SCIPconsIsInitial(cons) &&
+			   SCIPconsIsSeparated(cons) && SCIPconsIsEnforced(cons) && SCIPconsIsChecked(cons) &&
+			   SCIPconsIsPropagated(cons) && !SCIPconsIsLocal(cons) && !SCIPconsIsModifiable(cons) &&
+			   !SCIPconsIsDynamic(cons) && !SCIPconsIsRemovable(cons) && !SCIPconsIsStickingAtNode(cons);
+	};
+	auto const conss =
+		nonstd::span<SCIP_CONS*>{SCIPgetOrigConss(scip), static_cast<std::size_t>(SCIPgetNOrigConss(scip))};
+	return std::all_of(vars.begin(), vars.end(), is_default_var) &&
+		   std::all_of(conss.begin(), conss.end(), is_default_linear);
+}
+
+Model Model::load_binary(std::filesystem::path const& filename, PluginProfile profile) {
+	auto const fd = ::open(filename.c_str(), O_RDONLY);  // NOLINT(cppcoreguidelines-pro-type-vararg)
+	if (fd < 0) {
+		throw ScipError{fmt::format("Could not read binary problem {}.", filename.string())};
+	}
+	struct stat file_stat = {};
+	if (::fstat(fd, &file_stat) != 0 || file_stat.st_size == 0) {
+		::close(fd);
+		throw ScipError{fmt::format("Invalid binary problem {}: empty file.", filename.string())};
+	}
+	auto const size = static_cast<std::size_t>(file_stat.st_size);
+	// The arrays are copied out of the mapping, which only saves reading the file through an intermediate buffer
+	auto* const mapped = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+	::close(fd);
+	if (mapped == MAP_FAILED) {
+		throw ScipError{fmt::format("Could not map binary problem {} in memory.", filename.string())};
+	}
+	auto const unmap = [size](void* ptr) { ::munmap(ptr, size); };
+	auto const mapping = std::unique_ptr<void, decltype(unmap)>{mapped, unmap};
+	return read_binary(std::string_view{static_cast<char const*>(mapped), size}, filename.string(), profile);
+}
+
+Model Model::from_binary(std::string_view data, PluginProfile profile) {
+	return read_binary(data, "in memory", profile);
+}
+
+namespace {
+
+auto read_binary(std::string_view data, std::string source, PluginProfile profile) -> Model {
+	auto reader = Reader{data, std::move(source)};
+	if (reader.value<std::array<char, 8>>() != magic) {
+		reader.fail("not an Ecole binary problem");
+	}
+	if (reader.value<std::uint32_t>() != format_version) {
+		reader.fail("unsupported format version");
+	}
+	if (reader.value<std::uint32_t>() != byte_order_mark) {
+		reader.fail("written on a machine with a different byte order");
+	}
+	auto const name = reader.array<char>();
+	auto const objsense = reader.value<std::int32_t>();
+	auto const objoffset = reader.value<SCIP_Real>();
+	auto const var_lbs = reader.array<SCIP_Real>();
+	auto const var_ubs = reader.array<SCIP_Real>();
+	auto const var_objs = reader.array<SCIP_Real>();
+	auto const var_types = reader.array<std::uint8_t>();
+	auto const var_names = reader.array<char>();
+	auto const cons_lhs = reader.array<SCIP_Real>();
+	auto const cons_rhs = reader.array<SCIP_Real>();
+	auto const cons_indptr = reader.array<std::uint64_t>();
+	auto const cons_indices = reader.array<std::int32_t>();
+	auto const cons_values = reader.array<SCIP_Real>();
+	auto const cons_names = reader.array<char>();
+
+	auto const n_vars = var_lbs.size();
+	auto const n_conss = cons_lhs.size();
+	if (var_ubs.size() != n_vars || var_objs.size() != n_vars || var_types.size() != n_vars) {
+		reader.fail("inconsistent number of variables");
+	}
+	if (cons_rhs.size() != n_conss || cons_indptr.size() != n_conss + 1 || cons_indptr.front() != 0 ||
+		cons_indptr.back() != cons_indices.size() || cons_values.size() != cons_indices.size() ||
+		!std::is_sorted(cons_indptr.begin(), cons_indptr.end())) {
+		reader.fail("inconsistent constraints");
+	}
+	if (std::any_of(cons_indices.begin(), cons_indices.end(), [n_vars](auto idx) {
+			return idx < 0 || static_cast<std::size_t>(idx) >= n_vars;
+		})) {
+		reader.fail("variable index out of range");
+	}
+	if (name.empty() || name.back() != '\0') {
+		reader.fail("problem name is not null terminated");
+	}
+	auto const var_name_ptrs = split_names(var_names, n_vars, reader);
+	auto const cons_name_ptrs = split_names(cons_names, n_conss, reader);
+
+	auto model = Model{profile};
+	auto* const scip = model.get_scip_ptr();
+	scip::call(SCIPcreateProbBasic, scip, name.data());
+	scip::call(SCIPsetObjsense, scip, static_cast<SCIP_OBJSENSE>(objsense));
+	scip::call(SCIPaddOrigObjoffset, scip, objoffset);
+
+	auto const inf = SCIPinfinity(scip);
+	auto vars = std::vector<SCIP_VAR*>(n_vars);
+	for (std::size_t i = 0; i < n_vars; ++i) {
+		auto var = create_var_basic(
+			scip,
+			var_name_ptrs[i],
+			std::clamp(var_lbs[i], -inf, inf),
+			std::clamp(var_ubs[i], -inf, inf),
+			var_objs[i],
+			static_cast<SCIP_VARTYPE>(var_types[i]));
+		scip::call(SCIPaddVar, scip, var.get());
+		// The problem holds a reference to the variable after it is released here
+		vars[i] = var.get();
+	}
+
+	auto row_vars = std::vector<SCIP_VAR*>{};
+	for (std::size_t i = 0; i < n_conss; ++i) {
+		auto const begin = cons_indptr[i];
+		auto const end = cons_indptr[i + 1];
+		row_vars.clear();
+		for (auto k = begin; k < end; ++k) {
+			row_vars.push_back(vars[static_cast<std::size_t>(cons_indices[k])]);
+		}
+		auto cons = create_cons_basic_linear(
+			scip,
+			cons_name_ptrs[i],
+			end - begin,
+			row_vars.data(),
+			cons_values.data() + begin,
+			std::clamp(cons_lhs[i], -inf, inf),
+			std::clamp(cons_rhs[i], -inf, inf));
+		scip::call(SCIPaddCons, scip, cons.get());
+	}
+	return model;
+}
+
+}  // namespace
+
+}  // namespace ecole::scip
@@ -1,16 +1,26 @@
+#include <algorithm>
+#include <cassert>
 #include <cmath>
-#include <fmt/format.h>
+#include <cstddef>
+#include <future>
+#include <iterator>
 #include <stdexcept>
-#include <xtensor/xadapt.hpp>
-#include <xtensor/xnorm.hpp>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <range/v3/view/zip.hpp>
 #include <xtensor/xtensor.hpp>
-#include <xtensor/xview.hpp>
 
 #include "ecole/scip/cons.hpp"
+#include "ecole/scip/model.hpp"
 #include "ecole/utility/sparse-matrix.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 namespace ecole::scip {
 
+namespace views = ranges::views;
+
 void ConsReleaser::operator()(SCIP_CONS* ptr) {
 	scip::call(SCIPreleaseCons, scip, &ptr);
 }
@@ -38,6 +48,117 @@ auto create_cons_basic_linear(
 	return {cons, ConsReleaser{scip}};
 }
 
+LinearConstraintBatch::LinearConstraintBatch() : indptr{0} {}
+
+LinearConstraintBatch::LinearConstraintBatch(
+	std::vector<std::size_t> indptr_,
+	std::vector<std::size_t> indices_,
+	std::vector<SCIP_Real> values_,
+	std::vector<SCIP_Real> lhs_,
+	std::vector<SCIP_Real> rhs_) :
+	indptr(std::move(indptr_)),
+	indices(std::move(indices_)),
+	values(std::move(values_)),
+	lhs(std::move(lhs_)),
+	rhs(std::move(rhs_)) {
+	if (indptr.empty() || indptr.front() != 0 || indptr.back() != indices.size()) {
+		throw std::invalid_argument{"Row offsets must start at zero and end with the number of non zeros."};
+	}
+	if (!std::is_sorted(indptr.begin(), indptr.end())) {
+		throw std::invalid_argument{"Row offsets must be non decreasing."};
+	}
+	if (values.size() != indices.size()) {
+		throw std::invalid_argument{fmt::format(
+			"Got {} coefficients for {} variable indices but there must be as many.", values.size(), indices.size())};
+	}
+	if ((lhs.size() != indptr.size() - 1) || (rhs.size() != indptr.size() - 1)) {
+		throw std::invalid_argument{fmt::format(
+			"Got {} left and {} right hand sides for {} constraints but there must be as many.",
+			lhs.size(),
+			rhs.size(),
+			indptr.size() - 1)};
+	}
+}
+
+void LinearConstraintBatch::reserve(std::size_t n_constraints, std::size_t n_nonzeros) {
+	indptr.reserve(n_constraints + 1);
+	lhs.reserve(n_constraints);
+	rhs.reserve(n_constraints);
+	indices.reserve(n_nonzeros);
+	values.reserve(n_nonzeros);
+}
+
+void LinearConstraintBatch::add(
+	nonstd::span<std::size_t const> var_indices,
+	nonstd::span<SCIP_Real const> coefs,
+	SCIP_Real lhs_,
+	SCIP_Real rhs_) {
+	if (var_indices.size() != coefs.size()) {
+		throw std::invalid_argument{fmt::format(
+			"Got {} coefficients for {} variables but there must be as many.", coefs.size(), var_indices.size())};
+	}
+	indices.insert(indices.end(), var_indices.begin(), var_indices.end());
+	values.insert(values.end(), coefs.begin(), coefs.end());
+	indptr.push_back(indices.size());
+	lhs.push_back(lhs_);
+	rhs.push_back(rhs_);
+}
+
+void LinearConstraintBatch::add(
+	nonstd::span<std::size_t const> var_indices,
+	SCIP_Real coef,
+	SCIP_Real lhs_,
+	SCIP_Real rhs_) {
+	indices.insert(indices.end(), var_indices.begin(), var_indices.end());
+	values.insert(values.end(), var_indices.size(), coef);
+	indptr.push_back(indices.size());
+	lhs.push_back(lhs_);
+	rhs.push_back(rhs_);
+}
+
+void LinearConstraintBatch::add_to(SCIP* scip, nonstd::span<SCIP_VAR* const> vars, char const* name_prefix) const {
+	// Check all indices before modifying the problem
+	auto const max_index = std::max_element(indices.begin(), indices.end());
+	if (max_index != indices.end() && *max_index >= vars.size()) {
+		throw std::out_of_range{
+			fmt::format("Variable index {} is out of range for {} variables.", *max_index, vars.size())};
+	}
+
+	auto max_row_size = std::size_t{0};
+	for (std::size_t i = 0; i < size(); ++i) {
+		max_row_size = std::max(max_row_size, indptr[i + 1] - indptr[i]);
+	}
+	auto row_vars = std::vector<SCIP_VAR*>(max_row_size);
+	auto name = fmt::memory_buffer{};
+	auto const inf = SCIPinfinity(scip);
+
+	for (std::size_t i = 0; i < size(); ++i) {
+		auto const begin = indptr[i];
+		auto const end = indptr[i + 1];
+		for (auto k = begin; k < end; ++k) {
+			row_vars[k - begin] = vars[indices[k]];
+		}
+		name.clear();
+		if (name_prefix != nullptr) {
+			fmt::format_to(std::back_inserter(name), "{}{}", name_prefix, i);
+		}
+		name.push_back('\0');
+		auto cons = create_cons_basic_linear(
+			scip,
+			name.data(),
+			end - begin,
+			row_vars.data(),
+			values.data() + begin,
+			std::clamp(lhs[i], -inf, inf),
+			std::clamp(rhs[i], -inf, inf));
+		scip::call(SCIPaddCons, scip, cons.get());
+	}
+}
+
+void LinearConstraintBatch::add_to(Model& model, char const* name_prefix) const {
+	add_to(model.get_scip_ptr(), model.variables(), name_prefix);
+}
+
 auto cons_get_rhs(SCIP const* scip, SCIP_CONS const* cons) noexcept -> std::optional<SCIP_Real> {
 	SCIP_Bool success = FALSE;
 	auto const rhs = SCIPconsGetRhs(const_cast<SCIP*>(scip), const_cast<SCIP_CONS*>(cons), &success);
@@ -75,10 +196,11 @@ auto cons_get_finite_lhs(SCIP const* scip, SCIP_CONS const* cons) noexcept -> st
 }
 
 auto get_cons_n_vars(SCIP const* scip, SCIP_CONS const* cons) -> std::optional<std::size_t> {
-	SCIP_Bool success = false;
+	SCIP_Bool success = FALSE;
 	int n_vars = 0;
+	// Handlers not supporting the call report it through success, any other error is thrown
 	scip::call(SCIPgetConsNVars, const_cast<SCIP*>(scip), const_cast<SCIP_CONS*>(cons), &n_vars, &success);
-	if (!success) {
+	if (success == FALSE) {
 		return {};
 	}
 	assert(n_vars >= 0);
@@ -96,7 +218,7 @@ auto get_cons_vars(SCIP* scip, SCIP_CONS* cons, nonstd::span<SCIP_VAR*> out) ->
 	}
 	SCIP_Bool success = FALSE;
 	scip::call(SCIPgetConsVars, scip, cons, out.data(), static_cast<int>(out.size()), &success);
-	return success;
+	return success == TRUE;
 }
 
 auto get_cons_vars(SCIP const* scip, SCIP_CONS const* cons, nonstd::span<SCIP_VAR const*> out) -> bool {
@@ -141,7 +263,7 @@ auto get_cons_vals(SCIP const* scip, SCIP_CONS const* cons, nonstd::span<SCIP_Re
 		out.data(),
 		static_cast<int>(out.size()),
 		&success);
-	return success;
+	return success == TRUE;
 }
 
 auto get_cons_vals(SCIP const* scip, SCIP_CONS const* cons) -> std::optional<std::vector<SCIP_Real>> {
@@ -173,7 +295,7 @@ auto get_vars_linear(SCIP const* scip, SCIP_CONS const* cons) noexcept -> nonstd
  */
 auto get_constraint_linear_coefs(SCIP* const scip, SCIP_CONS* const constraint) -> std::optional<
 	std::tuple<std::vector<SCIP_VAR*>, std::vector<SCIP_Real>, std::optional<SCIP_Real>, std::optional<SCIP_Real>>> {
-	SCIP_Bool success = false;
+	SCIP_Bool success = FALSE;
 	int n_constraint_variables;
 	int n_active_variables;
 	SCIP_Real constant_offset = 0;
@@ -181,7 +303,7 @@ auto get_constraint_linear_coefs(SCIP* const scip, SCIP_CONS* const constraint)
 
 	// Find how many active variables and constraint variables there are (for allocation)
 	scip::call(SCIPgetConsNVars, scip, constraint, &n_constraint_variables, &success);
-	if (!success) {
+	if (success == FALSE) {
 		return std::nullopt;
 	}
 	n_active_variables = SCIPgetNVars(scip);
@@ -192,12 +314,13 @@ auto get_constraint_linear_coefs(SCIP* const scip, SCIP_CONS* const constraint)
 	auto coefficients = std::vector<SCIP_Real>(buffer_size);
 
 	// Get the variables and their coefficients in the constraint
-	scip::call(SCIPgetConsVars, scip, constraint, variables.data(), static_cast<int>(buffer_size), &success);
-	if (!success) {
+	auto const size = static_cast<int>(buffer_size);
+	scip::call(SCIPgetConsVars, scip, constraint, variables.data(), size, &success);
+	if (success == FALSE) {
 		return std::nullopt;
 	}
-	scip::call(SCIPgetConsVals, scip, constraint, coefficients.data(), static_cast<int>(buffer_size), &success);
-	if (!success) {
+	scip::call(SCIPgetConsVals, scip, constraint, coefficients.data(), size, &success);
+	if (success == FALSE) {
 		return std::nullopt;
 	}
 
@@ -233,12 +356,9 @@ auto get_constraint_linear_coefs(SCIP* const scip, SCIP_CONS* const constraint)
 	return {{variables, coefficients, lhs, rhs}};
 }
 
-auto get_constraint_coefs(SCIP* const scip, SCIP_CONS* const constraint)
-	-> std::tuple<std::vector<SCIP_VAR*>, std::vector<SCIP_Real>, std::optional<SCIP_Real>, std::optional<SCIP_Real>> {
-	auto constraint_data = get_constraint_linear_coefs(scip, constraint);
-	if (constraint_data.has_value()) {  // Constraint must be linear
-		return constraint_data.value();
-	}
+namespace {
+
+[[noreturn]] void throw_not_linear(SCIP_CONS* const constraint) {
 	throw ScipError(fmt::format(
 		"Constraint {} cannot be expressed as a single linear constraint (type \"{}\"), MilpBipartite observation "
 		"cannot be extracted.",
@@ -246,103 +366,290 @@ auto get_constraint_coefs(SCIP* const scip, SCIP_CONS* const constraint)
 		SCIPconshdlrGetName(SCIPconsGetHdlr(constraint))));
 }
 
-SCIP_Real cons_l2_norm(std::vector<SCIP_Real> const& constraint_coefs) {
-	auto xt_constraint_coefs = xt::adapt(constraint_coefs, {constraint_coefs.size()});
+/**
+ * Read constraints as linear combinations of active variables, reusing the same buffers for all constraints.
+ *
+ * This is the allocation free equivalent of get_constraint_linear_coefs.
+ */
+class LinearConsReader {
+public:
+	LinearConsReader(SCIP* const scip_) :
+		scip(scip_),
+		variables(static_cast<std::size_t>(SCIPgetNVars(scip))),
+		coefficients(static_cast<std::size_t>(SCIPgetNVars(scip))),
+		last_seen(static_cast<std::size_t>(SCIPgetNVars(scip)), 0) {}
+
+	/** Number of variables upon which the constraint depends, without reading the coefficients when possible. */
+	auto count(SCIP_CONS* const constraint) -> std::size_t {
+		// Before transformation, all constraint variables are active hence there is no need to re-express them
+		if (SCIPgetStage(scip) < SCIP_STAGE_TRANSFORMED) {
+			reexpressed = false;
+			auto const n_vars = get_cons_n_vars(scip, constraint);
+			if (!n_vars.has_value()) {
+				throw_not_linear(constraint);
+			}
+			return n_vars.value();
+		}
+		read(constraint);
+		return n_read;
+	}
+
+	/** Read the variables and coefficients of the constraint in the buffers. */
+	void read(SCIP_CONS* const constraint) {
+		SCIP_Bool success = false;
+		int n_constraint_variables = 0;
+		scip::call(SCIPgetConsNVars, scip, constraint, &n_constraint_variables, &success);
+		if (!success) {
+			throw_not_linear(constraint);
+		}
 
-	auto const norm = xt::norm_l2(xt_constraint_coefs)();
+		// Buffers must hold the constraint variables, as well as all active variables after re-expression
+		auto const buffer_size = std::max(static_cast<std::size_t>(n_constraint_variables), variables.size());
+		variables.resize(buffer_size);
+		coefficients.resize(buffer_size);
+
+		scip::call(SCIPgetConsVars, scip, constraint, variables.data(), static_cast<int>(buffer_size), &success);
+		if (!success) {
+			throw_not_linear(constraint);
+		}
+		scip::call(SCIPgetConsVals, scip, constraint, coefficients.data(), static_cast<int>(buffer_size), &success);
+		if (!success) {
+			throw_not_linear(constraint);
+		}
+
+		constant_offset = 0.;
+		auto const is_active = [](SCIP_VAR* var) { return SCIPvarIsActive(var) != FALSE; };
+		auto const vars_end = variables.begin() + n_constraint_variables;
+		reexpressed = (SCIPgetStage(scip) >= SCIP_STAGE_TRANSFORMED) &&
+									(!std::all_of(variables.begin(), vars_end, is_active) || has_duplicates(variables.begin(), vars_end));
+		if (reexpressed) {
+			int requiredsize = 0;
+			scip::call(
+				SCIPgetProbvarLinearSum,
+				scip,
+				variables.data(),
+				coefficients.data(),
+				&n_constraint_variables,
+				static_cast<int>(buffer_size),
+				&constant_offset,
+				&requiredsize,
+				true);
+		}
+		n_read = static_cast<std::size_t>(n_constraint_variables);
+	}
+
+	[[nodiscard]] auto vars() const noexcept -> nonstd::span<SCIP_VAR* const> { return {variables.data(), n_read}; }
+	[[nodiscard]] auto coefs() const noexcept -> nonstd::span<SCIP_Real const> { return {coefficients.data(), n_read}; }
+	[[nodiscard]] auto offset() const noexcept -> SCIP_Real { return constant_offset; }
+
+	/**
+	 * Whether the last constraint read had inactive or repeated variables that were re-expressed.
+	 *
+	 * Re-expressing variables uses SCIP buffer memory, so such constraints must not be read concurrently.
+	 */
+	[[nodiscard]] auto was_reexpressed() const noexcept -> bool { return reexpressed; }
+
+private:
+	SCIP* scip;
+	std::vector<SCIP_VAR*> variables;
+	std::vector<SCIP_Real> coefficients;
+	/** The last read in which every active variable was seen, to find repeated variables without sorting. */
+	std::vector<std::size_t> last_seen;
+	std::size_t n_reads = 0;
+	std::size_t n_read = 0;
+	SCIP_Real constant_offset = 0.;
+	bool reexpressed = false;
+
+	/** Whether an active variable appears more than once, to be merged as SCIPgetProbvarLinearSum does. */
+	template <typename Iter> auto has_duplicates(Iter begin, Iter end) -> bool {
+		++n_reads;
+		for (; begin != end; ++begin) {
+			auto& seen = last_seen[static_cast<std::size_t>(SCIPvarGetProbindex(*begin))];
+			if (seen == n_reads) {
+				return true;
+			}
+			seen = n_reads;
+		}
+		return false;
+	}
+};
+
+auto l2_norm(nonstd::span<SCIP_Real const> coefs) noexcept -> SCIP_Real {
+	SCIP_Real norm_squared = 0.;
+	for (auto const coef : coefs) {
+		norm_squared += coef * coef;
+	}
+	auto const norm = std::sqrt(norm_squared);
 	return norm > 0. ? norm : 1.;
 }
 
-auto get_all_constraints(SCIP* const scip, bool normalize, bool include_variable_bounds)
-	-> std::tuple<utility::coo_matrix<SCIP_Real>, xt::xtensor<SCIP_Real, 1>> {
-	auto* const variables = SCIPgetVars(scip);
-	auto* const constraints = SCIPgetConss(scip);
-	auto nb_variables = static_cast<std::size_t>(SCIPgetNVars(scip));
-	auto nb_constraints = static_cast<std::size_t>(SCIPgetNConss(scip));
+}  // namespace
 
-	std::size_t n_rows = 0;
+auto get_constraint_coefs(SCIP* const scip, SCIP_CONS* const constraint)
+	-> std::tuple<std::vector<SCIP_VAR*>, std::vector<SCIP_Real>, std::optional<SCIP_Real>, std::optional<SCIP_Real>> {
+	auto constraint_data = get_constraint_linear_coefs(scip, constraint);
+	if (constraint_data.has_value()) {  // Constraint must be linear
+		return constraint_data.value();
+	}
+	throw_not_linear(constraint);
+}
 
-	std::vector<SCIP_Real> values;
-	std::vector<std::size_t> column_indices;
-	std::vector<std::size_t> row_indices;
-	std::vector<SCIP_Real> biases;
+/*
+ * The matrix is assembled in two passes.
+ * The first pass counts the number of rows and non zero coefficients of every constraint, so that the second pass can
+ * write every coefficient directly in its final place, without intermediate copies.
+ * Since every constraint knows where to write, the second pass can be partitioned among threads with an output that
+ * does not depend on the number of threads.
+ */
+auto get_all_constraints(
+	SCIP* const scip,
+	bool normalize,
+	bool include_variable_bounds,
+	utility::ThreadPool* const thread_pool) -> std::tuple<utility::coo_matrix<SCIP_Real>, xt::xtensor<SCIP_Real, 1>> {
+	auto const variables = nonstd::span{SCIPgetVars(scip), static_cast<std::size_t>(SCIPgetNVars(scip))};
+	auto const constraints = nonstd::span{SCIPgetConss(scip), static_cast<std::size_t>(SCIPgetNConss(scip))};
+	auto const n_cons = constraints.size();
+	auto is_finite = [scip](SCIP_Real bound) { return !SCIPisInfinity(scip, std::abs(bound)); };
+
+	// First pass, count rows and non zeros of every constraint
+	auto cons_first_row = std::vector<std::size_t>(n_cons + 1, 0);
+	auto cons_first_coef = std::vector<std::size_t>(n_cons + 1, 0);
+	auto cons_reexpressed = std::vector<bool>(n_cons, false);
+	{
+		auto reader = LinearConsReader{scip};
+		for (std::size_t cons_idx = 0; cons_idx < n_cons; ++cons_idx) {
+			auto* const constraint = constraints[cons_idx];
+			// Counted even without finite sides to report non linear constraints
+			auto const n_vars = reader.count(constraint);
+			cons_reexpressed[cons_idx] = reader.was_reexpressed();
+			auto const n_sides = static_cast<std::size_t>(cons_get_finite_lhs(scip, constraint).has_value()) +
+													 static_cast<std::size_t>(cons_get_finite_rhs(scip, constraint).has_value());
+			cons_first_row[cons_idx + 1] = cons_first_row[cons_idx] + n_sides;
+			cons_first_coef[cons_idx + 1] = cons_first_coef[cons_idx] + n_sides * n_vars;
+		}
+	}
+	auto n_rows = cons_first_row.back();
+	auto nnz = cons_first_coef.back();
+	if (include_variable_bounds) {
+		for (auto* const var : variables) {
+			auto const n_bounds = static_cast<std::size_t>(is_finite(SCIPvarGetLbGlobal(var))) +
+														static_cast<std::size_t>(is_finite(SCIPvarGetUbGlobal(var)));
+			n_rows += n_bounds;
+			nnz += n_bounds;
+		}
+	}
 
-	// For each constraint
-	for (std::size_t cons_idx = 0; cons_idx < nb_constraints; ++cons_idx) {
-		auto* const constraint = constraints[cons_idx];
-		auto [constraint_vars, constraint_coefs, lhs, rhs] = get_constraint_coefs(scip, constraint);
-		SCIP_Real const constraint_norm = normalize ? cons_l2_norm(constraint_coefs) : 1.;
+	// Second pass, fill the preallocated matrix
+	auto constraint_matrix = utility::coo_matrix<SCIP_Real>{
+		decltype(utility::coo_matrix<SCIP_Real>::values)::from_shape({nnz}),
+		decltype(utility::coo_matrix<SCIP_Real>::indices)::from_shape({2, nnz}),
+		{n_rows, variables.size()},
+	};
+	auto constraint_biases = xt::xtensor<SCIP_Real, 1>::from_shape({n_rows});
+	auto add_entry = [&constraint_matrix](std::size_t coef_idx, std::size_t row, std::size_t var_idx, SCIP_Real value) {
+		constraint_matrix.values(coef_idx) = value;
+		constraint_matrix.indices(0, coef_idx) = row;
+		constraint_matrix.indices(1, coef_idx) = var_idx;
+	};
 
+	auto fill_constraint = [&](LinearConsReader& reader, std::size_t cons_idx) {
+		auto* const constraint = constraints[cons_idx];
+		auto const lhs = cons_get_finite_lhs(scip, constraint);
+		auto const rhs = cons_get_finite_rhs(scip, constraint);
+		if (!lhs.has_value() && !rhs.has_value()) {
+			return;
+		}
+		reader.read(constraint);
+		auto const norm = normalize ? l2_norm(reader.coefs()) : 1.;
+		auto row = cons_first_row[cons_idx];
+		auto coef_idx = cons_first_coef[cons_idx];
+		auto add_row = [&](SCIP_Real sign, SCIP_Real bias) {
+			for (auto const [var, coef] : views::zip(reader.vars(), reader.coefs())) {
+				add_entry(coef_idx++, row, static_cast<std::size_t>(SCIPvarGetProbindex(var)), sign * coef);
+			}
+			constraint_biases(row++) = sign * bias / norm;
+		};
 		// Inequality has a left hand side?
 		if (lhs.has_value()) {
-			for (std::size_t cons_var_idx = 0; cons_var_idx < std::size(constraint_vars); ++cons_var_idx) {
-				SCIP_Real value = constraint_coefs[cons_var_idx];
-				int var_idx = SCIPvarGetProbindex(constraint_vars[cons_var_idx]);
-
-				values.push_back(-value);
-				row_indices.push_back(n_rows);
-				column_indices.push_back(static_cast<std::size_t>(var_idx));
-			}
-			if (normalize) {
-				biases.push_back(-lhs.value() / constraint_norm);
-			} else {
-				biases.push_back(-lhs.value());
-			}
-			n_rows++;
+			add_row(-1., lhs.value() - reader.offset());
 		}
 		// Inequality has a right hand side?
 		if (rhs.has_value()) {
-			for (std::size_t cons_var_idx = 0; cons_var_idx < std::size(constraint_vars); ++cons_var_idx) {
-				SCIP_Real value = constraint_coefs[cons_var_idx];
-				int var_idx = SCIPvarGetProbindex(constraint_vars[cons_var_idx]);
+			add_row(1., rhs.value() - reader.offset());
+		}
+		assert(row == cons_first_row[cons_idx + 1]);
+		assert(coef_idx == cons_first_coef[cons_idx + 1]);
+	};
 
-				values.push_back(value);
-				row_indices.push_back(n_rows);
-				column_indices.push_back(static_cast<std::size_t>(var_idx));
+	// Constraints that need re-expression are filled on this thread after the others
+	auto fill_constraints = [&fill_constraint, &cons_reexpressed, scip](std::size_t begin, std::size_t end) {
+		auto reader = LinearConsReader{scip};
+		for (auto cons_idx = begin; cons_idx < end; ++cons_idx) {
+			if (!cons_reexpressed[cons_idx]) {
+				fill_constraint(reader, cons_idx);
 			}
-			if (normalize) {
-				biases.push_back(rhs.value() / constraint_norm);
-			} else {
-				biases.push_back(rhs.value());
+		}
+	};
+
+	// Nested in another parallel task, the constraints are read sequentially
+	auto const parallel = thread_pool != nullptr && !utility::ThreadPool::in_worker_thread();
+	auto const n_chunks = parallel ? std::min(thread_pool->size(), n_cons) : std::size_t{1};
+	if (n_chunks <= 1) {
+		fill_constraints(0, n_cons);
+	} else {
+		// Chunks are balanced by number of non zeros
+		auto futures = std::vector<std::future<void>>{};
+		futures.reserve(n_chunks);
+		auto begin = std::size_t{0};
+		for (std::size_t chunk = 1; chunk <= n_chunks; ++chunk) {
+			auto const coef_target = chunk * cons_first_coef.back() / n_chunks;
+			auto const end = (chunk == n_chunks) ?
+												 n_cons :
+												 std::max(
+													 begin,
+													 static_cast<std::size_t>(
+														 std::lower_bound(cons_first_coef.begin(), cons_first_coef.end() - 1, coef_target) -
+														 cons_first_coef.begin()));
+			futures.push_back(thread_pool->submit([&fill_constraints, begin, end] { fill_constraints(begin, end); }));
+			begin = end;
+		}
+		// All tasks are awaited before rethrowing since they reference local variables
+		for (auto& fut : futures) {
+			fut.wait();
+		}
+		for (auto& fut : futures) {
+			fut.get();
+		}
+	}
+	{
+		auto reader = LinearConsReader{scip};
+		for (std::size_t cons_idx = 0; cons_idx < n_cons; ++cons_idx) {
+			if (cons_reexpressed[cons_idx]) {
+				fill_constraint(reader, cons_idx);
 			}
-			n_rows++;
 		}
 	}
 
 	if (include_variable_bounds) {
 		// Add variable bounds as additional constraints
-		for (std::size_t var_idx = 0; var_idx < nb_variables; ++var_idx) {
+		auto row = cons_first_row.back();
+		auto coef_idx = cons_first_coef.back();
+		for (std::size_t var_idx = 0; var_idx < variables.size(); ++var_idx) {
 			auto lb = SCIPvarGetLbGlobal(variables[var_idx]);
 			auto ub = SCIPvarGetUbGlobal(variables[var_idx]);
-			if (!SCIPisInfinity(scip, std::abs(lb))) {
-				values.push_back(-1.);
-				row_indices.push_back(n_rows);
-				column_indices.push_back(static_cast<std::size_t>(var_idx));
-				biases.push_back(-lb);
-				n_rows++;
+			if (is_finite(lb)) {
+				add_entry(coef_idx++, row, var_idx, -1.);
+				constraint_biases(row++) = -lb;
 			}
-			if (!SCIPisInfinity(scip, std::abs(ub))) {
-				values.push_back(1.);
-				row_indices.push_back(n_rows);
-				column_indices.push_back(static_cast<std::size_t>(var_idx));
-				biases.push_back(ub);
-				n_rows++;
+			if (is_finite(ub)) {
+				add_entry(coef_idx++, row, var_idx, 1.);
+				constraint_biases(row++) = ub;
 			}
 		}
+		assert(row == n_rows);
+		assert(coef_idx == nnz);
 	}
 
-	// Turn values and indices into xt::xarray's
-	auto const nnz = values.size();
-
-	utility::coo_matrix<SCIP_Real> constraint_matrix{};
-	constraint_matrix.values = xt::adapt(std::move(values), {nnz});
-	constraint_matrix.indices = decltype(utility::coo_matrix<SCIP_Real>::indices)::from_shape({2, nnz});
-	xt::row(constraint_matrix.indices, 0) = xt::adapt(std::move(row_indices), {nnz});
-	xt::row(constraint_matrix.indices, 1) = xt::adapt(std::move(column_indices), {nnz});
-	constraint_matrix.shape = {n_rows, nb_variables};
-
-	xt::xtensor<SCIP_Real, 1> constraint_biases = xt::adapt(std::move(biases), {n_rows});
-
 	return std::tuple{std::move(constraint_matrix), std::move(constraint_biases)};
 }
 
@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <objscip/objmessagehdlr.h>
+#include <scip/scip.h>
+
+#include "ecole/scip/exception.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/scimpl.hpp"
+#include "ecole/scip/utils.hpp"
+
+namespace ecole::scip {
+
+/**
+ * SCIP message handler writing the log into a ring buffer of fixed size.
+ *
+ * Writing reserves its bytes with an atomic increment and copies the message, without formatting, locking, or
+ * allocating, so that concurrent solvers writing in the same handler do not overwrite each other.
+ * Messages written to other files than the standard outputs, such as statistics written to a file, go to their file.
+ * The buffer is owned by the Scimpl, and outlives the SCIP writing in it.
+ */
+class LogBuffer : public ::scip::ObjMessagehdlr {
+public:
+	explicit LogBuffer(std::size_t capacity) : ObjMessagehdlr{false}, buffer(capacity) {}
+
+	void scip_warning(SCIP_MESSAGEHDLR* /*messagehdlr*/, FILE* file, const char* message) override {
+		write(file, message);
+	}
+	void scip_dialog(SCIP_MESSAGEHDLR* /*messagehdlr*/, FILE* file, const char* message) override {
+		write(file, message);
+	}
+	void scip_info(SCIP_MESSAGEHDLR* /*messagehdlr*/, FILE* file, const char* message) override {
+		write(file, message);
+	}
+
+	/** The log written since the last clear, starting at the first full line if older messages were overwritten. */
+	[[nodiscard]] auto log() const -> std::string {
+		auto const end = n_written.load(std::memory_order_acquire);
+		auto const begin = std::max(cleared_at, end - std::min<std::uint64_t>(end, buffer.size()));
+		auto text = std::string(static_cast<std::size_t>(end - begin), '\0');
+		for (auto pos = begin; pos < end; ++pos) {
+			text[static_cast<std::size_t>(pos - begin)] = buffer[static_cast<std::size_t>(pos % buffer.size())];
+		}
+		if (begin > cleared_at) {
+			text.erase(0, std::min(text.size(), text.find('\n') + 1));
+		}
+		return text;
+	}
+
+	void clear() noexcept { cleared_at = n_written.load(std::memory_order_acquire); }
+
+private:
+	std::vector<char> buffer;
+	std::atomic<std::uint64_t> n_written = 0;
+	std::uint64_t cleared_at = 0;
+
+	void write(FILE* file, const char* message) noexcept {
+		if (file != nullptr && file != stdout && file != stderr) {
+			std::fputs(message, file);
+			return;
+		}
+		auto size = std::strlen(message);
+		auto pos = n_written.fetch_add(size, std::memory_order_acq_rel);
+		// Only the end of messages longer than the buffer would be kept
+		if (size > buffer.size()) {
+			pos += size - buffer.size();
+			message += size - buffer.size();
+			size = buffer.size();
+		}
+		auto const offset = static_cast<std::size_t>(pos % buffer.size());
+		auto const first = std::min(size, buffer.size() - offset);
+		std::memcpy(buffer.data() + offset, message, first);
+		std::memcpy(buffer.data(), message + first, size - first);
+	}
+};
+
+namespace {
+
+/** Give a message handler to SCIP, which captures it, and release the reference of its creation. */
+void set_handler(SCIP* scip, SCIP_MESSAGEHDLR* handler) {
+	auto const retcode = SCIPsetMessagehdlr(scip, handler);
+	SCIPmessagehdlrRelease(&handler);
+	if (retcode != SCIP_OKAY) {
+		throw ScipError::from_retcode(retcode);
+	}
+}
+
+}  // namespace
+
+void Model::capture_log(std::size_t capacity) {
+	SCIP_MESSAGEHDLR* handler = nullptr;
+	if (capacity == 0) {
+		scip::call(SCIPcreateMessagehdlrDefault, &handler, true, nullptr, true);
+		set_handler(get_scip_ptr(), handler);
+		scimpl->log_buffer() = nullptr;
+		return;
+	}
+	auto buffer = std::make_shared<LogBuffer>(capacity);
+	// The buffer is not deleted by SCIP
+	scip::call(SCIPcreateObjMessagehdlr, &handler, buffer.get(), false);
+	set_handler(get_scip_ptr(), handler);
+	scimpl->log_buffer() = std::move(buffer);
+	set_messagehdlr_quiet(false);
+}
+
+auto Model::captured_log() const -> std::string {
+	auto const& buffer = scimpl->log_buffer();
+	return buffer != nullptr ? buffer->log() : std::string{};
+}
+
+void Model::clear_captured_log() noexcept {
+	if (auto const& buffer = scimpl->log_buffer(); buffer != nullptr) {
+		buffer->clear();
+	}
+}
+
+}  // namespace ecole::scip
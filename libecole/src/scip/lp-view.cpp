@@ -0,0 +1,126 @@
+#include <algorithm>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+#include <scip/scip.h>
+
+#include "ecole/scip/exception.hpp"
+#include "ecole/scip/lp-view.hpp"
+#include "ecole/scip/model.hpp"
+
+namespace ecole::scip {
+
+namespace {
+
+auto current_lp_key(SCIP* scip) noexcept -> std::tuple<SCIP_Longint, SCIP_Longint, SCIP_Longint> {
+	auto* const node = SCIPgetFocusNode(scip);
+	auto const node_number = (node != nullptr) ? SCIPnodeGetNumber(node) : SCIP_Longint{-1};
+	return {node_number, SCIPgetNLPs(scip), SCIPgetNLPIterations(scip)};
+}
+
+}  // namespace
+
+LpView::LpView(Model& model) {
+	auto* const scip = model.get_scip_ptr();
+	if (SCIPgetStage(scip) != SCIP_STAGE_SOLVING) {
+		throw ScipError::from_retcode(SCIP_INVALIDCALL);
+	}
+	lp_key = current_lp_key(scip);
+
+	auto const lp_cols = model.lp_columns();
+	auto const n_cols = lp_cols.size();
+	columns.assign(lp_cols.begin(), lp_cols.end());
+	column_var_indices.resize(n_cols);
+	column_objectives.resize(n_cols);
+	column_lower_bounds.resize(n_cols);
+	column_upper_bounds.resize(n_cols);
+	column_primal_values.resize(n_cols);
+	column_reduced_costs.resize(n_cols);
+	column_basis_statuses.resize(n_cols);
+	for (std::size_t j = 0; j < n_cols; ++j) {
+		auto* const col = columns[j];
+		column_var_indices[j] = static_cast<std::size_t>(SCIPcolGetVarProbindex(col));
+		column_objectives[j] = SCIPcolGetObj(col);
+		column_lower_bounds[j] = SCIPcolGetLb(col);
+		column_upper_bounds[j] = SCIPcolGetUb(col);
+		column_primal_values[j] = SCIPcolGetPrimsol(col);
+		column_reduced_costs[j] = SCIPgetColRedcost(scip, col);
+		column_basis_statuses[j] = SCIPcolGetBasisStatus(col);
+	}
+
+	auto const lp_rows = model.lp_rows();
+	auto const n_rows = lp_rows.size();
+	rows.assign(lp_rows.begin(), lp_rows.end());
+	row_lhs.resize(n_rows);
+	row_rhs.resize(n_rows);
+	row_constants.resize(n_rows);
+	row_activities.resize(n_rows);
+	row_dual_values.resize(n_rows);
+	row_basis_statuses.resize(n_rows);
+	row_pointers.resize(n_rows + 1);
+	row_pointers[0] = 0;
+	for (std::size_t i = 0; i < n_rows; ++i) {
+		auto* const row = rows[i];
+		row_lhs[i] = SCIProwGetLhs(row);
+		row_rhs[i] = SCIProwGetRhs(row);
+		row_constants[i] = SCIProwGetConstant(row);
+		row_activities[i] = SCIPgetRowActivity(scip, row);
+		row_dual_values[i] = SCIProwGetDualsol(row);
+		row_basis_statuses[i] = SCIProwGetBasisStatus(row);
+		row_pointers[i + 1] = row_pointers[i] + static_cast<std::size_t>(SCIProwGetNLPNonz(row));
+	}
+
+	// The LP non zeros are stored first in every row, followed by those on columns not in the LP
+	column_indices.resize(row_pointers[n_rows]);
+	values.resize(row_pointers[n_rows]);
+	for (std::size_t i = 0; i < n_rows; ++i) {
+		auto* const row = rows[i];
+		auto* const row_cols = SCIProwGetCols(row);
+		auto const* const row_vals = SCIProwGetVals(row);
+		auto const begin = row_pointers[i];
+		auto const row_nnz = row_pointers[i + 1] - begin;
+		for (std::size_t k = 0; k < row_nnz; ++k) {
+			column_indices[begin + k] = static_cast<std::size_t>(SCIPcolGetLPPos(row_cols[k]));
+		}
+		std::copy_n(row_vals, row_nnz, values.begin() + static_cast<std::ptrdiff_t>(begin));
+	}
+}
+
+auto LpView::n_bytes() const noexcept -> std::size_t {
+	auto bytes = [](auto const&... vecs) {
+		return ((vecs.capacity() * sizeof(typename std::decay_t<decltype(vecs)>::value_type)) + ...);
+	};
+	return bytes(
+		columns,
+		column_var_indices,
+		column_objectives,
+		column_lower_bounds,
+		column_upper_bounds,
+		column_primal_values,
+		column_reduced_costs,
+		column_basis_statuses,
+		rows,
+		row_lhs,
+		row_rhs,
+		row_constants,
+		row_activities,
+		row_dual_values,
+		row_basis_statuses,
+		row_pointers,
+		column_indices,
+		values);
+}
+
+void prepare_lp_view(Model& model) {
+	if (model.stage() == SCIP_STAGE_SOLVING) {
+		static_cast<void>(model.lp_view());
+	}
+}
+
+auto LpView::is_current(Model const& model) const noexcept -> bool {
+	auto* const scip = const_cast<SCIP*>(model.get_scip_ptr());
+	return (SCIPgetStage(scip) == SCIP_STAGE_SOLVING) && (current_lp_key(scip) == lp_key);
+}
+
+}  // namespace ecole::scip
@@ -0,0 +1,75 @@
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <mutex>
+#include <utility>
+
+#include "ecole/scip/model-pool.hpp"
+#include "ecole/scip/model.hpp"
+
+namespace ecole::scip {
+
+ModelPool::ModelPool(PluginProfile profile, std::size_t max_size) : m_profile{profile}, m_max_size{max_size} {}
+
+auto ModelPool::acquire() -> Model {
+	{
+		auto const lk = std::lock_guard{m_mutex};
+		if (!m_models.empty()) {
+			auto model = std::move(m_models.back());
+			m_models.pop_back();
+			return model;
+		}
+	}
+	return Model{m_profile};
+}
+
+auto ModelPool::from_file(std::filesystem::path const& filename) -> Model {
+	auto model = acquire();
+	try {
+		model.read_problem(filename.string());
+	} catch (...) {
+		release(std::move(model));
+		throw;
+	}
+	return model;
+}
+
+void ModelPool::release(Model&& model) {
+	if (size() >= m_max_size) {
+		return;
+	}
+	// Recycled outside of the lock since it frees the problem
+	auto recycled = std::move(model);
+	try {
+		if (!recycled.recycle(m_profile)) {
+			return;
+		}
+	} catch (...) {
+		// Models that fail to recycle are simply freed
+		return;
+	}
+	auto const lk = std::lock_guard{m_mutex};
+	if (m_models.size() < m_max_size) {
+		m_models.push_back(std::move(recycled));
+	}
+}
+
+void ModelPool::reserve(std::size_t n_models) {
+	auto const n_target = std::min(n_models, m_max_size);
+	// Created outside of the lock since it includes all the plugins
+	for (auto n_available = size(); n_available < n_target; ++n_available) {
+		auto model = Model{m_profile};
+		auto const lk = std::lock_guard{m_mutex};
+		if (m_models.size() >= n_target) {
+			return;
+		}
+		m_models.push_back(std::move(model));
+	}
+}
+
+auto ModelPool::size() const -> std::size_t {
+	auto const lk = std::lock_guard{m_mutex};
+	return m_models.size();
+}
+
+}  // namespace ecole::scip
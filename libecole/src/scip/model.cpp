@@ -1,28 +1,121 @@
 #include <algorithm>
 #include <cassert>
 #include <cstddef>
+#include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <iterator>
+#include <optional>
+#include <random>
 #include <stdexcept>
 #include <string>
+#include <string_view>
+#include <system_error>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
 
 #include <fmt/format.h>
-#include <range/v3/view/move.hpp>
 #include <scip/scip.h>
-#include <scip/scipdefplugins.h>
 
 #include "ecole/scip/callback.hpp"
+#include "ecole/scip/cons.hpp"
 #include "ecole/scip/exception.hpp"
+#include "ecole/scip/lp-view.hpp"
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/scimpl.hpp"
 #include "ecole/scip/utils.hpp"
-#include "ecole/utility/unreachable.hpp"
+#include "ecole/utility/coroutine.hpp"
+
+#include "utility/decompress.hpp"
+#include "utility/hash.hpp"
 
 namespace ecole::scip {
 
-Model::Model() : Model{std::make_unique<Scimpl>()} {
-	scip::call(SCIPincludeDefaultPlugins, get_scip_ptr());
+namespace {
+
+/** A file with the given content, that SCIP readers can open, and that is removed upon destruction. */
+class BufferFile {
+public:
+	BufferFile(std::string_view data, std::string const& format) {
+#ifdef __linux__
+		if (write_memory_file(data)) {
+			return;
+		}
+#endif
+		write_temporary_file(data, format);
+	}
+
+	BufferFile(BufferFile const&) = delete;
+	BufferFile(BufferFile&&) = delete;
+	auto operator=(BufferFile const&) -> BufferFile& = delete;
+	auto operator=(BufferFile&&) -> BufferFile& = delete;
+
+	~BufferFile() {
+#ifdef __linux__
+		if (fd >= 0) {
+			::close(fd);
+			return;
+		}
+#endif
+		auto error = std::error_code{};
+		std::filesystem::remove(path, error);
+	}
+
+	[[nodiscard]] auto filename() const noexcept -> std::string const& { return path; }
+
+private:
+	std::string path;
+#ifdef __linux__
+	int fd = -1;
+#endif
+
+#ifdef __linux__
+	/** Anonymous file living in memory, opened again by SCIP through its /proc entry. */
+	auto write_memory_file(std::string_view data) -> bool {
+		fd = ::memfd_create("ecole-problem", MFD_CLOEXEC);
+		if (fd < 0) {
+			return false;
+		}
+		for (auto remaining = data; !remaining.empty();) {
+			auto const n_written = ::write(fd, remaining.data(), remaining.size());
+			if (n_written < 0) {
+				::close(fd);
+				fd = -1;
+				return false;
+			}
+			remaining.remove_prefix(static_cast<std::size_t>(n_written));
+		}
+		path = fmt::format("/proc/self/fd/{}", fd);
+		return true;
+	}
+#endif
+
+	void write_temporary_file(std::string_view data, std::string const& format) {
+		auto device = std::random_device{};
+		path = (std::filesystem::temp_directory_path() / fmt::format("ecole-problem-{:08x}.{}", device(), format))
+				   .string();
+		auto file = std::ofstream{path, std::ios::binary};
+		file.write(data.data(), static_cast<std::streamsize>(data.size()));
+		if (!file) {
+			throw ScipError{fmt::format("Could not write the problem to temporary file {}.", path)};
+		}
+	}
+};
+
+}  // namespace
+
+Model::Model() : Model{PluginProfile::full} {}
+
+Model::Model(PluginProfile profile) : Model{std::make_unique<Scimpl>()} {
+	include_plugins(get_scip_ptr(), profile);
+	scimpl->set_plugin_profile(profile);
 }
 
 Model::Model(Model&&) noexcept = default;
@@ -42,6 +135,15 @@ SCIP const* Model::get_scip_ptr() const noexcept {
 	return scimpl->get_scip_ptr();
 }
 
+bool Model::recycle(PluginProfile profile) {
+	if (scimpl == nullptr || !scimpl->recycle(profile)) {
+		return false;
+	}
+	set_messagehdlr_quiet(true);
+	clear_captured_log();
+	return true;
+}
+
 Model Model::copy() const {
 	return std::make_unique<Scimpl>(scimpl->copy());
 }
@@ -50,6 +152,22 @@ Model Model::copy_orig() const {
 	return std::make_unique<Scimpl>(scimpl->copy_orig());
 }
 
+Model Model::fork() const {
+	return std::make_unique<Scimpl>(scimpl->fork());
+}
+
+std::optional<Model> Model::copy_problem(PluginProfile profile) const {
+	auto copy = scimpl->copy_problem(profile);
+	if (!copy.has_value()) {
+		return {};
+	}
+	return {std::make_unique<Scimpl>(std::move(copy).value())};
+}
+
+bool Model::load_problem(Model const& other) {
+	return scimpl->load_problem(*other.scimpl);
+}
+
 bool Model::operator==(Model const& other) const noexcept {
 	return scimpl == other.scimpl;
 }
@@ -58,14 +176,20 @@ bool Model::operator!=(Model const& other) const noexcept {
 	return !(*this == other);
 }
 
-Model Model::from_file(std::filesystem::path const& filename) {
-	auto model = Model{};
+Model Model::from_file(std::filesystem::path const& filename, PluginProfile profile) {
+	auto model = Model{profile};
 	model.read_problem(filename.c_str());
 	return model;
 }
 
-Model Model::prob_basic(std::string const& name) {
-	auto model = Model{};
+Model Model::from_buffer(std::string_view data, std::string const& format, PluginProfile profile) {
+	auto model = Model{profile};
+	model.read_problem_from_buffer(data, format);
+	return model;
+}
+
+Model Model::prob_basic(std::string const& name, PluginProfile profile) {
+	auto model = Model{profile};
 	scip::call(SCIPcreateProbBasic, model.get_scip_ptr(), name.c_str());
 	return model;
 }
@@ -75,9 +199,32 @@ void Model::write_problem(std::filesystem::path const& filename) const {
 }
 
 void Model::read_problem(std::string const& filename) {
+	auto const path = std::filesystem::path{filename};
+	auto const compression = utility::compression_of(path);
+	if (compression == utility::Compression::zstd && !utility::can_decompress(compression)) {
+		throw ScipError{fmt::format("Cannot read {}, Ecole was built without zstd.", filename)};
+	}
+	// Compressed files are decompressed in memory, much faster than SCIP readers do, and parsed from there
+	auto const format = path.stem().extension().string();
+	if (compression != utility::Compression::none && utility::can_decompress(compression) && !format.empty()) {
+		auto data = std::string{};
+		try {
+			data = utility::read_decompressed(path, compression);
+		} catch (std::runtime_error const& error) {
+			throw ScipError{error.what()};
+		}
+		read_problem_from_buffer(data, format.substr(1));
+		return;
+	}
 	scip::call(SCIPreadProb, get_scip_ptr(), filename.c_str(), nullptr);
 }
 
+void Model::read_problem_from_buffer(std::string_view data, std::string const& format) {
+	auto const file = BufferFile{data, format};
+	// The extension is given explicitly since the in-memory file has none
+	scip::call(SCIPreadProb, get_scip_ptr(), file.filename().c_str(), format.c_str());
+}
+
 void Model::set_messagehdlr_quiet(bool quiet) noexcept {
 	SCIPsetMessagehdlrQuiet(get_scip_ptr(), static_cast<SCIP_Bool>(quiet));
 }
@@ -95,26 +242,7 @@ SCIP_STAGE Model::stage() const noexcept {
 }
 
 ParamType Model::get_param_type(std::string const& name) const {
-	auto* scip_param = SCIPgetParam(const_cast<SCIP*>(get_scip_ptr()), name.c_str());
-	if (scip_param == nullptr) {
-		throw scip::ScipError::from_retcode(SCIP_PARAMETERUNKNOWN);
-	}
-	switch (SCIPparamGetType(scip_param)) {
-	case SCIP_PARAMTYPE_BOOL:
-		return ParamType::Bool;
-	case SCIP_PARAMTYPE_INT:
-		return ParamType::Int;
-	case SCIP_PARAMTYPE_LONGINT:
-		return ParamType::LongInt;
-	case SCIP_PARAMTYPE_REAL:
-		return ParamType::Real;
-	case SCIP_PARAMTYPE_CHAR:
-		return ParamType::Char;
-	case SCIP_PARAMTYPE_STRING:
-		return ParamType::String;
-	default:
-		utility::unreachable();
-	}
+	return param_type(find_param(const_cast<SCIP*>(get_scip_ptr()), name));
 }
 
 template <> void Model::set_param<ParamType::Bool>(std::string const& name, bool value) {
@@ -167,31 +295,107 @@ template <> std::string Model::get_param<ParamType::String>(std::string const& n
 	return ptr;
 }
 
-void Model::set_params(std::map<std::string, Param> name_values) {
-	for (auto&& [name, value] : ranges::views::move(name_values)) {
-		set_param(name, std::move(value));
+template <ParamType T> ParamHandle<T> Model::param_handle(std::string const& name) {
+	auto* const param = find_param(get_scip_ptr(), name);
+	if (param_type(param) != T) {
+		throw scip::ScipError{fmt::format("Parameter <{}> is not of the requested type.", name)};
 	}
+	return {get_scip_ptr(), param};
 }
 
+template ParamHandle<ParamType::Bool> Model::param_handle<ParamType::Bool>(std::string const& name);
+template ParamHandle<ParamType::Int> Model::param_handle<ParamType::Int>(std::string const& name);
+template ParamHandle<ParamType::LongInt> Model::param_handle<ParamType::LongInt>(std::string const& name);
+template ParamHandle<ParamType::Real> Model::param_handle<ParamType::Real>(std::string const& name);
+template ParamHandle<ParamType::Char> Model::param_handle<ParamType::Char>(std::string const& name);
+template ParamHandle<ParamType::String> Model::param_handle<ParamType::String>(std::string const& name);
+
 namespace {
 
+/** Change the value of a parameter, unless it already holds it. */
+template <ParamType T> void set_param_if_changed(SCIP* scip, SCIP_PARAM* param, Param const& value) {
+	auto const handle = ParamHandle<T>{scip, param};
+	auto new_value = internal::cast<param_t<T>>(value);
+	if (handle.get() != new_value) {
+		handle.set(std::move(new_value));
+	}
+}
+
+auto get_param_value(SCIP* scip, SCIP_PARAM* param) -> Param {
+	switch (param_type(param)) {
+	case ParamType::Bool:
+		return ParamHandle<ParamType::Bool>{scip, param}.get();
+	case ParamType::Int:
+		return ParamHandle<ParamType::Int>{scip, param}.get();
+	case ParamType::LongInt:
+		return ParamHandle<ParamType::LongInt>{scip, param}.get();
+	case ParamType::Real:
+		return ParamHandle<ParamType::Real>{scip, param}.get();
+	case ParamType::Char:
+		return ParamHandle<ParamType::Char>{scip, param}.get();
+	case ParamType::String:
+		return ParamHandle<ParamType::String>{scip, param}.get();
+	default:
+		utility::unreachable();
+	}
+}
+
 nonstd::span<SCIP_PARAM*> get_params_span(Model const& model) noexcept {
 	auto* const scip = const_cast<SCIP*>(model.get_scip_ptr());
 	return {SCIPgetParams(scip), static_cast<std::size_t>(SCIPgetNParams(scip))};
 }
 
-}  // namespace
-
-std::map<std::string, Param> Model::get_params() const {
+/** Read the parameters directly from their SCIP handle, without looking them up by name again. */
+auto get_params_if(Model const& model, bool changed_only) -> std::map<std::string, Param> {
+	auto* const scip = const_cast<SCIP*>(model.get_scip_ptr());
 	std::map<std::string, Param> name_values{};
-	for (auto* const param : get_params_span(*this)) {
-		auto name = std::string{SCIPparamGetName(param)};
-		auto value = get_param<Param>(name);
-		name_values.insert({std::move(name), std::move(value)});
+	for (auto* const param : get_params_span(model)) {
+		if (!changed_only || !SCIPparamIsDefault(param)) {
+			name_values.emplace_hint(name_values.end(), SCIPparamGetName(param), get_param_value(scip, param));
+		}
 	}
 	return name_values;
 }
 
+}  // namespace
+
+void Model::set_params(std::map<std::string, Param> const& name_values) {
+	auto* const scip = get_scip_ptr();
+	for (auto const& [name, value] : name_values) {
+		auto* const param = find_param(scip, name);
+		switch (param_type(param)) {
+		case ParamType::Bool:
+			set_param_if_changed<ParamType::Bool>(scip, param, value);
+			break;
+		case ParamType::Int:
+			set_param_if_changed<ParamType::Int>(scip, param, value);
+			break;
+		case ParamType::LongInt:
+			set_param_if_changed<ParamType::LongInt>(scip, param, value);
+			break;
+		case ParamType::Real:
+			set_param_if_changed<ParamType::Real>(scip, param, value);
+			break;
+		case ParamType::Char:
+			set_param_if_changed<ParamType::Char>(scip, param, value);
+			break;
+		case ParamType::String:
+			set_param_if_changed<ParamType::String>(scip, param, value);
+			break;
+		default:
+			utility::unreachable();
+		}
+	}
+}
+
+std::map<std::string, Param> Model::get_params() const {
+	return get_params_if(*this, false);
+}
+
+std::map<std::string, Param> Model::get_changed_params() const {
+	return get_params_if(*this, true);
+}
+
 void Model::disable_presolve() {
 	scip::call(SCIPsetPresolving, get_scip_ptr(), SCIP_PARAMSETTING_OFF, true);
 }
@@ -227,11 +431,99 @@ nonstd::span<SCIP_COL*> Model::lp_columns() const {
 	return {SCIPgetLPCols(scip_ptr), static_cast<std::size_t>(SCIPgetNLPCols(scip_ptr))};
 }
 
+std::shared_ptr<LpView const> Model::lp_view() {
+	auto& cached = scimpl->lp_view_cache();
+	if (cached == nullptr || !cached->is_current(*this)) {
+		cached = std::make_shared<LpView const>(*this);
+	}
+	return cached;
+}
+
+auto Model::memory_usage() const noexcept -> MemoryUsage {
+	auto* const scip_ptr = const_cast<SCIP*>(get_scip_ptr());
+	auto const& lp_view = scimpl->lp_view_cache();
+	return {
+		static_cast<std::size_t>(SCIPgetMemUsed(scip_ptr)),
+		static_cast<std::size_t>(SCIPgetMemTotal(scip_ptr)),
+		static_cast<std::size_t>(SCIPgetMemExternEstim(scip_ptr)),
+		lp_view != nullptr ? lp_view->n_bytes() : 0,
+	};
+}
+
 nonstd::span<SCIP_CONS*> Model::constraints() const noexcept {
 	auto* const scip_ptr = const_cast<SCIP*>(get_scip_ptr());
 	return {SCIPgetConss(scip_ptr), static_cast<std::size_t>(SCIPgetNConss(scip_ptr))};
 }
 
+namespace {
+
+/** The fingerprint of the problem, and whether all the data of its constraints were hashed. */
+auto hash_problem(Model const& model) -> std::pair<std::uint64_t, bool> {
+	auto* const scip_ptr = const_cast<SCIP*>(model.get_scip_ptr());
+	auto hasher = utility::Hasher{};
+	auto exact = true;
+	hasher.add(static_cast<int>(SCIPgetObjsense(scip_ptr)));
+	hasher.add(SCIPgetOrigObjoffset(scip_ptr));
+	if (SCIPgetStage(scip_ptr) >= SCIP_STAGE_TRANSFORMED) {
+		hasher.add(SCIPgetTransObjoffset(scip_ptr));
+	}
+	auto const vars = model.variables();
+	hasher.add(static_cast<std::uint64_t>(vars.size()));
+	for (auto* const var : vars) {
+		hasher.add(static_cast<int>(SCIPvarGetType(var)));
+		hasher.add(SCIPvarGetObj(var));
+		hasher.add(SCIPvarGetLbGlobal(var));
+		hasher.add(SCIPvarGetUbGlobal(var));
+	}
+	auto const conss = model.constraints();
+	hasher.add(static_cast<std::uint64_t>(conss.size()));
+	auto cons_vars = std::vector<SCIP_VAR*>{};
+	auto cons_vals = std::vector<SCIP_Real>{};
+	for (auto* const cons : conss) {
+		hasher.add(std::string_view{SCIPconshdlrGetName(SCIPconsGetHdlr(cons))});
+		auto const n_vars = get_cons_n_vars(scip_ptr, cons);
+		if (!n_vars.has_value()) {
+			exact = false;
+			continue;
+		}
+		hasher.add(static_cast<std::uint64_t>(n_vars.value()));
+		cons_vars.resize(n_vars.value());
+		if (get_cons_vars(scip_ptr, cons, cons_vars)) {
+			for (auto* const var : cons_vars) {
+				hasher.add(SCIPvarGetProbindex(var));
+			}
+		} else {
+			exact = false;
+		}
+		cons_vals.resize(n_vars.value());
+		if (get_cons_vals(scip_ptr, cons, cons_vals)) {
+			hasher.add(nonstd::span<SCIP_Real const>{cons_vals.data(), cons_vals.size()});
+		} else {
+			exact = false;
+		}
+		auto const lhs = cons_get_lhs(scip_ptr, cons);
+		auto const rhs = cons_get_rhs(scip_ptr, cons);
+		exact = exact && lhs.has_value() && rhs.has_value();
+		hasher.add(lhs.value_or(-SCIPinfinity(scip_ptr)));
+		hasher.add(rhs.value_or(SCIPinfinity(scip_ptr)));
+	}
+	return {hasher.digest(), exact};
+}
+
+}  // namespace
+
+std::uint64_t Model::fingerprint() const {
+	return hash_problem(*this).first;
+}
+
+std::optional<std::uint64_t> Model::exact_fingerprint() const {
+	auto const [fingerprint, exact] = hash_problem(*this);
+	if (!exact) {
+		return {};
+	}
+	return fingerprint;
+}
+
 nonstd::span<SCIP_ROW*> Model::lp_rows() const {
 	auto* const scip_ptr = const_cast<SCIP*>(get_scip_ptr());
 	if (SCIPgetStage(scip_ptr) != SCIP_STAGE_SOLVING) {
@@ -256,6 +548,16 @@ void Model::solve() {
 	scip::call(SCIPsolve, get_scip_ptr());
 }
 
+void Model::solve_concurrent() {
+	auto* const scip = get_scip_ptr();
+	auto const stage = SCIPgetStage(scip);
+	scip::call(SCIPsolveConcurrent, scip);
+	// Without a task processing interface, SCIP only prints a message and returns
+	if (SCIPgetStage(scip) == stage) {
+		scip::call(SCIPsolve, scip);
+	}
+}
+
 bool Model::is_solved() const noexcept {
 	return SCIPgetStage(const_cast<SCIP*>(get_scip_ptr())) == SCIP_STAGE_SOLVED;
 }
@@ -307,4 +609,32 @@ auto Model::solve_iter_continue(SCIP_RESULT result) -> std::optional<callback::D
 	return scimpl->solve_iter_continue(result);
 }
 
+void Model::solve_iter_set_deadline(std::chrono::nanoseconds timeout, SCIP_RESULT fallback) {
+	scimpl->solve_iter_set_deadline(timeout, fallback);
+}
+
+auto Model::solve_iter_reclaim() -> bool {
+	return scimpl->solve_iter_reclaim();
+}
+
+auto Model::callback_statistics() const noexcept -> callback::Statistics {
+	return scimpl->callback_statistics();
+}
+
+utility::CoroutineBackend Model::coroutine_backend() const noexcept {
+	return scimpl->coroutine_backend();
+}
+
+void Model::set_coroutine_backend(utility::CoroutineBackend backend) noexcept {
+	scimpl->set_coroutine_backend(backend);
+}
+
+utility::AffinityPolicy Model::coroutine_affinity() const noexcept {
+	return scimpl->coroutine_affinity();
+}
+
+void Model::set_coroutine_affinity(utility::AffinityPolicy affinity) noexcept {
+	scimpl->set_coroutine_affinity(affinity);
+}
+
 }  // namespace ecole::scip
@@ -0,0 +1,85 @@
+#include <string>
+
+#include <scip/scip.h>
+
+#include "ecole/scip/exception.hpp"
+#include "ecole/scip/param.hpp"
+#include "ecole/scip/utils.hpp"
+#include "ecole/utility/unreachable.hpp"
+
+namespace ecole::scip {
+
+auto find_param(SCIP* scip, std::string const& name) -> SCIP_PARAM* {
+	auto* const param = SCIPgetParam(scip, name.c_str());
+	if (param == nullptr) {
+		throw ScipError::from_retcode(SCIP_PARAMETERUNKNOWN);
+	}
+	return param;
+}
+
+auto param_type(SCIP_PARAM* param) noexcept -> ParamType {
+	switch (SCIPparamGetType(param)) {
+	case SCIP_PARAMTYPE_BOOL:
+		return ParamType::Bool;
+	case SCIP_PARAMTYPE_INT:
+		return ParamType::Int;
+	case SCIP_PARAMTYPE_LONGINT:
+		return ParamType::LongInt;
+	case SCIP_PARAMTYPE_REAL:
+		return ParamType::Real;
+	case SCIP_PARAMTYPE_CHAR:
+		return ParamType::Char;
+	case SCIP_PARAMTYPE_STRING:
+		return ParamType::String;
+	default:
+		utility::unreachable();
+	}
+}
+
+template <ParamType T>
+ParamHandle<T>::ParamHandle(SCIP* scip_, SCIP_PARAM* param_) noexcept : scip(scip_), param(param_) {}
+
+template <ParamType T> auto ParamHandle<T>::get() const -> param_t<T> {
+	if constexpr (T == ParamType::Bool) {
+		return static_cast<bool>(SCIPparamGetBool(param));
+	} else if constexpr (T == ParamType::Int) {
+		return SCIPparamGetInt(param);
+	} else if constexpr (T == ParamType::LongInt) {
+		return SCIPparamGetLongint(param);
+	} else if constexpr (T == ParamType::Real) {
+		return SCIPparamGetReal(param);
+	} else if constexpr (T == ParamType::Char) {
+		return SCIPparamGetChar(param);
+	} else {
+		return SCIPparamGetString(param);
+	}
+}
+
+template <ParamType T> void ParamHandle<T>::set(utility::value_or_const_ref_t<param_t<T>> value) const {
+	if constexpr (T == ParamType::Bool) {
+		scip::call(SCIPchgBoolParam, scip, param, static_cast<SCIP_Bool>(value));
+	} else if constexpr (T == ParamType::Int) {
+		scip::call(SCIPchgIntParam, scip, param, value);
+	} else if constexpr (T == ParamType::LongInt) {
+		scip::call(SCIPchgLongintParam, scip, param, value);
+	} else if constexpr (T == ParamType::Real) {
+		scip::call(SCIPchgRealParam, scip, param, value);
+	} else if constexpr (T == ParamType::Char) {
+		scip::call(SCIPchgCharParam, scip, param, value);
+	} else {
+		scip::call(SCIPchgStringParam, scip, param, value.c_str());
+	}
+}
+
+template <ParamType T> auto ParamHandle<T>::name() const -> char const* {
+	return SCIPparamGetName(param);
+}
+
+template class ParamHandle<ParamType::Bool>;
+template class ParamHandle<ParamType::Int>;
+template class ParamHandle<ParamType::LongInt>;
+template class ParamHandle<ParamType::Real>;
+template class ParamHandle<ParamType::Char>;
+template class ParamHandle<ParamType::String>;
+
+}  // namespace ecole::scip
@@ -0,0 +1,54 @@
+#include <scip/scip.h>
+#include <scip/scipdefplugins.h>
+
+#include "ecole/scip/plugins.hpp"
+#include "ecole/scip/utils.hpp"
+#include "ecole/utility/unreachable.hpp"
+
+namespace ecole::scip {
+
+namespace {
+
+void include_modeling_plugins(SCIP* scip) {
+	// Linear constraints must come first since the specialized ones register themselves as its upgrades
+	scip::call(SCIPincludeConshdlrLinear, scip);
+	scip::call(SCIPincludeConshdlrSetppc, scip);
+	scip::call(SCIPincludeConshdlrLogicor, scip);
+	scip::call(SCIPincludeConshdlrKnapsack, scip);
+	scip::call(SCIPincludeConshdlrVarbound, scip);
+	scip::call(SCIPincludeConshdlrBounddisjunction, scip);
+	scip::call(SCIPincludeReaderCip, scip);
+	scip::call(SCIPincludeReaderLp, scip);
+	scip::call(SCIPincludeReaderMps, scip);
+}
+
+void include_branching_plugins(SCIP* scip) {
+	include_modeling_plugins(scip);
+	scip::call(SCIPincludeConshdlrIntegral, scip);
+	scip::call(SCIPincludeNodeselBfs, scip);
+	scip::call(SCIPincludeNodeselDfs, scip);
+	scip::call(SCIPincludeNodeselEstimate, scip);
+	scip::call(SCIPincludeBranchruleMostinf, scip);
+	scip::call(SCIPincludeBranchrulePscost, scip);
+	scip::call(SCIPincludeBranchruleRelpscost, scip);
+	// Used by the strong branching observation functions
+	scip::call(SCIPincludeBranchruleVanillafullstrong, scip);
+	scip::call(SCIPincludeDispDefault, scip);
+	scip::call(SCIPincludeTableDefault, scip);
+}
+
+}  // namespace
+
+void include_plugins(SCIP* scip, PluginProfile profile) {
+	switch (profile) {
+	case PluginProfile::full:
+		return scip::call(SCIPincludeDefaultPlugins, scip);
+	case PluginProfile::branching:
+		return include_branching_plugins(scip);
+	case PluginProfile::modeling:
+		return include_modeling_plugins(scip);
+	}
+	utility::unreachable();
+}
+
+}  // namespace ecole::scip
@@ -1,14 +1,28 @@
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstddef>
+#include <exception>
 #include <mutex>
+#include <optional>
+#include <string>
 #include <scip/type_result.h>
 #include <scip/type_retcode.h>
 #include <tuple>
 #include <type_traits>
 #include <utility>
+#include <variant>
+#include <vector>
 
 #include <objscip/objbranchrule.h>
+#include <objscip/objcutsel.h>
+#include <objscip/objeventhdlr.h>
 #include <objscip/objheur.h>
+#include <objscip/objnodesel.h>
+#include <objscip/objpresol.h>
+#include <objscip/objsepa.h>
 #include <scip/scip.h>
 #include <scip/scipdefplugins.h>
 #include <scip/type_timing.h>
@@ -17,6 +31,8 @@
 #include "ecole/scip/scimpl.hpp"
 #include "ecole/scip/utils.hpp"
 #include "ecole/utility/coroutine.hpp"
+#include "ecole/utility/metrics.hpp"
+#include "ecole/utility/tracing.hpp"
 
 namespace ecole::scip {
 
@@ -24,18 +40,84 @@ namespace ecole::scip {
  *  Definition of reverse Callbacks  *
  *************************************/
 
+/** Atomic since they are read by the caller while the solver thread may still be running. */
+struct SolverCounters {
+	std::atomic<std::size_t> n_skipped_calls = 0;
+	std::atomic<std::chrono::nanoseconds::rep> solving_time_ns = 0;
+	/** Only used by the solver thread. */
+	std::chrono::steady_clock::time_point running_since;
+	/** The first exception of a callback, turned into a SCIP error to go through SCIP, and rethrown after solving. */
+	std::exception_ptr callback_error = nullptr;  // NOLINT(bugprone-throw-keyword-missing)
+};
+
 namespace {
 
+/** Counters of the model being solved by the current solver thread, if any. */
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+thread_local SolverCounters* solver_counters = nullptr;
+
+void count_skipped_call() noexcept {
+	if (solver_counters != nullptr) {
+		solver_counters->n_skipped_calls.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+/** Keep the exception being handled to rethrow it after solving, in place of the SCIP error it is turned into. */
+void store_callback_error() noexcept {
+	if (solver_counters != nullptr && solver_counters->callback_error == nullptr) {
+		solver_counters->callback_error = std::current_exception();
+	}
+}
+
+/** Add the time since the solver last started running to its solving time. */
+void count_solving_time() noexcept {
+	if (solver_counters != nullptr) {
+		auto const now = std::chrono::steady_clock::now();
+		auto const elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(now - solver_counters->running_since);
+		solver_counters->solving_time_ns.fetch_add(elapsed.count(), std::memory_order_relaxed);
+		solver_counters->running_since = now;
+	}
+}
+
 using Controller = utility::Coroutine<callback::DynamicCall, SCIP_RESULT>;
 using Executor = typename Controller::Executor;
 
+/** Where a reverse callback stands among those of an iterative solving. */
+struct Position {
+	/** Among the callbacks of the same type, which gives its name. */
+	std::size_t type_index;
+	/** Among all the constructors given to solve_iter, which is given back in calls. */
+	std::size_t constructor_index;
+};
+
 /**
- * Function to add a callback to SCIP.
+ * Function to add a callback to SCIP, or give the one already included at the same position to a new solving.
  *
  * Needs to be implemented by all reverse callbacks.
  */
 template <callback::Type type>
-auto include_reverse_callback(SCIP* scip, std::weak_ptr<Executor> executor, callback::Constructor<type> args) -> void;
+auto include_reverse_callback(
+	SCIP* scip,
+	std::weak_ptr<Executor> executor,
+	callback::Constructor<type> args,
+	Position position) -> void;
+
+/** Set the counters of the current solver thread for the lifetime of the object. */
+class CountersGuard {
+public:
+	explicit CountersGuard(SolverCounters* counters) noexcept {
+		solver_counters = counters;
+		counters->running_since = std::chrono::steady_clock::now();
+	}
+	CountersGuard(CountersGuard const&) = delete;
+	CountersGuard(CountersGuard&&) = delete;
+	auto operator=(CountersGuard const&) -> CountersGuard& = delete;
+	auto operator=(CountersGuard&&) -> CountersGuard& = delete;
+	~CountersGuard() {
+		count_solving_time();
+		solver_counters = nullptr;
+	}
+};
 
 /**
  * In a callback send Callback type and wait for result.
@@ -51,6 +133,15 @@ auto handle_executor(SCIP* scip, std::weak_ptr<Executor>& weak_executor, callbac
 		return {SCIP_OKAY, SCIP_DIDNOTRUN};
 	}
 	try {
+		count_solving_time();
+		auto const message = [&] {
+			// The solver thread is idle while the agent decides
+			ECOLE_TRACE_SPAN("Executor::yield");
+			return weak_executor.lock()->yield(call);
+		}();
+		if (solver_counters != nullptr) {
+			solver_counters->running_since = std::chrono::steady_clock::now();
+		}
 		return std::visit(
 			[&](auto result_or_stop) -> std::tuple<SCIP_RETCODE, SCIP_RESULT> {
 				using StopToken = Executor::StopToken;
@@ -60,12 +151,40 @@ auto handle_executor(SCIP* scip, std::weak_ptr<Executor>& weak_executor, callbac
 					return {SCIP_OKAY, result_or_stop};
 				}
 			},
-			weak_executor.lock()->yield(call));
+			message);
 	} catch (...) {
+		store_callback_error();
 		return {SCIP_ERROR, SCIP_DIDNOTRUN};
 	}
 }
 
+/**
+ * Answer the call with the handler if it does, or else wait for the result of the executor.
+ *
+ * The handler runs in the solver thread, so that calls the agent is not interested in are declined without switching
+ * threads.
+ */
+template <callback::Type type>
+auto handle_call(
+	SCIP* scip,
+	std::weak_ptr<Executor>& weak_executor,
+	callback::Handler<type> const& handler,
+	callback::Call<type> const& call) noexcept -> std::tuple<SCIP_RETCODE, SCIP_RESULT> {
+	if (handler) {
+		// Exceptions must not go through SCIP C code
+		try {
+			if (auto const handled = handler(scip, call); handled.has_value()) {
+				count_skipped_call();
+				return {SCIP_OKAY, handled.value()};
+			}
+		} catch (...) {
+			store_callback_error();
+			return {SCIP_ERROR, SCIP_DIDNOTRUN};
+		}
+	}
+	return handle_executor(scip, weak_executor, call);
+}
+
 class ReverseBranchrule : public ::scip::ObjBranchrule {
 public:
 	ReverseBranchrule(
@@ -73,15 +192,51 @@ public:
 		int priority,
 		int maxdepth,
 		SCIP_Real maxbounddist,
-		std::weak_ptr<Executor> weak_executor) :
+		std::weak_ptr<Executor> weak_executor,
+		callback::Handler<callback::Type::Branchrule> handler,
+		std::array<bool, 3> yields,
+		Position position) :
 		ObjBranchrule{
 			scip,
-			name(callback::Type::Branchrule),
+			name(callback::Type::Branchrule, position.type_index).c_str(),
 			"Branchrule that wait for another thread to make the branching.",
 			priority,
 			maxdepth,
 			maxbounddist},
-		m_weak_executor{std::move(weak_executor)} {}
+		m_weak_executor{std::move(weak_executor)},
+		m_handler{std::move(handler)},
+		m_yields{yields},
+		m_constructor_index{position.constructor_index} {}
+
+	/** The branchrule already included in the model by a previous iterative solving, if any. */
+	static auto find(SCIP* scip, std::size_t type_index) -> ReverseBranchrule* {
+		auto const branchrule_name = name(callback::Type::Branchrule, type_index);
+		return dynamic_cast<ReverseBranchrule*>(SCIPfindObjBranchrule(scip, branchrule_name.c_str()));
+	}
+
+	/** Give the branchrule to a new iterative solving. */
+	auto rearm(
+		SCIP* scip,
+		std::weak_ptr<Executor> weak_executor,
+		callback::Constructor<callback::Type::Branchrule> args,
+		std::size_t constructor_index) -> void {
+		auto* const branchrule = SCIPfindBranchrule(scip, scip_name_);
+		scip::call(SCIPsetBranchrulePriority, scip, branchrule, args.priority);
+		scip::call(SCIPsetBranchruleMaxdepth, scip, branchrule, args.max_depth);
+		scip::call(SCIPsetBranchruleMaxbounddist, scip, branchrule, args.max_bound_distance);
+		m_weak_executor = std::move(weak_executor);
+		m_handler = std::move(args.handler);
+		m_yields = {args.yield_lp, args.yield_external, args.yield_pseudo};
+		m_constructor_index = constructor_index;
+	}
+
+	/** Leave branching to other rules until the branchrule is given a new iterative solving. */
+	auto disarm(SCIP* scip) -> void {
+		scip::call(SCIPsetBranchrulePriority, scip, SCIPfindBranchrule(scip, scip_name_), callback::priority_min);
+		m_weak_executor.reset();
+		m_handler = nullptr;
+		m_yields = {false, false, false};
+	}
 
 	auto scip_execlp(SCIP* scip, SCIP_BRANCHRULE* /*branchrule*/, SCIP_Bool allow_add_constraints, SCIP_RESULT* result)
 		-> SCIP_RETCODE override {
@@ -103,8 +258,32 @@ public:
 
 private:
 	std::weak_ptr<Executor> m_weak_executor;
+	callback::Handler<callback::Type::Branchrule> m_handler;
+	/** Whether to yield on every Where, indexed by its value. */
+	std::array<bool, 3> m_yields;
+	std::size_t m_constructor_index;
 
 	auto scip_exec_any(SCIP* scip, SCIP_RESULT* result, callback::BranchruleCall call) -> SCIP_RETCODE {
+		call.constructor_index = m_constructor_index;
+		// Calls nobody waits for are skipped without the cost of switching threads
+		if (!m_yields[static_cast<std::size_t>(call.where)]) {
+			count_skipped_call();
+			*result = SCIP_DIDNOTRUN;
+			return SCIP_OKAY;
+		}
+		if (m_handler) {
+			// Exceptions must not go through SCIP C code
+			try {
+				if (auto const handled = m_handler(scip, call); handled.has_value()) {
+					count_skipped_call();
+					*result = handled.value();
+					return SCIP_OKAY;
+				}
+			} catch (...) {
+				store_callback_error();
+				return SCIP_ERROR;
+			}
+		}
 		auto retcode = SCIP_OKAY;
 		std::tie(retcode, *result) = handle_executor(scip, m_weak_executor, call);
 		return retcode;
@@ -115,11 +294,24 @@ template <>
 auto include_reverse_callback<callback::Type::Branchrule>(
 	SCIP* scip,
 	std::weak_ptr<Executor> executor,
-	callback::Constructor<callback::Type::Branchrule> args) -> void {
+	callback::Constructor<callback::Type::Branchrule> args,
+	Position position) -> void {
+	if (auto* const reverse = ReverseBranchrule::find(scip, position.type_index); reverse != nullptr) {
+		reverse->rearm(scip, std::move(executor), std::move(args), position.constructor_index);
+		return;
+	}
 	scip::call(
 		SCIPincludeObjBranchrule,
 		scip,
-		new ReverseBranchrule(scip, args.priority, args.max_depth, args.max_bound_distance, std::move(executor)),
+		new ReverseBranchrule(
+			scip,
+			args.priority,
+			args.max_depth,
+			args.max_bound_distance,
+			std::move(executor),
+			std::move(args.handler),
+			{args.yield_lp, args.yield_external, args.yield_pseudo},
+			position),
 		true);
 }  // NOLINT
 
@@ -132,10 +324,11 @@ public:
 		int freqofs,
 		int maxdepth,
 		SCIP_HEURTIMING timingmask,
-		std::weak_ptr<Executor> weak_executor) :
+		std::weak_ptr<Executor> weak_executor,
+		Position position) :
 		ObjHeur{
 			scip,
-			name(callback::Type::Heuristic),
+			name(callback::Type::Heuristic, position.type_index).c_str(),
 			"Primal heuristic that waits for another thread to provide a primal solution.",
 			'e',
 			priority,
@@ -144,7 +337,35 @@ public:
 			maxdepth,
 			timingmask,
 			false},
-		m_weak_executor{std::move(weak_executor)} {}
+		m_weak_executor{std::move(weak_executor)},
+		m_constructor_index{position.constructor_index} {}
+
+	/** The heuristic already included in the model by a previous iterative solving, if any. */
+	static auto find(SCIP* scip, std::size_t type_index) -> ReverseHeur* {
+		return dynamic_cast<ReverseHeur*>(SCIPfindObjHeur(scip, name(callback::Type::Heuristic, type_index).c_str()));
+	}
+
+	/** Give the heuristic to a new iterative solving. */
+	auto rearm(
+		SCIP* scip,
+		std::weak_ptr<Executor> weak_executor,
+		callback::Constructor<callback::Type::Heuristic> args,
+		std::size_t constructor_index) -> void {
+		auto* const heur = SCIPfindHeur(scip, scip_name_);
+		scip::call(SCIPsetHeurPriority, scip, heur, args.priority);
+		scip::call(SCIPsetHeurFreq, scip, heur, args.frequency);
+		scip::call(SCIPsetIntParam, scip, param_name("freqofs").c_str(), args.frequency_offset);
+		scip::call(SCIPsetIntParam, scip, param_name("maxdepth").c_str(), args.max_depth);
+		SCIPheurSetTimingmask(heur, args.timing_mask);
+		m_weak_executor = std::move(weak_executor);
+		m_constructor_index = constructor_index;
+	}
+
+	/** Disable the heuristic until it is given a new iterative solving. */
+	auto disarm(SCIP* scip) -> void {
+		scip::call(SCIPsetHeurFreq, scip, SCIPfindHeur(scip, scip_name_), -1);
+		m_weak_executor.reset();
+	}
 
 	auto scip_exec(
 		SCIP* scip,
@@ -153,20 +374,31 @@ public:
 		SCIP_Bool node_infeasible,
 		SCIP_RESULT* result) -> SCIP_RETCODE override {
 		auto retcode = SCIP_OKAY;
-		std::tie(retcode, *result) = handle_executor(
-			scip, m_weak_executor, callback::HeuristicCall{heuristic_timing, static_cast<bool>(node_infeasible)});
+		auto const call =
+			callback::HeuristicCall{heuristic_timing, static_cast<bool>(node_infeasible), m_constructor_index};
+		std::tie(retcode, *result) = handle_executor(scip, m_weak_executor, call);
 		return retcode;
 	}
 
 private:
 	std::weak_ptr<Executor> m_weak_executor;
+	std::size_t m_constructor_index;
+
+	[[nodiscard]] auto param_name(char const* param) const -> std::string {
+		return std::string{"heuristics/"} + scip_name_ + "/" + param;
+	}
 };
 
 template <>
 auto include_reverse_callback<callback::Type::Heuristic>(
 	SCIP* scip,
 	std::weak_ptr<Executor> executor,
-	callback::Constructor<callback::Type::Heuristic> args) -> void {
+	callback::Constructor<callback::Type::Heuristic> args,
+	Position position) -> void {
+	if (auto* const reverse = ReverseHeur::find(scip, position.type_index); reverse != nullptr) {
+		reverse->rearm(scip, std::move(executor), std::move(args), position.constructor_index);
+		return;
+	}
 	scip::call(
 		SCIPincludeObjHeur,
 		scip,
@@ -177,10 +409,557 @@ auto include_reverse_callback<callback::Type::Heuristic>(
 			args.frequency_offset,
 			args.max_depth,
 			args.timing_mask,
-			std::move(executor)),
+			std::move(executor),
+			position),
+		true);
+}  // NOLINT
+
+class ReverseNodesel : public ::scip::ObjNodesel {
+public:
+	ReverseNodesel(
+		SCIP* scip,
+		int priority,
+		int memsave_priority,
+		std::weak_ptr<Executor> weak_executor,
+		callback::Handler<callback::Type::Nodesel> handler,
+		Position position) :
+		ObjNodesel{
+			scip,
+			name(callback::Type::Nodesel, position.type_index).c_str(),
+			"Node selector that waits for another thread to select the next node.",
+			priority,
+			memsave_priority},
+		m_weak_executor{std::move(weak_executor)},
+		m_handler{std::move(handler)},
+		m_constructor_index{position.constructor_index} {}
+
+	/** The node selector already included in the model by a previous iterative solving, if any. */
+	static auto find(SCIP* scip, std::size_t type_index) -> ReverseNodesel* {
+		auto const nodesel_name = name(callback::Type::Nodesel, type_index);
+		return dynamic_cast<ReverseNodesel*>(SCIPfindObjNodesel(scip, nodesel_name.c_str()));
+	}
+
+	/** Give the node selector to a new iterative solving. */
+	auto rearm(
+		SCIP* scip,
+		std::weak_ptr<Executor> weak_executor,
+		callback::Constructor<callback::Type::Nodesel> args,
+		std::size_t constructor_index) -> void {
+		auto* const nodesel = SCIPfindNodesel(scip, scip_name_);
+		scip::call(SCIPsetNodeselStdPriority, scip, nodesel, args.priority);
+		scip::call(SCIPsetNodeselMemsavePriority, scip, nodesel, args.memsave_priority);
+		m_weak_executor = std::move(weak_executor);
+		m_handler = std::move(args.handler);
+		m_constructor_index = constructor_index;
+	}
+
+	/** Leave node selection to the other selectors until the selector is given a new iterative solving. */
+	auto disarm(SCIP* scip) -> void {
+		auto* const nodesel = SCIPfindNodesel(scip, scip_name_);
+		scip::call(SCIPsetNodeselStdPriority, scip, nodesel, callback::priority_min);
+		scip::call(SCIPsetNodeselMemsavePriority, scip, nodesel, callback::priority_min);
+		m_weak_executor.reset();
+		m_handler = nullptr;
+	}
+
+	auto scip_select(SCIP* scip, SCIP_NODESEL* /*nodesel*/, SCIP_NODE** selnode) -> SCIP_RETCODE override {
+		*selnode = nullptr;
+		auto const call = callback::NodeselCall{selnode, m_constructor_index};
+		auto retcode = SCIP_OKAY;
+		auto result = SCIP_DIDNOTRUN;
+		auto handled = std::optional<SCIP_RESULT>{};
+		if (m_handler) {
+			// Exceptions must not go through SCIP C code
+			try {
+				handled = m_handler(scip, call);
+			} catch (...) {
+				store_callback_error();
+				return SCIP_ERROR;
+			}
+		}
+		if (handled.has_value()) {
+			count_skipped_call();
+			result = handled.value();
+		} else {
+			std::tie(retcode, result) = handle_executor(scip, m_weak_executor, call);
+		}
+		if (result != SCIP_SUCCESS || *selnode == nullptr) {
+			*selnode = SCIPgetBestboundNode(scip);
+		}
+		return retcode;
+	}
+
+	/** Order nodes by lower bound, then by estimate, as used when the selection is left to the node selector. */
+	auto scip_comp(SCIP* scip, SCIP_NODESEL* /*nodesel*/, SCIP_NODE* node1, SCIP_NODE* node2) -> int override {
+		auto const lower1 = SCIPnodeGetLowerbound(node1);
+		auto const lower2 = SCIPnodeGetLowerbound(node2);
+		if (SCIPisLT(scip, lower1, lower2)) {
+			return -1;
+		}
+		if (SCIPisGT(scip, lower1, lower2)) {
+			return 1;
+		}
+		auto const estimate1 = SCIPnodeGetEstimate(node1);
+		auto const estimate2 = SCIPnodeGetEstimate(node2);
+		if (SCIPisLT(scip, estimate1, estimate2)) {
+			return -1;
+		}
+		if (SCIPisGT(scip, estimate1, estimate2)) {
+			return 1;
+		}
+		return 0;
+	}
+
+private:
+	std::weak_ptr<Executor> m_weak_executor;
+	callback::Handler<callback::Type::Nodesel> m_handler;
+	std::size_t m_constructor_index;
+};
+
+template <>
+auto include_reverse_callback<callback::Type::Nodesel>(
+	SCIP* scip,
+	std::weak_ptr<Executor> executor,
+	callback::Constructor<callback::Type::Nodesel> args,
+	Position position) -> void {
+	if (auto* const reverse = ReverseNodesel::find(scip, position.type_index); reverse != nullptr) {
+		reverse->rearm(scip, std::move(executor), std::move(args), position.constructor_index);
+		return;
+	}
+	scip::call(
+		SCIPincludeObjNodesel,
+		scip,
+		new ReverseNodesel(
+			scip, args.priority, args.memsave_priority, std::move(executor), std::move(args.handler), position),
+		true);
+}  // NOLINT
+
+class ReverseCutsel : public ::scip::ObjCutsel {
+public:
+	ReverseCutsel(
+		SCIP* scip,
+		int priority,
+		std::weak_ptr<Executor> weak_executor,
+		callback::Handler<callback::Type::Cutsel> handler,
+		Position position) :
+		ObjCutsel{
+			scip,
+			name(callback::Type::Cutsel, position.type_index).c_str(),
+			"Cut selector that waits for another thread to select cuts.",
+			priority},
+		m_weak_executor{std::move(weak_executor)},
+		m_handler{std::move(handler)},
+		m_constructor_index{position.constructor_index} {}
+
+	/** The cut selector already included in the model by a previous iterative solving, if any. */
+	static auto find(SCIP* scip, std::size_t type_index) -> ReverseCutsel* {
+		auto const cutsel_name = name(callback::Type::Cutsel, type_index);
+		return dynamic_cast<ReverseCutsel*>(SCIPfindObjCutsel(scip, cutsel_name.c_str()));
+	}
+
+	/** Give the cut selector to a new iterative solving. */
+	auto rearm(
+		SCIP* scip,
+		std::weak_ptr<Executor> weak_executor,
+		callback::Constructor<callback::Type::Cutsel> args,
+		std::size_t constructor_index) -> void {
+		scip::call(SCIPsetCutselPriority, scip, SCIPfindCutsel(scip, scip_name_), args.priority);
+		m_weak_executor = std::move(weak_executor);
+		m_handler = std::move(args.handler);
+		m_constructor_index = constructor_index;
+	}
+
+	/** Leave cut selection to the other selectors until the selector is given a new iterative solving. */
+	auto disarm(SCIP* scip) -> void {
+		scip::call(SCIPsetCutselPriority, scip, SCIPfindCutsel(scip, scip_name_), callback::priority_min);
+		m_weak_executor.reset();
+		m_handler = nullptr;
+	}
+
+	auto scip_select(
+		SCIP* scip,
+		SCIP_CUTSEL* /*cutsel*/,
+		SCIP_ROW** cuts,
+		int ncuts,
+		SCIP_ROW** forcedcuts,
+		int nforcedcuts,
+		SCIP_Bool root,
+		int maxnselectedcuts,
+		int* nselectedcuts,
+		SCIP_RESULT* result) -> SCIP_RETCODE override {
+		*nselectedcuts = 0;
+		auto const call = callback::CutselCall{
+			cuts,
+			ncuts,
+			forcedcuts,
+			nforcedcuts,
+			static_cast<bool>(root),
+			maxnselectedcuts,
+			nselectedcuts,
+			m_constructor_index};
+		if (m_handler) {
+			// Exceptions must not go through SCIP C code
+			try {
+				if (auto const handled = m_handler(scip, call); handled.has_value()) {
+					count_skipped_call();
+					*result = handled.value();
+					return SCIP_OKAY;
+				}
+			} catch (...) {
+				store_callback_error();
+				return SCIP_ERROR;
+			}
+		}
+		auto retcode = SCIP_OKAY;
+		std::tie(retcode, *result) = handle_executor(scip, m_weak_executor, call);
+		// Only a success is a selection, anything else is left to the next cut selector
+		if (*result != SCIP_SUCCESS) {
+			*result = SCIP_DIDNOTFIND;
+		}
+		return retcode;
+	}
+
+private:
+	std::weak_ptr<Executor> m_weak_executor;
+	callback::Handler<callback::Type::Cutsel> m_handler;
+	std::size_t m_constructor_index;
+};
+
+template <>
+auto include_reverse_callback<callback::Type::Cutsel>(
+	SCIP* scip,
+	std::weak_ptr<Executor> executor,
+	callback::Constructor<callback::Type::Cutsel> args,
+	Position position) -> void {
+	if (auto* const reverse = ReverseCutsel::find(scip, position.type_index); reverse != nullptr) {
+		reverse->rearm(scip, std::move(executor), std::move(args), position.constructor_index);
+		return;
+	}
+	scip::call(
+		SCIPincludeObjCutsel,
+		scip,
+		new ReverseCutsel(scip, args.priority, std::move(executor), std::move(args.handler), position),
+		true);
+}  // NOLINT
+
+class ReverseSepa : public ::scip::ObjSepa {
+public:
+	ReverseSepa(
+		SCIP* scip,
+		int priority,
+		int freq,
+		SCIP_Real maxbounddist,
+		std::weak_ptr<Executor> weak_executor,
+		callback::Handler<callback::Type::Separator> handler,
+		Position position) :
+		ObjSepa{
+			scip,
+			name(callback::Type::Separator, position.type_index).c_str(),
+			"Separator that waits for another thread to separate the LP solution.",
+			priority,
+			freq,
+			maxbounddist,
+			false,
+			false},
+		m_weak_executor{std::move(weak_executor)},
+		m_handler{std::move(handler)},
+		m_constructor_index{position.constructor_index} {}
+
+	/** The separator already included in the model by a previous iterative solving, if any. */
+	static auto find(SCIP* scip, std::size_t type_index) -> ReverseSepa* {
+		return dynamic_cast<ReverseSepa*>(SCIPfindObjSepa(scip, name(callback::Type::Separator, type_index).c_str()));
+	}
+
+	/** Give the separator to a new iterative solving. */
+	auto rearm(
+		SCIP* scip,
+		std::weak_ptr<Executor> weak_executor,
+		callback::Constructor<callback::Type::Separator> args,
+		std::size_t constructor_index) -> void {
+		scip::call(SCIPsetSepaPriority, scip, SCIPfindSepa(scip, scip_name_), args.priority);
+		scip::call(SCIPsetIntParam, scip, param_name("freq").c_str(), args.frequency);
+		scip::call(SCIPsetRealParam, scip, param_name("maxbounddist").c_str(), args.max_bound_distance);
+		m_weak_executor = std::move(weak_executor);
+		m_handler = std::move(args.handler);
+		m_constructor_index = constructor_index;
+	}
+
+	/** Disable the separator until it is given a new iterative solving. */
+	auto disarm(SCIP* scip) -> void {
+		scip::call(SCIPsetIntParam, scip, param_name("freq").c_str(), -1);
+		m_weak_executor.reset();
+		m_handler = nullptr;
+	}
+
+	auto scip_execlp(SCIP* scip, SCIP_SEPA* /*sepa*/, SCIP_RESULT* result, SCIP_Bool allowlocal, int depth)
+		-> SCIP_RETCODE override {
+		auto retcode = SCIP_OKAY;
+		auto const call = callback::SeparatorCall{static_cast<bool>(allowlocal), depth, m_constructor_index};
+		std::tie(retcode, *result) = handle_call(scip, m_weak_executor, m_handler, call);
+		return retcode;
+	}
+
+private:
+	std::weak_ptr<Executor> m_weak_executor;
+	callback::Handler<callback::Type::Separator> m_handler;
+	std::size_t m_constructor_index;
+
+	[[nodiscard]] auto param_name(char const* param) const -> std::string {
+		return std::string{"separating/"} + scip_name_ + "/" + param;
+	}
+};
+
+template <>
+auto include_reverse_callback<callback::Type::Separator>(
+	SCIP* scip,
+	std::weak_ptr<Executor> executor,
+	callback::Constructor<callback::Type::Separator> args,
+	Position position) -> void {
+	if (auto* const reverse = ReverseSepa::find(scip, position.type_index); reverse != nullptr) {
+		reverse->rearm(scip, std::move(executor), std::move(args), position.constructor_index);
+		return;
+	}
+	scip::call(
+		SCIPincludeObjSepa,
+		scip,
+		new ReverseSepa(
+			scip,
+			args.priority,
+			args.frequency,
+			args.max_bound_distance,
+			std::move(executor),
+			std::move(args.handler),
+			position),
+		true);
+}  // NOLINT
+
+class ReversePresol : public ::scip::ObjPresol {
+public:
+	ReversePresol(
+		SCIP* scip,
+		int priority,
+		int maxrounds,
+		SCIP_PRESOLTIMING timing,
+		std::weak_ptr<Executor> weak_executor,
+		callback::Handler<callback::Type::Presolver> handler,
+		Position position) :
+		ObjPresol{
+			scip,
+			name(callback::Type::Presolver, position.type_index).c_str(),
+			"Presolver that waits for another thread on every presolving round.",
+			priority,
+			maxrounds,
+			timing},
+		m_weak_executor{std::move(weak_executor)},
+		m_handler{std::move(handler)},
+		m_constructor_index{position.constructor_index} {}
+
+	/** The presolver already included in the model by a previous iterative solving, if any. */
+	static auto find(SCIP* scip, std::size_t type_index) -> ReversePresol* {
+		auto const presol_name = name(callback::Type::Presolver, type_index);
+		return dynamic_cast<ReversePresol*>(SCIPfindObjPresol(scip, presol_name.c_str()));
+	}
+
+	/** Give the presolver to a new iterative solving. */
+	auto rearm(
+		SCIP* scip,
+		std::weak_ptr<Executor> weak_executor,
+		callback::Constructor<callback::Type::Presolver> args,
+		std::size_t constructor_index) -> void {
+		auto* const presol = SCIPfindPresol(scip, scip_name_);
+		scip::call(SCIPsetPresolPriority, scip, presol, args.priority);
+		scip::call(SCIPsetIntParam, scip, param_name("maxrounds").c_str(), args.max_rounds);
+		SCIPpresolSetTiming(presol, args.timing_mask);
+		m_weak_executor = std::move(weak_executor);
+		m_handler = std::move(args.handler);
+		m_constructor_index = constructor_index;
+	}
+
+	/** Disable the presolver until it is given a new iterative solving. */
+	auto disarm(SCIP* scip) -> void {
+		scip::call(SCIPsetIntParam, scip, param_name("maxrounds").c_str(), 0);
+		m_weak_executor.reset();
+		m_handler = nullptr;
+	}
+
+	auto scip_exec(
+		SCIP* scip,
+		SCIP_PRESOL* /*presol*/,
+		int nrounds,
+		SCIP_PRESOLTIMING presoltiming,
+		int /*nnewfixedvars*/,
+		int /*nnewaggrvars*/,
+		int /*nnewchgvartypes*/,
+		int /*nnewchgbds*/,
+		int /*nnewholes*/,
+		int /*nnewdelconss*/,
+		int /*nnewaddconss*/,
+		int /*nnewupgdconss*/,
+		int /*nnewchgcoefs*/,
+		int /*nnewchgsides*/,
+		int* /*nfixedvars*/,
+		int* /*naggrvars*/,
+		int* /*nchgvartypes*/,
+		int* /*nchgbds*/,
+		int* /*naddholes*/,
+		int* /*ndelconss*/,
+		int* /*naddconss*/,
+		int* /*nupgdconss*/,
+		int* /*nchgcoefs*/,
+		int* /*nchgsides*/,
+		SCIP_RESULT* result) -> SCIP_RETCODE override {
+		auto retcode = SCIP_OKAY;
+		auto const call = callback::PresolverCall{nrounds, presoltiming, m_constructor_index};
+		std::tie(retcode, *result) = handle_call(scip, m_weak_executor, m_handler, call);
+		// The problem is not changed by the agent, so the round cannot be reported as successful
+		if (*result != SCIP_DELAYED && *result != SCIP_DIDNOTRUN) {
+			*result = SCIP_DIDNOTFIND;
+		}
+		return retcode;
+	}
+
+private:
+	std::weak_ptr<Executor> m_weak_executor;
+	callback::Handler<callback::Type::Presolver> m_handler;
+	std::size_t m_constructor_index;
+
+	[[nodiscard]] auto param_name(char const* param) const -> std::string {
+		return std::string{"presolving/"} + scip_name_ + "/" + param;
+	}
+};
+
+template <>
+auto include_reverse_callback<callback::Type::Presolver>(
+	SCIP* scip,
+	std::weak_ptr<Executor> executor,
+	callback::Constructor<callback::Type::Presolver> args,
+	Position position) -> void {
+	if (auto* const reverse = ReversePresol::find(scip, position.type_index); reverse != nullptr) {
+		reverse->rearm(scip, std::move(executor), std::move(args), position.constructor_index);
+		return;
+	}
+	scip::call(
+		SCIPincludeObjPresol,
+		scip,
+		new ReversePresol(
+			scip,
+			args.priority,
+			args.max_rounds,
+			args.timing_mask,
+			std::move(executor),
+			std::move(args.handler),
+			position),
 		true);
 }  // NOLINT
 
+class ReverseEventhdlr : public ::scip::ObjEventhdlr {
+public:
+	ReverseEventhdlr(
+		SCIP* scip,
+		SCIP_EVENTTYPE event_mask,
+		std::weak_ptr<Executor> weak_executor,
+		callback::Handler<callback::Type::EventHandler> handler,
+		Position position) :
+		ObjEventhdlr{
+			scip,
+			name(callback::Type::EventHandler, position.type_index).c_str(),
+			"Event handler that waits for another thread on every event caught."},
+		m_event_mask{event_mask},
+		m_weak_executor{std::move(weak_executor)},
+		m_handler{std::move(handler)},
+		m_constructor_index{position.constructor_index} {}
+
+	/** The event handler already included in the model by a previous iterative solving, if any. */
+	static auto find(SCIP* scip, std::size_t type_index) -> ReverseEventhdlr* {
+		auto const eventhdlr_name = name(callback::Type::EventHandler, type_index);
+		return dynamic_cast<ReverseEventhdlr*>(SCIPfindObjEventhdlr(scip, eventhdlr_name.c_str()));
+	}
+
+	/** Give the event handler to a new iterative solving, which catches events from its solving stage on. */
+	auto rearm(
+		SCIP* /*scip*/,
+		std::weak_ptr<Executor> weak_executor,
+		callback::Constructor<callback::Type::EventHandler> args,
+		std::size_t constructor_index) -> void {
+		m_event_mask = args.event_mask;
+		m_weak_executor = std::move(weak_executor);
+		m_handler = std::move(args.handler);
+		m_constructor_index = constructor_index;
+	}
+
+	/** Catch no event until the handler is given a new iterative solving. */
+	auto disarm(SCIP* /*scip*/) -> void {
+		m_event_mask = SCIP_EVENTTYPE_DISABLED;
+		m_weak_executor.reset();
+		m_handler = nullptr;
+	}
+
+	auto scip_initsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE override {
+		m_caught_mask = m_event_mask;
+		if (m_caught_mask == SCIP_EVENTTYPE_DISABLED) {
+			return SCIP_OKAY;
+		}
+		return SCIPcatchEvent(scip, m_caught_mask, eventhdlr, nullptr, nullptr);
+	}
+
+	auto scip_exitsol(SCIP* scip, SCIP_EVENTHDLR* eventhdlr) -> SCIP_RETCODE override {
+		if (m_caught_mask == SCIP_EVENTTYPE_DISABLED) {
+			return SCIP_OKAY;
+		}
+		return SCIPdropEvent(scip, std::exchange(m_caught_mask, SCIP_EVENTTYPE_DISABLED), eventhdlr, nullptr, -1);
+	}
+
+	auto scip_exec(SCIP* scip, SCIP_EVENTHDLR* /*eventhdlr*/, SCIP_EVENT* event, SCIP_EVENTDATA* /*eventdata*/)
+		-> SCIP_RETCODE override {
+		auto const call = callback::EventHandlerCall{SCIPeventGetType(event), event, m_constructor_index};
+		return std::get<0>(handle_call(scip, m_weak_executor, m_handler, call));
+	}
+
+private:
+	SCIP_EVENTTYPE m_event_mask;
+	/** The events caught in the current solving, which may differ from those of the next one. */
+	SCIP_EVENTTYPE m_caught_mask = SCIP_EVENTTYPE_DISABLED;
+	std::weak_ptr<Executor> m_weak_executor;
+	callback::Handler<callback::Type::EventHandler> m_handler;
+	std::size_t m_constructor_index;
+};
+
+template <>
+auto include_reverse_callback<callback::Type::EventHandler>(
+	SCIP* scip,
+	std::weak_ptr<Executor> executor,
+	callback::Constructor<callback::Type::EventHandler> args,
+	Position position) -> void {
+	if (auto* const reverse = ReverseEventhdlr::find(scip, position.type_index); reverse != nullptr) {
+		reverse->rearm(scip, std::move(executor), std::move(args), position.constructor_index);
+		return;
+	}
+	scip::call(
+		SCIPincludeObjEventhdlr,
+		scip,
+		new ReverseEventhdlr(scip, args.event_mask, std::move(executor), std::move(args.handler), position),
+		true);
+}  // NOLINT
+
+/** Call the function on every reverse callback of the given class included in the model, from the given index on. */
+template <typename Reverse, typename Func> void for_each_reverse(SCIP* scip, std::size_t first, Func&& func) {
+	for (auto type_index = first; auto* const reverse = Reverse::find(scip, type_index); ++type_index) {
+		func(*reverse);
+	}
+}
+
+/** Leave the reverse callbacks of the given class from the given index on to other plugins. */
+template <typename Reverse> void disarm_reverse(SCIP* scip, std::size_t first = 0) {
+	for_each_reverse<Reverse>(scip, first, [scip](Reverse& reverse) { reverse.disarm(scip); });
+}
+
+/** The number of reverse callbacks of the given class included in the model. */
+template <typename Reverse> auto count_reverse(SCIP* scip) -> int {
+	auto count = 0;
+	for_each_reverse<Reverse>(scip, 0, [&count](Reverse& /*reverse*/) { ++count; });
+	return count;
+}
+
 }  // namespace
 
 /****************************
@@ -201,13 +980,28 @@ std::unique_ptr<SCIP, ScipDeleter> create_scip() {
 	return scip_ptr;
 }
 
+auto memory_gauge() -> utility::metrics::Gauge& {
+	static auto& gauge = utility::metrics::gauge("ecole_scip_memory_bytes", "Block memory used by all SCIP models.");
+	return gauge;
+}
+
 }  // namespace
 
-Scimpl::Scimpl() : m_scip{create_scip()} {}
+Scimpl::Scimpl() :
+	m_scip{create_scip()},
+	m_copy_mutex{std::make_unique<std::mutex>()},
+	m_coroutine_backend{utility::default_coroutine_backend},
+	m_coroutine_affinity{utility::default_affinity_policy},
+	m_memory{memory_gauge()} {}
 
 Scimpl::Scimpl(Scimpl&&) noexcept = default;
 
-Scimpl::Scimpl(std::unique_ptr<SCIP, ScipDeleter>&& scip_ptr) noexcept : m_scip(std::move(scip_ptr)) {}
+Scimpl::Scimpl(std::unique_ptr<SCIP, ScipDeleter>&& scip_ptr) noexcept :
+	m_scip(std::move(scip_ptr)),
+	m_copy_mutex{std::make_unique<std::mutex>()},
+	m_coroutine_backend{utility::default_coroutine_backend},
+	m_coroutine_affinity{utility::default_affinity_policy},
+	m_memory{memory_gauge()} {}
 
 Scimpl::~Scimpl() = default;
 
@@ -223,10 +1017,8 @@ auto Scimpl::copy() const -> Scimpl {
 		return {create_scip()};
 	}
 	auto dest = create_scip();
-	// Copy operation is not thread safe
-	static auto m = std::mutex{};
-	auto g = std::lock_guard{m};
-	scip::call(SCIPcopy, m_scip.get(), dest.get(), nullptr, nullptr, "", true, false, false, false, nullptr);
+	auto const lk = lock_for_copy();
+	scip::call(SCIPcopy, m_scip.get(), dest.get(), nullptr, nullptr, "", true, false, true, false, nullptr);
 	return {std::move(dest)};
 }
 
@@ -238,28 +1030,301 @@ auto Scimpl::copy_orig() const -> Scimpl {
 		return {create_scip()};
 	}
 	auto dest = create_scip();
-	// Copy operation is not thread safe
-	static auto m = std::mutex{};
-	auto g = std::lock_guard{m};
-	scip::call(SCIPcopyOrig, m_scip.get(), dest.get(), nullptr, nullptr, "", false, false, false, nullptr);
+	auto const lk = lock_for_copy();
+	scip::call(SCIPcopyOrig, m_scip.get(), dest.get(), nullptr, nullptr, "", false, true, false, nullptr);
 	return {std::move(dest)};
 }
 
+auto Scimpl::fork() const -> Scimpl {
+	if (m_scip == nullptr) {
+		return {nullptr};
+	}
+	if (SCIPgetStage(m_scip.get()) < SCIP_STAGE_TRANSFORMED) {
+		return copy_orig();
+	}
+	auto dest = create_scip();
+	auto const lk = lock_for_copy();
+	// Copying with local bounds turns the subtree of the current node into the new problem
+	scip::call(SCIPcopy, m_scip.get(), dest.get(), nullptr, nullptr, "", false, false, true, false, nullptr);
+	return {std::move(dest)};
+}
+
+namespace {
+
+struct HashmapDeleter {
+	void operator()(SCIP_HASHMAP* ptr) { SCIPhashmapFree(&ptr); }
+};
+
+auto create_hashmap(SCIP* scip, int size) -> std::unique_ptr<SCIP_HASHMAP, HashmapDeleter> {
+	SCIP_HASHMAP* map = nullptr;
+	scip::call(SCIPhashmapCreate, &map, SCIPblkmem(scip), size);
+	return std::unique_ptr<SCIP_HASHMAP, HashmapDeleter>{map};
+}
+
+/**
+ * Whether the target has the handlers of all constraints of the source problem, transformed once transformed.
+ *
+ * Handlers must also be able to copy their constraints, which is what copying can check before copying anything.
+ */
+auto has_conshdlrs(SCIP* source, SCIP* target) -> bool {
+	auto const transformed = SCIPgetStage(source) >= SCIP_STAGE_TRANSFORMED;
+	auto const n_conss = transformed ? SCIPgetNConss(source) : SCIPgetNOrigConss(source);
+	auto* const* const conss = transformed ? SCIPgetConss(source) : SCIPgetOrigConss(source);
+	for (int i = 0; i < n_conss; ++i) {
+		auto* const conshdlr = SCIPfindConshdlr(target, SCIPconshdlrGetName(SCIPconsGetHdlr(conss[i])));
+		if (conshdlr == nullptr || SCIPconshdlrIsClonable(conshdlr) == FALSE) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/** Copy the problem of the source, transformed once transformed, as the original problem of the target. */
+auto copy_problem_into(SCIP* source, SCIP* target) -> bool {
+	auto const transformed = SCIPgetStage(source) >= SCIP_STAGE_TRANSFORMED;
+	auto const n_conss = transformed ? SCIPgetNConss(source) : SCIPgetNOrigConss(source);
+	SCIP_Bool valid = TRUE;
+	auto const varmap = create_hashmap(target, SCIPgetNVars(source));
+	auto const consmap = create_hashmap(target, n_conss);
+	auto const* const name = SCIPgetProbName(source);
+	if (transformed) {
+		scip::call(SCIPcopyProb, source, target, varmap.get(), consmap.get(), true, name);
+		scip::call(SCIPcopyVars, source, target, varmap.get(), consmap.get(), nullptr, nullptr, 0, true);
+		scip::call(SCIPcopyConss, source, target, varmap.get(), consmap.get(), true, false, &valid);
+	} else {
+		scip::call(SCIPcopyOrigProb, source, target, varmap.get(), consmap.get(), name);
+		scip::call(SCIPcopyOrigVars, source, target, varmap.get(), consmap.get(), nullptr, nullptr, 0);
+		scip::call(SCIPcopyOrigConss, source, target, varmap.get(), consmap.get(), false, &valid);
+	}
+	return valid != FALSE;
+}
+
+}  // namespace
+
+auto Scimpl::copy_problem(PluginProfile profile) const -> std::optional<Scimpl> {
+	if (m_scip == nullptr) {
+		return Scimpl{nullptr};
+	}
+	auto dest = Scimpl{create_scip()};
+	include_plugins(dest.get_scip_ptr(), profile);
+	dest.set_plugin_profile(profile);
+	auto* const source = m_scip.get();
+	if (SCIPgetStage(source) == SCIP_STAGE_INIT) {
+		return {std::move(dest)};
+	}
+
+	// Constraints of missing handlers would fail to be copied, so they are detected before copying anything
+	if (!has_conshdlrs(source, dest.get_scip_ptr())) {
+		return {};
+	}
+	auto const lk = lock_for_copy();
+	if (!copy_problem_into(source, dest.get_scip_ptr())) {
+		return {};
+	}
+	return {std::move(dest)};
+}
+
+auto Scimpl::load_problem(Scimpl const& source) -> bool {
+	auto* const source_scip = source.m_scip.get();
+	if (source_scip == nullptr || source_scip == m_scip.get() || SCIPgetStage(source_scip) == SCIP_STAGE_INIT) {
+		return false;
+	}
+	auto* const target = m_scip.get();
+	// Checked before freeing the problem, so that the model is left untouched when the copy cannot be made
+	if (!has_conshdlrs(source_scip, target)) {
+		return false;
+	}
+	scip::call(SCIPfreeProb, target);
+	m_lp_view.reset();
+	auto const lk = source.lock_for_copy();
+	if (!copy_problem_into(source_scip, target)) {
+		// A handler refused to copy one of its constraints, the partial problem must not be solved
+		scip::call(SCIPfreeProb, target);
+		throw ScipError{"Could not copy all the constraints of the problem."};
+	}
+	return true;
+}
+
+namespace {
+
+/** Number of plugins of every kind, not counting the reverse callbacks that recycled models keep. */
+auto count_plugins(SCIP* scip) -> std::vector<int> {
+	return {
+		SCIPgetNReaders(scip),
+		SCIPgetNPricers(scip),
+		SCIPgetNConshdlrs(scip),
+		SCIPgetNConflicthdlrs(scip),
+		SCIPgetNPresols(scip) - count_reverse<ReversePresol>(scip),
+		SCIPgetNRelaxs(scip),
+		SCIPgetNSepas(scip) - count_reverse<ReverseSepa>(scip),
+		SCIPgetNCutsels(scip) - count_reverse<ReverseCutsel>(scip),
+		SCIPgetNProps(scip),
+		SCIPgetNHeurs(scip) - count_reverse<ReverseHeur>(scip),
+		SCIPgetNEventhdlrs(scip) - count_reverse<ReverseEventhdlr>(scip),
+		SCIPgetNNodesels(scip) - count_reverse<ReverseNodesel>(scip),
+		SCIPgetNBranchrules(scip) - count_reverse<ReverseBranchrule>(scip),
+		SCIPgetNDisps(scip),
+		SCIPgetNTables(scip),
+	};
+}
+
+}  // namespace
+
+void Scimpl::set_plugin_profile(PluginProfile profile) {
+	m_plugin_profile = profile;
+	m_plugin_counts = count_plugins(get_scip_ptr());
+}
+
+auto Scimpl::recycle(PluginProfile profile) -> bool {
+	auto* const scip = get_scip_ptr();
+	// Plugins included since the creation, such as event handlers of data functions, may hold state of the episode
+	// (if not pointers to objects that are gone), and cannot be removed from SCIP
+	if (scip == nullptr || m_plugin_profile != profile || count_plugins(scip) != m_plugin_counts) {
+		return false;
+	}
+	// Stops the solver thread of an unfinished iterative solving
+	m_controller = nullptr;
+	m_deadline_missed = false;
+	scip::call(SCIPfreeProb, scip);
+	scip::call(SCIPresetParams, scip);
+	disarm_reverse<ReverseBranchrule>(scip);
+	disarm_reverse<ReverseHeur>(scip);
+	disarm_reverse<ReverseNodesel>(scip);
+	disarm_reverse<ReverseCutsel>(scip);
+	disarm_reverse<ReverseSepa>(scip);
+	disarm_reverse<ReversePresol>(scip);
+	disarm_reverse<ReverseEventhdlr>(scip);
+	m_solver_counters = nullptr;
+	m_statistics = {};
+	m_lp_view = nullptr;
+	return true;
+}
+
+auto Scimpl::lock_for_copy() const -> std::unique_lock<std::mutex> {
+	// Every SCIP has its own settings, statistics, and memory, and default plugins hold no global state, so copies of
+	// different models need not be synchronized.
+	// Copying however reads the source problem and updates the source statistics, so copies of the same model are
+	// serialized.
+	// The destination is created before locking, and copies are made thread safe (sharing no data with the source)
+	// so that they can be solved in other threads.
+	static auto& n_copies = utility::metrics::counter("ecole_model_copies_total", "Copies of SCIP models.");
+	static auto& lock_wait = utility::metrics::histogram(
+		"ecole_model_copy_mutex_wait_seconds", "Time spent waiting for other copies of the same model.");
+	n_copies.add();
+	auto const timer = utility::metrics::ScopedTimer{lock_wait};
+	return std::unique_lock{*m_copy_mutex};
+}
+
 auto Scimpl::solve_iter(nonstd::span<callback::DynamicConstructor const> arg_packs)
 	-> std::optional<callback::DynamicCall> {
+	ECOLE_TRACE_SPAN("Scimpl::solve_iter");
 	auto* const scip_ptr = get_scip_ptr();
-	m_controller = std::make_unique<Controller>([=](std::weak_ptr<Executor> const& executor) {
-		for (auto const pack : arg_packs) {
-			std::visit([&](auto args) { include_reverse_callback(scip_ptr, executor, args); }, pack);
-		}
-		scip::call(SCIPsolve, scip_ptr);
-	});
-	return m_controller->wait();
+	m_statistics = {};
+	m_deadline_missed = false;
+	// Nodes and LPs are numbered again by the new solve, so the view cannot be told apart from a new one
+	m_lp_view = nullptr;
+	m_solver_counters = std::make_shared<SolverCounters>();
+	m_controller = std::make_unique<Controller>(
+		m_coroutine_backend,
+		m_coroutine_affinity,
+		[=, counters = m_solver_counters](std::weak_ptr<Executor> const& executor) {
+			// Callbacks of the same type are told apart by their position, and reused across solvings.
+			// Positions are counted per index in DynamicConstructor, which follows the order of callback::Type.
+			auto n_of_type = std::array<std::size_t, std::variant_size_v<callback::DynamicConstructor>>{};
+			for (std::size_t i = 0; i < arg_packs.size(); ++i) {
+				auto& type_index = n_of_type[arg_packs[i].index()];
+				std::visit(
+					[&](auto args) { include_reverse_callback(scip_ptr, executor, args, {type_index, i}); },
+					arg_packs[i]);
+				++type_index;
+			}
+			// Those of a previous solving with more callbacks are left to other plugins
+			disarm_reverse<ReverseBranchrule>(scip_ptr, n_of_type[0]);
+			disarm_reverse<ReverseHeur>(scip_ptr, n_of_type[1]);
+			disarm_reverse<ReverseNodesel>(scip_ptr, n_of_type[2]);
+			disarm_reverse<ReverseCutsel>(scip_ptr, n_of_type[3]);
+			disarm_reverse<ReverseSepa>(scip_ptr, n_of_type[4]);
+			disarm_reverse<ReversePresol>(scip_ptr, n_of_type[5]);
+			disarm_reverse<ReverseEventhdlr>(scip_ptr, n_of_type[6]);
+			ECOLE_TRACE_SPAN("SCIPsolve");
+			auto const guard = CountersGuard{counters.get()};
+			try {
+				scip::call(SCIPsolve, scip_ptr);
+			} catch (ScipError const&) {
+				if (counters->callback_error != nullptr) {
+					std::rethrow_exception(counters->callback_error);
+				}
+				throw;
+			}
+		});
+	return wait_for_solver();
 }
 
 auto Scimpl::solve_iter_continue(SCIP_RESULT result) -> std::optional<callback::DynamicCall> {
+	ECOLE_TRACE_SPAN("Scimpl::solve_iter_continue");
+	m_statistics.caller_time += std::chrono::steady_clock::now() - m_statistics.last_yield_time;
+	// The solver already continued with the fallback result
+	if (std::exchange(m_deadline_missed, false)) {
+		return wait_for_solver();
+	}
 	m_controller->resume(result);
-	return m_controller->wait();
+	return wait_for_solver();
+}
+
+void Scimpl::solve_iter_set_deadline(std::chrono::nanoseconds timeout, SCIP_RESULT fallback) {
+	m_controller->set_deadline(timeout, fallback);
+}
+
+auto Scimpl::solve_iter_reclaim() -> bool {
+	if (m_controller == nullptr || m_deadline_missed) {
+		return !m_deadline_missed;
+	}
+	if (!m_controller->reclaim()) {
+		m_deadline_missed = true;
+		++m_statistics.n_missed_deadlines;
+	}
+	return !m_deadline_missed;
+}
+
+auto Scimpl::callback_statistics() const noexcept -> callback::Statistics {
+	auto statistics = m_statistics;
+	if (m_solver_counters != nullptr) {
+		statistics.n_skipped_calls = m_solver_counters->n_skipped_calls.load(std::memory_order_relaxed);
+		statistics.solving_time =
+			std::chrono::nanoseconds{m_solver_counters->solving_time_ns.load(std::memory_order_relaxed)};
+	}
+	return statistics;
+}
+
+auto Scimpl::wait_for_solver() -> std::optional<callback::DynamicCall> {
+	static auto& wait_time = utility::metrics::histogram(
+		"ecole_coroutine_wait_seconds", "Time spent waiting for the solver to yield or finish.");
+	auto const before = std::chrono::steady_clock::now();
+	auto fcall = m_controller->wait();
+	m_statistics.last_yield_time = std::chrono::steady_clock::now();
+	m_statistics.waiting_time += m_statistics.last_yield_time - before;
+	wait_time.observe(m_statistics.last_yield_time - before);
+	m_memory.set(SCIPgetMemUsed(get_scip_ptr()));
+	if (fcall.has_value()) {
+		++m_statistics.n_yields;
+	}
+	return fcall;
+}
+
+auto Scimpl::coroutine_backend() const noexcept -> utility::CoroutineBackend {
+	return m_coroutine_backend;
+}
+
+void Scimpl::set_coroutine_backend(utility::CoroutineBackend backend) noexcept {
+	m_coroutine_backend = backend;
+}
+
+auto Scimpl::coroutine_affinity() const noexcept -> utility::AffinityPolicy {
+	return m_coroutine_affinity;
+}
+
+void Scimpl::set_coroutine_affinity(utility::AffinityPolicy affinity) noexcept {
+	m_coroutine_affinity = affinity;
 }
 
 }  // namespace ecole::scip
@@ -0,0 +1,62 @@
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+
+#include "ecole/threads.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole {
+namespace {
+
+/** The number of threads set by the user, zero for one per core. */
+std::atomic<std::size_t> user_n_threads = 0;
+
+std::mutex shared_pool_mutex;
+std::shared_ptr<utility::ThreadPool> shared_pool;  // Guarded by shared_pool_mutex
+
+}  // namespace
+
+auto set_n_threads(std::size_t n_threads) -> void {
+	auto old_pool = std::shared_ptr<utility::ThreadPool>{};
+	{
+		auto const lk = std::lock_guard{shared_pool_mutex};
+		user_n_threads = n_threads;
+		old_pool = std::move(shared_pool);
+	}
+	// Features still holding the old pool keep it alive, otherwise its workers are joined here, outside of the lock
+}
+
+auto get_n_threads() noexcept -> std::size_t {
+	if (auto const n_threads = user_n_threads.load(); n_threads > 0) {
+		return n_threads;
+	}
+	auto const n_threads = std::thread::hardware_concurrency();
+	return n_threads > 0 ? n_threads : 1;
+}
+
+auto shared_thread_pool() -> std::shared_ptr<utility::ThreadPool> {
+	auto const lk = std::lock_guard{shared_pool_mutex};
+	auto const n_threads = get_n_threads();
+	if (n_threads <= 1) {
+		return {};
+	}
+	if (shared_pool == nullptr) {
+		shared_pool = std::make_shared<utility::ThreadPool>(n_threads);
+	}
+	return shared_pool;
+}
+
+auto make_thread_pool(std::size_t n_threads) -> std::shared_ptr<utility::ThreadPool> {
+	if (n_threads == 0) {
+		return shared_thread_pool();
+	}
+	if (n_threads == 1) {
+		return {};
+	}
+	return std::make_shared<utility::ThreadPool>(n_threads);
+}
+
+}  // namespace ecole
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <exception>
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "ecole/utility/affinity.hpp"
+
+namespace ecole::utility {
+
+namespace {
+
+#ifdef __linux__
+
+/** Read a topology file of a CPU, returning an empty string if it does not exist. */
+auto read_topology(unsigned int cpu, char const* name) -> std::string {
+	auto file = std::ifstream{"/sys/devices/system/cpu/cpu" + std::to_string(cpu) + "/topology/" + name};
+	auto content = std::string{};
+	std::getline(file, content);
+	return content;
+}
+
+/** Parse a CPU list in the kernel format, such as ``0-3,8,10-11``. */
+auto parse_cpu_list(std::string const& list) -> CpuSet {
+	auto cpus = CpuSet{};
+	auto stream = std::istringstream{list};
+	auto range = std::string{};
+	while (std::getline(stream, range, ',')) {
+		auto const dash = range.find('-');
+		try {
+			auto const first = std::stoul(range.substr(0, dash));
+			auto const last = (dash == std::string::npos) ? first : std::stoul(range.substr(dash + 1));
+			for (auto cpu = first; cpu <= last; ++cpu) {
+				cpus.push_back(static_cast<unsigned int>(cpu));
+			}
+		} catch (std::exception const&) {
+			return {};
+		}
+	}
+	std::sort(cpus.begin(), cpus.end());
+	return cpus;
+}
+
+#endif
+
+}  // namespace
+
+auto thread_affinity() -> CpuSet {
+	auto cpus = CpuSet{};
+#ifdef __linux__
+	auto mask = cpu_set_t{};
+	CPU_ZERO(&mask);
+	// On Linux, the process id zero designates the calling thread
+	if (sched_getaffinity(0, sizeof(mask), &mask) == 0) {
+		for (unsigned int cpu = 0; cpu < CPU_SETSIZE; ++cpu) {
+			if (CPU_ISSET(cpu, &mask)) {
+				cpus.push_back(cpu);
+			}
+		}
+	}
+#endif
+	return cpus;
+}
+
+auto set_thread_affinity([[maybe_unused]] CpuSet const& cpus) -> bool {
+#ifdef __linux__
+	auto mask = cpu_set_t{};
+	CPU_ZERO(&mask);
+	for (auto const cpu : cpus) {
+		if (cpu < CPU_SETSIZE) {
+			CPU_SET(cpu, &mask);
+		}
+	}
+	return (CPU_COUNT(&mask) > 0) && (sched_setaffinity(0, sizeof(mask), &mask) == 0);
+#else
+	return false;
+#endif
+}
+
+auto physical_cores() -> std::vector<CpuSet> {
+	auto const allowed = thread_affinity();
+	// Cores keyed by socket and first sibling
+	auto cores = std::map<std::pair<long, unsigned int>, CpuSet>{};
+	for (auto const cpu : allowed) {
+		auto socket = long{0};
+		auto siblings = CpuSet{};
+#ifdef __linux__
+		try {
+			socket = std::stol(read_topology(cpu, "physical_package_id"));
+		} catch (std::exception const&) {
+			socket = 0;
+		}
+		siblings = parse_cpu_list(read_topology(cpu, "thread_siblings_list"));
+#endif
+		// Siblings not allowed to the thread are left out of the core
+		auto const first_allowed = std::find_if(siblings.begin(), siblings.end(), [&allowed](auto sibling) {
+			return std::binary_search(allowed.begin(), allowed.end(), sibling);
+		});
+		auto const leader = (first_allowed != siblings.end()) ? *first_allowed : cpu;
+		cores[{socket, leader}].push_back(cpu);
+	}
+	auto result = std::vector<CpuSet>{};
+	result.reserve(cores.size());
+	for (auto& [key, core] : cores) {
+		result.push_back(std::move(core));
+	}
+	return result;
+}
+
+ScopedAffinity::ScopedAffinity(CpuSet const& cpus) {
+	if (cpus.empty()) {
+		return;
+	}
+	previous = thread_affinity();
+	if (previous != cpus) {
+		changed = set_thread_affinity(cpus);
+	}
+}
+
+ScopedAffinity::~ScopedAffinity() {
+	if (changed) {
+		set_thread_affinity(previous);
+	}
+}
+
+}  // namespace ecole::utility
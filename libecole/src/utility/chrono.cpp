@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <cerrno>
 #include <ctime>
 #include <system_error>
@@ -25,4 +26,62 @@ auto cpu_clock::now() -> time_point {
 	return time_point{std::chrono::seconds{spec.tv_sec} + std::chrono::nanoseconds{spec.tv_nsec}};
 }
 
+auto coarse_steady_clock::now() -> time_point {
+#if defined(CLOCK_MONOTONIC_COARSE)
+	struct timespec spec;
+	if (clock_gettime(CLOCK_MONOTONIC_COARSE, &spec) != 0) {
+		throw std::system_error{{errno, std::generic_category()}};
+	}
+	return time_point{std::chrono::seconds{spec.tv_sec} + std::chrono::nanoseconds{spec.tv_nsec}};
+#else
+	return time_point{std::chrono::duration_cast<duration>(std::chrono::steady_clock::now().time_since_epoch())};
+#endif
+}
+
+auto thread_cpu_clock::now() -> time_point {
+	// Also available on MacOS >= 10.12
+	struct timespec spec;
+	if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &spec) != 0) {
+		throw std::system_error{{errno, std::generic_category()}};
+	}
+	return time_point{std::chrono::seconds{spec.tv_sec} + std::chrono::nanoseconds{spec.tv_nsec}};
+}
+
+ThreadsCpuTimer::ThreadsCpuTimer(ThreadsCpuTimer const& other) {
+	auto const lk = std::lock_guard{other.mutex};
+	last_reads = other.last_reads;
+	total = other.total;
+}
+
+auto ThreadsCpuTimer::operator=(ThreadsCpuTimer const& other) -> ThreadsCpuTimer& {
+	if (this != &other) {
+		auto const lk = std::scoped_lock{mutex, other.mutex};
+		last_reads = other.last_reads;
+		total = other.total;
+	}
+	return *this;
+}
+
+void ThreadsCpuTimer::reset() {
+	auto const lk = std::lock_guard{mutex};
+	last_reads.clear();
+	total = std::chrono::nanoseconds{0};
+}
+
+auto ThreadsCpuTimer::elapsed() -> std::chrono::nanoseconds {
+	auto const now = thread_cpu_clock::now();
+	auto const id = std::this_thread::get_id();
+	auto const lk = std::lock_guard{mutex};
+	// Only a couple of threads read a timer, so a linear search is enough
+	auto const is_caller = [id](auto const& read) { return read.first == id; };
+	auto const iter = std::find_if(last_reads.begin(), last_reads.end(), is_caller);
+	if (iter == last_reads.end()) {
+		last_reads.emplace_back(id, now);
+	} else {
+		total += now - iter->second;
+		iter->second = now;
+	}
+	return total;
+}
+
 }  // namespace ecole::utility
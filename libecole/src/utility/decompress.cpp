@@ -0,0 +1,155 @@
+#include <cstddef>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+
+#include <fmt/format.h>
+
+#ifdef ECOLE_HAS_ZLIB
+#include <zlib.h>
+#endif
+#ifdef ECOLE_HAS_ZSTD
+#include <zstd.h>
+#endif
+
+#include "utility/decompress.hpp"
+
+namespace ecole::utility {
+
+namespace {
+
+constexpr std::size_t chunk_size = std::size_t{1} << 20U;
+
+/** Preallocate the output assuming a typical compression ratio of text problem files. */
+void reserve_for(std::string& out, std::filesystem::path const& filename) {
+	auto error = std::error_code{};
+	if (auto const size = std::filesystem::file_size(filename, error); !error) {
+		out.reserve(4 * size);
+	}
+}
+
+#ifdef ECOLE_HAS_ZLIB
+auto read_gzip(std::filesystem::path const& filename) -> std::string {
+	auto const file = std::unique_ptr<gzFile_s, decltype(&gzclose)>{gzopen(filename.c_str(), "rb"), &gzclose};
+	if (file == nullptr) {
+		throw std::runtime_error{fmt::format("Could not open file {}.", filename.string())};
+	}
+	gzbuffer(file.get(), static_cast<unsigned>(chunk_size));
+	auto out = std::string{};
+	reserve_for(out, filename);
+	while (true) {
+		auto const begin = out.size();
+		out.resize(begin + chunk_size);
+		auto const n_read = gzread(file.get(), out.data() + begin, static_cast<unsigned>(chunk_size));
+		if (n_read < 0) {
+			auto errnum = 0;
+			throw std::runtime_error{fmt::format("{}: {}", filename.string(), gzerror(file.get(), &errnum))};
+		}
+		out.resize(begin + static_cast<std::size_t>(n_read));
+		if (static_cast<std::size_t>(n_read) < chunk_size) {
+			return out;
+		}
+	}
+}
+#endif
+
+#ifdef ECOLE_HAS_ZSTD
+auto read_zstd(std::filesystem::path const& filename) -> std::string {
+	auto file = std::ifstream{filename, std::ios::binary};
+	if (!file) {
+		throw std::runtime_error{fmt::format("Could not open file {}.", filename.string())};
+	}
+	auto const stream =
+		std::unique_ptr<ZSTD_DStream, decltype(&ZSTD_freeDStream)>{ZSTD_createDStream(), &ZSTD_freeDStream};
+	auto in_buffer = std::string(ZSTD_DStreamInSize(), '\0');
+	auto out = std::string{};
+	reserve_for(out, filename);
+	auto last_result = std::size_t{0};
+	while (file) {
+		file.read(in_buffer.data(), static_cast<std::streamsize>(in_buffer.size()));
+		auto input = ZSTD_inBuffer{in_buffer.data(), static_cast<std::size_t>(file.gcount()), 0};
+		// A full output buffer can leave decompressed data to flush even once the input is consumed
+		auto output_full = true;
+		while (input.pos < input.size || output_full) {
+			auto const begin = out.size();
+			out.resize(begin + chunk_size);
+			auto output = ZSTD_outBuffer{out.data() + begin, chunk_size, 0};
+			last_result = ZSTD_decompressStream(stream.get(), &output, &input);
+			if (ZSTD_isError(last_result) != 0) {
+				throw std::runtime_error{fmt::format("{}: {}", filename.string(), ZSTD_getErrorName(last_result))};
+			}
+			out.resize(begin + output.pos);
+			output_full = output.pos == output.size;
+		}
+	}
+	// A non zero hint means that the last frame is not complete
+	if (last_result != 0) {
+		throw std::runtime_error{fmt::format("{}: truncated zstd file.", filename.string())};
+	}
+	return out;
+}
+#endif
+
+}  // namespace
+
+auto compression_of(std::filesystem::path const& filename) -> Compression {
+	auto const extension = filename.extension();
+	if (extension == ".gz") {
+		return Compression::gzip;
+	}
+	if (extension == ".zst") {
+		return Compression::zstd;
+	}
+	return Compression::none;
+}
+
+auto can_decompress(Compression compression) noexcept -> bool {
+	switch (compression) {
+	case Compression::none:
+		return true;
+	case Compression::gzip:
+#ifdef ECOLE_HAS_ZLIB
+		return true;
+#else
+		return false;
+#endif
+	case Compression::zstd:
+#ifdef ECOLE_HAS_ZSTD
+		return true;
+#else
+		return false;
+#endif
+	}
+	return false;
+}
+
+auto read_decompressed(std::filesystem::path const& filename, Compression compression) -> std::string {
+	switch (compression) {
+	case Compression::none: {
+		auto file = std::ifstream{filename, std::ios::binary};
+		if (!file) {
+			throw std::runtime_error{fmt::format("Could not open file {}.", filename.string())};
+		}
+		return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+	}
+	case Compression::gzip:
+#ifdef ECOLE_HAS_ZLIB
+		return read_gzip(filename);
+#else
+		break;
+#endif
+	case Compression::zstd:
+#ifdef ECOLE_HAS_ZSTD
+		return read_zstd(filename);
+#else
+		break;
+#endif
+	}
+	throw std::runtime_error{fmt::format("Ecole was built without support to decompress {}.", filename.string())};
+}
+
+}  // namespace ecole::utility
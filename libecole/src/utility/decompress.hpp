@@ -0,0 +1,26 @@
+#pragma once
+
+#include <filesystem>
+#include <string>
+
+namespace ecole::utility {
+
+/** The compression of a file, deduced from its extension. */
+enum struct Compression { none, gzip, zstd };
+
+auto compression_of(std::filesystem::path const& filename) -> Compression;
+
+/** Whether Ecole was built with the library to decompress the given format. */
+auto can_decompress(Compression compression) noexcept -> bool;
+
+/**
+ * Read and decompress a whole file into memory.
+ *
+ * Data is decompressed in large chunks, which is much faster than the line by line reading of SCIP readers, and
+ * files made of multiple compressed frames or members (as written by ``pigz`` or ``zstd -T``) are supported.
+ *
+ * @throw std::runtime_error If the file cannot be read, is not valid, or the format is not supported in this build.
+ */
+auto read_decompressed(std::filesystem::path const& filename, Compression compression) -> std::string;
+
+}  // namespace ecole::utility
@@ -1,21 +1,18 @@
 #include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstddef>
 #include <functional>
-#include <iterator>
+#include <numeric>
 #include <random>
-#include <set>
 #include <stdexcept>
+#include <utility>
 #include <vector>
 
-#include <range/v3/range/conversion.hpp>
-#include <range/v3/view/iota.hpp>
-#include <range/v3/view/transform.hpp>
-
 #include "ecole/utility/random.hpp"
 
 #include "utility/graph.hpp"
 
-namespace views = ranges::views;
-
 namespace ecole::utility {
 
 auto Graph::Edge::operator==(Edge const& other) const noexcept -> bool {
@@ -26,167 +23,295 @@ auto Graph::Edge::operator!=(Edge const& other) const noexcept -> bool {
 	return !(*this == other);
 }
 
+Graph::Graph(std::size_t n_nodes) : offsets(n_nodes + 1, 0) {}
+
+Graph::Graph(std::vector<std::size_t> offsets_, std::vector<Node> adjacency_) noexcept :
+	offsets{std::move(offsets_)}, adjacency{std::move(adjacency_)} {}
+
 auto Graph::n_nodes() const noexcept -> std::size_t {
-	return edges.size();
+	return offsets.size() - 1;
 }
 
 auto Graph::degree(Node n) const noexcept -> std::size_t {
-	return edges[n].size();
+	return offsets[n + 1] - offsets[n];
 }
 
-auto Graph::neighbors(Node n) const noexcept -> robin_hood::unordered_flat_set<Node> const& {
-	return edges[n];
+auto Graph::neighbors(Node n) const noexcept -> nonstd::span<Node const> {
+	return {adjacency.data() + offsets[n], degree(n)};
 }
 
-auto Graph::are_connected(Node popular, Node unpopular) const -> bool {
-	return neighbors(unpopular).contains(popular);
+auto Graph::are_connected(Node n1, Node n2) const noexcept -> bool {
+	if (degree(n1) < degree(n2)) {
+		std::swap(n1, n2);
+	}
+	auto const neighbors_ = neighbors(n2);
+	return std::binary_search(neighbors_.begin(), neighbors_.end(), n1);
 }
 
 auto Graph::n_edges() const noexcept -> std::size_t {
-	auto count = std::size_t{0};
-	for (auto const& neighbors : edges) {
-		count += neighbors.size();
-	}
 	// Each edge is stored twice
-	assert(count % 2 == 0);
-	return count / 2;
+	assert(adjacency.size() % 2 == 0);
+	return adjacency.size() / 2;
+}
+
+GraphBuilder::GraphBuilder(std::size_t n_nodes) : degrees(n_nodes, 0) {}
+
+void GraphBuilder::reserve(std::size_t n_edges) {
+	edges.reserve(n_edges);
 }
 
-void Graph::add_edge(Edge edge) {
-	assert(!are_connected(edge.first, edge.second));
-	edges[edge.first].insert(edge.second);
-	edges[edge.second].insert(edge.first);
+void GraphBuilder::add_edge(Edge edge) {
+	assert(edge.first < n_nodes() && edge.second < n_nodes());
+	edges.push_back(edge);
+	degrees[edge.first]++;
+	degrees[edge.second]++;
 }
 
-void Graph::reserve(std::size_t degree) {
-	for (auto& neighborhood : edges) {
-		neighborhood.reserve(degree);
+auto GraphBuilder::build() const -> Graph {
+	auto offsets = std::vector<std::size_t>(n_nodes() + 1, 0);
+	std::partial_sum(degrees.begin(), degrees.end(), offsets.begin() + 1);
+
+	// Scatter both ends of every edge in the adjacency list of the other end
+	auto adjacency = std::vector<Node>(2 * edges.size());
+	auto positions = std::vector<std::size_t>(offsets.begin(), offsets.end() - 1);
+	for (auto [n1, n2] : edges) {
+		adjacency[positions[n1]++] = n2;
+		adjacency[positions[n2]++] = n1;
+	}
+	for (Node n = 0; n < n_nodes(); ++n) {
+		auto const begin = adjacency.begin() + static_cast<std::ptrdiff_t>(offsets[n]);
+		auto const end = adjacency.begin() + static_cast<std::ptrdiff_t>(offsets[n + 1]);
+		std::sort(begin, end);
+		assert(std::adjacent_find(begin, end) == end);
 	}
+
+	return {std::move(offsets), std::move(adjacency)};
 }
 
-auto Graph::erdos_renyi(std::size_t n_nodes, double edge_probability, RandomGenerator& rng) -> Graph {
-	// Allocate adjacency lists for the expected approximate number of neighbors in an Erdos Renyi graph.
-	// Computed as the expectation of a Binomial.
-	auto graph = Graph{n_nodes};
-	auto const expected_neighbors = static_cast<std::size_t>(std::ceil(static_cast<double>(n_nodes) * edge_probability));
-	graph.reserve(expected_neighbors);
+namespace {
 
-	// Flip a (continuous) coin for each edge in the undirected graph
+/** Flip a (continuous) coin for each edge in the undirected graph. */
+void add_erdos_renyi_edges_pairwise(GraphBuilder& builder, double edge_probability, RandomGenerator& rng) {
+	auto const n_nodes = builder.n_nodes();
 	auto rand = std::uniform_real_distribution<double>{0.0, 1.0};
-	for (Node n1 = 0; n1 < n_nodes; ++n1) {
-		for (Node n2 = n1 + 1; n2 < n_nodes; ++n2) {
+	for (Graph::Node n1 = 0; n1 < n_nodes; ++n1) {
+		for (Graph::Node n2 = n1 + 1; n2 < n_nodes; ++n2) {
 			if (rand(rng) < edge_probability) {
-				graph.add_edge({n1, n2});
+				builder.add_edge({n1, n2});
+			}
+		}
+	}
+}
+
+/**
+ * Skip over the pairs of nodes without edges.
+ *
+ * Pairs (n1, n2) with n2 < n1 are enumerated in lexicographic order, and the number of pairs skipped before the next
+ * edge follows a geometric distribution.
+ * Algorithm from Batagelj and Brandes, "Efficient generation of large random networks", 2005.
+ */
+void add_erdos_renyi_edges_skipping(GraphBuilder& builder, double edge_probability, RandomGenerator& rng) {
+	auto const n_nodes = builder.n_nodes();
+	if (edge_probability <= 0.) {
+		return;
+	}
+	if (edge_probability >= 1.) {
+		for (Graph::Node n1 = 0; n1 < n_nodes; ++n1) {
+			for (Graph::Node n2 = n1 + 1; n2 < n_nodes; ++n2) {
+				builder.add_edge({n1, n2});
 			}
 		}
+		return;
 	}
 
-	return graph;
+	auto const log_miss = std::log1p(-edge_probability);
+	auto rand = std::uniform_real_distribution<double>{0.0, 1.0};
+	auto n1 = Graph::Node{1};
+	auto n2 = Graph::Node{0};
+	auto skip = std::floor(std::log1p(-rand(rng)) / log_miss);
+	while (n1 < n_nodes) {
+		// Walk the skipped pairs row by row, working in doubles since the skip can be huge for small probabilities
+		while (n1 < n_nodes && skip >= static_cast<double>(n1 - n2)) {
+			skip -= static_cast<double>(n1 - n2);
+			++n1;
+			n2 = 0;
+		}
+		if (n1 < n_nodes) {
+			n2 += static_cast<Graph::Node>(skip);
+			builder.add_edge({n1, n2});
+			++n2;
+			skip = std::floor(std::log1p(-rand(rng)) / log_miss);
+		}
+	}
 }
 
-auto Graph::barabasi_albert(std::size_t n_nodes, std::size_t affinity, RandomGenerator& rng) -> Graph {
-	if (affinity < 1 || affinity >= n_nodes) {
-		throw std::invalid_argument{"Affinity must be between 1 and the number of nodes."};
+}  // namespace
+
+auto Graph::erdos_renyi(std::size_t n_nodes, double edge_probability, RandomGenerator& rng, bool geometric_skip)
+	-> Graph {
+	// Allocate for the expected number of edges in an Erdos Renyi graph, computed as the expectation of a Binomial.
+	auto builder = GraphBuilder{n_nodes};
+	auto const n_pairs = static_cast<double>(n_nodes) * static_cast<double>(n_nodes > 0 ? n_nodes - 1 : 0) / 2.;
+	builder.reserve(static_cast<std::size_t>(std::ceil(n_pairs * std::clamp(edge_probability, 0., 1.))));
+
+	if (geometric_skip) {
+		add_erdos_renyi_edges_skipping(builder, edge_probability, rng);
+	} else {
+		add_erdos_renyi_edges_pairwise(builder, edge_probability, rng);
 	}
+	return builder.build();
+}
+
+namespace {
 
-	// Allocate adjacency lists for the expected approximate number of neighbors in an Barabasi Albert graph.
-	// Computed as the expectation of a power law.
-	// https://web.archive.org/web/20200615213344/https://barabasi.com/f/622.pdf
-	auto graph = Graph{n_nodes};
-	graph.reserve(2 * affinity);
+/** Grow the graph with weights recomputed for every new node, in quadratic time. */
+auto barabasi_albert_weighted(std::size_t n_nodes, std::size_t affinity, RandomGenerator& rng) -> Graph {
+	using Node = Graph::Node;
+
+	// The number of edges is deterministic.
+	auto builder = GraphBuilder{n_nodes};
+	builder.reserve((n_nodes - affinity) * affinity);
 
 	// First nodes are all connected to the first one (star shape).
 	for (Node n = 1; n <= affinity; ++n) {
-		graph.add_edge({0, n});
+		builder.add_edge({0, n});
 	}
 
-	// Function to get Degrees from 0 to k_nodes (exluded) as vector of doubles.
-	auto get_degrees = [&graph](auto k_nodes) {
-		auto get_degree = [&graph](auto m) { return static_cast<double>(graph.degree(m)); };
-		return views::ints(Node{0}, k_nodes) | views::transform(get_degree) | ranges::to<std::vector>();
-	};
+	// Degrees of the nodes as doubles, maintained alongside the builder for sampling.
+	auto degrees = std::vector<double>(n_nodes, 0.);
+	for (Node n = 0; n <= affinity; ++n) {
+		degrees[n] = static_cast<double>(builder.degree(n));
+	}
 
 	// Other node grow the graph one by one
 	for (Node n = affinity + 1; n < n_nodes; ++n) {
 		// They are linked to `affinity` existing node with probability proportional to degree
-		for (auto neighbor : utility::arg_choice(affinity, get_degrees(n), rng)) {
-			graph.add_edge({n, neighbor});
+		auto weights = std::vector<double>(degrees.begin(), degrees.begin() + static_cast<std::ptrdiff_t>(n));
+		for (auto neighbor : utility::arg_choice(affinity, std::move(weights), rng)) {
+			builder.add_edge({n, neighbor});
+			degrees[neighbor] += 1.;
 		}
+		degrees[n] = static_cast<double>(affinity);
 	}
 
-	return graph;
+	return builder.build();
 }
 
-template <typename K, typename V> using map = robin_hood::unordered_flat_map<K, V>;
-template <typename T> using set = robin_hood::unordered_flat_set<T>;
+}  // namespace
 
-/** Create a set of mapping of nodes to their degrees. */
-auto create_nodes_degrees(Graph const& g) -> map<Graph::Node, std::size_t> {
-	auto nodes = map<Graph::Node, std::size_t>{};
-	nodes.reserve(g.n_nodes());
-	for (auto n = Graph::Node{0}; n < Graph::Node{g.n_nodes()}; ++n) {
-		nodes[n] = g.degree(n);
+auto Graph::barabasi_albert(std::size_t n_nodes, std::size_t affinity, RandomGenerator& rng, bool repeated_nodes)
+	-> Graph {
+	if (affinity < 1 || affinity >= n_nodes) {
+		throw std::invalid_argument{"Affinity must be between 1 and the number of nodes."};
+	}
+	if (!repeated_nodes) {
+		return barabasi_albert_weighted(n_nodes, affinity, rng);
 	}
-	return nodes;
-}
 
-/** Find, remove, and return the node with maximum degree. */
-auto extract_node_with_max_degree(map<Graph::Node, std::size_t>& nodes_degrees) -> Graph::Node {
-	assert(!nodes_degrees.empty());
-	auto cmp_degrees = [](auto const& nd_1, auto const& nd_2) { return nd_1.second < nd_2.second; };
-	auto const max_iter = std::max_element(nodes_degrees.begin(), nodes_degrees.end(), cmp_degrees);
-	auto node = max_iter->first;
-	nodes_degrees.erase(max_iter);
-	return node;
-}
+	// The ends of all edges, two by two, so that every node appears as many times as its degree.
+	// The number of edges is deterministic.
+	auto const n_edges = (n_nodes - affinity) * affinity;
+	auto ends = std::vector<Node>{};
+	ends.reserve(2 * n_edges);
 
-/** Compute intersection between neighborhood and leftovers nodes and sort them by decreasing degree. */
-auto best_clique_candidates(set<Graph::Node> const& neighborhood, map<Graph::Node, std::size_t> const& leftover_nodes)
-	-> std::vector<Graph::Node> {
-	auto candidates = std::vector<Graph::Node>{};
-	candidates.reserve(std::min(neighborhood.size(), leftover_nodes.size()));
-	auto in_leftover_nodes = [&leftover_nodes](auto node) { return leftover_nodes.contains(node); };
-	std::copy_if(neighborhood.begin(), neighborhood.end(), std::back_inserter(candidates), in_leftover_nodes);
-	// Decreasing sort by degree using > comparison.
-	auto cmp_degrees = [&leftover_nodes](auto node1, auto node2) {
-		// NOLINTNEXTLINE(bugprone-lambda-function-name)  __func__ is used in assert macro.
-		assert(leftover_nodes.contains(node1) && leftover_nodes.contains(node2));
-		return leftover_nodes.find(node1)->second > leftover_nodes.find(node2)->second;
-	};
-	std::sort(candidates.begin(), candidates.end(), cmp_degrees);
-	return candidates;
-}
+	// First nodes are all connected to the first one (star shape).
+	for (Node n = 1; n <= affinity; ++n) {
+		ends.push_back(0);
+		ends.push_back(n);
+	}
 
-/** Return a vector of Node with the center and an allocated size. */
-auto allocate_clique(Graph::Node center, std::size_t n_center_neighors) {
-	auto clique = std::vector<Graph::Node>{};
-	clique.reserve(n_center_neighors + 1);
-	clique.push_back(center);
-	return clique;
+	// Other node grow the graph one by one, linked to `affinity` existing nodes with probability proportional to
+	// degree. Drawing ends uniformly and rejecting nodes already chosen samples them without replacement.
+	auto targets = std::vector<Node>{};
+	targets.reserve(affinity);
+	for (Node n = affinity + 1; n < n_nodes; ++n) {
+		auto choice = std::uniform_int_distribution<std::size_t>{0, ends.size() - 1};
+		targets.clear();
+		while (targets.size() < affinity) {
+			auto const target = ends[choice(rng)];
+			if (std::find(targets.begin(), targets.end(), target) == targets.end()) {
+				targets.push_back(target);
+			}
+		}
+		for (auto const target : targets) {
+			ends.push_back(n);
+			ends.push_back(target);
+		}
+	}
+
+	// Write the edges in the adjacency lists in the order they were added.
+	// The neighbors of a node are then the nodes it was linked to upon its addition, followed by the nodes added later
+	// and linked to it, in increasing order, so only the first ones need sorting.
+	auto degrees = std::vector<std::size_t>(n_nodes, 0);
+	for (auto const node : ends) {
+		++degrees[node];
+	}
+	auto offsets = std::vector<std::size_t>(n_nodes + 1, 0);
+	std::partial_sum(degrees.begin(), degrees.end(), offsets.begin() + 1);
+	auto adjacency = std::vector<Node>(ends.size());
+	auto positions = std::vector<std::size_t>(offsets.begin(), offsets.end() - 1);
+	for (std::size_t e = 0; e < ends.size(); e += 2) {
+		adjacency[positions[ends[e]]++] = ends[e + 1];
+		adjacency[positions[ends[e + 1]]++] = ends[e];
+	}
+	for (Node n = 0; n < n_nodes; ++n) {
+		auto const begin = adjacency.begin() + static_cast<std::ptrdiff_t>(offsets[n]);
+		auto const end = adjacency.begin() + static_cast<std::ptrdiff_t>(offsets[n + 1]);
+		std::sort(begin, begin + static_cast<std::ptrdiff_t>(std::min(affinity, degrees[n])));
+		assert(std::adjacent_find(begin, end, std::greater_equal<>{}) == end);
+	}
+
+	return {std::move(offsets), std::move(adjacency)};
 }
 
 auto Graph::greedy_clique_partition() const -> std::vector<std::vector<Node>> {
 	auto clique_partition = std::vector<std::vector<Node>>{};
 	clique_partition.reserve(n_nodes());
 
-	auto leftover_nodes = create_nodes_degrees(*this);
-
-	// Process all nodes to put them in a new clique
-	while (!leftover_nodes.empty()) {
-		// Start clique from the node with most neighbors
-		auto const clique_center = extract_node_with_max_degree(leftover_nodes);
-		auto const clique_candidates = best_clique_candidates(neighbors(clique_center), leftover_nodes);
-		auto clique = allocate_clique(clique_center, clique_candidates.size());
-
-		// Candidate clique members are among the neighbors
-		for (auto node : clique_candidates) {
-			// If clique candidate preserve cliqueness, i.e. connected to every node in clique
-			if (std::all_of(
-						clique.begin(), clique.end(), [&](auto clique_node) { return are_connected(node, clique_node); })) {
-				clique.push_back(node);
-				[[maybe_unused]] auto const n_removed = leftover_nodes.erase(node);
-				assert(n_removed == 1);
+	// Nodes by decreasing degree, which is the order in which they become clique centers
+	auto order = std::vector<Node>(n_nodes());
+	std::iota(order.begin(), order.end(), Node{0});
+	std::stable_sort(order.begin(), order.end(), [this](auto n1, auto n2) { return degree(n1) > degree(n2); });
+	auto rank = std::vector<std::size_t>(n_nodes());
+	for (std::size_t r = 0; r < order.size(); ++r) {
+		rank[order[r]] = r;
+	}
+
+	auto leftover = std::vector<bool>(n_nodes(), true);
+	// Neighbors of the last clique member are marked with a different stamp every time, so marks are never cleared
+	auto marks = std::vector<std::size_t>(n_nodes(), 0);
+	auto stamp = std::size_t{0};
+	auto candidates = std::vector<Node>{};
+	for (auto const center : order) {
+		if (!leftover[center]) {
+			continue;
+		}
+		leftover[center] = false;
+
+		// Candidate clique members are among the leftover neighbors, by decreasing degree
+		candidates.clear();
+		for (auto const node : neighbors(center)) {
+			if (leftover[node]) {
+				candidates.push_back(node);
+			}
+		}
+		std::sort(candidates.begin(), candidates.end(), [&rank](auto n1, auto n2) { return rank[n1] < rank[n2]; });
+
+		auto clique = std::vector<Node>{center};
+		// Candidates are kept connected to every clique member, so the first one always preserves cliqueness.
+		// This adds the same nodes as testing every candidate against every member, with a single pass over the
+		// neighbors of every member instead of binary searches.
+		auto first = candidates.begin();
+		auto last = candidates.end();
+		while (first != last) {
+			auto const node = *first;
+			clique.push_back(node);
+			leftover[node] = false;
+			++stamp;
+			for (auto const neighbor : neighbors(node)) {
+				marks[neighbor] = stamp;
 			}
+			last = std::remove_if(++first, last, [&marks, stamp](auto other) { return marks[other] != stamp; });
 		}
 
 		clique_partition.push_back(std::move(clique));
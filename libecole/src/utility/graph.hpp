@@ -1,17 +1,25 @@
 #pragma once
 
+#include <algorithm>
 #include <cstddef>
 #include <utility>
 #include <vector>
 
-#include <robin_hood.h>
+#include <nonstd/span.hpp>
 
 #include "ecole/export.hpp"
 #include "ecole/random.hpp"
 
 namespace ecole::utility {
 
-/** A simple symetric graph based on adjacency lists.  */
+class GraphBuilder;
+
+/**
+ * A simple symetric graph stored as compressed sparse adjacency lists.
+ *
+ * The graph cannot be modified and is created with a GraphBuilder.
+ * The neighbors of every node are stored contiguously and sorted.
+ */
 class ECOLE_EXPORT Graph {
 public:
 	using Node = std::size_t;
@@ -30,27 +38,40 @@ public:
 	 * @param n_nodes The number of nodes in the graph generated.
 	 * @param edge_probability The probability that a given edge is added to the graph.
 	 * @param rng The random number generator used to sample edges.
+	 * @param geometric_skip Whether to sample the number of pairs skipped between two edges from a geometric
+	 *  distribution, in time linear in the number of nodes and edges (Batagelj and Brandes, 2005).
+	 *  Otherwise, a coin is flipped for every pair of nodes, as in previous versions.
+	 *  Both give the same distribution of graphs, but not the same graph for a given random generator.
 	 */
-	ECOLE_EXPORT static auto erdos_renyi(std::size_t n_nodes, double edge_probability, RandomGenerator& rng) -> Graph;
+	ECOLE_EXPORT static auto erdos_renyi(
+		std::size_t n_nodes,
+		double edge_probability,
+		RandomGenerator& rng,
+		bool geometric_skip = true) -> Graph;
 
 	/** Sample a new graph using Barabasi Albert algorithm.
 	 *
 	 * @param n_nodes The number of nodes in the graph generated.
 	 * @param affinity The number of nodes that each node is connected to.
 	 * @param rng The random number generator used to sample edges.
+	 * @param repeated_nodes Whether to sample the neighbors of every new node among the ends of the edges added so
+	 *  far, in which every node is repeated as many times as its degree, in time linear in the number of edges.
+	 *  Otherwise, all previous nodes are weighted by their degree for every new node, as in previous versions.
+	 *  Both give the same distribution of graphs, but not the same graph for a given random generator.
 	 */
-	ECOLE_EXPORT static auto barabasi_albert(std::size_t n_nodes, std::size_t affinity, RandomGenerator& rng) -> Graph;
+	ECOLE_EXPORT static auto
+	barabasi_albert(std::size_t n_nodes, std::size_t affinity, RandomGenerator& rng, bool repeated_nodes = true)
+		-> Graph;
 
 	/** Empty graph with only nodes */
-	Graph(std::size_t n_nodes) : edges{n_nodes} {}
-
-	/** Reserve size for each adjacency list. */
-	ECOLE_EXPORT void reserve(std::size_t degree);
+	ECOLE_EXPORT Graph(std::size_t n_nodes);
 
 	[[nodiscard]] ECOLE_EXPORT auto n_nodes() const noexcept -> std::size_t;
 	[[nodiscard]] ECOLE_EXPORT auto degree(Node n) const noexcept -> std::size_t;
-	[[nodiscard]] ECOLE_EXPORT auto neighbors(Node n) const noexcept -> robin_hood::unordered_flat_set<Node> const&;
-	[[nodiscard]] ECOLE_EXPORT auto are_connected(Node popular, Node unpopular) const -> bool;
+	/** The sorted neighbors of a node. */
+	[[nodiscard]] ECOLE_EXPORT auto neighbors(Node n) const noexcept -> nonstd::span<Node const>;
+	/** Binary search in the smallest of the two adjacency lists. */
+	[[nodiscard]] ECOLE_EXPORT auto are_connected(Node n1, Node n2) const noexcept -> bool;
 	[[nodiscard]] ECOLE_EXPORT auto n_edges() const noexcept -> std::size_t;
 
 	/** Apply a function on all edges in the graph.
@@ -59,19 +80,50 @@ public:
 	 */
 	template <typename Func> void edges_visit(Func&& func) const;
 
-	ECOLE_EXPORT void add_edge(Edge edge);
-
 	/** Partition the nodes in clique using greedy algorithm.
+	 *
+	 * Cliques are grown from the nodes of highest degree, ties being broken by the smallest node.
 	 *
 	 * @return Vector of cliques, each being a vector of nodes.
 	 */
 	[[nodiscard]] ECOLE_EXPORT auto greedy_clique_partition() const -> std::vector<std::vector<Node>>;
 
 private:
-	// Vector likely more performant than list on small-sized small-count data due to more predictable cache usage
-	using AdjacencyLists = std::vector<robin_hood::unordered_flat_set<Node>>;
+	friend class GraphBuilder;
 
-	AdjacencyLists edges;
+	/** The position of the neighbors of every node in adjacency, followed by the size of adjacency. */
+	std::vector<std::size_t> offsets;
+	/** The neighbors of all nodes, each edge being stored twice. */
+	std::vector<Node> adjacency;
+
+	Graph(std::vector<std::size_t> offsets, std::vector<Node> adjacency) noexcept;
+};
+
+/** Collect the edges of a graph before creating it in a single pass. */
+class ECOLE_EXPORT GraphBuilder {
+public:
+	using Node = Graph::Node;
+	using Edge = Graph::Edge;
+
+	/** Start with nodes but no edges. */
+	ECOLE_EXPORT GraphBuilder(std::size_t n_nodes);
+
+	/** Reserve memory for the given number of edges. */
+	ECOLE_EXPORT void reserve(std::size_t n_edges);
+
+	[[nodiscard]] auto n_nodes() const noexcept -> std::size_t { return degrees.size(); }
+	/** The degree of a node given the edges added so far. */
+	[[nodiscard]] auto degree(Node n) const noexcept -> std::size_t { return degrees[n]; }
+
+	/** Add an edge, which must not have been added before. */
+	ECOLE_EXPORT void add_edge(Edge edge);
+
+	/** Create the graph with the edges added. */
+	[[nodiscard]] ECOLE_EXPORT auto build() const -> Graph;
+
+private:
+	std::vector<Edge> edges;
+	std::vector<std::size_t> degrees;
 };
 
 /*****************************
@@ -81,10 +133,10 @@ private:
 template <typename Func> void Graph::edges_visit(Func&& func) const {
 	auto const n_nodes_ = n_nodes();
 	for (auto n1 = Node{0}; n1 < n_nodes_; ++n1) {
-		for (auto n2 : neighbors(n1)) {
-			if (n1 <= n2) {  // Undirected graph
-				func(Edge{n1, n2});
-			}
+		auto const neighbors_ = neighbors(n1);
+		// Undirected graph, and neighbors are sorted
+		for (auto iter = std::lower_bound(neighbors_.begin(), neighbors_.end(), n1); iter != neighbors_.end(); ++iter) {
+			func(Edge{n1, *iter});
 		}
 	}
 }
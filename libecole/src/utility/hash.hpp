@@ -0,0 +1,102 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string_view>
+
+#include <nonstd/span.hpp>
+
+namespace ecole::utility {
+
+/**
+ * Streaming 64 bits hash of words.
+ *
+ * Words are mixed into four independent lanes in turn, so that long arrays are hashed without dependency between
+ * consecutive words and the loop over them can be vectorized.
+ * The result only depends on the sequence of words, not on how they are split between calls.
+ * This is a fast non cryptographic hash, meant for cache keys.
+ */
+class Hasher {
+public:
+	void add(std::uint64_t word) noexcept {
+		auto& lane = lanes[n_words % n_lanes];
+		lane = rotate((lane ^ word) * prime, 31);
+		++n_words;
+	}
+
+	void add(double value) noexcept {
+		// Both zeros are the same value
+		value = value == 0. ? 0. : value;
+		auto word = std::uint64_t{0};
+		std::memcpy(&word, &value, sizeof(word));
+		add(word);
+	}
+
+	void add(int value) noexcept { add(static_cast<std::uint64_t>(static_cast<std::int64_t>(value))); }
+
+	void add(nonstd::span<double const> values) noexcept {
+		auto i = std::size_t{0};
+		// Align on the first lane to process whole groups of words with fixed lanes
+		for (; i < values.size() && n_words % n_lanes != 0; ++i) {
+			add(values[i]);
+		}
+		for (; i + n_lanes <= values.size(); i += n_lanes) {
+			for (std::size_t l = 0; l < n_lanes; ++l) {
+				auto value = values[i + l] == 0. ? 0. : values[i + l];
+				auto word = std::uint64_t{0};
+				std::memcpy(&word, &value, sizeof(word));
+				lanes[l] = rotate((lanes[l] ^ word) * prime, 31);
+			}
+			n_words += n_lanes;
+		}
+		for (; i < values.size(); ++i) {
+			add(values[i]);
+		}
+	}
+
+	void add(std::string_view str) noexcept {
+		add(static_cast<std::uint64_t>(str.size()));
+		for (std::size_t i = 0; i < str.size(); i += sizeof(std::uint64_t)) {
+			auto word = std::uint64_t{0};
+			std::memcpy(&word, str.data() + i, std::min(sizeof(word), str.size() - i));
+			add(word);
+		}
+	}
+
+	/** The hash of all words added so far. */
+	[[nodiscard]] auto digest() const noexcept -> std::uint64_t {
+		auto hash = n_words;
+		for (auto const lane : lanes) {
+			hash = mix(hash ^ lane);
+		}
+		return hash;
+	}
+
+private:
+	static constexpr std::size_t n_lanes = 4;
+	static constexpr std::uint64_t prime = 0x9e3779b97f4a7c15ULL;
+
+	static constexpr auto rotate(std::uint64_t x, unsigned int r) noexcept -> std::uint64_t {
+		return (x << r) | (x >> (64U - r));
+	}
+
+	/** Finalizer of SplitMix64, so that every input bit affects every output bit. */
+	static constexpr auto mix(std::uint64_t x) noexcept -> std::uint64_t {
+		x = (x ^ (x >> 30U)) * 0xbf58476d1ce4e5b9ULL;
+		x = (x ^ (x >> 27U)) * 0x94d049bb133111ebULL;
+		return x ^ (x >> 31U);
+	}
+
+	std::array<std::uint64_t, n_lanes> lanes = {
+		0x243f6a8885a308d3ULL,
+		0x13198a2e03707344ULL,
+		0xa4093822299f31d0ULL,
+		0x082efa98ec4e6c89ULL,
+	};
+	std::uint64_t n_words = 0;
+};
+
+}  // namespace ecole::utility
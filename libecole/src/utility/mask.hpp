@@ -0,0 +1,40 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <nonstd/span.hpp>
+#include <scip/scip.h>
+
+namespace ecole::utility {
+
+/**
+ * Fill the buffer with the mask of the given variables among the first ``n_vars`` of their problem.
+ *
+ * The mask holds a byte per variable, set to one for the given ones and indexed by their problem index.
+ * When packed, it rather holds a bit per variable, in the little bit order of ``numpy.unpackbits``: the one of
+ * variable ``i`` is bit ``i % 8`` of byte ``i / 8``.
+ * The buffer only allocates when it grows larger than ever before.
+ */
+inline auto fill_variable_mask(
+	nonstd::span<SCIP_VAR*> vars,
+	std::size_t n_vars,
+	bool packed,
+	std::vector<std::uint8_t>& buffer) -> nonstd::span<std::uint8_t const> {
+	constexpr auto bits = std::size_t{8};
+	buffer.resize(packed ? (n_vars + bits - 1) / bits : n_vars);
+	std::fill(buffer.begin(), buffer.end(), std::uint8_t{0});
+	for (auto* const var : vars) {
+		auto const idx = static_cast<std::size_t>(SCIPvarGetProbindex(var));
+		if (packed) {
+			buffer[idx / bits] |= static_cast<std::uint8_t>(1U << (idx % bits));
+		} else {
+			buffer[idx] = 1;
+		}
+	}
+	return {buffer.data(), buffer.size()};
+}
+
+}  // namespace ecole::utility
@@ -2,6 +2,9 @@
 
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <iterator>
+#include <limits>
 #include <type_traits>
 #include <utility>
 
@@ -31,25 +34,6 @@ using range_value_type_t = std::remove_cv_t<std::remove_reference_t<decltype(*st
 
 }  // namespace internal
 
-/**
- * Compute the sum of and count of elements.
- *
- * @param range The container to iteratre over.
- * @param transform A callable to apply on every element of the container.
- * @param filter A callable to filter in elements (after transformation).
- */
-template <typename Range, typename U = internal::range_value_type_t<Range>>
-auto count_sum(Range range) noexcept -> std::pair<U, std::size_t> {
-	auto sum = U{0};
-	auto count = std::size_t{0};
-
-	for (auto const element : range) {
-		count++;
-		sum += element;
-	}
-	return {count, sum};
-}
-
 /**
  * Hold statistics of a range.
  */
@@ -62,32 +46,104 @@ template <typename T> struct StatsFeatures {
 	T max = 0.;
 };
 
-template <
-	typename Range,
-	typename U = internal::range_value_type_t<Range>,
-	typename T = std::conditional_t<std::is_floating_point_v<U>, U, double>>
-auto compute_stats(Range range) noexcept -> StatsFeatures<T> {
-	auto const [count, sum] = count_sum(range);
+/**
+ * Accumulate statistics of values seen one at a time.
+ *
+ * Contrary to compute_stats, values are given one at a time, so that statistics over different subsets of the same
+ * data (for instance positive and negative values) can be computed in a single sweep.
+ * The standard deviation uses Welford's online algorithm, which is numerically stable.
+ */
+template <typename T> class StatsAccumulator {
+public:
+	void add(T value) noexcept {
+		count++;
+		sum += value;
+		auto const delta = value - mean;
+		mean += delta / static_cast<T>(count);
+		sum_squared_deviations += delta * (value - mean);
+		min = std::min(min, value);
+		max = std::max(max, value);
+	}
 
-	// We can assume count to be always positive after this point and that the (filtered) iteration
-	// will contain at least one element.
-	if (count == 0) {
-		return {};
+	/** The statistics of the values added, all zero if none were added. */
+	[[nodiscard]] auto stats() const noexcept -> StatsFeatures<T> {
+		if (count == 0) {
+			return {};
+		}
+		auto const stddev = std::sqrt(sum_squared_deviations / static_cast<T>(count));
+		return {static_cast<T>(count), sum, mean, stddev, min, max};
 	}
 
-	auto const mean = safe_div(static_cast<T>(sum), static_cast<T>(count));
-	auto stddev = T{0.};
-	auto min = std::numeric_limits<U>::max();
-	auto max = std::numeric_limits<U>::min();
+private:
+	std::size_t count = 0;
+	T sum = 0.;
+	T mean = 0.;
+	T sum_squared_deviations = 0.;
+	T min = std::numeric_limits<T>::infinity();
+	T max = -std::numeric_limits<T>::infinity();
+};
 
-	for (auto const element : range) {
-		min = std::min(min, element);
-		max = std::max(max, element);
-		stddev += square(static_cast<T>(element) - mean);
+namespace internal {
+
+/** Whether the elements of a range are stored contiguously, and can hence be read again at no cost. */
+template <typename R, typename = void> struct is_contiguous_range : std::false_type {};
+template <typename R>
+struct is_contiguous_range<
+	R,
+	std::void_t<decltype(std::data(std::declval<R&>())), decltype(std::size(std::declval<R&>()))>> : std::true_type {};
+
+/**
+ * Statistics of contiguous values, in two sweeps over the memory.
+ *
+ * Contrary to the online algorithm, the sweeps have no division nor dependency between iterations other than the
+ * reductions, so that they are cheap and can be vectorized.
+ */
+template <typename T, typename U>
+auto compute_contiguous_stats(U const* data, std::size_t count) noexcept -> StatsFeatures<T> {
+	auto sum = T{0.};
+	auto min = data[0];
+	auto max = data[0];
+	for (std::size_t i = 0; i < count; ++i) {
+		sum += static_cast<T>(data[i]);
+		min = std::min(min, data[i]);
+		max = std::max(max, data[i]);
+	}
+	auto const mean = sum / static_cast<T>(count);
+	auto sum_squared_deviations = T{0.};
+	for (std::size_t i = 0; i < count; ++i) {
+		sum_squared_deviations += square(static_cast<T>(data[i]) - mean);
 	}
-	stddev = std::sqrt(stddev / static_cast<T>(count));
+	auto const stddev = std::sqrt(sum_squared_deviations / static_cast<T>(count));
+	return {static_cast<T>(count), sum, mean, stddev, static_cast<T>(min), static_cast<T>(max)};
+}
 
-	return {static_cast<T>(count), static_cast<T>(sum), mean, stddev, static_cast<T>(min), static_cast<T>(max)};
+}  // namespace internal
+
+/**
+ * Compute the count, sum, mean, standard deviation, minimum, and maximum of a range, all zero if it is empty.
+ *
+ * Every element is read once, so that lazy views transforming or filtering elements (for instance calling SCIP
+ * accessors) are only evaluated once.
+ * Contiguous ranges are read twice from memory instead, which avoids the divisions of the online algorithm.
+ */
+template <
+	typename Range,
+	typename U = internal::range_value_type_t<Range>,
+	typename T = std::conditional_t<std::is_floating_point_v<U>, U, double>>
+auto compute_stats(Range&& range) noexcept -> StatsFeatures<T> {
+	if constexpr (internal::is_contiguous_range<Range>::value) {
+		auto const count = static_cast<std::size_t>(std::size(range));
+		if (count == 0) {
+			return {};
+		}
+		return internal::compute_contiguous_stats<T>(std::data(range), count);
+	} else {
+		auto accumulator = StatsAccumulator<T>{};
+		for (auto const element : range) {
+			accumulator.add(static_cast<T>(element));
+		}
+		return accumulator.stats();
+	}
 }
 
 }  // namespace ecole::utility
@@ -0,0 +1,258 @@
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <typeinfo>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if __has_include(<cxxabi.h>)
+#include <cxxabi.h>
+#endif
+
+#include <fmt/format.h>
+
+#include "ecole/utility/metrics.hpp"
+
+namespace ecole::utility::metrics {
+
+/***************************
+ *  Histogram definitions  *
+ ***************************/
+
+auto Histogram::counts() const noexcept -> std::array<std::uint64_t, n_bounds + 1> {
+	auto counts = std::array<std::uint64_t, n_bounds + 1>{};
+	std::transform(m_counts.begin(), m_counts.end(), counts.begin(), [](auto const& c) {
+		return c.load(std::memory_order_relaxed);
+	});
+	return counts;
+}
+
+auto Histogram::count() const noexcept -> std::uint64_t {
+	auto n = std::uint64_t{0};
+	for (auto const& c : m_counts) {
+		n += c.load(std::memory_order_relaxed);
+	}
+	return n;
+}
+
+/**************************
+ *  Registry definitions  *
+ **************************/
+
+namespace {
+
+using Metric = std::variant<std::unique_ptr<Counter>, std::unique_ptr<Gauge>, std::unique_ptr<Histogram>>;
+
+/** The metrics of the same name, which only differ by their labels. */
+struct Family {
+	std::string name;
+	std::string help;
+	std::size_t kind;
+	std::vector<std::pair<Labels, Metric>> metrics;
+};
+
+auto constexpr kind_names = std::array{"counter", "gauge", "histogram"};
+
+/** The index of the metric type in the Metric variant. */
+template <typename T> auto constexpr kind_of() noexcept -> std::size_t {
+	if constexpr (std::is_same_v<T, Counter>) {
+		return 0;
+	} else if constexpr (std::is_same_v<T, Gauge>) {
+		return 1;
+	} else {
+		static_assert(std::is_same_v<T, Histogram>);
+		return 2;
+	}
+}
+
+auto is_valid_name(std::string_view name) noexcept -> bool {
+	auto const valid_char = [](char c) {
+		return std::isalnum(static_cast<unsigned char>(c)) != 0 || c == '_' || c == ':';
+	};
+	return !name.empty() && std::isdigit(static_cast<unsigned char>(name.front())) == 0 &&
+				 std::all_of(name.begin(), name.end(), valid_char);
+}
+
+class Registry {
+public:
+	template <typename T> auto get(std::string_view name, std::string_view help, Labels const& labels) -> T& {
+		auto constexpr kind = kind_of<T>();
+		auto const lk = std::lock_guard{m_mutex};
+		auto iter = std::find_if(m_families.begin(), m_families.end(), [name](auto const& f) { return f.name == name; });
+		if (iter == m_families.end()) {
+			if (!is_valid_name(name)) {
+				throw std::invalid_argument{fmt::format(R"(Invalid metric name "{}".)", name)};
+			}
+			iter = m_families.insert(m_families.end(), Family{std::string{name}, std::string{help}, kind, {}});
+		} else if (iter->kind != kind) {
+			throw std::invalid_argument{
+				fmt::format("Metric {} is already registered as a {}.", iter->name, kind_names.at(iter->kind))};
+		}
+		auto& metrics = iter->metrics;
+		auto const same_labels = [&labels](auto const& metric) { return metric.first == labels; };
+		if (auto found = std::find_if(metrics.begin(), metrics.end(), same_labels); found != metrics.end()) {
+			return *std::get<std::unique_ptr<T>>(found->second);
+		}
+		auto& metric = metrics.emplace_back(labels, std::make_unique<T>());
+		return *std::get<std::unique_ptr<T>>(metric.second);
+	}
+
+	/** Call the function with every family, holding the lock so that no metric is added meanwhile. */
+	template <typename Func> void for_each(Func&& func) const {
+		auto const lk = std::lock_guard{m_mutex};
+		for (auto const& family : m_families) {
+			func(family);
+		}
+	}
+
+private:
+	mutable std::mutex m_mutex;
+	std::vector<Family> m_families;
+};
+
+auto registry() -> Registry& {
+	static auto the_registry = Registry{};
+	return the_registry;
+}
+
+auto with_label(Labels labels, std::string name, std::string value) -> Labels {
+	labels.emplace_back(std::move(name), std::move(value));
+	return labels;
+}
+
+/** Append the samples of a metric, histograms being expanded as in Prometheus. */
+void add_samples(std::vector<Sample>& samples, std::string const& name, Labels const& labels, Metric const& metric) {
+	if (auto const* counter = std::get_if<std::unique_ptr<Counter>>(&metric)) {
+		samples.push_back({name, labels, static_cast<double>((*counter)->value())});
+	} else if (auto const* gauge = std::get_if<std::unique_ptr<Gauge>>(&metric)) {
+		samples.push_back({name, labels, static_cast<double>((*gauge)->value())});
+	} else {
+		auto const& histogram = *std::get<std::unique_ptr<Histogram>>(metric);
+		auto const counts = histogram.counts();
+		auto cumulative = std::uint64_t{0};
+		for (std::size_t i = 0; i < Histogram::n_bounds; ++i) {
+			cumulative += counts[i];
+			auto const bound = static_cast<double>(Histogram::bounds_ns[i]) / 1e9;
+			auto const value = static_cast<double>(cumulative);
+			samples.push_back({name + "_bucket", with_label(labels, "le", fmt::format("{}", bound)), value});
+		}
+		cumulative += counts[Histogram::n_bounds];
+		samples.push_back({name + "_bucket", with_label(labels, "le", "+Inf"), static_cast<double>(cumulative)});
+		auto const sum = std::chrono::duration<double>(histogram.sum()).count();
+		samples.push_back({name + "_sum", labels, sum});
+		samples.push_back({name + "_count", labels, static_cast<double>(cumulative)});
+	}
+}
+
+/** Escape a label value as in the text format of Prometheus. */
+auto escape(std::string_view value) -> std::string {
+	auto escaped = std::string{};
+	escaped.reserve(value.size());
+	for (auto const c : value) {
+		switch (c) {
+		case '\\':
+			escaped += R"(\\)";
+			break;
+		case '"':
+			escaped += R"(\")";
+			break;
+		case '\n':
+			escaped += R"(\n)";
+			break;
+		default:
+			escaped += c;
+		}
+	}
+	return escaped;
+}
+
+}  // namespace
+
+auto counter(std::string_view name, std::string_view help, Labels const& labels) -> Counter& {
+	return registry().get<Counter>(name, help, labels);
+}
+
+auto gauge(std::string_view name, std::string_view help, Labels const& labels) -> Gauge& {
+	return registry().get<Gauge>(name, help, labels);
+}
+
+auto histogram(std::string_view name, std::string_view help, Labels const& labels) -> Histogram& {
+	return registry().get<Histogram>(name, help, labels);
+}
+
+auto collect() -> std::vector<Sample> {
+	auto samples = std::vector<Sample>{};
+	registry().for_each([&samples](Family const& family) {
+		for (auto const& [labels, metric] : family.metrics) {
+			add_samples(samples, family.name, labels, metric);
+		}
+	});
+	return samples;
+}
+
+auto to_prometheus() -> std::string {
+	auto text = std::string{};
+	auto samples = std::vector<Sample>{};
+	registry().for_each([&](Family const& family) {
+		text += fmt::format("# HELP {} {}\n# TYPE {} {}\n", family.name, family.help, family.name, kind_names[family.kind]);
+		samples.clear();
+		for (auto const& [labels, metric] : family.metrics) {
+			add_samples(samples, family.name, labels, metric);
+		}
+		for (auto const& sample : samples) {
+			text += sample.name;
+			if (!sample.labels.empty()) {
+				auto separator = "{";
+				for (auto const& [label, value] : sample.labels) {
+					text += fmt::format(R"({}{}="{}")", separator, label, escape(value));
+					separator = ",";
+				}
+				text += '}';
+			}
+			text += fmt::format(" {}\n", sample.value);
+		}
+	});
+	return text;
+}
+
+auto type_label(std::type_info const& type) -> std::string {
+	auto name = std::string{type.name()};
+#if __has_include(<cxxabi.h>)
+	auto status = 0;
+	auto* const demangled = abi::__cxa_demangle(type.name(), nullptr, nullptr, &status);
+	if (status == 0 && demangled != nullptr) {
+		name = demangled;
+	}
+	std::free(demangled);  // NOLINT(cppcoreguidelines-no-malloc) allocated by the demangler
+#endif
+	// Namespaces of Ecole are lower case, unlike its types
+	auto const is_namespace = [](std::string_view word) {
+		return !word.empty() && std::all_of(word.begin(), word.end(), [](char c) {
+			return std::islower(static_cast<unsigned char>(c)) != 0 || c == '_';
+		});
+	};
+	for (std::string_view const prefix : {"(anonymous namespace)::", "ecole::"}) {
+		for (auto pos = name.find(prefix); pos != std::string::npos; pos = name.find(prefix, pos)) {
+			name.erase(pos, prefix.size());
+			for (auto end = name.find("::", pos);
+					 end != std::string::npos && is_namespace(std::string_view{name}.substr(pos, end - pos));
+					 end = name.find("::", pos)) {
+				name.erase(pos, end + 2 - pos);
+			}
+		}
+	}
+	return name;
+}
+
+}  // namespace ecole::utility::metrics
@@ -0,0 +1,363 @@
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+#include <robin_hood.h>
+#include <xtensor/xadapt.hpp>
+#include <xtensor/xview.hpp>
+
+#include "utility/mps.hpp"
+
+namespace ecole::utility {
+
+namespace {
+
+enum struct Section { none, name, objsense, rows, columns, rhs, ranges, bounds, end };
+
+enum struct RowSense { objective, free, equal, less, greater };
+
+struct Row {
+	RowSense sense;
+	double rhs = 0.;
+	std::optional<double> range = {};
+	std::vector<std::pair<std::size_t, double>> coefs = {};
+};
+
+/** Incremental reader holding the problem as it is being parsed. */
+class MpsReader {
+public:
+	MpsReader(std::filesystem::path filename_, double infinity_) : filename(std::move(filename_)), infinity(infinity_) {}
+
+	auto read() -> MpsProblem {
+		auto file = std::ifstream{filename};
+		if (!file) {
+			throw std::runtime_error{fmt::format("Could not open file {}.", filename.string())};
+		}
+		auto line = std::string{};
+		while (section != Section::end && std::getline(file, line)) {
+			line_number++;
+			read_line(line);
+		}
+		return to_problem();
+	}
+
+private:
+	std::filesystem::path filename;
+	double infinity;
+	Section section = Section::none;
+	std::size_t line_number = 0;
+	bool in_integer_marker = false;
+	std::optional<std::size_t> objective_row;
+
+	std::vector<Row> rows;
+	robin_hood::unordered_map<std::string, std::size_t> row_indices;
+	std::vector<double> objective;
+	std::vector<double> lower_bounds;
+	std::vector<double> upper_bounds;
+	std::vector<bool> integral;
+	robin_hood::unordered_map<std::string, std::size_t> column_indices;
+
+	std::vector<std::string> tokens;
+
+	[[noreturn]] void fail(std::string const& reason) const {
+		throw std::runtime_error{fmt::format("{}:{}: {}", filename.string(), line_number, reason)};
+	}
+
+	void tokenize(std::string const& line) {
+		tokens.clear();
+		auto pos = line.find_first_not_of(" \t\r");
+		while (pos != std::string::npos) {
+			auto const end = line.find_first_of(" \t\r", pos);
+			tokens.emplace_back(line.substr(pos, end - pos));
+			pos = line.find_first_not_of(" \t\r", end);
+		}
+	}
+
+	[[nodiscard]] auto parse_value(std::string const& token) const -> double {
+		char* end = nullptr;
+		auto const value = std::strtod(token.c_str(), &end);
+		if (end != token.c_str() + token.size()) {
+			fail(fmt::format("invalid number \"{}\"", token));
+		}
+		if (value >= infinity) {
+			return std::numeric_limits<double>::infinity();
+		}
+		if (value <= -infinity) {
+			return -std::numeric_limits<double>::infinity();
+		}
+		return value;
+	}
+
+	[[nodiscard]] auto find_row(std::string const& name) const -> std::size_t {
+		auto const iter = row_indices.find(name);
+		if (iter == row_indices.end()) {
+			fail(fmt::format("unknown row \"{}\"", name));
+		}
+		return iter->second;
+	}
+
+	[[nodiscard]] auto find_column(std::string const& name) const -> std::size_t {
+		auto const iter = column_indices.find(name);
+		if (iter == column_indices.end()) {
+			fail(fmt::format("unknown column \"{}\"", name));
+		}
+		return iter->second;
+	}
+
+	void read_line(std::string const& line) {
+		if (line.empty() || line[0] == '*') {
+			return;
+		}
+		tokenize(line);
+		if (tokens.empty()) {
+			return;
+		}
+		// Section headers start on the first column
+		if (line[0] != ' ' && line[0] != '\t') {
+			read_section(tokens[0]);
+			return;
+		}
+		switch (section) {
+		case Section::rows:
+			return read_row();
+		case Section::columns:
+			return read_column();
+		case Section::rhs:
+			return read_rhs_or_range(false);
+		case Section::ranges:
+			return read_rhs_or_range(true);
+		case Section::bounds:
+			return read_bound();
+		case Section::name:
+		case Section::objsense:
+			// Objective sense does not change the features
+			return;
+		default:
+			fail("data outside of a section");
+		}
+	}
+
+	void read_section(std::string const& name) {
+		if (name == "NAME") {
+			section = Section::name;
+		} else if (name == "OBJSENSE") {
+			section = Section::objsense;
+		} else if (name == "ROWS") {
+			section = Section::rows;
+		} else if (name == "COLUMNS") {
+			section = Section::columns;
+		} else if (name == "RHS") {
+			section = Section::rhs;
+		} else if (name == "RANGES") {
+			section = Section::ranges;
+		} else if (name == "BOUNDS") {
+			section = Section::bounds;
+		} else if (name == "ENDATA") {
+			section = Section::end;
+		} else {
+			fail(fmt::format("unsupported section {}", name));
+		}
+	}
+
+	void read_row() {
+		if (tokens.size() != 2) {
+			fail("expected a row type and name");
+		}
+		auto const& type = tokens[0];
+		auto sense = RowSense::free;
+		if (type == "N") {
+			sense = objective_row.has_value() ? RowSense::free : RowSense::objective;
+		} else if (type == "E") {
+			sense = RowSense::equal;
+		} else if (type == "L") {
+			sense = RowSense::less;
+		} else if (type == "G") {
+			sense = RowSense::greater;
+		} else {
+			fail(fmt::format("unknown row type {}", type));
+		}
+		if (sense == RowSense::objective) {
+			objective_row = rows.size();
+		}
+		row_indices.emplace(tokens[1], rows.size());
+		rows.push_back({sense});
+	}
+
+	void read_column() {
+		if (tokens.size() == 3 && tokens[1] == "'MARKER'") {
+			if (tokens[2] == "'INTORG'") {
+				in_integer_marker = true;
+			} else if (tokens[2] == "'INTEND'") {
+				in_integer_marker = false;
+			} else {
+				fail(fmt::format("unknown marker {}", tokens[2]));
+			}
+			return;
+		}
+		if (tokens.size() != 3 && tokens.size() != 5) {
+			fail("expected a column name followed by one or two row and value pairs");
+		}
+
+		auto const [iter, inserted] = column_indices.try_emplace(tokens[0], objective.size());
+		auto const col = iter->second;
+		if (inserted) {
+			objective.push_back(0.);
+			lower_bounds.push_back(0.);
+			upper_bounds.push_back(in_integer_marker ? 1. : std::numeric_limits<double>::infinity());
+			integral.push_back(in_integer_marker);
+		}
+		for (std::size_t i = 1; i + 1 < tokens.size(); i += 2) {
+			auto const row = find_row(tokens[i]);
+			auto const value = parse_value(tokens[i + 1]);
+			if (rows[row].sense == RowSense::objective) {
+				objective[col] += value;
+			} else if (value != 0.) {
+				rows[row].coefs.emplace_back(col, value);
+			}
+		}
+	}
+
+	void read_rhs_or_range(bool is_range) {
+		// The set name is optional
+		auto const first = tokens.size() % 2;
+		if (tokens.size() < 2 + first) {
+			fail("expected one or two row and value pairs");
+		}
+		for (auto i = first; i + 1 < tokens.size(); i += 2) {
+			auto& row = rows[find_row(tokens[i])];
+			auto const value = parse_value(tokens[i + 1]);
+			if (is_range) {
+				row.range = value;
+			} else {
+				row.rhs = value;
+			}
+		}
+	}
+
+	void read_bound() {
+		if (tokens.size() < 2 || tokens.size() > 4) {
+			fail("expected a bound type, set name, column name and value");
+		}
+		auto const& type = tokens[0];
+		auto const has_value = !(type == "FR" || type == "MI" || type == "PL" || type == "BV") || tokens.size() == 4;
+		auto const name_pos = has_value ? tokens.size() - 2 : tokens.size() - 1;
+		if (name_pos == 0) {
+			fail("missing column name");
+		}
+		auto const col = find_column(tokens[name_pos]);
+		auto const value = has_value ? parse_value(tokens.back()) : 0.;
+
+		auto& lb = lower_bounds[col];
+		auto& ub = upper_bounds[col];
+		auto constexpr inf = std::numeric_limits<double>::infinity();
+		if (type == "UP" || type == "UI" || type == "SC") {
+			// Following SCIP, a negative upper bounds makes a zero lower bound infinite
+			if (value < 0 && lb == 0.) {
+				lb = -inf;
+			}
+			ub = value;
+		} else if (type == "LO" || type == "LI") {
+			lb = value;
+		} else if (type == "FX") {
+			lb = value;
+			ub = value;
+		} else if (type == "FR") {
+			lb = -inf;
+			ub = inf;
+		} else if (type == "MI") {
+			lb = -inf;
+		} else if (type == "PL") {
+			ub = inf;
+		} else if (type == "BV") {
+			lb = 0.;
+			ub = 1.;
+		} else {
+			fail(fmt::format("unknown bound type {}", type));
+		}
+		if (type == "UI" || type == "LI" || type == "BV") {
+			integral[col] = true;
+		}
+	}
+
+	/** Lay out the finite sides of every row as in scip::get_all_constraints. */
+	auto to_problem() -> MpsProblem {
+		auto values = std::vector<double>{};
+		auto row_idx = std::vector<std::size_t>{};
+		auto col_idx = std::vector<std::size_t>{};
+		auto biases = std::vector<double>{};
+		auto add_side = [&](Row const& row, double sign, double bias) {
+			for (auto const [col, value] : row.coefs) {
+				values.push_back(sign * value);
+				row_idx.push_back(biases.size());
+				col_idx.push_back(col);
+			}
+			biases.push_back(sign * bias);
+		};
+
+		for (auto const& row : rows) {
+			auto lhs = std::optional<double>{};
+			auto rhs = std::optional<double>{};
+			auto const range = std::abs(row.range.value_or(0.));
+			switch (row.sense) {
+			case RowSense::equal:
+				lhs = row.rhs;
+				rhs = row.rhs;
+				if (row.range.has_value()) {
+					(row.range.value() > 0 ? rhs : lhs) = row.rhs + row.range.value();
+				}
+				break;
+			case RowSense::less:
+				rhs = row.rhs;
+				if (row.range.has_value()) {
+					lhs = row.rhs - range;
+				}
+				break;
+			case RowSense::greater:
+				lhs = row.rhs;
+				if (row.range.has_value()) {
+					rhs = row.rhs + range;
+				}
+				break;
+			default:
+				continue;
+			}
+			if (lhs.has_value() && std::isfinite(lhs.value())) {
+				add_side(row, -1., lhs.value());
+			}
+			if (rhs.has_value() && std::isfinite(rhs.value())) {
+				add_side(row, 1., rhs.value());
+			}
+		}
+
+		auto problem = MpsProblem{};
+		auto const nnz = values.size();
+		problem.constraint_matrix.values = xt::adapt(std::move(values), {nnz});
+		problem.constraint_matrix.indices = decltype(coo_matrix<double>::indices)::from_shape({2, nnz});
+		xt::row(problem.constraint_matrix.indices, 0) = xt::adapt(std::move(row_idx), {nnz});
+		xt::row(problem.constraint_matrix.indices, 1) = xt::adapt(std::move(col_idx), {nnz});
+		problem.constraint_matrix.shape = {biases.size(), objective.size()};
+		auto const n_rows = biases.size();
+		problem.constraint_biases = xt::adapt(std::move(biases), {n_rows});
+		problem.objective = std::move(objective);
+		problem.lower_bounds = std::move(lower_bounds);
+		problem.upper_bounds = std::move(upper_bounds);
+		problem.integral = std::move(integral);
+		return problem;
+	}
+};
+
+}  // namespace
+
+auto read_mps(std::filesystem::path const& filename, double infinity) -> MpsProblem {
+	return MpsReader{filename, infinity}.read();
+}
+
+}  // namespace ecole::utility
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <filesystem>
+#include <vector>
+
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/export.hpp"
+#include "ecole/utility/sparse-matrix.hpp"
+
+namespace ecole::utility {
+
+/**
+ * Data of a linear problem read from an MPS file.
+ *
+ * Constraints are laid out as in scip::get_all_constraints, that is every finite side of a row is an inequality
+ * ``a x <= b``, with the left hand side negated.
+ * Variables are ordered by first appearance in the ``COLUMNS`` section.
+ */
+struct MpsProblem {
+	coo_matrix<double> constraint_matrix;
+	xt::xtensor<double, 1> constraint_biases;
+	std::vector<double> objective;
+	std::vector<double> lower_bounds;
+	std::vector<double> upper_bounds;
+	std::vector<bool> integral;
+};
+
+/**
+ * Read an MPS file line by line, without creating a SCIP model.
+ *
+ * Only the free (whitespace separated) format and the ``NAME``, ``OBJSENSE``, ``ROWS``, ``COLUMNS``, ``RHS``,
+ * ``RANGES``, and ``BOUNDS`` sections are supported.
+ * Following SCIP, integer columns have default bounds of zero and one, and values whose magnitude is at least
+ * ``infinity`` are infinite.
+ *
+ * @throw std::runtime_error If the file cannot be opened or has an unsupported content.
+ */
+ECOLE_EXPORT auto read_mps(std::filesystem::path const& filename, double infinity = 1e20) -> MpsProblem;
+
+}  // namespace ecole::utility
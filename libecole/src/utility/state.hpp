@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+
+namespace ecole::utility {
+
+/**
+ * Build the saved state of an object, as a sequence of integers and byte strings.
+ *
+ * Integers are written as little endian 64 bits words, and byte strings are prefixed by their length, so that states
+ * are the same on all platforms.
+ */
+class StateWriter {
+public:
+	void write(std::uint64_t value) {
+		for (unsigned int shift = 0; shift < 64; shift += 8) {
+			data.push_back(static_cast<char>((value >> shift) & 0xFFU));
+		}
+	}
+
+	void write(std::string_view bytes) {
+		write(static_cast<std::uint64_t>(bytes.size()));
+		data.append(bytes);
+	}
+
+	[[nodiscard]] auto str() && -> std::string { return std::move(data); }
+
+private:
+	std::string data;
+};
+
+/** Read a state in the order it was written by a StateWriter. */
+class StateReader {
+public:
+	explicit StateReader(std::string_view data_) noexcept : data{data_} {}
+
+	/** @throw std::invalid_argument If the state is too short. */
+	auto read_integer() -> std::uint64_t {
+		auto const bytes = take(sizeof(std::uint64_t));
+		auto value = std::uint64_t{0};
+		for (std::size_t i = 0; i < bytes.size(); ++i) {
+			value |= static_cast<std::uint64_t>(static_cast<unsigned char>(bytes[i])) << (8 * i);
+		}
+		return value;
+	}
+
+	/** @throw std::invalid_argument If the state is too short. */
+	auto read_bytes() -> std::string_view {
+		auto const size = read_integer();
+		if (size > data.size()) {
+			throw std::invalid_argument{"Saved state is truncated."};
+		}
+		return take(static_cast<std::size_t>(size));
+	}
+
+	/** @throw std::invalid_argument If the state has more data than what was read. */
+	void finish() const {
+		if (!data.empty()) {
+			throw std::invalid_argument{"Saved state has trailing data."};
+		}
+	}
+
+private:
+	std::string_view data;
+
+	auto take(std::size_t n) -> std::string_view {
+		if (n > data.size()) {
+			throw std::invalid_argument{"Saved state is truncated."};
+		}
+		auto const bytes = data.substr(0, n);
+		data.remove_prefix(n);
+		return bytes;
+	}
+};
+
+}  // namespace ecole::utility
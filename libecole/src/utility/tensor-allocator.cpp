@@ -0,0 +1,43 @@
+#include <atomic>
+#include <memory_resource>
+#include <utility>
+
+#include "ecole/utility/tensor-allocator.hpp"
+
+namespace ecole::utility {
+
+namespace {
+
+auto the_resource() noexcept -> std::atomic<std::pmr::memory_resource*>& {
+	static auto resource = std::atomic<std::pmr::memory_resource*>{std::pmr::new_delete_resource()};
+	return resource;
+}
+
+/** The resource of the innermost ScopedTensorMemoryResource of the thread, if any. */
+// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
+thread_local std::pmr::memory_resource* scoped_resource = nullptr;
+
+}  // namespace
+
+auto tensor_memory_resource() noexcept -> std::pmr::memory_resource* {
+	if (scoped_resource != nullptr) {
+		return scoped_resource;
+	}
+	return the_resource().load(std::memory_order_acquire);
+}
+
+auto set_tensor_memory_resource(std::pmr::memory_resource* resource) noexcept -> std::pmr::memory_resource* {
+	if (resource == nullptr) {
+		resource = std::pmr::new_delete_resource();
+	}
+	return the_resource().exchange(resource, std::memory_order_acq_rel);
+}
+
+ScopedTensorMemoryResource::ScopedTensorMemoryResource(std::pmr::memory_resource* resource) noexcept :
+	previous{std::exchange(scoped_resource, resource)} {}
+
+ScopedTensorMemoryResource::~ScopedTensorMemoryResource() {
+	scoped_resource = previous;
+}
+
+}  // namespace ecole::utility
@@ -0,0 +1,41 @@
+#include <atomic>
+#include <cstddef>
+#include <utility>
+
+#include "ecole/utility/thread-pool.hpp"
+
+namespace ecole::utility {
+namespace {
+
+// Defined in the library rather than inline, so that pools of all binaries share it
+thread_local bool is_worker_thread = false;
+
+std::atomic<std::size_t> n_running = 0;
+
+}  // namespace
+
+RunningThread::RunningThread() noexcept {
+	++n_running;
+}
+
+RunningThread::RunningThread(RunningThread&& other) noexcept : m_counted{std::exchange(other.m_counted, false)} {}
+
+RunningThread::~RunningThread() noexcept {
+	if (m_counted) {
+		--n_running;
+	}
+}
+
+auto RunningThread::count() noexcept -> std::size_t {
+	return n_running.load();
+}
+
+auto ThreadPool::in_worker_thread() noexcept -> bool {
+	return is_worker_thread;
+}
+
+auto ThreadPool::mark_worker_thread() noexcept -> void {
+	is_worker_thread = true;
+}
+
+}  // namespace ecole::utility
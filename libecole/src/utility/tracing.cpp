@@ -0,0 +1,147 @@
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include "ecole/utility/tracing.hpp"
+
+namespace ecole::utility::tracing {
+
+namespace {
+
+struct Event {
+	char const* name;
+	std::chrono::steady_clock::time_point begin;
+	std::chrono::steady_clock::time_point end;
+};
+
+/** Events of one thread, only contended while the trace is written. */
+struct ThreadBuffer {
+	std::size_t thread_id;
+	std::mutex mutex;
+	std::vector<Event> events;
+};
+
+class Recorder {
+public:
+	Recorder() {
+		if (auto const* const filename = std::getenv("ECOLE_TRACE_FILE"); filename != nullptr) {
+			start(filename);
+		}
+	}
+	Recorder(Recorder const&) = delete;
+	Recorder(Recorder&&) = delete;
+	auto operator=(Recorder const&) -> Recorder& = delete;
+	auto operator=(Recorder&&) -> Recorder& = delete;
+	~Recorder() { stop(); }
+
+	[[nodiscard]] auto is_started() const noexcept -> bool { return started.load(std::memory_order_relaxed); }
+
+	void start(std::string filename_) {
+		auto lock = std::lock_guard{mutex};
+		filename = std::move(filename_);
+		for (auto& buffer : buffers) {
+			auto buffer_lock = std::lock_guard{buffer->mutex};
+			buffer->events.clear();
+		}
+		origin = std::chrono::steady_clock::now();
+		started.store(true, std::memory_order_relaxed);
+	}
+
+	void stop() {
+		auto lock = std::lock_guard{mutex};
+		if (!started.exchange(false, std::memory_order_relaxed)) {
+			return;
+		}
+		write();
+	}
+
+	void record(Event const& event) {
+		auto& buffer = thread_buffer();
+		auto lock = std::lock_guard{buffer.mutex};
+		buffer.events.push_back(event);
+	}
+
+private:
+	std::atomic<bool> started = false;
+	std::mutex mutex;
+	std::string filename;
+	std::chrono::steady_clock::time_point origin;
+	/** Buffers are shared with their thread, so that they outlive threads that ended before the trace is written. */
+	std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+
+	auto thread_buffer() -> ThreadBuffer& {
+		thread_local auto buffer = std::shared_ptr<ThreadBuffer>{};
+		if (buffer == nullptr) {
+			auto lock = std::lock_guard{mutex};
+			buffer = std::make_shared<ThreadBuffer>();
+			buffer->thread_id = buffers.size();
+			buffers.push_back(buffer);
+		}
+		return *buffer;
+	}
+
+	/** Write the complete events ("X" phase) in microseconds since the start of the trace. */
+	void write() {
+		auto file = std::ofstream{filename};
+		auto const micro_seconds = [this](std::chrono::steady_clock::time_point time) {
+			return std::chrono::duration<double, std::micro>(time - origin).count();
+		};
+		file << R"({"displayTimeUnit": "ms", "traceEvents": [)";
+		auto separator = "\n";
+		for (auto& buffer : buffers) {
+			auto buffer_lock = std::lock_guard{buffer->mutex};
+			for (auto const& event : buffer->events) {
+				file << separator
+						 << fmt::format(
+								R"({{"name": "{}", "ph": "X", "pid": 0, "tid": {}, "ts": {:.3f}, "dur": {:.3f}}})",
+								event.name,
+								buffer->thread_id,
+								micro_seconds(event.begin),
+								std::chrono::duration<double, std::micro>(event.end - event.begin).count());
+				separator = ",\n";
+			}
+			buffer->events.clear();
+		}
+		file << "\n]}\n";
+	}
+};
+
+auto recorder() -> Recorder& {
+	static auto the_recorder = Recorder{};
+	return the_recorder;
+}
+
+/** Start tracing from the environment variable when the library is loaded. */
+[[maybe_unused]] auto const& load_recorder = recorder();
+
+}  // namespace
+
+auto is_started() noexcept -> bool {
+	return recorder().is_started();
+}
+
+void start(std::string filename) {
+	recorder().start(std::move(filename));
+}
+
+void stop() {
+	recorder().stop();
+}
+
+void Span::record(
+	char const* name,
+	std::chrono::steady_clock::time_point begin,
+	std::chrono::steady_clock::time_point end) {
+	recorder().record({name, begin, end});
+}
+
+}  // namespace ecole::utility::tracing
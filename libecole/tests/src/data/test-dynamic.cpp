@@ -1,3 +1,6 @@
+#include <array>
+#include <utility>
+
 #include <catch2/catch.hpp>
 
 #include "ecole/data/dynamic.hpp"
@@ -34,3 +37,52 @@ TEST_CASE("Dynamic function is polymorphic", "[unit][data]") {
 		REQUIRE(data == double_val + 1);
 	}
 }
+
+namespace {
+
+/** A data function too large to be stored inline. */
+struct LargeDataFunc : IntDataFunc {
+	LargeDataFunc() : IntDataFunc{0} {}
+	std::array<char, 2 * DynamicFunction<int>::buffer_size> padding = {};
+};
+
+}  // namespace
+
+TEST_CASE("Dynamic function stores small functions inline", "[unit][data]") {
+	STATIC_REQUIRE(DynamicFunction<int>::is_stored_inline<IntDataFunc>);
+	STATIC_REQUIRE(!DynamicFunction<int>::is_stored_inline<LargeDataFunc>);
+}
+
+TEST_CASE("Dynamic function copies are independent", "[unit][data]") {
+	auto model = get_model();
+	auto const make_func = GENERATE(
+		+[] { return DynamicFunction<int>{IntDataFunc{0}}; }, +[] { return DynamicFunction<int>{LargeDataFunc{}}; });
+	auto data_func = make_func();
+	auto data_func_copy = data_func;
+	data_func_copy.before_reset(model);
+	REQUIRE(data_func.extract(model, false) == 0);
+	REQUIRE(data_func_copy.extract(model, false) == 1);
+
+	auto data_func_moved = std::move(data_func_copy);
+	REQUIRE(data_func_moved.extract(model, false) == 1);
+	data_func = data_func_moved;
+	REQUIRE(data_func.extract(model, false) == 1);
+}
+
+TEST_CASE("Variant function unit tests", "[unit][data]") {
+	unit_tests(VariantFunction<double, IntDataFunc, DoubleDataFunc>{DoubleDataFunc{}});
+}
+
+TEST_CASE("Variant function dispatches to the stored function", "[unit][data]") {
+	using Data = double;
+	auto data_func = VariantFunction<Data, IntDataFunc, DoubleDataFunc>{IntDataFunc{33}};
+	auto model = get_model();
+	REQUIRE(data_func.index() == 0);
+	data_func.before_reset(model);
+	REQUIRE(data_func.extract(model, false) == Data{34});
+
+	data_func = VariantFunction<Data, IntDataFunc, DoubleDataFunc>{DoubleDataFunc{42.}};
+	REQUIRE(data_func.index() == 1);
+	data_func.before_reset(model);
+	REQUIRE(data_func.extract(model, false) == 43.);
+}
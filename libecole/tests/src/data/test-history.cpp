@@ -0,0 +1,100 @@
+#include <cstddef>
+#include <optional>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+
+#include "ecole/data/history.hpp"
+#include "ecole/observation/pseudocosts.hpp"
+
+#include "conftest.hpp"
+#include "data/mock-function.hpp"
+#include "data/unit-tests.hpp"
+
+using namespace ecole;
+
+namespace {
+
+/** Return the number of previous calls to extract in the episode, or nothing when done. */
+struct CountFunction {
+	int n_extracted = 0;
+
+	void before_reset(scip::Model& /*model*/) { n_extracted = 0; }
+	auto extract(scip::Model& /*model*/, bool done) -> std::optional<int> {
+		if (done) {
+			return {};
+		}
+		return n_extracted++;
+	}
+};
+
+template <typename Data> auto values(data::History<Data> const& history) {
+	auto result = std::vector<Data>{};
+	for (std::size_t i = 0; i < history.size(); ++i) {
+		result.push_back(history[i]);
+	}
+	return result;
+}
+
+}  // namespace
+
+TEST_CASE("Data HistoryFunction unit tests", "[unit][data]") {
+	data::unit_tests(data::HistoryFunction<data::IntDataFunc>{{}, 3});
+	data::unit_tests(data::HistoryFunction<observation::Pseudocosts>{{}, 3, true});
+}
+
+TEST_CASE("History data function keeps the last data of the episode", "[data]") {
+	auto history_func = data::HistoryFunction<CountFunction>{{}, 3};
+	auto model = get_model();
+	history_func.before_reset(model);
+	REQUIRE(history_func.history().empty());
+
+	REQUIRE(values(history_func.extract(model, false).value()) == std::vector{0});
+	REQUIRE(values(history_func.extract(model, false).value()) == std::vector{0, 1});
+	REQUIRE(values(history_func.extract(model, false).value()) == std::vector{0, 1, 2});
+	auto const history = history_func.extract(model, false).value();
+	REQUIRE(values(history) == std::vector{1, 2, 3});
+	REQUIRE(values(history_func.extract(model, false).value()) == std::vector{2, 3, 4});
+
+	SECTION("Histories are not modified by later extractions") { REQUIRE(values(history) == std::vector{1, 2, 3}); }
+
+	SECTION("Nothing is returned nor kept without data") {
+		REQUIRE_FALSE(history_func.extract(model, true).has_value());
+		REQUIRE(values(history_func.history()) == std::vector{2, 3, 4});
+	}
+
+	SECTION("History is cleared on reset") {
+		history_func.before_reset(model);
+		REQUIRE(history_func.history().empty());
+		REQUIRE(values(history_func.extract(model, false).value()) == std::vector{0});
+	}
+}
+
+TEST_CASE("Padded history data function repeats the first data", "[data]") {
+	auto history_func = data::HistoryFunction<CountFunction>{{}, 3, true};
+	auto model = get_model();
+	history_func.before_reset(model);
+	REQUIRE(history_func.history().empty());
+	REQUIRE(values(history_func.extract(model, false).value()) == std::vector{0, 0, 0});
+	REQUIRE(values(history_func.extract(model, false).value()) == std::vector{0, 0, 1});
+	REQUIRE(values(history_func.extract(model, false).value()) == std::vector{0, 1, 2});
+	REQUIRE(values(history_func.extract(model, false).value()) == std::vector{1, 2, 3});
+}
+
+TEST_CASE("History data function shares data between histories", "[data]") {
+	auto history_func = data::HistoryFunction<observation::Pseudocosts>{{}, 2};
+	auto model = get_model();
+	history_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const first = history_func.extract(model, false).value();
+	auto const second = history_func.extract(model, false).value();
+	REQUIRE(second.size() == 2);
+	REQUIRE(second.items().front() == first.items().back());
+	REQUIRE(&second.front() == &first.back());
+}
+
+TEST_CASE("History data function cannot be empty", "[data]") {
+	REQUIRE_THROWS_AS(data::HistoryFunction<data::IntDataFunc>({}, 0), std::invalid_argument);
+}
@@ -4,6 +4,7 @@
 #include <catch2/catch.hpp>
 
 #include "ecole/data/map.hpp"
+#include "ecole/utility/flat-map.hpp"
 
 #include "conftest.hpp"
 #include "data/mock-function.hpp"
@@ -22,7 +23,7 @@ TEST_CASE("Combine data extraction functions into a map", "[data]") {
 	data_func.before_reset(model);
 	advance_to_stage(model, SCIP_STAGE_SOLVING);
 	auto const data = data_func.extract(model, false);
-	STATIC_REQUIRE(std::is_same_v<std::remove_const_t<decltype(data)>, std::map<std::string, int>>);
+	STATIC_REQUIRE(std::is_same_v<std::remove_const_t<decltype(data)>, ecole::utility::FlatMap<std::string, int>>);
 	REQUIRE(data.at("a") == 2);
 	REQUIRE(data.at("b") == 3);
 }
@@ -0,0 +1,125 @@
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/data/normalized.hpp"
+#include "ecole/observation/khalil-2016.hpp"
+#include "ecole/observation/node-bipartite.hpp"
+
+#include "conftest.hpp"
+#include "data/unit-tests.hpp"
+
+using namespace ecole;
+
+namespace {
+
+struct MatrixObs {
+	xt::xtensor<double, 2> features;
+};
+
+auto normalized_features(MatrixObs& obs) {
+	return std::tie(obs.features);
+}
+
+/** Return the given matrices in turn. */
+struct MatrixFunction {
+	std::vector<xt::xtensor<double, 2>> matrices;
+	std::size_t n_extracted = 0;
+
+	void before_reset(scip::Model& /*model*/) {}
+	auto extract(scip::Model& /*model*/, bool /*done*/) -> std::optional<MatrixObs> {
+		return MatrixObs{matrices[n_extracted++ % matrices.size()]};
+	}
+};
+
+auto const nan = std::numeric_limits<double>::quiet_NaN();
+
+}  // namespace
+
+TEST_CASE("Data NormalizedFunction unit tests", "[unit][data]") {
+	data::unit_tests(data::NormalizedFunction<observation::Khalil2016>{});
+}
+
+TEST_CASE("NormalizedFunction normalizes with the statistics of previous observations", "[data]") {
+	auto const first = xt::xtensor<double, 2>{{1., 10.}, {3., nan}};
+	auto const second = xt::xtensor<double, 2>{{5., 20.}, {3., 30.}};
+	auto func = data::NormalizedFunction<MatrixFunction>{MatrixFunction{{first, second}}, 0.};
+	auto model = get_model();
+	func.before_reset(model);
+
+	// Nothing is known before the first observation
+	auto const obs1 = func.extract(model, false).value();
+	REQUIRE(obs1.features(0, 0) == 1.);
+	REQUIRE(std::isnan(obs1.features(1, 1)));
+	auto const& stats = func.get_statistics().at(0);
+	REQUIRE(stats.count(0) == 2);
+	REQUIRE(stats.count(1) == 1);
+	REQUIRE(stats.mean(0) == Approx(2.));
+	REQUIRE(stats.variance(0) == Approx(1.));
+
+	auto const obs2 = func.extract(model, false).value();
+	REQUIRE(obs2.features(0, 0) == Approx(3.));
+	// The variance of a single value is zero, hence an infinite scale without epsilon
+	REQUIRE(obs2.features(0, 1) == std::numeric_limits<double>::infinity());
+	REQUIRE(func.get_statistics().at(0).mean(1) == Approx(20.));
+
+	SECTION("Frozen statistics are not updated") {
+		auto const saved = func.get_statistics();
+		func.freeze();
+		func.extract(model, false);
+		REQUIRE(func.get_statistics() == saved);
+	}
+
+	SECTION("Statistics are restored from bytes") {
+		auto restored = data::NormalizedFunction<MatrixFunction>{MatrixFunction{{first, second}}, 0.};
+		restored.load_statistics(func.save_statistics());
+		REQUIRE(restored.get_statistics() == func.get_statistics());
+		REQUIRE_THROWS_AS(restored.load_statistics("garbage"), std::invalid_argument);
+	}
+
+	SECTION("Observations must have the same number of features") {
+		auto other = data::NormalizedFunction<MatrixFunction>{MatrixFunction{{xt::xtensor<double, 2>{{1.}}}}};
+		other.set_statistics(func.get_statistics());
+		REQUIRE_THROWS_AS(other.extract(model, false), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Merged statistics are the statistics of all values", "[data]") {
+	auto values = std::vector<double>{1., 4., -2., 8., 0.5, 3.};
+	auto all = data::FeatureStatistics{1};
+	auto left = data::FeatureStatistics{1};
+	auto right = data::FeatureStatistics{1};
+	for (std::size_t i = 0; i < values.size(); ++i) {
+		all.add(0, values[i]);
+		(i < 2 ? left : right).add(0, values[i]);
+	}
+	left.merge(right);
+	REQUIRE(left.count(0) == all.count(0));
+	REQUIRE(left.mean(0) == Approx(all.mean(0)));
+	REQUIRE(left.variance(0) == Approx(all.variance(0)));
+
+	auto empty = data::FeatureStatistics{};
+	empty.merge(all);
+	REQUIRE(empty == all);
+	REQUIRE_THROWS_AS(all.merge(data::FeatureStatistics{2}), std::invalid_argument);
+}
+
+TEST_CASE("NormalizedFunction gathers statistics of NodeBipartite features", "[data]") {
+	auto func = data::NormalizedFunction<observation::NodeBipartite>{};
+	auto model = get_model();
+	func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const obs = func.extract(model, false).value();
+	REQUIRE(func.get_statistics().size() == 2);
+	auto const& variable_stats = func.get_statistics()[0];
+	REQUIRE(variable_stats.n_features() == obs.variable_features.shape()[1]);
+	REQUIRE(variable_stats.count(0) == obs.variable_features.shape()[0]);
+}
@@ -0,0 +1,148 @@
+#include <stdexcept>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <xtensor/xmath.hpp>
+
+#include "ecole/data/parallel.hpp"
+#include "ecole/observation/khalil-2016.hpp"
+#include "ecole/observation/node-bipartite.hpp"
+#include "ecole/observation/strong-branching-scores.hpp"
+#include "ecole/scip/lp-view.hpp"
+
+#include "conftest.hpp"
+#include "data/mock-function.hpp"
+#include "data/unit-tests.hpp"
+
+using namespace ecole;
+using namespace ecole::data;
+
+namespace {
+
+/** A mock function declaring that it does not modify the model. */
+struct ReadOnlyIntFunc : IntDataFunc {
+	static constexpr bool mutates_model = false;
+	using MockFunction<int>::MockFunction;
+};
+
+/** Return the thread extracting the data. */
+struct ThreadIdFunc {
+	static constexpr bool mutates_model = false;
+	auto before_reset(scip::Model& /*model*/) -> void {}
+	auto extract(scip::Model& /*model*/, bool /*done*/) -> std::thread::id { return std::this_thread::get_id(); }
+};
+
+/** A read only function that fails. */
+struct ThrowingFunc {
+	static constexpr bool mutates_model = false;
+	auto before_reset(scip::Model& /*model*/) -> void {}
+	auto extract(scip::Model& /*model*/, bool /*done*/) -> int { throw std::runtime_error{"Extraction failed"}; }
+};
+
+}  // namespace
+
+TEST_CASE("Observation functions declare whether they modify the model", "[data]") {
+	STATIC_REQUIRE(trait::mutates_model_v<observation::NodeBipartite>);
+	STATIC_REQUIRE(trait::mutates_model_v<observation::Khalil2016>);
+	STATIC_REQUIRE(trait::mutates_model_v<observation::StrongBranchingScores>);
+	STATIC_REQUIRE(trait::mutates_model_v<IntDataFunc>);
+	STATIC_REQUIRE(!trait::mutates_model_v<ReadOnlyIntFunc>);
+}
+
+TEST_CASE("Observation functions declare whether they read the LP view", "[data]") {
+	STATIC_REQUIRE(trait::uses_lp_view_v<observation::NodeBipartite>);
+	STATIC_REQUIRE(trait::uses_lp_view_v<observation::Khalil2016>);
+	STATIC_REQUIRE(!trait::uses_lp_view_v<IntDataFunc>);
+	STATIC_REQUIRE(ParallelTupleFunction<IntDataFunc, observation::NodeBipartite>::uses_lp_view);
+	STATIC_REQUIRE(!ParallelTupleFunction<IntDataFunc, ReadOnlyIntFunc>::uses_lp_view);
+}
+
+TEST_CASE("Parallel tuple function shares the LP view", "[data]") {
+	auto data_func = ParallelTupleFunction{observation::NodeBipartite{}, observation::Khalil2016{}};
+	auto model = get_model();
+	data_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const [node_obs, khalil_obs] = data_func.extract(model, false);
+	REQUIRE(node_obs.has_value());
+	REQUIRE(khalil_obs.has_value());
+	REQUIRE(model.lp_view()->is_current(model));
+}
+
+TEST_CASE("Parallel tuple function extracts the same observations as sequential extraction", "[data]") {
+	auto parallel_func = ParallelTupleFunction{
+		observation::NodeBipartite{}, ReadOnlyIntFunc{}, observation::Khalil2016{}, ThreadIdFunc{}, ReadOnlyIntFunc{}};
+	auto node_func = observation::NodeBipartite{};
+	auto khalil_func = observation::Khalil2016{};
+	auto model = get_model();
+	parallel_func.before_reset(model);
+	node_func.before_reset(model);
+	khalil_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const [node_obs, int_obs, khalil_obs, thread_id, other_int_obs] = parallel_func.extract(model, false);
+	auto const node_expected = node_func.extract(model, false);
+	auto const khalil_expected = khalil_func.extract(model, false);
+	REQUIRE(node_obs.has_value());
+	REQUIRE(node_expected.has_value());
+	REQUIRE(node_obs.value().variable_features == node_expected.value().variable_features);
+	REQUIRE(node_obs.value().row_features == node_expected.value().row_features);
+	REQUIRE(node_obs.value().edge_features.values == node_expected.value().edge_features.values);
+	REQUIRE(khalil_obs.has_value());
+	REQUIRE(khalil_expected.has_value());
+	REQUIRE(xt::allclose(khalil_obs.value().features, khalil_expected.value().features, 1e-05, 1e-08, true));
+}
+
+TEST_CASE("Parallel tuple function unit tests", "[unit][data]") {
+	unit_tests(ParallelTupleFunction{ReadOnlyIntFunc{}, IntDataFunc{}, ReadOnlyIntFunc{}});
+}
+
+TEST_CASE("Parallel tuple function extracts the same data as a tuple function", "[data]") {
+	auto data_func = ParallelTupleFunction{ReadOnlyIntFunc{1}, IntDataFunc{2}, ReadOnlyIntFunc{3}, ThreadIdFunc{}};
+	STATIC_REQUIRE(decltype(data_func)::n_read_only == 3);
+	auto model = get_model();
+	data_func.before_reset(model);
+	auto const data = data_func.extract(model, false);
+	STATIC_REQUIRE(std::is_same_v<std::remove_const_t<decltype(data)>, std::tuple<int, int, int, std::thread::id>>);
+	REQUIRE(std::get<0>(data) == 2);
+	REQUIRE(std::get<1>(data) == 3);
+	REQUIRE(std::get<2>(data) == 4);
+	// The last read only function is extracted in the calling thread
+	REQUIRE(std::get<3>(data) == std::this_thread::get_id());
+}
+
+TEST_CASE("Parallel tuple function rethrows errors", "[data]") {
+	auto data_func = ParallelTupleFunction{ThrowingFunc{}, ReadOnlyIntFunc{}, ThreadIdFunc{}};
+	auto model = get_model();
+	data_func.before_reset(model);
+	REQUIRE_THROWS_AS(data_func.extract(model, false), std::runtime_error);
+}
+
+TEST_CASE("Parallel vector function unit tests", "[unit][data]") {
+	unit_tests(ParallelVectorFunction{std::vector{ReadOnlyIntFunc{}, ReadOnlyIntFunc{}}});
+}
+
+TEST_CASE("Parallel vector function extracts data in order", "[data]") {
+	auto const n_threads = GENERATE(std::size_t{1}, std::size_t{3});
+	auto functions = std::vector<ReadOnlyIntFunc>{};
+	for (int i = 0; i < 10; ++i) {
+		functions.emplace_back(i);
+	}
+	auto data_func = ParallelVectorFunction{functions, n_threads};
+	auto model = get_model();
+	data_func.before_reset(model);
+	auto const data = data_func.extract(model, false);
+	REQUIRE(data.size() == functions.size());
+	for (std::size_t i = 0; i < data.size(); ++i) {
+		REQUIRE(data[i] == static_cast<int>(i) + 1);
+	}
+}
+
+TEST_CASE("Parallel vector function rethrows errors", "[data]") {
+	auto data_func = ParallelVectorFunction{std::vector<ThrowingFunc>(4), 2};
+	auto model = get_model();
+	data_func.before_reset(model);
+	REQUIRE_THROWS_AS(data_func.extract(model, false), std::runtime_error);
+}
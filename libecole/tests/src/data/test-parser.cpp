@@ -1,4 +1,5 @@
 #include <map>
+#include <memory>
 #include <string>
 #include <tuple>
 #include <type_traits>
@@ -8,6 +9,7 @@
 
 #include "ecole/data/parser.hpp"
 #include "ecole/none.hpp"
+#include "ecole/utility/flat-map.hpp"
 
 #include "conftest.hpp"
 #include "data/mock-function.hpp"
@@ -32,8 +34,44 @@ TEST_CASE("Recursively parse data functions", "[data]") {
 	auto const aggregate_obs = aggregate_func.extract(model, false);
 
 	using AggregateObs = std::remove_const_t<decltype(aggregate_obs)>;
-	STATIC_REQUIRE(
-		std::is_same_v<AggregateObs, std::tuple<std::map<std::string, int>, std::vector<double>, ecole::NoneType>>);
+	using IntMap = ecole::utility::FlatMap<std::string, int>;
+	STATIC_REQUIRE(std::is_same_v<AggregateObs, std::tuple<IntMap, std::vector<double>, ecole::NoneType>>);
 	REQUIRE(std::get<0>(aggregate_obs).at("0") == 1);
 	REQUIRE(std::get<1>(aggregate_obs).at(0) == 1.0);
 }
+
+TEST_CASE("Profiled parser passes unit tests", "[unit][data]") {
+	ecole::data::unit_tests(parse_profiled(make_function_aggregate(), std::make_shared<ExtractProfile>()));
+}
+
+TEST_CASE("Profiled parser records timings without changing the data", "[data]") {
+	auto profile = std::make_shared<ExtractProfile>();
+	auto aggregate_func = parse_profiled(make_function_aggregate(), profile);
+	auto model = get_model();
+
+	aggregate_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const aggregate_obs = aggregate_func.extract(model, false);
+	aggregate_func.extract(model, false);
+
+	using AggregateObs = std::remove_const_t<decltype(aggregate_obs)>;
+	using IntMap = ecole::utility::FlatMap<std::string, int>;
+	STATIC_REQUIRE(std::is_same_v<AggregateObs, std::tuple<IntMap, std::vector<double>, ecole::NoneType>>);
+	REQUIRE(std::get<0>(aggregate_obs).at("0") == 1);
+	REQUIRE(std::get<1>(aggregate_obs).at(0) == 1.0);
+
+	for (auto const* path : {"", "/0", "/0/0", "/1", "/1/0", "/2"}) {
+		auto const& timings = profile->at(path);
+		REQUIRE(timings.n_calls() == 2);
+		REQUIRE(timings.thread_cpu_times.size() == 2);
+		REQUIRE(timings.total_wall_time().count() >= 0);
+	}
+	// Containers include the time of the functions they contain
+	REQUIRE(profile->at("").total_wall_time() >= profile->at("/0").total_wall_time());
+
+	SECTION("Timings are reset with the function") {
+		aggregate_func.before_reset(model);
+		REQUIRE(profile->at("").n_calls() == 0);
+		REQUIRE(profile->at("/1/0").n_calls() == 0);
+	}
+}
@@ -0,0 +1,38 @@
+#include <utility>
+
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+
+#include "ecole/data/pooled.hpp"
+#include "ecole/observation/pseudocosts.hpp"
+
+#include "conftest.hpp"
+#include "data/unit-tests.hpp"
+
+using namespace ecole;
+
+using PooledPseudocosts = data::PooledFunction<observation::Pseudocosts>;
+
+TEST_CASE("Data PooledFunction unit tests", "[unit][data]") {
+	data::unit_tests(PooledPseudocosts{});
+}
+
+TEST_CASE("Pooled data function reuse released data", "[data]") {
+	// Only candidates so that the observation has no NaN and can be compared
+	auto pooled_func = PooledPseudocosts{observation::Pseudocosts{true}, 1};
+	auto model = get_model();
+	pooled_func.before_reset(model);
+	REQUIRE_FALSE(pooled_func.extract(model, false).has_value());
+	REQUIRE(pooled_func.pool()->size() == 1);
+
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto data = pooled_func.extract(model, false).value();
+	REQUIRE(pooled_func.pool()->size() == 0);
+	REQUIRE(data == observation::Pseudocosts{true}.extract(model, false).value());
+
+	auto const* const memory = data.data();
+	pooled_func.release(std::move(data));
+	REQUIRE(pooled_func.pool()->size() == 1);
+	auto const data_reused = pooled_func.extract(model, false).value();
+	REQUIRE(data_reused.data() == memory);
+}
@@ -0,0 +1,93 @@
+#include <future>
+#include <stdexcept>
+#include <tuple>
+#include <type_traits>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/data/prefetched.hpp"
+#include "ecole/data/tuple.hpp"
+#include "ecole/traits.hpp"
+
+#include "conftest.hpp"
+#include "data/mock-function.hpp"
+
+using namespace ecole;
+
+namespace {
+
+/** Read only data function whose extraction waits for a signal. */
+struct GatedFunction {
+	static constexpr bool mutates_model = false;
+
+	std::shared_future<void> gate;
+	int value = 0;
+
+	auto before_reset(scip::Model& /*model*/) -> void {}
+	auto extract(scip::Model& /*model*/, bool /*done*/) const -> int {
+		gate.wait();
+		return value;
+	}
+};
+
+/** Read only data function failing to extract. */
+struct ThrowingFunction {
+	static constexpr bool mutates_model = false;
+
+	auto before_reset(scip::Model& /*model*/) -> void {}
+	auto extract(scip::Model& /*model*/, bool /*done*/) const -> int { throw std::runtime_error{"No data"}; }
+};
+
+}  // namespace
+
+TEST_CASE("Prefetched functions are data functions extracting in the background", "[data]") {
+	using Func = data::PrefetchedFunction<GatedFunction>;
+	STATIC_REQUIRE(trait::is_data_function_v<Func>);
+	STATIC_REQUIRE(trait::prefetches_v<Func>);
+	STATIC_REQUIRE_FALSE(trait::mutates_model_v<Func>);
+	STATIC_REQUIRE(trait::prefetches_v<data::TupleFunction<data::IntDataFunc, Func>>);
+	STATIC_REQUIRE_FALSE(trait::prefetches_v<data::TupleFunction<data::IntDataFunc>>);
+}
+
+TEST_CASE("Prefetched function returns before the data is extracted", "[data]") {
+	auto signal = std::promise<void>{};
+	auto data_func = data::PrefetchedFunction<GatedFunction>{GatedFunction{signal.get_future().share(), 3}};
+	auto model = get_model();
+	data_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const data = data_func.extract(model, false);
+	REQUIRE_FALSE(data.is_ready());
+	signal.set_value();
+	REQUIRE(data.get() == 3);
+	REQUIRE(data.is_ready());
+	data_func.join();
+}
+
+TEST_CASE("Prefetched function rethrows extraction errors on access", "[data]") {
+	auto data_func = data::PrefetchedFunction<ThrowingFunction>{};
+	auto model = get_model();
+	data_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const data = data_func.extract(model, false);
+	// Waiting does not throw, so that environments can transition
+	data_func.join();
+	REQUIRE_THROWS_AS(data.get(), std::runtime_error);
+}
+
+TEST_CASE("Tuple function starts prefetched functions last", "[data]") {
+	auto signal = std::promise<void>{};
+	auto data_func = data::TupleFunction{
+		data::PrefetchedFunction<GatedFunction>{GatedFunction{signal.get_future().share(), 2}}, data::IntDataFunc{0}};
+	auto model = get_model();
+	data_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const [prefetched, value] = data_func.extract(model, false);
+	REQUIRE(value == 1);
+	REQUIRE_FALSE(prefetched.is_ready());
+	signal.set_value();
+	data_func.join();
+	REQUIRE(prefetched.get() == 2);
+}
@@ -1,3 +1,5 @@
+#include <stdexcept>
+
 #include <catch2/catch.hpp>
 
 #include "ecole/data/timed.hpp"
@@ -14,8 +16,8 @@ TEST_CASE("Data TimedFunction unit tests", "[unit][data]") {
 }
 
 TEST_CASE("Timed data function is positive", "[data]") {
-	bool const wall = GENERATE(true, false);
-	auto timed_func = data::TimedFunction<data::IntDataFunc>{wall};
+	auto const [wall, thread_cpu] = GENERATE(table<bool, bool>({{false, false}, {true, false}, {false, true}}));
+	auto timed_func = data::TimedFunction<data::IntDataFunc>{wall, thread_cpu};
 	auto model = get_model();
 
 	timed_func.before_reset(model);
@@ -23,3 +25,7 @@ TEST_CASE("Timed data function is positive", "[data]") {
 	auto const time = timed_func.extract(model, false);
 	REQUIRE(time >= 0.);
 }
+
+TEST_CASE("Timed data function cannot use both the wall and thread CPU time", "[data]") {
+	REQUIRE_THROWS_AS((data::TimedFunction<data::IntDataFunc>{true, true}), std::invalid_argument);
+}
@@ -0,0 +1,276 @@
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+
+#include "ecole/data/trajectory.hpp"
+#include "ecole/observation/node-bipartite.hpp"
+#include "ecole/random.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "conftest.hpp"
+#include "test-utility/tmp-folder.hpp"
+#include "utility/decompress.hpp"
+
+using namespace ecole;
+
+namespace {
+
+auto make_steps(bool csr_edges) -> std::vector<data::TrajectoryStep> {
+	auto obs_func = observation::NodeBipartite{false, false, csr_edges};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto steps = std::vector<data::TrajectoryStep>{};
+	for (std::size_t i = 0; i < 3; ++i) {
+		auto const cands = model.lp_branch_cands();
+		auto action_set = xt::xtensor<std::size_t, 1>::from_shape({cands.size()});
+		for (std::size_t j = 0; j < cands.size(); ++j) {
+			action_set[j] = static_cast<std::size_t>(SCIPvarGetProbindex(cands[j]));
+		}
+		auto const action = action_set.size() > 0 ? action_set[0] : 0;
+		steps.push_back({obs_func.extract(model, false).value(), std::move(action_set), action, -static_cast<double>(i)});
+	}
+	return steps;
+}
+
+void require_equal(data::TrajectoryStep const& actual, data::TrajectoryStep const& expected) {
+	REQUIRE(actual.observation.variable_features == expected.observation.variable_features);
+	REQUIRE(actual.observation.row_features == expected.observation.row_features);
+	REQUIRE(actual.observation.edge_features == expected.observation.edge_features);
+	REQUIRE(actual.observation.edge_features_csr == expected.observation.edge_features_csr);
+	REQUIRE(actual.action_set == expected.action_set);
+	REQUIRE(actual.action == expected.action);
+	REQUIRE(actual.reward == expected.reward);
+}
+
+void require_equal(data::TrajectorySample const& actual, data::TrajectoryStep const& expected) {
+	auto const& obs = actual.observation;
+	auto const& expected_obs = expected.observation;
+	REQUIRE(obs.variable_features.adapt() == expected_obs.variable_features);
+	REQUIRE(obs.row_features.adapt() == expected_obs.row_features);
+	REQUIRE(obs.edge_features.values.adapt() == expected_obs.edge_features.values);
+	REQUIRE(obs.edge_features.indices.adapt() == expected_obs.edge_features.indices);
+	REQUIRE(obs.edge_features.shape == expected_obs.edge_features.shape);
+	REQUIRE(obs.edge_features_csr.values.adapt() == expected_obs.edge_features_csr.values);
+	REQUIRE(obs.edge_features_csr.column_indices.adapt() == expected_obs.edge_features_csr.column_indices);
+	REQUIRE(obs.edge_features_csr.row_pointers.adapt() == expected_obs.edge_features_csr.row_pointers);
+	REQUIRE(obs.edge_features_csr.shape == expected_obs.edge_features_csr.shape);
+	REQUIRE(actual.action_set.adapt() == expected.action_set);
+	REQUIRE(actual.action == expected.action);
+	REQUIRE(actual.reward == expected.reward);
+}
+
+auto write_steps(std::filesystem::path const& filename, std::vector<data::TrajectoryStep> const& steps) {
+	auto writer = data::TrajectoryWriter{filename, false, 64, false};
+	for (auto const& step : steps) {
+		writer.write(step);
+	}
+	return filename;
+}
+
+}  // namespace
+
+TEST_CASE("Trajectory steps read back equal to the steps written", "[data]") {
+	auto const compress = GENERATE(true, false);
+	auto const delta_integers = GENERATE(true, false);
+	auto const csr_edges = GENERATE(true, false);
+	auto const chunk_size = GENERATE(std::size_t{1}, std::size_t{2}, std::size_t{64});
+	auto const steps = make_steps(csr_edges);
+	auto const tmp = TmpFolderRAII{};
+	auto const filename = tmp.make_subpath(".trj");
+
+	{
+		auto writer = data::TrajectoryWriter{
+			filename, compress, chunk_size, true, data::TrajectoryCompression::zero_runs, delta_integers};
+		for (auto const& step : steps) {
+			writer.write(step);
+		}
+		REQUIRE(writer.size() == steps.size());
+	}
+
+	auto const reader = data::TrajectoryReader{filename};
+	REQUIRE(reader.size() == steps.size());
+	// Random access in reverse order
+	for (auto i = steps.size(); i-- > 0;) {
+		require_equal(reader.read(i), steps[i]);
+	}
+	REQUIRE_THROWS_AS(reader.read(steps.size()), std::out_of_range);
+}
+
+TEST_CASE("Compressed trajectories are smaller", "[data]") {
+	auto const steps = make_steps(false);
+	auto const tmp = TmpFolderRAII{};
+	auto write = [&](bool compress) {
+		auto const filename = tmp.make_subpath(".trj");
+		auto writer = data::TrajectoryWriter{filename, compress};
+		for (auto const& step : steps) {
+			writer.write(step);
+		}
+		writer.close();
+		return std::filesystem::file_size(filename);
+	};
+	REQUIRE(write(true) < write(false));
+}
+
+TEST_CASE("Trajectories compressed with zstd read back equal to the steps written", "[data]") {
+	auto const delta_integers = GENERATE(true, false);
+	auto const steps = make_steps(true);
+	auto const tmp = TmpFolderRAII{};
+	auto const filename = tmp.make_subpath(".trj");
+	auto const zstd = data::TrajectoryCompression::zstd;
+	if (!utility::can_decompress(utility::Compression::zstd)) {
+		REQUIRE_THROWS_AS((data::TrajectoryWriter{filename, true, 64, true, zstd}), std::runtime_error);
+		return;
+	}
+
+	{
+		auto writer = data::TrajectoryWriter{filename, true, 64, true, zstd, delta_integers};
+		for (auto const& step : steps) {
+			writer.write(step);
+		}
+	}
+	auto const reader = data::TrajectoryReader{filename};
+	for (std::size_t i = 0; i < steps.size(); ++i) {
+		require_equal(reader.read(i), steps[i]);
+		require_equal(reader.view(i), steps[i]);
+	}
+}
+
+TEST_CASE("Trajectories with integers stored as differences are smaller", "[data]") {
+	auto const steps = make_steps(true);
+	auto const tmp = TmpFolderRAII{};
+	auto write = [&](bool delta_integers) {
+		auto const filename = tmp.make_subpath(".trj");
+		auto writer = data::TrajectoryWriter{
+			filename, false, 64, true, data::TrajectoryCompression::zero_runs, delta_integers};
+		for (auto const& step : steps) {
+			writer.write(step);
+		}
+		writer.close();
+		return std::filesystem::file_size(filename);
+	};
+	REQUIRE(write(true) < write(false));
+}
+
+TEST_CASE("Trajectory steps are recovered from writers that were not closed", "[data]") {
+	auto const steps = make_steps(false);
+	auto const tmp = TmpFolderRAII{};
+	auto const filename = tmp.make_subpath(".trj");
+	{
+		auto writer = data::TrajectoryWriter{filename};
+		for (auto const& step : steps) {
+			writer.write(step);
+		}
+	}
+	// Remove the index, made of the number of steps, their offsets, the offset of the index, and a magic string
+	auto const index_size = (steps.size() + 2) * sizeof(std::uint64_t) + 8;
+	std::filesystem::resize_file(filename, std::filesystem::file_size(filename) - index_size);
+
+	auto const reader = data::TrajectoryReader{filename};
+	REQUIRE(reader.size() == steps.size());
+	require_equal(reader.read(steps.size() - 1), steps.back());
+}
+
+TEST_CASE("Throw on invalid trajectory files", "[data]") {
+	auto const tmp = TmpFolderRAII{};
+	REQUIRE_THROWS_AS(data::TrajectoryReader{tmp.make_subpath(".trj")}, std::runtime_error);
+
+	auto const not_trajectory = tmp.make_subpath(".trj");
+	std::ofstream{not_trajectory} << "Not a trajectory file at all";
+	REQUIRE_THROWS_AS(data::TrajectoryReader{not_trajectory}, std::runtime_error);
+
+	auto const float32_trajectory = tmp.make_subpath(".trj");
+	data::TrajectoryWriterFloat32{float32_trajectory}.close();
+	REQUIRE_THROWS_AS(data::TrajectoryReader{float32_trajectory}, std::runtime_error);
+	REQUIRE(data::TrajectoryReaderFloat32{float32_trajectory}.size() == 0);
+}
+
+TEST_CASE("Trajectory steps viewed equal to the steps written", "[data]") {
+	auto const compress = GENERATE(true, false);
+	auto const narrow_integers = GENERATE(true, false);
+	auto const delta_integers = GENERATE(true, false);
+	auto const steps = make_steps(true);
+	auto const tmp = TmpFolderRAII{};
+	auto const filename = tmp.make_subpath(".trj");
+	{
+		auto writer = data::TrajectoryWriter{
+			filename, compress, 2, narrow_integers, data::TrajectoryCompression::zero_runs, delta_integers};
+		for (auto const& step : steps) {
+			writer.write(step);
+		}
+	}
+
+	auto samples = std::vector<data::TrajectorySample>{};
+	{
+		auto const reader = data::TrajectoryReader{filename};
+		for (std::size_t i = 0; i < reader.size(); ++i) {
+			samples.push_back(reader.view(i));
+		}
+		REQUIRE_THROWS_AS(reader.view(steps.size()), std::out_of_range);
+	}
+	// Samples keep the file mapped after the reader is destroyed
+	for (std::size_t i = 0; i < steps.size(); ++i) {
+		require_equal(samples[i], steps[i]);
+	}
+}
+
+TEST_CASE("Trajectory datasets index the steps of all files", "[data]") {
+	auto const steps = make_steps(false);
+	auto const tmp = TmpFolderRAII{};
+	auto const empty = tmp.make_subpath(".trj");
+	data::TrajectoryWriter{empty}.close();
+	auto const dataset = data::TrajectoryDataset{{
+		write_steps(tmp.make_subpath(".trj"), steps),
+		empty,
+		write_steps(tmp.make_subpath(".trj"), steps),
+	}};
+
+	REQUIRE(dataset.size() == 2 * steps.size());
+	for (std::size_t i = 0; i < dataset.size(); ++i) {
+		require_equal(dataset.view(i), steps[i % steps.size()]);
+	}
+	require_equal(dataset.read(steps.size()), steps.front());
+	REQUIRE_THROWS_AS(dataset.view(dataset.size()), std::out_of_range);
+}
+
+TEST_CASE("Shuffled trajectory iterators return every step once", "[data]") {
+	auto const n_prefetch = GENERATE(std::size_t{1}, std::size_t{16});
+	auto const steps = make_steps(false);
+	auto const tmp = TmpFolderRAII{};
+	auto const dataset = data::TrajectoryDataset{{
+		write_steps(tmp.make_subpath(".trj"), steps),
+		write_steps(tmp.make_subpath(".trj"), steps),
+	}};
+	auto rng = RandomGenerator{0};
+	auto iter = data::ShuffledTrajectoryIterator{dataset, rng, n_prefetch};
+
+	auto order = iter.order();
+	REQUIRE(order.size() == dataset.size());
+	for (auto const index : order) {
+		auto const sample = iter.next();
+		REQUIRE(sample.has_value());
+		require_equal(sample.value(), steps[index % steps.size()]);
+	}
+	REQUIRE_FALSE(iter.next().has_value());
+	std::sort(order.begin(), order.end());
+	for (std::size_t i = 0; i < order.size(); ++i) {
+		REQUIRE(order[i] == i);
+	}
+}
+
+TEST_CASE("Shuffled trajectory iterators can be destroyed before the end", "[data]") {
+	auto const tmp = TmpFolderRAII{};
+	auto const dataset = data::TrajectoryDataset{{write_steps(tmp.make_subpath(".trj"), make_steps(false))}};
+	auto rng = RandomGenerator{0};
+	auto iter = data::ShuffledTrajectoryIterator{dataset, rng, 1};
+	REQUIRE(iter.next().has_value());
+}
@@ -1,8 +1,12 @@
+#include <cstddef>
+#include <optional>
 #include <type_traits>
 
 #include <catch2/catch.hpp>
 
 #include "ecole/data/tuple.hpp"
+#include "ecole/scip/lp-view.hpp"
+#include "ecole/scip/model.hpp"
 
 #include "conftest.hpp"
 #include "data/mock-function.hpp"
@@ -10,6 +14,28 @@
 
 using namespace ecole::data;
 
+namespace {
+
+/** Data function counting the columns and rows it visits, and extracting nothing otherwise. */
+struct LpCountingFunction {
+	static constexpr bool visits_lp = true;
+
+	struct Visitor {
+		std::size_t n_columns = 0;
+		std::size_t n_rows = 0;
+
+		void visit_column(ecole::scip::LpView const& /*lp*/, std::size_t /*col_idx*/) { ++n_columns; }
+		void visit_row(ecole::scip::LpView const& /*lp*/, std::size_t /*row_idx*/) { ++n_rows; }
+		[[nodiscard]] auto finish() const -> std::optional<std::size_t> { return n_columns + n_rows; }
+	};
+
+	auto before_reset(ecole::scip::Model& /*model*/) -> void {}
+	auto extract(ecole::scip::Model& /*model*/, bool /*done*/) -> std::optional<std::size_t> { return {}; }
+	[[nodiscard]] auto lp_visitor(ecole::scip::Model& /*model*/, bool /*done*/) const -> Visitor { return {}; }
+};
+
+}  // namespace
+
 TEST_CASE("Data TupleFunction unit tests", "[unit][data]") {
 	ecole::data::unit_tests(TupleFunction{IntDataFunc{}, DoubleDataFunc{}});
 }
@@ -25,3 +51,25 @@ TEST_CASE("Combine data functions into a tuple", "[data]") {
 	REQUIRE(std::get<0>(data) == 1);
 	REQUIRE(std::get<1>(data) == 2.0);  // NOLINT(readability-magic-numbers)
 }
+
+TEST_CASE("Functions visiting the LP share a single traversal", "[data]") {
+	auto data_func = TupleFunction{LpCountingFunction{}, IntDataFunc{0}, LpCountingFunction{}};
+	STATIC_REQUIRE(decltype(data_func)::uses_lp_view);
+	auto model = get_model();
+	data_func.before_reset(model);
+
+	SECTION("Functions extract data outside of the solving stage") {
+		auto const [first, _, second] = data_func.extract(model, false);
+		REQUIRE_FALSE(first.has_value());
+		REQUIRE_FALSE(second.has_value());
+	}
+
+	SECTION("Functions visit all columns and rows of the LP") {
+		advance_to_stage(model, SCIP_STAGE_SOLVING);
+		auto const lp = model.lp_view();
+		auto const [first, value, second] = data_func.extract(model, false);
+		REQUIRE(first == lp->n_columns() + lp->n_rows());
+		REQUIRE(second == first);
+		REQUIRE(value == 1);
+	}
+}
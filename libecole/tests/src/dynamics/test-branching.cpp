@@ -1,12 +1,21 @@
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
 #include <stdexcept>
+#include <thread>
 #include <tuple>
+#include <utility>
+#include <vector>
 
 #include <catch2/catch.hpp>
+#include <xtensor/xbuilder.hpp>
 #include <xtensor/xmath.hpp>
 #include <xtensor/xsort.hpp>
 
 #include "ecole/dynamics/branching.hpp"
 #include "ecole/exception.hpp"
+#include "ecole/random.hpp"
 
 #include "conftest.hpp"
 #include "dynamics/unit-tests.hpp"
@@ -63,6 +72,98 @@ TEST_CASE("BranchingDynamics functional tests", "[dynamics]") {
 		}
 		REQUIRE(model.is_solved());
 	}
+
+	SECTION("Action set views match the action set") {
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		for (auto i = 0; (i < 10) && !done; ++i) {
+			auto const view = dyn.action_set_view(model);
+			auto const view_32 = dyn.action_set_view_32(model);
+			REQUIRE(view.has_value());
+			REQUIRE(view_32.has_value());
+			REQUIRE(std::equal(view->begin(), view->end(), action_set->begin(), action_set->end()));
+			REQUIRE(std::equal(view_32->begin(), view_32->end(), action_set->begin(), action_set->end()));
+			std::tie(done, action_set) = dyn.step_dynamics(model, action_set.value()[0]);
+		}
+	}
+
+	SECTION("Action masks match the action set") {
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		auto const n_vars = model.variables().size();
+		for (auto i = 0; (i < 10) && !done; ++i) {
+			auto const mask = dyn.action_mask_view(model);
+			auto const packed = dyn.action_mask_view(model, true);
+			REQUIRE(mask.has_value());
+			REQUIRE(packed.has_value());
+			REQUIRE(mask->size() == n_vars);
+			REQUIRE(packed->size() == (n_vars + 7) / 8);
+			auto n_masked = std::size_t{0};
+			for (std::size_t var = 0; var < n_vars; ++var) {
+				auto const is_candidate = std::find(action_set->begin(), action_set->end(), var) != action_set->end();
+				REQUIRE((*mask)[var] == (is_candidate ? 1 : 0));
+				REQUIRE((((*packed)[var / 8] >> (var % 8)) & 1U) == (is_candidate ? 1U : 0U));
+				n_masked += (*mask)[var];
+			}
+			REQUIRE(n_masked == action_set->size());
+			std::tie(done, action_set) = dyn.step_dynamics(model, action_set.value()[0]);
+		}
+	}
+
+	SECTION("Action set views reuse their buffer") {
+		dyn.reset_dynamics(model);
+		auto const* const data = dyn.action_set_view(model)->data();
+		REQUIRE(dyn.action_set_view(model)->data() == data);
+	}
+}
+
+TEST_CASE("BranchingDynamics branches on several nodes per step", "[dynamics]") {
+	bool const pseudo_candidates = GENERATE(true, false);
+	auto dyn = dynamics::BranchingDynamics{pseudo_candidates};
+	auto model = get_model();
+	auto const first_candidate = [](scip::Model& /*model*/, dynamics::BranchingDynamics::ActionSet const& action_set) {
+		return dynamics::BranchingDynamics::Action{action_set.value()[0]};
+	};
+
+	SECTION("Solve instance with fewer steps") {
+		auto constexpr n_nodes = 5;
+		auto n_policy_calls = std::size_t{0};
+		auto const counting_policy = [&](scip::Model& m, dynamics::BranchingDynamics::ActionSet const& action_set) {
+			++n_policy_calls;
+			return first_candidate(m, action_set);
+		};
+		auto n_steps = std::size_t{0};
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		while (!done) {
+			REQUIRE(action_set.has_value());
+			std::tie(done, action_set) = dyn.step_dynamics(model, action_set.value()[0], n_nodes, counting_policy);
+			++n_steps;
+		}
+		REQUIRE(model.is_solved());
+		REQUIRE(n_policy_calls <= (n_nodes - 1) * n_steps);
+		REQUIRE(n_policy_calls >= (n_nodes - 1) * (n_steps - 1));
+	}
+
+	SECTION("Branch with scores") {
+		auto const scores = xt::xtensor<double, 1>(xt::arange<double>(static_cast<double>(model.variables().size())));
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		while (!done) {
+			std::tie(done, action_set) =
+				dyn.step_dynamics(model, Default, 3, dynamics::BranchingDynamics::score_policy(scores));
+		}
+		REQUIRE(model.is_solved());
+	}
+
+	SECTION("Forward policy exceptions") {
+		auto const throwing_policy = [](scip::Model& /*model*/, auto const& /*action_set*/)
+			-> dynamics::BranchingDynamics::Action { throw std::runtime_error{"policy error"}; };
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		REQUIRE_FALSE(done);
+		REQUIRE_THROWS_AS(dyn.step_dynamics(model, action_set.value()[0], 2, throwing_policy), std::runtime_error);
+	}
+
+	SECTION("Require a policy for several nodes") {
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		REQUIRE_THROWS_AS(dyn.step_dynamics(model, Default, 2, nullptr), std::invalid_argument);
+	}
 }
 
 TEST_CASE("BranchingDynamics handles limits", "[dynamics]") {
@@ -86,3 +187,216 @@ TEST_CASE("BranchingDynamics handles limits", "[dynamics]") {
 		std::tie(done, action_set) = dyn.step_dynamics(model, action_set.value()[0]);
 	}
 }
+
+namespace {
+
+/** Count the number of times control is given back until the instance is solved. */
+auto count_steps(dynamics::BranchingDynamics& dyn, scip::Model& model) -> std::size_t {
+	auto rng = RandomGenerator{0};  // NOLINT(cert-msc32-c, cert-msc51-cpp) reproducible schedule
+	dyn.set_dynamics_random_state(model, rng);
+	auto [done, action_set] = dyn.reset_dynamics(model);
+	auto n_steps = std::size_t{0};
+	while (!done) {
+		++n_steps;
+		std::tie(done, action_set) = dyn.step_dynamics(model, Default);
+	}
+	REQUIRE(model.is_solved());
+	return n_steps;
+}
+
+}  // namespace
+
+TEST_CASE("BranchingDynamics only gives control on scheduled nodes", "[dynamics][slow]") {
+	auto model = get_model();
+	auto dyn = dynamics::BranchingDynamics{};
+	auto const n_all_steps = count_steps(dyn, model);
+
+	SECTION("Every k-th node") {
+		auto model_every = get_model();
+		auto dyn_every = dynamics::BranchingDynamics{false, dynamics::ObservationSchedule::every(3)};
+		auto const n_steps = count_steps(dyn_every, model_every);
+		REQUIRE(n_steps <= n_all_steps);
+		REQUIRE(n_steps >= 1);
+	}
+
+	SECTION("Probabilistic nodes") {
+		auto model_never = get_model();
+		auto dyn_never = dynamics::BranchingDynamics{false, dynamics::ObservationSchedule::probability(0.)};
+		REQUIRE(count_steps(dyn_never, model_never) == 0);
+	}
+
+	SECTION("Shallow nodes") {
+		auto model_root = get_model();
+		auto dyn_root = dynamics::BranchingDynamics{false, dynamics::ObservationSchedule::max_depth(0)};
+		REQUIRE(count_steps(dyn_root, model_root) <= 1);
+	}
+}
+
+TEST_CASE("Copies of BranchingDynamics can be used concurrently", "[dynamics][slow]") {
+	auto constexpr n_copies = std::size_t{4};
+	auto const dyn = dynamics::BranchingDynamics{false, dynamics::ObservationSchedule::every(2)};
+	// The number of steps, and the number of candidates in the action masks of all steps
+	auto const run_episode = [](dynamics::BranchingDynamics& copy) {
+		auto model = get_model();
+		auto rng = RandomGenerator{0};  // NOLINT(cert-msc32-c, cert-msc51-cpp) reproducible schedule
+		copy.set_dynamics_random_state(model, rng);
+		auto [done, action_set] = copy.reset_dynamics(model);
+		auto n_steps = std::size_t{0};
+		auto n_masked = std::size_t{0};
+		for (; !done; ++n_steps) {
+			auto const mask = copy.action_mask_view(model).value();
+			n_masked += static_cast<std::size_t>(std::count(mask.begin(), mask.end(), std::uint8_t{1}));
+			std::tie(done, action_set) = copy.step_dynamics(model, action_set.value()[0]);
+		}
+		return std::pair{n_steps, n_masked};
+	};
+
+	auto sequential_copy = dyn;
+	auto const expected = run_episode(sequential_copy);
+	auto copies = std::vector<dynamics::BranchingDynamics>(n_copies, dyn);
+	auto results = std::vector<std::pair<std::size_t, std::size_t>>(n_copies);
+	auto threads = std::vector<std::thread>{};
+	for (std::size_t i = 0; i < n_copies; ++i) {
+		threads.emplace_back([&, i] { results[i] = run_episode(copies[i]); });
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	for (auto const& result : results) {
+		REQUIRE(result == expected);
+	}
+}
+
+TEST_CASE("BranchingDynamics explore nodes not scheduled with a policy", "[dynamics][slow]") {
+	using Dynamics = dynamics::BranchingDynamics;
+	auto const never = dynamics::ObservationSchedule::probability(0.);
+	auto model = get_model();
+
+	SECTION("Explore with pseudocosts") {
+		auto dyn = Dynamics{false, never, 0, false, std::chrono::milliseconds::zero(), Dynamics::pseudocost_policy()};
+		REQUIRE(count_steps(dyn, model) == 0);
+	}
+
+	SECTION("Explore with a custom policy") {
+		auto n_calls = std::size_t{0};
+		auto const first_candidate = [&n_calls](scip::Model& /*model*/, Dynamics::ActionSet const& action_set) {
+			++n_calls;
+			return Dynamics::Action{action_set.value()[0]};
+		};
+		auto dyn = Dynamics{false, never, 0, false, std::chrono::milliseconds::zero(), first_candidate};
+		REQUIRE(count_steps(dyn, model) == 0);
+		REQUIRE(n_calls > 0);
+	}
+
+	SECTION("Forward explore policy exceptions") {
+		auto const throwing_policy = [](scip::Model& /*model*/, auto const& /*action_set*/) -> Dynamics::Action {
+			throw std::runtime_error{"policy error"};
+		};
+		auto dyn = Dynamics{false, never, 0, false, std::chrono::milliseconds::zero(), throwing_policy};
+		REQUIRE_THROWS_AS(dyn.reset_dynamics(model), std::runtime_error);
+	}
+}
+
+TEST_CASE("ObservationSchedule validates its parameters", "[dynamics]") {
+	REQUIRE_THROWS_AS(dynamics::ObservationSchedule::every(0), std::invalid_argument);
+	REQUIRE_THROWS_AS(dynamics::ObservationSchedule::probability(1.5), std::invalid_argument);
+	REQUIRE(dynamics::ObservationSchedule{}.selects_all());
+	REQUIRE(!dynamics::ObservationSchedule::every(2).selects_all());
+}
+
+TEST_CASE("BranchingDynamics only draw from the random generator for random schedules", "[dynamics]") {
+	auto model = get_model();
+	auto rng = RandomGenerator{0};  // NOLINT(cert-msc32-c, cert-msc51-cpp) reproducible seeds
+	auto expected_rng = RandomGenerator{0};
+	dynamics::BranchingDynamics{}.set_dynamics_random_state(model, rng);
+	dynamics::DefaultSetDynamicsRandomState{}.set_dynamics_random_state(model, expected_rng);
+	REQUIRE(rng == expected_rng);
+
+	dynamics::BranchingDynamics{false, dynamics::ObservationSchedule::probability(0.5)}.set_dynamics_random_state(
+		model, rng);
+	dynamics::DefaultSetDynamicsRandomState{}.set_dynamics_random_state(model, expected_rng);
+	REQUIRE(rng != expected_rng);
+}
+
+TEST_CASE("BranchingDynamics caches presolved problems", "[dynamics]") {
+	auto dyn = dynamics::BranchingDynamics{false, {}, 1};
+	auto rng = RandomGenerator{0};
+	auto model = get_model();
+	dyn.set_dynamics_random_state(model, rng);
+	REQUIRE(dyn.n_presolved_cached() == 1);
+
+	SECTION("Start from the presolved problem") {
+		REQUIRE(model.stage() == SCIP_STAGE_PROBLEM);
+		REQUIRE(model.get_param<int>("presolving/maxrounds") == 0);
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		while (!done) {
+			std::tie(done, action_set) = dyn.step_dynamics(model, action_set.value()[0]);
+		}
+		REQUIRE(model.is_solved());
+	}
+
+	SECTION("Reuse the presolved problem on the same instance") {
+		auto other_model = get_model();
+		dyn.set_dynamics_random_state(other_model, rng);
+		REQUIRE(dyn.n_presolved_cached() == 1);
+		REQUIRE(other_model.variables().size() == model.variables().size());
+	}
+
+	SECTION("Evict older problems when parameters change") {
+		auto other_model = get_model();
+		other_model.set_param("presolving/maxrounds", 1);
+		dyn.set_dynamics_random_state(other_model, rng);
+		REQUIRE(dyn.n_presolved_cached() == 1);
+	}
+
+	SECTION("Disabled by default") {
+		auto default_dyn = dynamics::BranchingDynamics{};
+		auto other_model = get_model();
+		default_dyn.set_dynamics_random_state(other_model, rng);
+		REQUIRE(default_dyn.n_presolved_cached() == 0);
+	}
+}
+
+TEST_CASE("BranchingDynamics caches root cuts", "[dynamics]") {
+	REQUIRE_THROWS_AS((dynamics::BranchingDynamics{false, {}, 0, true}), std::invalid_argument);
+
+	auto dyn = dynamics::BranchingDynamics{false, {}, 1, true};
+	auto rng = RandomGenerator{0};
+	auto model = get_model();
+	dyn.set_dynamics_random_state(model, rng);
+	auto presolved_only = get_model();
+	dynamics::BranchingDynamics{false, {}, 1}.set_dynamics_random_state(presolved_only, rng);
+	REQUIRE(model.constraints().size() >= presolved_only.constraints().size());
+
+	auto [done, action_set] = dyn.reset_dynamics(model);
+	while (!done) {
+		std::tie(done, action_set) = dyn.step_dynamics(model, action_set.value()[0]);
+	}
+	REQUIRE(model.is_solved());
+}
+
+TEST_CASE("BranchingDynamics fall back to SCIP branching after the step deadline", "[dynamics]") {
+	using namespace std::chrono_literals;
+	REQUIRE_THROWS_AS((dynamics::BranchingDynamics{false, {}, 0, false, -1ms}), std::invalid_argument);
+
+	auto const deadline = GENERATE(as<std::chrono::milliseconds>{}, 1ms, 1h);
+	auto dyn = dynamics::BranchingDynamics{false, {}, 0, false, deadline};
+	auto model = get_model();
+	auto [done, action_set] = dyn.reset_dynamics(model);
+	auto n_steps = std::size_t{0};
+	for (; !done && n_steps < 5; ++n_steps) {
+		dyn.start_step_deadline(model);
+		std::this_thread::sleep_for(20ms);
+		std::tie(done, action_set) = dyn.step_dynamics(model, action_set.value()[0]);
+	}
+	auto const n_missed = model.callback_statistics().n_missed_deadlines;
+	if (deadline == 1h) {
+		REQUIRE(n_missed == 0);
+	} else {
+		REQUIRE(n_missed == n_steps);
+	}
+	while (!done) {
+		std::tie(done, action_set) = dyn.step_dynamics(model, action_set.value()[0]);
+	}
+	REQUIRE(model.is_solved());
+}
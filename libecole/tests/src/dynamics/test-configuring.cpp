@@ -1,9 +1,12 @@
+#include <stdexcept>
 #include <string>
 #include <tuple>
 
 #include <catch2/catch.hpp>
+#include <scip/scip.h>
 
 #include "ecole/dynamics/configuring.hpp"
+#include "ecole/scip/model.hpp"
 
 #include "conftest.hpp"
 #include "dynamics/unit-tests.hpp"
@@ -51,3 +54,62 @@ TEST_CASE("ConfiguringDynamics functional tests", "[dynamics]") {
 		}
 	}
 }
+
+TEST_CASE("ConfiguringDynamics solve with multiple threads", "[dynamics]") {
+	REQUIRE_THROWS_AS(dynamics::ConfiguringDynamics{0}, std::invalid_argument);
+
+	auto dyn = dynamics::ConfiguringDynamics{2};
+	auto model = get_model();
+	dyn.reset_dynamics(model);
+	auto const [done, action_set] = dyn.step_dynamics(model, {});
+	REQUIRE(done);
+	REQUIRE(model.is_solved());
+	REQUIRE(model.get_param<int>("parallel/maxnthreads") == 2);
+}
+
+TEST_CASE("Parameters are classified by the solve phase they affect", "[dynamics]") {
+	using dynamics::SolvePhase;
+	REQUIRE(dynamics::param_phase("branching/scorefunc") == SolvePhase::solving);
+	REQUIRE(dynamics::param_phase("nodeselection/childsel") == SolvePhase::solving);
+	REQUIRE(dynamics::param_phase("heuristics/rins/freq") == SolvePhase::presolving);
+	REQUIRE(dynamics::param_phase("constraints/linear/sepafreq") == SolvePhase::solving);
+	REQUIRE(dynamics::param_phase("presolving/maxrounds") == SolvePhase::presolving);
+	REQUIRE(dynamics::param_phase("propagating/probing/maxprerounds") == SolvePhase::presolving);
+	REQUIRE(dynamics::param_phase("constraints/linear/aggregatevariables") == SolvePhase::presolving);
+	REQUIRE(dynamics::param_phase("lp/presolving") == SolvePhase::presolving);
+	REQUIRE(dynamics::param_phase("numerics/feastol") == SolvePhase::presolving);
+}
+
+TEST_CASE("ConfiguringDynamics reuse the presolved problem", "[dynamics][slow]") {
+	auto dyn = dynamics::ConfiguringDynamics{1, true};
+	REQUIRE(dyn.reuse_presolve());
+	// Unlike get_model, presolving is kept enabled
+	auto const make_model = [] {
+		auto model = scip::Model::from_file(problem_file);
+		model.disable_cuts();
+		return model;
+	};
+
+	auto first = make_model();
+	dyn.reset_dynamics(first);
+	dyn.step_dynamics(first, {{"branching/scorefunc", 's'}});
+	REQUIRE(first.is_solved());
+	REQUIRE(first.get_param<int>("presolving/maxrounds") != 0);
+
+	SECTION("Configurations of solving parameters start from the presolved problem") {
+		auto model = make_model();
+		dyn.reset_dynamics(model);
+		dyn.step_dynamics(model, {{"branching/scorefunc", 'p'}});
+		REQUIRE(model.is_solved());
+		REQUIRE(model.get_param<int>("presolving/maxrounds") == 0);
+		REQUIRE(SCIPgetPrimalbound(model.get_scip_ptr()) == Approx(SCIPgetPrimalbound(first.get_scip_ptr())));
+	}
+
+	SECTION("Configurations of presolving parameters presolve again") {
+		auto model = make_model();
+		dyn.reset_dynamics(model);
+		dyn.step_dynamics(model, {{"presolving/maxrounds", 1}});
+		REQUIRE(model.is_solved());
+		REQUIRE(model.get_param<int>("presolving/maxrounds") == 1);
+	}
+}
@@ -0,0 +1,74 @@
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <xtensor/xview.hpp>
+
+#include "ecole/dynamics/cut-selection.hpp"
+
+#include "conftest.hpp"
+#include "dynamics/unit-tests.hpp"
+
+using namespace ecole;
+
+namespace {
+
+using Column = dynamics::CutSelectionDynamics::Column;
+
+auto column(dynamics::CutSelectionDynamics::ActionSet const& action_set, Column col) {
+	return xt::view(action_set.value(), xt::all(), static_cast<std::size_t>(col));
+}
+
+}  // namespace
+
+TEST_CASE("CutSelectionDynamics unit tests", "[unit][dynamics]") {
+	auto const policy = [](auto const& /*action_set*/, auto const& /*model*/) -> dynamics::CutSelectionDynamics::Action {
+		return std::vector<std::size_t>{0};
+	};
+	dynamics::unit_tests(dynamics::CutSelectionDynamics{}, policy);
+}
+
+TEST_CASE("CutSelectionDynamics functional tests", "[dynamics]") {
+	auto dyn = dynamics::CutSelectionDynamics{};
+	auto model = get_model();
+
+	SECTION("Return valid cut features") {
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		REQUIRE_FALSE(done);
+		REQUIRE(action_set.has_value());
+		REQUIRE(action_set->shape(0) > 0);
+		REQUIRE(action_set->shape(1) == dynamics::CutSelectionDynamics::n_columns);
+		REQUIRE(xt::all(column(action_set, Column::efficacy) >= 0));
+		REQUIRE(xt::all(xt::abs(column(action_set, Column::objective_parallelism)) <= 1));
+		REQUIRE(xt::all(column(action_set, Column::support) > 0));
+		REQUIRE(xt::all(column(action_set, Column::support) <= 1));
+		REQUIRE(xt::all(column(action_set, Column::integer_support) >= 0));
+		REQUIRE(xt::all(column(action_set, Column::integer_support) <= 1));
+	}
+
+	SECTION("Solve instance with default selection") {
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		while (!done) {
+			std::tie(done, action_set) = dyn.step_dynamics(model, Default);
+		}
+		REQUIRE(model.is_solved());
+	}
+
+	SECTION("Solve instance selecting no cut") {
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		while (!done) {
+			std::tie(done, action_set) = dyn.step_dynamics(model, std::vector<std::size_t>{});
+		}
+		REQUIRE(model.is_solved());
+	}
+
+	SECTION("Throw on invalid selections") {
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		REQUIRE_FALSE(done);
+		auto const n_cuts = action_set->shape(0);
+		REQUIRE_THROWS_AS(dyn.step_dynamics(model, std::vector<std::size_t>{n_cuts}), std::invalid_argument);
+		REQUIRE_THROWS_AS(dyn.step_dynamics(model, std::vector<std::size_t>{0, 0}), std::invalid_argument);
+	}
+}
@@ -0,0 +1,100 @@
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+
+#include <catch2/catch.hpp>
+#include <xtensor/xsort.hpp>
+
+#include "ecole/dynamics/inline-policy-branching.hpp"
+#include "ecole/none.hpp"
+#include "ecole/observation/pseudocosts.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "conftest.hpp"
+#include "dynamics/unit-tests.hpp"
+
+using namespace ecole;
+
+namespace {
+
+auto first_candidate(scip::Model& /*model*/, dynamics::InlinePolicyBranching::Candidates const& cands) -> std::size_t {
+	return cands(0);
+}
+
+}  // namespace
+
+TEST_CASE("InlinePolicyBranching unit tests", "[unit][dynamics]") {
+	bool const pseudo_candidates = GENERATE(true, false);
+	auto const policy = [](auto const& /*action_set*/, auto const& /*model*/) { return None; };
+	dynamics::unit_tests(dynamics::InlinePolicyBranching{first_candidate, pseudo_candidates}, policy);
+}
+
+TEST_CASE("InlinePolicyBranching functional tests", "[dynamics]") {
+	bool const pseudo_candidates = GENERATE(true, false);
+	auto model = get_model();
+	std::size_t n_calls = 0;
+
+	SECTION("Episodes have length one") {
+		auto dyn = dynamics::InlinePolicyBranching{first_candidate, pseudo_candidates};
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		REQUIRE_FALSE(done);
+		std::tie(done, action_set) = dyn.step_dynamics(model, None);
+		REQUIRE(done);
+		REQUIRE(model.is_solved());
+	}
+
+	SECTION("Call the policy with valid candidates") {
+		auto const policy = [&n_calls](scip::Model& m, auto const& cands) {
+			++n_calls;
+			REQUIRE(cands.size() > 0);
+			REQUIRE(xt::unique(cands).size() == cands.size());
+			for (auto const idx : cands) {
+				REQUIRE(idx < m.variables().size());
+			}
+			return cands(cands.size() - 1);
+		};
+		auto dyn = dynamics::InlinePolicyBranching{policy, pseudo_candidates};
+		dyn.reset_dynamics(model);
+		dyn.step_dynamics(model, None);
+		REQUIRE(n_calls > 0);
+		REQUIRE(model.is_solved());
+	}
+
+	SECTION("Extract observations in the policy") {
+		auto obs_func = observation::Pseudocosts{};
+		auto const policy = [&n_calls, &obs_func](scip::Model& m, auto const& cands) {
+			++n_calls;
+			REQUIRE(obs_func.extract(m, false).has_value());
+			return cands(0);
+		};
+		auto dyn = dynamics::InlinePolicyBranching{policy, pseudo_candidates};
+		obs_func.before_reset(model);
+		dyn.reset_dynamics(model);
+		dyn.step_dynamics(model, None);
+		REQUIRE(n_calls > 0);
+	}
+
+	SECTION("Solve without policy") {
+		auto dyn = dynamics::InlinePolicyBranching{};
+		dyn.reset_dynamics(model);
+		dyn.step_dynamics(model, None);
+		REQUIRE(model.is_solved());
+	}
+
+	SECTION("Forward policy exceptions") {
+		auto const policy = [](scip::Model& /*model*/, auto const& /*cands*/) -> std::size_t {
+			throw std::runtime_error{"Policy error"};
+		};
+		auto dyn = dynamics::InlinePolicyBranching{policy, pseudo_candidates};
+		dyn.reset_dynamics(model);
+		REQUIRE_THROWS_AS(dyn.step_dynamics(model, None), std::runtime_error);
+		REQUIRE_FALSE(model.is_solved());
+	}
+
+	SECTION("Throw on invalid branching variable") {
+		auto const policy = [](scip::Model& m, auto const& /*cands*/) { return m.variables().size() + 1; };
+		auto dyn = dynamics::InlinePolicyBranching{policy, pseudo_candidates};
+		dyn.reset_dynamics(model);
+		REQUIRE_THROWS_AS(dyn.step_dynamics(model, None), std::invalid_argument);
+	}
+}
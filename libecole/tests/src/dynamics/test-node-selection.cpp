@@ -0,0 +1,79 @@
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+#include <xtensor/xsort.hpp>
+#include <xtensor/xview.hpp>
+
+#include "ecole/dynamics/node-selection.hpp"
+
+#include "conftest.hpp"
+#include "dynamics/unit-tests.hpp"
+
+using namespace ecole;
+
+namespace {
+
+using Column = dynamics::NodeSelectionDynamics::Column;
+
+auto column(dynamics::NodeSelectionDynamics::ActionSet const& action_set, Column col) {
+	return xt::view(action_set.value(), xt::all(), static_cast<std::size_t>(col));
+}
+
+/** Select the deepest open node. */
+auto deepest_node(dynamics::NodeSelectionDynamics::ActionSet const& action_set) -> std::size_t {
+	auto const depths = column(action_set, Column::depth);
+	auto const best = xt::argmax(depths)();
+	return static_cast<std::size_t>(column(action_set, Column::number)(best));
+}
+
+}  // namespace
+
+TEST_CASE("NodeSelectionDynamics unit tests", "[unit][dynamics]") {
+	auto const policy = [](auto const& action_set, auto const& /*model*/) -> dynamics::NodeSelectionDynamics::Action {
+		return deepest_node(action_set);
+	};
+	dynamics::unit_tests(dynamics::NodeSelectionDynamics{}, policy);
+}
+
+TEST_CASE("NodeSelectionDynamics functional tests", "[dynamics]") {
+	auto dyn = dynamics::NodeSelectionDynamics{};
+	auto model = get_model();
+
+	SECTION("Frontier has the open nodes") {
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		REQUIRE_FALSE(done);
+		for (auto i = 0; (i < 20) && !done; ++i) {
+			REQUIRE(action_set.has_value());
+			REQUIRE(action_set->shape(1) == dynamics::NodeSelectionDynamics::n_columns);
+			REQUIRE(action_set->shape(0) == static_cast<std::size_t>(SCIPgetNNodesLeft(model.get_scip_ptr())));
+			auto const numbers = column(action_set, Column::number);
+			REQUIRE(xt::unique(numbers).size() == numbers.size());
+			std::tie(done, action_set) = dyn.step_dynamics(model, deepest_node(action_set));
+		}
+	}
+
+	SECTION("Solve instance with default selection") {
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		while (!done) {
+			std::tie(done, action_set) = dyn.step_dynamics(model, Default);
+		}
+		REQUIRE(model.is_solved());
+	}
+
+	SECTION("Solve instance with depth first selection") {
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		while (!done) {
+			std::tie(done, action_set) = dyn.step_dynamics(model, deepest_node(action_set));
+		}
+		REQUIRE(model.is_solved());
+	}
+
+	SECTION("Throw on nodes not in the frontier") {
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		REQUIRE_FALSE(done);
+		REQUIRE_THROWS_AS(dyn.step_dynamics(model, std::size_t{1} << 40U), std::invalid_argument);
+	}
+}
@@ -0,0 +1,58 @@
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/dynamics/parallel-configurator.hpp"
+#include "ecole/reward/is-done.hpp"
+#include "ecole/reward/n-nodes.hpp"
+
+#include "conftest.hpp"
+
+using namespace ecole;
+
+TEST_CASE("ParallelConfigurator evaluates every configuration", "[dynamics]") {
+	auto const n_threads = GENERATE(std::size_t{1}, std::size_t{3});
+	auto configurator = dynamics::ParallelConfigurator<reward::NNodes>{{}, n_threads};
+	auto model = get_model();
+
+	SECTION("Return a reward per configuration") {
+		auto const param_dicts = std::vector<dynamics::ParamDict>{
+			{},
+			{{"branching/scorefunc", 's'}},
+			{{"limits/totalnodes", 1}},
+			{{"branching/scorefunc", 'p'}},
+		};
+		auto const rewards = configurator.evaluate(model, param_dicts);
+		REQUIRE(rewards.size() == param_dicts.size());
+		REQUIRE(rewards[2] <= 1);
+	}
+
+	SECTION("Leave the model unchanged") {
+		auto const param_dicts = std::vector<dynamics::ParamDict>(2);
+		configurator.evaluate(model, param_dicts);
+		REQUIRE(model.stage() == SCIP_STAGE_PROBLEM);
+	}
+
+	SECTION("Same configurations give the same rewards") {
+		auto const param_dicts = std::vector<dynamics::ParamDict>(3, {{"randomization/randomseedshift", 3}});
+		auto const rewards = configurator.evaluate(model, param_dicts);
+		REQUIRE(rewards[0] == rewards[1]);
+		REQUIRE(rewards[1] == rewards[2]);
+	}
+
+	SECTION("Accept no configuration") {
+		REQUIRE(configurator.evaluate(model, {}).empty());
+	}
+
+	SECTION("Rethrow errors of configurations") {
+		auto const param_dicts = std::vector<dynamics::ParamDict>{{}, {{"not/a/param", 1}}, {}};
+		REQUIRE_THROWS(configurator.evaluate(model, param_dicts));
+	}
+}
+
+TEST_CASE("ParallelConfigurator with a done reward", "[dynamics]") {
+	auto configurator = dynamics::ParallelConfigurator<reward::IsDone>{};
+	auto const rewards = configurator.evaluate(get_model(), std::vector<dynamics::ParamDict>(2));
+	REQUIRE(rewards == std::vector<reward::Reward>{1, 1});
+}
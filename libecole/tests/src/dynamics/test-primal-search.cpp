@@ -1,5 +1,8 @@
+#include <algorithm>
+#include <cstddef>
 #include <stdexcept>
 #include <tuple>
+#include <vector>
 
 #include <catch2/catch.hpp>
 #include <xtensor/xmath.hpp>
@@ -39,6 +42,17 @@ TEST_CASE("PrimalSearchDynamics functional tests", "[dynamics]") {
 		REQUIRE(xt::unique(var_ids).size() == var_ids.size());
 	}
 
+	SECTION("Action mask matches the action set") {
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		auto const mask = dyn.action_mask_view(model);
+		REQUIRE(mask.has_value());
+		REQUIRE(mask->size() == model.variables().size());
+		REQUIRE(static_cast<std::size_t>(std::count(mask->begin(), mask->end(), 1)) == action_set->size());
+		for (auto const var : action_set.value()) {
+			REQUIRE((*mask)[var] == 1);
+		}
+	}
+
 	SECTION("Handle extreme action - empty") {
 		auto [done, action_set] = dyn.reset_dynamics(model);
 		REQUIRE(action_set.has_value());
@@ -79,6 +93,50 @@ TEST_CASE("PrimalSearchDynamics functional tests", "[dynamics]") {
 		REQUIRE(model.is_solved());
 	}
 
+	SECTION("Try a batch of solutions") {
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		REQUIRE(action_set.has_value());
+		auto var_ids = std::vector<std::size_t>(action_set.value().begin(), action_set.value().end());
+		auto zeros = std::vector<SCIP_Real>(var_ids.size(), 0.);
+		auto ones = std::vector<SCIP_Real>(var_ids.size(), 1.);
+		auto const ids_span = nonstd::span<std::size_t const>{var_ids};
+		auto const actions = std::vector<dynamics::PrimalSearchDynamics::Action>{
+			{ids_span, nonstd::span<SCIP_Real const>{zeros}},
+			{{}, {}},
+			{ids_span, nonstd::span<SCIP_Real const>{ones}},
+		};
+		std::tie(done, action_set) = dyn.step_dynamics_batch(model, actions);
+		REQUIRE_FALSE(done);
+		REQUIRE(dyn.last_solutions_kept().size() == actions.size());
+		REQUIRE_FALSE(dyn.last_solutions_kept()[1]);
+	}
+
+	SECTION("A batch counts as a single trial") {
+		auto n_steps = 0;
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		auto const actions = std::vector<dynamics::PrimalSearchDynamics::Action>(3, {{}, {}});
+		for (; !done && n_steps < trials_per_node; ++n_steps) {
+			REQUIRE(model.stage() == SCIP_STAGE_SOLVING);
+			auto const n_nodes = SCIPgetNNodes(model.get_scip_ptr());
+			std::tie(done, action_set) = dyn.step_dynamics_batch(model, actions);
+			if (n_steps + 1 < trials_per_node) {
+				REQUIRE(SCIPgetNNodes(model.get_scip_ptr()) == n_nodes);
+			}
+		}
+	}
+
+	SECTION("Throw on invalid solution in batch") {
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		REQUIRE_FALSE(done);
+		auto var_ids = std::vector<std::size_t>{model.variables().size()};
+		auto var_vals = std::vector<SCIP_Real>{0.0};
+		auto const actions = std::vector<dynamics::PrimalSearchDynamics::Action>{
+			{{}, {}},
+			{nonstd::span<std::size_t const>{var_ids}, nonstd::span<SCIP_Real const>{var_vals}},
+		};
+		REQUIRE_THROWS_AS(dyn.step_dynamics_batch(model, actions), std::invalid_argument);
+	}
+
 	SECTION("Throw on invalid variable id") {
 		auto [done, action_set] = dyn.reset_dynamics(model);
 		REQUIRE_FALSE(done);
@@ -92,6 +150,53 @@ TEST_CASE("PrimalSearchDynamics functional tests", "[dynamics]") {
 	}
 }
 
+TEST_CASE("PrimalSearchDynamics screens solutions before probing", "[dynamics]") {
+	using Screening = dynamics::PrimalSearchDynamics::Screening;
+	auto model = get_model();
+
+	SECTION("Fractional values are rejected") {
+		auto dyn = dynamics::PrimalSearchDynamics{1, 1, 0, -1, Screening::reject};
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		REQUIRE(action_set.has_value());
+		auto var_ids = std::vector<std::size_t>(action_set.value().begin(), action_set.value().end());
+		auto halves = std::vector<SCIP_Real>(var_ids.size(), 0.5);  // NOLINT(readability-magic-numbers)
+		auto const actions = std::vector<dynamics::PrimalSearchDynamics::Action>{
+			{nonstd::span<std::size_t const>{var_ids}, nonstd::span<SCIP_Real const>{halves}},
+			{{}, {}},
+		};
+		std::tie(done, action_set) = dyn.step_dynamics_batch(model, actions);
+		REQUIRE(dyn.last_solutions_screened_out() == std::vector<bool>{true, false});
+		REQUIRE(dyn.last_solutions_kept() == std::vector<bool>{false, false});
+	}
+
+	SECTION("Repaired values are probed") {
+		auto dyn = dynamics::PrimalSearchDynamics{1, 1, 0, -1, Screening::repair};
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		REQUIRE(action_set.has_value());
+		// A single variable leaves the others free to satisfy the rows, once its value is repaired
+		auto var_ids = std::vector<std::size_t>{action_set.value()[0]};
+		auto var_vals = std::vector<SCIP_Real>{0.2};  // NOLINT(readability-magic-numbers)
+		auto const action = dynamics::PrimalSearchDynamics::Action{
+			nonstd::span<std::size_t const>{var_ids}, nonstd::span<SCIP_Real const>{var_vals}};
+		std::tie(done, action_set) = dyn.step_dynamics(model, action);
+		REQUIRE(dyn.last_solutions_screened_out() == std::vector<bool>{false});
+	}
+
+	SECTION("Screening does not change the solving") {
+		auto const screening = GENERATE(Screening::reject, Screening::repair);
+		auto dyn = dynamics::PrimalSearchDynamics{1, 1, 0, -1, screening};
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		while (!done) {
+			REQUIRE(action_set.has_value());
+			auto var_ids = std::vector<std::size_t>(action_set.value().begin(), action_set.value().end());
+			auto zeros = std::vector<SCIP_Real>(var_ids.size(), 0.);
+			std::tie(done, action_set) = dyn.step_dynamics(
+				model, {nonstd::span<std::size_t const>{var_ids}, nonstd::span<SCIP_Real const>{zeros}});
+		}
+		REQUIRE(model.is_solved());
+	}
+}
+
 TEST_CASE("PrimalSearchDynamics handles limits", "[dynamics]") {
 	auto dyn = dynamics::PrimalSearchDynamics{1};
 	auto model = get_model();
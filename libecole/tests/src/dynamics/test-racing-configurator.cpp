@@ -0,0 +1,44 @@
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/dynamics/racing-configurator.hpp"
+#include "ecole/reward/n-nodes.hpp"
+
+#include "conftest.hpp"
+
+using namespace ecole;
+
+TEST_CASE("RacingConfigurator evaluates every configuration", "[dynamics]") {
+	auto const n_threads = GENERATE(std::size_t{1}, std::size_t{3});
+	auto model = get_model();
+
+	SECTION("No configuration is interrupted with an infinite tolerance") {
+		auto configurator =
+			dynamics::RacingConfigurator<reward::NNodes>{{}, std::numeric_limits<double>::infinity(), n_threads};
+		auto const param_dicts = std::vector<dynamics::ParamDict>{{}, {{"branching/scorefunc", 's'}}, {}};
+		auto const results = configurator.evaluate(model, param_dicts);
+		REQUIRE(results.size() == param_dicts.size());
+		for (auto const& result : results) {
+			REQUIRE_FALSE(result.interrupted);
+			REQUIRE(result.gap_integral >= 0);
+		}
+		REQUIRE(model.stage() == SCIP_STAGE_PROBLEM);
+	}
+
+	SECTION("Interrupt configurations dominated by the first one") {
+		// Sequentially, with a zero tolerance, any configuration after the first one is dominated
+		auto configurator = dynamics::RacingConfigurator<reward::NNodes>{{}, 0., 1};
+		auto const param_dicts = std::vector<dynamics::ParamDict>(2);
+		auto const results = configurator.evaluate(model, param_dicts);
+		REQUIRE_FALSE(results[0].interrupted);
+		REQUIRE(results[1].interrupted);
+	}
+
+	SECTION("Accept no configuration") {
+		auto configurator = dynamics::RacingConfigurator<reward::NNodes>{{}, 1., n_threads};
+		REQUIRE(configurator.evaluate(model, {}).empty());
+	}
+}
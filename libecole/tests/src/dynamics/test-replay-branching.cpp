@@ -0,0 +1,121 @@
+#include <cstddef>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/dynamics/branching.hpp"
+#include "ecole/dynamics/replay-branching.hpp"
+#include "ecole/none.hpp"
+#include "ecole/observation/pseudocosts.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "conftest.hpp"
+#include "dynamics/unit-tests.hpp"
+
+using namespace ecole;
+
+namespace {
+
+using Candidates = dynamics::ReplayBranching::Candidates;
+
+/** Record the first candidates branched on with BranchingDynamics, up to a node limit. */
+auto record_episode() -> std::tuple<std::vector<std::size_t>, std::vector<Candidates>> {
+	auto model = get_model();
+	model.set_param("limits/totalnodes", 20);  // NOLINT(readability-magic-numbers)
+	auto actions = std::vector<std::size_t>{};
+	auto action_sets = std::vector<Candidates>{};
+	auto dyn = dynamics::BranchingDynamics{};
+	auto [done, action_set] = dyn.reset_dynamics(model);
+	while (!done) {
+		actions.push_back(action_set.value()(0));
+		action_sets.push_back(action_set.value());
+		std::tie(done, action_set) = dyn.step_dynamics(model, actions.back());
+	}
+	return {std::move(actions), std::move(action_sets)};
+}
+
+}  // namespace
+
+TEST_CASE("ReplayBranching unit tests", "[unit][dynamics]") {
+	auto const policy = [](auto const& /*action_set*/, auto const& /*model*/) { return None; };
+	dynamics::unit_tests(dynamics::ReplayBranching{}, policy);
+}
+
+TEST_CASE("ReplayBranching functional tests", "[dynamics]") {
+	// Structured bindings cannot be captured by the observers
+	auto const recording = record_episode();
+	auto const& actions = std::get<0>(recording);
+	auto const& action_sets = std::get<1>(recording);
+	REQUIRE(actions.size() > 1);
+	auto model = get_model();
+	model.set_param("limits/totalnodes", 20);  // NOLINT(readability-magic-numbers)
+
+	SECTION("Replay the whole recorded episode") {
+		auto n_observed = std::size_t{0};
+		auto const observer = [&](scip::Model& /*model*/, std::size_t step, Candidates const& candidates) {
+			REQUIRE(step == n_observed);
+			REQUIRE(candidates.size() == action_sets[step].size());
+			++n_observed;
+		};
+		auto dyn = dynamics::ReplayBranching{actions, action_sets, observer};
+		auto [done, action_set] = dyn.reset_dynamics(model);
+		REQUIRE_FALSE(done);
+		std::tie(done, action_set) = dyn.step_dynamics(model, None);
+		REQUIRE(done);
+		REQUIRE(dyn.n_replayed() == actions.size());
+		REQUIRE(n_observed == actions.size());
+	}
+
+	SECTION("Extract observations on selected steps only") {
+		auto obs_func = observation::Pseudocosts{};
+		auto observed = std::vector<std::size_t>{};
+		auto const observer = [&](scip::Model& m, std::size_t step, Candidates const& /*candidates*/) {
+			REQUIRE(obs_func.extract(m, false).has_value());
+			observed.push_back(step);
+		};
+		auto const selected = std::vector<std::size_t>{0, actions.size() - 1};
+		auto dyn = dynamics::ReplayBranching{actions, {}, observer, selected};
+		obs_func.before_reset(model);
+		dyn.reset_dynamics(model);
+		dyn.step_dynamics(model, None);
+		REQUIRE(observed == selected);
+	}
+
+	SECTION("Stop solving after the last recorded action") {
+		auto const prefix = std::vector<std::size_t>(actions.begin(), actions.begin() + 1);
+		auto dyn = dynamics::ReplayBranching{prefix};
+		dyn.reset_dynamics(model);
+		auto const [done, action_set] = dyn.step_dynamics(model, None);
+		REQUIRE(done);
+		REQUIRE(dyn.n_replayed() == 1);
+		REQUIRE_FALSE(model.is_solved());
+	}
+
+	SECTION("Detect actions that are not candidates") {
+		auto diverging = actions;
+		diverging.back() = model.variables().size();
+		auto dyn = dynamics::ReplayBranching{diverging};
+		dyn.reset_dynamics(model);
+		try {
+			dyn.step_dynamics(model, None);
+			FAIL("Replay did not diverge");
+		} catch (dynamics::ReplayDivergence const& divergence) {
+			REQUIRE(divergence.step() == actions.size() - 1);
+		}
+	}
+
+	SECTION("Detect candidates that differ from the recording") {
+		auto diverging = action_sets;
+		diverging.front() = Candidates::from_shape({0});
+		auto dyn = dynamics::ReplayBranching{actions, diverging};
+		dyn.reset_dynamics(model);
+		REQUIRE_THROWS_AS(dyn.step_dynamics(model, None), dynamics::ReplayDivergence);
+	}
+
+	SECTION("Throw on mismatched recorded action sets") {
+		REQUIRE_THROWS_AS(dynamics::ReplayBranching(actions, {Candidates{}}), std::invalid_argument);
+	}
+}
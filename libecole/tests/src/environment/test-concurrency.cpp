@@ -0,0 +1,115 @@
+#include <cstddef>
+#include <future>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/data/tuple.hpp"
+#include "ecole/environment/branching.hpp"
+#include "ecole/environment/configuring.hpp"
+#include "ecole/observation/hutter-2011.hpp"
+#include "ecole/observation/khalil-2016.hpp"
+#include "ecole/observation/milp-bipartite.hpp"
+#include "ecole/observation/node-bipartite.hpp"
+#include "ecole/observation/pseudocosts.hpp"
+#include "ecole/observation/strong-branching-scores.hpp"
+#include "ecole/random.hpp"
+#include "ecole/reward/bound-integral.hpp"
+#include "ecole/reward/is-done.hpp"
+#include "ecole/reward/lp-iterations.hpp"
+#include "ecole/reward/n-nodes.hpp"
+#include "ecole/reward/solving-time.hpp"
+
+#include "conftest.hpp"
+
+/*
+ * Every environment of these tests only touches its own Model, so they run concurrently without synchronization.
+ * Any shared state inside Ecole or SCIP (counters, message handlers, random seeding...) is hence exercised from many
+ * threads, which ThreadSanitizer (SANITIZE_THREAD) reports if it is not properly synchronized.
+ */
+
+using namespace ecole;
+
+namespace {
+
+using BranchingObservation = data::TupleFunction<
+	observation::NodeBipartite,
+	observation::Khalil2016,
+	observation::Pseudocosts,
+	observation::StrongBranchingScores,
+	observation::Hutter2011>;
+using ConfiguringObservation = data::TupleFunction<observation::MilpBipartite, observation::Hutter2011>;
+
+template <typename Env> auto make_env(std::size_t seed) {
+	auto env = Env{};
+	env.seed(static_cast<Seed>(seed));
+	return env;
+}
+
+template <typename RewardFunction> void run_branching_episodes(std::size_t seed, std::size_t n_episodes) {
+	auto env = make_env<environment::Branching<BranchingObservation, RewardFunction>>(seed);
+	for (std::size_t episode = 0; episode < n_episodes; ++episode) {
+		auto [obs, action_set, reward, done, info] = env.reset(problem_file);
+		// Few steps are enough to run all the state functions
+		for (auto n_steps = 0; !done && n_steps < 5; ++n_steps) {
+			std::tie(obs, action_set, reward, done, info) = env.step(action_set.value()[0]);
+		}
+	}
+}
+
+template <typename RewardFunction> void run_configuring_episodes(std::size_t seed, std::size_t n_episodes) {
+	auto env = make_env<environment::Configuring<ConfiguringObservation, RewardFunction>>(seed);
+	for (std::size_t episode = 0; episode < n_episodes; ++episode) {
+		env.reset(problem_file);
+		env.step({{"limits/nodes", scip::Param{100LL}}});
+	}
+}
+
+}  // namespace
+
+TEST_CASE("Independent environments run concurrently", "[env][slow][concurrency]") {
+	auto constexpr n_episodes = std::size_t{2};
+	auto constexpr n_repeats = std::size_t{2};
+	auto const episode_runners = std::vector<void (*)(std::size_t, std::size_t)>{
+		run_branching_episodes<reward::IsDone>,
+		run_branching_episodes<reward::LpIterations>,
+		run_branching_episodes<reward::NNodes>,
+		run_branching_episodes<reward::SolvingTime>,
+		run_branching_episodes<reward::DualIntegral>,
+		run_branching_episodes<reward::PrimalIntegral>,
+		run_branching_episodes<reward::PrimalDualIntegral>,
+		run_configuring_episodes<reward::IsDone>,
+		run_configuring_episodes<reward::SolvingTime>,
+		run_configuring_episodes<reward::PrimalDualIntegral>,
+	};
+
+	// Every kind of environment runs simultaneously in several threads
+	auto futures = std::vector<std::future<void>>{};
+	for (std::size_t repeat = 0; repeat < n_repeats; ++repeat) {
+		for (std::size_t i = 0; i < episode_runners.size(); ++i) {
+			auto const seed = repeat * episode_runners.size() + i;
+			futures.push_back(std::async(std::launch::async, episode_runners[i], seed, n_episodes));
+		}
+	}
+	for (auto& fut : futures) {
+		REQUIRE_NOTHROW(fut.get());
+	}
+}
+
+TEST_CASE("Random generators are spawned concurrently", "[concurrency]") {
+	auto constexpr n_threads = std::size_t{8};
+	auto futures = std::vector<std::future<RandomGenerator>>{};
+	for (std::size_t i = 0; i < n_threads; ++i) {
+		futures.push_back(std::async(std::launch::async, [] { return spawn_random_generator(); }));
+	}
+	auto rngs = std::vector<RandomGenerator>{};
+	for (auto& fut : futures) {
+		rngs.push_back(fut.get());
+	}
+	for (std::size_t i = 0; i < n_threads; ++i) {
+		for (std::size_t j = i + 1; j < n_threads; ++j) {
+			REQUIRE(rngs[i] != rngs[j]);
+		}
+	}
+}
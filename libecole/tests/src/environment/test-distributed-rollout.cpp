@@ -0,0 +1,215 @@
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/environment/distributed-rollout.hpp"
+#include "ecole/environment/environment.hpp"
+#include "ecole/information/nothing.hpp"
+#include "ecole/none.hpp"
+#include "ecole/observation/nothing.hpp"
+#include "ecole/random.hpp"
+#include "ecole/reward/constant.hpp"
+
+#include "conftest.hpp"
+
+/****************************************
+ *  Mocking some classes for unit test  *
+ ****************************************/
+
+namespace {
+
+/** Dummy dynamics terminating after a random number of steps. */
+struct RandomLengthDynamics {
+	using Action = std::size_t;
+
+	std::size_t remaining = 0;
+
+	auto set_dynamics_random_state(ecole::scip::Model& /*model*/, ecole::RandomGenerator& rng) -> void {
+		remaining = std::uniform_int_distribution<std::size_t>{1, 20}(rng);
+	}
+
+	auto reset_dynamics(ecole::scip::Model& /*model*/) -> std::tuple<bool, ecole::NoneType> {
+		return {false, ecole::None};
+	}
+
+	auto step_dynamics(ecole::scip::Model& /*model*/, Action const& /*action*/) -> std::tuple<bool, ecole::NoneType> {
+		--remaining;
+		return {remaining == 0, ecole::None};
+	}
+};
+
+using Env = ecole::environment::
+	Environment<RandomLengthDynamics, ecole::observation::Nothing, ecole::reward::Constant, ecole::information::Nothing>;
+using Worker = ecole::environment::DistributedRolloutWorker<Env>;
+
+/** Recorder serializing the number of steps of an episode. */
+struct StepCounter {
+	std::mutex mutex;
+	std::map<std::size_t, std::size_t> n_steps;
+
+	void begin(std::size_t env) {
+		auto const lk = std::lock_guard{mutex};
+		n_steps[env] = 0;
+	}
+
+	template <typename... Args> void record(std::size_t env, Args const&... /*args*/) {
+		auto const lk = std::lock_guard{mutex};
+		++n_steps[env];
+	}
+
+	auto end(std::size_t env) -> std::string {
+		auto const lk = std::lock_guard{mutex};
+		return std::to_string(n_steps[env]);
+	}
+};
+
+auto make_worker(std::size_t n_envs) -> Worker {
+	auto envs = std::vector<Env>{};
+	for (std::size_t i = 0; i < n_envs; ++i) {
+		envs.emplace_back(ecole::observation::Nothing{}, ecole::reward::Constant{1.});
+	}
+	return Worker{std::move(envs)};
+}
+
+auto const zero_policy = [](std::size_t /*env*/, auto const& /*obs*/, auto const& /*action_set*/) {
+	return std::size_t{0};
+};
+
+auto const make_instance = [](ecole::environment::EpisodeTask const& /*task*/) { return problem_file; };
+
+/** Run a rollout with workers in threads talking directly to the coordinator, and collect the trajectories. */
+auto run_rollout(std::uint64_t n_episodes, std::vector<std::size_t> const& envs_per_worker)
+	-> std::map<std::uint64_t, std::string> {
+	auto mutex = std::mutex{};
+	auto trajectories = std::map<std::uint64_t, std::string>{};
+	auto sink = [&](ecole::environment::EpisodeTask const& task, std::string_view trajectory) {
+		auto const lk = std::lock_guard{mutex};
+		trajectories.emplace(task.episode, trajectory);
+	};
+	auto coordinator = ecole::environment::RolloutCoordinator{n_episodes, sink, 2, ecole::RandomGenerator{0}};
+
+	auto threads = std::vector<std::thread>{};
+	for (std::size_t rank = 0; rank < envs_per_worker.size(); ++rank) {
+		threads.emplace_back([&coordinator, rank, n_envs = envs_per_worker[rank]] {
+			auto worker = make_worker(n_envs);
+			auto recorder = StepCounter{};
+			worker.run(
+				[&] { return coordinator.assign(rank); },
+				make_instance,
+				zero_policy,
+				recorder,
+				[&](auto const& task, std::string trajectory) { coordinator.complete(rank, task.episode, trajectory); });
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	REQUIRE(coordinator.n_completed() == n_episodes);
+	return trajectories;
+}
+
+}  // namespace
+
+/*****************************
+ *  Test RolloutCoordinator  *
+ *****************************/
+
+using namespace ecole;
+
+TEST_CASE("Rollout coordinator derives seeds as sharded generators", "[env]") {
+	auto const rng = RandomGenerator{3};
+	auto const ignore = [](auto const& /*task*/, auto /*trajectory*/) {};
+	auto const coordinator = environment::RolloutCoordinator{10, ignore, 1, rng};
+	for (std::uint64_t episode = 0; episode < 10; ++episode) {
+		auto const task = coordinator.task(episode);
+		REQUIRE(task.episode == episode);
+		REQUIRE(task.instance_seed == derive_random_generator(rng, episode)());
+		REQUIRE(task.instance_seed != task.environment_seed);
+	}
+}
+
+TEST_CASE("Rollout coordinator limits the episodes in flight", "[env]") {
+	auto n_received = std::size_t{0};
+	auto coordinator = environment::RolloutCoordinator{4, [&](auto const& /*task*/, auto /*trajectory*/) {
+														   ++n_received;
+													   }};
+	auto const first = coordinator.assign(0);
+	auto const second = coordinator.assign(0);
+	REQUIRE(first.has_value());
+	REQUIRE(second.has_value());
+	REQUIRE(first->episode == 0);
+	REQUIRE(second->episode == 1);
+
+	SECTION("Other workers have their own credit") {
+		REQUIRE(coordinator.assign(1)->episode == 2);
+		REQUIRE(coordinator.assign(1)->episode == 3);
+	}
+
+	SECTION("Completing an episode gives back credit") {
+		coordinator.complete(0, 0, "trajectory");
+		REQUIRE(n_received == 1);
+		REQUIRE(coordinator.assign(0)->episode == 2);
+		REQUIRE_THROWS_AS(coordinator.complete(0, 0, "trajectory"), std::invalid_argument);
+	}
+
+	SECTION("Released episodes are assigned again") {
+		coordinator.release(0);
+		REQUIRE_THROWS_AS(coordinator.complete(0, 0, "trajectory"), std::invalid_argument);
+		REQUIRE(coordinator.assign(1)->episode == 0);
+		REQUIRE(coordinator.assign(1)->episode == 1);
+		coordinator.complete(1, 0, "trajectory");
+		coordinator.complete(1, 1, "trajectory");
+		REQUIRE(coordinator.n_completed() == 2);
+	}
+
+	REQUIRE_THROWS_AS(environment::RolloutCoordinator(1, {}, 0), std::invalid_argument);
+}
+
+TEST_CASE("Rollout coordinator has no episode left once every trajectory is received", "[env]") {
+	auto coordinator = environment::RolloutCoordinator{1, [](auto const& /*task*/, auto /*trajectory*/) {}};
+	auto const task = coordinator.assign(0);
+	REQUIRE(task.has_value());
+	coordinator.complete(0, task->episode, "trajectory");
+	coordinator.wait();
+	REQUIRE_FALSE(coordinator.assign(1).has_value());
+}
+
+/***********************************
+ *  Test DistributedRolloutWorker  *
+ ***********************************/
+
+TEST_CASE("Distributed rollout sends a trajectory per episode", "[env]") {
+	auto const trajectories = run_rollout(12, {2, 3});
+	REQUIRE(trajectories.size() == 12);
+	for (auto const& [episode, trajectory] : trajectories) {
+		REQUIRE(std::stoul(trajectory) > 0);
+	}
+}
+
+TEST_CASE("Distributed rollout does not depend on the workers", "[env]") {
+	REQUIRE(run_rollout(10, {1}) == run_rollout(10, {2, 1, 3}));
+}
+
+TEST_CASE("Distributed rollout worker rethrows the errors of episodes", "[env]") {
+	auto worker = make_worker(2);
+	auto recorder = StepCounter{};
+	auto n_fetched = std::atomic<std::uint64_t>{0};
+	auto fetch = [&n_fetched]() -> std::optional<environment::EpisodeTask> {
+		return environment::EpisodeTask{n_fetched++, 0, 0};
+	};
+	auto failing_send = [](auto const& /*task*/, std::string /*trajectory*/) { throw std::runtime_error{"Lost"}; };
+	REQUIRE_THROWS_AS(worker.run(fetch, make_instance, zero_policy, recorder, failing_send), std::runtime_error);
+	REQUIRE_THROWS_AS(Worker{std::vector<Env>{}}, std::invalid_argument);
+}
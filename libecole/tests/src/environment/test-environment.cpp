@@ -1,8 +1,16 @@
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <thread>
 #include <tuple>
 #include <vector>
 
 #include <catch2/catch.hpp>
 
+#include "ecole/data/prefetched.hpp"
+#include "ecole/environment/branching.hpp"
 #include "ecole/environment/environment.hpp"
 #include "ecole/exception.hpp"
 #include "ecole/information/nothing.hpp"
@@ -10,6 +18,7 @@
 #include "ecole/observation/nothing.hpp"
 #include "ecole/random.hpp"
 #include "ecole/reward/constant.hpp"
+#include "ecole/scip/model-pool.hpp"
 #include "ecole/traits.hpp"
 
 #include "conftest.hpp"
@@ -51,6 +60,17 @@ struct TestDynamics {
 
 }  // namespace dynamics
 
+namespace observation {
+
+/** Observation function opting out of extraction, which must hence never be called. */
+struct ThrowingNothing {
+	static constexpr bool extracts_nothing = true;
+	auto before_reset(scip::Model& /*model*/) -> void { throw std::logic_error{"Unexpected before_reset"}; }
+	auto extract(scip::Model& /*model*/, bool /*done*/) -> NoneType { throw std::logic_error{"Unexpected extract"}; }
+};
+
+}  // namespace observation
+
 namespace environment {
 
 using TestEnv = Environment<dynamics::TestDynamics, observation::Nothing, reward::Constant, information::Nothing>;
@@ -73,6 +93,53 @@ TEST_CASE("Environments accept SCIP parameters", "[env]") {
 	REQUIRE(env.model().get_param<std::string>(name) == std::string(value));
 }
 
+TEST_CASE("Environments set the memory limit of episodes", "[env]") {
+	auto env = environment::TestEnv{{}, {}, {}, {{"limits/memory", 1.}}};
+	env.memory_limit() = std::size_t{64} << 20U;
+
+	env.reset(problem_file);
+	REQUIRE(env.model().get_param<double>("limits/memory") == 64.);
+}
+
+TEST_CASE("Environments restore their random state", "[env]") {
+	auto env = environment::TestEnv{};
+	env.seed(0);
+	auto const state = env.save_state();
+	env.rng()();
+	env.load_state(state);
+	REQUIRE(env.rng() == RandomGenerator{0});
+	REQUIRE_THROWS_AS(env.load_state(state.substr(1)), std::invalid_argument);
+}
+
+TEST_CASE("Environments do not call functions extracting nothing", "[env]") {
+	auto env = environment::Environment<
+		dynamics::TestDynamics,
+		observation::ThrowingNothing,
+		reward::Constant,
+		information::Nothing>{};
+	auto [obs, action_set, reward, done, info] = env.reset(problem_file);
+	REQUIRE(obs.has_value());
+	REQUIRE(info.empty());
+	std::tie(obs, action_set, reward, done, info) = env.step(0.);
+	REQUIRE(obs.has_value());
+}
+
+TEST_CASE("Environments extract prefetched observations in the background", "[env]") {
+	auto env = environment::Environment<
+		dynamics::TestDynamics,
+		data::PrefetchedFunction<observation::Nothing>,
+		reward::Constant,
+		information::Nothing>{};
+	auto [obs, action_set, reward, done, info] = env.reset(problem_file);
+	REQUIRE(obs.has_value());
+	obs->get();
+	// The environment waits for the extraction before stepping
+	std::tie(obs, action_set, reward, done, info) = env.step(0.);
+	std::tie(obs, action_set, reward, done, info) = env.step(0.);
+	REQUIRE(obs.has_value());
+	obs->get();
+}
+
 TEST_CASE("Environments have MDP API", "[env]") {
 	auto env = environment::TestEnv{};
 	constexpr double some_action = 3.0;
@@ -111,3 +178,110 @@ TEST_CASE("Environments have MDP API", "[env]") {
 		REQUIRE_THROWS_AS(env.step(some_action), MarkovError);
 	}
 }
+
+TEST_CASE("Environments recycle models from a pool", "[env]") {
+	auto env = environment::TestEnv{};
+	env.model_pool() = std::make_shared<scip::ModelPool>();
+
+	env.reset(problem_file);
+	auto const* const scip = env.model().get_scip_ptr();
+	env.reset(problem_file);
+	REQUIRE(env.model().get_scip_ptr() == scip);
+	REQUIRE(env.model().stage() == SCIP_STAGE_PROBLEM);
+
+	SECTION("Models given to reset are released to the pool") {
+		env.reset(get_model());
+		REQUIRE(env.model_pool()->size() == 1);
+	}
+}
+
+TEST_CASE("Environments have asynchronous MDP API", "[env]") {
+	auto env = environment::TestEnv{};
+	constexpr double some_action = 3.0;
+	using Calls = dynamics::TestDynamics::Calls;
+
+	SECTION("Call reset and step asynchronously") {
+		auto [obs, action_set, reward, done, info] = env.reset_async(std::string{problem_file}).get();
+		std::tie(obs, action_set, reward, done, info) = env.step_async(some_action).get();
+		REQUIRE(env.dynamics().calls == std::vector{Calls::seed, Calls::reset, Calls::step});
+		REQUIRE(env.dynamics().last_action == some_action);
+	}
+
+	SECTION("Exceptions are forwarded through the future") {
+		auto future = env.step_async(some_action);
+		REQUIRE_THROWS_AS(future.get(), MarkovError);
+	}
+}
+
+TEST_CASE("Environments can extract observations lazily", "[env]") {
+	auto env = environment::TestEnv{};
+	constexpr double some_action = 3.0;
+
+	SECTION("Observations are only extracted when accessed") {
+		auto [obs, action_set, reward, done, info] = env.reset_lazy(problem_file);
+		REQUIRE(!obs.is_extracted());
+		REQUIRE(obs.get().has_value());
+		REQUIRE(obs.is_extracted());
+	}
+
+	SECTION("Observations cannot be extracted past the next transition") {
+		auto [obs, action_set, reward, done, info] = env.reset_lazy(problem_file);
+		auto [next_obs, next_action_set, next_reward, next_done, next_info] = env.step_lazy(some_action);
+		REQUIRE_THROWS_AS(obs.get(), MarkovError);
+		REQUIRE_NOTHROW(next_obs.get());
+	}
+
+	SECTION("Observations extracted remain available after transitioning") {
+		auto [obs, action_set, reward, done, info] = env.reset_lazy(problem_file);
+		obs.get();
+		env.step_lazy(some_action);
+		REQUIRE(obs.get().has_value());
+	}
+
+	SECTION("Terminal states have no observation") {
+		env.reset_lazy(problem_file);
+		while (true) {
+			auto [obs, action_set, reward, done, info] = env.step_lazy(some_action);
+			if (done) {
+				REQUIRE(!obs.get().has_value());
+				break;
+			}
+		}
+		REQUIRE_THROWS_AS(env.step_lazy(some_action), MarkovError);
+	}
+}
+
+TEST_CASE("Environments stop the step deadline before taking a snapshot", "[env]") {
+	using namespace std::chrono_literals;
+	auto const deadline = GENERATE(as<std::chrono::milliseconds>{}, 1ms, 1h);
+	auto env = environment::Branching<observation::Nothing>{
+		{}, {}, {}, {}, false, dynamics::ObservationSchedule{}, std::size_t{0}, false, deadline};
+	auto [obs, action_set, reward, done, info] = env.reset(problem_file);
+	REQUIRE_FALSE(done);
+	std::this_thread::sleep_for(20ms);
+
+	if (deadline == 1h) {
+		REQUIRE_NOTHROW(env.snapshot());
+	} else {
+		REQUIRE_THROWS_AS(env.snapshot(), MarkovError);
+	}
+	// The environment can still transition after the snapshot
+	REQUIRE_NOTHROW(env.step(action_set.value()[0]));
+}
+
+TEST_CASE("Environments start the step deadline of lazy observations", "[env]") {
+	using namespace std::chrono_literals;
+	auto const deadline = GENERATE(as<std::chrono::milliseconds>{}, 1ms, 1h);
+	auto env = environment::Branching<observation::Nothing>{
+		{}, {}, {}, {}, false, dynamics::ObservationSchedule{}, std::size_t{0}, false, deadline};
+	auto [obs, action_set, reward, done, info] = env.reset_lazy(problem_file);
+	REQUIRE_FALSE(done);
+	std::this_thread::sleep_for(20ms);
+
+	if (deadline == 1h) {
+		REQUIRE_NOTHROW(obs.get());
+	} else {
+		REQUIRE_THROWS_AS(obs.get(), MarkovError);
+	}
+	REQUIRE_NOTHROW(env.step_lazy(action_set.value()[0]));
+}
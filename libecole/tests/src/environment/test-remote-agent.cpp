@@ -0,0 +1,140 @@
+#include <chrono>
+#include <cstddef>
+#include <future>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <nonstd/span.hpp>
+
+#include "ecole/environment/environment.hpp"
+#include "ecole/environment/remote-agent.hpp"
+#include "ecole/environment/rollout.hpp"
+#include "ecole/information/nothing.hpp"
+#include "ecole/none.hpp"
+#include "ecole/observation/nothing.hpp"
+#include "ecole/random.hpp"
+#include "ecole/reward/constant.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+#include "conftest.hpp"
+
+/****************************************
+ *  Mocking some classes for unit test  *
+ ****************************************/
+
+namespace {
+
+/** Only the types of an environment, with observations telling the action expected by the test. */
+struct TypesOnlyEnv {
+	using OptionalObservation = std::size_t;
+	using ActionSet = ecole::NoneType;
+	using Action = std::size_t;
+};
+
+using Agent = ecole::environment::RemoteAgent<TypesOnlyEnv>;
+
+auto const echo_transport = [](nonstd::span<Agent::Request const> requests) {
+	auto actions = std::vector<std::size_t>{};
+	for (auto const& request : requests) {
+		actions.push_back(*request.observation);
+	}
+	return actions;
+};
+
+/** Dummy dynamics terminating after a random number of steps. */
+struct RandomLengthDynamics {
+	using Action = std::size_t;
+
+	std::size_t remaining = 0;
+
+	auto set_dynamics_random_state(ecole::scip::Model& /*model*/, ecole::RandomGenerator& rng) -> void {
+		remaining = std::uniform_int_distribution<std::size_t>{1, 20}(rng);
+	}
+
+	auto reset_dynamics(ecole::scip::Model& /*model*/) -> std::tuple<bool, ecole::NoneType> {
+		return {false, ecole::None};
+	}
+
+	auto step_dynamics(ecole::scip::Model& /*model*/, Action const& /*action*/) -> std::tuple<bool, ecole::NoneType> {
+		--remaining;
+		return {remaining == 0, ecole::None};
+	}
+};
+
+using Env = ecole::environment::
+	Environment<RandomLengthDynamics, ecole::observation::Nothing, ecole::reward::Constant, ecole::information::Nothing>;
+
+}  // namespace
+
+/**********************
+ *  Test RemoteAgent  *
+ **********************/
+
+using namespace ecole;
+
+TEST_CASE("Remote agent sends full batches at once", "[env]") {
+	auto constexpr n_workers = std::size_t{4};
+	auto agent = Agent{echo_transport, n_workers, std::chrono::hours{1}};
+	auto pool = utility::ThreadPool{n_workers};
+	auto futures = std::vector<std::future<std::size_t>>{};
+	for (std::size_t worker = 0; worker < n_workers; ++worker) {
+		futures.push_back(pool.submit([&agent, worker] { return agent(worker, 2 * worker, None); }));
+	}
+	for (std::size_t worker = 0; worker < n_workers; ++worker) {
+		REQUIRE(futures[worker].get() == 2 * worker);
+	}
+	REQUIRE(agent.n_batches() == 1);
+}
+
+TEST_CASE("Remote agent sends incomplete batches after the maximum delay", "[env]") {
+	auto agent = Agent{echo_transport, 4, std::chrono::milliseconds{1}};
+	REQUIRE(agent(0, 3, None) == 3);
+	REQUIRE(agent(0, 5, None) == 5);
+	REQUIRE(agent.n_batches() == 2);
+}
+
+TEST_CASE("Remote agent rethrows the errors of the transport", "[env]") {
+	auto const failing_transport = [](nonstd::span<Agent::Request const> /*requests*/) -> std::vector<std::size_t> {
+		throw std::runtime_error{"Service unavailable"};
+	};
+	auto failing_agent = Agent{failing_transport, 1};
+	REQUIRE_THROWS_AS(failing_agent(0, 0, None), std::runtime_error);
+
+	auto const short_transport = [](nonstd::span<Agent::Request const> /*requests*/) {
+		return std::vector<std::size_t>{};
+	};
+	auto short_agent = Agent{short_transport, 1};
+	REQUIRE_THROWS_AS(short_agent(0, 0, None), std::invalid_argument);
+
+	REQUIRE_THROWS_AS(Agent(echo_transport, 0), std::invalid_argument);
+}
+
+TEST_CASE("Remote agent is the policy of rollout runners", "[env]") {
+	auto constexpr n_envs = std::size_t{3};
+	auto envs = std::vector<Env>{};
+	for (std::size_t i = 0; i < n_envs; ++i) {
+		envs.emplace_back(observation::Nothing{}, reward::Constant{1.});
+	}
+	auto runner = environment::RolloutRunner<Env>{std::move(envs)};
+	using EnvAgent = environment::RemoteAgent<Env>;
+	auto n_requests = std::size_t{0};
+	auto agent = EnvAgent{
+		[&n_requests](nonstd::span<EnvAgent::Request const> requests) {
+			n_requests += requests.size();
+			return std::vector<std::size_t>(requests.size(), 0);
+		},
+		n_envs};
+
+	auto const results = runner.run(std::vector<std::string>(8, problem_file), agent);
+	auto n_steps = std::size_t{0};
+	for (auto const& result : results) {
+		n_steps += result.n_steps;
+	}
+	REQUIRE(results.size() == 8);
+	REQUIRE(n_requests == n_steps);
+	REQUIRE(agent.n_batches() <= n_steps);
+}
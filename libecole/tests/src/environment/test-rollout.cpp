@@ -0,0 +1,148 @@
+#include <cstddef>
+#include <optional>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/environment/environment.hpp"
+#include "ecole/environment/rollout.hpp"
+#include "ecole/information/nothing.hpp"
+#include "ecole/none.hpp"
+#include "ecole/observation/nothing.hpp"
+#include "ecole/random.hpp"
+#include "ecole/reward/constant.hpp"
+#include "ecole/utility/affinity.hpp"
+
+#include "conftest.hpp"
+
+/****************************************
+ *  Mocking some classes for unit test  *
+ ****************************************/
+
+namespace {
+
+/**
+ * Dummy dynamics terminating after a random number of steps, and throwing when given a non zero action.
+ */
+struct RandomLengthDynamics {
+	using Action = std::size_t;
+
+	std::size_t remaining = 0;
+
+	auto set_dynamics_random_state(ecole::scip::Model& /*model*/, ecole::RandomGenerator& rng) -> void {
+		remaining = std::uniform_int_distribution<std::size_t>{1, 20}(rng);
+	}
+
+	auto reset_dynamics(ecole::scip::Model& /*model*/) -> std::tuple<bool, ecole::NoneType> {
+		return {false, ecole::None};
+	}
+
+	auto step_dynamics(ecole::scip::Model& /*model*/, Action const& action) -> std::tuple<bool, ecole::NoneType> {
+		if (action != 0) {
+			throw std::runtime_error{"Invalid action"};
+		}
+		--remaining;
+		return {remaining == 0, ecole::None};
+	}
+};
+
+using Env = ecole::environment::
+	Environment<RandomLengthDynamics, ecole::observation::Nothing, ecole::reward::Constant, ecole::information::Nothing>;
+using Runner = ecole::environment::RolloutRunner<Env>;
+
+auto make_runner(std::size_t n_envs, bool pin_workers = false) -> Runner {
+	auto envs = std::vector<Env>{};
+	for (std::size_t i = 0; i < n_envs; ++i) {
+		envs.emplace_back(ecole::observation::Nothing{}, ecole::reward::Constant{1.});
+	}
+	auto runner = Runner{std::move(envs), pin_workers};
+	runner.seed(0);
+	return runner;
+}
+
+auto const zero_policy = [](std::size_t /*worker*/, auto const& /*obs*/, auto const& /*action_set*/) {
+	return std::size_t{0};
+};
+
+}  // namespace
+
+/************************
+ *  Test RolloutRunner  *
+ ************************/
+
+using namespace ecole;
+
+TEST_CASE("Rollout runner runs an episode per instance", "[env]") {
+	auto constexpr n_episodes = std::size_t{16};
+	auto runner = make_runner(4);
+	auto const results = runner.run(std::vector<std::string>(n_episodes, problem_file), zero_policy);
+
+	REQUIRE(results.size() == n_episodes);
+	for (std::size_t i = 0; i < n_episodes; ++i) {
+		REQUIRE(results[i].episode == i);
+		REQUIRE(results[i].worker < runner.size());
+		REQUIRE(results[i].n_steps > 0);
+		// One per transition, plus the reset
+		REQUIRE(results[i].cumulative_reward == Approx(static_cast<double>(results[i].n_steps + 1)));
+	}
+}
+
+TEST_CASE("Rollout episodes do not depend on the number of workers", "[env]") {
+	auto constexpr n_episodes = std::size_t{10};
+	auto const instances = std::vector<std::string>(n_episodes, problem_file);
+	auto single_runner = make_runner(1);
+	auto multi_runner = make_runner(3);
+	auto const single_results = single_runner.run(instances, zero_policy);
+	auto const multi_results = multi_runner.run(instances, zero_policy);
+
+	REQUIRE(single_results.size() == multi_results.size());
+	for (std::size_t i = 0; i < n_episodes; ++i) {
+		REQUIRE(single_results[i].n_steps == multi_results[i].n_steps);
+	}
+}
+
+TEST_CASE("Rollout runner pins workers to physical cores", "[env]") {
+	auto runner = make_runner(3, true);
+	auto const cores = utility::physical_cores();
+	for (std::size_t worker = 0; worker < runner.size(); ++worker) {
+		if (!cores.empty()) {
+			REQUIRE(runner.worker_cpus(worker) == cores[worker % cores.size()]);
+		}
+	}
+	REQUIRE(make_runner(3).worker_cpus(0).empty());
+
+	auto const single_results = make_runner(1).run(std::vector<std::string>(6, problem_file), zero_policy);
+	auto const pinned_results = runner.run(std::vector<std::string>(6, problem_file), zero_policy);
+	REQUIRE(pinned_results.size() == single_results.size());
+	for (std::size_t i = 0; i < pinned_results.size(); ++i) {
+		REQUIRE(pinned_results[i].n_steps == single_results[i].n_steps);
+	}
+}
+
+TEST_CASE("Rollout runner takes instances from a queue", "[env]") {
+	auto runner = make_runner(2);
+	auto n_left = std::size_t{5};
+	auto next_instance = [&n_left]() -> std::optional<std::string> {
+		if (n_left == 0) {
+			return {};
+		}
+		--n_left;
+		return problem_file;
+	};
+	auto const results = runner.run_from(next_instance, zero_policy);
+	REQUIRE(results.size() == 5);
+	REQUIRE(n_left == 0);
+}
+
+TEST_CASE("Rollout runner rethrows the errors of episodes", "[env]") {
+	auto runner = make_runner(2);
+	auto const failing_policy = [](std::size_t /*worker*/, auto const& /*obs*/, auto const& /*action_set*/) {
+		return std::size_t{1};
+	};
+	REQUIRE_THROWS_AS(runner.run(std::vector<std::string>(4, problem_file), failing_policy), std::runtime_error);
+	REQUIRE_THROWS_AS(Runner{std::vector<Env>{}}, std::invalid_argument);
+}
@@ -0,0 +1,121 @@
+#include <cstddef>
+#include <limits>
+#include <stdexcept>
+#include <tuple>
+
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+
+#include "ecole/environment/branching.hpp"
+#include "ecole/environment/configuring.hpp"
+#include "ecole/environment/stopping-criterion.hpp"
+#include "ecole/observation/nothing.hpp"
+
+#include "conftest.hpp"
+
+using namespace ecole;
+
+namespace {
+
+/** Run an episode with the first candidate as action, returning the number of steps. */
+template <typename Env> auto run_episode(Env& env) -> std::size_t {
+	auto n_steps = std::size_t{0};
+	auto [obs, action_set, reward, done, info] = env.reset(problem_file);
+	while (!done) {
+		std::tie(obs, action_set, reward, done, info) = env.step(action_set.value()[0]);
+		++n_steps;
+	}
+	return n_steps;
+}
+
+/** The memory counted by SCIP against its memory limit. */
+auto model_memory(scip::Model const& model) -> std::size_t {
+	auto const usage = model.memory_usage();
+	return usage.scip_used + usage.scip_external;
+}
+
+}  // namespace
+
+TEST_CASE("Stopping criteria end branching episodes early", "[env]") {
+	auto env = environment::Branching<observation::Nothing>{};
+	env.seed(0);
+	auto const full_n_steps = run_episode(env);
+	REQUIRE_FALSE(environment::is_stopped_by_criterion(env.model()));
+
+	auto constexpr max_n_nodes = 3;
+	env.stopping_criterion() = [](scip::Model& model) { return SCIPgetNNodes(model.get_scip_ptr()) >= max_n_nodes; };
+	env.seed(0);
+	auto const n_steps = run_episode(env);
+
+	REQUIRE(n_steps < full_n_steps);
+	REQUIRE(SCIPgetStatus(env.model().get_scip_ptr()) == SCIP_STATUS_USERINTERRUPT);
+	REQUIRE(environment::is_stopped_by_criterion(env.model()));
+	REQUIRE(SCIPgetNNodes(env.model().get_scip_ptr()) <= max_n_nodes + 1);
+
+	SECTION("Criteria are evaluated anew on every episode") {
+		env.seed(0);
+		REQUIRE(run_episode(env) == n_steps);
+	}
+}
+
+TEST_CASE("Stopping criteria end branching episodes on cached presolved problems", "[env]") {
+	auto constexpr presolve_cache_size = std::size_t{1};
+	auto env = environment::Branching<observation::Nothing>{
+		{}, {}, {}, {}, false, dynamics::ObservationSchedule{}, presolve_cache_size};
+	auto constexpr max_n_nodes = 3;
+	env.stopping_criterion() = [](scip::Model& model) { return SCIPgetNNodes(model.get_scip_ptr()) >= max_n_nodes; };
+
+	// The second episode reuses the presolved problem of the first one
+	for (auto i = 0; i < 2; ++i) {
+		env.seed(0);
+		run_episode(env);
+		REQUIRE(env.dynamics().n_presolved_cached() == 1);
+		REQUIRE(environment::is_stopped_by_criterion(env.model()));
+		REQUIRE(SCIPgetNNodes(env.model().get_scip_ptr()) <= max_n_nodes + 1);
+	}
+}
+
+TEST_CASE("Stopping criteria end configuring episodes early", "[env]") {
+	auto env = environment::Configuring<observation::Nothing>{};
+	// Any gap holds, so the solving stops on the first event
+	env.stopping_criterion() = environment::gap_below(std::numeric_limits<double>::infinity());
+	env.reset(problem_file);
+	env.step({});
+	REQUIRE(environment::is_stopped_by_criterion(env.model()));
+	REQUIRE(SCIPgetStatus(env.model().get_scip_ptr()) == SCIP_STATUS_USERINTERRUPT);
+}
+
+TEST_CASE("Primal bound stall criterion waits for the given number of nodes", "[env]") {
+	auto env = environment::Branching<observation::Nothing>{};
+	env.stopping_criterion() = environment::primal_bound_stalled(2);
+	run_episode(env);
+	if (environment::is_stopped_by_criterion(env.model())) {
+		REQUIRE(SCIPgetNNodes(env.model().get_scip_ptr()) >= 2);
+	} else {
+		REQUIRE(SCIPgetStatus(env.model().get_scip_ptr()) != SCIP_STATUS_USERINTERRUPT);
+	}
+}
+
+TEST_CASE("Exceptions of stopping criteria are rethrown by the environment", "[env]") {
+	auto env = environment::Branching<observation::Nothing>{};
+	env.stopping_criterion() = [](scip::Model& /*model*/) -> bool { throw std::runtime_error{"Stop"}; };
+	REQUIRE_THROWS_AS(run_episode(env), std::runtime_error);
+
+	SECTION("Environment can be reset after the error") {
+		env.stopping_criterion() = {};
+		REQUIRE_NOTHROW(run_episode(env));
+	}
+}
+
+TEST_CASE("Memory limit ends branching episodes early", "[env]") {
+	auto env = environment::Branching<observation::Nothing>{};
+	env.seed(0);
+	auto const full_n_steps = run_episode(env);
+
+	env.memory_limit() = model_memory(env.model()) / 2;
+	env.seed(0);
+	auto const n_steps = run_episode(env);
+
+	REQUIRE(n_steps < full_n_steps);
+	REQUIRE(SCIPgetStatus(env.model().get_scip_ptr()) == SCIP_STATUS_MEMLIMIT);
+}
@@ -0,0 +1,249 @@
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/environment/vector-environment.hpp"
+#include "ecole/exception.hpp"
+#include "ecole/information/nothing.hpp"
+#include "ecole/instance/abstract.hpp"
+#include "ecole/none.hpp"
+#include "ecole/observation/nothing.hpp"
+#include "ecole/random.hpp"
+#include "ecole/reward/constant.hpp"
+
+#include "conftest.hpp"
+
+/****************************************
+ *  Mocking some classes for unit test  *
+ ****************************************/
+
+namespace {
+
+/**
+ * Dummy dynamics terminating after a number of steps given to reset, one by default.
+ */
+struct CountDownDynamics {
+	using Action = std::size_t;
+
+	std::size_t remaining = 0;
+
+	auto set_dynamics_random_state(ecole::scip::Model& /*model*/, ecole::RandomGenerator& /*rng*/) -> void {}
+
+	auto reset_dynamics(ecole::scip::Model& /*model*/, std::size_t n_steps = 1) -> std::tuple<bool, ecole::NoneType> {
+		remaining = n_steps;
+		return {remaining == 0, ecole::None};
+	}
+
+	auto step_dynamics(ecole::scip::Model& /*model*/, Action const& /*action*/) -> std::tuple<bool, ecole::NoneType> {
+		--remaining;
+		return {remaining == 0, ecole::None};
+	}
+};
+
+/**
+ * Dummy generator reading the test problem, and counting the instances generated.
+ */
+struct CountingGenerator : ecole::instance::InstanceGenerator {
+	std::atomic<std::size_t> n_generated{0};
+
+	auto next() -> ecole::scip::Model override {
+		++n_generated;
+		return get_model();
+	}
+	void seed(ecole::Seed /*seed*/) override {}
+	[[nodiscard]] auto done() const -> bool override { return false; }
+};
+
+/**
+ * Dummy generator reading the test problem, and naming the instances by their order of generation.
+ */
+struct NamingGenerator : ecole::instance::InstanceGenerator {
+	std::size_t n_generated = 0;
+
+	auto next() -> ecole::scip::Model override {
+		auto model = get_model();
+		model.set_name(std::to_string(n_generated++));
+		return model;
+	}
+	void seed(ecole::Seed /*seed*/) override {}
+	[[nodiscard]] auto done() const -> bool override { return false; }
+};
+
+using VecEnv = ecole::environment::VectorEnvironment<
+	CountDownDynamics,
+	ecole::observation::Nothing,
+	ecole::reward::Constant,
+	ecole::information::Nothing>;
+
+}  // namespace
+
+/****************************
+ *  Test VectorEnvironment  *
+ ****************************/
+
+using namespace ecole;
+
+TEST_CASE("Vector environments step all environments", "[env]") {
+	auto constexpr n_envs = std::size_t{4};
+	auto constexpr n_steps = std::size_t{3};
+	auto env = VecEnv{n_envs};
+	auto const instances = std::vector<std::string>(n_envs, problem_file);
+	auto const actions = std::vector<std::size_t>(n_envs, 0);
+
+	SECTION("Reset returns one entry per environment") {
+		auto [obs, action_sets, rewards, dones, infos] = env.reset(instances, n_steps);
+		REQUIRE(obs.size() == n_envs);
+		REQUIRE(action_sets.size() == n_envs);
+		REQUIRE(rewards.size() == n_envs);
+		REQUIRE(dones == std::vector<bool>(n_envs, false));
+		REQUIRE(infos.size() == n_envs);
+	}
+
+	SECTION("Run full episodes") {
+		auto [obs, action_sets, rewards, dones, infos] = env.reset(instances, n_steps);
+		for (std::size_t i = 0; i < n_steps; ++i) {
+			std::tie(obs, action_sets, rewards, dones, infos) = env.step(actions);
+		}
+		REQUIRE(dones == std::vector<bool>(n_envs, true));
+		for (std::size_t i = 0; i < n_envs; ++i) {
+			REQUIRE(env.done(i));
+		}
+	}
+
+	SECTION("Terminated environments are not stepped") {
+		env.reset(instances, n_steps);
+		for (std::size_t i = 0; i < n_steps + 2; ++i) {
+			auto const dones = std::get<3>(env.step(actions));
+			REQUIRE(dones == std::vector<bool>(n_envs, i + 1 >= n_steps));
+		}
+	}
+
+	SECTION("Mismatching batch sizes are rejected") {
+		REQUIRE_THROWS_AS(env.reset(std::vector<std::string>(n_envs + 1, problem_file), n_steps), std::invalid_argument);
+		env.reset(instances, n_steps);
+		REQUIRE_THROWS_AS(env.step(std::vector<std::size_t>(n_envs - 1, 0)), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Vector environments reset terminated environments on the next step", "[env]") {
+	auto constexpr n_envs = std::size_t{3};
+	auto env = VecEnv{n_envs};
+	auto const actions = std::vector<std::size_t>(n_envs, 0);
+	auto const instances = std::vector<std::string>(n_envs, problem_file);
+
+	SECTION("Environments never reset are all reset") {
+		auto const dones = std::get<3>(env.step_or_reset(actions, instances, std::size_t{1}));
+		REQUIRE(dones == std::vector<bool>(n_envs, false));
+	}
+
+	SECTION("Only terminated environments are reset") {
+		env.reset(instances, std::size_t{2});
+		env.environment(1).step(0);
+		auto dones = std::get<3>(env.step(actions));
+		REQUIRE(dones == std::vector<bool>{false, true, false});
+		dones = std::get<3>(env.step_or_reset(actions, std::vector<std::string>{problem_file}, std::size_t{2}));
+		REQUIRE(dones == std::vector<bool>{true, false, true});
+		REQUIRE_FALSE(env.done(1));
+	}
+
+	SECTION("One instance is needed per terminated environment") {
+		REQUIRE_THROWS_AS(env.step_or_reset(actions, std::vector<std::string>{}, std::size_t{1}), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Vector environments collect asynchronous transitions as they complete", "[env]") {
+	auto constexpr n_envs = std::size_t{3};
+	auto constexpr n_steps = std::size_t{2};
+	auto env = VecEnv{n_envs};
+
+	for (std::size_t i = 0; i < n_envs; ++i) {
+		env.reset_async(i, std::string{problem_file}, n_steps);
+	}
+	REQUIRE(env.n_pending() == n_envs);
+	REQUIRE_THROWS_AS(env.step_async(0, 0), MarkovError);
+	REQUIRE_THROWS_AS(env.step(std::vector<std::size_t>(n_envs, 0)), MarkovError);
+
+	auto seen = std::vector<bool>(n_envs, false);
+	while (env.n_pending() > 0) {
+		auto [i, transition] = env.wait_any();
+		REQUIRE_FALSE(std::get<3>(transition));
+		seen[i] = true;
+	}
+	REQUIRE(seen == std::vector<bool>(n_envs, true));
+	REQUIRE_THROWS_AS(env.wait_any(), MarkovError);
+
+	env.step_async(1, 0);
+	auto const [i, transition] = env.wait_any();
+	REQUIRE(i == 1);
+	REQUIRE_FALSE(env.done(1));
+}
+
+TEST_CASE("Vector environments reset terminated environments in the background", "[env]") {
+	auto constexpr n_envs = std::size_t{3};
+	auto env = VecEnv{n_envs};
+	auto const actions = std::vector<std::size_t>(n_envs, 0);
+	auto generator = std::make_shared<CountingGenerator>();
+
+	SECTION("Resetting without instances needs a generator") {
+		REQUIRE_THROWS_AS(env.reset(), MarkovError);
+	}
+
+	env.set_auto_reset(generator);
+	REQUIRE(env.auto_reset());
+
+	SECTION("Environments never reset start an episode immediately") {
+		auto const dones = std::get<3>(env.step(actions));
+		REQUIRE(dones == std::vector<bool>(n_envs, false));
+		REQUIRE(generator->n_generated.load() == n_envs);
+	}
+
+	SECTION("Terminated environments return their new episode on the next step") {
+		auto dones = std::get<3>(env.reset());
+		REQUIRE(dones == std::vector<bool>(n_envs, false));
+		// Episodes of one step terminate on every other step, and are reset in between
+		for (std::size_t i = 0; i < 4; ++i) {
+			dones = std::get<3>(env.step(actions));
+			REQUIRE(dones == std::vector<bool>(n_envs, i % 2 == 0));
+		}
+		// The first reset and the two automatic ones pulled an instance per environment
+		REQUIRE(generator->n_generated.load() == 3 * n_envs);
+	}
+
+	SECTION("Environments being reset are not transitioned asynchronously") {
+		env.reset();
+		env.step(actions);
+		REQUIRE_THROWS_AS(env.step_async(0, 0), MarkovError);
+	}
+
+	SECTION("Explicit resets discard automatic resets") {
+		env.reset();
+		env.step(actions);
+		auto const dones = std::get<3>(env.reset(std::vector<std::string>(n_envs, problem_file), std::size_t{2}));
+		REQUIRE(dones == std::vector<bool>(n_envs, false));
+		REQUIRE(std::get<3>(env.step(actions)) == std::vector<bool>(n_envs, false));
+	}
+
+	SECTION("Environments draw instances in their order") {
+		auto naming_generator = std::make_shared<NamingGenerator>();
+		env.set_auto_reset(naming_generator);
+		env.reset();
+		// After the discarded automatic resets and the explicit reset, the first step starts resets on the last instances
+		env.step(actions);
+		env.step(actions);
+		for (std::size_t i = 0; i < n_envs; ++i) {
+			REQUIRE(env.environment(i).model().name() == std::to_string(2 * n_envs + i));
+		}
+	}
+
+	SECTION("Disabling automatic resets leaves terminated environments done") {
+		env.reset();
+		env.step(actions);
+		env.set_auto_reset(nullptr);
+		REQUIRE(std::get<3>(env.step(actions)) == std::vector<bool>(n_envs, true));
+	}
+}
@@ -0,0 +1,47 @@
+#include <tuple>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/dynamics/branching.hpp"
+#include "ecole/information/performance-counters.hpp"
+#include "ecole/traits.hpp"
+
+#include "conftest.hpp"
+
+using namespace ecole;
+
+TEST_CASE("PerformanceCounters is an information function", "[information]") {
+	STATIC_REQUIRE(trait::is_information_function_v<information::PerformanceCounters>);
+}
+
+TEST_CASE("PerformanceCounters are zero before iterative solving", "[information]") {
+	auto info_func = information::PerformanceCounters{};
+	auto model = get_model();
+	info_func.before_reset(model);
+	auto const info = info_func.extract(model);
+	REQUIRE(info.at("n_yields") == 0);
+	REQUIRE(info.at("waiting_time") == 0);
+	REQUIRE(info.at("time_since_yield") == 0);
+}
+
+TEST_CASE("PerformanceCounters accumulate over an episode", "[information]") {
+	auto info_func = information::PerformanceCounters{};
+	auto dynamics = dynamics::BranchingDynamics{};
+	auto model = get_model();
+	info_func.before_reset(model);
+	auto [done, action_set] = dynamics.reset_dynamics(model);
+	auto n_yields = done ? 0 : 1;
+	for (auto n_steps = 0; !done && n_steps < 5; ++n_steps) {
+		std::tie(done, action_set) = dynamics.step_dynamics(model, action_set.value()[0]);
+		n_yields += done ? 0 : 1;
+	}
+
+	auto const info = info_func.extract(model, done);
+	REQUIRE(info.at("n_yields") == n_yields);
+	REQUIRE(info.at("n_skipped_calls") >= 0);
+	REQUIRE(info.at("n_missed_deadlines") == 0);
+	REQUIRE(info.at("solving_time") > 0);
+	REQUIRE(info.at("waiting_time") > 0);
+	REQUIRE(info.at("caller_time") > 0);
+	REQUIRE(info.at("time_since_yield") >= 0);
+}
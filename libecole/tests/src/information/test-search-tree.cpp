@@ -0,0 +1,97 @@
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+
+#include "ecole/information/search-tree.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/traits.hpp"
+
+#include "conftest.hpp"
+#include "test-utility/tmp-folder.hpp"
+
+using namespace ecole;
+
+TEST_CASE("SearchTreeRecorder is an information function", "[information]") {
+	STATIC_REQUIRE(trait::is_information_function_v<information::SearchTreeRecorder>);
+}
+
+TEST_CASE("SearchTreeRecorder does not include its handler while solving", "[information]") {
+	auto info_func = information::SearchTreeRecorder{[](auto const& /*record*/) {}};
+	auto model = get_model();
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const n_eventhdlrs = SCIPgetNEventhdlrs(model.get_scip_ptr());
+	REQUIRE(info_func.extract(model, false).empty());
+	REQUIRE(SCIPgetNEventhdlrs(model.get_scip_ptr()) == n_eventhdlrs);
+}
+
+TEST_CASE("SearchTreeRecorder streams the solved nodes", "[information][slow]") {
+	auto records = std::vector<information::SearchTreeRecord>{};
+	auto info_func = information::SearchTreeRecorder{[&records](auto const& record) { records.push_back(record); }};
+	auto model = get_model();
+	info_func.before_reset(model);
+	model.solve();
+	auto const info = info_func.extract(model, true);
+
+	REQUIRE(info.at("n_records") == static_cast<double>(records.size()));
+	REQUIRE(records.size() <= static_cast<std::size_t>(SCIPgetNNodes(model.get_scip_ptr())));
+	REQUIRE(records.front().number == 1);
+	REQUIRE(records.front().parent == 0);
+	REQUIRE(records.front().branching_var == -1);
+
+	// Every node other than the root was created by branching on a recorded parent
+	auto depths = std::map<std::int64_t, std::int32_t>{};
+	for (auto const& record : records) {
+		depths[record.number] = record.depth;
+	}
+	for (auto const& record : records) {
+		if (record.parent != 0 && depths.count(record.parent) > 0) {
+			REQUIRE(record.depth == depths[record.parent] + 1);
+			REQUIRE(record.branching_var >= 0);
+			REQUIRE(record.lower_bound <= record.primal_bound + 1e-6);  // NOLINT(readability-magic-numbers)
+		}
+		REQUIRE(record.lp_iterations >= 0);
+	}
+}
+
+TEST_CASE("SearchTreeReader reads the records written", "[information][slow]") {
+	auto const tmp = TmpFolderRAII{};
+	auto const filename = tmp.make_subpath(".tree");
+	auto records = std::vector<information::SearchTreeRecord>{};
+	{
+		auto info_func = information::SearchTreeRecorder{filename};
+		auto model = get_model();
+		auto collect = information::SearchTreeRecorder{[&records](auto const& record) { records.push_back(record); }};
+		info_func.before_reset(model);
+		model.set_param("limits/totalnodes", 50);  // NOLINT(readability-magic-numbers)
+		model.solve();
+		info_func.extract(model, true);
+		// A second model replays the same solve to compare with the records in memory
+		auto copy = get_model();
+		collect.before_reset(copy);
+		copy.set_param("limits/totalnodes", 50);  // NOLINT(readability-magic-numbers)
+		copy.solve();
+	}
+
+	auto const reader = information::SearchTreeReader{filename};
+	REQUIRE(reader.size() == records.size());
+	auto const read = reader.read_all();
+	for (std::size_t i = 0; i < read.size(); ++i) {
+		REQUIRE(read[i].number == records[i].number);
+		REQUIRE(read[i].parent == records[i].parent);
+		REQUIRE(read[i].outcome == records[i].outcome);
+		REQUIRE(read[i].branching_var == records[i].branching_var);
+	}
+	REQUIRE(reader.read(0).number == 1);
+	REQUIRE_THROWS_AS(reader.read(reader.size()), std::out_of_range);
+}
+
+TEST_CASE("SearchTreeReader rejects other files", "[information]") {
+	auto const tmp = TmpFolderRAII{};
+	REQUIRE_THROWS_AS(information::SearchTreeReader{tmp.make_subpath(".tree")}, std::runtime_error);
+	REQUIRE_THROWS_AS(information::SearchTreeReader{problem_file}, std::runtime_error);
+}
@@ -0,0 +1,69 @@
+#include <algorithm>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/information/solver-statistics.hpp"
+#include "ecole/traits.hpp"
+
+#include "conftest.hpp"
+
+using namespace ecole;
+
+TEST_CASE("SolverStatistics is an information function", "[information]") {
+	STATIC_REQUIRE(trait::is_information_function_v<information::SolverStatistics>);
+}
+
+TEST_CASE("SolverStatistics are zero before presolving", "[information]") {
+	auto info_func = information::SolverStatistics{};
+	auto model = get_model();
+	info_func.before_reset(model);
+	auto const info = info_func.extract(model);
+	REQUIRE(info.at("n_nodes") == 0);
+	REQUIRE(info.at("n_lp_iterations") == 0);
+	REQUIRE(info.at("n_cuts_found") == 0);
+}
+
+TEST_CASE("SolverStatistics collect the requested statistics", "[information]") {
+	auto model = get_model();
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	SECTION("Default statistics") {
+		auto info_func = information::SolverStatistics{};
+		auto const data = info_func.collect(model);
+		REQUIRE(data.n_nodes == 1);
+		REQUIRE(data.n_lp_iterations > 0);
+		REQUIRE(data.n_root_lp_iterations <= data.n_lp_iterations);
+		REQUIRE(data.n_cuts_applied <= data.n_cuts_found);
+		REQUIRE(data.solving_time > 0);
+		REQUIRE(data.plugin_times.empty());
+
+		auto const info = info_func.extract(model);
+		REQUIRE(info.at("n_nodes") == 1);
+		REQUIRE(info.at("n_lp_iterations") == static_cast<double>(data.n_lp_iterations));
+		REQUIRE(info.count("time/heuristic/rounding") == 0);
+	}
+
+	SECTION("Only some groups of statistics") {
+		auto params = information::SolverStatistics::Parameters{};
+		params.lp_iterations = false;
+		params.cuts = false;
+		auto info_func = information::SolverStatistics{params};
+		REQUIRE(info_func.collect(model).n_lp_iterations == 0);
+		auto const info = info_func.extract(model);
+		REQUIRE(info.count("n_nodes") == 1);
+		REQUIRE(info.count("n_lp_iterations") == 0);
+		REQUIRE(info.count("n_cuts_found") == 0);
+	}
+
+	SECTION("Plugin times") {
+		auto params = information::SolverStatistics::Parameters{};
+		params.plugin_times = true;
+		auto info_func = information::SolverStatistics{params};
+		auto const data = info_func.collect(model);
+		REQUIRE(!data.plugin_times.empty());
+		auto const all_positive = [](auto const& plugin_time) { return plugin_time.second >= 0; };
+		REQUIRE(std::all_of(data.plugin_times.begin(), data.plugin_times.end(), all_positive));
+		REQUIRE(info_func.extract(model).count("time/heuristic/rounding") == 1);
+	}
+}
@@ -0,0 +1,129 @@
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/instance/cache.hpp"
+#include "ecole/scip/exception.hpp"
+
+#include "conftest.hpp"
+#include "test-utility/tmp-folder.hpp"
+
+using namespace ecole;
+
+TEST_CASE("InstanceCache returns copies of the instance", "[instance]") {
+	auto cache = instance::InstanceCache{};
+	auto const original = scip::Model::from_file(problem_file);
+
+	auto model = cache.get(problem_file);
+	REQUIRE(model.variables().size() == original.variables().size());
+	REQUIRE(cache.size() == 1);
+	REQUIRE(cache.n_templates(problem_file) == 1);
+	REQUIRE(cache.n_nonzeros() > original.variables().size());
+
+	SECTION("Reuse templates across calls") {
+		auto other = cache.get(problem_file);
+		REQUIRE(other != model);
+		REQUIRE(cache.n_templates(problem_file) == 1);
+	}
+
+	SECTION("Copies can be solved independently") {
+		model.solve();
+		auto other = cache.get(problem_file);
+		REQUIRE(model.is_solved());
+		REQUIRE_FALSE(other.is_solved());
+	}
+
+	SECTION("Clear the cache") {
+		cache.clear();
+		REQUIRE(cache.size() == 0);
+		REQUIRE(cache.n_templates(problem_file) == 0);
+		REQUIRE(cache.n_nonzeros() == 0);
+	}
+}
+
+TEST_CASE("InstanceCache evicts least recently used instances", "[instance]") {
+	auto const tmp = TmpFolderRAII{};
+	auto model = get_model();
+	auto const file_1 = tmp.make_subpath(".mps").string();
+	auto const file_2 = tmp.make_subpath(".mps").string();
+	model.write_problem(file_1);
+	model.write_problem(file_2);
+	auto const instance_nonzeros = [&] {
+		auto cache = instance::InstanceCache{};
+		cache.get(file_1);
+		return cache.n_nonzeros();
+	}();
+
+	SECTION("Keep instances within the bound") {
+		auto cache = instance::InstanceCache{2 * instance_nonzeros};
+		cache.get(file_1);
+		cache.get(file_2);
+		REQUIRE(cache.size() == 2);
+		REQUIRE(cache.n_nonzeros() == 2 * instance_nonzeros);
+	}
+
+	SECTION("Drop the least recently used instance") {
+		auto cache = instance::InstanceCache{instance_nonzeros};
+		cache.get(file_1);
+		cache.get(file_2);
+		REQUIRE(cache.size() == 1);
+		REQUIRE(cache.n_templates(file_1) == 0);
+		REQUIRE(cache.n_templates(file_2) == 1);
+		REQUIRE(cache.n_nonzeros() == instance_nonzeros);
+	}
+
+	SECTION("Do not keep instances larger than the bound") {
+		auto cache = instance::InstanceCache{instance_nonzeros - 1};
+		REQUIRE(cache.get(file_1).variables().size() == model.variables().size());
+		REQUIRE(cache.size() == 0);
+		REQUIRE(cache.n_nonzeros() == 0);
+	}
+}
+
+TEST_CASE("InstanceCache reads modified files again", "[instance]") {
+	auto const tmp = TmpFolderRAII{};
+	auto const filename = tmp.make_subpath(".mps");
+	auto model = get_model();
+	model.set_name("before");
+	model.write_problem(filename);
+
+	auto cache = instance::InstanceCache{};
+	REQUIRE(cache.get(filename.string()).name() == "before");
+	model.set_name("after");
+	model.write_problem(filename);
+	// File times can be too coarse to notice a rewrite
+	std::filesystem::last_write_time(filename, std::filesystem::last_write_time(filename) + std::chrono::seconds{1});
+	REQUIRE(cache.get(filename.string()).name() == "after");
+	REQUIRE(cache.n_templates(filename.string()) == 1);
+}
+
+TEST_CASE("InstanceCache does not cache missing files", "[instance]") {
+	auto cache = instance::InstanceCache{};
+	REQUIRE_THROWS_AS(cache.get("/does_not_exist.mps"), scip::ScipError);
+	REQUIRE(cache.size() == 0);
+}
+
+TEST_CASE("InstanceCache can be used concurrently", "[instance][slow]") {
+	auto cache = instance::InstanceCache{};
+	auto const n_vars = scip::Model::from_file(problem_file).variables().size();
+	auto get_many = [&cache, n_vars] {
+		for (auto i = 0; i < 5; ++i) {
+			if (cache.get(problem_file).variables().size() != n_vars) {
+				return false;
+			}
+		}
+		return true;
+	};
+	auto futures = std::vector<std::future<bool>>{};
+	for (auto i = 0; i < 4; ++i) {
+		futures.push_back(std::async(std::launch::async, get_many));
+	}
+	for (auto& fut : futures) {
+		REQUIRE(fut.get());
+	}
+	REQUIRE(cache.n_templates(problem_file) >= 1);
+	REQUIRE(cache.n_templates(problem_file) <= 4);
+}
@@ -0,0 +1,72 @@
+#include <cstddef>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/exception.hpp"
+#include "ecole/instance/dataset.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "conftest.hpp"
+#include "instance/unit-tests.hpp"
+#include "test-utility/tmp-folder.hpp"
+
+using namespace ecole;
+
+namespace {
+
+auto read_file(std::filesystem::path const& path) -> std::string {
+	auto file = std::ifstream{path};
+	return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+/** A generator that is immediately exhausted. */
+class EmptyGenerator : public instance::InstanceGenerator {
+public:
+	auto next() -> scip::Model override { throw IteratorExhausted{}; }
+	void seed(Seed /*seed*/) override {}
+	[[nodiscard]] auto done() const -> bool override { return true; }
+};
+
+}  // namespace
+
+TEST_CASE("Write a dataset of instances", "[instance]") {
+	auto const tmp = TmpFolderRAII{};
+	std::size_t constexpr n_instances = 5;
+	auto const paths =
+		instance::write_dataset(instance::make_set_cover, n_instances, 3, tmp.dir() / "sequential", "mps", 1);
+	REQUIRE(paths.size() == n_instances);
+
+	SECTION("Files can be read back") {
+		for (auto const& path : paths) {
+			REQUIRE(std::filesystem::exists(path));
+			REQUIRE(scip::Model::from_file(path).variables().size() == 100);
+		}
+	}
+
+	SECTION("Files do not depend on the number of threads") {
+		auto const parallel_paths =
+			instance::write_dataset(instance::make_set_cover, n_instances, 3, tmp.dir() / "parallel", "mps", 3);
+		for (std::size_t i = 0; i < n_instances; ++i) {
+			REQUIRE(read_file(paths[i]) == read_file(parallel_paths[i]));
+		}
+	}
+
+	SECTION("Files differ between instances and seeds") {
+		auto const other_paths = instance::write_dataset(instance::make_set_cover, 1, 4, tmp.dir() / "other", "mps", 1);
+		REQUIRE(read_file(paths[0]) != read_file(paths[1]));
+		REQUIRE(read_file(paths[0]) != read_file(other_paths[0]));
+	}
+}
+
+TEST_CASE("Exhausted generators fail to write a dataset", "[instance]") {
+	auto const tmp = TmpFolderRAII{};
+	auto const make_empty = []() -> std::unique_ptr<instance::InstanceGenerator> {
+		return std::make_unique<EmptyGenerator>();
+	};
+	REQUIRE_THROWS_AS(instance::write_dataset(make_empty, 2, 0, tmp.dir(), "mps", 2), std::invalid_argument);
+}
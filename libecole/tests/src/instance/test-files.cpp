@@ -1,5 +1,13 @@
 #include <algorithm>
 #include <array>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <iterator>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
 
 #include <catch2/catch.hpp>
 
@@ -58,8 +66,9 @@ TEST_CASE("FileGenerator properly iterate over files", "[instance]") {
 	auto const nested_dirs = GENERATE(true, false);
 	auto const recursive = GENERATE(true, false);
 	auto const sampling_mode = GENERATE(SamplingMode::replace, SamplingMode::remove, SamplingMode::remove_and_repeat);
+	auto const n_prefetch = GENERATE(std::size_t{0}, std::size_t{2});
 	auto const instances_raii = InstanceDatasetRAII{nested_dirs};
-	auto generator = instance::FileGenerator{{instances_raii.dir(), recursive, sampling_mode}};
+	auto generator = instance::FileGenerator{{instances_raii.dir(), recursive, sampling_mode, n_prefetch}};
 
 	if (nested_dirs && !recursive) {
 		SECTION("Throw exception when no files are found") {
@@ -96,3 +105,175 @@ TEST_CASE("FileGenerator properly iterate over files", "[instance]") {
 		}
 	}
 }
+
+TEST_CASE("FileGenerator prefetching does not change the files sampled", "[instance]") {
+	using SamplingMode = instance::FileGenerator::Parameters::SamplingMode;
+	auto const sampling_mode = GENERATE(SamplingMode::replace, SamplingMode::remove_and_repeat);
+	// A limit of one byte prefetches a single file at a time
+	auto const size_limit = GENERATE(std::uintmax_t{1}, std::uintmax_t{1} << 30);
+	auto const instances_raii = InstanceDatasetRAII{};
+	auto constexpr n_files = 2 * InstanceDatasetRAII::names.size();
+	// NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
+	auto const rng = RandomGenerator{};
+
+	auto generator = instance::FileGenerator{{instances_raii.dir(), true, sampling_mode, 0}, rng};
+	auto prefetching = instance::FileGenerator{{instances_raii.dir(), true, sampling_mode, 3, size_limit}, rng};
+	auto const names = collect_names<n_files>(generator);
+	REQUIRE(collect_names<n_files>(prefetching) == names);
+
+	SECTION("Copies prefetch the same files") {
+		prefetching.seed(0);
+		prefetching.next();
+		auto copy = prefetching;
+		REQUIRE(collect_names<n_files>(copy) == collect_names<n_files>(prefetching));
+	}
+
+	SECTION("Restored generators sample the same files") {
+		prefetching.seed(0);
+		prefetching.next();
+		auto const state = prefetching.save_state();
+		auto restored = instance::FileGenerator{{instances_raii.dir(), true, sampling_mode, 3, size_limit}};
+		restored.load_state(state);
+		REQUIRE(collect_names<n_files>(restored) == collect_names<n_files>(prefetching));
+		REQUIRE_THROWS_AS(generator.load_state(state), std::invalid_argument);
+	}
+}
+
+TEST_CASE("FileGenerator caching does not change the models", "[instance]") {
+	auto const n_prefetch = GENERATE(std::size_t{0}, std::size_t{2});
+	auto const instances_raii = InstanceDatasetRAII{};
+	auto constexpr n_files = 2 * InstanceDatasetRAII::names.size();
+	// NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
+	auto const rng = RandomGenerator{};
+	using SamplingMode = instance::FileGenerator::Parameters::SamplingMode;
+	auto const max_nonzeros = std::numeric_limits<std::size_t>::max();
+
+	auto generator = instance::FileGenerator{{instances_raii.dir(), true, SamplingMode::replace, n_prefetch}, rng};
+	auto caching = instance::FileGenerator{
+		{instances_raii.dir(), true, SamplingMode::replace, n_prefetch, std::uintmax_t{1} << 30, max_nonzeros}, rng};
+	REQUIRE(collect_names<n_files>(caching) == collect_names<n_files>(generator));
+}
+
+TEST_CASE("FileGenerator reads snapshots of the files", "[instance]") {
+	auto const n_prefetch = GENERATE(std::size_t{0}, std::size_t{2});
+	auto const instances_raii = InstanceDatasetRAII{};
+	auto const snapshots_raii = TmpFolderRAII{};
+	auto constexpr n_files = 2 * InstanceDatasetRAII::names.size();
+	// NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
+	auto const rng = RandomGenerator{};
+	using SamplingMode = instance::FileGenerator::Parameters::SamplingMode;
+	auto params = instance::FileGenerator::Parameters{instances_raii.dir(), true, SamplingMode::replace, n_prefetch};
+	auto generator = instance::FileGenerator{params, rng};
+	params.snapshot_directory = snapshots_raii.dir().string();
+	auto snapshotting = instance::FileGenerator{params, rng};
+
+	auto const names = collect_names<n_files>(generator);
+	REQUIRE(collect_names<n_files>(snapshotting) == names);
+	auto const n_snapshots = std::distance(
+		std::filesystem::directory_iterator{snapshots_raii.dir()}, std::filesystem::directory_iterator{});
+	REQUIRE(n_snapshots > 0);
+	REQUIRE(n_snapshots <= static_cast<std::ptrdiff_t>(InstanceDatasetRAII::names.size()));
+
+	SECTION("Other generators read the same snapshots") {
+		auto other = instance::FileGenerator{params, rng};
+		REQUIRE(collect_names<n_files>(other) == names);
+	}
+}
+
+TEST_CASE("FileGenerator reads the files of a manifest", "[instance]") {
+	auto const n_prefetch = GENERATE(std::size_t{0}, std::size_t{2});
+	auto const instances_raii = InstanceDatasetRAII{true};
+	auto const manifest_raii = TmpFolderRAII{};
+	auto constexpr n_files = 2 * InstanceDatasetRAII::names.size();
+	// NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
+	auto const rng = RandomGenerator{};
+	using SamplingMode = instance::FileGenerator::Parameters::SamplingMode;
+	auto params = instance::FileGenerator::Parameters{instances_raii.dir(), true, SamplingMode::replace, n_prefetch};
+	auto generator = instance::FileGenerator{params, rng};
+
+	auto const manifest = manifest_raii.make_subpath(".tsv");
+	instance::write_manifest(manifest, instance::scan_manifest(instances_raii.dir()));
+	params.directory = "does-not-exist";
+	params.manifest = manifest.string();
+	auto from_manifest = instance::FileGenerator{params, rng};
+	REQUIRE(collect_names<n_files>(from_manifest) == collect_names<n_files>(generator));
+
+	SECTION("States are the same as when scanning the directory") {
+		auto restored = instance::FileGenerator{params};
+		restored.load_state(generator.save_state());
+		REQUIRE(collect_names<n_files>(restored) == collect_names<n_files>(generator));
+	}
+}
+
+TEST_CASE("FileGenerator samples batches of files of similar cost", "[instance]") {
+	using SamplingMode = instance::FileGenerator::Parameters::SamplingMode;
+	auto const sampling_mode = GENERATE(SamplingMode::replace, SamplingMode::remove, SamplingMode::remove_and_repeat);
+	auto const n_prefetch = GENERATE(std::size_t{0}, std::size_t{2});
+	auto const instances_raii = InstanceDatasetRAII{};
+	auto const manifest_raii = TmpFolderRAII{};
+	auto constexpr n_files = InstanceDatasetRAII::names.size();
+
+	// The files of the first half of the names are cheaper than the others
+	auto entries = instance::scan_manifest(instances_raii.dir());
+	auto cheap_names = std::vector<std::string>{};
+	for (std::size_t i = 0; i < entries.size(); ++i) {
+		entries[i].cost = static_cast<double>(i);
+		if (i < n_files / 2) {
+			cheap_names.push_back(scip::Model::from_file(entries[i].path).name());
+		}
+	}
+	auto const manifest = manifest_raii.make_subpath(".tsv");
+	instance::write_manifest(manifest, entries);
+	auto params = instance::FileGenerator::Parameters{instances_raii.dir(), true, sampling_mode, n_prefetch};
+	params.manifest = manifest.string();
+	params.n_buckets = 2;
+	params.bucket_batch_size = n_files / 2;
+	auto generator = instance::FileGenerator{params};
+
+	auto const is_cheap = [&cheap_names](auto const& name) { return is_subset(std::array{name}, cheap_names); };
+	for (auto i = 0; i < 4; ++i) {
+		auto const batch = collect_names<n_files / 2>(generator);
+		REQUIRE(std::all_of(begin(batch), end(batch), is_cheap) == is_cheap(batch.front()));
+		REQUIRE(std::any_of(begin(batch), end(batch), is_cheap) == is_cheap(batch.front()));
+		if (sampling_mode == SamplingMode::remove && i == 1) {
+			REQUIRE(generator.done());
+			break;
+		}
+	}
+
+	SECTION("Restored generators sample the same files") {
+		auto restored = instance::FileGenerator{params};
+		restored.load_state(generator.save_state());
+		if (!generator.done()) {
+			REQUIRE(collect_names<n_files>(restored) == collect_names<n_files>(generator));
+		}
+	}
+}
+
+TEST_CASE("FileGenerator samples disjoint shards of the files", "[instance]") {
+	auto const instances_raii = InstanceDatasetRAII{};
+	auto constexpr world_size = std::size_t{2};
+	auto constexpr n_shard_files = InstanceDatasetRAII::names.size() / world_size;
+	using SamplingMode = instance::FileGenerator::Parameters::SamplingMode;
+	auto params = instance::FileGenerator::Parameters{instances_raii.dir(), true, SamplingMode::remove};
+	params.world_size = world_size;
+
+	auto all_names = std::vector<std::string>{};
+	for (std::size_t rank = 0; rank < world_size; ++rank) {
+		params.rank = rank;
+		auto generator = instance::FileGenerator{params};
+		auto const names = collect_names<n_shard_files>(generator);
+		REQUIRE(generator.done());
+		all_names.insert(all_names.end(), names.begin(), names.end());
+	}
+	// Shards have as many files as there are names in total, so they are disjoint
+	REQUIRE(is_same_set(all_names, InstanceDatasetRAII::names));
+
+	SECTION("Ranks must be smaller than the world size") {
+		params.rank = world_size;
+		REQUIRE_THROWS_AS(instance::FileGenerator{params}, std::invalid_argument);
+		params.rank = 0;
+		params.world_size = 0;
+		REQUIRE_THROWS_AS(instance::FileGenerator{params}, std::invalid_argument);
+	}
+}
@@ -0,0 +1,78 @@
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/exception.hpp"
+#include "ecole/instance/filtered.hpp"
+
+#include "conftest.hpp"
+#include "instance/unit-tests.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Probe statistics describe the root node", "[instance]") {
+	auto const model = get_model();
+	auto const stats = instance::ProbeStatistics::probe(model, 10.);
+	REQUIRE(model.stage() == SCIP_STAGE_PROBLEM);
+	REQUIRE(stats.n_vars > 0);
+	REQUIRE(stats.n_cons > 0);
+	REQUIRE(stats.gap >= 0.);
+	REQUIRE(stats.solving_time >= 0.);
+
+	auto range = instance::ProbeRange{};
+	REQUIRE(range.contains(stats) == !stats.solved);
+	range.keep_solved = true;
+	range.max_lp_iterations = stats.n_lp_iterations;
+	range.max_gap = stats.gap;
+	REQUIRE(range.contains(stats));
+	if (!stats.solved) {
+		range.min_lp_iterations = stats.n_lp_iterations + 1;
+		REQUIRE_FALSE(range.contains(stats));
+	}
+}
+
+TEST_CASE("FilteredGenerator only keeps instances in range", "[instance]") {
+	auto range = instance::ProbeRange{};
+	range.keep_solved = true;
+	range.min_lp_iterations = 1;
+	auto generator = instance::FilteredGenerator{instance::make_set_cover, range, 2, 1, 1000, RandomGenerator{0}};
+	REQUIRE(generator.n_threads() == 2);
+	for (std::size_t i = 0; i < 3; ++i) {
+		auto const model = generator.next();
+		REQUIRE(range.contains(instance::ProbeStatistics::probe(model, range.time_limit)));
+	}
+	REQUIRE(generator.n_probed() >= 3);
+	REQUIRE(generator.n_rejected() <= generator.n_probed());
+
+	// The sequence only depends on the seed
+	auto other = instance::FilteredGenerator{instance::make_set_cover, range, 2, 2, 1000, RandomGenerator{0}};
+	generator.seed(0);
+	other.seed(0);
+	for (std::size_t i = 0; i < 3; ++i) {
+		REQUIRE(instance::same_problem_permutation(generator.next(), other.next()));
+	}
+}
+
+TEST_CASE("FilteredGenerator fails on out of reach ranges", "[instance]") {
+	auto range = instance::ProbeRange{};
+	range.keep_solved = false;
+	range.min_lp_iterations = 1;
+	range.max_lp_iterations = 0;
+	auto generator = instance::FilteredGenerator{instance::make_set_cover, range, 1, 1, 3, RandomGenerator{0}};
+	REQUIRE_THROWS_AS(generator.next(), std::runtime_error);
+	REQUIRE_THROWS_AS(instance::FilteredGenerator(instance::make_set_cover, range, 1, 1, 0), std::invalid_argument);
+}
+
+TEST_CASE("FilteredGenerator is exhausted with its generators", "[instance]") {
+	auto range = instance::ProbeRange{};
+	range.keep_solved = true;
+	auto const make_finite = [] { return std::make_unique<instance::FiniteGenerator>(2); };
+	auto generator = instance::FilteredGenerator{make_finite, range, 1, 1, 1000, RandomGenerator{0}};
+	generator.next();
+	generator.next();
+	REQUIRE(generator.done());
+	REQUIRE_THROWS_AS(generator.next(), IteratorExhausted);
+}
@@ -0,0 +1,64 @@
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/instance/manifest.hpp"
+
+#include "conftest.hpp"
+#include "test-utility/tmp-folder.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Manifests list the problem files of a directory", "[instance]") {
+	auto const tmp_raii = TmpFolderRAII{};
+	auto const directory = tmp_raii.dir() / "problems";
+	std::filesystem::create_directories(directory / "nested");
+	auto model = get_model();
+	model.write_problem(directory / "a.lp");
+	model.write_problem(directory / "nested" / "b.lp");
+
+	REQUIRE(instance::scan_manifest(directory, false).size() == 1);
+	auto const entries = instance::scan_manifest(directory, true, true, 2);
+	REQUIRE(entries.size() == 2);
+	REQUIRE(entries[0].path < entries[1].path);
+	for (auto const& entry : entries) {
+		REQUIRE(entry.size == std::filesystem::file_size(entry.path));
+		REQUIRE(entry.n_nonzeros == model.nnz());
+		REQUIRE(entry.fingerprint == model.fingerprint());
+	}
+
+	SECTION("Read what was written") {
+		auto const manifest = tmp_raii.dir() / "manifest.tsv";
+		instance::write_manifest(manifest, entries);
+		auto const read = instance::read_manifest(manifest);
+		REQUIRE(read.size() == entries.size());
+		for (std::size_t i = 0; i < read.size(); ++i) {
+			REQUIRE(std::filesystem::equivalent(read[i].path, entries[i].path));
+			REQUIRE(read[i].size == entries[i].size);
+			REQUIRE(read[i].n_nonzeros == entries[i].n_nonzeros);
+			REQUIRE(read[i].fingerprint == entries[i].fingerprint);
+		}
+	}
+
+	SECTION("Unknown statistics are left empty") {
+		auto const manifest = tmp_raii.dir() / "manifest.tsv";
+		instance::write_manifest(manifest, instance::scan_manifest(directory));
+		for (auto const& entry : instance::read_manifest(manifest)) {
+			REQUIRE(entry.size > 0);
+			REQUIRE_FALSE(entry.n_nonzeros.has_value());
+			REQUIRE_FALSE(entry.fingerprint.has_value());
+		}
+	}
+}
+
+TEST_CASE("Malformed manifests are rejected", "[instance]") {
+	auto const tmp_raii = TmpFolderRAII{};
+	auto const manifest = tmp_raii.make_subpath(".tsv");
+	REQUIRE_THROWS_AS(instance::read_manifest(manifest), std::invalid_argument);
+
+	auto const line = GENERATE("a.lp", "a.lp\t-3", "a.lp\t12\tmany", "a.lp\t1\t2\t3\t4\t5", "a.lp\t1\t\t\t-1");
+	std::ofstream{manifest} << "# comment\n\n" << line << '\n';
+	REQUIRE_THROWS_AS(instance::read_manifest(manifest), std::invalid_argument);
+}
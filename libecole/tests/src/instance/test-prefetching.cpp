@@ -0,0 +1,83 @@
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/exception.hpp"
+#include "ecole/instance/prefetching.hpp"
+
+#include "conftest.hpp"
+#include "instance/unit-tests.hpp"
+
+using namespace ecole;
+
+TEST_CASE("PrefetchingGenerator instances are reproducible", "[instance]") {
+	auto const n_threads = GENERATE(std::size_t{1}, std::size_t{3});
+	auto const queue_size = GENERATE(std::size_t{1}, std::size_t{4});
+	auto generator = instance::PrefetchingGenerator{instance::make_set_cover, n_threads, queue_size, RandomGenerator{0}};
+	REQUIRE(generator.n_threads() == n_threads);
+	REQUIRE_FALSE(generator.done());
+
+	auto models = std::vector<scip::Model>{};
+	for (std::size_t i = 0; i < 4; ++i) {
+		models.push_back(generator.next());
+	}
+	REQUIRE_FALSE(instance::same_problem_permutation(models[0], models[1]));
+
+	// The sequence depends on the number of threads, but not on their scheduling nor the size of queues
+	auto other = instance::PrefetchingGenerator{instance::make_set_cover, n_threads, 1, RandomGenerator{0}};
+	for (auto const& model : models) {
+		REQUIRE(instance::same_problem_permutation(other.next(), model));
+	}
+
+	generator.seed(0);
+	auto reseeded = instance::PrefetchingGenerator{instance::make_set_cover, n_threads, queue_size, RandomGenerator{}};
+	reseeded.seed(0);
+	REQUIRE(instance::same_problem_permutation(generator.next(), reseeded.next()));
+}
+
+TEST_CASE("PrefetchingGenerator restores the same instances", "[instance]") {
+	auto generator = instance::PrefetchingGenerator{instance::make_set_cover, 2, 2, RandomGenerator{0}};
+	generator.next();
+	auto const state = generator.save_state();
+	auto models = std::vector<scip::Model>{};
+	for (std::size_t i = 0; i < 3; ++i) {
+		models.push_back(generator.next());
+	}
+
+	auto restored = instance::PrefetchingGenerator{instance::make_set_cover, 2, 1, RandomGenerator{1}};
+	restored.load_state(state);
+	for (auto const& model : models) {
+		REQUIRE(instance::same_problem_permutation(restored.next(), model));
+	}
+
+	auto other = instance::PrefetchingGenerator{instance::make_set_cover, 3, 1};
+	REQUIRE_THROWS_AS(other.load_state(state), std::invalid_argument);
+	auto make_finite = [] { return std::make_unique<instance::FiniteGenerator>(2, false); };
+	REQUIRE_THROWS_AS(instance::PrefetchingGenerator(make_finite, 2, 1).save_state(), std::logic_error);
+}
+
+TEST_CASE("PrefetchingGenerator is exhausted when all generators are", "[instance]") {
+	auto make_finite = [] { return std::make_unique<instance::FiniteGenerator>(2, false); };
+	auto generator = instance::PrefetchingGenerator{make_finite, 2, 1};
+	for (std::size_t i = 0; i < 4; ++i) {
+		REQUIRE_FALSE(generator.done());
+		generator.next();
+	}
+	REQUIRE(generator.done());
+	REQUIRE_THROWS_AS(generator.next(), IteratorExhausted);
+}
+
+TEST_CASE("PrefetchingGenerator rethrows generation errors", "[instance]") {
+	auto make_failing = [] { return std::make_unique<instance::FiniteGenerator>(1, true); };
+	auto generator = instance::PrefetchingGenerator{make_failing, 1, 1};
+	REQUIRE_THROWS_AS(generator.next(), std::runtime_error);
+	REQUIRE(generator.done());
+}
+
+TEST_CASE("PrefetchingGenerator rejects invalid sizes", "[instance]") {
+	REQUIRE_THROWS_AS((instance::PrefetchingGenerator{instance::make_set_cover, 0, 1}), std::invalid_argument);
+	REQUIRE_THROWS_AS((instance::PrefetchingGenerator{instance::make_set_cover, 1, 0}), std::invalid_argument);
+}
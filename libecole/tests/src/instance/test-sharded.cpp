@@ -0,0 +1,50 @@
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/instance/sharded.hpp"
+
+#include "conftest.hpp"
+#include "instance/unit-tests.hpp"
+
+using namespace ecole;
+
+TEST_CASE("ShardedGenerator shards the sequence of a single generator", "[instance]") {
+	auto constexpr world_size = std::size_t{3};
+	auto constexpr n_instances = 2 * world_size;
+	auto whole = instance::ShardedGenerator{instance::make_set_cover(), 0, 1, RandomGenerator{0}};
+	auto models = std::vector<scip::Model>{};
+	for (std::size_t i = 0; i < n_instances; ++i) {
+		models.push_back(whole.next());
+	}
+	REQUIRE_FALSE(instance::same_problem_permutation(models[0], models[1]));
+
+	for (std::size_t rank = 0; rank < world_size; ++rank) {
+		auto shard = instance::ShardedGenerator{instance::make_set_cover(), rank, world_size, RandomGenerator{0}};
+		for (auto i = rank; i < n_instances; i += world_size) {
+			REQUIRE(instance::same_problem_permutation(shard.next(), models[i]));
+		}
+	}
+
+	SECTION("Seeding restarts the sequence") {
+		whole.seed(0);
+		REQUIRE(instance::same_problem_permutation(whole.next(), models[0]));
+	}
+
+	SECTION("Restored generators continue the sequence") {
+		auto shard = instance::ShardedGenerator{instance::make_set_cover(), 1, world_size, RandomGenerator{0}};
+		shard.next();
+		auto restored = instance::ShardedGenerator{instance::make_set_cover(), 1, world_size};
+		restored.load_state(shard.save_state());
+		REQUIRE(instance::same_problem_permutation(restored.next(), models[1 + world_size]));
+	}
+
+	SECTION("Ranks must be smaller than the world size") {
+		REQUIRE_THROWS_AS(
+			(instance::ShardedGenerator{instance::make_set_cover(), world_size, world_size}), std::invalid_argument);
+		REQUIRE_THROWS_AS((instance::ShardedGenerator{instance::make_set_cover(), 0, 0}), std::invalid_argument);
+		REQUIRE_THROWS_AS((instance::ShardedGenerator{nullptr, 0, 1}), std::invalid_argument);
+	}
+}
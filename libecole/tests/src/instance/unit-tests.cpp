@@ -1,12 +1,16 @@
 #include <algorithm>
 #include <cstddef>
+#include <memory>
+#include <stdexcept>
 
 #include <range/v3/view/zip.hpp>
 #include <scip/cons_linear.h>
 #include <scip/scip.h>
 
+#include "ecole/instance/set-cover.hpp"
 #include "ecole/scip/cons.hpp"
 
+#include "conftest.hpp"
 #include "unit-tests.hpp"
 
 namespace views = ranges::views;
@@ -73,4 +77,19 @@ auto same_problem_permutation(scip::Model const& model1, scip::Model const& mode
 	return true;
 }
 
+auto make_set_cover() -> std::unique_ptr<InstanceGenerator> {
+	// Keep problem size reasonable for tests
+	std::size_t constexpr n_rows = 50;
+	std::size_t constexpr n_cols = 100;
+	return std::make_unique<SetCoverGenerator>(SetCoverGenerator::Parameters{n_rows, n_cols});
+}
+
+auto FiniteGenerator::next() -> scip::Model {
+	if (fail) {
+		throw std::runtime_error{"Generation failed"};
+	}
+	--n_instances;
+	return get_model();
+}
+
 }  // namespace ecole::instance
@@ -1,14 +1,37 @@
 #pragma once
 
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <string_view>
 #include <type_traits>
 
 #include <catch2/catch.hpp>
+#include <scip/scip.h>
 
+#include "ecole/instance/abstract.hpp"
 #include "ecole/random.hpp"
 #include "ecole/scip/model.hpp"
 
 namespace ecole::instance {
 
+/** A set cover generator of a size reasonable for tests. */
+auto make_set_cover() -> std::unique_ptr<InstanceGenerator>;
+
+/** A generator of a finite number of copies of the test problem, that can fail instead. */
+class FiniteGenerator : public InstanceGenerator {
+public:
+	explicit FiniteGenerator(std::size_t n_instances_, bool fail_ = false) : n_instances{n_instances_}, fail{fail_} {}
+
+	auto next() -> scip::Model override;
+	void seed(Seed /*seed*/) override {}
+	[[nodiscard]] auto done() const -> bool override { return n_instances == 0; }
+
+private:
+	std::size_t n_instances;
+	bool fail;
+};
+
 /** Check that the problem instances permutations are the same.
  *
  * Check that all constraints and variables are the same without trying any reordering.
@@ -57,11 +80,40 @@ template <typename Generator> void unit_tests(Generator&& generator) {
 		REQUIRE(same_problem_permutation(model1, model2));
 	}
 
+	SECTION("Restored state gives the same instances") {
+		auto const state = generator.save_state();
+		auto const model1 = generator.next();
+		generator.load_state(state);
+		auto const model2 = generator.next();
+		REQUIRE(same_problem_permutation(model1, model2));
+		REQUIRE_THROWS_AS(generator.load_state(state.substr(1)), std::invalid_argument);
+	}
+
 	SECTION("Generated models are valid SCIP models") {
 		auto model = generator.next();
 		model.solve();
 		REQUIRE(model.is_solved());
 	}
+
+	SECTION("Anonymous instances are the same problems without names") {
+		auto const params = generator.get_parameters();
+		auto anonymous_params = params;
+		anonymous_params.named = false;
+		// NOLINTNEXTLINE(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
+		auto rng = RandomGenerator{};
+		auto anonymous_rng = rng;
+		auto const model = Generator::generate_instance(params, rng);
+		auto anonymous_model = Generator::generate_instance(anonymous_params, anonymous_rng);
+		REQUIRE(same_problem_permutation(model, anonymous_model));
+		for (auto* const var : anonymous_model.variables()) {
+			REQUIRE(std::string_view{SCIPvarGetName(var)}.empty());
+		}
+		for (auto* const cons : anonymous_model.constraints()) {
+			REQUIRE(std::string_view{SCIPconsGetName(cons)}.empty());
+		}
+		anonymous_model.solve();
+		REQUIRE(anonymous_model.is_solved());
+	}
 }
 
 }  // namespace ecole::instance
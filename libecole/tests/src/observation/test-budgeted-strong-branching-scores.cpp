@@ -0,0 +1,98 @@
+#include <cstddef>
+
+#include <catch2/catch.hpp>
+#include <xtensor/xindex_view.hpp>
+#include <xtensor/xmath.hpp>
+
+#include "ecole/observation/budgeted-strong-branching-scores.hpp"
+
+#include "conftest.hpp"
+#include "observation/unit-tests.hpp"
+
+using namespace ecole;
+
+TEST_CASE("BudgetedStrongBranchingScores unit tests", "[unit][obs]") {
+	bool const pseudo_candidates = GENERATE(true, false);
+	bool const reuse_cache = GENERATE(true, false);
+	observation::unit_tests(observation::BudgetedStrongBranchingScores{pseudo_candidates, 3, 10, reuse_cache});
+}
+
+TEST_CASE("BudgetedStrongBranchingScores return scores within budget", "[obs]") {
+	bool const pseudo_candidates = GENERATE(true, false);
+	std::size_t const max_candidates = 3;
+	auto obs_func = observation::BudgetedStrongBranchingScores{pseudo_candidates, max_candidates, 10};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const obs = obs_func.extract(model, false);
+
+	REQUIRE(obs.has_value());
+	auto const& scores = obs.value();
+	REQUIRE(scores.size() == model.lp_columns().size());
+	auto const not_nan_scores = xt::filter(scores, !xt::isnan(scores));
+	REQUIRE(not_nan_scores.size() > 0);
+	REQUIRE(not_nan_scores.size() <= max_candidates);
+	REQUIRE(xt::all(not_nan_scores >= 0));
+}
+
+TEST_CASE("BudgetedStrongBranchingScores without budget scores all candidates", "[obs]") {
+	auto obs_func = observation::BudgetedStrongBranchingScores{};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const obs = obs_func.extract(model, false);
+
+	REQUIRE(obs.has_value());
+	auto const& scores = obs.value();
+	REQUIRE(xt::filter(scores, !xt::isnan(scores)).size() == model.lp_branch_cands().size());
+}
+
+TEST_CASE("BudgetedStrongBranchingScores reuse cached scores on the same node", "[obs]") {
+	auto obs_func = observation::BudgetedStrongBranchingScores{false, {}, {}, true};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const first = obs_func.extract(model, false);
+	auto const second = obs_func.extract(model, false);
+
+	REQUIRE(first.has_value());
+	REQUIRE(second.has_value());
+	REQUIRE(xt::all(xt::equal(xt::isnan(first.value()), xt::isnan(second.value()))));
+	auto const not_nan = !xt::isnan(first.value());
+	REQUIRE(xt::all(xt::filter(first.value(), not_nan) == xt::filter(second.value(), not_nan)));
+}
+
+TEST_CASE("ReliabilityBranchingScores unit tests", "[unit][obs]") {
+	bool const pseudo_candidates = GENERATE(true, false);
+	observation::unit_tests(observation::ReliabilityBranchingScores{pseudo_candidates, 1., 10});
+}
+
+TEST_CASE("ReliabilityBranchingScores strong branch unreliable candidates", "[obs]") {
+	auto obs_func = observation::ReliabilityBranchingScores{};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const obs = obs_func.extract(model, false);
+
+	REQUIRE(obs.has_value());
+	auto const& [scores, exact] = obs.value();
+	REQUIRE(scores.size() == model.lp_columns().size());
+	REQUIRE(exact.size() == scores.size());
+	// At the root node, no pseudocost has been updated yet
+	REQUIRE(xt::filter(scores, !xt::isnan(scores)).size() == model.lp_branch_cands().size());
+	REQUIRE(xt::all(xt::equal(exact, !xt::isnan(scores))));
+	REQUIRE(xt::all(xt::filter(scores, exact) >= 0));
+}
+
+TEST_CASE("ReliabilityBranchingScores without reliability threshold use pseudocosts", "[obs]") {
+	auto obs_func = observation::ReliabilityBranchingScores{false, 0.};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const obs = obs_func.extract(model, false);
+
+	REQUIRE(obs.has_value());
+	auto const& [scores, exact] = obs.value();
+	REQUIRE(xt::filter(scores, !xt::isnan(scores)).size() == model.lp_branch_cands().size());
+	REQUIRE_FALSE(xt::any(exact));
+}
@@ -0,0 +1,55 @@
+#include <cstddef>
+
+#include <catch2/catch.hpp>
+#include <xtensor/xindex_view.hpp>
+#include <xtensor/xmath.hpp>
+
+#include "ecole/observation/detailed-strong-branching-scores.hpp"
+
+#include "conftest.hpp"
+#include "observation/unit-tests.hpp"
+
+using namespace ecole;
+
+TEST_CASE("DetailedStrongBranchingScores unit tests", "[unit][obs]") {
+	bool const pseudo_candidates = GENERATE(true, false);
+	observation::unit_tests(observation::DetailedStrongBranchingScores{pseudo_candidates, 10});
+}
+
+TEST_CASE("DetailedStrongBranchingScores report the children of every candidate", "[obs]") {
+	auto obs_func = observation::DetailedStrongBranchingScores{};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const obs = obs_func.extract(model, false);
+
+	REQUIRE(obs.has_value());
+	auto const& [scores, down_gains, up_gains, n_lp_iterations] = obs.value();
+	auto const n_vars = model.lp_columns().size();
+	REQUIRE(scores.size() == n_vars);
+	REQUIRE(down_gains.size() == n_vars);
+	REQUIRE(up_gains.size() == n_vars);
+	REQUIRE(n_lp_iterations.size() == n_vars);
+
+	auto const evaluated = !xt::isnan(scores);
+	REQUIRE(xt::filter(scores, evaluated).size() == model.lp_branch_cands().size());
+	REQUIRE(xt::all(xt::equal(evaluated, !xt::isnan(down_gains))));
+	REQUIRE(xt::all(xt::equal(evaluated, !xt::isnan(up_gains))));
+	REQUIRE(xt::all(xt::filter(down_gains, evaluated) >= 0));
+	REQUIRE(xt::all(xt::filter(up_gains, evaluated) >= 0));
+	REQUIRE(xt::all(xt::filter(n_lp_iterations, !evaluated) == 0));
+	REQUIRE(xt::sum(n_lp_iterations)() > 0);
+}
+
+TEST_CASE("DetailedStrongBranchingScores respect the iteration limit", "[obs]") {
+	std::size_t const max_lp_iterations = 2;
+	auto obs_func = observation::DetailedStrongBranchingScores{false, max_lp_iterations};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const obs = obs_func.extract(model, false);
+
+	REQUIRE(obs.has_value());
+	// Each of the two children is limited
+	REQUIRE(xt::all(obs.value().n_lp_iterations <= 2 * max_lp_iterations));
+}
@@ -1,11 +1,16 @@
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <limits>
 #include <type_traits>
 
 #include <catch2/catch.hpp>
+#include <scip/scip.h>
 #include <xtensor/xview.hpp>
 
 #include "ecole/observation/hutter-2011.hpp"
+#include "ecole/scip/utils.hpp"
+#include "ecole/utility/metrics.hpp"
 
 #include "conftest.hpp"
 #include "observation/unit-tests.hpp"
@@ -100,6 +105,8 @@ TEST_CASE("Hutter2011 return correct observation", "[obs]") {
 			auto const q75_degree = get_feature(Features::node_degree_75q);
 			REQUIRE(is_sorted(min_degree, q25_degree, q75_degree, max_degree));
 			REQUIRE(is_sorted(0., get_feature(Features::edge_density), 1.));
+			REQUIRE(is_sorted(0., get_feature(Features::clustering_coef_mean), 1.));
+			REQUIRE(0. <= get_feature(Features::clustering_coef_std));
 		}
 
 		SECTION("LP based features") {
@@ -127,3 +134,93 @@ TEST_CASE("Hutter2011 return correct observation", "[obs]") {
 		}
 	}
 }
+
+TEST_CASE("Hutter2011 reuse cached features of the same instance", "[obs]") {
+	auto& n_hits = utility::metrics::counter("ecole_hutter2011_cache_requests_total", "", {{"result", "hit"}});
+	auto& n_misses = utility::metrics::counter("ecole_hutter2011_cache_requests_total", "", {{"result", "miss"}});
+	auto obs_func = observation::Hutter2011{true, 64, 1, false, 1};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	auto const n_misses_before = n_misses.value();
+	auto const first = obs_func.extract(model, false);
+	REQUIRE(n_misses.value() == n_misses_before + 1);
+
+	auto model_copy = model.copy_orig();
+	obs_func.before_reset(model_copy);
+	auto const n_hits_before = n_hits.value();
+	auto const second = obs_func.extract(model_copy, false);
+
+	REQUIRE(n_hits.value() == n_hits_before + 1);
+	REQUIRE(n_misses.value() == n_misses_before + 1);
+	REQUIRE(first.has_value());
+	REQUIRE(second.has_value());
+	REQUIRE(first->features == second->features);
+
+	SECTION("Least recently used instances are evicted") {
+		auto other = model.copy_orig();
+		auto* const var = other.variables()[0];
+		scip::call(SCIPchgVarObj, other.get_scip_ptr(), var, SCIPvarGetObj(var) + 1.);
+		obs_func.extract(other, false);
+		REQUIRE(n_misses.value() == n_misses_before + 2);
+		obs_func.extract(model, false);
+		REQUIRE(n_misses.value() == n_misses_before + 3);
+	}
+}
+
+TEST_CASE("Hutter2011 estimated clustering coefficients are close to exact ones", "[obs]") {
+	using Features = observation::Hutter2011Obs::Features;
+	auto const clustering_mean = [](std::size_t n_samples) {
+		auto obs_func = observation::Hutter2011{false, n_samples};
+		auto model = get_model();
+		obs_func.before_reset(model);
+		return obs_func.extract(model, false).value().features[static_cast<std::size_t>(Features::clustering_coef_mean)];
+	};
+	auto constexpr exhaustive = std::numeric_limits<std::size_t>::max();
+	REQUIRE(clustering_mean(1000) == Approx(clustering_mean(exhaustive)).margin(0.1));
+}
+
+TEST_CASE("Hutter2011 features from file match features from model", "[obs]") {
+	using Features = observation::Hutter2011Obs::Features;
+	auto obs_func = observation::Hutter2011{};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	auto const expected = obs_func.extract(model, false).value().features;
+	auto const actual = obs_func.extract_from_file(problem_file).features;
+
+	REQUIRE(actual.shape(0) == observation::Hutter2011Obs::n_features);
+	auto const lp_features = {
+		Features::lp_slack_mean, Features::lp_slack_max, Features::lp_slack_l2, Features::lp_objective_value};
+	for (auto const feat : lp_features) {
+		REQUIRE(std::isnan(actual[static_cast<std::size_t>(feat)]));
+	}
+	for (auto const feat : {
+			 Features::nb_variables,
+			 Features::nb_constraints,
+			 Features::nb_nonzero_coefs,
+			 Features::variable_node_degree_mean,
+			 Features::constraint_node_degree_max,
+			 Features::node_degree_mean,
+			 Features::node_degree_max,
+			 Features::edge_density,
+			 Features::objective_coef_m_std,
+			 Features::constraint_coef_mean,
+			 Features::ratio_continuous_vars,
+		 }) {
+		REQUIRE(actual[static_cast<std::size_t>(feat)] == Approx(expected[static_cast<std::size_t>(feat)]));
+	}
+}
+
+TEST_CASE("Hutter2011 reads the LP features from the root LP of a model being solved", "[obs][slow]") {
+	using Features = observation::Hutter2011Obs::Features;
+	auto model = get_model();
+	model.set_param("limits/nodes", 1);
+	model.solve();
+	REQUIRE_FALSE(observation::Hutter2011{}.extract(model, false).has_value());
+
+	auto obs_func = observation::Hutter2011{false, 64, 1, true};
+	auto const optional_obs = obs_func.extract(model, false);
+	REQUIRE(optional_obs.has_value());
+	auto const& features = optional_obs.value().features;
+	REQUIRE_FALSE(xt::any(xt::isnan(features)));
+	REQUIRE(features[static_cast<std::size_t>(Features::lp_slack_mean)] >= 0.);
+}
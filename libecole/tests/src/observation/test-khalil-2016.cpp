@@ -1,3 +1,7 @@
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
 #include <catch2/catch.hpp>
 #include <range/v3/view/enumerate.hpp>
 #include <range/v3/view/transform.hpp>
@@ -8,6 +12,8 @@
 #include <xtensor/xview.hpp>
 
 #include "ecole/observation/khalil-2016.hpp"
+#include "ecole/scip/callback.hpp"
+#include "ecole/scip/model.hpp"
 #include "ecole/tweak/range.hpp"
 
 #include "conftest.hpp"
@@ -19,7 +25,9 @@ using namespace ecole;
 
 TEST_CASE("Khalil2016 unit tests", "[unit][obs]") {
 	auto const pseudo = GENERATE(true, false);
-	observation::unit_tests(observation::Khalil2016{pseudo});
+	auto const n_threads = GENERATE(std::size_t{1}, std::size_t{4});
+	observation::unit_tests(observation::Khalil2016{pseudo, n_threads});
+	observation::unit_tests(observation::Khalil2016{pseudo, n_threads, false, {}, true});
 }
 
 template <typename Tensor, typename T = typename Tensor::value_type>
@@ -163,3 +171,113 @@ TEST_CASE("Khalil2016 return correct observation", "[obs]") {
 		}
 	}
 }
+
+TEST_CASE("Khalil2016 parallel extraction matches sequential extraction", "[obs]") {
+	auto const pseudo = GENERATE(true, false);
+	auto sequential_func = observation::Khalil2016{pseudo, 1};
+	auto parallel_func = observation::Khalil2016{pseudo, 4};
+	auto model = get_model();
+	sequential_func.before_reset(model);
+	parallel_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const sequential_obs = sequential_func.extract(model, false).value();
+	auto const parallel_obs = parallel_func.extract(model, false).value();
+	// Exact comparison, where NaN for non candidates compare equal
+	REQUIRE(xt::all(xt::isclose(sequential_obs.features, parallel_obs.features, 0., 0., true)));
+}
+
+TEST_CASE("Khalil2016 candidates only extraction matches full extraction", "[obs]") {
+	auto const pseudo = GENERATE(true, false);
+	auto full_func = observation::Khalil2016{pseudo};
+	auto cands_func = observation::Khalil2016{pseudo, 1, true};
+	auto model = get_model();
+	full_func.before_reset(model);
+	cands_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const full_obs = full_func.extract(model, false).value();
+	auto const cands_obs = cands_func.extract(model, false).value();
+	auto const branch_cands = pseudo ? model.pseudo_branch_cands() : model.lp_branch_cands();
+	REQUIRE(cands_obs.features.shape(0) == branch_cands.size());
+	REQUIRE(cands_obs.candidates == full_obs.candidates);
+	for (std::size_t i = 0; i < cands_obs.candidates.size(); ++i) {
+		auto const var_idx = static_cast<std::ptrdiff_t>(cands_obs.candidates(i));
+		REQUIRE(xt::row(cands_obs.features, static_cast<std::ptrdiff_t>(i)) == xt::row(full_obs.features, var_idx));
+	}
+}
+
+TEST_CASE("Khalil2016 selected features match full extraction", "[obs]") {
+	using Features = observation::Khalil2016Obs::Features;
+	auto const features = std::vector{Features::pseudocost_sum, Features::obj_coef, Features::active_coef_weight1_max};
+	auto full_func = observation::Khalil2016{};
+	auto selected_func = observation::Khalil2016{false, 1, false, features};
+	auto model = get_model();
+	full_func.before_reset(model);
+	selected_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const full_obs = full_func.extract(model, false).value();
+	auto const selected_obs = selected_func.extract(model, false).value();
+	REQUIRE(selected_obs.features.shape(0) == full_obs.features.shape(0));
+	REQUIRE(selected_obs.features.shape(1) == features.size());
+	for (std::size_t k = 0; k < features.size(); ++k) {
+		auto const full_col = xt::col(full_obs.features, static_cast<std::ptrdiff_t>(features[k]));
+		auto const selected_col = xt::col(selected_obs.features, static_cast<std::ptrdiff_t>(k));
+		REQUIRE(xt::all(xt::isclose(full_col, selected_col, 0., 0., true)));
+	}
+}
+
+TEST_CASE("Khalil2016 incremental extraction matches full extraction", "[obs][slow]") {
+	auto full_func = observation::Khalil2016{};
+	auto incremental_func = observation::Khalil2016{false, 1, false, {}, true};
+	// Cuts are kept so that LP rows change during solving
+	auto model = scip::Model::from_file(problem_file);
+	model.disable_presolve();
+	full_func.before_reset(model);
+	incremental_func.before_reset(model);
+
+	auto fcall = model.solve_iter(scip::callback::BranchruleConstructor{});
+	for (auto n_nodes = 0; fcall.has_value() && n_nodes < 20; ++n_nodes) {
+		auto const full_obs = full_func.extract(model, false).value();
+		auto const incremental_obs = incremental_func.extract(model, false).value();
+		// Exact comparison, where NaN for non candidates compare equal
+		REQUIRE(xt::all(xt::isclose(full_obs.features, incremental_obs.features, 0., 0., true)));
+		fcall = model.solve_iter_continue(SCIP_DIDNOTRUN);
+	}
+}
+
+TEST_CASE("Khalil2016 time budget leaves missed features NaN", "[obs]") {
+	auto const n_threads = GENERATE(std::size_t{1}, std::size_t{4});
+	auto full_func = observation::Khalil2016{};
+	auto model = get_model();
+	full_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const full_obs = full_func.extract(model, false).value();
+
+	SECTION("An ample budget extracts every feature") {
+		auto budget_func = observation::Khalil2016{false, n_threads, false, {}, false, std::chrono::seconds{100}};
+		budget_func.before_reset(model);
+		auto const obs = budget_func.extract(model, false).value();
+		REQUIRE_FALSE(xt::any(obs.timed_out));
+		REQUIRE(xt::all(xt::isclose(full_obs.features, obs.features, 0., 0., true)));
+	}
+
+	SECTION("Features past the deadline are marked") {
+		// Extracting the static features at the root node alone takes longer than the budget
+		auto budget_func = observation::Khalil2016{false, n_threads, false, {}, false, std::chrono::microseconds{1}};
+		budget_func.before_reset(model);
+		auto const obs = budget_func.extract(model, false).value();
+		REQUIRE(obs.candidates == full_obs.candidates);
+		for (std::size_t k = 0; k < observation::Khalil2016Obs::n_features; ++k) {
+			auto const col = xt::col(obs.features, static_cast<std::ptrdiff_t>(k));
+			auto const full_col = xt::col(full_obs.features, static_cast<std::ptrdiff_t>(k));
+			REQUIRE(obs.timed_out(k) == (k >= observation::Khalil2016Obs::n_static_features));
+			if (obs.timed_out(k)) {
+				REQUIRE(xt::all(xt::isnan(col)));
+			} else {
+				REQUIRE(xt::all(xt::isclose(full_col, col, 0., 0., true)));
+			}
+		}
+	}
+}
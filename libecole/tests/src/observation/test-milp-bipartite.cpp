@@ -1,10 +1,17 @@
 #include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <utility>
+#include <vector>
 
 #include <catch2/catch.hpp>
 #include <xtensor/xmath.hpp>
 #include <xtensor/xview.hpp>
 
 #include "ecole/observation/milp-bipartite.hpp"
+#include "ecole/scip/cons.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 #include "conftest.hpp"
 #include "observation/unit-tests.hpp"
@@ -13,7 +20,8 @@ using namespace ecole;
 
 TEST_CASE("MilpBipartite unit tests", "[unit][obs]") {
 	auto const normalize = GENERATE(true, false);
-	observation::unit_tests(observation::MilpBipartite{normalize});
+	auto const n_threads = GENERATE(std::size_t{1}, std::size_t{4});
+	observation::unit_tests(observation::MilpBipartite{normalize, n_threads});
 }
 
 TEST_CASE("MilpBipartite return correct observation", "[obs]") {
@@ -54,3 +62,102 @@ TEST_CASE("MilpBipartite return correct observation", "[obs]") {
 		}
 	}
 }
+
+TEST_CASE("MilpBipartite single precision matches double precision", "[obs]") {
+	auto normalize = GENERATE(true, false);
+	auto model = get_model();
+	auto const obs = observation::MilpBipartite{normalize}.extract(model, false).value();
+	auto const obs_float32 = observation::MilpBipartiteFloat32{normalize}.extract(model, false).value();
+
+	REQUIRE(xt::allclose(xt::cast<float>(obs.variable_features), obs_float32.variable_features));
+	REQUIRE(xt::allclose(xt::cast<float>(obs.constraint_features), obs_float32.constraint_features));
+	REQUIRE(obs.edge_features.indices == obs_float32.edge_features.indices);
+	REQUIRE(xt::allclose(xt::cast<float>(obs.edge_features.values), obs_float32.edge_features.values));
+}
+
+TEST_CASE("Standalone MilpBipartite extraction matches the observation function", "[obs]") {
+	auto model = get_model();
+	auto const obs = observation::MilpBipartite{}.extract(model, false).value();
+
+	auto const from_model = observation::extract_milp_bipartite<double>(model).value();
+	REQUIRE(from_model.variable_features == obs.variable_features);
+	auto const from_files = observation::extract_milp_bipartite<double>(
+		std::vector<std::filesystem::path>{problem_file, problem_file}, false, false, 2);
+	REQUIRE(from_files.size() == 2);
+	for (auto const& from_file : from_files) {
+		REQUIRE(from_file.value().variable_features == obs.variable_features);
+		REQUIRE(from_file.value().edge_features.indices == obs.edge_features.indices);
+	}
+
+	SECTION("Presolving leaves the model unchanged") {
+		auto const presolved = observation::extract_milp_bipartite<double>(model, true);
+		REQUIRE(model.stage() == SCIP_STAGE_PROBLEM);
+		if (presolved.has_value()) {
+			auto const from_file = observation::extract_milp_bipartite<double>(problem_file, true);
+			REQUIRE(from_file.has_value());
+			REQUIRE(presolved->variable_features.shape() == from_file->variable_features.shape());
+		}
+	}
+}
+
+TEST_CASE("MilpBipartite edges match constraint coefficients", "[obs]") {
+	auto obs_func = observation::MilpBipartite{false};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	auto const obs = obs_func.extract(model, false).value();
+	auto* const scip = model.get_scip_ptr();
+
+	// Build expected entries one constraint at a time
+	auto expected_values = std::vector<double>{};
+	auto expected_biases = std::vector<double>{};
+	for (auto* const cons : model.constraints()) {
+		auto const [vars, coefs, lhs, rhs] = scip::get_constraint_coefs(scip, cons);
+		for (auto const& [side, sign] : {std::pair{lhs, -1.}, std::pair{rhs, 1.}}) {
+			if (side.has_value()) {
+				for (auto const coef : coefs) {
+					expected_values.push_back(sign * coef);
+				}
+				expected_biases.push_back(sign * side.value());
+			}
+		}
+	}
+
+	REQUIRE(obs.edge_features.nnz() == expected_values.size());
+	REQUIRE(obs.constraint_features.shape()[0] == expected_biases.size());
+	for (std::size_t i = 0; i < expected_values.size(); ++i) {
+		REQUIRE(obs.edge_features.values(i) == expected_values[i]);
+	}
+	for (std::size_t i = 0; i < expected_biases.size(); ++i) {
+		REQUIRE(obs.constraint_features(i, 0) == expected_biases[i]);
+	}
+}
+
+TEST_CASE("MilpBipartite compressed edges match coordinate edges", "[obs]") {
+	auto const n_threads = GENERATE(std::size_t{1}, std::size_t{4});
+	auto model = get_model();
+	auto const coo_obs = observation::MilpBipartite{}.extract(model, false).value();
+	auto const obs = observation::MilpBipartite{false, n_threads, true, true}.extract(model, false).value();
+
+	REQUIRE(obs.edge_features.nnz() == 0);
+	REQUIRE(obs.edge_features_csr == coo_obs.edge_features.to_csr<std::int32_t>());
+	REQUIRE(obs.edge_features_csc == coo_obs.edge_features.to_csc<std::int32_t>());
+	REQUIRE(obs.edge_features_csc.row_pointers.size() == obs.variable_features.shape(0) + 1);
+}
+
+TEST_CASE("Constraints extracted in parallel match serial extraction", "[obs]") {
+	auto const stage = GENERATE(SCIP_STAGE_PROBLEM, SCIP_STAGE_TRANSFORMED, SCIP_STAGE_PRESOLVED);
+	auto const normalize = GENERATE(true, false);
+	auto const include_variable_bounds = GENERATE(true, false);
+	auto model = get_model(stage);
+	auto* const scip = model.get_scip_ptr();
+	auto thread_pool = utility::ThreadPool{4};
+
+	auto const [matrix, biases] = scip::get_all_constraints(scip, normalize, include_variable_bounds);
+	auto const [matrix_par, biases_par] =
+		scip::get_all_constraints(scip, normalize, include_variable_bounds, &thread_pool);
+
+	REQUIRE(matrix.shape == matrix_par.shape);
+	REQUIRE(matrix.indices == matrix_par.indices);
+	REQUIRE(matrix.values == matrix_par.values);
+	REQUIRE(biases == biases_par);
+}
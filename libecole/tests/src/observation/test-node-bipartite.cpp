@@ -1,10 +1,14 @@
 #include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
 
 #include <catch2/catch.hpp>
 #include <xtensor/xmath.hpp>
 #include <xtensor/xview.hpp>
 
 #include "ecole/observation/node-bipartite.hpp"
+#include "ecole/scip/callback.hpp"
 
 #include "conftest.hpp"
 #include "observation/unit-tests.hpp"
@@ -12,16 +16,17 @@
 using namespace ecole;
 
 TEST_CASE("NodeBipartite unit tests", "[unit][obs]") {
-	observation::unit_tests(observation::NodeBipartite{});
+	auto incremental = GENERATE(true, false);
+	observation::unit_tests(observation::NodeBipartite{false, incremental});
+	observation::unit_tests(observation::NodeBipartiteFloat32{false, incremental});
+	observation::unit_tests(observation::CompactNodeBipartite{false, incremental});
 }
 
 TEST_CASE("NodeBipartite return correct observation", "[obs]") {
 	auto cache = GENERATE(true, false);
-	auto obs_func = observation::NodeBipartite{cache};
+	auto incremental = GENERATE(true, false);
+	auto obs_func = observation::NodeBipartite{cache, incremental};
 	auto model = get_model();
-	if (cache) {
-		model.disable_cuts();
-	}
 	obs_func.before_reset(model);
 	advance_to_stage(model, SCIP_STAGE_SOLVING);
 	auto const optional_obs = obs_func.extract(model, false);
@@ -53,3 +58,235 @@ TEST_CASE("NodeBipartite return correct observation", "[obs]") {
 		REQUIRE_FALSE(xt::all(xt::isnan(obs.row_features)));
 	}
 }
+
+TEST_CASE("NodeBipartite incremental and cached extractions match full extraction", "[obs][slow]") {
+	auto cache = GENERATE(true, false);
+	auto full_func = observation::NodeBipartite{};
+	auto incremental_func = observation::NodeBipartite{cache, !cache};
+	// Cuts are kept so that LP rows change during solving
+	auto model = scip::Model::from_file(problem_file);
+	model.disable_presolve();
+	full_func.before_reset(model);
+	incremental_func.before_reset(model);
+
+	auto fcall = model.solve_iter(scip::callback::BranchruleConstructor{});
+	for (auto n_nodes = 0; fcall.has_value() && n_nodes < 20; ++n_nodes) {
+		auto const full_obs = full_func.extract(model, false).value();
+		auto const incremental_obs = incremental_func.extract(model, false).value();
+		REQUIRE(xt::all(xt::isclose(full_obs.variable_features, incremental_obs.variable_features, 1e-9, 0., true)));
+		REQUIRE(xt::all(xt::isclose(full_obs.row_features, incremental_obs.row_features, 1e-9, 0., true)));
+		REQUIRE(full_obs.edge_features.shape == incremental_obs.edge_features.shape);
+		REQUIRE(full_obs.edge_features.indices == incremental_obs.edge_features.indices);
+		REQUIRE(xt::allclose(full_obs.edge_features.values, incremental_obs.edge_features.values));
+		fcall = model.solve_iter_continue(SCIP_DIDNOTRUN);
+	}
+}
+
+TEST_CASE("NodeBipartite CSR edges match coordinate edges", "[obs]") {
+	auto incremental = GENERATE(true, false);
+	auto coo_func = observation::NodeBipartite{};
+	auto csr_func = observation::NodeBipartite{false, incremental, true};
+	auto model = get_model();
+	coo_func.before_reset(model);
+	csr_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const coo_obs = coo_func.extract(model, false).value();
+	auto const csr_obs = csr_func.extract(model, false).value();
+	REQUIRE(csr_obs.edge_features.nnz() == 0);
+	REQUIRE(csr_obs.edge_features_csr == decltype(csr_obs.edge_features_csr)::from_coo(coo_obs.edge_features));
+}
+
+TEST_CASE("NodeBipartite CSC edges are the edges sorted by variable", "[obs]") {
+	auto const csr_edges = GENERATE(true, false);
+	auto coo_func = observation::NodeBipartite{};
+	auto csc_func = observation::NodeBipartite{false, false, csr_edges, 0, true};
+	auto model = get_model();
+	coo_func.before_reset(model);
+	csc_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const coo_obs = coo_func.extract(model, false).value();
+	auto const csc_obs = csc_func.extract(model, false).value();
+	auto const& csc = csc_obs.edge_features_csc;
+	REQUIRE(csc == coo_obs.edge_features.to_csc<std::int32_t>());
+	REQUIRE(csc.shape[0] == csc_obs.variable_features.shape(0));
+	REQUIRE(csc.row_pointers.size() == csc.shape[0] + 1);
+	REQUIRE(static_cast<std::size_t>(csc.row_pointers(csc.shape[0])) == coo_obs.edge_features.nnz());
+	REQUIRE((csr_edges ? csc_obs.edge_features_csr.nnz() : csc_obs.edge_features.nnz()) == csc.nnz());
+}
+
+TEST_CASE("NodeBipartite extraction into an existing observation reuses memory", "[obs]") {
+	auto csr_edges = GENERATE(true, false);
+	auto obs_func = observation::NodeBipartite{false, false, csr_edges};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto obs = observation::NodeBipartiteObs{};
+	REQUIRE(obs_func.extract_into(model, false, obs));
+	auto const* const variable_data = obs.variable_features.data();
+	auto const* const row_data = obs.row_features.data();
+	auto const* const edge_data = csr_edges ? obs.edge_features_csr.values.data() : obs.edge_features.values.data();
+	REQUIRE(obs_func.extract_into(model, false, obs));
+	REQUIRE(obs.variable_features.data() == variable_data);
+	REQUIRE(obs.row_features.data() == row_data);
+	REQUIRE((csr_edges ? obs.edge_features_csr.values.data() : obs.edge_features.values.data()) == edge_data);
+
+	auto const fresh_obs = obs_func.extract(model, false).value();
+	REQUIRE(obs.variable_features == fresh_obs.variable_features);
+	REQUIRE(obs.edge_features == fresh_obs.edge_features);
+	REQUIRE(obs.edge_features_csr == fresh_obs.edge_features_csr);
+}
+
+TEST_CASE("NodeBipartite single precision matches double precision", "[obs]") {
+	auto incremental = GENERATE(true, false);
+	auto obs_func = observation::NodeBipartite{false, incremental};
+	auto obs_func_float32 = observation::NodeBipartiteFloat32{false, incremental};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	obs_func_float32.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const obs = obs_func.extract(model, false).value();
+	auto const obs_float32 = obs_func_float32.extract(model, false).value();
+	auto const close = [](auto const& expected, auto const& actual) {
+		return xt::all(xt::isclose(xt::cast<float>(expected), actual, 1e-5, 0., true));
+	};
+	REQUIRE(close(obs.variable_features, obs_float32.variable_features));
+	REQUIRE(close(obs.row_features, obs_float32.row_features));
+	REQUIRE(obs.edge_features.indices == obs_float32.edge_features.indices);
+	REQUIRE(close(obs.edge_features.values, obs_float32.edge_features.values));
+}
+
+TEST_CASE("NodeBipartite observations collate into a single graph", "[obs]") {
+	auto csr_edges = GENERATE(true, false);
+	auto obs_func = observation::NodeBipartite{false, false, csr_edges};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const obs = obs_func.extract(model, false).value();
+	auto const n_vars = obs.variable_features.shape(0);
+	auto const n_rows = obs.row_features.shape(0);
+	auto const n_edges = csr_edges ? obs.edge_features_csr.nnz() : obs.edge_features.nnz();
+
+	auto const batch = observation::collate(std::vector{obs, obs});
+
+	REQUIRE(batch.variable_features.shape(0) == 2 * n_vars);
+	REQUIRE(batch.row_features.shape(0) == 2 * n_rows);
+	REQUIRE(batch.edge_features.nnz() == 2 * n_edges);
+	REQUIRE(xt::view(batch.variable_features, xt::range(n_vars, 2 * n_vars), xt::all()) == obs.variable_features);
+	REQUIRE(batch.variable_batch(0) == 0);
+	REQUIRE(batch.variable_batch(2 * n_vars - 1) == 1);
+	REQUIRE(batch.variable_offsets(1) == n_vars);
+	REQUIRE(batch.edge_offsets(2) == 2 * n_edges);
+	// Edges of the second graph are shifted to its variables and rows
+	auto const second_rows = xt::view(batch.edge_features.indices, 0, xt::range(n_edges, 2 * n_edges));
+	auto const second_vars = xt::view(batch.edge_features.indices, 1, xt::range(n_edges, 2 * n_edges));
+	REQUIRE(xt::amin(second_rows)() >= n_rows);
+	REQUIRE(xt::amin(second_vars)() >= n_vars);
+	REQUIRE(xt::amax(second_vars)() < 2 * n_vars);
+}
+
+TEST_CASE("NodeBipartite subgraphs around branching candidates", "[obs]") {
+	auto const csr_edges = GENERATE(true, false);
+	auto const candidate_hops = GENERATE(std::size_t{1}, std::size_t{2});
+	auto full_func = observation::NodeBipartite{false, false, csr_edges};
+	auto sub_func = observation::NodeBipartite{false, false, csr_edges, candidate_hops};
+	auto model = get_model();
+	full_func.before_reset(model);
+	sub_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const full_obs = full_func.extract(model, false).value();
+	auto const sub_obs = sub_func.extract(model, false).value();
+	auto const& var_ids = sub_obs.variable_ids;
+	auto const& row_ids = sub_obs.row_ids;
+	REQUIRE(var_ids.size() == sub_obs.variable_features.shape(0));
+	REQUIRE(row_ids.size() == sub_obs.row_features.shape(0));
+	REQUIRE(var_ids.size() >= model.lp_branch_cands().size());
+	REQUIRE(var_ids.size() <= full_obs.variable_features.shape(0));
+	REQUIRE(sub_obs.variable_features == xt::view(full_obs.variable_features, xt::keep(var_ids)));
+	REQUIRE(sub_obs.row_features == xt::view(full_obs.row_features, xt::keep(row_ids)));
+
+	auto const to_vector = [](auto const& ids) { return std::vector<std::size_t>(ids.begin(), ids.end()); };
+	if (csr_edges) {
+		auto const expected = full_obs.edge_features_csr.select_rows(to_vector(row_ids)).select_cols(to_vector(var_ids));
+		REQUIRE(sub_obs.edge_features_csr == expected);
+	} else {
+		auto const expected = full_obs.edge_features.select_rows(to_vector(row_ids)).select_cols(to_vector(var_ids));
+		REQUIRE(sub_obs.edge_features == expected);
+	}
+	REQUIRE_THROWS_AS((observation::NodeBipartite{false, false, false, 3}), std::invalid_argument);
+}
+
+TEST_CASE("NodeBipartite deltas rebuild the observations", "[obs][slow]") {
+	auto const incremental = GENERATE(true, false);
+	auto full_func = observation::NodeBipartite{false, false, true};
+	auto delta_func = observation::DeltaNodeBipartite{false, incremental};
+	auto model = scip::Model::from_file(problem_file);
+	model.disable_presolve();
+	full_func.before_reset(model);
+	delta_func.before_reset(model);
+
+	auto obs = observation::NodeBipartiteObs{};
+	auto fcall = model.solve_iter(scip::callback::BranchruleConstructor{});
+	for (auto n_nodes = 0; fcall.has_value() && n_nodes < 20; ++n_nodes) {
+		auto const full_obs = full_func.extract(model, false).value();
+		auto const delta = delta_func.extract(model, false).value();
+		observation::apply_delta(obs, delta);
+		REQUIRE(xt::all(xt::isclose(full_obs.variable_features, obs.variable_features, 0., 0., true)));
+		REQUIRE(xt::all(xt::isclose(full_obs.row_features, obs.row_features, 0., 0., true)));
+		REQUIRE(obs.edge_features_csr == full_obs.edge_features_csr);
+		REQUIRE(delta.edge_features.nnz() <= full_obs.edge_features_csr.nnz());
+		fcall = model.solve_iter_continue(SCIP_DIDNOTRUN);
+	}
+}
+
+TEST_CASE("NodeBipartite deltas must match the observation they are applied to", "[obs]") {
+	auto delta = observation::NodeBipartiteDelta{};
+	delta.n_rows = 2;
+	auto obs = observation::NodeBipartiteObs{};
+	REQUIRE_THROWS_AS(observation::apply_delta(obs, delta), std::invalid_argument);
+}
+
+TEST_CASE("NodeBipartite compact observations encode the categorical features", "[obs]") {
+	using VariableFeatures = observation::NodeBipartiteObs::VariableFeatures;
+	using Continuous = observation::NodeBipartiteCompactObs::ContinuousVariableFeatures;
+	using Categorical = observation::NodeBipartiteCompactObs::CategoricalVariableFeatures;
+
+	auto obs_func = observation::NodeBipartite{};
+	auto compact_func = observation::CompactNodeBipartite{};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	compact_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const obs = obs_func.extract(model, false).value();
+	auto const compact = compact_func.extract(model, false).value();
+	auto const n_vars = obs.variable_features.shape(0);
+	REQUIRE(compact.variable_features.shape(0) == n_vars);
+	REQUIRE(compact.variable_features.shape(1) == observation::NodeBipartiteCompactObs::n_continuous_variable_features);
+	REQUIRE(compact.variable_categories.shape(0) == n_vars);
+	REQUIRE(
+		compact.variable_categories.shape(1) == observation::NodeBipartiteCompactObs::n_categorical_variable_features);
+	REQUIRE(xt::all(xt::equal(compact.row_features, obs.row_features) | xt::isnan(obs.row_features)));
+	REQUIRE(compact.edge_features.indices == obs.edge_features.indices);
+
+	auto const full = [&obs](std::size_t var, VariableFeatures feature) {
+		return obs.variable_features(var, static_cast<std::size_t>(feature));
+	};
+	for (std::size_t var = 0; var < n_vars; ++var) {
+		auto const category = [&compact, var](Categorical feature) {
+			return compact.variable_categories(var, static_cast<std::size_t>(feature));
+		};
+		auto const type = static_cast<std::size_t>(category(Categorical::type));
+		REQUIRE(full(var, VariableFeatures::is_type_binary) == (type == 0));
+		REQUIRE(full(var, VariableFeatures::is_type_continuous) == (type == 3));
+		REQUIRE(full(var, VariableFeatures::has_lower_bound) == category(Categorical::has_lower_bound));
+		REQUIRE(full(var, VariableFeatures::is_basis_basic) == (category(Categorical::basis_status) == 1));
+		REQUIRE(
+			full(var, VariableFeatures::objective) ==
+			compact.variable_features(var, static_cast<std::size_t>(Continuous::objective)));
+	}
+}
@@ -1,8 +1,13 @@
 #include <cmath>
+#include <cstddef>
+#include <tuple>
 
 #include <catch2/catch.hpp>
 #include <scip/scip.h>
+#include <xtensor/xmath.hpp>
+#include <xtensor/xtensor.hpp>
 
+#include "ecole/data/tuple.hpp"
 #include "ecole/observation/pseudocosts.hpp"
 
 #include "conftest.hpp"
@@ -11,7 +16,8 @@
 using namespace ecole;
 
 TEST_CASE("Pseudocosts unit tests", "[unit][obs]") {
-	observation::unit_tests(observation::Pseudocosts{});
+	auto const candidates_only = GENERATE(true, false);
+	observation::unit_tests(observation::Pseudocosts{candidates_only});
 }
 
 TEST_CASE("Pseudocosts return pseudo costs array", "[obs]") {
@@ -33,3 +39,47 @@ TEST_CASE("Pseudocosts return pseudo costs array", "[obs]") {
 		REQUIRE(pseudocost > 0);
 	}
 }
+
+TEST_CASE("Pseudocosts of candidates only match full pseudocosts", "[obs]") {
+	auto model = get_model();
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const costs = observation::Pseudocosts{false}.extract(model, false).value();
+	auto const cands_costs = observation::Pseudocosts{true}.extract(model, false).value();
+
+	auto const cands = model.lp_branch_cands();
+	REQUIRE(cands_costs.size() == cands.size());
+	for (std::size_t i = 0; i < cands.size(); ++i) {
+		REQUIRE(cands_costs[i] == costs[static_cast<std::size_t>(SCIPvarGetProbindex(cands[i]))]);
+	}
+}
+
+TEST_CASE("Pseudocosts extracted in a reused tensor", "[obs]") {
+	// Only candidates so that the observation has no NaN and can be compared
+	auto obs_func = observation::Pseudocosts{true};
+	auto model = get_model();
+	obs_func.before_reset(model);
+	auto pseudocosts = xt::xtensor<double, 1>{};
+	REQUIRE_FALSE(obs_func.extract_into(model, false, pseudocosts));
+
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	REQUIRE(obs_func.extract_into(model, false, pseudocosts));
+	auto const* const data = pseudocosts.data();
+	REQUIRE(obs_func.extract_into(model, false, pseudocosts));
+	REQUIRE(pseudocosts.data() == data);
+	REQUIRE(pseudocosts == obs_func.extract(model, false).value());
+}
+
+TEST_CASE("Pseudocosts visiting the LP match extracted pseudocosts", "[obs]") {
+	auto const candidates_only = GENERATE(true, false);
+	auto model = get_model();
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const costs = observation::Pseudocosts{candidates_only}.extract(model, false).value();
+
+	// Both functions share a single traversal of the LP
+	auto tuple_func = data::TupleFunction{observation::Pseudocosts{candidates_only}, observation::Pseudocosts{true}};
+	auto const [visited_costs, visited_cands_costs] = tuple_func.extract(model, false);
+	REQUIRE(visited_costs.has_value());
+	REQUIRE(visited_cands_costs.has_value());
+	REQUIRE(xt::all(xt::isclose(visited_costs.value(), costs, 0., 0., true)));
+	REQUIRE(visited_cands_costs.value() == observation::Pseudocosts{true}.extract(model, false).value());
+}
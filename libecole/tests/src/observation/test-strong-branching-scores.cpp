@@ -12,6 +12,7 @@ using namespace ecole;
 TEST_CASE("StrongBranchingScores unit tests", "[unit][obs]") {
 	bool pseudo_candidates = GENERATE(true, false);
 	observation::unit_tests(observation::StrongBranchingScores{pseudo_candidates});
+	observation::unit_tests(observation::StrongBranchingScores{pseudo_candidates, 4});
 }
 
 TEST_CASE("StrongBranchingScores return correct branchig scores", "[obs]") {
@@ -29,3 +30,23 @@ TEST_CASE("StrongBranchingScores return correct branchig scores", "[obs]") {
 	REQUIRE(not_nan_scores.size() > 0);
 	REQUIRE(xt::all(not_nan_scores >= 0));
 }
+
+TEST_CASE("StrongBranchingScores parallel scores match sequential scores", "[obs]") {
+	bool pseudo_candidates = GENERATE(true, false);
+	auto sequential_func = observation::StrongBranchingScores{pseudo_candidates, 1};
+	auto parallel_func = observation::StrongBranchingScores{pseudo_candidates, 4};
+	auto model = get_model();
+	sequential_func.before_reset(model);
+	parallel_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+
+	auto const sequential_scores = sequential_func.extract(model, false).value();
+	auto const parallel_scores = parallel_func.extract(model, false).value();
+	REQUIRE_FALSE(sequential_func.scored_on_lp_copies());
+	// LP candidates are all columns of the node LP, which is solved to optimality when branching
+	if (!pseudo_candidates) {
+		REQUIRE(parallel_func.scored_on_lp_copies());
+	}
+	// Children LPs can end on different optimal bases, whose objective values only agree up to the LP tolerances
+	REQUIRE(xt::all(xt::isclose(sequential_scores, parallel_scores, 1e-6, 1e-6, true)));
+}
@@ -0,0 +1,84 @@
+#include <cmath>
+#include <cstddef>
+
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+#include <xtensor/xmath.hpp>
+
+#include "ecole/observation/tree-statistics.hpp"
+#include "ecole/scip/callback.hpp"
+#include "ecole/scip/model.hpp"
+
+#include "conftest.hpp"
+#include "observation/unit-tests.hpp"
+
+using namespace ecole;
+
+TEST_CASE("TreeStatistics unit tests", "[unit][obs]") {
+	observation::unit_tests(observation::TreeStatistics{});
+}
+
+TEST_CASE("TreeStatistics return correct observation", "[obs]") {
+	using Features = observation::TreeStatisticsObs::Features;
+
+	auto obs_func = observation::TreeStatistics{};
+	auto model = get_model();
+	obs_func.before_reset(model);
+
+	SECTION("Observation is empty before solving") { REQUIRE_FALSE(obs_func.extract(model, false).has_value()); }
+
+	SECTION("Observation has correct values at the root") {
+		advance_to_stage(model, SCIP_STAGE_SOLVING);
+		auto const optional_obs = obs_func.extract(model, false);
+		REQUIRE(optional_obs.has_value());
+		auto const& obs = optional_obs.value();
+		auto get_feature = [&obs](auto feat) { return obs.features[static_cast<std::size_t>(feat)]; };
+
+		REQUIRE(obs.features.shape(0) == observation::TreeStatisticsObs::n_features);
+		REQUIRE_FALSE(xt::any(xt::isnan(obs.features)));
+		REQUIRE(get_feature(Features::n_nodes) == 1);
+		REQUIRE(get_feature(Features::focus_depth) == 0);
+		REQUIRE(get_feature(Features::focus_depth_mean) == 0);
+		REQUIRE(get_feature(Features::n_backtracks) == 0);
+		REQUIRE(get_feature(Features::n_branched_nodes) == 0);
+	}
+}
+
+TEST_CASE("TreeStatistics do not include their handler while solving", "[obs]") {
+	using Features = observation::TreeStatisticsObs::Features;
+
+	auto obs_func = observation::TreeStatistics{};
+	auto model = get_model();
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const n_eventhdlrs = SCIPgetNEventhdlrs(model.get_scip_ptr());
+	auto const obs = obs_func.extract(model, false).value();
+	auto get_feature = [&obs](auto feat) { return obs.features[static_cast<std::size_t>(feat)]; };
+
+	REQUIRE(SCIPgetNEventhdlrs(model.get_scip_ptr()) == n_eventhdlrs);
+	REQUIRE(get_feature(Features::n_nodes) == 1);
+	REQUIRE(std::isnan(get_feature(Features::focus_depth_mean)));
+	REQUIRE(std::isnan(get_feature(Features::gap_at_last_incumbent)));
+}
+
+TEST_CASE("TreeStatistics aggregates are consistent during the search", "[obs][slow]") {
+	using Features = observation::TreeStatisticsObs::Features;
+
+	auto obs_func = observation::TreeStatistics{};
+	auto model = get_model();
+	obs_func.before_reset(model);
+
+	auto fcall = model.solve_iter(scip::callback::BranchruleConstructor{});
+	for (auto n_nodes = 0; fcall.has_value() && n_nodes < 20; ++n_nodes) {
+		auto const obs = obs_func.extract(model, false).value();
+		auto get_feature = [&obs](auto feat) { return obs.features[static_cast<std::size_t>(feat)]; };
+
+		REQUIRE_FALSE(xt::any(xt::isnan(obs.features)));
+		REQUIRE(xt::all(obs.features >= 0));
+		REQUIRE(get_feature(Features::focus_depth) <= get_feature(Features::max_depth));
+		REQUIRE(get_feature(Features::focus_depth_mean) <= get_feature(Features::max_depth));
+		REQUIRE(get_feature(Features::n_backtracks) < get_feature(Features::n_nodes));
+		REQUIRE(get_feature(Features::n_branched_nodes) < get_feature(Features::n_nodes));
+		REQUIRE(get_feature(Features::nodes_since_incumbent) <= get_feature(Features::n_nodes));
+		fcall = model.solve_iter_continue(SCIP_DIDNOTRUN);
+	}
+}
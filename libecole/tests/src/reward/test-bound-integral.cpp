@@ -1,4 +1,11 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+
 #include <catch2/catch.hpp>
+#include <scip/scip.h>
 
 #include "ecole/reward/bound-integral.hpp"
 
@@ -48,3 +55,85 @@ TEST_CASE("DualInPrimalDualIntegraltegral returns the difference in dual integra
 		REQUIRE(reward_func.extract(model) >= 0);
 	}
 }
+
+TEST_CASE("DualIntegral accumulates the same integral as its history", "[reward][slow]") {
+	auto reward_func = reward::DualIntegral{false, {}, true};
+	auto model = get_model();
+	reward_func.before_reset(model);
+	model.solve();
+	auto const reward = reward_func.extract(model);
+
+	auto const& history = reward_func.history(model);
+	REQUIRE(history.times.size() >= 2);
+	REQUIRE(history.dual_bounds.size() == history.times.size());
+	auto const is_nan = [](auto bound) { return std::isnan(bound); };
+	REQUIRE(std::all_of(history.primal_bounds.begin(), history.primal_bounds.end(), is_nan));
+	auto const sign = SCIPgetObjsense(model.get_scip_ptr()) == SCIP_OBJSENSE_MINIMIZE ? -1. : 1.;
+	auto integral = 0.;
+	for (std::size_t i = 0; i + 1 < history.times.size(); ++i) {
+		auto const time_diff = std::chrono::duration<double>(history.times[i + 1] - history.times[i]).count();
+		integral += sign * history.dual_bounds[i] * time_diff;
+	}
+	REQUIRE(reward == Approx(integral));
+}
+
+TEST_CASE("Bound integrals do not keep a history by default", "[reward]") {
+	auto reward_func = reward::PrimalDualIntegral{};
+	auto model = get_model();
+	reward_func.before_reset(model);
+	reward_func.extract(model);
+	REQUIRE(reward_func.history(model).times.empty());
+}
+
+TEST_CASE("DualIntegral can read the bound once per node with a coarse clock", "[reward][slow]") {
+	auto reward_func = reward::DualIntegral{true, {}, true, reward::DualBoundEvent::node, true};
+	auto model = get_model();
+	reward_func.before_reset(model);
+	model.solve();
+	reward_func.extract(model);
+	auto const& history = reward_func.history(model);
+	REQUIRE(history.times.size() >= 2);
+	REQUIRE(std::is_sorted(history.times.begin(), history.times.end()));
+}
+
+TEST_CASE("Bound integrals reject a coarse process time", "[reward]") {
+	REQUIRE_THROWS_AS((reward::DualIntegral{false, {}, false, reward::DualBoundEvent::lp, true}), std::invalid_argument);
+}
+
+TEST_CASE("Bound integrals on the same model share their event handler", "[reward][slow]") {
+	auto model = get_model();
+	auto const n_eventhdlrs = SCIPgetNEventhdlrs(model.get_scip_ptr());
+	auto primal = reward::PrimalIntegral{true, {}, true};
+	auto dual = reward::DualIntegral{true};
+	auto primal_dual = reward::PrimalDualIntegral{true};
+	primal.before_reset(model);
+	dual.before_reset(model);
+	primal_dual.before_reset(model);
+	REQUIRE(SCIPgetNEventhdlrs(model.get_scip_ptr()) == n_eventhdlrs + 1);
+
+	SECTION("Integrals with another clock use another handler") {
+		reward::DualIntegral{}.before_reset(model);
+		REQUIRE(SCIPgetNEventhdlrs(model.get_scip_ptr()) == n_eventhdlrs + 2);
+	}
+
+	SECTION("Every integral is accumulated separately") {
+		model.solve();
+		REQUIRE(std::isfinite(primal.extract(model)));
+		REQUIRE(std::isfinite(dual.extract(model)));
+		REQUIRE(std::isfinite(primal_dual.extract(model)));
+		// The history records both bounds since they are used by some integral
+		auto const& history = primal.history(model);
+		REQUIRE(history.dual_bounds.size() == history.times.size());
+		REQUIRE_FALSE(std::isnan(history.dual_bounds.back()));
+	}
+}
+
+TEST_CASE("PrimalDualIntegral can count the CPU time of the environment threads only", "[reward][slow]") {
+	auto reward_func = reward::PrimalDualIntegral{false, {}, false, reward::DualBoundEvent::lp, false, true};
+	auto model = get_model();
+	reward_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	REQUIRE(reward_func.extract(model) >= 0);
+	REQUIRE_THROWS_AS(
+		(reward::DualIntegral{true, {}, false, reward::DualBoundEvent::lp, false, true}), std::invalid_argument);
+}
@@ -1,3 +1,5 @@
+#include <stdexcept>
+
 #include <catch2/catch.hpp>
 
 #include "ecole/reward/solving-time.hpp"
@@ -8,13 +10,13 @@
 using namespace ecole;
 
 TEST_CASE("SolvingTime unit tests", "[unit][reward]") {
-	bool const wall = GENERATE(true, false);
-	reward::unit_tests(reward::SolvingTime{wall});
+	auto const [wall, thread_cpu] = GENERATE(table<bool, bool>({{true, false}, {false, false}, {false, true}}));
+	reward::unit_tests(reward::SolvingTime{wall, thread_cpu});
 }
 
 TEST_CASE("Solving time rewards are positive initially", "[reward]") {
-	bool const wall = GENERATE(true, false);
-	auto reward_func = reward::SolvingTime{wall};
+	auto const [wall, thread_cpu] = GENERATE(table<bool, bool>({{true, false}, {false, false}, {false, true}}));
+	auto reward_func = reward::SolvingTime{wall, thread_cpu};
 	auto model = get_model();  // a non-trivial instance is loaded
 
 	SECTION("Solving time is nonnegative before presolving") {
@@ -28,3 +30,7 @@ TEST_CASE("Solving time rewards are positive initially", "[reward]") {
 		REQUIRE(reward_func.extract(model) > 0);
 	}
 }
+
+TEST_CASE("SolvingTime cannot use the wall time and the thread CPU time", "[reward]") {
+	REQUIRE_THROWS_AS((reward::SolvingTime{true, true}), std::invalid_argument);
+}
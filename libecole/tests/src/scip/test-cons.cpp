@@ -0,0 +1,256 @@
+#include <array>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <objscip/objconshdlr.h>
+#include <scip/scip.h>
+
+#include "ecole/scip/cons.hpp"
+#include "ecole/scip/exception.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+#include "ecole/scip/var.hpp"
+
+using namespace ecole;
+
+namespace {
+
+auto make_model_with_vars(std::size_t n_vars) -> scip::Model {
+	auto model = scip::Model::prob_basic();
+	auto* const scip = model.get_scip_ptr();
+	for (std::size_t i = 0; i < n_vars; ++i) {
+		auto var = scip::create_var_basic(scip, "", 0., 1., 1., SCIP_VARTYPE_BINARY);
+		scip::call(SCIPaddVar, scip, var.get());
+	}
+	return model;
+}
+
+/** Handler of constraints without variables, which counts them with the given return code. */
+class MockConshdlr : public ::scip::ObjConshdlr {
+public:
+	inline static auto constexpr name = "ecole::MockConshdlr";
+
+	MockConshdlr(SCIP* scip, SCIP_RETCODE n_vars_retcode_) :
+		ObjConshdlr(
+			scip,
+			name,
+			"Constraint handler for tests",
+			0,
+			0,
+			0,
+			-1,
+			-1,
+			-1,
+			0,
+			FALSE,
+			FALSE,
+			FALSE,
+			SCIP_PROPTIMING_BEFORELP,
+			SCIP_PRESOLTIMING_FAST),
+		n_vars_retcode{n_vars_retcode_} {}
+
+	auto scip_enfolp(
+		SCIP* /*scip*/,
+		SCIP_CONSHDLR* /*conshdlr*/,
+		SCIP_CONS** /*conss*/,
+		int /*nconss*/,
+		int /*nusefulconss*/,
+		SCIP_Bool /*solinfeasible*/,
+		SCIP_RESULT* result) -> SCIP_RETCODE override {
+		*result = SCIP_FEASIBLE;
+		return SCIP_OKAY;
+	}
+
+	auto scip_enfops(
+		SCIP* /*scip*/,
+		SCIP_CONSHDLR* /*conshdlr*/,
+		SCIP_CONS** /*conss*/,
+		int /*nconss*/,
+		int /*nusefulconss*/,
+		SCIP_Bool /*solinfeasible*/,
+		SCIP_Bool /*objinfeasible*/,
+		SCIP_RESULT* result) -> SCIP_RETCODE override {
+		*result = SCIP_FEASIBLE;
+		return SCIP_OKAY;
+	}
+
+	auto scip_check(
+		SCIP* /*scip*/,
+		SCIP_CONSHDLR* /*conshdlr*/,
+		SCIP_CONS** /*conss*/,
+		int /*nconss*/,
+		SCIP_SOL* /*sol*/,
+		SCIP_Bool /*checkintegrality*/,
+		SCIP_Bool /*checklprows*/,
+		SCIP_Bool /*printreason*/,
+		SCIP_Bool /*completely*/,
+		SCIP_RESULT* result) -> SCIP_RETCODE override {
+		*result = SCIP_FEASIBLE;
+		return SCIP_OKAY;
+	}
+
+	auto scip_lock(
+		SCIP* /*scip*/,
+		SCIP_CONSHDLR* /*conshdlr*/,
+		SCIP_CONS* /*cons*/,
+		SCIP_LOCKTYPE /*locktype*/,
+		int /*nlockspos*/,
+		int /*nlocksneg*/) -> SCIP_RETCODE override {
+		return SCIP_OKAY;
+	}
+
+	auto scip_getnvars(SCIP* /*scip*/, SCIP_CONSHDLR* /*conshdlr*/, SCIP_CONS* /*cons*/, int* nvars, SCIP_Bool* success)
+		-> SCIP_RETCODE override {
+		*nvars = 0;
+		*success = FALSE;
+		return n_vars_retcode;
+	}
+
+private:
+	SCIP_RETCODE n_vars_retcode;
+};
+
+/** Add a constraint of the mock handler to the model. */
+auto add_mock_cons(scip::Model& model, SCIP_RETCODE n_vars_retcode) -> SCIP_CONS* {
+	auto* const scip = model.get_scip_ptr();
+	auto handler = std::make_unique<MockConshdlr>(scip, n_vars_retcode);
+	scip::call(SCIPincludeObjConshdlr, scip, handler.get(), true);
+	// NOLINTNEXTLINE memory ownership is passed to SCIP
+	handler.release();
+	SCIP_CONS* cons = nullptr;
+	scip::call(
+		SCIPcreateCons,
+		scip,
+		&cons,
+		"mock",
+		SCIPfindConshdlr(scip, MockConshdlr::name),
+		nullptr,
+		TRUE,
+		TRUE,
+		TRUE,
+		TRUE,
+		TRUE,
+		FALSE,
+		FALSE,
+		FALSE,
+		FALSE,
+		FALSE);
+	scip::call(SCIPaddCons, scip, cons);
+	scip::call(SCIPreleaseCons, scip, &cons);
+	return model.constraints().back();
+}
+
+}  // namespace
+
+TEST_CASE("Add a batch of linear constraints", "[scip]") {
+	auto constexpr inf = std::numeric_limits<SCIP_Real>::infinity();
+	auto model = make_model_with_vars(3);
+	auto* const scip = model.get_scip_ptr();
+
+	auto batch = scip::LinearConstraintBatch{};
+	batch.add(std::array<std::size_t, 2>{0, 2}, std::array{2., 3.}, -inf, 4.);
+	batch.add(std::array<std::size_t, 3>{0, 1, 2}, 1., 1., inf);
+	REQUIRE(batch.size() == 2);
+	REQUIRE(batch.n_nonzeros() == 5);
+
+	batch.add_to(model);
+	auto const constraints = model.constraints();
+	REQUIRE(constraints.size() == 2);
+	REQUIRE(std::string_view{SCIPconsGetName(constraints[0])} == "c_0");
+	REQUIRE_FALSE(scip::cons_get_finite_lhs(scip, constraints[0]).has_value());
+	REQUIRE(scip::cons_get_rhs(scip, constraints[0]).value() == 4.);
+	auto const vals = scip::get_vals_linear(scip, constraints[0]);
+	REQUIRE(std::vector(vals.begin(), vals.end()) == std::vector{2., 3.});
+	REQUIRE(scip::get_vars_linear(scip, constraints[1]).size() == 3);
+	REQUIRE(scip::cons_get_lhs(scip, constraints[1]).value() == 1.);
+	REQUIRE_FALSE(scip::cons_get_finite_rhs(scip, constraints[1]).has_value());
+}
+
+TEST_CASE("Build a batch of linear constraints from compressed sparse rows", "[scip]") {
+	auto model = make_model_with_vars(2);
+	auto const batch = scip::LinearConstraintBatch{{0, 1, 2}, {0, 1}, {1., -1.}, {0., 0.}, {1., 1.}};
+	batch.add_to(model, nullptr);
+	REQUIRE(model.constraints().size() == 2);
+	REQUIRE(std::string_view{SCIPconsGetName(model.constraints()[1])}.empty());
+	model.solve();
+	REQUIRE(model.is_solved());
+}
+
+TEST_CASE("Throw on invalid batches of linear constraints", "[scip]") {
+	using Batch = scip::LinearConstraintBatch;
+	REQUIRE_THROWS_AS((Batch{{}, {}, {}, {}, {}}), std::invalid_argument);
+	REQUIRE_THROWS_AS((Batch{{0, 2}, {0}, {1.}, {0.}, {1.}}), std::invalid_argument);
+	REQUIRE_THROWS_AS((Batch{{0, 1}, {0}, {1., 2.}, {0.}, {1.}}), std::invalid_argument);
+	REQUIRE_THROWS_AS((Batch{{0, 1}, {0}, {1.}, {}, {1.}}), std::invalid_argument);
+
+	auto batch = Batch{};
+	REQUIRE_THROWS_AS(batch.add(std::array<std::size_t, 1>{0}, std::array{1., 2.}, 0., 1.), std::invalid_argument);
+
+	batch.add(std::array<std::size_t, 1>{5}, 1., 0., 1.);
+	auto model = make_model_with_vars(2);
+	REQUIRE_THROWS_AS(batch.add_to(model), std::out_of_range);
+	REQUIRE(model.constraints().empty());
+}
+
+TEST_CASE("Repeated variables of transformed constraints are merged", "[scip]") {
+	auto model = make_model_with_vars(2);
+	auto* const scip = model.get_scip_ptr();
+	auto const vars = model.variables();
+	auto const cons_vars = std::array<SCIP_VAR const*, 3>{vars[0], vars[1], vars[0]};
+	auto const cons_vals = std::array{1., 3., 2.};
+	auto cons = scip::create_cons_basic_linear(
+		scip, "", cons_vars.size(), cons_vars.data(), cons_vals.data(), -SCIPinfinity(scip), 4.);
+	scip::call(SCIPaddCons, scip, cons.get());
+	model.transform_prob();
+
+	auto const [matrix, biases] = scip::get_all_constraints(scip);
+	REQUIRE(matrix.nnz() == 2);
+	auto coefs = std::vector<SCIP_Real>(2, 0.);
+	for (std::size_t k = 0; k < matrix.nnz(); ++k) {
+		coefs[matrix.indices(1, k)] += matrix.values(k);
+	}
+	REQUIRE(coefs == std::vector{3., 3.});
+	REQUIRE(biases(0) == 4.);
+}
+
+TEST_CASE("Constraint accessors read the variables of constraints", "[scip]") {
+	auto model = make_model_with_vars(2);
+	auto* const scip = model.get_scip_ptr();
+	auto batch = scip::LinearConstraintBatch{};
+	batch.add(std::array<std::size_t, 2>{0, 1}, std::array{2., 3.}, 0., 4.);
+	batch.add_to(model);
+	auto* const cons = model.constraints()[0];
+
+	REQUIRE(scip::get_cons_n_vars(scip, cons) == std::optional<std::size_t>{2});
+	REQUIRE(scip::get_cons_vars(scip, cons).value().size() == 2);
+	REQUIRE(scip::get_cons_vals(scip, cons).value() == std::vector{2., 3.});
+	auto const [vars, vals, lhs, rhs] = scip::get_constraint_linear_coefs(scip, cons).value();
+	REQUIRE(vals == std::vector{2., 3.});
+	REQUIRE(rhs == std::optional<SCIP_Real>{4.});
+}
+
+TEST_CASE("Constraint accessors return nothing for handlers not supporting them", "[scip]") {
+	auto model = make_model_with_vars(1);
+	auto* const scip = model.get_scip_ptr();
+	auto* const cons = add_mock_cons(model, SCIP_OKAY);
+
+	REQUIRE_FALSE(scip::get_cons_n_vars(scip, cons).has_value());
+	REQUIRE_FALSE(scip::get_cons_vars(scip, cons).has_value());
+	REQUIRE_FALSE(scip::get_cons_vals(scip, cons).has_value());
+	REQUIRE_FALSE(scip::get_constraint_linear_coefs(scip, cons).has_value());
+}
+
+TEST_CASE("Constraint accessors throw on SCIP errors", "[scip]") {
+	auto model = make_model_with_vars(1);
+	auto* const scip = model.get_scip_ptr();
+	auto* const cons = add_mock_cons(model, SCIP_ERROR);
+
+	REQUIRE_THROWS_AS(scip::get_cons_n_vars(scip, cons), scip::ScipError);
+	REQUIRE_THROWS_AS(scip::get_cons_vars(scip, cons), scip::ScipError);
+	REQUIRE_THROWS_AS(scip::get_constraint_linear_coefs(scip, cons), scip::ScipError);
+}
@@ -0,0 +1,63 @@
+#include <cstddef>
+
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+
+#include "ecole/scip/exception.hpp"
+#include "ecole/scip/lp-view.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/row.hpp"
+
+#include "conftest.hpp"
+
+using namespace ecole;
+
+TEST_CASE("LpView reads the LP of the current node", "[scip]") {
+	auto model = get_model();
+	REQUIRE_THROWS_AS(model.lp_view(), scip::ScipError);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const lp = model.lp_view();
+
+	SECTION("Columns match the LP columns") {
+		auto const columns = model.lp_columns();
+		REQUIRE(lp->n_columns() == columns.size());
+		for (std::size_t j = 0; j < columns.size(); ++j) {
+			REQUIRE(lp->columns[j] == columns[j]);
+			REQUIRE(lp->column_var_indices[j] == static_cast<std::size_t>(SCIPcolGetVarProbindex(columns[j])));
+			REQUIRE(lp->column_primal_values[j] == SCIPcolGetPrimsol(columns[j]));
+			REQUIRE(lp->column_basis_statuses[j] == SCIPcolGetBasisStatus(columns[j]));
+		}
+	}
+
+	SECTION("Rows match the LP rows") {
+		auto const rows = model.lp_rows();
+		REQUIRE(lp->n_rows() == rows.size());
+		for (std::size_t i = 0; i < rows.size(); ++i) {
+			REQUIRE(lp->row_lhs[i] == SCIProwGetLhs(rows[i]));
+			REQUIRE(lp->row_rhs[i] == SCIProwGetRhs(rows[i]));
+			REQUIRE(lp->row_dual_values[i] == SCIProwGetDualsol(rows[i]));
+			auto const cols = scip::get_cols(rows[i]);
+			auto const vals = scip::get_vals(rows[i]);
+			auto const view_cols = lp->row_columns(i);
+			auto const view_vals = lp->row_values(i);
+			REQUIRE(view_cols.size() == static_cast<std::size_t>(SCIProwGetNLPNonz(rows[i])));
+			for (std::size_t k = 0; k < view_cols.size(); ++k) {
+				REQUIRE(lp->columns[view_cols[k]] == cols[k]);
+				REQUIRE(view_vals[k] == vals[k]);
+			}
+		}
+	}
+
+	SECTION("Share the view on the same LP") {
+		REQUIRE(lp->is_current(model));
+		REQUIRE(model.lp_view() == lp);
+	}
+
+	SECTION("Take a new view on the next node") {
+		model.solve_iter_continue(SCIP_DIDNOTRUN);
+		if (model.stage() == SCIP_STAGE_SOLVING) {
+			REQUIRE_FALSE(lp->is_current(model));
+			REQUIRE(model.lp_view() != lp);
+		}
+	}
+}
@@ -0,0 +1,108 @@
+#include <cstddef>
+
+#include <catch2/catch.hpp>
+#include <scip/scip.h>
+
+#include "ecole/scip/callback.hpp"
+#include "ecole/scip/model-pool.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/scip/utils.hpp"
+
+#include "conftest.hpp"
+
+using namespace ecole;
+
+namespace {
+
+/** Branch on the first candidate until solving terminates, or at most the given number of times. */
+auto branch_on_first(scip::Model& model, std::size_t max_n_branch) -> std::size_t {
+	auto n_branch = std::size_t{0};
+	auto fcall = model.solve_iter(scip::callback::BranchruleConstructor{});
+	for (; fcall.has_value() && n_branch < max_n_branch; ++n_branch) {
+		auto const cands = model.lp_branch_cands();
+		scip::call(SCIPbranchVar, model.get_scip_ptr(), cands[0], nullptr, nullptr, nullptr);
+		fcall = model.solve_iter_continue(SCIP_BRANCHED);
+	}
+	return n_branch;
+}
+
+}  // namespace
+
+TEST_CASE("Released models are recycled", "[scip]") {
+	auto pool = scip::ModelPool{};
+	auto model = pool.from_file(problem_file);
+	auto const* const scip = model.get_scip_ptr();
+	model.set_param("limits/maxsol", 1);
+
+	pool.release(std::move(model));
+	REQUIRE(pool.size() == 1);
+
+	auto recycled = pool.acquire();
+	REQUIRE(pool.size() == 0);
+	REQUIRE(recycled.get_scip_ptr() == scip);
+	REQUIRE(recycled.stage() == SCIP_STAGE_INIT);
+	REQUIRE(recycled.get_param<int>("limits/maxsol") == scip::Model{}.get_param<int>("limits/maxsol"));
+}
+
+TEST_CASE("Recycled models solve iteratively again", "[scip][slow]") {
+	auto pool = scip::ModelPool{};
+	auto model = pool.from_file(problem_file);
+	// Left in the middle of iterative solving
+	branch_on_first(model, 2);
+	pool.release(std::move(model));
+
+	model = pool.from_file(problem_file);
+	REQUIRE(pool.size() == 0);
+	auto reference = scip::Model::from_file(problem_file);
+	REQUIRE(branch_on_first(model, 1000) == branch_on_first(reference, 1000));
+	REQUIRE(model.is_solved());
+
+	SECTION("Disarmed reverse callbacks do not interfere with solving") {
+		pool.release(std::move(model));
+		model = pool.from_file(problem_file);
+		model.solve();
+		REQUIRE(model.is_solved());
+	}
+}
+
+TEST_CASE("Reverse callbacks of recycled models are reused", "[scip]") {
+	auto pool = scip::ModelPool{};
+	auto model = pool.from_file(problem_file);
+	branch_on_first(model, 1);
+	auto const n_branchrules = SCIPgetNBranchrules(model.get_scip_ptr());
+	pool.release(std::move(model));
+
+	model = pool.from_file(problem_file);
+	branch_on_first(model, 1);
+	REQUIRE(SCIPgetNBranchrules(model.get_scip_ptr()) == n_branchrules);
+}
+
+TEST_CASE("Models that cannot be recycled are freed", "[scip]") {
+	SECTION("Models with a different plugin profile") {
+		auto pool = scip::ModelPool{scip::PluginProfile::branching};
+		pool.release(scip::Model{scip::PluginProfile::full});
+		REQUIRE(pool.size() == 0);
+	}
+
+	SECTION("Models not created by the pool") {
+		auto pool = scip::ModelPool{};
+		pool.release(get_model().copy_orig());
+		REQUIRE(pool.size() == 0);
+	}
+
+	SECTION("Models beyond the maximum size") {
+		auto pool = scip::ModelPool{scip::PluginProfile::full, 1};
+		pool.release(pool.acquire());
+		pool.release(scip::Model{});
+		REQUIRE(pool.size() == 1);
+	}
+}
+
+TEST_CASE("Reserved models are available", "[scip]") {
+	auto pool = scip::ModelPool{scip::PluginProfile::full, 2};
+	pool.reserve(1);
+	REQUIRE(pool.size() == 1);
+	pool.reserve(3);
+	REQUIRE(pool.size() == 2);
+	REQUIRE(pool.acquire().stage() == SCIP_STAGE_INIT);
+}
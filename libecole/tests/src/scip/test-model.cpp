@@ -1,10 +1,17 @@
 #include <array>
+#include <cstddef>
+#include <fstream>
+#include <functional>
 #include <future>
+#include <iterator>
 #include <limits>
+#include <optional>
 #include <random>
+#include <stdexcept>
 #include <string>
 
 #include <catch2/catch.hpp>
+#include <scip/cons_sos1.h>
 #include <scip/scip.h>
 
 #include "ecole/random.hpp"
@@ -12,8 +19,10 @@
 #include "ecole/scip/exception.hpp"
 #include "ecole/scip/model.hpp"
 #include "ecole/scip/utils.hpp"
+#include "ecole/utility/coroutine.hpp"
 
 #include "conftest.hpp"
+#include "test-utility/tmp-folder.hpp"
 
 using namespace ecole;
 
@@ -28,14 +37,268 @@ TEST_CASE("Equality comparison", "[scip]") {
 	REQUIRE(model != model.copy_orig());
 }
 
+TEST_CASE("Model copies in multiple threads", "[scip][slow]") {
+	auto const model = get_model();
+	auto const n_vars = model.variables().size();
+	auto const copy_many = [n_vars](scip::Model const& source) {
+		for (auto i = 0; i < 5; ++i) {
+			auto copy = source.copy_orig();
+			if (copy.variables().size() != n_vars) {
+				return false;
+			}
+			copy.presolve();
+		}
+		return true;
+	};
+
+	SECTION("From the same source") {
+		auto fut1 = std::async(std::launch::async, copy_many, std::cref(model));
+		auto fut2 = std::async(std::launch::async, copy_many, std::cref(model));
+		REQUIRE((fut1.get() && fut2.get()));
+	}
+
+	SECTION("From different sources") {
+		auto const model_copy = model.copy_orig();
+		auto fut1 = std::async(std::launch::async, copy_many, std::cref(model));
+		auto fut2 = std::async(std::launch::async, copy_many, std::cref(model_copy));
+		REQUIRE((fut1.get() && fut2.get()));
+	}
+}
+
+TEST_CASE("Fork model from current node", "[scip][slow]") {
+	auto model = get_model(SCIP_STAGE_SOLVING);
+	REQUIRE(model.stage() == SCIP_STAGE_SOLVING);
+	auto fork = model.fork();
+	REQUIRE(fork != model);
+	REQUIRE(fork.stage() == SCIP_STAGE_PROBLEM);
+
+	SECTION("Solve the fork independently") {
+		model.solve_iter_continue(SCIP_DIDNOTRUN);
+		fork.solve();
+		REQUIRE(fork.is_solved());
+	}
+
+	SECTION("Fork again from the fork") {
+		auto fork_of_fork = fork.fork();
+		REQUIRE(fork_of_fork.variables().size() == fork.variables().size());
+	}
+}
+
 TEST_CASE("Create model from file", "[scip]") {
 	auto model = scip::Model::from_file(problem_file);
 }
 
+TEST_CASE("Create model with a plugin profile", "[scip]") {
+	auto const profile = GENERATE(scip::PluginProfile::modeling, scip::PluginProfile::branching);
+	auto full = scip::Model::from_file(problem_file);
+	auto model = scip::Model::from_file(problem_file, profile);
+	REQUIRE(model.variables().size() == full.variables().size());
+	REQUIRE(model.constraints().size() == full.constraints().size());
+	REQUIRE(SCIPgetNHeurs(model.get_scip_ptr()) == 0);
+	REQUIRE(SCIPgetNConshdlrs(model.get_scip_ptr()) < SCIPgetNConshdlrs(full.get_scip_ptr()));
+
+	SECTION("Copies have the same plugins") {
+		auto copy = model.copy_orig();
+		REQUIRE(SCIPgetNConshdlrs(copy.get_scip_ptr()) == SCIPgetNConshdlrs(model.get_scip_ptr()));
+	}
+
+	if (profile == scip::PluginProfile::branching) {
+		SECTION("Solve without default heuristics and separators") {
+			model.solve();
+			REQUIRE(model.is_solved());
+		}
+	}
+}
+
+TEST_CASE("Copy only the problem of a model", "[scip]") {
+	auto model = scip::Model::from_file(problem_file);
+
+	SECTION("Copy the original problem with the plugins of the profile") {
+		auto copy = model.copy_problem(scip::PluginProfile::branching);
+		REQUIRE(copy.has_value());
+		REQUIRE(copy->variables().size() == model.variables().size());
+		REQUIRE(copy->constraints().size() == model.constraints().size());
+		REQUIRE(SCIPgetNHeurs(copy->get_scip_ptr()) == 0);
+		copy->solve();
+		REQUIRE(copy->is_solved());
+	}
+
+	SECTION("Copy the transformed problem") {
+		model.presolve();
+		auto copy = model.copy_problem(scip::PluginProfile::branching);
+		REQUIRE(copy.has_value());
+		REQUIRE(copy->stage() == SCIP_STAGE_PROBLEM);
+		REQUIRE(copy->variables().size() == model.variables().size());
+	}
+
+	SECTION("Do not copy constraints that the profile cannot handle") {
+		auto* const scip = model.get_scip_ptr();
+		auto vars = model.variables();
+		SCIP_CONS* cons = nullptr;
+		scip::call(SCIPcreateConsBasicSOS1, scip, &cons, "sos", 2, vars.data(), nullptr);
+		scip::call(SCIPaddCons, scip, cons);
+		scip::call(SCIPreleaseCons, scip, &cons);
+		REQUIRE_FALSE(model.copy_problem(scip::PluginProfile::branching).has_value());
+	}
+}
+
+TEST_CASE("Load the problem of another model", "[scip]") {
+	auto model = get_model();
+	auto presolved = scip::Model::from_file(problem_file);
+	presolved.presolve();
+
+	SECTION("The transformed problem becomes the original one") {
+		model.set_param("branching/scorefunc", 'p');
+		REQUIRE(model.load_problem(presolved));
+		REQUIRE(model.stage() == SCIP_STAGE_PROBLEM);
+		REQUIRE(model.variables().size() == presolved.variables().size());
+		REQUIRE(model.get_param<char>("branching/scorefunc") == 'p');
+		model.solve();
+		REQUIRE(model.is_solved());
+	}
+
+	SECTION("Do not load a model without problem, or the model itself") {
+		auto const n_vars = model.variables().size();
+		REQUIRE_FALSE(model.load_problem(scip::Model{}));
+		REQUIRE_FALSE(model.load_problem(model));
+		REQUIRE(model.variables().size() == n_vars);
+	}
+
+	SECTION("Leave the model untouched when it cannot handle the constraints") {
+		auto source = scip::Model::from_file(problem_file);
+		auto* const scip = source.get_scip_ptr();
+		auto vars = source.variables();
+		SCIP_CONS* cons = nullptr;
+		scip::call(SCIPcreateConsBasicSOS1, scip, &cons, "sos", 2, vars.data(), nullptr);
+		scip::call(SCIPaddCons, scip, cons);
+		scip::call(SCIPreleaseCons, scip, &cons);
+		auto target = scip::Model::from_file(problem_file, scip::PluginProfile::branching);
+		auto const n_conss = target.constraints().size();
+		REQUIRE_FALSE(target.load_problem(source));
+		REQUIRE(target.constraints().size() == n_conss);
+		target.solve();
+		REQUIRE(target.is_solved());
+	}
+}
+
 TEST_CASE("Raise if file does not exist", "[scip]") {
 	REQUIRE_THROWS_AS(scip::Model::from_file("/does_not_exist.mps"), scip::ScipError);
 }
 
+TEST_CASE("Create model from a buffer", "[scip]") {
+	auto file = std::ifstream{problem_file, std::ios::binary};
+	auto const data = std::string{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+	auto from_file = scip::Model::from_file(problem_file);
+	auto model = scip::Model::from_buffer(data, "mps");
+	REQUIRE(model.variables().size() == from_file.variables().size());
+	REQUIRE(model.constraints().size() == from_file.constraints().size());
+
+	SECTION("Raise if the data is not in the given format") {
+		REQUIRE_THROWS_AS(scip::Model::from_buffer("not a problem", "mps"), scip::ScipError);
+	}
+}
+
+TEST_CASE("Fingerprint recognizes the same problem", "[scip]") {
+	auto model = scip::Model::from_file(problem_file);
+	auto const fingerprint = model.fingerprint();
+	REQUIRE(scip::Model::from_file(problem_file).fingerprint() == fingerprint);
+	REQUIRE(model.copy_orig().fingerprint() == fingerprint);
+
+	SECTION("Change with the objective") {
+		auto* const var = model.variables()[0];
+		scip::call(SCIPchgVarObj, model.get_scip_ptr(), var, SCIPvarGetObj(var) + 1.);
+		REQUIRE(model.fingerprint() != fingerprint);
+	}
+
+	SECTION("Cover all the data of linear problems") {
+		REQUIRE(model.exact_fingerprint() == fingerprint);
+	}
+
+	SECTION("Change with the objective sense") {
+		scip::call(SCIPsetObjsense, model.get_scip_ptr(), SCIP_OBJSENSE_MAXIMIZE);
+		REQUIRE(model.fingerprint() != fingerprint);
+	}
+
+	SECTION("Change with the objective offset") {
+		scip::call(SCIPaddOrigObjoffset, model.get_scip_ptr(), 1.);
+		REQUIRE(model.fingerprint() != fingerprint);
+	}
+
+	SECTION("Ignore the name") {
+		model.set_name("renamed");
+		REQUIRE(model.fingerprint() == fingerprint);
+	}
+
+	SECTION("Are not exact with constraints without sides") {
+		auto* const scip = model.get_scip_ptr();
+		auto vars = model.variables();
+		SCIP_CONS* cons = nullptr;
+		scip::call(SCIPcreateConsBasicSOS1, scip, &cons, "sos", 2, vars.data(), nullptr);
+		scip::call(SCIPaddCons, scip, cons);
+		scip::call(SCIPreleaseCons, scip, &cons);
+		REQUIRE_FALSE(model.exact_fingerprint().has_value());
+	}
+}
+
+TEST_CASE("Memory usage accounts for the solver and the LP view", "[scip]") {
+	auto model = get_model();
+	auto const before = model.memory_usage();
+	REQUIRE(before.scip_used > 0);
+	REQUIRE(before.scip_total >= before.scip_used);
+	REQUIRE(before.lp_view == 0);
+
+	static_cast<void>(model.lp_view());
+	REQUIRE(model.memory_usage().lp_view > 0);
+}
+
+TEST_CASE("Binary problems are read back identical", "[scip]") {
+	auto const tmp = TmpFolderRAII{};
+	auto const filename = tmp.make_subpath(".bin");
+	auto model = get_model();
+	model.save_binary(filename);
+	auto loaded = scip::Model::load_binary(filename);
+
+	REQUIRE(loaded.name() == model.name());
+	auto const vars = model.variables();
+	auto const loaded_vars = loaded.variables();
+	REQUIRE(loaded_vars.size() == vars.size());
+	for (std::size_t i = 0; i < vars.size(); ++i) {
+		REQUIRE(std::string{SCIPvarGetName(loaded_vars[i])} == SCIPvarGetName(vars[i]));
+		REQUIRE(SCIPvarGetType(loaded_vars[i]) == SCIPvarGetType(vars[i]));
+		REQUIRE(SCIPvarGetLbOriginal(loaded_vars[i]) == SCIPvarGetLbOriginal(vars[i]));
+		REQUIRE(SCIPvarGetUbOriginal(loaded_vars[i]) == SCIPvarGetUbOriginal(vars[i]));
+		REQUIRE(SCIPvarGetObj(loaded_vars[i]) == SCIPvarGetObj(vars[i]));
+	}
+	REQUIRE(loaded.constraints().size() == model.constraints().size());
+
+	SECTION("Solve to the same objective") {
+		model.solve();
+		loaded.solve();
+		REQUIRE(loaded.primal_bound() == Approx(model.primal_bound()));
+	}
+
+	SECTION("Only problems with default linear constraints are exact") {
+		REQUIRE(model.is_binary_exact());
+		REQUIRE(loaded.is_binary_exact());
+		scip::call(SCIPsetConsRemovable, model.get_scip_ptr(), model.constraints()[0], TRUE);
+		REQUIRE_FALSE(model.is_binary_exact());
+	}
+
+	SECTION("Raise on invalid files") {
+		auto const other = tmp.make_subpath(".bin");
+		std::ofstream{other, std::ios::binary} << "ECOLEBIN";
+		REQUIRE_THROWS_AS(scip::Model::load_binary(other), scip::ScipError);
+	}
+
+	SECTION("Binary problems in memory are the same as in files") {
+		auto const data = model.to_binary();
+		auto const in_memory = scip::Model::from_binary(data);
+		REQUIRE(in_memory.to_binary() == data);
+		REQUIRE(loaded.to_binary() == data);
+		REQUIRE_THROWS_AS(scip::Model::from_binary(data.substr(0, data.size() / 2)), scip::ScipError);
+	}
+}
+
 TEST_CASE("Model transform", "[scip][slow]") {
 	auto model = get_model();
 	model.transform_prob();
@@ -105,6 +368,34 @@ TEST_CASE("Explicit parameter management", "[scip]") {
 	}
 }
 
+TEST_CASE("Parameter handles", "[scip]") {
+	auto model = scip::Model{};
+	auto constexpr int_param = "conflict/minmaxvars";
+
+	SECTION("Get and set through the handle") {
+		auto const handle = model.param_handle<ParamType::Int>(int_param);
+		REQUIRE(handle.get() == model.get_param<ParamType::Int>(int_param));
+		handle.set(3);
+		REQUIRE(model.get_param<ParamType::Int>(int_param) == 3);
+		model.set_param<ParamType::Int>(int_param, 4);
+		REQUIRE(handle.get() == 4);
+	}
+
+	SECTION("Throw on wrong parameter value") {
+		auto const handle = model.param_handle<ParamType::Int>(int_param);
+		REQUIRE_THROWS_AS(handle.set(-3), scip::ScipError);
+	}
+
+	SECTION("Throw on wrong parameters type") {
+		REQUIRE_THROWS_AS(model.param_handle<ParamType::Real>(int_param), scip::ScipError);
+		REQUIRE_THROWS_WITH(model.param_handle<ParamType::Real>(int_param), Contains(int_param));
+	}
+
+	SECTION("Throw on unknown parameters") {
+		REQUIRE_THROWS_AS(model.param_handle<ParamType::Int>("not a parameter"), scip::ScipError);
+	}
+}
+
 TEST_CASE("Automatic parameter management", "[scip]") {
 	auto model = scip::Model{};
 	auto constexpr int_param = "conflict/minmaxvars";
@@ -173,10 +464,24 @@ TEST_CASE("Map parameter management", "[scip]") {
 		model.set_params(vals);
 		REQUIRE(vals[int_param] == scip::Param{model.get_param<int>(int_param)});
 	}
+
+	SECTION("Set map of parameters with values of other types") {
+		model.set_params({{int_param, 3.0}});
+		REQUIRE(model.get_param<int>(int_param) == 3);
+	}
+
+	SECTION("Extract map of changed parameters") {
+		REQUIRE(model.get_changed_params().count(int_param) == 0);
+		model.set_param(int_param, model.get_param<int>(int_param) + 1);
+		auto const vals = model.get_changed_params();
+		REQUIRE(vals.size() < model.get_params().size());
+		REQUIRE(vals.at(int_param) == scip::Param{model.get_param<int>(int_param)});
+	}
 }
 
 TEST_CASE("Iterative branching", "[scip][slow]") {
 	auto model = get_model();
+	model.set_coroutine_backend(GENERATE(utility::CoroutineBackend::Thread, utility::CoroutineBackend::ThreadCache));
 	auto fcall = model.solve_iter(scip::callback::BranchruleConstructor{});
 
 	SECTION("Destructed before done") {}
@@ -201,9 +506,11 @@ TEST_CASE("Iterative branching", "[scip][slow]") {
 
 TEST_CASE("Iterative solving", "[scip][slow]") {
 	auto model = get_model();
-	auto const constructors = std::array<scip::callback::DynamicConstructor, 2>{
+	auto const constructors = std::array<scip::callback::DynamicConstructor, 4>{
 		scip::callback::BranchruleConstructor{},
 		scip::callback::HeuristicConstructor{},
+		scip::callback::NodeselConstructor{},
+		scip::callback::CutselConstructor{},
 	};
 	auto maybe_fcall = model.solve_iter(constructors);
 
@@ -212,6 +519,8 @@ TEST_CASE("Iterative solving", "[scip][slow]") {
 	SECTION("Using SCIP default") {
 		auto used_branchrule = false;
 		auto used_heuristic = false;
+		auto used_nodesel = false;
+		auto used_cutsel = false;
 		while (maybe_fcall.has_value()) {
 			std::visit(
 				[&](auto fcall) {
@@ -219,6 +528,10 @@ TEST_CASE("Iterative solving", "[scip][slow]") {
 						used_branchrule = true;
 					} else if constexpr (std::is_same_v<decltype(fcall), scip::callback::HeuristicCall>) {
 						used_heuristic = true;
+					} else if constexpr (std::is_same_v<decltype(fcall), scip::callback::NodeselCall>) {
+						used_nodesel = true;
+					} else if constexpr (std::is_same_v<decltype(fcall), scip::callback::CutselCall>) {
+						used_cutsel = true;
 					}
 				},
 				maybe_fcall.value());
@@ -226,5 +539,154 @@ TEST_CASE("Iterative solving", "[scip][slow]") {
 		}
 		REQUIRE(used_branchrule);
 		REQUIRE(used_heuristic);
+		REQUIRE(used_nodesel);
+		REQUIRE(used_cutsel);
+	}
+}
+
+TEST_CASE("Iterative solving on separators, presolvers, and events", "[scip][slow]") {
+	// Presolving and separation are disabled by get_model
+	auto model = scip::Model::from_file(problem_file);
+	auto const constructors = std::array<scip::callback::DynamicConstructor, 3>{
+		scip::callback::SeparatorConstructor{},
+		scip::callback::PresolverConstructor{},
+		scip::callback::EventHandlerConstructor{},
+	};
+	auto maybe_fcall = model.solve_iter(constructors);
+
+	auto used_separator = false;
+	auto used_presolver = false;
+	auto n_solved_nodes = std::size_t{0};
+	while (maybe_fcall.has_value()) {
+		std::visit(
+			[&](auto fcall) {
+				if constexpr (std::is_same_v<decltype(fcall), scip::callback::SeparatorCall>) {
+					REQUIRE(fcall.constructor_index == 0);
+					used_separator = true;
+				} else if constexpr (std::is_same_v<decltype(fcall), scip::callback::PresolverCall>) {
+					REQUIRE(fcall.constructor_index == 1);
+					used_presolver = true;
+				} else if constexpr (std::is_same_v<decltype(fcall), scip::callback::EventHandlerCall>) {
+					REQUIRE(fcall.constructor_index == 2);
+					REQUIRE((fcall.event_type & SCIP_EVENTTYPE_NODESOLVED) != 0);
+					++n_solved_nodes;
+				}
+			},
+			maybe_fcall.value());
+		maybe_fcall = model.solve_iter_continue(SCIP_DIDNOTRUN);
+	}
+	REQUIRE(model.is_solved());
+	REQUIRE(used_separator);
+	REQUIRE(used_presolver);
+	REQUIRE(n_solved_nodes > 0);
+}
+
+TEST_CASE("Handlers decline separator calls in the solver thread", "[scip][slow]") {
+	auto model = scip::Model::from_file(problem_file);
+	auto constructor = scip::callback::SeparatorConstructor{};
+	constructor.handler = [](SCIP* /*scip*/, scip::callback::SeparatorCall const& /*call*/) {
+		return std::optional<SCIP_RESULT>{SCIP_DIDNOTRUN};
+	};
+	REQUIRE_FALSE(model.solve_iter(constructor).has_value());
+	REQUIRE(model.is_solved());
+	REQUIRE(model.callback_statistics().n_yields == 0);
+	REQUIRE(model.callback_statistics().n_skipped_calls > 0);
+}
+
+TEST_CASE("Exceptions of handlers are rethrown by iterative solving", "[scip]") {
+	auto model = scip::Model::from_file(problem_file);
+	auto constructor = scip::callback::SeparatorConstructor{};
+	constructor.handler = [](SCIP* /*scip*/, auto const& /*call*/) -> std::optional<SCIP_RESULT> {
+		throw std::logic_error{"Handler error"};
+	};
+	// Rather than the SCIP error it is turned into to go through SCIP
+	REQUIRE_THROWS_AS(model.solve_iter(constructor), std::logic_error);
+}
+
+TEST_CASE("Exceptions of branchrule handlers are rethrown by iterative solving", "[scip]") {
+	auto model = get_model();
+	auto constructor = scip::callback::BranchruleConstructor{};
+	constructor.handler = [](SCIP* /*scip*/, auto const& /*call*/) -> std::optional<SCIP_RESULT> {
+		throw std::logic_error{"Handler error"};
+	};
+	REQUIRE_THROWS_AS(model.solve_iter(constructor), std::logic_error);
+}
+
+TEST_CASE("Iterative solving only yields the requested branchrule calls", "[scip][slow]") {
+	auto model = get_model();
+	auto constructor = scip::callback::BranchruleConstructor{};
+	constructor.yield_external = false;
+	constructor.yield_pseudo = false;
+	// Pseudo solution branching happens when the LP is not solved
+	model.set_param("lp/solvefreq", -1);
+	auto maybe_fcall = model.solve_iter(constructor);
+	while (maybe_fcall.has_value()) {
+		auto const& call = std::get<scip::callback::BranchruleCall>(maybe_fcall.value());
+		REQUIRE(call.where == scip::callback::BranchruleCall::Where::LP);
+		maybe_fcall = model.solve_iter_continue(SCIP_DIDNOTRUN);
+	}
+	REQUIRE(model.is_solved());
+}
+
+TEST_CASE("Iterative solving tells apart callbacks of the same type", "[scip][slow]") {
+	auto model = get_model();
+	auto pseudo_only = scip::callback::BranchruleConstructor{};
+	pseudo_only.yield_lp = false;
+	pseudo_only.yield_external = false;
+	auto lp_only = scip::callback::BranchruleConstructor{};
+	lp_only.priority = scip::callback::priority_max - 1;
+	lp_only.yield_external = false;
+	lp_only.yield_pseudo = false;
+	auto const constructors = std::array<scip::callback::DynamicConstructor, 2>{pseudo_only, lp_only};
+
+	auto maybe_fcall = model.solve_iter(constructors);
+	REQUIRE(maybe_fcall.has_value());
+	while (maybe_fcall.has_value()) {
+		auto const& call = std::get<scip::callback::BranchruleCall>(maybe_fcall.value());
+		if (call.where == scip::callback::BranchruleCall::Where::LP) {
+			REQUIRE(call.constructor_index == 1);
+		} else {
+			REQUIRE(call.constructor_index == 0);
+		}
+		maybe_fcall = model.solve_iter_continue(SCIP_DIDNOTRUN);
+	}
+	REQUIRE(model.is_solved());
+}
+
+TEST_CASE("Models capture their log in a ring buffer", "[scip][slow]") {
+	auto model = get_model();
+	REQUIRE(model.captured_log().empty());
+
+	SECTION("Capture the log of solving") {
+		model.capture_log();
+		model.solve();
+		auto const log = model.captured_log();
+		REQUIRE(log.find("SCIP Status") != std::string::npos);
+		model.clear_captured_log();
+		REQUIRE(model.captured_log().empty());
+	}
+
+	SECTION("Keep the last full lines when the buffer is full") {
+		constexpr auto capacity = std::size_t{200};
+		model.capture_log(capacity);
+		model.solve();
+		auto const log = model.captured_log();
+		REQUIRE(!log.empty());
+		REQUIRE(log.size() <= capacity);
+		REQUIRE(log.back() == '\n');
+	}
+
+	SECTION("Copies do not capture the log") {
+		model.capture_log();
+		auto copy = model.copy_orig();
+		copy.solve();
+		REQUIRE(copy.captured_log().empty());
+	}
+
+	SECTION("Stop capturing") {
+		model.capture_log();
+		model.capture_log(0);
+		model.solve();
+		REQUIRE(model.captured_log().empty());
 	}
 }
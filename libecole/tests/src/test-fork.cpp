@@ -0,0 +1,27 @@
+#include <stdexcept>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/fork.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Running threads are counted", "[fork]") {
+	auto const n_threads = n_running_threads();
+	{
+		auto pool = utility::ThreadPool{2};
+		REQUIRE(n_running_threads() == n_threads + 2);
+		if (n_threads == 0) {
+			REQUIRE_THROWS_AS(check_fork_safe(), std::runtime_error);
+		}
+	}
+	REQUIRE(n_running_threads() == n_threads);
+}
+
+TEST_CASE("Prewarming leaves no thread running", "[fork][slow]") {
+	auto const n_threads = n_running_threads();
+	SECTION("Solving with all plugins") { prewarm(); }
+	SECTION("Modeling plugins only") { prewarm(scip::PluginProfile::modeling); }
+	REQUIRE(n_running_threads() == n_threads);
+}
@@ -1,3 +1,7 @@
+#include <random>
+#include <stdexcept>
+#include <string>
+
 #include <catch2/catch.hpp>
 
 #include "ecole/random.hpp"
@@ -32,3 +36,77 @@ TEST_CASE("Random generator serialization", "[random]") {
 	auto const rng_copy = deserialize(data);
 	REQUIRE(rng == rng_copy);
 }
+
+TEST_CASE("Random generator binary serialization", "[random]") {
+	auto rng = RandomGenerator{42};  // NOLINT This is deterministic for the test
+	rng.discard(1000);
+	auto const data = serialize_binary(rng);
+	REQUIRE(data.size() < serialize(rng).size());
+
+	auto rng_copy = deserialize_binary(data);
+	REQUIRE(rng == rng_copy);
+	REQUIRE(rng() == rng_copy());
+
+	SECTION("Text and binary formats are interchangeable") { REQUIRE(deserialize(serialize(rng_copy)) == rng_copy); }
+
+	SECTION("Invalid data throws") {
+		REQUIRE_THROWS_AS(deserialize_binary(data.substr(1)), std::invalid_argument);
+		REQUIRE_THROWS_AS(deserialize_binary(std::string(data.size(), 'a')), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Random generators generate the same values as std::mt19937", "[random]") {
+	auto rng = RandomGenerator{42};  // NOLINT This is deterministic for the test
+	auto std_rng = std::mt19937{42};  // NOLINT This is deterministic for the test
+	for (auto i = 0; i < 2000; ++i) {
+		REQUIRE(rng() == std_rng());
+	}
+
+	auto seeds = std::seed_seq{1, 2, 3};
+	auto std_seeds = std::seed_seq{1, 2, 3};
+	REQUIRE(RandomGenerator{seeds}() == std::mt19937{std_seeds}());
+
+	SECTION("Generators are copied rather than taken as seed sequences") {
+		rng.discard(10);  // NOLINT(readability-magic-numbers)
+		auto rng_copy = RandomGenerator{rng};
+		REQUIRE(rng_copy == rng);
+	}
+}
+
+TEST_CASE("Random generator streams do not depend on the order of calls", "[random]") {
+	ecole::seed(0);
+	auto const rng_1 = ecole::spawn_random_generator(1);
+	auto const rng_2 = ecole::spawn_random_generator(2);
+	ecole::seed(0);
+	REQUIRE(ecole::spawn_random_generator(2) == rng_2);
+	REQUIRE(ecole::spawn_random_generator(1) == rng_1);
+	REQUIRE(rng_1 != rng_2);
+}
+
+TEST_CASE("Derived random generators are independent of the parent", "[random]") {
+	auto const rng = RandomGenerator{42};  // NOLINT This is deterministic for the test
+	auto const derived = derive_random_generator(rng, 0);
+	REQUIRE(derive_random_generator(rng, 0) == derived);
+	REQUIRE(derive_random_generator(rng, 1) != derived);
+	REQUIRE(derived != rng);
+}
+
+TEST_CASE("Split random generators", "[random]") {
+	auto rng = RandomGenerator{42};  // NOLINT This is deterministic for the test
+	auto const original = rng;
+	auto const rngs = split_random_generator(rng, 3);
+	REQUIRE(rngs.size() == 3);
+	REQUIRE(rngs[0] != rngs[1]);
+	REQUIRE(rngs[1] != rngs[2]);
+	REQUIRE(rngs[0] == derive_random_generator(original, 0));
+
+	SECTION("Successive splits are different") {
+		REQUIRE(rng != original);
+		REQUIRE(split_random_generator(rng, 3)[0] != rngs[0]);
+	}
+
+	SECTION("Splits are reproducible") {
+		auto other = original;
+		REQUIRE(split_random_generator(other, 3) == rngs);
+	}
+}
@@ -4,7 +4,10 @@
 
 #include "ecole/environment/configuring.hpp"
 #include "ecole/information/abstract.hpp"
+#include "ecole/information/nothing.hpp"
+#include "ecole/observation/nothing.hpp"
 #include "ecole/reward/abstract.hpp"
+#include "ecole/reward/constant.hpp"
 #include "ecole/traits.hpp"
 
 using namespace ecole;
@@ -168,3 +171,9 @@ TEST_CASE("Detect action set type", "[trait]") {
 	STATIC_REQUIRE_SAME(trait::action_set_of_t<environment::Configuring<>>, ecole::NoneType);
 	STATIC_REQUIRE_SAME(trait::action_set_of_t<dynamics::ConfiguringDynamics>, ecole::NoneType);
 }
+
+TEST_CASE("Detect data functions extracting nothing", "[trait]") {
+	STATIC_REQUIRE(trait::extracts_nothing_v<observation::Nothing>);
+	STATIC_REQUIRE(trait::extracts_nothing_v<information::Nothing>);
+	STATIC_REQUIRE_FALSE(trait::extracts_nothing_v<reward::Constant>);
+}
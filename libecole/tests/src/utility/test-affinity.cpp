@@ -0,0 +1,37 @@
+#include <algorithm>
+#include <thread>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/utility/affinity.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Physical cores partition the CPUs of the thread", "[utility]") {
+	auto const allowed = utility::thread_affinity();
+	auto cpus = utility::CpuSet{};
+	for (auto const& core : utility::physical_cores()) {
+		REQUIRE_FALSE(core.empty());
+		REQUIRE(std::is_sorted(core.begin(), core.end()));
+		cpus.insert(cpus.end(), core.begin(), core.end());
+	}
+	std::sort(cpus.begin(), cpus.end());
+	REQUIRE(cpus == allowed);
+}
+
+TEST_CASE("Scoped affinity restores the affinity of the thread", "[utility]") {
+	// Ran in a new thread to leave the affinity of the test thread untouched on failure
+	std::thread{[] {
+		auto const allowed = utility::thread_affinity();
+		if (allowed.empty()) {
+			return;
+		}
+		auto const core = utility::physical_cores().front();
+		{
+			auto const pinned = utility::ScopedAffinity{core};
+			REQUIRE(utility::thread_affinity() == core);
+		}
+		REQUIRE(utility::thread_affinity() == allowed);
+		REQUIRE_FALSE(utility::set_thread_affinity({}));
+	}}.join();
+}
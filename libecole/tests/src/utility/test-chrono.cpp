@@ -1,3 +1,6 @@
+#include <chrono>
+#include <future>
+
 #include <catch2/catch.hpp>
 
 #include "ecole/utility/chrono.hpp"
@@ -9,3 +12,37 @@ TEST_CASE("cpu_clock is monotonic", "[utility]") {
 	auto const after = utility::cpu_clock::now();
 	REQUIRE(before <= after);
 }
+
+TEST_CASE("coarse_steady_clock is monotonic", "[utility]") {
+	auto const before = utility::coarse_steady_clock::now();
+	auto const after = utility::coarse_steady_clock::now();
+	REQUIRE(before <= after);
+}
+
+TEST_CASE("thread_cpu_clock is monotonic", "[utility]") {
+	auto const before = utility::thread_cpu_clock::now();
+	auto const after = utility::thread_cpu_clock::now();
+	REQUIRE(before <= after);
+}
+
+TEST_CASE("ThreadsCpuTimer adds the time of every thread reading it", "[utility]") {
+	auto timer = utility::ThreadsCpuTimer{};
+	// The first read of a thread only sets its reference point
+	REQUIRE(timer.elapsed() == std::chrono::nanoseconds{0});
+
+	auto const busy = [&timer] {
+		timer.elapsed();
+		auto const start = utility::thread_cpu_clock::now();
+		while (utility::thread_cpu_clock::now() - start < std::chrono::milliseconds{5}) {
+		}
+		return timer.elapsed();
+	};
+	auto const after_other = std::async(std::launch::async, busy).get();
+	REQUIRE(after_other >= std::chrono::milliseconds{5});
+	REQUIRE(timer.elapsed() >= after_other);
+
+	SECTION("Reset the timer") {
+		timer.reset();
+		REQUIRE(timer.elapsed() == std::chrono::nanoseconds{0});
+	}
+}
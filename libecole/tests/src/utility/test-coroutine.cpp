@@ -1,9 +1,12 @@
 #include <catch2/catch.hpp>
+#include <chrono>
 #include <memory>
+#include <thread>
 #include <variant>
 
 #include "ecole/none.hpp"
 #include "ecole/scip/scimpl.hpp"
+#include "ecole/utility/affinity.hpp"
 #include "ecole/utility/coroutine.hpp"
 
 using namespace ecole;
@@ -43,8 +46,9 @@ TEST_CASE("Coroutine can return values", "[utility]") {
 	using Coroutine = utility::Coroutine<int, NoneType>;
 	using Executor = Coroutine::Executor;
 	auto const max = GENERATE(0, 1, 5);
+	auto const backend = GENERATE(utility::CoroutineBackend::Thread, utility::CoroutineBackend::ThreadCache);
 
-	auto co = Coroutine{[max](Executor& executor) {
+	auto co = Coroutine{backend, [max](Executor& executor) {
 		for (int i = 0; i < max; ++i) {
 			auto message = executor.yield(i);
 			if (Executor::is_stop(message)) {
@@ -86,3 +90,106 @@ TEST_CASE("Coroutine can send messages", "[utility]") {
 	REQUIRE(ret.has_value());
 	REQUIRE(ret.value() == message);
 }
+
+TEST_CASE("Cached coroutines reuse threads", "[utility]") {
+	using Coroutine = utility::Coroutine<NoneType, NoneType>;
+	using Executor = Coroutine::Executor;
+
+	auto run_one = [] {
+		auto co = Coroutine{utility::CoroutineBackend::ThreadCache, [](Executor& executor) { executor.yield(None); }};
+		REQUIRE(co.wait().has_value());
+		co.resume(None);
+		REQUIRE_FALSE(co.wait().has_value());
+	};
+
+	run_one();
+	auto const n_threads = utility::ThreadCache::global().size();
+	for (auto i = 0; i < 10; ++i) {
+		run_one();
+	}
+	REQUIRE(utility::ThreadCache::global().size() == n_threads);
+}
+
+TEST_CASE("Coroutine executors follow the affinity of their caller", "[utility]") {
+	using Coroutine = utility::Coroutine<utility::CpuSet, NoneType>;
+	using Executor = Coroutine::Executor;
+
+	auto const backend = GENERATE(utility::CoroutineBackend::Thread, utility::CoroutineBackend::ThreadCache);
+	auto const yield_affinity = [](Executor& executor) { executor.yield(utility::thread_affinity()); };
+	// Ran in a new thread to leave the affinity of the test thread untouched on failure
+	std::thread{[&] {
+		auto const cores = utility::physical_cores();
+		if (cores.empty()) {
+			return;
+		}
+		auto const pinned = utility::ScopedAffinity{cores.back()};
+
+		auto follower = Coroutine{backend, utility::AffinityPolicy::FollowCaller, yield_affinity};
+		REQUIRE(follower.wait() == cores.back());
+		follower.resume(None);
+		REQUIRE_FALSE(follower.wait().has_value());
+	}}.join();
+}
+
+TEMPLATE_TEST_CASE(
+	"Coroutine wait policies exchange values",
+	"[utility]",
+	utility::BlockingWait,
+	utility::SpinThenBlockWait<>,
+	utility::SpinThenBlockWait<0>) {
+	using Coroutine = utility::Coroutine<int, int, TestType>;
+	using Executor = typename Coroutine::Executor;
+	auto constexpr n_exchanges = 100;
+
+	auto co = Coroutine{[](Executor& executor) {
+		auto message = executor.yield(0);
+		while (!Executor::is_stop(message)) {
+			message = executor.yield(std::get<int>(message) + 1);
+		}
+	}};
+
+	auto ret = co.wait();
+	for (int i = 0; i < n_exchanges; ++i) {
+		REQUIRE(ret.has_value());
+		REQUIRE(ret.value() == i);
+		co.resume(ret.value());
+		ret = co.wait();
+	}
+}
+
+TEST_CASE("Coroutine executors resume by themselves after a deadline", "[utility]") {
+	using Coroutine = utility::Coroutine<int, int>;
+	using Executor = Coroutine::Executor;
+	using namespace std::chrono_literals;
+	constexpr auto fallback = -1;
+
+	auto co = Coroutine{[](Executor& executor) {
+		auto message = executor.yield(0);
+		while (!Executor::is_stop(message)) {
+			message = executor.yield(std::get<int>(message));
+		}
+	}};
+	REQUIRE(co.wait() == 0);
+
+	SECTION("Reclaimed before the deadline") {
+		co.set_deadline(1h, fallback);
+		REQUIRE(co.reclaim());
+		co.resume(3);
+		REQUIRE(co.wait() == 3);
+	}
+
+	SECTION("Deadline passed") {
+		co.set_deadline(1ms, fallback);
+		std::this_thread::sleep_for(50ms);
+		REQUIRE_FALSE(co.reclaim());
+		REQUIRE(co.wait() == fallback);
+		// No deadline is set for the following value
+		REQUIRE(co.reclaim());
+		co.resume(3);
+		REQUIRE(co.wait() == 3);
+	}
+
+	SECTION("Destroyed while waiting for the deadline") {
+		co.set_deadline(1h, fallback);
+	}
+}
@@ -0,0 +1,39 @@
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/utility/cow.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Copy on write values are shared by copies", "[utility]") {
+	auto original = utility::Cow<std::vector<int>>{std::vector<int>{1, 2, 3}};
+	REQUIRE_FALSE(original.shared());
+
+	auto copy = original;
+	REQUIRE(original.shared());
+	REQUIRE(copy->data() == original->data());
+
+	SECTION("Modifying a copy only copies its value") {
+		copy.mut()[0] = 4;
+		REQUIRE(copy->data() != original->data());
+		REQUIRE(*original == std::vector<int>{1, 2, 3});
+		REQUIRE(*copy == std::vector<int>{4, 2, 3});
+		REQUIRE_FALSE(original.shared());
+		REQUIRE_FALSE(copy.shared());
+	}
+
+	SECTION("Values no longer shared are modified in place") {
+		copy = utility::Cow<std::vector<int>>{};
+		auto const* const memory = original->data();
+		original.mut()[0] = 4;
+		REQUIRE(original->data() == memory);
+	}
+
+	SECTION("Releasing a shared value copies it") {
+		auto const released = std::move(copy).release();
+		REQUIRE(released == std::vector<int>{1, 2, 3});
+		REQUIRE(*original == std::vector<int>{1, 2, 3});
+	}
+}
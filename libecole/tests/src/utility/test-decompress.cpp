@@ -0,0 +1,125 @@
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <string_view>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/scip/model.hpp"
+#include "utility/decompress.hpp"
+
+#include "conftest.hpp"
+#include "test-utility/tmp-folder.hpp"
+
+using namespace ecole;
+
+namespace {
+
+auto read_file(std::filesystem::path const& filename) -> std::string {
+	auto file = std::ifstream{filename, std::ios::binary};
+	return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+void write_file(std::filesystem::path const& filename, std::string const& data) {
+	std::ofstream{filename, std::ios::binary} << data;
+}
+
+void append_le(std::string& out, std::uint64_t value, std::size_t n_bytes) {
+	for (std::size_t i = 0; i < n_bytes; ++i) {
+		out.push_back(static_cast<char>((value >> (8 * i)) & 0xFFU));
+	}
+}
+
+auto crc32(std::string_view data) -> std::uint32_t {
+	auto crc = ~std::uint32_t{0};
+	for (auto const byte : data) {
+		crc ^= static_cast<std::uint8_t>(byte);
+		for (auto bit = 0; bit < 8; ++bit) {
+			crc = (crc >> 1U) ^ (0xEDB88320U & (0U - (crc & 1U)));
+		}
+	}
+	return ~crc;
+}
+
+/** A gzip file made of uncompressed deflate blocks, which does not need zlib to be written. */
+auto stored_gzip(std::string_view data) -> std::string {
+	auto const crc = crc32(data);
+	auto const size = data.size();
+	auto out = std::string{"\x1f\x8b\x08\x00\x00\x00\x00\x00\x00\xff", 10};
+	constexpr std::size_t max_block_size = 0xFFFF;
+	do {
+		auto const block = data.substr(0, max_block_size);
+		data.remove_prefix(block.size());
+		out.push_back(data.empty() ? '\x01' : '\x00');
+		append_le(out, block.size(), 2);
+		append_le(out, ~block.size() & 0xFFFFU, 2);
+		out.append(block);
+	} while (!data.empty());
+	append_le(out, crc, 4);
+	append_le(out, size & 0xFFFFFFFFU, 4);
+	return out;
+}
+
+/** A zstd frame made of raw blocks, which does not need libzstd to be written. */
+auto raw_zstd(std::string_view data) -> std::string {
+	auto out = std::string{};
+	append_le(out, 0xFD2FB528U, 4);
+	// Single segment, with the content size on four bytes
+	out.push_back('\xA0');
+	append_le(out, data.size(), 4);
+	constexpr std::size_t max_block_size = std::size_t{1} << 17U;
+	do {
+		auto const block = data.substr(0, max_block_size);
+		data.remove_prefix(block.size());
+		auto const is_last = data.empty() ? 1U : 0U;
+		append_le(out, is_last | (block.size() << 3U), 3);
+		out.append(block);
+	} while (!data.empty());
+	return out;
+}
+
+}  // namespace
+
+TEST_CASE("Compression is deduced from the extension", "[utility]") {
+	REQUIRE(utility::compression_of("a.mps") == utility::Compression::none);
+	REQUIRE(utility::compression_of("a.mps.gz") == utility::Compression::gzip);
+	REQUIRE(utility::compression_of("a.mps.zst") == utility::Compression::zstd);
+}
+
+TEST_CASE("Compressed problem files are decompressed in memory", "[utility]") {
+	auto const tmp = TmpFolderRAII{};
+	auto const data = read_file(problem_file);
+	auto reference = scip::Model::from_file(problem_file);
+
+	SECTION("Gzip") {
+		auto const filename = tmp.make_subpath(".mps.gz");
+		write_file(filename, stored_gzip(data) + stored_gzip(""));
+		if (utility::can_decompress(utility::Compression::gzip)) {
+			REQUIRE(utility::read_decompressed(filename, utility::Compression::gzip) == data);
+		}
+		auto model = scip::Model::from_file(filename);
+		REQUIRE(model.variables().size() == reference.variables().size());
+	}
+
+	SECTION("Zstd") {
+		auto const filename = tmp.make_subpath(".mps.zst");
+		write_file(filename, raw_zstd(data));
+		if (utility::can_decompress(utility::Compression::zstd)) {
+			REQUIRE(utility::read_decompressed(filename, utility::Compression::zstd) == data);
+			auto model = scip::Model::from_file(filename);
+			REQUIRE(model.variables().size() == reference.variables().size());
+		} else {
+			REQUIRE_THROWS_AS(scip::Model::from_file(filename), scip::ScipError);
+		}
+	}
+
+	SECTION("Truncated files raise") {
+		auto const filename = tmp.make_subpath(".mps.zst");
+		auto const compressed = raw_zstd(data);
+		write_file(filename, compressed.substr(0, compressed.size() / 2));
+		REQUIRE_THROWS_AS(scip::Model::from_file(filename), scip::ScipError);
+	}
+}
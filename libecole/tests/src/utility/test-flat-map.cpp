@@ -0,0 +1,65 @@
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/utility/flat-map.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Flat map keeps entries sorted by key", "[utility]") {
+	auto map = utility::FlatMap<std::string, int>{{"b", 2}, {"a", 1}, {"b", 3}};
+	map.emplace("d", 4);
+	map.emplace("c", 3);
+
+	REQUIRE(map.size() == 4);
+	auto keys = std::vector<std::string>{};
+	for (auto const& [key, _] : map) {
+		keys.emplace_back(key);
+	}
+	REQUIRE(keys == std::vector<std::string>{"a", "b", "c", "d"});
+	// First of duplicated keys is kept, as in std::map
+	REQUIRE(map.at("b") == 2);
+}
+
+TEST_CASE("Flat map has the interface of std::map", "[utility]") {
+	auto map = utility::FlatMap<std::string, int>{};
+	REQUIRE(map.empty());
+
+	SECTION("Lookup with transparent keys") {
+		map.emplace("a", 1);
+		REQUIRE(map.contains("a"));
+		REQUIRE(map.count(std::string{"a"}) == 1);
+		REQUIRE(map.find("z") == map.end());
+		REQUIRE_THROWS_AS(map.at("z"), std::out_of_range);
+	}
+
+	SECTION("Do not overwrite existing keys on emplace") {
+		REQUIRE(map.emplace("a", 1).second);
+		REQUIRE_FALSE(map.emplace("a", 2).second);
+		REQUIRE(map.at("a") == 1);
+	}
+
+	SECTION("Overwrite existing keys on assignment") {
+		map["a"] = 1;
+		map["a"] += 1;
+		REQUIRE(map.at("a") == 2);
+		REQUIRE_FALSE(map.insert_or_assign("a", 3).second);
+		REQUIRE(map.at("a") == 3);
+	}
+
+	SECTION("Insert at the correct position with any hint") {
+		map.emplace_hint(map.end(), "b", 2);
+		map.emplace_hint(map.end(), "a", 1);
+		map.emplace_hint(map.begin(), "c", 3);
+		REQUIRE(map == utility::FlatMap<std::string, int>{{"a", 1}, {"b", 2}, {"c", 3}});
+	}
+
+	SECTION("Erase entries") {
+		map.emplace("a", 1);
+		REQUIRE(map.erase("a") == 1);
+		REQUIRE(map.erase("a") == 0);
+		REQUIRE(map.empty());
+	}
+}
@@ -1,6 +1,7 @@
 #include <algorithm>
 #include <array>
 #include <cstddef>
+#include <functional>
 #include <vector>
 
 #include <catch2/catch.hpp>
@@ -24,8 +25,9 @@ TEST_CASE("Edge comparison", "[instance][unit]") {
 TEST_CASE("Unit test graph class used in IndependentSet", "[instance][unit]") {
 	std::size_t constexpr n_nodes = 4;
 	auto constexpr edges = std::array{Edge{0, 1}, Edge{2, 0}};
-	auto graph = Graph{n_nodes};
-	std::for_each(edges.begin(), edges.end(), [&graph](auto edge) { graph.add_edge(edge); });
+	auto builder = utility::GraphBuilder{n_nodes};
+	std::for_each(edges.begin(), edges.end(), [&builder](auto edge) { builder.add_edge(edge); });
+	auto graph = builder.build();
 
 	SECTION("Graph builders") {
 		auto rng = RandomGenerator{};  // NOLINT(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
@@ -61,10 +63,18 @@ TEST_CASE("Unit test graph class used in IndependentSet", "[instance][unit]") {
 		}
 	}
 
+	SECTION("Neighbors are sorted") {
+		auto const neighbors = graph.neighbors(0);
+		REQUIRE(std::vector(neighbors.begin(), neighbors.end()) == std::vector<Graph::Node>{1, 2});
+	}
+
 	SECTION("Check if nodes are connected") {
 		for (auto [n1, n2] : edges) {
 			REQUIRE(graph.are_connected(n1, n2));
+			REQUIRE(graph.are_connected(n2, n1));
 		}
+		REQUIRE_FALSE(graph.are_connected(1, 2));
+		REQUIRE_FALSE(graph.are_connected(0, 3));
 	}
 
 	SECTION("Edge visitor visit edges excatly once") {
@@ -103,13 +113,33 @@ TEST_CASE("Unit test graph class used in IndependentSet", "[instance][unit]") {
 	}
 }
 
+TEST_CASE("Greedy clique partition grows cliques from the nodes of highest degree", "[instance][unit]") {
+	auto builder = utility::GraphBuilder{5};
+	for (auto const edge : std::array<Edge, 5>{{{0, 1}, {0, 2}, {1, 2}, {0, 3}, {3, 4}}}) {
+		builder.add_edge(edge);
+	}
+	auto const expected = std::vector<std::vector<Graph::Node>>{{0, 1, 2}, {3, 4}};
+	REQUIRE(builder.build().greedy_clique_partition() == expected);
+}
+
+TEST_CASE("Graph builder tracks degrees", "[instance][unit]") {
+	auto builder = utility::GraphBuilder{3};
+	builder.add_edge({2, 0});
+	REQUIRE(builder.degree(0) == 1);
+	REQUIRE(builder.degree(1) == 0);
+	REQUIRE(builder.degree(2) == 1);
+	REQUIRE(builder.build().n_edges() == 1);
+	REQUIRE(Graph{3}.n_edges() == 0);
+}
+
 TEST_CASE("Erdos Renyi builder", "[instance]") {
 	// These tests are actually not random because the random generator is always the same, but it could be changed that
 	// the results should hold with very high probability
 	auto rng = RandomGenerator{};  // NOLINT(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
 	auto constexpr n_nodes = 100;
 	auto constexpr edge_prob = 0.5;
-	auto graph = Graph::erdos_renyi(n_nodes, edge_prob, rng);
+	auto const geometric_skip = GENERATE(true, false);
+	auto graph = Graph::erdos_renyi(n_nodes, edge_prob, rng, geometric_skip);
 
 	// Number of edges follows a binomial(C(n_nodes,2), edge_prob).
 	// With the Chernov Bounds, we compute that this is true with proba ~ 1-1e-40
@@ -126,11 +156,39 @@ TEST_CASE("Erdos Renyi builder", "[instance]") {
 	}
 }
 
+TEST_CASE("Erdos Renyi builder on extreme probabilities", "[instance]") {
+	auto rng = RandomGenerator{};  // NOLINT(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
+	auto constexpr n_nodes = 10;
+	auto const geometric_skip = GENERATE(true, false);
+	REQUIRE(Graph::erdos_renyi(n_nodes, 0., rng, geometric_skip).n_edges() == 0);
+	REQUIRE(Graph::erdos_renyi(n_nodes, 1., rng, geometric_skip).n_edges() == n_nodes * (n_nodes - 1) / 2);
+	REQUIRE(Graph::erdos_renyi(1, 0.5, rng, geometric_skip).n_edges() == 0);
+}
+
 TEST_CASE("Barabasi Albert builder", "[instance]") {
 	auto rng = RandomGenerator{};  // NOLINT(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
 	auto constexpr n_nodes = 100;
 	auto constexpr affinity = 11;
-	auto graph = Graph::barabasi_albert(n_nodes, affinity, rng);
+	auto const repeated_nodes = GENERATE(true, false);
+	auto const graph = Graph::barabasi_albert(n_nodes, affinity, rng, repeated_nodes);
 	// Deterministic, according to building algorithm
 	REQUIRE(graph.n_edges() == (n_nodes - affinity - 1) * affinity + affinity);
+
+	SECTION("Neighbors are sorted and unique") {
+		for (Graph::Node n = 0; n < n_nodes; ++n) {
+			auto const neighbors = graph.neighbors(n);
+			REQUIRE(std::adjacent_find(neighbors.begin(), neighbors.end(), std::greater_equal<>{}) == neighbors.end());
+			REQUIRE(graph.degree(n) >= (n == 0 ? affinity : 1));
+		}
+	}
+}
+
+TEST_CASE("Barabasi Albert builder scales to large graphs", "[instance][slow]") {
+	auto rng = RandomGenerator{};  // NOLINT(cert-msc32-c, cert-msc51-cpp) We want reproducible in tests
+	auto constexpr n_nodes = 100'000;
+	auto constexpr affinity = 10;
+	auto const graph = Graph::barabasi_albert(n_nodes, affinity, rng);
+	REQUIRE(graph.n_edges() == (n_nodes - affinity) * affinity);
+	// New nodes are linked to old nodes of high degree
+	REQUIRE(graph.degree(0) > 10 * affinity);
 }
@@ -0,0 +1,75 @@
+#include <cstddef>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <range/v3/view/transform.hpp>
+
+#include "utility/math.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Accumulated statistics match range statistics", "[utility]") {
+	auto const values = std::vector<double>{3., -1., 4., 1., -5., 9., 2., 6.};  // NOLINT(readability-magic-numbers)
+	auto accumulator = utility::StatsAccumulator<double>{};
+	for (auto const val : values) {
+		accumulator.add(val);
+	}
+	auto const expected = utility::compute_stats(values);
+	auto const actual = accumulator.stats();
+
+	REQUIRE(actual.count == expected.count);
+	REQUIRE(actual.sum == Approx(expected.sum));
+	REQUIRE(actual.mean == Approx(expected.mean));
+	REQUIRE(actual.stddev == Approx(expected.stddev));
+	REQUIRE(actual.min == -5.);
+	REQUIRE(actual.max == 9.);
+}
+
+TEST_CASE("Accumulated statistics of negative values", "[utility]") {
+	auto accumulator = utility::StatsAccumulator<double>{};
+	accumulator.add(-2.);
+	accumulator.add(-4.);
+	auto const stats = accumulator.stats();
+	REQUIRE(stats.mean == Approx(-3.));
+	REQUIRE(stats.stddev == Approx(1.));
+	REQUIRE(stats.min == -4.);
+	REQUIRE(stats.max == -2.);
+}
+
+TEST_CASE("Accumulated statistics without values are zero", "[utility]") {
+	auto const stats = utility::StatsAccumulator<double>{}.stats();
+	REQUIRE(stats.count == 0.);
+	REQUIRE(stats.mean == 0.);
+	REQUIRE(stats.stddev == 0.);
+	REQUIRE(stats.min == 0.);
+	REQUIRE(stats.max == 0.);
+}
+
+TEST_CASE("Range statistics read lazy views once", "[utility]") {
+	auto const values = std::vector<int>{3, -1, 4, 1, -5, 9, 2, 6};  // NOLINT(readability-magic-numbers)
+	auto n_reads = std::size_t{0};
+	auto const read = [&n_reads](int val) {
+		++n_reads;
+		return val;
+	};
+	auto const lazy = utility::compute_stats(values | ranges::views::transform(read));
+	auto const contiguous = utility::compute_stats(values);
+
+	REQUIRE(n_reads == values.size());
+	REQUIRE(lazy.count == contiguous.count);
+	REQUIRE(lazy.sum == Approx(contiguous.sum));
+	REQUIRE(lazy.mean == Approx(contiguous.mean));
+	REQUIRE(lazy.stddev == Approx(contiguous.stddev));
+	REQUIRE(contiguous.min == -5.);
+	REQUIRE(contiguous.max == 9.);
+	REQUIRE(lazy.min == -5.);
+	REQUIRE(lazy.max == 9.);
+}
+
+TEST_CASE("Range statistics of negative values", "[utility]") {
+	auto const stats = utility::compute_stats(std::vector<double>{-2., -4.});
+	REQUIRE(stats.mean == Approx(-3.));
+	REQUIRE(stats.stddev == Approx(1.));
+	REQUIRE(stats.max == -2.);
+	REQUIRE(utility::compute_stats(std::vector<double>{}).count == 0.);
+}
@@ -0,0 +1,99 @@
+#include <chrono>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/utility/metrics.hpp"
+
+using namespace ecole::utility;
+using namespace std::chrono_literals;
+
+namespace {
+
+auto find_sample(std::string const& name, metrics::Labels const& labels) -> double {
+	for (auto const& sample : metrics::collect()) {
+		if (sample.name == name && sample.labels == labels) {
+			return sample.value;
+		}
+	}
+	throw std::out_of_range{name};
+}
+
+}  // namespace
+
+TEST_CASE("Metrics of the same name and labels are shared", "[utility]") {
+	auto& counter = metrics::counter("test_shared_total", "Help.");
+	REQUIRE(&counter == &metrics::counter("test_shared_total", "Other help."));
+	REQUIRE(&counter != &metrics::counter("test_shared_total", "Help.", {{"label", "value"}}));
+	REQUIRE_THROWS_AS(metrics::gauge("test_shared_total", "Help."), std::invalid_argument);
+	REQUIRE_THROWS_AS(metrics::counter("0_invalid name", "Help."), std::invalid_argument);
+}
+
+TEST_CASE("Counters are updated from many threads", "[utility]") {
+	auto& counter = metrics::counter("test_threads_total", "Help.");
+	auto threads = std::vector<std::thread>{};
+	for (auto i = 0; i < 4; ++i) {
+		threads.emplace_back([&counter] {
+			for (auto j = 0; j < 1000; ++j) {
+				counter.add();
+			}
+		});
+	}
+	for (auto& thread : threads) {
+		thread.join();
+	}
+	REQUIRE(counter.value() == 4000);
+	REQUIRE(find_sample("test_threads_total", {}) == 4000.);
+}
+
+TEST_CASE("Gauge shares are removed when destroyed", "[utility]") {
+	auto& gauge = metrics::gauge("test_share", "Help.");
+	{
+		auto share = metrics::GaugeShare{gauge};
+		share.set(10);
+		auto other = metrics::GaugeShare{gauge};
+		other.set(5);
+		REQUIRE(gauge.value() == 15);
+		share.set(3);
+		REQUIRE(gauge.value() == 8);
+		auto moved = std::move(share);
+		REQUIRE(gauge.value() == 8);
+	}
+	REQUIRE(gauge.value() == 0);
+}
+
+TEST_CASE("Histograms count durations in cumulative buckets", "[utility]") {
+	auto& histogram = metrics::histogram("test_duration_seconds", "Help.");
+	histogram.observe(500ns);
+	histogram.observe(1us);
+	histogram.observe(3us);
+	histogram.observe(1h);
+	REQUIRE(histogram.count() == 4);
+	REQUIRE(histogram.counts().front() == 2);
+	REQUIRE(histogram.counts().back() == 1);
+	REQUIRE(histogram.sum() == 1h + 4500ns);
+
+	REQUIRE(find_sample("test_duration_seconds_bucket", {{"le", "1e-06"}}) == 2.);
+	REQUIRE(find_sample("test_duration_seconds_bucket", {{"le", "4e-06"}}) == 3.);
+	REQUIRE(find_sample("test_duration_seconds_bucket", {{"le", "+Inf"}}) == 4.);
+	REQUIRE(find_sample("test_duration_seconds_count", {}) == 4.);
+	REQUIRE(find_sample("test_duration_seconds_sum", {}) == Approx(3600.0000045));
+}
+
+TEST_CASE("Metrics are exported in the text format of Prometheus", "[utility]") {
+	metrics::counter("test_export_total", "Exported events.", {{"kind", R"(a "quoted" \ value)"}}).add(3);
+	metrics::histogram("test_export_seconds", "Exported durations.").observe(1ms);
+	auto const text = metrics::to_prometheus();
+	auto const header = "# HELP test_export_total Exported events.\n# TYPE test_export_total counter\n";
+	REQUIRE(text.find(header) != std::string::npos);
+	REQUIRE(text.find(R"(test_export_total{kind="a \"quoted\" \\ value"} 3)") != std::string::npos);
+	REQUIRE(text.find("# TYPE test_export_seconds histogram\n") != std::string::npos);
+}
+
+TEST_CASE("Type labels omit the namespaces of Ecole", "[utility]") {
+	REQUIRE(metrics::type_label(typeid(metrics::Counter)) == "Counter");
+	REQUIRE(metrics::type_label(typeid(std::vector<metrics::Gauge>)).find("ecole") == std::string::npos);
+}
@@ -0,0 +1,78 @@
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <fstream>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+#include <xtensor/xtensor.hpp>
+
+#include "utility/mps.hpp"
+
+#include "conftest.hpp"
+#include "test-utility/tmp-folder.hpp"
+
+using namespace ecole;
+
+namespace {
+
+auto write_file(TmpFolderRAII const& tmp, char const* content) {
+	auto const filename = tmp.make_subpath(".mps");
+	std::ofstream{filename} << content;
+	return filename;
+}
+
+}  // namespace
+
+TEST_CASE("Read MPS constraints sides, objective, and bounds", "[utility]") {
+	auto const tmp = TmpFolderRAII{};
+	auto const filename = write_file(tmp, R"(NAME test
+* A comment
+ROWS
+ N obj
+ L c1
+ G c2
+ E c3
+COLUMNS
+ MARKER 'MARKER' 'INTORG'
+ x obj 1 c1 2
+ x c3 1
+ MARKER 'MARKER' 'INTEND'
+ y obj -1 c2 3
+ y c3 1
+RHS
+ rhs c1 4 c2 1
+ rhs c3 5
+BOUNDS
+ UP bnd x 7
+ FR bnd y
+ENDATA
+)");
+	auto const problem = utility::read_mps(filename);
+
+	// c1 has a right hand side, c2 a left hand side, and c3 both
+	REQUIRE(problem.constraint_matrix.shape == std::array<std::size_t, 2>{4, 2});
+	REQUIRE(problem.constraint_matrix.nnz() == 6);
+	REQUIRE(problem.constraint_biases == xt::xtensor<double, 1>{4., -1., -5., 5.});
+	REQUIRE(problem.objective == std::vector<double>{1., -1.});
+	REQUIRE(problem.lower_bounds[0] == 0.);
+	REQUIRE(problem.upper_bounds[0] == 7.);
+	REQUIRE(std::isinf(problem.lower_bounds[1]));
+	REQUIRE(std::isinf(problem.upper_bounds[1]));
+	REQUIRE(problem.integral == std::vector<bool>{true, false});
+}
+
+TEST_CASE("Read MPS test instance", "[utility]") {
+	auto const problem = utility::read_mps(problem_file);
+	REQUIRE(problem.constraint_matrix.nnz() > 0);
+	REQUIRE(problem.constraint_biases.size() == problem.constraint_matrix.shape[0]);
+	REQUIRE(problem.objective.size() == problem.constraint_matrix.shape[1]);
+}
+
+TEST_CASE("Throw on invalid MPS files", "[utility]") {
+	auto const tmp = TmpFolderRAII{};
+	REQUIRE_THROWS_AS(utility::read_mps(tmp.make_subpath(".mps")), std::runtime_error);
+	REQUIRE_THROWS_AS(utility::read_mps(write_file(tmp, "ROWS\n N obj\nCOLUMNS\n x c1 1\nENDATA\n")), std::runtime_error);
+	REQUIRE_THROWS_AS(utility::read_mps(write_file(tmp, "QUADOBJ\nENDATA\n")), std::runtime_error);
+}
@@ -0,0 +1,34 @@
+#include <utility>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/utility/recycle-pool.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Recycle pool gives back released objects", "[utility]") {
+	auto pool = utility::RecyclePool<std::vector<int>>{2};
+	REQUIRE(pool.acquire().empty());
+
+	auto object = std::vector<int>{1, 2, 3};
+	auto const* const memory = object.data();
+	pool.release(std::move(object));
+	REQUIRE(pool.size() == 1);
+
+	auto reused = pool.acquire();
+	REQUIRE(reused.data() == memory);
+	REQUIRE(reused == std::vector<int>{1, 2, 3});
+	REQUIRE(pool.size() == 0);
+}
+
+TEST_CASE("Recycle pool destroys objects beyond its capacity", "[utility]") {
+	auto pool = utility::RecyclePool<std::vector<int>>{2};
+	for (int i = 0; i < 3; ++i) {
+		pool.release(std::vector<int>{i});
+	}
+	REQUIRE(pool.size() == pool.capacity());
+	// Most recently released objects first
+	REQUIRE(pool.acquire() == std::vector<int>{1});
+	REQUIRE(pool.acquire() == std::vector<int>{0});
+}
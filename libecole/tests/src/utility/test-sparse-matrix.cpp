@@ -1,6 +1,12 @@
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
 #include <catch2/catch.hpp>
 
 #include "ecole/utility/sparse-matrix.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 using namespace ecole;
 
@@ -25,3 +31,122 @@ TEST_CASE("Sparse matrix unit unit tests", "[unit][utility]") {
 		REQUIRE(matrix_copy == matrix);
 	}
 }
+
+TEST_CASE("Compressed sparse row matrix unit tests", "[unit][utility]") {
+	auto const coo = utility::coo_matrix<double>{
+		{2., 4., 7.},            // NOLINT(readability-magic-numbers)
+		{{0, 2, 2}, {1, 0, 2}},  // NOLINT(readability-magic-numbers)
+		{3, 3},                  // NOLINT(readability-magic-numbers)
+	};
+	auto const matrix = utility::csr_matrix<double, std::int32_t>::from_coo(coo);
+
+	SECTION("Conversion from coordinate format") {
+		REQUIRE(matrix.nnz() == coo.nnz());
+		REQUIRE(matrix.shape == coo.shape);
+		REQUIRE((matrix.values == coo.values));
+		REQUIRE((matrix.column_indices == decltype(matrix.column_indices){1, 0, 2}));
+		REQUIRE((matrix.row_pointers == decltype(matrix.row_pointers){0, 1, 1, 3}));
+	}
+
+	SECTION("Conversion to coordinate format") { REQUIRE(matrix.to_coo() == coo); }
+
+	SECTION("Equality comparison") {
+		auto const matrix_copy = matrix;  // NOLINT(performance-unnecessary-copy-initialization)
+		REQUIRE(matrix_copy == matrix);
+	}
+
+	SECTION("To and from tuple") {
+		auto t = matrix.to_tuple();
+		REQUIRE((std::get<0>(t) == matrix.values));
+		REQUIRE((std::get<1>(t) == matrix.column_indices));
+		REQUIRE((std::get<2>(t) == matrix.row_pointers));
+		REQUIRE((std::get<3>(t) == matrix.shape));
+		auto const matrix_copy = utility::csr_matrix<double, std::int32_t>::from_tuple(std::move(t));
+		REQUIRE(matrix_copy == matrix);
+	}
+}
+
+TEST_CASE("Sparse matrix conversions and slicing", "[unit][utility]") {
+	// Unsorted with a duplicate element at (1, 0)
+	auto const coo = utility::coo_matrix<double>{
+		{1., 2., 3., 4., 5.},                // NOLINT(readability-magic-numbers)
+		{{2, 1, 0, 1, 1}, {1, 0, 2, 2, 0}},  // NOLINT(readability-magic-numbers)
+		{3, 4},                              // NOLINT(readability-magic-numbers)
+	};
+	auto pool = utility::ThreadPool{2};
+	auto* const thread_pool = GENERATE(false, true) ? &pool : nullptr;
+
+	SECTION("Conversion to compressed sparse row") {
+		auto const csr = coo.to_csr<std::int32_t>(thread_pool);
+		REQUIRE(csr.shape == coo.shape);
+		REQUIRE((csr.row_pointers == decltype(csr.row_pointers){0, 1, 4, 5}));
+		REQUIRE((csr.column_indices == decltype(csr.column_indices){2, 0, 2, 0, 1}));
+		REQUIRE((csr.values == decltype(csr.values){3., 2., 4., 5., 1.}));
+	}
+
+	SECTION("Conversion to compressed sparse column") {
+		auto const csc = coo.to_csc(thread_pool);
+		REQUIRE(csc.shape == decltype(csc.shape){4, 3});
+		REQUIRE((csc.row_pointers == decltype(csc.row_pointers){0, 2, 3, 5, 5}));
+		REQUIRE((csc.column_indices == decltype(csc.column_indices){1, 1, 2, 0, 1}));
+		REQUIRE(csc == coo.transpose().to_csr(thread_pool));
+	}
+
+	SECTION("Transposition") {
+		REQUIRE(coo.transpose().transpose() == coo);
+		auto const csr = coo.to_csr(thread_pool);
+		auto const transposed = csr.transpose(thread_pool);
+		REQUIRE(transposed.shape == decltype(transposed.shape){4, 3});
+		REQUIRE(transposed == coo.to_csc(thread_pool));
+		REQUIRE(transposed.transpose(thread_pool).transpose(thread_pool) == transposed);
+	}
+
+	SECTION("Summation of duplicates") {
+		auto const expected = utility::coo_matrix<double>{
+			{3., 7., 4., 1.},              // NOLINT(readability-magic-numbers)
+			{{0, 1, 1, 2}, {2, 0, 2, 1}},  // NOLINT(readability-magic-numbers)
+			{3, 4},                        // NOLINT(readability-magic-numbers)
+		};
+		REQUIRE(coo.sum_duplicates(thread_pool) == expected);
+		REQUIRE(coo.to_csr(thread_pool).sum_duplicates(thread_pool) == expected.to_csr());
+	}
+
+	SECTION("Row selection") {
+		auto const rows = std::vector<std::size_t>{2, 0};
+		auto const expected = utility::coo_matrix<double>{{1., 3.}, {{0, 1}, {1, 2}}, {2, 4}};
+		REQUIRE(coo.select_rows(rows) == expected);
+		REQUIRE(coo.to_csr(thread_pool).select_rows(rows) == expected.to_csr());
+	}
+
+	SECTION("Column selection") {
+		auto const cols = std::vector<std::size_t>{2, 1};
+		auto const expected = utility::coo_matrix<double>{{1., 3., 4.}, {{2, 0, 1}, {1, 0, 0}}, {3, 2}};
+		REQUIRE(coo.select_cols(cols) == expected);
+		REQUIRE(coo.to_csr(thread_pool).select_cols(cols) == expected.to_csr());
+	}
+
+	SECTION("Invalid selections") {
+		REQUIRE_THROWS_AS(coo.select_rows(std::vector<std::size_t>{3}), std::invalid_argument);
+		REQUIRE_THROWS_AS(coo.select_cols(std::vector<std::size_t>{1, 1}), std::invalid_argument);
+		REQUIRE_THROWS_AS(coo.to_csr().select_rows(std::vector<std::size_t>{0, 0}), std::invalid_argument);
+	}
+}
+
+TEST_CASE("Parallel conversion of large sparse matrices", "[unit][utility]") {
+	auto constexpr nnz = std::size_t{3} * utility::internal::min_parallel_chunk_size;
+	auto constexpr n_rows = std::size_t{1000};
+	auto coo = utility::coo_matrix<double>{
+		decltype(utility::coo_matrix<double>::values)::from_shape({nnz}),
+		decltype(utility::coo_matrix<double>::indices)::from_shape({2, nnz}),
+		{n_rows, n_rows},
+	};
+	for (std::size_t k = 0; k < nnz; ++k) {
+		coo.values(k) = static_cast<double>(k);
+		coo.indices(0, k) = (k * 7919) % n_rows;    // NOLINT(readability-magic-numbers)
+		coo.indices(1, k) = (k * 104729) % n_rows;  // NOLINT(readability-magic-numbers)
+	}
+	auto pool = utility::ThreadPool{3};
+	REQUIRE(coo.to_csr(&pool) == coo.to_csr());
+	REQUIRE(coo.to_csc(&pool) == coo.to_csc());
+	REQUIRE(coo.sum_duplicates(&pool) == coo.sum_duplicates());
+}
@@ -0,0 +1,108 @@
+#include <cstddef>
+#include <future>
+#include <memory_resource>
+#include <utility>
+
+#include <catch2/catch.hpp>
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/observation/node-bipartite.hpp"
+#include "ecole/utility/tensor-allocator.hpp"
+
+#include "conftest.hpp"
+
+using namespace ecole;
+
+namespace {
+
+/** Count the bytes currently allocated through the resource. */
+class CountingResource : public std::pmr::memory_resource {
+public:
+	std::size_t n_bytes = 0;
+
+private:
+	auto do_allocate(std::size_t bytes, std::size_t alignment) -> void* override {
+		n_bytes += bytes;
+		return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+	}
+
+	void do_deallocate(void* ptr, std::size_t bytes, std::size_t alignment) override {
+		n_bytes -= bytes;
+		std::pmr::new_delete_resource()->deallocate(ptr, bytes, alignment);
+	}
+
+	[[nodiscard]] auto do_is_equal(std::pmr::memory_resource const& other) const noexcept -> bool override {
+		return this == &other;
+	}
+};
+
+/** Set the tensor memory resource for the lifetime of the object. */
+struct ResourceRAII {
+	std::pmr::memory_resource* previous;
+	explicit ResourceRAII(std::pmr::memory_resource* resource) :
+		previous{utility::set_tensor_memory_resource(resource)} {}
+	ResourceRAII(ResourceRAII const&) = delete;
+	ResourceRAII(ResourceRAII&&) = delete;
+	auto operator=(ResourceRAII const&) -> ResourceRAII& = delete;
+	auto operator=(ResourceRAII&&) -> ResourceRAII& = delete;
+	~ResourceRAII() { utility::set_tensor_memory_resource(previous); }
+};
+
+template <typename T, std::size_t N>
+using tensor = xt::xtensor_container<xt::uvector<T, utility::TensorAllocator<T>>, N, xt::layout_type::row_major>;
+
+}  // namespace
+
+TEST_CASE("Setting the tensor memory resource returns the previous one", "[utility]") {
+	auto resource = CountingResource{};
+	auto* const previous = utility::set_tensor_memory_resource(&resource);
+	REQUIRE(utility::tensor_memory_resource() == &resource);
+	REQUIRE(utility::set_tensor_memory_resource(nullptr) == &resource);
+	REQUIRE(utility::tensor_memory_resource() == std::pmr::new_delete_resource());
+	utility::set_tensor_memory_resource(previous);
+}
+
+TEST_CASE("Tensors give memory back to the resource they were created with", "[utility]") {
+	auto resource = CountingResource{};
+	{
+		auto const set_resource = ResourceRAII{&resource};
+		auto const tensor_in_resource = tensor<double, 2>::from_shape({3, 4});
+		REQUIRE(resource.n_bytes == 3 * 4 * sizeof(double));
+
+		auto moved = tensor<double, 2>{};
+		{
+			auto const restore = ResourceRAII{nullptr};
+			auto other = tensor<double, 2>::from_shape({2, 2});
+			moved = std::move(other);
+		}
+		REQUIRE(resource.n_bytes == 3 * 4 * sizeof(double));
+	}
+	REQUIRE(resource.n_bytes == 0);
+}
+
+TEST_CASE("Scoped tensor memory resources only apply to the current thread", "[utility]") {
+	auto global = CountingResource{};
+	auto scoped = CountingResource{};
+	auto const set_global = ResourceRAII{&global};
+	{
+		auto const set_scoped = utility::ScopedTensorMemoryResource{&scoped};
+		REQUIRE(utility::tensor_memory_resource() == &scoped);
+		auto other_thread = std::async(std::launch::async, [] { return utility::tensor_memory_resource(); });
+		REQUIRE(other_thread.get() == &global);
+	}
+	REQUIRE(utility::tensor_memory_resource() == &global);
+}
+
+#ifdef ECOLE_TENSOR_ALLOCATOR
+TEST_CASE("Observation tensors are allocated through the tensor memory resource", "[utility]") {
+	auto resource = CountingResource{};
+	auto const set_resource = ResourceRAII{&resource};
+	auto model = get_model();
+	auto obs_func = observation::NodeBipartite{};
+	obs_func.before_reset(model);
+	advance_to_stage(model, SCIP_STAGE_SOLVING);
+	auto const obs = obs_func.extract(model, false);
+	REQUIRE(obs.has_value());
+	REQUIRE(resource.n_bytes >= obs.value().variable_features.size() * sizeof(double));
+}
+#endif
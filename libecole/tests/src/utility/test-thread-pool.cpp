@@ -0,0 +1,85 @@
+#include <atomic>
+#include <future>
+#include <stdexcept>
+#include <vector>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/threads.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+using namespace ecole;
+
+TEST_CASE("Thread pool execute tasks", "[utility]") {
+	auto const n_threads = GENERATE(1UL, 4UL);
+	auto pool = utility::ThreadPool{n_threads};
+	REQUIRE(pool.size() == n_threads);
+
+	SECTION("Return values through futures") {
+		auto futures = std::vector<std::future<int>>{};
+		for (int i = 0; i < 100; ++i) {
+			futures.push_back(pool.submit([i] { return i * i; }));
+		}
+		for (int i = 0; i < 100; ++i) {
+			REQUIRE(futures[static_cast<std::size_t>(i)].get() == i * i);
+		}
+	}
+
+	SECTION("Forward exceptions through futures") {
+		auto future = pool.submit([]() -> int { throw std::runtime_error{"error"}; });
+		REQUIRE_THROWS_AS(future.get(), std::runtime_error);
+	}
+}
+
+TEST_CASE("Thread pool finish pending tasks on destruction", "[utility]") {
+	auto count = std::atomic<int>{0};
+	{
+		auto pool = utility::ThreadPool{2};
+		for (int i = 0; i < 50; ++i) {
+			pool.submit([&count] { ++count; });
+		}
+	}
+	REQUIRE(count == 50);
+}
+
+TEST_CASE("Thread pool tasks know they run in a worker", "[utility]") {
+	auto pool = utility::ThreadPool{2};
+	REQUIRE_FALSE(utility::ThreadPool::in_worker_thread());
+	REQUIRE(pool.submit([] { return utility::ThreadPool::in_worker_thread(); }).get());
+}
+
+TEST_CASE("Shared thread pool follows the number of threads of Ecole", "[utility]") {
+	set_n_threads(3);
+	REQUIRE(get_n_threads() == 3);
+	REQUIRE(utility::ThreadPool::default_n_threads() == 3);
+
+	SECTION("The shared pool is reused") {
+		auto const pool = shared_thread_pool();
+		REQUIRE(pool != nullptr);
+		REQUIRE(pool->size() == 3);
+		REQUIRE(shared_thread_pool() == pool);
+		REQUIRE(make_thread_pool(0) == pool);
+	}
+
+	SECTION("The shared pool is replaced when the number of threads changes") {
+		auto const pool = shared_thread_pool();
+		set_n_threads(2);
+		REQUIRE(pool->size() == 3);
+		REQUIRE(shared_thread_pool()->size() == 2);
+	}
+
+	SECTION("No pool is used with a single thread") {
+		REQUIRE(make_thread_pool(1) == nullptr);
+		set_n_threads(1);
+		REQUIRE(shared_thread_pool() == nullptr);
+	}
+
+	SECTION("Explicit numbers of threads get a pool of their own") {
+		auto const pool = make_thread_pool(2);
+		REQUIRE(pool->size() == 2);
+		REQUIRE(pool != shared_thread_pool());
+	}
+
+	set_n_threads(0);
+	REQUIRE(get_n_threads() >= 1);
+}
@@ -0,0 +1,43 @@
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <string>
+
+#include <catch2/catch.hpp>
+
+#include "ecole/utility/tracing.hpp"
+
+#include "test-utility/tmp-folder.hpp"
+
+using namespace ecole;
+
+namespace {
+
+auto read_file(std::filesystem::path const& path) -> std::string {
+	auto file = std::ifstream{path};
+	return {std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+}
+
+}  // namespace
+
+TEST_CASE("Spans are written as a Chrome trace when tracing is stopped", "[utility]") {
+	auto const tmp = TmpFolderRAII{};
+	auto const path = tmp.make_subpath(".json");
+
+	{ auto const span = utility::tracing::Span{"before-start"}; }
+	utility::tracing::start(path.string());
+	REQUIRE(utility::tracing::is_started());
+	{ auto const span = utility::tracing::Span{"main-thread"}; }
+	std::async(std::launch::async, [] { auto const span = utility::tracing::Span{"other-thread"}; }).wait();
+	utility::tracing::stop();
+	REQUIRE_FALSE(utility::tracing::is_started());
+	{ auto const span = utility::tracing::Span{"after-stop"}; }
+
+	auto const trace = read_file(path);
+	REQUIRE(trace.find(R"("traceEvents")") != std::string::npos);
+	REQUIRE(trace.find(R"("name": "main-thread", "ph": "X")") != std::string::npos);
+	REQUIRE(trace.find(R"("name": "other-thread", "ph": "X")") != std::string::npos);
+	REQUIRE(trace.find("before-start") == std::string::npos);
+	REQUIRE(trace.find("after-stop") == std::string::npos);
+}
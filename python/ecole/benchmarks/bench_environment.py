@@ -0,0 +1,167 @@
+"""Measure the step and reset throughput of environments as observed from Python.
+
+Every environment is run with every built-in observation function on generated set cover instances,
+with a fixed policy.
+The C++ time is the time spent in calls to the dynamics and data functions, which includes the
+conversions made by the bindings.
+The rest of the time, the Python time, is spent in the interpreter, mostly in ``Environment.reset``
+and ``Environment.step``.
+
+Run with ``python python/ecole/benchmarks/bench_environment.py --help`` for the options.
+"""
+
+import argparse
+import csv
+import sys
+import time
+
+import numpy as np
+
+import ecole
+
+
+class Timed:
+    """Proxy to an object accumulating the time spent in its methods."""
+
+    def __init__(self, wrapped):
+        self._wrapped = wrapped
+        self.time_s = 0.0
+
+    def __getattr__(self, name):
+        attribute = getattr(self._wrapped, name)
+        if not callable(attribute):
+            return attribute
+
+        def timed(*args, **kwargs):
+            before = time.perf_counter()
+            try:
+                return attribute(*args, **kwargs)
+            finally:
+                self.time_s += time.perf_counter() - before
+
+        return timed
+
+
+def branching_policy(action_set):
+    return action_set[0]
+
+
+def configuring_policy(action_set):
+    return {}
+
+
+def primal_search_policy(action_set):
+    return (action_set, np.zeros(len(action_set)))
+
+
+def node_selection_policy(action_set):
+    # The first column holds the node numbers
+    return int(action_set[0, 0])
+
+
+def cut_selection_policy(action_set):
+    return [0] if len(action_set) > 0 else []
+
+
+ENVIRONMENTS = {
+    "Branching": (ecole.environment.Branching, branching_policy),
+    "Configuring": (ecole.environment.Configuring, configuring_policy),
+    "PrimalSearch": (ecole.environment.PrimalSearch, primal_search_policy),
+    "NodeSelection": (ecole.environment.NodeSelection, node_selection_policy),
+    "CutSelection": (ecole.environment.CutSelection, cut_selection_policy),
+}
+
+OBSERVATION_FUNCTIONS = {
+    "Nothing": ecole.observation.Nothing,
+    "NodeBipartite": ecole.observation.NodeBipartite,
+    "MilpBipartite": ecole.observation.MilpBipartite,
+    "StrongBranchingScores": ecole.observation.StrongBranchingScores,
+    "Pseudocosts": ecole.observation.Pseudocosts,
+    "Khalil2016": ecole.observation.Khalil2016,
+    "Hutter2011": ecole.observation.Hutter2011,
+}
+
+COLUMNS = [
+    "environment",
+    "observation",
+    "n_resets",
+    "n_steps",
+    "reset_time_s",
+    "step_time_s",
+    "cpp_time_s",
+    "python_time_s",
+    "resets_per_s",
+    "steps_per_s",
+    "python_fraction",
+]
+
+
+def benchmark(env_class, policy, obs_class, instances, n_nodes):
+    """Run one episode on every instance and return the measures as a dictionary."""
+    env = env_class(observation_function=obs_class(), scip_params={"limits/totalnodes": n_nodes})
+    # Every call into the bindings goes through one of these members
+    members = ["dynamics", "observation_function", "reward_function", "information_function"]
+    timed = [Timed(getattr(env, member)) for member in members]
+    for member, proxy in zip(members, timed):
+        setattr(env, member, proxy)
+
+    n_steps, reset_time_s, step_time_s = 0, 0.0, 0.0
+    for instance in instances:
+        before = time.perf_counter()
+        _, action_set, _, done, _ = env.reset(instance)
+        reset_time_s += time.perf_counter() - before
+        while not done:
+            before = time.perf_counter()
+            _, action_set, _, done, _ = env.step(policy(action_set))
+            step_time_s += time.perf_counter() - before
+            n_steps += 1
+
+    total_time_s = reset_time_s + step_time_s
+    cpp_time_s = sum(t.time_s for t in timed)
+    python_time_s = total_time_s - cpp_time_s
+    return {
+        "n_resets": len(instances),
+        "n_steps": n_steps,
+        "reset_time_s": reset_time_s,
+        "step_time_s": step_time_s,
+        "cpp_time_s": cpp_time_s,
+        "python_time_s": python_time_s,
+        "resets_per_s": len(instances) / reset_time_s if reset_time_s > 0 else 0.0,
+        "steps_per_s": n_steps / step_time_s if step_time_s > 0 else 0.0,
+        "python_fraction": python_time_s / total_time_s if total_time_s > 0 else 0.0,
+    }
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--instances", "-n", type=int, default=5, help="Number of instances")
+    parser.add_argument("--node-limit", type=int, default=100, help="Node limit of every episode")
+    parser.add_argument("--seed", "-s", type=int, default=0, help="Global Ecole random seed")
+    parser.add_argument("--environments", nargs="+", default=list(ENVIRONMENTS))
+    parser.add_argument("--observations", nargs="+", default=list(OBSERVATION_FUNCTIONS))
+    args = parser.parse_args()
+
+    ecole.seed(args.seed)
+    generator = ecole.instance.SetCoverGenerator(n_rows=500, n_cols=1000)
+    instances = [next(generator) for _ in range(args.instances)]
+    for instance in instances:
+        instance.disable_presolve()
+        instance.disable_cuts()
+
+    writer = csv.DictWriter(sys.stdout, fieldnames=COLUMNS)
+    writer.writeheader()
+    for env_name in args.environments:
+        env_class, policy = ENVIRONMENTS[env_name]
+        for obs_name in args.observations:
+            obs_class = OBSERVATION_FUNCTIONS[obs_name]
+            try:
+                row = benchmark(env_class, policy, obs_class, instances, args.node_limit)
+            except Exception as e:
+                message = f"Error when benchmarking {env_name} with {obs_name}: {e}"
+                print(message, file=sys.stderr)
+                continue
+            writer.writerow({"environment": env_name, "observation": obs_name, **row})
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,65 @@
+"""Measure the startup time of short lived processes using Ecole.
+
+Every scenario is run in new interpreters, so that nothing is cached by a previous import, and
+the time is measured from the start of the process to the end of the scenario, including the
+startup of the interpreter, which is reported separately as the baseline.
+
+Run with ``python python/ecole/benchmarks/bench_startup.py --help`` for the options.
+"""
+
+import argparse
+import csv
+import statistics
+import subprocess
+import sys
+import time
+
+SCENARIOS = {
+    "python": "pass",
+    "import": "import ecole",
+    "model": "import ecole; ecole.scip.Model.prob_basic()",
+    "model_modeling": (
+        "import ecole; ecole.scip.Model.prob_basic(profile=ecole.scip.PluginProfile.Modeling)"
+    ),
+    "observation": "import ecole; ecole.observation.NodeBipartite()",
+    "environment": "import ecole; ecole.environment.Branching()",
+}
+
+COLUMNS = ["scenario", "n_runs", "median_time_s", "min_time_s", "overhead_s"]
+
+
+def time_process(code):
+    """Return the wall time of a new interpreter running the code."""
+    before = time.perf_counter()
+    subprocess.run([sys.executable, "-c", code], check=True)
+    return time.perf_counter() - before
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--runs", "-n", type=int, default=20, help="Processes per scenario")
+    parser.add_argument("--scenarios", nargs="+", default=list(SCENARIOS))
+    args = parser.parse_args()
+
+    # Warm the file system cache, which would otherwise slow down the first scenario
+    time_process(SCENARIOS["environment"])
+    baseline_s = statistics.median(time_process(SCENARIOS["python"]) for _ in range(args.runs))
+
+    writer = csv.DictWriter(sys.stdout, fieldnames=COLUMNS)
+    writer.writeheader()
+    for name in args.scenarios:
+        times_s = [time_process(SCENARIOS[name]) for _ in range(args.runs)]
+        median_s = statistics.median(times_s)
+        writer.writerow(
+            {
+                "scenario": name,
+                "n_runs": args.runs,
+                "median_time_s": median_s,
+                "min_time_s": min(times_s),
+                "overhead_s": median_s - baseline_s,
+            }
+        )
+
+
+if __name__ == "__main__":
+    main()
@@ -1,15 +1,74 @@
+import importlib
+import importlib.abc
+import importlib.util
 import sys
 
-from ecole.core import RandomGenerator, seed, spawn_random_generator, MarkovError, Default
+import ecole.core
+from ecole.core import (
+    RandomGenerator,
+    seed,
+    spawn_random_generator,
+    derive_random_generator,
+    split_random_generator,
+    set_n_threads,
+    get_n_threads,
+    n_running_threads,
+    check_fork_safe,
+    prewarm,
+    MarkovError,
+    Default,
+)
+
+
+class _CoreSubmoduleFinder(importlib.abc.MetaPathFinder, importlib.abc.Loader):
+    """Bind the submodules of ``ecole.core`` when first imported, including when unpickling."""
+
+    def find_spec(self, fullname, path, target=None):
+        package, _, name = fullname.rpartition(".")
+        if package != "ecole.core" or name not in ecole.core.submodules:
+            return None
+        return importlib.util.spec_from_loader(fullname, self)
+
+    def create_module(self, spec):
+        return ecole.core.bind_submodule(spec.name.rpartition(".")[2])
+
+    def exec_module(self, module):
+        pass
+
+
+sys.meta_path.append(_CoreSubmoduleFinder())
 
 import ecole.version
-import ecole.data
-import ecole.observation
-import ecole.reward
-import ecole.information
-import ecole.scip
-import ecole.instance
-import ecole.dynamics
-import ecole.environment
+
+# Imported on first access, so that importing Ecole only binds what is used
+_SUBMODULES = (
+    "data",
+    "observation",
+    "reward",
+    "information",
+    "scip",
+    "instance",
+    "dynamics",
+    "environment",
+    "rollout",
+    "vector",
+    "metrics",
+)
+
+
+def __getattr__(name):
+    if name in _SUBMODULES:
+        return importlib.import_module(f"ecole.{name}")
+    raise AttributeError(f"module 'ecole' has no attribute '{name}'")
+
+
+def __dir__():
+    return sorted(set(globals()) | set(_SUBMODULES))
+
+
+# Module __getattr__ is only supported from Python 3.7
+if sys.version_info < (3, 7):
+    for _name in _SUBMODULES:
+        importlib.import_module(f"ecole.{_name}")
 
 __version__ = "{v.major}.{v.minor}.{v.patch}".format(v=ecole.version.get_ecole_lib_version())
@@ -7,6 +7,7 @@
 
 #include "ecole/none.hpp"
 #include "ecole/scip/type.hpp"
+#include "ecole/utility/flat-map.hpp"
 
 /**
  * Cutomize PyBind casting for some types.
@@ -21,6 +22,15 @@ namespace pybind11::detail {
  */
 template <> struct type_caster<ecole::NoneType> : void_caster<ecole::NoneType> {};
 
+/**
+ * Custom caster for ecole::utility::FlatMap.
+ *
+ * Cast to and from `dict` as is done with `std::map`, iterating over the entries in key order.
+ */
+template <typename Key, typename Value, typename Compare>
+struct type_caster<ecole::utility::FlatMap<Key, Value, Compare>> :
+	map_caster<ecole::utility::FlatMap<Key, Value, Compare>, Key, Value> {};
+
 /**
  * Custom caster for  scip::Param.
  *
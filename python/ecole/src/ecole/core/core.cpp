@@ -1,22 +1,86 @@
 #define FORCE_IMPORT_ARRAY
 
+#include <algorithm>
+#include <cstdint>
 #include <limits>
 #include <memory>
+#include <optional>
+#include <string>
 #include <string_view>
+#include <vector>
 
 #include <pybind11/operators.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 #include <xtensor-python/pytensor.hpp>
 
 #include "ecole/default.hpp"
 #include "ecole/exception.hpp"
+#include "ecole/fork.hpp"
 #include "ecole/random.hpp"
+#include "ecole/threads.hpp"
 
 #include "core.hpp"
 
 using namespace ecole;
 namespace py = pybind11;
 
+namespace {
+
+/** A submodule of the bindings, bound on first import. */
+struct Submodule {
+	std::string_view name;
+	void (*bind)(py::module_ const&);
+	/** The submodules whose types are used when binding this one, as default arguments or in signatures. */
+	std::vector<std::string_view> dependencies;
+	bool uses_numpy = true;
+};
+
+auto submodules() -> std::vector<Submodule> const& {
+	static auto const all = std::vector<Submodule>{
+		{"version", [](py::module_ const& m) { version::bind_submodule(m); }, {}, false},
+		{"metrics", [](py::module_ const& m) { utility::metrics::bind_submodule(m); }, {}, false},
+		{"scip", [](py::module_ const& m) { scip::bind_submodule(m); }, {}},
+		{"instance", [](py::module_ const& m) { instance::bind_submodule(m); }, {"scip"}},
+		{"data", [](py::module_ const& m) { data::bind_submodule(m); }, {"scip"}},
+		{"observation", [](py::module_ const& m) { observation::bind_submodule(m); }, {"scip", "data"}},
+		{"reward", [](py::module_ const& m) { reward::bind_submodule(m); }, {"scip", "data"}},
+		{"information", [](py::module_ const& m) { information::bind_submodule(m); }, {"scip", "data"}},
+		{"dynamics", [](py::module_ const& m) { dynamics::bind_submodule(m); }, {"scip", "data"}},
+		{"environment",
+		 [](py::module_ const& m) { environment::bind_submodule(m); },
+		 {"scip", "data", "observation", "reward", "information", "dynamics"}},
+	};
+	return all;
+}
+
+/** Return the submodule, binding it and its dependencies if not already done, or nothing if there is no such name. */
+auto bind_submodule(std::string_view name) -> std::optional<py::module_> {
+	auto const& all = submodules();
+	auto const iter = std::find_if(all.begin(), all.end(), [name](auto const& sub) { return sub.name == name; });
+	if (iter == all.end()) {
+		return {};
+	}
+	auto core = py::module_::import("ecole.core");
+	// Looking the attribute up in the dictionary does not call the module __getattr__ back
+	auto const attributes = py::reinterpret_borrow<py::dict>(PyModule_GetDict(core.ptr()));
+	auto const key = std::string{name};
+	if (attributes.contains(key)) {
+		return attributes[key.c_str()].cast<py::module_>();
+	}
+	for (auto const dependency : iter->dependencies) {
+		bind_submodule(dependency);
+	}
+	if (iter->uses_numpy) {
+		xt::import_numpy();
+	}
+	auto submodule = core.def_submodule(key.c_str());
+	iter->bind(submodule);
+	return submodule;
+}
+
+}  // namespace
+
 PYBIND11_MODULE(core, m) {
 	m.doc() = R"str(
 		Root module for binding Ecole library.
@@ -25,8 +89,6 @@ PYBIND11_MODULE(core, m) {
 		the user interface.
 	)str";
 
-	xt::import_numpy();
-
 	py::class_<RandomGenerator>(m, "RandomGenerator")  //
 		.def_property_readonly_static(
 			"min_seed", [](py::object const& /* cls */) { return std::numeric_limits<RandomGenerator::result_type>::min(); })
@@ -60,15 +122,77 @@ PYBIND11_MODULE(core, m) {
 			[](const RandomGenerator& self, py::dict const& /* memo */) { return std::make_unique<RandomGenerator>(self); },
 			py::arg("memo"))
 		.def(py::pickle(
-			[](RandomGenerator const& self) { return serialize(self); },
-			[](std::string const& data) { return std::make_unique<RandomGenerator>(deserialize(data)); }));
+			[](RandomGenerator const& self) { return py::bytes{serialize_binary(self)}; },
+			[](py::object const& data) {
+				// Generators pickled by older versions are in text format
+				if (py::isinstance<py::str>(data)) {
+					return std::make_unique<RandomGenerator>(deserialize(data.cast<std::string>()));
+				}
+				return std::make_unique<RandomGenerator>(deserialize_binary(data.cast<std::string>()));
+			}));
 
 	m.def("seed", &ecole::seed, py::arg("val"), "Seed the global source of randomness in Ecole.");
-	m.def("spawn_random_generator", &ecole::spawn_random_generator, R"(
+	m.def("spawn_random_generator", py::overload_cast<>(&ecole::spawn_random_generator), R"(
 		Create new random generator deriving from global source of randomness.
 
 		The global source of randomness is advance so two random engien created successively have different states.
 	)");
+	m.def(
+		"spawn_random_generator",
+		py::overload_cast<std::uint64_t>(&ecole::spawn_random_generator),
+		py::arg("stream"),
+		R"(
+		Get the random generator of the given stream of the global source of randomness.
+
+		The result only depends on the global seed and the stream, not on the order of calls.
+	)");
+	m.def("derive_random_generator", &ecole::derive_random_generator, py::arg("rng"), py::arg("stream"), R"(
+		Derive an independent random generator from the state of a random generator and a stream index.
+
+		The parent random generator is not modified.
+	)");
+	m.def("split_random_generator", &ecole::split_random_generator, py::arg("rng"), py::arg("n"), R"(
+		Split a random generator into a list of independent random generators, one per parallel worker.
+
+		The parent random generator is advanced so that successive splits give different random generators.
+	)");
+
+	m.def("set_n_threads", &ecole::set_n_threads, py::arg("n_threads"), R"(
+		Set the number of threads used by the parallel features of Ecole that are not given one explicitly.
+
+		This includes observation functions created with ``n_threads=0``, vector environments, and batch tools.
+		They share a single pool of threads, and run sequentially when called from one of its threads, so that
+		the cores are not oversubscribed, for instance by the observation functions of a vector environment.
+		Zero, the default, uses one thread per core, and one disables parallelism.
+		Only features created afterward are affected.
+	)");
+	m.def("get_n_threads", &ecole::get_n_threads, R"(
+		Get the number of threads used by the parallel features of Ecole that are not given one explicitly.
+	)");
+
+	m.def("n_running_threads", &ecole::n_running_threads, R"(
+		The number of threads created by Ecole that are running.
+	)");
+	m.def("check_fork_safe", &ecole::check_fork_safe, R"(
+		Raise a ``RuntimeError`` if threads created by Ecole are running, which forked processes would not have.
+
+		Threads are held by environments in the middle of an episode, vector environments, observation functions
+		created with many threads, prefetching instance generators, and shuffled trajectory iterators.
+		Other objects, such as models, instance generators, and single threaded environments, can be created before
+		forking, and are shared with the forked processes until modified.
+	)");
+	m.def(
+		"prewarm",
+		[](std::optional<ecole::scip::PluginProfile> profile) {
+			ecole::prewarm(profile.value_or(ecole::scip::PluginProfile::full));
+		},
+		py::arg("profile") = py::none(),
+		R"(
+		Initialize the process wide state that Ecole and SCIP otherwise create on first use.
+
+		A small problem is solved with the plugins of the profile (all of them by default), without leaving any
+		thread running, so that processes forked afterward share this state rather than all creating it.
+	)");
 
 	py::class_<ecole::DefaultType>(m, "DefaultType")
 		.def(py::self == py::self)  // NOLINT(misc-redundant-expression)  pybind specific syntax
@@ -84,12 +208,32 @@ PYBIND11_MODULE(core, m) {
 	py::register_exception<ecole::MarkovError>(m, "MarkovError");
 	py::register_exception<ecole::IteratorExhausted>(m, "IteratorExhausted", PyExc_StopIteration);
 
-	version::bind_submodule(m.def_submodule("version"));
-	scip::bind_submodule(m.def_submodule("scip"));
-	instance::bind_submodule(m.def_submodule("instance"));
-	data::bind_submodule(m.def_submodule("data"));
-	observation::bind_submodule(m.def_submodule("observation"));
-	reward::bind_submodule(m.def_submodule("reward"));
-	information::bind_submodule(m.def_submodule("information"));
-	dynamics::bind_submodule(m.def_submodule("dynamics"));
+	// Submodules are only bound when first imported, which short lived processes often do not all need.
+	// An empty path makes the module a package, so that the import system asks the finder of ``ecole`` for them.
+	m.attr("__path__") = py::list{};
+	auto names = py::list{};
+	for (auto const& sub : submodules()) {
+		names.append(sub.name);
+	}
+	m.attr("submodules") = py::tuple{names};
+	m.def(
+		"bind_submodule",
+		[](std::string const& name) {
+			if (auto submodule = bind_submodule(name); submodule.has_value()) {
+				return submodule.value();
+			}
+			throw py::value_error{"No submodule named " + name + " in ecole.core."};
+		},
+		py::arg("name"),
+		R"(
+		Bind the submodule and the submodules it depends on, and return it.
+
+		Submodules are bound once, on their first import, or by the first call of this function.
+	)");
+	m.def("__getattr__", [](std::string const& name) -> py::object {
+		if (auto submodule = bind_submodule(name); submodule.has_value()) {
+			return submodule.value();
+		}
+		throw py::attribute_error{"module 'ecole.core' has no attribute '" + name + "'"};
+	});
 }
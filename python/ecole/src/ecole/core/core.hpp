@@ -10,6 +10,10 @@ namespace version {
 void bind_submodule(pybind11::module_ m);
 }
 
+namespace utility::metrics {
+void bind_submodule(pybind11::module_ const& m);
+}
+
 namespace scip {
 void bind_submodule(pybind11::module_ m);
 }
@@ -38,4 +42,8 @@ namespace dynamics {
 void bind_submodule(pybind11::module_ const& m);
 }
 
+namespace environment {
+void bind_submodule(pybind11::module_ const& m);
+}
+
 }  // namespace ecole
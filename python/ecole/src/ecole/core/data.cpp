@@ -1,15 +1,28 @@
+#include <cstddef>
+#include <optional>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/stl/filesystem.h>
+#include <xtensor-python/pytensor.hpp>
 
 #include "ecole/data/abstract.hpp"
 #include "ecole/data/constant.hpp"
 #include "ecole/data/map.hpp"
 #include "ecole/data/none.hpp"
 #include "ecole/data/timed.hpp"
+#include "ecole/data/trajectory.hpp"
 #include "ecole/data/vector.hpp"
+#include "ecole/random.hpp"
 #include "ecole/scip/model.hpp"
+#include "ecole/utility/tensor-view.hpp"
 
 #include "core.hpp"
+#include "native.hpp"
 
 namespace ecole::data {
 
@@ -19,20 +32,279 @@ namespace py = pybind11;
  * A C++ class to wrap any Python object as an data extraction function.
  *
  * This is used to bind templated types such as MapFunction and VectorFunction.
+ * Objects holding a NativeFunction extract their data with the GIL released.
  */
 class PyDataFunction {
 public:
 	PyDataFunction() noexcept = default;
-	explicit PyDataFunction(py::object data_func) noexcept : data_function(std::move(data_func)) {}
+	explicit PyDataFunction(py::object data_func) :
+		data_function(std::move(data_func)), native(NativeFunction::from(data_function)) {}
 
 	auto before_reset(scip::Model& model) -> void { data_function.attr("before_reset")(&model); }
 
-	auto extract(scip::Model& model, bool done) -> py::object { return data_function.attr("extract")(&model, done); }
+	auto extract(scip::Model& model, bool done) -> py::object {
+		if (native.has_value()) {
+			auto const convert = [&] {
+				auto const release = py::gil_scoped_release{};
+				return native->extract(model, done);
+			}();
+			return convert();
+		}
+		return data_function.attr("extract")(&model, done);
+	}
+
+	[[nodiscard]] auto is_native() const noexcept -> bool { return native.has_value(); }
+
+	/** Extract data from a native function, without the GIL. */
+	auto extract_native(scip::Model& model, bool done) const -> NativeFunction::Converter {
+		return native->extract(model, done);
+	}
 
 private:
 	py::object data_function;
+	std::optional<NativeFunction> native;
 };
 
+/**
+ * Extract data from the functions in order, with the GIL released once per run of consecutive native functions.
+ *
+ * Functions may change the model, so they are called in their order even when mixing both kinds of functions.
+ * Data of native functions are converted back to Python once all functions are done.
+ */
+auto extract_grouped(std::vector<PyDataFunction*> const& functions, scip::Model& model, bool done)
+	-> std::vector<py::object> {
+	auto data = std::vector<py::object>(functions.size());
+	auto converters = std::vector<NativeFunction::Converter>(functions.size());
+	for (std::size_t i = 0; i < functions.size();) {
+		if (!functions[i]->is_native()) {
+			data[i] = functions[i]->extract(model, done);
+			++i;
+			continue;
+		}
+		auto const release = py::gil_scoped_release{};
+		for (; i < functions.size() && functions[i]->is_native(); ++i) {
+			converters[i] = functions[i]->extract_native(model, done);
+		}
+	}
+	for (std::size_t i = 0; i < functions.size(); ++i) {
+		if (converters[i]) {
+			data[i] = converters[i]();
+		}
+	}
+	return data;
+}
+
+/**
+ * Bind a trajectory writer and reader with the given observation value type.
+ */
+/** A read only Numpy array viewing the tensor, keeping ``base`` alive. */
+template <typename T, std::size_t N>
+auto readonly_array(utility::tensor_view<T, N> const& view, py::handle base) -> py::array_t<T> {
+	auto array = py::array_t<T>{view.shape, view.data, base};
+	array.attr("flags").attr("writeable") = false;
+	return array;
+}
+
+/** Bind a property returning a read only array viewing the tensor of the sample. */
+template <typename Sample, typename Getter>
+void def_view(py::class_<Sample>& sample_class, char const* name, Getter getter, char const* doc) {
+	sample_class.def_property_readonly(
+		name,
+		[getter](py::object const& self) { return readonly_array(getter(self.cast<Sample const&>()), self); },
+		doc);
+}
+
+template <typename Value> void bind_trajectory_sample(py::module_ const& m, char const* sample_name) {
+	using Sample = BasicTrajectorySample<Value>;
+
+	auto sample_class = py::class_<Sample>(m, sample_name, R"(
+		A step viewed in place in a trajectory file.
+
+		Arrays are read only and share the memory of the mapped file when the step was written without
+		compression nor integer narrowing.
+		They keep the file mapped while they are alive.
+		Fields have the same layout as in :py:class:`~ecole.observation.NodeBipartiteObs` and the steps written.
+	)");
+	def_view(
+		sample_class,
+		"variable_features",
+		[](Sample const& s) { return s.observation.variable_features; },
+		"The features of the variables.");
+	def_view(
+		sample_class,
+		"row_features",
+		[](Sample const& s) { return s.observation.row_features; },
+		"The features of the rows.");
+	def_view(
+		sample_class,
+		"edge_values",
+		[](Sample const& s) { return s.observation.edge_features.values; },
+		"The non zero values of the edge features in COO format.");
+	def_view(
+		sample_class,
+		"edge_indices",
+		[](Sample const& s) { return s.observation.edge_features.indices; },
+		"The row and column indices of the edge features in COO format.");
+	def_view(
+		sample_class,
+		"edge_csr_values",
+		[](Sample const& s) { return s.observation.edge_features_csr.values; },
+		"The non zero values of the edge features in CSR format.");
+	def_view(
+		sample_class,
+		"edge_csr_column_indices",
+		[](Sample const& s) { return s.observation.edge_features_csr.column_indices; },
+		"The column indices of the edge features in CSR format.");
+	def_view(
+		sample_class,
+		"edge_csr_row_pointers",
+		[](Sample const& s) { return s.observation.edge_features_csr.row_pointers; },
+		"The row pointers of the edge features in CSR format.");
+	def_view(sample_class, "action_set", [](Sample const& s) { return s.action_set; }, "The action set.");
+	sample_class  //
+		.def_property_readonly("edge_shape", [](Sample const& s) { return s.observation.edge_features.shape; })
+		.def_readonly("action", &Sample::action)
+		.def_readonly("reward", &Sample::reward);
+}
+
+template <typename Value>
+void bind_trajectory(
+	py::module_ const& m,
+	char const* writer_name,
+	char const* reader_name,
+	char const* dataset_name,
+	char const* iterator_name) {
+	using Writer = BasicTrajectoryWriter<Value>;
+	using Reader = BasicTrajectoryReader<Value>;
+	using Dataset = BasicTrajectoryDataset<Value>;
+	using Iterator = BasicShuffledTrajectoryIterator<Value>;
+	using Obs = observation::BasicNodeBipartiteObs<Value>;
+
+	py::class_<Writer>(m, writer_name, R"(
+		Stream trajectory steps to a compact binary file.
+
+		Steps are made of a :py:class:`~ecole.observation.NodeBipartite` observation, an action set, an action,
+		and a reward.
+		Integer arrays are stored with the smallest integer width that represent their values, and
+		arrays are optionally compressed.
+		Steps are written by chunks, and an index is written when closing the writer, which can be used as
+		a context manager.
+		Files that were not closed can still be read.
+		Files are not portable accross machines of different endianness.
+	)")
+		.def(
+			py::init<std::filesystem::path const&, bool, std::size_t, bool, TrajectoryCompression, bool>(),
+			py::arg("filename"),
+			py::arg("compress") = false,
+			py::arg("chunk_size") = 64,  // NOLINT(readability-magic-numbers)
+			py::arg("narrow_integers") = true,
+			py::arg("compression") = TrajectoryCompression::zero_runs,
+			py::arg("delta_integers") = false,
+			R"(
+			Create a new file, overwriting existing ones.
+
+			Parameters
+			----------
+			filename:
+				The file to write.
+			compress:
+				Whether to compress arrays, which makes writing slower.
+			chunk_size:
+				The number of steps buffered in memory before being written to the file.
+			narrow_integers:
+				Whether to store integers with the smallest width possible.
+				Files written without compression nor narrowing can be viewed without any copy.
+			compression:
+				How to compress arrays when ``compress`` is set.
+				Feature matrices are compressed column by column.
+			delta_integers:
+				Whether to store integer arrays, such as sorted edge indices, as the differences of
+				consecutive values when they are narrower than the values.
+		)")
+		.def(
+			"write",
+			[](Writer& self,
+				 Obs const& obs,
+				 xt::xtensor<std::size_t, 1> const& action_set,
+				 std::size_t action,
+				 double reward) { self.write(obs, action_set, action, reward); },
+			py::arg("observation"),
+			py::arg("action_set"),
+			py::arg("action"),
+			py::arg("reward"),
+			"Append a step to the trajectory.")
+		.def("close", &Writer::close, "Write buffered steps and the index of steps.")
+		.def("__len__", &Writer::size)
+		.def("__enter__", [](Writer& self) -> Writer& { return self; }, py::return_value_policy::reference)
+		.def("__exit__", [](Writer& self, py::args const& /*args*/) { self.close(); });
+
+	py::class_<Reader>(m, reader_name, R"(
+		Random access to the steps of a trajectory file.
+
+		The file is memory mapped so that only the steps being read are loaded in memory.
+		Steps are returned as a tuple ``(observation, action_set, action, reward)``.
+	)")
+		.def(py::init<std::filesystem::path const&>(), py::arg("filename"))
+		.def("__len__", &Reader::size)
+		.def(
+			"__getitem__",
+			[](Reader const& self, std::size_t index) {
+				auto step = [&] {
+					auto const release = py::gil_scoped_release{};
+					return self.read(index);
+				}();
+				return std::tuple{std::move(step.observation), std::move(step.action_set), step.action, step.reward};
+			},
+			py::arg("index"))
+		.def(
+			"view",
+			[](Reader const& self, std::size_t index) {
+				auto const release = py::gil_scoped_release{};
+				return self.view(index);
+			},
+			py::arg("index"),
+			"View the step in place in the file.");
+
+	py::class_<Dataset>(m, dataset_name, R"(
+		The steps of multiple trajectory files, indexed contiguously.
+
+		Files are memory mapped, and steps are viewed in place as
+		:py:class:`~ecole.data.TrajectorySample`.
+	)")
+		.def(py::init<std::vector<std::filesystem::path> const&>(), py::arg("filenames"))
+		.def("__len__", &Dataset::size)
+		.def(
+			"__getitem__",
+			[](Dataset const& self, std::size_t index) {
+				auto const release = py::gil_scoped_release{};
+				return self.view(index);
+			},
+			py::arg("index"));
+
+	py::class_<Iterator>(m, iterator_name, R"(
+		Iterate once over the steps of a dataset in a random order.
+
+		A background thread views the next steps and loads their memory from disk ahead of time.
+	)")
+		.def(
+			py::init<Dataset const&, RandomGenerator&, std::size_t>(),
+			py::arg("dataset"),
+			py::arg("rng"),
+			py::arg("n_prefetch") = 16,  // NOLINT(readability-magic-numbers)
+			py::keep_alive<1, 2>())
+		.def("__iter__", [](Iterator& self) -> Iterator& { return self; }, py::return_value_policy::reference)
+		.def("__next__", [](Iterator& self) {
+			auto sample = [&] {
+				auto const release = py::gil_scoped_release{};
+				return self.next();
+			}();
+			if (!sample.has_value()) {
+				throw py::stop_iteration{};
+			}
+			return std::move(sample).value();
+		});
+}
+
 void bind_submodule(py::module_ const& m) {
 	m.doc() = "Data extraction functions manipulation.";
 
@@ -63,10 +335,20 @@ void bind_submodule(py::module_ const& m) {
 			"Call before_reset on all data extraction functions.")
 		.def(
 			"extract",
-			&PyVectorFunction::extract,
+			[](PyVectorFunction& self, scip::Model& model, bool done) {
+				auto functions = std::vector<PyDataFunction*>{};
+				for (auto& func : self.functions()) {
+					functions.push_back(&func);
+				}
+				return extract_grouped(functions, model, done);
+			},
 			py::arg("model"),
 			py::arg("done"),
-			"Return data from all functions as a tuple.");
+			R"(
+			Return data from all functions as a list.
+
+			Functions are called in order, consecutive functions of Ecole all together with the GIL released.
+		)");
 
 	using PyMapFunction = MapFunction<std::string, PyDataFunction>;
 	py::class_<PyMapFunction>(m, "MapFunction", "Pack data extraction functions together and return data as a dict.")
@@ -84,20 +366,37 @@ void bind_submodule(py::module_ const& m) {
 			"Call before_reset on all data extraction functions.")
 		.def(
 			"extract",
-			&PyMapFunction::extract,
+			[](PyMapFunction& self, scip::Model& model, bool done) {
+				auto functions = std::vector<PyDataFunction*>{};
+				for (auto& [_, func] : self.functions()) {
+					functions.push_back(&func);
+				}
+				auto data = extract_grouped(functions, model, done);
+				auto result = py::dict{};
+				auto iter = data.begin();
+				for (auto const& [key, _] : self.functions()) {
+					result[py::str{key}] = std::move(*iter++);
+				}
+				return result;
+			},
 			py::arg("model"),
 			py::arg("done"),
-			"Return data from all functions as a dict.");
+			R"(
+			Return data from all functions as a dict.
+
+			Functions are called in the same order as with :py:meth:`VectorFunction.extract`.
+		)");
 
 	using PyTimedFunction = TimedFunction<PyDataFunction>;
 	py::class_<PyTimedFunction>(m, "TimedFunction", "Time in seconds of any function.")
 		.def(
-			py::init([](py::object func, bool wall) {
-				return std::make_unique<PyTimedFunction>(PyDataFunction{std::move(func)}, wall);
+			py::init([](py::object func, bool wall, bool thread_cpu) {
+				return std::make_unique<PyTimedFunction>(PyDataFunction{std::move(func)}, wall, thread_cpu);
 			}),
 			py::arg("func"),
-			py::arg("wall") = false)
-		.def(py::init<bool>(), py::arg("wall") = false)
+			py::arg("wall") = false,
+			py::arg("thread_cpu") = false)
+		.def(py::init<bool, bool>(), py::arg("wall") = false, py::arg("thread_cpu") = false)
 		.def(
 			"before_reset",
 			&PyTimedFunction::before_reset,
@@ -109,6 +408,21 @@ void bind_submodule(py::module_ const& m) {
 			py::arg("model"),
 			py::arg("done"),
 			"Time the data extract function in seconds.");
+
+	py::enum_<TrajectoryCompression>(m, "TrajectoryCompression", "The compression of arrays in trajectory files.")
+		.value("zero_runs", TrajectoryCompression::zero_runs, "Runs of zeros are replaced by their length.")
+		.value("zstd", TrajectoryCompression::zstd, "Compressed with zstd, when Ecole is built with it.");
+
+	bind_trajectory_sample<double>(m, "TrajectorySample");
+	bind_trajectory_sample<float>(m, "TrajectorySampleFloat32");
+	bind_trajectory<double>(
+		m, "TrajectoryWriter", "TrajectoryReader", "TrajectoryDataset", "ShuffledTrajectoryIterator");
+	bind_trajectory<float>(
+		m,
+		"TrajectoryWriterFloat32",
+		"TrajectoryReaderFloat32",
+		"TrajectoryDatasetFloat32",
+		"ShuffledTrajectoryIteratorFloat32");
 }
 
 }  // namespace ecole::data
@@ -1,12 +1,22 @@
+#include <algorithm>
+#include <chrono>
+#include <optional>
 #include <utility>
+#include <vector>
 
+#include <pybind11/chrono.h>
+#include <pybind11/functional.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include <xtensor-python/pytensor.hpp>
 
 #include "ecole/dynamics/branching.hpp"
 #include "ecole/dynamics/configuring.hpp"
+#include "ecole/dynamics/cut-selection.hpp"
+#include "ecole/dynamics/node-selection.hpp"
 #include "ecole/dynamics/primal-search.hpp"
+#include "ecole/dynamics/schedule.hpp"
+#include "ecole/python/array-span.hpp"
 #include "ecole/scip/model.hpp"
 
 #include "core.hpp"
@@ -14,7 +24,6 @@
 namespace ecole::dynamics {
 
 namespace py = pybind11;
-template <typename T> using Numpy = py::array_t<T, py::array::c_style | py::array::forcecast>;
 
 template <typename Class, typename... ClassArgs> struct dynamics_class : public pybind11::class_<Class, ClassArgs...> {
 	using pybind11::class_<Class, ClassArgs...>::class_;
@@ -32,9 +41,14 @@ template <typename Class, typename... ClassArgs> struct dynamics_class : public
 
 	/** Bind step_dynamics */
 	template <typename... Args> auto def_step_dynamics(Args&&... args) -> auto& {
+		return def_step_dynamics_method(&Class::step_dynamics, std::forward<Args>(args)...);
+	}
+
+	/** Bind step_dynamics with an explicit method, used to select among overloads. */
+	template <typename Method, typename... Args> auto def_step_dynamics_method(Method method, Args&&... args) -> auto& {
 		this->def(
 			"step_dynamics",
-			&Class::step_dynamics,
+			method,
 			py::arg("model"),
 			py::arg("action"),
 			py::call_guard<py::gil_scoped_release>(),
@@ -55,9 +69,52 @@ template <typename Class, typename... ClassArgs> struct dynamics_class : public
 	}
 };
 
+/**
+ * Wrap a view on a buffer of the dynamics in a read-only array, or return None if there is no view.
+ *
+ * The array refers to the buffer of the dynamics, which the base object keeps alive.
+ */
+template <typename T>
+auto readonly_view(std::optional<nonstd::span<T const>> const& maybe_view, py::object const& dynamics) -> py::object {
+	if (!maybe_view.has_value()) {
+		return py::none();
+	}
+	auto array = py::array_t<T>{static_cast<py::ssize_t>(maybe_view->size()), maybe_view->data(), dynamics};
+	py::detail::array_proxy(array.ptr())->flags &= ~py::detail::npy_api::NPY_ARRAY_WRITEABLE_;
+	return std::move(array);
+}
+
+/** The variable indices and values of a primal search action, read from Python without copy when possible. */
+using PrimalSearchArgument = std::pair<
+	python::ArraySpan<PrimalSearchDynamics::Action::first_type::value_type>,
+	python::ArraySpan<PrimalSearchDynamics::Action::second_type::value_type>>;
+
+auto primal_search_argument(py::handle action) -> PrimalSearchArgument {
+	auto const [indices, values] = action.cast<std::pair<py::object, py::object>>();
+	return {PrimalSearchArgument::first_type{indices}, PrimalSearchArgument::second_type{values}};
+}
+
 void bind_submodule(pybind11::module_ const& m) {
 	m.doc() = "Ecole collection of environment dynamics.";
 
+	py::class_<ObservationSchedule>(m, "ObservationSchedule", R"(
+		Selection of the branching nodes on which control is given to the user.
+
+		Nodes that are not selected are branched on by SCIP without giving back control, which saves the
+		cost of extracting observations and rewards on nodes that are not used, for instance when collecting
+		datasets.
+	)")
+		.def(py::init<>(), "Select every node.")
+		.def_static("every", &ObservationSchedule::every, py::arg("period"), R"(
+			Select one node every ``period`` nodes, starting with the first one.
+		)")
+		.def_static("probability", &ObservationSchedule::probability, py::arg("probability"), R"(
+			Select every node independently with the given probability, seeded by the environment.
+		)")
+		.def_static("max_depth", &ObservationSchedule::max_depth, py::arg("max_depth"), R"(
+			Select nodes whose depth in the branch-and-bound tree is at most ``max_depth``.
+		)");
+
 	{
 		dynamics_class<BranchingDynamics>{m, "BranchingDynamics", R"(
 			Single variable branching Dynamics.
@@ -93,7 +150,9 @@ void bind_submodule(pybind11::module_ const& m) {
 						(``SCIPvarGetProbindex``).
 						Variable ordering in the ``action_set`` is arbitrary.
 			)")
-			.def_step_dynamics(R"(
+			.def_step_dynamics_method(
+				py::overload_cast<scip::Model&, BranchingDynamics::Action>(&BranchingDynamics::step_dynamics, py::const_),
+				R"(
 				Branch and resume solving until next branching.
 
 				Branching is done on a single variable using ``SCIPbranchVar``.
@@ -119,8 +178,114 @@ void bind_submodule(pybind11::module_ const& m) {
 						(``SCIPvarGetProbindex``).
 						Variables ordering in the ``action_set`` is arbitrary.
 					)")
+			.def(
+				"step_dynamics",
+				py::overload_cast<scip::Model&, BranchingDynamics::Action, std::size_t, BranchingDynamics::Policy>(
+					&BranchingDynamics::step_dynamics, py::const_),
+				py::arg("model"),
+				py::arg("action"),
+				py::arg("n_nodes"),
+				py::arg("policy"),
+				py::call_guard<py::gil_scoped_release>(),
+				R"(
+				Branch, then let a policy branch on the following nodes before resuming control.
+
+				The policy is called directly by the solver on the next ``n_nodes - 1`` branching decisions, so that
+				control is given back to the user only once every ``n_nodes`` nodes.
+
+				Parameters
+				----------
+					model:
+						The state of the Markov Decision Process. Passed by the environment.
+					action:
+						The index the LP column of the variable to branch on, or ``ecole.Default``.
+					n_nodes:
+						The number of branching decisions to make before giving back control.
+					policy:
+						A callable taking the model and action set, and returning a variable index or ``ecole.Default``.
+						For instance the policy returned by :py:meth:`score_policy`.
+
+				Returns
+				-------
+					done:
+						Whether the instance is solved.
+					action_set:
+						List of indices of branching candidate variables.
+			)")
+			.def(
+				"action_set_view",
+				[](py::object const& self, scip::Model const& model, bool compact) -> py::object {
+					auto const& dynamics = self.cast<BranchingDynamics const&>();
+					if (compact) {
+						return readonly_view(dynamics.action_set_view_32(model), self);
+					}
+					return readonly_view(dynamics.action_set_view(model), self);
+				},
+				py::arg("model"),
+				py::arg("compact") = false,
+				R"(
+				Return the action set of the current node without allocating.
+
+				The array is a read-only view of a buffer of the dynamics, which is overwritten by the next
+				call to this method.
+
+				Parameters
+				----------
+					model:
+						The state of the Markov Decision Process.
+					compact:
+						Whether to return 32 bits indices rather than 64 bits ones.
+
+				Returns
+				-------
+					action_set:
+						List of indices of branching candidate variables, or ``None`` if the model is not solving.
+			)")
+			.def(
+				"action_mask_view",
+				[](py::object const& self, scip::Model const& model, bool packed) {
+					return readonly_view(self.cast<BranchingDynamics const&>().action_mask_view(model, packed), self);
+				},
+				py::arg("model"),
+				py::arg("packed") = false,
+				R"(
+				Return the action set of the current node as a mask over all variables, without allocating.
+
+				The array is a read-only view of a buffer of the dynamics, which is overwritten by the next
+				call to this method with the same ``packed`` value.
+				It can be used to mask the scores of all variables, for instance with ``torch.from_numpy``.
+
+				Parameters
+				----------
+					model:
+						The state of the Markov Decision Process.
+					packed:
+						Whether to return a bit per variable rather than a byte, as packed by
+						``numpy.packbits(mask, bitorder="little")``.
+
+				Returns
+				-------
+					action_mask:
+						A ``uint8`` array, indexed by variable problem index, that is one for branching candidates,
+						or ``None`` if the model is not solving.
+			)")
+			.def_static("score_policy", &BranchingDynamics::score_policy, py::arg("scores"), R"(
+				Create a policy that branches on the candidate with the highest score.
+
+				Parameters
+				----------
+					scores:
+						The score of every variable, indexed by their position in the original problem.
+			)")
+			.def_static("pseudocost_policy", &BranchingDynamics::pseudocost_policy, R"(
+				Create a policy that branches on the candidate with the highest pseudocost score.
+
+				Used as the ``explore_policy`` with a probabilistic ``observation_schedule``, and
+				:py:class:`~ecole.observation.StrongBranchingScores` as observation, this is the
+				explore-then-strong-branch scheme of imitation learning, where only expert nodes reach Python.
+			)")
 			.def_set_dynamics_random_state(R"(
-				Set seeds on the :py:class:`~ecole.scip.Model`.
+				Set seeds on the :py:class:`~ecole.scip.Model` and on the observation schedule.
 
 				Set seed parameters, including permutation, LP, and shift.
 
@@ -131,7 +296,15 @@ void bind_submodule(pybind11::module_ const& m) {
 					rng:
 						The source of randomness. Passed by the environment.
 			)")
-			.def(py::init<bool>(), py::arg("pseudo_candidates") = false, R"(
+			.def(
+				py::init<bool, ObservationSchedule, std::size_t, bool, std::chrono::milliseconds, BranchingDynamics::Policy>(),
+				py::arg("pseudo_candidates") = false,
+				py::arg("observation_schedule") = ObservationSchedule{},
+				py::arg("presolve_cache_size") = 0,
+				py::arg("cache_root_cuts") = false,
+				py::arg("step_deadline") = std::chrono::milliseconds::zero(),
+				py::arg("explore_policy") = py::none(),
+				R"(
 				Create new dynamics.
 
 				Parameters
@@ -139,7 +312,45 @@ void bind_submodule(pybind11::module_ const& m) {
 				pseudo_candidates:
 					Whether the action set contains pseudo branching variable candidates (``SCIPgetPseudoBranchCands``)
 					or LP branching variable candidates (``SCIPgetPseudoBranchCands``).
-			)");
+				observation_schedule:
+					The nodes on which control is given back to the user.
+					Other nodes are branched on by SCIP default rules directly in the solver, without extracting
+					observations nor rewards.
+				presolve_cache_size:
+					The number of presolved problems kept to start later episodes on the same instance without
+					presolving again.
+					Episodes then start from a copy of the presolved problem, with presolving disabled.
+					Zero disables the cache.
+				cache_root_cuts:
+					Whether to also keep the cuts separated at the root node of presolved problems, and add them as
+					linear constraints to the problem of later episodes.
+					Requires a presolve cache.
+				step_deadline:
+					How long the solver waits for the action once the environment has extracted the state, as a
+					``datetime.timedelta`` or a number of seconds.
+					Past the deadline, SCIP branches with its default rules and keeps solving until the next state,
+					and the late action is dropped.
+					Zero waits forever.
+				explore_policy:
+					The policy branching on the nodes not selected by ``observation_schedule``, directly in the solver,
+					or ``None`` for SCIP default rules.
+					With the policy of :py:meth:`pseudocost_policy`, no Python code runs on these nodes.
+			)")
+			.def(
+				"start_step_deadline",
+				&BranchingDynamics::start_step_deadline,
+				py::arg("model"),
+				R"(
+				Start the step deadline of the current state, if any.
+
+				Called by environments once they are done extracting the state, except with lazy observations.
+				The model must not be used until the next call to :py:meth:`step_dynamics`.
+			)")
+			.def_property_readonly("step_deadline", &BranchingDynamics::step_deadline)
+			.def_property_readonly(
+				"n_presolved_cached",
+				&BranchingDynamics::n_presolved_cached,
+				"The number of presolved problems currently in the cache.");
 	}
 
 	{
@@ -195,13 +406,46 @@ void bind_submodule(pybind11::module_ const& m) {
 					rng:
 						The source of randomness. Passed by the environment.
 			)")
-			.def(py::init<>());
+			.def(py::init<std::size_t, bool>(), py::arg("n_threads") = 1, py::arg("reuse_presolve") = false, R"(
+				Create new dynamics.
+
+				Parameters
+				----------
+				n_threads:
+					The number of threads solving every instance.
+					With more than one thread, instances are solved with the SCIP concurrent solver, which races
+					differently configured copies of the problem and keeps the result and statistics of the first to
+					finish.
+					Requires SCIP to be built with a task processing interface, otherwise instances are solved
+					sequentially.
+				reuse_presolve:
+					Whether to presolve every instance once, for all the configurations only setting solving
+					parameters (see :py:func:`param_phase`).
+					The presolved problem is cached and loaded in place of presolving again when the instance and
+					the presolving parameters are the same, ignoring randomization parameters.
+					The model then solves the presolved problem as its original problem, so solutions and
+					statistics are those of the presolved problem.
+			)")
+			.def_property_readonly("n_threads", &ConfiguringDynamics::n_threads)
+			.def_property_readonly("reuse_presolve", &ConfiguringDynamics::reuse_presolve);
+
+		py::enum_<SolvePhase>(m, "SolvePhase", "The earliest phase of the solving process that a parameter affects.")
+			.value("presolving", SolvePhase::presolving, "The parameter may change the presolved problem.")
+			.value("solving", SolvePhase::solving, "The parameter only affects solving the presolved problem.");
+
+		m.def("param_phase", &param_phase, py::arg("name"), R"(
+			Classify a SCIP parameter by the solve phase it affects.
+
+			Parameters of branching rules, node selectors, separators, cut selectors, the LP, conflict analysis,
+			limits, parallelism, and display only affect solving, as do the frequencies of constraint handlers and
+			propagators.
+			Any other parameter is conservatively considered to affect presolving, including those of primal
+			heuristics, since some run during presolving.
+		)");
 	}
 
 	{
-		using idx_t = typename PrimalSearchDynamics::Action::first_type::value_type;
-		using val_t = typename PrimalSearchDynamics::Action::second_type::value_type;
-		dynamics_class<PrimalSearchDynamics>{m, "PrimalSearchDynamics", R"(
+		auto primal_search = dynamics_class<PrimalSearchDynamics>{m, "PrimalSearchDynamics", R"(
 			Search for primal solutions Dynamics.
 
 			Based on a SCIP `primal heuristic <https://www.scipopt.org/doc/html/HEUR.php>`_
@@ -213,7 +457,26 @@ void bind_submodule(pybind11::module_ const& m) {
 			expected to give back as an action a partial primal solution, i.e., a value
 			assignment for a subset of these variables.
 
-		)"}
+		)"};
+
+		py::enum_<PrimalSearchDynamics::Screening>(primal_search, "Screening", R"(
+			How solutions are screened against the linear rows of the LP before any probing.
+
+			Screening bounds the activity of every global row of the LP with the solution, the other
+			variables being free within their global bounds, and only solutions that cannot violate a row
+			are probed.
+		)")
+			.value("none", PrimalSearchDynamics::Screening::none, "Probe all solutions.")
+			.value(
+				"reject",
+				PrimalSearchDynamics::Screening::reject,
+				"Do not probe solutions with invalid values or violating a row.")
+			.value(
+				"repair",
+				PrimalSearchDynamics::Screening::repair,
+				"Round integer variables and clip values to bounds, then reject solutions violating a row.");
+
+		primal_search
 			.def_set_dynamics_random_state(R"(
 				Set seeds on the :py:class:`~ecole.scip.Model`.
 
@@ -249,11 +512,31 @@ void bind_submodule(pybind11::module_ const& m) {
 			)")
 			.def(
 				"step_dynamics",
-				[](PrimalSearchDynamics& self, scip::Model& model, std::pair<Numpy<idx_t>, Numpy<val_t>> const& action) {
-					auto const indices = nonstd::span{action.first.data(), static_cast<std::size_t>(action.first.size())};
-					auto const values = nonstd::span{action.second.data(), static_cast<std::size_t>(action.second.size())};
+				[](PrimalSearchDynamics& self, scip::Model& model, py::object const& action) {
+					// A list of tuples is a batch of solutions, anything else a single solution
+					auto const is_batch = py::isinstance<py::list>(action) &&
+										  std::all_of(action.begin(), action.end(), [](py::handle const& item) {
+											  return py::isinstance<py::tuple>(item);
+										  });
+					// Arrays must outlive the spans, and are released after the GIL is acquired back
+					auto arguments = std::vector<PrimalSearchArgument>{};
+					if (is_batch) {
+						for (auto const& item : action) {
+							arguments.push_back(primal_search_argument(item));
+						}
+					} else {
+						arguments.push_back(primal_search_argument(action));
+					}
 					auto const release = py::gil_scoped_release{};
-					return self.step_dynamics(model, {indices, values});
+					auto actions = std::vector<PrimalSearchDynamics::Action>{};
+					actions.reserve(arguments.size());
+					for (auto& [indices, values] : arguments) {
+						actions.emplace_back(indices.span(), values.span());
+					}
+					if (is_batch) {
+						return self.step_dynamics_batch(model, nonstd::span<PrimalSearchDynamics::Action const>{actions});
+					}
+					return self.step_dynamics(model, actions.front());
 				},
 				py::arg("model"),
 				py::arg("action"),
@@ -267,12 +550,16 @@ void bind_submodule(pybind11::module_ const& m) {
 				values, and the rest of the variable assigments is deduced by solving an LP in probing
 				mode. If the provided partial assigment is empty, then nothing is done.
 
+				A list of (partial) solutions can also be given, in which case they are all tried
+				in the same probing session, and count as a single search trial.
+
 				Parameters
 				----------
 					model:
 						The state of the Markov Decision Process. Passed by the environment.
 					action:
-						A subset of the variables given in the action set, and their assigned values.
+						A subset of the variables given in the action set, and their assigned values,
+						or a list of such ``(indices, values)`` tuples.
 
 				Returns
 				-------
@@ -281,12 +568,34 @@ void bind_submodule(pybind11::module_ const& m) {
 					action_set:
 						List of non-fixed discrete variables (``SCIPgetPseudoBranchCands``).
 			)")
+			.def_property_readonly(
+				"last_solutions_kept",
+				&PrimalSearchDynamics::last_solutions_kept,
+				"For every solution of the last step, whether it was kept by SCIP.")
+			.def_property_readonly(
+				"last_solutions_screened_out",
+				&PrimalSearchDynamics::last_solutions_screened_out,
+				"For every solution of the last step, whether it was screened out without probing.")
 			.def(
-				py::init<int, int, int, int>(),
+				"action_mask_view",
+				[](py::object const& self, scip::Model const& model, bool packed) {
+					return readonly_view(self.cast<PrimalSearchDynamics&>().action_mask_view(model, packed), self);
+				},
+				py::arg("model"),
+				py::arg("packed") = false,
+				R"(
+				Return the action set as a mask over all variables, without allocating.
+
+				The array is laid out as in :py:meth:`BranchingDynamics.action_mask_view`, and is overwritten by
+				the next call to this method with the same ``packed`` value.
+			)")
+			.def(
+				py::init<int, int, int, int, PrimalSearchDynamics::Screening>(),
 				py::arg("trials_per_node") = 1,
 				py::arg("depth_freq") = 1,
 				py::arg("depth_start") = 0,
 				py::arg("depth_stop") = -1,
+				py::arg("screening") = PrimalSearchDynamics::Screening::none,
 				R"(
 					Initialize new PrimalSearchDynamics.
 
@@ -300,8 +609,137 @@ void bind_submodule(pybind11::module_ const& m) {
 							Tree depth at which the primal search starts being called (``HEUR_FREQOFS`` in SCIP).
 						depth_stop:
 							Tree depth after which the primal search stops being called (``HEUR_MAXDEPTH`` in SCIP).
+						screening:
+							How solutions are screened against the LP rows before probing, see
+							:py:class:`PrimalSearchDynamics.Screening`.
 				)");
 	}
+
+	{
+		dynamics_class<NodeSelectionDynamics>{m, "NodeSelectionDynamics", R"(
+			Node selection Dynamics.
+
+			Based on a SCIP `node selector <https://www.scipopt.org/doc/html/NODESEL.php>`_
+			with maximal priority.
+			The dynamics give the control back to the user every time SCIP selects the next node to process.
+			The user receives as an action set the frontier of open nodes, and is expected to select one
+			of them as the action.
+			The frontier is tracked incrementally as nodes are created, selected, and pruned.
+		)"}
+			.def_set_dynamics_random_state(R"(
+				Set seeds on the :py:class:`~ecole.scip.Model`.
+
+				Set seed parameters, including permutation, LP, and shift.
+
+				Parameters
+				----------
+					model:
+						The state of the Markov Decision Process. Passed by the environment.
+					rng:
+						The source of randomness. Passed by the environment.
+			)")
+			.def_reset_dynamics(R"(
+				Start solving up to the first node selection.
+
+				Parameters
+				----------
+					model:
+						The state of the Markov Decision Process. Passed by the environment.
+
+				Returns
+				-------
+					done:
+						Whether the instance is solved.
+						This can happen before any node selection, for instance if the instance is solved during
+						presolving.
+					action_set:
+						Array with one row per open node, in arbitrary order, and four columns: the node number
+						(``SCIPnodeGetNumber``), its depth, its lower bound, and its estimate.
+			)")
+			.def_step_dynamics(R"(
+				Select a node and resume solving until the next node selection.
+
+				Parameters
+				----------
+					model:
+						The state of the Markov Decision Process. Passed by the environment.
+					action:
+						The number of the node to process next, from the first column of the action set.
+						If an explicit ``ecole.Default`` is passed, then the node with the best lower bound is selected.
+
+				Returns
+				-------
+					done:
+						Whether the instance is solved.
+					action_set:
+						Array with one row per open node, in arbitrary order, and four columns: the node number
+						(``SCIPnodeGetNumber``), its depth, its lower bound, and its estimate.
+			)")
+			.def(py::init<>());
+	}
+
+	{
+		dynamics_class<CutSelectionDynamics>{m, "CutSelectionDynamics", R"(
+			Cut selection Dynamics.
+
+			Based on a SCIP `cut selector <https://www.scipopt.org/doc/html/CUTSEL.php>`_
+			with maximal priority.
+			The dynamics give the control back to the user in every separation round with candidate cuts.
+			The user receives as an action set a matrix of features of the candidate cuts, and is expected to
+			select the cuts to add to the LP.
+		)"}
+			.def_set_dynamics_random_state(R"(
+				Set seeds on the :py:class:`~ecole.scip.Model`.
+
+				Set seed parameters, including permutation, LP, and shift.
+
+				Parameters
+				----------
+					model:
+						The state of the Markov Decision Process. Passed by the environment.
+					rng:
+						The source of randomness. Passed by the environment.
+			)")
+			.def_reset_dynamics(R"(
+				Start solving up to the first cut selection.
+
+				Parameters
+				----------
+					model:
+						The state of the Markov Decision Process. Passed by the environment.
+
+				Returns
+				-------
+					done:
+						Whether the instance is solved.
+					action_set:
+						Array with one row per candidate cut and four columns: the efficacy, the parallelism
+						to the objective, the fraction of LP columns in the cut, and the fraction of the cut
+						columns that are integral.
+						Forced cuts are always added and are not candidates.
+			)")
+			.def_step_dynamics(R"(
+				Add the selected cuts and resume solving until the next cut selection.
+
+				Parameters
+				----------
+					model:
+						The state of the Markov Decision Process. Passed by the environment.
+					action:
+						The indices of the cuts to add, that is rows of the action set.
+						If an explicit ``ecole.Default`` is passed, then SCIP default cut selector is used.
+
+				Returns
+				-------
+					done:
+						Whether the instance is solved.
+					action_set:
+						Array with one row per candidate cut and four columns: the efficacy, the parallelism
+						to the objective, the fraction of LP columns in the cut, and the fraction of the cut
+						columns that are integral.
+			)")
+			.def(py::init<>());
+	}
 }
 
 }  // namespace ecole::dynamics
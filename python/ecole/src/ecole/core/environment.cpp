@@ -0,0 +1,552 @@
+#include <algorithm>
+#include <cstddef>
+#include <filesystem>
+#include <functional>
+#include <map>
+#include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/stl/filesystem.h>
+#include <xtensor-python/pytensor.hpp>
+#include <xtensor/xtensor.hpp>
+
+#include "ecole/environment/branching.hpp"
+#include "ecole/environment/configuring.hpp"
+#include "ecole/environment/primal-search.hpp"
+#include "ecole/environment/vector-environment.hpp"
+#include "ecole/information/nothing.hpp"
+#include "ecole/instance/capacitated-facility-location.hpp"
+#include "ecole/instance/combinatorial-auction.hpp"
+#include "ecole/instance/files.hpp"
+#include "ecole/instance/independent-set.hpp"
+#include "ecole/instance/set-cover.hpp"
+#include "ecole/observation/khalil-2016.hpp"
+#include "ecole/observation/milp-bipartite.hpp"
+#include "ecole/observation/node-bipartite.hpp"
+#include "ecole/observation/nothing.hpp"
+#include "ecole/python/array-span.hpp"
+#include "ecole/reward/is-done.hpp"
+#include "ecole/reward/lp-iterations.hpp"
+#include "ecole/reward/n-nodes.hpp"
+#include "ecole/reward/solving-time.hpp"
+#include "ecole/scip/model.hpp"
+#include "ecole/utility/thread-pool.hpp"
+
+#include "core.hpp"
+
+namespace ecole::environment {
+
+namespace py = pybind11;
+template <typename T> using Numpy = py::array_t<T, py::array::c_style | py::array::forcecast>;
+
+namespace {
+
+/**
+ * Observation function dispatching at runtime to one of the built-in observation functions.
+ *
+ * Only C++ functions are accepted, so that the whole transition runs without the GIL.
+ */
+class BuiltinObservation {
+public:
+	using Function = std::variant<
+		observation::Nothing,
+		observation::NodeBipartite,
+		observation::MilpBipartite,
+		observation::Khalil2016>;
+	using Observation = std::variant<
+		NoneType,
+		observation::NodeBipartiteObs,
+		observation::MilpBipartiteObs,
+		observation::Khalil2016Obs>;
+
+	BuiltinObservation(Function function_ = observation::Nothing{}) : function{std::move(function_)} {}
+
+	auto before_reset(scip::Model& model) -> void {
+		std::visit([&model](auto& func) { func.before_reset(model); }, function);
+	}
+
+	auto extract(scip::Model& model, bool done) -> std::optional<Observation> {
+		return std::visit([&](auto& func) { return wrap(func.extract(model, done)); }, function);
+	}
+
+	template <typename Func> [[nodiscard]] auto holds() const noexcept -> bool {
+		return std::holds_alternative<Func>(function);
+	}
+
+private:
+	Function function;
+
+	static auto wrap(NoneType none) -> std::optional<Observation> { return Observation{none}; }
+
+	template <typename Obs> static auto wrap(std::optional<Obs>&& obs) -> std::optional<Observation> {
+		if (!obs.has_value()) {
+			return {};
+		}
+		return Observation{std::move(obs).value()};
+	}
+};
+
+/** Reward function dispatching at runtime to one of the built-in reward functions. */
+class BuiltinReward {
+public:
+	using Function = std::variant<reward::IsDone, reward::NNodes, reward::LpIterations, reward::SolvingTime>;
+
+	BuiltinReward(Function function_ = reward::IsDone{}) : function{std::move(function_)} {}
+
+	auto before_reset(scip::Model& model) -> void {
+		std::visit([&model](auto& func) { func.before_reset(model); }, function);
+	}
+
+	auto extract(scip::Model& model, bool done) -> reward::Reward {
+		return std::visit([&](auto& func) { return func.extract(model, done); }, function);
+	}
+
+private:
+	Function function;
+};
+
+template <typename Dynamics>
+using BuiltinEnvironment = Environment<Dynamics, BuiltinObservation, BuiltinReward, information::Nothing>;
+
+/**
+ * Bind the methods shared by all environments, except step whose action may need a conversion.
+ *
+ * All transitions release the GIL once, for the dynamics and the extraction of the reward, observation, and
+ * information altogether.
+ */
+template <typename Dynamics>
+auto bind_environment(
+	py::module_ const& m,
+	char const* name,
+	BuiltinObservation::Function default_observation_function,
+	char const* doc) {
+	using Env = BuiltinEnvironment<Dynamics>;
+	auto env_class = py::class_<Env>{m, name, doc};
+	env_class
+		.def(
+			py::init([](std::optional<BuiltinObservation::Function> observation_function,
+						BuiltinReward::Function reward_function,
+						std::map<std::string, scip::Param> scip_params,
+						Dynamics dynamics) {
+				return std::make_unique<Env>(
+					BuiltinObservation{std::move(observation_function).value_or(observation::Nothing{})},
+					BuiltinReward{std::move(reward_function)},
+					information::Nothing{},
+					std::move(scip_params),
+					std::move(dynamics));
+			}),
+			py::arg("observation_function") = std::move(default_observation_function),
+			py::arg("reward_function") = reward::IsDone{},
+			py::arg("scip_params") = std::map<std::string, scip::Param>{},
+			py::arg("dynamics") = Dynamics{},
+			R"(
+			Create a new environment object.
+
+			Parameters
+			----------
+				observation_function:
+					A built-in observation function, or None to not extract observations.
+				reward_function:
+					A built-in reward function.
+				scip_params:
+					Parameters set on the underlying :py:class:`~ecole.scip.Model` at the start of every episode.
+				dynamics:
+					The dynamics of the environment, to customize their parameters.
+		)")
+		.def(
+			"reset",
+			[](Env& self, scip::Model const& model) { return self.reset(model); },
+			py::arg("instance"),
+			py::call_guard<py::gil_scoped_release>(),
+			"Start a new episode on a copy of the given model, as :py:meth:`ecole.environment.Environment.reset`.")
+		.def(
+			"reset",
+			[](Env& self, std::filesystem::path const& filename) { return self.reset(filename.string()); },
+			py::arg("instance"),
+			py::call_guard<py::gil_scoped_release>(),
+			"Start a new episode on the given instance file, as :py:meth:`ecole.environment.Environment.reset`.")
+		.def("snapshot", &Env::snapshot, py::call_guard<py::gil_scoped_release>(), R"(
+			Capture the current state to later branch differently from it.
+
+			See :py:meth:`ecole.environment.Environment.snapshot`.
+		)")
+		.def("seed", &Env::seed, py::arg("value"), "Set the random seed of the environment.")
+		.def_property_readonly(
+			"model",
+			[](Env& self) -> scip::Model& { return self.model(); },
+			py::return_value_policy::reference_internal,
+			"The model of the current episode.")
+		.def_property_readonly(
+			"dynamics",
+			[](Env& self) -> Dynamics& { return self.dynamics(); },
+			py::return_value_policy::reference_internal,
+			"The dynamics driving the environment.");
+	return env_class;
+}
+
+using Observations = std::vector<std::optional<BuiltinObservation::Observation>>;
+
+/** Concatenate the bipartite graphs, terminal states having no observation hence empty ranges. */
+auto collate_node_bipartite(Observations const& observations) -> observation::NodeBipartiteBatch {
+	auto pointers = std::vector<observation::NodeBipartiteObs const*>(observations.size(), nullptr);
+	for (std::size_t i = 0; i < observations.size(); ++i) {
+		if (observations[i].has_value()) {
+			pointers[i] = std::get_if<observation::NodeBipartiteObs>(&observations[i].value());
+		}
+	}
+	return observation::collate<double>(
+		nonstd::span<observation::NodeBipartiteObs const* const>{pointers.data(), pointers.size()});
+}
+
+using VectorBranching =
+	VectorEnvironment<dynamics::BranchingDynamics, BuiltinObservation, BuiltinReward, information::Nothing>;
+
+/**
+ * Return of the reset and step of VectorBranching, as arrays rather than lists.
+ *
+ * Bipartite graph observations are collated, other observations are kept as a list.
+ * Action sets are concatenated, the one of environment ``i`` being in ``[offsets[i], offsets[i+1])``.
+ */
+using StackedBatch = std::tuple<
+	std::variant<observation::NodeBipartiteBatch, Observations>,
+	std::pair<xt::xtensor<std::size_t, 1>, xt::xtensor<std::size_t, 1>>,
+	xt::xtensor<double, 1>,
+	xt::xtensor<bool, 1>,
+	std::vector<VectorBranching::InformationMap>>;
+
+auto stack(VectorBranching& vector_env, VectorBranching::Batch&& batch) -> StackedBatch {
+	auto& [observations, action_sets, rewards, dones, informations] = batch;
+	auto const n_envs = vector_env.size();
+
+	// All environments have copies of the same observation function
+	auto const concatenate =
+		n_envs > 0 && vector_env.environment(0).observation_function().holds<observation::NodeBipartite>();
+	auto stacked_observations = std::variant<observation::NodeBipartiteBatch, Observations>{};
+	if (concatenate) {
+		stacked_observations = collate_node_bipartite(observations);
+	} else {
+		stacked_observations = std::move(observations);
+	}
+
+	auto action_set_offsets = xt::xtensor<std::size_t, 1>::from_shape({n_envs + 1});
+	action_set_offsets[0] = 0;
+	for (std::size_t i = 0; i < n_envs; ++i) {
+		action_set_offsets[i + 1] = action_set_offsets[i] + (action_sets[i].has_value() ? action_sets[i]->size() : 0);
+	}
+	auto action_set_values = xt::xtensor<std::size_t, 1>::from_shape({action_set_offsets[n_envs]});
+	for (std::size_t i = 0; i < n_envs; ++i) {
+		if (action_sets[i].has_value()) {
+			std::copy(action_sets[i]->begin(), action_sets[i]->end(), action_set_values.begin() + action_set_offsets[i]);
+		}
+	}
+
+	auto stacked_rewards = xt::xtensor<double, 1>::from_shape({n_envs});
+	std::copy(rewards.begin(), rewards.end(), stacked_rewards.begin());
+	auto stacked_dones = xt::xtensor<bool, 1>::from_shape({n_envs});
+	std::copy(dones.begin(), dones.end(), stacked_dones.begin());
+
+	return {
+		std::move(stacked_observations),
+		{std::move(action_set_values), std::move(action_set_offsets)},
+		std::move(stacked_rewards),
+		std::move(stacked_dones),
+		std::move(informations)};
+}
+
+/** The actions of VectorBranching, read from an array that only needs to be alive, which the caller guarantees. */
+auto to_actions(Numpy<std::size_t> const& actions) -> std::vector<VectorBranching::Action> {
+	auto vector_actions = std::vector<VectorBranching::Action>(static_cast<std::size_t>(actions.size()));
+	std::transform(actions.data(), actions.data() + actions.size(), vector_actions.begin(), [](auto idx) {
+		return VectorBranching::Action{idx};
+	});
+	return vector_actions;
+}
+
+/**
+ * A copy of the given generator, which must be one of the C++ generators, so that it runs without the GIL.
+ */
+template <typename... Generators>
+auto copy_generator(py::handle generator) -> std::shared_ptr<instance::InstanceGenerator> {
+	auto copy = std::shared_ptr<instance::InstanceGenerator>{};
+	// Try every generator type until one matches
+	auto const try_cast = [&](auto* type_tag) {
+		using Generator = std::remove_pointer_t<decltype(type_tag)>;
+		if (!copy && py::isinstance<Generator>(generator)) {
+			copy = std::make_shared<Generator>(generator.cast<Generator const&>());
+		}
+	};
+	(try_cast(static_cast<Generators*>(nullptr)), ...);
+	if (!copy) {
+		throw std::invalid_argument{"Only the instance generators of Ecole are supported."};
+	}
+	return copy;
+}
+
+void bind_vector_branching(py::module_ const& m) {
+	py::class_<VectorBranching>(m, "VectorBranching", R"(
+		Many :py:class:`Branching` environments stepped concurrently in C++.
+
+		Every call to reset and step releases the GIL once for all environments, and returns arrays stacking the
+		results of every environment.
+		Bipartite graph observations are collated into a :py:class:`~ecole.observation.NodeBipartiteBatch`, other
+		observations are returned as a list.
+		Action sets are returned as a pair of the concatenated action sets and the offsets of every environment.
+		Environments in terminal states are not transitioned anymore until the next reset.
+	)")
+		.def(
+			py::init([](std::size_t n_envs,
+						std::optional<BuiltinObservation::Function> const& observation_function,
+						BuiltinReward::Function const& reward_function,
+						std::map<std::string, scip::Param> const& scip_params,
+						dynamics::BranchingDynamics const& dynamics,
+						std::size_t n_threads) {
+				auto envs = std::vector<VectorBranching::Env>{};
+				envs.reserve(n_envs);
+				for (std::size_t i = 0; i < n_envs; ++i) {
+					envs.emplace_back(
+						BuiltinObservation{observation_function.value_or(observation::Nothing{})},
+						BuiltinReward{reward_function},
+						information::Nothing{},
+						scip_params,
+						dynamics);
+				}
+				return std::make_unique<VectorBranching>(std::move(envs), n_threads);
+			}),
+			py::arg("n_envs"),
+			py::arg("observation_function") = observation::NodeBipartite{},
+			py::arg("reward_function") = reward::IsDone{},
+			py::arg("scip_params") = std::map<std::string, scip::Param>{},
+			py::arg("dynamics") = dynamics::BranchingDynamics{},
+			py::arg("n_threads") = 0,
+			R"(
+			Create identical environments, as :py:class:`Branching`.
+
+			Parameters
+			----------
+				n_envs:
+					The number of environments.
+				n_threads:
+					The number of worker threads, or zero to use one per environment (up to :py:func:`ecole.get_n_threads`).
+		)")
+		.def("seed", &VectorBranching::seed, py::arg("value"), "Seed every environment from a different stream.")
+		.def(
+			"reset",
+			[](VectorBranching& self, std::vector<std::reference_wrapper<scip::Model const>> const& models) {
+				return stack(self, self.reset(models));
+			},
+			py::arg("instances"),
+			py::call_guard<py::gil_scoped_release>(),
+			"Reset every environment on a copy of its model.")
+		.def(
+			"reset",
+			[](VectorBranching& self, std::vector<std::filesystem::path> const& filenames) {
+				auto names = std::vector<std::string>(filenames.size());
+				std::transform(filenames.begin(), filenames.end(), names.begin(), [](auto const& f) { return f.string(); });
+				return stack(self, self.reset(std::move(names)));
+			},
+			py::arg("instances"),
+			py::call_guard<py::gil_scoped_release>(),
+			"Reset every environment on its instance file.")
+		.def(
+			"step",
+			[](VectorBranching& self, Numpy<std::size_t> const& actions) {
+				return stack(self, self.step(to_actions(actions)));
+			},
+			py::arg("actions"),
+			py::call_guard<py::gil_scoped_release>(),
+			R"(
+			Branch on one variable in every environment that is not in a terminal state.
+
+			Parameters
+			----------
+				actions:
+					One variable index per environment, ignored for environments in terminal states.
+		)")
+		.def(
+			"step_or_reset",
+			[](VectorBranching& self,
+			   Numpy<std::size_t> const& actions,
+			   std::vector<std::reference_wrapper<scip::Model const>> const& models) {
+				return stack(self, self.step_or_reset(to_actions(actions), models));
+			},
+			py::arg("actions"),
+			py::arg("instances"),
+			py::call_guard<py::gil_scoped_release>(),
+			R"(
+			Branch in every environment that is not in a terminal state, and reset the others on a copy of a model.
+
+			Parameters
+			----------
+				actions:
+					One variable index per environment, ignored for environments in terminal states.
+				instances:
+					One model per environment in a terminal state, in the order of the environments.
+		)")
+		.def(
+			"step_or_reset",
+			[](VectorBranching& self,
+			   Numpy<std::size_t> const& actions,
+			   std::vector<std::filesystem::path> const& filenames) {
+				auto names = std::vector<std::string>(filenames.size());
+				std::transform(filenames.begin(), filenames.end(), names.begin(), [](auto const& f) { return f.string(); });
+				return stack(self, self.step_or_reset(to_actions(actions), std::move(names)));
+			},
+			py::arg("actions"),
+			py::arg("instances"),
+			py::call_guard<py::gil_scoped_release>(),
+			"Branch in every environment that is not in a terminal state, and reset the others on an instance file.")
+		.def(
+			"set_auto_reset",
+			[](VectorBranching& self, py::handle generator) {
+				auto copy = std::shared_ptr<instance::InstanceGenerator>{};
+				if (!generator.is_none()) {
+					copy = copy_generator<
+						instance::FileGenerator,
+						instance::SetCoverGenerator,
+						instance::CombinatorialAuctionGenerator,
+						instance::CapacitatedFacilityLocationGenerator,
+						instance::IndependentSetGenerator>(generator);
+				}
+				auto const release = py::gil_scoped_release{};
+				self.set_auto_reset(std::move(copy));
+			},
+			py::arg("generator"),
+			R"(
+			Reset environments in the background as soon as they reach a terminal state.
+
+			The next :py:meth:`step` then returns the first transition of the new episode of these
+			environments, as their :py:meth:`reset` would, without waiting for the instance to be presolved
+			and solved up to the first observation.
+			Instances are generated in order of environments, so that a seeded generator gives the same
+			instances to the same environments on every run.
+
+			Parameters
+			----------
+				generator:
+					One of the instance generators of Ecole, which is copied, or ``None`` to stop resetting
+					automatically.
+					Generators written in Python are not supported, since they would need the GIL.
+		)")
+		.def_property_readonly("auto_reset", &VectorBranching::auto_reset)
+		.def(
+			"reset",
+			[](VectorBranching& self) { return stack(self, self.reset()); },
+			py::call_guard<py::gil_scoped_release>(),
+			"Reset every environment on an instance of the generator given to :py:meth:`set_auto_reset`.")
+		.def("__len__", &VectorBranching::size);
+}
+
+/**
+ * Call a function on a thread of Ecole and return an asyncio future of its result.
+ *
+ * The thread only holds the GIL to call the function, and completes the future with the thread-safe callbacks of the
+ * event loop, so that functions releasing the GIL, such as step_dynamics, do not block the loop.
+ */
+auto call_async(py::object loop, py::object function, py::args args, py::kwargs kwargs) -> py::object {
+	auto future = loop.attr("create_future")();
+	// Python objects are copied with the GIL held, and released by the thread with the GIL held as well
+	utility::ThreadCache::global().submit([loop, future, function, args, kwargs]() mutable {
+		auto const gil = py::gil_scoped_acquire{};
+		auto result = py::object{py::none()};
+		auto error = py::object{py::none()};
+		try {
+			result = function(*args, **kwargs);
+		} catch (py::error_already_set const& e) {
+			error = e.value();
+		}
+		auto complete = py::cpp_function([](py::object const& fut, py::object const& res, py::object const& err) {
+			// The future is done if it was cancelled while the function ran
+			if (fut.attr("done")().cast<bool>()) {
+				return;
+			}
+			if (err.is_none()) {
+				fut.attr("set_result")(res);
+			} else {
+				fut.attr("set_exception")(err);
+			}
+		});
+		try {
+			loop.attr("call_soon_threadsafe")(complete, future, result, error);
+		} catch (py::error_already_set const&) {
+			// The loop is closed, so nothing awaits the result anymore
+		}
+		loop.release().dec_ref();
+		future.release().dec_ref();
+		function.release().dec_ref();
+		args.release().dec_ref();
+		kwargs.release().dec_ref();
+	});
+	return future;
+}
+
+}  // namespace
+
+void bind_submodule(py::module_ const& m) {
+	m.doc() = R"(
+		Environments implemented in C++ for the built-in dynamics and data functions.
+
+		Every call to reset and step is a single transition to C++, releasing the GIL once.
+		Only the built-in observation and reward functions (without arithmetic) are accepted.
+	)";
+
+	bind_environment<dynamics::BranchingDynamics>(m, "Branching", observation::NodeBipartite{}, R"(
+		Environment implemented in C++ with :py:class:`~ecole.dynamics.BranchingDynamics`.
+	)")
+		.def(
+			"step",
+			&BuiltinEnvironment<dynamics::BranchingDynamics>::template step<>,
+			py::arg("action"),
+			py::call_guard<py::gil_scoped_release>(),
+			"Branch on the given variable, as :py:meth:`ecole.environment.Environment.step`.");
+
+	bind_environment<dynamics::ConfiguringDynamics>(m, "Configuring", observation::Nothing{}, R"(
+		Environment implemented in C++ with :py:class:`~ecole.dynamics.ConfiguringDynamics`.
+	)")
+		.def(
+			"step",
+			&BuiltinEnvironment<dynamics::ConfiguringDynamics>::template step<>,
+			py::arg("action"),
+			py::call_guard<py::gil_scoped_release>(),
+			"Set the given parameters and solve, as :py:meth:`ecole.environment.Environment.step`.");
+
+	{
+		using Env = BuiltinEnvironment<dynamics::PrimalSearchDynamics>;
+		using idx_t = typename dynamics::PrimalSearchDynamics::Action::first_type::value_type;
+		using val_t = typename dynamics::PrimalSearchDynamics::Action::second_type::value_type;
+		bind_environment<dynamics::PrimalSearchDynamics>(m, "PrimalSearch", observation::NodeBipartite{}, R"(
+			Environment implemented in C++ with :py:class:`~ecole.dynamics.PrimalSearchDynamics`.
+		)")
+			.def(
+				"step",
+				[](Env& self, std::pair<py::object, py::object> const& action) {
+					auto indices = python::ArraySpan<idx_t>{action.first};
+					auto values = python::ArraySpan<val_t>{action.second};
+					// Arrays are released after the GIL is acquired back
+					auto const release = py::gil_scoped_release{};
+					return self.step(dynamics::PrimalSearchDynamics::Action{indices.span(), values.span()});
+				},
+				py::arg("action"),
+				"Try the given partial solution, as :py:meth:`ecole.environment.Environment.step`.");
+	}
+
+	bind_vector_branching(m);
+
+	m.def("call_async", &call_async, py::arg("loop"), py::arg("function"), R"(
+		Call a function on a thread of Ecole and return an :py:class:`asyncio.Future` of its result.
+
+		The future is completed through the thread-safe callbacks of the event loop, which is thus not
+		blocked while the function runs, as long as it releases the GIL.
+		Used by :py:meth:`ecole.environment.Environment.step_async`.
+	)");
+}
+
+}  // namespace ecole::environment
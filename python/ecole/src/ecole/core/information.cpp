@@ -1,7 +1,11 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/stl/filesystem.h>
 
 #include "ecole/information/nothing.hpp"
+#include "ecole/information/performance-counters.hpp"
+#include "ecole/information/search-tree.hpp"
+#include "ecole/information/solver-statistics.hpp"
 #include "ecole/scip/model.hpp"
 
 #include "core.hpp"
@@ -20,6 +24,142 @@ void bind_submodule(py::module_ const& m) {
 		.def(py::init<>())
 		.def("before_reset", &Nothing::before_reset, py::arg("model"), "Do nothing.")
 		.def("extract", &Nothing::extract, py::arg("model"), py::arg("done"), "Return an empty dictionnary.");
+
+	py::class_<SolverStatisticsData>(m, "SolverStatisticsData", "Solver statistics collected in a single pass.")
+		.def_readonly("n_nodes", &SolverStatisticsData::n_nodes)
+		.def_readonly("n_total_nodes", &SolverStatisticsData::n_total_nodes)
+		.def_readonly("n_lp_iterations", &SolverStatisticsData::n_lp_iterations)
+		.def_readonly("n_root_lp_iterations", &SolverStatisticsData::n_root_lp_iterations)
+		.def_readonly("n_primal_lp_iterations", &SolverStatisticsData::n_primal_lp_iterations)
+		.def_readonly("n_dual_lp_iterations", &SolverStatisticsData::n_dual_lp_iterations)
+		.def_readonly("n_barrier_lp_iterations", &SolverStatisticsData::n_barrier_lp_iterations)
+		.def_readonly("n_strong_branching_lp_iterations", &SolverStatisticsData::n_strong_branching_lp_iterations)
+		.def_readonly("n_diving_lp_iterations", &SolverStatisticsData::n_diving_lp_iterations)
+		.def_readonly("n_cuts_found", &SolverStatisticsData::n_cuts_found)
+		.def_readonly("n_cuts_applied", &SolverStatisticsData::n_cuts_applied)
+		.def_readonly("n_separation_rounds", &SolverStatisticsData::n_separation_rounds)
+		.def_readonly("presolving_time", &SolverStatisticsData::presolving_time)
+		.def_readonly("solving_time", &SolverStatisticsData::solving_time)
+		.def_readonly("plugin_times", &SolverStatisticsData::plugin_times);
+
+	py::class_<SolverStatistics>(m, "SolverStatistics", R"(
+		Solver statistics collected in a single pass.
+
+		The statistics are cumulated since the start of the solving process, and are returned in a
+		dictionnary with the names of the attributes of :py:class:`SolverStatisticsData` as keys.
+		Plugin times use keys of the form ``time/<type>/<name>``.
+	)")
+		.def(
+			py::init([](bool nodes, bool lp_iterations, bool cuts, bool separation_rounds, bool times, bool plugin_times) {
+				auto const params =
+					SolverStatistics::Parameters{nodes, lp_iterations, cuts, separation_rounds, times, plugin_times};
+				return SolverStatistics{params};
+			}),
+			py::arg("nodes") = true,
+			py::arg("lp_iterations") = true,
+			py::arg("cuts") = true,
+			py::arg("separation_rounds") = true,
+			py::arg("times") = true,
+			py::arg("plugin_times") = false,
+			R"(
+		Create a SolverStatistics information function.
+
+		Parameters
+		----------
+		nodes :
+			Collect the number of nodes in the current run and in all runs.
+		lp_iterations :
+			Collect the number of LP iterations, in total and by type of LP.
+		cuts :
+			Collect the number of cuts found and applied.
+		separation_rounds :
+			Collect the number of separation rounds.
+		times :
+			Collect the presolving and solving times.
+		plugin_times :
+			Collect the time spent in every heuristic, separator, propagator, presolver, and branching rule.
+		)")
+		.def("before_reset", &SolverStatistics::before_reset, py::arg("model"), "Do nothing.")
+		.def(
+			"extract",
+			&SolverStatistics::extract,
+			py::arg("model"),
+			py::arg("done") = false,
+			"Return the requested statistics in a dictionnary.")
+		.def(
+			"collect",
+			&SolverStatistics::collect,
+			py::arg("model"),
+			"Return the requested statistics, leaving the other ones to zero.");
+
+	py::class_<PerformanceCounters>(m, "PerformanceCounters", R"(
+		Where the time of the episode went, since the environment was reset.
+
+		The information is a dictionnary with the number of yields of the solver (``n_yields``), the
+		number of callbacks answered without yielding (``n_skipped_calls``) or after missing a deadline
+		(``n_missed_deadlines``), and the times in seconds
+		spent solving between yields (``solving_time``), blocked waiting for the solver
+		(``waiting_time``), between a yield and the next resume (``caller_time``), and since the last
+		yield (``time_since_yield``).
+	)")
+		.def(py::init<>())
+		.def("before_reset", &PerformanceCounters::before_reset, py::arg("model"), "Do nothing.")
+		.def(
+			"extract",
+			&PerformanceCounters::extract,
+			py::arg("model"),
+			py::arg("done") = false,
+			"Return the counters in a dictionnary.");
+
+	py::enum_<NodeOutcome>(m, "NodeOutcome", "What happened to a node once solved.")
+		.value("branched", NodeOutcome::branched, "The node was branched on, creating children.")
+		.value("feasible", NodeOutcome::feasible, "The LP solution was feasible, or the node was cut off.")
+		.value("infeasible", NodeOutcome::infeasible, "The node was infeasible.");
+
+	py::class_<SearchTreeRecord>(m, "SearchTreeRecord", "A node of the branch-and-bound tree, as recorded when solved.")
+		.def_readonly("number", &SearchTreeRecord::number)
+		.def_readonly("parent", &SearchTreeRecord::parent)
+		.def_readonly("lower_bound", &SearchTreeRecord::lower_bound)
+		.def_readonly("primal_bound", &SearchTreeRecord::primal_bound)
+		.def_readonly("branching_bound", &SearchTreeRecord::branching_bound)
+		.def_readonly("lp_iterations", &SearchTreeRecord::lp_iterations)
+		.def_readonly("depth", &SearchTreeRecord::depth)
+		.def_readonly("branching_var", &SearchTreeRecord::branching_var)
+		.def_readonly("outcome", &SearchTreeRecord::outcome)
+		.def_readonly("branching_upper", &SearchTreeRecord::branching_upper);
+
+	py::class_<SearchTreeRecorder>(m, "SearchTreeRecorder", R"(
+		Information function streaming the branch-and-bound tree to a file while it is solved.
+
+		An event handler writes a fixed size record for every node solved, when it is branched on or
+		found feasible or infeasible, so that the memory used does not grow with the tree.
+		Nodes pruned before being focused are not recorded.
+		Records of successive episodes are appended, every tree starting with its root, and are read
+		with :py:class:`SearchTreeReader`.
+		The information is the number of records of the episode (``n_records``).
+	)")
+		.def(py::init<std::filesystem::path const&>(), py::arg("filename"))
+		.def(
+			"before_reset",
+			&SearchTreeRecorder::before_reset,
+			py::arg("model"),
+			"Include the event handler recording the tree of the model.")
+		.def(
+			"extract",
+			&SearchTreeRecorder::extract,
+			py::arg("model"),
+			py::arg("done") = false,
+			"Return the number of records of the episode, flushing the file when done.");
+
+	py::class_<SearchTreeReader>(m, "SearchTreeReader", "Random access to the records of a search tree file.")
+		.def(py::init<std::filesystem::path const&>(), py::arg("filename"))
+		.def("__len__", &SearchTreeReader::size)
+		.def("read", &SearchTreeReader::read, py::arg("index"), "Read the record at the given position.")
+		.def(
+			"read_all",
+			&SearchTreeReader::read_all,
+			py::call_guard<py::gil_scoped_release>(),
+			"Read all records, in the order they were written.");
 }
 
 }  // namespace ecole::information
@@ -1,13 +1,28 @@
+#include <cstdint>
+#include <filesystem>
+#include <limits>
 #include <memory>
+#include <optional>
+#include <stdexcept>
+#include <string>
 #include <tuple>
+#include <type_traits>
 
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+#include <pybind11/stl/filesystem.h>
 
+#include "ecole/instance/cache.hpp"
 #include "ecole/instance/capacitated-facility-location.hpp"
 #include "ecole/instance/combinatorial-auction.hpp"
+#include "ecole/instance/dataset.hpp"
 #include "ecole/instance/files.hpp"
+#include "ecole/instance/filtered.hpp"
 #include "ecole/instance/independent-set.hpp"
+#include "ecole/instance/manifest.hpp"
+#include "ecole/instance/prefetching.hpp"
 #include "ecole/instance/set-cover.hpp"
+#include "ecole/instance/sharded.hpp"
 #include "ecole/utility/function-traits.hpp"
 
 #include "core.hpp"
@@ -48,11 +63,21 @@ template <typename PyClass, typename MemberTuple> void def_attributes(PyClass& p
  */
 template <typename PyClass> void def_iterator(PyClass& py_class);
 
+/**
+ * Bind saving and loading the state of the generator as bytes.
+ */
+template <typename PyClass> void def_state(PyClass& py_class);
+
 /**
  * Bind a string constructor for Enums.
  */
 template <typename PyEnum> void def_init_str(PyEnum& py_enum);
 
+/**
+ * A factory copying the given generator, which must be one of the C++ generators.
+ */
+template <typename... Generators> auto make_factory(py::handle generator) -> PrefetchingGenerator::Factory;
+
 void bind_submodule(py::module const& m) {
 	m.doc() = "Random instance generators for Ecole.";
 
@@ -61,6 +86,15 @@ void bind_submodule(py::module const& m) {
 		Member{"directory", &FileGenerator::Parameters::directory},
 		Member{"recursive", &FileGenerator::Parameters::recursive},
 		Member{"sampling_mode", &FileGenerator::Parameters::sampling_mode},
+		Member{"n_prefetch", &FileGenerator::Parameters::n_prefetch},
+		Member{"prefetch_size_limit", &FileGenerator::Parameters::prefetch_size_limit},
+		Member{"cache_max_nonzeros", &FileGenerator::Parameters::cache_max_nonzeros},
+		Member{"snapshot_directory", &FileGenerator::Parameters::snapshot_directory},
+		Member{"manifest", &FileGenerator::Parameters::manifest},
+		Member{"n_buckets", &FileGenerator::Parameters::n_buckets},
+		Member{"bucket_batch_size", &FileGenerator::Parameters::bucket_batch_size},
+		Member{"rank", &FileGenerator::Parameters::rank},
+		Member{"world_size", &FileGenerator::Parameters::world_size},
 	};
 	// Bind FileGenerator and remove intermediate Parameter class
 	auto file_gen = py::class_<FileGenerator>{m, "FileGenerator"};
@@ -91,9 +125,45 @@ void bind_submodule(py::module const& m) {
 					iteration when all files are sampled once;
 				- "remove_and_repeat": Remove every file from the sampling pool right after it is sampled
 					but repeat the procedure (with different order) after all files have been sampled.
+		n_prefetch:
+			The maximum number of files loaded ahead on background threads, or zero to load files on demand.
+			Files are sampled in the same order with and without prefetching.
+		prefetch_size_limit:
+			Stop loading files ahead once their total size in bytes reaches this limit.
+		cache_max_nonzeros:
+			Keep parsed files in an :py:class:`InstanceCache` bounded by this total number of non zeros,
+			or zero to read files every time they are sampled.
+		snapshot_directory:
+			A directory in which to write a binary snapshot of every file the first time it is sampled,
+			read instead of the file afterward, or an empty string to parse files every time.
+			Only problems with linear constraints and default flags, which snapshots reproduce exactly,
+			have one, other files being parsed every time.
+			Worker processes sharing the directory parse every file once.
+			It must not be inside ``directory``.
+		manifest:
+			A manifest listing the files, as written by :py:func:`write_manifest`, read instead of
+			searching ``directory`` if not empty.
+			This avoids listing large directories on slow file systems.
+		n_buckets:
+			Group the files in this many buckets of similar cost, each with the same number of files,
+			or one to sample among all files.
+			The cost of a file is taken from the manifest if it is known for all files, otherwise its
+			number of non zeros if it is known for all files, otherwise its size.
+		bucket_batch_size:
+			The number of consecutive files sampled from the same bucket, for instance the number of
+			environments stepped together, so that they get problems of similar cost.
+			The first file of every batch is sampled among all files, so that every file is still
+			sampled with the same probability.
+		rank:
+			Only sample the files of this shard, such as the rank of a distributed process.
+			Files are sorted by path and dealt to the ``world_size`` shards in turn, so that shards are
+			disjoint and every process only keeps the files of its own shard.
+		world_size:
+			The number of shards in which files are split, or one to sample all files.
 	)");
 	def_attributes(file_gen, file_params);
 	def_iterator(file_gen);
+	def_state(file_gen);
 	file_gen.def("seed", &FileGenerator::seed, py::arg(" seed"));
 
 	// The Set Cover parameters used in constructor, generate_instance, and attributes
@@ -102,6 +172,7 @@ void bind_submodule(py::module const& m) {
 		Member{"n_cols", &SetCoverGenerator::Parameters::n_cols},
 		Member{"density", &SetCoverGenerator::Parameters::density},
 		Member{"max_coef", &SetCoverGenerator::Parameters::max_coef},
+		Member{"named", &SetCoverGenerator::Parameters::named},
 	};
 	// Bind SetCoverGenerator and remove intermediate Parameter class
 	auto set_cover_gen = py::class_<SetCoverGenerator>{m, "SetCoverGenerator"};
@@ -122,6 +193,9 @@ void bind_submodule(py::module const& m) {
 		max_coef:
 			Maximum objective coefficient.
 			The value must be greater than one.
+		named:
+			Whether to name variables and constraints.
+			Anonymous problems use less memory and are faster to generate, but cannot be inspected by names.
 		rng:
 			The random number generator used to peform all sampling.
 
@@ -135,6 +209,7 @@ void bind_submodule(py::module const& m) {
 	def_init(set_cover_gen, set_cover_params);
 	def_attributes(set_cover_gen, set_cover_params);
 	def_iterator(set_cover_gen);
+	def_state(set_cover_gen);
 	set_cover_gen.def("seed", &SetCoverGenerator::seed, py::arg("seed"));
 
 	// The Independent Set parameters used in constructor, generate_instance, and attributes
@@ -143,6 +218,9 @@ void bind_submodule(py::module const& m) {
 		Member{"graph_type", &IndependentSetGenerator::Parameters::graph_type},
 		Member{"edge_probability", &IndependentSetGenerator::Parameters::edge_probability},
 		Member{"affinity", &IndependentSetGenerator::Parameters::affinity},
+		Member{"geometric_skip", &IndependentSetGenerator::Parameters::geometric_skip},
+		Member{"repeated_nodes", &IndependentSetGenerator::Parameters::repeated_nodes},
+		Member{"named", &IndependentSetGenerator::Parameters::named},
 	};
 	// Create class for IndependenSetGenerator
 	auto independent_set_gen = py::class_<IndependentSetGenerator>{m, "IndependentSetGenerator"};
@@ -181,6 +259,20 @@ void bind_submodule(py::module const& m) {
 			The number of nodes each new node will be attached to, in the sampling scheme.
 			This parameter must be an integer >= 1.
 			This parameter will only be used if ``graph_type == "barabasi_albert"``.
+		geometric_skip:
+			Whether to sample Erdos Renyi graphs by skipping a geometric number of node pairs between edges, in time
+			linear in the number of nodes and edges.
+			Otherwise, every pair of nodes is sampled, which reproduces the instances of previous versions.
+			This parameter will only be used if ``graph_type == "erdos_renyi"``.
+		repeated_nodes:
+			Whether to sample the neighbors of every new node of Barabasi Albert graphs among the ends of the
+			edges added so far, in time linear in the number of edges.
+			Otherwise, all previous nodes are weighted by their degree for every new node, which reproduces the
+			instances of previous versions.
+			This parameter will only be used if ``graph_type == "barabasi_albert"``.
+		named:
+			Whether to name variables and constraints.
+			Anonymous problems use less memory and are faster to generate, but cannot be inspected by names.
 		rng:
 			The random number generator used to peform all sampling.
 
@@ -202,6 +294,7 @@ void bind_submodule(py::module const& m) {
 	def_init(independent_set_gen, independent_set_params);
 	def_attributes(independent_set_gen, independent_set_params);
 	def_iterator(independent_set_gen);
+	def_state(independent_set_gen);
 	independent_set_gen.def("seed", &IndependentSetGenerator::seed, py::arg("seed"));
 
 	// The Combinatorial Auction parameters used in constructor, generate_instance, and attributes
@@ -218,6 +311,7 @@ void bind_submodule(py::module const& m) {
 		Member{"resale_factor", &CombinatorialAuctionGenerator::Parameters::resale_factor},
 		Member{"integers", &CombinatorialAuctionGenerator::Parameters::integers},
 		Member{"warnings", &CombinatorialAuctionGenerator::Parameters::warnings},
+		Member{"named", &CombinatorialAuctionGenerator::Parameters::named},
 	};
 	// Bind CombinatorialAuctionGenerator and remove intermediate Parameter class
 	auto combinatorial_auction_gen = py::class_<CombinatorialAuctionGenerator>{m, "CombinatorialAuctionGenerator"};
@@ -257,6 +351,9 @@ void bind_submodule(py::module const& m) {
 			Determines if the bid prices should be integral.
 		warnings:
 			Determines if warnings should be printed when invalid bundles are skipped in instance generation.
+		named:
+			Whether to name variables and constraints.
+			Anonymous problems use less memory and are faster to generate, but cannot be inspected by names.
 		rng:
 			The random number generator used to peform all sampling.
 
@@ -271,6 +368,7 @@ void bind_submodule(py::module const& m) {
 	def_init(combinatorial_auction_gen, combinatorial_auction_params);
 	def_attributes(combinatorial_auction_gen, combinatorial_auction_params);
 	def_iterator(combinatorial_auction_gen);
+	def_state(combinatorial_auction_gen);
 	combinatorial_auction_gen.def("seed", &CombinatorialAuctionGenerator::seed, py::arg("seed"));
 
 	// The Capacitated Facility Location parameters used in constructor, generate_instance, and attributes
@@ -283,6 +381,7 @@ void bind_submodule(py::module const& m) {
 		Member{"capacity_interval", &CapacitatedFacilityLocationGenerator::Parameters::capacity_interval},
 		Member{"fixed_cost_cste_interval", &CapacitatedFacilityLocationGenerator::Parameters::fixed_cost_cste_interval},
 		Member{"fixed_cost_scale_interval", &CapacitatedFacilityLocationGenerator::Parameters::fixed_cost_scale_interval},
+		Member{"named", &CapacitatedFacilityLocationGenerator::Parameters::named},
 	};
 	// Bind CapacitatedFacilityLocationGenerator and remove intermediate Parameter class
 	auto capacitated_facility_location_gen =
@@ -323,6 +422,9 @@ void bind_submodule(py::module const& m) {
 			The second terms in the fixed costs for opening facilities are sampled independently as uniform integers
 			in this interval [lower, upper[ multiplied by the square root of their capacity prior to scaling.
 			This second term reflects the economies of scale.
+		named:
+			Whether to name variables and constraints.
+			Anonymous problems use less memory and are faster to generate, but cannot be inspected by names.
 		rng:
 			The random number generator used to peform all sampling.
 
@@ -336,7 +438,336 @@ void bind_submodule(py::module const& m) {
 	def_init(capacitated_facility_location_gen, capacitated_facility_location_params);
 	def_attributes(capacitated_facility_location_gen, capacitated_facility_location_params);
 	def_iterator(capacitated_facility_location_gen);
+	def_state(capacitated_facility_location_gen);
 	capacitated_facility_location_gen.def("seed", &CapacitatedFacilityLocationGenerator::seed, py::arg(" seed"));
+
+	py::class_<InstanceCache>(m, "InstanceCache", R"(
+		Cache of problem instances read once and copied on every request.
+
+		The cache keeps a pool of parsed models for every instance, so that repeated (and concurrent) requests
+		for the same instance only pay the cost of a copy.
+		Instances are identified by their file name and modification time, so modified files are read again.
+
+		Parameters
+		----------
+		max_nonzeros:
+			The maximum total number of non zeros, that is variables plus constraint coefficients, of the models kept.
+			The least recently used instances are dropped when it is exceeded.
+	)")
+		.def(py::init<std::size_t>(), py::arg("max_nonzeros") = std::numeric_limits<std::size_t>::max())
+		.def(
+			"get",
+			&InstanceCache::get,
+			py::arg("filename"),
+			py::call_guard<py::gil_scoped_release>(),
+			"Return a fresh copy of the instance in the given file.")
+		.def("__len__", &InstanceCache::size)
+		.def("n_templates", &InstanceCache::n_templates, py::arg("filename"))
+		.def("n_nonzeros", &InstanceCache::n_nonzeros)
+		.def("clear", &InstanceCache::clear);
+
+	auto prefetching_gen = py::class_<PrefetchingGenerator>{m, "PrefetchingGenerator", R"(
+		Generate instances ahead of time on background threads.
+
+		Every thread runs its own copy of the given generator, seeded from the random generator of the
+		prefetching generator, and keeps a bounded queue of ready models.
+		Models are taken from the threads in turn, so the sequence of instances only depends on the seed.
+	)"};
+	prefetching_gen
+		.def(
+			py::init([](py::handle generator, std::size_t n_threads, std::size_t queue_size, RandomGenerator const* rng) {
+				auto factory = make_factory<
+					FileGenerator,
+					SetCoverGenerator,
+					CombinatorialAuctionGenerator,
+					CapacitatedFacilityLocationGenerator,
+					IndependentSetGenerator>(generator);
+				if (rng == nullptr) {
+					return std::make_unique<PrefetchingGenerator>(factory, n_threads, queue_size);
+				}
+				return std::make_unique<PrefetchingGenerator>(factory, n_threads, queue_size, *rng);
+			}),
+			py::arg("generator"),
+			py::arg("n_threads") = 2,
+			py::arg("queue_size") = 2,
+			py::arg("rng") = py::none(),
+			R"(
+			Create copies of the generator and start generating instances.
+
+			Parameters
+			----------
+			generator:
+				One of the instance generators of Ecole, copied for every thread.
+				Instance generators written in Python are not supported.
+			n_threads:
+				The number of background threads.
+			queue_size:
+				The maximum number of models prefetched by every thread.
+			rng:
+				The random generator used to seed the generators of every thread.
+		)")
+		.def_property_readonly("n_threads", &PrefetchingGenerator::n_threads)
+		.def("done", &PrefetchingGenerator::done, py::call_guard<py::gil_scoped_release>());
+	def_iterator(prefetching_gen);
+	def_state(prefetching_gen);
+	prefetching_gen.def("seed", &PrefetchingGenerator::seed, py::arg("seed"), py::call_guard<py::gil_scoped_release>());
+
+	auto sharded_gen = py::class_<ShardedGenerator>{m, "ShardedGenerator", R"(
+		Generate the shard of a sequence of instances that belongs to one of many distributed processes.
+
+		The given generator is seeded before every instance, as in :py:func:`write_dataset`, so that
+		instance ``i`` of the whole sequence only depends on the random generator and ``i``.
+		The process of a given rank only generates the instances ``rank``, ``rank + world_size``, and so
+		on, hence shards are disjoint and together form the sequence generated with a world size of one.
+		Files are sharded with the ``rank`` and ``world_size`` parameters of :py:class:`FileGenerator`.
+	)"};
+	sharded_gen
+		.def(
+			py::init([](py::handle generator, std::size_t rank, std::size_t world_size, RandomGenerator const* rng) {
+				auto factory = make_factory<
+					SetCoverGenerator,
+					CombinatorialAuctionGenerator,
+					CapacitatedFacilityLocationGenerator,
+					IndependentSetGenerator>(generator);
+				if (rng == nullptr) {
+					return std::make_unique<ShardedGenerator>(factory(), rank, world_size);
+				}
+				return std::make_unique<ShardedGenerator>(factory(), rank, world_size, *rng);
+			}),
+			py::arg("generator"),
+			py::arg("rank"),
+			py::arg("world_size"),
+			py::arg("rng") = py::none(),
+			R"(
+			Copy the generator to generate the instances of a shard.
+
+			Parameters
+			----------
+			generator:
+				One of the random instance generators of Ecole, copied.
+				Instance generators written in Python are not supported.
+			rank:
+				The shard generated, such as the rank of the distributed process.
+			world_size:
+				The number of shards, such as the number of distributed processes.
+			rng:
+				The random generator from which the seeds of all instances are derived, which must be the
+				same in all processes, for instance by seeding them with the same seed.
+		)")
+		.def_property_readonly("rank", &ShardedGenerator::rank)
+		.def_property_readonly("world_size", &ShardedGenerator::world_size)
+		.def("done", &ShardedGenerator::done);
+	def_iterator(sharded_gen);
+	def_state(sharded_gen);
+	sharded_gen.def("seed", &ShardedGenerator::seed, py::arg("seed"));
+
+	auto filtered_gen = py::class_<FilteredGenerator>{m, "FilteredGenerator", R"(
+		Generate instances of a given difficulty, by probing them on background threads.
+
+		Every thread runs its own copy of the given generator, and probes every instance by presolving it and
+		solving its root node, to only keep those whose probe statistics fall in the given range.
+		Instances solved at the root, or too hard, are discarded while environments are being used.
+		Models are taken from the threads in turn, so the sequence of instances only depends on the seed.
+	)"};
+	filtered_gen
+		.def(
+			py::init([](py::handle generator,
+						bool keep_solved,
+						double min_gap,
+						double max_gap,
+						std::size_t min_lp_iterations,
+						std::size_t max_lp_iterations,
+						double time_limit,
+						std::size_t n_threads,
+						std::size_t queue_size,
+						std::size_t max_rejections,
+						RandomGenerator const* rng) {
+				auto factory = make_factory<
+					FileGenerator,
+					SetCoverGenerator,
+					CombinatorialAuctionGenerator,
+					CapacitatedFacilityLocationGenerator,
+					IndependentSetGenerator>(generator);
+				auto const range =
+					ProbeRange{keep_solved, min_gap, max_gap, min_lp_iterations, max_lp_iterations, time_limit};
+				if (rng == nullptr) {
+					return std::make_unique<FilteredGenerator>(factory, range, n_threads, queue_size, max_rejections);
+				}
+				return std::make_unique<FilteredGenerator>(
+					factory, range, n_threads, queue_size, max_rejections, *rng);
+			}),
+			py::arg("generator"),
+			py::arg("keep_solved") = false,
+			py::arg("min_gap") = 0.,
+			py::arg("max_gap") = std::numeric_limits<double>::infinity(),
+			py::arg("min_lp_iterations") = 0,
+			py::arg("max_lp_iterations") = std::numeric_limits<std::size_t>::max(),
+			py::arg("time_limit") = std::numeric_limits<double>::infinity(),
+			py::arg("n_threads") = 2,
+			py::arg("queue_size") = 2,
+			py::arg("max_rejections") = 1000,
+			py::arg("rng") = py::none(),
+			R"(
+			Create copies of the generator and start generating and probing instances.
+
+			Parameters
+			----------
+			generator:
+				One of the instance generators of Ecole, copied for every thread.
+				Instance generators written in Python are not supported.
+			keep_solved:
+				Whether to keep instances solved at the root node, regardless of the other bounds.
+			min_gap:
+				The minimum relative gap after the root node.
+			max_gap:
+				The maximum relative gap after the root node, infinite without primal solution.
+			min_lp_iterations:
+				The minimum number of LP iterations at the root node.
+			max_lp_iterations:
+				The maximum number of LP iterations at the root node.
+			time_limit:
+				The time limit of every probe, in seconds, which makes the kept instances depend on the
+				speed of the machine.
+			n_threads:
+				The number of background threads.
+			queue_size:
+				The maximum number of kept models prefetched by every thread.
+			max_rejections:
+				The number of consecutive instances a thread rejects before raising an error.
+			rng:
+				The random generator used to seed the generators of every thread.
+		)")
+		.def_property_readonly("n_threads", &FilteredGenerator::n_threads)
+		.def_property_readonly("n_probed", &FilteredGenerator::n_probed)
+		.def_property_readonly("n_rejected", &FilteredGenerator::n_rejected)
+		.def("done", &FilteredGenerator::done, py::call_guard<py::gil_scoped_release>());
+	def_iterator(filtered_gen);
+	def_state(filtered_gen);
+	filtered_gen.def("seed", &FilteredGenerator::seed, py::arg("seed"), py::call_guard<py::gil_scoped_release>());
+
+	m.def(
+		"write_dataset",
+		[](py::handle generator,
+			 std::size_t n_instances,
+			 Seed seed,
+			 std::filesystem::path const& directory,
+			 std::string const& extension,
+			 std::size_t n_threads) {
+			auto factory = make_factory<
+				FileGenerator,
+				SetCoverGenerator,
+				CombinatorialAuctionGenerator,
+				CapacitatedFacilityLocationGenerator,
+				IndependentSetGenerator>(generator);
+			auto const release = py::gil_scoped_release{};
+			return write_dataset(factory, n_instances, seed, directory, extension, n_threads);
+		},
+		py::arg("generator"),
+		py::arg("n_instances"),
+		py::arg("seed"),
+		py::arg("directory"),
+		py::arg("extension") = "mps",
+		py::arg("n_threads") = 0,
+		R"(
+		Generate instances and write them to files on multiple threads.
+
+		Instance ``i`` is generated after seeding a copy of the generator with a seed derived from ``seed`` and ``i``
+		only, so the content of the files does not depend on the number of threads.
+		Files are named ``instance-<i>.<extension>``.
+
+		Parameters
+		----------
+		generator:
+			One of the instance generators of Ecole, copied for every thread.
+			Instance generators written in Python are not supported.
+		n_instances:
+			The number of instances to write.
+		seed:
+			The seed from which the seed of every instance is derived.
+		directory:
+			The directory in which to write the files, created if it does not exist.
+		extension:
+			The extension of the files, from which SCIP deduces the format.
+			For instance ``"mps.gz"`` writes compressed MPS files when SCIP is built with zlib.
+		n_threads:
+			The number of threads, or zero to use :py:func:`ecole.get_n_threads`.
+
+		Returns
+		-------
+		paths:
+			The paths of the files written, in the order of the instances.
+	)");
+
+	py::class_<ManifestEntry>{m, "ManifestEntry", R"(
+		A problem file listed in a manifest.
+
+		The number of non zeros, the fingerprint, and the cost are ``None`` when unknown.
+		The cost is the expected cost of an episode on the problem, such as a solving time measured
+		before, used to sample files of similar cost together in :py:class:`FileGenerator`.
+	)"}
+		.def(
+			py::init<
+				std::filesystem::path,
+				std::uintmax_t,
+				std::optional<std::size_t>,
+				std::optional<std::uint64_t>,
+				std::optional<double>>(),
+			py::arg("path"),
+			py::arg("size") = 0,
+			py::arg("n_nonzeros") = py::none(),
+			py::arg("fingerprint") = py::none(),
+			py::arg("cost") = py::none())
+		.def_readwrite("path", &ManifestEntry::path)
+		.def_readwrite("size", &ManifestEntry::size)
+		.def_readwrite("n_nonzeros", &ManifestEntry::n_nonzeros)
+		.def_readwrite("fingerprint", &ManifestEntry::fingerprint)
+		.def_readwrite("cost", &ManifestEntry::cost);
+
+	m.def(
+		"scan_manifest",
+		&scan_manifest,
+		py::arg("directory"),
+		py::arg("recursive") = true,
+		py::arg("read_problems") = false,
+		py::arg("n_threads") = 0,
+		py::call_guard<py::gil_scoped_release>(),
+		R"(
+		List the problem files of a directory, as :py:class:`FileGenerator` does.
+
+		Parameters
+		----------
+		directory:
+			The directory in which to look for files.
+		recursive:
+			Wether sub-directories are searched as well.
+		read_problems:
+			Whether to read the problems to also know their number of non zeros and fingerprint,
+			which is much slower than only listing the files.
+		n_threads:
+			The number of threads reading problems, or zero to share Ecole's threads
+			(see :py:func:`ecole.set_n_threads`).
+
+		Returns
+		-------
+		entries:
+			A :py:class:`ManifestEntry` per file, sorted by path.
+	)");
+	m.def(
+		"write_manifest",
+		&write_manifest,
+		py::arg("manifest"),
+		py::arg("entries"),
+		py::call_guard<py::gil_scoped_release>(),
+		R"(
+		Write a manifest file, to be read by :py:class:`FileGenerator` instead of listing a directory.
+
+		The manifest is a tab separated text file, with one line per problem file holding its path,
+		size, number of non zeros, fingerprint, and cost.
+		Paths are written relative to the directory of the manifest.
+	)");
+	m.def("read_manifest", &read_manifest, py::arg("manifest"), py::call_guard<py::gil_scoped_release>(), R"(
+		Read a manifest file written by :py:func:`write_manifest`.
+	)");
 }
 
 /******************************************
@@ -443,6 +874,51 @@ template <typename PyClass> void def_iterator(PyClass& py_class) {
 	py_class.def("__next__", &Generator::next, py::call_guard<py::gil_scoped_release>());
 }
 
+template <typename PyClass> void def_state(PyClass& py_class) {
+	// The C++ class being wrapped
+	using Generator = typename PyClass::type;
+	py_class.def(
+		"save_state",
+		[](Generator const& self) {
+			auto state = std::string{};
+			{
+				auto const release = py::gil_scoped_release{};
+				state = self.save_state();
+			}
+			return py::bytes{state};
+		},
+		R"(
+			Save the state of the generator, as bytes.
+
+			Loading the state with :py:meth:`load_state`, on this generator or on a new one with the same
+			parameters, resumes the same sequence of instances, for instance to restart an interrupted job.
+		)");
+	py_class.def(
+		"load_state",
+		[](Generator& self, std::string const& state) {
+			auto const release = py::gil_scoped_release{};
+			self.load_state(state);
+		},
+		py::arg("state"),
+		"Restore a state returned by :py:meth:`save_state`.");
+}
+
+template <typename... Generators> auto make_factory(py::handle generator) -> PrefetchingGenerator::Factory {
+	auto factory = PrefetchingGenerator::Factory{};
+	// Try every generator type until one matches
+	auto const try_cast = [&](auto* type_tag) {
+		using Generator = std::remove_pointer_t<decltype(type_tag)>;
+		if (!factory && py::isinstance<Generator>(generator)) {
+			factory = [copy = generator.cast<Generator>()] { return std::make_unique<Generator>(copy); };
+		}
+	};
+	(try_cast(static_cast<Generators*>(nullptr)), ...);
+	if (!factory) {
+		throw std::invalid_argument{"Only the instance generators of Ecole are supported."};
+	}
+	return factory;
+}
+
 template <typename PyEnum> void def_init_str(PyEnum& py_enum) {
 	// The C++ being wrapped
 	using Enum = typename PyEnum::type;
@@ -0,0 +1,106 @@
+#include <chrono>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "ecole/utility/metrics.hpp"
+
+#include "core.hpp"
+
+namespace ecole::utility::metrics {
+
+namespace py = pybind11;
+
+namespace {
+
+/** Metrics are owned by the registry for the whole process, so Python never deletes them. */
+template <typename Metric> using Holder = std::unique_ptr<Metric, py::nodelete>;
+
+using LabelMap = std::map<std::string, std::string>;
+
+/** Bind a function finding or registering a metric, with labels as a dictionary. */
+template <typename Metric, auto (*Register)(std::string_view, std::string_view, Labels const&)->Metric&>
+void def_registration(py::module_ const& m, char const* name) {
+	m.def(
+		name,
+		[](std::string const& metric_name, std::string const& help, LabelMap const& labels) -> Metric& {
+			return Register(metric_name, help, Labels(labels.begin(), labels.end()));
+		},
+		py::arg("name"),
+		py::arg("help"),
+		py::arg("labels") = LabelMap{},
+		py::return_value_policy::reference,
+		R"(
+			Find or register the metric of the given name and labels.
+
+			The help is only used when the name is first registered.
+
+			Raises
+			------
+			ValueError
+				If the name is invalid, or already registered with another type of metric.
+		)");
+}
+
+}  // namespace
+
+void bind_submodule(py::module_ const& m) {
+	m.doc() = R"(
+		Operational metrics of the process, shared with the C++ library.
+
+		Metrics are registered once for the whole process, and are cheap to update from any thread.
+		They are read with :py:func:`collect`, or exported for Prometheus with :py:func:`to_prometheus`.
+	)";
+
+	py::class_<Counter, Holder<Counter>>(m, "Counter", "A monotonic count of events.")
+		.def("add", &Counter::add, py::arg("n") = 1)
+		.def_property_readonly("value", &Counter::value);
+
+	py::class_<Gauge, Holder<Gauge>>(m, "Gauge", "A value that goes up and down.")
+		.def("add", &Gauge::add, py::arg("delta"))
+		.def("set", &Gauge::set, py::arg("value"))
+		.def_property_readonly("value", &Gauge::value);
+
+	py::class_<Histogram, Holder<Histogram>>(m, "Histogram", "Distribution of durations, in seconds.")
+		.def(
+			"observe",
+			[](Histogram& self, double seconds) {
+				self.observe(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>{seconds}));
+			},
+			py::arg("seconds"))
+		.def_property_readonly("count", &Histogram::count)
+		.def_property_readonly(
+			"sum", [](Histogram const& self) { return std::chrono::duration<double>(self.sum()).count(); });
+
+	def_registration<Counter, &counter>(m, "counter");
+	def_registration<Gauge, &gauge>(m, "gauge");
+	def_registration<Histogram, &histogram>(m, "histogram");
+
+	m.def(
+		"collect",
+		[] {
+			auto samples = std::vector<std::tuple<std::string, LabelMap, double>>{};
+			for (auto& sample : collect()) {
+				auto labels = LabelMap{sample.labels.begin(), sample.labels.end()};
+				samples.emplace_back(std::move(sample.name), std::move(labels), sample.value);
+			}
+			return samples;
+		},
+		R"(
+			Read all the metrics, in the order they were registered.
+
+			Every sample is a tuple of the name, the labels, and the value.
+			Histograms are expanded as in Prometheus, in cumulative ``_bucket`` samples with the ``le``
+			upper bound label, and ``_sum`` and ``_count`` samples, in seconds.
+		)");
+	m.def("to_prometheus", &to_prometheus, "Write all the metrics in the text exposition format of Prometheus.");
+}
+
+}  // namespace ecole::utility::metrics
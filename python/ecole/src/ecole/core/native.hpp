@@ -0,0 +1,78 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+#include <optional>
+#include <unordered_map>
+#include <utility>
+
+#include <pybind11/pybind11.h>
+
+#include "ecole/scip/model.hpp"
+#include "ecole/traits.hpp"
+
+namespace ecole::data {
+
+/**
+ * A data function implemented in C++, held by a Python object, that extracts data without the GIL.
+ *
+ * Bound types are registered when their extract method is bound.
+ * Compositions of data functions defined in Python, such as VectorFunction, unwrap the objects of registered types
+ * so that their functions extract data together with the GIL released, and only the conversion of the data back to
+ * Python needs the GIL.
+ */
+class NativeFunction {
+public:
+	/** Data extracted without the GIL, converted to Python when called with the GIL held. */
+	using Converter = std::function<pybind11::object()>;
+
+	/** Register a bound type of data function whose Python extract returns the data of the C++ one. */
+	template <typename Function> static void register_type(pybind11::handle type) {
+		registry()[reinterpret_cast<PyTypeObject*>(type.ptr())] = {
+			[](pybind11::handle obj) -> void* { return &obj.cast<Function&>(); },
+			[](void* function, scip::Model& model, bool done) -> Converter {
+				using Data = trait::data_of_t<Function>;
+				auto data = std::make_shared<Data>(static_cast<Function*>(function)->extract(model, done));
+				return [data = std::move(data)] { return pybind11::cast(std::move(*data)); };
+			}};
+	}
+
+	/**
+	 * The function held by a Python object, if its type is registered.
+	 *
+	 * Objects of Python subclasses are not unwrapped, since they may override extract.
+	 * The object must outlive the native function.
+	 */
+	static auto from(pybind11::handle obj) -> std::optional<NativeFunction> {
+		auto const& types = registry();
+		auto const iter = types.find(Py_TYPE(obj.ptr()));
+		if (iter == types.end()) {
+			return {};
+		}
+		return NativeFunction{iter->second.get(obj), iter->second.extract};
+	}
+
+	/** Extract data from the function, which does not need the GIL. */
+	auto extract(scip::Model& model, bool done) const -> Converter { return extract_func(function, model, done); }
+
+private:
+	using Extract = auto (*)(void* function, scip::Model& model, bool done) -> Converter;
+
+	struct Type {
+		void* (*get)(pybind11::handle obj);
+		Extract extract;
+	};
+
+	void* function;
+	Extract extract_func;
+
+	NativeFunction(void* function_, Extract extract_) noexcept : function{function_}, extract_func{extract_} {}
+
+	/** The registered types, only modified when binding, with the GIL held. */
+	static auto registry() -> std::unordered_map<PyTypeObject*, Type>& {
+		static auto types = std::unordered_map<PyTypeObject*, Type>{};
+		return types;
+	}
+};
+
+}  // namespace ecole::data
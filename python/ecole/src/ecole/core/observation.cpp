@@ -1,12 +1,27 @@
 #include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
 #include <memory>
+#include <optional>
 #include <string>
+#include <typeinfo>
 #include <utility>
+#include <vector>
 
+#include <pybind11/chrono.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <pybind11/stl/filesystem.h>
 #include <xtensor-python/pytensor.hpp>
 
+#include "ecole/data/history.hpp"
+#include "ecole/data/normalized.hpp"
+#include "ecole/data/pooled.hpp"
+#include "ecole/observation/budgeted-strong-branching-scores.hpp"
+#include "ecole/observation/detailed-strong-branching-scores.hpp"
 #include "ecole/observation/hutter-2011.hpp"
 #include "ecole/observation/khalil-2016.hpp"
 #include "ecole/observation/milp-bipartite.hpp"
@@ -14,11 +29,17 @@
 #include "ecole/observation/nothing.hpp"
 #include "ecole/observation/pseudocosts.hpp"
 #include "ecole/observation/strong-branching-scores.hpp"
+#include "ecole/observation/tree-statistics.hpp"
 #include "ecole/python/auto-class.hpp"
+#include "ecole/python/dlpack.hpp"
 #include "ecole/scip/model.hpp"
+#include "ecole/utility/metrics.hpp"
+#include "ecole/utility/recycle-pool.hpp"
 #include "ecole/utility/sparse-matrix.hpp"
+#include "ecole/utility/thread-pool.hpp"
 
 #include "core.hpp"
+#include "native.hpp"
 
 namespace ecole::observation {
 
@@ -38,11 +59,24 @@ template <typename PyClass, typename... Args> auto def_before_reset(PyClass pycl
 
 /**
  * Helper function to bind the `extract` method of observation functions.
+ *
+ * Observations are returned by value, hence moved into Python objects.
+ * Returned tensors become numpy arrays owning the moved xtensor storage, without copy.
+ * Extractions are timed in the same metric as in the C++ environments.
  */
 template <typename PyClass, typename... Args> auto def_extract(PyClass pyclass, Args&&... args) {
+	data::NativeFunction::register_type<typename PyClass::type>(pyclass);
+	using Function = typename PyClass::type;
 	return pyclass.def(
 		"extract",
-		&PyClass::type::extract,
+		[](Function& self, scip::Model& model, bool done) {
+			static auto& duration = utility::metrics::histogram(
+				"ecole_observation_extract_seconds",
+				"Time spent extracting observations.",
+				{{"function", utility::metrics::type_label(typeid(Function))}});
+			auto const timer = utility::metrics::ScopedTimer{duration};
+			return self.extract(model, done);
+		},
 		py::arg("model"),
 		py::arg("done"),
 		py::call_guard<py::gil_scoped_release>(),
@@ -50,17 +84,214 @@ template <typename PyClass, typename... Args> auto def_extract(PyClass pyclass,
 }
 
 /**
- * Observation module bindings definitions.
+ * Wrap a tensor in a numpy array without copy.
+ *
+ * The tensor is released to the pool when the array is garbage collected.
  */
-void bind_submodule(py::module_ const& m) {
-	m.doc() = "Observation classes for Ecole.";
+template <typename Tensor>
+auto make_pooled_array(Tensor&& tensor, std::shared_ptr<utility::RecyclePool<Tensor>> pool) -> py::array {
+	struct Owner {
+		Tensor tensor;
+		std::shared_ptr<utility::RecyclePool<Tensor>> pool;
+		Owner(Tensor&& tensor_, std::shared_ptr<utility::RecyclePool<Tensor>> pool_) :
+			tensor{std::move(tensor_)}, pool{std::move(pool_)} {}
+		Owner(Owner const&) = delete;
+		Owner(Owner&&) = delete;
+		auto operator=(Owner const&) -> Owner& = delete;
+		auto operator=(Owner&&) -> Owner& = delete;
+		~Owner() { pool->release(std::move(tensor)); }
+	};
+	auto owner = std::unique_ptr<Owner>{new Owner{std::move(tensor), std::move(pool)}};
+	auto const capsule = py::capsule{owner.get(), [](void* ptr) { delete static_cast<Owner*>(ptr); }};
+	auto& owned = owner.release()->tensor;
+	auto const shape = std::vector<py::ssize_t>(owned.shape().begin(), owned.shape().end());
+	return py::array_t<typename Tensor::value_type>{shape, owned.data(), capsule};
+}
 
-	xt::import_numpy();
+/**
+ * Bind an observation function returning tensors recycled from a pool.
+ *
+ * Arrays returned in Python give their memory back to the pool when garbage collected.
+ */
+template <typename Func>
+auto bind_pooled(py::module_ const& m, char const* name, char const* doc) -> py::class_<data::PooledFunction<Func>> {
+	using Pooled = data::PooledFunction<Func>;
+	auto pooled = py::class_<Pooled>(m, name, doc);
+	def_before_reset(pooled, R"(Reset the wrapped observation function.)");
+	pooled.def(
+		"extract",
+		[](Pooled& self, scip::Model& model, bool done) -> py::object {
+			auto obs = [&] {
+				auto const release = py::gil_scoped_release{};
+				return self.extract(model, done);
+			}();
+			if (!obs.has_value()) {
+				return py::none();
+			}
+			return make_pooled_array(std::move(obs).value(), self.pool());
+		},
+		py::arg("model"),
+		py::arg("done"),
+		"Extract an observation in an array recycled from the pool.");
+	return pooled;
+}
 
-	m.attr("Nothing") = py::type::of<Nothing>();
+/**
+ * Bind an observation function normalizing the features of another one with running statistics.
+ */
+template <typename Func> void bind_normalized(py::module_ const& m, char const* name, char const* doc) {
+	using Normalized = data::NormalizedFunction<Func>;
+	auto normalized = py::class_<Normalized>(m, name, doc);
+	normalized
+		.def(
+			py::init<Func, double, bool>(),
+			py::arg("function") = Func{},
+			py::arg("epsilon") = Normalized::default_epsilon,
+			py::arg("frozen") = false,
+			R"(
+			Wrap a copy of the observation function.
+
+			Parameters
+			----------
+			function:
+				The observation function whose features are normalized.
+			epsilon:
+				Added to the variance of every feature before dividing by its standard deviation.
+			frozen:
+				Whether to normalize without updating the statistics, for instance once they are loaded for
+				inference.
+		)")
+		.def("freeze", &Normalized::freeze, py::arg("frozen") = true, "Stop or resume updating the statistics.")
+		.def_property_readonly("frozen", &Normalized::frozen)
+		.def_property(
+			"statistics",
+			&Normalized::get_statistics,
+			&Normalized::set_statistics,
+			"The :py:class:`FeatureStatistics` of every feature matrix, empty before extracting.")
+		.def(
+			"merge_statistics",
+			&Normalized::merge_statistics,
+			py::arg("statistics"),
+			"Add the statistics of another function, such as a copy used in another process.")
+		.def(
+			"save_statistics",
+			[](Normalized const& self) { return py::bytes{self.save_statistics()}; },
+			"Return the statistics as bytes.")
+		.def(
+			"load_statistics",
+			[](Normalized& self, py::bytes const& data) { self.load_statistics(std::string{data}); },
+			py::arg("data"),
+			"Restore statistics returned by :py:meth:`save_statistics`.");
+	def_before_reset(normalized, "Reset the wrapped observation function, keeping the statistics.");
+	def_extract(normalized, "Extract an observation and normalize its features.");
+}
+
+/**
+ * Bind an observation function returning the last observations of another one, along with the type of its histories.
+ *
+ * Observations in a history are references to those kept by the function, which are not copied.
+ */
+template <typename Func>
+void bind_history(py::module_ const& m, char const* name, char const* history_name, char const* doc) {
+	using HistoryFunc = data::HistoryFunction<Func>;
+	using Data = typename HistoryFunc::Data;
+	using History = data::History<Data>;
+	py::class_<History>(m, history_name, R"(
+		The last observations of an episode, from the oldest to the most recent.
+
+		Observations are shared between histories and with the observation function that returned them.
+		Modifying them in place thus modifies them in all histories, unless they are copied first.
+	)")
+		.def("__len__", &History::size)
+		.def(
+			"__getitem__",
+			[](History const& self, py::ssize_t index) -> Data const& {
+				auto const size = static_cast<py::ssize_t>(self.size());
+				if (index < 0) {
+					index += size;
+				}
+				if (index < 0 || index >= size) {
+					throw py::index_error{"History index out of range."};
+				}
+				return self[static_cast<std::size_t>(index)];
+			},
+			py::arg("index"),
+			py::return_value_policy::reference_internal)
+		.def("__copy__", [](History const& self) { return self; })
+		.def(
+			"__deepcopy__",
+			[](History const& self, py::dict const& /*memo*/) {
+				auto items = std::vector<typename History::Item>{};
+				items.reserve(self.size());
+				for (auto const& item : self.items()) {
+					items.push_back(std::make_shared<Data const>(*item));
+				}
+				return History{std::move(items)};
+			},
+			py::arg("memo"))
+		.def(py::pickle(
+			[](History const& self) {
+				auto observations = py::list{};
+				for (auto const& item : self.items()) {
+					observations.append(py::cast(*item));
+				}
+				return observations;
+			},
+			[](py::list const& observations) {
+				auto items = std::vector<typename History::Item>{};
+				items.reserve(observations.size());
+				for (auto const& obs : observations) {
+					items.push_back(std::make_shared<Data const>(obs.cast<Data>()));
+				}
+				return History{std::move(items)};
+			}));
+
+	auto history = py::class_<HistoryFunc>(m, name, doc);
+	history
+		.def(
+			py::init<Func, std::size_t, bool>(),
+			py::arg("function") = Func{},
+			py::arg("length") = 1,
+			py::arg("pad") = false,
+			R"(
+			Wrap a copy of the observation function.
+
+			Parameters
+			----------
+			function:
+				The observation function whose observations are kept.
+			length:
+				The maximum number of observations in a history.
+			pad:
+				Whether the first observation of the episode is repeated so that histories always have the
+				given length.
+		)")
+		.def_property_readonly("length", &HistoryFunc::length)
+		.def_property_readonly("padded", &HistoryFunc::padded)
+		.def("history", &HistoryFunc::history, "The last observations of the episode, without extracting.");
+	def_before_reset(history, "Clear the history and reset the wrapped observation function.");
+	def_extract(history, "Extract an observation and return the history ending with it.");
+}
+
+/**
+ * The pool used by sparse matrix operations when called with ``parallel=True``, or null otherwise.
+ */
+auto sparse_thread_pool(bool parallel) -> utility::ThreadPool* {
+	if (!parallel) {
+		return nullptr;
+	}
+	static auto pool = utility::ThreadPool{};
+	return &pool;
+}
 
-	using coo_matrix = decltype(NodeBipartiteObs::edge_features);
-	ecole::python::auto_class<coo_matrix>(m, "coo_matrix", R"(
+/**
+ * Bind the sparse matrices used in observations with the given value type.
+ */
+template <typename Value> void bind_sparse_matrices(py::module_ const& m, char const* coo_name, char const* csr_name) {
+	using coo_matrix = utility::coo_matrix<Value>;
+	using csr_matrix = utility::csr_matrix<Value, std::int32_t>;
+	using Indices = std::vector<std::size_t>;
+	ecole::python::auto_class<coo_matrix>(m, coo_name, R"(
 		Sparse matrix in the coordinate format.
 
 		Similar to Scipy's ``scipy.sparse.coo_matrix`` or PyTorch ``torch.sparse``.
@@ -75,11 +306,108 @@ void bind_submodule(py::module_ const& m) {
 			dimension in the sparse matrix.
 		)")
 		.def_readwrite("shape", &coo_matrix::shape, "The dimension of the sparse matrix, as if it was dense.")
-		.def_property_readonly("nnz", &coo_matrix::nnz);
+		.def_property_readonly("nnz", &coo_matrix::nnz)
+		.def(
+			"to_csr",
+			[](coo_matrix const& self, bool parallel) {
+				return self.template to_csr<std::int32_t>(sparse_thread_pool(parallel));
+			},
+			py::arg("parallel") = false,
+			py::call_guard<py::gil_scoped_release>(),
+			R"(
+			Convert to the compressed sparse row format, in linear time.
 
-	// Node bipartite observation
-	auto node_bipartite_obs =
-		ecole::python::auto_class<NodeBipartiteObs>(m, "NodeBipartiteObs", R"(
+			Elements of a row keep their order.
+			With ``parallel``, large matrices are converted on a thread pool.
+		)")
+		.def(
+			"to_csc",
+			[](coo_matrix const& self, bool parallel) {
+				return self.template to_csc<std::int32_t>(sparse_thread_pool(parallel));
+			},
+			py::arg("parallel") = false,
+			py::call_guard<py::gil_scoped_release>(),
+			R"(
+			Convert to the compressed sparse column format, in linear time.
+
+			The result is the compressed sparse row matrix of the transpose, that is ``row_pointers`` index columns,
+			and ``column_indices`` hold row indices.
+		)")
+		.def("transpose", &coo_matrix::transpose, py::call_guard<py::gil_scoped_release>())
+		.def(
+			"sum_duplicates",
+			[](coo_matrix const& self, bool parallel) { return self.sum_duplicates(sparse_thread_pool(parallel)); },
+			py::arg("parallel") = false,
+			py::call_guard<py::gil_scoped_release>(),
+			"Sort elements by row then column, and sum the values of elements with the same indices.")
+		.def(
+			"select_rows",
+			[](coo_matrix const& self, Indices const& rows) { return self.select_rows(rows); },
+			py::arg("rows"),
+			py::call_guard<py::gil_scoped_release>(),
+			"Keep the elements of the given rows, renumbered by their position in ``rows``.")
+		.def(
+			"select_cols",
+			[](coo_matrix const& self, Indices const& cols) { return self.select_cols(cols); },
+			py::arg("cols"),
+			py::call_guard<py::gil_scoped_release>(),
+			"Keep the elements of the given columns, renumbered by their position in ``cols``.");
+
+	ecole::python::auto_class<csr_matrix>(m, csr_name, R"(
+		Sparse matrix in the compressed sparse row format.
+
+		Similar to Scipy's ``scipy.sparse.csr_matrix``, which can be built with
+		``csr_matrix((values, column_indices, row_pointers), shape)``.
+	)")
+		.def_auto_copy()
+		.def_auto_pickle("values", "column_indices", "row_pointers", "shape")
+		.def_readwrite_xtensor("values", &csr_matrix::values, "A vector of non zero values in the matrix")
+		.def_readwrite_xtensor(
+			"column_indices", &csr_matrix::column_indices, "A vector of the column index of every non zero value.")
+		.def_readwrite_xtensor("row_pointers", &csr_matrix::row_pointers, R"(
+			A vector with one more element than there are rows in the matrix.
+
+			The column indices and values of row ``i`` are in the range ``[row_pointers[i], row_pointers[i+1])``.
+		)")
+		.def_readwrite("shape", &csr_matrix::shape, "The dimension of the sparse matrix, as if it was dense.")
+		.def_property_readonly("nnz", &csr_matrix::nnz)
+		.def("to_coo", &csr_matrix::to_coo, py::call_guard<py::gil_scoped_release>())
+		.def(
+			"transpose",
+			[](csr_matrix const& self, bool parallel) { return self.transpose(sparse_thread_pool(parallel)); },
+			py::arg("parallel") = false,
+			py::call_guard<py::gil_scoped_release>(),
+			R"(
+			Transpose the matrix, in linear time.
+
+			This is also the conversion to the compressed sparse column format.
+			The column indices of every row of the result are sorted.
+		)")
+		.def(
+			"sum_duplicates",
+			[](csr_matrix const& self, bool parallel) { return self.sum_duplicates(sparse_thread_pool(parallel)); },
+			py::arg("parallel") = false,
+			py::call_guard<py::gil_scoped_release>(),
+			"Sort the column indices of every row, and sum the values of elements with the same indices.")
+		.def(
+			"select_rows",
+			[](csr_matrix const& self, Indices const& rows) { return self.select_rows(rows); },
+			py::arg("rows"),
+			py::call_guard<py::gil_scoped_release>(),
+			"Keep the given rows, renumbered by their position in ``rows``.")
+		.def(
+			"select_cols",
+			[](csr_matrix const& self, Indices const& cols) { return self.select_cols(cols); },
+			py::arg("cols"),
+			py::call_guard<py::gil_scoped_release>(),
+			"Keep the elements of the given columns, renumbered by their position in ``cols``.");
+}
+
+/**
+ * Bind a NodeBipartite observation with the given value type.
+ */
+template <typename Obs> auto bind_node_bipartite_obs(py::module_ const& m, char const* name) {
+	return ecole::python::auto_class<Obs>(m, name, R"(
 		Bipartite graph observation for branch-and-bound nodes.
 
 		The optimization problem is represented as an heterogenous bipartite graph.
@@ -91,9 +419,17 @@ void bind_submodule(py::module_ const& m) {
 		Each variable and constraint node is associated with a vector of features.
 		Each edge is associated with the coefficient of the variable in the constraint.
 	)")
+			.def(py::init<>(), "Create an empty observation, for instance to apply deltas to.")
 			.def_auto_copy()
-			.def_auto_pickle("variable_features", "row_features", "edge_features")
-			.def_readwrite_xtensor("variable_features", &NodeBipartiteObs::variable_features, R"rst(
+			.def_auto_pickle(
+				"variable_features",
+				"row_features",
+				"edge_features",
+				"edge_features_csr",
+				"edge_features_csc",
+				"variable_ids",
+				"row_ids")
+			.def_readwrite_xtensor("variable_features", &Obs::variable_features, R"rst(
 					A matrix where each row represents a variable, and each column a feature of the variable.
 
 					Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
@@ -101,13 +437,327 @@ void bind_submodule(py::module_ const& m) {
 				)rst")
 			.def_readwrite_xtensor(
 				"row_features",
-				&NodeBipartiteObs::row_features,
+				&Obs::row_features,
 				"A matrix where each row is represents a constraint, and each column a feature of the constraints.")
 			.def_readwrite(
 				"edge_features",
-				&NodeBipartiteObs::edge_features,
+				&Obs::edge_features,
 				"The constraint matrix of the optimization problem, with rows for contraints and "
-				"columns for variables.");
+				"columns for variables.")
+			.def_readwrite(
+				"edge_features_csr",
+				&Obs::edge_features_csr,
+				"The same constraint matrix as ``edge_features`` in the CSR format, only when requested in "
+				":py:class:`NodeBipartite`.")
+			.def_readwrite(
+				"edge_features_csc",
+				&Obs::edge_features_csc,
+				"The edges sorted by variable, in the CSR format of the transposed constraint matrix, only when "
+				"requested in :py:class:`NodeBipartite`.")
+			.def_readwrite_xtensor(
+				"variable_ids",
+				&Obs::variable_ids,
+				"The original index of every variable of a subgraph around branching candidates, empty for the "
+				"whole graph.")
+			.def_readwrite_xtensor(
+				"row_ids",
+				&Obs::row_ids,
+				"The original index of every row of a subgraph around branching candidates, empty for the whole graph.");
+}
+
+/**
+ * Bind a NodeBipartite observation function with the given value type.
+ */
+template <typename Func> void bind_node_bipartite(py::module_ const& m, char const* name, char const* doc) {
+	auto node_bipartite = py::class_<Func>(m, name, doc);
+	node_bipartite.def(
+		py::init<bool, bool, bool, std::size_t, bool>(),
+		py::arg("cache") = false,
+		py::arg("incremental") = false,
+		py::arg("csr_edges") = false,
+		py::arg("candidate_hops") = 0,
+		py::arg("csc_edges") = false,
+		R"(
+		Constructor for NodeBipartite.
+
+		Parameters
+		----------
+		cache :
+			Whether or not to cache static features within an episode.
+			Static row features are cached for every LP row, identified by its SCIP index, so that only
+			new cuts or modified rows get them recomputed.
+			This is safe with cutting planes.
+		incremental :
+			Whether to track changes in the LP rows with SCIP events, so that static row features and edges are
+			only recomputed for rows that changed since the previous extraction.
+			This is safe with cutting planes and takes precedence over ``cache``.
+		csr_edges :
+			Whether to extract edges in ``edge_features_csr``, in the CSR format with 32 bits indices, instead of
+			``edge_features``.
+		candidate_hops :
+			Restrict the graph to the subgraph induced by the LP branching candidates and the rows they appear in
+			(1), and further to the other variables of these rows (2).
+			The original indices of the kept variables and rows are given in ``variable_ids`` and ``row_ids``.
+			The default (0) extracts the whole graph.
+		csc_edges :
+			Whether to also extract edges sorted by variable in ``edge_features_csc``, with 32 bits indices.
+			Its ``row_pointers`` are the offsets of the edges of every variable, and its ``column_indices`` their
+			row, so that messages to variables can be aggregated by segments without sorting edges.
+	)");
+	def_before_reset(node_bipartite, "Cache some feature not expected to change during an episode.");
+	def_extract(node_bipartite, "Extract a new bipartite graph observation.");
+}
+
+/**
+ * Bind a batch of NodeBipartite observations, and the function collating them, with the given value type.
+ */
+template <typename Value> void bind_node_bipartite_batch(py::module_ m, char const* name) {
+	using Batch = BasicNodeBipartiteBatch<Value>;
+	ecole::python::auto_class<Batch>(m, name, R"(
+		Bipartite graph observations concatenated into a single graph, as returned by :py:func:`collate`.
+
+		The variables, rows, and edges of observation ``i`` are in the ranges given by consecutive elements of the
+		offsets, and the batch vectors give the observation of every variable and row.
+	)")
+		.def_auto_copy()
+		.def_readwrite_xtensor("variable_features", &Batch::variable_features, "The concatenated variable features.")
+		.def_readwrite_xtensor("row_features", &Batch::row_features, "The concatenated row features.")
+		.def_readwrite(
+			"edge_features",
+			&Batch::edge_features,
+			"The edges of all observations, with indices shifted to the concatenated rows and variables.")
+		.def_readwrite_xtensor("variable_batch", &Batch::variable_batch, "The observation index of every variable.")
+		.def_readwrite_xtensor("row_batch", &Batch::row_batch, "The observation index of every row.")
+		.def_readwrite_xtensor("variable_offsets", &Batch::variable_offsets)
+		.def_readwrite_xtensor("row_offsets", &Batch::row_offsets)
+		.def_readwrite_xtensor("edge_offsets", &Batch::edge_offsets);
+
+	m.def(
+		"collate",
+		[](std::vector<BasicNodeBipartiteObs<Value> const*> const& observations) {
+			return collate<Value>(
+				nonstd::span<BasicNodeBipartiteObs<Value> const* const>{observations.data(), observations.size()});
+		},
+		py::arg("observations"),
+		py::call_guard<py::gil_scoped_release>(),
+		R"(
+		Concatenate bipartite graph observations into a single graph, without copying them to C++ first.
+
+		Edges extracted in the CSR format are written in the coordinate format.
+		The GIL is released while collating.
+	)");
+}
+
+/**
+ * Bind a NodeBipartite delta, the function extracting it, and the function applying it, with the given value type.
+ */
+template <typename Value> void bind_node_bipartite_delta(py::module_ m, char const* delta_name, char const* func_name) {
+	using Delta = BasicNodeBipartiteDelta<Value>;
+	using Func = BasicDeltaNodeBipartite<Value>;
+	ecole::python::auto_class<Delta>(m, delta_name, R"(
+		Changes of a bipartite graph observation from the previous one, as extracted by :py:class:`DeltaNodeBipartite`.
+
+		Variables and rows are identified by their position in the observation.
+		Rows beyond ``n_rows`` are removed, and added rows have their features and edges in the delta.
+	)")
+		.def_auto_copy()
+		.def_auto_pickle(
+			"n_variables",
+			"n_rows",
+			"variable_indices",
+			"variable_features",
+			"row_indices",
+			"row_features",
+			"edge_row_indices",
+			"edge_features")
+		.def_readwrite("n_variables", &Delta::n_variables, "The number of variables once the delta is applied.")
+		.def_readwrite("n_rows", &Delta::n_rows, "The number of rows once the delta is applied.")
+		.def_readwrite_xtensor("variable_indices", &Delta::variable_indices, "The variables whose features changed.")
+		.def_readwrite_xtensor("variable_features", &Delta::variable_features, "The new features of these variables.")
+		.def_readwrite_xtensor("row_indices", &Delta::row_indices, "The rows whose features changed.")
+		.def_readwrite_xtensor("row_features", &Delta::row_features, "The new features of these rows.")
+		.def_readwrite_xtensor("edge_row_indices", &Delta::edge_row_indices, "The rows whose edges changed.")
+		.def_readwrite(
+			"edge_features",
+			&Delta::edge_features,
+			"The new edges of the rows of ``edge_row_indices``, with one row of the matrix per changed row.");
+
+	auto delta_func = py::class_<Func>(m, func_name, R"(
+		Observation function extracting the changes of the bipartite graph since the previous extraction.
+
+		Deltas are much smaller than observations between consecutive nodes of a dive, which matters when
+		storing them or sending them over the network.
+		The first delta of an episode is relative to an empty observation, and observations are recovered by
+		applying the deltas in order with :py:func:`apply_delta`.
+	)");
+	delta_func.def(
+		py::init<bool, bool>(),
+		py::arg("cache") = false,
+		py::arg("incremental") = false,
+		"Constructor for DeltaNodeBipartite, with the same parameters as :py:class:`NodeBipartite`.");
+	def_before_reset(delta_func, "Forget the previous observation.");
+	def_extract(delta_func, "Extract the changes of the bipartite graph since the previous extraction.");
+
+	m.def(
+		"apply_delta",
+		&apply_delta<Value>,
+		py::arg("observation"),
+		py::arg("delta"),
+		py::call_guard<py::gil_scoped_release>(),
+		R"(
+		Apply a delta, in place, to the observation it was extracted after.
+
+		Edges are written in ``edge_features_csr`` only, as with ``NodeBipartite(csr_edges=True)``.
+		An empty observation is given to apply the first delta of an episode.
+	)");
+}
+
+/**
+ * Bind a compact NodeBipartite observation and the function extracting it, with the given value type.
+ */
+template <typename Value>
+auto bind_node_bipartite_compact(py::module_ const& m, char const* obs_name, char const* func_name) {
+	using Obs = BasicNodeBipartiteCompactObs<Value>;
+	using Func = BasicCompactNodeBipartite<Value>;
+	auto obs = ecole::python::auto_class<Obs>(m, obs_name, R"(
+		Bipartite graph observation with categorical variable features stored as ``numpy.uint8`` codes.
+
+		The one hot encoded variable types and basis statuses are each stored as the position of the one in
+		their encoding, and boolean features as zero or one.
+		Row features and edges are those of :py:class:`NodeBipartiteObs`.
+	)");
+	obs.def_auto_copy()
+		.def_auto_pickle("variable_features", "variable_categories", "row_features", "edge_features", "edge_features_csr")
+		.def_readwrite_xtensor(
+			"variable_features",
+			&Obs::variable_features,
+			"A matrix of the continuous features of every variable, described by ``ContinuousVariableFeatures``.")
+		.def_readwrite_xtensor(
+			"variable_categories",
+			&Obs::variable_categories,
+			"A matrix of the categorical features of every variable, described by ``CategoricalVariableFeatures``.")
+		.def_readwrite_xtensor("row_features", &Obs::row_features, "The row features of :py:class:`NodeBipartiteObs`.")
+		.def_readwrite("edge_features", &Obs::edge_features, "The edges in the coordinate format.")
+		.def_readwrite("edge_features_csr", &Obs::edge_features_csr, "The edges in the CSR format, when requested.");
+
+	auto func = py::class_<Func>(m, func_name, R"(
+		Bipartite graph observation function extracting categorical variable features as codes.
+
+		Single precision observations take about a quarter of the memory per variable of a
+		:py:class:`NodeBipartiteObs`, which matters when storing many nodes, such as in replay buffers.
+	)");
+	func.def(
+		py::init<bool, bool, bool>(),
+		py::arg("cache") = false,
+		py::arg("incremental") = false,
+		py::arg("csr_edges") = false,
+		"Constructor for CompactNodeBipartite, with the same parameters as :py:class:`NodeBipartite`.");
+	def_before_reset(func, "Cache some feature not expected to change during an episode.");
+	def_extract(func, "Extract a new compact bipartite graph observation.");
+	return obs;
+}
+
+/**
+ * Bind a MilpBipartite observation with the given value type.
+ */
+template <typename Obs> auto bind_milp_bipartite_obs(py::module_ const& m, char const* name) {
+	return ecole::python::auto_class<Obs>(m, name, R"(
+		Bipartite graph observation that represents the most recent MILP during presolving.
+
+		The optimization problem is represented as an heterogenous bipartite graph.
+		On one side, a node is associated with one variable, on the other side a node is
+		associated with one constraint.
+		There exist an edge between a variable and a constraint if the variable exists in the
+		constraint with a non-zero coefficient.
+
+		Each variable and constraint node is associated with a vector of features.
+		Each edge is associated with the coefficient of the variable in the constraint.
+	)")
+			.def_auto_copy()
+			.def_auto_pickle(
+				"variable_features", "constraint_features", "edge_features", "edge_features_csr", "edge_features_csc")
+			.def_readwrite_xtensor("variable_features", &Obs::variable_features, R"rst(
+					A matrix where each row represents a variable, and each column a feature of the variable.
+
+					Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
+					hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
+				)rst")
+			.def_readwrite_xtensor(
+				"constraint_features",
+				&Obs::constraint_features,
+				"A matrix where each row is represents a constraint, and each column a feature of the constraints.")
+			.def_readwrite(
+				"edge_features",
+				&Obs::edge_features,
+				"The constraint matrix of the optimization problem, with rows for contraints and columns for variables.")
+			.def_readwrite(
+				"edge_features_csr",
+				&Obs::edge_features_csr,
+				"The same constraint matrix in the CSR format, only when requested in :py:class:`MilpBipartite`.")
+			.def_readwrite(
+				"edge_features_csc",
+				&Obs::edge_features_csc,
+				"The edges sorted by variable, in the CSR format of the transposed constraint matrix, only when "
+				"requested in :py:class:`MilpBipartite`.");
+}
+
+/**
+ * Bind a MilpBipartite observation function with the given value type.
+ */
+template <typename Func> void bind_milp_bipartite(py::module_ const& m, char const* name, char const* doc) {
+	auto milp_bipartite = py::class_<Func>(m, name, doc);
+	milp_bipartite.def(
+		py::init<bool, std::size_t, bool, bool>(),
+		py::arg("normalize") = false,
+		py::arg("n_threads") = 1,
+		py::arg("csr_edges") = false,
+		py::arg("csc_edges") = false,
+		R"(
+		Constructor for MilpBipartite.
+
+		Parameters
+		----------
+		normalize :
+			Should the features be normalized?
+			This is recommended for some application such as deep learning models.
+		n_threads :
+			The number of threads reading the constraints, or zero to share Ecole's threads
+			(see :py:func:`ecole.set_n_threads`).
+			The observation does not depend on the number of threads.
+		csr_edges :
+			Whether to extract edges in ``edge_features_csr``, in the CSR format with 32 bits indices, instead of
+			``edge_features``.
+		csc_edges :
+			Whether to also extract edges sorted by variable in ``edge_features_csc``, with 32 bits indices.
+	)");
+	def_before_reset(milp_bipartite, R"(Do nothing.)");
+	def_extract(milp_bipartite, "Extract a new bipartite graph observation.");
+}
+
+/**
+ * Observation module bindings definitions.
+ */
+void bind_submodule(py::module_ const& m) {
+	m.doc() = "Observation classes for Ecole.";
+
+	xt::import_numpy();
+
+	m.attr("Nothing") = py::type::of<Nothing>();
+
+	m.def("to_dlpack", &ecole::python::to_dlpack, py::arg("array"), R"(
+		Export an observation tensor as a DLPack capsule, without copy.
+
+		The capsule can be given to ``torch.utils.dlpack.from_dlpack`` (or any other DLPack consumer), and keeps
+		the observation memory alive as long as the consumer uses it.
+		This works with any version of numpy, including those without ``numpy.ndarray.__dlpack__``.
+	)");
+
+	bind_sparse_matrices<double>(m, "coo_matrix", "csr_matrix");
+	bind_sparse_matrices<float>(m, "coo_matrix_float32", "csr_matrix_float32");
+
+	// Node bipartite observation
+	auto node_bipartite_obs = bind_node_bipartite_obs<NodeBipartiteObs>(m, "NodeBipartiteObs");
+	auto node_bipartite_obs_float32 = bind_node_bipartite_obs<NodeBipartiteObsFloat32>(m, "NodeBipartiteObsFloat32");
 
 	py::enum_<NodeBipartiteObs::VariableFeatures>(node_bipartite_obs, "VariableFeatures")
 		.value("objective", NodeBipartiteObs::VariableFeatures::objective)
@@ -136,54 +786,96 @@ void bind_submodule(py::module_ const& m) {
 		.value("is_tight", NodeBipartiteObs::RowFeatures::is_tight)
 		.value("dual_solution_value", NodeBipartiteObs::RowFeatures::dual_solution_value)
 		.value("scaled_age", NodeBipartiteObs::RowFeatures::scaled_age);
+	// Features are shared across value types
+	node_bipartite_obs_float32.attr("VariableFeatures") = node_bipartite_obs.attr("VariableFeatures");
+	node_bipartite_obs_float32.attr("RowFeatures") = node_bipartite_obs.attr("RowFeatures");
+
+	bind_node_bipartite_batch<double>(m, "NodeBipartiteBatch");
+	bind_node_bipartite_batch<float>(m, "NodeBipartiteBatchFloat32");
 
-	auto node_bipartite = py::class_<NodeBipartite>(m, "NodeBipartite", R"(
+	bind_node_bipartite<NodeBipartite>(m, "NodeBipartite", R"(
 		Bipartite graph observation function on branch-and bound node.
 
 		This observation function extract structured :py:class:`NodeBipartiteObs`.
 	)");
-	node_bipartite.def(py::init<bool>(), py::arg("cache") = false, R"(
-		Constructor for NodeBipartite.
+	bind_node_bipartite<NodeBipartiteFloat32>(m, "NodeBipartiteFloat32", R"(
+		Single precision bipartite graph observation function on branch-and bound node.
 
-		Parameters
-		----------
-		cache :
-			Whether or not to cache static features within an episode.
-			Currently, this is only safe if cutting planes are disabled.
+		Identical to :py:class:`NodeBipartite`, but extract structured :py:class:`NodeBipartiteObsFloat32`, whose
+		features are ``numpy.float32`` arrays.
 	)");
-	def_before_reset(node_bipartite, "Cache some feature not expected to change during an episode.");
-	def_extract(node_bipartite, "Extract a new :py:class:`NodeBipartiteObs`.");
 
-	// MILP bipartite observation
-	auto milp_bipartite_obs =
-		ecole::python::auto_class<MilpBipartiteObs>(m, "MilpBipartiteObs", R"(
-		Bipartite graph observation that represents the most recent MILP during presolving.
-
-		The optimization problem is represented as an heterogenous bipartite graph.
-		On one side, a node is associated with one variable, on the other side a node is
-		associated with one constraint.
-		There exist an edge between a variable and a constraint if the variable exists in the
-		constraint with a non-zero coefficient.
+	ecole::python::auto_class<data::FeatureStatistics>(m, "FeatureStatistics", R"(
+		Running mean and variance of every feature, gathered with Welford's algorithm.
 
-		Each variable and constraint node is associated with a vector of features.
-		Each edge is associated with the coefficient of the variable in the constraint.
+		NaN values are not counted.
 	)")
-			.def_auto_copy()
-			.def_auto_pickle("variable_features", "constraint_features", "edge_features")
-			.def_readwrite_xtensor("variable_features", &MilpBipartiteObs::variable_features, R"rst(
-					A matrix where each row represents a variable, and each column a feature of the variable.
+		.def(py::init<std::size_t>(), py::arg("n_features") = 0)
+		.def_property_readonly("n_features", &data::FeatureStatistics::n_features)
+		.def_property_readonly("counts", &data::FeatureStatistics::get_counts)
+		.def_property_readonly("means", &data::FeatureStatistics::get_means)
+		.def_property_readonly(
+			"variances",
+			[](data::FeatureStatistics const& self) {
+				auto variances = std::vector<double>(self.n_features());
+				for (std::size_t j = 0; j < variances.size(); ++j) {
+					variances[j] = self.variance(j);
+				}
+				return variances;
+			})
+		.def(
+			"merge",
+			&data::FeatureStatistics::merge,
+			py::arg("other"),
+			"Add the statistics of the same features gathered elsewhere.");
 
-					Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
-					hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
-				)rst")
-			.def_readwrite_xtensor(
-				"constraint_features",
-				&MilpBipartiteObs::constraint_features,
-				"A matrix where each row is represents a constraint, and each column a feature of the constraints.")
-			.def_readwrite(
-				"edge_features",
-				&MilpBipartiteObs::edge_features,
-				"The constraint matrix of the optimization problem, with rows for contraints and columns for variables.");
+	bind_normalized<NodeBipartite>(m, "NormalizedNodeBipartite", R"(
+		Bipartite graph observation function with normalized features.
+
+		Variable and row features of the :py:class:`NodeBipartiteObs` are normalized feature by feature as
+		``(x - mean) / sqrt(variance + epsilon)``, with running statistics of the values extracted before,
+		updated in the same pass.
+		Edge features are left unchanged.
+	)");
+	bind_normalized<NodeBipartiteFloat32>(m, "NormalizedNodeBipartiteFloat32", R"(
+		Single precision bipartite graph observation function with normalized features.
+
+		Identical to :py:class:`NormalizedNodeBipartite`, but wraps a :py:class:`NodeBipartiteFloat32`.
+	)");
+
+	bind_node_bipartite_delta<double>(m, "NodeBipartiteDelta", "DeltaNodeBipartite");
+	bind_node_bipartite_delta<float>(m, "NodeBipartiteDeltaFloat32", "DeltaNodeBipartiteFloat32");
+
+	auto compact_obs = bind_node_bipartite_compact<double>(m, "NodeBipartiteCompactObs", "CompactNodeBipartite");
+	auto compact_obs_float32 =
+		bind_node_bipartite_compact<float>(m, "NodeBipartiteCompactObsFloat32", "CompactNodeBipartiteFloat32");
+	using ContinuousVariableFeatures = NodeBipartiteCompactObs::ContinuousVariableFeatures;
+	using CategoricalVariableFeatures = NodeBipartiteCompactObs::CategoricalVariableFeatures;
+	py::enum_<ContinuousVariableFeatures>(compact_obs, "ContinuousVariableFeatures")
+		.value("objective", ContinuousVariableFeatures::objective)
+		.value("normed_reduced_cost", ContinuousVariableFeatures::normed_reduced_cost)
+		.value("solution_value", ContinuousVariableFeatures::solution_value)
+		.value("solution_frac", ContinuousVariableFeatures::solution_frac)
+		.value("scaled_age", ContinuousVariableFeatures::scaled_age)
+		.value("incumbent_value", ContinuousVariableFeatures::incumbent_value)
+		.value("average_incumbent_value", ContinuousVariableFeatures::average_incumbent_value)
+		.value("index", ContinuousVariableFeatures::index);
+	py::enum_<CategoricalVariableFeatures>(compact_obs, "CategoricalVariableFeatures")
+		.value("type", CategoricalVariableFeatures::type)
+		.value("has_lower_bound", CategoricalVariableFeatures::has_lower_bound)
+		.value("has_upper_bound", CategoricalVariableFeatures::has_upper_bound)
+		.value("is_solution_at_lower_bound", CategoricalVariableFeatures::is_solution_at_lower_bound)
+		.value("is_solution_at_upper_bound", CategoricalVariableFeatures::is_solution_at_upper_bound)
+		.value("basis_status", CategoricalVariableFeatures::basis_status);
+	compact_obs.attr("RowFeatures") = node_bipartite_obs.attr("RowFeatures");
+	// Features are shared across value types
+	compact_obs_float32.attr("ContinuousVariableFeatures") = compact_obs.attr("ContinuousVariableFeatures");
+	compact_obs_float32.attr("CategoricalVariableFeatures") = compact_obs.attr("CategoricalVariableFeatures");
+	compact_obs_float32.attr("RowFeatures") = node_bipartite_obs.attr("RowFeatures");
+
+	// MILP bipartite observation
+	auto milp_bipartite_obs = bind_milp_bipartite_obs<MilpBipartiteObs>(m, "MilpBipartiteObs");
+	auto milp_bipartite_obs_float32 = bind_milp_bipartite_obs<MilpBipartiteObsFloat32>(m, "MilpBipartiteObsFloat32");
 
 	py::enum_<MilpBipartiteObs::VariableFeatures>(milp_bipartite_obs, "VariableFeatures")
 		.value("objective", MilpBipartiteObs::VariableFeatures::objective)
@@ -198,23 +890,70 @@ void bind_submodule(py::module_ const& m) {
 
 	py::enum_<MilpBipartiteObs::ConstraintFeatures>(milp_bipartite_obs, "ConstraintFeatures")
 		.value("bias", MilpBipartiteObs::ConstraintFeatures::bias);
+	// Features are shared across value types
+	milp_bipartite_obs_float32.attr("VariableFeatures") = milp_bipartite_obs.attr("VariableFeatures");
+	milp_bipartite_obs_float32.attr("ConstraintFeatures") = milp_bipartite_obs.attr("ConstraintFeatures");
 
-	auto milp_bipartite = py::class_<MilpBipartite>(m, "MilpBipartite", R"(
+	bind_milp_bipartite<MilpBipartite>(m, "MilpBipartite", R"(
 		Bipartite graph observation function for the sub-MILP at the latest branch-and-bound node.
 
 		This observation function extract structured :py:class:`MilpBipartiteObs`.
 	)");
-	milp_bipartite.def(py::init<bool>(), py::arg("normalize") = false, R"(
-		Constructor for MilpBipartite.
+	bind_milp_bipartite<MilpBipartiteFloat32>(m, "MilpBipartiteFloat32", R"(
+		Single precision bipartite graph observation function for the sub-MILP at the latest branch-and-bound node.
+
+		Identical to :py:class:`MilpBipartite`, but extract structured :py:class:`MilpBipartiteObsFloat32`, whose
+		features are ``numpy.float32`` arrays.
+	)");
+
+	m.def(
+		"extract_milp_bipartite",
+		py::overload_cast<scip::Model&, bool, bool>(&extract_milp_bipartite<double>),
+		py::arg("model"),
+		py::arg("presolve") = false,
+		py::arg("normalize") = false,
+		py::call_guard<py::gil_scoped_release>(),
+		R"(
+		Extract the :py:class:`MilpBipartiteObs` of a problem, outside of any environment.
+
+		Meant for instance level features, for instance for algorithm selection.
+		The GIL is released during extraction.
 
 		Parameters
 		----------
-		normalize :
-			Should the features be normalized?
-			This is recommended for some application such as deep learning models.
+		model:
+			The problem, which can also be given as the path of a problem file, or as a list of paths to
+			extract many files in parallel.
+			Files are read with only the plugins needed, and freed after extraction.
+		presolve:
+			Whether to extract the graph of the presolved problem rather than the original one.
+			Models given directly are copied before presolving.
+		normalize:
+			Whether to normalize the features of constraints and variables.
+		n_threads:
+			When extracting a list of files, the number of threads reading them, or zero to share Ecole's
+			threads (see :py:func:`ecole.set_n_threads`).
+
+		Returns
+		-------
+		The observation, or ``None`` if the problem is solved by presolving, or a list of them for a list of files.
 	)");
-	def_before_reset(milp_bipartite, R"(Do nothing.)");
-	def_extract(milp_bipartite, "Extract a new :py:class:`MilpBipartiteObs`.");
+	m.def(
+		"extract_milp_bipartite",
+		py::overload_cast<std::filesystem::path const&, bool, bool>(&extract_milp_bipartite<double>),
+		py::arg("model"),
+		py::arg("presolve") = false,
+		py::arg("normalize") = false,
+		py::call_guard<py::gil_scoped_release>());
+	m.def(
+		"extract_milp_bipartite",
+		py::overload_cast<std::vector<std::filesystem::path> const&, bool, bool, std::size_t>(
+			&extract_milp_bipartite<double>),
+		py::arg("model"),
+		py::arg("presolve") = false,
+		py::arg("normalize") = false,
+		py::arg("n_threads") = 0,
+		py::call_guard<py::gil_scoped_release>());
 
 	// Strong branching observation
 	auto strong_branching_scores = py::class_<StrongBranchingScores>(m, "StrongBranchingScores", R"(
@@ -231,7 +970,11 @@ void bind_submodule(py::module_ const& m) {
 		hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
 		Variables for which a strong branching score is not applicable are filled with ``NaN``.
 	)");
-	strong_branching_scores.def(py::init<bool>(), py::arg("pseudo_candidates") = false, R"(
+	strong_branching_scores.def(
+		py::init<bool, std::size_t>(),
+		py::arg("pseudo_candidates") = false,
+		py::arg("n_threads") = 1,
+		R"(
 		Constructor for StrongBranchingScores.
 
 		Parameters
@@ -239,10 +982,164 @@ void bind_submodule(py::module_ const& m) {
 		pseudo_candidates :
 			The parameter determines if strong branching scores are computed for
 			pseudo candidate variables (when true) or LP candidate variables (when false).
+		n_threads :
+			The number of threads scoring candidates, or zero to share Ecole's threads
+			(see :py:func:`ecole.set_n_threads`).
+			With more than one thread, every thread solves the children of a share of the candidates
+			on its own copy of the node LP, and scores are the same as with one thread up to the LP
+			tolerances.
 	)");
-	def_before_reset(strong_branching_scores, R"(Do nothing.)");
+	def_before_reset(strong_branching_scores, R"(Resolve the strong branching parameters of the model.)");
 	def_extract(strong_branching_scores, "Extract an array containing strong branching scores.");
 
+	// Budgeted strong branching observation
+	auto budgeted_strong_branching_scores =
+		py::class_<BudgetedStrongBranchingScores>(m, "BudgetedStrongBranchingScores", R"(
+		Approximate strong branching score observation function on branch-and bound node.
+
+		This observation computes strong branching scores like :py:class:`StrongBranchingScores`, but under a
+		budget.
+		Only the candidates with the highest pseudocost scores are evaluated, and the number of simplex
+		iterations of every strong branching LP can be limited.
+		The resulting scores are cheaper to compute, at the expense of being less accurate.
+
+		This observation function extracts an array with the same layout as :py:class:`StrongBranchingScores`.
+		Variables that are not candidates, or that are not preselected, are filled with ``NaN``.
+	)");
+	budgeted_strong_branching_scores.def(
+		py::init<bool, std::optional<std::size_t>, std::optional<std::size_t>, bool>(),
+		py::arg("pseudo_candidates") = false,
+		py::arg("max_candidates") = py::none(),
+		py::arg("max_lp_iterations") = py::none(),
+		py::arg("reuse_cache") = false,
+		R"(
+		Constructor for BudgetedStrongBranchingScores.
+
+		Parameters
+		----------
+		pseudo_candidates :
+			The parameter determines if strong branching scores are computed for
+			pseudo candidate variables (when true) or LP candidate variables (when false).
+		max_candidates :
+			The number of candidates, with highest pseudocost score, to evaluate.
+			All candidates are evaluated when ``None``.
+		max_lp_iterations :
+			The simplex iteration limit of each strong branching LP, or no limit when ``None``.
+		reuse_cache :
+			Whether to return the previously computed scores when extracting again on the same
+			node, without any new LP solved.
+	)");
+	def_before_reset(budgeted_strong_branching_scores, R"(Clear the cached scores.)");
+	def_extract(budgeted_strong_branching_scores, "Extract an array containing approximate strong branching scores.");
+
+	// Reliability branching scores observation
+	ecole::python::auto_class<ReliabilityBranchingScoresObs>(m, "ReliabilityBranchingScoresObs", R"(
+		Strong branching scores, some of which are estimated from pseudocosts.
+
+		Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
+		hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
+	)")
+		.def_auto_copy()
+		.def_auto_pickle("scores", "exact")
+		.def_readwrite_xtensor(
+			"scores",
+			&ReliabilityBranchingScoresObs::scores,
+			"The score of every variable, with ``NaN`` for variables that are not candidates.")
+		.def_readwrite_xtensor("exact", &ReliabilityBranchingScoresObs::exact, R"(
+			Whether every score was computed by strong branching.
+			Other scores are pseudocost scores, or ``NaN``.
+		)");
+
+	auto reliability_branching_scores = py::class_<ReliabilityBranchingScores>(m, "ReliabilityBranchingScores", R"(
+		Strong branching scores, skipping candidates with reliable pseudocosts.
+
+		Similarly to SCIP reliability pseudocost branching, strong branching is only run on candidates whose
+		pseudocosts have not yet been updated enough times.
+		The other candidates use their pseudocost score.
+		This makes strong branching labels cheaper to collect, with the quality tradeoff controlled by the
+		reliability threshold, and tells which scores are exact.
+
+		This observation function extracts a :py:class:`ReliabilityBranchingScoresObs`.
+	)");
+	reliability_branching_scores.def(
+		py::init<bool, SCIP_Real, std::optional<std::size_t>>(),
+		py::arg("pseudo_candidates") = false,
+		py::arg("reliability_threshold") = 5.,
+		py::arg("max_lp_iterations") = py::none(),
+		R"(
+		Constructor for ReliabilityBranchingScores.
+
+		Parameters
+		----------
+		pseudo_candidates :
+			The parameter determines if scores are computed for pseudo candidate variables (when true)
+			or LP candidate variables (when false).
+		reliability_threshold :
+			The number of pseudocost updates, in both directions, from which a candidate is not strong branched.
+			The default is the maximum reliability of SCIP reliability pseudocost branching.
+		max_lp_iterations :
+			The simplex iteration limit of each strong branching LP, or no limit when ``None``.
+	)");
+	def_before_reset(reliability_branching_scores, R"(Do nothing.)");
+	def_extract(reliability_branching_scores, "Extract scores and whether they are exact.");
+
+	// Detailed strong branching scores observation
+	ecole::python::auto_class<DetailedStrongBranchingScoresObs>(m, "DetailedStrongBranchingScoresObs", R"(
+		Strong branching scores, with the children LPs they are computed from.
+
+		Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
+		hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
+	)")
+		.def_auto_copy()
+		.def_auto_pickle("scores", "down_gains", "up_gains", "n_lp_iterations")
+		.def_readwrite_xtensor(
+			"scores",
+			&DetailedStrongBranchingScoresObs::scores,
+			"The score of every variable, with ``NaN`` for variables that were not evaluated.")
+		.def_readwrite_xtensor(
+			"down_gains",
+			&DetailedStrongBranchingScoresObs::down_gains,
+			"The dual bound improvement of the down child of every variable, or ``NaN``.")
+		.def_readwrite_xtensor(
+			"up_gains",
+			&DetailedStrongBranchingScoresObs::up_gains,
+			"The dual bound improvement of the up child of every variable, or ``NaN``.")
+		.def_readwrite_xtensor(
+			"n_lp_iterations",
+			&DetailedStrongBranchingScoresObs::n_lp_iterations,
+			"The number of simplex iterations of both children of every variable, or zero.");
+
+	auto detailed_strong_branching_scores =
+		py::class_<DetailedStrongBranchingScores>(m, "DetailedStrongBranchingScores", R"(
+		Strong branching score observation function, computed by Ecole.
+
+		Contrary to :py:class:`StrongBranchingScores`, the ``vanillafullstrong`` branching rule is not
+		called.
+		The children LPs of every candidate are solved with the SCIP strong branching API, each warm
+		started from the node LP basis, and reported along with their number of simplex iterations.
+		Results are stored in SCIP columns as if computed by a branching rule, hence SCIP can reuse them
+		on the same node.
+
+		This observation function extracts a :py:class:`DetailedStrongBranchingScoresObs`.
+	)");
+	detailed_strong_branching_scores.def(
+		py::init<bool, std::optional<std::size_t>>(),
+		py::arg("pseudo_candidates") = false,
+		py::arg("max_lp_iterations") = py::none(),
+		R"(
+		Constructor for DetailedStrongBranchingScores.
+
+		Parameters
+		----------
+		pseudo_candidates :
+			The parameter determines if strong branching scores are computed for
+			pseudo candidate variables (when true) or LP candidate variables (when false).
+		max_lp_iterations :
+			The simplex iteration limit of each child LP, or no limit when ``None``.
+	)");
+	def_before_reset(detailed_strong_branching_scores, R"(Do nothing.)");
+	def_extract(detailed_strong_branching_scores, "Extract strong branching scores and children LPs.");
+
 	// Pseudocosts observation
 	auto pseudocosts = py::class_<Pseudocosts>(m, "Pseudocosts", R"(
 		Pseudocosts observation function on branch-and-bound nodes.
@@ -259,11 +1156,45 @@ void bind_submodule(py::module_ const& m) {
 		Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
 		hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
 		Variables for which a pseudocost is not applicable are filled with ``NaN``.
+		Alternatively, only the pseudocosts of the LP branching candidates can be extracted.
+	)");
+	pseudocosts.def(py::init<bool>(), py::arg("candidates_only") = false, R"(
+		Create new observation.
+
+		Parameters
+		----------
+		candidates_only:
+				Whether to only extract the pseudocosts of the LP branching candidates, in the order of
+				``SCIPgetLPBranchCands``, rather than one value per variable.
 	)");
-	pseudocosts.def(py::init<>());
 	def_before_reset(pseudocosts, R"(Do nothing.)");
 	def_extract(pseudocosts, "Extract an array containing pseudocosts.");
 
+	auto pooled_pseudocosts = bind_pooled<Pseudocosts>(m, "PooledPseudocosts", R"(
+		Pseudocosts observation function extracting in recycled arrays.
+
+		Identical to :py:class:`Pseudocosts`, but arrays are taken from a pool of previously extracted
+		observations instead of being allocated on every call.
+		An array is given back to the pool when it is garbage collected, so it must not be kept by the
+		caller for the memory to be reused.
+	)");
+	pooled_pseudocosts.def(
+		py::init([](bool candidates_only, std::size_t capacity) {
+			return data::PooledFunction<Pseudocosts>{Pseudocosts{candidates_only}, capacity};
+		}),
+		py::arg("candidates_only") = false,
+		py::arg("capacity") = 4,
+		R"(
+		Create new observation.
+
+		Parameters
+		----------
+		candidates_only:
+				Whether to only extract the pseudocosts of the LP branching candidates.
+		capacity:
+				The maximum number of garbage collected arrays kept for reuse.
+	)");
+
 	// Khalil observation
 	auto khalil2016_obs = ecole::python::auto_class<Khalil2016Obs>(m, "Khalil2016Obs", R"(
 		Branching candidates features from Khalil et al. (2016).
@@ -279,18 +1210,28 @@ void bind_submodule(py::module_ const& m) {
 			*Thirtieth AAAI Conference on Artificial Intelligence*. 2016.
 	)");
 	khalil2016_obs.def_auto_copy()
-		.def_auto_pickle("features")
+		.def_auto_pickle("features", "candidates", "timed_out")
 		.def_readwrite_xtensor("features", &Khalil2016Obs::features, R"rst(
 			A matrix where each row represents a variable, and each column a feature of the variable.
 
 			Variables are ordered according to their position in the original problem (``SCIPvarGetProbindex``),
 			hence they can be indexed by the :py:class:`~ecole.environment.Branching` environment ``action_set``.
 			Variables for which the features are not applicable are filled with ``NaN``.
+			When extracted with ``candidates_only``, rows are instead the branching candidates, in the order of
+			:py:attr:`Khalil2016Obs.candidates`.
 
 			The first :py:attr:`Khalil2016Obs.n_static_features` features columns are static (they do not
 			change through the solving process), and the remaining :py:attr:`Khalil2016Obs.n_dynamic_features`
 			are dynamic.
 		)rst")
+		.def_readwrite_xtensor(
+			"candidates",
+			&Khalil2016Obs::candidates,
+			"The problem index (``SCIPvarGetProbindex``) of the branching candidates, in the order they are extracted.")
+		.def_readwrite_xtensor("timed_out", &Khalil2016Obs::timed_out, R"rst(
+			Whether every column was left ``NaN`` because the ``time_budget`` of the extraction ran out before its
+			group of features was computed for all candidates.
+		)rst")
 		.def_readonly_static("n_static_features", &Khalil2016Obs::n_static_features)
 		.def_readonly_static("n_dynamic_features", &Khalil2016Obs::n_dynamic_features);
 
@@ -373,7 +1314,15 @@ void bind_submodule(py::module_ const& m) {
 
 		This observation function extract structured :py:class:`Khalil2016Obs`.
 	)");
-	khalil2016.def(py::init<bool>(), py::arg("pseudo_candidates") = false, R"(
+	khalil2016.def(
+		py::init<bool, std::size_t, bool, std::vector<Khalil2016Obs::Features>, bool, std::chrono::microseconds>(),
+		py::arg("pseudo_candidates") = false,
+		py::arg("n_threads") = 1,
+		py::arg("candidates_only") = false,
+		py::arg("features") = std::vector<Khalil2016Obs::Features>{},
+		py::arg("incremental") = false,
+		py::arg("time_budget") = std::chrono::microseconds::zero(),
+		R"(
 		Create new observation.
 
 		Parameters
@@ -381,9 +1330,43 @@ void bind_submodule(py::module_ const& m) {
 		pseudo_candidates:
 				Whether the pseudo branching variable candidates (``SCIPgetPseudoBranchCands``)
 				or LP branching variable candidates (``SCIPgetPseudoBranchCands``) are observed.
+		n_threads:
+				The number of threads computing the features of branching candidates, or zero to share
+				Ecole's threads (see :py:func:`ecole.set_n_threads`).
+				The observation does not depend on the number of threads.
+		candidates_only:
+				Whether to only extract a row per branching candidate, in the order of
+				:py:attr:`Khalil2016Obs.candidates`, rather than a row per variable.
+		features:
+				The :py:class:`Khalil2016Obs.Features` to extract, as columns in the given order, or all of them
+				when empty.
+				Groups of dynamic features where no feature is selected are not computed.
+		incremental:
+				Whether to track changes of the LP rows with SCIP events, so that the constraint degree and
+				coefficient to right hand side ratio statistics are only recomputed for the columns of rows
+				that changed since the previous extraction.
+		time_budget:
+				The wall time allowed per extraction, in seconds or as a ``datetime.timedelta``, or zero for no
+				limit.
+				Groups of dynamic features are then computed from the cheapest to the most expensive, and
+				the groups not complete by the deadline are ``NaN`` and marked in :py:attr:`Khalil2016Obs.timed_out`.
 	)");
-	def_before_reset(khalil2016, R"(Reset static features cache.)");
+	def_before_reset(khalil2016, R"(Reset static features cache, and track LP rows if incremental.)");
 	def_extract(khalil2016, "Extract the observation matrix.");
+	bind_normalized<Khalil2016>(m, "NormalizedKhalil2016", R"(
+		Khalil2016 observation function with normalized features.
+
+		Every column of :py:attr:`Khalil2016Obs.features` is normalized as ``(x - mean) / sqrt(variance + epsilon)``,
+		with running statistics of the values extracted before, updated in the same pass.
+		NaN features of variables that are not branching candidates are not counted.
+	)");
+	bind_history<Khalil2016>(m, "HistoryKhalil2016", "Khalil2016ObsHistory", R"(
+		Khalil2016 observations of the last nodes of the episode.
+
+		Observations are kept in a ring buffer, without copy, so that returning a history of any length only
+		allocates a list of references to them.
+		Nothing is returned in terminal states, where there is no observation.
+	)");
 
 	// Hutter2011 observation
 	auto hutter_obs = ecole::python::auto_class<Hutter2011Obs>(m, "Hutter2011Obs", R"(
@@ -420,6 +1403,8 @@ void bind_submodule(py::module_ const& m) {
 		.value("node_degree_std", Hutter2011Obs::Features::node_degree_std)
 		.value("node_degree_25q", Hutter2011Obs::Features::node_degree_25q)
 		.value("node_degree_75q", Hutter2011Obs::Features::node_degree_75q)
+		.value("clustering_coef_mean", Hutter2011Obs::Features::clustering_coef_mean)
+		.value("clustering_coef_std", Hutter2011Obs::Features::clustering_coef_std)
 		.value("edge_density", Hutter2011Obs::Features::edge_density)
 		.value("lp_slack_mean", Hutter2011Obs::Features::lp_slack_mean)
 		.value("lp_slack_max", Hutter2011Obs::Features::lp_slack_max)
@@ -442,9 +1427,92 @@ void bind_submodule(py::module_ const& m) {
 
 		This observation function extracts a structured :py:class:`Hutter2011Obs`.
 	)");
-	hutter.def(py::init<>());
+	hutter.def(
+		py::init<bool, std::size_t, std::size_t, bool, std::size_t>(),
+		py::arg("cache_features") = false,
+		py::arg("n_clustering_samples") = 64,
+		py::arg("n_threads") = 1,
+		py::arg("reuse_root_lp") = false,
+		py::arg("max_cached_instances") = 1024,
+		R"(
+		Create new observation.
+
+		Parameters
+		----------
+		cache_features:
+				Whether to remember the features of instances, so that they are returned without being
+				recomputed, nor the constraints read, when the same instance (according to a hash of its data)
+				is seen again.
+		n_clustering_samples:
+				The number of pairs of neighbors sampled per variable to estimate the clustering coefficients
+				of the variable graph. All pairs are used when there are fewer.
+		n_threads:
+				The number of threads reading the constraints, or zero to share Ecole's threads
+				(see :py:func:`ecole.set_n_threads`).
+				The observation does not depend on the number of threads.
+		reuse_root_lp:
+				Whether to read the LP based features from the root LP of models whose root LP is solved,
+				rather than solving the LP relaxation of a copy, and thereby to also extract during solving.
+				The root LP is that of the presolved problem with cuts, so the features differ from those of
+				the copy.
+		max_cached_instances:
+				The number of instances whose features are cached, the least recently used being dropped
+				first.
+	)");
 	def_before_reset(hutter, R"(Do nothing.)");
 	def_extract(hutter, "Extract the observation matrix.");
+	hutter.def(
+		"extract_from_file",
+		&Hutter2011::extract_from_file,
+		py::arg("filename"),
+		py::call_guard<py::gil_scoped_release>(),
+		R"(
+		Compute the features of an MPS file without loading it in SCIP.
+
+		The file is read once line by line, which is much faster than creating a model for triaging large
+		collections of instances.
+		The LP based features, which require solving the LP relaxation, are ``NaN``.
+		Only the free MPS format, without quadratic, SOS, or indicator sections, is supported.
+	)");
+
+	// TreeStatistics observation
+	auto tree_statistics_obs = ecole::python::auto_class<TreeStatisticsObs>(m, "TreeStatisticsObs", R"(
+		Statistics of the branch-and-bound tree extracted by :py:class:`TreeStatistics`.
+
+		Depths are those of the nodes in the tree of the presolved problem, with the root at depth zero.
+		Means are zero before any node is recorded, and the gaps are infinite without primal solution.
+	)");
+	tree_statistics_obs.def_auto_copy()
+		.def_auto_pickle("features")
+		.def_readwrite_xtensor("features", &TreeStatisticsObs::features, "A vector of tree statistics.");
+
+	py::enum_<TreeStatisticsObs::Features>(tree_statistics_obs, "Features")
+		.value("n_nodes", TreeStatisticsObs::Features::n_nodes)
+		.value("n_open_nodes", TreeStatisticsObs::Features::n_open_nodes)
+		.value("focus_depth", TreeStatisticsObs::Features::focus_depth)
+		.value("max_depth", TreeStatisticsObs::Features::max_depth)
+		.value("focus_depth_mean", TreeStatisticsObs::Features::focus_depth_mean)
+		.value("focus_depth_stddev", TreeStatisticsObs::Features::focus_depth_stddev)
+		.value("leaf_depth_mean", TreeStatisticsObs::Features::leaf_depth_mean)
+		.value("n_feasible_leaves", TreeStatisticsObs::Features::n_feasible_leaves)
+		.value("n_infeasible_leaves", TreeStatisticsObs::Features::n_infeasible_leaves)
+		.value("n_branched_nodes", TreeStatisticsObs::Features::n_branched_nodes)
+		.value("n_backtracks", TreeStatisticsObs::Features::n_backtracks)
+		.value("n_incumbents", TreeStatisticsObs::Features::n_incumbents)
+		.value("nodes_since_incumbent", TreeStatisticsObs::Features::nodes_since_incumbent)
+		.value("gap", TreeStatisticsObs::Features::gap)
+		.value("gap_at_last_incumbent", TreeStatisticsObs::Features::gap_at_last_incumbent);
+
+	auto tree_statistics = py::class_<TreeStatistics>(m, "TreeStatistics", R"(
+		Statistics of the branch-and-bound tree and of the search in it.
+
+		This observation function extracts a structured :py:class:`TreeStatisticsObs` during solving.
+		The statistics are aggregated by an event handler as nodes are solved and incumbents found,
+		so that extracting them takes constant time regardless of the size of the tree.
+	)");
+	tree_statistics.def(py::init<>(), "Create new observation.");
+	def_before_reset(tree_statistics, R"(Add the event handler aggregating the statistics to the model.)");
+	def_extract(tree_statistics, "Extract the statistics, or ``None`` when the model is not solving.");
 }
 
 }  // namespace ecole::observation
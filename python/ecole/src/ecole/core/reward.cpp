@@ -1,9 +1,12 @@
 #include <functional>
+#include <type_traits>
 #include <utility>
 
+#include <pybind11/chrono.h>
 #include <pybind11/eval.h>
 #include <pybind11/functional.h>
 #include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
 
 #include "ecole/reward/bound-integral.hpp"
 #include "ecole/reward/constant.hpp"
@@ -14,6 +17,7 @@
 #include "ecole/scip/model.hpp"
 
 #include "core.hpp"
+#include "native.hpp"
 
 namespace py = pybind11;
 
@@ -137,6 +141,7 @@ void bind_submodule(py::module_ const& m) {
 		Number of nodes difference.
 
 		The reward is defined as the total number of nodes processed since the previous state.
+		With the concurrent solver, these are the nodes of the solver that finished first.
 	)");
 	nnodes.def(py::init<>());
 	def_operators(nnodes);
@@ -154,13 +159,18 @@ void bind_submodule(py::module_ const& m) {
 		The solving time is specific to the operating system: it includes time spent in
 		:py:meth:`~ecole.environment.Environment.reset` and time spent waiting on the agent.
 	)");
-	solvingtime.def(py::init<bool>(), py::arg("wall") = false, R"(
+	solvingtime.def(py::init<bool, bool>(), py::arg("wall") = false, py::arg("thread_cpu") = false, R"(
 		Create a SolvingTime reward function.
 
 		Parameters
 		----------
 		wall :
 			If true, the wall time will be used. If False (default), the process time will be used.
+		thread_cpu :
+			If true, only the CPU time of the environment and solver threads will be used, which excludes
+			other threads of the process, such as other environments. Cannot be used with ``wall``.
+			The threads of the SCIP concurrent solver are not counted, so multithreaded
+			:py:class:`~ecole.dynamics.ConfiguringDynamics` should use the process time instead.
 
 	)");
 	def_operators(solvingtime);
@@ -171,6 +181,15 @@ void bind_submodule(py::module_ const& m) {
 		The difference in solving time is computed in between calls.
 		)");
 
+	py::enum_<DualBoundEvent>(m, "DualBoundEvent", "The solver events after which the dual bound of an integral is read.")
+		.value("LP", DualBoundEvent::lp)
+		.value("Node", DualBoundEvent::node);
+
+	py::class_<BoundHistory>(m, "BoundHistory", "The bounds recorded at every event by a bound integral reward.")
+		.def_readonly("times", &BoundHistory::times)
+		.def_readonly("primal_bounds", &BoundHistory::primal_bounds)
+		.def_readonly("dual_bounds", &BoundHistory::dual_bounds);
+
 	auto dualintegral = py::class_<DualIntegral>(m, "DualIntegral", R"(
 		Dual integral difference.
 
@@ -179,9 +198,13 @@ void bind_submodule(py::module_ const& m) {
 		it includes time spent in :py:meth:`~ecole.environment.Environment.reset` and time spent waiting on the agent.
 	)");
 	dualintegral.def(
-		py::init<bool, DualIntegral::BoundFunction>(),
+		py::init<bool, DualIntegral::BoundFunction, bool, DualBoundEvent, bool, bool>(),
 		py::arg("wall") = false,
 		py::arg("bound_function") = DualIntegral::BoundFunction{},
+		py::arg("keep_history") = false,
+		py::arg("dual_bound_event") = DualBoundEvent::lp,
+		py::arg("coarse_clock") = false,
+		py::arg("thread_cpu_clock") = false,
 
 		R"(
 		Create a DualIntegral reward function.
@@ -194,9 +217,26 @@ void bind_submodule(py::module_ const& m) {
 			A function which takes an ecole model and returns a tuple of an initial dual bound and the offset
 			to compute the dual bound with respect to.  Values should be ordered as (offset, initial_dual_bound).
 			The default function returns (0, 1e20) if the problem is a maximization and (0, -1e20) otherwise.
-
+		keep_history :
+			If true, also record the bounds at every event, which is useful for debugging but uses memory
+			proportional to the number of events.
+		dual_bound_event :
+			The events after which the dual bound is read, either after every LP or only after every node,
+			which is cheaper.
+		coarse_clock :
+			If true, read the wall time from a coarse clock, which is cheaper but has a resolution of a few
+			milliseconds. Requires ``wall`` to be true.
+		thread_cpu_clock :
+			If true, only the CPU time of the environment and solver threads will be used, which excludes
+			other threads of the process, such as other environments. Cannot be used with ``wall``.
 	)");
 	def_operators(dualintegral);
+	dualintegral.def(
+		"history",
+		&DualIntegral::history,
+		py::arg("model"),
+		py::return_value_policy::copy,
+		"The bounds recorded at every event since the reset, empty unless ``keep_history`` is true.");
 	def_before_reset(dualintegral, "Reset the internal clock counter and the event handler.");
 	def_extract(dualintegral, R"(
 		Computes the current dual integral and returns the difference.
@@ -212,9 +252,13 @@ void bind_submodule(py::module_ const& m) {
 		it includes time spent in :py:meth:`~ecole.environment.Environment.reset` and time spent waiting on the agent.
 	)");
 	primalintegral.def(
-		py::init<bool, PrimalIntegral::BoundFunction>(),
+		py::init<bool, PrimalIntegral::BoundFunction, bool, DualBoundEvent, bool, bool>(),
 		py::arg("wall") = false,
 		py::arg("bound_function") = PrimalIntegral::BoundFunction{},
+		py::arg("keep_history") = false,
+		py::arg("dual_bound_event") = DualBoundEvent::lp,
+		py::arg("coarse_clock") = false,
+		py::arg("thread_cpu_clock") = false,
 		R"(
 		Create a PrimalIntegral reward function.
 
@@ -226,8 +270,26 @@ void bind_submodule(py::module_ const& m) {
 			A function which takes an ecole model and returns a tuple of an initial primal bound and the offset
 			to compute the primal bound with respect to. Values should be ordered as (offset, initial_primal_bound).
 			The default function returns (0, -1e20) if the problem is a maximization and (0, 1e20) otherwise.
+		keep_history :
+			If true, also record the bounds at every event, which is useful for debugging but uses memory
+			proportional to the number of events.
+		dual_bound_event :
+			The events after which the dual bound is read, either after every LP or only after every node,
+			which is cheaper.
+		coarse_clock :
+			If true, read the wall time from a coarse clock, which is cheaper but has a resolution of a few
+			milliseconds. Requires ``wall`` to be true.
+		thread_cpu_clock :
+			If true, only the CPU time of the environment and solver threads will be used, which excludes
+			other threads of the process, such as other environments. Cannot be used with ``wall``.
 	)");
 	def_operators(primalintegral);
+	primalintegral.def(
+		"history",
+		&PrimalIntegral::history,
+		py::arg("model"),
+		py::return_value_policy::copy,
+		"The bounds recorded at every event since the reset, empty unless ``keep_history`` is true.");
 	def_before_reset(primalintegral, "Reset the internal clock counter and the event handler.");
 	def_extract(primalintegral, R"(
 		Computes the current primal integral and returns the difference.
@@ -243,9 +305,13 @@ void bind_submodule(py::module_ const& m) {
 		it includes time spent in :py:meth:`~ecole.environment.Environment.reset` and time spent waiting on the agent.
 	)");
 	primaldualintegral.def(
-		py::init<bool, PrimalDualIntegral::BoundFunction>(),
+		py::init<bool, PrimalDualIntegral::BoundFunction, bool, DualBoundEvent, bool, bool>(),
 		py::arg("wall") = false,
 		py::arg("bound_function") = PrimalDualIntegral::BoundFunction{},
+		py::arg("keep_history") = false,
+		py::arg("dual_bound_event") = DualBoundEvent::lp,
+		py::arg("coarse_clock") = false,
+		py::arg("thread_cpu_clock") = false,
 		R"(
 		Create a PrimalDualIntegral reward function.
 
@@ -257,8 +323,26 @@ void bind_submodule(py::module_ const& m) {
 			A function which takes an ecole model and returns a tuple of an initial primal bound and dual bound.
 			Values should be ordered as (initial_primal_bound, initial_dual_bound). The default function returns
 			(-1e20, 1e20) if the problem is a maximization and (1e20, -1e20) otherwise.
+		keep_history :
+			If true, also record the bounds at every event, which is useful for debugging but uses memory
+			proportional to the number of events.
+		dual_bound_event :
+			The events after which the dual bound is read, either after every LP or only after every node,
+			which is cheaper.
+		coarse_clock :
+			If true, read the wall time from a coarse clock, which is cheaper but has a resolution of a few
+			milliseconds. Requires ``wall`` to be true.
+		thread_cpu_clock :
+			If true, only the CPU time of the environment and solver threads will be used, which excludes
+			other threads of the process, such as other environments. Cannot be used with ``wall``.
 	)");
 	def_operators(primaldualintegral);
+	primaldualintegral.def(
+		"history",
+		&PrimalDualIntegral::history,
+		py::arg("model"),
+		py::return_value_policy::copy,
+		"The bounds recorded at every event since the reset, empty unless ``keep_history`` is true.");
 	def_before_reset(primaldualintegral, "Reset the internal clock counter and the event handler.");
 	def_extract(primaldualintegral, R"(
 		Computes the current primal-dual integral and returns the difference.
@@ -336,6 +420,11 @@ template <typename PyClass, typename... Args> void def_before_reset(PyClass pycl
 }
 
 template <typename PyClass, typename... Args> void def_extract(PyClass pyclass, Args&&... args) {
+	using Function = typename PyClass::type;
+	// Rewards operating on Python objects, such as Arithmetic, need the GIL
+	if constexpr (std::is_invocable_v<decltype(&Function::extract), Function&, scip::Model&, bool>) {
+		data::NativeFunction::register_type<Function>(pyclass);
+	}
 	pyclass.def(
 		"extract", &PyClass::type::extract, py::arg("model"), py::arg("done") = false, std::forward<Args>(args)...);
 }
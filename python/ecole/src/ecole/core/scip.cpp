@@ -1,5 +1,9 @@
 #include <algorithm>
+#include <cstddef>
 #include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
 #include <vector>
 
 #include <pybind11/operators.h>
@@ -44,7 +48,12 @@ void bind_submodule(py::module_ m) {
 
 	py::enum_<Type>{m, "Type"}
 		.value("Branchrule", Type::Branchrule)  //
-		.value("Heuristic", Type::Heuristic);
+		.value("Heuristic", Type::Heuristic)
+		.value("Nodesel", Type::Nodesel)
+		.value("Cutsel", Type::Cutsel)
+		.value("Separator", Type::Separator)
+		.value("Presolver", Type::Presolver)
+		.value("EventHandler", Type::EventHandler);
 
 	m.def("name", name, "Return the name used by the reverse callback.");
 
@@ -53,12 +62,16 @@ void bind_submodule(py::module_ m) {
 	m.attr("max_bound_distance_none") = max_bound_distance_none;
 	m.attr("frequency_always") = frequency_always;
 	m.attr("frequency_offset_none") = frequency_offset_none;
+	m.attr("max_rounds_none") = max_rounds_none;
 
 	python::auto_data_class<BranchruleConstructor>(m, "BranchruleConstructor")
 		.def_auto_members(
 			python::Member{"priority", &BranchruleConstructor::priority},
 			python::Member{"max_depth", &BranchruleConstructor::max_depth},
-			python::Member{"max_bound_distance", &BranchruleConstructor::max_bound_distance});
+			python::Member{"max_bound_distance", &BranchruleConstructor::max_bound_distance},
+			python::Member{"yield_lp", &BranchruleConstructor::yield_lp},
+			python::Member{"yield_external", &BranchruleConstructor::yield_external},
+			python::Member{"yield_pseudo", &BranchruleConstructor::yield_pseudo});
 
 	python::auto_data_class<HeuristicConstructor>(m, "HeuristicConstructor")
 		.def_auto_members(
@@ -68,6 +81,29 @@ void bind_submodule(py::module_ m) {
 			python::Member{"max_depth", &HeuristicConstructor::max_depth},
 			python::Member{"timing_mask", &HeuristicConstructor::timing_mask});
 
+	python::auto_data_class<NodeselConstructor>(m, "NodeselConstructor")
+		.def_auto_members(
+			python::Member{"priority", &NodeselConstructor::priority},
+			python::Member{"memsave_priority", &NodeselConstructor::memsave_priority});
+
+	python::auto_data_class<CutselConstructor>(m, "CutselConstructor")
+		.def_auto_members(python::Member{"priority", &CutselConstructor::priority});
+
+	python::auto_data_class<SeparatorConstructor>(m, "SeparatorConstructor")
+		.def_auto_members(
+			python::Member{"priority", &SeparatorConstructor::priority},
+			python::Member{"frequency", &SeparatorConstructor::frequency},
+			python::Member{"max_bound_distance", &SeparatorConstructor::max_bound_distance});
+
+	python::auto_data_class<PresolverConstructor>(m, "PresolverConstructor")
+		.def_auto_members(
+			python::Member{"priority", &PresolverConstructor::priority},
+			python::Member{"max_rounds", &PresolverConstructor::max_rounds},
+			python::Member{"timing_mask", &PresolverConstructor::timing_mask});
+
+	python::auto_data_class<EventHandlerConstructor>(m, "EventHandlerConstructor")
+		.def_auto_members(python::Member{"event_mask", &EventHandlerConstructor::event_mask});
+
 	auto branchrule_call = python::auto_data_class<BranchruleCall>(m, "BranchruleCall");
 	py::enum_<BranchruleCall::Where>(branchrule_call, "Where")
 		.value("LP", BranchruleCall::Where::LP)
@@ -75,12 +111,42 @@ void bind_submodule(py::module_ m) {
 		.value("Pseudo", BranchruleCall::Where::Pseudo);
 	branchrule_call.def_auto_members(
 		python::Member{"allow_add_constraints", &BranchruleCall::allow_add_constraints},
-		python::Member{"where", &BranchruleCall::where});
+		python::Member{"where", &BranchruleCall::where},
+		python::Member{"constructor_index", &BranchruleCall::constructor_index});
 
 	python::auto_data_class<HeuristicCall>(m, "HeuristicCall")
 		.def_auto_members(
 			python::Member{"heuristic_timing", &HeuristicCall::heuristic_timing},
-			python::Member{"node_infeasible", &HeuristicCall::node_infeasible});
+			python::Member{"node_infeasible", &HeuristicCall::node_infeasible},
+			python::Member{"constructor_index", &HeuristicCall::constructor_index});
+
+	// The selected node cannot be set from Python, hence resuming always lets SCIP select the node
+	py::class_<NodeselCall>(m, "NodeselCall");
+
+	python::auto_data_class<CutselCall>(m, "CutselCall")
+		.def_auto_members(
+			python::Member{"n_cuts", &CutselCall::n_cuts},
+			python::Member{"n_forced_cuts", &CutselCall::n_forced_cuts},
+			python::Member{"root", &CutselCall::root},
+			python::Member{"max_n_selected_cuts", &CutselCall::max_n_selected_cuts},
+			python::Member{"constructor_index", &CutselCall::constructor_index});
+
+	python::auto_data_class<SeparatorCall>(m, "SeparatorCall")
+		.def_auto_members(
+			python::Member{"allow_local", &SeparatorCall::allow_local},
+			python::Member{"depth", &SeparatorCall::depth},
+			python::Member{"constructor_index", &SeparatorCall::constructor_index});
+
+	python::auto_data_class<PresolverCall>(m, "PresolverCall")
+		.def_auto_members(
+			python::Member{"n_rounds", &PresolverCall::n_rounds},
+			python::Member{"timing", &PresolverCall::timing},
+			python::Member{"constructor_index", &PresolverCall::constructor_index});
+
+	// The event itself is only valid in the solver thread until resuming, hence only its type is given to Python
+	py::class_<EventHandlerCall>(m, "EventHandlerCall")
+		.def_readonly("event_type", &EventHandlerCall::event_type)
+		.def_readonly("constructor_index", &EventHandlerCall::constructor_index);
 }
 
 }  // namespace callback
@@ -106,6 +172,22 @@ void bind_submodule(py::module_ m) {
 		.value("FreeTrans", SCIP_STAGE_FREETRANS)
 		.value("Free", SCIP_STAGE_FREE);
 
+	py::enum_<PluginProfile>{m, "PluginProfile", R"(
+		The set of SCIP plugins included in a new model.
+
+		Including only the plugins needed makes creating models faster and lighter.
+		Parameters of plugins that are not included do not exist, and copies of a model have the same plugins.
+	)"}
+		.value("Full", PluginProfile::full, "All default SCIP plugins.")
+		.value(
+			"Branching",
+			PluginProfile::branching,
+			"Readers, linear constraints, node selectors, and branching rules, without heuristics or separators.")
+		.value(
+			"Modeling",
+			PluginProfile::modeling,
+			"Readers and linear constraints, to create, read, copy, and write problems, but not solve them.");
+
 	// SCIP_HEURTIMING is simply a collection of Macros! We create a scope for holding the values.
 	struct HeurTiming {};
 	py::class_<HeurTiming>{m, "HeurTiming"}
@@ -127,9 +209,56 @@ void bind_submodule(py::module_ m) {
 
 	callback::bind_submodule(m.def_submodule("callback"));
 
+	python::auto_data_class<MemoryUsage>(m, "MemoryUsage", "Memory held by a Model, in bytes.")
+		.def_auto_members(
+			python::Member{"scip_used", &MemoryUsage::scip_used},
+			python::Member{"scip_total", &MemoryUsage::scip_total},
+			python::Member{"scip_external", &MemoryUsage::scip_external},
+			python::Member{"lp_view", &MemoryUsage::lp_view});
+
 	py::class_<Model>(m, "Model")  //
-		.def_static("from_file", &Model::from_file, py::arg("filepath"), py::call_guard<py::gil_scoped_release>())
-		.def_static("prob_basic", &Model::prob_basic, py::arg("name") = "Model")
+		.def_static(
+			"from_file",
+			&Model::from_file,
+			py::arg("filepath"),
+			py::arg("profile") = PluginProfile::full,
+			py::call_guard<py::gil_scoped_release>())
+		.def_static(
+			"from_buffer",
+			[](py::buffer const& data, std::string const& format, PluginProfile profile) {
+				auto const info = data.request();
+				if (info.ndim > 1 || (info.ndim == 1 && info.strides[0] != info.itemsize)) {
+					throw std::invalid_argument{"The buffer must be contiguous."};
+				}
+				auto const view = std::string_view{
+					static_cast<char const*>(info.ptr), static_cast<std::size_t>(info.size * info.itemsize)};
+				auto const release = py::gil_scoped_release{};
+				return Model::from_buffer(view, format, profile);
+			},
+			py::arg("data"),
+			py::arg("format"),
+			py::arg("profile") = PluginProfile::full,
+			R"(
+			Parse a problem held in memory, such as the bytes of an LP or MPS file.
+
+			Parameters
+			----------
+			data:
+				Any contiguous buffer, such as ``bytes`` or ``memoryview``, with the content of the file.
+			format:
+				The extension of the file format, such as ``"lp"`` or ``"mps"``.
+			profile:
+				The plugins included in the model.
+		)")
+		.def_static(
+			"load_binary",
+			&Model::load_binary,
+			py::arg("filepath"),
+			py::arg("profile") = PluginProfile::full,
+			py::call_guard<py::gil_scoped_release>(),
+			"Read a problem written with ``save_binary``, much faster than parsing text files.")
+		.def_static(
+			"prob_basic", &Model::prob_basic, py::arg("name") = "Model", py::arg("profile") = PluginProfile::full)
 		.def_static(
 			"from_pyscipopt",
 			[](py::object const& pyscipopt_model) {
@@ -149,7 +278,50 @@ void bind_submodule(py::module_ m) {
 		.def(py::self == py::self)  // NOLINT(misc-redundant-expression)  pybind specific syntax
 		.def(py::self != py::self)  // NOLINT(misc-redundant-expression)  pybind specific syntax
 
+		.def(
+			"save_binary",
+			&Model::save_binary,
+			py::arg("filepath"),
+			py::call_guard<py::gil_scoped_release>(),
+			R"(
+			Write the original problem in a compact binary format, read back with ``load_binary``.
+
+			All constraints must have a linear representation, and are read back as linear constraints.
+			Parameters and solutions are not saved.
+		)")
+		.def("is_binary_exact", &Model::is_binary_exact, R"(
+			Whether ``load_binary`` reads back the same problem as written by ``save_binary``.
+
+			That is the case when all constraints are linear, and have default flags, as do variables.
+		)")
+		// Pickled in the binary format, so that models are sent to other processes without parsing text
+		.def(py::pickle(
+			[](Model const& self) {
+				auto data = std::string{};
+				{
+					auto const release = py::gil_scoped_release{};
+					data = self.to_binary();
+				}
+				return py::bytes{data};
+			},
+			[](py::bytes const& state) {
+				char* data = nullptr;
+				auto size = Py_ssize_t{0};
+				if (PyBytes_AsStringAndSize(state.ptr(), &data, &size) != 0) {
+					throw py::error_already_set{};
+				}
+				auto const release = py::gil_scoped_release{};
+				return Model::from_binary(std::string_view{data, static_cast<std::size_t>(size)});
+			}))
 		.def("copy_orig", &Model::copy_orig, py::call_guard<py::gil_scoped_release>())
+		.def("fork", &Model::fork, py::call_guard<py::gil_scoped_release>(), R"(
+			Create a new problem from the subtree of the current node.
+
+			During solving, the new model holds the transformed problem with the local bounds of the current node.
+			Solving it explores a subtree equivalent to the current node, but the branching tree, cuts, and primal
+			solutions found so far are not kept.
+			Before the problem is transformed, this is the same as ``copy_orig``.
+		)")
 		.def(
 			"as_pyscipopt",
 			[](scip::Model& model) {
@@ -162,13 +334,57 @@ void bind_submodule(py::module_ m) {
 			py::keep_alive<0, 1>())
 
 		.def("set_messagehdlr_quiet", &Model::set_messagehdlr_quiet, py::arg("quiet"))
+		.def(
+			"capture_log",
+			&Model::capture_log,
+			py::arg("capacity") = Model::default_log_capacity,
+			R"(
+			Capture the log of SCIP in a ring buffer of the given number of bytes, rather than writing it.
+
+			Messages are copied without locking nor allocating, so that capture can be left on in
+			production, and the log retrieved with :py:meth:`captured_log` after an episode or an
+			exception.
+			The model is no longer quiet, and how much is logged is set by the ``display/verblevel``
+			parameter.
+			A capacity of zero stops capturing.
+		)")
+		.def(
+			"captured_log",
+			&Model::captured_log,
+			"The last captured log, starting at the first full line once older messages are overwritten.")
+		.def("clear_captured_log", &Model::clear_captured_log)
 
 		.def_property("name", &Model::name, &Model::set_name)
 		.def_property_readonly("stage", &Model::stage)
+		.def(
+			"fingerprint",
+			&Model::fingerprint,
+			R"(
+			Return a hash of the problem, to recognize an instance seen previously.
+
+			The hash covers the variables, objective, bounds, and constraints, but not the names, and is the same
+			across reads of a file and copies.
+			Data of constraints that SCIP cannot report, such as nonlinear expressions, are not hashed.
+		)")
+		.def(
+			"exact_fingerprint",
+			&Model::exact_fingerprint,
+			"Return the fingerprint if it covers all the data of the problem, or ``None`` otherwise.")
+
+		.def(
+			"memory_usage",
+			&Model::memory_usage,
+			R"(
+			Return the memory held by the solver, and by Ecole data cached in the model.
+
+			The SCIP ``limits/memory`` parameter (in megabytes) applies to the sum of ``scip_used`` and
+			``scip_external``.
+		)")
 
 		.def("get_param", &Model::get_param<Param>, py::arg("name"))
 		.def("set_param", &Model::set_param<Param>, py::arg("name"), py::arg("value"))
 		.def("get_params", &Model::get_params)
+		.def("get_changed_params", &Model::get_changed_params)
 		.def("set_params", &Model::set_params, py::arg("name_values"))
 		.def("disable_cuts", &Model::disable_cuts)
 		.def("disable_presolve", &Model::disable_presolve)
@@ -195,7 +411,12 @@ void bind_submodule(py::module_ m) {
 				// Call the function
 				return self.solve_iter(args);
 			})
-		.def("solve_iter_continue", &Model::solve_iter_continue);
+		.def("solve_iter_continue", &Model::solve_iter_continue)
+		.def("solve_iter_reclaim", &Model::solve_iter_reclaim, py::call_guard<py::gil_scoped_release>(), R"(
+			Take back the model after a step deadline was set.
+
+			Return whether the solver is still paused on the callback, true when no deadline was set.
+		)");
 }
 
 }  // namespace ecole::scip
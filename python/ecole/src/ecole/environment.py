@@ -1,6 +1,46 @@
 """Ecole collection of environments."""
 
+import asyncio
+
 import ecole
+import ecole.core.metrics
+
+# Shared with the environments of the C++ library
+_n_resets = ecole.core.metrics.counter("ecole_environment_resets_total", "Environment resets.")
+_n_steps = ecole.core.metrics.counter("ecole_environment_steps_total", "Environment transitions.")
+
+
+class LazyObservation:
+    """Handle to the observation of a state, extracted on first access.
+
+    The observation can only be extracted until the environment transitions again, after which it
+    remains available for as long as the handle.
+    """
+
+    def __init__(self, environment, done):
+        self._environment = environment
+        self._state_id = environment._state_id
+        self._done = done
+        self._extracted = False
+        self._observation = None
+
+    @property
+    def is_extracted(self):
+        """Whether the observation was extracted."""
+        return self._extracted
+
+    def get(self):
+        """Extract the observation if it was not already, and return it."""
+        if not self._extracted:
+            if self._environment._state_id != self._state_id:
+                raise ecole.MarkovError(
+                    "The environment transitioned before the observation was extracted."
+                )
+            if not self._done:
+                env = self._environment
+                self._observation = env.observation_function.extract(env.model, self._done)
+            self._extracted = True
+        return self._observation
 
 
 class Environment:
@@ -21,6 +61,8 @@ class Environment:
         reward_function=ecole.Default,
         information_function=ecole.Default,
         scip_params=None,
+        lazy_observation=False,
+        memory_limit=None,
         **dynamics_kwargs
     ) -> None:
         """Create a new environment object.
@@ -38,6 +80,15 @@ class Environment:
             additional information returned by :meth:`reset` and :meth:`step`.
         scip_params:
             Parameters set on the underlying :py:class:`~ecole.scip.Model` at the start of every episode.
+        lazy_observation:
+            If true, :meth:`reset` and :meth:`step` return a :py:class:`LazyObservation` in place of the
+            observation, which is only extracted if accessed before the next transition.
+            The observation is then extracted after the information.
+        memory_limit:
+            The memory, in bytes, that the model of an episode may use, or ``None`` for no limit.
+            It is set as the SCIP ``limits/memory`` parameter of every episode, overriding
+            ``scip_params``, so that the episode terminates when it is reached, and can be compared with
+            :py:meth:`ecole.scip.Model.memory_usage`.
         **dynamics_kwargs:
             Other arguments are passed to the constructor of the :py:class:`~ecole.typing.Dynamics`.
 
@@ -55,6 +106,9 @@ class Environment:
         self.dynamics = self.__Dynamics__(**dynamics_kwargs)
         self.can_transition = False
         self.rng = ecole.spawn_random_generator()
+        self.lazy_observation = lazy_observation
+        self.memory_limit = memory_limit
+        self._state_id = 0
 
     def reset(self, instance, *dynamics_args, **dynamics_kwargs):
         """Start a new episode.
@@ -100,12 +154,16 @@ class Environment:
 
         """
         self.can_transition = True
+        self._state_id += 1
         try:
             if isinstance(instance, ecole.core.scip.Model):
                 self.model = instance.copy_orig()
             else:
                 self.model = ecole.core.scip.Model.from_file(instance)
             self.model.set_params(self.scip_params)
+            if self.memory_limit is not None:
+                # SCIP memory limit is in megabytes
+                self.model.set_param("limits/memory", self.memory_limit / 2 ** 20)
 
             self.dynamics.set_dynamics_random_state(self.model, self.rng)
 
@@ -119,14 +177,17 @@ class Environment:
                 self.model, *dynamics_args, **dynamics_kwargs
             )
             self.can_transition = not done
+            _n_resets.add()
 
             # Extract additional information to be returned by reset
             reward_offset = self.reward_function.extract(self.model, done)
-            if not done:
-                observation = self.observation_function.extract(self.model, done)
+            if self.lazy_observation:
+                information = self.information_function.extract(self.model, done)
+                observation = LazyObservation(self, done)
             else:
-                observation = None
-            information = self.information_function.extract(self.model, done)
+                observation = self._extract_observation(done)
+                information = self.information_function.extract(self.model, done)
+                self._start_step_deadline(done)
 
             return observation, action_set, reward_offset, done, information
         except Exception as e:
@@ -174,27 +235,94 @@ class Environment:
         """
         if not self.can_transition:
             raise ecole.MarkovError("Environment need to be reset.")
+        self._state_id += 1
 
         try:
             # Transition the environment to the next state
             done, action_set = self.dynamics.step_dynamics(
                 self.model, action, *dynamics_args, **dynamics_kwargs
             )
-            self.can_transition = not done
+            return self._step_result(done, action_set)
+        except Exception as e:
+            self.can_transition = False
+            raise e
 
-            # Extract additional information to be returned by step
-            reward = self.reward_function.extract(self.model, done)
-            if not done:
-                observation = self.observation_function.extract(self.model, done)
-            else:
-                observation = None
-            information = self.information_function.extract(self.model, done)
+    async def step_async(self, action, *dynamics_args, **dynamics_kwargs):
+        """Transition from one state to another without blocking the event loop.
 
-            return observation, action_set, reward, done, information
-        except Exception as e:
+        Same as :meth:`step`, except that the transition runs on a thread of Ecole, which completes
+        the awaited future through the event loop.
+        Many environments can thus be driven concurrently by a single thread, for instance with
+        :py:func:`asyncio.gather`.
+        Data functions are still called in the thread of the event loop, once the transition is
+        done.
+
+        Another transition cannot start before the awaited one is done.
+        Cancelling the awaiting task does not interrupt the transition, after which the environment
+        needs to be reset.
+        """
+        if not self.can_transition:
+            raise ecole.MarkovError("Environment need to be reset.")
+        self._state_id += 1
+        self.can_transition = False
+
+        try:
+            loop = asyncio.get_running_loop()
+            done, action_set = await ecole.core.environment.call_async(
+                loop,
+                self.dynamics.step_dynamics,
+                self.model,
+                action,
+                *dynamics_args,
+                **dynamics_kwargs
+            )
+            return self._step_result(done, action_set)
+        except BaseException as e:
             self.can_transition = False
             raise e
 
+    def _step_result(self, done, action_set):
+        self.can_transition = not done
+        _n_steps.add()
+
+        # Extract additional information to be returned by step
+        reward = self.reward_function.extract(self.model, done)
+        if self.lazy_observation:
+            information = self.information_function.extract(self.model, done)
+            observation = LazyObservation(self, done)
+        else:
+            observation = self._extract_observation(done)
+            information = self.information_function.extract(self.model, done)
+            self._start_step_deadline(done)
+
+        return observation, action_set, reward, done, information
+
+    def _extract_observation(self, done):
+        if done:
+            return None
+        return self.observation_function.extract(self.model, done)
+
+    def _start_step_deadline(self, done):
+        # The model is left to the solver of dynamics with a deadline once the state is extracted
+        if not done and hasattr(self.dynamics, "start_step_deadline"):
+            self.dynamics.start_step_deadline(self.model)
+
+    def snapshot(self) -> ecole.core.scip.Model:
+        """Capture the current state to later branch differently from it.
+
+        The snapshot is a new problem equivalent to the current node (see :py:meth:`ecole.scip.Model.fork`).
+        Passing it to :py:meth:`reset` starts a new episode from that node, and it can be reused for as many
+        resets as desired.
+        The step deadline of the current state, if any, is stopped first, since the solver must not
+        run while copying.
+        A :py:class:`ecole.MarkovError` is raised if the deadline has already passed.
+        """
+        if not self.model.solve_iter_reclaim():
+            raise ecole.MarkovError(
+                "The state cannot be captured after its step deadline has passed."
+            )
+        return self.model.fork()
+
     def seed(self, value: int) -> None:
         """Set the random seed of the environment.
 
@@ -207,6 +335,22 @@ class Environment:
         """
         self.rng.seed(value)
 
+    def save_state(self) -> bytes:
+        """Save the state carried by the environment from one episode to the next.
+
+        This is the :py:class:`~ecole.RandomGenerator` from which the randomness of every episode
+        is drawn, so that an environment restored with :py:meth:`load_state`, then reset on the
+        same instances, runs the same episodes.
+        The state of the ongoing episode, held by the model, is not saved.
+        """
+        return self.rng.__getstate__()
+
+    def load_state(self, state: bytes) -> None:
+        """Restore a state returned by :py:meth:`save_state`, taking effect from the next reset."""
+        rng = ecole.RandomGenerator.__new__(ecole.RandomGenerator)
+        rng.__setstate__(state)
+        self.rng = rng
+
 
 class Branching(Environment):
     __Dynamics__ = ecole.dynamics.BranchingDynamics
@@ -220,3 +364,18 @@ class Configuring(Environment):
 class PrimalSearch(Environment):
     __Dynamics__ = ecole.dynamics.PrimalSearchDynamics
     __DefaultObservationFunction__ = ecole.observation.NodeBipartite
+
+
+class NodeSelection(Environment):
+    __Dynamics__ = ecole.dynamics.NodeSelectionDynamics
+
+
+class CutSelection(Environment):
+    __Dynamics__ = ecole.dynamics.CutSelectionDynamics
+
+
+# Environments implemented in C++, restricted to built-in observation and reward functions.
+NativeBranching = ecole.core.environment.Branching
+NativeConfiguring = ecole.core.environment.Configuring
+NativePrimalSearch = ecole.core.environment.PrimalSearch
+NativeVectorBranching = ecole.core.environment.VectorBranching
@@ -1 +1,95 @@
+import numpy as np
+
 from ecole.core.observation import *
+
+
+def _share(value):
+    """A read-only view of an array, or a copy on write wrapper of an observation struct."""
+    if isinstance(value, np.ndarray):
+        view = value.view()
+        view.flags.writeable = False
+        return view
+    if isinstance(getattr(value, "__getstate__", lambda: None)(), dict):
+        return CopyOnWrite(value)
+    return value
+
+
+def _freeze(value):
+    if isinstance(value, np.ndarray):
+        value.flags.writeable = False
+    return value
+
+
+class CopyOnWrite:
+    """Observation struct sharing its arrays with its copies until they are modified.
+
+    Wrapping an observation, and copying the wrapper with :py:func:`copy.copy`, take constant time:
+    attributes are read-only views on the arrays of the observation, which are shared by all copies.
+    Assigning an attribute only replaces it in one copy, and :py:meth:`writable` copies one array,
+    so that only the modified arrays are copied, as by data augmentation in replay buffers.
+    Nested structs, such as sparse matrices, are wrapped as well.
+
+    The wrapped observation must not be modified in place afterward, since its arrays are shared.
+    """
+
+    __slots__ = ("_type", "_fields", "_owned")
+
+    def __init__(self, obs):
+        object.__setattr__(self, "_type", type(obs))
+        object.__setattr__(self, "_fields", {k: _share(v) for k, v in obs.__getstate__().items()})
+        object.__setattr__(self, "_owned", set())
+
+    def __getattr__(self, name):
+        # Private attributes are missing before unpickling, and must not be looked up in the fields
+        if name.startswith("_"):
+            raise AttributeError(name)
+        try:
+            return self._fields[name]
+        except KeyError:
+            raise AttributeError(name) from None
+
+    def __setattr__(self, name, value):
+        """Replace an attribute in this copy only."""
+        if name not in self._fields:
+            raise AttributeError(name)
+        self._fields[name] = value if isinstance(value, np.ndarray) else _share(value)
+        self._owned.add(name)
+
+    def writable(self, name):
+        """The array of an attribute, for modification in place, copied first if it is shared.
+
+        Nested structs are returned as their own copy on write wrapper.
+        """
+        if isinstance(self._fields[name], CopyOnWrite):
+            return self._fields[name]
+        if name not in self._owned:
+            self._fields[name] = np.array(self._fields[name])
+            self._owned.add(name)
+        return self._fields[name]
+
+    def __copy__(self):
+        copy = CopyOnWrite.__new__(CopyOnWrite)
+        # Arrays owned so far become shared, so they are frozen to not change the copy in place
+        fields = {k: _freeze(v) for k, v in self._fields.items()}
+        fields = {k: v.__copy__() if isinstance(v, CopyOnWrite) else v for k, v in fields.items()}
+        object.__setattr__(copy, "_type", self._type)
+        object.__setattr__(copy, "_fields", fields)
+        object.__setattr__(copy, "_owned", set())
+        self._owned.clear()
+        return copy
+
+    def __deepcopy__(self, memo):
+        return CopyOnWrite(self.materialize())
+
+    def materialize(self):
+        """Copy the arrays in a new observation struct of the wrapped type."""
+        obj = self._type.__new__(self._type)
+        materialized = lambda v: v.materialize() if isinstance(v, CopyOnWrite) else v
+        obj.__setstate__({k: materialized(v) for k, v in self._fields.items()})
+        return obj
+
+    def __getstate__(self):
+        return self.materialize()
+
+    def __setstate__(self, obs):
+        CopyOnWrite.__init__(self, obs)
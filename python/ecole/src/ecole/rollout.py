@@ -0,0 +1,376 @@
+"""Environments run in worker processes, publishing observations through shared memory.
+
+Every worker process owns an environment and a ring buffer of slots in a POSIX shared memory segment.
+Observations are written in a free slot, with one array per tensor of the observation, and only a
+small description of their layout is sent to the trainer process, which reads the arrays without copy.
+"""
+
+import multiprocessing
+import multiprocessing.connection
+import os
+import pickle
+import types
+
+import numpy as np
+
+import ecole
+
+
+_ALIGNMENT = 64
+
+
+def _shared_memory():
+    try:
+        from multiprocessing import shared_memory
+    except ImportError as e:  # Python < 3.8
+        raise RuntimeError("Shared memory rollouts require Python 3.8 or later.") from e
+    return shared_memory
+
+
+def _flatten(obj, arrays):
+    """Describe the layout of an observation, appending its arrays to the given list."""
+    if obj is None:
+        return None
+    if isinstance(obj, np.ndarray):
+        arrays.append(np.ascontiguousarray(obj))
+        return ("array", len(arrays) - 1)
+    if isinstance(obj, tuple):
+        return ("tuple", [_flatten(o, arrays) for o in obj])
+    if isinstance(obj, list):
+        return ("list", [_flatten(o, arrays) for o in obj])
+    if isinstance(obj, dict):
+        return ("dict", {k: _flatten(v, arrays) for k, v in obj.items()})
+    # Ecole observation structs are pickled from their attributes
+    state = obj.__getstate__() if hasattr(obj, "__getstate__") else None
+    if isinstance(state, dict):
+        return ("struct", type(obj), {k: _flatten(v, arrays) for k, v in state.items()})
+    return ("object", obj)
+
+
+def _unflatten(layout, arrays, materialize):
+    """Rebuild an observation from its layout, as views on the arrays or as Ecole objects."""
+    if layout is None:
+        return None
+    kind = layout[0]
+    if kind == "array":
+        return arrays[layout[1]]
+    if kind == "tuple":
+        return tuple(_unflatten(o, arrays, materialize) for o in layout[1])
+    if kind == "list":
+        return [_unflatten(o, arrays, materialize) for o in layout[1]]
+    if kind == "dict":
+        return {k: _unflatten(v, arrays, materialize) for k, v in layout[1].items()}
+    if kind == "struct":
+        _, cls, fields = layout
+        fields = {k: _unflatten(v, arrays, materialize) for k, v in fields.items()}
+        if not materialize:
+            return types.SimpleNamespace(**fields)
+        obj = cls.__new__(cls)
+        obj.__setstate__(fields)
+        return obj
+    return layout[1]
+
+
+def _aligned(n_bytes):
+    return (n_bytes + _ALIGNMENT - 1) // _ALIGNMENT * _ALIGNMENT
+
+
+class _RingBuffer:
+    """Fixed size slots in a shared memory segment, handed out in order."""
+
+    def __init__(self, n_slots, slot_size, name=None):
+        shared_memory = _shared_memory()
+        self.n_slots = n_slots
+        self.slot_size = _aligned(slot_size)
+        if name is None:
+            self.memory = shared_memory.SharedMemory(create=True, size=self.n_slots * self.slot_size)
+        else:
+            self.memory = shared_memory.SharedMemory(name=name)
+
+    def write(self, slot, arrays):
+        """Copy the arrays in the slot and return their descriptions, or None if they do not fit."""
+        descriptions = []
+        offset = 0
+        for array in arrays:
+            descriptions.append((array.dtype.str, array.shape, offset))
+            offset += _aligned(array.nbytes)
+        if offset > self.slot_size:
+            return None
+        base = slot * self.slot_size
+        for array, (_, _, array_offset) in zip(arrays, descriptions):
+            start = base + array_offset
+            self.memory.buf[start : start + array.nbytes] = array.reshape(-1).view(np.uint8)
+        return descriptions
+
+    def read(self, slot, descriptions):
+        """Views on the arrays of a slot."""
+        base = slot * self.slot_size
+        return [
+            np.ndarray(shape, dtype=np.dtype(dtype), buffer=self.memory.buf, offset=base + offset)
+            for dtype, shape, offset in descriptions
+        ]
+
+
+def _worker_main(make_env, connection, memory_name, n_slots, slot_size, free_slots, cpus):
+    """Loop of worker processes, running environment commands sent through the connection."""
+    if cpus is not None:
+        # Before creating the environment, so that its memory is allocated on the node of the CPUs
+        os.sched_setaffinity(0, cpus)
+    ring = _RingBuffer(n_slots, slot_size, name=memory_name)
+    env = make_env()
+    next_slot = 0
+    try:
+        while True:
+            command, args, kwargs = connection.recv()
+            if command == "close":
+                break
+            try:
+                if command == "seed":
+                    env.seed(*args)
+                    connection.send(("ok", None))
+                    continue
+                observation, action_set, reward, done, info = getattr(env, command)(*args, **kwargs)
+                arrays = []
+                layout = _flatten(observation, arrays)
+                free_slots.acquire()
+                descriptions = ring.write(next_slot, arrays)
+                if descriptions is None:
+                    # Too large for a slot, the observation is pickled through the connection
+                    free_slots.release()
+                    payload = ("pickled", pickle.dumps(observation))
+                else:
+                    payload = ("shared", next_slot, layout, descriptions)
+                    next_slot = (next_slot + 1) % n_slots
+                connection.send(("transition", (payload, action_set, reward, done, info)))
+            except Exception as e:
+                connection.send(("error", e))
+    finally:
+        ring.memory.close()
+
+
+class _Inherited:
+    """Give a forked worker the environment created before forking."""
+
+    def __init__(self, env):
+        self.env = env
+
+    def __call__(self):
+        env, self.env = self.env, None
+        return env
+
+
+class SharedObservation:
+    """Observation read from the shared memory slot of a worker.
+
+    The arrays of :py:attr:`view` are views on the slot, which is handed back to the worker by
+    :py:meth:`release`, after which they must not be used anymore.
+    """
+
+    def __init__(self, ring, free_slots, payload):
+        self._free_slots = free_slots
+        if payload[0] == "pickled":
+            self._arrays = None
+            self.view = pickle.loads(payload[1])
+            self._layout = None
+        else:
+            _, slot, layout, descriptions = payload
+            self._arrays = ring.read(slot, descriptions)
+            self._layout = layout
+            self.view = _unflatten(layout, self._arrays, materialize=False)
+
+    def copy(self):
+        """Copy the observation out of shared memory, as the original observation object."""
+        if self._layout is None:
+            return self.view
+        if self._arrays is None:
+            raise ValueError("The observation was released.")
+        return _unflatten(self._layout, [a.copy() for a in self._arrays], materialize=True)
+
+    def release(self):
+        """Hand the slot back to the worker."""
+        if self._arrays is not None:
+            self._arrays = None
+            self.view = None
+            self._free_slots.release()
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.release()
+
+
+class RolloutServer:
+    """Environments stepped in worker processes, with observations in shared memory.
+
+    Contrary to threads, worker processes do not share the GIL, nor the process wide state of SCIP.
+    Observations are written by workers in the shared memory ring buffer of their environment, and
+    returned as :py:class:`SharedObservation`, whose arrays are read by the trainer without copy,
+    with the same attributes as observation structs.
+    A worker can be ahead of the trainer by up to ``n_slots`` unreleased observations, after which it
+    waits for the trainer to release one.
+    Observations exceeding ``slot_size`` bytes are pickled instead.
+
+    The API follows the asynchronous part of ``VectorEnvironment``: commands are sent to a worker with
+    :py:meth:`reset_async` and :py:meth:`step_async`, and collected in order of completion with
+    :py:meth:`wait_any`.
+    """
+
+    def __init__(
+        self,
+        make_env,
+        n_workers,
+        n_slots=4,
+        slot_size=64 * 2 ** 20,
+        cpus=None,
+        start_method="spawn",
+    ):
+        """Start the worker processes.
+
+        Parameters
+        ----------
+        make_env:
+            A callable creating the environment of a worker, such as a ``functools.partial`` of
+            an environment class with its arguments, which must be picklable unless forking.
+        n_workers:
+            The number of worker processes, each with its own environment.
+        n_slots:
+            The number of observations a worker can publish before they are released.
+        slot_size:
+            The size in bytes of a slot of the ring buffers.
+        cpus:
+            The CPUs of every worker, for instance the SMT siblings of a different physical core
+            for each worker, applied with ``os.sched_setaffinity`` on Linux.
+            The solver of a worker runs on the same CPUs, and the memory of its environment stays
+            on their NUMA node.
+            By default, workers run on any CPU.
+        start_method:
+            How worker processes are started, as in ``multiprocessing.get_context``.
+            With ``"fork"``, Ecole is prewarmed (see :py:func:`ecole.prewarm`), and environments
+            are created in the trainer process before forking, so that workers start without
+            importing Ecole nor creating SCIP, and share their memory until they modify it.
+            No Ecole thread may be running when forking (see :py:func:`ecole.check_fork_safe`),
+            and the memory of the environments is then allocated before the CPUs are set.
+
+        """
+        if cpus is not None and len(cpus) != n_workers:
+            raise ValueError("RolloutServer needs a set of CPUs for every worker.")
+        context = multiprocessing.get_context(start_method)
+        forking = start_method == "fork"
+        if forking:
+            ecole.prewarm()
+        self._rings = []
+        self._free_slots = []
+        self._connections = []
+        self._processes = []
+        self._pending = [False] * n_workers
+        for i in range(n_workers):
+            ring = _RingBuffer(n_slots, slot_size)
+            free_slots = context.Semaphore(n_slots)
+            parent, child = context.Pipe()
+            worker_make_env = _Inherited(make_env()) if forking else make_env
+            if forking:
+                ecole.check_fork_safe()
+            process = context.Process(
+                target=_worker_main,
+                args=(
+                    worker_make_env,
+                    child,
+                    ring.memory.name,
+                    n_slots,
+                    slot_size,
+                    free_slots,
+                    None if cpus is None else list(cpus[i]),
+                ),
+                daemon=True,
+            )
+            process.start()
+            # The worker has its own copy of an inherited environment
+            del worker_make_env
+            child.close()
+            self._rings.append(ring)
+            self._free_slots.append(free_slots)
+            self._connections.append(parent)
+            self._processes.append(process)
+
+    def __len__(self):
+        return len(self._processes)
+
+    def seed(self, value):
+        """Seed every environment, from a different stream of the given seed."""
+        rng = ecole.RandomGenerator(value)
+        for i, connection in enumerate(self._connections):
+            self._check_not_pending(i)
+            seed = ecole.derive_random_generator(rng, i)()
+            connection.send(("seed", (seed,), {}))
+            status, error = connection.recv()
+            if status == "error":
+                raise error
+
+    def reset_async(self, i, instance, *dynamics_args, **dynamics_kwargs):
+        """Reset the environment of worker ``i`` without waiting for it."""
+        self._send(i, "reset", (instance,) + dynamics_args, dynamics_kwargs)
+
+    def step_async(self, i, action, *dynamics_args, **dynamics_kwargs):
+        """Transition the environment of worker ``i`` without waiting for it."""
+        self._send(i, "step", (action,) + dynamics_args, dynamics_kwargs)
+
+    @property
+    def n_pending(self):
+        """The number of commands not yet collected by :py:meth:`wait_any`."""
+        return sum(self._pending)
+
+    def wait_any(self):
+        """Wait for the first pending command to complete.
+
+        Returns
+        -------
+        i:
+            The index of the worker.
+        transition:
+            The ``(observation, action_set, reward, done, info)`` of the environment, where the
+            observation is a :py:class:`SharedObservation`.
+
+        """
+        if self.n_pending == 0:
+            raise ecole.MarkovError("No pending asynchronous transition.")
+        pending = [c for c, p in zip(self._connections, self._pending) if p]
+        connection = multiprocessing.connection.wait(pending)[0]
+        i = self._connections.index(connection)
+        self._pending[i] = False
+        status, message = connection.recv()
+        if status == "error":
+            raise message
+        payload, action_set, reward, done, info = message
+        observation = SharedObservation(self._rings[i], self._free_slots[i], payload)
+        return i, (observation, action_set, reward, done, info)
+
+    def close(self):
+        """Stop the worker processes and free the shared memory."""
+        for connection, process in zip(self._connections, self._processes):
+            if process.is_alive():
+                connection.send(("close", (), {}))
+        for connection, process in zip(self._connections, self._processes):
+            process.join()
+            connection.close()
+        for ring in self._rings:
+            ring.memory.close()
+            ring.memory.unlink()
+        self._processes = []
+        self._connections = []
+        self._rings = []
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def _check_not_pending(self, i):
+        if self._pending[i]:
+            raise ecole.MarkovError(f"Worker {i} already has a pending asynchronous transition.")
+
+    def _send(self, i, command, args, kwargs):
+        self._check_not_pending(i)
+        self._connections[i].send((command, args, kwargs))
+        self._pending[i] = True
@@ -0,0 +1,255 @@
+"""Vector environments following the ``VectorEnv`` protocol of Gymnasium.
+
+Environments are either stepped by threads in C++, with the GIL released once for all of them, or
+by worker processes publishing their observations through shared memory, so that observations are
+never pickled.
+Gymnasium is not needed: the protocol is followed by duck typing.
+"""
+
+import functools
+
+import numpy as np
+
+import ecole
+import ecole.rollout
+
+
+class Environment:
+    """Many environments stepped together, as a Gymnasium ``VectorEnv``.
+
+    Episodes are drawn from an iterable of instances, and automatically reset in the ``NextStep``
+    mode of Gymnasium: an environment that terminates is reset on the following call to
+    :py:meth:`step`, which ignores its action and returns the first observation of its new episode
+    with a zero reward.
+    The Ecole action sets, which change at every transition, are returned in the ``"action_set"``
+    entry of the information, with one array per environment.
+
+    With the ``"thread"`` backend, environments are a
+    :py:class:`~ecole.environment.NativeVectorBranching`, whose bipartite graph observations are
+    concatenated into a single :py:class:`~ecole.observation.NodeBipartiteBatch`, with the offsets
+    of every environment.
+    With the ``"process"`` backend, environments run in the worker processes of a
+    :py:class:`~ecole.rollout.RolloutServer`, and observations are a tuple with the view of every
+    environment in the shared memory of its worker
+    (see :py:class:`~ecole.rollout.SharedObservation`), or ``None`` for terminal states.
+    These views are only valid until the next call to :py:meth:`reset` or :py:meth:`step`: they must
+    be copied to be kept longer.
+    """
+
+    metadata = {"autoreset_mode": "NextStep"}
+    # Observations are graphs and action sets change at every transition, so no space is defined
+    single_observation_space = None
+    single_action_space = None
+    observation_space = None
+    action_space = None
+
+    def __init__(
+        self,
+        n_envs,
+        instances,
+        backend="thread",
+        make_env=None,
+        n_slots=2,
+        slot_size=64 * 2 ** 20,
+        auto_reset=False,
+        **env_kwargs
+    ):
+        """Create the environments.
+
+        Parameters
+        ----------
+        n_envs:
+            The number of environments.
+        instances:
+            An iterable of instances, either all file paths or all :py:class:`~ecole.scip.Model`,
+            such as an instance generator, from which every new episode takes the next one.
+        backend:
+            Either ``"thread"`` or ``"process"``.
+        make_env:
+            With the ``"process"`` backend, a picklable callable creating the environment of a
+            worker, by default a :py:class:`~ecole.environment.Branching` environment.
+        n_slots:
+            With the ``"process"`` backend, the number of shared memory slots of every worker.
+            One is enough, since observations are released on the next call.
+        slot_size:
+            With the ``"process"`` backend, the size in bytes of a shared memory slot.
+        auto_reset:
+            With the ``"thread"`` backend, whether to reset terminated environments in the
+            background, as soon as they terminate, so that the following call to :py:meth:`step`
+            does not wait for the new episodes
+            (see :py:meth:`~ecole.environment.NativeVectorBranching.set_auto_reset`).
+            The instances must then be one of the instance generators of Ecole, which is copied,
+            so the given generator is not advanced.
+        **env_kwargs:
+            The arguments of the environments, passed to
+            :py:class:`~ecole.environment.NativeVectorBranching` with the ``"thread"`` backend, or
+            to the default environment of the ``"process"`` backend.
+
+        """
+        self.num_envs = n_envs
+        self.backend = backend
+        self._instances = iter(instances)
+        self._dones = np.ones(n_envs, dtype=bool)
+        self._observations = []
+        if backend == "thread":
+            if make_env is not None:
+                raise ValueError("The thread backend only runs NativeVectorBranching environments.")
+            self._envs = ecole.environment.NativeVectorBranching(n_envs, **env_kwargs)
+            self._server = None
+            if auto_reset:
+                self._envs.set_auto_reset(instances)
+        elif backend == "process":
+            if auto_reset:
+                raise ValueError("Only the thread backend resets environments in the background.")
+            if make_env is None:
+                make_env = functools.partial(ecole.environment.Branching, **env_kwargs)
+            elif env_kwargs:
+                raise ValueError("Environment arguments are given to make_env or as keywords.")
+            self._envs = None
+            self._server = ecole.rollout.RolloutServer(make_env, n_envs, n_slots, slot_size)
+        else:
+            raise ValueError(f"Unknown backend {backend!r}, expected 'thread' or 'process'.")
+
+    def reset(self, seed=None, options=None):
+        """Reset every environment on a new instance.
+
+        Parameters
+        ----------
+        seed:
+            If given, every environment is seeded from a different stream of the seed.
+        options:
+            Unused, accepted for compatibility with Gymnasium.
+
+        Returns
+        -------
+        observations:
+            The batched observations of the initial states.
+        infos:
+            The action sets of all environments, and their reward offsets in ``"reward_offset"``.
+
+        """
+        self._release()
+        if seed is not None:
+            (self._envs if self._server is None else self._server).seed(seed)
+        if self._server is None and self._envs.auto_reset:
+            observations, action_sets, rewards, dones, _ = self._envs.reset()
+            action_sets = _split(*action_sets)
+        elif self._server is None:
+            instances = self._next_instances(self.num_envs)
+            observations, action_sets, rewards, dones, _ = self._envs.reset(instances)
+            action_sets = _split(*action_sets)
+        else:
+            for i, instance in enumerate(self._next_instances(self.num_envs)):
+                self._server.reset_async(i, instance)
+            observations, action_sets, rewards, dones = self._wait_all()
+        self._dones = np.asarray(dones, dtype=bool)
+        return observations, {"action_set": action_sets, "reward_offset": np.asarray(rewards)}
+
+    def step(self, actions):
+        """Transition every environment, and reset the ones whose episode terminated.
+
+        Parameters
+        ----------
+        actions:
+            One action per environment, ignored for the environments that are reset.
+
+        Returns
+        -------
+        observations:
+            The batched observations of the new states.
+        rewards:
+            The reward of every environment, zero for the environments that are reset.
+        terminations:
+            Whether every environment reached a terminal state.
+        truncations:
+            Always false, since episodes are only limited through the parameters of the solver.
+        infos:
+            The action sets of all environments.
+
+        """
+        self._release()
+        resets = self._dones.copy()
+        if self._server is None and self._envs.auto_reset:
+            # Environments that terminated are already being reset
+            observations, action_sets, rewards, dones, _ = self._envs.step(actions)
+            action_sets = _split(*action_sets)
+        elif self._server is None:
+            instances = self._next_instances(int(resets.sum()))
+            if resets.any():
+                result = self._envs.step_or_reset(actions, instances)
+            else:
+                result = self._envs.step(actions)
+            observations, action_sets, rewards, dones, _ = result
+            action_sets = _split(*action_sets)
+        else:
+            instances = iter(self._next_instances(int(resets.sum())))
+            for i, reset in enumerate(resets):
+                if reset:
+                    self._server.reset_async(i, next(instances))
+                else:
+                    self._server.step_async(i, actions[i])
+            observations, action_sets, rewards, dones = self._wait_all()
+        self._dones = np.asarray(dones, dtype=bool)
+        rewards = np.where(resets, 0.0, np.asarray(rewards, dtype=np.float64))
+        truncations = np.zeros(self.num_envs, dtype=bool)
+        return observations, rewards, self._dones.copy(), truncations, {"action_set": action_sets}
+
+    def close(self):
+        """Stop the worker processes, if any, and release their shared memory."""
+        self._release()
+        if self._server is not None:
+            self._server.close()
+            self._server = None
+        self._envs = None
+
+    def __len__(self):
+        return self.num_envs
+
+    def __enter__(self):
+        return self
+
+    def __exit__(self, *args):
+        self.close()
+
+    def _next_instances(self, n):
+        instances = []
+        for _ in range(n):
+            try:
+                instances.append(next(self._instances))
+            except StopIteration as e:
+                raise ValueError("The iterable of instances is exhausted.") from e
+        return instances
+
+    def _release(self):
+        for observation in self._observations:
+            observation.release()
+        self._observations = []
+
+    def _wait_all(self):
+        """Collect the pending transitions of all workers, in the order of the environments."""
+        transitions = [None] * self.num_envs
+        error = None
+        while self._server.n_pending > 0:
+            try:
+                i, transition = self._server.wait_any()
+                transitions[i] = transition
+            except Exception as e:
+                error = e if error is None else error
+        if error is not None:
+            # All environments start new episodes on the next step
+            for transition in transitions:
+                if transition is not None:
+                    transition[0].release()
+            self._dones[:] = True
+            raise error
+        self._observations = [t[0] for t in transitions]
+        observations = tuple(o.view for o in self._observations)
+        action_sets = tuple(t[1] for t in transitions)
+        rewards = [t[2] for t in transitions]
+        dones = [t[3] for t in transitions]
+        return observations, action_sets, rewards, dones
+
+
+def _split(values, offsets):
+    """The action set of every environment, as views on the concatenated ones."""
+    return tuple(values[begin:end] for begin, end in zip(offsets[:-1], offsets[1:]))
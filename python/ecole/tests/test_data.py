@@ -1,6 +1,7 @@
 import itertools
 import unittest.mock as mock
 
+import numpy as np
 import pytest
 
 import ecole
@@ -51,6 +52,41 @@ def test_MapFunction(model, done):
     assert data == {"name1": "something", "name2": "else"}
 
 
+def test_VectorFunction_mixed(model):
+    """Functions of Ecole and Python are mixed, each returning its data in its place."""
+    py_func = mock.MagicMock()
+    py_func.extract.return_value = "python"
+    obs_func = ecole.data.VectorFunction(
+        ecole.observation.Pseudocosts(), py_func, ecole.reward.NNodes(), ecole.observation.Nothing()
+    )
+    map_func = ecole.data.MapFunction(pseudocosts=ecole.observation.Pseudocosts(), python=py_func)
+
+    obs_func.before_reset(model)
+    map_func.before_reset(model)
+    pytest.helpers.advance_to_stage(model, ecole.scip.Stage.Solving)
+    pseudocosts, python, n_nodes, nothing = obs_func.extract(model, False)
+    assert isinstance(pseudocosts, np.ndarray)
+    assert python == "python"
+    assert isinstance(n_nodes, float)
+    assert nothing is None
+    data = map_func.extract(model, False)
+    assert list(data) == ["pseudocosts", "python"]
+    np.testing.assert_array_equal(data["pseudocosts"], pseudocosts)
+
+
+def test_VectorFunction_mixed_order(model):
+    """Functions of Ecole and Python are called in order, seeing the changes of the previous ones."""
+    py_func = mock.MagicMock()
+    py_func.extract.side_effect = lambda model, done: pytest.helpers.advance_to_stage(
+        model, ecole.scip.Stage.Solving
+    )
+    obs_func = ecole.data.VectorFunction(ecole.observation.Pseudocosts(), py_func)
+    obs_func.before_reset(model)
+    pseudocosts, _ = obs_func.extract(model, False)
+    assert pseudocosts is None
+    assert model.stage == ecole.scip.Stage.Solving
+
+
 @pytest.mark.parametrize("done", (True, False))
 @pytest.mark.parametrize("wall", (True, False))
 def test_TimedFunction(model, done, wall):
@@ -66,6 +102,12 @@ def test_TimedFunction(model, done, wall):
     assert time > 0
 
 
+def test_TimedFunction_needs_one_clock():
+    """The wall time and the thread CPU time cannot be both requested."""
+    with pytest.raises(ValueError):
+        ecole.data.TimedFunction(mock.MagicMock(), wall=True, thread_cpu=True)
+
+
 def test_parse_None():
     """None is parsed as NoneFunction."""
     assert isinstance(ecole.data.parse(None, mock.MagicMock()), ecole.data.NoneFunction)
@@ -138,3 +180,54 @@ def test_parse_recursive_default(model):
     assert isinstance(data["name2"], list)
     assert data["name2"][1] is None
     assert data["name2"][2] == 1
+
+
+@pytest.mark.parametrize("delta_integers", (True, False))
+def test_trajectory_round_trip(model, tmp_path, delta_integers):
+    """Steps written in a trajectory file are read back identical."""
+    obs_func = ecole.observation.NodeBipartite()
+    obs_func.before_reset(model)
+    pytest.helpers.advance_to_stage(model, ecole.scip.Stage.Solving)
+    obs = obs_func.extract(model, False)
+    action_set = np.array([0, 2, 3], dtype=np.uint64)
+
+    filename = tmp_path / "trajectory.trj"
+    with ecole.data.TrajectoryWriter(filename, compress=True, delta_integers=delta_integers) as writer:
+        writer.write(obs, action_set, 2, 1.5)
+        writer.write(obs, action_set, 3, -1.0)
+
+    reader = ecole.data.TrajectoryReader(filename)
+    assert len(reader) == 2
+    obs_read, action_set_read, action, reward = reader[1]
+    assert np.array_equal(obs_read.variable_features, obs.variable_features)
+    assert np.array_equal(obs_read.edge_features.indices, obs.edge_features.indices)
+    assert np.array_equal(action_set_read, action_set)
+    assert (action, reward) == (3, -1.0)
+    with pytest.raises(IndexError):
+        reader[2]
+
+
+def test_trajectory_dataset_shuffled_views(model, tmp_path):
+    """Steps of multiple files are viewed as read only arrays in a random order."""
+    obs_func = ecole.observation.NodeBipartite()
+    obs_func.before_reset(model)
+    pytest.helpers.advance_to_stage(model, ecole.scip.Stage.Solving)
+    obs = obs_func.extract(model, False)
+    action_set = np.array([0, 2, 3], dtype=np.uint64)
+
+    filenames = [tmp_path / "trajectory-1.trj", tmp_path / "trajectory-2.trj"]
+    for i, filename in enumerate(filenames):
+        with ecole.data.TrajectoryWriter(filename, narrow_integers=False) as writer:
+            writer.write(obs, action_set, i, float(i))
+
+    dataset = ecole.data.TrajectoryDataset(filenames)
+    assert len(dataset) == 2
+    sample = dataset[1]
+    assert np.array_equal(sample.variable_features, obs.variable_features)
+    assert np.array_equal(sample.edge_indices, obs.edge_features.indices)
+    assert np.array_equal(sample.action_set, action_set)
+    assert (sample.action, sample.reward) == (1, 1.0)
+    assert not sample.variable_features.flags.writeable
+
+    iterator = ecole.data.ShuffledTrajectoryIterator(dataset, ecole.RandomGenerator(0), n_prefetch=1)
+    assert sorted(sample.action for sample in iterator) == [0, 1]
@@ -6,6 +6,8 @@ The tests provided here run the same assertions on all dynamics.
 They mostly test that the code Bindings work as expected.
 """
 
+import time
+
 import pytest
 import numpy as np
 
@@ -73,6 +75,98 @@ class TestBranching(DynamicsUnitTests):
     def setup_method(self, method):
         self.dynamics = ecole.dynamics.BranchingDynamics(False)
 
+    def test_multi_node_step(self, model):
+        """Let a policy branch on several nodes per step."""
+        n_calls = 0
+
+        def policy(model, action_set):
+            nonlocal n_calls
+            n_calls += 1
+            return action_set[0]
+
+        done, action_set = self.dynamics.reset_dynamics(model)
+        while not done:
+            done, action_set = self.dynamics.step_dynamics(model, action_set[0], 4, policy)
+        assert n_calls > 0
+
+    def test_score_policy(self, model):
+        """Branch with a score vector on several nodes per step."""
+        obs = ecole.observation.MilpBipartite().extract(model, False)
+        scores = np.arange(obs.variable_features.shape[0], dtype=np.float64)
+        policy = ecole.dynamics.BranchingDynamics.score_policy(scores)
+        done, action_set = self.dynamics.reset_dynamics(model)
+        while not done:
+            done, action_set = self.dynamics.step_dynamics(model, ecole.Default, 4, policy)
+
+    def test_action_set_view(self, model):
+        """Views hold the same candidates as the action set."""
+        done, action_set = self.dynamics.reset_dynamics(model)
+        view = self.dynamics.action_set_view(model)
+        compact_view = self.dynamics.action_set_view(model, compact=True)
+        assert compact_view.dtype == np.uint32
+        assert not view.flags.writeable
+        assert np.array_equal(view, action_set)
+        assert np.array_equal(compact_view, action_set)
+
+    def test_action_mask_view(self, model):
+        """Masks are set on the candidates of the action set."""
+        done, action_set = self.dynamics.reset_dynamics(model)
+        mask = self.dynamics.action_mask_view(model)
+        assert mask.dtype == np.uint8
+        assert not mask.flags.writeable
+        assert mask.ndim == 1 and len(mask) > action_set.max()
+        assert np.array_equal(np.flatnonzero(mask), np.sort(action_set))
+        packed = self.dynamics.action_mask_view(model, packed=True)
+        assert np.array_equal(np.unpackbits(packed, count=len(mask), bitorder="little"), mask)
+
+    def test_observation_schedule(self, model):
+        """Control is only given back on scheduled nodes."""
+        schedule = ecole.dynamics.ObservationSchedule.probability(0.0)
+        dynamics = ecole.dynamics.BranchingDynamics(observation_schedule=schedule)
+        dynamics.set_dynamics_random_state(model, ecole.RandomGenerator(0))
+        done, _ = dynamics.reset_dynamics(model)
+        assert done
+        with pytest.raises(ValueError):
+            ecole.dynamics.ObservationSchedule.every(0)
+
+    def test_explore_policy(self, model):
+        """Nodes not scheduled are branched on by the explore policy."""
+        schedule = ecole.dynamics.ObservationSchedule.probability(0.0)
+        explore_policy = ecole.dynamics.BranchingDynamics.pseudocost_policy()
+        dynamics = ecole.dynamics.BranchingDynamics(observation_schedule=schedule, explore_policy=explore_policy)
+        dynamics.set_dynamics_random_state(model, ecole.RandomGenerator(0))
+        done, _ = dynamics.reset_dynamics(model)
+        assert done
+        assert model.is_solved
+
+    def test_presolve_cache(self, model):
+        """Episodes on the same instance start from a single presolved problem."""
+        dynamics = ecole.dynamics.BranchingDynamics(presolve_cache_size=1)
+        rng = ecole.RandomGenerator(0)
+        for _ in range(2):
+            episode_model = model.copy_orig()
+            dynamics.set_dynamics_random_state(episode_model, rng)
+            done, _ = dynamics.reset_dynamics(episode_model)
+            assert not done
+        assert dynamics.n_presolved_cached == 1
+        with pytest.raises(ValueError):
+            ecole.dynamics.BranchingDynamics(cache_root_cuts=True)
+        dynamics = ecole.dynamics.BranchingDynamics(presolve_cache_size=1, cache_root_cuts=True)
+        episode_model = model.copy_orig()
+        dynamics.set_dynamics_random_state(episode_model, rng)
+        done, _ = dynamics.reset_dynamics(episode_model)
+
+    def test_step_deadline(self, model):
+        """Late actions are dropped and SCIP branches by itself."""
+        dynamics = ecole.dynamics.BranchingDynamics(step_deadline=0.001)
+        done, action_set = dynamics.reset_dynamics(model)
+        assert not done
+        dynamics.start_step_deadline(model)
+        time.sleep(0.05)
+        dynamics.step_dynamics(model, action_set[0])
+        info = ecole.information.PerformanceCounters().extract(model, False)
+        assert info["n_missed_deadlines"] == 1
+
 
 class TestBranchingDefault(TestBranching):
     @staticmethod
@@ -108,6 +202,34 @@ class TestConfiguring(DynamicsUnitTests):
         self.dynamics = ecole.dynamics.ConfiguringDynamics()
 
 
+class TestConfiguringConcurrent(TestConfiguring):
+    def setup_method(self, method):
+        self.dynamics = ecole.dynamics.ConfiguringDynamics(n_threads=2)
+
+
+class TestConfiguringReusePresolve(TestConfiguring):
+    def setup_method(self, method):
+        self.dynamics = ecole.dynamics.ConfiguringDynamics(reuse_presolve=True)
+
+    def test_reuse_presolve(self, problem_file):
+        """A second episode on the same instance solves the presolved problem."""
+        # Unlike the model fixture, presolving is kept enabled
+        models = [ecole.scip.Model.from_file(problem_file) for _ in range(2)]
+        for model in models:
+            self.dynamics.reset_dynamics(model)
+            self.dynamics.step_dynamics(model, {"branching/scorefunc": "s"})
+            assert model.is_solved
+        assert models[0].get_param("presolving/maxrounds") != 0
+        assert models[1].get_param("presolving/maxrounds") == 0
+
+
+def test_param_phase():
+    """Parameters are classified by the solve phase they affect."""
+    SolvePhase = ecole.dynamics.SolvePhase
+    assert ecole.dynamics.param_phase("branching/scorefunc") == SolvePhase.solving
+    assert ecole.dynamics.param_phase("presolving/maxrounds") == SolvePhase.presolving
+
+
 class TestPrimalSearch(DynamicsUnitTests):
     @staticmethod
     def assert_action_set(action_set):
@@ -127,3 +249,88 @@ class TestPrimalSearch(DynamicsUnitTests):
 
     def setup_method(self, method):
         self.dynamics = ecole.dynamics.PrimalSearchDynamics()
+
+    def test_step_batch(self, model):
+        """Try a list of partial solutions in a single step."""
+        done, action_set = self.dynamics.reset_dynamics(model)
+        assert not done
+        batch = [
+            (action_set, np.zeros(len(action_set))),
+            ([], []),
+            (action_set, [1.0] * len(action_set)),
+        ]
+        self.dynamics.step_dynamics(model, batch)
+        assert len(self.dynamics.last_solutions_kept) == len(batch)
+        assert not self.dynamics.last_solutions_kept[1]
+
+    def test_step_converted_arrays(self, model):
+        """Arrays of other integer or floating point types are accepted as actions."""
+        done, action_set = self.dynamics.reset_dynamics(model)
+        n_vars = len(action_set)
+        batch = [
+            (action_set.astype(np.int32), np.zeros(n_vars, dtype=np.float32)),
+            (action_set.astype(np.int64)[::-1], np.ones(n_vars)[::-1]),
+            (list(action_set), np.zeros(n_vars, dtype=np.int8)),
+        ]
+        self.dynamics.step_dynamics(model, batch)
+        assert len(self.dynamics.last_solutions_kept) == len(batch)
+        with pytest.raises(ValueError):
+            self.dynamics.step_dynamics(model, (np.array([-1]), np.zeros(1, dtype=np.float32)))
+
+    def test_action_mask_view(self, model):
+        """The mask is set on the candidates of the action set."""
+        done, action_set = self.dynamics.reset_dynamics(model)
+        mask = self.dynamics.action_mask_view(model)
+        assert np.array_equal(np.flatnonzero(mask), np.sort(action_set))
+
+    def test_screening(self, model):
+        """Fractional values are screened out without probing."""
+        Screening = ecole.dynamics.PrimalSearchDynamics.Screening
+        self.dynamics = ecole.dynamics.PrimalSearchDynamics(screening=Screening.reject)
+        done, action_set = self.dynamics.reset_dynamics(model)
+        batch = [(action_set, np.full(len(action_set), 0.5)), ([], [])]
+        self.dynamics.step_dynamics(model, batch)
+        assert list(self.dynamics.last_solutions_screened_out) == [True, False]
+        assert not any(self.dynamics.last_solutions_kept)
+
+
+class TestNodeSelection(DynamicsUnitTests):
+    @staticmethod
+    def assert_action_set(action_set):
+        assert isinstance(action_set, np.ndarray)
+        assert action_set.ndim == 2
+        assert action_set.shape[0] > 0
+        assert action_set.shape[1] == 4
+
+    @staticmethod
+    def policy(action_set):
+        # Deepest node
+        return int(action_set[np.argmax(action_set[:, 1]), 0])
+
+    @staticmethod
+    def bad_policy(action_set):
+        return 1 << 40
+
+    def setup_method(self, method):
+        self.dynamics = ecole.dynamics.NodeSelectionDynamics()
+
+
+class TestCutSelection(DynamicsUnitTests):
+    @staticmethod
+    def assert_action_set(action_set):
+        assert isinstance(action_set, np.ndarray)
+        assert action_set.ndim == 2
+        assert action_set.shape[0] > 0
+        assert action_set.shape[1] == 4
+
+    @staticmethod
+    def policy(action_set):
+        # Most efficacious cut
+        return [int(np.argmax(action_set[:, 0]))]
+
+    @staticmethod
+    def bad_policy(action_set):
+        return [len(action_set)]
+
+    def setup_method(self, method):
+        self.dynamics = ecole.dynamics.CutSelectionDynamics()
@@ -1,6 +1,9 @@
 """Unit tests for Ecole Environment."""
 
+import asyncio
+import time
 import unittest.mock as mock
+import numpy as np
 import pytest
 
 import ecole
@@ -43,6 +46,51 @@ def test_step_error(model):
         env.step("some action")
 
 
+def test_step_async(model):
+    """Step without blocking the event loop."""
+    env = MockEnvironment()
+    env.reset(model)
+    _, action_set, _, done, _ = asyncio.run(env.step_async("some action"))
+    env.dynamics.step_dynamics.assert_called_with(env.model, "some action")
+    assert action_set == "other_action_set"
+    assert done
+    with pytest.raises(ecole.MarkovError):
+        asyncio.run(env.step_async("some action"))
+
+
+def test_step_async_exception(model):
+    """Exceptions of the dynamics are raised by the awaited step."""
+    env = MockEnvironment()
+    env.reset(model)
+    env.dynamics.step_dynamics.side_effect = ValueError("bad action")
+    with pytest.raises(ValueError):
+        asyncio.run(env.step_async("some action"))
+    assert not env.can_transition
+
+
+@pytest.mark.slow
+def test_step_async_concurrent(model):
+    """Environments stepped concurrently by one thread run the same episodes as sequentially."""
+
+    async def run_episode(env):
+        _, action_set, _, done, _ = env.reset(model)
+        n_steps = 0
+        while not done:
+            _, action_set, _, done, _ = await env.step_async(action_set[0])
+            n_steps += 1
+        return n_steps
+
+    async def run_episodes(envs):
+        return await asyncio.gather(*(run_episode(env) for env in envs))
+
+    envs = [ecole.environment.Branching(observation_function=None) for _ in range(4)]
+    for env in envs:
+        env.seed(0)
+    n_steps = asyncio.run(run_episodes(envs))
+    assert len(set(n_steps)) == 1
+    assert all(env.model.is_solved for env in envs)
+
+
 def test_seed():
     """Random generator is consumed."""
     env = MockEnvironment()
@@ -50,8 +98,131 @@ def test_seed():
     assert env.rng == ecole.RandomGenerator(33)
 
 
+def test_save_load_state():
+    """The random generator of the environment is restored."""
+    env = MockEnvironment()
+    env.seed(33)
+    state = env.save_state()
+    env.rng()
+    env.load_state(state)
+    assert env.rng == ecole.RandomGenerator(33)
+
+
 def test_scip_params(model):
     """Reset sets parameters on the model."""
     env = MockEnvironment(scip_params={"concurrent/paramsetprefix": "testname"})
     env.reset(model)
     assert env.model.get_param("concurrent/paramsetprefix") == "testname"
+
+
+def test_memory_limit(model):
+    """Reset sets the memory limit in megabytes."""
+    env = MockEnvironment(scip_params={"limits/memory": 1.0}, memory_limit=64 * 2 ** 20)
+    env.reset(model)
+    assert env.model.get_param("limits/memory") == 64
+
+
+@pytest.mark.slow
+def test_snapshot(model):
+    """Episodes can be restarted from a snapshot."""
+    env = ecole.environment.Branching(observation_function=None)
+    _, action_set, _, done, _ = env.reset(model)
+    assert not done
+    snapshot = env.snapshot()
+    for _ in range(2):
+        _, action_set, _, done, _ = env.reset(snapshot)
+        while not done:
+            _, action_set, _, done, _ = env.step(action_set[-1])
+    assert env.model.is_solved
+
+
+@pytest.mark.parametrize("deadline", (0.001, 3600.0))
+def test_snapshot_stops_step_deadline(model, deadline):
+    """Snapshots cannot be taken once the solver left the state at its step deadline."""
+    env = ecole.environment.Branching(observation_function=None, step_deadline=deadline)
+    _, action_set, _, done, _ = env.reset(model)
+    assert not done
+    time.sleep(0.02)
+    if deadline > 1:
+        env.snapshot()
+    else:
+        with pytest.raises(ecole.MarkovError):
+            env.snapshot()
+    env.step(action_set[0])
+
+
+def test_lazy_observation(model):
+    """Observations are only extracted if accessed before the next transition."""
+    obs_func = mock.MagicMock()
+    obs_func.extract = mock.MagicMock(return_value="some_observation")
+    env = MockEnvironment(observation_function=obs_func, lazy_observation=True)
+
+    obs, _, _, _, _ = env.reset(model)
+    obs_func.extract.assert_not_called()
+    assert not obs.is_extracted
+    assert obs.get() == "some_observation"
+    assert obs.is_extracted
+    obs_func.extract.assert_called_once()
+
+    obs, _, _, _, _ = env.reset(model)
+    _, _, _, done, _ = env.step("some action")
+    with pytest.raises(ecole.MarkovError):
+        obs.get()
+    assert obs_func.extract.call_count == 1
+
+
+@pytest.mark.slow
+def test_native_branching(model):
+    """Native environments run episodes with built-in functions."""
+    env = ecole.environment.NativeBranching(reward_function=ecole.reward.NNodes())
+    obs, action_set, _, done, info = env.reset(model)
+    assert isinstance(obs, ecole.observation.NodeBipartiteObs)
+    assert info == {}
+    while not done:
+        obs, action_set, reward, done, _ = env.step(action_set[0])
+        assert reward >= 0
+    assert obs is None
+    assert env.model.is_solved
+
+
+def test_native_configuring(model):
+    """Native environments take the same actions as their dynamics."""
+    env = ecole.environment.NativeConfiguring(observation_function=None)
+    obs, action_set, _, done, _ = env.reset(model)
+    assert not done
+    obs, _, _, done, _ = env.step({"limits/nodes": 1})
+    assert done
+    with pytest.raises(ecole.MarkovError):
+        env.step({})
+
+
+def test_native_builtin_functions_only():
+    """Native environments reject Python data functions."""
+    with pytest.raises(TypeError):
+        ecole.environment.NativeBranching(reward_function=-ecole.reward.NNodes())
+
+
+@pytest.mark.slow
+def test_native_vector_branching(model):
+    """Vector environments return stacked arrays and concatenated graphs."""
+    n_envs = 3
+    envs = ecole.environment.NativeVectorBranching(n_envs)
+    obs, (action_sets, offsets), rewards, dones, _ = envs.reset([model] * n_envs)
+    assert len(envs) == n_envs
+    assert rewards.shape == (n_envs,)
+    assert dones.shape == (n_envs,)
+    assert offsets.shape == (n_envs + 1,)
+    assert obs.variable_offsets[-1] == obs.variable_features.shape[0]
+    assert obs.edge_offsets[-1] == obs.edge_features.nnz
+    assert (obs.edge_features.indices[0] < obs.row_features.shape[0]).all()
+    assert (obs.edge_features.indices[1] < obs.variable_features.shape[0]).all()
+    while not dones.all():
+        # Environments in terminal states have an empty action set
+        actions = np.array(
+            [
+                action_sets[offsets[i]] if offsets[i] < offsets[i + 1] else 0
+                for i in range(n_envs)
+            ]
+        )
+        obs, (action_sets, offsets), rewards, dones, _ = envs.step(actions)
+    assert offsets[-1] == 0
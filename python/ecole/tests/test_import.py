@@ -0,0 +1,46 @@
+import pickle
+import subprocess
+import sys
+
+import pytest
+
+import ecole
+
+
+def run_python(code):
+    """Run the code in a new interpreter, where Ecole has not been imported yet."""
+    subprocess.run([sys.executable, "-c", code], check=True)
+
+
+def test_import_is_lazy():
+    """Importing Ecole does not bind the submodules it does not use."""
+    run_python(
+        "import sys, ecole\n"
+        "assert 'ecole.core.environment' not in sys.modules\n"
+        "assert 'ecole.environment' not in sys.modules\n"
+    )
+
+
+def test_submodules_are_bound_on_access():
+    """Submodules and their dependencies are bound when first accessed."""
+    run_python(
+        "import sys, ecole\n"
+        "assert ecole.environment.Branching is not None\n"
+        "assert 'ecole.core.dynamics' in sys.modules\n"
+        "assert ecole.core.observation is sys.modules['ecole.core.observation']\n"
+    )
+
+
+def test_unpickle_in_new_interpreter(model):
+    """Objects of submodules that are not bound yet can be unpickled."""
+    data = pickle.dumps(ecole.observation.MilpBipartite().extract(model, False))
+    run_python(f"import pickle\nassert pickle.loads({data!r}).variable_features.size > 0\n")
+
+
+def test_bind_submodule():
+    assert ecole.core.bind_submodule("scip") is ecole.core.scip
+    assert "environment" in ecole.core.submodules
+    with pytest.raises(ValueError):
+        ecole.core.bind_submodule("nothing")
+    with pytest.raises(AttributeError):
+        ecole.core.nothing
@@ -20,7 +20,11 @@ def pytest_generate_tests(metafunc):
     `information_function` as input.
     """
     if "information_function" in metafunc.fixturenames:
-        all_information_functions = (ecole.information.Nothing(),)
+        all_information_functions = (
+            ecole.information.Nothing(),
+            ecole.information.SolverStatistics(),
+            ecole.information.PerformanceCounters(),
+        )
         metafunc.parametrize("information_function", all_information_functions)
 
 
@@ -53,3 +57,53 @@ def test_Nothing_information(model):
     info = make_info(ecole.information.Nothing(), model)
     assert isinstance(info, dict)
     assert len(info) == 0
+
+
+def test_SolverStatistics_information(model):
+    """Statistics are returned as a dictionnary of floats."""
+    info = make_info(ecole.information.SolverStatistics(plugin_times=True), model)
+    assert isinstance(info, dict)
+    assert info["n_nodes"] == 1
+    assert info["n_lp_iterations"] > 0
+    assert "time/heuristic/rounding" in info
+    assert all(isinstance(v, float) for v in info.values())
+
+
+def test_SolverStatistics_collect(model):
+    """Statistics not requested are left to zero."""
+    info_func = ecole.information.SolverStatistics(lp_iterations=False)
+    pytest.helpers.advance_to_stage(model, ecole.scip.Stage.Solving)
+    data = info_func.collect(model)
+    assert data.n_nodes == 1
+    assert data.n_lp_iterations == 0
+    assert "n_lp_iterations" not in info_func.extract(model)
+
+
+def test_PerformanceCounters_information(model):
+    """Counters are accumulated over the steps of an episode."""
+    env = ecole.environment.Branching(information_function=ecole.information.PerformanceCounters())
+    _, action_set, _, done, info = env.reset(model)
+    assert all(isinstance(v, float) for v in info.values())
+    n_steps = 0
+    while not done and n_steps < 5:
+        _, action_set, _, done, info = env.step(action_set[0])
+        n_steps += 1
+    assert info["n_yields"] == n_steps + (0 if done else 1)
+    assert info["solving_time"] > 0
+    assert info["waiting_time"] > 0
+    assert info["caller_time"] > 0
+
+
+def test_SearchTreeRecorder_information(model, tmp_path):
+    """The nodes solved are written to the file and read back."""
+    filename = tmp_path / "tree.bin"
+    info_func = ecole.information.SearchTreeRecorder(filename)
+    info_func.before_reset(model)
+    model.solve()
+    info = info_func.extract(model, True)
+    reader = ecole.information.SearchTreeReader(filename)
+    assert len(reader) == info["n_records"]
+    records = reader.read_all()
+    assert records[0].number == 1
+    assert records[0].parent == 0
+    assert all(isinstance(r.outcome, ecole.information.NodeOutcome) for r in records)
@@ -84,6 +84,17 @@ def test_repeated_slice_iteration(instance_generator):
             assert isinstance(model, ecole.scip.Model)
 
 
+def test_save_load_state(instance_generator, tmp_path):
+    """A restored generator resumes the same sequence of instances."""
+    next(instance_generator)
+    state = instance_generator.save_state()
+    assert isinstance(state, bytes)
+    next(instance_generator).write_problem(tmp_path / "model.lp")
+    instance_generator.load_state(state)
+    next(instance_generator).write_problem(tmp_path / "restored.lp")
+    assert (tmp_path / "model.lp").read_text() == (tmp_path / "restored.lp").read_text()
+
+
 def test_FileGenerator_parameters(tmp_dataset):
     """Parameters are bound in the constructor and as attributes."""
     generator = ecole.instance.FileGenerator(directory=str(tmp_dataset), sampling_mode="remove")
@@ -115,3 +126,154 @@ def test_CapacitatedFacilityLocationGenerator_parameters():
     )
     assert generator.ratio == -1
     assert generator.demand_interval == (1, 5)
+
+
+def test_anonymous_instances(instance_generator):
+    """Generators can skip naming variables and constraints."""
+    if isinstance(instance_generator, ecole.instance.FileGenerator):
+        pytest.skip("No names to skip for file loaders")
+    InstanceGenerator = type(instance_generator)
+    model = InstanceGenerator.generate_instance(
+        named=False, rng=ecole.RandomGenerator()
+    )
+    assert isinstance(model, ecole.scip.Model)
+    assert InstanceGenerator(named=False).named is False
+
+
+def test_InstanceCache(problem_file):
+    """Cached instances are copies of the problem file."""
+    cache = ecole.instance.InstanceCache()
+    model = cache.get(str(problem_file))
+    other = cache.get(str(problem_file))
+    assert model != other
+    assert model.name == ecole.scip.Model.from_file(problem_file).name
+    assert len(cache) == 1
+    assert cache.n_templates(str(problem_file)) == 1
+
+
+def test_InstanceCache_bounded(problem_file):
+    """Instances larger than the bound are not kept."""
+    cache = ecole.instance.InstanceCache(max_nonzeros=1)
+    assert isinstance(cache.get(str(problem_file)), ecole.scip.Model)
+    assert len(cache) == 0
+    assert cache.n_nonzeros() == 0
+
+
+def test_PrefetchingGenerator(tmp_path):
+    """Prefetched instances are reproducible and only C++ generators are accepted."""
+    generator = ecole.instance.SetCoverGenerator(n_rows=50, n_cols=100)
+    prefetching = ecole.instance.PrefetchingGenerator(
+        generator, n_threads=2, rng=ecole.RandomGenerator(0)
+    )
+    other = ecole.instance.PrefetchingGenerator(
+        generator, n_threads=2, rng=ecole.RandomGenerator(0)
+    )
+    assert prefetching.n_threads == 2
+    for i in range(3):
+        next(prefetching).write_problem(tmp_path / f"model-{i}.lp")
+        next(other).write_problem(tmp_path / f"other-{i}.lp")
+        model_text = (tmp_path / f"model-{i}.lp").read_text()
+        assert model_text == (tmp_path / f"other-{i}.lp").read_text()
+
+    with pytest.raises(ValueError):
+        ecole.instance.PrefetchingGenerator(object())
+
+
+def test_ShardedGenerator(tmp_path):
+    """Shards of a generator are disjoint parts of the same sequence."""
+    generator = ecole.instance.SetCoverGenerator(n_rows=50, n_cols=100)
+    whole = ecole.instance.ShardedGenerator(generator, 0, 1, rng=ecole.RandomGenerator(0))
+    fingerprints = [next(whole).fingerprint() for _ in range(4)]
+    assert len(set(fingerprints)) == 4
+    for rank in range(2):
+        shard = ecole.instance.ShardedGenerator(
+            generator, rank=rank, world_size=2, rng=ecole.RandomGenerator(0)
+        )
+        assert (shard.rank, shard.world_size) == (rank, 2)
+        assert [next(shard).fingerprint() for _ in range(2)] == fingerprints[rank::2]
+
+    with pytest.raises(ValueError):
+        ecole.instance.ShardedGenerator(generator, rank=2, world_size=2)
+
+
+def test_FilteredGenerator():
+    """Filtered instances are in range and reproducible."""
+    generator = ecole.instance.SetCoverGenerator(n_rows=50, n_cols=100)
+    filtered = ecole.instance.FilteredGenerator(
+        generator, keep_solved=True, min_lp_iterations=1, rng=ecole.RandomGenerator(0)
+    )
+    other = ecole.instance.FilteredGenerator(
+        generator, keep_solved=True, min_lp_iterations=1, rng=ecole.RandomGenerator(0)
+    )
+    assert filtered.n_threads == 2
+    for _ in range(3):
+        assert next(filtered).fingerprint() == next(other).fingerprint()
+    assert filtered.n_probed >= 3
+    assert filtered.n_rejected <= filtered.n_probed
+
+    with pytest.raises(ValueError):
+        ecole.instance.FilteredGenerator(object())
+    with pytest.raises(RuntimeError):
+        out_of_reach = ecole.instance.FilteredGenerator(
+            generator, min_lp_iterations=1, max_lp_iterations=0, max_rejections=2
+        )
+        next(out_of_reach)
+
+
+def test_FileGenerator_shards(tmp_dataset):
+    """Files are split among ranks."""
+    n_files = len(list(tmp_dataset.iterdir()))
+    shards = [
+        ecole.instance.FileGenerator(
+            str(tmp_dataset), sampling_mode="remove", rank=rank, world_size=2
+        )
+        for rank in range(2)
+    ]
+    assert [len(list(shard)) for shard in shards] == [(n_files + 1) // 2, n_files // 2]
+
+
+def test_write_dataset(tmp_path):
+    """Files written do not depend on the number of threads."""
+    generator = ecole.instance.SetCoverGenerator(n_rows=50, n_cols=100)
+    paths = ecole.instance.write_dataset(
+        generator, 3, seed=0, directory=tmp_path / "a", n_threads=1
+    )
+    other = ecole.instance.write_dataset(
+        generator, 3, seed=0, directory=tmp_path / "b", n_threads=3
+    )
+    assert len(paths) == 3
+    for path, other_path in zip(paths, other):
+        assert path.read_text() == other_path.read_text()
+
+
+def test_manifest(tmp_dataset, tmp_path):
+    """FileGenerator reads the files of a manifest instead of listing the directory."""
+    entries = ecole.instance.scan_manifest(tmp_dataset, read_problems=True)
+    assert len(entries) > 0
+    assert all(e.n_nonzeros is not None and e.fingerprint is not None for e in entries)
+
+    manifest = tmp_path / "manifest.tsv"
+    ecole.instance.write_manifest(manifest, entries)
+    assert [e.size for e in ecole.instance.read_manifest(manifest)] == [e.size for e in entries]
+
+    generator = ecole.instance.FileGenerator(manifest=str(manifest), sampling_mode="remove")
+    assert sum(1 for _ in generator) == len(entries)
+
+
+def test_FileGenerator_buckets(tmp_path):
+    """Consecutive files are sampled from the same bucket of costs."""
+    generator = ecole.instance.SetCoverGenerator(n_rows=50, n_cols=100)
+    ecole.instance.write_dataset(generator, 4, seed=0, directory=tmp_path / "instances")
+    entries = ecole.instance.scan_manifest(tmp_path / "instances")
+    for i, entry in enumerate(entries):
+        entry.cost = float(i)
+    manifest = tmp_path / "manifest.tsv"
+    ecole.instance.write_manifest(manifest, entries)
+
+    # With a file per bucket, batches repeat the same file
+    generator = ecole.instance.FileGenerator(
+        manifest=str(manifest), n_buckets=len(entries), bucket_batch_size=2, sampling_mode="replace"
+    )
+    generator.seed(0)
+    for _ in range(5):
+        assert next(generator).fingerprint() == next(generator).fingerprint()
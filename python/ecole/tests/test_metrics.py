@@ -0,0 +1,43 @@
+"""Test Ecole process-wide metrics."""
+
+import pytest
+
+import ecole
+
+
+def test_metrics_are_shared():
+    """Registering a metric a second time returns the same metric."""
+    counter = ecole.metrics.counter("test_python_total", "Help.", {"label": "value"})
+    counter.add(2)
+    assert ecole.metrics.counter("test_python_total", "Help.", {"label": "value"}).value == 2
+    with pytest.raises(ValueError):
+        ecole.metrics.gauge("test_python_total", "Help.")
+
+
+def test_histogram_in_seconds():
+    """Durations are observed and collected in seconds."""
+    histogram = ecole.metrics.histogram("test_python_seconds", "Help.")
+    histogram.observe(0.5)
+    assert histogram.count == 1
+    assert histogram.sum == pytest.approx(0.5)
+    samples = {
+        (name, tuple(labels.items())): value for name, labels, value in ecole.metrics.collect()
+    }
+    assert samples[("test_python_seconds_bucket", (("le", "+Inf"),))] == 1
+    assert samples[("test_python_seconds_bucket", (("le", "0.262144"),))] == 0
+
+
+def test_environment_metrics(model):
+    """Environments count their transitions and time the extraction of observations."""
+    env = ecole.environment.Branching(observation_function=ecole.observation.NodeBipartite())
+    steps = ecole.metrics.counter("ecole_environment_steps_total", "")
+    resets = ecole.metrics.counter("ecole_environment_resets_total", "")
+    n_steps, n_resets = steps.value, resets.value
+    _, action_set, _, done, _ = env.reset(model)
+    if not done:
+        env.step(action_set[0])
+    assert resets.value == n_resets + 1
+    assert steps.value == n_steps + (0 if done else 1)
+    text = ecole.metrics.to_prometheus()
+    assert "# TYPE ecole_observation_extract_seconds histogram" in text
+    assert 'ecole_observation_extract_seconds_count{function="NodeBipartite"}' in text
@@ -8,6 +8,7 @@ Here,
 """
 
 import copy
+import datetime
 import pickle
 
 import numpy as np
@@ -27,12 +28,33 @@ def pytest_generate_tests(metafunc):
         all_observation_functions = (
             ecole.observation.Nothing(),
             ecole.observation.NodeBipartite(),
+            ecole.observation.NodeBipartite(incremental=True),
+            ecole.observation.NodeBipartite(csr_edges=True),
+            ecole.observation.NodeBipartite(candidate_hops=2),
+            ecole.observation.NodeBipartite(csr_edges=True, csc_edges=True),
+            ecole.observation.DeltaNodeBipartite(),
+            ecole.observation.NodeBipartiteFloat32(),
+            ecole.observation.CompactNodeBipartiteFloat32(),
             ecole.observation.MilpBipartite(),
+            ecole.observation.MilpBipartiteFloat32(),
             ecole.observation.StrongBranchingScores(True),
             ecole.observation.StrongBranchingScores(False),
+            ecole.observation.StrongBranchingScores(n_threads=2),
+            ecole.observation.BudgetedStrongBranchingScores(max_candidates=3, max_lp_iterations=10),
+            ecole.observation.BudgetedStrongBranchingScores(reuse_cache=True),
+            ecole.observation.ReliabilityBranchingScores(),
+            ecole.observation.DetailedStrongBranchingScores(max_lp_iterations=10),
             ecole.observation.Pseudocosts(),
+            ecole.observation.Pseudocosts(candidates_only=True),
+            ecole.observation.PooledPseudocosts(),
             ecole.observation.Khalil2016(),
+            ecole.observation.Khalil2016(candidates_only=True),
+            ecole.observation.NormalizedKhalil2016(),
+            ecole.observation.HistoryKhalil2016(length=2, pad=True),
+            ecole.observation.NormalizedNodeBipartite(),
             ecole.observation.Hutter2011(),
+            ecole.observation.Hutter2011(cache_features=True),
+            ecole.observation.TreeStatistics(),
         )
         metafunc.parametrize("observation_function", all_observation_functions)
 
@@ -75,6 +97,32 @@ def test_observation_pickle(observation_function, model):
     obs_copy = pickle.loads(blob)
 
 
+def test_CopyOnWrite(model):
+    """Copies share arrays until they are modified."""
+    obs = make_obs(ecole.observation.NodeBipartite(), model)
+    cow = ecole.observation.CopyOnWrite(obs)
+    other = copy.copy(cow)
+    assert np.shares_memory(cow.variable_features, other.variable_features)
+    assert np.shares_memory(cow.edge_features.values, obs.edge_features.values)
+    with pytest.raises(ValueError):
+        other.variable_features[0, 0] = 1
+
+    other.writable("variable_features")[0, 0] += 1
+    assert not np.shares_memory(cow.variable_features, other.variable_features)
+    assert np.shares_memory(cow.row_features, other.row_features)
+    assert cow.variable_features[0, 0] == obs.variable_features[0, 0]
+    other.edge_features.values = -other.edge_features.values
+    assert np.shares_memory(cow.edge_features.values, obs.edge_features.values)
+
+    materialized = other.materialize()
+    assert isinstance(materialized, ecole.observation.NodeBipartiteObs)
+    assert materialized.variable_features[0, 0] == obs.variable_features[0, 0] + 1
+    assert np.array_equal(materialized.edge_features.values, -obs.edge_features.values)
+    unpickled = pickle.loads(pickle.dumps(other))
+    assert np.array_equal(unpickled.variable_features, other.variable_features)
+    assert not np.shares_memory(copy.deepcopy(cow).row_features, cow.row_features)
+
+
 def assert_array(arr, ndim=1, non_empty=True, dtype=np.double):
     assert isinstance(arr, np.ndarray)
     assert arr.ndim == ndim
@@ -82,6 +130,48 @@ def assert_array(arr, ndim=1, non_empty=True, dtype=np.double):
     assert arr.dtype == dtype
 
 
+def test_observation_arrays_are_not_copied(model):
+    """Array attributes are views on the C++ observation and returned arrays own their memory."""
+    obs = make_obs(ecole.observation.NodeBipartite(), model)
+    getters = (
+        lambda o: o.variable_features,
+        lambda o: o.row_features,
+        lambda o: o.edge_features.values,
+        lambda o: o.edge_features.indices,
+    )
+    for get in getters:
+        arr = get(obs)
+        assert not arr.flags.owndata
+        assert get(obs).__array_interface__["data"][0] == arr.__array_interface__["data"][0]
+
+    # Writes are visible in the observation
+    obs.edge_features.values[0] = 42.0
+    assert obs.edge_features.values[0] == 42.0
+
+    # Views keep the observation alive
+    values = obs.edge_features.values
+    expected = values.copy()
+    del obs
+    assert np.array_equal(values, expected)
+
+    # Owned by the capsule of the moved xtensor rather than by a numpy copy
+    assert not make_obs(ecole.observation.Pseudocosts(), model).flags.owndata
+
+
+def test_observation_to_dlpack(model):
+    """DLPack capsules share the observation memory."""
+    obs = make_obs(ecole.observation.NodeBipartite(), model)
+    capsule = ecole.observation.to_dlpack(obs.variable_features)
+    assert type(capsule).__name__ == "PyCapsule"
+
+    torch = pytest.importorskip("torch")
+    tensor = torch.utils.dlpack.from_dlpack(ecole.observation.to_dlpack(obs.variable_features))
+    assert tensor.data_ptr() == obs.variable_features.__array_interface__["data"][0]
+    assert tuple(tensor.shape) == obs.variable_features.shape
+    row_features = torch.utils.dlpack.from_dlpack(ecole.observation.to_dlpack(obs.row_features))
+    assert np.array_equal(row_features.numpy(), obs.row_features, equal_nan=True)
+
+
 def test_Nothing_observation(model):
     """Observation of Nothing is None."""
     assert make_obs(ecole.observation.Nothing(), model) is None
@@ -101,6 +191,93 @@ def test_NodeBipartite_observation(model):
     assert len(obs.RowFeatures.__members__) == obs.row_features.shape[1]
 
 
+def test_NodeBipartite_candidate_subgraph(model):
+    """Subgraphs around candidates keep the features of the original variables and rows."""
+    full_obs = make_obs(ecole.observation.NodeBipartite(), model)
+    obs = make_obs(ecole.observation.NodeBipartite(candidate_hops=1), model)
+    assert_array(obs.variable_ids, dtype=np.uint64)
+    assert len(obs.variable_ids) == obs.variable_features.shape[0] == obs.edge_features.shape[1]
+    assert len(obs.row_ids) == obs.row_features.shape[0] == obs.edge_features.shape[0]
+    assert np.array_equal(obs.variable_features, full_obs.variable_features[obs.variable_ids], equal_nan=True)
+    assert np.array_equal(obs.row_features, full_obs.row_features[obs.row_ids], equal_nan=True)
+
+
+def test_DeltaNodeBipartite_observation(model):
+    """Applying a delta to an empty observation gives the whole observation."""
+    full_obs = make_obs(ecole.observation.NodeBipartite(csr_edges=True), model)
+    delta = make_obs(ecole.observation.DeltaNodeBipartite(), model)
+    assert isinstance(delta, ecole.observation.NodeBipartiteDelta)
+    assert delta.n_rows == len(delta.row_indices) == full_obs.row_features.shape[0]
+    obs = ecole.observation.NodeBipartiteObs()
+    ecole.observation.apply_delta(obs, delta)
+    assert np.array_equal(obs.variable_features, full_obs.variable_features, equal_nan=True)
+    assert np.array_equal(obs.row_features, full_obs.row_features, equal_nan=True)
+    assert (obs.edge_features_csr.values == full_obs.edge_features_csr.values).all()
+    assert (obs.edge_features_csr.row_pointers == full_obs.edge_features_csr.row_pointers).all()
+
+
+def test_NodeBipartiteFloat32_observation(model):
+    """Observation of NodeBipartiteFloat32 has single precision features."""
+    obs = make_obs(ecole.observation.NodeBipartiteFloat32(), model)
+    assert isinstance(obs, ecole.observation.NodeBipartiteObsFloat32)
+    assert_array(obs.variable_features, ndim=2, dtype=np.float32)
+    assert_array(obs.row_features, ndim=2, dtype=np.float32)
+    assert_array(obs.edge_features.values, dtype=np.float32)
+    assert obs.VariableFeatures is ecole.observation.NodeBipartiteObs.VariableFeatures
+
+
+def test_CompactNodeBipartite_observation(model):
+    """Categorical variable features of CompactNodeBipartite are codes of the one hot encoded ones."""
+    full_obs = make_obs(ecole.observation.NodeBipartiteFloat32(), model)
+    obs = make_obs(ecole.observation.CompactNodeBipartiteFloat32(), model)
+    assert_array(obs.variable_features, ndim=2, dtype=np.float32)
+    assert_array(obs.variable_categories, ndim=2, dtype=np.uint8)
+    assert obs.variable_categories.shape[1] == len(obs.CategoricalVariableFeatures.__members__)
+    Full = ecole.observation.NodeBipartiteObs.VariableFeatures
+    Categorical = ecole.observation.NodeBipartiteCompactObs.CategoricalVariableFeatures
+    type_one_hot = full_obs.variable_features[:, int(Full.is_type_binary) : int(Full.is_type_continuous) + 1]
+    assert (obs.variable_categories[:, Categorical.type] == type_one_hot.argmax(axis=1)).all()
+
+
+def test_NodeBipartite_collate(model):
+    """Observations are concatenated into a single graph with shifted edge indices."""
+    obs = make_obs(ecole.observation.NodeBipartite(), model)
+    n_vars, n_rows = obs.variable_features.shape[0], obs.row_features.shape[0]
+    batch = ecole.observation.collate([obs, obs])
+    assert isinstance(batch, ecole.observation.NodeBipartiteBatch)
+    assert batch.variable_features.shape == (2 * n_vars, obs.variable_features.shape[1])
+    assert batch.row_features.shape == (2 * n_rows, obs.row_features.shape[1])
+    assert batch.edge_features.nnz == 2 * obs.edge_features.nnz
+    assert (batch.variable_batch[n_vars:] == 1).all()
+    assert list(batch.row_offsets) == [0, n_rows, 2 * n_rows]
+    second_edges = batch.edge_features.indices[:, obs.edge_features.nnz :]
+    assert (second_edges[0] >= n_rows).all()
+    assert (second_edges[1] >= n_vars).all()
+
+
+def assert_same_csr(a, b):
+    assert list(a.shape) == list(b.shape)
+    assert (a.values == b.values).all()
+    assert (a.column_indices == b.column_indices).all()
+    assert (a.row_pointers == b.row_pointers).all()
+
+
+@pytest.mark.parametrize("parallel", (False, True))
+def test_sparse_matrix_conversions(model, parallel):
+    """Edge features are converted and sliced consistently in the coordinate and compressed formats."""
+    coo = make_obs(ecole.observation.NodeBipartite(), model).edge_features
+    csr = coo.to_csr(parallel=parallel)
+    assert isinstance(csr, ecole.observation.csr_matrix)
+    assert csr.nnz == coo.nnz
+    assert_same_csr(csr.sum_duplicates(parallel=parallel), coo.sum_duplicates(parallel=parallel).to_csr())
+    assert_same_csr(coo.to_csc(parallel=parallel), coo.transpose().to_csr())
+    assert_same_csr(csr.transpose(parallel=parallel), coo.transpose().to_csr().sum_duplicates())
+    rows = [coo.shape[0] - 1, 0]
+    assert_same_csr(coo.select_rows(rows).to_csr(), csr.select_rows(rows))
+    with pytest.raises(ValueError):
+        coo.select_cols([0, 0])
+
+
 def test_MilpBipartite_observation(model):
     """Observation of MilpBipartite is a type with array attributes."""
     obs = make_obs(ecole.observation.MilpBipartite(), model, stage=ecole.scip.Stage.Problem)
@@ -115,18 +292,97 @@ def test_MilpBipartite_observation(model):
     assert len(obs.ConstraintFeatures.__members__) == obs.constraint_features.shape[1]
 
 
+@pytest.mark.parametrize(
+    "obs_func,stage",
+    (
+        (ecole.observation.NodeBipartite(csc_edges=True), ecole.scip.Stage.Solving),
+        (ecole.observation.MilpBipartite(csr_edges=True, csc_edges=True), ecole.scip.Stage.Problem),
+    ),
+)
+def test_csc_edges(model, obs_func, stage):
+    """Edges sorted by variable are the CSR matrix of the transposed graph."""
+    obs = make_obs(obs_func, model, stage=stage)
+    csc = obs.edge_features_csc
+    assert_array(csc.row_pointers, dtype=np.int32)
+    assert len(csc.row_pointers) == obs.variable_features.shape[0] + 1
+    assert (np.diff(csc.row_pointers) >= 0).all()
+    assert csc.row_pointers[-1] == csc.nnz
+    sorted_edges = obs.edge_features if obs.edge_features.nnz > 0 else obs.edge_features_csr.to_coo()
+    assert_same_csr(csc, sorted_edges.to_csc())
+
+
+def test_MilpBipartiteFloat32_observation(model):
+    """Observation of MilpBipartiteFloat32 has single precision features."""
+    obs = make_obs(ecole.observation.MilpBipartiteFloat32(), model, stage=ecole.scip.Stage.Problem)
+    assert isinstance(obs, ecole.observation.MilpBipartiteObsFloat32)
+    assert_array(obs.variable_features, ndim=2, dtype=np.float32)
+    assert_array(obs.constraint_features, ndim=2, dtype=np.float32)
+    assert_array(obs.edge_features.values, dtype=np.float32)
+
+
+def test_extract_milp_bipartite(model, problem_file):
+    """Standalone extraction accepts models, paths, and lists of paths."""
+    obs = ecole.observation.extract_milp_bipartite(model)
+    assert isinstance(obs, ecole.observation.MilpBipartiteObs)
+    from_file = ecole.observation.extract_milp_bipartite(problem_file)
+    assert np.array_equal(from_file.variable_features, obs.variable_features)
+    from_files = ecole.observation.extract_milp_bipartite([problem_file] * 3, n_threads=2)
+    assert len(from_files) == 3
+    assert all(np.array_equal(o.variable_features, obs.variable_features) for o in from_files)
+    ecole.observation.extract_milp_bipartite(model, presolve=True)
+    assert model.stage == ecole.scip.Stage.Problem
+
+
 def test_StrongBranchingScores_observation(model):
     """Observation of StrongBranchingScores is a numpy array."""
     obs = make_obs(ecole.observation.StrongBranchingScores(), model)
     assert_array(obs)
 
 
+def test_BudgetedStrongBranchingScores_observation(model):
+    """Observation of BudgetedStrongBranchingScores is a numpy array with at most max_candidates scores."""
+    obs = make_obs(ecole.observation.BudgetedStrongBranchingScores(max_candidates=3), model)
+    assert_array(obs)
+    assert np.count_nonzero(~np.isnan(obs)) <= 3
+
+
+def test_ReliabilityBranchingScores_observation(model):
+    """Observation of ReliabilityBranchingScores flags the scores computed by strong branching."""
+    obs = make_obs(ecole.observation.ReliabilityBranchingScores(reliability_threshold=0), model)
+    assert_array(obs.scores)
+    assert_array(obs.exact, dtype=bool)
+    assert not obs.exact.any()
+
+
+def test_DetailedStrongBranchingScores_observation(model):
+    """Observation of DetailedStrongBranchingScores reports the children of evaluated candidates."""
+    obs = make_obs(ecole.observation.DetailedStrongBranchingScores(), model)
+    assert_array(obs.scores)
+    assert_array(obs.down_gains)
+    assert_array(obs.up_gains)
+    assert obs.n_lp_iterations.shape == obs.scores.shape
+    assert np.array_equal(np.isnan(obs.scores), np.isnan(obs.down_gains))
+    assert obs.n_lp_iterations.sum() > 0
+
+
 def test_Pseudocosts_observation(model):
     """Observation of Pseudocosts is a numpy array."""
     obs = make_obs(ecole.observation.Pseudocosts(), model)
     assert_array(obs)
 
 
+def test_PooledPseudocosts_observation(model):
+    """Pooled pseudocosts match pseudocosts and recycle garbage collected arrays."""
+    obs_func = ecole.observation.PooledPseudocosts(candidates_only=True, capacity=1)
+    obs = make_obs(obs_func, model)
+    assert_array(obs)
+    assert np.array_equal(obs, ecole.observation.Pseudocosts(candidates_only=True).extract(model, False))
+
+    address = obs.__array_interface__["data"][0]
+    del obs
+    assert obs_func.extract(model, False).__array_interface__["data"][0] == address
+
+
 def test_Khalil2016_observation(model):
     """Observation of Khalil2016 is a numpy matrix."""
     obs = make_obs(ecole.observation.Khalil2016(), model)
@@ -136,6 +392,87 @@ def test_Khalil2016_observation(model):
     assert len(obs.Features.__members__) == obs.features.shape[1]
 
 
+def test_Khalil2016_features_selection(model):
+    """Selected features are the matching columns of the full observation."""
+    Features = ecole.observation.Khalil2016Obs.Features
+    features = [Features.pseudocost_sum, Features.obj_coef, Features.active_coef_weight1_max]
+    obs_func = ecole.observation.Khalil2016(features=features)
+    full_func = ecole.observation.Khalil2016()
+    obs_func.before_reset(model)
+    full_func.before_reset(model)
+    pytest.helpers.advance_to_stage(model, ecole.scip.Stage.Solving)
+    obs = obs_func.extract(model, False)
+    full_obs = full_func.extract(model, False)
+    assert obs.features.shape == (full_obs.features.shape[0], len(features))
+    np.testing.assert_array_equal(obs.features, full_obs.features[:, [int(f) for f in features]])
+
+
+def test_Khalil2016_time_budget(model):
+    """Features missing the deadline are NaN and marked as timed out."""
+    n_static = ecole.observation.Khalil2016Obs.n_static_features
+    obs_func = ecole.observation.Khalil2016(time_budget=datetime.timedelta(microseconds=1))
+    obs_func.before_reset(model)
+    pytest.helpers.advance_to_stage(model, ecole.scip.Stage.Solving)
+    obs = obs_func.extract(model, False)
+    assert obs.timed_out.shape == (obs.features.shape[1],)
+    assert not obs.timed_out[:n_static].any()
+    assert np.isnan(obs.features[:, obs.timed_out]).all()
+
+    ample_func = ecole.observation.Khalil2016(time_budget=100.0)
+    ample_func.before_reset(model)
+    assert not ample_func.extract(model, False).timed_out.any()
+
+
+def test_NormalizedKhalil2016_observation(model):
+    """Features are normalized with the statistics of previous observations."""
+    obs_func = ecole.observation.NormalizedKhalil2016(
+        ecole.observation.Khalil2016(candidates_only=True)
+    )
+    raw_func = ecole.observation.Khalil2016(candidates_only=True)
+    obs_func.before_reset(model)
+    raw_func.before_reset(model)
+    pytest.helpers.advance_to_stage(model, ecole.scip.Stage.Solving)
+    raw = raw_func.extract(model, False).features
+    # Nothing is known before the first observation
+    np.testing.assert_array_equal(obs_func.extract(model, False).features, raw)
+    (stats,) = obs_func.statistics
+    assert stats.n_features == raw.shape[1]
+    np.testing.assert_allclose(stats.means, np.nanmean(raw, axis=0), atol=1e-10)
+    np.testing.assert_allclose(stats.variances, np.nanvar(raw, axis=0), atol=1e-10)
+
+    normalized = obs_func.extract(model, False).features
+    expected = (raw - np.nanmean(raw, axis=0)) / np.sqrt(np.nanvar(raw, axis=0) + 1e-8)
+    np.testing.assert_allclose(normalized, expected, atol=1e-6)
+
+    frozen = ecole.observation.NormalizedKhalil2016(raw_func, frozen=True)
+    frozen.load_statistics(obs_func.save_statistics())
+    frozen.extract(model, False)
+    assert frozen.statistics[0].counts == obs_func.statistics[0].counts
+
+
+def test_HistoryKhalil2016_observation(model):
+    """Histories hold the last observations without copying them."""
+    obs_func = ecole.observation.HistoryKhalil2016(length=2)
+    raw_func = ecole.observation.Khalil2016()
+    obs_func.before_reset(model)
+    raw_func.before_reset(model)
+    pytest.helpers.advance_to_stage(model, ecole.scip.Stage.Solving)
+    first = obs_func.extract(model, False)
+    assert len(first) == 1
+    np.testing.assert_array_equal(first[0].features, raw_func.extract(model, False).features)
+
+    second = obs_func.extract(model, False)
+    third = obs_func.extract(model, False)
+    assert len(third) == 2
+    assert np.shares_memory(second[-1].features, third[0].features)
+    assert len(obs_func.history()) == 2
+
+    obs_func.before_reset(model)
+    assert len(obs_func.history()) == 0
+    with pytest.raises(IndexError):
+        obs_func.history()[0]
+
+
 def test_Hutter2011_observation(model):
     """Observation of Hutter2011 is a numpy vector."""
     obs = make_obs(ecole.observation.Hutter2011(), model, stage=ecole.scip.Stage.Problem)
@@ -143,3 +480,19 @@ def test_Hutter2011_observation(model):
 
     # Check that there are enums describing feeatures
     assert len(obs.Features.__members__) == obs.features.shape[0]
+
+
+def test_TreeStatistics_observation(model):
+    """Observation of TreeStatistics is a numpy vector at the root node."""
+    obs = make_obs(ecole.observation.TreeStatistics(), model)
+    assert_array(obs.features, ndim=1)
+    assert len(obs.Features.__members__) == obs.features.shape[0]
+    assert obs.features[ecole.observation.TreeStatisticsObs.Features.n_nodes] == 1
+
+
+def test_Hutter2011_extract_from_file(problem_file):
+    """Hutter2011 features read from file leave LP features to NaN."""
+    obs = ecole.observation.Hutter2011().extract_from_file(problem_file)
+    assert_array(obs.features, ndim=1)
+    assert np.isnan(obs.features[ecole.observation.Hutter2011Obs.Features.lp_objective_value])
+    assert obs.features[ecole.observation.Hutter2011Obs.Features.nb_variables] > 0
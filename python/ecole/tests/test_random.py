@@ -35,6 +35,21 @@ def test_RandomGenerator_pickle():
     assert rng == pickle.loads(pickle.dumps(rng))
 
 
+def test_RandomGenerator_pickle_text_state():
+    """Generators pickled in text format can still be unpickled."""
+    rng = ecole.RandomGenerator(42)
+    rng_copy = ecole.RandomGenerator.__new__(ecole.RandomGenerator)
+    rng_copy.__setstate__(" ".join(str(w) for w in _mt19937_words(42)) + " 624")
+    assert rng_copy == rng
+
+
+def _mt19937_words(seed):
+    words = [seed]
+    for i in range(1, 624):
+        words.append((1812433253 * (words[-1] ^ (words[-1] >> 30)) + i) & 0xFFFFFFFF)
+    return words
+
+
 def test_same_seed():
     """Same seed give same random generators."""
     ecole.seed(0)
@@ -58,3 +73,24 @@ def test_spawn_generator():
     rng_1 = ecole.spawn_random_generator()
     rng_2 = ecole.spawn_random_generator()
     assert rng_1 != rng_2
+
+
+def test_spawn_generator_stream():
+    """Random generators of a stream do not depend on the order of calls."""
+    ecole.seed(0)
+    rng_1 = ecole.spawn_random_generator(1)
+    rng_2 = ecole.spawn_random_generator(2)
+    ecole.seed(0)
+    assert ecole.spawn_random_generator(2) == rng_2
+    assert ecole.spawn_random_generator(1) == rng_1
+    assert rng_1 != rng_2
+
+
+def test_split_generator():
+    """Split random generators are reproducible and different."""
+    rng = ecole.RandomGenerator(42)
+    rngs = ecole.split_random_generator(rng, 3)
+    assert len(rngs) == 3
+    assert rngs[0] != rngs[1]
+    assert rngs[0] == ecole.derive_random_generator(ecole.RandomGenerator(42), 0)
+    assert rng != ecole.RandomGenerator(42)
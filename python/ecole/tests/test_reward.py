@@ -141,3 +141,36 @@ def test_primal_dual_integral_lambda(model):
     reward = reward_function.extract(model)
 
     assert reward >= 0
+
+
+def test_bound_integral_history(model):
+    """Bound integrals only record their history when asked to."""
+    reward_function = ecole.reward.PrimalDualIntegral(keep_history=True)
+    reward_function.before_reset(model)
+    pytest.helpers.advance_to_stage(model, ecole.scip.Stage.Solving)
+    reward_function.extract(model)
+
+    history = reward_function.history(model)
+    assert len(history.times) >= 2
+    assert len(history.primal_bounds) == len(history.times)
+    assert len(history.dual_bounds) == len(history.times)
+
+
+def test_dual_integral_node_events(model):
+    """The dual bound can be read after every node with a coarse wall clock."""
+    reward_function = ecole.reward.DualIntegral(
+        wall=True, dual_bound_event=ecole.reward.DualBoundEvent.Node, coarse_clock=True
+    )
+    reward_function.before_reset(model)
+    pytest.helpers.advance_to_stage(model, ecole.scip.Stage.Solving)
+    assert isinstance(reward_function.extract(model), float)
+
+
+def test_solving_time_thread_cpu(model):
+    """The CPU time of the environment and solver threads can be used instead."""
+    reward_function = ecole.reward.SolvingTime(thread_cpu=True)
+    reward_function.before_reset(model)
+    pytest.helpers.advance_to_stage(model, ecole.scip.Stage.Solving)
+    assert reward_function.extract(model) > 0
+    with pytest.raises(ValueError):
+        ecole.reward.SolvingTime(wall=True, thread_cpu=True)
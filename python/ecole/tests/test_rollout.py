@@ -0,0 +1,108 @@
+"""Unit tests for Ecole multi-process rollouts."""
+
+import os
+import sys
+
+import numpy as np
+import pytest
+
+import ecole
+import ecole.rollout
+
+
+pytestmark = pytest.mark.skipif(sys.version_info < (3, 8), reason="Shared memory requires Python 3.8")
+
+
+def test_observation_layout_round_trip(model):
+    """Observations written in a slot are read back as views, and copied as the original type."""
+    obs_func = ecole.observation.NodeBipartite()
+    obs_func.before_reset(model)
+    pytest.helpers.advance_to_stage(model, ecole.scip.Stage.Solving)
+    obs = obs_func.extract(model, False)
+
+    ring = ecole.rollout._RingBuffer(n_slots=2, slot_size=2 ** 20)
+    try:
+        arrays = []
+        layout = ecole.rollout._flatten(obs, arrays)
+        descriptions = ring.write(1, arrays)
+        views = ring.read(1, descriptions)
+        view = ecole.rollout._unflatten(layout, views, materialize=False)
+        np.testing.assert_array_equal(view.variable_features, obs.variable_features)
+        np.testing.assert_array_equal(view.edge_features.indices, obs.edge_features.indices)
+
+        copy = ecole.rollout._unflatten(layout, [v.copy() for v in views], materialize=True)
+        assert isinstance(copy, ecole.observation.NodeBipartiteObs)
+        np.testing.assert_array_equal(copy.row_features, obs.row_features)
+        del view, views
+    finally:
+        ring.memory.close()
+        ring.memory.unlink()
+
+
+def test_observation_too_large_for_slot():
+    """Arrays that do not fit in a slot are not written."""
+    ring = ecole.rollout._RingBuffer(n_slots=1, slot_size=64)
+    try:
+        assert ring.write(0, [np.zeros(100)]) is None
+    finally:
+        ring.memory.close()
+        ring.memory.unlink()
+
+
+@pytest.mark.slow
+def test_rollout_server_episodes(problem_file):
+    """Workers run full episodes, collected in order of completion."""
+    with ecole.rollout.RolloutServer(ecole.environment.Branching, n_workers=2) as server:
+        server.seed(0)
+        for i in range(len(server)):
+            server.reset_async(i, str(problem_file))
+        with pytest.raises(ecole.MarkovError):
+            server.step_async(0, 0)
+
+        n_done = 0
+        while server.n_pending > 0:
+            i, (obs, action_set, reward, done, info) = server.wait_any()
+            obs.release()
+            if done:
+                n_done += 1
+            else:
+                server.step_async(i, action_set[0])
+        assert n_done == len(server)
+        with pytest.raises(ecole.MarkovError):
+            server.wait_any()
+
+
+@pytest.mark.slow
+@pytest.mark.skipif(sys.platform == "win32", reason="Forking requires POSIX")
+def test_rollout_server_forked_workers(problem_file):
+    """Environments created before forking, by a callable that cannot be pickled, run their episodes."""
+    make_env = lambda: ecole.environment.Branching()
+    with ecole.rollout.RolloutServer(make_env, n_workers=2, start_method="fork") as server:
+        server.seed(0)
+        for i in range(len(server)):
+            server.reset_async(i, str(problem_file))
+        for _ in range(len(server)):
+            i, (obs, action_set, reward, done, info) = server.wait_any()
+            obs.release()
+            assert not done
+
+
+def test_rollout_server_cpus_per_worker():
+    """A set of CPUs must be given for every worker."""
+    with pytest.raises(ValueError):
+        ecole.rollout.RolloutServer(ecole.environment.Branching, n_workers=2, cpus=[[0]])
+
+
+@pytest.mark.slow
+@pytest.mark.skipif(not hasattr(os, "sched_getaffinity"), reason="Affinity requires Linux")
+def test_rollout_server_pinned_workers(problem_file):
+    """Workers restricted to some CPUs run their episodes as usual."""
+    cpus = sorted(os.sched_getaffinity(0))[:1]
+    make_env = ecole.environment.Branching
+    with ecole.rollout.RolloutServer(make_env, n_workers=2, cpus=[cpus, cpus]) as server:
+        server.seed(0)
+        for i in range(len(server)):
+            server.reset_async(i, str(problem_file))
+        for _ in range(len(server)):
+            i, (obs, action_set, reward, done, info) = server.wait_any()
+            obs.release()
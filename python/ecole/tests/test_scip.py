@@ -1,4 +1,6 @@
 import importlib.util
+import pathlib
+import pickle
 
 import pytest
 
@@ -22,6 +24,72 @@ def test_copy_orig(model):
     assert model != model_copy
 
 
+def test_fingerprint(model, problem_file):
+    assert model.fingerprint() == model.copy_orig().fingerprint()
+    assert model.fingerprint() == ecole.scip.Model.from_file(problem_file).fingerprint()
+    assert model.exact_fingerprint() == model.fingerprint()
+
+
+def test_memory_usage(model):
+    usage = model.memory_usage()
+    assert usage.scip_used > 0
+    assert usage.scip_total >= usage.scip_used
+    assert usage.lp_view == 0
+
+
+def test_fork(model):
+    fcall = model.solve_iter(ecole.scip.callback.BranchruleConstructor())
+    assert fcall is not None
+    fork = model.fork()
+    assert fork != model
+    assert fork.stage == ecole.scip.Stage.Problem
+    model.solve_iter_continue(ecole.scip.callback.Result.DidNotRun)
+    fork.solve()
+    assert fork.is_solved
+
+
+@pytest.mark.parametrize(
+    "profile", (ecole.scip.PluginProfile.Branching, ecole.scip.PluginProfile.Modeling)
+)
+def test_plugin_profile(problem_file, profile):
+    model = ecole.scip.Model.from_file(problem_file, profile=profile)
+    full = ecole.scip.Model.from_file(problem_file)
+    assert model.name == full.name
+    assert "heuristics/rins/freq" not in model.get_params()
+    assert "heuristics/rins/freq" in full.get_params()
+
+
+def test_from_buffer(problem_file):
+    data = pathlib.Path(problem_file).read_bytes()
+    full = ecole.scip.Model.from_file(problem_file)
+    for buffer in (data, memoryview(data)):
+        model = ecole.scip.Model.from_buffer(buffer, "mps")
+        assert model.name == full.name
+
+    with pytest.raises(ecole.scip.ScipError):
+        ecole.scip.Model.from_buffer(b"not a problem", "mps")
+
+
+def test_binary_round_trip(model, tmp_path):
+    filepath = tmp_path / "problem.bin"
+    model.save_binary(filepath)
+    loaded = ecole.scip.Model.load_binary(filepath)
+    assert loaded.name == model.name
+    loaded.solve()
+    model.solve()
+    assert loaded.primal_bound == pytest.approx(model.primal_bound)
+
+
+def test_pickle(model):
+    """Models are pickled in the binary format."""
+    unpickled = pickle.loads(pickle.dumps(model))
+    assert unpickled.name == model.name
+    assert unpickled != model
+    unpickled.solve()
+    model.solve()
+    assert unpickled.primal_bound == pytest.approx(model.primal_bound)
+
+
 @requires_pyscipopt
 def test_from_pyscipopt_shared():
     """Ecole share same pointer."""
@@ -124,6 +192,13 @@ def test_get_params(model):
         assert isinstance(params[name], param_type)
 
 
+def test_get_changed_params(model):
+    name = "conflict/minmaxvars"
+    assert name not in model.get_changed_params()
+    model.set_param(name, model.get_param(name) + 1)
+    assert model.get_changed_params()[name] == model.get_param(name)
+
+
 def test_set_params(model):
     # Some values to test
     params = {name: "v" if param_type is str else param_type(1) for name, param_type in names_types}
@@ -156,13 +231,29 @@ def test_bounds(model):
     assert model.dual_bound < model.primal_bound
 
 
+def test_capture_log(model):
+    """The log of SCIP is kept in memory rather than written."""
+    assert model.captured_log() == ""
+    model.capture_log(capacity=2 ** 12)
+    model.solve()
+    log = model.captured_log()
+    assert 0 < len(log) <= 2 ** 12
+    model.clear_captured_log()
+    assert model.captured_log() == ""
+
+
 @pytest.mark.slow
 def test_solve_iter(model):
     used_branchrule = False
     used_heuristic = False
+    used_nodesel = False
+    used_cutsel = False
 
     fcall = model.solve_iter(
-        ecole.scip.callback.BranchruleConstructor(), ecole.scip.callback.HeuristicConstructor()
+        ecole.scip.callback.BranchruleConstructor(),
+        ecole.scip.callback.HeuristicConstructor(),
+        ecole.scip.callback.NodeselConstructor(),
+        ecole.scip.callback.CutselConstructor(),
     )
     while fcall is not None:
         fcall = model.solve_iter_continue(ecole.scip.callback.Result.DidNotRun)
@@ -170,6 +261,34 @@ def test_solve_iter(model):
             used_branchrule = True
         elif isinstance(fcall, ecole.scip.callback.HeuristicCall):
             used_heuristic = True
+        elif isinstance(fcall, ecole.scip.callback.NodeselCall):
+            used_nodesel = True
+        elif isinstance(fcall, ecole.scip.callback.CutselCall):
+            used_cutsel = True
 
     assert used_branchrule
     assert used_heuristic
+    assert used_nodesel
+    assert used_cutsel
+
+
+@pytest.mark.slow
+def test_solve_iter_separator_presolver_event_handler(problem_file):
+    # The model fixture disables presolving and separation
+    model = ecole.scip.Model.from_file(problem_file)
+    calls = set()
+    fcall = model.solve_iter(
+        ecole.scip.callback.SeparatorConstructor(),
+        ecole.scip.callback.PresolverConstructor(max_rounds=1),
+        ecole.scip.callback.EventHandlerConstructor(),
+    )
+    while fcall is not None:
+        calls.add(type(fcall))
+        fcall = model.solve_iter_continue(ecole.scip.callback.Result.DidNotRun)
+
+    assert model.is_solved
+    assert calls == {
+        ecole.scip.callback.SeparatorCall,
+        ecole.scip.callback.PresolverCall,
+        ecole.scip.callback.EventHandlerCall,
+    }
@@ -0,0 +1,43 @@
+import pytest
+
+import ecole
+
+
+def test_set_n_threads():
+    ecole.set_n_threads(3)
+    try:
+        assert ecole.get_n_threads() == 3
+    finally:
+        ecole.set_n_threads(0)
+    assert ecole.get_n_threads() >= 1
+
+
+def test_shared_threads_observation(model):
+    """Observation functions sharing Ecole's threads give the same observation as sequential ones."""
+    ecole.set_n_threads(2)
+    try:
+        shared = ecole.observation.MilpBipartite(n_threads=0)
+        sequential = ecole.observation.MilpBipartite(n_threads=1)
+        obs_shared = shared.extract(model, False)
+        obs_sequential = sequential.extract(model, False)
+    finally:
+        ecole.set_n_threads(0)
+    assert (obs_shared.edge_features.values == obs_sequential.edge_features.values).all()
+
+
+def test_running_threads_are_counted(problem_file):
+    """Environments in the middle of an episode hold a solver thread, and cannot be forked."""
+    env = ecole.environment.Branching()
+    n_threads = ecole.n_running_threads()
+    _, _, _, done, _ = env.reset(str(problem_file))
+    assert not done
+    assert ecole.n_running_threads() > n_threads
+    with pytest.raises(RuntimeError):
+        ecole.check_fork_safe()
+
+
+def test_prewarm():
+    n_threads = ecole.n_running_threads()
+    ecole.prewarm()
+    ecole.prewarm(ecole.scip.PluginProfile.Modeling)
+    assert ecole.n_running_threads() == n_threads
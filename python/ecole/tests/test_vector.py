@@ -0,0 +1,86 @@
+"""Unit tests for Ecole vector environments."""
+
+import itertools
+import sys
+
+import numpy as np
+import pytest
+
+import ecole
+import ecole.vector
+
+
+def choose_actions(infos):
+    """The first action of every environment, or zero for the ones that are reset."""
+    return np.array([a[0] if len(a) > 0 else 0 for a in infos["action_set"]], dtype=np.uint64)
+
+
+def test_thread_vector_environment(problem_file):
+    """Terminated environments are reset on the next step, with a zero reward."""
+    n_envs = 2
+    instances = itertools.repeat(str(problem_file))
+    with ecole.vector.Environment(n_envs, instances, backend="thread") as envs:
+        obs, infos = envs.reset(seed=0)
+        assert len(envs) == n_envs
+        assert obs.variable_offsets.shape == (n_envs + 1,)
+        assert len(infos["action_set"]) == n_envs
+        assert infos["reward_offset"].shape == (n_envs,)
+
+        terminations = np.zeros(n_envs, dtype=bool)
+        while not terminations.any():
+            obs, rewards, terminations, truncations, infos = envs.step(choose_actions(infos))
+            assert rewards.shape == (n_envs,)
+            assert not truncations.any()
+        obs, rewards, _, _, infos = envs.step(choose_actions(infos))
+        assert (rewards[terminations] == 0).all()
+        assert all(len(infos["action_set"][i]) > 0 for i in np.flatnonzero(terminations))
+
+
+def test_thread_vector_environment_auto_reset():
+    """Terminated environments are reset in the background on a copy of the generator."""
+    n_envs = 2
+    generator = ecole.instance.SetCoverGenerator(n_rows=100, n_cols=200)
+    with ecole.vector.Environment(n_envs, generator, auto_reset=True) as envs:
+        _, infos = envs.reset(seed=0)
+        terminations = np.zeros(n_envs, dtype=bool)
+        while not terminations.any():
+            _, rewards, terminations, _, infos = envs.step(choose_actions(infos))
+        _, rewards, new_terminations, _, infos = envs.step(choose_actions(infos))
+        assert (rewards[terminations] == 0).all()
+        assert all(len(infos["action_set"][i]) > 0 for i in np.flatnonzero(~new_terminations))
+
+
+def test_vector_environment_auto_reset_needs_ecole_generator(problem_file):
+    """Python iterables would need the GIL to be reset in the background."""
+    with pytest.raises(ValueError):
+        ecole.vector.Environment(2, [str(problem_file)], auto_reset=True)
+    with pytest.raises(ValueError):
+        ecole.vector.Environment(2, [str(problem_file)], backend="process", auto_reset=True)
+
+
+def test_vector_environment_exhausted_instances(problem_file):
+    """An error is raised when no instance is left for a new episode."""
+    with ecole.vector.Environment(2, [str(problem_file)]) as envs:
+        with pytest.raises(ValueError):
+            envs.reset()
+
+
+def test_vector_environment_unknown_backend():
+    """Only the thread and process backends exist."""
+    with pytest.raises(ValueError):
+        ecole.vector.Environment(2, [], backend="fiber")
+
+
+@pytest.mark.slow
+@pytest.mark.skipif(sys.version_info < (3, 8), reason="Shared memory requires Python 3.8")
+def test_process_vector_environment(problem_file):
+    """Observations of worker processes are views in shared memory, released on the next call."""
+    n_envs = 2
+    instances = itertools.repeat(str(problem_file))
+    with ecole.vector.Environment(n_envs, instances, backend="process") as envs:
+        obs, infos = envs.reset(seed=0)
+        assert len(obs) == n_envs
+        assert all(o is None or o.variable_features.ndim == 2 for o in obs)
+        for _ in range(3):
+            obs, rewards, terminations, _, infos = envs.step(choose_actions(infos))
+            assert rewards.shape == terminations.shape == (n_envs,)
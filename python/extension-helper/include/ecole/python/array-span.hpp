@@ -0,0 +1,101 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <nonstd/span.hpp>
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+namespace ecole::python {
+
+/**
+ * A Python array argument read as a span of T, for the duration of a call.
+ *
+ * Contiguous numpy arrays of T are read in place.
+ * Contiguous and aligned numpy arrays of other integers or floating points, such as the ``int64`` indices returned by numpy
+ * functions, are converted by span, once and into a buffer, which does not need the GIL.
+ * Other objects, such as lists, are converted by numpy upon construction.
+ * Construction requires the GIL, and the object must be destroyed with the GIL held, since it keeps the array alive.
+ */
+template <typename T> class ArraySpan {
+public:
+	explicit ArraySpan(pybind11::handle obj) {
+		using Numpy = pybind11::array_t<T, pybind11::array::c_style | pybind11::array::forcecast>;
+		if (!pybind11::isinstance<Numpy>(obj) && pybind11::isinstance<pybind11::array>(obj)) {
+			auto arr = pybind11::reinterpret_borrow<pybind11::array>(obj);
+			auto const dtype = arr.dtype();
+			auto constexpr required = pybind11::array::c_style | pybind11::detail::npy_api::NPY_ARRAY_ALIGNED_;
+			auto const readable = (arr.flags() & required) == required && dtype.attr("isnative").cast<bool>();
+			if (readable && is_supported(dtype.kind(), dtype.itemsize())) {
+				kind = dtype.kind();
+				itemsize = static_cast<std::size_t>(dtype.itemsize());
+				set_array(std::move(arr));
+				return;
+			}
+		}
+		set_array(obj.cast<Numpy>());
+	}
+
+	/** The values of the array, converted the first time if they are not of type T. */
+	auto span() -> nonstd::span<T const> {
+		if (kind == in_place) {
+			return {static_cast<T const*>(data), size};
+		}
+		if (!converted) {
+			convert();
+			converted = true;
+		}
+		return {buffer.data(), buffer.size()};
+	}
+
+private:
+	static constexpr char in_place = '\0';
+
+	pybind11::array array;
+	void const* data = nullptr;
+	std::size_t size = 0;
+	char kind = in_place;
+	std::size_t itemsize = 0;
+	bool converted = false;
+	std::vector<T> buffer;
+
+	static auto is_supported(char kind_, pybind11::ssize_t itemsize_) noexcept -> bool {
+		auto const is_power = itemsize_ == 1 || itemsize_ == 2 || itemsize_ == 4 || itemsize_ == 8;
+		return ((kind_ == 'i' || kind_ == 'u') && is_power) || (kind_ == 'f' && (itemsize_ == 4 || itemsize_ == 8));
+	}
+
+	void set_array(pybind11::array arr) {
+		data = arr.data();
+		size = static_cast<std::size_t>(arr.size());
+		array = std::move(arr);
+	}
+
+	template <typename Source> void convert_from() {
+		auto const* const source = static_cast<Source const*>(data);
+		buffer.resize(size);
+		std::transform(source, source + size, buffer.begin(), [](Source value) { return static_cast<T>(value); });
+	}
+
+	void convert() {
+		if (kind == 'f') {
+			return itemsize == 4 ? convert_from<float>() : convert_from<double>();
+		}
+		auto const is_signed = kind == 'i';
+		switch (itemsize) {
+		case 1:
+			return is_signed ? convert_from<std::int8_t>() : convert_from<std::uint8_t>();
+		case 2:
+			return is_signed ? convert_from<std::int16_t>() : convert_from<std::uint16_t>();
+		case 4:
+			return is_signed ? convert_from<std::int32_t>() : convert_from<std::uint32_t>();
+		default:
+			return is_signed ? convert_from<std::int64_t>() : convert_from<std::uint64_t>();
+		}
+	}
+};
+
+}  // namespace ecole::python
@@ -14,17 +14,23 @@ namespace ecole::python {
 template <typename Class, typename... ClassArgs> struct auto_class : public pybind11::class_<Class, ClassArgs...> {
 	using pybind11::class_<Class, ClassArgs...>::class_;
 
-	/** An Alternative pybind11::class_::def_readwrite for xtensor members. */
+	/**
+	 * An Alternative pybind11::class_::def_readwrite for xtensor members.
+	 *
+	 * Reading the attribute never copies: the numpy array is a view on the C++ tensor that keeps the object alive.
+	 * Assigning the attribute copies the array into the C++ tensor, converting its type if needed.
+	 */
 	template <typename Str, typename MemberPtr, typename... Args>
 	auto def_readwrite_xtensor(Str&& name, MemberPtr&& member_ptr, Args&&... args) -> auto& {
 		using Member = std::remove_reference_t<std::invoke_result_t<MemberPtr, Class>>;
 		using value_type = typename Member::value_type;
 		auto constexpr rank = xt::get_rank<Member>::value;
-		this->def_property(
-			std::forward<Str>(name),
-			[member_ptr](Class& self) -> decltype(auto) { return std::invoke(member_ptr, self); },
-			[member_ptr](Class& self, xt::pytensor<value_type, rank> const& val) { std::invoke(member_ptr, self) = val; },
-			std::forward<Args>(args)...);
+		auto getter = pybind11::cpp_function(
+			[member_ptr](Class& self) -> Member& { return std::invoke(member_ptr, self); },
+			pybind11::return_value_policy::reference_internal);
+		auto setter = pybind11::cpp_function(
+			[member_ptr](Class& self, xt::pytensor<value_type, rank> const& val) { std::invoke(member_ptr, self) = val; });
+		this->def_property(std::forward<Str>(name), getter, setter, std::forward<Args>(args)...);
 		return *this;
 	}
 
@@ -87,8 +93,8 @@ template <typename Class, typename... ClassArgs> struct auto_data_class : public
 	}
 
 	template <typename... FuncPtr> auto def_auto_init(Member<FuncPtr>... members) -> auto& {
-		// Instantiate the C++ type at compile time to get default parameters.
-		auto constexpr default_params = type{};
+		// Instantiate the C++ type to get default parameters.
+		auto const default_params = type{};
 		// Bind a constructor that takes as input all parameters
 		this->def(
 			// Get the type of each parameter and add it to the Python constructor
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <stdexcept>
+#include <vector>
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+
+namespace ecole::python {
+
+/**
+ * The subset of the DLPack C ABI used to export tensors.
+ *
+ * Layouts follow ``dlpack.h`` (version 0.8), which is a stable ABI, so the header is not needed.
+ */
+namespace dlpack {
+
+enum DeviceType : std::int32_t { kDLCPU = 1 };
+
+enum DataTypeCode : std::uint8_t { kDLInt = 0, kDLUInt = 1, kDLFloat = 2, kDLBool = 6 };
+
+struct Device {
+	DeviceType device_type;
+	std::int32_t device_id;
+};
+
+struct DataType {
+	std::uint8_t code;
+	std::uint8_t bits;
+	std::uint16_t lanes;
+};
+
+struct Tensor {
+	void* data;
+	Device device;
+	std::int32_t ndim;
+	DataType dtype;
+	std::int64_t* shape;
+	std::int64_t* strides;
+	std::uint64_t byte_offset;
+};
+
+struct ManagedTensor {
+	Tensor dl_tensor;
+	void* manager_ctx;
+	void (*deleter)(ManagedTensor* self);
+};
+
+}  // namespace dlpack
+
+/**
+ * Export a numpy array as a DLPack capsule, without copy.
+ *
+ * The capsule keeps the array, and hence the memory it views, alive until the consumer (for instance
+ * ``torch.utils.dlpack.from_dlpack``) is done with it.
+ * Unlike ``ndarray.__dlpack__``, this does not require a recent version of numpy.
+ */
+inline auto to_dlpack(pybind11::array const& array) -> pybind11::capsule {
+	auto const code = [&array]() -> std::uint8_t {
+		switch (array.dtype().kind()) {
+		case 'f':
+			return dlpack::kDLFloat;
+		case 'i':
+			return dlpack::kDLInt;
+		case 'u':
+			return dlpack::kDLUInt;
+		case 'b':
+			return dlpack::kDLBool;
+		default:
+			throw std::invalid_argument{"Only boolean, integer, and floating point arrays can be exported."};
+		}
+	}();
+
+	/** Owns the array and the shape and strides that the DLPack tensor points to. */
+	struct Context {
+		dlpack::ManagedTensor managed;
+		pybind11::array array;
+		std::vector<std::int64_t> shape;
+		std::vector<std::int64_t> strides;
+	};
+	auto context = std::make_unique<Context>();
+	context->array = array;
+	auto const ndim = static_cast<std::size_t>(array.ndim());
+	auto const itemsize = static_cast<std::int64_t>(array.itemsize());
+	for (std::size_t i = 0; i < ndim; ++i) {
+		context->shape.push_back(static_cast<std::int64_t>(array.shape(i)));
+		// DLPack strides are in number of elements rather than bytes
+		context->strides.push_back(static_cast<std::int64_t>(array.strides(i)) / itemsize);
+	}
+	auto& tensor = context->managed.dl_tensor;
+	tensor.data = const_cast<void*>(array.data());  // NOLINT(cppcoreguidelines-pro-type-const-cast) DLPack is not const
+	tensor.device = {dlpack::kDLCPU, 0};
+	tensor.ndim = static_cast<std::int32_t>(ndim);
+	tensor.dtype = {code, static_cast<std::uint8_t>(itemsize * 8), 1};
+	tensor.shape = context->shape.data();
+	tensor.strides = context->strides.data();
+	tensor.byte_offset = 0;
+	context->managed.manager_ctx = context.get();
+	context->managed.deleter = [](dlpack::ManagedTensor* self) {
+		// Consumers may call the deleter without holding the GIL
+		auto const gil = pybind11::gil_scoped_acquire{};
+		delete static_cast<Context*>(self->manager_ctx);  // NOLINT(cppcoreguidelines-owning-memory)
+	};
+
+	// Consumers rename the capsule once they take ownership, otherwise the tensor is deleted with the capsule
+	auto* const raw_capsule = PyCapsule_New(&context->managed, "dltensor", [](PyObject* capsule) {
+		if (PyCapsule_IsValid(capsule, "dltensor") != 0) {
+			auto* const managed = static_cast<dlpack::ManagedTensor*>(PyCapsule_GetPointer(capsule, "dltensor"));
+			managed->deleter(managed);
+		}
+	});
+	if (raw_capsule == nullptr) {
+		throw pybind11::error_already_set{};
+	}
+	context.release();
+	return pybind11::reinterpret_steal<pybind11::capsule>(raw_capsule);
+}
+
+}  // namespace ecole::python